@@ -64,6 +64,13 @@ public:
         return true;
     }
 
+    // Whether draw() may run on several threads at once, each with its own canvas, for nanobench's
+    // --benchThreads mode. preDraw() and postDraw() are still called one canvas at a time, and
+    // perCanvasPreDraw()/perCanvasPostDraw() only for the main canvas.
+    virtual bool isThreadSafe() const {
+        return false;
+    }
+
     // Call before draw, allows the benchmark to do setup work outside of the
     // timer. When a benchmark is repeatedly drawn, this should be called once
     // before the initial draw.
@@ -85,6 +92,10 @@ public:
                              skia_private::TArray<SkString>* keys,
                              skia_private::TArray<double>* values) {}
 
+    // Extra metrics to add to the results, e.g. a distribution that the samples don't capture.
+    virtual void getMetrics(skia_private::TArray<SkString>* keys,
+                            skia_private::TArray<double>* values) {}
+
     // Replaces the GrRecordingContext's dmsaaStats() with a single frame of this benchmark.
     virtual bool getDMSAAStats(GrRecordingContext*) { return false; }
 
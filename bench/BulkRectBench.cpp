@@ -19,6 +19,8 @@
 #include "src/gpu/ganesh/SkGr.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 
+#include <algorithm>
+
 // Benchmarks that exercise the bulk image and solid color quad APIs, under a variety of patterns:
 enum class ImageMode {
     kShared, // 1. One shared image referenced by every rectangle
@@ -29,7 +31,8 @@ enum class ImageMode {
 enum class DrawMode {
     kBatch,  // Bulk API submission, one call to draw every rectangle
     kRef,    // One standard SkCanvas draw call per rectangle
-    kQuad    // One experimental draw call per rectangle, only for solid color draws
+    kQuad,   // One experimental draw call per rectangle, only for solid color draws
+    kBulk    // One SkCanvas::experimental_DrawBulk call, only for solid color or shared images
 };
 //   X
 enum class RectangleLayout {
@@ -43,6 +46,8 @@ class BulkRectBench : public Benchmark {
 public:
     static_assert(kImageMode == ImageMode::kNone || kDrawMode != DrawMode::kQuad,
                   "kQuad only supported for solid color draws");
+    static_assert(kImageMode != ImageMode::kUnique || kDrawMode != DrawMode::kBulk,
+                  "kBulk only supported for solid color draws or a shared image");
 
     inline static constexpr int kWidth      = 1024;
     inline static constexpr int kHeight     = 1024;
@@ -86,6 +91,8 @@ protected:
             fName.append("_batch");
         } else if (kDrawMode == DrawMode::kRef) {
             fName.append("_ref");
+        } else if (kDrawMode == DrawMode::kBulk) {
+            fName.append("_bulk");
         } else {
             fName.append("_quad");
         }
@@ -174,6 +181,31 @@ protected:
         }
     }
 
+    void drawBulk(SkCanvas* canvas) const {
+        SkASSERT(kDrawMode == DrawMode::kBulk);
+
+        SkCanvas::BulkItem items[kRectCount];
+        SkRect srcRects[kRectCount];
+        SkCanvas::BulkSet set;
+        set.fCount = kRectCount;
+        set.fItems = items;
+        set.fRects = fRects;
+        if constexpr (kImageMode == ImageMode::kNone) {
+            std::fill_n(items, kRectCount, SkCanvas::BulkItem::kRect);
+            set.fColors = fColors;
+        } else {
+            std::fill_n(items, kRectCount, SkCanvas::BulkItem::kImageRect);
+            std::fill_n(srcRects, kRectCount,
+                        SkRect::MakeIWH(fImages[0]->width(), fImages[0]->height()));
+            set.fSrcRects = srcRects;
+            set.fImage = fImages[0].get();
+        }
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        canvas->experimental_DrawBulk(set, SkSamplingOptions(SkFilterMode::kLinear), paint);
+    }
+
     const char* onGetName() override {
         if (fName.isEmpty()) {
             this->computeName();
@@ -246,7 +278,9 @@ protected:
 
     void onDraw(int loops, SkCanvas* canvas) override {
         for (int i = 0; i < loops; i++) {
-            if (kImageMode == ImageMode::kNone) {
+            if (kDrawMode == DrawMode::kBulk) {
+                this->drawBulk(canvas);
+            } else if (kImageMode == ImageMode::kNone) {
                 if (kDrawMode == DrawMode::kBatch) {
                     this->drawSolidColorsBatch(canvas);
                 } else {
@@ -276,11 +310,13 @@ protected:
 #define ADD_BENCH_FAMILY(n, layout)                                            \
     ADD_BENCH(n, layout, ImageMode::kShared, DrawMode::kBatch)                 \
     ADD_BENCH(n, layout, ImageMode::kShared, DrawMode::kRef)                   \
+    ADD_BENCH(n, layout, ImageMode::kShared, DrawMode::kBulk)                  \
     ADD_BENCH(n, layout, ImageMode::kUnique, DrawMode::kBatch)                 \
     ADD_BENCH(n, layout, ImageMode::kUnique, DrawMode::kRef)                   \
     ADD_BENCH(n, layout, ImageMode::kNone,   DrawMode::kBatch)                 \
     ADD_BENCH(n, layout, ImageMode::kNone,   DrawMode::kRef)                   \
-    ADD_BENCH(n, layout, ImageMode::kNone,   DrawMode::kQuad)
+    ADD_BENCH(n, layout, ImageMode::kNone,   DrawMode::kQuad)                  \
+    ADD_BENCH(n, layout, ImageMode::kNone,   DrawMode::kBulk)
 
 ADD_BENCH_FAMILY(1000,  RectangleLayout::kRandom)
 ADD_BENCH_FAMILY(1000,  RectangleLayout::kGrid)
@@ -7,6 +7,7 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkMatrix.h"
 
 class CanvasSaveRestoreBench : public Benchmark {
 public:
@@ -47,3 +48,49 @@ DEF_BENCH( return new CanvasSaveRestoreBench(8);)
 DEF_BENCH( return new CanvasSaveRestoreBench(32);)
 DEF_BENCH( return new CanvasSaveRestoreBench(128);)
 DEF_BENCH( return new CanvasSaveRestoreBench(512);)
+
+// Mimics a DOM-like renderer: every node of a tree that is 'depth' deep saves, offsets itself
+// within its parent with a translate-only concat(), and restores, without clipping. Each node has
+// a few leaf children besides the one that continues the tree.
+class CanvasSaveTranslateRestoreBench : public Benchmark {
+public:
+    CanvasSaveTranslateRestoreBench(int depth) : fDepth(depth) {
+        fName.printf("canvas_save_translate_restore_%d", fDepth);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kRaster; }
+    SkISize onGetSize() override { return { 1, 1 }; }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkMatrix offset = SkMatrix::Translate(1, 2);
+        for (int i = 0; i < loops; ++i) {
+            for (int j = 0; j < fDepth; ++j) {
+                for (int leaf = 0; leaf < kLeavesPerNode; ++leaf) {
+                    canvas->save();
+                    canvas->concat(offset);
+                    canvas->restore();
+                }
+                canvas->save();
+                canvas->concat(offset);
+            }
+            canvas->drawColor(SkColors::kCyan);
+            for (int j = 0; j < fDepth; ++j) {
+                canvas->restore();
+            }
+        }
+    }
+
+private:
+    static constexpr int kLeavesPerNode = 4;
+
+    const int fDepth;
+    SkString fName;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new CanvasSaveTranslateRestoreBench(8);)
+DEF_BENCH( return new CanvasSaveTranslateRestoreBench(32);)
+DEF_BENCH( return new CanvasSaveTranslateRestoreBench(128);)
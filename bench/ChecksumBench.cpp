@@ -12,11 +12,13 @@
 #include "src/core/SkChecksum.h"
 #include "src/core/SkMD5.h"
 
+#include <cstring>
 #include <memory>
 
 enum ChecksumType {
     kMD5_ChecksumType,
     kWyhash_ChecksumType,
+    kMix64_ChecksumType,  // SkGoodHash's path for 8-byte keys
 };
 
 class ComputeChecksumBench : public Benchmark {
@@ -32,10 +34,12 @@ public:
 
     ComputeChecksumBench(ChecksumType type, size_t blockSize) : fType(type), fBlockSize(blockSize) {
         SkASSERT(blockSize <= kBufferSize);
+        SkASSERT(type != kMix64_ChecksumType || blockSize == sizeof(uint64_t));
 
         switch (fType) {
             case kMD5_ChecksumType: fName = "compute_md5"; break;
             case kWyhash_ChecksumType: fName = "compute_wyhash"; break;
+            case kMix64_ChecksumType: fName = "compute_mix64"; break;
         }
         fName.appendf("_%d", static_cast<int>(fBlockSize));
     }
@@ -72,6 +76,12 @@ public:
                     case kWyhash_ChecksumType:
                         result = SkChecksum::Hash32(buf, fBlockSize);
                         break;
+                    case kMix64_ChecksumType: {
+                        uint64_t bits;
+                        memcpy(&bits, buf, sizeof(bits));
+                        result = SkChecksum::Mix64(bits);
+                        break;
+                    }
                 }
             }
         }
@@ -94,3 +104,5 @@ DEF_BENCH( return new ComputeChecksumBench(kMD5_ChecksumType, 1024); )
     DEF_BENCH( return new ComputeChecksumBench(T, 1024); )
 
 DEF_CHECKSUM_BENCH(kWyhash_ChecksumType)
+
+DEF_BENCH( return new ComputeChecksumBench(kMix64_ChecksumType, 8); )
@@ -9,12 +9,15 @@
 #include "bench/CodecBenchPriv.h"
 #include "include/codec/SkCodec.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "src/core/SkOSFile.h"
 #include "tools/flags/CommandLineFlags.h"
 
 // Actually zeroing the memory would throw off timing, so we just lie.
 static DEFINE_bool(zero_init, false,
                    "Pretend our destination is zero-intialized, simulating Android?");
+static DEFINE_int(codec_threads, 0,
+                  "If > 0, pass a thread pool of this size to SkCodec::Options::fExecutor.");
 
 CodecBench::CodecBench(SkString baseName, SkData* encoded, SkColorType colorType,
         SkAlphaType alphaType)
@@ -53,6 +56,11 @@ void CodecBench::onDraw(int n, SkCanvas* canvas) {
     if (FLAGS_zero_init) {
         options.fZeroInitialized = SkCodec::kYes_ZeroInitialized;
     }
+    std::unique_ptr<SkExecutor> executor;
+    if (FLAGS_codec_threads > 0) {
+        executor = SkExecutor::MakeFIFOThreadPool(FLAGS_codec_threads);
+        options.fExecutor = executor.get();
+    }
     for (int i = 0; i < n; i++) {
         codec = SkCodec::MakeFromData(fData);
 #ifdef SK_DEBUG
@@ -10,9 +10,14 @@
 #include "bench/Benchmark.h"
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint3.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/chromium/GrDeferredDisplayListRecorder.h"
 #include "include/private/chromium/GrSurfaceCharacterization.h"
+#include "include/utils/SkShadowUtils.h"
+#include "src/core/SkTaskGroup.h"
 
 static GrSurfaceCharacterization create_characterization(GrDirectContext* direct) {
     size_t maxResourceBytes = direct->getResourceCacheLimit();
@@ -97,3 +102,86 @@ private:
 };
 
 DEF_BENCH(return new DDLRecorderBench();)
+
+// This benchmark simulates many DDL recorders tiling a page at the same time. Each thread has its
+// own DDLRecorder and draws rrect shadows, each of which looks up the shadow falloff texture in
+// the GrThreadSafeCache that all the recorders share.
+class DDLRecorderThreadsBench : public Benchmark {
+public:
+    DDLRecorderThreadsBench() { }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return Backend::kGanesh == backend; }
+
+    const char* onGetName() override { return "DDLRecorder_16threads"; }
+
+    void onDraw(int loops, SkCanvas* origCanvas) override {
+        if (fRecorders.empty()) {
+            return;
+        }
+
+        const SkPath path = SkPath::RRect(SkRect::MakeXYWH(4, 4, 20, 20), 4, 4);
+        for (int i = 0; i < loops; ++i) {
+            SkTaskGroup tasks(*fExecutor);
+            for (int thread = 0; thread < kNumThreads; ++thread) {
+                tasks.add([this, thread, &path] {
+                    GrDeferredDisplayListRecorder* recorder = fRecorders[thread].get();
+                    SkCanvas* recordingCanvas = recorder->getCanvas();
+                    for (int draw = 0; draw < kDrawsPerDDL; ++draw) {
+                        SkShadowUtils::DrawShadow(recordingCanvas,
+                                                  path,
+                                                  SkPoint3::Make(0, 0, 4),
+                                                  SkPoint3::Make(16, -16, 64),
+                                                  32,
+                                                  SK_ColorBLACK,
+                                                  SK_ColorBLACK);
+                    }
+                    fDDLs[thread].emplace_back(recorder->detach());
+                });
+            }
+            tasks.wait();
+        }
+    }
+
+private:
+    static constexpr int kNumThreads = 16;
+    static constexpr int kDrawsPerDDL = 64;
+
+    void onPerCanvasPreDraw(SkCanvas* origCanvas) override {
+        auto context = origCanvas->recordingContext()->asDirectContext();
+        if (!context) {
+            return;
+        }
+
+        GrSurfaceCharacterization c = create_characterization(context);
+        if (!c.isValid()) {
+            return;
+        }
+
+        fExecutor = SkExecutor::MakeFIFOThreadPool(kNumThreads);
+        for (int thread = 0; thread < kNumThreads; ++thread) {
+            fRecorders.push_back(std::make_unique<GrDeferredDisplayListRecorder>(c));
+        }
+        fDDLs.resize(kNumThreads);
+    }
+
+    void onPostDraw(SkCanvas*) override {
+        for (auto& ddls : fDDLs) {
+            ddls.clear();
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        fDDLs.clear();
+        fRecorders.clear();
+        fExecutor.reset();
+    }
+
+    std::unique_ptr<SkExecutor>                                  fExecutor;
+    std::vector<std::unique_ptr<GrDeferredDisplayListRecorder>>  fRecorders;
+    std::vector<std::vector<sk_sp<GrDeferredDisplayList>>>       fDDLs;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH(return new DDLRecorderThreadsBench();)
@@ -7,12 +7,15 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
 #include "include/encode/SkWebpEncoder.h"
 #include "tools/DecodeUtils.h"
 
+#include <memory>
+
 // Like other Benchmark subclasses, Encoder benchmarks are run by:
 // nanobench --match ^Encode_
 //
@@ -123,3 +126,89 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
 #undef PNG
+
+// Measures how encoding scales with the number of threads given to the encoder's executor.
+class ExecutorEncodeBench : public Benchmark {
+public:
+    using Encoder = bool (*)(SkWStream*, const SkPixmap&, SkExecutor*);
+    ExecutorEncodeBench(const char* filename, Encoder encoder, const char* encoderName, int threads)
+        : fSourceFilename(filename)
+        , fEncoder(encoder)
+        , fThreads(threads)
+        , fName(SkStringPrintf("Encode_%s_%s_threads%d", filename, encoderName, threads)) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkAssertResult(ToolUtils::GetResourceAsBitmap(fSourceFilename, &fBitmap));
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            SkPixmap pixmap;
+            SkAssertResult(fBitmap.peekPixels(&pixmap));
+            SkNullWStream dst;
+            SkAssertResult(fEncoder(&dst, pixmap, fExecutor.get()));
+            SkASSERT(dst.bytesWritten() > 0);
+        }
+    }
+
+private:
+    const char*                 fSourceFilename;
+    Encoder                     fEncoder;
+    int                         fThreads;
+    SkString                    fName;
+    SkBitmap                    fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+static bool encode_png_executor(SkWStream* dst, const SkPixmap& src, SkExecutor* executor) {
+    SkPngEncoder::Options opts;
+    opts.fExecutor = executor;
+    return SkPngEncoder::Encode(dst, src, opts);
+}
+
+static bool encode_jpeg_executor(SkWStream* dst, const SkPixmap& src, SkExecutor* executor) {
+    SkJpegEncoder::Options opts;
+    opts.fQuality = 90;
+    opts.fExecutor = executor;
+    return SkJpegEncoder::Encode(dst, src, opts);
+}
+
+static bool encode_webp_lossy_executor(SkWStream* dst, const SkPixmap& src, SkExecutor* executor) {
+    SkWebpEncoder::Options opts;
+    opts.fCompression = SkWebpEncoder::Compression::kLossy;
+    opts.fQuality = 90;
+    opts.fExecutor = executor;
+    return SkWebpEncoder::Encode(dst, src, opts);
+}
+
+static bool encode_webp_lossless_executor(SkWStream* dst,
+                                          const SkPixmap& src,
+                                          SkExecutor* executor) {
+    SkWebpEncoder::Options opts;
+    opts.fCompression = SkWebpEncoder::Compression::kLossless;
+    opts.fQuality = 90;
+    opts.fExecutor = executor;
+    return SkWebpEncoder::Encode(dst, src, opts);
+}
+
+// threads0 is the serial encoder, without an executor.
+#define EXECUTOR_BENCHES(ENCODER, NAME)                                                      \
+    DEF_BENCH(return new ExecutorEncodeBench("images/mandrill_1600.png", ENCODER, NAME, 0)); \
+    DEF_BENCH(return new ExecutorEncodeBench("images/mandrill_1600.png", ENCODER, NAME, 1)); \
+    DEF_BENCH(return new ExecutorEncodeBench("images/mandrill_1600.png", ENCODER, NAME, 2)); \
+    DEF_BENCH(return new ExecutorEncodeBench("images/mandrill_1600.png", ENCODER, NAME, 4)); \
+    DEF_BENCH(return new ExecutorEncodeBench("images/mandrill_1600.png", ENCODER, NAME, 8));
+
+EXECUTOR_BENCHES(encode_png_executor, "PNG")
+EXECUTOR_BENCHES(encode_jpeg_executor, "JPEG")
+EXECUTOR_BENCHES(encode_webp_lossy_executor, "WEBP")
+EXECUTOR_BENCHES(encode_webp_lossless_executor, "WEBP_LL")
+
+#undef EXECUTOR_BENCHES
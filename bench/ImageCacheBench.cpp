@@ -7,6 +7,7 @@
 
 #include "bench/Benchmark.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 
 namespace {
 static void* gGlobalAddress;
@@ -72,6 +73,90 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Measures hit throughput of the global (striped) cache with several threads looking up at once.
+class ImageCacheThreadedBench : public Benchmark {
+    enum {
+        CACHE_COUNT = 500,
+        THREAD_COUNT = 8,
+    };
+    // Keys distinct from any other user of gGlobalAddress.
+    static constexpr intptr_t kBase = 1 << 24;
+
+public:
+    ImageCacheThreadedBench() {}
+
+protected:
+    const char* onGetName() override {
+        return "imagecache_threaded_hits";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        // Re-add anything that has been purged since the last run.
+        for (int i = 0; i < CACHE_COUNT; ++i) {
+            TestKey key(kBase + i);
+            if (!SkResourceCache::Find(key, TestRec::Visitor, nullptr)) {
+                SkResourceCache::Add(new TestRec(key, i));
+            }
+        }
+
+        SkTaskGroup().batch(THREAD_COUNT, [&](int thread) {
+            for (int i = 0; i < loops; ++i) {
+                TestKey key(kBase + (thread * 31 + i) % CACHE_COUNT);
+                (void)SkResourceCache::Find(key, TestRec::Visitor, nullptr);
+            }
+        });
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
+// Looks up hits in the global cache from one thread per canvas; see nanobench --benchThreads.
+class ImageCacheGlobalBench : public Benchmark {
+    enum {
+        CACHE_COUNT = 500,
+    };
+    // Keys distinct from any other user of gGlobalAddress.
+    static constexpr intptr_t kBase = 1 << 25;
+
+protected:
+    const char* onGetName() override {
+        return "imagecache_global_hits";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    bool isThreadSafe() const override { return true; }
+
+    void onPreDraw(SkCanvas*) override {
+        // Re-add anything that has been purged since the last run.
+        for (int i = 0; i < CACHE_COUNT; ++i) {
+            TestKey key(kBase + i);
+            if (!SkResourceCache::Find(key, TestRec::Visitor, nullptr)) {
+                SkResourceCache::Add(new TestRec(key, i));
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            TestKey key(kBase + (i * 31) % CACHE_COUNT);
+            (void)SkResourceCache::Find(key, TestRec::Visitor, nullptr);
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ImageCacheBench(); )
+DEF_BENCH( return new ImageCacheThreadedBench(); )
+DEF_BENCH( return new ImageCacheGlobalBench(); )
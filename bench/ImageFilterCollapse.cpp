@@ -7,9 +7,11 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkImageFilter.h"
+#include "include/core/SkShader.h"
 #include "include/core/SkSurface.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/effects/SkImageFilters.h"
@@ -18,7 +20,8 @@
 // table filter image filters and draws a bitmap.
 // This bench shows an improvement in performance and memory
 // when collapsing matrices or tables is implemented since all
-// the passes are collapsed in one.
+// the passes are collapsed in one. The blend variant does the
+// same for a chain of blend image filters.
 
 class BaseImageFilterCollapseBench : public Benchmark {
 public:
@@ -34,6 +37,11 @@ protected:
         }
     }
 
+    void doPreDraw(sk_sp<SkImageFilter> imageFilter) {
+        SkASSERT(!fImageFilter);
+        fImageFilter = std::move(imageFilter);
+    }
+
     void onDraw(int loops, SkCanvas* canvas) override {
         makeBitmap();
 
@@ -131,5 +139,36 @@ protected:
     }
 };
 
+class BlendCollapseBench: public BaseImageFilterCollapseBench {
+protected:
+    const char* onGetName() override {
+        return "image_filter_collapse_blend";
+    }
+
+    void onDelayedSetup() override {
+        const SkBlendMode modes[] = {
+            SkBlendMode::kMultiply,
+            SkBlendMode::kScreen,
+            SkBlendMode::kSrcOver,
+        };
+        const SkColor colors[] = {
+            0x80FF0000,
+            0x8000FF00,
+            0x800000FF,
+        };
+
+        // Each blend takes the previous one as its background, starting from the source image.
+        sk_sp<SkImageFilter> imageFilter;
+        for (size_t i = 0; i < std::size(modes); ++i) {
+            imageFilter = SkImageFilters::Blend(
+                    modes[i],
+                    std::move(imageFilter),
+                    SkImageFilters::Shader(SkShaders::Color(colors[i])));
+        }
+        this->doPreDraw(std::move(imageFilter));
+    }
+};
+
 DEF_BENCH(return new TableCollapseBench;)
 DEF_BENCH(return new MatrixCollapseBench;)
+DEF_BENCH(return new BlendCollapseBench;)
@@ -8,7 +8,10 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkData.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "src/utils/SkJSON.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/Resources.h"
 
 #if defined(SK_BUILD_FOR_ANDROID)
 static constexpr const char* kBenchFile = "/data/local/tmp/bench.json";
@@ -18,16 +21,22 @@ static constexpr const char* kBenchFile = "/tmp/bench.json";
 
 class JsonBench : public Benchmark {
 public:
+    JsonBench() : fName("json_skjson") {}
+
+    // Parses a resource file, instead of the local bench file.
+    explicit JsonBench(const char* resource)
+        : fResource(resource)
+        , fName(SkStringPrintf("json_skjson_%s", SkOSPath::Basename(resource).c_str())) {}
 
 protected:
-    const char* onGetName() override { return "json_skjson"; }
+    const char* onGetName() override { return fName.c_str(); }
 
     bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
 
     void onPerCanvasPreDraw(SkCanvas*) override {
-        fData = SkData::MakeFromFileName(kBenchFile);
+        fData = fResource ? GetResourceAsData(fResource) : SkData::MakeFromFileName(kBenchFile);
         if (!fData) {
-            SkDebugf("!! Could not open bench file: %s\n", kBenchFile);
+            SkDebugf("!! Could not open bench file: %s\n", fResource ? fResource : kBenchFile);
         }
     }
 
@@ -48,13 +57,20 @@ protected:
     }
 
 private:
-    sk_sp<SkData> fData;
+    const char*    fResource = nullptr;
+    const SkString fName;
+    sk_sp<SkData>  fData;
 
     using INHERITED = Benchmark;
 };
 
 DEF_BENCH( return new JsonBench; )
 
+// Lottie files: pretty-printed, minified, and with embedded (base64) images.
+DEF_BENCH( return new JsonBench("skottie/skottie-text-scale-to-fit-minmax.json"); )
+DEF_BENCH( return new JsonBench("skottie/skottie-phonehub-onboard_min.json"); )
+DEF_BENCH( return new JsonBench("skottie/skottie-displacement-rgba.json"); )
+
 #if (0)
 
 #include "rapidjson/document.h"
@@ -7,10 +7,15 @@
 
 #include "bench/MSKPBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkGraphics.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrRecordingContext.h"
+#include "src/base/SkTime.h"
 #include "tools/MSKPPlayer.h"
 
+#include <algorithm>
+#include <cmath>
+
 MSKPBench::MSKPBench(SkString name, std::unique_ptr<MSKPPlayer> player)
         : fName(name), fPlayer(std::move(player)) {}
 
@@ -48,3 +53,113 @@ void MSKPBench::onPostDraw(SkCanvas*) {
     // nanobench can tear down the 3D API context/device before destroying the benchmarks.
     fPlayer->resetLayers();
 }
+
+MSKPFrameTimesBench::MSKPFrameTimesBench(SkString name,
+                                         std::unique_ptr<MSKPPlayer> player,
+                                         bool coldCache)
+        : fName(SkStringPrintf("%s_frametimes%s", name.c_str(), coldCache ? "_cold" : ""))
+        , fPlayer(std::move(player))
+        , fColdCache(coldCache) {}
+
+MSKPFrameTimesBench::~MSKPFrameTimesBench() = default;
+
+bool MSKPFrameTimesBench::isSuitableFor(Backend backend) {
+    // Waiting for the GPU needs a direct context; Graphite's is owned by the target.
+    return backend == Backend::kRaster || backend == Backend::kGanesh;
+}
+
+void MSKPFrameTimesBench::onDraw(int loops, SkCanvas* canvas) {
+    auto dContext = GrAsDirectContext(canvas->recordingContext());
+    for (int i = 0; i < loops; ++i) {
+        for (int f = 0; f < fPlayer->numFrames(); ++f) {
+            double start = SkTime::GetNSecs();
+            canvas->save();
+            canvas->clipIRect(SkIRect::MakeSize(fPlayer->frameDimensions(f)));
+            fPlayer->playFrame(canvas, f);
+            canvas->restore();
+            if (dContext) {
+                dContext->flushAndSubmit();
+            }
+            double cpuEnd = SkTime::GetNSecs();
+            if (dContext) {
+                // Returns once the GPU has finished everything submitted so far, i.e. this frame.
+                dContext->submit(GrSyncCpu::kYes);
+            }
+            double end = SkTime::GetNSecs();
+            fCpuMs.push_back((cpuEnd - start) * 1e-6);
+            fTotalMs.push_back((end - start) * 1e-6);
+        }
+        fPlayer->rewindLayers();
+    }
+}
+
+const char* MSKPFrameTimesBench::onGetName() { return fName.c_str(); }
+
+SkISize MSKPFrameTimesBench::onGetSize() {
+    auto dims = fPlayer->maxDimensions();
+    return {dims.width(), dims.height()};
+}
+
+void MSKPFrameTimesBench::onPerCanvasPreDraw(SkCanvas*) {
+    fCpuMs.clear();
+    fTotalMs.clear();
+}
+
+void MSKPFrameTimesBench::onPreDraw(SkCanvas* canvas) {
+    if (fColdCache) {
+        SkGraphics::PurgeAllCaches();
+        if (auto dContext = GrAsDirectContext(canvas->recordingContext())) {
+            dContext->freeGpuResources();
+        }
+    }
+    fPlayer->allocateLayers(canvas);
+}
+
+void MSKPFrameTimesBench::onPostDraw(SkCanvas*) {
+    fPlayer->resetLayers();
+}
+
+void MSKPFrameTimesBench::getMetrics(skia_private::TArray<SkString>* keys,
+                                     skia_private::TArray<double>* values) {
+    if (fTotalMs.empty()) {
+        return;
+    }
+    keys->push_back(SkString("frames"));
+    values->push_back(fTotalMs.size());
+
+    auto addPercentiles = [&](const char* prefix, skia_private::TArray<double> ms) {
+        std::sort(ms.begin(), ms.end());
+        static constexpr struct {
+            const char* fName;
+            double fPercentile;
+        } kPercentiles[] = {{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"p999", 0.999}};
+        for (const auto& [name, percentile] : kPercentiles) {
+            // Nearest rank, so p99 of fewer than 100 frames is the slowest frame.
+            int rank = std::max(0, (int)std::ceil(percentile * ms.size()) - 1);
+            keys->push_back(SkStringPrintf("%s_%s_ms", prefix, name));
+            values->push_back(ms[rank]);
+        }
+        keys->push_back(SkStringPrintf("%s_max_ms", prefix));
+        values->push_back(ms.back());
+    };
+    addPercentiles("cpu", fCpuMs);
+    addPercentiles("frame", fTotalMs);
+
+    // Frame counts by total time, in buckets that double from a quarter of a 60Hz frame.
+    static constexpr int kBucketLimitsMs[] = {4, 8, 16, 32, 64};
+    static constexpr int kBucketCount = std::size(kBucketLimitsMs);
+    int counts[kBucketCount + 1] = {};
+    for (double ms : fTotalMs) {
+        int bucket = 0;
+        while (bucket < kBucketCount && ms > kBucketLimitsMs[bucket]) {
+            ++bucket;
+        }
+        counts[bucket]++;
+    }
+    for (int i = 0; i < kBucketCount; ++i) {
+        keys->push_back(SkStringPrintf("frames_le_%dms", kBucketLimitsMs[i]));
+        values->push_back(counts[i]);
+    }
+    keys->push_back(SkStringPrintf("frames_gt_%dms", kBucketLimitsMs[kBucketCount - 1]));
+    values->push_back(counts[kBucketCount]);
+}
@@ -9,6 +9,7 @@
 #define MSKPBench_DEFINED
 
 #include "bench/Benchmark.h"
+#include "include/private/base/SkTArray.h"
 
 class MSKPPlayer;
 
@@ -29,4 +30,37 @@ private:
     std::unique_ptr<MSKPPlayer> fPlayer;
 };
 
+/**
+ * Plays an MSKP's frames once per loop like MSKPBench, but times each frame by itself and reports
+ * the distribution of frame times (percentiles and a histogram) through getMetrics(). Each frame's
+ * CPU time covers recording and submitting it; its total time also waits for the GPU to finish it.
+ *
+ * The cold cache variant purges Skia's caches and the GPU context's resources before each pass
+ * over the frames, so every pass pays for cache misses and pipeline compiles again.
+ */
+class MSKPFrameTimesBench : public Benchmark {
+public:
+    MSKPFrameTimesBench(SkString name, std::unique_ptr<MSKPPlayer> player, bool coldCache);
+    ~MSKPFrameTimesBench() override;
+
+    void getMetrics(skia_private::TArray<SkString>* keys,
+                    skia_private::TArray<double>* values) override;
+
+protected:
+    bool isSuitableFor(Backend backend) override;
+    void onDraw(int loops, SkCanvas*) override;
+    const char* onGetName() override;
+    SkISize onGetSize() override;
+    void onPerCanvasPreDraw(SkCanvas*) override;
+    void onPreDraw(SkCanvas*) override;
+    void onPostDraw(SkCanvas*) override;
+
+private:
+    SkString fName;
+    std::unique_ptr<MSKPPlayer> fPlayer;
+    const bool fColdCache;
+    skia_private::TArray<double> fCpuMs;
+    skia_private::TArray<double> fTotalMs;
+};
+
 #endif
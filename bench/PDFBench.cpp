@@ -78,11 +78,15 @@ DEF_BENCH(return new PDFScalarBench("PDFScalar_random", next_any);)
 
 #ifdef SK_SUPPORT_PDF
 
+#include "src/pdf/SkDeflate.h"
 #include "src/pdf/SkPDFBitmap.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 #include "src/pdf/SkPDFShader.h"
 #include "src/pdf/SkPDFUtils.h"
 
+#include <optional>
+#include <vector>
+
 namespace {
 class PDFImageBench : public Benchmark {
 public:
@@ -187,6 +191,56 @@ private:
     std::unique_ptr<SkStreamAsset> fAsset;
 };
 
+/** Compresses 4MB of image-like data with SkDeflateWStream: as one zlib stream, in independent
+    blocks on this thread, and in independent blocks spread over a thread pool. */
+class PDFDeflateBench : public Benchmark {
+public:
+    enum class Mode { kStream, kBlocks, kThreadedBlocks };
+    explicit PDFDeflateBench(Mode mode) : fMode(mode) {}
+
+protected:
+    const char* onGetName() override {
+        switch (fMode) {
+            case Mode::kStream:         return "PDFDeflate_stream";
+            case Mode::kBlocks:         return "PDFDeflate_blocks";
+            case Mode::kThreadedBlocks: return "PDFDeflate_blocks_threaded";
+        }
+        SkUNREACHABLE;
+    }
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+    void onDelayedSetup() override {
+        // Smooth gradients with a little noise compress about as well as photographs.
+        SkRandom random;
+        fData.resize(4 << 20);
+        for (size_t i = 0; i < fData.size(); ++i) {
+            fData[i] = SkToU8((i % 1024) / 4 + (random.nextU() & 7));
+        }
+        if (fMode == Mode::kThreadedBlocks) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            SkNullWStream wStream;
+            std::optional<SkDeflateWStream> deflate;
+            if (fMode == Mode::kStream) {
+                deflate.emplace(&wStream, -1);
+            } else {
+                deflate.emplace(&wStream, -1, /*gzip=*/false, fExecutor.get());
+            }
+            deflate->write(fData.data(), fData.size());
+            deflate->finalize();
+        }
+    }
+
+private:
+    Mode fMode;
+    std::vector<uint8_t> fData;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
 struct PDFColorComponentBench : public Benchmark {
     bool isSuitableFor(Backend b) override {
         return b == Backend::kNonRendering;
@@ -309,6 +363,9 @@ struct PDFClipPathBenchmark : public Benchmark {
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
 DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFDeflateBench(PDFDeflateBench::Mode::kStream);)
+DEF_BENCH(return new PDFDeflateBench(PDFDeflateBench::Mode::kBlocks);)
+DEF_BENCH(return new PDFDeflateBench(PDFDeflateBench::Mode::kThreadedBlocks);)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
@@ -19,20 +19,45 @@
 #include "include/private/base/SkTDArray.h"
 #include "src/base/SkRandom.h"
 
+#include "src/core/SkBlitter.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkMatrixPriv.h"
+#include "src/core/SkScan.h"
 
 using namespace skia_private;
 
 enum Flags {
     kStroke_Flag = 1 << 0,
-    kBig_Flag    = 1 << 1
+    kBig_Flag    = 1 << 1,
+    // The next two only scan convert the fill, with SkScan_SparseAAPath or with AAA, into a
+    // blitter that just sums coverage, so the two can be compared side by side.
+    kSparse_Flag = 1 << 2,
+    kAAA_Flag    = 1 << 3,
 };
 
 #define FLAGS00  Flags(0)
 #define FLAGS01  Flags(kStroke_Flag)
 #define FLAGS10  Flags(kBig_Flag)
 #define FLAGS11  Flags(kStroke_Flag | kBig_Flag)
+#define FLAGS_SPARSE00  Flags(kSparse_Flag)
+#define FLAGS_SPARSE10  Flags(kSparse_Flag | kBig_Flag)
+#define FLAGS_AAA00  Flags(kAAA_Flag)
+#define FLAGS_AAA10  Flags(kAAA_Flag | kBig_Flag)
+
+namespace {
+class CoverageSumBlitter : public SkBlitter {
+public:
+    void blitH(int x, int y, int width) override { fSum += 0xFF * width; }
+
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override {
+        for (int i = 0; runs[i]; i += runs[i]) {
+            fSum += antialias[i] * runs[i];
+        }
+    }
+
+    uint64_t fSum = 0;
+};
+}  // namespace
 
 class PathBench : public Benchmark {
     SkPaint     fPaint;
@@ -56,6 +81,11 @@ protected:
                      fFlags & kStroke_Flag ? "stroke" : "fill",
                      fFlags & kBig_Flag ? "big" : "small");
         this->appendName(&fName);
+        if (fFlags & kSparse_Flag) {
+            fName.append("_sparse");
+        } else if (fFlags & kAAA_Flag) {
+            fName.append("_aaa");
+        }
         return fName.c_str();
     }
 
@@ -70,6 +100,20 @@ protected:
             path.transform(m);
         }
 
+        if (fFlags & (kSparse_Flag | kAAA_Flag)) {
+            const SkIRect pathIR = path.getBounds().roundOut();
+            const SkIRect clipBounds = SkIRect::MakeSize(canvas->getBaseLayerSize());
+            CoverageSumBlitter blitter;
+            for (int i = 0; i < loops; i++) {
+                if (fFlags & kSparse_Flag) {
+                    SkScan::SparseAAFillPath(path, &blitter, pathIR, clipBounds);
+                } else {
+                    SkScan::AAAFillPath(path, &blitter, pathIR, clipBounds, false);
+                }
+            }
+            return;
+        }
+
         for (int i = 0; i < loops; i++) {
             canvas->drawPath(path, paint);
         }
@@ -1199,6 +1243,24 @@ DEF_BENCH( return new LongCurvedPathBench(FLAGS01); )
 DEF_BENCH( return new LongLinePathBench(FLAGS00); )
 DEF_BENCH( return new LongLinePathBench(FLAGS01); )
 
+// Scan conversion alone, sparse AA against AAA.
+DEF_BENCH( return new CirclePathBench(FLAGS_SPARSE00); )
+DEF_BENCH( return new CirclePathBench(FLAGS_SPARSE10); )
+DEF_BENCH( return new AAAConcavePathBench(FLAGS_SPARSE00); )
+DEF_BENCH( return new AAAConcavePathBench(FLAGS_SPARSE10); )
+DEF_BENCH( return new SawToothPathBench(FLAGS_SPARSE00); )
+DEF_BENCH( return new SawToothPathBench(FLAGS_SPARSE10); )
+DEF_BENCH( return new LongCurvedPathBench(FLAGS_SPARSE00); )
+DEF_BENCH( return new LongLinePathBench(FLAGS_SPARSE00); )
+DEF_BENCH( return new CirclePathBench(FLAGS_AAA00); )
+DEF_BENCH( return new CirclePathBench(FLAGS_AAA10); )
+DEF_BENCH( return new AAAConcavePathBench(FLAGS_AAA00); )
+DEF_BENCH( return new AAAConcavePathBench(FLAGS_AAA10); )
+DEF_BENCH( return new SawToothPathBench(FLAGS_AAA00); )
+DEF_BENCH( return new SawToothPathBench(FLAGS_AAA10); )
+DEF_BENCH( return new LongCurvedPathBench(FLAGS_AAA00); )
+DEF_BENCH( return new LongLinePathBench(FLAGS_AAA00); )
+
 DEF_BENCH( return new PathCreateBench(); )
 DEF_BENCH( return new PathCopyBench(); )
 DEF_BENCH( return new PathTransformBench(true); )
@@ -1228,6 +1290,73 @@ DEF_BENCH( return new TightBoundsBench([](const SkPath& path) {
         SkRect bounds; TightBounds(path, &bounds); return bounds;
     }, "pathops"); )
 
+// The per-point passes over a 100k point polygon: bounds, transform and convexity.
+class LargePathBench : public Benchmark {
+public:
+    enum class Op { kBounds, kTransform, kConvexity };
+
+    LargePathBench(Op op) : fOp(op) {
+        static const char* kNames[] = { "bounds", "transform", "convexity" };
+        fName.printf("large_path_%s", kNames[(int)op]);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        const int N = 100000;
+        SkRandom rand;
+        for (int i = 0; i < N; ++i) {
+            SkScalar angle = SK_ScalarPI * 2 * i / N,
+                     radius = 100 + rand.nextF();
+            SkPoint pt = {radius * SkScalarCos(angle), radius * SkScalarSin(angle)};
+            if (i == 0) {
+                fPath.moveTo(pt);
+            } else {
+                fPath.lineTo(pt);
+            }
+        }
+        fPath.close();
+        fMatrix.setRotate(30);
+        fMatrix.postScale(2, 3);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPath dst;
+        for (int i = 0; i < loops; ++i) {
+            switch (fOp) {
+                case Op::kBounds:
+                    fBounds.setBounds(SkPathPriv::PointData(fPath), fPath.countPoints());
+                    break;
+                case Op::kTransform:
+                    fPath.transform(fMatrix, &dst);
+                    fBounds = dst.getBounds();
+                    break;
+                case Op::kConvexity:
+                    SkPathPriv::ForceComputeConvexity(fPath);
+                    fConvex = fPath.isConvex();
+                    break;
+            }
+        }
+    }
+
+private:
+    const Op fOp;
+    SkString fName;
+    SkPath   fPath;
+    SkMatrix fMatrix;
+    SkRect   fBounds;
+    bool     fConvex;
+};
+
+DEF_BENCH( return new LargePathBench(LargePathBench::Op::kBounds); )
+DEF_BENCH( return new LargePathBench(LargePathBench::Op::kTransform); )
+DEF_BENCH( return new LargePathBench(LargePathBench::Op::kConvexity); )
+
 // These seem to be optimized away, which is troublesome for timing.
 /*
 DEF_BENCH( return new ConicBench_Chop5() )
@@ -94,6 +94,69 @@ static SkPath makerects() {
 }
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
 
+// One long contour whose two sides weave across each other, so most of its segments are far apart.
+static SkPath makewave() {
+    SkPath path;
+    path.moveTo(0, 0);
+    for (int i = 0; i < 5000; ++i) {
+        path.lineTo(i * 0.5f, 100 + 20 * SkScalarSin(i * 0.1f));
+    }
+    for (int i = 5000; i >= 0; --i) {
+        path.lineTo(i * 0.5f, 110 + 20 * SkScalarCos(i * 0.07f));
+    }
+    path.close();
+    return path;
+}
+DEF_BENCH( return new PathOpsSimplifyBench("wave", makewave()); )
+
+// Unions many overlapping concave paths, which SkOpBuilder can't just sum and simplify.
+class PathOpsBuilderUnionBench : public Benchmark {
+    SkString                     fName;
+    skia_private::TArray<SkPath> fPaths;
+
+public:
+    PathOpsBuilderUnionBench(int count) {
+        fName.printf("pathops_builder_union_%d", count);
+        SkRandom rand;
+        SkScalar scale = SkScalarSqrt(count) * 4;
+        for (int i = 0; i < count; ++i) {
+            SkScalar x = rand.nextUScalar1() * scale;
+            SkScalar y = rand.nextUScalar1() * scale;
+            SkPath& path = fPaths.push_back();
+            path.moveTo(x, y);
+            path.lineTo(x + 6, y + 3);
+            path.lineTo(x, y + 6);
+            path.lineTo(x + 2, y + 3);
+            path.close();
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkOpBuilder builder;
+            for (const SkPath& path : fPaths) {
+                builder.add(path, kUnion_SkPathOp);
+            }
+            SkPath result;
+            builder.resolve(&result);
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new PathOpsBuilderUnionBench(100); )
+DEF_BENCH( return new PathOpsBuilderUnionBench(10000); )
+
 #include "include/core/SkPathBuilder.h"
 
 template <size_t N> struct ArrayPath {
@@ -9,6 +9,9 @@
 #include "include/core/SkCanvas.h"
 #include "src/base/SkRandom.h"
 
+#include <algorithm>
+#include <iterator>
+
 class QuickRejectBench : public Benchmark {
     enum { N = 1000000 };
     float fFloats[N];
@@ -38,6 +41,53 @@ class QuickRejectBench : public Benchmark {
 };
 DEF_BENCH( return new QuickRejectBench; )
 
+// Culls the same rects one at a time with quickReject(), or together with quickRejectRects().
+class QuickRejectRectsBench : public Benchmark {
+    enum { N = 250000 };
+    SkRect   fRects[N];
+    uint32_t fVisible[(N + 31) / 32];
+    bool     fBatched;
+
+    const char* onGetName() override {
+        return fBatched ? "quick_reject_rects_batched" : "quick_reject_rects";
+    }
+    bool isSuitableFor(Backend backend) override { return backend != Backend::kNonRendering; }
+
+    void onDelayedSetup() override  {
+        SkRandom rand;
+        for (SkRect& r : fRects) {
+            r = SkRect::MakeXYWH(300.0f * (rand.nextSScalar1() + 0.5f),
+                                 300.0f * (rand.nextSScalar1() + 0.5f),
+                                 rand.nextRangeF(1, 10),
+                                 rand.nextRangeF(1, 10));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkMatrix matrix = SkMatrix::Scale(1.5f, 1.5f);
+        while (loops --> 0) {
+            if (fBatched) {
+                canvas->quickRejectRects(fRects, matrix, fVisible);
+            } else {
+                canvas->save();
+                canvas->concat(matrix);
+                std::fill(std::begin(fVisible), std::end(fVisible), 0);
+                for (int i = 0; i < N; i++) {
+                    if (!canvas->quickReject(fRects[i])) {
+                        fVisible[i / 32] |= 1u << (i % 32);
+                    }
+                }
+                canvas->restore();
+            }
+        }
+    }
+
+public:
+    explicit QuickRejectRectsBench(bool batched) : fBatched(batched) {}
+};
+DEF_BENCH( return new QuickRejectRectsBench(false); )
+DEF_BENCH( return new QuickRejectRectsBench(true); )
+
 class ConcatBench : public Benchmark {
     SkMatrix fMatrix;
 
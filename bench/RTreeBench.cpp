@@ -18,6 +18,8 @@ using namespace skia_private;
 static const SkScalar GENERATE_EXTENTS = 1000.0f;
 static const int NUM_BUILD_RECTS = 500;
 static const int NUM_QUERY_RECTS = 5000;
+// Big enough that the tree gets sorted, like the ones for SKPs with lots of ops.
+static const int NUM_LARGE_RECTS = 100000;
 static const int GRID_WIDTH = 100;
 
 typedef SkRect (*MakeRectProc)(SkRandom&, int, int);
@@ -25,7 +27,8 @@ typedef SkRect (*MakeRectProc)(SkRandom&, int, int);
 // Time how long it takes to build an R-Tree.
 class RTreeBuildBench : public Benchmark {
 public:
-    RTreeBuildBench(const char* name, MakeRectProc proc) : fProc(proc) {
+    RTreeBuildBench(const char* name, MakeRectProc proc, int numRects = NUM_BUILD_RECTS)
+            : fProc(proc), fNumRects(numRects) {
         fName.printf("rtree_%s_build", name);
     }
 
@@ -39,18 +42,19 @@ protected:
     }
     void onDraw(int loops, SkCanvas* canvas) override {
         SkRandom rand;
-        AutoTArray<SkRect> rects(NUM_BUILD_RECTS);
-        for (int i = 0; i < NUM_BUILD_RECTS; ++i) {
-            rects[i] = fProc(rand, i, NUM_BUILD_RECTS);
+        AutoTArray<SkRect> rects(fNumRects);
+        for (int i = 0; i < fNumRects; ++i) {
+            rects[i] = fProc(rand, i, fNumRects);
         }
 
         for (int i = 0; i < loops; ++i) {
             SkRTree tree;
-            tree.insert(rects.data(), NUM_BUILD_RECTS);
+            tree.insert(rects.data(), fNumRects);
         }
     }
 private:
     MakeRectProc fProc;
+    int fNumRects;
     SkString fName;
     using INHERITED = Benchmark;
 };
@@ -58,7 +62,8 @@ private:
 // Time how long it takes to perform queries on an R-Tree.
 class RTreeQueryBench : public Benchmark {
 public:
-    RTreeQueryBench(const char* name, MakeRectProc proc) : fProc(proc) {
+    RTreeQueryBench(const char* name, MakeRectProc proc, int numRects = NUM_QUERY_RECTS)
+            : fProc(proc), fNumRects(numRects) {
         fName.printf("rtree_%s_query", name);
     }
 
@@ -71,11 +76,11 @@ protected:
     }
     void onDelayedSetup() override {
         SkRandom rand;
-        AutoTArray<SkRect> rects(NUM_QUERY_RECTS);
-        for (int i = 0; i < NUM_QUERY_RECTS; ++i) {
-            rects[i] = fProc(rand, i, NUM_QUERY_RECTS);
+        AutoTArray<SkRect> rects(fNumRects);
+        for (int i = 0; i < fNumRects; ++i) {
+            rects[i] = fProc(rand, i, fNumRects);
         }
-        fTree.insert(rects.data(), NUM_QUERY_RECTS);
+        fTree.insert(rects.data(), fNumRects);
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
@@ -93,6 +98,7 @@ protected:
 private:
     SkRTree fTree;
     MakeRectProc fProc;
+    int fNumRects;
     SkString fName;
     using INHERITED = Benchmark;
 };
@@ -138,3 +144,8 @@ DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
 DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
 DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects));
+
+DEF_BENCH(return new RTreeBuildBench("XY_100k", &make_XYordered_rects, NUM_LARGE_RECTS));
+DEF_BENCH(return new RTreeBuildBench("random_100k", &make_random_rects, NUM_LARGE_RECTS));
+DEF_BENCH(return new RTreeQueryBench("XY_100k", &make_XYordered_rects, NUM_LARGE_RECTS));
+DEF_BENCH(return new RTreeQueryBench("random_100k", &make_random_rects, NUM_LARGE_RECTS));
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/core/SkRasterPipelineOpList.h"
+
+#include <cstdint>
+
+// Runs the stages that dominate raster blits and pixel conversions over one long row, so that
+// changes to the SkRasterPipeline_opts.h backends (and their lane counts) show up directly.
+// The row length is deliberately not a multiple of any stride to exercise the tail.
+static constexpr int kWidth = 1023;
+
+class RasterPipelineBench : public Benchmark {
+public:
+    enum class Mode {
+        kBlit_8888,       // load_8888, load_8888_dst, srcover, store_8888
+        kBlitA8_8888,     // load_8888, scale_u8, load_8888_dst, srcover, store_8888
+        kConvert_F16,     // load_f16, store_8888 (there is no lowp load_f16)
+        kConvert_8888,    // load_8888, swap_rb, store_8888
+    };
+
+    RasterPipelineBench(Mode mode, bool forceHighp) : fMode(mode), fForceHighp(forceHighp) {
+        const char* modeName = "";
+        switch (mode) {
+            case Mode::kBlit_8888:    modeName = "blit_8888";    break;
+            case Mode::kBlitA8_8888:  modeName = "blit_a8_8888"; break;
+            case Mode::kConvert_F16:  modeName = "convert_f16";  break;
+            case Mode::kConvert_8888: modeName = "convert_8888"; break;
+        }
+        fName.printf("SkRasterPipeline_%s_%s", modeName, forceHighp ? "highp" : "lowp");
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kWidth; ++i) {
+            fSrc8888[i] = 0x80402010u * (uint32_t)(i + 1);
+            fDst8888[i] = 0xff808080u;
+            fMask[i]    = (uint8_t)i;
+            fSrcF16[i]  = 0x3c003800'34003000ull;  // 1.0, 0.5, 0.25, 0.125
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkRasterPipeline_MemoryCtx src8888 = {fSrc8888, 0},
+                                   dst8888 = {fDst8888, 0},
+                                   mask    = {fMask,    0},
+                                   srcF16  = {fSrcF16,  0};
+
+        SkSTArenaAlloc<256> alloc;
+        SkRasterPipeline p(&alloc);
+        switch (fMode) {
+            case Mode::kBlit_8888:
+                p.append(SkRasterPipelineOp::load_8888, &src8888);
+                p.append(SkRasterPipelineOp::load_8888_dst, &dst8888);
+                p.append(SkRasterPipelineOp::srcover);
+                p.append(SkRasterPipelineOp::store_8888, &dst8888);
+                break;
+            case Mode::kBlitA8_8888:
+                p.append(SkRasterPipelineOp::load_8888, &src8888);
+                p.append(SkRasterPipelineOp::scale_u8, &mask);
+                p.append(SkRasterPipelineOp::load_8888_dst, &dst8888);
+                p.append(SkRasterPipelineOp::srcover);
+                p.append(SkRasterPipelineOp::store_8888, &dst8888);
+                break;
+            case Mode::kConvert_F16:
+                p.append(SkRasterPipelineOp::load_f16, &srcF16);
+                p.append(SkRasterPipelineOp::store_8888, &dst8888);
+                break;
+            case Mode::kConvert_8888:
+                p.append(SkRasterPipelineOp::load_8888, &src8888);
+                p.append(SkRasterPipelineOp::swap_rb);
+                p.append(SkRasterPipelineOp::store_8888, &dst8888);
+                break;
+        }
+        if (fForceHighp) {
+            // Lowp has no dither stage, so this pins the pipeline to highp. A zero rate leaves
+            // the output unchanged.
+            static constexpr float kNoDither = 0.0f;
+            p.append(SkRasterPipelineOp::dither, &kNoDither);
+        }
+
+        auto fn = p.compile();
+        while (loops --> 0) {
+            fn(0, 0, kWidth, 1);
+        }
+    }
+
+private:
+    Mode     fMode;
+    bool     fForceHighp;
+    SkString fName;
+
+    uint32_t fSrc8888[kWidth];
+    uint32_t fDst8888[kWidth];
+    uint8_t  fMask   [kWidth];
+    uint64_t fSrcF16 [kWidth];
+};
+
+using Mode = RasterPipelineBench::Mode;
+DEF_BENCH(return new RasterPipelineBench(Mode::kBlit_8888,    /*forceHighp=*/false);)
+DEF_BENCH(return new RasterPipelineBench(Mode::kBlit_8888,    /*forceHighp=*/true);)
+DEF_BENCH(return new RasterPipelineBench(Mode::kBlitA8_8888,  /*forceHighp=*/false);)
+DEF_BENCH(return new RasterPipelineBench(Mode::kBlitA8_8888,  /*forceHighp=*/true);)
+DEF_BENCH(return new RasterPipelineBench(Mode::kConvert_F16,  /*forceHighp=*/true);)
+DEF_BENCH(return new RasterPipelineBench(Mode::kConvert_8888, /*forceHighp=*/false);)
+DEF_BENCH(return new RasterPipelineBench(Mode::kConvert_8888, /*forceHighp=*/true);)
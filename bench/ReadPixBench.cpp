@@ -10,6 +10,10 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrRecordingContext.h"
+#include "include/gpu/ganesh/GrStreamingReadback.h"
 
 // Time variants of read-pixels
 //  [ colortype ][ alphatype ][ colorspace ]
@@ -64,6 +68,69 @@ DEF_BENCH( return new ReadPixBench(kBGRA_8888_SkColorType, kUnpremul_SkAlphaType
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// Streams async readbacks of the canvas' surface through a GrStreamingReadback that keeps up to
+// fFramesInFlight reads outstanding, like a video-capture pipeline.
+class StreamingReadPixBench : public Benchmark {
+public:
+    StreamingReadPixBench(int framesInFlight) : fFramesInFlight(framesInFlight) {
+        fName.printf("readpix_streaming_%d", framesInFlight);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kGanesh;
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        auto dContext = GrAsDirectContext(canvas->recordingContext());
+        SkSurface* surface = canvas->getSurface();
+        if (!dContext || !surface) {
+            return;
+        }
+        auto readback = GrStreamingReadback::Make(dContext, fFramesInFlight);
+        if (!readback) {
+            return;
+        }
+
+        SkImageInfo info = surface->imageInfo().makeColorType(kRGBA_8888_SkColorType);
+        auto frameDone = [](SkImage::ReadPixelsContext c,
+                            std::unique_ptr<const SkImage::AsyncReadResult> result) {
+            // Touch the mapped pixels as a consumer would, then release the result so its
+            // transfer buffer goes back to the pool.
+            if (result) {
+                *static_cast<uint32_t*>(c) += *static_cast<const uint32_t*>(result->data(0));
+            }
+        };
+        uint32_t checksum = 0;
+        for (int i = 0; i < loops; i++) {
+            canvas->clear(i & 1 ? SK_ColorRED : SK_ColorBLUE);
+            while (!readback->readFrame(surface, info, SkIRect::MakeSize(info.dimensions()),
+                                        SkImage::RescaleGamma::kSrc,
+                                        SkImage::RescaleMode::kNearest,
+                                        frameDone, &checksum)) {
+                // Every frame is in flight; wait for the GPU to deliver the oldest one.
+                dContext->checkAsyncWorkCompletion();
+            }
+            dContext->submit();
+        }
+        dContext->submit(GrSyncCpu::kYes);
+        dContext->checkAsyncWorkCompletion();
+    }
+
+private:
+    int fFramesInFlight;
+    SkString fName;
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new StreamingReadPixBench(1); )
+DEF_BENCH( return new StreamingReadPixBench(3); )
+
+////////////////////////////////////////////////////////////////////////////////
+
 class PixmapOrientBench : public Benchmark {
 public:
     PixmapOrientBench() {}
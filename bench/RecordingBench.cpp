@@ -34,16 +34,21 @@ SkISize PictureCentricBench::onGetSize() {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-RecordingBench::RecordingBench(const char* name, const SkPicture* pic, bool useBBH)
+RecordingBench::RecordingBench(const char* name,
+                               const SkPicture* pic,
+                               bool useBBH,
+                               uint32_t recordFlags)
     : INHERITED(name, pic)
     , fUseBBH(useBBH)
+    , fRecordFlags(recordFlags)
 {}
 
 void RecordingBench::onDraw(int loops, SkCanvas*) {
     SkRTreeFactory factory;
     SkPictureRecorder recorder;
     while (loops --> 0) {
-        fSrc->playback(recorder.beginRecording(fSrc->cullRect(), fUseBBH ? &factory : nullptr));
+        fSrc->playback(recorder.beginRecording(fSrc->cullRect(), fUseBBH ? &factory : nullptr,
+                                               fRecordFlags));
         (void)recorder.finishRecordingAsPicture();
     }
 }
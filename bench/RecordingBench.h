@@ -29,13 +29,14 @@ protected:
 
 class RecordingBench : public PictureCentricBench {
 public:
-    RecordingBench(const char* name, const SkPicture*, bool useBBH);
+    RecordingBench(const char* name, const SkPicture*, bool useBBH, uint32_t recordFlags = 0);
 
 protected:
     void onDraw(int loops, SkCanvas*) override;
 
 private:
     bool fUseBBH;
+    uint32_t fRecordFlags;
 
     using INHERITED = PictureCentricBench;
 };
@@ -7,6 +7,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkRegion.h"
 #include "include/core/SkString.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkRandom.h"
 
 static bool union_proc(SkRegion& a, SkRegion& b) {
@@ -116,6 +117,47 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Builds a region from many small, mostly disjoint rects, like damage accumulated over a frame,
+// either with one setRects() call or with one union op() per rect.
+class RegionSetRectsBench : public Benchmark {
+public:
+    RegionSetRectsBench(int count, bool bulk) : fBulk(bulk) {
+        fName.printf("region_%s_%d", bulk ? "setrects" : "unionrects", count);
+
+        SkRandom rand;
+        for (int i = 0; i < count; i++) {
+            int x = rand.nextU() % 2048;
+            int y = rand.nextU() % 2048;
+            fRects.push_back(SkIRect::MakeXYWH(x, y, 1 + rand.nextU() % 64, 1 + rand.nextU() % 64));
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            SkRegion rgn;
+            if (fBulk) {
+                rgn.setRects(fRects.data(), fRects.size());
+            } else {
+                for (const SkIRect& r : fRects) {
+                    rgn.op(r, SkRegion::kUnion_Op);
+                }
+            }
+        }
+    }
+
+private:
+    skia_private::TArray<SkIRect> fRects;
+    SkString fName;
+    bool fBulk;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #define SMALL   16
@@ -129,3 +171,10 @@ DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+
+DEF_BENCH(return new RegionBench(256, union_proc, "union");)
+DEF_BENCH(return new RegionBench(256, diffrect_proc, "differencerect");)
+DEF_BENCH(return new RegionSetRectsBench(64, false);)
+DEF_BENCH(return new RegionSetRectsBench(64, true);)
+DEF_BENCH(return new RegionSetRectsBench(1024, false);)
+DEF_BENCH(return new RegionSetRectsBench(1024, true);)
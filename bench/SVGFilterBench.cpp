@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+
+#if defined(SK_ENABLE_SVG)
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "modules/svg/include/SkSVGDOM.h"
+
+#include <cstring>
+
+// Renders an SVG DOM whose shapes use <filter>s each loop, so the time includes resolving the
+// filter DAGs as well as evaluating them.
+class SVGFilterBench : public Benchmark {
+public:
+    SVGFilterBench(const char* name, const char* filter) : fName(name) {
+        fSVG.printf("<svg xmlns='http://www.w3.org/2000/svg' width='256' height='256'>"
+                    "  <filter id='f' x='0' y='0' width='1' height='1'>%s</filter>",
+                    filter);
+        // Many shapes share the same filter, as in icon sheets.
+        for (int y = 0; y < 256; y += 32) {
+            for (int x = 0; x < 256; x += 32) {
+                fSVG.appendf("<rect x='%d' y='%d' width='24' height='24' fill='#4080c0'"
+                             "      filter='url(#f)'/>", x, y);
+            }
+        }
+        fSVG.append("</svg>");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    SkISize onGetSize() override { return {256, 256}; }
+
+    void onDelayedSetup() override {
+        SkMemoryStream stream(fSVG.c_str(), fSVG.size());
+        fDOM = SkSVGDOM::MakeFromStream(stream);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            fDOM->render(canvas);
+        }
+    }
+
+private:
+    SkString        fName;
+    SkString        fSVG;
+    sk_sp<SkSVGDOM> fDOM;
+};
+
+DEF_BENCH(return new SVGFilterBench("svg_filter_blur",
+                                    "<feGaussianBlur stdDeviation='2'/>");)
+
+// Two independent blurred branches, merged.
+DEF_BENCH(return new SVGFilterBench(
+        "svg_filter_blur_merge",
+        "<feGaussianBlur in='SourceGraphic' stdDeviation='1' result='a'/>"
+        "<feGaussianBlur in='SourceAlpha' stdDeviation='3' result='b'/>"
+        "<feOffset in='b' dx='2' dy='2' result='c'/>"
+        "<feComposite in='a' in2='c' operator='over'/>");)
+
+DEF_BENCH(return new SVGFilterBench(
+        "svg_filter_lighting",
+        "<feDiffuseLighting in='SourceAlpha' surfaceScale='2' lighting-color='white'>"
+        "  <feDistantLight azimuth='45' elevation='45'/>"
+        "</feDiffuseLighting>");)
+
+DEF_BENCH(return new SVGFilterBench(
+        "svg_filter_turbulence",
+        "<feTurbulence baseFrequency='0.05' numOctaves='2'/>"
+        "<feComposite in2='SourceAlpha' operator='in'/>");)
+
+#endif  // defined(SK_ENABLE_SVG)
@@ -5,11 +5,19 @@
 
 #if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
 #include "modules/skshaper/include/SkShaper.h"
 #include "tools/Resources.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+#include "modules/skshaper/include/SkShaper_harfbuzz.h"
+#endif
+
 #include <cfloat>
+#include <memory>
+#include <vector>
 
 namespace {
 struct ShaperBench : public Benchmark {
@@ -36,6 +44,45 @@ struct ShaperBench : public Benchmark {
         }
     }
 };
+
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+// Shapes the cells of a data grid: many short strings in one font.
+struct ShaperBatchBench : public Benchmark {
+    ShaperBatchBench(int threads)
+            : fThreads(threads)
+            , fName(threads ? SkStringPrintf("shaper_batch_threads_%d", threads)
+                            : SkString("shaper_batch")) {}
+    inline static constexpr int kCells = 2000;
+    const int fThreads;
+    const SkString fName;
+    std::vector<SkString> fTexts;
+    std::vector<SkShapers::HB::BatchItem> fItems;
+    std::unique_ptr<SkExecutor> fExecutor;
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override {
+        if (fThreads) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+        const SkFont font = ToolUtils::DefaultFont();
+        for (int i = 0; i < kCells; ++i) {
+            fTexts.push_back(SkStringPrintf("Row %d, $%d.%02d", i / 8, i * 37, i % 100));
+        }
+        for (const SkString& text : fTexts) {
+            SkShapers::HB::BatchItem item;
+            item.fUtf8 = text.c_str();
+            item.fUtf8Bytes = text.size();
+            item.fFont = font;
+            fItems.push_back(item);
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            (void)SkShapers::HB::ShapeBatch(fItems, fExecutor.get());
+        }
+    }
+};
+#endif
 }  // namespace
 
 #define SHAPER_BENCH(X) DEF_BENCH(return new ShaperBench("text/" #X ".txt", "shaper_" #X);)
@@ -75,4 +122,9 @@ SHAPER_BENCH(tifnagh)
 SHAPER_BENCH(vai)
 #undef SHAPER_BENCH
 
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+DEF_BENCH(return new ShaperBatchBench(0);)
+DEF_BENCH(return new ShaperBatchBench(4);)
+#endif
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
@@ -58,9 +58,18 @@ protected:
         return backend == Backend::kNonRendering;
     }
 
-    void onDraw(int loops, SkCanvas*) override {
-        size_t oldCacheLimitSize = SkGraphics::GetFontCacheLimit();
+    bool isThreadSafe() const override { return true; }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        fOldCacheLimitSize = SkGraphics::GetFontCacheLimit();
         SkGraphics::SetFontCacheLimit(fCacheSize);
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        SkGraphics::SetFontCacheLimit(fOldCacheLimitSize);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
         SkFont font = ToolUtils::DefaultFont();
         font.setEdging(SkFont::Edging::kAntiAlias);
         font.setSubpixel(true);
@@ -69,12 +78,12 @@ protected:
         for (int work = 0; work < loops; work++) {
             do_font_stuff(&font);
         }
-        SkGraphics::SetFontCacheLimit(oldCacheLimitSize);
     }
 
 private:
     using INHERITED = Benchmark;
     const size_t fCacheSize;
+    size_t fOldCacheLimitSize = 0;
     SkString fName;
 };
 
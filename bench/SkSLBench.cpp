@@ -176,6 +176,7 @@ protected:
                     break;
 
                 case Output::kSkRP:
+                    fCompiler.runRasterPipelineOptimizations(*program);
                     SkAssertResult(CompileToSkRP(*program));
                     break;
             }
@@ -513,6 +514,36 @@ void main()
 
 COMPILER_BENCH(tiny, "void main() { sk_FragColor = half4(1); }");
 
+// A blur-like shader whose inlined helpers repeat work, and whose loop recomputes values that never
+// change between iterations. This exercises common-subexpression elimination and loop-invariant
+// hoisting, which only run on programs bound for the Raster Pipeline; compare the skrp variant
+// against the others.
+COMPILER_BENCH(redundant, R"(
+sampler2D uTextureSampler_0_S0;
+noperspective in float2 vTextureCoords_S0;
+uniform float2 uDirection_S0;
+uniform float uSigma_S0;
+float weight(float x, float sigma) {
+	return exp(-(x * x) / (2 * sigma * sigma)) / (sigma * 2.50662827);
+}
+void main()
+{
+	half4 sum = half4(0);
+	float total = 0;
+	for (int i = -8; i <= 8; ++i) {
+		float2 texelStep = uDirection_S0 / (uSigma_S0 * 3);
+		float scaledSigma = uSigma_S0 * 0.5 + 1;
+		float w = weight(float(i), scaledSigma) + weight(float(i) + 0.5, scaledSigma);
+		float2 coords = vTextureCoords_S0 + float(i) * texelStep;
+		sum += half(w) * sample(uTextureSampler_0_S0, coords);
+		total += w;
+	}
+	half4 color = sum / half(total);
+	sk_FragColor = half4(color.rgb * color.a, color.a) * (color.a * color.a + 1) +
+	               half4(color.a * color.a + 1);
+}
+)");
+
 #define GRAPHITE_BENCH(name, text)                                                                \
     static constexpr char name##_SRC[] = text;                                                    \
     DEF_BENCH(return new SkSLCompileBench(#name, name##_SRC, /*optimize=*/true, Output::kGrMtl);) \
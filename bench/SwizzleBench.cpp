@@ -14,21 +14,32 @@ public:
 
     SwizzleBench(const char* name, SkOpts::Swizzle_8888_u32 fn) : fName(name), fFn_u32(fn) {}
     SwizzleBench(const char* name, SkOpts::Swizzle_8888_u8  fn) : fName(name), fFn_u8 (fn) {}
+    SwizzleBench(const char* name, SkOpts::Swizzle_565_u8   fn) : fName(name), fFn_565(fn) {}
+    SwizzleBench(const char* name, SkOpts::Swizzle_A8_u8    fn) : fName(name), fFn_A8 (fn) {}
+    SwizzleBench(const char* name, SkOpts::Swizzle_8888_index fn)
+        : fName(name), fFn_index(fn) {}
 
     bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
     const char* onGetName() override { return fName; }
     void onDraw(int loops, SkCanvas*) override {
         static const int K = 1023; // Arbitrary, but nice to be a non-power-of-two to trip up SIMD.
-        uint32_t dst[K], src[K];
+        // 16-bit RGBA sources need 8 bytes per pixel.
+        uint32_t dst[K], src[2*K], table[256];
         while (loops --> 0) {
-            if (fFn_u32) { fFn_u32(dst,                 src, K); }
-            if (fFn_u8)  { fFn_u8 (dst, (const uint8_t*)src, K); }
+            if (fFn_u32)   { fFn_u32  (dst,                 src, K); }
+            if (fFn_u8)    { fFn_u8   (dst, (const uint8_t*)src, K); }
+            if (fFn_565)   { fFn_565  ((uint16_t*)dst, (const uint8_t*)src, K); }
+            if (fFn_A8)    { fFn_A8   ((uint8_t*)dst,  (const uint8_t*)src, K); }
+            if (fFn_index) { fFn_index(dst, (const uint8_t*)src, K, table); }
         }
     }
 private:
     const char* fName;
     SkOpts::Swizzle_8888_u32 fFn_u32 = nullptr;
     SkOpts::Swizzle_8888_u8  fFn_u8  = nullptr;
+    SkOpts::Swizzle_565_u8   fFn_565 = nullptr;
+    SkOpts::Swizzle_A8_u8    fFn_A8  = nullptr;
+    SkOpts::Swizzle_8888_index fFn_index = nullptr;
 };
 
 
@@ -42,3 +53,12 @@ DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_RGBA", SkOpts::grayA_to_RGBA
 DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_rgbA", SkOpts::grayA_to_rgbA));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_RGB1", SkOpts::inverted_CMYK_to_RGB1));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_BGR1", SkOpts::inverted_CMYK_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB16_to_RGB1", SkOpts::RGB16_to_RGB1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB16_to_BGR1", SkOpts::RGB16_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_RGBA", SkOpts::RGBA16_to_RGBA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_BGRA", SkOpts::RGBA16_to_BGRA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_rgbA", SkOpts::RGBA16_to_rgbA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_bgrA", SkOpts::RGBA16_to_bgrA));
+DEF_BENCH(return new SwizzleBench("SkOpts::gray_to_565", SkOpts::gray_to_565));
+DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_A8", SkOpts::grayA_to_A8));
+DEF_BENCH(return new SwizzleBench("SkOpts::index_to_8888", SkOpts::index_to_8888));
@@ -6,11 +6,14 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkRandom.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
 #include "src/gpu/ganesh/geometry/GrInnerFanTriangulator.h"
 #include "src/gpu/ganesh/geometry/GrTriangulator.h"
+#include <cmath>
 #include <vector>
 
 using namespace skia_private;
@@ -110,6 +113,48 @@ public:
 
 DEF_BENCH( return new PathToTrianglesBench(); );
 
+// A single concave star with 64k points, the kind of path that pauses the first draw while it
+// triangulates. With an executor it is cut into bands that are triangulated in parallel.
+class LargePathToTrianglesBench : public TriangulatorBenchmark {
+public:
+    LargePathToTrianglesBench(bool threaded)
+            : TriangulatorBenchmark(threaded ? "PathToTriangles_large_banded"
+                                             : "PathToTriangles_large") {
+        if (threaded) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDelayedSetup() override {
+        constexpr int kNumPoints = 1 << 16;
+        SkRandom rand;
+        SkPath& path = fPaths.push_back();
+        for (int i = 0; i < kNumPoints; ++i) {
+            float angle = SK_ScalarPI * 2 * i / kNumPoints;
+            float radius = (i & 1) ? 1000 : 500 + 400 * rand.nextF();
+            SkPoint pt = {radius * std::cos(angle), radius * std::sin(angle)};
+            if (i == 0) {
+                path.moveTo(pt);
+            } else {
+                path.lineTo(pt);
+            }
+        }
+        path.close();
+    }
+
+    void doLoop() override {
+        bool isLinear;
+        GrTriangulator::PathToTriangles(fPaths[0], kTigerTolerance, SkRect::MakeEmpty(), this,
+                                        &isLinear, fExecutor.get());
+    }
+
+private:
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH( return new LargePathToTrianglesBench(false); );
+DEF_BENCH( return new LargePathToTrianglesBench(true); );
+
 class TriangulateInnerFanBench : public TriangulatorBenchmark {
 public:
     TriangulateInnerFanBench() : TriangulatorBenchmark("TriangulateInnerFan") {}
@@ -10,9 +10,12 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontTypes.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkTypeface.h"
 #include "src/base/SkUTF.h"
 #include "src/base/SkUtils.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/core/SkTypefaceCache.h"
 #include "tools/fonts/FontToolUtils.h"
 
 // From Project Guttenberg. This is UTF-8 text.
@@ -317,3 +320,58 @@ DEF_BENCH(return new UtfToGlyph(SkTextEncoding::kUTF8, atext, std::size(atext),
 
 
 
+
+// Searches an SkTypefaceCache from several threads at once, as font managers do while resolving
+// fonts for multi-threaded layout.
+class TypefaceCacheFind : public Benchmark {
+public:
+    TypefaceCacheFind(int threads)
+        : fThreads(threads)
+        , fName(SkStringPrintf("SkTypefaceCacheFind_threads%d", threads)) {}
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kTypefaceCount; ++i) {
+            fCache.add(SkTypeface::MakeEmpty());
+        }
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        // Finds the typeface at an index, to scan part of the cache like a real search.
+        struct Search {
+            int fIndex;
+            int fSeen = 0;
+        };
+        auto findProc = [](SkTypeface*, void* ctx) {
+            Search* search = static_cast<Search*>(ctx);
+            return search->fSeen++ == search->fIndex;
+        };
+        SkTaskGroup(*fExecutor).batch(fThreads, [&](int thread) {
+            for (int i = 0; i < loops; ++i) {
+                Search search{(i + thread) % kTypefaceCount};
+                sk_sp<SkTypeface> found = fCache.findByProcAndRef(findProc, &search);
+                SkASSERT(found);
+            }
+        });
+    }
+
+private:
+    static constexpr int kTypefaceCount = 32;
+
+    const int                   fThreads;
+    SkString                    fName;
+    SkTypefaceCache             fCache;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new TypefaceCacheFind(1);)
+DEF_BENCH(return new TypefaceCacheFind(2);)
+DEF_BENCH(return new TypefaceCacheFind(4);)
+DEF_BENCH(return new TypefaceCacheFind(8);)
@@ -15,6 +15,8 @@
 #include "tools/DecodeUtils.h"
 #include "tools/Resources.h"
 
+#include <vector>
+
 // Just want to trigger perspective handling, not dramatically change size
 static void tiny_persp_effect(SkCanvas* canvas) {
     SkMatrix m;
@@ -28,23 +30,17 @@ enum VertFlags {
     kTexture_VertFlag = 1 << 1,
     kPersp_VertFlag   = 1 << 2,
     kBilerp_VertFlag  = 1 << 3,
+    kDense_VertFlag   = 1 << 4,  // A large mesh of triangles only a few pixels in size.
 };
 
 class VertBench : public Benchmark {
     SkString fName;
-    enum {
-        W = 64*2,
-        H = 48*2,
-        ROW = 20,
-        COL = 20,
-        PTS = (ROW + 1) * (COL + 1),
-        IDX = ROW * COL * 6,
-    };
+    int W, H, ROW, COL, PTS, IDX;
 
     sk_sp<SkShader> fShader;
-    SkPoint fPts[PTS], fTex[PTS];
-    SkColor fColors[PTS];
-    uint16_t fIdx[IDX];
+    std::vector<SkPoint> fPts, fTex;
+    std::vector<SkColor> fColors;
+    std::vector<uint16_t> fIdx;
     unsigned fFlags;
 
     static void load_2_tris(uint16_t idx[], int x, int y, int rb) {
@@ -66,11 +62,26 @@ class VertBench : public Benchmark {
 
 public:
     VertBench(unsigned flags) : fFlags(flags) {
+        if (fFlags & kDense_VertFlag) {
+            W = 640;
+            H = 480;
+            ROW = COL = 160;
+        } else {
+            W = 64*2;
+            H = 48*2;
+            ROW = COL = 20;
+        }
+        PTS = (ROW + 1) * (COL + 1);
+        IDX = ROW * COL * 6;
+        fPts.resize(PTS);
+        fColors.resize(PTS);
+        fIdx.resize(IDX);
+
         const SkScalar dx = SkIntToScalar(W) / COL;
         const SkScalar dy = SkIntToScalar(H) / COL;
 
-        SkPoint* pts = fPts;
-        uint16_t* idx = fIdx;
+        SkPoint* pts = fPts.data();
+        uint16_t* idx = fIdx.data();
 
         SkScalar yy = 0;
         for (int y = 0; y <= ROW; y++) {
@@ -90,13 +101,13 @@ public:
             }
             yy += dy;
         }
-        SkASSERT(PTS == pts - fPts);
-        SkASSERT(IDX == idx - fIdx);
+        SkASSERT(PTS == pts - fPts.data());
+        SkASSERT(IDX == idx - fIdx.data());
 
         // We want to store texs in a separate array, so the blitters don't "cheat" and
         // skip the (normal) step of computing the new local-matrix. This is the common case
         // we think in the wild (where the texture coordinates are different from the positions.
-        memcpy(fTex, fPts, sizeof(fPts));
+        fTex = fPts;
 
         SkRandom rand;
         for (int i = 0; i < PTS; ++i) {
@@ -116,6 +127,9 @@ public:
         if (fFlags & kBilerp_VertFlag) {
             fName.append("_bilerp");
         }
+        if (fFlags & kDense_VertFlag) {
+            fName.append("_dense");
+        }
     }
 
 protected:
@@ -129,10 +143,10 @@ protected:
             tiny_persp_effect(canvas);
         }
 
-        const SkPoint* texs = (fFlags & kTexture_VertFlag) ? fTex    : nullptr;
-        const SkColor* cols = (fFlags & kColors_VertFlag)  ? fColors : nullptr;
+        const SkPoint* texs = (fFlags & kTexture_VertFlag) ? fTex.data()    : nullptr;
+        const SkColor* cols = (fFlags & kColors_VertFlag)  ? fColors.data() : nullptr;
         auto verts = SkVertices::MakeCopy(SkVertices::kTriangles_VertexMode, PTS,
-                                          fPts, texs, cols, IDX, fIdx);
+                                          fPts.data(), texs, cols, IDX, fIdx.data());
         for (int i = 0; i < loops; i++) {
             canvas->drawVertices(verts, SkBlendMode::kModulate, paint);
         }
@@ -148,6 +162,8 @@ DEF_BENCH(return new VertBench(kTexture_VertFlag | kBilerp_VertFlag);)
 DEF_BENCH(return new VertBench(kColors_VertFlag);)
 DEF_BENCH(return new VertBench(kColors_VertFlag | kTexture_VertFlag);)
 DEF_BENCH(return new VertBench(kColors_VertFlag | kTexture_VertFlag | kBilerp_VertFlag);)
+DEF_BENCH(return new VertBench(kColors_VertFlag | kDense_VertFlag);)
+DEF_BENCH(return new VertBench(kColors_VertFlag | kTexture_VertFlag | kDense_VertFlag);)
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -32,6 +32,7 @@
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkString.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/encode/SkPngEncoder.h"
 #include "include/private/base/SkMacros.h"
 #include "src/base/SkAutoMalloc.h"
@@ -39,6 +40,7 @@
 #include "src/base/SkTime.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkOSFile.h"
+#include "src/core/SkTHash.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/utils/SkJSONWriter.h"
@@ -55,6 +57,7 @@
 #include "tools/fonts/FontToolUtils.h"
 #include "tools/ios_utils.h"
 #include "tools/trace/EventTracingPriv.h"
+#include "tools/trace/PhaseStatsTracer.h"
 #include "tools/trace/SkDebugfTracer.h"
 
 #if defined(SK_ENABLE_SVG)
@@ -85,6 +88,7 @@
 
 extern bool gSkForceRasterPipelineBlitter;
 extern bool gForceHighPrecisionRasterPipeline;
+extern bool gSkUseSparseAA;
 
 #ifndef SK_BUILD_FOR_WIN
     #include <unistd.h>
@@ -143,6 +147,7 @@ static DEFINE_string(zoom, "1.0,0",
                      "Comma-separated zoomMax,zoomPeriodMs factors for a periodic SKP zoom "
                      "function that ping-pongs between 1.0 and zoomMax.");
 static DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
+static DEFINE_bool(internPaints, false, "Record SKPs with SkPictureRecorder::kInternPaints_RecordFlag?");
 static DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
 static DEFINE_int(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 static DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
@@ -158,6 +163,7 @@ static DEFINE_string(benchType,  "",
 
 static DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
 static DEFINE_bool(forceRasterPipelineHP, false, "sets gSkForceRasterPipelineBlitter and gForceHighPrecisionRasterPipeline");
+static DEFINE_bool(sparseAA, false, "sets gSkUseSparseAA");
 
 static DEFINE_bool2(pre_log, p, false,
                     "Log before running each test. May be incomprehensible when threading");
@@ -188,6 +194,8 @@ static DEFINE_bool2(verbose, v, false, "enable verbose output from the test driv
 
 static DEFINE_string(skps, "skps", "Directory to read skps from.");
 static DEFINE_string(mskps, "mskps", "Directory to read mskps from.");
+static DEFINE_bool(mskpFrameTimes, false,
+                   "Also bench each mskp's frame time distribution, with warm and cold caches.");
 static DEFINE_string(svgs, "", "Directory to read SVGs from, or a single SVG file.");
 static DEFINE_string(texttraces, "", "Directory to read TextBlobTrace files from.");
 
@@ -211,8 +219,160 @@ static DEFINE_bool(splitPerfettoTracesByBenchmark, true,
 
 static DEFINE_bool(runtimeCPUDetection, true, "Skip runtime CPU detection and optimization");
 
+static DEFINE_int(benchThreads, 0,
+                  "If >1, also run benchmarks that are thread safe on this many threads at once, "
+                  "each with its own canvas, and report their throughput. CPU configs only.");
+
+static DEFINE_bool(memoryStats, false,
+                   "Add the peak and final bytes used by each of Skia's caches while sampling to "
+                   "the JSON results, as reported through SkTraceMemoryDump.");
+
+static DEFINE_bool(phaseStats, false,
+                   "Time each TRACE_EVENT scope while sampling, and add its stats to the JSON "
+                   "results under \"phases\". Replaces --trace.");
+
 static double now_ms() { return SkTime::GetNSecs() * 1e-6; }
 
+// Adds up the bytes that each of Skia's caches reports through SkTraceMemoryDump, for
+// --memoryStats. A cache is named by the second component of its dump names, e.g. "sk_glyph_cache"
+// for "skia/sk_glyph_cache", and "gpu_resources" for "skia/gpu_resources/resource_12".
+class MemoryStats : public SkTraceMemoryDump {
+public:
+    void dumpNumericValue(const char* dumpName,
+                          const char* valueName,
+                          const char* units,
+                          uint64_t value) override {
+        // Only count what objects take up, not budgets, object counts or purgeable subsets.
+        if (0 != strcmp(units, "bytes") ||
+            (0 != strcmp(valueName, "size") && 0 != strcmp(valueName, "discardable_size"))) {
+            return;
+        }
+        const char* name = dumpName;
+        if (SkStrStartsWith(name, "skia/")) {
+            name += strlen("skia/");
+        }
+        const char* end = strchr(name, '/');
+        SkString cache(name, end ? end - name : strlen(name));
+        uint64_t* bytes = fBytes.find(cache);
+        if (!bytes) {
+            bytes = fBytes.set(std::move(cache), 0);
+        }
+        *bytes += value;
+    }
+
+    void setMemoryBacking(const char*, const char*, const char*) override {}
+    void setDiscardableMemoryBacking(const char*, const SkDiscardableMemory&) override {}
+
+    // The glyph cache only reports its total when details are light.
+    LevelOfDetail getRequestedDetails() const override { return kLight_LevelOfDetail; }
+
+    // Wrapped objects belong to the client.
+    bool shouldDumpWrappedObjects() const override { return false; }
+
+    void reset() {
+        fBytes.reset();
+        fPeakBytes.reset();
+    }
+
+    // Replaces the current bytes with what the caches use now, and raises the peaks to them.
+    void sample(const Target* target) {
+        fBytes.reset();
+        SkGraphics::DumpMemoryStatistics(this);
+        target->dumpMemoryStatistics(this);
+        fBytes.foreach([&](const SkString& cache, uint64_t bytes) {
+            uint64_t* peak = fPeakBytes.find(cache);
+            if (!peak) {
+                peak = fPeakBytes.set(cache, 0);
+            }
+            *peak = std::max(*peak, bytes);
+        });
+    }
+
+    // Writes each cache's peak bytes, and its bytes after the last sample.
+    void write(NanoJSONResultsWriter* log) const {
+        TArray<const SkString*> caches;
+        fPeakBytes.foreach([&](const SkString& cache, uint64_t) { caches.push_back(&cache); });
+        std::sort(caches.begin(), caches.end(), [](const SkString* a, const SkString* b) {
+            return strcmp(a->c_str(), b->c_str()) < 0;
+        });
+
+        log->beginObject("memory");
+        for (const SkString* cache : caches) {
+            const uint64_t* bytes = fBytes.find(*cache);
+            log->beginObject(cache->c_str());
+            log->appendMetric("peak_bytes", *fPeakBytes.find(*cache));
+            log->appendMetric("final_bytes", bytes ? *bytes : 0);
+            log->endObject();
+        }
+        log->endObject(); // memory
+    }
+
+private:
+    THashMap<SkString, uint64_t> fBytes;
+    THashMap<SkString, uint64_t> fPeakBytes;
+};
+
+// Collects how long each traced phase took in each sample, for --phaseStats.
+class PhaseSamples {
+public:
+    void reset() {
+        fPhases.reset();
+        fSampleCount = 0;
+    }
+
+    void addSample(const TArray<PhaseStatsTracer::Phase>& phases, int loops) {
+        for (const PhaseStatsTracer::Phase& phase : phases) {
+            Samples* samples = fPhases.find(phase.fName);
+            if (!samples) {
+                samples = fPhases.set(phase.fName, Samples());
+            }
+            // A phase that didn't run in earlier samples took no time in them.
+            samples->fMs.push_back_n(fSampleCount - samples->fMs.size(), 0.0);
+            samples->fMs.push_back(phase.fTotalMs / loops);
+            samples->fCalls += phase.fCount;
+        }
+        fLoops += loops;
+        fSampleCount++;
+    }
+
+    // Writes each phase's time per iteration, scaled to the benchmark's units like the samples,
+    // and how many times it ran per iteration.
+    void write(NanoJSONResultsWriter* log, double units) {
+        TArray<const SkString*> names;
+        fPhases.foreach([&](const SkString& name, const Samples&) { names.push_back(&name); });
+        std::sort(names.begin(), names.end(), [](const SkString* a, const SkString* b) {
+            return strcmp(a->c_str(), b->c_str()) < 0;
+        });
+
+        log->beginObject("phases");
+        for (const SkString* name : names) {
+            Samples* samples = fPhases.find(*name);
+            samples->fMs.push_back_n(fSampleCount - samples->fMs.size(), 0.0);
+            for (double& ms : samples->fMs) {
+                ms *= 1.0 / units;
+            }
+            Stats stats(samples->fMs, /*want_plot=*/false);
+            log->beginObject(name->c_str());
+            log->appendMetric("min_ms", stats.min);
+            log->appendMetric("median_ms", stats.median);
+            log->appendMetric("mean_ms", stats.mean);
+            log->appendMetric("calls", sk_ieee_double_divide(samples->fCalls, fLoops));
+            log->endObject();
+        }
+        log->endObject(); // phases
+    }
+
+private:
+    struct Samples {
+        TArray<double> fMs;
+        double fCalls = 0;
+    };
+
+    THashMap<SkString, Samples> fPhases;
+    int fSampleCount = 0;
+    double fLoops = 0;
+};
+
 static SkString humanize(double ms) {
     if (FLAGS_verbose) return SkStringPrintf("%" PRIu64, (uint64_t)(ms*1e6));
     return HumanizeMs(ms);
@@ -302,6 +462,10 @@ struct GPUTarget : public Target {
         context->priv().printGpuStats();
         context->priv().printContextStats();
     }
+
+    void dumpMemoryStatistics(SkTraceMemoryDump* dump) const override {
+        this->contextInfo.directContext()->dumpMemoryStatistics(dump);
+    }
 };
 
 #if defined(SK_GRAPHITE)
@@ -383,6 +547,10 @@ struct GraphiteTarget : public Target {
 
     void dumpStats() override {
     }
+
+    void dumpMemoryStatistics(SkTraceMemoryDump* dump) const override {
+        this->context->dumpMemoryStatistics(dump);
+    }
 };
 #endif // SK_GRAPHITE
 
@@ -403,6 +571,31 @@ static double time(int loops, Benchmark* bench, Target* target) {
     return elapsed;
 }
 
+// Runs 'loops' iterations of the bench on each canvas at once, one thread per canvas, and returns
+// the elapsed wall time.
+static double time_threaded(int loops, Benchmark* bench, const TArray<SkCanvas*>& canvases) {
+    for (SkCanvas* canvas : canvases) {
+        if (canvas) {
+            canvas->clear(SK_ColorWHITE);
+        }
+        bench->preDraw(canvas);
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(canvases.size());
+    double start = now_ms();
+    for (SkCanvas* canvas : canvases) {
+        threads.emplace_back([=] { bench->draw(loops, canvas); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double elapsed = now_ms() - start;
+    for (SkCanvas* canvas : canvases) {
+        bench->postDraw(canvas);
+    }
+    return elapsed;
+}
+
 static double estimate_timer_overhead() {
     double overhead = 0;
     for (int i = 0; i < FLAGS_overheadLoops; i++) {
@@ -955,7 +1148,10 @@ public:
             fBenchType  = "recording";
             fSKPBytes = static_cast<double>(pic->approximateBytesUsed());
             fSKPOps   = pic->approximateOpCount();
-            return new RecordingBench(name.c_str(), pic.get(), FLAGS_bbh);
+            return new RecordingBench(name.c_str(), pic.get(), FLAGS_bbh,
+                                      FLAGS_internPaints
+                                              ? SkPictureRecorder::kInternPaints_RecordFlag
+                                              : 0);
         }
 
         // Add all .skps as DeserializePictureBenchs.
@@ -982,13 +1178,14 @@ public:
                     continue;
                 }
 
-                if (FLAGS_bbh) {
+                if (FLAGS_bbh || FLAGS_internPaints) {
                     // The SKP we read off disk doesn't have a BBH.  Re-record so it grows one.
                     SkRTreeFactory factory;
                     SkPictureRecorder recorder;
-                    pic->playback(recorder.beginRecording(pic->cullRect().width(),
-                                                          pic->cullRect().height(),
-                                                          &factory));
+                    pic->playback(recorder.beginRecording(
+                            SkRect::MakeWH(pic->cullRect().width(), pic->cullRect().height()),
+                            FLAGS_bbh ? &factory : nullptr,
+                            FLAGS_internPaints ? SkPictureRecorder::kInternPaints_RecordFlag : 0));
                     pic = recorder.finishRecordingAsPicture();
                 }
                 SkString name = SkOSPath::Basename(path.c_str());
@@ -1045,6 +1242,20 @@ public:
             return new MSKPBench(std::move(name), std::move(player));
         }
 
+        // With --mskpFrameTimes, read them all again for their frame times, warm then cold.
+        while (FLAGS_mskpFrameTimes && fCurrentMSKPFrameTimes < 2 * fMSKPs.size()) {
+            const bool coldCache = fCurrentMSKPFrameTimes & 1;
+            const SkString& path = fMSKPs[fCurrentMSKPFrameTimes++ / 2];
+            std::unique_ptr<MSKPPlayer> player = ReadMSKP(path.c_str());
+            if (!player) {
+                continue;
+            }
+            SkString name = SkOSPath::Basename(path.c_str());
+            fSourceType = "mskp";
+            fBenchType = "mskp_frametimes";
+            return new MSKPFrameTimesBench(std::move(name), std::move(player), coldCache);
+        }
+
         for (; fCurrentCodec < fImages.size(); fCurrentCodec++) {
             fSourceType = "image";
             fBenchType = "skcodec";
@@ -1296,6 +1507,7 @@ private:
     int fCurrentRecording = 0;
     int fCurrentDeserialPicture = 0;
     int fCurrentMSKP = 0;
+    int fCurrentMSKPFrameTimes = 0;
     int fCurrentScale = 0;
     int fCurrentSKP = 0;
     int fCurrentSVG = 0;
@@ -1342,7 +1554,13 @@ class NanobenchShaderErrorHandler : public GrContextOptions::ShaderErrorHandler
 int main(int argc, char** argv) {
     CommandLineFlags::Parse(argc, argv);
 
-    initializeEventTracingForTools();
+    PhaseStatsTracer* phaseTracer = nullptr;
+    if (FLAGS_phaseStats) {
+        phaseTracer = new PhaseStatsTracer();
+        SkAssertResult(SkEventTracer::SetInstance(phaseTracer));
+    } else {
+        initializeEventTracingForTools();
+    }
 
 #if defined(SK_BUILD_FOR_IOS)
     cd_Documents();
@@ -1414,6 +1632,8 @@ int main(int argc, char** argv) {
     }
 
     TArray<double> samples;
+    PhaseSamples phaseSamples;
+    MemoryStats memoryStats;
 
     if (kAutoTuneLoops != FLAGS_loops) {
         SkDebugf("Fixed number of loops; times would only be misleading so we won't print them.\n");
@@ -1440,6 +1660,7 @@ int main(int argc, char** argv) {
 
     gSkForceRasterPipelineBlitter     = FLAGS_forceRasterPipelineHP || FLAGS_forceRasterPipeline;
     gForceHighPrecisionRasterPipeline = FLAGS_forceRasterPipelineHP;
+    gSkUseSparseAA                    = FLAGS_sparseAA;
 
     // The SkSL memory benchmark must run before any GPU painting occurs. SkSL allocates memory for
     // its modules the first time they are accessed, and this test is trying to measure the size of
@@ -1515,17 +1736,32 @@ int main(int argc, char** argv) {
                 } while (now_ms() < stop);
             }
 
+            auto sample = [&] {
+                if (phaseTracer) {
+                    phaseTracer->takePhases();  // Drop whatever ran between samples.
+                }
+                double ms = time(loops, bench.get(), target) / loops;
+                if (phaseTracer) {
+                    phaseSamples.addSample(phaseTracer->takePhases(), loops);
+                }
+                if (FLAGS_memoryStats) {
+                    memoryStats.sample(target);
+                }
+                return ms;
+            };
+            phaseSamples.reset();
+            memoryStats.reset();
             if (FLAGS_ms) {
                 samples.clear();
                 auto stop = now_ms() + FLAGS_ms;
                 do {
-                    samples.push_back(time(loops, bench.get(), target) / loops);
+                    samples.push_back(sample());
                     pool.drain();
                 } while (now_ms() < stop);
             } else {
                 samples.reset(FLAGS_samples);
                 for (int s = 0; s < FLAGS_samples; s++) {
-                    samples[s] = time(loops, bench.get(), target) / loops;
+                    samples[s] = sample();
                     pool.drain();
                 }
             }
@@ -1535,8 +1771,32 @@ int main(int argc, char** argv) {
                 sample *= (1.0 / bench->getUnits());
             }
 
+            // Time the same loops on --benchThreads threads at once. The samples are the wall
+            // time per iteration across all threads, so they equal the single threaded samples
+            // divided by the thread count when the bench scales perfectly.
+            TArray<double> threadedSamples;
+            if (FLAGS_benchThreads > 1 && bench->isThreadSafe() &&
+                (Benchmark::Backend::kNonRendering == target->config.backend ||
+                 Benchmark::Backend::kRaster == target->config.backend)) {
+                TArray<sk_sp<SkSurface>> surfaces;
+                TArray<SkCanvas*> canvases;
+                for (int t = 0; t < FLAGS_benchThreads; ++t) {
+                    if (canvas) {
+                        surfaces.push_back(SkSurfaces::Raster(canvas->imageInfo()));
+                    }
+                    canvases.push_back(canvas ? surfaces.back()->getCanvas() : nullptr);
+                }
+                threadedSamples.reset(samples.size());
+                for (double& sample : threadedSamples) {
+                    sample = time_threaded(loops, bench.get(), canvases) /
+                             ((double)loops * FLAGS_benchThreads * bench->getUnits());
+                    pool.drain();
+                }
+            }
+
             TArray<SkString> keys;
             TArray<double> values;
+            bench->getMetrics(&keys, &values);
             if (configs[i].backend == Benchmark::Backend::kGanesh) {
                 if (FLAGS_gpuStatsDump) {
                     // TODO cache stats
@@ -1580,9 +1840,26 @@ int main(int argc, char** argv) {
                 log.appendDoubleDigits(sample, 16);
             }
             log.endArray(); // samples
+            if (phaseTracer) {
+                phaseSamples.write(&log, bench->getUnits());
+            }
+            if (FLAGS_memoryStats) {
+                memoryStats.write(&log);
+            }
             benchStream.fillCurrentMetrics(log);
+            std::optional<Stats> threadedStats;
+            if (!threadedSamples.empty()) {
+                threadedStats.emplace(threadedSamples, /*want_plot=*/false);
+                log.appendMetric("threaded_count", FLAGS_benchThreads);
+                log.appendMetric("threaded_min_ms", threadedStats->min);
+                log.appendMetric("threaded_median_ms", threadedStats->median);
+                // The fraction of linear speedup: 1 if each thread runs as fast as a lone thread.
+                log.appendMetric("threaded_scaling",
+                                 sk_ieee_double_divide(stats.median,
+                                                       threadedStats->median * FLAGS_benchThreads));
+            }
             if (!keys.empty()) {
-                // dump to json, only SKPBench currently returns valid keys / values
+                // dump to json, only SKPBench and MSKPFrameTimesBench return keys / values
                 SkASSERT(keys.size() == values.size());
                 for (int j = 0; j < keys.size(); j++) {
                     log.appendMetric(keys[j].c_str(), values[j]);
@@ -1644,6 +1921,17 @@ int main(int argc, char** argv) {
                         );
             }
 
+            if (threadedStats && !FLAGS_quiet && !FLAGS_csv) {
+                SkDebugf("\t\t%d threads: median %s per iteration, %.0f%% scaling\t%s\t%s\n"
+                        , FLAGS_benchThreads
+                        , HUMANIZE(threadedStats->median)
+                        , 100 * sk_ieee_double_divide(stats.median,
+                                                      threadedStats->median * FLAGS_benchThreads)
+                        , config
+                        , bench->getUniqueName()
+                        );
+            }
+
             if (FLAGS_gpuStats && Benchmark::Backend::kGanesh == configs[i].backend) {
                 target->dumpStats();
             }
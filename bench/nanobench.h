@@ -19,6 +19,7 @@
 
 class SkBitmap;
 class SkCanvas;
+class SkTraceMemoryDump;
 class NanoJSONResultsWriter;
 
 struct Config {
@@ -73,6 +74,9 @@ struct Target {
     /** Writes gathered stats using SkDebugf. */
     virtual void dumpStats() {}
 
+    /** Reports the memory used by the target's GPU context, if any. */
+    virtual void dumpMemoryStatistics(SkTraceMemoryDump*) const {}
+
     SkCanvas* getCanvas() const {
         if (!surface) {
             return nullptr;
@@ -137,10 +137,47 @@ cc_defaults {
     ]
 }
 
+cc_library_static {
+    // The ARMv8.2 raster pipeline stages need their own -march, and Soong only sets cflags per
+    // module, so they're built separately and pulled into libskia on arm64 devices.
+    name: "libskia_opts_armv82",
+    defaults: ["skia_defaults"],
+    enabled: false,
+    arch: {
+        arm64: {
+            enabled: true,
+            srcs: [
+                $armv82_srcs
+            ],
+            cflags: [
+                "-march=armv8.2-a+fp16+dotprod",
+            ],
+        },
+    },
+    local_include_dirs: [
+        "android",
+    ],
+}
+
+cc_defaults {
+    name: "skia_armv82_opts",
+    target: {
+      android_arm64: {
+        cflags: [
+          "-DSK_ENABLE_ARMV82_OPTS",
+        ],
+        whole_static_libs: [
+          "libskia_opts_armv82",
+        ],
+      },
+    },
+}
+
 cc_library_static {
     // Smaller version of Skia, without e.g. codecs, intended for use by RenderEngine.
     name: "libskia_renderengine",
     defaults: ["skia_defaults",
+               "skia_armv82_opts",
                "skia_renderengine_deps"],
     srcs: [
         $renderengine_srcs
@@ -220,6 +257,7 @@ cc_library_static {
 
     defaults: ["skia_deps",
                "skia_defaults",
+               "skia_armv82_opts",
     ],
 }
 
@@ -751,6 +789,7 @@ with open('Android.bp', 'w') as Android_bp:
 
     'x86_srcs':      bpfmt(16, strip_non_srcs(defs['hsw'] +
                                              defs['skx'])),
+    'armv82_srcs':   bpfmt(16, strip_non_srcs(defs['armv82'])),
 
     'gm_includes'       : bpfmt(8, gm_includes),
     'gm_srcs'           : bpfmt(8, gm_srcs),
@@ -27,6 +27,7 @@
 #include <memory>
 
 class SkData;
+class SkExecutor;
 class SkPngChunkReader;
 class SkStream;
 struct SkGainmapInfo;
@@ -280,6 +281,25 @@ public:
     bool getAndroidGainmap(SkGainmapInfo* outInfo,
                            std::unique_ptr<SkStream>* outGainmapImageStream);
 
+    /**
+     *  Decode the image and its gainmap, and write the rendition for a display with the HDR to
+     *  SDR ratio dstHdrRatio to pixels, converted to info's color type and color space. Use an F16
+     *  color type to keep the HDR range. This is the same result as drawing with the shader from
+     *  SkGainmapShader::Make(), computed once at decode time, for images shown at a fixed
+     *  headroom.
+     *
+     *  If executor is non-null, the gainmap is decoded on it while the base image is decoded on
+     *  the calling thread.
+     *
+     *  Images without a gainmap are decoded as getAndroidPixels() would. info must have the
+     *  dimensions of getInfo(); this does not sample or subset.
+     */
+    SkCodec::Result getGainmapAppliedPixels(const SkImageInfo& info,
+                                            void* pixels,
+                                            size_t rowBytes,
+                                            float dstHdrRatio,
+                                            SkExecutor* executor = nullptr);
+
 protected:
     SkAndroidCodec(SkCodec*);
 
@@ -29,6 +29,7 @@
 #include <vector>
 
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkImage;
 class SkPngChunkReader;
@@ -317,6 +318,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -360,6 +362,15 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, getPixels may decode independent parts of the image concurrently on
+         *  this executor (and will wait for them before returning). The decoded pixels are the
+         *  same either way.
+         *
+         *  Currently only used for full-size decodes of baseline JPEGs with restart markers.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
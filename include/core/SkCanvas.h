@@ -1088,6 +1088,24 @@ public:
     */
     bool quickReject(const SkPath& path) const;
 
+    /** Culls a batch of rects against clip. Each rect in rects is transformed by matrix, and then
+        by SkMatrix, and compared with clip the same way as quickReject(const SkRect&).
+
+        Bit (i % 32) of visible[i / 32] is set if rect i may be visible, and cleared if it can be
+        quickly determined to be outside of clip. visible must hold at least
+        (rects.size() + 31) / 32 words.
+
+        Use to skip building draw commands for many small items at once; several rects are
+        transformed and compared together.
+
+        @param rects    SkRect array to compare with clip
+        @param matrix   SkMatrix applied to rects before the canvas SkMatrix
+        @param visible  storage for one bit per rect
+        @return         number of rects that may be visible
+    */
+    int quickRejectRects(SkSpan<const SkRect> rects, const SkMatrix& matrix,
+                         SkSpan<uint32_t> visible) const;
+
     /** Returns bounds of clip, transformed by inverse of SkMatrix. If clip is empty,
         return SkRect::MakeEmpty, where all SkRect sides equal zero.
 
@@ -1692,6 +1710,43 @@ public:
                                          const SkSamplingOptions&, const SkPaint* paint = nullptr,
                                          SrcRectConstraint constraint = kStrict_SrcRectConstraint);
 
+    /** The kind of each entry of a BulkSet. */
+    enum class BulkItem : uint8_t {
+        kRect,       // drawRect(fRects[i])
+        kRRect,      // drawRRect() of fRects[i] with the simple radii fRadii[i]
+        kImageRect,  // drawImageRect() of fSrcRects[i] of fImage into fRects[i]
+    };
+
+    /**
+     * Structure-of-arrays description of the entries drawn by experimental_DrawBulk(). Every
+     * non-null array holds fCount elements.
+     */
+    struct BulkSet {
+        int fCount = 0;
+        const BulkItem* fItems = nullptr;      // Required
+        const SkRect* fRects = nullptr;        // Required; the sorted bounds or dst of each entry
+        const SkVector* fRadii = nullptr;      // Required if any entry is a kRRect
+        const SkRect* fSrcRects = nullptr;     // Required if any entry is a kImageRect
+        const SkColor4f* fColors = nullptr;    // Optional; replaces the paint color per entry
+        const SkImage* fImage = nullptr;       // Required if any entry is a kImageRect
+    };
+
+    /**
+     * This is an experimental API, and it may change or be removed.
+     *
+     * Draws every entry of 'set' in order, as if by a separate drawRect(), drawRRect() or
+     * drawImageRect() (with kFast_SrcRectConstraint) call, using 'paint' with its color replaced
+     * by the entry's color when 'set.fColors' is provided. Image entries use the paint the way
+     * drawImageRect() does, e.g. only the alpha of their color applies to color images.
+     *
+     * Unlike separate calls, the paint is only analyzed once, and devices may draw runs of similar
+     * entries together: Ganesh draws runs of solid color rects as one batch of quads, and image
+     * entries draw through the same path as experimental_DrawEdgeAAImageSet(). An image filter
+     * on 'paint' is applied to each entry separately.
+     */
+    void experimental_DrawBulk(const BulkSet& set, const SkSamplingOptions& sampling,
+                               const SkPaint& paint);
+
     /** Draws text, with origin at (x, y), using clip, SkMatrix, SkFont font,
         and SkPaint paint.
 
@@ -2277,6 +2332,8 @@ protected:
 
     virtual void onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4], QuadAAFlags aaFlags,
                                   const SkColor4f& color, SkBlendMode mode);
+    virtual void onDrawBulk(const BulkSet& set, const SkSamplingOptions& sampling,
+                            const SkPaint& paint);
 
     enum ClipEdgeStyle {
         kHard_ClipEdgeStyle,
@@ -2384,6 +2441,9 @@ private:
         std::unique_ptr<BackImage> fBackImage;
         SkM44 fMatrix;
         int fDeferredSaveCount = 0;
+        // Whether the clip was modified since this record was pushed. If it wasn't, restoring
+        // it doesn't need to recompute the quick-reject bounds.
+        bool fClipChanged = false;
 
         MCRec(SkDevice* device);
         MCRec(const MCRec* prev);
@@ -22,6 +22,12 @@ public:
     static std::unique_ptr<SkExecutor> MakeLIFOThreadPool(int threads = 0,
                                                           bool allowBorrowing = true);
 
+    // Like the pools above, but each thread has its own queue: work added from a pool thread
+    // goes onto that thread's queue (run LIFO), and idle threads steal from the others (FIFO).
+    // This avoids a single shared lock when tasks spawn more tasks, e.g. nested SkTaskGroups.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingThreadPool(int threads = 0,
+                                                                  bool allowBorrowing = true);
+
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
     static void SetDefault(SkExecutor*);  // Does not take ownership.  Not thread safe.
@@ -12,6 +12,7 @@
 #include "include/core/SkTypes.h"
 
 #include <cstddef>
+#include <new>
 
 class SkData;
 class SkReadBuffer;
@@ -77,6 +78,21 @@ public:
     static sk_sp<SkFlattenable> Deserialize(Type, const void* data, size_t length,
                                             const SkDeserialProcs* procs = nullptr);
 
+#if defined(SK_POOL_FLATTENABLES)
+    // Effects are small, immutable and often created and dropped every frame, so when this is
+    // defined, they come from per-thread free lists of a few size classes instead of the heap.
+    // They may be freed on any thread.
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+
+    static void* operator new(size_t size, void* placement) {
+        return ::operator new(size, placement);
+    }
+    static void operator delete(void* ptr, void* placement) {
+        ::operator delete(ptr, placement);
+    }
+#endif
+
 protected:
     class PrivateInitializer {
     public:
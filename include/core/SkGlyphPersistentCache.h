@@ -0,0 +1,50 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphPersistentCache_DEFINED
+#define SkGlyphPersistentCache_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTypes.h"
+
+#include <memory>
+
+class SkData;
+
+/**
+ *  Storage for the font cache's glyphs which outlives the process, so that glyphs rasterized in
+ *  one run don't have to be rasterized again in the next. See
+ *  SkGraphics::SetFontCachePersistentCache().
+ *
+ *  The font cache stores the images, metrics and paths of each strike (a typeface at a size and
+ *  transform) under a key which identifies the font itself, not just the process's typeface
+ *  object. It loads a strike's glyphs when creating the strike, and stores them when the strike
+ *  is purged or SkGraphics::SaveFontCacheToPersistentCache() is called. The methods may be
+ *  called concurrently from any thread.
+ */
+class SK_API SkGlyphPersistentCache {
+public:
+    virtual ~SkGlyphPersistentCache() = default;
+
+    /**
+     *  Returns the data last stored under the key, or nullptr if there is none.
+     */
+    virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+    /**
+     *  Stores the data under the key, replacing what was stored there before.
+     */
+    virtual void store(const SkData& key, const SkData& data) = 0;
+
+    /**
+     *  Returns a cache which keeps each strike in its own file in the directory, creating the
+     *  directory if needed. The files are memory-mapped when loaded.
+     */
+    static std::unique_ptr<SkGlyphPersistentCache> MakeDirectoryCache(const char* directory);
+};
+
+#endif  // SkGlyphPersistentCache_DEFINED
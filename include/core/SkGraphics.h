@@ -16,6 +16,8 @@
 #include <memory>
 
 class SkData;
+class SkExecutor;
+class SkGlyphPersistentCache;
 class SkImageGenerator;
 class SkOpenTypeSVGDecoder;
 class SkTraceMemoryDump;
@@ -69,6 +71,31 @@ public:
      */
     static int SetFontCacheCountLimit(int count);
 
+    /**
+     *  Specify an executor on which the font cache may rasterize glyph images. When a draw
+     *  needs many glyph images which are not in the cache yet, they are rasterized on the
+     *  executor's threads as well as the calling one. Pass nullptr (the default) to rasterize
+     *  all glyphs on the calling thread. The executor must outlive its use by the font cache.
+     */
+    static void SetFontCacheRasterExecutor(SkExecutor* executor);
+
+    /**
+     *  Specify where the font cache keeps glyphs across runs of the process. New strikes start
+     *  with the glyphs stored for them there, instead of rasterizing them again, and strikes
+     *  store their glyphs there when they are purged from the font cache. Pass nullptr (the
+     *  default) to disable. If storeExecutor is set, purged strikes are serialized and stored on
+     *  it rather than on the thread that purged them. The persistent cache and executor must
+     *  outlive their use by the font cache.
+     */
+    static void SetFontCachePersistentCache(SkGlyphPersistentCache* persistentCache,
+                                            SkExecutor* storeExecutor = nullptr);
+
+    /**
+     *  Store the glyphs of all the strikes in the font cache which got new glyphs since they
+     *  were loaded or last stored, e.g. before the process exits.
+     */
+    static void SaveFontCacheToPersistentCache();
+
     /**
      *  Return the current limit to the number of entries in the typeface cache.
      *  A cache "entry" is associated with each typeface.
@@ -82,6 +109,35 @@ public:
      */
     static int SetTypefaceCacheCountLimit(int count);
 
+    /**
+     *  Return the current limit to the number of entries in the runtime effect cache. An entry is
+     *  associated with each SkRuntimeEffect compiled from SkSL; creating an effect again from the
+     *  same SkSL and options returns the cached one instead of compiling it again.
+     */
+    static int GetRuntimeEffectCacheCountLimit();
+
+    /**
+     *  Set the limit to the number of entries in the runtime effect cache, and return the
+     *  previous value. If this new value is lower than the previous, the least recently used
+     *  entries are purged to meet the new limit. Zero disables the cache, including for the
+     *  effects that Skia creates internally.
+     */
+    static int SetRuntimeEffectCacheCountLimit(int count);
+
+    /**
+     *  Return the number of entries in the runtime effect cache.
+     */
+    static int GetRuntimeEffectCacheCountUsed();
+
+    /**
+     *  Runtime effects and GPU shaders are compiled against SkSL modules of built-in functions,
+     *  which are themselves compiled the first time a shader needs them. This compiles all of the
+     *  modules used by runtime effects and the GPU backends that were built in, so that clients can
+     *  pay for them at a convenient time (e.g. on a background thread during startup) instead of
+     *  when the first frame is drawn. It is safe to call from any thread, and cheap to call again.
+     */
+    static void PreloadSkSLModules();
+
     /**
      *  For debugging purposes, this will attempt to purge the font cache. It
      *  does not change the limit, but will cause subsequent font measures and
@@ -140,6 +196,28 @@ public:
      */
     static void PurgeAllCaches();
 
+    /**
+     *  Process-wide counts of work done by Skia's CPU caches since the process started. The
+     *  counters are always on and cheap to update, so they can be read in production builds where
+     *  profilers can't be attached. To see the work done by some period, subtract a snapshot taken
+     *  before it from one taken after it.
+     *
+     *  GPU work is counted per context; see GrDirectContext::getGpuCounters() and
+     *  skgpu::graphite::Context::getGpuCounters().
+     */
+    struct SK_API Stats {
+        uint64_t fStrikeCacheHits = 0;         // Glyph strike lookups that found a cached strike.
+        uint64_t fStrikeCacheMisses = 0;       // ... and those that had to create a new strike.
+        uint64_t fGlyphImagesRasterized = 0;   // Glyph masks rendered by a scaler context.
+        uint64_t fGlyphPathsGenerated = 0;     // Glyph outlines generated by a scaler context.
+        uint64_t fResourceCacheHits = 0;       // SkResourceCache lookups (e.g. mipmaps, blurred
+        uint64_t fResourceCacheMisses = 0;     // masks and decoded images) that hit or missed.
+
+        Stats operator-(const Stats& before) const;
+    };
+
+    static Stats GetStats();
+
     typedef std::unique_ptr<SkImageGenerator>
                                             (*ImageGeneratorFromEncodedDataFactory)(sk_sp<SkData>);
 
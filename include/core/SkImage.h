@@ -25,6 +25,7 @@ class GrRecordingContext;
 class SkBitmap;
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkImageFilter;
 class SkImageGenerator;
@@ -540,6 +541,25 @@ public:
                     int srcY,
                     CachingHint cachingHint = kAllow_CachingHint) const;
 
+    /** Like readPixels(context, dst, srcX, srcY, cachingHint), but if SkImage is raster-backed a
+        large copy may be split into bands of rows which are converted in parallel on executor.
+        Other images ignore executor. Returns once every row has been copied.
+
+        @param context      the GrDirectContext in play, if it exists
+        @param dst          destination SkPixmap: SkImageInfo, pixels, row bytes
+        @param srcX         column index whose absolute value is less than width()
+        @param srcY         row index whose absolute value is less than height()
+        @param executor     runs the bands of the copy; may be nullptr
+        @param cachingHint  whether the pixels should be cached locally
+        @return             true if pixels are copied to dst
+    */
+    bool readPixels(GrDirectContext* context,
+                    const SkPixmap& dst,
+                    int srcX,
+                    int srcY,
+                    SkExecutor* executor,
+                    CachingHint cachingHint = kAllow_CachingHint) const;
+
 #ifndef SK_IMAGE_READ_PIXELS_DISABLE_LEGACY_API
     /** Deprecated. Use the variants that accept a GrDirectContext. */
     bool readPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRowBytes,
@@ -692,6 +712,18 @@ public:
     bool scalePixels(const SkPixmap& dst, const SkSamplingOptions&,
                      CachingHint cachingHint = kAllow_CachingHint) const;
 
+    /** Like scalePixels(dst, sampling, cachingHint), but the CPU work of scaling and converting
+        the pixels may be split into bands of rows which run in parallel on executor. Returns once
+        every row has been written.
+
+        @param dst            destination SkPixmap: SkImageInfo, pixels, row bytes
+        @param executor       runs the bands of the scale; may be nullptr
+        @param cachingHint    whether the pixels should be cached locally
+        @return               true if pixels are scaled to fit dst
+    */
+    bool scalePixels(const SkPixmap& dst, const SkSamplingOptions&, SkExecutor* executor,
+                     CachingHint cachingHint = kAllow_CachingHint) const;
+
     /** Returns encoded SkImage pixels as SkData, if SkImage was created from supported
         encoded stream format. Platform support for formats vary and may require building
         with one or more of: SK_ENCODE_JPEG, SK_ENCODE_PNG, SK_ENCODE_WEBP.
@@ -11,6 +11,7 @@
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkYUVAPixmaps.h"
 #include "include/private/base/SkAPI.h"
@@ -94,6 +95,26 @@ public:
         return this->getPixels(pm.info(), pm.writable_addr(), pm.rowBytes());
     }
 
+    /**
+     *  Decodes only the 'subset' of the image (in the coordinates of getInfo()) into 'dst', whose
+     *  dimensions must match the subset's. This lets draws of a small part of a large image skip
+     *  decoding the rest of it.
+     *
+     *  Generators are not required to support this. It returns false if the generator cannot
+     *  decode this subset, in which case callers should decode the whole image with getPixels().
+     */
+    bool getSubsetPixels(const SkPixmap& dst, const SkIRect& subset);
+
+    /**
+     *  Returns dimensions that approximate the image's scaled by 'desiredScale', at which
+     *  getPixels() can decode the image directly, e.g. with a codec's native downscaling. Unlike
+     *  resampling a full decode, this can save decoding time and memory. Generators that cannot
+     *  decode at another size return the image's dimensions.
+     */
+    SkISize getScaledDimensions(float desiredScale) const {
+        return this->onGetScaledDimensions(desiredScale);
+    }
+
     /**
      *  If decoding to YUV is supported, this returns true. Otherwise, this
      *  returns false and the caller will ignore output parameter yuvaPixmapInfo.
@@ -128,6 +149,8 @@ protected:
     virtual sk_sp<SkData> onRefEncodedData() { return nullptr; }
     struct Options {};
     virtual bool onGetPixels(const SkImageInfo&, void*, size_t, const Options&) { return false; }
+    virtual bool onGetSubsetPixels(const SkPixmap&, const SkIRect&) { return false; }
+    virtual SkISize onGetScaledDimensions(float) const { return fInfo.dimensions(); }
     virtual bool onIsValid(GrRecordingContext*) const { return true; }
     virtual bool onIsProtected() const { return false; }
     virtual bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes&,
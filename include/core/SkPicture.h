@@ -11,6 +11,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkShader.h"  // IWYU pragma: keep
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 
 #include <atomic>
@@ -87,6 +88,18 @@ public:
     static sk_sp<SkPicture> MakeFromData(const void* data, size_t size,
                                          const SkDeserialProcs* procs = nullptr);
 
+    /** Like MakeFromData(), but the returned SkPicture may reference data instead of copying from
+        it: its op stream and the encoded images it holds share data's memory, and keep data alive.
+        This makes loading large pictures from a memory-mapped file (see SkData::MakeFromFileName)
+        much cheaper. data must not be modified while the SkPicture or its images exist.
+
+        @param data   container for serial data
+        @param procs  custom serial data decoders; may be nullptr
+        @return       SkPicture constructed from data
+    */
+    static sk_sp<SkPicture> MakeFromSharedData(sk_sp<SkData> data,
+                                               const SkDeserialProcs* procs = nullptr);
+
     /** \class SkPicture::AbortCallback
         AbortCallback is an abstract class. An implementation of AbortCallback may
         passed as a parameter to SkPicture::playback, to stop it before all drawing
@@ -135,6 +148,22 @@ public:
     */
     virtual void playback(SkCanvas* canvas, AbortCallback* callback = nullptr) const = 0;
 
+    /** Replays only the drawing commands that intersect at least one of rects, e.g. the dirty
+        tiles of a frame, in a single pass. Each command is sent to canvas at most once and in
+        its recorded order, and canvas is clipped to the union of rects while they play, so
+        pixels outside of rects are left untouched.
+
+        Commands are culled with the SkBBoxHierarchy the picture was recorded with, if any.
+        Pictures recorded without one build an SkRTree once they have been played back
+        partially more than once.
+
+        @param canvas    receiver of drawing commands
+        @param rects     areas to redraw, in the picture's coordinates
+        @param callback  allows interruption of playback
+    */
+    void playbackRects(SkCanvas* canvas, SkSpan<const SkRect> rects,
+                       AbortCallback* callback = nullptr) const;
+
     /** Returns cull SkRect for this picture, passed in when SkPicture was created.
         Returned SkRect does not specify clipping SkRect for SkPicture; cull is hint
         of SkPicture bounds.
@@ -258,7 +287,8 @@ private:
         bool textBlobsOnly=false) const;
     static sk_sp<SkPicture> MakeFromStreamPriv(SkStream*, const SkDeserialProcs*,
                                                class SkTypefacePlayback*,
-                                               int recursionLimit);
+                                               int recursionLimit,
+                                               const SkData* sharedData = nullptr);
     friend class SkPictureData;
 
     /** Return true if the SkStream/Buffer represents a serialized picture, and
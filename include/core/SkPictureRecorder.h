@@ -13,7 +13,9 @@
 #include "include/core/SkScalar.h"
 #include "include/private/base/SkAPI.h"
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #ifdef SK_BUILD_FOR_ANDROID_FRAMEWORK
 namespace android {
@@ -34,6 +36,13 @@ public:
     SkPictureRecorder();
     ~SkPictureRecorder();
 
+    enum RecordFlags {
+        // Draws of rects, image rects and text blobs share one copy of each distinct paint that
+        // they use, instead of each holding their own. Pictures that repeat a few paints many
+        // times use less memory, and play back with better cache locality.
+        kInternPaints_RecordFlag = 1 << 0,
+    };
+
     /** Returns the canvas that records the drawing commands.
         @param bounds the cull rect used when recording this picture. Any drawing the falls outside
                       of this rect is undefined, and may be drawn or it may not.
@@ -41,9 +50,13 @@ public:
         @param recordFlags optional flags that control recording.
         @return the canvas.
     */
-    SkCanvas* beginRecording(const SkRect& bounds, sk_sp<SkBBoxHierarchy> bbh);
+    SkCanvas* beginRecording(const SkRect& bounds,
+                             sk_sp<SkBBoxHierarchy> bbh,
+                             uint32_t recordFlags = 0);
 
-    SkCanvas* beginRecording(const SkRect& bounds, SkBBHFactory* bbhFactory = nullptr);
+    SkCanvas* beginRecording(const SkRect& bounds,
+                             SkBBHFactory* bbhFactory = nullptr,
+                             uint32_t recordFlags = 0);
 
     SkCanvas* beginRecording(SkScalar width, SkScalar height,
                              SkBBHFactory* bbhFactory = nullptr) {
@@ -90,9 +103,54 @@ public:
      */
     sk_sp<SkDrawable> finishRecordingAsDrawable();
 
+    /**
+     *  Records part of the picture, e.g. an independent subtree of a layout, into its own
+     *  canvas, which may be used on another thread while this recorder's canvas keeps recording.
+     */
+    class SK_API SubRecording {
+    public:
+        ~SubRecording();
+
+        /** Returns the canvas to record into, or null once finish() was called. */
+        SkCanvas* getRecordingCanvas();
+
+        /**
+         *  Ends the sub-recording. This may be called on the thread that recorded it, but it
+         *  must happen before the parent recorder finishes, e.g. by waiting for that thread.
+         *  Sub-recordings that are not finished by then are dropped from the picture.
+         */
+        void finish();
+
+    private:
+        friend class SkPictureRecorder;
+        struct Placeholder;
+
+        SubRecording(sk_sp<Placeholder>, const SkRect& bounds);
+
+        sk_sp<Placeholder>          fPlaceholder;
+        std::unique_ptr<SkRecorder> fRecorder;
+    };
+
+    /**
+     *  Inserts a placeholder at the current point of the recording, and returns a sub-recording
+     *  that fills it in. The sub-recording's canvas starts with the recording canvas' current
+     *  matrix as its identity, and with 'bounds' (in that space) as its cull rect. It uses the
+     *  same RecordFlags as this recorder.
+     *
+     *  When this recorder finishes, the ops of finished sub-recordings are spliced into the
+     *  picture at their placeholders without copying them, so the result is the same as if they
+     *  had been drawn to the recording canvas between a save() and a restore() at that point.
+     *  Returns null if this recorder isn't recording.
+     */
+    std::unique_ptr<SubRecording> beginSubRecording(const SkRect& bounds);
+
 private:
     void reset();
 
+    // Splices finished sub-recordings into fRecord, and returns the bytes used by their
+    // sub-pictures.
+    size_t spliceSubRecordings();
+
     /** Replay the current (partially recorded) operation stream into
         canvas. This call doesn't close the current recording.
     */
@@ -107,6 +165,7 @@ private:
     sk_sp<SkBBoxHierarchy>      fBBH;
     std::unique_ptr<SkRecorder> fRecorder;
     sk_sp<SkRecord>             fRecord;
+    std::vector<sk_sp<SubRecording::Placeholder>> fPlaceholders;
 
     SkPictureRecorder(SkPictureRecorder&&) = delete;
     SkPictureRecorder& operator=(SkPictureRecorder&&) = delete;
@@ -22,6 +22,7 @@
 #include <cstdint>
 
 class SkColorSpace;
+class SkExecutor;
 enum SkAlphaType : int;
 struct SkMask;
 
@@ -669,6 +670,17 @@ public:
         return this->readPixels(dst.info(), dst.writable_addr(), dst.rowBytes(), 0, 0);
     }
 
+    /** Like readPixels(dst, srcX, srcY), but a large copy may be split into bands of rows which
+        are converted in parallel on executor. Returns once every row has been copied.
+
+        @param dst       SkImageInfo and pixel address to write to
+        @param srcX      column index whose absolute value is less than width()
+        @param srcY      row index whose absolute value is less than height()
+        @param executor  runs the bands of the copy; may be nullptr
+        @return          true if pixels are copied to dst
+    */
+    bool readPixels(const SkPixmap& dst, int srcX, int srcY, SkExecutor* executor) const;
+
     /** Copies SkBitmap to dst, scaling pixels to fit dst.width() and dst.height(), and
         converting pixels to match dst.colorType() and dst.alphaType(). Returns true if
         pixels are copied. Returns false if dst address is nullptr, or dst.rowBytes() is
@@ -690,6 +702,15 @@ public:
     */
     bool scalePixels(const SkPixmap& dst, const SkSamplingOptions&) const;
 
+    /** Like scalePixels(dst, sampling), but large destinations may be split into bands of rows
+        which are scaled in parallel on executor. Returns once every row has been written.
+
+        @param dst       SkImageInfo and pixel address to write to
+        @param executor  runs the bands of the scale; may be nullptr
+        @return          true if pixels are scaled to fit dst
+    */
+    bool scalePixels(const SkPixmap& dst, const SkSamplingOptions&, SkExecutor* executor) const;
+
     /** Writes color to pixels bounded by subset; returns true on success.
         Returns false if colorType() is kUnknown_SkColorType, or if subset does
         not intersect bounds().
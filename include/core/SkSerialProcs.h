@@ -15,6 +15,7 @@
 #include <optional>
 
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkPicture;
 class SkTypeface;
@@ -112,6 +113,12 @@ struct SK_API SkDeserialProcs {
     // parameters and returns a bool). Given that there are only two valid implementations of that
     // proc, we just insert the bool directly.
     bool                         fAllowSkSL = true;
+
+    // If set, SkPicture deserialization decodes the picture's images, and creates its typefaces
+    // when there is no fTypefaceProc, concurrently on this executor. The image procs (and the
+    // picture's typeface factories) are then called from several threads at once, so they must
+    // be thread safe. Deserialization still returns only once everything is decoded.
+    SkExecutor*                  fExecutor = nullptr;
 };
 
 #endif
@@ -60,6 +60,9 @@ public:
         // If set, all rendering will have dithering enabled
         // Currently this only impacts GPU backends
         kAlwaysDither_Flag = 1 << 2,
+        // If set, raster surfaces draw paths with many verbs in horizontal bands, concurrently on
+        // SkExecutor::GetDefault(). The result doesn't depend on the executor's thread count.
+        kParallelizeLargePaths_Flag = 1 << 3,
     };
 
     /** No flags, unknown pixel geometry, platform-default contrast/gamma. */
@@ -422,6 +422,12 @@ private:
 
     friend class SkFontPriv;         // getGlyphToUnicodeMap
 
+    /** The part of MakeDeserialize() that follows reading the descriptor. Unlike reading, this
+     *  can run on another thread.
+     */
+    static sk_sp<SkTypeface> MakeFromDescriptor(SkFontDescriptor*, sk_sp<SkFontMgr> lastResortMgr);
+    friend class SkPictureData;      // MakeFromDescriptor
+
 private:
     SkTypefaceID        fUniqueID;
     SkFontStyle         fStyle;
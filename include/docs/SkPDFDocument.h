@@ -159,10 +159,13 @@ struct Metadata {
     /** Executor to handle threaded work within PDF Backend. If this is nullptr,
         then all work will be done serially on the main thread. To have worker
         threads assist with various tasks, set this to a valid SkExecutor
-        instance. Currently used for executing Deflate algorithm in parallel.
+        instance. Currently used for deflating streams, encoding images, and
+        subsetting fonts in parallel.
 
-        If set, the PDF output will be non-reproducible in the order and
-        internal numbering of objects, but should render the same.
+        Streams and fonts are written in the same order, with the same object
+        numbers, as without an executor. Documents containing images may still
+        be non-reproducible in the order and internal numbering of objects, but
+        should render the same.
 
         Experimental.
     */
@@ -189,6 +192,24 @@ struct Metadata {
         kHarfbuzz_Subsetter,
         kSfntly_Subsetter,
     } fSubsetter = kHarfbuzz_Subsetter;
+
+    /** If true, each page object is written to the stream and released as
+        soon as the page ends, and fonts are written out (releasing their
+        glyph usage and tables) whenever the data retained for them grows past
+        fMaxRetainedFontBytes, instead of all at close(). This bounds memory
+        use to roughly that of one page, at the cost of a larger file: a font
+        used across a flush is embedded again as a separate subset.
+
+        Experimental.
+    */
+    bool fStreaming = false;
+
+    /** With fStreaming, the approximate number of bytes of font data (glyph
+        usage and glyph-to-unicode tables) to retain between pages before the
+        fonts used so far are written out. Zero writes them out after every
+        page.
+    */
+    size_t fMaxRetainedFontBytes = 1 << 20;
 };
 
 /** Associate a node ID with subsequent drawing commands in an
@@ -291,6 +291,7 @@ private:
     sk_sp<SkRuntimeEffect> makeUnoptimizedClone();
 
     static Result MakeFromSource(SkString sksl, const Options& options, SkSL::ProgramKind kind);
+    static Result CompileFromSource(SkString sksl, const Options& options, SkSL::ProgramKind kind);
 
     static Result MakeInternal(std::unique_ptr<SkSL::Program> program,
                                const Options& options,
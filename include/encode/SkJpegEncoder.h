@@ -16,6 +16,7 @@
 class SkColorSpace;
 class SkData;
 class SkEncoder;
+class SkExecutor;
 class SkPixmap;
 class SkWStream;
 class SkImage;
@@ -86,6 +87,18 @@ struct Options {
      */
     const skcms_ICCProfile* fICCProfile = nullptr;
     const char* fICCProfileDescription = nullptr;
+
+    /**
+     *  If set, Encode() splits large images into bands of rows, each one restart interval, and
+     *  compresses the bands concurrently on this executor before joining them with restart
+     *  markers.
+     *
+     *  The result is a baseline JPEG that decodes to the same pixels as the result without an
+     *  executor, but uses the standard Huffman tables, so it is slightly larger. It does not
+     *  depend on the executor's number of threads. This is ignored when encoding with an
+     *  SkEncoder from Make(), or when encoding an SkYUVAPixmaps.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
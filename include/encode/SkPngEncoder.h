@@ -19,6 +19,7 @@
 
 class GrDirectContext;
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkPixmap;
 class SkWStream;
@@ -80,6 +81,18 @@ struct Options {
      */
     const skcms_ICCProfile* fICCProfile = nullptr;
     const char* fICCProfileDescription = nullptr;
+
+    /**
+     *  If set, large images are filtered and compressed in bands of rows concurrently on this
+     *  executor. Each band is compressed on its own (primed with the data before it) and the
+     *  bands are joined with zlib sync flushes.
+     *
+     *  The result decodes to the same pixels, but is slightly larger than, and not byte for byte
+     *  the same as, the result without an executor. It does not depend on the executor's
+     *  number of threads, or on how rows are passed to SkEncoder::encodeRows(), which may hold
+     *  on to some rows until a later call.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
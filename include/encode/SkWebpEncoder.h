@@ -16,6 +16,7 @@
 class SkPixmap;
 class SkWStream;
 class SkData;
+class SkExecutor;
 class GrDirectContext;
 class SkImage;
 struct skcms_ICCProfile;
@@ -52,6 +53,16 @@ struct SK_API Options {
      */
     const skcms_ICCProfile* fICCProfile = nullptr;
     const char* fICCProfileDescription = nullptr;
+
+    /**
+     *  If set, libwebp is allowed to use a second thread (its |thread_level| option), e.g. to
+     *  compress the alpha plane of a lossy image alongside its color, or to try more than one
+     *  lossless configuration at high effort. libwebp manages that thread itself rather than
+     *  running it on this executor, so this only acts as the opt-in.
+     *
+     *  The result decodes to the same pixels as the result without an executor.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
@@ -10,6 +10,8 @@
 
 #include "include/core/SkTypes.h"
 
+#include <cstdint>
+
 /**
  * This file includes numerous public types that are used by all of our gpu backends.
  */
@@ -79,6 +81,32 @@ enum class Origin : unsigned {
     kBottomLeft,
 };
 
+/**
+ * Counts of work done by a GPU context since it was created. The counters are always on and cheap
+ * to update, so they can be read in production builds. To see the work done by some period,
+ * subtract a snapshot taken before it from one taken after it.
+ */
+struct GpuCounters {
+    uint64_t fPipelineCompiles = 0;      // Shader pipelines (programs) that had to be created.
+    uint64_t fPipelineCompileNanos = 0;  // Wall time spent creating them on the calling thread.
+    uint64_t fTextureUploadBytes = 0;    // Pixel bytes written into textures.
+    uint64_t fRenderPasses = 0;
+    uint64_t fDrawsRecorded = 0;         // Draws that Skia recorded ...
+    uint64_t fDrawCalls = 0;             // ... and the GPU draw commands issued for them. Batching
+                                         // makes this smaller than fDrawsRecorded.
+
+    GpuCounters operator-(const GpuCounters& before) const {
+        GpuCounters diff;
+        diff.fPipelineCompiles     = fPipelineCompiles     - before.fPipelineCompiles;
+        diff.fPipelineCompileNanos = fPipelineCompileNanos - before.fPipelineCompileNanos;
+        diff.fTextureUploadBytes   = fTextureUploadBytes   - before.fTextureUploadBytes;
+        diff.fRenderPasses         = fRenderPasses         - before.fRenderPasses;
+        diff.fDrawsRecorded        = fDrawsRecorded        - before.fDrawsRecorded;
+        diff.fDrawCalls            = fDrawCalls            - before.fDrawCalls;
+        return diff;
+    }
+};
+
 } // namespace skgpu
 
 
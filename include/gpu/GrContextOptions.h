@@ -110,6 +110,34 @@ struct SK_API GrContextOptions {
      */
     SkExecutor* fExecutor = nullptr;
 
+    /**
+     * If true and fExecutor is set, programs that the draws of a flush need but that aren't in the
+     * runtime program cache are compiled by the driver on fExecutor, starting while the flush is
+     * prepared. The compiles run concurrently with each other and with the rest of the flush, and
+     * a draw only waits if its program is still compiling when it's recorded. Draws are never
+     * skipped. Only the Vulkan backend supports this; other backends always compile on the
+     * flushing thread.
+     */
+    bool fAsyncPipelineCompilation = false;
+
+    /**
+     * If true and fExecutor is set, the Vulkan backend records each render pass into its own
+     * secondary command buffer, and the driver calls that write those command buffers run on
+     * fExecutor while the flush goes on to the next render pass. The command buffers are executed
+     * in the same order as without this. Other backends ignore it.
+     */
+    bool fParallelCommandRecording = false;
+
+    /**
+     * If true, the resource cache limit set with GrDirectContext::setResourceCacheLimit() is only
+     * used within a frame, where a frame ends with each GrDirectContext::submit(). At the end of a
+     * frame the cache purges unlocked resources until it holds no more than one and a half times
+     * the largest set of resources that any of the last 60 frames used. This lets the cache shrink
+     * when content is simple and grow back up to the limit for bursts such as fast scrolling. The
+     * working set, hit and miss counts and bytes purged are reported by dumpMemoryStatistics().
+     */
+    bool fAdaptiveResourceCacheBudget = false;
+
     /** Construct mipmaps manually, via repeated downsampling draw-calls. This is used when
         the driver's implementation (glGenerateMipmap) contains bugs. This requires mipmap
         level control (ie desktop or ES3). */
@@ -135,12 +163,40 @@ struct SK_API GrContextOptions {
      */
     bool fAllowPathMaskCaching = true;
 
+    /**
+     * If non-zero, image filter results are kept in a cache of up to this many bytes that is owned
+     * by the GrDirectContext, instead of a cache that only lives for one draw. Drawing the same
+     * SkImageFilter again with the same layer matrix, clip and source content (e.g. a filter whose
+     * inputs are images or pictures, or a backdrop whose pixels haven't changed) then reuses the
+     * earlier result. Results are held as textures that aren't purged with the resource cache, so
+     * this budget adds to it. GrDirectContext::freeGpuResources() empties the cache.
+     */
+    size_t fImageFilterCacheBytes = 0;
+
     /**
      * If true, the GPU will not be used to perform YUV -> RGB conversion when generating
      * textures from codec-backed images.
      */
     bool fDisableGpuYUVConversion = false;
 
+    /**
+     * If true, opaque 8888 raster images that are drawn without mipmaps are BC1 compressed on the
+     * CPU before they are uploaded, when the backend supports BC1 textures. The compressed texture
+     * is cached like any other image texture, keyed by the image's pixels, and takes 1/8th of the
+     * GPU memory. BC1 is lossy, so this is best suited to photographic content such as map tiles
+     * or thumbnails. Compressing takes CPU time on the first draw of each image.
+     */
+    bool fCompressOpaqueRasterImages = false;
+
+    /**
+     * If true, picture shaders render their tile at the next power-of-two scale at or above the
+     * one they are drawn at, instead of at exactly that scale. Each rendered tile is cached per
+     * scale, so zooming a picture-shaded pattern only renders a new tile when crossing an octave,
+     * and returning to an earlier zoom level reuses the cached tile. Tiles may be up to twice as
+     * large in each dimension and are minified when sampled.
+     */
+    bool fSnapPictureShaderScales = false;
+
     /**
      * The maximum size of cache textures used for Skia's Glyph cache.
      */
@@ -163,6 +219,32 @@ struct SK_API GrContextOptions {
     float fGlyphsAsPathsFontSize = 324;
 #endif
 
+    /**
+     * Glyphs whose masks would be larger than this many device pixels in width or height are
+     * drawn from their outlines, which the GPU rasterizes (e.g. in its path atlas), instead of
+     * from masks rasterized on the CPU and uploaded to the glyph atlas. Lowering it helps large
+     * text whose glyphs are rarely reused. Color glyphs are always drawn as masks. The default
+     * draws every glyph which fits in the glyph atlas as a mask.
+     */
+    int fMaxGlyphMaskDimension = 256;
+
+    /**
+     * Draw distance field text from multi-channel distance fields, which keep the corners of
+     * glyphs sharp when they are magnified. One strike then serves every size drawn as distance
+     * field text, so zooming rasterizes far fewer glyphs. The fields take 4 bytes per texel in the
+     * color glyph atlas instead of 1 in the A8 atlas, and subpixel (LCD) text is drawn grayscale.
+     */
+    bool fMultiChannelDistanceFieldText = false;
+
+    /**
+     * Draw glyphs with outlines in Slugs (and in glyph runs drawn without a text blob, which use
+     * Slugs internally) as paths, which the GPU path renderers rasterize from their curves at
+     * draw time, instead of from masks in the glyph atlas. Such Slugs don't depend on the scale
+     * they were made at, so zooming them rasterizes and uploads no glyphs. Color glyphs are
+     * still drawn as masks.
+     */
+    bool fDrawSlugGlyphsAsPaths = false;
+
     /**
      * Can the glyph atlas use multiple textures. If allowed, the each texture's size is bound by
      * fGlypheCacheTextureMaximumBytes.
@@ -175,6 +257,14 @@ struct SK_API GrContextOptions {
      */
     bool fAvoidStencilBuffers = false;
 
+    /**
+     * Keep the vertices of triangulated paths in the process-wide SkResourceCache as well as in
+     * this context, so that other contexts with this option drawing the same path at a similar
+     * scale upload them instead of triangulating the path again. Useful when several contexts
+     * (e.g. one per window) draw the same complex paths. Costs a CPU copy of each triangulation.
+     */
+    bool fShareTriangulatedPaths = false;
+
     /**
      * Enables driver workaround to use draws instead of HW clears, e.g. glClear on the GL backend.
      */
@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 class GrAtlasManager;
 class GrBackendSemaphore;
@@ -513,6 +514,65 @@ public:
      */
     void checkAsyncWorkCompletion();
 
+    /**
+     * Returns true if setGpuOpTimingsEnabled() can measure GPU time on this context. This needs
+     * GPU timestamp queries, which are currently only used on OpenGL (version 3.3 or
+     * GL_ARB_timer_query) and OpenGL ES (GL_EXT_disjoint_timer_query). Vulkan and Metal are not
+     * supported yet.
+     */
+    bool supportsGpuOpTimings() const;
+
+    /**
+     * While enabled, the GPU time taken by each chain of GrOps that is drawn is measured with a
+     * pair of timestamp queries and added to a total for its op class (e.g. "FillRectOp"). Each
+     * measurement is also reported as a "skia.gpu.optime" trace counter named after the op class.
+     * This adds work to every draw, so it should only be enabled while profiling. Disabling it
+     * drops any timings that have not been taken. On tiling GPUs the times are only approximate.
+     * Measurements taken while the GPU's timer was disrupted (e.g. by a clock change) are dropped.
+     */
+    void setGpuOpTimingsEnabled(bool enabled);
+
+    struct GpuOpTiming {
+        const char*              fOpName;  // The op class. This is a string literal.
+        int                      fCount;   // The number of op chains measured.
+        std::chrono::nanoseconds fTime;    // Their total GPU time.
+    };
+
+    /**
+     * Returns the timings by op class since the last call, and resets them. Only work the GPU has
+     * finished is included, e.g. after submit(GrSyncCpu::kYes).
+     */
+    std::vector<GpuOpTiming> takeGpuOpTimings();
+
+    /**
+     * While enabled, each GPU program that the context builds records how long it spent parsing,
+     * optimizing and generating code from its SkSL, and how long the driver took to compile the
+     * result. Programs found in the GrContextOptions::PersistentCache are recorded too, with the
+     * stages that were skipped left at zero. The stages are traced in the "skia.shaders" category
+     * whether or not this is enabled. Disabling it drops any timings that have not been taken.
+     * This is currently supported by the GL and Vulkan backends.
+     */
+    void setShaderCompileTimingsEnabled(bool enabled);
+
+    struct ShaderCompileTiming {
+        sk_sp<SkData>            fKey;           // The program's GrContextOptions::PersistentCache
+                                                 // key. Use it to pick programs to precompile.
+        std::chrono::nanoseconds fParseTime;     // SkSL parsing and IR generation.
+        std::chrono::nanoseconds fOptimizeTime;  // SkSL inlining and optimization.
+        std::chrono::nanoseconds fCodegenTime;   // SkSL to GLSL or SPIR-V.
+        std::chrono::nanoseconds fDriverTime;    // The driver's shader compiles and program link.
+    };
+
+    /** Returns the timings of the programs built since the last call, and resets them. */
+    std::vector<ShaderCompileTiming> takeShaderCompileTimings();
+
+    /**
+     * Returns the always-on counters of work this context has done since it was created. Subtract
+     * an earlier snapshot to see the work done since then. Draws recorded into DDLs are not
+     * counted in fDrawsRecorded.
+     */
+    skgpu::GpuCounters getGpuCounters() const;
+
     /** Enumerates all cached GPU resources and dumps their memory to traceMemoryDump. */
     // Chrome is using this!
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
@@ -32,6 +32,7 @@ class GrRecordingContextPriv;
 class GrThreadSafeCache;
 class SkArenaAlloc;
 class SkCapabilities;
+class SkImageFilterCache;
 class SkJSONWriter;
 
 namespace sktext::gpu {
@@ -264,6 +265,10 @@ protected:
     // Delete last in case other objects call it during destruction.
     std::unique_ptr<GrAuditTrail>     fAuditTrail;
 
+    // Image filter results that are reused across draws. Only direct contexts with a non-zero
+    // GrContextOptions::fImageFilterCacheBytes have one.
+    sk_sp<SkImageFilterCache>         fImageFilterCache;
+
 private:
     OwnedArenas                       fArenas;
 
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrStreamingReadback_DEFINED
+#define GrStreamingReadback_DEFINED
+
+#include "include/core/SkImage.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkAPI.h"
+
+#include <memory>
+
+class GrDirectContext;
+class SkSurface;
+struct SkIRect;
+struct SkImageInfo;
+
+/**
+ * Reads back a stream of frames from Ganesh surfaces, e.g. for video capture, while keeping up to
+ * maxFramesInFlight() reads in flight. Unlike SkSurface::asyncRescaleAndReadPixels(), which creates
+ * a new transfer buffer for every read, the GPU-to-CPU transfer buffers come from a fixed pool
+ * owned by this object and are reused from frame to frame.
+ *
+ * When a frame is read without any pixel conversion, the AsyncReadResult handed to the callback
+ * points directly at the mapped transfer buffer (no copy is made). That buffer returns to the
+ * pool once the result is destroyed, so clients must release results to keep the stream going.
+ *
+ * All calls must be made on the thread that owns the GrDirectContext. The GrStreamingReadback
+ * may be destroyed while reads are still in flight; their callbacks will still be called.
+ */
+class SK_API GrStreamingReadback {
+public:
+    /** Returns null if 'context' is null or abandoned, or if maxFramesInFlight is less than 1. */
+    static std::unique_ptr<GrStreamingReadback> Make(GrDirectContext* context,
+                                                     int maxFramesInFlight);
+
+    ~GrStreamingReadback();
+
+    /**
+     * Starts reading 'srcRect' of 'surface' into the next free transfer buffer of the pool, as
+     * with SkSurface::asyncRescaleAndReadPixels(). The surface must belong to this object's
+     * context. 'callback' is called exactly once, with null if the read failed. As with
+     * asyncRescaleAndReadPixels(), the read is flushed but the caller must submit it.
+     *
+     * Returns false, without calling 'callback', if all maxFramesInFlight() buffers are still
+     * waiting on the GPU or held by unreleased results. The caller may retry later, e.g. after
+     * GrDirectContext::checkAsyncWorkCompletion() has delivered the oldest frame.
+     */
+    bool readFrame(SkSurface* surface,
+                   const SkImageInfo& dstInfo,
+                   const SkIRect& srcRect,
+                   SkImage::RescaleGamma rescaleGamma,
+                   SkImage::RescaleMode rescaleMode,
+                   SkImage::ReadPixelsCallback callback,
+                   SkImage::ReadPixelsContext callbackContext);
+
+    /** The number of frames that are waiting on the GPU or held by unreleased results. */
+    int framesInFlight() const;
+
+    int maxFramesInFlight() const;
+
+private:
+    class Pool;
+
+    GrStreamingReadback(GrDirectContext*, sk_sp<Pool>);
+
+    GrDirectContext* fContext;
+    sk_sp<Pool> fPool;
+};
+
+#endif
@@ -93,6 +93,7 @@ public:
         GrGLFunction<GrGLBeginQueryFn> fBeginQuery;
         GrGLFunction<GrGLBindAttribLocationFn> fBindAttribLocation;
         GrGLFunction<GrGLBindBufferFn> fBindBuffer;
+        GrGLFunction<GrGLBindBufferRangeFn> fBindBufferRange;
         GrGLFunction<GrGLBindFragDataLocationFn> fBindFragDataLocation;
         GrGLFunction<GrGLBindFragDataLocationIndexedFn> fBindFragDataLocationIndexed;
         GrGLFunction<GrGLBindFramebufferFn> fBindFramebuffer;
@@ -106,6 +107,7 @@ public:
         GrGLFunction<GrGLBlendFuncFn> fBlendFunc;
         GrGLFunction<GrGLBlitFramebufferFn> fBlitFramebuffer;
         GrGLFunction<GrGLBufferDataFn> fBufferData;
+        GrGLFunction<GrGLBufferStorageFn> fBufferStorage;
         GrGLFunction<GrGLBufferSubDataFn> fBufferSubData;
         GrGLFunction<GrGLCheckFramebufferStatusFn> fCheckFramebufferStatus;
         GrGLFunction<GrGLClearFn> fClear;
@@ -185,6 +187,7 @@ public:
         GrGLFunction<GrGLGetStringFn> fGetString;
         GrGLFunction<GrGLGetStringiFn> fGetStringi;
         GrGLFunction<GrGLGetTexLevelParameterivFn> fGetTexLevelParameteriv;
+        GrGLFunction<GrGLGetUniformBlockIndexFn> fGetUniformBlockIndex;
         GrGLFunction<GrGLGetUniformLocationFn> fGetUniformLocation;
         GrGLFunction<GrGLInsertEventMarkerFn> fInsertEventMarker;
         GrGLFunction<GrGLInvalidateBufferDataFn> fInvalidateBufferData;
@@ -286,6 +289,7 @@ public:
         GrGLFunction<GrGLUniform4iFn> fUniform4i;
         GrGLFunction<GrGLUniform4fvFn> fUniform4fv;
         GrGLFunction<GrGLUniform4ivFn> fUniform4iv;
+        GrGLFunction<GrGLUniformBlockBindingFn> fUniformBlockBinding;
         GrGLFunction<GrGLUniformMatrix2fvFn> fUniformMatrix2fv;
         GrGLFunction<GrGLUniformMatrix3fvFn> fUniformMatrix3fv;
         GrGLFunction<GrGLUniformMatrix4fvFn> fUniformMatrix4fv;
@@ -19,8 +19,11 @@
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 class SkColorSpace;
+class SkData;
 class SkRuntimeEffect;
 class SkTraceMemoryDump;
 
@@ -157,6 +160,15 @@ public:
      */
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    /**
+     * Returns the always-on counters of work done by this Context and every Recorder made from it
+     * since the Context was created. Subtract an earlier snapshot to see the work done since then.
+     * Draws and draw calls are counted when a Recorder turns them into a draw pass, texture
+     * uploads when they are recorded, and render passes when they are added to a command buffer.
+     * This may be called from any thread.
+     */
+    skgpu::GpuCounters getGpuCounters() const;
+
     /**
      * Returns true if the backend-specific context has gotten into an unrecoverarble, lost state
      * (e.g. if we've gotten a VK_ERROR_DEVICE_LOST in the Vulkan backend).
@@ -168,6 +180,55 @@ public:
      */
     bool supportsProtectedContent() const;
 
+    /**
+     * Returns true if the backend can time draws on the GPU. Currently only Vulkan devices that
+     * support timestamps on graphics queues can.
+     */
+    bool supportsGpuDrawTimings() const;
+
+    /**
+     * While enabled, each run of draws that a render pass records with one pipeline is timed on
+     * the GPU. This adds a pair of timestamp queries per pipeline change, so it should only be
+     * turned on while profiling. Does nothing if supportsGpuDrawTimings() is false.
+     */
+    void setGpuDrawTimingsEnabled(bool enabled);
+
+    struct GpuDrawTiming {
+        std::string fName;
+        int fCount;                     // The number of timed runs of draws.
+        std::chrono::nanoseconds fTime;  // Their total time on the GPU.
+    };
+    struct GpuDrawTimings {
+        // Keyed by RenderStep name, e.g. "TessellateWedgesRenderStep[convex]".
+        std::vector<GpuDrawTiming> fRenderSteps;
+        // Keyed by the full pipeline: the RenderStep name followed by the paint's shader key.
+        std::vector<GpuDrawTiming> fPipelines;
+    };
+
+    /**
+     * Returns the times of the draws whose command buffers the GPU has finished since the last
+     * call, in no particular order, and resets them. Work that is still in flight is reported by a
+     * later call; submit with SyncToCpu::kYes first to include everything.
+     */
+    GpuDrawTimings takeGpuDrawTimings();
+
+    /**
+     * Returns a manifest of the pipelines this Context has compiled, for a later process to pass
+     * to PrecompileSerializedPipelines() on startup. The manifest only identifies the pipelines;
+     * it holds no compiled shaders and is safe to keep across driver updates. A manifest written
+     * by another version of Skia is ignored. Returns null if no pipeline could be described.
+     */
+    sk_sp<SkData> serializePipelineKeys() const;
+
+    /**
+     * Like serializePipelineKeys(), but only lists the pipelines that draws had to compile because
+     * neither Precompile() nor PrecompileSerializedPipelines() had compiled them first. Run the
+     * app with its usual precompilation to find the gaps in it. The precompile_gen tool turns the
+     * result into PaintOptions, and PrecompileSerializedPipelines() accepts it as is.
+     * Returns null if there were no such pipelines or none could be described.
+     */
+    sk_sp<SkData> serializePipelineMisses() const;
+
     // Provides access to functions that aren't part of the public API.
     ContextPriv priv();
     const ContextPriv priv() const;  // NOLINT(readability-const-return-type)
@@ -70,6 +70,32 @@ struct SK_API ContextOptions {
     float fGlyphsAsPathsFontSize = 324;
 #endif
 
+    /**
+     * Glyphs whose masks would be larger than this many device pixels in width or height are
+     * drawn from their outlines, which the GPU rasterizes (e.g. in its path atlas), instead of
+     * from masks rasterized on the CPU and uploaded to the glyph atlas. Lowering it helps large
+     * text whose glyphs are rarely reused. Color glyphs are always drawn as masks. The default
+     * draws every glyph which fits in the glyph atlas as a mask.
+     */
+    int fMaxGlyphMaskDimension = 256;
+
+    /**
+     * Draw distance field text from multi-channel distance fields, which keep the corners of
+     * glyphs sharp when they are magnified. One strike then serves every size drawn as distance
+     * field text, so zooming rasterizes far fewer glyphs. The fields take 4 bytes per texel in the
+     * color glyph atlas instead of 1 in the A8 atlas, and subpixel (LCD) text is drawn grayscale.
+     */
+    bool fMultiChannelDistanceFieldText = false;
+
+    /**
+     * Draw glyphs with outlines in Slugs (and in glyph runs drawn without a text blob, which use
+     * Slugs internally) as paths, which the GPU path renderers rasterize from their curves at
+     * draw time, instead of from masks in the glyph atlas. Such Slugs don't depend on the scale
+     * they were made at, so zooming them rasterizes and uploads no glyphs. Color glyphs are
+     * still drawn as masks.
+     */
+    bool fDrawSlugGlyphsAsPaths = false;
+
     /**
      * Can the glyph atlas use multiple textures. If allowed, the each texture's size is bound by
      * fGlypheCacheTextureMaximumBytes.
@@ -85,6 +111,20 @@ struct SK_API ContextOptions {
      */
     bool fDisableCachedGlyphUploads = false;
 
+    /**
+     * If true, draws that are completely hidden behind a later opaque rectangle in the same draw
+     * pass are skipped instead of being shaded and then overwritten. This spends some CPU time at
+     * flush to reduce the fragment load of overdraw-heavy content.
+     */
+    bool fEnableOcclusionCulling = false;
+
+    /**
+     * If true, and the backend supports compute, the mip levels of RGBA_8888 textures are
+     * downsampled in a single compute pass (one dispatch per level) instead of one render pass per
+     * level.
+     */
+    bool fGenerateMipmapsWithCompute = false;
+
     static constexpr size_t kDefaultContextBudget = 256 * (1 << 20);
     /**
      * What is the budget for GPU resources allocated and held by the Context.
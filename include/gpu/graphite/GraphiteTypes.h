@@ -43,6 +43,9 @@ using GpuFinishedProc = void (*)(GpuFinishedContext finishedContext, CallbackRes
  * TextureInfo must match the info provided to the Recorder when making the deferred canvas.
  *
  * fTargetTranslation is an additional translation applied to draws targeting fTargetSurface.
+ * A Recording made with a deferred canvas may be inserted any number of times, into the same or
+ * different target surfaces and with a different translation each time, without recording it
+ * again. This is the cheapest way to draw content that only moves between frames.
  *
  * The client may pass in two arrays of initialized BackendSemaphores to be included in the
  * command stream. At some time before issuing commands in the Recording, the fWaitSemaphores will
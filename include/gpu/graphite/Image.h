@@ -14,7 +14,11 @@
 #include "include/core/SkSpan.h"
 #include "include/gpu/GpuTypes.h"
 
+#include <functional>
+#include <vector>
+
 class SkYUVAInfo;
+class SkYUVAPixmapInfo;
 class SkYUVAPixmaps;
 struct SkIRect;
 
@@ -261,6 +265,39 @@ SK_API sk_sp<SkImage> TextureFromYUVAPixmaps(skgpu::graphite::Recorder*,
                                              bool limitToMaxTextureSize = false,
                                              sk_sp<SkColorSpace> imgColorSpace = nullptr);
 
+/** Called by TextureFromYUVAPlanes() to write the planes of the image at 'index', e.g. with
+    SkCodec::getYUVAPlanes(). Returns false if the planes could not be written.
+*/
+using YUVAPlanesWriter = std::function<bool(int index, const SkYUVAPixmaps& planes)>;
+
+/** Creates planar SkImages like TextureFromYUVAPixmaps(), except that the planes are written by
+    'writePlanes' directly into the memory that is uploaded to the GPU, rather than copied there
+    from memory owned by the client. The planes of all the images share one upload buffer and one
+    upload, so creating many small images (e.g. a page of thumbnails) in one call is much cheaper
+    than creating them one at a time.
+
+    'writePlanes' is called once for each valid entry of 'pixmapInfos', before this returns. The
+    planes it is passed use the color types of the SkYUVAPixmapInfo, but their row bytes are
+    chosen for the GPU and may differ from those of the SkYUVAPixmapInfo. Their initial contents
+    are undefined.
+
+    The images are not mipmapped. If a plane cannot be uploaded without converting it to another
+    color type, or is larger than the GPU's maximum texture size, that image is not created and
+    the client may fall back to TextureFromYUVAPixmaps().
+
+    @param Recorder        The Recorder to use for storing commands
+    @param pixmapInfos     The plane layout of each image, e.g. from SkCodec::queryYUVAInfo()
+    @param writePlanes     Writes the planes of each image
+    @param imgColorSpace   Range of colors of the resulting images; may be nullptr
+    @return                An SkImage per entry of 'pixmapInfos', which is nullptr for each image
+                           that could not be created or whose planes 'writePlanes' did not write
+*/
+SK_API std::vector<sk_sp<SkImage>> TextureFromYUVAPlanes(
+        skgpu::graphite::Recorder*,
+        SkSpan<const SkYUVAPixmapInfo> pixmapInfos,
+        const YUVAPlanesWriter& writePlanes,
+        sk_sp<SkColorSpace> imgColorSpace = nullptr);
+
 /** Creates an SkImage from YUV[A] planar textures associated with the recorder.
      @param recorder            The recorder.
      @param yuvaBackendTextures A set of textures containing YUVA data and a description of the
@@ -20,6 +20,8 @@
 
 struct AHardwareBuffer;
 class SkCanvas;
+class SkExecutor;
+class SkTaskGroup;
 struct SkImageInfo;
 class SkPixmap;
 class SkTraceMemoryDump;
@@ -70,6 +72,16 @@ struct SK_API RecorderOptions final {
     static constexpr size_t kDefaultRecorderBudget = 256 * (1 << 20);
     // What is the budget for GPU resources allocated and held by this Recorder.
     size_t fGpuBudgetInBytes = kDefaultRecorderBudget;
+
+    // If set, snap() uses it to sort the draws of large DrawPasses on several threads, and large
+    // raster images copy their pixels into upload buffers on it while recording continues. The
+    // executor must outlive the Recorder.
+    SkExecutor* fExecutor = nullptr;
+
+    // If true, each surface remembers the order its last draw pass was sorted into, and reuses it
+    // when the next frame records the same sequence of draws. This suits UIs that redraw mostly
+    // the same content every frame, at the cost of a copy of the sort keys per surface.
+    bool fRetainDrawOrder = false;
 };
 
 class SK_API Recorder final {
@@ -228,6 +240,10 @@ private:
     std::unique_ptr<sktext::gpu::StrikeCache> fStrikeCache;
     std::unique_ptr<sktext::gpu::TextBlobRedrawCoordinator> fTextBlobCache;
     sk_sp<ImageProvider> fClientImageProvider;
+    SkExecutor* fExecutor;
+    // Pixel copies into upload buffers that are running on fExecutor. snap() waits for them.
+    std::unique_ptr<SkTaskGroup> fUploadTasks;
+    bool fRetainDrawOrder;
 
     // In debug builds we guard against improper thread handling
     // This guard is passed to the ResourceCache.
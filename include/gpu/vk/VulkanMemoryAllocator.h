@@ -12,6 +12,8 @@
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/vk/VulkanTypes.h"
 
+class SkTraceMemoryDump;
+
 namespace skgpu {
 
 class VulkanMemoryAllocator : public SkRefCnt {
@@ -107,6 +109,11 @@ public:
     // amount of memory in use by an allocation from this allocator.
     // Return 1st param is total allocated memory, 2nd is total used memory.
     virtual std::pair<uint64_t, uint64_t> totalAllocatedAndUsedMemory() const = 0;
+
+    // Reports how the allocator's device memory is used, e.g. how much of it is held in blocks
+    // but free and how fragmented that free space is. Called when the owning GrDirectContext or
+    // graphite::Context dumps its memory statistics.
+    virtual void dumpMemoryStatistics(SkTraceMemoryDump*) const {}
 };
 
 } // namespace skgpu
@@ -106,7 +106,9 @@ private:
     SkTDArray<SkPathOp> fOps;
 
     static bool FixWinding(SkPath* path);
+    static bool IsAssociative(const SkPathOp ops[], int count);
     static void ReversePath(SkPath* path);
+    bool resolvePairwise(SkPathOp op, SkPath* result);
     void reset();
 };
 
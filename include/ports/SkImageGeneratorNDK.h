@@ -14,8 +14,12 @@
 #include "include/core/SkData.h"
 #include "include/core/SkImageGenerator.h"
 
+#include <functional>
 #include <memory>
 
+class SkExecutor;
+class SkImage;
+
 namespace SkImageGeneratorNDK {
 /**
  *  Create a generator that uses the Android NDK's APIs for decoding images.
@@ -34,6 +38,28 @@ namespace SkImageGeneratorNDK {
  *  dimensions are supported?
  */
 SK_API std::unique_ptr<SkImageGenerator> MakeFromEncodedNDK(sk_sp<SkData>);
+
+#if defined(SK_GANESH)
+/**
+ *  Decode with AImageDecoder straight into a new AHardwareBuffer, and return an image backed by
+ *  the buffer (see SkImages::DeferredFromAHardwareBuffer). Drawing the image with a GPU context
+ *  samples the decoded pixels in place, without the copy to a texture that decoding to memory
+ *  and uploading would need.
+ *
+ *  The image has the color space of the encoded data; no color space transformation is applied.
+ *  Returns nullptr if the data can't be decoded, or if the device can't allocate a buffer that is
+ *  both CPU-writable and GPU-sampleable in the decoded color type.
+ */
+SK_API sk_sp<SkImage> DecodeToHardwareBufferImage(sk_sp<SkData>);
+
+/**
+ *  Like DecodeToHardwareBufferImage(), but decodes on the executor and calls done with the image
+ *  (or nullptr) on the executor's thread.
+ */
+SK_API void DecodeToHardwareBufferImageAsync(sk_sp<SkData>,
+                                             SkExecutor*,
+                                             std::function<void(sk_sp<SkImage>)> done);
+#endif
 }
 
 #endif // SK_ENABLE_NDK_IMAGES
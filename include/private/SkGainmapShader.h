@@ -14,6 +14,7 @@
 class SkColorSpace;
 class SkShader;
 class SkImage;
+class SkPixmap;
 struct SkGainmapInfo;
 struct SkRect;
 struct SkSamplingOptions;
@@ -49,6 +50,22 @@ public:
                                 const SkRect& dstRect,
                                 float dstHdrRatio,
                                 sk_sp<SkColorSpace> dstColorSpace);
+
+    /**
+     *  Apply the gainmap to the base image on the CPU, writing the rendition for dstHdrRatio to
+     *  dst in dst's color type and color space. This computes what drawing the shader from Make()
+     *  over all of dst would, with the gainmap stretched to dst's dimensions using linear
+     *  filtering, but once: use it for images that are shown at a fixed HDR to SDR ratio rather
+     *  than paying for the gainmap math on every draw. An F16 dst keeps the HDR range.
+     *
+     *  base must have dst's dimensions. Returns false if the dimensions don't match, or if any
+     *  of the pixmaps can't be read or written.
+     */
+    static bool ApplyToPixmap(const SkPixmap& base,
+                              const SkPixmap& gainmap,
+                              const SkGainmapInfo& gainmapInfo,
+                              float dstHdrRatio,
+                              const SkPixmap& dst);
 };
 
 #endif
@@ -67,6 +67,9 @@ public:
     private:
         mutable SkMutex fMutex;
         skia_private::STArray<1, sk_sp<SkIDChangeListener>> fListeners SK_GUARDED_BY(fMutex);
+        // Mirrors fListeners.size(), so that changed() and reset() can skip the mutex when there
+        // is nothing to do. Most lists (e.g. those of temporary paths) never get a listener.
+        std::atomic<int> fCount{0};
     };
 
 private:
@@ -13,13 +13,17 @@
 #include "include/private/chromium/GrDeferredDisplayList.h"
 #include "include/private/chromium/GrSurfaceCharacterization.h"
 
+#include <vector>
+
 class GrBackendFormat;
 class GrRecordingContext;
 class GrRenderTargetProxy;
 class GrYUVABackendTextureInfo;
 class SkCanvas;
 class SkColorSpace;
+class SkExecutor;
 class SkImage;
+class SkPicture;
 class GrPromiseImageTexture;
 class SkSurface;
 enum SkAlphaType : int;
@@ -98,4 +102,23 @@ private:
     sk_sp<SkSurface>                            fSurface;
 };
 
+namespace skgpu::ganesh {
+/** Splits the bounds of the characterization into numXDivisions x numYDivisions tiles and records
+    the picture, clipped to each tile, into a DDL of its own. If executor is not null the tiles are
+    recorded on its threads, otherwise they are recorded on the calling thread.
+
+    Each DDL only draws into its own tile, so they can be drawn with DrawDDL, in any order, into a
+    surface compatible with the characterization. Images in the picture are uploaded by each DDL
+    that draws them; convert them to promise images first to share a single texture.
+
+    @return  the DDLs in row-major tile order, or an empty vector if the characterization is
+             invalid, either division count is not positive, or a DDL could not be recorded.
+*/
+SK_API std::vector<sk_sp<GrDeferredDisplayList>> RecordTiledDDLs(const GrSurfaceCharacterization&,
+                                                                 const SkPicture*,
+                                                                 int numXDivisions,
+                                                                 int numYDivisions,
+                                                                 SkExecutor* executor = nullptr);
+}  // namespace skgpu::ganesh
+
 #endif
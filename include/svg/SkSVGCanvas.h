@@ -23,6 +23,8 @@ public:
         kConvertTextToPaths_Flag   = 0x01, // emit text as <path>s
         kNoPrettyXML_Flag          = 0x02, // suppress newlines and tabs in output
         kRelativePathEncoding_Flag = 0x04, // use relative commands for path encoding
+        kReusePaths_Flag           = 0x08, // emit paths drawn more than once as <use>s of a
+                                           // shared <path> definition
     };
 
     /**
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPictureDamage_DEFINED
+#define SkPictureDamage_DEFINED
+
+#include "include/core/SkRegion.h"
+#include "include/core/SkTypes.h"
+
+class SkPicture;
+
+class SK_API SkPictureDamage {
+public:
+    /**
+     *  Returns the area, in the pictures' coordinates, where playing back 'after' may produce
+     *  different pixels than playing back 'before'. Pixels outside of the region are guaranteed
+     *  to match, so a frame recorded as 'after' can be drawn with its canvas clipped to the
+     *  damage on top of the previous frame, and the damage can be passed on as a partial present
+     *  hint.
+     *
+     *  The draws of the two pictures are matched up in order. A draw is unchanged if it has the
+     *  same geometry, paint, matrix and clip in both pictures; images, vertices, drawables and
+     *  nested pictures are compared by their unique IDs. The damage is the union of the bounds
+     *  of the draws that only one of the pictures has.
+     *
+     *  If either picture is null, the damage is the cull rect of the other one.
+     */
+    static SkRegion Compute(const SkPicture* before, const SkPicture* after);
+};
+
+#endif
@@ -63,6 +63,24 @@ public:
                            SkColor ambientColor, SkColor spotColor,
                            uint32_t flags = SkShadowFlags::kNone_ShadowFlag);
 
+    /**
+     * Draw the shadows of several occluders lit by the same light, as if DrawShadow() were called
+     * for each path in turn with its zPlaneParams. Drawing a frame's shadows together, before the
+     * occluders that cast them, lets the GPU backends batch them into fewer draws. This is only
+     * correct if no occluder overlaps the shadow of an occluder that comes later in the arrays.
+     *
+     * @param canvas  The canvas on which to draw the shadows.
+     * @param paths  The occluders used to generate the shadows.
+     * @param zPlaneParams  The plane function of each occluder, as for DrawShadow().
+     * @param count  The number of paths and zPlaneParams.
+     *
+     * The light, colors and flags are as for DrawShadow(), and are shared by all of the shadows.
+     */
+    static void DrawShadows(SkCanvas* canvas, const SkPath paths[], const SkPoint3 zPlaneParams[],
+                            int count, const SkPoint3& lightPos, SkScalar lightRadius,
+                            SkColor ambientColor, SkColor spotColor,
+                            uint32_t flags = SkShadowFlags::kNone_ShadowFlag);
+
     /**
      * Generate bounding box for shadows relative to path. Includes both the ambient and spot
      * shadow bounds.
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTiledImage_DEFINED
+#define SkTiledImage_DEFINED
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkTypes.h"
+
+#include <memory>
+#include <utility>
+
+class SkCodec;
+class SkExecutor;
+class SkPaint;
+
+/**
+ *  Draws an encoded image that is too large to decode at once (e.g. a gigapixel photo or scan).
+ *
+ *  The image is split into square tiles. Each draw() only needs the tiles that intersect the
+ *  canvas' clip; the ones that aren't decoded yet are decoded from their subset of the encoded
+ *  image on an SkExecutor, and drawn by a later draw() once they are ready. Until then, their
+ *  area is drawn from a low resolution placeholder of the whole image, which is decoded (with
+ *  downsampling) before any tile.
+ *
+ *  Decoded tiles are kept in an LRU cache of at most Options::fMaxResidentTiles tiles. When a
+ *  tile is drawn to a GPU canvas, its texture stays cached by the GPU context until the tile is
+ *  evicted, so the cache also bounds the tile textures that are kept resident.
+ *
+ *  An SkTiledImage must only be used from one thread at a time. It is safe to destroy it while
+ *  decodes are pending; the destructor waits for the decode that is running, if any, and drops
+ *  the rest.
+ */
+class SK_API SkTiledImage {
+public:
+    struct Options {
+        // The width and height of each tile, rounded up to an even number (some codecs can only
+        // decode subsets that start at even coordinates). GPU canvases should use tiles that fit
+        // in a texture.
+        int fTileSize = 1024;
+
+        // The most decoded tiles that are kept at once. If a single draw() needs more tiles than
+        // this, the limit is raised to that many tiles.
+        int fMaxResidentTiles = 64;
+
+        // The placeholder is downsampled by the largest integer factor that keeps its larger
+        // dimension at least this big. If zero, no placeholder is drawn.
+        int fPlaceholderSize = 1024;
+
+        // Tiles are decoded one at a time on this executor. If null, SkExecutor::GetDefault() is
+        // used.
+        SkExecutor* fExecutor = nullptr;
+    };
+
+    /**
+     *  Returns null if 'codec' is null or its image is empty. Tiles that 'codec' fails to decode
+     *  (e.g. because it cannot decode that subset) keep being drawn from the placeholder.
+     */
+    static std::unique_ptr<SkTiledImage> Make(std::unique_ptr<SkCodec> codec,
+                                              const Options& options);
+    static std::unique_ptr<SkTiledImage> Make(std::unique_ptr<SkCodec> codec) {
+        return Make(std::move(codec), Options());
+    }
+
+    ~SkTiledImage();
+
+    SkISize dimensions() const;
+    int width() const { return this->dimensions().width(); }
+    int height() const { return this->dimensions().height(); }
+
+    /**
+     *  Draws the 'src' area of the image into 'dst', like SkCanvas::drawImageRect(). Visible tiles
+     *  that aren't decoded yet are drawn from the placeholder (or not at all, if it isn't decoded
+     *  yet either) and queued for decoding. Tiles that earlier draws queued, but which haven't
+     *  started decoding, are dropped from the queue, so panning away cancels them.
+     *
+     *  Each tile is drawn separately, so filtering does not blend pixels across tile edges.
+     *
+     *  Returns true if every visible tile was drawn at full resolution. Clients that get false
+     *  should draw again later, e.g. on their next frame.
+     */
+    bool draw(SkCanvas* canvas,
+              const SkRect& src,
+              const SkRect& dst,
+              const SkSamplingOptions& sampling = {},
+              const SkPaint* paint = nullptr);
+
+    bool draw(SkCanvas* canvas,
+              const SkRect& dst,
+              const SkSamplingOptions& sampling = {},
+              const SkPaint* paint = nullptr) {
+        return this->draw(canvas, SkRect::Make(this->dimensions()), dst, sampling, paint);
+    }
+
+    /** The number of decoded tiles, not counting the placeholder. */
+    int residentTileCount() const;
+
+    /** Blocks until every scheduled decode has finished. */
+    void waitForPendingDecodes();
+
+private:
+    class Impl;
+
+    explicit SkTiledImage(std::unique_ptr<Impl>);
+
+    std::unique_ptr<Impl> fImpl;
+};
+
+#endif
@@ -0,0 +1,28 @@
+// Copyright 2024 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#ifndef PolygonOps_DEFINED
+#define PolygonOps_DEFINED
+
+#include "include/core/SkPath.h"
+#include "include/pathops/SkPathOps.h"
+
+#include <optional>
+
+namespace bentleyottmann {
+
+// Combines two paths made only of lines, like Op() in SkPathOps, honoring each path's fill type.
+//
+// The points are snapped to a grid of 1/Contours::kScaleFactor, and everything after that is done
+// with exact integer predicates: the only rounding is where two edges cross, and the crossing
+// points are rounded to the grid. So unlike SkPathOps there are no tolerances to tune and no
+// coincidence handling to go wrong, at the cost of moving the output by up to half a grid step.
+//
+// The result has the winding fill type (or inverse winding), with every region of it wound once.
+//
+// Returns nullopt if either path has curves or points which don't fit the grid, so the caller can
+// fall back to Op().
+std::optional<SkPath> polygon_op(const SkPath& one, const SkPath& two, SkPathOp op);
+}  // namespace bentleyottmann
+
+#endif  // PolygonOps_DEFINED
@@ -0,0 +1,527 @@
+// Copyright 2024 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "modules/bentleyottmann/include/PolygonOps.h"
+
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkScalar.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTo.h"
+#include "modules/bentleyottmann/include/Contour.h"
+#include "modules/bentleyottmann/include/Point.h"
+#include "modules/bentleyottmann/include/Segment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace bentleyottmann {
+namespace {
+
+// Splitting edges where they cross moves them by up to half a grid step, which can make new
+// crossings. Give up if they are not all found after this many rounds.
+constexpr int kMaxSplitPasses = 8;
+
+// Keeping the coordinates to 30 bits keeps their differences to 31 bits, and the cross products
+// of differences to 63.
+constexpr double kMaxCoordinate = 1 << 29;
+
+// An edge between two grid points, from upper to lower (see Point's ordering). The winding is
+// the number of times each operand's contours go along the edge from upper to lower, minus the
+// number of times they come back.
+struct Edge {
+    Point upper;
+    Point lower;
+    int winding[2];
+
+    Segment segment() const { return {upper, lower}; }
+};
+
+// Returns < 0, 0 or > 0 as c is on the +x side of, on, or on the -x side of the line from a down
+// to b.
+int64_t orient(Point a, Point b, Point c) {
+    return SkToS64(b.x - a.x) * SkToS64(c.y - a.y) - SkToS64(b.y - a.y) * SkToS64(c.x - a.x);
+}
+
+// Adds the edge from p0 to p1 to 'edges' on behalf of 'operand'.
+void add_edge(Point p0, Point p1, int operand, int winding, std::vector<Edge>* edges) {
+    if (p0 == p1) {
+        return;
+    }
+    Edge& edge = edges->emplace_back();
+    if (p1 < p0) {
+        std::swap(p0, p1);
+        winding = -winding;
+    }
+    edge.upper = p0;
+    edge.lower = p1;
+    edge.winding[operand] = winding;
+    edge.winding[1 - operand] = 0;
+}
+
+// If 'transpose' is set, swaps x and y.
+bool add_path_edges(const SkPath& path, int operand, bool transpose, std::vector<Edge>* edges) {
+    if (!path.isFinite() || (path.getSegmentMasks() & ~SkPath::kLine_SegmentMask)) {
+        return false;
+    }
+    const SkRect& bounds = path.getBounds();
+    double extent = std::max({std::fabs(bounds.fLeft), std::fabs(bounds.fTop),
+                              std::fabs(bounds.fRight), std::fabs(bounds.fBottom)});
+    if (extent * contour::Contours::kScaleFactor >= kMaxCoordinate) {
+        return false;
+    }
+
+    for (const contour::Contour& contour : contour::Contours::Make(path)) {
+        const size_t count = contour.points.size();
+        for (size_t i = 0; i < count; ++i) {
+            const contour::Point& p0 = contour.points[i];
+            const contour::Point& p1 = contour.points[i + 1 < count ? i + 1 : 0];
+            if (transpose) {
+                add_edge({p0.y, p0.x}, {p1.y, p1.x}, operand, 1, edges);
+            } else {
+                add_edge({p0.x, p0.y}, {p1.x, p1.y}, operand, 1, edges);
+            }
+        }
+    }
+    return true;
+}
+
+struct Split {
+    size_t edge;
+    Point at;
+};
+
+// Is p strictly between the ends of e, given that it is on e's line?
+bool inside_collinear(const Edge& e, Point p) {
+    return e.upper < p && p < e.lower;
+}
+
+// Finds the points where e0 and e1 touch or cross inside one of them. Returns true if a crossing
+// point had to be rounded to the grid.
+bool find_splits(const Edge& e0, size_t i0, const Edge& e1, size_t i1,
+                 std::vector<Split>* splits) {
+    const int64_t o0 = orient(e0.upper, e0.lower, e1.upper),
+                  o1 = orient(e0.upper, e0.lower, e1.lower),
+                  o2 = orient(e1.upper, e1.lower, e0.upper),
+                  o3 = orient(e1.upper, e1.lower, e0.lower);
+
+    // The ends of one edge on the other are exact, whether the edges overlap or just touch.
+    auto splitIfInside = [&](int64_t o, const Edge& e, size_t i, Point p) {
+        if (o == 0 && inside_collinear(e, p)) {
+            splits->push_back({i, p});
+        }
+    };
+    splitIfInside(o0, e0, i0, e1.upper);
+    splitIfInside(o1, e0, i0, e1.lower);
+    splitIfInside(o2, e1, i1, e0.upper);
+    splitIfInside(o3, e1, i1, e0.lower);
+
+    if (((o0 < 0 && o1 > 0) || (o0 > 0 && o1 < 0)) && ((o2 < 0 && o3 > 0) || (o2 > 0 && o3 < 0))) {
+        // The edges cross inside both of them. o2 and o3 are proportional to the distances of
+        // e0's ends from e1's line.
+        const double t = static_cast<double>(o2) / (static_cast<double>(o2) - o3);
+        const Point crossing = {
+                e0.upper.x + SkToS32(std::llround(t * (e0.lower.x - e0.upper.x))),
+                e0.upper.y + SkToS32(std::llround(t * (e0.lower.y - e0.upper.y)))};
+        splits->push_back({i0, crossing});
+        splits->push_back({i1, crossing});
+        return true;
+    }
+    return false;
+}
+
+// Splits the edges at the 'splits', which are sorted by edge.
+void apply_splits(const std::vector<Split>& splits, std::vector<Edge>* edges) {
+    std::vector<Point> points;
+    for (auto cursor = splits.begin(); cursor != splits.end();) {
+        const size_t index = cursor->edge;
+        const Edge edge = (*edges)[index];
+        points.clear();
+        for (; cursor != splits.end() && cursor->edge == index; ++cursor) {
+            if (cursor->at != edge.upper && cursor->at != edge.lower) {
+                points.push_back(cursor->at);
+            }
+        }
+        if (points.empty()) {
+            continue;
+        }
+
+        // Rounded crossings may be a little off the edge, so order them by how far along it they
+        // are, not by their y.
+        const int64_t dx = edge.lower.x - edge.upper.x,
+                      dy = edge.lower.y - edge.upper.y;
+        auto along = [&](Point p) {
+            return (p.x - edge.upper.x) * dx + (p.y - edge.upper.y) * dy;
+        };
+        std::sort(points.begin(), points.end(), [&](Point p0, Point p1) {
+            return std::make_tuple(along(p0), p0) < std::make_tuple(along(p1), p1);
+        });
+        points.erase(std::unique(points.begin(), points.end()), points.end());
+
+        // The first piece replaces the edge, and the rest go on the end.
+        Point start = edge.upper;
+        bool first = true;
+        points.push_back(edge.lower);
+        for (Point end : points) {
+            if (first) {
+                (*edges)[index].lower = end;
+                first = false;
+            } else {
+                SkASSERT(start != end);
+                const bool backwards = end < start;
+                Edge& piece = edges->emplace_back();
+                piece.upper = backwards ? end : start;
+                piece.lower = backwards ? start : end;
+                piece.winding[0] = backwards ? -edge.winding[0] : edge.winding[0];
+                piece.winding[1] = backwards ? -edge.winding[1] : edge.winding[1];
+            }
+            start = end;
+        }
+        // A split point off the edge can make the first piece go backwards.
+        Edge& firstPiece = (*edges)[index];
+        if (firstPiece.lower < firstPiece.upper) {
+            std::swap(firstPiece.upper, firstPiece.lower);
+            firstPiece.winding[0] = -firstPiece.winding[0];
+            firstPiece.winding[1] = -firstPiece.winding[1];
+        }
+    }
+}
+
+// Splits the edges where they cross, touch, or overlap until they only meet at their ends, then
+// merges the edges which are the same. Returns false if that doesn't settle.
+bool make_planar(std::vector<Edge>* edges) {
+    struct Bounds {
+        int32_t left, top, right, bottom;
+    };
+    std::vector<Bounds> bounds;
+    std::vector<size_t> order;
+    std::vector<size_t> active;
+    std::vector<Split> splits;
+    for (int pass = 0; pass < kMaxSplitPasses; ++pass) {
+        bounds.resize(edges->size());
+        order.resize(edges->size());
+        for (size_t i = 0; i < edges->size(); ++i) {
+            const auto [l, t, r, b] = (*edges)[i].segment().bounds();
+            bounds[i] = {l, t, r, b};
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&bounds](size_t i0, size_t i1) {
+            return bounds[i0].top < bounds[i1].top;
+        });
+
+        // Sweep down, testing each edge against the earlier edges which reach its top.
+        active.clear();
+        splits.clear();
+        bool rounded = false;
+        for (size_t index : order) {
+            const Bounds& edgeBounds = bounds[index];
+            active.erase(std::remove_if(active.begin(), active.end(), [&](size_t i) {
+                return bounds[i].bottom < edgeBounds.top;
+            }), active.end());
+            for (size_t other : active) {
+                if (bounds[other].left <= edgeBounds.right &&
+                        edgeBounds.left <= bounds[other].right) {
+                    rounded |= find_splits((*edges)[other], other, (*edges)[index], index, &splits);
+                }
+            }
+            active.push_back(index);
+        }
+
+        if (!splits.empty()) {
+            std::sort(splits.begin(), splits.end(), [](const Split& s0, const Split& s1) {
+                return s0.edge < s1.edge;
+            });
+            apply_splits(splits, edges);
+        }
+
+        // Splitting at points on the edges doesn't move them, so only rounding can add crossings.
+        if (!rounded) {
+            std::sort(edges->begin(), edges->end(), [](const Edge& e0, const Edge& e1) {
+                return std::tie(e0.upper, e0.lower) < std::tie(e1.upper, e1.lower);
+            });
+            size_t merged = 0;
+            for (const Edge& edge : *edges) {
+                if (merged > 0 && (*edges)[merged - 1].upper == edge.upper &&
+                                  (*edges)[merged - 1].lower == edge.lower) {
+                    (*edges)[merged - 1].winding[0] += edge.winding[0];
+                    (*edges)[merged - 1].winding[1] += edge.winding[1];
+                } else {
+                    (*edges)[merged++] = edge;
+                }
+            }
+            edges->resize(merged);
+            edges->erase(std::remove_if(edges->begin(), edges->end(), [](const Edge& e) {
+                return e.winding[0] == 0 && e.winding[1] == 0;
+            }), edges->end());
+            return true;
+        }
+    }
+    return false;
+}
+
+struct Windings {
+    int w[2] = {0, 0};
+};
+
+class Classifier {
+public:
+    Classifier(const SkPath& one, const SkPath& two, SkPathOp op)
+            : fFillTypes{one.getFillType(), two.getFillType()}
+            , fOp{op}
+            , fOutsideIsInside{this->isInResult(Windings{})} {}
+
+    bool outsideIsInside() const { return fOutsideIsInside; }
+
+    // Is the region with these windings inside the result's path? The region around everything
+    // is always outside: when it is in the result, the result has an inverse fill type.
+    bool isInside(const Windings& windings) const {
+        return this->isInResult(windings) != fOutsideIsInside;
+    }
+
+private:
+    bool isInResult(const Windings& windings) const {
+        bool in[2];
+        for (int i = 0; i < 2; ++i) {
+            int w = windings.w[i];
+            bool filled = SkPathFillType_IsEvenOdd(fFillTypes[i]) ? (w & 1) != 0 : w != 0;
+            in[i] = filled != SkPathFillType_IsInverse(fFillTypes[i]);
+        }
+        bool inside = false;
+        switch (fOp) {
+            case kDifference_SkPathOp:        inside = in[0] && !in[1]; break;
+            case kIntersect_SkPathOp:         inside = in[0] && in[1];  break;
+            case kUnion_SkPathOp:             inside = in[0] || in[1];  break;
+            case kXOR_SkPathOp:               inside = in[0] != in[1];  break;
+            case kReverseDifference_SkPathOp: inside = in[1] && !in[0]; break;
+        }
+        return inside;
+    }
+
+    const SkPathFillType fFillTypes[2];
+    const SkPathOp fOp;
+    const bool fOutsideIsInside;
+};
+
+// An edge of the result, going so the result is on its +x side when it goes down.
+struct DirectedEdge {
+    Point from;
+    Point to;
+};
+
+// The same as orient(s.upper, s.lower, p) <= 0, spelled as "s is at or left of p".
+bool at_or_left_of(const Edge& s, Point p) {
+    return orient(s.upper, s.lower, p) <= 0;
+}
+
+// Sweeps down the planar edges, accumulating the windings across each band between vertices to
+// find which side of each edge is in the result.
+std::vector<DirectedEdge> classify(const std::vector<Edge>& edges, const Classifier& classifier) {
+    std::vector<DirectedEdge> result;
+    auto keep = [&](const Edge& edge, const Windings& before, const Windings& after) {
+        bool insideBefore = classifier.isInside(before),
+             insideAfter  = classifier.isInside(after);
+        if (insideBefore != insideAfter) {
+            // 'before' is on the -x side of a non-horizontal edge, or above a horizontal one.
+            bool forward = edge.upper.y == edge.lower.y ? insideBefore : insideAfter;
+            result.push_back(forward ? DirectedEdge{edge.upper, edge.lower}
+                                     : DirectedEdge{edge.lower, edge.upper});
+        }
+    };
+
+    auto windingsLeftOf = [&edges](const std::vector<size_t>& active, Point p) {
+        Windings windings;
+        for (size_t i : active) {
+            if (!at_or_left_of(edges[i], p)) {
+                break;
+            }
+            windings.w[0] += edges[i].winding[0];
+            windings.w[1] += edges[i].winding[1];
+        }
+        return windings;
+    };
+
+    // The edges are sorted by upper, so they start in the order the sweep reaches them.
+    std::vector<size_t> lowers;
+    {
+        lowers.reserve(edges.size());
+        for (size_t i = 0; i < edges.size(); ++i) {
+            if (edges[i].upper.y != edges[i].lower.y) {
+                lowers.push_back(i);
+            }
+        }
+        std::sort(lowers.begin(), lowers.end(), [&edges](size_t i0, size_t i1) {
+            return edges[i0].lower.y < edges[i1].lower.y;
+        });
+    }
+
+    // The non-horizontal edges crossing the band below the current y, in order of x.
+    std::vector<size_t> active;
+    std::vector<size_t> horizontals;
+    std::vector<Windings> above;
+    size_t nextUpper = 0,
+           nextLower = 0;
+    while (nextUpper < edges.size() || nextLower < lowers.size()) {
+        int32_t y = INT32_MAX;
+        if (nextUpper < edges.size()) {
+            y = edges[nextUpper].upper.y;
+        }
+        if (nextLower < lowers.size()) {
+            y = std::min(y, edges[lowers[nextLower]].lower.y);
+        }
+
+        // Horizontal edges at y lie between the band above and the band below.
+        horizontals.clear();
+        for (size_t i = nextUpper; i < edges.size() && edges[i].upper.y == y; ++i) {
+            if (edges[i].lower.y == y) {
+                horizontals.push_back(i);
+            }
+        }
+        above.clear();
+        for (size_t i : horizontals) {
+            above.push_back(windingsLeftOf(active, edges[i].upper));
+        }
+
+        for (; nextLower < lowers.size() && edges[lowers[nextLower]].lower.y == y; ++nextLower) {
+            active.erase(std::find(active.begin(), active.end(), lowers[nextLower]));
+        }
+
+        size_t firstInserted = active.size();
+        for (; nextUpper < edges.size() && edges[nextUpper].upper.y == y; ++nextUpper) {
+            const Edge& edge = edges[nextUpper];
+            if (edge.lower.y == y) {
+                continue;
+            }
+            // Nothing crosses a vertex, so only the edges starting there have the same x at y.
+            auto position = std::partition_point(active.begin(), active.end(), [&](size_t i) {
+                int64_t o = orient(edges[i].upper, edges[i].lower, edge.upper);
+                return o < 0 || (o == 0 && compare_slopes(edges[i].segment(),
+                                                          edge.segment()) < 0);
+            });
+            firstInserted = std::min(firstInserted, SkToSizeT(position - active.begin()));
+            active.insert(position, nextUpper);
+        }
+
+        for (size_t h = 0; h < horizontals.size(); ++h) {
+            const Edge& edge = edges[horizontals[h]];
+            keep(edge, above[h], windingsLeftOf(active, edge.upper));
+        }
+
+        // Each new edge sees the same windings on either side all the way down.
+        Windings windings;
+        for (size_t position = 0; position < active.size(); ++position) {
+            const Edge& edge = edges[active[position]];
+            Windings after = windings;
+            after.w[0] += edge.winding[0];
+            after.w[1] += edge.winding[1];
+            if (position >= firstInserted && edge.upper.y == y) {
+                keep(edge, windings, after);
+            }
+            windings = after;
+        }
+    }
+    return result;
+}
+
+// Links the directed edges into closed contours. If 'transpose' is set, swaps x and y back.
+SkPath make_path(std::vector<DirectedEdge> edges, bool inverse, bool transpose) {
+    SkPath path;
+    path.setFillType(inverse ? SkPathFillType::kInverseWinding : SkPathFillType::kWinding);
+    std::sort(edges.begin(), edges.end(), [](const DirectedEdge& e0, const DirectedEdge& e1) {
+        return e0.from < e1.from;
+    });
+    std::vector<bool> used(edges.size(), false);
+
+    // The first unused edge starting at p.
+    std::vector<size_t> cursor(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) {
+        cursor[i] = i;
+    }
+    auto takeEdgeFrom = [&](Point p) -> const DirectedEdge* {
+        auto start = std::partition_point(edges.begin(), edges.end(), [p](const DirectedEdge& e) {
+            return e.from < p;
+        });
+        size_t group = start - edges.begin();
+        if (group == edges.size()) {
+            return nullptr;
+        }
+        size_t& i = cursor[group];
+        while (i < edges.size() && edges[i].from == p && used[i]) {
+            ++i;
+        }
+        if (i == edges.size() || edges[i].from != p) {
+            return nullptr;
+        }
+        used[i] = true;
+        return &edges[i];
+    };
+
+    auto toSkPoint = [transpose](Point p) {
+        if (transpose) {
+            std::swap(p.x, p.y);
+        }
+        return SkPoint::Make(SkDoubleToScalar(p.x / contour::Contours::kScaleFactor),
+                             SkDoubleToScalar(p.y / contour::Contours::kScaleFactor));
+    };
+
+    std::vector<Point> points;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        if (used[i]) {
+            continue;
+        }
+        // Every vertex of the result has as many edges in as out, so the walk can only stop
+        // where it started.
+        const DirectedEdge* edge = takeEdgeFrom(edges[i].from);
+        points.clear();
+        points.push_back(edge->from);
+        while (edge) {
+            // Drop the vertices in the middle of straight runs.
+            if (points.size() >= 2 &&
+                    orient(points[points.size() - 2], points.back(), edge->to) == 0) {
+                points.back() = edge->to;
+            } else {
+                points.push_back(edge->to);
+            }
+            if (edge->to == points.front()) {
+                break;
+            }
+            edge = takeEdgeFrom(edge->to);
+        }
+        SkASSERT(points.back() == points.front());
+        points.pop_back();
+        if (points.size() < 3) {
+            continue;
+        }
+        path.moveTo(toSkPoint(points[0]));
+        for (size_t p = 1; p < points.size(); ++p) {
+            path.lineTo(toSkPoint(points[p]));
+        }
+        path.close();
+    }
+    return path;
+}
+}  // namespace
+
+std::optional<SkPath> polygon_op(const SkPath& one, const SkPath& two, SkPathOp op) {
+    // Both sweeps go down, and fewer edges cross each horizontal line of a tall path than of a
+    // wide one. Swapping x and y mirrors the result, which reverses all its contours, but that
+    // still winds every region of it once.
+    SkRect bounds = one.getBounds();
+    bounds.join(two.getBounds());
+    const bool transpose = bounds.width() > bounds.height();
+
+    std::vector<Edge> edges;
+    if (!add_path_edges(one, 0, transpose, &edges) || !add_path_edges(two, 1, transpose, &edges)) {
+        return std::nullopt;
+    }
+    if (!make_planar(&edges)) {
+        return std::nullopt;
+    }
+    Classifier classifier{one, two, op};
+    return make_path(classify(edges, classifier), classifier.outsideIsInside(), transpose);
+}
+}  // namespace bentleyottmann
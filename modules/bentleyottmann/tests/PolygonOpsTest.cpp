@@ -0,0 +1,148 @@
+// Copyright 2024 Google LLC
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "modules/bentleyottmann/include/PolygonOps.h"
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkRect.h"
+#include "include/pathops/SkPathOps.h"
+#include "src/base/SkRandom.h"
+#include "tests/Test.h"
+
+using namespace bentleyottmann;
+
+DEF_TEST(BO_polygon_op_Basic, reporter) {
+    SkPath left = SkPath::Rect(SkRect::MakeLTRB(0, 0, 10, 10)),
+           right = SkPath::Rect(SkRect::MakeLTRB(5, 5, 15, 15));
+    {
+        auto result = polygon_op(left, right, kUnion_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->getBounds() == SkRect::MakeLTRB(0, 0, 15, 15));
+        REPORTER_ASSERT(reporter, result->contains(2, 2) && result->contains(12, 12));
+        REPORTER_ASSERT(reporter, !result->contains(12, 2) && !result->contains(2, 12));
+        // The two squares meet in two corners, with no edges in the middle.
+        REPORTER_ASSERT(reporter, result->countPoints() == 8);
+    }
+    {
+        auto result = polygon_op(left, right, kIntersect_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->isRect(nullptr));
+        REPORTER_ASSERT(reporter, result->getBounds() == SkRect::MakeLTRB(5, 5, 10, 10));
+    }
+    {
+        auto result = polygon_op(left, right, kXOR_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->contains(2, 2) && result->contains(12, 12));
+        REPORTER_ASSERT(reporter, !result->contains(7, 7));
+    }
+    {
+        // A hole, wound the same way as the outside, with the paths in the other order.
+        SkPath hole = SkPath::Rect(SkRect::MakeLTRB(3, 3, 7, 7));
+        auto result = polygon_op(hole, left, kReverseDifference_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->contains(1, 1) && !result->contains(5, 5));
+    }
+    {
+        // Paths with curves are left to SkPathOps.
+        SkPath circle = SkPath::Circle(5, 5, 5);
+        REPORTER_ASSERT(reporter, !polygon_op(left, circle, kUnion_SkPathOp).has_value());
+    }
+}
+
+DEF_TEST(BO_polygon_op_Coincident, reporter) {
+    // Squares sharing a whole side and part of another merge into one contour.
+    SkPath square = SkPath::Rect(SkRect::MakeLTRB(0, 0, 10, 10)),
+           beside = SkPath::Rect(SkRect::MakeLTRB(10, 0, 20, 10), SkPathDirection::kCCW),
+           inside = SkPath::Rect(SkRect::MakeLTRB(0, 0, 5, 5));
+    {
+        auto result = polygon_op(square, beside, kUnion_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->isRect(nullptr));
+        REPORTER_ASSERT(reporter, result->getBounds() == SkRect::MakeLTRB(0, 0, 20, 10));
+    }
+    {
+        auto result = polygon_op(square, inside, kDifference_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->countPoints() == 6);
+        REPORTER_ASSERT(reporter, result->contains(7, 7) && !result->contains(2, 2));
+    }
+    {
+        auto result = polygon_op(square, square, kXOR_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->isEmpty());
+    }
+}
+
+DEF_TEST(BO_polygon_op_FillTypes, reporter) {
+    // A bow tie crosses itself in the middle, into a left and a right lobe, and an even-odd star
+    // leaves its center out.
+    SkPath bowtie;
+    bowtie.moveTo(0, 0);
+    bowtie.lineTo(10, 10);
+    bowtie.lineTo(10, 0);
+    bowtie.lineTo(0, 10);
+    bowtie.close();
+    SkPath star;
+    star.moveTo(50, 0);
+    star.lineTo(79, 90);
+    star.lineTo(2, 35);
+    star.lineTo(98, 35);
+    star.lineTo(21, 90);
+    star.close();
+    star.setFillType(SkPathFillType::kEvenOdd);
+    {
+        auto result = polygon_op(star, SkPath(), kUnion_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->contains(50, 10) && !result->contains(50, 50));
+    }
+    {
+        auto result = polygon_op(bowtie, SkPath::Rect(SkRect::MakeLTRB(0, 0, 10, 5)),
+                                 kIntersect_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->contains(1, 4) && !result->contains(5, 1));
+    }
+    {
+        SkPath outside = bowtie;
+        outside.setFillType(SkPathFillType::kInverseWinding);
+        auto result = polygon_op(outside, SkPath(), kUnion_SkPathOp);
+        REPORTER_ASSERT(reporter, result.has_value());
+        REPORTER_ASSERT(reporter, result->isInverseFillType());
+        REPORTER_ASSERT(reporter, result->contains(5, 1) && !result->contains(1, 5));
+    }
+}
+
+DEF_TEST(BO_polygon_op_MatchesPathOps, reporter) {
+    SkRandom rand;
+    auto polygon = [&rand]() {
+        SkPath path;
+        path.moveTo(rand.nextRangeF(0, 10), rand.nextRangeF(0, 10));
+        for (int i = 0; i < 8; ++i) {
+            path.lineTo(rand.nextRangeF(0, 10), rand.nextRangeF(0, 10));
+        }
+        path.close();
+        if (rand.nextBool()) {
+            path.setFillType(SkPathFillType::kEvenOdd);
+        }
+        return path;
+    };
+    for (int i = 0; i < 100; ++i) {
+        const SkPath one = polygon(),
+                     two = polygon();
+        const SkPathOp op = static_cast<SkPathOp>(i % (kReverseDifference_SkPathOp + 1));
+        auto result = polygon_op(one, two, op);
+        SkPath expected;
+        REPORTER_ASSERT(reporter, result.has_value());
+        if (!result || !Op(one, two, op, &expected)) {
+            continue;
+        }
+        // The results can differ where the grid moved the edges, so compare away from them.
+        int mismatches = 0;
+        for (float y = 0.13f; y < 10; y += 0.5f) {
+            for (float x = 0.17f; x < 10; x += 0.5f) {
+                mismatches += result->contains(x, y) != expected.contains(x, y);
+            }
+        }
+        REPORTER_ASSERT(reporter, mismatches <= 2, "op %d mismatches %d", op, mismatches);
+    }
+}
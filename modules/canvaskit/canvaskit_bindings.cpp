@@ -135,6 +135,15 @@ struct SkEmbeddedResourceHeader { const SkEmbeddedResource* entries; int count;
 extern "C" const SkEmbeddedResourceHeader SK_EMBEDDED_FONTS;
 #endif
 
+#ifdef CK_ENABLE_PTHREADS
+#include "include/core/SkExecutor.h"
+#include "include/private/base/SkMutex.h"
+#include "src/base/SkNoDestructor.h"
+
+#include <emscripten/threading.h>
+#include <unordered_map>
+#endif
+
 #if defined(GR_TEST_UTILS)
 #error "This define should not be set, as it brings in test-only things and bloats codesize."
 #endif
@@ -205,6 +214,25 @@ std::unique_ptr<SkCodec> DecodeImageData(sk_sp<SkData> data) {
     return nullptr;
 }
 
+#ifdef CK_ENABLE_PTHREADS
+// Images decoded on a worker thread wait here, keyed by the id JS handed to _decodeImageAsync,
+// until JS takes them on the main thread with _takeDecodedImage.
+static SkMutex gDecodedImagesMutex;
+static SkNoDestructor<std::unordered_map<int, sk_sp<SkImage>>> gDecodedImages;
+
+static SkExecutor& DecodeExecutor() {
+    // The threads come out of emscripten's pthread pool, i.e. they are Web Workers.
+    static SkNoDestructor<std::unique_ptr<SkExecutor>> executor(
+            SkExecutor::MakeFIFOThreadPool(CK_PTHREAD_POOL_SIZE));
+    return **executor;
+}
+
+// Runs on the main thread, where the JS side of the promise lives.
+static void NotifyImageDecoded(int id) {
+    EM_ASM({ Module['_onImageDecoded']($0); }, id);
+}
+#endif // CK_ENABLE_PTHREADS
+
 struct OptionalMatrix : SkMatrix {
     OptionalMatrix(WASMPointerF32 mPtr) {
         if (mPtr) {
@@ -1088,6 +1116,34 @@ EMSCRIPTEN_BINDINGS(Skia) {
         }
         return std::get<0>(codec->getImage());
     }), allow_raw_pointers());
+#ifdef CK_ENABLE_PTHREADS
+    function("_decodeImageAsync", optional_override([](WASMPointerU8 iptr,
+                                                       size_t length, int id)->void {
+        uint8_t* imgData = reinterpret_cast<uint8_t*>(iptr);
+        auto bytes = SkData::MakeFromMalloc(imgData, length);
+        DecodeExecutor().add([bytes = std::move(bytes), id] {
+            sk_sp<SkImage> image;
+            if (auto codec = DecodeImageData(bytes)) {
+                image = std::get<0>(codec->getImage());
+            }
+            {
+                SkAutoMutexExclusive lock(gDecodedImagesMutex);
+                (*gDecodedImages)[id] = std::move(image);
+            }
+            emscripten_async_run_in_main_runtime_thread(EM_FUNC_SIG_VI, NotifyImageDecoded, id);
+        });
+    }));
+    function("_takeDecodedImage", optional_override([](int id)->sk_sp<SkImage> {
+        SkAutoMutexExclusive lock(gDecodedImagesMutex);
+        auto it = gDecodedImages->find(id);
+        if (it == gDecodedImages->end()) {
+            return nullptr;
+        }
+        sk_sp<SkImage> image = std::move(it->second);
+        gDecodedImages->erase(it);
+        return image;
+    }), allow_raw_pointers());
+#endif
 
     // These won't be called directly, there are corresponding JS helpers to deal with arrays.
     function("_MakeImage", optional_override([](SimpleImageInfo ii,
@@ -141,6 +141,18 @@ if [[ $@ == *legacy_draw_vertices* ]]; then
   LEGACY_DRAW_VERTICES="true"
 fi
 
+ENABLE_SIMD="true"
+if [[ $@ == *no_simd* ]]; then
+  echo "Omitting WebAssembly SIMD"
+  ENABLE_SIMD="false"
+fi
+
+ENABLE_PTHREADS="false"
+if [[ $@ == *pthreads* ]]; then
+  echo "Building with pthreads; the page must be cross-origin isolated to load it"
+  ENABLE_PTHREADS="true"
+fi
+
 DEBUGGER_ENABLED="false"
 if [[ $@ == *enable_debugger* ]]; then
   DEBUGGER_ENABLED="true"
@@ -262,6 +274,8 @@ echo "Compiling"
   skia_canvaskit_legacy_draw_vertices_blend_mode=${LEGACY_DRAW_VERTICES} \
   skia_canvaskit_enable_debugger=${DEBUGGER_ENABLED} \
   skia_canvaskit_enable_paragraph=${ENABLE_PARAGRAPH} \
+  skia_canvaskit_enable_pthreads=${ENABLE_PTHREADS} \
+  skia_canvaskit_enable_simd=${ENABLE_SIMD} \
   skia_canvaskit_enable_webgl=${ENABLE_WEBGL} \
   skia_canvaskit_enable_webgpu=${ENABLE_WEBGPU}"
 
@@ -46,6 +46,8 @@ var CanvasKit = {
   MakeImage: function() {},
   /** @return {CanvasKit.Image} */
   MakeImageFromEncoded: function() {},
+  /** @return {Promise<CanvasKit.Image>} */
+  MakeImageFromEncodedAsync: function() {},
   MakeImageFromCanvasImageSource: function() {},
   MakeOnScreenGLSurface: function() {},
   MakeRenderTarget: function() {},
@@ -53,6 +55,7 @@ var CanvasKit = {
   MakeSWCanvasSurface: function() {},
   MakeManagedAnimation: function() {},
   MakeVertices: function() {},
+  MakeVerticesBuilder: function() {},
   MakeSurface: function() {},
   MakeGPUDeviceContext: function() {},
   MakeGPUCanvasContext: function() {},
@@ -92,8 +95,10 @@ var CanvasKit = {
   _computeTonalColors: function() {},
   _decodeAnimatedImage: function() {},
   _decodeImage: function() {},
+  _decodeImageAsync: function() {},
   _getShadowLocalBounds: function() {},
   _setTextureCleanup: function() {},
+  _takeDecodedImage: function() {},
 
   // The testing object is meant to expose internal functions
   // for more fine-grained testing, e.g. parseColor
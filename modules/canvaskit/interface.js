@@ -1343,3 +1343,49 @@ CanvasKit.MakeVertices = function(mode, positions, textureCoordinates, colors,
   // Create the vertices, which owns the memory that the builder had allocated.
   return builder.detach();
 };
+
+// Like MakeVertices, but nothing is copied: positions(), textureCoordinates(), colors() and
+// indices() return TypedArrays over the memory of the Vertices being built, which the caller
+// fills in place before calling detach(). Like MallocObj.toTypedArray(), the arrays should not be
+// cached, as they are invalidated if the WASM heap is resized.
+CanvasKit.MakeVerticesBuilder = function(mode, vertexCount, indexCount, hasTextureCoordinates,
+                                         hasColors, isVolatile) {
+  // Default isVolatile to true if not set
+  isVolatile = isVolatile === undefined ? true : isVolatile;
+
+  var flags = 0;
+  // These flags are from SkVertices.h and should be kept in sync with those.
+  if (hasTextureCoordinates) {
+    flags |= (1 << 0);
+  }
+  if (hasColors) {
+    flags |= (1 << 1);
+  }
+  if (!isVolatile) {
+    flags |= (1 << 2);
+  }
+
+  var builder = new CanvasKit._VerticesBuilder(mode, vertexCount, indexCount || 0, flags);
+  function view(ptr, typedArray, len) {
+    return ptr ? new typedArray(CanvasKit.HEAPU8.buffer, ptr, len) : null;
+  }
+  return {
+    'positions': function() {
+      return view(builder.positions(), Float32Array, vertexCount * 2);
+    },
+    'textureCoordinates': function() {
+      return view(builder.texCoords(), Float32Array, vertexCount * 2);
+    },
+    'colors': function() {
+      return view(builder.colors(), Uint32Array, vertexCount);
+    },
+    'indices': function() {
+      return view(builder.indices(), Uint16Array, indexCount);
+    },
+    'detach': function() {
+      var vertices = builder.detach();
+      builder.delete();
+      return vertices;
+    },
+  };
+};
@@ -1046,6 +1046,10 @@ function verticesTests(CK: CanvasKit) {
     const vertices2 = CK.MakeVertices(CK.VertexMode.TriangleFan,
         points2, null, colors, null, true);
 
+    const builder = CK.MakeVerticesBuilder(CK.VertexMode.Triangles, 3, 0, false, true);
+    builder.positions().set([0, 0, 10, 0, 0, 10]); // $ExpectType void
+    const vertices3 = builder.detach(); // $ExpectType Vertices
+
     const rect = vertices.bounds(); // $ExpectType Float32Array
     vertices.bounds(rect);
     const id = vertices.uniqueID(); // $ExpectType number
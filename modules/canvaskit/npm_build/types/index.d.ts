@@ -399,6 +399,13 @@ export interface CanvasKit {
      */
     MakeImageFromEncoded(bytes: Uint8Array | ArrayBuffer): Image | null;
 
+    /**
+     * Like MakeImageFromEncoded, but the image is decoded on a Web Worker and the returned
+     * Promise resolves to it (or null) once decoded. Only present in builds with pthreads.
+     * @param bytes
+     */
+    MakeImageFromEncodedAsync?(bytes: Uint8Array | ArrayBuffer): Promise<Image | null>;
+
     /**
      * Returns an Image with the data from the provided CanvasImageSource (e.g. <img>). This will
      * use the browser's built in codecs, in that src will be drawn to a canvas and then readback
@@ -428,6 +435,20 @@ export interface CanvasKit {
                  colors?: Float32Array | ColorIntArray | null, indices?: number[] | null,
                  isVolatile?: boolean): Vertices;
 
+    /**
+     * Returns a builder for a Vertices whose arrays are filled in place, without the copies
+     * MakeVertices makes. This is useful for meshes that are regenerated every frame.
+     * @param mode
+     * @param vertexCount
+     * @param indexCount
+     * @param hasTextureCoordinates
+     * @param hasColors
+     * @param isVolatile
+     */
+    MakeVerticesBuilder(mode: VertexMode, vertexCount: number, indexCount?: number,
+                        hasTextureCoordinates?: boolean, hasColors?: boolean,
+                        isVolatile?: boolean): VerticesBuilder;
+
     /**
      * Returns a Skottie animation built from the provided json string.
      * Requires that Skottie be compiled into CanvasKit.
@@ -3112,6 +3133,25 @@ export interface Typeface extends EmbindObject<"Typeface"> {
 /**
  * See SkVertices.h for more on this class.
  */
+/**
+ * Builds a Vertices in place. The TypedArrays returned are views onto the memory of the Vertices
+ * being built; do not cache them, they may be invalidated if the WASM heap is resized. Arrays that
+ * were not asked for when making the builder are null.
+ */
+export interface VerticesBuilder {
+    positions(): Float32Array;
+    textureCoordinates(): Float32Array | null;
+    /**
+     * Colors are int colors, e.g. from CanvasKit.ColorAsInt().
+     */
+    colors(): Uint32Array | null;
+    indices(): Uint16Array | null;
+    /**
+     * Returns the built Vertices. The builder must not be used afterwards.
+     */
+    detach(): Vertices;
+}
+
 export interface Vertices extends EmbindObject<"Vertices"> {
     /**
      * Return the bounding area for the vertices.
@@ -698,6 +698,30 @@ describe('Canvas Behavior', () => {
         paint.delete();
     });
 
+    gm('drawvertices_builder_canvas', (canvas) => {
+        const paint = new CanvasKit.Paint();
+        paint.setAntiAlias(true);
+
+        // Same as drawvertices_canvas, but written straight into the Vertices' memory.
+        const builder = CanvasKit.MakeVerticesBuilder(CanvasKit.VertexMode.TriangleFan,
+            4, 0, false /*hasTextureCoordinates*/, true /*hasColors*/, false /*isVolatile*/);
+        expect(builder.textureCoordinates()).toBeNull();
+        expect(builder.indices()).toBeNull();
+        builder.positions().set([0, 0,  250, 0,  100, 100,  0, 250]);
+        builder.colors().set([CanvasKit.ColorAsInt(255, 0, 0, 255),
+                              CanvasKit.ColorAsInt(0, 0, 255, 255),
+                              CanvasKit.ColorAsInt(255, 255, 0, 255),
+                              CanvasKit.ColorAsInt(0, 255, 255, 255)]);
+        const vertices = builder.detach();
+
+        const bounds = vertices.bounds();
+        expect(bounds).toEqual(CanvasKit.LTRBRect(0, 0, 250, 250));
+
+        canvas.drawVertices(vertices, CanvasKit.BlendMode.Dst, paint);
+        vertices.delete();
+        paint.delete();
+    });
+
     gm('drawvertices_texture_canvas', (canvas, fetchedByteBuffers) => {
         const img = CanvasKit.MakeImageFromEncoded(fetchedByteBuffers[0]);
 
@@ -0,0 +1,32 @@
+// Adds JS functions for the pthreads build of CanvasKit, where some work runs on Web Workers.
+(function(CanvasKit){
+  CanvasKit._extraInitializations = CanvasKit._extraInitializations || [];
+  CanvasKit._extraInitializations.push(function() {
+    var pendingDecodes = {};
+    var nextDecodeID = 1;
+
+    // Called on the main thread by the C++ side once a worker has finished a decode.
+    CanvasKit['_onImageDecoded'] = function(id) {
+      var resolve = pendingDecodes[id];
+      delete pendingDecodes[id];
+      if (resolve) {
+        resolve(CanvasKit._takeDecodedImage(id));
+      }
+    };
+
+    // data is a TypedArray or ArrayBuffer e.g. from fetch().then(resp.arrayBuffer())
+    // Returns a Promise that resolves to the decoded Image, or null if it could not be decoded.
+    CanvasKit.MakeImageFromEncodedAsync = function(data) {
+      data = new Uint8Array(data);
+
+      var iptr = CanvasKit._malloc(data.byteLength);
+      CanvasKit.HEAPU8.set(data, iptr);
+      var id = nextDecodeID++;
+      return new Promise(function(resolve) {
+        pendingDecodes[id] = resolve;
+        // The decode takes ownership of the malloc'd data.
+        CanvasKit._decodeImageAsync(iptr, data.byteLength, id);
+      });
+    };
+  });
+}(Module)); // When this file is loaded in, the high level object is "Module";
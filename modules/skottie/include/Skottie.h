@@ -98,6 +98,9 @@ public:
                                          // frames are only resolved when needed, at seek() time.
             kPreferEmbeddedFonts = 0x02, // Attempt to use the embedded fonts (glyph paths,
                                          // normally used as fallback) over native Skia typefaces.
+            kCachePrecompLayers  = 0x04, // Rasterize precomp layer content once it stops changing,
+                                         // and draw the cached image while only the layer
+                                         // transform/opacity animates.
         };
 
         explicit Builder(uint32_t flags = 0);
@@ -160,6 +163,9 @@ public:
 
         /**
          * Animation factories.
+         *
+         * Besides Lottie JSON, the data can also be in the binary form produced by the
+         * skottie2binary tool, which skips JSON parsing when loading.
          */
         sk_sp<Animation> make(SkStream*);
         sk_sp<Animation> make(const char* data, size_t length);
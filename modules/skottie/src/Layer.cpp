@@ -383,6 +383,7 @@ sk_sp<sksg::Transform> LayerBuilder::getParentTransform(const AnimationBuilder&
                                                         TransformType ttype) {
     if (auto* parent_builder = cbuilder->layerBuilder(fParentIndex)) {
         // Explicit parent layer.
+        parent_builder->fFlags |= Flags::kIsParent;
         return parent_builder->getTransform(abuilder, cbuilder, ttype);
     }
 
@@ -539,10 +540,14 @@ sk_sp<sksg::RenderNode> LayerBuilder::buildRenderTree(const AnimationBuilder& ab
         layer = nullptr;
     }
 
+    // While the layer is inactive, its transform animators only need to run for the sake of
+    // dependent layers (transform chain children, or 3D layers viewed through a camera).
+    // The transform (and the rest of the layer) catches up on the first seek after activation.
+    // Layers without a render node are never hidden, so they keep ticking their transforms.
     const auto has_animators    = !abuilder.fCurrentAnimatorScope->empty();
     const auto force_seek_count = build_info.fFlags & kForceSeek
             ? abuilder.fCurrentAnimatorScope->size()
-            : fTransformAnimatorCount;
+            : (this->hasTransformDependents() || !layer) ? fTransformAnimatorCount : 0;
 
     sk_sp<Animator> controller = sk_make_sp<LayerController>(ascope.release(),
                                                              layer,
@@ -59,10 +59,16 @@ private:
         // k2DTransformValid = 0x01,  // reserved for cache tracking
         // k3DTransformValie = 0x02,  // reserved for cache tracking
         kIs3D                = 0x04,  // 3D layer ("ddd": 1) or camera layer
+        kIsParent            = 0x08,  // other layers' transform chains include this layer
     };
 
     bool is3D() const { return fFlags & Flags::kIs3D; }
 
+    // Whether other layers depend on this layer's transform, even when this layer is inactive.
+    bool hasTransformDependents() const {
+        return (fFlags & Flags::kIsParent) || this->isCamera();
+    }
+
     bool hasMotionBlur(const CompositionBuilder*) const;
 
     // Attaches (if needed) and caches the transform chain for a given layer,
@@ -5,12 +5,19 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkSurface.h"
 #include "modules/skottie/include/Skottie.h"
+#include "src/utils/SkJSON.h"
 #include "tests/Test.h"
 
 #include <cmath>
+#include <cstring>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -269,3 +276,135 @@ DEF_TEST(Skottie_Layer_NoType, r) {
     // passes if we don't crash
     REPORTER_ASSERT(r, anim);
 }
+
+DEF_TEST(Skottie_Layer_InactiveTransforms, r) {
+    // A red solid which is only active in [5..10), and a blue solid parented to a null layer
+    // which is only active in [0..1).  Both slide over time.
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 10,
+             "layers": [
+               {
+                 "ty": 1,
+                 "ip": 5,
+                 "op": 10,
+                 "sw": 10,
+                 "sh": 10,
+                 "sc": "#ff0000",
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [0,0] }, { "t": 10, "s": [90,0] } ] }
+                 }
+               },
+               {
+                 "ty": 1,
+                 "ip": 0,
+                 "op": 10,
+                 "parent": 1,
+                 "sw": 10,
+                 "sh": 10,
+                 "sc": "#0000ff",
+                 "ks": {}
+               },
+               {
+                 "ty": 3,
+                 "ind": 1,
+                 "ip": 0,
+                 "op": 1,
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [0,0] }, { "t": 10, "s": [0,90] } ] }
+                 }
+               }
+             ]
+           })";
+
+    SkMemoryStream stream(json, strlen(json));
+    auto anim = Animation::Make(&stream);
+    REPORTER_ASSERT(r, anim);
+    if (!anim) {
+        return;
+    }
+
+    auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(100, 100));
+    auto color_at = [&](int x, int y) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::MakeN32Premul(1, 1));
+        SkAssertResult(surface->readPixels(bm, x, y));
+        return bm.getColor(0, 0);
+    };
+
+    // Seek while the red solid is inactive, then once it is active: its transform must catch up.
+    anim->seekFrame(2);
+    anim->seekFrame(9);
+    surface->getCanvas()->clear(SK_ColorWHITE);
+    anim->render(surface->getCanvas());
+
+    REPORTER_ASSERT(r, color_at(86, 5) == SK_ColorRED);
+    REPORTER_ASSERT(r, color_at( 5, 5) == SK_ColorWHITE);
+
+    // The blue solid follows its inactive parent.
+    REPORTER_ASSERT(r, color_at(5, 86) == SK_ColorBLUE);
+    REPORTER_ASSERT(r, color_at(5, 50) == SK_ColorWHITE);
+}
+
+DEF_TEST(Skottie_BinaryInput, r) {
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 10,
+             "layers": [
+               {
+                 "ty": 1,
+                 "sw": 10,
+                 "sh": 10,
+                 "sc": "#ff0000",
+                 "ks": {
+                   "p": { "a": 1, "k": [ { "t": 0, "s": [0,0] }, { "t": 10, "s": [90,0] } ] }
+                 }
+               }
+             ]
+           })";
+
+    const skjson::DOM dom(json, strlen(json));
+    SkDynamicMemoryWStream stream;
+    dom.writeBinary(&stream);
+    const auto binary = stream.detachAsData();
+
+    auto json_anim = Animation::Builder().make(json, strlen(json));
+    auto binary_anim = Animation::Builder().make(static_cast<const char*>(binary->data()),
+                                                 binary->size());
+    REPORTER_ASSERT(r, json_anim && binary_anim);
+    if (!json_anim || !binary_anim) {
+        return;
+    }
+    REPORTER_ASSERT(r, binary_anim->version() == json_anim->version());
+    REPORTER_ASSERT(r, binary_anim->size() == json_anim->size());
+    REPORTER_ASSERT(r, binary_anim->duration() == json_anim->duration());
+
+    // Both forms render the same frames.
+    auto render = [](Animation* anim) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::MakeN32Premul(100, 100));
+        SkCanvas canvas(bm);
+        canvas.clear(SK_ColorWHITE);
+        anim->seekFrame(5);
+        anim->render(&canvas);
+        return bm;
+    };
+    const SkBitmap expected = render(json_anim.get()),
+                   actual   = render(binary_anim.get());
+    REPORTER_ASSERT(r, !memcmp(expected.getPixels(), actual.getPixels(),
+                               expected.computeByteSize()));
+
+    // Truncated binary data fails to load, instead of being parsed as JSON.
+    REPORTER_ASSERT(r, !Animation::Builder().make(static_cast<const char*>(binary->data()),
+                                                  binary->size() / 2));
+}
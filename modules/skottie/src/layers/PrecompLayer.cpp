@@ -21,6 +21,7 @@
 #include "modules/skottie/src/SkottieValue.h"
 #include "modules/skottie/src/animator/Animator.h"
 #include "modules/sksg/include/SkSGNode.h"
+#include "modules/sksg/include/SkSGRasterCache.h"
 #include "modules/sksg/include/SkSGRenderNode.h"
 #include "src/base/SkTLazy.h"
 #include "src/utils/SkJSON.h"
@@ -216,6 +217,10 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachPrecompLayer(const skjson::Objec
             AutoPropertyTracker apt(this, *precomp_asset, PropertyObserver::NodeType::COMPOSITION);
             precomp_layer =
                 CompositionBuilder(*this, layer_info->fSize, *precomp_asset).build(*this);
+
+            if (fFlags & Animation::Builder::kCachePrecompLayers) {
+                precomp_layer = sksg::RasterCacheEffect::Make(std::move(precomp_layer));
+            }
         }
     }
 
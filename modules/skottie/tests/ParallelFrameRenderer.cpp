@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
+#include "tests/Test.h"
+
+#include <cstring>
+#include <vector>
+
+DEF_TEST(Skottie_ParallelFrameRenderer, r) {
+    // A red solid which fades in over the first ten frames.
+    static constexpr char json[] =
+        R"({
+             "v": "5.2.1",
+             "w": 100,
+             "h": 100,
+             "fr": 10,
+             "ip": 0,
+             "op": 20,
+             "layers": [
+               {
+                 "ty": 1,
+                 "ip": 0,
+                 "op": 20,
+                 "sw": 100,
+                 "sh": 100,
+                 "sc": "#ff0000",
+                 "ks": {
+                   "o": { "a": 1, "k": [ { "t": 0, "s": [0] }, { "t": 10, "s": [100] } ] }
+                 }
+               }
+             ]
+           })";
+
+    auto make_animation = []() { return skottie::Animation::Make(json, strlen(json)); };
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(50, 50);
+
+    auto renderer = skottie_utils::ParallelFrameRenderer::Make(make_animation, info, 3);
+    REPORTER_ASSERT(r, renderer && renderer->threadCount() == 3);
+    if (!renderer) {
+        return;
+    }
+
+    // More frames than threads, and not a multiple of their count.
+    std::vector<double> frames;
+    for (int i = 0; i < 11; ++i) {
+        frames.push_back(i);
+    }
+
+    auto reference = make_animation();
+    SkBitmap expected;
+    expected.allocPixels(info);
+    size_t nextIndex = 0;
+    renderer->renderFrames(frames, SK_ColorWHITE, [&](size_t index, const SkPixmap& frame) {
+        REPORTER_ASSERT(r, index == nextIndex++);
+
+        SkCanvas canvas(expected);
+        const SkRect dst = SkRect::Make(info.bounds());
+        reference->seekFrame(frames[index]);
+        canvas.clear(SK_ColorWHITE);
+        reference->render(&canvas, &dst);
+
+        for (int y = 0; y < info.height(); ++y) {
+            REPORTER_ASSERT(r, !memcmp(frame.addr(0, y), expected.getAddr(0, y),
+                                       info.minRowBytes()),
+                            "frame %zu, row %d", index, y);
+        }
+        if (index == 0) {
+            REPORTER_ASSERT(r, frame.getColor(25, 25) == SK_ColorWHITE);
+        } else if (index == frames.size() - 1) {
+            REPORTER_ASSERT(r, frame.getColor(25, 25) == SK_ColorRED);
+        }
+    });
+    REPORTER_ASSERT(r, nextIndex == frames.size());
+}
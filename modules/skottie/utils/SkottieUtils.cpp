@@ -7,18 +7,21 @@
 
 #include "modules/skottie/utils/SkottieUtils.h"
 
+#include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 #include "include/private/base/SkAssert.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skresources/include/SkResources.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
 #include <cstring>
 #include <utility>
 
-class SkCanvas;
-
 namespace skottie_utils {
 
 class CustomPropertyManager::PropertyInterceptor final : public skottie::PropertyObserver {
@@ -296,4 +299,66 @@ sk_sp<skottie::ExternalLayer> ExternalAnimationPrecompInterceptor::onLoadPrecomp
                 : nullptr;
 }
 
+std::unique_ptr<ParallelFrameRenderer> ParallelFrameRenderer::Make(
+        const AnimationFactory& factory, const SkImageInfo& frameInfo, int threads) {
+    std::vector<Worker> workers(std::max(threads, 1));
+    for (Worker& worker : workers) {
+        worker.fAnimation = factory();
+        if (!worker.fAnimation ||
+            !worker.fFrames[0].tryAllocPixels(frameInfo) ||
+            !worker.fFrames[1].tryAllocPixels(frameInfo)) {
+            return nullptr;
+        }
+    }
+
+    return std::unique_ptr<ParallelFrameRenderer>(new ParallelFrameRenderer(
+            SkExecutor::MakeFIFOThreadPool(SkToInt(workers.size())), std::move(workers)));
+}
+
+ParallelFrameRenderer::ParallelFrameRenderer(std::unique_ptr<SkExecutor> executor,
+                                             std::vector<Worker> workers)
+        : fExecutor(std::move(executor))
+        , fWorkers(std::move(workers)) {}
+
+ParallelFrameRenderer::~ParallelFrameRenderer() = default;
+
+void ParallelFrameRenderer::renderFrames(SkSpan<const double> frames,
+                                         SkColor background,
+                                         const FrameCallback& callback) {
+    // Frames are rendered in batches of one frame per worker. While a batch renders into one
+    // set of bitmaps, the previous batch is handed to the callback from the other set.
+    const size_t batchSize = fWorkers.size();
+    const size_t batchCount = (frames.size() + batchSize - 1) / batchSize;
+
+    auto batch_range = [&](size_t batch) {
+        const size_t start = batch * batchSize;
+        return std::make_pair(start, std::min(start + batchSize, frames.size()));
+    };
+
+    SkTaskGroup taskGroup(*fExecutor);
+    for (size_t batch = 0; batch <= batchCount; ++batch) {
+        if (batch < batchCount) {
+            const auto [start, end] = batch_range(batch);
+            const size_t buffer = batch & 1;
+            taskGroup.batch(SkToInt(end - start), [&, start = start, buffer](int i) {
+                Worker& worker = fWorkers[i];
+                SkCanvas canvas(worker.fFrames[buffer]);
+                const SkRect dst = SkRect::Make(worker.fFrames[buffer].bounds());
+
+                worker.fAnimation->seekFrame(frames[start + i]);
+                canvas.clear(background);
+                worker.fAnimation->render(&canvas, &dst);
+            });
+        }
+        if (batch > 0) {
+            const auto [start, end] = batch_range(batch - 1);
+            const size_t buffer = (batch - 1) & 1;
+            for (size_t i = start; i < end; ++i) {
+                callback(i, fWorkers[i - start].fFrames[buffer].pixmap());
+            }
+        }
+        taskGroup.wait();
+    }
+}
+
 } // namespace skottie_utils
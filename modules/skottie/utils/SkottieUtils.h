@@ -8,20 +8,29 @@
 #ifndef SkottieUtils_DEFINED
 #define SkottieUtils_DEFINED
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkString.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skottie/include/ExternalLayer.h"
 #include "modules/skottie/include/SkottieProperty.h"
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+class SkExecutor;
+class SkPixmap;
 struct SkSize;
 
 namespace skottie {
+class Animation;
 class MarkerObserver;
 }
 
@@ -146,6 +155,52 @@ private:
     const SkString                             fPrefix;
 };
 
+/**
+ * Renders animation frames on a pool of threads, for offline export.
+ *
+ * An Animation keeps the state of its current frame in its scene graph, so a single instance
+ * can't be seeked and rendered from several threads at once. Instead, each worker renders with
+ * its own Animation built by the factory. Building them all from the same JSON, with a shared
+ * skresources::CachingResourceProvider, lets them share their decoded image assets.
+ */
+class ParallelFrameRenderer final {
+public:
+    using AnimationFactory = std::function<sk_sp<skottie::Animation>()>;
+
+    /**
+     * Builds one animation per thread with the factory, which is only called from this thread.
+     * Returns nullptr if the factory fails, or if the frame info can't back a raster surface.
+     */
+    static std::unique_ptr<ParallelFrameRenderer> Make(const AnimationFactory&,
+                                                       const SkImageInfo& frameInfo,
+                                                       int threads);
+    ~ParallelFrameRenderer();
+
+    using FrameCallback = std::function<void(size_t index, const SkPixmap& frame)>;
+
+    /**
+     * Renders each of the given frames (in frame units, as for Animation::seekFrame()) over
+     * 'background', scaled to fill the frame info's bounds.
+     *
+     * The callback receives the frames in order, on the calling thread, while the workers move
+     * on to the following frames. The pixmap is only valid for the duration of the callback.
+     */
+    void renderFrames(SkSpan<const double> frames, SkColor background, const FrameCallback&);
+
+    int threadCount() const { return SkToInt(fWorkers.size()); }
+
+private:
+    struct Worker {
+        sk_sp<skottie::Animation> fAnimation;
+        SkBitmap                  fFrames[2]; // rendered into and delivered from in turn
+    };
+
+    ParallelFrameRenderer(std::unique_ptr<SkExecutor>, std::vector<Worker>);
+
+    const std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<Worker>               fWorkers;
+};
+
 } // namespace skottie_utils
 
 #endif // SkottieUtils_DEFINED
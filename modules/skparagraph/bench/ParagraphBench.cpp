@@ -13,7 +13,11 @@
 #include "tools/fonts/FontToolUtils.h"
 
 #include <cfloat>
+#include <memory>
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkString.h"
+#include "src/core/SkTaskGroup.h"
 #include "modules/skparagraph/utils/TestFontCollection.h"
 
 using namespace skia::textlayout;
@@ -54,6 +58,84 @@ struct ParagraphBench : public Benchmark {
         }
     }
 };
+
+// Lays out one paragraph at a new width on every loop, like dragging the edge of a resizable
+// pane. The text is shaped once, so this measures line breaking and formatting.
+struct ParagraphResizeBench : public Benchmark {
+    ParagraphResizeBench(const char* r, const char* n) : fResource(r), fName(n) {}
+    const char* fResource;
+    const char* fName;
+    std::unique_ptr<Paragraph> fParagraph;
+    const char* onGetName() override { return fName; }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override {
+        sk_sp<SkData> data = GetResourceAsData(fResource);
+        if (!data) {
+            return;
+        }
+        auto fontCollection = sk_make_sp<FontCollection>();
+        fontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.addText((const char*)data->data(), data->size());
+        fParagraph = builder.Build();
+        fParagraph->layout(800);
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fParagraph) {
+            return;
+        }
+        for (int i = 0; i < loops; ++i) {
+            fParagraph->layout(400 + (i % 400));
+        }
+    }
+};
+
+// Lays out many distinct, short paragraphs on several threads sharing one font collection, like a
+// list view would. Each layout is a paragraph cache hit: the paragraphs are shaped once up front,
+// which also fills the font collection's typeface cache, since FontCollection itself isn't safe
+// to update from several threads.
+struct ParagraphCacheBench : public Benchmark {
+    ParagraphCacheBench(int threads)
+            : fThreads(threads)
+            , fName(SkStringPrintf("paragraph_cache_threads_%d", threads)) {}
+    inline static constexpr int kParagraphs = 2000;
+    const int fThreads;
+    const SkString fName;
+    sk_sp<FontCollection> fFontCollection;
+    std::unique_ptr<SkExecutor> fExecutor;
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override {
+        fFontCollection = sk_make_sp<FontCollection>();
+        fFontCollection->setDefaultFontManager(ToolUtils::TestFontMgr());
+        fFontCollection->getParagraphCache()->setLimits(kParagraphs, 0);
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        for (int i = 0; i < kParagraphs; ++i) {
+            this->layout(i);
+        }
+    }
+    void layout(int i) {
+        ParagraphStyle paragraph_style;
+        paragraph_style.turnHintingOff();
+        const SkString text = SkStringPrintf("List item #%d: some text", i);
+        ParagraphBuilderImpl builder(paragraph_style, fFontCollection);
+        builder.addText(text.c_str(), text.size());
+        builder.Build()->layout(300);
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup taskGroup(*fExecutor);
+        while (loops-- > 0) {
+            taskGroup.batch(fThreads, [this](int thread) {
+                for (int i = thread; i < kParagraphs; i += fThreads) {
+                    this->layout(i);
+                }
+            });
+            taskGroup.wait();
+        }
+    }
+};
 }  // namespace
 
 #define PARAGRAPH_BENCH(X) DEF_BENCH(return new ParagraphBench(50000, "text/" #X ".txt", "paragraph_" #X);)
@@ -62,4 +144,9 @@ struct ParagraphBench : public Benchmark {
 PARAGRAPH_BENCH(english)
 #undef PARAGRAPH_BENCH
 
+DEF_BENCH(return new ParagraphResizeBench("text/english.txt", "paragraph_resize_english");)
+
+DEF_BENCH(return new ParagraphCacheBench(1);)
+DEF_BENCH(return new ParagraphCacheBench(4);)
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
@@ -0,0 +1,98 @@
+// Copyright 2024 Google LLC.
+#ifndef EditableParagraph_DEFINED
+#define EditableParagraph_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
+#include "modules/skparagraph/include/FontCollection.h"
+#include "modules/skparagraph/include/Paragraph.h"
+#include "modules/skparagraph/include/ParagraphStyle.h"
+#include "modules/skparagraph/include/TextStyle.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class SkCanvas;
+
+namespace skia {
+namespace textlayout {
+
+// Lays out text which is edited a little at a time, e.g. in a text editor.
+//
+// The text is split at hard line breaks ('\n') into separate paragraphs. The text on either side
+// of a hard break never shapes, wraps or reorders (bidi) together, so after an edit only the
+// paragraphs which the edit touches are shaped and wrapped again: the others keep their Paragraph
+// object, with its runs and lines, and just move up or down. An edit costs O(edited paragraphs)
+// instead of O(text).
+//
+// All the text uses one TextStyle.
+class EditableParagraph {
+public:
+    EditableParagraph(const ParagraphStyle& paragraphStyle,
+                      const TextStyle& textStyle,
+                      sk_sp<FontCollection> fontCollection);
+    ~EditableParagraph();
+
+    // The text is UTF-8, and all the offsets below are UTF-8 offsets into it.
+    void setText(std::string_view utf8);
+    const std::string& text() const { return fText; }
+
+    // Replaces the text in [start, end) with 'utf8'. Only the paragraphs from the one holding
+    // 'start' to the one holding 'end' are rebuilt.
+    void replaceText(size_t start, size_t end, std::string_view utf8);
+
+    // Lays out the paragraphs which were edited, or all of them if the width changed.
+    void layout(SkScalar width);
+    void paint(SkCanvas* canvas, SkScalar x, SkScalar y);
+
+    SkScalar getHeight() const { return fHeight; }
+    SkScalar getLongestLine() const { return fLongestLine; }
+
+    // The paragraphs, one per hard line, stacked from the top. A paragraph is built on the first
+    // layout() after its text changed, so this returns null for an edited paragraph until then.
+    size_t paragraphCount() const { return fLines.size(); }
+    Paragraph* paragraph(size_t index) const { return fLines[index].fParagraph.get(); }
+    size_t paragraphTextStart(size_t index) const { return fLines[index].fStart; }
+    SkScalar paragraphTop(size_t index) const { return fLines[index].fTop; }
+
+    // Returns the index of the paragraph holding the text offset (a '\n' belongs to the
+    // paragraph it ends).
+    size_t paragraphIndexAt(size_t offset) const;
+
+    // Returns the paragraph and the position in it which are closest to the coordinate, with
+    // the top-left corner of the text as the origin. The position is in the paragraph's own
+    // glyph position units (see Paragraph::getGlyphPositionAtCoordinate).
+    std::pair<size_t, PositionWithAffinity> getGlyphPositionAtCoordinate(SkScalar dx,
+                                                                         SkScalar dy) const;
+
+private:
+    struct Line {
+        size_t fStart;   // The line's text, not including the '\n' which ends it.
+        size_t fLength;
+        std::unique_ptr<Paragraph> fParagraph;
+        SkScalar fTop = 0;
+    };
+
+    // Splits fText[start, start + length) into lines, appending them to 'lines'.
+    void splitLines(size_t start, size_t length, std::vector<Line>* lines) const;
+
+    const ParagraphStyle fParagraphStyle;
+    const TextStyle fTextStyle;
+    const sk_sp<FontCollection> fFontCollection;
+
+    std::string fText;
+    std::vector<Line> fLines;
+    bool fLaidOut = false;
+    SkScalar fWidth = 0;
+    SkScalar fHeight = 0;
+    SkScalar fLongestLine = 0;
+};
+
+}  // namespace textlayout
+}  // namespace skia
+
+#endif  // EditableParagraph_DEFINED
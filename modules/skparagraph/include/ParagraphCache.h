@@ -2,9 +2,14 @@
 #ifndef ParagraphCache_DEFINED
 #define ParagraphCache_DEFINED
 
+#include "include/core/SkString.h"
 #include "include/private/base/SkMutex.h"
 #include "src/core/SkLRUCache.h"
+
+#include <atomic>
+#include <cstddef>
 #include <functional>  // std::function
+#include <memory>
 
 #define PARAGRAPH_CACHE_STATS
 
@@ -17,6 +22,8 @@ class ParagraphCacheValue;
 
 class ParagraphCache {
 public:
+    inline static constexpr int kDefaultMaxEntries = 128;
+
     ParagraphCache();
     ~ParagraphCache();
 
@@ -25,13 +32,30 @@ public:
     bool updateParagraph(ParagraphImpl* paragraph);
     bool findParagraph(ParagraphImpl* paragraph);
 
+    // Limits the cache to maxEntries paragraphs and, unless maxBytes is 0, to roughly maxBytes of
+    // cached shaping results. The cache is split into shards by key hash, each with its own lock
+    // and an even part of both limits, so eviction is least-recently-used within a shard.
+    void setLimits(int maxEntries, size_t maxBytes);
+    int maxEntries() const;
+    size_t maxBytes() const;
+    size_t bytesUsed() const;
+
+    struct Stats {
+        int fLookups = 0;       // findParagraph() calls while the cache is on
+        int fHits = 0;          // lookups which found the paragraph
+        int fInsertions = 0;    // paragraphs added by updateParagraph()
+
+        float hitRate() const { return fLookups > 0 ? static_cast<float>(fHits) / fLookups : 0; }
+    };
+    Stats stats() const;
+
     // For testing
     void setChecker(std::function<void(ParagraphImpl* impl, const char*, bool)> checker) {
         fChecker = std::move(checker);
     }
     void printStatistics();
     void turnOn(bool value) { fCacheIsOn = value; }
-    int count() { return fLRUCacheMap.count(); }
+    int count();
 
     bool isPossiblyTextEditing(ParagraphImpl* paragraph);
 
@@ -40,24 +64,42 @@ public:
     struct Entry;
     void updateFrom(const ParagraphImpl* paragraph, Entry* entry);
     void updateTo(ParagraphImpl* paragraph, const Entry* entry);
+    static size_t ApproximateBytes(const ParagraphCacheValue* value);
+    void setLastCachedText(const SkString& text);
 
-     mutable SkMutex fParagraphMutex;
-     std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
-
-    static const int kMaxEntries = 128;
+    std::function<void(ParagraphImpl* impl, const char*, bool)> fChecker;
 
     struct KeyHash {
         uint32_t operator()(const ParagraphCacheKey& key) const;
     };
 
-    SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
+    // Shards are picked with the top bits of the key hash.
+    static constexpr int kShardBits = 3;
+    static constexpr int kShardCount = 1 << kShardBits;
+
+    struct Shard {
+        Shard();
+
+        mutable SkMutex fMutex;
+        SkLRUCache<ParagraphCacheKey, std::unique_ptr<Entry>, KeyHash> fLRUCacheMap;
+        size_t fBytesUsed = 0;
+    };
+    Shard& shardFor(const ParagraphCacheKey& key);
+
+    Shard fShards[kShardCount];
+    std::atomic<int> fMaxEntries;
+    std::atomic<size_t> fMaxBytes;
     bool fCacheIsOn;
-    ParagraphCacheValue* fLastCachedValue;
+
+    // The start and end of the last cached text, for isPossiblyTextEditing().
+    SkMutex fLastTextMutex;
+    SkString fLastTextPrefix;
+    SkString fLastTextSuffix;
 
 #ifdef PARAGRAPH_CACHE_STATS
-    int fTotalRequests;
-    int fCacheMisses;
-    int fHashMisses; // cache hit but hash table missed
+    std::atomic<int> fLookups;
+    std::atomic<int> fHits;
+    std::atomic<int> fInsertions;
 #endif
 };
 
@@ -0,0 +1,127 @@
+// Copyright 2024 Google LLC.
+#include "modules/skparagraph/include/EditableParagraph.h"
+
+#include "include/core/SkCanvas.h"
+#include "modules/skparagraph/include/ParagraphBuilder.h"
+
+#include <algorithm>
+
+namespace skia {
+namespace textlayout {
+
+EditableParagraph::EditableParagraph(const ParagraphStyle& paragraphStyle,
+                                     const TextStyle& textStyle,
+                                     sk_sp<FontCollection> fontCollection)
+        : fParagraphStyle(paragraphStyle)
+        , fTextStyle(textStyle)
+        , fFontCollection(std::move(fontCollection)) {
+    this->setText({});
+}
+
+EditableParagraph::~EditableParagraph() = default;
+
+void EditableParagraph::splitLines(size_t start, size_t length, std::vector<Line>* lines) const {
+    const size_t end = start + length;
+    for (size_t lineStart = start;;) {
+        const size_t lineEnd = fText.find('\n', lineStart);
+        if (lineEnd == std::string::npos || lineEnd >= end) {
+            lines->push_back({lineStart, end - lineStart, nullptr});
+            return;
+        }
+        lines->push_back({lineStart, lineEnd - lineStart, nullptr});
+        lineStart = lineEnd + 1;
+    }
+}
+
+void EditableParagraph::setText(std::string_view utf8) {
+    fText = utf8;
+    fLines.clear();
+    this->splitLines(0, fText.size(), &fLines);
+}
+
+size_t EditableParagraph::paragraphIndexAt(size_t offset) const {
+    // The last line which starts at or before the offset.
+    auto line = std::upper_bound(fLines.begin(), fLines.end(), offset,
+                                 [](size_t offset, const Line& line) {
+                                     return offset < line.fStart;
+                                 });
+    SkASSERT(line != fLines.begin());
+    return std::distance(fLines.begin(), line) - 1;
+}
+
+void EditableParagraph::replaceText(size_t start, size_t end, std::string_view utf8) {
+    end = std::min(end, fText.size());
+    start = std::min(start, end);
+
+    // The edit rebuilds the lines it touches, from the start of the first one to the end of the
+    // last one. Removing or adding a '\n' in there merges or splits lines.
+    const size_t first = this->paragraphIndexAt(start),
+                 last  = this->paragraphIndexAt(end);
+    const size_t editedStart = fLines[first].fStart,
+                 editedEnd   = fLines[last].fStart + fLines[last].fLength;
+
+    fText.replace(start, end - start, utf8);
+    const size_t removed = end - start;
+
+    std::vector<Line> edited;
+    this->splitLines(editedStart, editedEnd - removed + utf8.size() - editedStart, &edited);
+
+    // The lines after the edit keep their paragraphs; only their text moves.
+    for (size_t i = last + 1; i < fLines.size(); ++i) {
+        fLines[i].fStart = fLines[i].fStart - removed + utf8.size();
+    }
+    fLines.erase(fLines.begin() + first, fLines.begin() + last + 1);
+    fLines.insert(fLines.begin() + first,
+                  std::make_move_iterator(edited.begin()),
+                  std::make_move_iterator(edited.end()));
+}
+
+void EditableParagraph::layout(SkScalar width) {
+    const bool widthChanged = !fLaidOut || width != fWidth;
+    fLaidOut = true;
+    fWidth = width;
+
+    fHeight = 0;
+    fLongestLine = 0;
+    for (Line& line : fLines) {
+        if (!line.fParagraph) {
+            auto builder = ParagraphBuilder::make(fParagraphStyle, fFontCollection);
+            builder->pushStyle(fTextStyle);
+            builder->addText(fText.data() + line.fStart, line.fLength);
+            builder->pop();
+            line.fParagraph = builder->Build();
+            line.fParagraph->layout(width);
+        } else if (widthChanged) {
+            line.fParagraph->layout(width);
+        }
+        line.fTop = fHeight;
+        fHeight += line.fParagraph->getHeight();
+        fLongestLine = std::max(fLongestLine, line.fParagraph->getLongestLine());
+    }
+}
+
+void EditableParagraph::paint(SkCanvas* canvas, SkScalar x, SkScalar y) {
+    for (const Line& line : fLines) {
+        if (line.fParagraph) {
+            line.fParagraph->paint(canvas, x, y + line.fTop);
+        }
+    }
+}
+
+std::pair<size_t, PositionWithAffinity> EditableParagraph::getGlyphPositionAtCoordinate(
+        SkScalar dx, SkScalar dy) const {
+    // The last paragraph which starts at or above dy.
+    auto line = std::upper_bound(fLines.begin(), fLines.end(), dy,
+                                 [](SkScalar dy, const Line& line) { return dy < line.fTop; });
+    if (line != fLines.begin()) {
+        --line;
+    }
+    const size_t index = std::distance(fLines.begin(), line);
+    if (!line->fParagraph) {
+        return {index, PositionWithAffinity()};
+    }
+    return {index, line->fParagraph->getGlyphPositionAtCoordinate(dx, dy - line->fTop)};
+}
+
+}  // namespace textlayout
+}  // namespace skia
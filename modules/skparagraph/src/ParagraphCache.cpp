@@ -1,4 +1,5 @@
 // Copyright 2019 Google LLC.
+#include <algorithm>
 #include <memory>
 
 #include "modules/skparagraph/include/FontArguments.h"
@@ -233,24 +234,100 @@ bool ParagraphCacheKey::operator==(const ParagraphCacheKey& other) const {
 
 struct ParagraphCache::Entry {
 
-    Entry(ParagraphCacheValue* value) : fValue(value) {}
+    Entry(ParagraphCacheValue* value, size_t bytes, size_t* shardBytes)
+        : fValue(value), fBytes(bytes), fShardBytes(shardBytes) {
+        *fShardBytes += fBytes;
+    }
+    // Entries are destroyed when the LRU cache evicts them, under the shard's lock.
+    ~Entry() { *fShardBytes -= fBytes; }
+
     std::unique_ptr<ParagraphCacheValue> fValue;
+    const size_t fBytes;
+    size_t* fShardBytes;
 };
 
+ParagraphCache::Shard::Shard() : fLRUCacheMap(kDefaultMaxEntries / kShardCount) {}
+
 ParagraphCache::ParagraphCache()
     : fChecker([](ParagraphImpl* impl, const char*, bool){ })
-    , fLRUCacheMap(kMaxEntries)
+    , fMaxEntries(kDefaultMaxEntries)
+    , fMaxBytes(0)
     , fCacheIsOn(true)
-    , fLastCachedValue(nullptr)
 #ifdef PARAGRAPH_CACHE_STATS
-    , fTotalRequests(0)
-    , fCacheMisses(0)
-    , fHashMisses(0)
+    , fLookups(0)
+    , fHits(0)
+    , fInsertions(0)
 #endif
 { }
 
 ParagraphCache::~ParagraphCache() { }
 
+ParagraphCache::Shard& ParagraphCache::shardFor(const ParagraphCacheKey& key) {
+    // The hash table inside each shard uses the low bits of the hash.
+    return fShards[key.hash() >> (32 - kShardBits)];
+}
+
+void ParagraphCache::setLimits(int maxEntries, size_t maxBytes) {
+    fMaxEntries = std::max(maxEntries, 1);
+    fMaxBytes = maxBytes;
+    // Round the entries up, so that every shard can hold at least one paragraph.
+    const int shardEntries = (fMaxEntries + kShardCount - 1) / kShardCount;
+    const size_t shardBytes = maxBytes / kShardCount;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.fLRUCacheMap.setMaxCount(shardEntries);
+        while (maxBytes && shard.fBytesUsed > shardBytes) {
+            shard.fLRUCacheMap.removeLRU();
+        }
+    }
+}
+
+int ParagraphCache::maxEntries() const { return fMaxEntries; }
+
+size_t ParagraphCache::maxBytes() const { return fMaxBytes; }
+
+size_t ParagraphCache::bytesUsed() const {
+    size_t bytes = 0;
+    for (const Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        bytes += shard.fBytesUsed;
+    }
+    return bytes;
+}
+
+int ParagraphCache::count() {
+    int count = 0;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        count += shard.fLRUCacheMap.count();
+    }
+    return count;
+}
+
+ParagraphCache::Stats ParagraphCache::stats() const {
+    Stats stats;
+#ifdef PARAGRAPH_CACHE_STATS
+    stats.fLookups = fLookups;
+    stats.fHits = fHits;
+    stats.fInsertions = fInsertions;
+#endif
+    return stats;
+}
+
+size_t ParagraphCache::ApproximateBytes(const ParagraphCacheValue* value) {
+    size_t bytes = sizeof(ParagraphCacheValue) + value->fKey.text().size();
+    for (const Run& run : value->fRuns) {
+        bytes += sizeof(Run) +
+                 run.size() * (sizeof(SkGlyphID) + 2 * sizeof(SkPoint) + sizeof(uint32_t));
+    }
+    bytes += value->fClusters.size() * sizeof(Cluster);
+    bytes += value->fClustersIndexFromCodeUnit.size() * sizeof(size_t);
+    bytes += value->fCodeUnitProperties.size() * sizeof(SkUnicode::CodeUnitFlags);
+    bytes += value->fWords.size() * sizeof(size_t);
+    bytes += value->fBidiRegions.size() * sizeof(SkUnicode::BidiRegion);
+    return bytes;
+}
+
 void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 
     paragraph->fRuns.clear();
@@ -272,12 +349,13 @@ void ParagraphCache::updateTo(ParagraphImpl* paragraph, const Entry* entry) {
 }
 
 void ParagraphCache::printStatistics() {
+    const Stats stats = this->stats();
     SkDebugf("--- Paragraph Cache ---\n");
-    SkDebugf("Total requests: %d\n", fTotalRequests);
-    SkDebugf("Cache misses: %d\n", fCacheMisses);
-    SkDebugf("Cache miss %%: %f\n", (fTotalRequests > 0) ? 100.f * fCacheMisses / fTotalRequests : 0.f);
-    int cacheHits = fTotalRequests - fCacheMisses;
-    SkDebugf("Hash miss %%: %f\n", (cacheHits > 0) ? 100.f * fHashMisses / cacheHits : 0.f);
+    SkDebugf("Lookups: %d\n", stats.fLookups);
+    SkDebugf("Cache misses: %d\n", stats.fLookups - stats.fHits);
+    SkDebugf("Cache hit %%: %f\n", 100.f * stats.hitRate());
+    SkDebugf("Insertions: %d\n", stats.fInsertions);
+    SkDebugf("Entries: %d, bytes: %zu\n", this->count(), this->bytesUsed());
     SkDebugf("---------------------\n");
 }
 
@@ -286,14 +364,16 @@ void ParagraphCache::abandon() {
 }
 
 void ParagraphCache::reset() {
-    SkAutoMutexExclusive lock(fParagraphMutex);
 #ifdef PARAGRAPH_CACHE_STATS
-    fTotalRequests = 0;
-    fCacheMisses = 0;
-    fHashMisses = 0;
+    fLookups = 0;
+    fHits = 0;
+    fInsertions = 0;
 #endif
-    fLRUCacheMap.reset();
-    fLastCachedValue = nullptr;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive lock(shard.fMutex);
+        shard.fLRUCacheMap.reset();
+    }
+    this->setLastCachedText(SkString());
 }
 
 bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
@@ -301,20 +381,21 @@ bool ParagraphCache::findParagraph(ParagraphImpl* paragraph) {
         return false;
     }
 #ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
+    fLookups.fetch_add(1, std::memory_order_relaxed);
 #endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
 
     if (!entry) {
         // We have a cache miss
-#ifdef PARAGRAPH_CACHE_STATS
-        ++fCacheMisses;
-#endif
         fChecker(paragraph, "missingParagraph", true);
         return false;
     }
+#ifdef PARAGRAPH_CACHE_STATS
+    fHits.fetch_add(1, std::memory_order_relaxed);
+#endif
     updateTo(paragraph, entry->get());
     fChecker(paragraph, "foundParagraph", true);
     return true;
@@ -324,13 +405,11 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
     if (!fCacheIsOn) {
         return false;
     }
-#ifdef PARAGRAPH_CACHE_STATS
-    ++fTotalRequests;
-#endif
-    SkAutoMutexExclusive lock(fParagraphMutex);
 
     ParagraphCacheKey key(paragraph);
-    std::unique_ptr<Entry>* entry = fLRUCacheMap.find(key);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive lock(shard.fMutex);
+    std::unique_ptr<Entry>* entry = shard.fLRUCacheMap.find(key);
     if (!entry) {
         // isTooMuchMemoryWasted(paragraph) not needed for now
         if (isPossiblyTextEditing(paragraph)) {
@@ -338,9 +417,20 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
             return false;
         }
         ParagraphCacheValue* value = new ParagraphCacheValue(std::move(key), paragraph);
-        fLRUCacheMap.insert(value->fKey, std::make_unique<Entry>(value));
+        const size_t bytes = ApproximateBytes(value);
+        shard.fLRUCacheMap.insert(value->fKey,
+                                  std::make_unique<Entry>(value, bytes, &shard.fBytesUsed));
+        // Keep at least the new paragraph, even if it's over the budget on its own.
+        const size_t maxBytes = fMaxBytes;
+        const size_t shardBytes = maxBytes / kShardCount;
+        while (maxBytes && shard.fBytesUsed > shardBytes && shard.fLRUCacheMap.count() > 1) {
+            shard.fLRUCacheMap.removeLRU();
+        }
+#ifdef PARAGRAPH_CACHE_STATS
+        fInsertions.fetch_add(1, std::memory_order_relaxed);
+#endif
         fChecker(paragraph, "addedParagraph", true);
-        fLastCachedValue = value;
+        this->setLastCachedText(paragraph->fText);
         return true;
     } else {
         // We do not have to update the paragraph
@@ -350,25 +440,32 @@ bool ParagraphCache::updateParagraph(ParagraphImpl* paragraph) {
 
 // Special situation: (very) long paragraph that is close to the last formatted paragraph
 #define NOCACHE_PREFIX_LENGTH 40
-bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
-    if (fLastCachedValue == nullptr) {
-        return false;
+void ParagraphCache::setLastCachedText(const SkString& text) {
+    SkAutoMutexExclusive lock(fLastTextMutex);
+    if (text.size() < NOCACHE_PREFIX_LENGTH) {
+        fLastTextPrefix.reset();
+        fLastTextSuffix.reset();
+        return;
     }
+    fLastTextPrefix.set(text.c_str(), NOCACHE_PREFIX_LENGTH);
+    fLastTextSuffix.set(text.c_str() + text.size() - NOCACHE_PREFIX_LENGTH, NOCACHE_PREFIX_LENGTH);
+}
 
-    auto& lastText = fLastCachedValue->fKey.text();
+bool ParagraphCache::isPossiblyTextEditing(ParagraphImpl* paragraph) {
+    SkAutoMutexExclusive lock(fLastTextMutex);
     auto& text = paragraph->fText;
 
-    if ((lastText.size() < NOCACHE_PREFIX_LENGTH) || (text.size() < NOCACHE_PREFIX_LENGTH)) {
+    if (fLastTextPrefix.isEmpty() || (text.size() < NOCACHE_PREFIX_LENGTH)) {
         // Either last text or the current are too short
         return false;
     }
 
-    if (std::strncmp(lastText.c_str(), text.c_str(), NOCACHE_PREFIX_LENGTH) == 0) {
+    if (std::strncmp(fLastTextPrefix.c_str(), text.c_str(), NOCACHE_PREFIX_LENGTH) == 0) {
         // Texts have the same starts
         return true;
     }
 
-    if (std::strncmp(lastText.c_str() + lastText.size() - NOCACHE_PREFIX_LENGTH, &text[text.size() - NOCACHE_PREFIX_LENGTH], NOCACHE_PREFIX_LENGTH) == 0) {
+    if (std::strncmp(fLastTextSuffix.c_str(), &text[text.size() - NOCACHE_PREFIX_LENGTH], NOCACHE_PREFIX_LENGTH) == 0) {
         // Texts have the same ends
         return true;
     }
@@ -196,13 +196,16 @@ void ParagraphImpl::layout(SkScalar rawWidth) {
                 fFontCollection->getParagraphCache()->updateParagraph(this);
             }
         }
+        // The strut and the empty line metrics only depend on the styles and the runs, so they
+        // are kept along with the shaped text. A layout with a new width only breaks the lines
+        // and formats them again.
+        this->resolveStrut();
+        this->computeEmptyMetrics();
         fState = kShaped;
     }
 
     if (fState == kShaped) {
         this->resetContext();
-        this->resolveStrut();
-        this->computeEmptyMetrics();
         this->fLines.clear();
         this->breakShapedTextIntoLines(floorWidth);
         fState = kLineBroken;
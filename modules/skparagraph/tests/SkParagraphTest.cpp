@@ -21,6 +21,7 @@
 #include "include/core/SkTypes.h"
 #include "include/encode/SkPngEncoder.h"
 #include "modules/skparagraph/include/DartTypes.h"
+#include "modules/skparagraph/include/EditableParagraph.h"
 #include "modules/skparagraph/include/FontCollection.h"
 #include "modules/skparagraph/include/Paragraph.h"
 #include "modules/skparagraph/include/ParagraphCache.h"
@@ -5352,6 +5353,175 @@ UNIX_ONLY_TEST(SkParagraph_CacheStyles, reporter) {
     test(2, false);
 }
 
+UNIX_ONLY_TEST(SkParagraph_CacheLimits, reporter) {
+    ParagraphCache cache;
+    cache.turnOn(true);
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setColor(SK_ColorBLACK);
+
+    auto lookup = [&](int i) {
+        const SkString text = SkStringPrintf("paragraph %d", i);
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text.c_str(), text.size());
+        builder.pop();
+        auto paragraph = builder.Build();
+        auto impl = static_cast<ParagraphImpl*>(paragraph.get());
+        if (!cache.findParagraph(impl)) {
+            cache.updateParagraph(impl);
+        }
+    };
+
+    // The entry limit is split across the cache's shards, so it holds no more than that.
+    REPORTER_ASSERT(reporter, cache.maxEntries() == ParagraphCache::kDefaultMaxEntries);
+    cache.setLimits(16, 0);
+    for (int i = 0; i < 100; ++i) {
+        lookup(i);
+    }
+    REPORTER_ASSERT(reporter, cache.count() > 0 && cache.count() <= 16);
+
+    ParagraphCache::Stats stats = cache.stats();
+    REPORTER_ASSERT(reporter, stats.fLookups == 100);
+    REPORTER_ASSERT(reporter, stats.fHits == 0);
+    REPORTER_ASSERT(reporter, stats.fInsertions == 100);
+
+    // Repeated lookups hit.
+    cache.reset();
+    cache.setLimits(1000, 0);
+    for (int i = 0; i < 20; ++i) {
+        lookup(i % 10);
+    }
+    stats = cache.stats();
+    REPORTER_ASSERT(reporter, cache.count() == 10);
+    REPORTER_ASSERT(reporter, stats.fHits == 10);
+    REPORTER_ASSERT(reporter, stats.hitRate() == 0.5f);
+
+    // A byte budget evicts paragraphs, and lowering it purges them right away.
+    const size_t bytes = cache.bytesUsed();
+    REPORTER_ASSERT(reporter, bytes > 0);
+    cache.setLimits(1000, bytes / 4);
+    REPORTER_ASSERT(reporter, cache.count() < 10);
+    REPORTER_ASSERT(reporter, cache.bytesUsed() <= bytes / 4);
+
+    cache.reset();
+    REPORTER_ASSERT(reporter, cache.count() == 0 && cache.bytesUsed() == 0);
+}
+
+UNIX_ONLY_TEST(SkParagraph_ResizeKeepsShaping, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+    fontCollection->disableFontFallback();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+
+    StrutStyle strut_style;
+    strut_style.setFontFamilies({SkString("Roboto")});
+    strut_style.setFontSize(30);
+    strut_style.setStrutEnabled(true);
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+    paragraph_style.setStrutStyle(strut_style);
+    paragraph_style.setTextStyle(text_style);
+
+    const char* text = "The quick brown fox jumps over the lazy dog.\n"
+                       "Pack my box with five dozen liquor jugs.";
+    auto build = [&]() {
+        ParagraphBuilderImpl builder(paragraph_style, fontCollection);
+        builder.pushStyle(text_style);
+        builder.addText(text);
+        builder.pop();
+        return builder.Build();
+    };
+
+    // Laying out the same paragraph at several widths must match laying out a new one at each.
+    auto resized = build();
+    auto impl = static_cast<ParagraphImpl*>(resized.get());
+    for (SkScalar width : {500.f, 150.f, 300.f, 150.f, 500.f}) {
+        resized->layout(width);
+        REPORTER_ASSERT(reporter, impl->state() == kFormatted);
+
+        auto fresh = build();
+        fresh->layout(width);
+        REPORTER_ASSERT(reporter, resized->lineNumber() == fresh->lineNumber());
+        REPORTER_ASSERT(reporter, resized->getHeight() == fresh->getHeight());
+        REPORTER_ASSERT(reporter, resized->getLongestLine() == fresh->getLongestLine());
+        REPORTER_ASSERT(reporter, resized->getAlphabeticBaseline() == fresh->getAlphabeticBaseline());
+        REPORTER_ASSERT(reporter,
+                        resized->getMinIntrinsicWidth() == fresh->getMinIntrinsicWidth());
+    }
+}
+
+UNIX_ONLY_TEST(SkParagraph_EditableParagraph, reporter) {
+    sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
+    SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
+
+    ParagraphStyle paragraph_style;
+    paragraph_style.turnHintingOff();
+
+    TextStyle text_style;
+    text_style.setFontFamilies({SkString("Roboto")});
+    text_style.setFontSize(20);
+    text_style.setColor(SK_ColorBLACK);
+
+    EditableParagraph editable(paragraph_style, text_style, fontCollection);
+    editable.setText("first line\nsecond line\nthird line");
+    editable.layout(TestCanvasWidth);
+    REPORTER_ASSERT(reporter, editable.paragraphCount() == 3);
+
+    Paragraph* first = editable.paragraph(0);
+    Paragraph* third = editable.paragraph(2);
+    const SkScalar thirdTop = editable.paragraphTop(2);
+    REPORTER_ASSERT(reporter, editable.paragraphTop(1) == first->getHeight());
+    REPORTER_ASSERT(reporter, editable.getHeight() == thirdTop + third->getHeight());
+
+    // An edit inside a line only rebuilds that line's paragraph.
+    editable.replaceText(11, 17, "2nd");
+    REPORTER_ASSERT(reporter, editable.text() == "first line\n2nd line\nthird line");
+    REPORTER_ASSERT(reporter, editable.paragraph(1) == nullptr);
+    editable.layout(TestCanvasWidth);
+    REPORTER_ASSERT(reporter, editable.paragraph(0) == first);
+    REPORTER_ASSERT(reporter, editable.paragraph(2) == third);
+    REPORTER_ASSERT(reporter, editable.paragraphTop(2) == thirdTop);
+    REPORTER_ASSERT(reporter, editable.paragraphTextStart(2) == 20);
+
+    // Inserting a hard break splits a line.
+    editable.replaceText(3, 3, "\n");
+    editable.layout(TestCanvasWidth);
+    REPORTER_ASSERT(reporter, editable.paragraphCount() == 4);
+    REPORTER_ASSERT(reporter, editable.paragraph(3) == third);
+    REPORTER_ASSERT(reporter, editable.paragraphTop(3) > thirdTop);
+    REPORTER_ASSERT(reporter, editable.paragraphIndexAt(3) == 0);
+    REPORTER_ASSERT(reporter, editable.paragraphIndexAt(4) == 1);
+
+    // Deleting across lines merges them.
+    editable.replaceText(2, 16, "");
+    REPORTER_ASSERT(reporter, editable.text() == "fi line\nthird line");
+    editable.layout(TestCanvasWidth);
+    REPORTER_ASSERT(reporter, editable.paragraphCount() == 2);
+    REPORTER_ASSERT(reporter, editable.paragraph(1) == third);
+
+    SkScalar height = 0;
+    for (size_t i = 0; i < editable.paragraphCount(); ++i) {
+        REPORTER_ASSERT(reporter, editable.paragraphTop(i) == height);
+        height += editable.paragraph(i)->getHeight();
+    }
+    REPORTER_ASSERT(reporter, editable.getHeight() == height);
+
+    auto [index, position] = editable.getGlyphPositionAtCoordinate(1, editable.paragraphTop(1) + 1);
+    REPORTER_ASSERT(reporter, index == 1 && position.position == 0);
+}
+
 UNIX_ONLY_TEST(SkParagraph_ParagraphWithLineBreak, reporter) {
     sk_sp<ResourceFontCollection> fontCollection = sk_make_sp<ResourceFontCollection>();
     SKIP_IF_FONTS_NOT_FOUND(reporter, fontCollection)
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSGRasterCache_DEFINED
+#define SkSGRasterCache_DEFINED
+
+#include "include/core/SkImage.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "modules/sksg/include/SkSGEffectNode.h"
+#include "modules/sksg/include/SkSGNode.h"
+#include "modules/sksg/include/SkSGRenderNode.h"
+
+#include <utility>
+
+class GrRecordingContext;
+class SkCanvas;
+class SkMatrix;
+struct SkPoint;
+
+namespace skgpu::graphite {
+class Recorder;
+}
+
+namespace sksg {
+class InvalidationController;
+
+/**
+ * Concrete Effect node, which renders its descendants to an image when they stay unchanged
+ * between renders, and draws the cached image from then on.
+ *
+ * Transforms and opacity applied above this node don't affect the cache, so it pays off for static
+ * content which only moves or fades.  The cached image is rasterized at the current CTM scale,
+ * and is rebuilt when the scale drifts past the tolerance (as a ratio, e.g. 0.25 for +/-25%).
+ *
+ * Content which changes on every render is never cached.  Cached content is composited as a
+ * single image, so paint overrides from above (e.g. opacity) apply to it as a whole.
+ */
+class RasterCacheEffect final : public EffectNode {
+public:
+    static sk_sp<RasterCacheEffect> Make(sk_sp<RenderNode> child) {
+        return child ? sk_sp<RasterCacheEffect>(new RasterCacheEffect(std::move(child)))
+                     : nullptr;
+    }
+
+    SG_ATTRIBUTE(ScaleTolerance, float, fScaleTolerance)
+
+    // Whether the last render was drawn from the cached image (for testing).
+    bool renderedFromCache() const { return fRenderedFromCache; }
+
+protected:
+    explicit RasterCacheEffect(sk_sp<RenderNode>);
+
+    void onRender(SkCanvas*, const RenderContext*) const override;
+
+    SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
+
+private:
+    // Returns false if the content can't be cached at the given scale.
+    bool updateCache(SkCanvas*, float scale) const;
+
+    float fScaleTolerance = 0.25f;
+
+    // Rendering state.
+    mutable sk_sp<SkImage>             fImage;
+    mutable float                      fImageScale = 0;
+    mutable GrRecordingContext*        fImageContext  = nullptr;  // identity only
+    mutable skgpu::graphite::Recorder* fImageRecorder = nullptr;  // identity only
+    mutable bool                       fContentStable     = false,
+                                       fRenderedFromCache = false;
+
+    using INHERITED = EffectNode;
+};
+
+} // namespace sksg
+
+#endif // SkSGRasterCache_DEFINED
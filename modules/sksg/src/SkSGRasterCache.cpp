@@ -0,0 +1,119 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/sksg/include/SkSGRasterCache.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkSurface.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkFloatingPoint.h"
+
+#include <cmath>
+
+namespace sksg {
+
+// Larger content is rendered directly, rather than holding on to a huge image.
+static constexpr float kMaxCacheDimension = 4096;
+
+RasterCacheEffect::RasterCacheEffect(sk_sp<RenderNode> child)
+    : INHERITED(std::move(child)) {}
+
+SkRect RasterCacheEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
+    SkASSERT(this->hasInval());
+
+    // The content (or our tolerance) changed: wait until it settles down before caching again.
+    fImage.reset();
+    fContentStable = false;
+
+    return this->INHERITED::onRevalidate(ic, ctm);
+}
+
+bool RasterCacheEffect::updateCache(SkCanvas* canvas, float scale) const {
+    const bool scale_ok = fImageScale > 0 &&
+                          scale <= fImageScale * (1 + fScaleTolerance) &&
+                          scale * (1 + fScaleTolerance) >= fImageScale;
+    if (fImage &&
+        scale_ok &&
+        fImageContext == canvas->recordingContext() &&
+        fImageRecorder == canvas->recorder()) {
+        return true;
+    }
+    fImage.reset();
+
+    const SkRect& bounds = this->bounds();
+    const auto w = std::ceil(bounds.width()  * scale),
+               h = std::ceil(bounds.height() * scale);
+    if (!(w >= 1 && h >= 1 && w <= kMaxCacheDimension && h <= kMaxCacheDimension)) {
+        return false;
+    }
+
+    // Cache compatible with the destination (e.g. on the same GPU), when it supports that.
+    // Canvases without a backing surface (such as picture recorders) render directly.
+    const auto info = SkImageInfo::MakeN32Premul(static_cast<int>(w), static_cast<int>(h),
+                                                  canvas->imageInfo().refColorSpace());
+    auto surface = canvas->makeSurface(info);
+    if (!surface) {
+        return false;
+    }
+
+    SkCanvas* cache_canvas = surface->getCanvas();
+    cache_canvas->clear(SK_ColorTRANSPARENT);
+    cache_canvas->scale(scale, scale);
+    cache_canvas->translate(-bounds.left(), -bounds.top());
+    this->INHERITED::onRender(cache_canvas, nullptr);
+
+    fImage         = surface->makeImageSnapshot();
+    fImageScale    = scale;
+    fImageContext  = canvas->recordingContext();
+    fImageRecorder = canvas->recorder();
+
+    return fImage != nullptr;
+}
+
+void RasterCacheEffect::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    fRenderedFromCache = false;
+
+    // Content which just changed is likely to keep changing: only cache once it has been
+    // rendered unchanged.
+    const SkMatrix& ctm = canvas->getTotalMatrix();
+    const auto scale = ctm.hasPerspective() ? -1 : ctm.getMaxScale();
+    if (!fContentStable || !sk_float_isfinite(scale) || scale <= 0 || !this->updateCache(canvas, scale)) {
+        fContentStable = true;
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    ScopedRenderContext local_ctx(canvas, ctx);
+    if (ctx) {
+        if (ctx->fMaskShader) {
+            // Mask shaders cannot be applied via drawImage - we need layer isolation.
+            local_ctx.setIsolation(this->bounds(), ctm, true);
+        }
+        local_ctx->modulatePaint(ctm, &paint);
+    }
+
+    const SkRect& bounds = this->bounds();
+    canvas->drawImageRect(fImage,
+                          SkRect::MakeXYWH(bounds.left(), bounds.top(),
+                                           fImage->width()  / fImageScale,
+                                           fImage->height() / fImageScale),
+                          SkSamplingOptions(SkFilterMode::kLinear),
+                          &paint);
+    fRenderedFromCache = true;
+}
+
+} // namespace sksg
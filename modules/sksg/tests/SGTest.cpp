@@ -9,12 +9,17 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkRect.h"
 #include "include/private/base/SkTo.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGroup.h"
 #include "modules/sksg/include/SkSGInvalidationController.h"
 #include "modules/sksg/include/SkSGPaint.h"
+#include "modules/sksg/include/SkSGRasterCache.h"
 #include "modules/sksg/include/SkSGRect.h"
 #include "modules/sksg/include/SkSGRenderEffect.h"
 #include "modules/sksg/include/SkSGTransform.h"
@@ -355,4 +360,55 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+DEF_TEST(SGRasterCache, reporter) {
+    auto color = sksg::Color::Make(SK_ColorRED);
+    auto cache = sksg::RasterCacheEffect::Make(
+            sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeLTRB(0, 0, 10, 10)), color));
+    auto matrix = sksg::Matrix<SkMatrix>::Make(SkMatrix::I());
+    auto root = sksg::TransformEffect::Make(cache, matrix);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32Premul(50, 50));
+    SkCanvas canvas(bitmap);
+    auto render = [&]() {
+        root->revalidate(nullptr, SkMatrix::I());
+        canvas.clear(SK_ColorWHITE);
+        root->render(&canvas);
+    };
+
+    // The first render of new content is direct, and the content is cached on the next one.
+    render();
+    REPORTER_ASSERT(reporter, !cache->renderedFromCache());
+    render();
+    REPORTER_ASSERT(reporter, cache->renderedFromCache());
+    REPORTER_ASSERT(reporter, bitmap.getColor(5, 5) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, bitmap.getColor(15, 5) == SK_ColorWHITE);
+
+    // Moving the content reuses the cached image.
+    matrix->setMatrix(SkMatrix::Translate(20, 20));
+    render();
+    REPORTER_ASSERT(reporter, cache->renderedFromCache());
+    REPORTER_ASSERT(reporter, bitmap.getColor(5, 5) == SK_ColorWHITE);
+    REPORTER_ASSERT(reporter, bitmap.getColor(25, 25) == SK_ColorRED);
+
+    // So does scaling it, within the tolerance and past it (which rebuilds the image).
+    matrix->setMatrix(SkMatrix::Scale(1.2f, 1.2f));
+    render();
+    REPORTER_ASSERT(reporter, cache->renderedFromCache());
+    matrix->setMatrix(SkMatrix::Scale(4, 4));
+    render();
+    REPORTER_ASSERT(reporter, cache->renderedFromCache());
+    REPORTER_ASSERT(reporter, bitmap.getColor(35, 35) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, bitmap.getColor(45, 45) == SK_ColorWHITE);
+
+    // Changing the content drops the cache until it is stable again.
+    color->setColor(SK_ColorBLUE);
+    render();
+    REPORTER_ASSERT(reporter, !cache->renderedFromCache());
+    REPORTER_ASSERT(reporter, bitmap.getColor(35, 35) == SK_ColorBLUE);
+    render();
+    REPORTER_ASSERT(reporter, cache->renderedFromCache());
+    REPORTER_ASSERT(reporter, bitmap.getColor(35, 35) == SK_ColorBLUE);
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
@@ -306,6 +306,16 @@ private:
 namespace SkShapers {
 SKSHAPER_API std::unique_ptr<SkShaper> Primitive();
 
+/**
+ * Wraps a shaper with a cache of its results, for text which is shaped again and again, like the
+ * labels of a UI. The results are keyed by the text, the width and every run of the font, bidi,
+ * script and language iterators, along with the features. On a hit, the cached runs are replayed
+ * into the RunHandler without shaping. The least recently used results are evicted to keep the
+ * cache within about 'maxBytes'. The returned shaper is safe to use from several threads if the
+ * wrapped one is.
+ */
+SKSHAPER_API std::unique_ptr<SkShaper> Cached(std::unique_ptr<SkShaper> shaper, size_t maxBytes);
+
 SKSHAPER_API std::unique_ptr<SkShaper::BiDiRunIterator> TrivialBiDiRunIterator(size_t utf8Bytes,
                                                                                uint8_t bidiLevel);
 
@@ -8,13 +8,19 @@
 #ifndef SkShaper_harfbuzz_DEFINED
 #define SkShaper_harfbuzz_DEFINED
 
+#include "include/core/SkFont.h"
+#include "include/core/SkPoint.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "modules/skshaper/include/SkShaper.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
+class SkExecutor;
 class SkFontMgr;
 class SkUnicode;
 
@@ -33,6 +39,61 @@ SKSHAPER_API std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(cons
                                                                             SkFourByteTag script);
 
 SKSHAPER_API void PurgeCaches();
+
+// A string for ShapeBatch(). It is shaped as a single run, like a label or a table cell: with one
+// font, in one direction and without font fallback, bidi reordering or line wrapping.
+struct BatchItem {
+    const char* fUtf8 = nullptr;
+    size_t fUtf8Bytes = 0;
+    SkFont fFont;
+    bool fLeftToRight = true;
+    // The ISO 15924 script tag, or 0 to guess the script from the text.
+    SkFourByteTag fScript = 0;
+    // A BCP 47 language tag, or null for an undefined language.
+    const char* fLanguage = nullptr;
+};
+
+class ShapedBatch;
+// Shapes many short strings in one call. A HarfBuzz buffer and the HarfBuzz fonts are made once
+// and reused for all the strings, instead of once per string. With an executor, the items are
+// split into chunks which are shaped in parallel, each with its own HarfBuzz buffer and fonts.
+// The results are in the same order as the items either way.
+SKSHAPER_API ShapedBatch ShapeBatch(SkSpan<const BatchItem> items, SkExecutor* executor = nullptr);
+
+// The glyphs of every item of a batch, packed into arrays shared by all the items.
+class SKSHAPER_API ShapedBatch {
+public:
+    size_t count() const { return fItems.size(); }
+    size_t totalGlyphCount() const { return fGlyphs.size(); }
+
+    // An item's glyphs are in visual order, left to right. Their positions include the glyph
+    // offsets and are relative to the start of the item's baseline. The clusters are the UTF-8
+    // offsets into the item's text of the characters which each glyph came from.
+    SkSpan<const SkGlyphID> glyphs(size_t index) const {
+        return {fGlyphs.data() + fItems[index].fStart, fItems[index].fCount};
+    }
+    SkSpan<const SkPoint> positions(size_t index) const {
+        return {fPositions.data() + fItems[index].fStart, fItems[index].fCount};
+    }
+    SkSpan<const uint32_t> clusters(size_t index) const {
+        return {fClusters.data() + fItems[index].fStart, fItems[index].fCount};
+    }
+    SkVector advance(size_t index) const { return fItems[index].fAdvance; }
+
+private:
+    friend class BatchShaper;
+    friend ShapedBatch ShapeBatch(SkSpan<const BatchItem>, SkExecutor*);
+
+    struct Item {
+        size_t fStart;
+        size_t fCount;
+        SkVector fAdvance;
+    };
+    std::vector<Item> fItems;
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<uint32_t> fClusters;
+};
 }  // namespace SkShapers::HB
 
 #endif
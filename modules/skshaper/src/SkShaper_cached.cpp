@@ -0,0 +1,389 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkFont.h"
+#include "include/core/SkFontTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "modules/skshaper/include/SkShaper.h"
+#include "src/core/SkLRUCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace skia_private;
+
+namespace {
+
+// The runs an iterator yields, so they can be used in a cache key and then replayed into the
+// wrapped shaper on a cache miss.
+template <typename T>
+struct RecordedRun {
+    size_t fEnd;
+    T fValue;
+};
+
+template <typename T, typename Iterator, typename Current>
+TArray<RecordedRun<T>> record_runs(Iterator& iterator, Current&& current) {
+    TArray<RecordedRun<T>> runs;
+    while (!iterator.atEnd()) {
+        iterator.consume();
+        runs.push_back({iterator.endOfCurrentRun(), current(iterator)});
+    }
+    return runs;
+}
+
+template <typename T, typename Base>
+class ReplayRunIterator : public Base {
+public:
+    explicit ReplayRunIterator(const TArray<RecordedRun<T>>& runs) : fRuns(runs) {}
+    void consume() override { SkASSERT(!this->atEnd()); ++fCurrent; }
+    size_t endOfCurrentRun() const override { return fCurrent < 0 ? 0 : fRuns[fCurrent].fEnd; }
+    bool atEnd() const override { return fCurrent + 1 >= fRuns.size(); }
+
+protected:
+    const T& current() const { return fRuns[std::max(fCurrent, 0)].fValue; }
+
+private:
+    const TArray<RecordedRun<T>>& fRuns;
+    int fCurrent = -1;
+};
+
+class ReplayFontRunIterator final : public ReplayRunIterator<SkFont, SkShaper::FontRunIterator> {
+public:
+    using ReplayRunIterator::ReplayRunIterator;
+    const SkFont& currentFont() const override { return this->current(); }
+};
+class ReplayBiDiRunIterator final : public ReplayRunIterator<uint8_t, SkShaper::BiDiRunIterator> {
+public:
+    using ReplayRunIterator::ReplayRunIterator;
+    uint8_t currentLevel() const override { return this->current(); }
+};
+class ReplayScriptRunIterator final
+        : public ReplayRunIterator<SkFourByteTag, SkShaper::ScriptRunIterator> {
+public:
+    using ReplayRunIterator::ReplayRunIterator;
+    SkFourByteTag currentScript() const override { return this->current(); }
+};
+class ReplayLanguageRunIterator final
+        : public ReplayRunIterator<SkString, SkShaper::LanguageRunIterator> {
+public:
+    using ReplayRunIterator::ReplayRunIterator;
+    const char* currentLanguage() const override { return this->current().c_str(); }
+};
+
+// Everything a shaper told its RunHandler, in order.
+struct ShapedText : public SkNVRefCnt<ShapedText> {
+    enum class Event : uint8_t {
+        kBeginLine,
+        kRunInfo,
+        kCommitRunInfo,
+        kRunBuffer,
+        kCommitLine,
+    };
+    struct Run {
+        SkFont fFont;
+        uint8_t fBidiLevel;
+        SkVector fAdvance;
+        size_t fGlyphCount;
+        SkShaper::RunHandler::Range fUtf8Range;
+        size_t fGlyphStart;
+    };
+
+    // Each kRunInfo and kRunBuffer event has a run, in the same order.
+    std::vector<Event> fEvents;
+    std::vector<Run> fRuns;
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<SkPoint> fOffsets;
+    std::vector<uint32_t> fClusters;
+
+    size_t approximateBytes() const {
+        return sizeof(ShapedText) + fEvents.size() * sizeof(Event) + fRuns.size() * sizeof(Run) +
+               fGlyphs.size() * (sizeof(SkGlyphID) + 2 * sizeof(SkPoint) + sizeof(uint32_t));
+    }
+
+    void replay(SkShaper::RunHandler* handler) const {
+        size_t run = 0;
+        for (Event event : fEvents) {
+            switch (event) {
+                case Event::kBeginLine:
+                    handler->beginLine();
+                    break;
+                case Event::kRunInfo:
+                    handler->runInfo(this->info(fRuns[run++]));
+                    break;
+                case Event::kCommitRunInfo:
+                    handler->commitRunInfo();
+                    break;
+                case Event::kRunBuffer:
+                    this->fill(fRuns[run++], handler);
+                    break;
+                case Event::kCommitLine:
+                    handler->commitLine();
+                    break;
+            }
+        }
+    }
+
+private:
+    static SkShaper::RunHandler::RunInfo info(const Run& run) {
+        return {run.fFont, run.fBidiLevel, run.fAdvance, run.fGlyphCount, run.fUtf8Range};
+    }
+
+    void fill(const Run& run, SkShaper::RunHandler* handler) const {
+        const SkShaper::RunHandler::RunInfo info = this->info(run);
+        const SkShaper::RunHandler::Buffer buffer = handler->runBuffer(info);
+        for (size_t i = 0; i < run.fGlyphCount; ++i) {
+            const size_t glyph = run.fGlyphStart + i;
+            buffer.glyphs[i] = fGlyphs[glyph];
+            if (buffer.offsets) {
+                buffer.positions[i] = fPositions[glyph] + buffer.point;
+                buffer.offsets[i] = fOffsets[glyph];
+            } else {
+                buffer.positions[i] = fPositions[glyph] + fOffsets[glyph] + buffer.point;
+            }
+            if (buffer.clusters) {
+                buffer.clusters[i] = fClusters[glyph];
+            }
+        }
+        handler->commitRunBuffer(info);
+    }
+};
+
+// Records the output of a shaper. Its buffers ask for separate offsets, so that the runs can be
+// replayed into handlers which want them either way.
+class RecordingRunHandler final : public SkShaper::RunHandler {
+public:
+    explicit RecordingRunHandler(ShapedText* text) : fText(text) {}
+
+    void beginLine() override { fText->fEvents.push_back(ShapedText::Event::kBeginLine); }
+    void runInfo(const RunInfo& info) override {
+        fText->fEvents.push_back(ShapedText::Event::kRunInfo);
+        this->addRun(info);
+    }
+    void commitRunInfo() override { fText->fEvents.push_back(ShapedText::Event::kCommitRunInfo); }
+    Buffer runBuffer(const RunInfo& info) override {
+        const size_t start = this->addRun(info).fGlyphStart;
+        const size_t end = start + info.glyphCount;
+        fText->fGlyphs.resize(end);
+        fText->fPositions.resize(end);
+        fText->fOffsets.resize(end);
+        fText->fClusters.resize(end);
+        return {fText->fGlyphs.data() + start,
+                fText->fPositions.data() + start,
+                fText->fOffsets.data() + start,
+                fText->fClusters.data() + start,
+                {0, 0}};
+    }
+    void commitRunBuffer(const RunInfo&) override {
+        fText->fEvents.push_back(ShapedText::Event::kRunBuffer);
+    }
+    void commitLine() override { fText->fEvents.push_back(ShapedText::Event::kCommitLine); }
+
+private:
+    const ShapedText::Run& addRun(const RunInfo& info) {
+        fText->fRuns.push_back({info.fFont, info.fBidiLevel, info.fAdvance, info.glyphCount,
+                                info.utf8Range, fText->fGlyphs.size()});
+        return fText->fRuns.back();
+    }
+
+    ShapedText* fText;
+};
+
+template <typename T>
+void append_bytes(SkString* key, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value);
+    key->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void append_font(SkString* key, const SkFont& font) {
+    const SkTypeface* typeface = font.getTypeface();
+    append_bytes(key, typeface ? typeface->uniqueID() : SkTypefaceID(0));
+    append_bytes(key, font.getSize());
+    append_bytes(key, font.getScaleX());
+    append_bytes(key, font.getSkewX());
+    append_bytes(key, font.getEdging());
+    append_bytes(key, font.getHinting());
+    const uint8_t flags = (font.isForceAutoHinting() ? 1 << 0 : 0) |
+                          (font.isEmbeddedBitmaps()  ? 1 << 1 : 0) |
+                          (font.isSubpixel()         ? 1 << 2 : 0) |
+                          (font.isLinearMetrics()    ? 1 << 3 : 0) |
+                          (font.isEmbolden()         ? 1 << 4 : 0) |
+                          (font.isBaselineSnap()     ? 1 << 5 : 0);
+    append_bytes(key, flags);
+}
+
+class CachedShaper final : public SkShaper {
+public:
+    CachedShaper(std::unique_ptr<SkShaper> shaper, size_t maxBytes)
+            : fShaper(std::move(shaper))
+            , fMaxBytes(maxBytes)
+            , fCache(std::numeric_limits<int>::max()) {}
+
+private:
+#if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
+    // The wrapped shaper makes its own iterators for this one, so it isn't cached.
+    void shape(const char* utf8, size_t utf8Bytes,
+               const SkFont& srcFont,
+               bool leftToRight,
+               SkScalar width,
+               RunHandler* handler) const override {
+        fShaper->shape(utf8, utf8Bytes, srcFont, leftToRight, width, handler);
+    }
+
+    void shape(const char* utf8, size_t utf8Bytes,
+               FontRunIterator& font,
+               BiDiRunIterator& bidi,
+               ScriptRunIterator& script,
+               LanguageRunIterator& language,
+               SkScalar width,
+               RunHandler* handler) const override {
+        this->shape(utf8, utf8Bytes, font, bidi, script, language, nullptr, 0, width, handler);
+    }
+#endif
+
+    void shape(const char* utf8, size_t utf8Bytes,
+               FontRunIterator& font,
+               BiDiRunIterator& bidi,
+               ScriptRunIterator& script,
+               LanguageRunIterator& language,
+               const Feature* features, size_t featuresSize,
+               SkScalar width,
+               RunHandler* handler) const override {
+        // The iterators are consumed to build the key, which holds every input to the shaper.
+        auto fonts = record_runs<SkFont>(
+                font, [](const FontRunIterator& it) { return it.currentFont(); });
+        auto levels = record_runs<uint8_t>(
+                bidi, [](const BiDiRunIterator& it) { return it.currentLevel(); });
+        auto scripts = record_runs<SkFourByteTag>(
+                script, [](const ScriptRunIterator& it) { return it.currentScript(); });
+        auto languages = record_runs<SkString>(
+                language, [](const LanguageRunIterator& it) {
+                    return SkString(it.currentLanguage());
+                });
+
+        SkString key;
+        append_bytes(&key, utf8Bytes);
+        key.append(utf8, utf8Bytes);
+        append_bytes(&key, width);
+        append_bytes(&key, fonts.size());
+        for (const RecordedRun<SkFont>& run : fonts) {
+            append_bytes(&key, run.fEnd);
+            append_font(&key, run.fValue);
+        }
+        append_bytes(&key, levels.size());
+        for (const RecordedRun<uint8_t>& run : levels) {
+            append_bytes(&key, run.fEnd);
+            append_bytes(&key, run.fValue);
+        }
+        append_bytes(&key, scripts.size());
+        for (const RecordedRun<SkFourByteTag>& run : scripts) {
+            append_bytes(&key, run.fEnd);
+            append_bytes(&key, run.fValue);
+        }
+        append_bytes(&key, languages.size());
+        for (const RecordedRun<SkString>& run : languages) {
+            append_bytes(&key, run.fEnd);
+            append_bytes(&key, run.fValue.size());
+            key.append(run.fValue);
+        }
+        append_bytes(&key, featuresSize);
+        for (size_t i = 0; i < featuresSize; ++i) {
+            append_bytes(&key, features[i].tag);
+            append_bytes(&key, features[i].value);
+            append_bytes(&key, features[i].start);
+            append_bytes(&key, features[i].end);
+        }
+
+        sk_sp<const ShapedText> shaped;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            if (const std::unique_ptr<Entry>* entry = fCache.find(key)) {
+                shaped = (*entry)->fText;
+            }
+        }
+
+        if (!shaped) {
+            auto text = sk_make_sp<ShapedText>();
+            RecordingRunHandler recorder(text.get());
+            ReplayFontRunIterator fontReplay(fonts);
+            ReplayBiDiRunIterator bidiReplay(levels);
+            ReplayScriptRunIterator scriptReplay(scripts);
+            ReplayLanguageRunIterator languageReplay(languages);
+            fShaper->shape(utf8, utf8Bytes,
+                           fontReplay, bidiReplay, scriptReplay, languageReplay,
+                           features, featuresSize,
+                           width, &recorder);
+            shaped = text;
+            this->insert(key, std::move(text));
+        }
+
+        // Replaying happens outside of the lock, since the handler may take a while.
+        shaped->replay(handler);
+    }
+
+    struct Entry {
+        Entry(sk_sp<const ShapedText> text, size_t bytes, size_t* bytesUsed)
+                : fText(std::move(text)), fBytes(bytes), fBytesUsed(bytesUsed) {
+            *fBytesUsed += fBytes;
+        }
+        ~Entry() { *fBytesUsed -= fBytes; }
+
+        const sk_sp<const ShapedText> fText;
+        const size_t fBytes;
+        size_t* const fBytesUsed;
+    };
+
+    void insert(const SkString& key, sk_sp<const ShapedText> text) const {
+        const size_t bytes = key.size() + text->approximateBytes();
+        if (bytes > fMaxBytes) {
+            return;
+        }
+        SkAutoMutexExclusive lock(fMutex);
+        if (fCache.find(key)) {
+            // Another thread shaped the same text at the same time.
+            return;
+        }
+        while (fBytesUsed + bytes > fMaxBytes) {
+            fCache.removeLRU();
+        }
+        fCache.insert(key, std::make_unique<Entry>(std::move(text), bytes, &fBytesUsed));
+    }
+
+    const std::unique_ptr<SkShaper> fShaper;
+    const size_t fMaxBytes;
+
+    mutable SkMutex fMutex;
+    // Declared before the cache, which updates it as its entries are destroyed.
+    mutable size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+    mutable SkLRUCache<SkString, std::unique_ptr<Entry>> fCache SK_GUARDED_BY(fMutex);
+};
+
+}  // namespace
+
+namespace SkShapers {
+std::unique_ptr<SkShaper> Cached(std::unique_ptr<SkShaper> shaper, size_t maxBytes) {
+    if (!shaper) {
+        return nullptr;
+    }
+    return std::make_unique<CachedShaper>(std::move(shaper), maxBytes);
+}
+}  // namespace SkShapers
@@ -8,6 +8,7 @@
 #include "modules/skshaper/include/SkShaper_harfbuzz.h"
 
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontArguments.h"
 #include "include/core/SkFontMetrics.h"
@@ -35,6 +36,7 @@
 #include "src/base/SkTDPQueue.h"
 #include "src/base/SkUTF.h"
 #include "src/core/SkLRUCache.h"
+#include "src/core/SkTaskGroup.h"
 
 #if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
 #include "modules/skshaper/include/SkShaper_skunicode.h"
@@ -43,11 +45,13 @@
 #include <hb-ot.h>
 #include <hb.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -1511,4 +1515,145 @@ void PurgeCaches() {
     HBLockedFaceCache cache = get_hbFace_cache();
     cache.reset();
 }
+
+// Shapes the items of one chunk of a batch, with its own buffer and fonts.
+class BatchShaper {
+public:
+    BatchShaper() : fBuffer(hb_buffer_create())
+                  , fUndefinedLanguage(hb_language_from_string("und", -1)) {}
+
+    void shape(SkSpan<const BatchItem> items, ShapedBatch* result) {
+        result->fItems.reserve(result->fItems.size() + items.size());
+        for (const BatchItem& item : items) {
+            const size_t start = result->fGlyphs.size();
+            const SkVector advance = this->shape(item, result);
+            result->fItems.push_back({start, result->fGlyphs.size() - start, advance});
+        }
+    }
+
+private:
+    SkVector shape(const BatchItem& item, ShapedBatch* result) {
+        hb_font_t* hbFont = this->findFont(item.fFont);
+        if (!fBuffer || !hbFont || item.fUtf8Bytes == 0) {
+            return {0, 0};
+        }
+
+        hb_buffer_t* buffer = fBuffer.get();
+        SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
+        hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
+        hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
+        hb_buffer_add_utf8(buffer, item.fUtf8, item.fUtf8Bytes, 0, item.fUtf8Bytes);
+
+        hb_buffer_set_direction(buffer, item.fLeftToRight ? HB_DIRECTION_LTR : HB_DIRECTION_RTL);
+        if (item.fScript) {
+            hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)item.fScript));
+        }
+        // See ShaperHarfBuzz::shape() for why the language must never be HB_LANGUAGE_INVALID.
+        hb_language_t hbLanguage = item.fLanguage ? hb_language_from_string(item.fLanguage, -1)
+                                                  : HB_LANGUAGE_INVALID;
+        hb_buffer_set_language(buffer, hbLanguage != HB_LANGUAGE_INVALID ? hbLanguage
+                                                                         : fUndefinedLanguage);
+        hb_buffer_guess_segment_properties(buffer);
+
+        hb_shape(hbFont, buffer, nullptr, 0);
+        unsigned len = 0;
+        // HarfBuzz returns the glyphs of a run in visual order, even in an rtl run.
+        hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, &len);
+        hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
+
+        // Undo skhb_position with (1.0/(1<<16)) and scale as needed.
+        double SkScalarFromHBPosX = +(1.52587890625e-5) * item.fFont.getScaleX();
+        double SkScalarFromHBPosY = -(1.52587890625e-5);  // HarfBuzz y-up, Skia y-down
+        SkVector advance = {0, 0};
+        for (unsigned i = 0; i < len; i++) {
+            const SkVector offset = {SkScalar(pos[i].x_offset * SkScalarFromHBPosX),
+                                     SkScalar(pos[i].y_offset * SkScalarFromHBPosY)};
+            result->fGlyphs.push_back(SkTo<SkGlyphID>(info[i].codepoint));
+            result->fPositions.push_back(advance + offset);
+            result->fClusters.push_back(info[i].cluster);
+            advance += SkVector{SkScalar(pos[i].x_advance * SkScalarFromHBPosX),
+                                SkScalar(pos[i].y_advance * SkScalarFromHBPosY)};
+        }
+        return advance;
+    }
+
+    hb_font_t* findFont(const SkFont& font) {
+        // Batches rarely use more than a few fonts, and usually many items in a row share one.
+        for (int i = fFonts.size(); i-- > 0;) {
+            if (fFonts[i].first == font) {
+                return fFonts[i].second.get();
+            }
+        }
+
+        HBFont hbFont;
+        {
+            HBLockedFaceCache cache = get_hbFace_cache();
+            SkTypefaceID dataId = font.getTypeface()->uniqueID();
+            HBFont* typefaceFontCached = cache.find(dataId);
+            if (!typefaceFontCached) {
+                HBFont typefaceFont(create_typeface_hb_font(*font.getTypeface()));
+                typefaceFontCached = cache.insert(dataId, std::move(typefaceFont));
+            }
+            if (!*typefaceFontCached) {
+                return nullptr;
+            }
+            hbFont = create_sub_hb_font(font, *typefaceFontCached);
+        }
+        if (fFonts.size() == kMaxFonts) {
+            fFonts.removeShuffle(0);
+        }
+        fFonts.emplace_back(font, std::move(hbFont));
+        return fFonts.back().second.get();
+    }
+
+    static constexpr int kMaxFonts = 16;
+
+    HBBuffer fBuffer;
+    hb_language_t fUndefinedLanguage;
+    TArray<std::pair<SkFont, HBFont>> fFonts;
+};
+
+ShapedBatch ShapeBatch(SkSpan<const BatchItem> items, SkExecutor* executor) {
+    // Each task shapes enough items to make up for setting up its own HarfBuzz state.
+    static constexpr size_t kItemsPerTask = 64;
+
+    ShapedBatch result;
+    if (!executor || items.size() <= kItemsPerTask) {
+        BatchShaper().shape(items, &result);
+        return result;
+    }
+
+    const size_t taskCount = (items.size() + kItemsPerTask - 1) / kItemsPerTask;
+    std::vector<ShapedBatch> chunks(taskCount);
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(SkToInt(taskCount), [&](int task) {
+        BatchShaper().shape(items.subspan(task * kItemsPerTask,
+                                          std::min(kItemsPerTask,
+                                                   items.size() - task * kItemsPerTask)),
+                            &chunks[task]);
+    });
+    taskGroup.wait();
+
+    // Pack the chunks' glyphs into the result's arrays.
+    size_t glyphCount = 0;
+    for (const ShapedBatch& chunk : chunks) {
+        glyphCount += chunk.totalGlyphCount();
+    }
+    result.fItems.reserve(items.size());
+    result.fGlyphs.reserve(glyphCount);
+    result.fPositions.reserve(glyphCount);
+    result.fClusters.reserve(glyphCount);
+    for (const ShapedBatch& chunk : chunks) {
+        const size_t start = result.fGlyphs.size();
+        for (const ShapedBatch::Item& item : chunk.fItems) {
+            result.fItems.push_back({start + item.fStart, item.fCount, item.fAdvance});
+        }
+        result.fGlyphs.insert(result.fGlyphs.end(), chunk.fGlyphs.begin(), chunk.fGlyphs.end());
+        result.fPositions.insert(result.fPositions.end(),
+                                 chunk.fPositions.begin(), chunk.fPositions.end());
+        result.fClusters.insert(result.fClusters.end(),
+                                chunk.fClusters.begin(), chunk.fClusters.end());
+    }
+    return result;
+}
 }  // namespace SkShapers::HB
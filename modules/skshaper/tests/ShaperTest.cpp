@@ -4,11 +4,14 @@
 #include "tests/Test.h"
 
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkScalar.h"
 #include "include/core/SkSpan.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTo.h"
@@ -22,7 +25,9 @@
 
 #include <cinttypes>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 namespace {
 struct RunHandler final : public SkShaper::RunHandler {
@@ -228,3 +233,183 @@ SHAPER_TEST(myanmar)
 SHAPER_TEST(taitham)
 SHAPER_TEST(tamil)
 #undef SHAPER_TEST
+
+namespace {
+struct CollectingRunHandler final : public SkShaper::RunHandler {
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<uint32_t> fClusters;
+    SkVector fAdvance = {0, 0};
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        fGlyphs.resize(info.glyphCount);
+        fPositions.resize(info.glyphCount);
+        fClusters.resize(info.glyphCount);
+        fAdvance = info.fAdvance;
+        return {fGlyphs.data(), fPositions.data(), nullptr, fClusters.data(), {0, 0}};
+    }
+    void commitRunBuffer(const RunInfo&) override {}
+    void commitLine() override {}
+};
+}  // namespace
+
+DEF_TEST(Shaper_batch, r) {
+    auto shaper = SkShapers::HB::ShapeDontWrapOrReorder(SkUnicode::Make(), SkFontMgr::RefEmpty());
+    if (!shaper) {
+        ERRORF(r, "Could not create shaper.");
+        return;
+    }
+
+    constexpr SkFourByteTag latn = SkSetFourByteTag('l','a','t','n');
+    constexpr SkFourByteTag hebr = SkSetFourByteTag('h','e','b','r');
+    SkFont font = ToolUtils::DefaultFont();
+    SkFont bigFont = font.makeWithSize(font.getSize() * 2);
+
+    // Enough items for the executor to split them across several tasks.
+    std::vector<SkString> texts;
+    std::vector<SkShapers::HB::BatchItem> items;
+    for (int i = 0; i < 300; ++i) {
+        texts.push_back(i % 3 == 2 ? SkString("\u05E9\u05DC\u05D5\u05DD")
+                                   : SkStringPrintf("Cell %d: office waffle", i));
+    }
+    for (int i = 0; i < 300; ++i) {
+        SkShapers::HB::BatchItem item;
+        item.fUtf8 = texts[i].c_str();
+        item.fUtf8Bytes = texts[i].size();
+        item.fFont = i % 5 ? font : bigFont;
+        item.fLeftToRight = i % 3 != 2;
+        item.fScript = item.fLeftToRight ? latn : hebr;
+        item.fLanguage = "en-US";
+        items.push_back(item);
+    }
+    items[7].fUtf8Bytes = 0;
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    const SkShapers::HB::ShapedBatch serial = SkShapers::HB::ShapeBatch(items);
+    const SkShapers::HB::ShapedBatch parallel = SkShapers::HB::ShapeBatch(items, executor.get());
+    REPORTER_ASSERT(r, serial.count() == items.size());
+    REPORTER_ASSERT(r, parallel.count() == items.size());
+    REPORTER_ASSERT(r, serial.totalGlyphCount() == parallel.totalGlyphCount());
+    REPORTER_ASSERT(r, serial.glyphs(7).empty());
+
+    // Each item matches shaping it on its own.
+    for (size_t i = 0; i < items.size(); ++i) {
+        const SkShapers::HB::BatchItem& item = items[i];
+        CollectingRunHandler handler;
+        auto fontRuns = SkShaper::TrivialFontRunIterator(item.fFont, item.fUtf8Bytes);
+        auto bidi = SkShaper::TrivialBiDiRunIterator(item.fLeftToRight ? 0 : 1, item.fUtf8Bytes);
+        auto script = SkShaper::TrivialScriptRunIterator(item.fScript, item.fUtf8Bytes);
+        auto language = SkShaper::TrivialLanguageRunIterator(item.fLanguage, item.fUtf8Bytes);
+        shaper->shape(item.fUtf8, item.fUtf8Bytes, fontRuns, bidi, script, language,
+                      nullptr, 0, SK_ScalarInfinity, &handler);
+
+        for (const SkShapers::HB::ShapedBatch* batch : {&serial, &parallel}) {
+            REPORTER_ASSERT(r, batch->glyphs(i).size() == handler.fGlyphs.size(), "item %zu", i);
+            if (batch->glyphs(i).size() != handler.fGlyphs.size()) {
+                continue;
+            }
+            for (size_t g = 0; g < handler.fGlyphs.size(); ++g) {
+                REPORTER_ASSERT(r, batch->glyphs(i)[g] == handler.fGlyphs[g]);
+                REPORTER_ASSERT(r, batch->positions(i)[g] == handler.fPositions[g]);
+                REPORTER_ASSERT(r, batch->clusters(i)[g] == handler.fClusters[g]);
+            }
+            // The single run sums its advances in logical order, so rtl runs may round apart.
+            REPORTER_ASSERT(r, SkScalarNearlyEqual(batch->advance(i).fX, handler.fAdvance.fX),
+                            "item %zu", i);
+        }
+    }
+}
+
+namespace {
+// Counts the calls which reach the wrapped shaper.
+class CountingShaper final : public SkShaper {
+public:
+    explicit CountingShaper(std::unique_ptr<SkShaper> shaper) : fShaper(std::move(shaper)) {}
+    mutable int fShapeCount = 0;
+
+private:
+#if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
+    void shape(const char* utf8, size_t utf8Bytes, const SkFont& font, bool leftToRight,
+               SkScalar width, RunHandler* handler) const override {
+        ++fShapeCount;
+        fShaper->shape(utf8, utf8Bytes, font, leftToRight, width, handler);
+    }
+    void shape(const char* utf8, size_t utf8Bytes, FontRunIterator& font, BiDiRunIterator& bidi,
+               ScriptRunIterator& script, LanguageRunIterator& language, SkScalar width,
+               RunHandler* handler) const override {
+        this->shape(utf8, utf8Bytes, font, bidi, script, language, nullptr, 0, width, handler);
+    }
+#endif
+    void shape(const char* utf8, size_t utf8Bytes, FontRunIterator& font, BiDiRunIterator& bidi,
+               ScriptRunIterator& script, LanguageRunIterator& language,
+               const Feature* features, size_t featuresSize, SkScalar width,
+               RunHandler* handler) const override {
+        ++fShapeCount;
+        fShaper->shape(utf8, utf8Bytes, font, bidi, script, language, features, featuresSize,
+                       width, handler);
+    }
+
+    std::unique_ptr<SkShaper> fShaper;
+};
+
+void shape_trivially(const SkShaper* shaper, const char* utf8, const SkFont& font, SkScalar width,
+                     CollectingRunHandler* handler,
+                     const SkShaper::Feature* features = nullptr, size_t featuresSize = 0) {
+    const size_t utf8Bytes = strlen(utf8);
+    SkShaper::TrivialFontRunIterator fontRuns(font, utf8Bytes);
+    SkShaper::TrivialBiDiRunIterator bidi(0, utf8Bytes);
+    SkShaper::TrivialScriptRunIterator script(SkSetFourByteTag('l','a','t','n'), utf8Bytes);
+    SkShaper::TrivialLanguageRunIterator language("en-US", utf8Bytes);
+    shaper->shape(utf8, utf8Bytes, fontRuns, bidi, script, language, features, featuresSize,
+                  width, handler);
+}
+}  // namespace
+
+DEF_TEST(Shaper_cached, r) {
+    const char* kText = "Hello, cached world";
+    const SkFont font = ToolUtils::DefaultFont();
+
+    auto counting = std::make_unique<CountingShaper>(SkShapers::Primitive());
+    const CountingShaper* counter = counting.get();
+    std::unique_ptr<SkShaper> cached = SkShapers::Cached(std::move(counting), 1 << 20);
+
+    CollectingRunHandler expected;
+    shape_trivially(SkShapers::Primitive().get(), kText, font, 1000, &expected);
+    REPORTER_ASSERT(r, !expected.fGlyphs.empty());
+
+    // The second time, the runs are replayed from the cache.
+    for (int i = 0; i < 2; ++i) {
+        CollectingRunHandler handler;
+        shape_trivially(cached.get(), kText, font, 1000, &handler);
+        REPORTER_ASSERT(r, counter->fShapeCount == 1);
+        REPORTER_ASSERT(r, handler.fGlyphs == expected.fGlyphs);
+        REPORTER_ASSERT(r, handler.fPositions == expected.fPositions);
+        REPORTER_ASSERT(r, handler.fClusters == expected.fClusters);
+        REPORTER_ASSERT(r, handler.fAdvance == expected.fAdvance);
+    }
+
+    // Any other input misses.
+    CollectingRunHandler handler;
+    shape_trivially(cached.get(), kText, font, 50, &handler);
+    REPORTER_ASSERT(r, counter->fShapeCount == 2);
+    shape_trivially(cached.get(), kText, font.makeWithSize(font.getSize() + 1), 1000, &handler);
+    REPORTER_ASSERT(r, counter->fShapeCount == 3);
+    const SkShaper::Feature liga = {SkSetFourByteTag('l','i','g','a'), 0, 0, strlen(kText)};
+    shape_trivially(cached.get(), kText, font, 1000, &handler, &liga, 1);
+    REPORTER_ASSERT(r, counter->fShapeCount == 4);
+    shape_trivially(cached.get(), "Hello, cached world!", font, 1000, &handler);
+    REPORTER_ASSERT(r, counter->fShapeCount == 5);
+    shape_trivially(cached.get(), kText, font, 1000, &handler);
+    REPORTER_ASSERT(r, counter->fShapeCount == 5);
+
+    // Results which don't fit in the budget aren't kept.
+    auto tinyCounting = std::make_unique<CountingShaper>(SkShapers::Primitive());
+    const CountingShaper* tinyCounter = tinyCounting.get();
+    std::unique_ptr<SkShaper> tiny = SkShapers::Cached(std::move(tinyCounting), 16);
+    shape_trivially(tiny.get(), kText, font, 1000, &handler);
+    shape_trivially(tiny.get(), kText, font, 1000, &handler);
+    REPORTER_ASSERT(r, tinyCounter->fShapeCount == 2);
+}
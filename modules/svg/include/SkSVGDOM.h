@@ -11,12 +11,14 @@
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTemplates.h"
 #include "modules/skresources/include/SkResources.h"
 #include "modules/svg/include/SkSVGIDMapper.h"
 
 class SkCanvas;
 class SkDOM;
+class SkPicture;
 class SkStream;
 class SkSVGNode;
 struct SkSVGPresentationContext;
@@ -85,6 +87,16 @@ public:
 
     void render(SkCanvas*) const;
 
+    /**
+     * When enabled, render() records the DOM into an SkPicture the first time it is called and
+     * draws that picture on later calls, instead of walking the node tree again. The picture is
+     * re-recorded after the container size changes or any node is modified (through its setters,
+     * setAttribute() or appendChild()), and whenever findNodeById() hands out a node.
+     *
+     * Disabled by default.
+     */
+    void setRenderCaching(bool);
+
     /** Render the node with the given id as if it were the only child of the root. */
     void renderNode(SkCanvas*, SkSVGPresentationContext&, const char* id) const;
 
@@ -92,12 +104,19 @@ private:
     SkSVGDOM(sk_sp<SkSVGSVG>, sk_sp<SkFontMgr>, sk_sp<skresources::ResourceProvider>,
              SkSVGIDMapper&&);
 
+    void purgeRenderCache();
+
     const sk_sp<SkSVGSVG>                      fRoot;
     const sk_sp<SkFontMgr>                     fFontMgr;
     const sk_sp<skresources::ResourceProvider> fResourceProvider;
     const SkSVGIDMapper                        fIDMapper;
 
     SkSize                 fContainerSize;
+
+    bool                     fRenderCaching = false;
+    mutable SkMutex          fCacheMutex;
+    mutable sk_sp<SkPicture> fCachedRender SK_GUARDED_BY(fCacheMutex);
+    mutable uint32_t         fCachedMutationID SK_GUARDED_BY(fCacheMutex) = 0;
 };
 
 #endif // SkSVGDOM_DEFINED
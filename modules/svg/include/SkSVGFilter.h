@@ -8,6 +8,9 @@
 #ifndef SkSVGFilter_DEFINED
 #define SkSVGFilter_DEFINED
 
+#include "include/core/SkRect.h"
+#include "include/core/SkSize.h"
+#include "include/private/base/SkMutex.h"
 #include "modules/svg/include/SkSVGHiddenContainer.h"
 #include "modules/svg/include/SkSVGTypes.h"
 
@@ -33,6 +36,27 @@ private:
 
     bool parseAndSetAttribute(const char*, const char*) override;
 
+    sk_sp<SkImageFilter> onBuildFilterDAG(const SkSVGRenderContext&) const;
+
+    // Everything outside the filter's subtree that the built DAG depends on. feImage can render
+    // arbitrary content, so filters using it are never cached.
+    struct DAGKey {
+        uint32_t        fMutationID;
+        SkRect          fRegion;
+        SkRect          fObjectBoundingBox;
+        SkSize          fViewport;
+        SkSVGColorType  fColor;
+        SkSVGColorspace fColorInterpolationFilters;
+
+        bool operator==(const DAGKey&) const;
+    };
+
+    // The most recently built DAG, reused while its key still matches.
+    mutable SkMutex              fDAGMutex;
+    mutable DAGKey               fCachedDAGKey SK_GUARDED_BY(fDAGMutex);
+    mutable sk_sp<SkImageFilter> fCachedDAG SK_GUARDED_BY(fDAGMutex);
+    mutable bool                 fHasCachedDAG SK_GUARDED_BY(fDAGMutex) = false;
+
     using INHERITED = SkSVGHiddenContainer;
 };
 
@@ -81,6 +81,7 @@ public:                                                                      \
         } else {                                                             \
             dest->set(SkSVGPropertyState::kInherit);                         \
         }                                                                    \
+        Invalidate();                                                        \
     }                                                                        \
     void set##attr_name(SkSVGProperty<attr_type, attr_inherited>&& v) {      \
         auto* dest = &fPresentationAttributes.f##attr_name;                  \
@@ -90,6 +91,7 @@ public:                                                                      \
         } else {                                                             \
             dest->set(SkSVGPropertyState::kInherit);                         \
         }                                                                    \
+        Invalidate();                                                        \
     }
 
 class SK_API SkSVGNode : public SkRefCnt {
@@ -111,6 +113,12 @@ public:
     // TODO: consolidate with existing setAttribute
     virtual bool parseAndSetAttribute(const char* name, const char* value);
 
+    /**
+     * Returns a value that changes whenever the attributes or children of any node are modified.
+     * SkSVGDOM compares it across render() calls to tell when a cached rendering is stale.
+     */
+    static uint32_t MutationID();
+
     // inherited
     SVG_PRES_ATTR(ClipRule                 , SkSVGFillRule  , true)
     SVG_PRES_ATTR(Color                    , SkSVGColorType , true)
@@ -149,6 +157,10 @@ public:
 protected:
     SkSVGNode(SkSVGTag);
 
+    // Marks the rendering of every DOM as potentially changed. Attribute setters and
+    // appendChild() implementations call this after modifying a node.
+    static void Invalidate();
+
     static SkMatrix ComputeViewboxMatrix(const SkRect&, const SkRect&, SkSVGPreserveAspectRatio);
 
     // Called before onRender(), to apply local attributes to the context.  Unlike onRender(),
@@ -197,8 +209,8 @@ private:
             return pr.isValid();                                              \
         }                                                                     \
     public:                                                                   \
-        void set##attr_name(const attr_type& a) { set_cp(a); }                \
-        void set##attr_name(attr_type&& a) { set_mv(std::move(a)); }
+        void set##attr_name(const attr_type& a) { set_cp(a); Invalidate(); } \
+        void set##attr_name(attr_type&& a) { set_mv(std::move(a)); Invalidate(); }
 
 #define SVG_ATTR(attr_name, attr_type, attr_default)                        \
     private:                                                                \
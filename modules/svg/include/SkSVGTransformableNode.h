@@ -13,7 +13,7 @@
 
 class SK_API SkSVGTransformableNode : public SkSVGNode {
 public:
-    void setTransform(const SkSVGTransformType& t) { fTransform = t; }
+    void setTransform(const SkSVGTransformType& t) { fTransform = t; Invalidate(); }
 
 protected:
     SkSVGTransformableNode(SkSVGTag);
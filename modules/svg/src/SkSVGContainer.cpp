@@ -15,6 +15,7 @@ SkSVGContainer::SkSVGContainer(SkSVGTag t) : INHERITED(t) { }
 void SkSVGContainer::appendChild(sk_sp<SkSVGNode> node) {
     SkASSERT(node);
     fChildren.push_back(std::move(node));
+    Invalidate();
 }
 
 bool SkSVGContainer::hasChildren() const {
@@ -7,7 +7,10 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkString.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
 #include "modules/svg/include/SkSVGAttributeParser.h"
 #include "modules/svg/include/SkSVGCircle.h"
@@ -47,8 +50,9 @@
 #include "modules/svg/include/SkSVGUse.h"
 #include "modules/svg/include/SkSVGValue.h"
 #include "src/base/SkTSearch.h"
+#include "src/core/SkRectPriv.h"
 #include "src/core/SkTraceEvent.h"
-#include "src/xml/SkDOM.h"
+#include "src/xml/SkXMLParser.h"
 
 namespace {
 
@@ -275,15 +279,6 @@ SortedDictionaryEntry<sk_sp<SkSVGNode>(*)()> gTagFactories[] = {
     { "use"               , []() -> sk_sp<SkSVGNode> { return SkSVGUse::Make();                }},
 };
 
-struct ConstructionContext {
-    ConstructionContext(SkSVGIDMapper* mapper) : fParent(nullptr), fIDMapper(mapper) {}
-    ConstructionContext(const ConstructionContext& other, const sk_sp<SkSVGNode>& newParent)
-        : fParent(newParent.get()), fIDMapper(other.fIDMapper) {}
-
-    SkSVGNode*     fParent;
-    SkSVGIDMapper* fIDMapper;
-};
-
 bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const char* value) {
     if (node->parseAndSetAttribute(name, value)) {
         // Handled by new code path
@@ -312,76 +307,99 @@ bool set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const
     return true;
 }
 
-void parse_node_attributes(const SkDOM& xmlDom, const SkDOM::Node* xmlNode,
-                           const sk_sp<SkSVGNode>& svgNode, SkSVGIDMapper* mapper) {
-    const char* name, *value;
-    SkDOM::AttrIter attrIter(xmlDom, xmlNode);
-    while ((name = attrIter.next(&value))) {
-        // We're handling id attributes out of band for now.
-        if (!strcmp(name, "id")) {
-            mapper->set(SkString(value), svgNode);
-            continue;
-        }
-        set_string_attribute(svgNode, name, value);
+void parse_node_attribute(const sk_sp<SkSVGNode>& svgNode, const char* name, const char* value,
+                          SkSVGIDMapper* mapper) {
+    // We're handling id attributes out of band for now.
+    if (!strcmp(name, "id")) {
+        mapper->set(SkString(value), svgNode);
+        return;
     }
+    set_string_attribute(svgNode, name, value);
 }
 
-sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext& ctx,
-                                    const SkDOM::Node* xmlNode) {
-    const char* elem = dom.getName(xmlNode);
-    const SkDOM::Type elemType = dom.getType(xmlNode);
-
-    if (elemType == SkDOM::kText_Type) {
-        // Text literals require special handling.
-        SkASSERT(dom.countChildren(xmlNode) == 0);
-        auto txt = SkSVGTextLiteral::Make();
-        txt->setText(SkString(dom.getName(xmlNode)));
-        ctx.fParent->appendChild(std::move(txt));
+sk_sp<SkSVGNode> make_node(const char* elem, bool isRoot) {
+    if (strcmp(elem, "svg") == 0) {
+        // Outermost SVG element must be tagged as such.
+        return SkSVGSVG::Make(isRoot ? SkSVGSVG::Type::kRoot
+                                     : SkSVGSVG::Type::kInner);
+    }
 
+    const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
+                                     SkTo<int>(std::size(gTagFactories)),
+                                     elem, sizeof(gTagFactories[0]));
+    if (tagIndex < 0) {
+#if defined(SK_VERBOSE_SVG_PARSING)
+        SkDebugf("unhandled element: <%s>\n", elem);
+#endif
         return nullptr;
     }
+    SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
 
-    SkASSERT(elemType == SkDOM::kElement_Type);
+    return gTagFactories[tagIndex].fValue();
+}
 
-    auto make_node = [](const ConstructionContext& ctx, const char* elem) -> sk_sp<SkSVGNode> {
-        if (strcmp(elem, "svg") == 0) {
-            // Outermost SVG element must be tagged as such.
-            return SkSVGSVG::Make(ctx.fParent ? SkSVGSVG::Type::kInner
-                                              : SkSVGSVG::Type::kRoot);
-        }
+// Builds the SVG node tree directly from the XML parser events, so the document is never held
+// as a generic XML DOM: memory is bounded by the SVG nodes plus the parser's input buffer.
+class SVGTreeBuilder final : public SkXMLParser {
+public:
+    explicit SVGTreeBuilder(SkSVGIDMapper* mapper) : SkXMLParser(&fParserError), fIDMapper(mapper) {}
 
-        const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
-                                         SkTo<int>(std::size(gTagFactories)),
-                                         elem, sizeof(gTagFactories[0]));
-        if (tagIndex < 0) {
-#if defined(SK_VERBOSE_SVG_PARSING)
-            SkDebugf("unhandled element: <%s>\n", elem);
-#endif
-            return nullptr;
-        }
-        SkASSERT(SkTo<size_t>(tagIndex) < std::size(gTagFactories));
+    sk_sp<SkSVGNode> takeRoot() { return std::move(fRoot); }
 
-        return gTagFactories[tagIndex].fValue();
-    };
+private:
+    bool onStartElement(const char elem[]) override {
+        sk_sp<SkSVGNode> node;
+        if (fSkipDepth == 0) {
+            node = make_node(elem, fParents.empty());
+        }
+        if (!node) {
+            // Unhandled elements are dropped along with their whole subtree.
+            fSkipDepth++;
+            return false;
+        }
+        fParents.push_back(std::move(node));
+        return false;
+    }
 
-    auto node = make_node(ctx, elem);
-    if (!node) {
-        return nullptr;
+    bool onAddAttribute(const char name[], const char value[]) override {
+        if (fSkipDepth == 0) {
+            parse_node_attribute(fParents.back(), name, value, fIDMapper);
+        }
+        return false;
     }
 
-    parse_node_attributes(dom, xmlNode, node, ctx.fIDMapper);
+    bool onEndElement(const char[]) override {
+        if (fSkipDepth > 0) {
+            fSkipDepth--;
+            return false;
+        }
+        // Children are appended once complete, matching the order they close in the document.
+        sk_sp<SkSVGNode> node = std::move(fParents.back());
+        fParents.pop_back();
+        if (fParents.empty()) {
+            fRoot = std::move(node);
+        } else {
+            fParents.back()->appendChild(std::move(node));
+        }
+        return false;
+    }
 
-    ConstructionContext localCtx(ctx, node);
-    for (auto* child = dom.getFirstChild(xmlNode, nullptr); child;
-         child = dom.getNextSibling(child)) {
-        sk_sp<SkSVGNode> childNode = construct_svg_node(dom, localCtx, child);
-        if (childNode) {
-            node->appendChild(std::move(childNode));
+    bool onText(const char text[], int len) override {
+        if (fSkipDepth == 0 && !fParents.empty()) {
+            // Text literals require special handling.
+            auto txt = SkSVGTextLiteral::Make();
+            txt->setText(SkString(text, SkTo<size_t>(len)));
+            fParents.back()->appendChild(std::move(txt));
         }
+        return false;
     }
 
-    return node;
-}
+    SkXMLParserError                       fParserError;
+    SkSVGIDMapper*                         fIDMapper;
+    skia_private::TArray<sk_sp<SkSVGNode>> fParents;
+    sk_sp<SkSVGNode>                       fRoot;
+    int                                    fSkipDepth = 0;
+};
 
 } // anonymous namespace
 
@@ -397,15 +415,13 @@ SkSVGDOM::Builder& SkSVGDOM::Builder::setResourceProvider(sk_sp<skresources::Res
 
 sk_sp<SkSVGDOM> SkSVGDOM::Builder::make(SkStream& str) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
-    SkDOM xmlDom;
-    if (!xmlDom.build(str)) {
+    SkSVGIDMapper mapper;
+    SVGTreeBuilder builder(&mapper);
+    if (!builder.parse(str)) {
         return nullptr;
     }
 
-    SkSVGIDMapper mapper;
-    ConstructionContext ctx(&mapper);
-
-    auto root = construct_svg_node(xmlDom, ctx, xmlDom.getRootNode());
+    auto root = builder.takeRoot();
     if (!root || root->tag() != SkSVGTag::kSvg) {
         return nullptr;
     }
@@ -435,6 +451,24 @@ SkSVGDOM::SkSVGDOM(sk_sp<SkSVGSVG> root, sk_sp<SkFontMgr> fmgr,
 
 void SkSVGDOM::render(SkCanvas* canvas) const {
     TRACE_EVENT0("skia", TRACE_FUNC);
+    if (fRoot && fRenderCaching) {
+        SkAutoMutexExclusive lock(fCacheMutex);
+        const uint32_t mutationID = SkSVGNode::MutationID();
+        if (!fCachedRender || fCachedMutationID != mutationID) {
+            // SVG content may draw outside the container, so don't let the cull rect clip it.
+            SkPictureRecorder recorder;
+            SkSVGLengthContext       lctx(fContainerSize);
+            SkSVGPresentationContext pctx;
+            fRoot->render(SkSVGRenderContext(recorder.beginRecording(SkRectPriv::MakeLargeS32()),
+                                             fFontMgr, fResourceProvider, fIDMapper, lctx, pctx,
+                                             {nullptr, nullptr}));
+            fCachedRender = recorder.finishRecordingAsPicture();
+            fCachedMutationID = mutationID;
+        }
+        canvas->drawPicture(fCachedRender);
+        return;
+    }
+
     if (fRoot) {
         SkSVGLengthContext       lctx(fContainerSize);
         SkSVGPresentationContext pctx;
@@ -459,11 +493,23 @@ const SkSize& SkSVGDOM::containerSize() const {
 }
 
 void SkSVGDOM::setContainerSize(const SkSize& containerSize) {
-    // TODO: inval
     fContainerSize = containerSize;
+    this->purgeRenderCache();
+}
+
+void SkSVGDOM::setRenderCaching(bool enabled) {
+    fRenderCaching = enabled;
+    this->purgeRenderCache();
+}
+
+void SkSVGDOM::purgeRenderCache() {
+    SkAutoMutexExclusive lock(fCacheMutex);
+    fCachedRender.reset();
 }
 
 sk_sp<SkSVGNode>* SkSVGDOM::findNodeById(const char* id) {
+    // The caller may modify or replace the node without going through its setters.
+    this->purgeRenderCache();
     SkString idStr(id);
     return this->fIDMapper.find(idStr);
 }
@@ -25,7 +25,44 @@ bool SkSVGFilter::parseAndSetAttribute(const char* name, const char* value) {
                    "primitiveUnits", name, value));
 }
 
+bool SkSVGFilter::DAGKey::operator==(const DAGKey& other) const {
+    return fMutationID == other.fMutationID &&
+           fRegion == other.fRegion &&
+           fObjectBoundingBox == other.fObjectBoundingBox &&
+           fViewport == other.fViewport &&
+           fColor == other.fColor &&
+           fColorInterpolationFilters == other.fColorInterpolationFilters;
+}
+
 sk_sp<SkImageFilter> SkSVGFilter::buildFilterDAG(const SkSVGRenderContext& ctx) const {
+    for (const auto& child : fChildren) {
+        if (child->tag() == SkSVGTag::kFeImage) {
+            return this->onBuildFilterDAG(ctx);
+        }
+    }
+
+    const auto obb = ctx.transformForCurrentOBB(SkSVGObjectBoundingBoxUnits(
+            SkSVGObjectBoundingBoxUnits::Type::kObjectBoundingBox));
+    const auto& inherited = ctx.presentationContext().fInherited;
+    const DAGKey key = {
+        SkSVGNode::MutationID(),
+        ctx.resolveOBBRect(fX, fY, fWidth, fHeight, fFilterUnits),
+        SkRect::MakeXYWH(obb.offset.x, obb.offset.y, obb.scale.x, obb.scale.y),
+        ctx.lengthContext().viewPort(),
+        *inherited.fColor,
+        *inherited.fColorInterpolationFilters,
+    };
+
+    SkAutoMutexExclusive lock(fDAGMutex);
+    if (!fHasCachedDAG || !(fCachedDAGKey == key)) {
+        fCachedDAG = this->onBuildFilterDAG(ctx);
+        fCachedDAGKey = key;
+        fHasCachedDAG = true;
+    }
+    return fCachedDAG;
+}
+
+sk_sp<SkImageFilter> SkSVGFilter::onBuildFilterDAG(const SkSVGRenderContext& ctx) const {
     sk_sp<SkImageFilter> filter;
     SkSVGFilterContext fctx(ctx.resolveOBBRect(fX, fY, fWidth, fHeight, fFilterUnits),
                             fPrimitiveUnits);
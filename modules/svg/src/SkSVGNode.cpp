@@ -14,6 +14,8 @@
 #include "modules/svg/include/SkSVGValue.h"
 #include "src/base/SkTLazy.h"
 
+#include <atomic>
+
 SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) {
     // Uninherited presentation attributes need a non-null default value.
     fPresentationAttributes.fStopColor.set(SkSVGColor(SK_ColorBLACK));
@@ -25,6 +27,16 @@ SkSVGNode::SkSVGNode(SkSVGTag t) : fTag(t) {
 
 SkSVGNode::~SkSVGNode() { }
 
+static std::atomic<uint32_t> gMutationID{0};
+
+uint32_t SkSVGNode::MutationID() {
+    return gMutationID.load(std::memory_order_acquire);
+}
+
+void SkSVGNode::Invalidate() {
+    gMutationID.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void SkSVGNode::render(const SkSVGRenderContext& ctx) const {
     SkSVGRenderContext localContext(ctx, this);
 
@@ -74,6 +86,7 @@ bool SkSVGNode::onPrepareToRender(SkSVGRenderContext* ctx) const {
 
 void SkSVGNode::setAttribute(SkSVGAttribute attr, const SkSVGValue& v) {
     this->onSetAttribute(attr, v);
+    Invalidate();
 }
 
 template <typename T>
@@ -573,6 +573,7 @@ void SkSVGTextContainer::appendChild(sk_sp<SkSVGNode> child) {
     case SkSVGTag::kTSpan:
         fChildren.push_back(
             sk_sp<SkSVGTextFragment>(static_cast<SkSVGTextFragment*>(child.release())));
+        Invalidate();
         break;
     default:
         break;
@@ -7,6 +7,8 @@
 
 #include <string>
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkStream.h"
 #include "include/utils/SkNoDrawCanvas.h"
 #include "modules/svg/include/SkSVGDOM.h"
@@ -32,3 +34,36 @@ DEF_TEST(Svg_Filters_NonePaintInputs, r) {
     SkNoDrawCanvas canvas(500, 500);
     svg_dom->render(&canvas);
 }
+
+DEF_TEST(Svg_Filters_CachedDAG, r) {
+    // Two shapes share a filter that floods with currentColor. The cached DAG must not leak one
+    // shape's color into the other, nor survive a change to the filter.
+    const std::string svgText = R"EOF(
+    <svg width="20" height="10" xmlns="http://www.w3.org/2000/svg">
+        <filter id="f" x="0" y="0" width="1" height="1">
+            <feFlood id="flood" flood-color="currentColor"/>
+        </filter>
+        <rect color="red"  filter="url(#f)" x="0"  y="0" width="10" height="10"/>
+        <rect color="blue" filter="url(#f)" x="10" y="0" width="10" height="10"/>
+    </svg>
+    )EOF";
+
+    auto str = SkMemoryStream::MakeDirect(svgText.c_str(), svgText.size());
+    auto dom = SkSVGDOM::MakeFromStream(*str);
+
+    SkBitmap bm;
+    bm.allocN32Pixels(20, 10);
+    SkCanvas canvas(bm);
+    for (int i = 0; i < 2; ++i) {
+        bm.eraseColor(SK_ColorTRANSPARENT);
+        dom->render(&canvas);
+        REPORTER_ASSERT(r, bm.getColor( 5, 5) == SK_ColorRED);
+        REPORTER_ASSERT(r, bm.getColor(15, 5) == SK_ColorBLUE);
+    }
+
+    (*dom->findNodeById("flood"))->setAttribute("flood-color", "black");
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    dom->render(&canvas);
+    REPORTER_ASSERT(r, bm.getColor( 5, 5) == SK_ColorBLACK);
+    REPORTER_ASSERT(r, bm.getColor(15, 5) == SK_ColorBLACK);
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+DEF_TEST(Svg_Parse, r) {
+    // The tree is built straight from the XML parser's events: unhandled elements are dropped with
+    // their subtrees, while their siblings, nested <svg>s and ids are kept.
+    static constexpr char kSVG[] =
+            "<svg xmlns='http://www.w3.org/2000/svg' width='30' height='10'>"
+            "  <unknown><rect id='hidden' width='10' height='10' fill='red'/></unknown>"
+            "  <g><rect id='left' width='10' height='10' fill='blue'/></g>"
+            "  <svg x='20' width='10' height='10'>"
+            "    <rect id='right' width='10' height='10' fill='green'/>"
+            "  </svg>"
+            "</svg>";
+    SkMemoryStream stream(kSVG, strlen(kSVG));
+    sk_sp<SkSVGDOM> dom = SkSVGDOM::MakeFromStream(stream);
+    REPORTER_ASSERT(r, dom);
+
+    REPORTER_ASSERT(r, !dom->findNodeById("hidden"));
+    REPORTER_ASSERT(r, dom->findNodeById("left"));
+    REPORTER_ASSERT(r, dom->findNodeById("right"));
+
+    SkBitmap bm;
+    bm.allocN32Pixels(30, 10);
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(bm);
+    dom->render(&canvas);
+    REPORTER_ASSERT(r, bm.getColor( 5, 5) == SK_ColorBLUE);
+    REPORTER_ASSERT(r, bm.getColor(15, 5) == SK_ColorTRANSPARENT);
+    REPORTER_ASSERT(r, bm.getColor(25, 5) == 0xff008000);  // SVG's green is #008000.
+
+    static constexpr char kMalformed[] = "<svg xmlns='http://www.w3.org/2000/svg'><g></svg>";
+    SkMemoryStream malformed(kMalformed, strlen(kMalformed));
+    REPORTER_ASSERT(r, !SkSVGDOM::MakeFromStream(malformed));
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkStream.h"
+#include "modules/svg/include/SkSVGDOM.h"
+#include "modules/svg/include/SkSVGNode.h"
+#include "modules/svg/include/SkSVGRect.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+DEF_TEST(Svg_RenderCache, r) {
+    static constexpr char kSVG[] =
+            "<svg xmlns='http://www.w3.org/2000/svg' width='10' height='10'>"
+            "  <rect id='r' width='10' height='10' fill='red'/>"
+            "</svg>";
+    SkMemoryStream stream(kSVG, strlen(kSVG));
+    sk_sp<SkSVGDOM> dom = SkSVGDOM::MakeFromStream(stream);
+    REPORTER_ASSERT(r, dom);
+    dom->setRenderCaching(true);
+
+    auto renderCenter = [&]() {
+        SkBitmap bm;
+        bm.allocN32Pixels(10, 10);
+        bm.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bm);
+        dom->render(&canvas);
+        return bm.getColor(5, 5);
+    };
+
+    REPORTER_ASSERT(r, renderCenter() == SK_ColorRED);
+    // Rendering again plays back the cached picture.
+    REPORTER_ASSERT(r, renderCenter() == SK_ColorRED);
+
+    // Modifying a node invalidates the cache.
+    sk_sp<SkSVGNode>* node = dom->findNodeById("r");
+    REPORTER_ASSERT(r, node && (*node)->tag() == SkSVGTag::kRect);
+    REPORTER_ASSERT(r, renderCenter() == SK_ColorRED);
+    (*node)->setAttribute("fill", "blue");
+    REPORTER_ASSERT(r, renderCenter() == SK_ColorBLUE);
+
+    static_cast<SkSVGRect*>(node->get())->setWidth(SkSVGLength(4));
+    REPORTER_ASSERT(r, renderCenter() == SK_ColorTRANSPARENT);
+}
@@ -58,6 +58,7 @@ SKIA_PUBLIC_HDRS = [
     "include/core/SkFontParameters.h",
     "include/core/SkFontStyle.h",
     "include/core/SkFontTypes.h",
+    "include/core/SkGlyphPersistentCache.h",
     "include/core/SkGraphics.h",
     "include/core/SkImage.h",
     "include/core/SkImageFilter.h",
@@ -144,6 +145,7 @@ SKIA_PUBLIC_HDRS = [
     "include/gpu/d3d/GrD3DBackendContext.h",
     "include/gpu/d3d/GrD3DTypes.h",
     "include/gpu/ganesh/GrExternalTextureGenerator.h",
+    "include/gpu/ganesh/GrStreamingReadback.h",
     "include/gpu/ganesh/SkImageGanesh.h",
     "include/gpu/ganesh/SkMeshGanesh.h",
     "include/gpu/ganesh/SkSurfaceGanesh.h",
@@ -218,8 +220,10 @@ SKIA_PUBLIC_HDRS = [
     "include/utils/SkPaintFilterCanvas.h",
     "include/utils/SkParse.h",
     "include/utils/SkParsePath.h",
+    "include/utils/SkPictureDamage.h",
     "include/utils/SkShadowUtils.h",
     "include/utils/SkTextUtils.h",
+    "include/utils/SkTiledImage.h",
     "include/utils/SkTraceEventPhase.h",
     "include/utils/mac/SkCGUtils.h",
 ]
@@ -435,6 +439,7 @@ BASE_SRCS_ALL = [
     "src/core/SkConvertPixels.cpp",
     "src/core/SkConvertPixels.h",
     "src/core/SkCoreBlitters.h",
+    "src/core/SkCounters.h",
     "src/core/SkCpu.cpp",
     "src/core/SkCpu.h",
     "src/core/SkCubicClipper.cpp",
@@ -476,6 +481,8 @@ BASE_SRCS_ALL = [
     "src/core/SkFont.cpp",
     "src/core/SkFontDescriptor.cpp",
     "src/core/SkFontDescriptor.h",
+    "src/core/SkFontFallbackCache.cpp",
+    "src/core/SkFontFallbackCache.h",
     "src/core/SkFontMetricsPriv.cpp",
     "src/core/SkFontMetricsPriv.h",
     "src/core/SkFontMgr.cpp",
@@ -491,6 +498,7 @@ BASE_SRCS_ALL = [
     "src/core/SkGlobalInitialization_core.cpp",
     "src/core/SkGlyph.cpp",
     "src/core/SkGlyph.h",
+    "src/core/SkGlyphPersistentCache.cpp",
     "src/core/SkGlyphRunPainter.cpp",
     "src/core/SkGlyphRunPainter.h",
     "src/core/SkGraphics.cpp",
@@ -650,9 +658,11 @@ BASE_SRCS_ALL = [
     "src/core/SkScanPriv.h",
     "src/core/SkScan_AAAPath.cpp",
     "src/core/SkScan_AntiPath.cpp",
+    "src/core/SkScan_AntiRRect.cpp",
     "src/core/SkScan_Antihair.cpp",
     "src/core/SkScan_Hairline.cpp",
     "src/core/SkScan_Path.cpp",
+    "src/core/SkScan_SparseAAPath.cpp",
     "src/core/SkSpecialImage.cpp",
     "src/core/SkSpecialImage.h",
     "src/core/SkSpriteBlitter.h",
@@ -985,6 +995,7 @@ BASE_SRCS_ALL = [
     "src/gpu/ganesh/GrStagingBufferManager.h",
     "src/gpu/ganesh/GrStencilSettings.cpp",
     "src/gpu/ganesh/GrStencilSettings.h",
+    "src/gpu/ganesh/GrStreamingReadback.cpp",
     "src/gpu/ganesh/GrStyle.cpp",
     "src/gpu/ganesh/GrStyle.h",
     "src/gpu/ganesh/GrSurface.cpp",
@@ -1673,6 +1684,7 @@ BASE_SRCS_ALL = [
     "src/sksl/tracing/SkSLTraceHook.cpp",
     "src/sksl/tracing/SkSLTraceHook.h",
     "src/sksl/transform/SkSLAddConstToVarModifiers.cpp",
+    "src/sksl/transform/SkSLEliminateCommonSubexpressions.cpp",
     "src/sksl/transform/SkSLEliminateDeadFunctions.cpp",
     "src/sksl/transform/SkSLEliminateDeadGlobalVariables.cpp",
     "src/sksl/transform/SkSLEliminateDeadLocalVariables.cpp",
@@ -1681,6 +1693,7 @@ BASE_SRCS_ALL = [
     "src/sksl/transform/SkSLFindAndDeclareBuiltinFunctions.cpp",
     "src/sksl/transform/SkSLFindAndDeclareBuiltinStructs.cpp",
     "src/sksl/transform/SkSLFindAndDeclareBuiltinVariables.cpp",
+    "src/sksl/transform/SkSLHoistLoopInvariants.cpp",
     "src/sksl/transform/SkSLHoistSwitchVarDeclarationsAtTopLevel.cpp",
     "src/sksl/transform/SkSLProgramWriter.h",
     "src/sksl/transform/SkSLRenamePrivateSymbols.cpp",
@@ -1751,6 +1764,7 @@ BASE_SRCS_ALL = [
     "src/utils/SkParse.cpp",
     "src/utils/SkParseColor.cpp",
     "src/utils/SkParsePath.cpp",
+    "src/utils/SkPictureDamage.cpp",
     "src/utils/SkPatchUtils.cpp",
     "src/utils/SkPatchUtils.h",
     "src/utils/SkPolyUtils.cpp",
@@ -1761,6 +1775,9 @@ BASE_SRCS_ALL = [
     "src/utils/SkShadowTessellator.h",
     "src/utils/SkShadowUtils.cpp",
     "src/utils/SkTextUtils.cpp",
+    "src/utils/SkTiledImage.cpp",
+    "src/utils/SkTiledRaster.cpp",
+    "src/utils/SkTiledRaster.h",
     "src/xps/SkXPSDevice.cpp",
     "src/xps/SkXPSDevice.h",
     "src/xps/SkXPSDocument.cpp",
@@ -1831,6 +1848,10 @@ CODEC_SRCS_LIMITED = [
     "src/codec/SkJpegDecoderMgr.cpp",
     "src/codec/SkJpegDecoderMgr.h",
     "src/codec/SkJpegPriv.h",
+    "src/codec/SkJpegRestartDecode.cpp",
+    "src/codec/SkJpegRestartDecode.h",
+    "src/codec/SkJpegSegmentScan.cpp",
+    "src/codec/SkJpegSegmentScan.h",
     "src/codec/SkJpegSourceMgr.cpp",
     "src/codec/SkJpegSourceMgr.h",
     "src/codec/SkJpegUtility.cpp",
@@ -2179,6 +2200,8 @@ VULKAN_SRCS = [
     "src/gpu/ganesh/vk/GrVkOpsRenderPass.h",
     "src/gpu/ganesh/vk/GrVkPipeline.cpp",
     "src/gpu/ganesh/vk/GrVkPipeline.h",
+    "src/gpu/ganesh/vk/GrVkPipelineLibraryCache.cpp",
+    "src/gpu/ganesh/vk/GrVkPipelineLibraryCache.h",
     "src/gpu/ganesh/vk/GrVkPipelineStateBuilder.cpp",
     "src/gpu/ganesh/vk/GrVkPipelineStateBuilder.h",
     "src/gpu/ganesh/vk/GrVkPipelineStateCache.cpp",
@@ -2322,6 +2345,7 @@ SKSG_LIB_HDRS = [
     "modules/sksg/include/SkSGPaint.h",
     "modules/sksg/include/SkSGPath.h",
     "modules/sksg/include/SkSGPlane.h",
+    "modules/sksg/include/SkSGRasterCache.h",
     "modules/sksg/include/SkSGRect.h",
     "modules/sksg/include/SkSGRenderEffect.h",
     "modules/sksg/include/SkSGRenderNode.h",
@@ -2349,6 +2373,7 @@ SKSG_LIB_SRCS = [
     "modules/sksg/src/SkSGPaint.cpp",
     "modules/sksg/src/SkSGPath.cpp",
     "modules/sksg/src/SkSGPlane.cpp",
+    "modules/sksg/src/SkSGRasterCache.cpp",
     "modules/sksg/src/SkSGRect.cpp",
     "modules/sksg/src/SkSGRenderEffect.cpp",
     "modules/sksg/src/SkSGRenderNode.cpp",
@@ -2364,6 +2389,7 @@ SKSG_LIB_SRCS = [
 
 SKPARAGRAPH_LIB_HDRS = [
     "modules/skparagraph/include/DartTypes.h",
+    "modules/skparagraph/include/EditableParagraph.h",
     "modules/skparagraph/include/FontArguments.h",
     "modules/skparagraph/include/FontCollection.h",
     "modules/skparagraph/include/Metrics.h",
@@ -2380,6 +2406,7 @@ SKPARAGRAPH_LIB_HDRS = [
 SKPARAGRAPH_LIB_SRCS = [
     "modules/skparagraph/src/Decorations.cpp",
     "modules/skparagraph/src/Decorations.h",
+    "modules/skparagraph/src/EditableParagraph.cpp",
     "modules/skparagraph/src/FontArguments.cpp",
     "modules/skparagraph/src/FontCollection.cpp",
     "modules/skparagraph/src/Iterators.h",
@@ -2590,6 +2617,7 @@ SKSHAPER_HDRS = [
 
 SKSHAPER_HARFBUZZ_SRCS = [
     "modules/skshaper/src/SkShaper.cpp",
+    "modules/skshaper/src/SkShaper_cached.cpp",
     "modules/skshaper/src/SkShaper_harfbuzz.cpp",
     "modules/skshaper/src/SkShaper_primitive.cpp",
     "modules/skshaper/src/SkShaper_skunicode.cpp",
@@ -2597,12 +2625,14 @@ SKSHAPER_HARFBUZZ_SRCS = [
 
 SKSHAPER_CORETEXT_SRCS = [
     "modules/skshaper/src/SkShaper.cpp",
+    "modules/skshaper/src/SkShaper_cached.cpp",
     "modules/skshaper/src/SkShaper_coretext.cpp",
     "modules/skshaper/src/SkShaper_primitive.cpp",
 ]
 
 SKSHAPER_PRIMITIVE_SRCS = [
     "modules/skshaper/src/SkShaper.cpp",
+    "modules/skshaper/src/SkShaper_cached.cpp",
     "modules/skshaper/src/SkShaper_primitive.cpp",
 ]
 
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <limits>
 
 static char* end_chain(char*) { return nullptr; }
 
@@ -93,6 +94,8 @@ void SkArenaAlloc::ensureSpace(uint32_t size, uint32_t alignment) {
     }
 
     char* newBlock = static_cast<char*>(sk_malloc_throw(allocationSize));
+    fHeapAllocationCount++;
+    fHeapBytes += allocationSize;
 
     auto previousDtor = fDtorCursor;
     fCursor = newBlock;
@@ -164,6 +167,50 @@ bool SkArenaAllocWithReset::isEmpty() {
            this->cursor() == fFirstBlock + sizeof(Footer);
 }
 
+SkRetainingArenaAlloc::SkRetainingArenaAlloc(size_t firstHeapAllocation)
+        : fFirstHeapAllocation{SkToU32(firstHeapAllocation)} {
+    fArena.emplace(nullptr, 0, fFirstHeapAllocation);
+}
+
+SkRetainingArenaAlloc::~SkRetainingArenaAlloc() {
+    fArena.reset();
+    sk_free(fBlock);
+}
+
+void SkRetainingArenaAlloc::reset() {
+    const size_t used = fArena->bytesUsed(fBlock, fBlockSize);
+    int heapAllocations = fArena->heapAllocationCount();
+    fArena.reset();
+
+    size_t blockSize = fBlockSize;
+    if (used > fBlockSize) {
+        // Grow to the new high-water mark, rounded like the arena's own large blocks.
+        blockSize = std::min<size_t>((used + 4095) & ~size_t{4095},
+                                     std::numeric_limits<uint32_t>::max() / 2);
+        fDecayPeak = 0;
+        fDecayCount = 0;
+    } else if (used <= fBlockSize / 2) {
+        fDecayPeak = std::max(fDecayPeak, used);
+        if (++fDecayCount >= kDecayResets) {
+            blockSize = (fDecayPeak + 4095) & ~size_t{4095};
+            fDecayPeak = 0;
+            fDecayCount = 0;
+        }
+    } else {
+        fDecayPeak = 0;
+        fDecayCount = 0;
+    }
+
+    if (blockSize != fBlockSize) {
+        sk_free(fBlock);
+        fBlock = blockSize > 0 ? static_cast<char*>(sk_malloc_throw(blockSize)) : nullptr;
+        fBlockSize = blockSize;
+        heapAllocations += fBlock ? 1 : 0;
+    }
+    fLastHeapAllocationCount = heapAllocations;
+    fArena.emplace(fBlock, fBlockSize, fFirstHeapAllocation);
+}
+
 // SkFibonacci47 is the first 47 Fibonacci numbers. Fib(47) is the largest value less than 2 ^ 32.
 // Used by SkFibBlockSizes.
 std::array<const uint32_t, 47> SkFibonacci47 {
@@ -20,6 +20,7 @@
 #include <cstring>
 #include <limits>
 #include <new>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -205,6 +206,11 @@ public:
         return objStart;
     }
 
+    // The number of blocks this arena has allocated from the heap, and their total size. The
+    // block passed to the constructor is not counted.
+    int heapAllocationCount() const { return fHeapAllocationCount; }
+    size_t heapBytes() const { return fHeapBytes; }
+
 protected:
     using FooterAction = char* (char*);
     struct Footer {
@@ -300,6 +306,8 @@ private:
     char*          fDtorCursor;
     char*          fCursor;
     char*          fEnd;
+    int            fHeapAllocationCount = 0;
+    size_t         fHeapBytes = 0;
 
     SkFibBlockSizes<std::numeric_limits<uint32_t>::max()> fFibonacciProgression;
 };
@@ -323,6 +331,56 @@ private:
     const uint32_t fFirstHeapAllocationSize;
 };
 
+// Owns one heap block, which it hands to a fresh SkArenaAlloc after every reset(). The block grows
+// to the most memory that any use between two resets needed, so a steady stream of similar uses
+// (e.g. one per frame) stops allocating from the heap after the first few. Once kDecayResets resets
+// in a row have used at most half of the block, it shrinks to the most that those uses needed.
+class SkRetainingArenaAlloc {
+public:
+    static constexpr int kDecayResets = 120;
+
+    // firstHeapAllocation is used by the arena before the retained block has grown.
+    explicit SkRetainingArenaAlloc(size_t firstHeapAllocation);
+    ~SkRetainingArenaAlloc();
+
+    SkRetainingArenaAlloc(const SkRetainingArenaAlloc&) = delete;
+    SkRetainingArenaAlloc& operator=(const SkRetainingArenaAlloc&) = delete;
+
+    SkArenaAlloc* get() { return &*fArena; }
+
+    // Destroy all allocated objects, and free every heap allocation but the retained block.
+    void reset();
+
+    // The number of heap allocations made by the arena between the last two calls to reset(),
+    // including resizing the retained block.
+    int lastHeapAllocationCount() const { return fLastHeapAllocationCount; }
+
+    size_t retainedBytes() const { return fBlockSize; }
+
+private:
+    class Arena : public SkArenaAlloc {
+    public:
+        using SkArenaAlloc::SkArenaAlloc;
+
+        // An upper bound on the memory used since construction, given the constructor's block.
+        size_t bytesUsed(const char* block, size_t blockSize) {
+            if (this->heapAllocationCount() > 0) {
+                return blockSize + this->heapBytes();
+            }
+            return this->cursor() ? this->cursor() - block : 0;
+        }
+    };
+
+    const uint32_t fFirstHeapAllocation;
+    char* fBlock = nullptr;
+    size_t fBlockSize = 0;
+    size_t fDecayPeak = 0;
+    int fDecayCount = 0;
+    int fLastHeapAllocationCount = 0;
+    // Destroyed explicitly before fBlock is freed.
+    std::optional<Arena> fArena;
+};
+
 // Helper for defining allocators with inline/reserved storage.
 // For argument declarations, stick to the base type (SkArenaAlloc).
 // Note: Inheriting from the storage first means the storage will outlive the
@@ -12,6 +12,7 @@
 #include "src/base/SkMathPriv.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -211,4 +212,57 @@ template <typename T> void SkTQSort(T** begin, T** end) {
     SkTQSort(begin, end, [](const T* a, const T* b) { return *a < *b; });
 }
 
+/** Sorts the array of size count by the int32_t that getKey returns for each element, using a
+ *  stable least significant digit radix sort. Elements with equal keys keep their order.
+ *
+ *  Each of the key's four bytes takes one pass over the array, except that bytes which are the
+ *  same for every key are skipped. That makes this much faster than Introsort for large arrays of
+ *  keys with a small range, such as the top Y of a path's edges.
+ *
+ *  @param array the elements to sort
+ *  @param scratch space for count elements, whose contents are overwritten
+ *  @param getKey a functor/lambda which returns an int32_t for an element
+ */
+template <typename T, typename K>
+void SkTRadixSort(T* array, T* scratch, int count, const K& getKey) {
+    if (count < 2) {
+        return;
+    }
+    constexpr int kPasses = 4;
+    // Flipping the sign bit makes the keys sort as unsigned values.
+    auto key = [&](const T& t) { return static_cast<uint32_t>(getKey(t)) ^ 0x80000000; };
+
+    int histogram[kPasses][256] = {};
+    for (int i = 0; i < count; ++i) {
+        uint32_t k = key(array[i]);
+        for (int pass = 0; pass < kPasses; ++pass) {
+            histogram[pass][(k >> (8 * pass)) & 0xFF]++;
+        }
+    }
+
+    T* src = array;
+    T* dst = scratch;
+    for (int pass = 0; pass < kPasses; ++pass) {
+        int* buckets = histogram[pass];
+        if (buckets[(key(src[0]) >> (8 * pass)) & 0xFF] == count) {
+            continue;  // Every key has the same byte here.
+        }
+        int offset = 0;
+        for (int b = 0; b < 256; ++b) {
+            int n = buckets[b];
+            buckets[b] = offset;
+            offset += n;
+        }
+        for (int i = 0; i < count; ++i) {
+            dst[buckets[(key(src[i]) >> (8 * pass)) & 0xFF]++] = std::move(src[i]);
+        }
+        std::swap(src, dst);
+    }
+    if (src != array) {
+        for (int i = 0; i < count; ++i) {
+            array[i] = std::move(src[i]);
+        }
+    }
+}
+
 #endif
@@ -10,14 +10,20 @@
 #include "include/codec/SkCodec.h"
 #include "include/codec/SkEncodedImageFormat.h"
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkStream.h"
+#include "include/private/SkGainmapInfo.h"
+#include "include/private/SkGainmapShader.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkAndroidCodecAdapter.h"
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkSampledCodec.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
 #include <cstdint>
@@ -545,3 +551,65 @@ bool SkAndroidCodec::getAndroidGainmap(SkGainmapInfo* info,
                                        std::unique_ptr<SkStream>* outGainmapImageStream) {
     return fCodec->onGetGainmapInfo(info, outGainmapImageStream);
 }
+
+SkCodec::Result SkAndroidCodec::getGainmapAppliedPixels(const SkImageInfo& info,
+                                                        void* pixels,
+                                                        size_t rowBytes,
+                                                        float dstHdrRatio,
+                                                        SkExecutor* executor) {
+    if (!pixels || rowBytes < info.minRowBytes()) {
+        return SkCodec::kInvalidParameters;
+    }
+    if (info.dimensions() != this->getInfo().dimensions()) {
+        return SkCodec::kInvalidScale;
+    }
+
+    // The gainmap stream doesn't share the base image's stream, so the two can be decoded at the
+    // same time. Reading the gainmap info does use the base image's stream, so it comes first.
+    SkGainmapInfo gainmapInfo;
+    std::unique_ptr<SkStream> gainmapStream;
+    if (!this->getAndroidGainmap(&gainmapInfo, &gainmapStream) || !gainmapStream) {
+        return this->getAndroidPixels(info, pixels, rowBytes);
+    }
+
+    SkBitmap gainmap;
+    bool gainmapDecoded = false;
+    auto decodeGainmap = [&gainmap, &gainmapDecoded, &gainmapStream]() {
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(std::move(gainmapStream));
+        if (codec && gainmap.tryAllocPixels(codec->getInfo())) {
+            gainmapDecoded = SkCodec::kSuccess == codec->getPixels(gainmap.pixmap());
+        }
+    };
+    std::unique_ptr<SkTaskGroup> gainmapTask;
+    if (executor) {
+        gainmapTask = std::make_unique<SkTaskGroup>(*executor);
+        gainmapTask->add(decodeGainmap);
+    }
+
+    SkBitmap base;
+    if (!base.tryAllocPixels(fCodec->getInfo())) {
+        return SkCodec::kInternalError;
+    }
+    const SkCodec::Result result = fCodec->getPixels(base.pixmap());
+
+    if (gainmapTask) {
+        gainmapTask->wait();
+    } else {
+        decodeGainmap();
+    }
+    if (result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput &&
+        result != SkCodec::kErrorInInput) {
+        return result;
+    }
+
+    const SkPixmap dst(info, pixels, rowBytes);
+    if (!gainmapDecoded) {
+        // Without the gainmap, show the base image.
+        return base.readPixels(dst) ? result : SkCodec::kInvalidConversion;
+    }
+    if (!SkGainmapShader::ApplyToPixmap(base.pixmap(), gainmap.pixmap(), gainmapInfo,
+                                        dstHdrRatio, dst)) {
+        return SkCodec::kInvalidConversion;
+    }
+    return result;
+}
@@ -12,6 +12,7 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkTypes.h"
 #include "src/codec/SkPixmapUtilsPriv.h"
 
@@ -85,6 +86,48 @@ bool SkCodecImageGenerator::onGetPixels(const SkImageInfo& requestInfo, void* re
     return this->getPixels(requestInfo, requestPixels, requestRowBytes, nullptr);
 }
 
+bool SkCodecImageGenerator::onGetSubsetPixels(const SkPixmap& dst, const SkIRect& subset) {
+    // The subset is in the oriented image's coordinates.
+    if (fCodec->getOrigin() != kTopLeft_SkEncodedOrigin) {
+        return false;
+    }
+
+    // Codecs that can decode a subset at any scale (e.g. webp) take it directly.
+    SkCodec::Options options;
+    SkIRect validSubset = subset;
+    if (fCodec->getValidSubset(&validSubset) && validSubset == subset) {
+        options.fSubset = &subset;
+        if (fCodec->getPixels(dst, &options) == SkCodec::kSuccess) {
+            return true;
+        }
+    }
+
+    // Incremental decoders (e.g. png) only decode the rows of the subset, and write them to the
+    // start of 'dst'.
+    const SkImageInfo fullInfo = dst.info().makeDimensions(fCodec->dimensions());
+    options.fSubset = &subset;
+    SkCodec::Result result = fCodec->startIncrementalDecode(fullInfo, dst.writable_addr(),
+                                                            dst.rowBytes(), &options);
+    if (result == SkCodec::kSuccess) {
+        return fCodec->incrementalDecode() == SkCodec::kSuccess;
+    }
+    if (result != SkCodec::kUnimplemented) {
+        return false;
+    }
+
+    // Scanline decoders (e.g. jpeg) decode the columns of the subset, skipping the rows above it.
+    const SkIRect scanlineSubset = SkIRect::MakeXYWH(subset.x(), 0, subset.width(),
+                                                     fCodec->dimensions().height());
+    options.fSubset = &scanlineSubset;
+    if (fCodec->startScanlineDecode(fullInfo, &options) != SkCodec::kSuccess ||
+        fCodec->getScanlineOrder() != SkCodec::kTopDown_SkScanlineOrder ||
+        !fCodec->skipScanlines(subset.y())) {
+        return false;
+    }
+    return fCodec->getScanlines(dst.writable_addr(), subset.height(), dst.rowBytes()) ==
+           subset.height();
+}
+
 bool SkCodecImageGenerator::onQueryYUVAInfo(
         const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
         SkYUVAPixmapInfo* yuvaPixmapInfo) const {
@@ -102,7 +145,7 @@ bool SkCodecImageGenerator::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
     }
 }
 
-SkISize SkCodecImageGenerator::getScaledDimensions(float desiredScale) const {
+SkISize SkCodecImageGenerator::onGetScaledDimensions(float desiredScale) const {
     SkISize size = fCodec->getScaledDimensions(desiredScale);
     if (SkEncodedOriginSwapsWidthHeight(fCodec->getOrigin())) {
         std::swap(size.fWidth, size.fHeight);
@@ -32,17 +32,6 @@ public:
 
     static std::unique_ptr<SkImageGenerator> MakeFromCodec(std::unique_ptr<SkCodec>);
 
-    /**
-     * Return a size that approximately supports the desired scale factor. The codec may not be able
-     * to scale efficiently to the exact scale factor requested, so return a size that approximates
-     * that scale. The returned value is the codec's suggestion for the closest valid scale that it
-     * can natively support.
-     *
-     * This is similar to SkCodec::getScaledDimensions, but adjusts the returned dimensions based
-     * on the image's EXIF orientation.
-     */
-    SkISize getScaledDimensions(float desiredScale) const;
-
     /**
      *  Decode into the given pixels, a block of memory of size at
      *  least (info.fHeight - 1) * rowBytes + (info.fWidth *
@@ -109,6 +98,15 @@ protected:
                      size_t rowBytes,
                      const Options& opts) override;
 
+    bool onGetSubsetPixels(const SkPixmap& dst, const SkIRect& subset) override;
+
+    /**
+     * Returns the codec's suggestion for the closest scale to 'desiredScale' that it can natively
+     * support. This is similar to SkCodec::getScaledDimensions, but adjusts the returned
+     * dimensions based on the image's EXIF orientation.
+     */
+    SkISize onGetScaledDimensions(float desiredScale) const override;
+
     bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes&,
                          SkYUVAPixmapInfo*) const override;
 
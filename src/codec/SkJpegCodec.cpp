@@ -27,6 +27,7 @@
 #include "src/codec/SkJpegConstants.h"
 #include "src/codec/SkJpegDecoderMgr.h"
 #include "src/codec/SkJpegPriv.h"
+#include "src/codec/SkJpegRestartDecode.h"
 #include "src/codec/SkParseEncodedOrigin.h"
 #include "src/codec/SkSwizzler.h"
 
@@ -652,6 +653,18 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return kUnimplemented;
     }
 
+    // If the whole JPEG is in memory and has restart markers, try decoding it in bands that
+    // start at those markers. Otherwise (or if that fails) fall back to a serial decode below.
+    if (options.fExecutor && this->stream()->getMemoryBase() && this->stream()->hasLength()) {
+        if (SkJpegDecodeRestartIntervals(this->stream()->getMemoryBase(),
+                                         this->stream()->getLength(),
+                                         dstInfo, dst, dstRowBytes, options,
+                                         this->getEncodedInfo().profile(),
+                                         options.fExecutor)) {
+            return kSuccess;
+        }
+    }
+
     // Get a pointer to the decompress info since we will use it quite frequently
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
@@ -23,6 +23,7 @@
 #include <memory>
 
 class JpegDecoderMgr;
+class SkExecutor;
 class SkSampler;
 class SkStream;
 class SkSwizzler;
@@ -159,6 +160,10 @@ private:
     std::unique_ptr<SkSwizzler>        fSwizzler;
 
     friend class SkRawCodec;
+    // Makes a codec for each band, with this codec's default color profile.
+    friend bool SkJpegDecodeRestartIntervals(const void*, size_t, const SkImageInfo&, void*, size_t,
+                                             const SkCodec::Options&, const skcms_ICCProfile*,
+                                             SkExecutor*);
 
     using INHERITED = SkCodec;
 };
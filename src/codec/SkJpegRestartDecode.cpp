@@ -0,0 +1,279 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkJpegRestartDecode.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkStream.h"
+#include "include/private/SkEncodedInfo.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/codec/SkJpegCodec.h"
+#include "src/codec/SkJpegConstants.h"
+#include "src/codec/SkJpegSegmentScan.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+// Markers used below that are not needed anywhere else. See section B.1.1.3 and Table B.1.
+constexpr uint8_t kMarkerSOF0 = 0xC0;  // Baseline DCT.
+constexpr uint8_t kMarkerSOF1 = 0xC1;  // Extended sequential DCT, Huffman coding.
+constexpr uint8_t kMarkerSOF15 = 0xCF;
+constexpr uint8_t kMarkerDHT = 0xC4;
+constexpr uint8_t kMarkerJPG = 0xC8;
+constexpr uint8_t kMarkerDAC = 0xCC;
+constexpr uint8_t kMarkerRST0 = 0xD0;
+constexpr uint8_t kMarkerRST7 = 0xD7;
+constexpr uint8_t kMarkerDRI = 0xDD;
+
+// Bands are at least this many pixel rows tall, and there are at most this many of them. This
+// keeps the per-band overhead small: each band copies the headers, creates a codec, and (for
+// vertically subsampled chroma) decodes the rows around it, which is ~12% extra work at 256 rows.
+constexpr int kMinBandRows = 256;
+constexpr int kMaxBands = 32;
+
+uint16_t read_be16(const uint8_t* p) { return (p[0] << 8) | p[1]; }
+
+// What we need to know about a baseline JPEG to split it at restart markers.
+struct RestartLayout {
+    size_t              fScanStart = 0;     // First byte of entropy-coded data.
+    size_t              fEndOfImage = 0;    // Offset of the EOI marker.
+    size_t              fHeightOffset = 0;  // Offset of the frame height in the SOF segment.
+    std::vector<size_t> fRestarts;          // Offset of each RSTm marker, in order.
+
+    int fWidth = 0;
+    int fHeight = 0;
+    int fMcuHeight = 0;       // In pixels.
+    int fMcusPerRow = 0;
+    int fMcuRows = 0;
+    int fRestartInterval = 0;  // In MCUs.
+    bool fVerticallySubsampled = false;
+};
+
+bool parse_layout(const uint8_t* data, size_t size, RestartLayout* layout) {
+    SkJpegSegmentScanner scanner(kJpegMarkerEndOfImage);
+    scanner.onBytes(data, size);
+    if (!scanner.isDone()) {
+        return false;
+    }
+
+    int componentCount = 0;
+    int maxH = 0, maxV = 0, minV = 0;
+    bool sawScan = false;
+    for (const SkJpegSegment& segment : scanner.getSegments()) {
+        const uint8_t marker = segment.marker;
+        const uint8_t* params = data + segment.offset + kJpegMarkerCodeSize +
+                                kJpegSegmentParameterLengthSize;
+        const size_t paramsSize = segment.parameterLength > kJpegSegmentParameterLengthSize
+                                          ? segment.parameterLength -
+                                                    kJpegSegmentParameterLengthSize
+                                          : 0;
+
+        if (sawScan) {
+            // Only restart markers may follow the (single) scan.
+            if (marker >= kMarkerRST0 && marker <= kMarkerRST7) {
+                layout->fRestarts.push_back(segment.offset);
+                continue;
+            }
+            if (marker == kJpegMarkerEndOfImage) {
+                layout->fEndOfImage = segment.offset;
+                break;
+            }
+            return false;
+        }
+
+        if (marker >= kMarkerSOF0 && marker <= kMarkerSOF15 &&
+            marker != kMarkerDHT && marker != kMarkerJPG && marker != kMarkerDAC) {
+            if ((marker != kMarkerSOF0 && marker != kMarkerSOF1) || paramsSize < 6) {
+                return false;
+            }
+            layout->fHeightOffset = segment.offset + kJpegMarkerCodeSize +
+                                    kJpegSegmentParameterLengthSize + 1;
+            layout->fHeight = read_be16(params + 1);
+            layout->fWidth = read_be16(params + 3);
+            componentCount = params[5];
+            if (componentCount == 0 || paramsSize < 6 + 3 * (size_t)componentCount) {
+                return false;
+            }
+            maxH = maxV = 0;
+            minV = 4;
+            for (int i = 0; i < componentCount; ++i) {
+                const uint8_t sampling = params[6 + 3 * i + 1];
+                const int h = sampling >> 4, v = sampling & 0xF;
+                if (h < 1 || h > 4 || v < 1 || v > 4) {
+                    return false;
+                }
+                maxH = std::max(maxH, h);
+                maxV = std::max(maxV, v);
+                minV = std::min(minV, v);
+            }
+        } else if (marker == kMarkerDRI) {
+            if (paramsSize < 2) {
+                return false;
+            }
+            layout->fRestartInterval = read_be16(params);
+        } else if (marker == kJpegMarkerStartOfScan) {
+            // The scan must contain every component, i.e. be the only scan.
+            if (componentCount == 0 || paramsSize < 1 || params[0] != componentCount) {
+                return false;
+            }
+            layout->fScanStart = segment.offset + kJpegMarkerCodeSize + segment.parameterLength;
+            sawScan = true;
+        }
+    }
+    // A height of zero means the height is only given by a DNL marker after the scan.
+    if (!sawScan || layout->fEndOfImage == 0 || layout->fRestartInterval == 0 ||
+        layout->fWidth == 0 || layout->fHeight == 0) {
+        return false;
+    }
+
+    // See section A.2: a single component scan is not interleaved, and its MCU is one block.
+    const int mcuWidth = componentCount == 1 ? 8 : 8 * maxH;
+    layout->fMcuHeight = componentCount == 1 ? 8 : 8 * maxV;
+    layout->fVerticallySubsampled = componentCount > 1 && minV < maxV;
+    layout->fMcusPerRow = (layout->fWidth + mcuWidth - 1) / mcuWidth;
+    layout->fMcuRows = (layout->fHeight + layout->fMcuHeight - 1) / layout->fMcuHeight;
+
+    // If the markers do not match the frame (e.g. the data is truncated), let the serial decode
+    // deal with it.
+    const uint64_t mcuCount = (uint64_t)layout->fMcusPerRow * layout->fMcuRows;
+    const uint64_t intervals = (mcuCount + layout->fRestartInterval - 1) /
+                               layout->fRestartInterval;
+    return layout->fRestarts.size() + 1 == intervals;
+}
+
+}  // namespace
+
+bool SkJpegDecodeRestartIntervals(const void* data,
+                                  size_t size,
+                                  const SkImageInfo& dstInfo,
+                                  void* dst,
+                                  size_t rowBytes,
+                                  const SkCodec::Options& options,
+                                  const skcms_ICCProfile* defaultColorProfile,
+                                  SkExecutor* executor) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    RestartLayout layout;
+    if (!executor || !parse_layout(bytes, size, &layout) ||
+        dstInfo.dimensions() != SkISize{layout.fWidth, layout.fHeight}) {
+        return false;
+    }
+
+    // Bands can only start at a restart marker that is also at the start of an MCU row. Those
+    // come every |unitRows| MCU rows.
+    const uint64_t alignedMcus = std::lcm((uint64_t)layout.fRestartInterval,
+                                          (uint64_t)layout.fMcusPerRow);
+    if (alignedMcus / layout.fMcusPerRow >= (uint64_t)layout.fMcuRows) {
+        return false;
+    }
+    const int unitRows = SkToInt(alignedMcus / layout.fMcusPerRow);
+    const int units = (layout.fMcuRows + unitRows - 1) / unitRows;
+    const int minUnitsPerBand =
+            (kMinBandRows + unitRows * layout.fMcuHeight - 1) / (unitRows * layout.fMcuHeight);
+    const int unitsPerBand = std::max((units + kMaxBands - 1) / kMaxBands, minUnitsPerBand);
+    const int bandCount = (units + unitsPerBand - 1) / unitsPerBand;
+    if (bandCount < 2) {
+        return false;
+    }
+
+    SkCodec::Options bandOptions = options;
+    bandOptions.fExecutor = nullptr;
+
+    std::atomic<bool> failed{false};
+    auto decodeBand = [&](int band) {
+        const int mcuH = layout.fMcuHeight;
+        const int firstRow = band * unitsPerBand * unitRows;  // In MCU rows.
+        const int endRow = std::min(firstRow + unitsPerBand * unitRows, layout.fMcuRows);
+
+        // Vertical chroma upsampling looks at the neighbouring rows, so decode (and throw away)
+        // an extra unit above and an extra MCU row below the band in that case.
+        int decodeFirstRow = firstRow, decodeEndRow = endRow;
+        if (layout.fVerticallySubsampled) {
+            decodeFirstRow = std::max(firstRow - unitRows, 0);
+            decodeEndRow = std::min(endRow + 1, layout.fMcuRows);
+        }
+
+        // Restart interval |i| is ended by marker fRestarts[i].
+        const uint64_t firstInterval =
+                (uint64_t)decodeFirstRow * layout.fMcusPerRow / layout.fRestartInterval;
+        const uint64_t lastInterval =
+                ((uint64_t)decodeEndRow * layout.fMcusPerRow - 1) / layout.fRestartInterval;
+        const size_t scanBegin = firstInterval == 0
+                                         ? layout.fScanStart
+                                         : layout.fRestarts[firstInterval - 1] + kJpegMarkerCodeSize;
+        const size_t scanEnd = lastInterval < layout.fRestarts.size()
+                                       ? layout.fRestarts[lastInterval]
+                                       : layout.fEndOfImage;
+
+        // Wrap the band up as its own JPEG: the original headers (with the height of the band),
+        // the band's entropy-coded data (restart markers renumbered from RST0), and an EOI.
+        const size_t headerSize = layout.fScanStart;
+        const size_t bandSize = headerSize + (scanEnd - scanBegin) + kJpegMarkerCodeSize;
+        sk_sp<SkData> bandData = SkData::MakeUninitialized(bandSize);
+        uint8_t* out = static_cast<uint8_t*>(bandData->writable_data());
+        memcpy(out, bytes, headerSize);
+        memcpy(out + headerSize, bytes + scanBegin, scanEnd - scanBegin);
+        out[bandSize - 2] = 0xFF;
+        out[bandSize - 1] = kJpegMarkerEndOfImage;
+
+        const int decodeTop = decodeFirstRow * mcuH;
+        const int decodeHeight = std::min(decodeEndRow * mcuH, layout.fHeight) - decodeTop;
+        out[layout.fHeightOffset + 0] = (uint8_t)(decodeHeight >> 8);
+        out[layout.fHeightOffset + 1] = (uint8_t)(decodeHeight & 0xFF);
+        for (uint64_t i = firstInterval; i < lastInterval; ++i) {
+            out[headerSize + (layout.fRestarts[i] - scanBegin) + 1] =
+                    SkToU8(kMarkerRST0 + ((i - firstInterval) & 0x7));
+        }
+
+        SkCodec::Result result;
+        std::unique_ptr<SkCodec> codec = SkJpegCodec::MakeFromStream(
+                SkMemoryStream::Make(std::move(bandData)), &result,
+                defaultColorProfile ? SkEncodedInfo::ICCProfile::Make(*defaultColorProfile)
+                                    : nullptr);
+        if (!codec || codec->dimensions() != SkISize{layout.fWidth, decodeHeight}) {
+            failed = true;
+            return;
+        }
+        const SkImageInfo bandInfo = dstInfo.makeDimensions(codec->dimensions());
+        if (SkCodec::kSuccess != codec->startScanlineDecode(bandInfo, &bandOptions)) {
+            failed = true;
+            return;
+        }
+
+        const int skipRows = (firstRow - decodeFirstRow) * mcuH;
+        if (skipRows > 0) {
+            skia_private::AutoTMalloc<uint8_t> scratch(bandInfo.minRowBytes());
+            for (int y = 0; y < skipRows; ++y) {
+                if (1 != codec->getScanlines(scratch.get(), 1, bandInfo.minRowBytes())) {
+                    failed = true;
+                    return;
+                }
+            }
+        }
+        const int top = firstRow * mcuH;
+        const int rows = std::min(endRow * mcuH, layout.fHeight) - top;
+        if (rows != codec->getScanlines(SkTAddOffset<void>(dst, top * rowBytes), rows, rowBytes)) {
+            failed = true;
+        }
+    };
+
+    SkTaskGroup tasks(*executor);
+    tasks.batch(bandCount, decodeBand);
+    tasks.wait();
+    return !failed;
+}
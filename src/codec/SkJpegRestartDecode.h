@@ -0,0 +1,44 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkJpegRestartDecode_codec_DEFINED
+#define SkJpegRestartDecode_codec_DEFINED
+
+#include "include/codec/SkCodec.h"
+
+#include <cstddef>
+
+class SkExecutor;
+struct SkImageInfo;
+struct skcms_ICCProfile;
+
+/*
+ * Decodes a baseline JPEG that has restart markers (DRI) by splitting it into horizontal bands
+ * and decoding the bands concurrently on |executor|.
+ *
+ * The entropy-coded data is reset at each restart marker, so a band that starts at a restart
+ * marker at the beginning of an MCU row can be decoded on its own: each band is re-wrapped as a
+ * JPEG with the original headers, a reduced height, and renumbered restart markers, and is
+ * decoded by its own SkJpegCodec. When chroma is subsampled vertically, each band also decodes
+ * the MCU rows around it (and discards them), so that the upsampled rows at the seams match a
+ * serial decode exactly.
+ *
+ * |data| must be the complete JPEG and |dstInfo| must have the JPEG's unscaled dimensions. If
+ * the image is not split (e.g. it is progressive, has no restart markers, is too small, or some
+ * band fails to decode), this returns false and the contents of |dst| are undefined; the caller
+ * should decode serially instead.
+ */
+bool SkJpegDecodeRestartIntervals(const void* data,
+                                  size_t size,
+                                  const SkImageInfo& dstInfo,
+                                  void* dst,
+                                  size_t rowBytes,
+                                  const SkCodec::Options& options,
+                                  const skcms_ICCProfile* defaultColorProfile,
+                                  SkExecutor* executor);
+
+#endif
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkParallelFrameDecoder.h"
+
+#include "include/codec/SkCodecAnimation.h"
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkSemaphore.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <utility>
+
+struct SkParallelFrameDecoder::Pending {
+    SkSemaphore    fDone;
+    int            fWaiters = 0;  // Guarded by SkParallelFrameDecoder::fMutex.
+    sk_sp<SkImage> fImage;
+};
+
+static std::vector<SkCodec::FrameInfo> frame_infos(SkCodec* codec) {
+    std::vector<SkCodec::FrameInfo> infos = codec->getFrameInfo();
+    if (infos.empty()) {
+        // A still image may not report any frame info; it has one independent frame.
+        SkCodec::FrameInfo info;
+        info.fRequiredFrame        = SkCodec::kNoFrame;
+        info.fDuration             = 0;
+        info.fFullyReceived        = true;
+        info.fAlphaType            = codec->getInfo().alphaType();
+        info.fHasAlphaWithinBounds = !codec->getInfo().isOpaque();
+        info.fDisposalMethod       = SkCodecAnimation::DisposalMethod::kKeep;
+        info.fBlend                = SkCodecAnimation::Blend::kSrc;
+        info.fFrameRect            = SkIRect::MakeSize(codec->dimensions());
+        infos.push_back(info);
+    }
+    return infos;
+}
+
+std::unique_ptr<SkParallelFrameDecoder> SkParallelFrameDecoder::Make(
+        sk_sp<SkData> data, SkSpan<const SkCodecs::Decoder> decoders, const Options& options) {
+    std::vector<SkCodecs::Decoder> ownedDecoders(decoders.begin(), decoders.end());
+    return Make([data, ownedDecoders = std::move(ownedDecoders)] {
+        return SkCodec::MakeFromData(data, ownedDecoders);
+    }, options);
+}
+
+std::unique_ptr<SkParallelFrameDecoder> SkParallelFrameDecoder::Make(sk_sp<SkData> data,
+                                                                     const Options& options) {
+    return Make([data] { return SkCodec::MakeFromData(data); }, options);
+}
+
+std::unique_ptr<SkParallelFrameDecoder> SkParallelFrameDecoder::Make(CodecFactory factory,
+                                                                     const Options& options) {
+    std::unique_ptr<SkCodec> codec = factory();
+    if (!codec) {
+        return nullptr;
+    }
+    return std::unique_ptr<SkParallelFrameDecoder>(
+            new SkParallelFrameDecoder(std::move(factory), std::move(codec), options));
+}
+
+SkParallelFrameDecoder::SkParallelFrameDecoder(CodecFactory factory,
+                                               std::unique_ptr<SkCodec> codec,
+                                               const Options& options)
+        : fFactory(std::move(factory))
+        , fInfo(codec->getInfo())
+        , fFrameInfos(frame_infos(codec.get()))
+        , fExecutor(options.fExecutor)
+        , fPrefetchCount(options.fExecutor
+                                 ? std::clamp(options.fPrefetchCount, 0, this->frameCount() - 1)
+                                 : 0)
+        , fMaxPooledFrames(std::max(options.fMaxPooledFrames, fPrefetchCount + 1))
+        , fFrames(fFrameInfos.size()) {
+    fIdleCodecs.push_back(std::move(codec));
+    if (fExecutor) {
+        fPrefetchTasks = std::make_unique<SkTaskGroup>(*fExecutor);
+    }
+}
+
+SkParallelFrameDecoder::~SkParallelFrameDecoder() {
+    if (fPrefetchTasks) {
+        fPrefetchTasks->wait();
+    }
+}
+
+std::unique_ptr<SkCodec> SkParallelFrameDecoder::acquireCodec() {
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (!fIdleCodecs.empty()) {
+            std::unique_ptr<SkCodec> codec = std::move(fIdleCodecs.back());
+            fIdleCodecs.pop_back();
+            return codec;
+        }
+    }
+    // Each codec parses the encoded data on its own, so only make one when all are busy.
+    return fFactory();
+}
+
+void SkParallelFrameDecoder::releaseCodec(std::unique_ptr<SkCodec> codec) {
+    if (codec) {
+        SkAutoMutexExclusive lock(fMutex);
+        fIdleCodecs.push_back(std::move(codec));
+    }
+}
+
+sk_sp<SkImage> SkParallelFrameDecoder::decode(SkCodec* codec,
+                                              int index,
+                                              const SkImage* prior) const {
+    const SkCodec::FrameInfo& frameInfo = fFrameInfos[index];
+
+    SkImageInfo info = fInfo;
+    if (frameInfo.fAlphaType != kOpaque_SkAlphaType && info.isOpaque()) {
+        info = info.makeAlphaType(kPremul_SkAlphaType);
+    }
+    SkBitmap bitmap;
+    if (!bitmap.tryAllocPixels(info)) {
+        return nullptr;
+    }
+
+    SkCodec::Options options;
+    options.fFrameIndex = index;
+    if (frameInfo.fRequiredFrame != SkCodec::kNoFrame) {
+        // The codec blends this frame onto its required frame, which must already be in dst.
+        if (!prior || !prior->readPixels(nullptr, bitmap.pixmap(), 0, 0)) {
+            return nullptr;
+        }
+        options.fPriorFrame = frameInfo.fRequiredFrame;
+    }
+
+    if (SkCodec::kSuccess != codec->getPixels(bitmap.pixmap(), &options)) {
+        return nullptr;
+    }
+    bitmap.setImmutable();
+    return bitmap.asImage();
+}
+
+sk_sp<SkImage> SkParallelFrameDecoder::findOrDecode(SkCodec* codec, int index) {
+    std::shared_ptr<Pending> pending;
+    bool claimed = false;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        Frame& frame = fFrames[index];
+        if (frame.fImage || frame.fFailed) {
+            frame.fLastUse = ++fUseCount;
+            return frame.fImage;
+        }
+        if (frame.fPending) {
+            pending = frame.fPending;
+            pending->fWaiters++;
+        } else {
+            pending = frame.fPending = std::make_shared<Pending>();
+            claimed = true;
+        }
+    }
+
+    if (!claimed) {
+        // Another codec is already decoding this frame.
+        pending->fDone.wait();
+        return pending->fImage;
+    }
+
+    // Waiting on the required frame while holding our claim cannot deadlock: required frames
+    // always come earlier in the animation, so every chain of waits ends at an independent frame.
+    sk_sp<SkImage> prior;
+    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
+    if (requiredFrame != SkCodec::kNoFrame) {
+        prior = this->findOrDecode(codec, requiredFrame);
+    }
+    sk_sp<SkImage> image = (requiredFrame == SkCodec::kNoFrame || prior)
+                                   ? this->decode(codec, index, prior.get())
+                                   : nullptr;
+
+    int waiters;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        Frame& frame = fFrames[index];
+        frame.fPending.reset();
+        if (image) {
+            frame.fImage = image;
+            frame.fLastUse = ++fUseCount;
+            fPooledCount++;
+            this->evictFrames();
+        } else {
+            frame.fFailed = true;
+        }
+        pending->fImage = image;
+        waiters = pending->fWaiters;
+    }
+    pending->fDone.signal(waiters);
+    return image;
+}
+
+std::vector<sk_sp<SkImage>> SkParallelFrameDecoder::decodeKeyframes() {
+    std::vector<int> keyframes;
+    for (int i = 0; i < this->frameCount(); ++i) {
+        if (fFrameInfos[i].fRequiredFrame == SkCodec::kNoFrame) {
+            keyframes.push_back(i);
+        }
+    }
+
+    std::vector<sk_sp<SkImage>> images(fFrameInfos.size());
+    auto decodeKeyframe = [&](int i) {
+        std::unique_ptr<SkCodec> codec = this->acquireCodec();
+        if (codec) {
+            images[keyframes[i]] = this->findOrDecode(codec.get(), keyframes[i]);
+        }
+        this->releaseCodec(std::move(codec));
+    };
+
+    if (fExecutor && keyframes.size() > 1) {
+        SkTaskGroup tasks(*fExecutor);
+        tasks.batch(SkToInt(keyframes.size()), decodeKeyframe);
+        tasks.wait();
+    } else {
+        for (int i = 0; i < SkToInt(keyframes.size()); ++i) {
+            decodeKeyframe(i);
+        }
+    }
+    return images;
+}
+
+sk_sp<SkImage> SkParallelFrameDecoder::getFrame(int index) {
+    SkASSERT(0 <= index && index < this->frameCount());
+
+    bool startPrefetch = false;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        fCurrentFrame = index;
+        if (fPrefetchCount > 0 && !fPrefetching) {
+            fPrefetching = startPrefetch = true;
+        }
+    }
+    if (startPrefetch) {
+        fPrefetchTasks->add([this] { this->prefetch(); });
+    }
+
+    std::unique_ptr<SkCodec> codec = this->acquireCodec();
+    sk_sp<SkImage> image = codec ? this->findOrDecode(codec.get(), index) : nullptr;
+    this->releaseCodec(std::move(codec));
+    return image;
+}
+
+void SkParallelFrameDecoder::prefetch() {
+    std::unique_ptr<SkCodec> codec;
+    for (;;) {
+        int next = -1;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            // fCurrentFrame may move while we work, so pick the next frame after each decode.
+            for (int i = 1; i <= fPrefetchCount && next < 0; ++i) {
+                const int candidate = (fCurrentFrame + i) % this->frameCount();
+                const Frame& frame = fFrames[candidate];
+                if (!frame.fImage && !frame.fPending && !frame.fFailed) {
+                    next = candidate;
+                }
+            }
+            if (next < 0) {
+                fPrefetching = false;
+                break;
+            }
+        }
+        if (!codec && !(codec = this->acquireCodec())) {
+            SkAutoMutexExclusive lock(fMutex);
+            fPrefetching = false;
+            break;
+        }
+        this->findOrDecode(codec.get(), next);
+    }
+    this->releaseCodec(std::move(codec));
+}
+
+bool SkParallelFrameDecoder::inPrefetchWindow(int index) const {
+    const int distance = (index - fCurrentFrame + this->frameCount()) % this->frameCount();
+    return distance <= fPrefetchCount;
+}
+
+void SkParallelFrameDecoder::evictFrames() {
+    while (fPooledCount > fMaxPooledFrames) {
+        // Drop the least recently used frame, keeping the current frame and the ones being
+        // prefetched after it.
+        int victim = -1;
+        for (int i = 0; i < this->frameCount(); ++i) {
+            const Frame& frame = fFrames[i];
+            if (frame.fImage && !this->inPrefetchWindow(i) &&
+                (victim < 0 || frame.fLastUse < fFrames[victim].fLastUse)) {
+                victim = i;
+            }
+        }
+        if (victim < 0) {
+            return;
+        }
+        fFrames[victim].fImage.reset();
+        fPooledCount--;
+    }
+}
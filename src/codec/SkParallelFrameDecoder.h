@@ -0,0 +1,140 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkParallelFrameDecoder_DEFINED
+#define SkParallelFrameDecoder_DEFINED
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "include/private/base/SkTo.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class SkData;
+class SkExecutor;
+class SkImage;
+class SkTaskGroup;
+
+/**
+ *  Decodes the frames of an animated image (GIF, WebP, AVIF, ...) using several SkCodecs at once.
+ *
+ *  An SkCodec can only decode one frame at a time, and each frame that depends on an earlier one
+ *  (FrameInfo::fRequiredFrame != SkCodec::kNoFrame) has to be decoded on top of that earlier
+ *  frame. This keeps a small pool of codecs for the same encoded data so that independent frames
+ *  can be decoded concurrently, and so that the frames following the last one returned by
+ *  getFrame() can be decoded in the background before they are asked for.
+ *
+ *  Decoded frames are kept in a pool of at most Options::fMaxPooledFrames images. Frames are
+ *  decoded in the codec's encoded orientation, like SkCodec::getPixels().
+ *
+ *  All methods are thread safe.
+ */
+class SkParallelFrameDecoder {
+public:
+    struct Options {
+        // Frames are decoded on this executor. If null, frames are decoded on the calling thread
+        // and nothing is prefetched.
+        SkExecutor* fExecutor = nullptr;
+
+        // After getFrame(i), frames i+1 ... i+fPrefetchCount (wrapping around to the start of the
+        // animation) are decoded in the background.
+        int fPrefetchCount = 4;
+
+        // The most decoded frames the pool keeps alive. This is raised to fPrefetchCount + 1 if
+        // it is smaller. Images already handed out are unaffected when a frame is evicted.
+        int fMaxPooledFrames = 8;
+    };
+
+    /**
+     *  Returns null if 'data' cannot be decoded by any of 'decoders'.
+     */
+    static std::unique_ptr<SkParallelFrameDecoder> Make(sk_sp<SkData> data,
+                                                        SkSpan<const SkCodecs::Decoder> decoders,
+                                                        const Options& options);
+    /**
+     *  Like above, but uses the decoders registered with SkCodecs::Register().
+     */
+    static std::unique_ptr<SkParallelFrameDecoder> Make(sk_sp<SkData> data,
+                                                        const Options& options);
+
+    // Waits for any background decoding to finish.
+    ~SkParallelFrameDecoder();
+
+    const SkImageInfo& info() const { return fInfo; }
+
+    int frameCount() const { return SkToInt(fFrameInfos.size()); }
+
+    const SkCodec::FrameInfo& frameInfo(int index) const {
+        SkASSERT(0 <= index && index < this->frameCount());
+        return fFrameInfos[index];
+    }
+
+    /**
+     *  Decodes every independent frame (fRequiredFrame == SkCodec::kNoFrame) concurrently and
+     *  blocks until they are done. The result is indexed by frame; dependent frames and frames
+     *  that failed to decode are null.
+     */
+    std::vector<sk_sp<SkImage>> decodeKeyframes();
+
+    /**
+     *  Returns frame 'index', decoding it (and any frames it depends on that are not pooled) if
+     *  necessary, and starts prefetching the frames after it. Returns null if it fails to decode.
+     */
+    sk_sp<SkImage> getFrame(int index);
+
+private:
+    using CodecFactory = std::function<std::unique_ptr<SkCodec>()>;
+
+    struct Pending;
+
+    struct Frame {
+        sk_sp<SkImage>           fImage;
+        std::shared_ptr<Pending> fPending;    // Set while a codec decodes this frame.
+        uint64_t                 fLastUse = 0;
+        bool                     fFailed = false;
+    };
+
+    SkParallelFrameDecoder(CodecFactory, std::unique_ptr<SkCodec>, const Options&);
+
+    static std::unique_ptr<SkParallelFrameDecoder> Make(CodecFactory, const Options&);
+
+    std::unique_ptr<SkCodec> acquireCodec();
+    void releaseCodec(std::unique_ptr<SkCodec>);
+
+    sk_sp<SkImage> decode(SkCodec*, int index, const SkImage* prior) const;
+    sk_sp<SkImage> findOrDecode(SkCodec*, int index);
+
+    void prefetch();
+    bool inPrefetchWindow(int index) const SK_REQUIRES(fMutex);
+    void evictFrames() SK_REQUIRES(fMutex);
+
+    const CodecFactory                    fFactory;
+    const SkImageInfo                     fInfo;
+    const std::vector<SkCodec::FrameInfo> fFrameInfos;
+    SkExecutor* const                     fExecutor;
+    const int                             fPrefetchCount;
+    const int                             fMaxPooledFrames;
+
+    SkMutex                               fMutex;
+    std::vector<std::unique_ptr<SkCodec>> fIdleCodecs  SK_GUARDED_BY(fMutex);
+    std::vector<Frame>                    fFrames      SK_GUARDED_BY(fMutex);
+    int                                   fPooledCount SK_GUARDED_BY(fMutex) = 0;
+    uint64_t                              fUseCount    SK_GUARDED_BY(fMutex) = 0;
+    int                                   fCurrentFrame SK_GUARDED_BY(fMutex) = 0;
+    bool                                  fPrefetching SK_GUARDED_BY(fMutex) = false;
+
+    std::unique_ptr<SkTaskGroup>          fPrefetchTasks;
+};
+
+#endif  // SkParallelFrameDecoder_DEFINED
@@ -150,10 +150,23 @@ static inline bool is_chunk(const png_byte* chunk, const char* tag) {
 
 static inline bool process_data(png_structp png_ptr, png_infop info_ptr,
         SkStream* stream, void* buffer, size_t bufferSize, size_t length) {
+    // If the stream is already in memory (e.g. an SkMemoryStream, possibly of an mmapped file),
+    // hand libpng the bytes in place instead of copying them into |buffer| first. libpng does not
+    // write to its input. The stream still advances the same way, in case we stop early.
+    const uint8_t* memory = stream->hasPosition()
+                                    ? static_cast<const uint8_t*>(stream->getMemoryBase())
+                                    : nullptr;
     while (length > 0) {
         const size_t bytesToProcess = std::min(bufferSize, length);
-        const size_t bytesRead = stream->read(buffer, bytesToProcess);
-        png_process_data(png_ptr, info_ptr, (png_bytep) buffer, bytesRead);
+        png_bytep bytes = (png_bytep) buffer;
+        size_t bytesRead;
+        if (memory) {
+            bytes = const_cast<png_bytep>(memory + stream->getPosition());
+            bytesRead = stream->skip(bytesToProcess);
+        } else {
+            bytesRead = stream->read(buffer, bytesToProcess);
+        }
+        png_process_data(png_ptr, info_ptr, bytes, bytesRead);
         if (bytesRead < bytesToProcess) {
             return false;
         }
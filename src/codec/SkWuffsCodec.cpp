@@ -81,7 +81,21 @@
 #define SK_WUFFS_INITIALIZE_FLAGS WUFFS_INITIALIZE__DEFAULT_OPTIONS
 #endif
 
+// If the encoded data is already in memory (e.g. an SkMemoryStream, possibly of an mmapped file),
+// the io_buffer wraps that memory directly instead of copying it, 4 KiB at a time, into fBuffer.
+// Wuffs only reads from the io_buffer, so the memory is never written to.
+static bool wraps_stream_memory(const wuffs_base__io_buffer* b, SkStream* s) {
+    return b->data.ptr && b->data.ptr == s->getMemoryBase();
+}
+
 static bool fill_buffer(wuffs_base__io_buffer* b, SkStream* s) {
+    if (wraps_stream_memory(b, s)) {
+        // Everything is already in the buffer, so there is nothing to read, just more to expose.
+        const bool grew = b->meta.wi < b->data.len;
+        b->meta.wi = b->data.len;
+        b->meta.closed = false;
+        return grew;
+    }
     b->compact();
     size_t num_read = s->read(b->data.ptr + b->meta.wi, b->data.len - b->meta.wi);
     b->meta.wi += num_read;
@@ -117,6 +131,17 @@ static bool seek_buffer(wuffs_base__io_buffer* b, SkStream* s, uint64_t pos) {
         b->meta.ri = pos - b->meta.pos;
         return true;
     }
+    // A buffer that wraps the stream's memory is never compacted, so its
+    // positions are stream positions.
+    if (wraps_stream_memory(b, s)) {
+        if (pos > b->data.len) {
+            return false;
+        }
+        b->meta.wi = b->data.len;
+        b->meta.ri = pos;
+        b->meta.closed = false;
+        return true;
+    }
     // Seek in the backing SkStream.
     if ((pos > SIZE_MAX) || (!s->seek(pos))) {
         return false;
@@ -284,11 +309,12 @@ private:
     Result onIncrementalDecodeTwoPass();
 
     void        onGetFrameCountInternal();
+    bool        initFrameCountDecoder();
     Result      seekFrame(int frameIndex);
     Result      resetDecoder();
     const char* decodeFrameConfig();
     const char* decodeFrame();
-    void        updateNumFullyReceivedFrames();
+    void        updateNumFullyReceivedFrames(wuffs_gif__decoder* decoder);
 
     SkWuffsFrameHolder                           fFrameHolder;
     std::unique_ptr<SkStream>                    fStream;
@@ -318,6 +344,18 @@ private:
     std::vector<SkWuffsFrame> fFrames;
     bool                      fFramesComplete;
 
+    // A second decoder, used only to walk the frame configs for
+    // onGetFrameCount. It is separate from fDecoder so that counting frames
+    // does not disturb an incremental decode, and it is never reset: when the
+    // stream runs out of data, it stays suspended (with its own I/O buffer and
+    // stream position) until the next onGetFrameCount call resumes it. Each
+    // call therefore only reads the bytes that arrived since the last one,
+    // instead of seeking back and re-scanning the last frame.
+    std::unique_ptr<wuffs_gif__decoder, decltype(&sk_free)> fFrameCountDecoder;
+    std::unique_ptr<uint8_t, decltype(&sk_free)>            fFrameCountBuffer;
+    wuffs_base__io_buffer                                   fFrameCountIOBuffer;
+    wuffs_base__frame_config                                fFrameCountFrameConfig;
+
     // If calling an fDecoder method returns an incomplete status, then
     // fDecoder is suspended in a coroutine (i.e. waiting on I/O or halted on a
     // non-recoverable error). To keep its internal proof-of-safety invariants
@@ -408,10 +446,20 @@ SkWuffsCodec::SkWuffsCodec(SkEncodedInfo&&
       fTwoPassPixbufLen(0),
       fNumFullyReceivedFrames(0),
       fFramesComplete(false),
+      fFrameCountDecoder(nullptr, &sk_free),
+      fFrameCountBuffer(nullptr, &sk_free),
+      fFrameCountIOBuffer(wuffs_base__empty_io_buffer()),
+      fFrameCountFrameConfig(wuffs_base__null_frame_config()),
       fDecoderIsSuspended(false),
       fCanSeek(canSeek) {
     fFrameHolder.init(this, imgcfg.pixcfg.width(), imgcfg.pixcfg.height());
 
+    // An iobuf that wraps the stream's memory stays valid as long as fStream.
+    if (wraps_stream_memory(&iobuf, fStream.get())) {
+        fIOBuffer = iobuf;
+        return;
+    }
+
     // Initialize fIOBuffer's fields, copying any outstanding data from iobuf to
     // fIOBuffer, as iobuf's backing array may not be valid for the lifetime of
     // this SkWuffsCodec object, but fIOBuffer's backing array (fBuffer) is.
@@ -782,69 +830,109 @@ int SkWuffsCodec::onGetFrameCount() {
 
     // It is valid, in terms of the SkCodec API, to call SkCodec::getFrameCount
     // while in an incremental decode (after onStartIncrementalDecode returns
-    // and before onIncrementalDecode returns kSuccess).
-    //
-    // We should not advance the SkWuffsCodec' stream while doing so, even
-    // though other SkCodec implementations can return increasing values from
-    // onGetFrameCount when given more data. If we tried to do so, the
-    // subsequent resume of the incremental decode would continue reading from
-    // a different position in the I/O stream, leading to an incorrect error.
-    //
-    // Other SkCodec implementations can move the stream forward during
-    // onGetFrameCount because they assume that the stream is rewindable /
-    // seekable. For example, an alternative GIF implementation may choose to
-    // store, for each frame walked past when merely counting the number of
-    // frames, the I/O position of each of the frame's GIF data blocks. (A GIF
-    // frame's compressed data can have multiple data blocks, each at most 255
-    // bytes in length). Obviously, this can require O(numberOfFrames) extra
-    // memory to store these I/O positions. The constant factor is small, but
-    // it's still O(N), not O(1).
+    // and before onIncrementalDecode returns kSuccess). Frames are counted by
+    // fFrameCountDecoder, not fDecoder, so this does not affect the decode in
+    // progress, other than moving the stream (which is moved back).
     //
     // Wuffs and SkWuffsCodec try to minimize relying on the rewindable /
     // seekable assumption. By design, Wuffs per se aims for O(1) memory use
     // (after any pixel buffers are allocated) instead of O(N), and its I/O
     // type, wuffs_base__io_buffer, is not necessarily rewindable or seekable.
-    //
-    // The Wuffs API provides a limited, optional form of seeking, to the start
-    // of an animation frame's data, but does not provide arbitrary save and
-    // load of its internal state whilst in the middle of an animation frame.
-    bool incrementalDecodeIsInProgress = fIncrDecDst != nullptr;
-
-    if (!fFramesComplete && !incrementalDecodeIsInProgress) {
+    // Keeping a suspended decoder for counting frames lets us pick up where
+    // we left off when more data arrives, without storing anything per frame
+    // beyond its SkWuffsFrame.
+    if (!fFramesComplete) {
         this->onGetFrameCountInternal();
-        this->updateNumFullyReceivedFrames();
     }
     return fFrames.size();
 }
 
+bool SkWuffsCodec::initFrameCountDecoder() {
+    void* decoder_raw = sk_malloc_canfail(sizeof__wuffs_gif__decoder());
+    if (!decoder_raw) {
+        return false;
+    }
+    fFrameCountDecoder.reset(reinterpret_cast<wuffs_gif__decoder*>(decoder_raw));
+
+    if (wraps_stream_memory(&fIOBuffer, fStream.get())) {
+        // Both decoders can read the stream's memory in place.
+        fFrameCountIOBuffer =
+            wuffs_base__make_io_buffer(fIOBuffer.data, wuffs_base__empty_io_buffer_meta());
+    } else {
+        fFrameCountBuffer.reset(
+            reinterpret_cast<uint8_t*>(sk_malloc_canfail(SK_WUFFS_CODEC_BUFFER_SIZE)));
+        if (!fFrameCountBuffer) {
+            return false;
+        }
+        fFrameCountIOBuffer = wuffs_base__make_io_buffer(
+            wuffs_base__make_slice_u8(fFrameCountBuffer.get(), SK_WUFFS_CODEC_BUFFER_SIZE),
+            wuffs_base__empty_io_buffer_meta());
+        if (!fStream->rewind()) {
+            return false;
+        }
+    }
+
+    // The image config was complete when this codec was made, so this only
+    // fails if we cannot read the stream again.
+    return reset_and_decode_image_config(fFrameCountDecoder.get(), nullptr, &fFrameCountIOBuffer,
+                                         fStream.get()) == SkCodec::kSuccess;
+}
+
 void SkWuffsCodec::onGetFrameCountInternal() {
-    size_t n = fFrames.size();
-    int    i = n ? n - 1 : 0;
-    if (this->seekFrame(i) != SkCodec::kSuccess) {
-        return;
+    const bool wrapsMemory = wraps_stream_memory(&fIOBuffer, fStream.get());
+    const size_t streamPosition = fStream->getPosition();
+
+    if (!fFrameCountDecoder) {
+        if (!this->initFrameCountDecoder()) {
+            fFrameCountDecoder.reset();
+            fFrameCountBuffer.reset();
+            if (!wrapsMemory) {
+                fStream->seek(streamPosition);
+            }
+            return;
+        }
+    } else if (!wrapsMemory) {
+        // Continue reading where fFrameCountDecoder stopped.
+        const wuffs_base__io_buffer_meta& meta = fFrameCountIOBuffer.meta;
+        if ((meta.pos + meta.wi > SIZE_MAX) || !fStream->seek(meta.pos + meta.wi)) {
+            fStream->seek(streamPosition);
+            return;
+        }
     }
 
     // Iterate through the frames, converting from Wuffs'
     // wuffs_base__frame_config type to Skia's SkWuffsFrame type.
-    for (; i < INT_MAX; i++) {
-        const char* status = this->decodeFrameConfig();
-        if (status == nullptr) {
-            // No-op.
-        } else if (status == wuffs_base__note__end_of_data) {
-            break;
+    while (true) {
+        wuffs_base__status status = fFrameCountDecoder->decode_frame_config(
+            &fFrameCountFrameConfig, &fFrameCountIOBuffer);
+        if (status.repr == nullptr) {
+            if (fFrameCountFrameConfig.index() == fFrames.size()) {
+                fFrames.emplace_back(&fFrameCountFrameConfig);
+                SkWuffsFrame* f = &fFrames[fFrames.size() - 1];
+                fFrameHolder.setAlphaAndRequiredFrame(f);
+            }
+        } else if (status.repr == wuffs_base__suspension__short_read) {
+            if (!fill_buffer(&fFrameCountIOBuffer, fStream.get())) {
+                // Wait, suspended, for more data.
+                break;
+            }
         } else {
-            return;
-        }
-
-        if (static_cast<size_t>(i) < fFrames.size()) {
-            continue;
+            // Either wuffs_base__note__end_of_data, or an error that more
+            // data will not fix.
+            fFramesComplete = true;
+            break;
         }
-        fFrames.emplace_back(&fFrameConfig);
-        SkWuffsFrame* f = &fFrames[fFrames.size() - 1];
-        fFrameHolder.setAlphaAndRequiredFrame(f);
+    }
+    this->updateNumFullyReceivedFrames(fFrameCountDecoder.get());
+    if (fFramesComplete) {
+        fFrameCountDecoder.reset();
+        fFrameCountBuffer.reset();
     }
 
-    fFramesComplete = true;
+    if (!wrapsMemory) {
+        // Put the stream back where fDecoder expects it.
+        fStream->seek(streamPosition);
+    }
 }
 
 bool SkWuffsCodec::onGetFrameInfo(int i, SkCodec::FrameInfo* frameInfo) const {
@@ -933,7 +1021,7 @@ const char* SkWuffsCodec::decodeFrameConfig() {
             continue;
         }
         fDecoderIsSuspended = !status.is_complete();
-        this->updateNumFullyReceivedFrames();
+        this->updateNumFullyReceivedFrames(fDecoder.get());
         return status.repr;
     }
 }
@@ -948,16 +1036,16 @@ const char* SkWuffsCodec::decodeFrame() {
             continue;
         }
         fDecoderIsSuspended = !status.is_complete();
-        this->updateNumFullyReceivedFrames();
+        this->updateNumFullyReceivedFrames(fDecoder.get());
         return status.repr;
     }
 }
 
-void SkWuffsCodec::updateNumFullyReceivedFrames() {
+void SkWuffsCodec::updateNumFullyReceivedFrames(wuffs_gif__decoder* decoder) {
     // num_decoded_frames's return value, n, can change over time, both up and
     // down, as we seek back and forth in the underlying stream.
     // fNumFullyReceivedFrames is the highest n we've seen.
-    uint64_t n = fDecoder->num_decoded_frames();
+    uint64_t n = decoder->num_decoded_frames();
     if (fNumFullyReceivedFrames < n) {
         fNumFullyReceivedFrames = n;
     }
@@ -996,6 +1084,12 @@ std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream> stream,
     wuffs_base__io_buffer iobuf =
         wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(buffer, SK_WUFFS_CODEC_BUFFER_SIZE),
                                    wuffs_base__empty_io_buffer_meta());
+    // io_buffer positions are stream positions, so only wrap memory that we are at the start of.
+    if (canSeek && stream->getMemoryBase() && stream->getPosition() == 0) {
+        uint8_t* memory = static_cast<uint8_t*>(const_cast<void*>(stream->getMemoryBase()));
+        iobuf = wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(memory, stream->getLength()),
+                                           wuffs_base__empty_io_buffer_meta());
+    }
     wuffs_base__image_config imgcfg = wuffs_base__null_image_config();
 
     // Wuffs is primarily a C library, not a C++ one. Furthermore, outside of
@@ -41,7 +41,8 @@ public:
                                         &fAlloc,
                                         drawCoverage,
                                         draw.fRC->clipShader(),
-                                        SkSurfacePropsCopyOrDefault(draw.fProps));
+                                        SkSurfacePropsCopyOrDefault(draw.fProps),
+                                        draw.fBlitterCache);
         return fBlitter;
     }
 
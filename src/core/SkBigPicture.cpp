@@ -14,7 +14,9 @@
 #include "src/core/SkRecordDraw.h"
 #include "src/core/SkRecords.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 SkBigPicture::SkBigPicture(const SkRect& cull,
                            sk_sp<SkRecord> record,
@@ -39,10 +41,82 @@ void SkBigPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
                  this->drawablePicts(),
                  nullptr,
                  this->drawableCount(),
-                 useBBH ? fBBH.get() : nullptr,
+                 useBBH ? this->playbackBBH() : nullptr,
                  callback);
 }
 
+void SkBigPicture::playbackRects(SkCanvas* canvas,
+                                 SkSpan<const SkRect> rects,
+                                 AbortCallback* callback) const {
+    SkASSERT(canvas);
+
+    const SkRect clipBounds = canvas->getLocalClipBounds();
+    const SkBBoxHierarchy* bbh =
+            clipBounds.contains(this->cullRect()) ? nullptr : this->playbackBBH();
+    if (!bbh) {
+        SkRecordDraw(*fRecord, canvas, this->drawablePicts(), nullptr, this->drawableCount(),
+                     nullptr, callback);
+        return;
+    }
+
+    // Query each rect on its own rather than their union, so ops between the rects are skipped,
+    // then merge the results so every op is drawn once, in order.
+    std::vector<int> ops;
+    for (const SkRect& rect : rects) {
+        SkRect query;
+        if (query.intersect(rect, clipBounds)) {
+            bbh->search(query, &ops);
+        }
+    }
+    std::sort(ops.begin(), ops.end());
+    ops.erase(std::unique(ops.begin(), ops.end()), ops.end());
+
+    SkAutoCanvasRestore saveRestore(canvas, /*doSave=*/true);
+    SkRecordDrawOps(*fRecord, canvas, this->drawablePicts(), nullptr, this->drawableCount(), ops,
+                    callback);
+}
+
+const SkBBoxHierarchy* SkBigPicture::playbackBBH() const {
+    if (fBBH) {
+        return fBBH.get();
+    }
+    // Building an SkRTree costs about as much as drawing every op once, so only do it for
+    // pictures that have been played back partially before and are likely to be again.
+    if (fRecord->count() < kMinOpsForLazyBBH ||
+        !fPlayedBackPartially.exchange(true, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    fLazyBBHOnce([this] {
+        const int count = fRecord->count();
+        skia_private::AutoTArray<SkRect> bounds(count);
+        skia_private::AutoTMalloc<SkBBoxHierarchy::Metadata> meta(count);
+        SkRecordFillBounds(fCullRect, *fRecord, bounds.data(), meta);
+
+        fLazyBBH = SkRTreeFactory()();
+        fLazyBBH->insert(bounds.data(), meta, count);
+    });
+    return fLazyBBH.get();
+}
+
+SkRect SkBigPicture::contentBounds() const {
+    if (fBBH) {
+        // SkPictureRecorder already trims the cull rect to the ops when there's a BBH.
+        return fCullRect;
+    }
+    fContentBoundsOnce([this] {
+        const int count = fRecord->count();
+        skia_private::AutoTArray<SkRect> bounds(count);
+        skia_private::AutoTMalloc<SkBBoxHierarchy::Metadata> meta(count);
+        SkRecordFillBounds(fCullRect, *fRecord, bounds.data(), meta);
+
+        fContentBounds.setEmpty();
+        for (int i = 0; i < count; i++) {
+            fContentBounds.join(bounds[i]);
+        }
+    });
+    return fContentBounds;
+}
+
 struct NestedApproxOpCounter {
     int fCount = 0;
 
@@ -12,10 +12,13 @@
 #include "include/core/SkPicture.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/private/base/SkNoncopyable.h"
+#include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/core/SkRecord.h"
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 
@@ -57,15 +60,38 @@ public:
     const SkBBoxHierarchy* bbh() const { return fBBH.get(); }
     const SkRecord*     record() const { return fRecord.get(); }
 
+// Used by SkPicture::playbackRects. The canvas is already clipped to the rects.
+    void playbackRects(SkCanvas*, SkSpan<const SkRect> rects, AbortCallback*) const;
+
+// Used by SkRecordDraw to bound nested pictures
+    // The union of the bounds of the ops. This is the cull rect for pictures recorded with a BBH,
+    // and is computed once on first use for those without, where it may be much tighter.
+    SkRect contentBounds() const;
+
 private:
+    friend class SkPictureDamage;
+
     int drawableCount() const;
     SkPicture const* const* drawablePicts() const;
 
+    // Pictures recorded without a BBH get an SkRTree once they are played back partially more
+    // than once, if they have at least this many ops.
+    static constexpr int kMinOpsForLazyBBH = 16;
+
+    // Returns the BBH to cull a partial playback with, or null to draw every op.
+    const SkBBoxHierarchy* playbackBBH() const;
+
     const SkRect                         fCullRect;
     const size_t                         fApproxBytesUsedBySubPictures;
     sk_sp<const SkRecord>                fRecord;
     std::unique_ptr<const SnapshotArray> fDrawablePicts;
     sk_sp<const SkBBoxHierarchy>         fBBH;
+
+    mutable SkOnce                       fContentBoundsOnce;
+    mutable SkRect                       fContentBounds;
+    mutable std::atomic<bool>            fPlayedBackPartially{false};
+    mutable SkOnce                       fLazyBBHOnce;
+    mutable sk_sp<SkBBoxHierarchy>       fLazyBBH;
 };
 
 #endif//SkBigPicture_DEFINED
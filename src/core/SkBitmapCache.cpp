@@ -14,6 +14,7 @@
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkMutex.h"
@@ -43,7 +44,7 @@ void SkNotifyBitmapGenIDIsStale(uint32_t bitmapGenID) {
 SkBitmapCacheDesc SkBitmapCacheDesc::Make(uint32_t imageID, const SkIRect& subset) {
     SkASSERT(imageID);
     SkASSERT(subset.width() > 0 && subset.height() > 0);
-    return { imageID, subset };
+    return { imageID, subset, {0, 0} };
 }
 
 SkBitmapCacheDesc SkBitmapCacheDesc::Make(const SkImage* image) {
@@ -51,6 +52,13 @@ SkBitmapCacheDesc SkBitmapCacheDesc::Make(const SkImage* image) {
     return Make(image->uniqueID(), bounds);
 }
 
+SkBitmapCacheDesc SkBitmapCacheDesc::MakeScaled(const SkImage* image, SkISize scaledSize) {
+    SkASSERT(!scaledSize.isEmpty());
+    SkBitmapCacheDesc desc = Make(image);
+    desc.fScaledSize = scaledSize;
+    return desc;
+}
+
 namespace {
 static unsigned gBitmapKeyNamespaceLabel;
 
@@ -9,6 +9,7 @@
 #define SkBitmapCache_DEFINED
 
 #include "include/core/SkRect.h"
+#include "include/core/SkSize.h"
 #include "include/private/base/SkAssert.h"
 
 #include <cstdint>
@@ -29,6 +30,7 @@ void SkNotifyBitmapGenIDIsStale(uint32_t bitmapGenID);
 struct SkBitmapCacheDesc {
     uint32_t    fImageID;       // != 0
     SkIRect     fSubset;        // always set to a valid rect (entire or subset)
+    SkISize     fScaledSize;    // empty, unless the pixels are the subset downscaled to this size
 
     void validate() const {
         SkASSERT(fImageID);
@@ -38,6 +40,7 @@ struct SkBitmapCacheDesc {
 
     static SkBitmapCacheDesc Make(const SkImage*);
     static SkBitmapCacheDesc Make(uint32_t genID, const SkIRect& subset);
+    static SkBitmapCacheDesc MakeScaled(const SkImage*, SkISize scaledSize);
 };
 
 class SkBitmapCache {
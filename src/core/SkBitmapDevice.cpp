@@ -30,12 +30,14 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkTLazy.h"
+#include "src/core/SkCoreBlitters.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkImagePriv.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/image/SkImage_Base.h"
+#include "src/image/SkImage_Lazy.h"
 #include "src/text/GlyphRun.h"
 
 #include <utility>
@@ -135,6 +137,7 @@ public:
         }
 
         fDraw.fProps = &fDevice->surfaceProps();
+        fDraw.fBlitterCache = fDevice->blitterCache();
     }
 
     bool needsTiling() const { return fNeedsTiling; }
@@ -210,6 +213,7 @@ public:
         }
         fCTM = &dev->localToDevice();
         fRC = &dev->fRCStack.rc();
+        fBlitterCache = dev->blitterCache();
     }
 };
 
@@ -245,6 +249,15 @@ SkBitmapDevice::SkBitmapDevice(const SkBitmap& bitmap, const SkSurfaceProps& sur
     SkASSERT(valid_for_bitmap_device(bitmap.info(), nullptr));
 }
 
+SkBitmapDevice::~SkBitmapDevice() = default;
+
+SkRasterPipelineBlitterCache* SkBitmapDevice::blitterCache() {
+    if (!fBlitterCache) {
+        fBlitterCache = std::make_unique<SkRasterPipelineBlitterCache>();
+    }
+    return fBlitterCache.get();
+}
+
 sk_sp<SkBitmapDevice> SkBitmapDevice::Create(const SkImageInfo& origInfo,
                                              const SkSurfaceProps& surfaceProps,
                                              SkRasterHandleAllocator* allocator) {
@@ -287,6 +300,7 @@ void SkBitmapDevice::replaceBitmapBackendForRasterSurface(const SkBitmap& bm) {
     SkASSERT(bm.width() == fBitmap.width());
     SkASSERT(bm.height() == fBitmap.height());
     fBitmap = bm;   // intent is to use bm's pixelRef (and rowbytes/config)
+    fBlitterCache.reset();  // its blitters point at the old pixels
 }
 
 sk_sp<SkDevice> SkBitmapDevice::createDevice(const CreateInfo& cinfo, const SkPaint* layerPaint) {
@@ -355,6 +369,14 @@ void SkBitmapDevice::drawRect(const SkRect& r, const SkPaint& paint) {
 }
 
 void SkBitmapDevice::drawOval(const SkRect& oval, const SkPaint& paint) {
+#if !defined(SK_IGNORE_BLURRED_RRECT_OPT) && !defined(SK_LEGACY_AA_RRECT_AS_PATH)
+    if (paint.isAntiAlias() && paint.getStyle() == SkPaint::kFill_Style &&
+        !paint.getPathEffect() && !paint.getMaskFilter()) {
+        // SkDrawBase::drawRRect fills antialiased ovals analytically.
+        this->drawRRect(SkRRect::MakeOval(oval), paint);
+        return;
+    }
+#endif
     // call the VIRTUAL version, so any subclasses who do handle drawPath aren't
     // required to override drawOval.
     this->drawPath(SkPath::Oval(oval), paint, true);
@@ -420,7 +442,42 @@ void SkBitmapDevice::drawImageRect(const SkImage* image, const SkRect* src, cons
     SkBitmap bitmap;
     // TODO: Elevate direct context requirement to public API and remove cheat.
     auto dContext = as_IB(image)->directContext();
-    if (!as_IB(image)->getROPixels(dContext, &bitmap)) {
+    SkRect adjustedSrc;
+    if (src && as_IB(image)->type() == SkImage_Base::Type::kLazy &&
+        sampling.mipmap == SkMipmapMode::kNone && !sampling.isAniso()) {
+        // Only decode the part of a lazy image that 'src' covers, plus the texels around it that
+        // filtering may read, and draw from that as if it were the whole image.
+        int filterRadius = 0;
+        if (sampling.useCubic) {
+            filterRadius = 2;
+        } else if (sampling.filter == SkFilterMode::kLinear) {
+            filterRadius = 1;
+        }
+        SkIRect subset = src->roundOut().makeOutset(filterRadius, filterRadius);
+        if (!static_cast<const SkImage_Lazy*>(image)->getROPixelsForSubset(
+                    dContext, &subset, &bitmap)) {
+            return;
+        }
+        adjustedSrc = src->makeOffset(-subset.fLeft, -subset.fTop);
+        src = &adjustedSrc;
+    } else if (as_IB(image)->type() == SkImage_Base::Type::kLazy &&
+               sampling.mipmap != SkMipmapMode::kNone && !sampling.isAniso()) {
+        // The draw filters through mip levels anyway, so a lazy image that is drawn much smaller
+        // can be decoded directly at a smaller size (e.g. with a JPEG's DCT scaling) instead.
+        SkMatrix srcToDevice = SkMatrix::RectToRect(src ? *src : SkRect::Make(image->bounds()),
+                                                    dst);
+        srcToDevice.postConcat(this->localToDevice());
+        if (!static_cast<const SkImage_Lazy*>(image)->getROPixelsForScale(
+                    dContext, srcToDevice.getMaxScale(), &bitmap)) {
+            return;
+        }
+        if (bitmap.dimensions() != image->dimensions()) {
+            adjustedSrc = SkMatrix::Scale(bitmap.width() / (float)image->width(),
+                                        bitmap.height() / (float)image->height())
+                                .mapRect(src ? *src : SkRect::Make(image->bounds()));
+            src = &adjustedSrc;
+        }
+    } else if (!as_IB(image)->getROPixels(dContext, &bitmap)) {
         return;
     }
 
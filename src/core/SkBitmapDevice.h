@@ -19,6 +19,7 @@
 #include "src/core/SkRasterClipStack.h"
 
 #include <cstddef>
+#include <memory>
 
 class SkBlender;
 class SkImage;
@@ -29,6 +30,7 @@ class SkPath;
 class SkPixmap;
 class SkRRect;
 class SkRasterHandleAllocator;
+class SkRasterPipelineBlitterCache;
 class SkRegion;
 class SkShader;
 class SkSpecialImage;
@@ -59,6 +61,8 @@ public:
     SkBitmapDevice(const SkBitmap& bitmap, const SkSurfaceProps& surfaceProps,
                    void* externalHandle = nullptr);
 
+    ~SkBitmapDevice() override;
+
     static sk_sp<SkBitmapDevice> Create(const SkImageInfo&, const SkSurfaceProps&,
                                         SkRasterHandleAllocator* = nullptr);
 
@@ -143,10 +147,14 @@ private:
     void drawBitmap(const SkBitmap&, const SkMatrix&, const SkRect* dstOrNull,
                     const SkSamplingOptions&, const SkPaint&);
 
+    SkRasterPipelineBlitterCache* blitterCache();
+
     SkBitmap    fBitmap;
     void*       fRasterHandle = nullptr;
     SkRasterClipStack  fRCStack;
     SkGlyphRunListPainterCPU fGlyphPainter;
+    // Created on first draw.
+    std::unique_ptr<SkRasterPipelineBlitterCache> fBlitterCache;
 };
 
 #endif // SkBitmapDevice_DEFINED
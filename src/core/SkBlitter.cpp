@@ -688,7 +688,8 @@ SkBlitter* SkBlitter::Choose(const SkPixmap& device,
                              SkArenaAlloc* alloc,
                              bool drawCoverage,
                              sk_sp<SkShader> clipShader,
-                             const SkSurfaceProps& props) {
+                             const SkSurfaceProps& props,
+                             SkRasterPipelineBlitterCache* cache) {
     SkASSERT(alloc);
 
     if (kUnknown_SkColorType == device.colorType()) {
@@ -741,6 +742,11 @@ SkBlitter* SkBlitter::Choose(const SkPixmap& device,
     }
 
     auto CreateSkRPBlitter = [&]() -> SkBlitter* {
+        if (cache && !clipShader) {
+            if (SkBlitter* cached = cache->find(device, *paint)) {
+                return cached;
+            }
+        }
         auto blitter = SkCreateRasterPipelineBlitter(device, *paint, ctm, alloc, clipShader, props);
         return blitter ? blitter
                        : alloc->make<SkNullBlitter>();
@@ -24,6 +24,7 @@ class SkArenaAlloc;
 class SkMatrix;
 class SkPaint;
 class SkPixmap;
+class SkRasterPipelineBlitterCache;
 class SkShader;
 class SkSurfaceProps;
 struct SkMask;
@@ -139,7 +140,8 @@ public:
     ///@}
 
     /** @name Factories
-        Return the correct blitter to use given the specified context.
+        Return the correct blitter to use given the specified context. If a cache is passed,
+        raster pipeline blitters for solid colors may be returned from it instead of alloc.
      */
     static SkBlitter* Choose(const SkPixmap& dst,
                              const SkMatrix& ctm,
@@ -147,7 +149,8 @@ public:
                              SkArenaAlloc*,
                              bool drawCoverage,
                              sk_sp<SkShader> clipShader,
-                             const SkSurfaceProps& props);
+                             const SkSurfaceProps& props,
+                             SkRasterPipelineBlitterCache* cache = nullptr);
 
     static SkBlitter* ChooseSprite(const SkPixmap& dst,
                                    const SkPaint&,
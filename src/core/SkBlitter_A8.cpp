@@ -289,7 +289,8 @@ SkBlitter* SkA8Blitter_Choose(const SkPixmap& dst,
                               SkArenaAlloc* alloc,
                               bool drawCoverage,
                               sk_sp<SkShader> clipShader,
-                              const SkSurfaceProps&) {
+                              const SkSurfaceProps&,
+                              SkRasterPipelineBlitterCache*) {
     if (dst.colorType() != SkColorType::kAlpha_8_SkColorType) {
         return nullptr;
     }
@@ -18,6 +18,7 @@
 class SkArenaAlloc;
 class SkMatrix;
 class SkPaint;
+class SkRasterPipelineBlitterCache;
 class SkShader;
 class SkSurfaceProps;
 struct SkIRect;
@@ -42,6 +43,7 @@ SkBlitter* SkA8Blitter_Choose(const SkPixmap& dst,
                               SkArenaAlloc*,
                               bool drawCoverage,
                               sk_sp<SkShader> clipShader,
-                              const SkSurfaceProps&);
+                              const SkSurfaceProps&,
+                              SkRasterPipelineBlitterCache*);
 
 #endif // SkBlitter_A8_DEFINED
@@ -40,7 +40,9 @@
 #include "include/private/chromium/Slug.h"
 #include "include/utils/SkNoDrawCanvas.h"
 #include "src/base/SkEnumBitMask.h"
+#include "src/base/SkMathPriv.h"
 #include "src/base/SkMSAN.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkBlenderBase.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkDevice.h"
@@ -231,6 +233,7 @@ public:
         // pre-condition, fQuickRejectBounds and other state should be valid before anything
         // modifies the device's clip.
         fCanvas->validateClip();
+        fCanvas->fMCRec->fClipChanged = true;
     }
     ~AutoUpdateQRBounds() {
         fCanvas->fQuickRejectBounds = fCanvas->computeDeviceClipBounds();
@@ -714,6 +717,12 @@ static skif::FilterResult apply_alpha_and_colorfilter(const skif::Context& ctx,
     return result;
 }
 
+// Image filter outputs wider or taller than this are evaluated in tiles of at most this size.
+#if !defined(SK_MAX_IMAGE_FILTER_TILE_SIZE)
+    #define SK_MAX_IMAGE_FILTER_TILE_SIZE 4096
+#endif
+static constexpr int kMaxImageFilterTileSize = SK_MAX_IMAGE_FILTER_TILE_SIZE;
+
 void SkCanvas::internalDrawDeviceWithFilter(SkDevice* src,
                                             SkDevice* dst,
                                             FilterSpan filters,
@@ -880,23 +889,59 @@ void SkCanvas::internalDrawDeviceWithFilter(SkDevice* src,
     sk_sp<SkImageFilter> nullFilter;
     FilterSpan filtersOrNull = filters.empty() ? FilterSpan{&nullFilter, 1} : filters;
 
+    // Very large outputs (e.g. printing or rasterizing a huge PDF page) are filtered one device
+    // space tile at a time. Each filter in the DAG only produces what is needed for the tile's
+    // desired output (plus the halo its own inputs require), so the intermediate images stay
+    // bounded by the tile size instead of by the whole output.
+    const SkIRect fullOutput = SkIRect(outputBounds);
+    const int tileCountX = (fullOutput.width() + kMaxImageFilterTileSize - 1) /
+                           kMaxImageFilterTileSize;
+    const int tileCountY = (fullOutput.height() + kMaxImageFilterTileSize - 1) /
+                           kMaxImageFilterTileSize;
+    const bool tiled = tileCountX > 1 || tileCountY > 1;
+
     for (const sk_sp<SkImageFilter>& filter : filtersOrNull) {
-        auto result = filter ? as_IFB(filter)->filterImage(ctx) : source;
-
-        if (srcIsCoverageLayer) {
-            SkASSERT(dst->useDrawCoverageMaskForMaskFilters());
-            // TODO: Can FilterResult optimize this in any meaningful way if it still has to go
-            // through drawCoverageMask that requires an image (vs a coverage shader)?
-            auto [coverageMask, origin] = result.imageAndOffset(ctx);
-            if (coverageMask) {
-                SkMatrix deviceMatrixWithOffset = mapping.layerToDevice();
-                deviceMatrixWithOffset.preTranslate(origin.x(), origin.y());
-                dst->drawCoverageMask(
-                        coverageMask.get(), deviceMatrixWithOffset, result.sampling(), paint);
+        for (int tileIndex = 0; tileIndex < tileCountX * tileCountY; ++tileIndex) {
+            skif::Context tileCtx = ctx;
+            if (tiled) {
+                const int tileX = tileIndex % tileCountX;
+                const int tileY = tileIndex / tileCountX;
+                SkIRect tile = SkIRect::MakeXYWH(fullOutput.fLeft + tileX * kMaxImageFilterTileSize,
+                                                 fullOutput.fTop + tileY * kMaxImageFilterTileSize,
+                                                 kMaxImageFilterTileSize,
+                                                 kMaxImageFilterTileSize);
+                SkAssertResult(tile.intersect(fullOutput));
+                tileCtx = ctx.withNewDesiredOutput(
+                        mapping.deviceToLayer(skif::DeviceSpace<SkIRect>(tile)));
+
+                // Results may extend past the tile, so clip each tile's draw to keep the tiles
+                // from overlapping. The tile is in device space, so clip with an identity matrix.
+                dst->pushClipStack();
+                SkAutoDeviceTransformRestore adtr(dst, SkMatrix::I());
+                dst->clipRect(SkRect::Make(tile), SkClipOp::kIntersect, /*aa=*/false);
+            }
+
+            auto result = filter ? as_IFB(filter)->filterImage(tileCtx) : source;
+
+            if (srcIsCoverageLayer) {
+                SkASSERT(dst->useDrawCoverageMaskForMaskFilters());
+                // TODO: Can FilterResult optimize this in any meaningful way if it still has to go
+                // through drawCoverageMask that requires an image (vs a coverage shader)?
+                auto [coverageMask, origin] = result.imageAndOffset(tileCtx);
+                if (coverageMask) {
+                    SkMatrix deviceMatrixWithOffset = mapping.layerToDevice();
+                    deviceMatrixWithOffset.preTranslate(origin.x(), origin.y());
+                    dst->drawCoverageMask(
+                            coverageMask.get(), deviceMatrixWithOffset, result.sampling(), paint);
+                }
+            } else {
+                result = apply_alpha_and_colorfilter(tileCtx, result, paint);
+                result.draw(tileCtx, dst, paint.getBlender());
+            }
+
+            if (tiled) {
+                dst->popClipStack();
             }
-        } else {
-            result = apply_alpha_and_colorfilter(ctx, result, paint);
-            result.draw(ctx, dst, paint.getBlender());
         }
     }
 
@@ -1456,6 +1501,8 @@ void SkCanvas::internalRestore() {
     // now detach these from fMCRec so we can pop(). Gets freed after its drawn
     std::unique_ptr<Layer> layer = std::move(fMCRec->fLayer);
     std::unique_ptr<BackImage> backImage = std::move(fMCRec->fBackImage);
+    // A plain save() that didn't touch the clip leaves the quick-reject bounds as they were.
+    const bool clipMayHaveChanged = fMCRec->fClipChanged || layer || backImage;
 
     // now do the normal restore()
     fMCRec->~MCRec();       // balanced in save()
@@ -1514,7 +1561,9 @@ void SkCanvas::internalRestore() {
     }
     // Update the quick-reject bounds in case the restore changed the top device or the
     // removed save record had included modifications to the clip stack.
-    fQuickRejectBounds = this->computeDeviceClipBounds();
+    if (clipMayHaveChanged) {
+        fQuickRejectBounds = this->computeDeviceClipBounds();
+    }
     this->validateClip();
 }
 
@@ -1645,6 +1694,14 @@ void SkCanvas::concat(const SkMatrix& matrix) {
     if (matrix.isIdentity()) {
         return;
     }
+    if (matrix.isTranslate()) {
+        // Only the last column of the CTM changes, so skip the full 4x4 multiply.
+        this->checkForDeferredSave();
+        fMCRec->fMatrix.preTranslate(matrix.getTranslateX(), matrix.getTranslateY());
+        this->topDevice()->setGlobalCTM(fMCRec->fMatrix);
+        this->didConcat44(SkM44(matrix));
+        return;
+    }
     this->concat(SkM44(matrix));
 }
 
@@ -1894,6 +1951,63 @@ bool SkCanvas::quickReject(const SkPath& path) const {
     return path.isEmpty() || this->quickReject(path.getBounds());
 }
 
+int SkCanvas::quickRejectRects(SkSpan<const SkRect> rects, const SkMatrix& matrix,
+                               SkSpan<uint32_t> visible) const {
+#ifdef SK_DEBUG
+    this->validateClip();
+#endif
+    SkASSERT(visible.size() >= (rects.size() + 31) / 32);
+
+    const size_t count = std::min(rects.size(), visible.size() * 32);
+    std::fill_n(visible.data(), (count + 31) / 32, 0);
+
+    SkM44 total = fMCRec->fMatrix;
+    total.preConcat(matrix);
+
+    const SkRect& qr = fQuickRejectBounds;
+    auto isVisible = [&qr](const SkRect& devRect) {
+        return devRect.isFinite() && devRect.intersects(qr);
+    };
+
+    int visibleCount = 0;
+    size_t i = 0;
+    const bool hasPerspective = total.rc(3,0) != 0 || total.rc(3,1) != 0 ||
+                                total.rc(3,2) != 0 || total.rc(3,3) != 1;
+    if (!hasPerspective) {
+        // Maps four rects per iteration, computing each corner in the same order as
+        // SkMatrixPriv::MapRect() does, so the result matches quickReject() exactly.
+        const float sx = total.rc(0,0), kx = total.rc(0,1), tx = total.rc(0,3),
+                    ky = total.rc(1,0), sy = total.rc(1,1), ty = total.rc(1,3);
+        for (; i + 4 <= count; i += 4) {
+            skvx::float4 l, t, r, b;
+            skvx::strided_load4(&rects[i].fLeft, l, t, r, b);
+
+            auto x0 = sx*l + kx*t, x1 = sx*r + kx*t, x2 = sx*l + kx*b, x3 = sx*r + kx*b;
+            auto y0 = ky*l + sy*t, y1 = ky*r + sy*t, y2 = ky*l + sy*b, y3 = ky*r + sy*b;
+            auto minX = tx + min(min(x0, x1), min(x2, x3)),
+                 maxX = tx + max(max(x0, x1), max(x2, x3)),
+                 minY = ty + min(min(y0, y1), min(y2, y3)),
+                 maxY = ty + max(max(y0, y1), max(y2, y3));
+
+            // Like SkRect::isFinite() and SkRect::intersects(); NaN and infinite lanes fail both.
+            auto finite = (minX*0 + minY*0 + maxX*0 + maxY*0) == 0;
+            auto hit = finite & (max(minX, qr.fLeft) < min(maxX, qr.fRight)) &
+                                (max(minY, qr.fTop) < min(maxY, qr.fBottom));
+
+            const uint32_t bits = (hit[0] & 1) | (hit[1] & 2) | (hit[2] & 4) | (hit[3] & 8);
+            visible[i / 32] |= bits << (i % 32);
+            visibleCount += SkPopCount(bits);
+        }
+    }
+    for (; i < count; ++i) {
+        if (isVisible(SkMatrixPriv::MapRect(total, rects[i]))) {
+            visible[i / 32] |= 1u << (i % 32);
+            ++visibleCount;
+        }
+    }
+    return visibleCount;
+}
+
 bool SkCanvas::internalQuickReject(const SkRect& bounds, const SkPaint& paint,
                                    const SkMatrix* matrix) {
     if (!bounds.isFinite() || paint.nothingToDraw()) {
@@ -2209,6 +2323,21 @@ void SkCanvas::experimental_DrawEdgeAAImageSet(const ImageSetEntry imageSet[], i
                                 constraint);
 }
 
+void SkCanvas::experimental_DrawBulk(const BulkSet& set, const SkSamplingOptions& sampling,
+                                     const SkPaint& paint) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    if (set.fCount <= 0 || !set.fItems || !set.fRects) {
+        return;
+    }
+    for (int i = 0; i < set.fCount; ++i) {
+        if ((set.fItems[i] == BulkItem::kRRect && !set.fRadii) ||
+            (set.fItems[i] == BulkItem::kImageRect && (!set.fImage || !set.fSrcRects))) {
+            return;
+        }
+    }
+    this->onDrawBulk(set, sampling, paint);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //  These are the virtual drawing methods
 //////////////////////////////////////////////////////////////////////////////
@@ -2991,6 +3120,55 @@ void SkCanvas::onDrawEdgeAAQuad(const SkRect& r, const SkPoint clip[4], QuadAAFl
     }
 }
 
+void SkCanvas::onDrawBulk(const BulkSet& set, const SkSamplingOptions& sampling,
+                          const SkPaint& paint) {
+    // Canvases without pixels of their own (e.g. recorders) get the entries as the separate draws
+    // that they already handle. Image filters are applied to each entry separately too.
+    if (this->topDevice()->isNoPixelsDevice() || paint.getImageFilter()) {
+        SkPaint entryPaint = paint;
+        for (int i = 0; i < set.fCount; ++i) {
+            if (set.fColors) {
+                entryPaint.setColor4f(set.fColors[i]);
+            }
+            const SkRect& rect = set.fRects[i];
+            switch (set.fItems[i]) {
+                case BulkItem::kRect:
+                    this->drawRect(rect, entryPaint);
+                    break;
+                case BulkItem::kRRect:
+                    this->drawRRect(SkRRect::MakeRectXY(rect, set.fRadii[i].fX, set.fRadii[i].fY),
+                                    entryPaint);
+                    break;
+                case BulkItem::kImageRect:
+                    this->drawImageRect(set.fImage, set.fSrcRects[i], rect, sampling, &entryPaint,
+                                        kFast_SrcRectConstraint);
+                    break;
+            }
+        }
+        return;
+    }
+
+    // The paint's own color doesn't matter when every entry replaces it.
+    SkPaint realPaint = paint;
+    if (set.fColors) {
+        realPaint.setAlphaf(1.f);
+    }
+
+    SkRect bounds = set.fRects[0];
+    for (int i = 1; i < set.fCount; ++i) {
+        SkASSERT(set.fRects[i].isSorted());
+        bounds.joinPossiblyEmptyRect(set.fRects[i]);
+    }
+    if (this->internalQuickReject(bounds, realPaint)) {
+        return;
+    }
+
+    auto layer = this->aboutToDraw(realPaint, &bounds);
+    if (layer) {
+        this->topDevice()->drawBulk(set, sampling, layer->paint());
+    }
+}
+
 void SkCanvas::onDrawEdgeAAImageSet2(const ImageSetEntry imageSet[], int count,
                                      const SkPoint dstClips[], const SkMatrix preViewMatrices[],
                                      const SkSamplingOptions& sampling, const SkPaint* paint,
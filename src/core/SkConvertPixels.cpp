@@ -7,6 +7,7 @@
 #include "src/core/SkConvertPixels.h"
 
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkSize.h"
 #include "include/private/SkColorData.h"
@@ -19,45 +20,52 @@
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkSwizzlePriv.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
-#include <initializer_list>
 
-static bool rect_memcpy(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
-                        const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
-                        const SkColorSpaceXformSteps& steps) {
+using Strategy = SkPixelConverter::Strategy;
+
+static Strategy choose_strategy(const SkColorInfo& dstInfo,
+                                const SkColorInfo& srcInfo,
+                                const SkColorSpaceXformSteps& steps) {
     // We can copy the pixels when no color type, alpha type, or color space changes.
-    if (dstInfo.colorType() != srcInfo.colorType()) {
-        return false;
-    }
-    if (dstInfo.colorType() != kAlpha_8_SkColorType
-            && steps.flags.mask() != 0b00000) {
-        return false;
+    if (dstInfo.colorType() == srcInfo.colorType() &&
+        (dstInfo.colorType() == kAlpha_8_SkColorType || steps.flags.mask() == 0b00000)) {
+        return Strategy::kRectMemcpy;
     }
 
-    SkRectMemcpy(dstPixels, dstRB,
-                 srcPixels, srcRB, dstInfo.minRowBytes(), dstInfo.height());
-    return true;
-}
-
-static bool swizzle_or_premul(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
-                              const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
-                              const SkColorSpaceXformSteps& steps) {
     auto is_8888 = [](SkColorType ct) {
         return ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType;
     };
-    if (!is_8888(dstInfo.colorType()) ||
-        !is_8888(srcInfo.colorType()) ||
-        steps.flags.linearize         ||
-        steps.flags.gamut_transform   ||
+    if (is_8888(dstInfo.colorType()) &&
+        is_8888(srcInfo.colorType()) &&
+        !steps.flags.linearize       &&
+        !steps.flags.gamut_transform &&
 #if !defined(SK_ARM_HAS_NEON)
-        steps.flags.unpremul          ||
+        !steps.flags.unpremul        &&
 #endif
-        steps.flags.encode) {
-        return false;
+        !steps.flags.encode) {
+        return Strategy::kSwizzleOrPremul;
+    }
+
+    if (dstInfo.colorType() == kAlpha_8_SkColorType) {
+        return Strategy::kConvertToAlpha8;
     }
+    return Strategy::kPipeline;
+}
 
+static void rect_memcpy(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
+                        const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB) {
+    SkRectMemcpy(dstPixels, dstRB,
+                 srcPixels, srcRB, dstInfo.minRowBytes(), dstInfo.height());
+}
+
+static void swizzle_or_premul(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
+                              const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                              const SkColorSpaceXformSteps& steps) {
     const bool swapRB = dstInfo.colorType() != srcInfo.colorType();
 
     void (*fn)(uint32_t*, const uint32_t*, int) = nullptr;
@@ -79,15 +87,11 @@ static bool swizzle_or_premul(const SkImageInfo& dstInfo,       void* dstPixels,
         dstPixels = SkTAddOffset<void>(dstPixels, dstRB);
         srcPixels = SkTAddOffset<const void>(srcPixels, srcRB);
     }
-    return true;
 }
 
-static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size_t dstRB,
-                              const SkImageInfo& srcInfo, const void*  src, size_t srcRB,
-                              const SkColorSpaceXformSteps&) {
-    if (dstInfo.colorType() != kAlpha_8_SkColorType) {
-        return false;
-    }
+static void convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size_t dstRB,
+                              const SkImageInfo& srcInfo, const void*  src, size_t srcRB) {
+    SkASSERT(dstInfo.colorType() == kAlpha_8_SkColorType);
     auto dst = (uint8_t*)vdst;
 
     switch (srcInfo.colorType()) {
@@ -96,7 +100,7 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
             // Unknown should never happen.
             // Alpha8 should have been handled by rect_memcpy().
             SkASSERT(false);
-            return false;
+            return;
         }
 
         case kA16_unorm_SkColorType: {
@@ -108,7 +112,7 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
                 dst = SkTAddOffset<uint8_t>(dst, dstRB);
                 src16 = SkTAddOffset<const uint16_t>(src16, srcRB);
             }
-            return true;
+            return;
         }
 
         case kGray_8_SkColorType:
@@ -125,7 +129,7 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
                memset(dst, 0xFF, srcInfo.width());
                dst = SkTAddOffset<uint8_t>(dst, dstRB);
             }
-            return true;
+            return;
         }
 
         case kARGB_4444_SkColorType: {
@@ -137,7 +141,7 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
                 dst = SkTAddOffset<uint8_t>(dst, dstRB);
                 src16 = SkTAddOffset<const uint16_t>(src16, srcRB);
             }
-            return true;
+            return;
         }
 
         case kBGRA_8888_SkColorType:
@@ -151,7 +155,7 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
                 dst = SkTAddOffset<uint8_t>(dst, dstRB);
                 src32 = SkTAddOffset<const uint32_t>(src32, srcRB);
             }
-            return true;
+            return;
         }
 
         case kRGBA_1010102_SkColorType:
@@ -164,7 +168,7 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
                 dst = SkTAddOffset<uint8_t>(dst, dstRB);
                 src32 = SkTAddOffset<const uint32_t>(src32, srcRB);
             }
-            return true;
+            return;
         }
 
         case kRGBA_F16Norm_SkColorType:
@@ -177,7 +181,7 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
                 dst = SkTAddOffset<uint8_t>(dst, dstRB);
                 src64 = SkTAddOffset<const uint64_t>(src64, srcRB);
             }
-            return true;
+            return;
         }
 
         case kRGBA_F32_SkColorType: {
@@ -189,7 +193,7 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
                 dst  = SkTAddOffset<uint8_t>(dst, dstRB);
                 rgba = SkTAddOffset<const float>(rgba, srcRB);
             }
-            return true;
+            return;
         }
 
         case kA16_float_SkColorType: {
@@ -201,7 +205,7 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
                 dst = SkTAddOffset<uint8_t>(dst, dstRB);
                 srcF16 = SkTAddOffset<const uint16_t>(srcF16, srcRB);
             }
-            return true;
+            return;
         }
 
         case kRGBA_10x6_SkColorType:
@@ -214,10 +218,9 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
                 dst = SkTAddOffset<uint8_t>(dst, dstRB);
                 src64 = SkTAddOffset<const uint64_t>(src64, srcRB);
             }
-            return true;
+            return;
         }
     }
-    return false;
 }
 
 // Default: Use the pipeline.
@@ -234,26 +237,135 @@ static void convert_with_pipeline(const SkImageInfo& dstInfo, void* dstRow, int
     pipeline.run(0,0, srcInfo.width(), srcInfo.height());
 }
 
+static void convert_pixels(Strategy strategy,
+                           const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
+                           const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                           const SkColorSpaceXformSteps& steps) {
+    switch (strategy) {
+        case Strategy::kRectMemcpy:
+            rect_memcpy(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB);
+            break;
+        case Strategy::kSwizzleOrPremul:
+            swizzle_or_premul(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps);
+            break;
+        case Strategy::kConvertToAlpha8:
+            convert_to_alpha8(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB);
+            break;
+        case Strategy::kPipeline:
+            convert_with_pipeline(dstInfo, dstPixels, (int)(dstRB / dstInfo.bytesPerPixel()),
+                                  srcInfo, srcPixels, (int)(srcRB / srcInfo.bytesPerPixel()),
+                                  steps);
+            break;
+    }
+}
+
+// The pipeline's memory contexts measure rows in pixels, so row bytes must be a whole number of them.
+static bool has_pixel_stride(const SkColorInfo& info, size_t rowBytes) {
+    int stride = (int)(rowBytes / info.bytesPerPixel());
+    return (size_t)stride * info.bytesPerPixel() == rowBytes;
+}
+
+// Splits a conversion into bands of rows which run in parallel on 'executor'. Returns false,
+// without converting anything, if the conversion is too small to be worth splitting.
+static bool convert_pixels_in_bands(Strategy strategy,
+                                    const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
+                                    const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                                    const SkColorSpaceXformSteps& steps,
+                                    SkExecutor* executor) {
+    // Splitting a conversion only pays off when each band is big enough to hide the cost of
+    // building its own pipeline and of handing it to another thread.
+    static constexpr int kMinPixelsPerBand = 64 * 1024;
+    static constexpr int kMaxBands = 8;
+    if (!executor) {
+        return false;
+    }
+    const SkISize dimensions = dstInfo.dimensions();
+    int bands = (int)std::min<int64_t>(dimensions.area() / kMinPixelsPerBand, kMaxBands);
+    bands = std::min(bands, dimensions.height());
+    if (bands <= 1) {
+        return false;
+    }
+
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(bands, [&](int band) {
+        const int top = dimensions.height() * band / bands;
+        const int bottom = dimensions.height() * (band + 1) / bands;
+        const SkISize bandSize = {dimensions.width(), bottom - top};
+        convert_pixels(strategy,
+                       dstInfo.makeDimensions(bandSize),
+                       SkTAddOffset<void>(dstPixels, top * dstRB), dstRB,
+                       srcInfo.makeDimensions(bandSize),
+                       SkTAddOffset<const void>(srcPixels, top * srcRB), srcRB,
+                       steps);
+    });
+    taskGroup.wait();
+    return true;
+}
+
 bool SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
-                     const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB) {
+                     const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                     SkExecutor* executor) {
     SkASSERT(dstInfo.dimensions() == srcInfo.dimensions());
     SkASSERT(SkImageInfoValidConversion(dstInfo, srcInfo));
 
-    int srcStride = (int)(srcRB / srcInfo.bytesPerPixel());
-    int dstStride = (int)(dstRB / dstInfo.bytesPerPixel());
-    if ((size_t)srcStride * srcInfo.bytesPerPixel() != srcRB ||
-        (size_t)dstStride * dstInfo.bytesPerPixel() != dstRB) {
+    if (!has_pixel_stride(srcInfo.colorInfo(), srcRB) ||
+        !has_pixel_stride(dstInfo.colorInfo(), dstRB)) {
         return false;
     }
 
     SkColorSpaceXformSteps steps{srcInfo.colorSpace(), srcInfo.alphaType(),
                                  dstInfo.colorSpace(), dstInfo.alphaType()};
+    Strategy strategy = choose_strategy(dstInfo.colorInfo(), srcInfo.colorInfo(), steps);
+    if (!convert_pixels_in_bands(strategy, dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB,
+                                 steps, executor)) {
+        convert_pixels(strategy, dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps);
+    }
+    return true;
+}
 
-    for (auto fn : {rect_memcpy, swizzle_or_premul, convert_to_alpha8}) {
-        if (fn(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps)) {
-            return true;
-        }
+SkPixelConverter::SkPixelConverter(const SkColorInfo& dstInfo, const SkColorInfo& srcInfo)
+        : fDstInfo(dstInfo)
+        , fSrcInfo(srcInfo)
+        , fSteps(srcInfo, dstInfo) {
+    fValid = SkImageInfoValidConversion(SkImageInfo::Make({1, 1}, dstInfo),
+                                        SkImageInfo::Make({1, 1}, srcInfo));
+    if (!fValid) {
+        return;
+    }
+    fStrategy = choose_strategy(fDstInfo, fSrcInfo, fSteps);
+    if (fStrategy == Strategy::kPipeline) {
+        SkRasterPipeline pipeline(&fAlloc);
+        pipeline.appendLoad(fSrcInfo.colorType(), &fSrcCtx);
+        fSteps.apply(&pipeline);
+        pipeline.appendStore(fDstInfo.colorType(), &fDstCtx);
+        fPipeline = pipeline.compile();
+    }
+}
+
+bool SkPixelConverter::convert(SkISize dimensions,
+                               void* dstPixels, size_t dstRB,
+                               const void* srcPixels, size_t srcRB,
+                               SkExecutor* executor) {
+    if (!fValid || !has_pixel_stride(fSrcInfo, srcRB) || !has_pixel_stride(fDstInfo, dstRB)) {
+        return false;
+    }
+    if (dimensions.isEmpty()) {
+        return true;
+    }
+
+    const SkImageInfo dstInfo = SkImageInfo::Make(dimensions, fDstInfo),
+                      srcInfo = SkImageInfo::Make(dimensions, fSrcInfo);
+    if (convert_pixels_in_bands(fStrategy, dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB,
+                                fSteps, executor)) {
+        return true;
+    }
+
+    if (fStrategy == Strategy::kPipeline) {
+        fSrcCtx = {const_cast<void*>(srcPixels), (int)(srcRB / fSrcInfo.bytesPerPixel())};
+        fDstCtx = {dstPixels, (int)(dstRB / fDstInfo.bytesPerPixel())};
+        fPipeline(0, 0, dimensions.width(), dimensions.height());
+        return true;
     }
-    convert_with_pipeline(dstInfo, dstPixels, dstStride, srcInfo, srcPixels, srcStride, steps);
+    convert_pixels(fStrategy, dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, fSteps);
     return true;
 }
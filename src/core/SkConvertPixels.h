@@ -8,12 +8,74 @@
 #ifndef SkConvertPixels_DEFINED
 #define SkConvertPixels_DEFINED
 
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkSize.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkColorSpaceXformSteps.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+
 #include <cstddef>
+#include <functional>
 
-struct SkImageInfo;
+class SkExecutor;
 
+/**
+ * Converts pixels from src to dst. If an executor is passed, large conversions are split into bands
+ * of rows which run in parallel; the call still returns only once every row has been converted.
+ */
 [[nodiscard]] bool SkConvertPixels(
         const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRowBytes,
-        const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRowBytes);
+        const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRowBytes,
+        SkExecutor* executor = nullptr);
+
+/**
+ * Converts pixels between a fixed pair of color types, alpha types and color spaces, like
+ * SkConvertPixels. The conversion method, and its raster pipeline if one is needed, are chosen
+ * once up front, so repeated small conversions (e.g. reading back many tiles) skip that setup.
+ *
+ * convert() must not be called from multiple threads at once, but a single large conversion can
+ * be split across an executor.
+ */
+class SkPixelConverter {
+public:
+    SkPixelConverter(const SkColorInfo& dstInfo, const SkColorInfo& srcInfo);
+
+    SkPixelConverter(const SkPixelConverter&) = delete;
+    SkPixelConverter& operator=(const SkPixelConverter&) = delete;
+
+    /** Returns false if either color info can't be used for a conversion. */
+    bool isValid() const { return fValid; }
+
+    /**
+     * Converts 'dimensions' pixels. If an executor is passed, tall conversions are split into
+     * bands of rows which run in parallel. Returns false if the converter isn't valid, or if a row
+     * stride isn't a multiple of its pixel size.
+     */
+    [[nodiscard]] bool convert(SkISize dimensions,
+                               void* dstPixels, size_t dstRowBytes,
+                               const void* srcPixels, size_t srcRowBytes,
+                               SkExecutor* executor = nullptr);
+
+    enum class Strategy {
+        kRectMemcpy,
+        kSwizzleOrPremul,
+        kConvertToAlpha8,
+        kPipeline,
+    };
+
+private:
+    SkColorInfo fDstInfo;
+    SkColorInfo fSrcInfo;
+    SkColorSpaceXformSteps fSteps;
+    Strategy fStrategy = Strategy::kPipeline;
+    bool fValid = false;
+
+    // The compiled pipeline reads and temporarily modifies these contexts, so it can only run one
+    // conversion at a time. Conversions split across an executor build a pipeline per band.
+    SkRasterPipeline_MemoryCtx fDstCtx = {nullptr, 0};
+    SkRasterPipeline_MemoryCtx fSrcCtx = {nullptr, 0};
+    SkSTArenaAlloc<1024> fAlloc;
+    std::function<void(size_t, size_t, size_t, size_t)> fPipeline;
+};
 
 #endif
@@ -8,19 +8,22 @@
 #ifndef SkCoreBlitters_DEFINED
 #define SkCoreBlitters_DEFINED
 
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkCPUTypes.h"
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/core/SkBlitRow.h"
 #include "src/core/SkBlitter.h"
+#include "src/core/SkRasterPipelineOpList.h"
 #include "src/shaders/SkShaderBase.h"
 
 #include <cstdint>
 
-class SkArenaAlloc;
 class SkMatrix;
 class SkRasterPipeline;
 class SkShader;
@@ -148,4 +151,34 @@ SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap&, const SkPaint&,
                                          bool shader_is_opaque,
                                          SkArenaAlloc*, sk_sp<SkShader> clipShader);
 
+class SkRasterPipelineBlitter;
+
+// Keeps the raster pipeline blitters built for solid-color paints, so that later draws into the
+// same pixels whose paints only differ in color can reuse the blitter and its compiled pipelines
+// after rebinding the color. Paints with shaders aren't cached: their stages are specialized to
+// the CTM and allocated for each draw.
+//
+// A cache belongs to a single device and must only be used by the thread drawing into it. A
+// blitter returned by find() is only valid until the next call to find().
+class SkRasterPipelineBlitterCache {
+public:
+    SkRasterPipelineBlitterCache();
+    ~SkRasterPipelineBlitterCache();
+
+    // Returns nullptr if the paint can't be drawn with a cached blitter.
+    SkBlitter* find(const SkPixmap& dst, const SkPaint& paint);
+
+private:
+    struct Entry {
+        SkRasterPipelineBlitter* fBlitter;
+        SkBlendMode fBlendMode;
+        SkRasterPipelineOp fColorOp;
+    };
+
+    static constexpr int kMaxEntries = 8;
+
+    SkArenaAllocWithReset fAlloc;
+    skia_private::STArray<kMaxEntries, Entry> fEntries;
+};
+
 #endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCounters_DEFINED
+#define SkCounters_DEFINED
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ *  A fixed set of event counters that are cheap enough to leave on in release builds.
+ *
+ *  Each counter is split across kShardCount cache-line-aligned shards, and every thread adds to
+ *  one shard (picked round-robin the first time the thread counts anything), so threads that
+ *  count the same events rarely contend for a cache line. Adds are relaxed atomic increments;
+ *  get() sums the shards, so a value read while other threads are counting may miss their most
+ *  recent adds, but never goes backwards.
+ *
+ *  Counters start at zero, and a constant-initialized SkShardedCounters needs no static
+ *  constructor.
+ */
+template <int kCount>
+class SkShardedCounters {
+public:
+    constexpr SkShardedCounters() = default;
+
+    SkShardedCounters(const SkShardedCounters&) = delete;
+    SkShardedCounters& operator=(const SkShardedCounters&) = delete;
+
+    void add(int counter, uint64_t n = 1) {
+        fShards[ThreadShard()].fCounts[counter].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t get(int counter) const {
+        uint64_t sum = 0;
+        for (const Shard& shard : fShards) {
+            sum += shard.fCounts[counter].load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+private:
+    static constexpr int kShardCount = 8;
+
+    static int ThreadShard() {
+        static std::atomic<int> gNextShard{0};
+        static thread_local const int tShard =
+                gNextShard.fetch_add(1, std::memory_order_relaxed) & (kShardCount - 1);
+        return tShard;
+    }
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> fCounts[kCount] = {};
+    };
+
+    Shard fShards[kShardCount] = {};
+};
+
+/** The counters behind SkGraphics::GetStats(). */
+enum class SkCounter : int {
+    kStrikeCacheHits,
+    kStrikeCacheMisses,
+    kGlyphImagesRasterized,
+    kGlyphPathsGenerated,
+    kResourceCacheHits,
+    kResourceCacheMisses,
+
+    kLast = kResourceCacheMisses,
+};
+static constexpr int kSkCounterCount = static_cast<int>(SkCounter::kLast) + 1;
+
+SkShardedCounters<kSkCounterCount>& SkGlobalCounters();
+
+inline void SkCount(SkCounter counter, uint64_t n = 1) {
+    SkGlobalCounters().add(static_cast<int>(counter), n);
+}
+
+#endif
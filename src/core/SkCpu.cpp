@@ -71,6 +71,26 @@
         }
         return features;
     }
+#elif (defined(SK_CPU_ARM64) || defined(__riscv)) && \
+        (defined(SK_BUILD_FOR_ANDROID) || defined(SK_BUILD_FOR_UNIX))
+    #include <sys/auxv.h>
+
+    static uint32_t read_cpu_features() {
+        uint32_t features = 0;
+    #if defined(SK_CPU_ARM64)
+        // HWCAP_* and HWCAP2_* from <asm/hwcap.h>, spelled out for older headers.
+        const unsigned long hwcap  = getauxval(AT_HWCAP),
+                            hwcap2 = getauxval(AT_HWCAP2);
+        if ((hwcap & (3 << 9)) == (3 << 9)) { features |= SkCpu::FP16; }  // FPHP + ASIMDHP
+        if (hwcap  & (1 << 20)) { features |= SkCpu::DOTPROD; }           // ASIMDDP
+        if (hwcap  & (1 << 22)) { features |= SkCpu::SVE;     }
+        if (hwcap2 & (1 <<  1)) { features |= SkCpu::SVE2;    }
+    #else
+        // RISC-V reports single-letter ISA extensions as bits of AT_HWCAP.
+        if (getauxval(AT_HWCAP) & (1 << ('V' - 'A'))) { features |= SkCpu::RVV; }
+    #endif
+        return features;
+    }
 #else
     static uint32_t read_cpu_features() {
         return 0;
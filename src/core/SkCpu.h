@@ -42,6 +42,20 @@ struct SkCpu {
         SKX = AVX512F  | AVX512DQ | AVX512CD | AVX512BW | AVX512VL,
 
         ERMS       = 1 << 20,
+
+        // ARM64 scalable vectors.
+        SVE        = 1 << 21,
+        SVE2       = 1 << 22,
+
+        // RISC-V vector extension (V, version 1.0).
+        RVV        = 1 << 23,
+
+        // ARM64 half-precision arithmetic and int8 dot products.
+        FP16       = 1 << 24,
+        DOTPROD    = 1 << 25,
+
+        // Handy alias for the ARMv8.2 features every core since Cortex-A55/A75 has.
+        ARMV82 = FP16 | DOTPROD,
     };
 
     static void CacheRuntimeFeatures();
@@ -96,6 +110,15 @@ inline bool SkCpu::Supports(uint32_t mask) {
     features &= (SSE1 | SSE2);
     #endif
 
+#endif
+#if defined(__riscv_v)
+    features |= RVV;
+#endif
+#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+    features |= FP16;
+#endif
+#if defined(__ARM_FEATURE_DOTPROD)
+    features |= DOTPROD;
 #endif
     return (features & mask) == mask;
 }
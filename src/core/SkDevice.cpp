@@ -15,6 +15,7 @@
 #include "include/core/SkImage.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkPathEffect.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRRect.h"
@@ -25,6 +26,7 @@
 #include "include/core/SkTypes.h"
 #include "include/core/SkVertices.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/chromium/Slug.h"  // IWYU pragma: keep
 #include "src/core/SkEnumerate.h"
 #include "src/core/SkImageFilterTypes.h"
@@ -65,6 +67,9 @@ void SkDevice::setDeviceCoordinateSystem(const SkM44& deviceToGlobal,
         fGlobalToDevice.postTranslate(-bufferOriginX, -bufferOriginY);
         fLocalToDevice.postTranslate(-bufferOriginX, -bufferOriginY);
     }
+    fGlobalToDeviceIsTranslate = fGlobalToDevice == SkM44::Translate(fGlobalToDevice.rc(0, 3),
+                                                                     fGlobalToDevice.rc(1, 3),
+                                                                     fGlobalToDevice.rc(2, 3));
     fLocalToDevice33 = fLocalToDevice.asM33();
     fLocalToDeviceDirty = true;
 }
@@ -73,7 +78,13 @@ void SkDevice::setGlobalCTM(const SkM44& ctm) {
     fLocalToDevice = ctm;
     fLocalToDevice.normalizePerspective();
     // Map from the global CTM state to this device's coordinate system.
-    fLocalToDevice.postConcat(fGlobalToDevice);
+    if (fGlobalToDeviceIsTranslate) {
+        fLocalToDevice.postTranslate(fGlobalToDevice.rc(0, 3),
+                                     fGlobalToDevice.rc(1, 3),
+                                     fGlobalToDevice.rc(2, 3));
+    } else {
+        fLocalToDevice.postConcat(fGlobalToDevice);
+    }
     fLocalToDevice33 = fLocalToDevice.asM33();
     fLocalToDeviceDirty = true;
 }
@@ -296,6 +307,49 @@ void SkDevice::drawEdgeAAImageSet(const SkCanvas::ImageSetEntry images[], int co
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+void SkDevice::drawBulk(const SkCanvas::BulkSet& set, const SkSamplingOptions& sampling,
+                        const SkPaint& paint) {
+    SkPaint entryPaint = paint;
+    SkPaint imagePaint = paint;
+    imagePaint.setStyle(SkPaint::kFill_Style);
+    imagePaint.setPathEffect(nullptr);
+    if (set.fColors) {
+        // The entries' alphas replace the paint's.
+        imagePaint.setAlphaf(1.f);
+    }
+
+    skia_private::TArray<SkCanvas::ImageSetEntry> images;
+    for (int i = 0; i < set.fCount;) {
+        if (set.fItems[i] == SkCanvas::BulkItem::kImageRect) {
+            images.clear();
+            for (; i < set.fCount && set.fItems[i] == SkCanvas::BulkItem::kImageRect; ++i) {
+                SkCanvas::ImageSetEntry& entry = images.push_back();
+                entry.fImage = sk_ref_sp(set.fImage);
+                entry.fSrcRect = set.fSrcRects[i];
+                entry.fDstRect = set.fRects[i];
+                entry.fAlpha = set.fColors ? set.fColors[i].fA : 1.f;
+                entry.fAAFlags = paint.isAntiAlias() ? SkCanvas::kAll_QuadAAFlags
+                                                     : SkCanvas::kNone_QuadAAFlags;
+            }
+            this->drawEdgeAAImageSet(images.data(), images.size(), nullptr, nullptr, sampling,
+                                     imagePaint, SkCanvas::kFast_SrcRectConstraint);
+            continue;
+        }
+
+        if (set.fColors) {
+            entryPaint.setColor4f(set.fColors[i]);
+        }
+        if (set.fItems[i] == SkCanvas::BulkItem::kRect) {
+            this->drawRect(set.fRects[i], entryPaint);
+        } else {
+            this->drawRRect(SkRRect::MakeRectXY(set.fRects[i], set.fRadii[i].fX,
+                                                set.fRadii[i].fY),
+                            entryPaint);
+        }
+        ++i;
+    }
+}
+
 void SkDevice::drawDrawable(SkCanvas* canvas, SkDrawable* drawable, const SkMatrix* matrix) {
     drawable->draw(canvas, matrix);
 }
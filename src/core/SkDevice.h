@@ -415,6 +415,10 @@ public:
                                     const SkSamplingOptions&, const SkPaint&,
                                     SkCanvas::SrcRectConstraint);
 
+    // Default impl draws each rect and rrect entry separately, and each run of image entries with
+    // drawEdgeAAImageSet().
+    virtual void drawBulk(const SkCanvas::BulkSet&, const SkSamplingOptions&, const SkPaint&);
+
     virtual void drawDrawable(SkCanvas*, SkDrawable*, const SkMatrix*);
 
     // -- "Special" drawing and image routines
@@ -551,6 +555,8 @@ private:
     // SkDevices, so pay the memory cost to avoid recalculating the inverse.
     SkM44 fDeviceToGlobal;
     SkM44 fGlobalToDevice;
+    // True if fGlobalToDevice only translates, as it does for the root device and most layers.
+    bool fGlobalToDeviceIsTranslate = true;
 
     // fLocalToDevice but as a 3x3.
     SkMatrix fLocalToDevice33;
@@ -7,18 +7,26 @@
 
 #include "src/core/SkDistanceFieldGen.h"
 
+#include "include/core/SkColorPriv.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkScalar.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTo.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/base/SkAutoMalloc.h"
+#include "src/core/SkGeometry.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkPointPriv.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -569,4 +577,347 @@ bool SkGenerateDistanceFieldFromBWImage(unsigned char* distanceField,
     return generate_distance_field_from_image(distanceField, copyPtr, width, height);
 }
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Multi-channel distance fields
+//
+// The outline is split at its corners into edges, and the edges are colored so that the two
+// edges meeting at a corner share exactly one of the r, g and b channels. Each channel holds the
+// signed distance to the nearest edge with that channel's color, and past the ends of an edge
+// the distance to the edge's tangent line. Near a corner two channels then disagree about which
+// side of the outline a texel is on, and the median of the three reproduces the corner exactly,
+// at any magnification. Smooth contours are a single white edge, in all channels, and so behave
+// just like a single-channel distance field.
+
+namespace {
+
+enum MSDFColor : uint8_t {
+    kRed_MSDFColor     = 0b001,
+    kGreen_MSDFColor   = 0b010,
+    kBlue_MSDFColor    = 0b100,
+    kYellow_MSDFColor  = kRed_MSDFColor | kGreen_MSDFColor,
+    kMagenta_MSDFColor = kRed_MSDFColor | kBlue_MSDFColor,
+    kCyan_MSDFColor    = kGreen_MSDFColor | kBlue_MSDFColor,
+    kWhite_MSDFColor   = kRed_MSDFColor | kGreen_MSDFColor | kBlue_MSDFColor,
+};
+
+// The outline is flattened into lines; a curve is many segments of one edge.
+struct MSDFSegment {
+    SkPoint fA, fB;
+    uint8_t fColor;
+    // Set on the segments which end an edge, where the distance keeps following the tangent line.
+    bool    fExtendStart = false,
+            fExtendEnd   = false;
+    // The sign of the distance on the left of the segment, where cross(B - A, p - A) > 0.
+    float   fLeftSign    = 1;
+};
+
+// The flattened points of each edge. Consecutive edges share their end points.
+using MSDFContour = std::vector<std::vector<SkPoint>>;
+
+// Returns a color which shares exactly one channel with 'color', and differs from 'banned'.
+MSDFColor switch_color(uint8_t color, uint8_t banned = 0) {
+    const uint8_t combined = color & banned;
+    if (combined == kRed_MSDFColor || combined == kGreen_MSDFColor ||
+        combined == kBlue_MSDFColor) {
+        return MSDFColor(combined ^ kWhite_MSDFColor);
+    }
+    if (color == 0 || color == kWhite_MSDFColor) {
+        return kCyan_MSDFColor;
+    }
+    // Rotate the channels.
+    const uint8_t shifted = color << 1;
+    return MSDFColor((shifted | shifted >> 3) & kWhite_MSDFColor);
+}
+
+void flatten_edge(const SkPoint* pts, int count, float conicWeight, std::vector<SkPoint>* edge) {
+    float length = 0;
+    for (int i = 1; i < count; ++i) {
+        length += SkPoint::Distance(pts[i - 1], pts[i]);
+    }
+    // Roughly a tenth of a texel of error for the curves found in glyphs.
+    const int steps = count == 2 ? 1 : SkTPin(SkScalarCeilToInt(2 * std::sqrt(length)), 2, 64);
+
+    edge->push_back(pts[0]);
+    for (int i = 1; i < steps; ++i) {
+        const float t = (float)i / steps;
+        SkPoint pt;
+        if (count == 3 && conicWeight != 1) {
+            pt = SkConic(pts, conicWeight).evalAt(t);
+        } else if (count == 3) {
+            SkEvalQuadAt(pts, t, &pt);
+        } else {
+            SkEvalCubicAt(pts, t, &pt, nullptr, nullptr);
+        }
+        edge->push_back(pt);
+    }
+    edge->push_back(pts[count - 1]);
+}
+
+std::vector<MSDFContour> split_into_edges(const SkPath& path) {
+    std::vector<MSDFContour> contours;
+    SkPath::Iter iter(path, /*forceClose=*/true);
+    SkPoint pts[4];
+    for (SkPath::Verb verb; (verb = iter.next(pts)) != SkPath::kDone_Verb;) {
+        int count;
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                contours.emplace_back();
+                continue;
+            case SkPath::kLine_Verb:  count = 2; break;
+            case SkPath::kQuad_Verb:
+            case SkPath::kConic_Verb: count = 3; break;
+            case SkPath::kCubic_Verb: count = 4; break;
+            default:
+                continue;
+        }
+        if (contours.empty()) {
+            contours.emplace_back();
+        }
+        std::vector<SkPoint> edge;
+        flatten_edge(pts, count, verb == SkPath::kConic_Verb ? iter.conicWeight() : 1, &edge);
+        // Drop degenerate segments, and edges which have none left.
+        edge.erase(std::unique(edge.begin(), edge.end()), edge.end());
+        if (edge.size() >= 2) {
+            contours.back().push_back(std::move(edge));
+        }
+    }
+    return contours;
+}
+
+SkVector unit_direction(SkPoint from, SkPoint to) {
+    SkVector v = to - from;
+    v.normalize();
+    return v;
+}
+
+// Colors the segments of one contour, and appends them to 'segments'.
+void color_contour(const MSDFContour& contour, std::vector<MSDFSegment>* segments) {
+    const int edgeCount = SkToInt(contour.size());
+    if (edgeCount == 0) {
+        return;
+    }
+
+    // An edge starts at a corner when the outline turns by more than about 8 degrees there.
+    static constexpr float kCornerCrossThreshold = 0.1411f;  // sin(3)
+    std::vector<int> corners;
+    for (int i = 0; i < edgeCount; ++i) {
+        const std::vector<SkPoint>& prev = contour[(i + edgeCount - 1) % edgeCount];
+        const std::vector<SkPoint>& next = contour[i];
+        const SkVector in  = unit_direction(prev[prev.size() - 2], prev.back()),
+                       out = unit_direction(next[0], next[1]);
+        if (SkPoint::DotProduct(in, out) <= 0 ||
+            std::abs(SkPoint::CrossProduct(in, out)) > kCornerCrossThreshold) {
+            corners.push_back(i);
+        }
+    }
+
+    const size_t firstSegment = segments->size();
+    auto appendEdge = [&](const std::vector<SkPoint>& edge, uint8_t color) {
+        for (size_t i = 1; i < edge.size(); ++i) {
+            segments->push_back({edge[i - 1], edge[i], color});
+        }
+    };
+
+    if (corners.empty()) {
+        for (const std::vector<SkPoint>& edge : contour) {
+            appendEdge(edge, kWhite_MSDFColor);
+        }
+    } else {
+        const int start = corners[0];
+        std::vector<uint8_t> edgeColors(edgeCount);
+        uint8_t color = switch_color(kWhite_MSDFColor);
+        const uint8_t initialColor = color;
+        for (int i = 0, corner = 0, cornerCount = SkToInt(corners.size()); i < edgeCount; ++i) {
+            const int index = (start + i) % edgeCount;
+            if (corner + 1 < cornerCount && corners[corner + 1] == index) {
+                ++corner;
+                // The last edge must differ from the first, which it meets at corners[0].
+                color = switch_color(color, corner == cornerCount - 1 ? initialColor : 0);
+            }
+            edgeColors[index] = color;
+        }
+        for (int i = 0; i < edgeCount; ++i) {
+            const int index = (start + i) % edgeCount;
+            appendEdge(contour[index], edgeColors[index]);
+        }
+
+        if (corners.size() == 1) {
+            // A lone corner, like a teardrop's, needs the other side of it in a different color
+            // too: split the contour into thirds colored with two colors around white.
+            const size_t count = segments->size() - firstSegment;
+            const uint8_t colors[3] = {initialColor, kWhite_MSDFColor, switch_color(initialColor)};
+            for (size_t i = 0; i < count; ++i) {
+                (*segments)[firstSegment + i].fColor = colors[std::min<size_t>(3 * i / count, 2)];
+            }
+        }
+    }
+
+    // The distance keeps following the tangent line past the corners, where the color changes.
+    const size_t count = segments->size() - firstSegment;
+    for (size_t i = 0; i < count && !corners.empty(); ++i) {
+        MSDFSegment& segment = (*segments)[firstSegment + i];
+        const MSDFSegment& prev = (*segments)[firstSegment + (i + count - 1) % count];
+        const MSDFSegment& next = (*segments)[firstSegment + (i + 1) % count];
+        segment.fExtendStart = prev.fColor != segment.fColor;
+        segment.fExtendEnd   = next.fColor != segment.fColor;
+    }
+}
+
+bool is_inside(int winding, SkPathFillType fillType) {
+    bool inside = SkPathFillType_IsEvenOdd(fillType) ? (winding & 1) : winding != 0;
+    return SkPathFillType_IsInverse(fillType) ? !inside : inside;
+}
+
+int winding_at(const std::vector<MSDFSegment>& segments, SkPoint p) {
+    int winding = 0;
+    for (const MSDFSegment& s : segments) {
+        if ((s.fA.fY <= p.fY) != (s.fB.fY <= p.fY)) {
+            const float x = s.fA.fX + (p.fY - s.fA.fY) * (s.fB.fX - s.fA.fX) / (s.fB.fY - s.fA.fY);
+            if (x > p.fX) {
+                winding += s.fB.fY > s.fA.fY ? 1 : -1;
+            }
+        }
+    }
+    return winding;
+}
+
+struct MSDFDistance {
+    float fDistance;       // unsigned distance to the segment
+    float fOrthogonality;  // breaks ties at shared end points: 0 is perpendicular to the segment
+    float fSigned;         // signed distance, following the tangent line at the ends of edges
+};
+
+MSDFDistance segment_distance(const MSDFSegment& s, SkPoint p) {
+    const SkVector d = s.fB - s.fA,
+                   ap = p - s.fA;
+    const float length = d.length();
+    const float t = SkPoint::DotProduct(ap, d) / (length * length);
+    const float perpendicular = SkPoint::CrossProduct(d, ap) / length;
+
+    MSDFDistance result;
+    if (t < 0 || t > 1) {
+        const SkVector endToP = t < 0 ? ap : p - s.fB;
+        result.fDistance = endToP.length();
+        result.fOrthogonality = result.fDistance > 0
+                ? std::abs(SkPoint::DotProduct(d, endToP)) / (length * result.fDistance)
+                : 0;
+    } else {
+        result.fDistance = std::abs(perpendicular);
+        result.fOrthogonality = 0;
+    }
+    const bool extend = (t < 0 && s.fExtendStart) || (t > 1 && s.fExtendEnd);
+    const float magnitude = extend ? std::abs(perpendicular) : result.fDistance;
+    result.fSigned = (perpendicular >= 0 ? s.fLeftSign : -s.fLeftSign) * magnitude;
+    return result;
+}
+
+bool closer(const MSDFDistance& a, const MSDFDistance& b) {
+    static constexpr float kTolerance = 1.0f / 1024;
+    if (std::abs(a.fDistance - b.fDistance) <= kTolerance) {
+        return a.fOrthogonality < b.fOrthogonality;
+    }
+    return a.fDistance < b.fDistance;
+}
+
+}  // anonymous namespace
+
+bool SkGenerateMultiChannelDistanceFieldFromPath(uint32_t* distanceField, const SkPath& path,
+                                                 int width, int height, size_t rowBytes) {
+    SkASSERT(distanceField);
+    if (!path.isFinite()) {
+        return false;
+    }
+
+    const SkPathFillType fillType = path.getFillType();
+    std::vector<MSDFSegment> segments;
+    for (const MSDFContour& contour : split_into_edges(path)) {
+        color_contour(contour, &segments);
+    }
+
+    // Whatever the contours' directions, make the distance negative on the inside of each segment.
+    static constexpr float kSideOffset = 1.0f / 32;
+    for (MSDFSegment& s : segments) {
+        SkVector left = {s.fA.fY - s.fB.fY, s.fB.fX - s.fA.fX};
+        left.setLength(kSideOffset);
+        const SkPoint p = (s.fA + s.fB) * 0.5f + left;
+        s.fLeftSign = is_inside(winding_at(segments, p), fillType) ? -1 : 1;
+    }
+
+    // Distances beyond this are clamped, so only the segments this close to a texel matter.
+    static constexpr float kReach = SK_DistanceFieldMagnitude + 1;
+    std::vector<const MSDFSegment*> rowSegments;
+    std::vector<std::pair<float, int>> crossings;
+    for (int row = 0; row < height; ++row) {
+        const float y = row + 0.5f;
+        rowSegments.clear();
+        crossings.clear();
+        for (const MSDFSegment& s : segments) {
+            if (std::min(s.fA.fY, s.fB.fY) - kReach <= y &&
+                y <= std::max(s.fA.fY, s.fB.fY) + kReach) {
+                rowSegments.push_back(&s);
+            }
+            if ((s.fA.fY <= y) != (s.fB.fY <= y)) {
+                const float x = s.fA.fX + (y - s.fA.fY) * (s.fB.fX - s.fA.fX) / (s.fB.fY - s.fA.fY);
+                crossings.push_back({x, s.fB.fY > s.fA.fY ? 1 : -1});
+            }
+        }
+        std::sort(crossings.begin(), crossings.end());
+
+        uint32_t* dst = reinterpret_cast<uint32_t*>(
+                reinterpret_cast<char*>(distanceField) + row * rowBytes);
+        int winding = 0;
+        size_t nextCrossing = 0;
+        for (int col = 0; col < width; ++col) {
+            const SkPoint p = {col + 0.5f, y};
+            while (nextCrossing < crossings.size() && crossings[nextCrossing].first <= p.fX) {
+                winding += crossings[nextCrossing++].second;
+            }
+            const bool inside = is_inside(winding, fillType);
+            const float far = inside ? -SK_DistanceFieldMagnitude : SK_DistanceFieldMagnitude;
+
+            MSDFDistance nearest[3];
+            bool found[3] = {false, false, false};
+            float nearestDistance = kReach;
+            for (const MSDFSegment* s : rowSegments) {
+                if (p.fX < std::min(s->fA.fX, s->fB.fX) - kReach ||
+                    std::max(s->fA.fX, s->fB.fX) + kReach < p.fX) {
+                    continue;
+                }
+                const MSDFDistance distance = segment_distance(*s, p);
+                for (int channel = 0; channel < 3; ++channel) {
+                    if ((s->fColor & (1 << channel)) &&
+                        (!found[channel] || closer(distance, nearest[channel]))) {
+                        nearest[channel] = distance;
+                        found[channel] = true;
+                    }
+                }
+                nearestDistance = std::min(nearestDistance, distance.fDistance);
+            }
+
+            // The true distance takes its sign from the fill, which is always right.
+            const float trueDistance = inside ? -nearestDistance : nearestDistance;
+            float channels[3];
+            for (int channel = 0; channel < 3; ++channel) {
+                channels[channel] = found[channel] ? nearest[channel].fSigned : far;
+            }
+            // Where the median lands on the wrong side, e.g. where contours overlap, fall back to
+            // the single-channel distance.
+            const float median = std::max(std::min(channels[0], channels[1]),
+                                          std::min(std::max(channels[0], channels[1]),
+                                                   channels[2]));
+            if ((median < 0) != inside) {
+                channels[0] = channels[1] = channels[2] = trueDistance;
+            }
+
+            dst[col] = SkPackARGB32NoCheck(
+                    pack_distance_field_val<SK_DistanceFieldMagnitude>(trueDistance),
+                    pack_distance_field_val<SK_DistanceFieldMagnitude>(channels[0]),
+                    pack_distance_field_val<SK_DistanceFieldMagnitude>(channels[1]),
+                    pack_distance_field_val<SK_DistanceFieldMagnitude>(channels[2]));
+        }
+    }
+    return true;
+}
+
 #endif // !defined(SK_DISABLE_SDF_TEXT)
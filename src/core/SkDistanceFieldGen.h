@@ -10,6 +10,9 @@
 #include "include/core/SkTypes.h"
 
 #include <cstddef>
+#include <cstdint>
+
+class SkPath;
 
 #if !defined(SK_DISABLE_SDF_TEXT)
 
@@ -68,6 +71,22 @@ bool SkGenerateDistanceFieldFromBWImage(unsigned char* distanceField,
                                         const unsigned char* image,
                                         int w, int h, size_t rowBytes);
 
+/** Given a path, generate the associated multi-channel distance field. Each texel is an SkPMColor
+ *  whose r, g and b hold signed distances to differently colored edges of the outline; the
+ *  median of the three keeps the outline's corners sharp when the field is magnified, where a
+ *  single-channel field rounds them off. Its a holds the single-channel distance field. All four
+ *  use the same 8-bit encoding as the single-channel distance fields above.
+
+ *  @param distanceField     The distance field to be generated, width x height SkPMColors.
+ *  @param path              The path, in texel space: texel (x, y) is centered at
+ *                           (x + 0.5, y + 0.5). It should already be inset by the padding above.
+ *  @param width             Width of the distance field.
+ *  @param height            Height of the distance field.
+ *  @param rowBytes          Size of each row in the distance field, in bytes.
+ */
+bool SkGenerateMultiChannelDistanceFieldFromPath(uint32_t* distanceField, const SkPath& path,
+                                                 int width, int height, size_t rowBytes);
+
 /** Given width and height of original image, return size (in bytes) of distance field
  *  @param w                 Width of the original image.
  *  @param h                 Height of the original image.
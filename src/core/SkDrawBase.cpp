@@ -17,14 +17,17 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkStrokeRec.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkCPUTypes.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/base/SkTLazy.h"
 #include "src/base/SkZip.h"
 #include "src/core/SkAutoBlitterChoose.h"
 #include "src/core/SkBlendModePriv.h"
+#include "src/core/SkBlitter.h"
 #include "src/core/SkBlitter_A8.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkDrawBase.h"
@@ -36,6 +39,7 @@
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkRectPriv.h"
 #include "src/core/SkScan.h"
+#include "src/core/SkTaskGroup.h"
 #include <algorithm>
 #include <cstddef>
 #include <optional>
@@ -313,6 +317,17 @@ void SkDrawBase::drawRRect(const SkRRect& rrect, const SkPaint& paint) const {
             }
         }
     }
+#if !defined(SK_LEGACY_AA_RRECT_AS_PATH)
+    else if (paint.isAntiAlias()) {
+        // Ovals and simple rrects that stay axis-aligned have an analytic coverage.
+        SkRRect devRRect;
+        if (rrect.transform(*fCTM, &devRRect) && SkScan::CanAntiFillRRect(devRRect)) {
+            SkAutoBlitterChoose blitter(*this, nullptr, paint);
+            SkScan::AntiFillRRect(devRRect, *fRC, blitter.get());
+            return;
+        }
+    }
+#endif
 
 DRAW_PATH:
     // Now fall back to the default case of using a path.
@@ -321,11 +336,106 @@ DRAW_PATH:
     this->drawPath(path, paint, nullptr, true);
 }
 
+using PathProc = void (*)(const SkPath&, const SkRasterClip&, SkBlitter*);
+
+static PathProc choose_path_proc(const SkPaint& paint, bool doFill) {
+    if (doFill) {
+        if (paint.isAntiAlias()) {
+            return SkScan::AntiFillPath;
+        }
+        return SkScan::FillPath;
+    }
+    // hairline
+    if (paint.isAntiAlias()) {
+        switch (paint.getStrokeCap()) {
+            case SkPaint::kButt_Cap:
+                return SkScan::AntiHairPath;
+            case SkPaint::kSquare_Cap:
+                return SkScan::AntiHairSquarePath;
+            case SkPaint::kRound_Cap:
+                return SkScan::AntiHairRoundPath;
+        }
+    } else {
+        switch (paint.getStrokeCap()) {
+            case SkPaint::kButt_Cap:
+                return SkScan::HairPath;
+            case SkPaint::kSquare_Cap:
+                return SkScan::HairSquarePath;
+            case SkPaint::kRound_Cap:
+                return SkScan::HairRoundPath;
+        }
+    }
+    SkUNREACHABLE;
+}
+
+// Paths with fewer verbs than this are drawn in one go even when the surface allows bands; the
+// cost of building their edges doesn't pay for the overhead of the tasks.
+static constexpr int kMinVerbsForBands = 1 << 16;
+static constexpr int kMinBandHeight = 64;
+static constexpr int kMaxBands = 16;
+
+bool SkDrawBase::drawDevPathInBands(const SkPath& devPath,
+                                    const SkPaint& paint,
+                                    bool drawCoverage,
+                                    bool doFill) const {
+    if (!fProps || !(fProps->flags() & SkSurfaceProps::kParallelizeLargePaths_Flag) ||
+        devPath.countVerbs() < kMinVerbsForBands) {
+        return false;
+    }
+
+    // The bands only depend on the bounds, so the same draw always makes the same bands no matter
+    // how many threads the executor has or how the tasks are scheduled.
+    SkIRect bounds = fRC->getBounds();
+    if (!devPath.isInverseFillType() &&
+        !bounds.intersect(devPath.getBounds().roundOut().makeOutset(1, 1))) {
+        return true;  // nothing to draw
+    }
+    const int bandCount = std::min(kMaxBands, bounds.height() / kMinBandHeight);
+    if (bandCount < 2) {
+        return false;
+    }
+
+    const PathProc proc = choose_path_proc(paint, doFill);
+    SkTaskGroup bands;
+    for (int i = 0; i < bandCount; ++i) {
+        const SkIRect band = SkIRect::MakeLTRB(bounds.fLeft,
+                                               bounds.fTop + bounds.height() * i / bandCount,
+                                               bounds.fRight,
+                                               bounds.fTop + bounds.height() * (i + 1) / bandCount);
+        // Each band clips the path's edges to its rows as they're built, and blits into rows that
+        // no other band touches, so the bands don't share any state besides the (immutable) path
+        // and paint.
+        bands.add([this, &devPath, &paint, drawCoverage, proc, band] {
+            SkRasterClip rc(*fRC);
+            if (!rc.op(band, SkClipOp::kIntersect)) {
+                return;
+            }
+            SkSTArenaAlloc<kSkBlitterContextSize> alloc;
+            SkBlitter* blitter = fBlitterChooser(fDst,
+                                                 *fCTM,
+                                                 paint,
+                                                 &alloc,
+                                                 drawCoverage,
+                                                 rc.clipShader(),
+                                                 SkSurfacePropsCopyOrDefault(fProps),
+                                                 /*cache=*/nullptr);  // not thread safe
+            proc(devPath, rc, blitter);
+        });
+    }
+    bands.wait();
+    return true;
+}
+
 void SkDrawBase::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawCoverage,
-                         SkBlitter* customBlitter, bool doFill) const {
+                         SkBlitter* customBlitter, bool doFill, const SkPath* srcPath) const {
     if (SkPathPriv::TooBigForMath(devPath)) {
         return;
     }
+    if (nullptr == customBlitter && !paint.getMaskFilter() &&
+        this->drawDevPathInBands(devPath, paint, drawCoverage, doFill)) {
+        return;
+    }
+
     SkBlitter* blitter = nullptr;
     SkAutoBlitterChoose blitterStorage;
     if (nullptr == customBlitter) {
@@ -337,47 +447,13 @@ void SkDrawBase::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool d
     if (paint.getMaskFilter()) {
         SkStrokeRec::InitStyle style = doFill ? SkStrokeRec::kFill_InitStyle
                                               : SkStrokeRec::kHairline_InitStyle;
-        if (as_MFB(paint.getMaskFilter())->filterPath(devPath, *fCTM, *fRC, blitter, style)) {
+        if (as_MFB(paint.getMaskFilter())->filterPath(devPath, *fCTM, *fRC, blitter, style,
+                                                      srcPath)) {
             return;  // filterPath() called the blitter, so we're done
         }
     }
 
-    void (*proc)(const SkPath&, const SkRasterClip&, SkBlitter*);
-    if (doFill) {
-        if (paint.isAntiAlias()) {
-            proc = SkScan::AntiFillPath;
-        } else {
-            proc = SkScan::FillPath;
-        }
-    } else {    // hairline
-        if (paint.isAntiAlias()) {
-            switch (paint.getStrokeCap()) {
-                case SkPaint::kButt_Cap:
-                    proc = SkScan::AntiHairPath;
-                    break;
-                case SkPaint::kSquare_Cap:
-                    proc = SkScan::AntiHairSquarePath;
-                    break;
-                case SkPaint::kRound_Cap:
-                    proc = SkScan::AntiHairRoundPath;
-                    break;
-            }
-        } else {
-            switch (paint.getStrokeCap()) {
-                case SkPaint::kButt_Cap:
-                    proc = SkScan::HairPath;
-                    break;
-                case SkPaint::kSquare_Cap:
-                    proc = SkScan::HairSquarePath;
-                    break;
-                case SkPaint::kRound_Cap:
-                    proc = SkScan::HairRoundPath;
-                    break;
-            }
-        }
-    }
-
-    proc(devPath, *fRC, blitter);
+    choose_path_proc(paint, doFill)(devPath, *fRC, blitter);
 }
 
 void SkDrawBase::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
@@ -460,7 +536,11 @@ void SkDrawBase::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
     }
 #endif
 
-    this->drawDevPath(*devPathPtr, *paint, drawCoverage, customBlitter, doFill);
+    // The mask filter may cache its work by the source path when that's what was transformed.
+    const SkPath* srcPath = pathPtr == &origSrcPath && devPathPtr != pathPtr && !prePathMatrix
+                                    ? &origSrcPath
+                                    : nullptr;
+    this->drawDevPath(*devPathPtr, *paint, drawCoverage, customBlitter, doFill, srcPath);
 }
 
 void SkDrawBase::paintMasks(SkZip<const SkGlyph*, SkPoint>, const SkPaint&) const {
@@ -28,6 +28,7 @@ class SkMaskFilter;
 class SkMatrix;
 class SkPath;
 class SkRRect;
+class SkRasterPipelineBlitterCache;
 class SkRasterClip;
 class SkShader;
 class SkSurfaceProps;
@@ -114,7 +115,8 @@ public:
                                        SkArenaAlloc*,
                                        bool drawCoverage,
                                        sk_sp<SkShader> clipShader,
-                                       const SkSurfaceProps&);
+                                       const SkSurfaceProps&,
+                                       SkRasterPipelineBlitterCache*);
 
 
 private:
@@ -132,11 +134,21 @@ private:
 
     void drawLine(const SkPoint[2], const SkPaint&) const;
 
+    // 'srcPath', if not null, is the path that was transformed by fCTM into 'devPath'.
     void drawDevPath(const SkPath& devPath,
                      const SkPaint& paint,
                      bool drawCoverage,
                      SkBlitter* customBlitter,
-                     bool doFill) const;
+                     bool doFill,
+                     const SkPath* srcPath = nullptr) const;
+
+    // If fProps asks for it and the path is big enough, splits the path's device bounds into
+    // horizontal bands and draws them concurrently on SkExecutor::GetDefault(). Returns false if
+    // the path should be drawn in one go instead.
+    bool drawDevPathInBands(const SkPath& devPath,
+                            const SkPaint& paint,
+                            bool drawCoverage,
+                            bool doFill) const;
     /**
      *  Return the current clip bounds, in local coordinates, with slop to account
      *  for antialiasing or hairlines (i.e. device-bounds outset by 1, and then
@@ -153,6 +165,7 @@ public:
     const SkMatrix*         fCTM{nullptr};             // required
     const SkRasterClip*     fRC{nullptr};              // required
     const SkSurfaceProps*   fProps{nullptr};           // optional
+    SkRasterPipelineBlitterCache* fBlitterCache{nullptr};  // optional
 
 #ifdef SK_DEBUG
     void validate() const;
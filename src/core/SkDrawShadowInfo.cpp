@@ -10,8 +10,11 @@
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkRect.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "include/utils/SkShadowUtils.h"
+#include "src/core/SkPointPriv.h"
+#include "src/core/SkRRectPriv.h"
 
 namespace SkDrawShadowMetrics {
 
@@ -212,6 +215,177 @@ void GetLocalBounds(const SkPath& path, const SkDrawShadowRec& rec, const SkMatr
     }
 }
 
+bool GetRRectShadows(const SkPath& path, const SkDrawShadowRec& rec, const SkMatrix& ctm,
+                     RRectShadow* ambient, RRectShadow* spot) {
+    // check z plane
+    bool tiltZPlane = SkToBool(!SkScalarNearlyZero(rec.fZPlaneParams.fX) ||
+                               !SkScalarNearlyZero(rec.fZPlaneParams.fY));
+    bool skipAnalytic = SkToBool(rec.fFlags & SkShadowFlags::kGeometricOnly_ShadowFlag);
+    if (tiltZPlane || skipAnalytic || !ctm.rectStaysRect() || !ctm.isSimilarity()) {
+        return false;
+    }
+
+    SkRRect rrect;
+    SkRect rect;
+    // we can only handle rects, circles, and simple rrects with circular corners
+    bool isRRect = path.isRRect(&rrect) && SkRRectPriv::IsNearlySimpleCircular(rrect) &&
+                   rrect.getSimpleRadii().fX > SK_ScalarNearlyZero;
+    if (!isRRect &&
+        path.isOval(&rect) && SkScalarNearlyEqual(rect.width(), rect.height()) &&
+        rect.width() > SK_ScalarNearlyZero) {
+        rrect.setOval(rect);
+        isRRect = true;
+    }
+    if (!isRRect && path.isRect(&rect)) {
+        rrect.setRect(rect);
+        isRRect = true;
+    }
+
+    if (!isRRect) {
+        return false;
+    }
+
+    ambient->fRRect.setEmpty();
+    spot->fRRect.setEmpty();
+    if (rrect.isEmpty()) {
+        return true;
+    }
+
+    SkPoint3 devLightPos = rec.fLightPos;
+    bool directional = SkToBool(rec.fFlags & kDirectionalLight_ShadowFlag);
+    if (!directional) {
+        // transform light
+        ctm.mapPoints((SkPoint*)&devLightPos.fX, 1);
+    }
+
+    // 1/scale
+    SkScalar devToSrcScale = ctm.isScaleTranslate() ?
+        SkScalarInvert(SkScalarAbs(ctm[SkMatrix::kMScaleX])) :
+        sk_float_rsqrt(ctm[SkMatrix::kMScaleX] * ctm[SkMatrix::kMScaleX] +
+                       ctm[SkMatrix::kMSkewX] * ctm[SkMatrix::kMSkewX]);
+
+    SkScalar occluderHeight = rec.fZPlaneParams.fZ;
+    bool transparent = SkToBool(rec.fFlags & SkShadowFlags::kTransparentOccluder_ShadowFlag);
+
+    if (SkColorGetA(rec.fAmbientColor) > 0) {
+        SkScalar devSpaceInsetWidth = AmbientBlurRadius(occluderHeight);
+        const SkScalar umbraRecipAlpha = AmbientRecipAlpha(occluderHeight);
+        const SkScalar devSpaceAmbientBlur = devSpaceInsetWidth * umbraRecipAlpha;
+
+        // Outset the shadow rrect to the border of the penumbra
+        SkScalar ambientPathOutset = devSpaceInsetWidth * devToSrcScale;
+        SkRect outsetRect = rrect.rect().makeOutset(ambientPathOutset, ambientPathOutset);
+        // If the rrect was an oval then its outset will also be one.
+        // We set it explicitly to avoid errors.
+        if (rrect.isOval()) {
+            ambient->fRRect = SkRRect::MakeOval(outsetRect);
+        } else {
+            SkScalar outsetRad = SkRRectPriv::GetSimpleRadii(rrect).fX + ambientPathOutset;
+            ambient->fRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
+        }
+
+        if (transparent) {
+            // set a large inset to force a fill
+            devSpaceInsetWidth = ambient->fRRect.width();
+        }
+        ambient->fBlurWidth = devSpaceAmbientBlur;
+        ambient->fInsetWidth = devSpaceInsetWidth;
+    }
+
+    if (SkColorGetA(rec.fSpotColor) > 0) {
+        SkScalar devSpaceSpotBlur;
+        SkScalar spotScale;
+        SkVector spotOffset;
+        if (directional) {
+            GetDirectionalParams(occluderHeight, devLightPos.fX, devLightPos.fY, devLightPos.fZ,
+                                 rec.fLightRadius, &devSpaceSpotBlur, &spotScale, &spotOffset);
+        } else {
+            GetSpotParams(occluderHeight, devLightPos.fX, devLightPos.fY, devLightPos.fZ,
+                          rec.fLightRadius, &devSpaceSpotBlur, &spotScale, &spotOffset);
+        }
+        // handle scale of radius due to CTM
+        const SkScalar srcSpaceSpotBlur = devSpaceSpotBlur * devToSrcScale;
+
+        // Adjust translate for the effect of the scale.
+        spotOffset.fX += spotScale*ctm[SkMatrix::kMTransX];
+        spotOffset.fY += spotScale*ctm[SkMatrix::kMTransY];
+        // This offset is in dev space, need to transform it into source space.
+        SkMatrix ctmInverse;
+        if (ctm.invert(&ctmInverse)) {
+            ctmInverse.mapPoints(&spotOffset, 1);
+        } else {
+            // Since the matrix is a similarity, this should never happen, but just in case...
+            SkDebugf("Matrix is degenerate. Will not render spot shadow correctly!\n");
+            SkASSERT(false);
+        }
+
+        // Compute the transformed shadow rrect
+        SkRRect spotShadowRRect;
+        SkMatrix shadowTransform;
+        shadowTransform.setScaleTranslate(spotScale, spotScale, spotOffset.fX, spotOffset.fY);
+        rrect.transform(shadowTransform, &spotShadowRRect);
+        SkScalar spotRadius = spotShadowRRect.getSimpleRadii().fX;
+
+        // Compute the insetWidth
+        SkScalar blurOutset = srcSpaceSpotBlur;
+        SkScalar insetWidth = blurOutset;
+        if (transparent) {
+            // If transparent, just do a fill
+            insetWidth += spotShadowRRect.width();
+        } else {
+            // For shadows, instead of using a stroke we specify an inset from the penumbra
+            // border. We want to extend this inset area so that it meets up with the caster
+            // geometry. The inset geometry will by default already be inset by the blur width.
+            //
+            // We compare the min and max corners inset by the radius between the original
+            // rrect and the shadow rrect. The distance between the two plus the difference
+            // between the scaled radius and the original radius gives the distance from the
+            // transformed shadow shape to the original shape in that corner. The max
+            // of these gives the maximum distance we need to cover.
+            //
+            // Since we are outsetting by 1/2 the blur distance, we just add the maxOffset to
+            // that to get the full insetWidth.
+            SkScalar maxOffset;
+            if (rrect.isRect()) {
+                // Manhattan distance works better for rects
+                maxOffset = std::max(std::max(SkTAbs(spotShadowRRect.rect().fLeft -
+                                                 rrect.rect().fLeft),
+                                          SkTAbs(spotShadowRRect.rect().fTop -
+                                                 rrect.rect().fTop)),
+                                   std::max(SkTAbs(spotShadowRRect.rect().fRight -
+                                                 rrect.rect().fRight),
+                                          SkTAbs(spotShadowRRect.rect().fBottom -
+                                                 rrect.rect().fBottom)));
+            } else {
+                SkScalar dr = spotRadius - SkRRectPriv::GetSimpleRadii(rrect).fX;
+                SkPoint upperLeftOffset = SkPoint::Make(spotShadowRRect.rect().fLeft -
+                                                        rrect.rect().fLeft + dr,
+                                                        spotShadowRRect.rect().fTop -
+                                                        rrect.rect().fTop + dr);
+                SkPoint lowerRightOffset = SkPoint::Make(spotShadowRRect.rect().fRight -
+                                                         rrect.rect().fRight - dr,
+                                                         spotShadowRRect.rect().fBottom -
+                                                         rrect.rect().fBottom - dr);
+                maxOffset = SkScalarSqrt(std::max(SkPointPriv::LengthSqd(upperLeftOffset),
+                                                  SkPointPriv::LengthSqd(lowerRightOffset))) + dr;
+            }
+            insetWidth += std::max(blurOutset, maxOffset);
+        }
+
+        // Outset the shadow rrect to the border of the penumbra
+        SkRect outsetRect = spotShadowRRect.rect().makeOutset(blurOutset, blurOutset);
+        if (spotShadowRRect.isOval()) {
+            spot->fRRect = SkRRect::MakeOval(outsetRect);
+        } else {
+            SkScalar outsetRad = spotRadius + blurOutset;
+            spot->fRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
+        }
+        spot->fBlurWidth = 2.0f * devSpaceSpotBlur;
+        spot->fInsetWidth = insetWidth;
+    }
+
+    return true;
+}
 
 }  // namespace SkDrawShadowMetrics
 
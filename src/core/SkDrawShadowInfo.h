@@ -11,6 +11,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkPoint3.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkScalar.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkFloatingPoint.h"
@@ -91,6 +92,22 @@ bool GetSpotShadowTransform(const SkPoint3& lightPos, SkScalar lightRadius,
 // get bounds prior to the ctm being applied
 void GetLocalBounds(const SkPath&, const SkDrawShadowRec&, const SkMatrix& ctm, SkRect* bounds);
 
+// A shadow of a rect, circle or circular rrect occluder that can be drawn analytically. fRRect is
+// in local space, outset to the outer border of the penumbra. The shadow's alpha falls off over
+// fBlurWidth device pixels inward from that border. The occluder hides the shadow further than
+// fInsetWidth inside the border, unless it is transparent.
+struct RRectShadow {
+    SkRRect  fRRect;
+    SkScalar fBlurWidth;
+    SkScalar fInsetWidth;
+};
+
+// Computes the ambient and spot shadows of the path if they can be drawn as RRectShadows. Returns
+// false if the path, z plane or ctm need the general shadow code. A shadow with a transparent
+// color, or of an empty occluder, gets an empty fRRect.
+bool GetRRectShadows(const SkPath&, const SkDrawShadowRec&, const SkMatrix& ctm,
+                     RRectShadow* ambient, RRectShadow* spot);
+
 }  // namespace SkDrawShadowMetrics
 
 #endif
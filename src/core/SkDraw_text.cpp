@@ -58,7 +58,8 @@ void SkDraw::paintMasks(SkZip<const SkGlyph*, SkPoint> accepted, const SkPaint&
                                            &alloc,
                                            false,
                                            fRC->clipShader(),
-                                           SkSurfacePropsCopyOrDefault(fProps));
+                                           SkSurfacePropsCopyOrDefault(fProps),
+                                           fBlitterCache);
 
     SkAAClipBlitterWrapper wrapper{*fRC, blitter};
     blitter = wrapper.getBlitter();
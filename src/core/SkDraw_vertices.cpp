@@ -28,7 +28,10 @@
 #include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkBlenderBase.h"
+#include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkConvertPixels.h"
 #include "src/core/SkCoreBlitters.h"
 #include "src/core/SkDraw.h"
@@ -41,8 +44,11 @@
 #include "src/shaders/SkTransformShader.h"
 #include "src/shaders/SkTriColorShader.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <optional>
 #include <utility>
 
@@ -184,6 +190,122 @@ static void fill_triangle(const VertState& state, SkBlitter* blitter, const SkRa
     }
 }
 
+// Dense meshes of small triangles spend most of their time setting up each triangle for
+// SkScan::FillTriangle and running the pipeline over spans only a few pixels long. When all that
+// is drawn is interpolated vertex colors, written or blended src-over into an N32 pixmap under a
+// rect clip, we fill the triangles directly instead: each one's clipped bounds are walked four
+// pixels at a time, testing its edge functions at pixel centers and interpolating the colors
+// from them. Pixels on an edge belong to the triangle only if it is a top or left edge, which
+// matches what SkScan::FillTriangle does for pixel centers on edges.
+namespace {
+class ColorTriangleFiller {
+public:
+    ColorTriangleFiller(const SkPixmap& dst, const SkIRect& clip, bool srcOver)
+            : fDst(dst), fClip(clip), fSrcOver(srcOver) {}
+
+    void fill(SkPoint p0, SkPoint p1, SkPoint p2,
+              SkPMColor4f c0, SkPMColor4f c1, SkPMColor4f c2) const {
+        float area = (p1 - p0).cross(p2 - p0);
+        if (area == 0 || !SkScalarIsFinite(area)) {
+            return;
+        }
+        if (area < 0) {
+            // Wind the triangle so points inside are on the positive side of every edge.
+            std::swap(p1, p2);
+            std::swap(c1, c2);
+            area = -area;
+        }
+
+        SkRect bounds;
+        const SkPoint pts[] = {p0, p1, p2};
+        bounds.setBounds(pts, 3);
+        if (!bounds.intersect(SkRect::Make(fClip))) {
+            return;
+        }
+        // The pixels whose centers can be inside the triangle.
+        const int left   = sk_float_saturate2int(std::ceil (bounds.fLeft   - 0.5f)),
+                  top    = sk_float_saturate2int(std::ceil (bounds.fTop    - 0.5f)),
+                  right  = sk_float_saturate2int(std::floor(bounds.fRight  - 0.5f) + 1),
+                  bottom = sk_float_saturate2int(std::floor(bounds.fBottom - 0.5f) + 1);
+
+        const Edge e0(p1, p2), e1(p2, p0), e2(p0, p1);
+        const float invArea = 1 / area;
+        // Interpolated colors are c0 + w1*(c1 - c0) + w2*(c2 - c0) with w1 = e1/area and
+        // w2 = e2/area.
+        const skvx::float4 base = skvx::float4::Load(c0.vec()),
+                           d1   = (skvx::float4::Load(c1.vec()) - base) * invArea,
+                           d2   = (skvx::float4::Load(c2.vec()) - base) * invArea;
+
+        const skvx::float4 xOffsets = {0.5f, 1.5f, 2.5f, 3.5f};
+        for (int y = top; y < bottom; ++y) {
+            uint32_t* row = fDst.writable_addr32(0, y);
+            const float cy = y + 0.5f;
+            for (int x = left; x < right; x += 4) {
+                const int n = std::min(4, right - x);
+                const skvx::float4 cx = x + xOffsets;
+                const skvx::float4 w0 = e0.eval(cx, cy),
+                                   w1 = e1.eval(cx, cy),
+                                   w2 = e2.eval(cx, cy);
+                const skvx::int4 inside = e0.contains(w0) & e1.contains(w1) & e2.contains(w2) &
+                                          (skvx::int4{0, 1, 2, 3} < n);
+                if (!any(inside)) {
+                    continue;
+                }
+
+                skvx::float4 r = base[0] + w1*d1[0] + w2*d2[0],
+                             g = base[1] + w1*d1[1] + w2*d2[1],
+                             b = base[2] + w1*d1[2] + w2*d2[2],
+                             a = base[3] + w1*d1[3] + w2*d2[3];
+
+                uint32_t pixels[4] = {0, 0, 0, 0};
+                memcpy(pixels, row + x, n * sizeof(uint32_t));
+                const skvx::uint4 dst = skvx::uint4::Load(pixels);
+                if (fSrcOver) {
+                    auto channel = [&](int shift) {
+                        return skvx::cast<float>((dst >> shift) & 0xff) * (1 / 255.0f);
+                    };
+                    const skvx::float4 invA = 1 - pin(a, skvx::float4(0), skvx::float4(1));
+                    r += channel(SK_R32_SHIFT) * invA;
+                    g += channel(SK_G32_SHIFT) * invA;
+                    b += channel(SK_B32_SHIFT) * invA;
+                    a += channel(SK_A32_SHIFT) * invA;
+                }
+                auto unorm = [](skvx::float4 v, int shift) {
+                    v = pin(v, skvx::float4(0), skvx::float4(1));
+                    return skvx::cast<uint32_t>(skvx::lrint(v * 255)) << shift;
+                };
+                const skvx::uint4 src = unorm(r, SK_R32_SHIFT) | unorm(g, SK_G32_SHIFT) |
+                                        unorm(b, SK_B32_SHIFT) | unorm(a, SK_A32_SHIFT);
+                if_then_else(skvx::cast<uint32_t>(inside), src, dst).store(pixels);
+                memcpy(row + x, pixels, n * sizeof(uint32_t));
+            }
+        }
+    }
+
+private:
+    // The edge function of a->b is positive for points to its right (with y pointing down).
+    struct Edge {
+        Edge(SkPoint a, SkPoint b)
+                : fA(a), fD(b - a), fTopLeft(fD.fY < 0 || (fD.fY == 0 && fD.fX > 0)) {}
+
+        skvx::float4 eval(skvx::float4 x, float y) const {
+            return fD.fX * (y - fA.fY) - fD.fY * (x - fA.fX);
+        }
+
+        skvx::int4 contains(skvx::float4 e) const {
+            return fTopLeft ? e >= 0 : e > 0;
+        }
+
+        SkPoint fA, fD;
+        bool fTopLeft;
+    };
+
+    const SkPixmap& fDst;
+    const SkIRect   fClip;
+    const bool      fSrcOver;
+};
+}  // namespace
+
 void SkDraw::drawFixedVertices(const SkVertices* vertices,
                                sk_sp<SkBlender> blender,
                                const SkPaint& paint,
@@ -283,6 +405,40 @@ void SkDraw::drawFixedVertices(const SkVertices* vertices,
     VertState::Proc vertProc = state.chooseProc(info.mode());
     SkSurfaceProps props = SkSurfacePropsCopyOrDefault(fProps);
 
+    if (colors && !paintShader && dev2 && fDst.colorType() == kN32_SkColorType &&
+        fDst.alphaType() != kUnpremul_SkAlphaType && fRC->isRect() && !fRC->clipShader() &&
+        !paint.getColorFilter() && !paint.getMaskFilter() && !paint.isDither()) {
+        std::optional<SkBlendMode> paintMode = paint.asBlendMode();
+        std::optional<SkBlendMode> colorMode = as_BB(blender)->asBlendMode();
+        if ((paintMode == SkBlendMode::kSrc || paintMode == SkBlendMode::kSrcOver) &&
+            (blenderIsDst || colorMode == SkBlendMode::kModulate)) {
+            // Fold what the pipeline would do to the vertex colors into them: modulating them by
+            // the opaque paint color and scaling by the paint's alpha.
+            SkPMColor4f scale = {1, 1, 1, 1};
+            if (!blenderIsDst) {
+                SkColor4f paintColor = paint.getColor4f().makeOpaque();
+                SkColorSpaceXformSteps(sk_srgb_singleton(), kUnpremul_SkAlphaType,
+                                       fDst.colorSpace(), kUnpremul_SkAlphaType)
+                        .apply(paintColor.vec());
+                scale = paintColor.premul();
+            }
+            scale = scale * paint.getAlphaf();
+            if (scale != SkPMColor4f{1, 1, 1, 1}) {
+                for (int i = 0; i < vertexCount; ++i) {
+                    dstColors[i] = dstColors[i] * scale;
+                }
+            }
+
+            ColorTriangleFiller filler(fDst, fRC->getBounds(),
+                                       *paintMode == SkBlendMode::kSrcOver);
+            while (vertProc(&state)) {
+                filler.fill(dev2[state.f0], dev2[state.f1], dev2[state.f2],
+                            dstColors[state.f0], dstColors[state.f1], dstColors[state.f2]);
+            }
+            return;
+        }
+    }
+
     auto blitter = SkCreateRasterPipelineBlitter(fDst,
                                                  finalPaint,
                                                  *ctm,
@@ -9,7 +9,9 @@
 
 #include "include/core/SkRect.h"
 #include "include/private/base/SkTDArray.h"
+#include "include/private/base/SkTemplates.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkTSort.h"
 
 #include <cstddef>
 
@@ -89,4 +91,36 @@ private:
     void addCubic(const SkPoint pts[]) override;
     Combine addPolyLine(const SkPoint pts[], char* edge, char** edgePtr) override;
 };
+
+/**
+ *  Sorts the edges from an SkEdgeBuilder into the order the scan converters walk them: by the
+ *  int32_t 'topY' returns, and by '*a < *b' among edges with the same top.
+ *
+ *  Paths with many edges radix sort them by their top instead of comparing every pair, which only
+ *  leaves the edges that start on the same row to compare. The '*a < *b' ordering has to agree
+ *  with 'topY' for edges with different tops.
+ */
+template <typename Edge, typename TopY>
+void SkSortEdges(Edge* list[], int count, const TopY& topY) {
+    constexpr int kMinRadixSortCount = 64;
+    if (count < kMinRadixSortCount) {
+        SkTQSort(list, list + count);
+        return;
+    }
+
+    skia_private::AutoSTMalloc<256, Edge*> scratch(count);
+    SkTRadixSort(list, scratch.get(), count, [&](const Edge* edge) { return topY(*edge); });
+    for (int start = 0; start < count;) {
+        const int32_t y = topY(*list[start]);
+        int end = start + 1;
+        while (end < count && topY(*list[end]) == y) {
+            ++end;
+        }
+        if (end - start > 1) {
+            SkTQSort(list + start, list + end);
+        }
+        start = end;
+    }
+}
+
 #endif
@@ -11,6 +11,7 @@
 #include "include/private/base/SkTArray.h"
 #include "src/base/SkNoDestructor.h"
 
+#include <atomic>
 #include <deque>
 #include <thread>
 #include <utility>
@@ -153,3 +154,245 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads, bool all
     return std::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores(),
                                                     allowBorrowing);
 }
+
+// SkWorkStealingThreadPool gives each of its threads a Chase-Lev deque ("Dynamic Circular
+// Work-Stealing Deque", Chase & Lev 2005, with the C11 orderings from Lê et al. 2013). Only the
+// owning thread pushes and takes at the bottom; any thread may steal from the top. Work added by
+// threads outside the pool can't go on a deque, so it is spread round-robin across small
+// per-thread inboxes instead, each with its own lock.
+//
+// As in SkThreadPool, fWorkAvailable counts queued work. Whoever takes a count from it owns
+// exactly one queued item and keeps looking until it finds one.
+class SkWorkStealingThreadPool final : public SkExecutor {
+public:
+    SkWorkStealingThreadPool(int threads, bool allowBorrowing)
+            : fQueues(new Queue[threads])
+            , fQueueCount(threads)
+            , fAllowBorrowing(allowBorrowing) {
+        for (int i = 0; i < threads; i++) {
+            fThreads.emplace_back(&Loop, this, i);
+        }
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        // Signal each thread that it's time to shut down.
+        for (int i = 0; i < fThreads.size(); i++) {
+            this->push_to_inbox(new Work(nullptr));
+            fWorkAvailable.signal(1);
+        }
+        for (int i = 0; i < fThreads.size(); i++) {
+            fThreads[i].join();
+        }
+        // Free anything left queued after the shutdown signals were picked up.
+        for (int i = 0; i < fQueueCount; i++) {
+            while (Work* work = pop_inbox(&fQueues[i])) {
+                delete work;
+            }
+            while (Work* work = fQueues[i].fDeque.steal()) {
+                delete work;
+            }
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        auto item = new Work(std::move(work));
+        if (int me = this->current_thread(); me >= 0) {
+            fQueues[me].fDeque.push(item);
+        } else {
+            this->push_to_inbox(item);
+        }
+        fWorkAvailable.signal(1);
+    }
+
+    void borrow() override {
+        if (fAllowBorrowing && fWorkAvailable.try_wait()) {
+            // A pool thread waiting on nested work starts with its own deque, which is most
+            // likely to hold the work it is waiting for.
+            int me = this->current_thread();
+            SkAssertResult(this->do_work(me >= 0 ? me : 0));
+        }
+    }
+
+private:
+    using Work = std::function<void(void)>;
+
+    class Deque {
+    public:
+        Deque() : fArray(new Array(kInitialCapacity)) {}
+        ~Deque() {
+            delete fArray.load(std::memory_order_relaxed);
+            for (Array* a : fRetired) {
+                delete a;
+            }
+        }
+
+        // Owner only.
+        void push(Work* work) {
+            int64_t b = fBottom.load(std::memory_order_relaxed),
+                    t = fTop.load(std::memory_order_acquire);
+            Array* a = fArray.load(std::memory_order_relaxed);
+            if (b - t > a->fMask) {
+                a = this->grow(a, t, b);
+            }
+            a->put(b, work);
+            std::atomic_thread_fence(std::memory_order_release);
+            fBottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        // Owner only.  Takes the most recently pushed work, or returns null.
+        Work* take() {
+            int64_t b = fBottom.load(std::memory_order_relaxed) - 1;
+            Array* a = fArray.load(std::memory_order_relaxed);
+            fBottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = fTop.load(std::memory_order_relaxed);
+
+            Work* work = nullptr;
+            if (t <= b) {
+                work = a->get(b);
+                if (t == b) {
+                    // Last item: race any stealers for it.
+                    if (!fTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                                std::memory_order_relaxed)) {
+                        work = nullptr;
+                    }
+                    fBottom.store(b + 1, std::memory_order_relaxed);
+                }
+            } else {
+                fBottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return work;
+        }
+
+        // Any thread.  Takes the oldest work, or returns null if empty or we lost a race.
+        Work* steal() {
+            int64_t t = fTop.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = fBottom.load(std::memory_order_acquire);
+            if (t >= b) {
+                return nullptr;
+            }
+            Work* work = fArray.load(std::memory_order_acquire)->get(t);
+            if (!fTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                        std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return work;
+        }
+
+    private:
+        static constexpr int64_t kInitialCapacity = 64;
+
+        struct Array {
+            explicit Array(int64_t capacity)
+                    : fMask(capacity - 1)
+                    , fSlots(new std::atomic<Work*>[capacity]) {}
+
+            Work* get(int64_t i) const { return fSlots[i & fMask].load(std::memory_order_relaxed); }
+            void put(int64_t i, Work* w) { fSlots[i & fMask].store(w, std::memory_order_relaxed); }
+
+            const int64_t                        fMask;
+            std::unique_ptr<std::atomic<Work*>[]> fSlots;
+        };
+
+        Array* grow(Array* a, int64_t t, int64_t b) {
+            auto bigger = new Array(2 * (a->fMask + 1));
+            for (int64_t i = t; i < b; i++) {
+                bigger->put(i, a->get(i));
+            }
+            // Stealers may still be reading the old array, so it lives as long as the deque.
+            fRetired.push_back(a);
+            fArray.store(bigger, std::memory_order_release);
+            return bigger;
+        }
+
+        std::atomic<int64_t> fTop{0},
+                             fBottom{0};
+        std::atomic<Array*>  fArray;
+        TArray<Array*>       fRetired;  // Owner only.
+    };
+
+    struct Queue {
+        Deque                  fDeque;
+        SkMutex                fInboxLock;
+        std::deque<Work*>      fInbox SK_GUARDED_BY(fInboxLock);
+    };
+
+    // Returns the index of the calling thread if it belongs to this pool, otherwise -1.
+    int current_thread() const {
+        return tPool == this ? tThreadIndex : -1;
+    }
+
+    void push_to_inbox(Work* work) {
+        Queue& q = fQueues[fNextInbox.fetch_add(1, std::memory_order_relaxed) % fQueueCount];
+        SkAutoMutexExclusive lock(q.fInboxLock);
+        q.fInbox.push_back(work);
+    }
+
+    static Work* pop_inbox(Queue* q) {
+        SkAutoMutexExclusive lock(q->fInboxLock);
+        if (q->fInbox.empty()) {
+            return nullptr;
+        }
+        Work* work = q->fInbox.front();
+        q->fInbox.pop_front();
+        return work;
+    }
+
+    // This method should be called only when fWorkAvailable indicates there's work to do.
+    bool do_work(int start) {
+        std::unique_ptr<Work> work;
+        const bool isOwner = this->current_thread() == start;
+        const int n = fQueueCount;
+        while (!work) {
+            if (isOwner) {
+                work.reset(fQueues[start].fDeque.take());
+            }
+            for (int i = 0; !work && i < n; i++) {
+                Queue* q = &fQueues[(start + i) % n];
+                work.reset(pop_inbox(q));
+                if (!work) {
+                    work.reset(q->fDeque.steal());
+                }
+            }
+            if (!work) {
+                // Our item is in flight (mid-push, or contested by a racing steal).
+                std::this_thread::yield();
+            }
+        }
+
+        if (!*work) {
+            return false;  // This is Loop()'s signal to shut down.
+        }
+
+        (*work)();
+        return true;
+    }
+
+    static void Loop(SkWorkStealingThreadPool* pool, int index) {
+        tPool = pool;
+        tThreadIndex = index;
+        do {
+            pool->fWorkAvailable.wait();
+        } while (pool->do_work(index));
+    }
+
+    static thread_local const SkWorkStealingThreadPool* tPool;
+    static thread_local int tThreadIndex;
+
+    std::unique_ptr<Queue[]> fQueues;
+    const int                fQueueCount;
+    TArray<std::thread>      fThreads;
+    std::atomic<unsigned>    fNextInbox{0};
+    SkSemaphore              fWorkAvailable;
+    bool                     fAllowBorrowing;
+};
+
+thread_local const SkWorkStealingThreadPool* SkWorkStealingThreadPool::tPool = nullptr;
+thread_local int SkWorkStealingThreadPool::tThreadIndex = -1;
+
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads,
+                                                                   bool allowBorrowing) {
+    return std::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores(),
+                                                      allowBorrowing);
+}
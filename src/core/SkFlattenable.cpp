@@ -10,7 +10,10 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTDArray.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkNoDestructor.h"
 #include "src/core/SkPtrRecorder.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkWriteBuffer.h"
@@ -19,6 +22,7 @@
 #include <cstdint>
 #include <cstring>
 #include <iterator>
+#include <new>
 #include <utility>
 
 SkNamedFactorySet::SkNamedFactorySet() : fNextAddedFactory(0) {}
@@ -156,3 +160,142 @@ sk_sp<SkFlattenable> SkFlattenable::Deserialize(SkFlattenable::Type type, const
     }
     return sk_sp<SkFlattenable>(buffer.readFlattenable(type));
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined(SK_POOL_FLATTENABLES)
+
+namespace {
+
+// Blocks are cached by size class on free lists: one per thread, and a shared depot. A thread
+// refills its list from the depot in batches, and gives blocks back to the depot when its list is
+// full or when the thread exits. A block freed on another thread than the one that allocated it
+// just joins the freeing thread's list. Every block is its own ::operator new allocation, so
+// blocks that the lists can't hold go back to the system.
+constexpr size_t kGranularity = 16;
+constexpr size_t kMaxPooledSize = 256;
+constexpr int kSizeClasses = kMaxPooledSize / kGranularity;
+constexpr int kThreadLimit = 64;     // Blocks per size class per thread
+constexpr int kDepotLimit = 1024;    // Blocks per size class in the depot
+constexpr int kBatch = kThreadLimit / 2;
+
+int size_class(size_t size) { return SkToInt((size + kGranularity - 1) / kGranularity) - 1; }
+size_t class_size(int sizeClass) { return (sizeClass + 1) * kGranularity; }
+
+struct FreeList {
+    struct Block { Block* fNext; };
+
+    Block* fHead = nullptr;
+    int fCount = 0;
+
+    void push(void* ptr) {
+        Block* block = static_cast<Block*>(ptr);
+        block->fNext = fHead;
+        fHead = block;
+        fCount++;
+    }
+
+    void* pop() {
+        Block* block = fHead;
+        if (block) {
+            fHead = block->fNext;
+            fCount--;
+        }
+        return block;
+    }
+
+    // Moves blocks to 'dst' until this has 'keep' blocks left or 'dst' has 'limit' blocks, and
+    // frees the rest of the blocks above 'keep'.
+    void drainTo(FreeList* dst, int keep, int limit, int sizeClass) {
+        while (fCount > keep) {
+            void* block = this->pop();
+            if (dst->fCount < limit) {
+                dst->push(block);
+            } else {
+                ::operator delete(block, class_size(sizeClass));
+            }
+        }
+    }
+};
+
+class Depot {
+public:
+    void refill(int sizeClass, FreeList* list) {
+        SkAutoMutexExclusive lock(fMutex);
+        FreeList& depot = fLists[sizeClass];
+        for (int i = 0; i < kBatch && depot.fCount > 0; ++i) {
+            list->push(depot.pop());
+        }
+    }
+
+    void drain(int sizeClass, FreeList* list, int keep) {
+        SkAutoMutexExclusive lock(fMutex);
+        list->drainTo(&fLists[sizeClass], keep, kDepotLimit, sizeClass);
+    }
+
+private:
+    SkMutex fMutex;
+    FreeList fLists[kSizeClasses] SK_GUARDED_BY(fMutex);
+};
+
+Depot& depot() {
+    static SkNoDestructor<Depot> gDepot;
+    return *gDepot;
+}
+
+// Blocks freed by other thread_local destructors after this thread's cache is gone go straight to
+// the depot. This flag is trivially destructible, so it is still valid then.
+thread_local bool tThreadCacheDestroyed = false;
+
+struct ThreadCache {
+    FreeList fLists[kSizeClasses];
+
+    ~ThreadCache() {
+        for (int i = 0; i < kSizeClasses; ++i) {
+            depot().drain(i, &fLists[i], 0);
+        }
+        tThreadCacheDestroyed = true;
+    }
+};
+
+thread_local ThreadCache tThreadCache;
+
+}  // namespace
+
+void* SkFlattenable::operator new(size_t size) {
+    if (size == 0 || size > kMaxPooledSize) {
+        return ::operator new(size);
+    }
+    const int sizeClass = size_class(size);
+    if (!tThreadCacheDestroyed) {
+        FreeList& list = tThreadCache.fLists[sizeClass];
+        if (list.fCount == 0) {
+            depot().refill(sizeClass, &list);
+        }
+        if (void* block = list.pop()) {
+            return block;
+        }
+    }
+    return ::operator new(class_size(sizeClass));
+}
+
+void SkFlattenable::operator delete(void* ptr, size_t size) {
+    if (size == 0 || size > kMaxPooledSize) {
+        ::operator delete(ptr, size);
+        return;
+    }
+    const int sizeClass = size_class(size);
+    if (tThreadCacheDestroyed) {
+        FreeList single;
+        single.push(ptr);
+        depot().drain(sizeClass, &single, 0);
+        return;
+    }
+    FreeList& list = tThreadCache.fLists[sizeClass];
+    list.push(ptr);
+    if (list.fCount > kThreadLimit) {
+        depot().drain(sizeClass, &list, kThreadLimit - kBatch);
+    }
+}
+
+#endif  // defined(SK_POOL_FLATTENABLES)
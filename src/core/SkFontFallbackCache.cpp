@@ -0,0 +1,59 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkFontFallbackCache.h"
+
+#include "src/core/SkChecksum.h"
+
+#include <cstring>
+#include <utility>
+
+SkFontFallbackCache::Key::Key(const char familyName[], const SkFontStyle& style,
+                              const char* bcp47[], int bcp47Count, SkUnichar character)
+        : fHasFamilyName(familyName != nullptr)
+        , fFamilyName(familyName)
+        , fStyle(style)
+        , fCharacter(character) {
+    for (int i = 0; i < bcp47Count; ++i) {
+        fLanguages.append(bcp47[i], strlen(bcp47[i]) + 1);
+    }
+}
+
+uint32_t SkFontFallbackCache::KeyHash::operator()(const Key& key) const {
+    struct {
+        SkUnichar fCharacter;
+        int fWeight;
+        int fWidth;
+        int fSlant;
+        int fHasFamilyName;
+    } fixed = {key.fCharacter, key.fStyle.weight(), key.fStyle.width(), key.fStyle.slant(),
+               key.fHasFamilyName};
+    uint32_t hash = SkChecksum::Hash32(&fixed, sizeof(fixed));
+    hash = SkChecksum::Hash32(key.fFamilyName.c_str(), key.fFamilyName.size(), hash);
+    return SkChecksum::Hash32(key.fLanguages.c_str(), key.fLanguages.size(), hash);
+}
+
+bool SkFontFallbackCache::find(const char familyName[], const SkFontStyle& style,
+                               const char* bcp47[], int bcp47Count, SkUnichar character,
+                               sk_sp<SkTypeface>* typeface) const {
+    const Key key(familyName, style, bcp47, bcp47Count, character);
+    SkAutoMutexExclusive lock(fMutex);
+    if (sk_sp<SkTypeface>* found = fCache.find(key)) {
+        *typeface = *found;
+        return true;
+    }
+    return false;
+}
+
+void SkFontFallbackCache::add(const char familyName[], const SkFontStyle& style,
+                              const char* bcp47[], int bcp47Count, SkUnichar character,
+                              sk_sp<SkTypeface> typeface) const {
+    const Key key(familyName, style, bcp47, bcp47Count, character);
+    SkAutoMutexExclusive lock(fMutex);
+    // Another thread may have added the same request since this one missed.
+    fCache.insert_or_update(key, std::move(typeface));
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkFontFallbackCache_DEFINED
+#define SkFontFallbackCache_DEFINED
+
+#include "include/core/SkFontStyle.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkLRUCache.h"
+
+#include <cstdint>
+
+// Remembers the results of SkFontMgr::matchFamilyStyleCharacter, for font managers whose fonts
+// don't change after they are made. Text layout asks for a fallback typeface for every character
+// the requested fonts don't have, and walking the fallback fonts to find one is slow, so the same
+// request is answered from here after the first time. A request which no font could satisfy is
+// remembered too, as a null typeface.
+class SkFontFallbackCache {
+public:
+    explicit SkFontFallbackCache(int maxCount = kDefaultMaxCount) : fCache(maxCount) {}
+
+    // Returns true if the request is cached, setting 'typeface' to its (possibly null) result.
+    bool find(const char familyName[], const SkFontStyle& style,
+              const char* bcp47[], int bcp47Count, SkUnichar character,
+              sk_sp<SkTypeface>* typeface) const;
+
+    void add(const char familyName[], const SkFontStyle& style,
+             const char* bcp47[], int bcp47Count, SkUnichar character,
+             sk_sp<SkTypeface> typeface) const;
+
+private:
+    inline static constexpr int kDefaultMaxCount = 1024;
+
+    struct Key {
+        Key(const char familyName[], const SkFontStyle& style,
+            const char* bcp47[], int bcp47Count, SkUnichar character);
+
+        bool operator==(const Key& that) const {
+            return fCharacter == that.fCharacter &&
+                   fStyle == that.fStyle &&
+                   fHasFamilyName == that.fHasFamilyName &&
+                   fFamilyName == that.fFamilyName &&
+                   fLanguages == that.fLanguages;
+        }
+
+        // A null family name and an empty one may match differently.
+        bool fHasFamilyName;
+        SkString fFamilyName;
+        SkFontStyle fStyle;
+        // The bcp47 tags in order, each followed by a '\0', so that different lists never join
+        // to the same string.
+        SkString fLanguages;
+        SkUnichar fCharacter;
+    };
+
+    struct KeyHash {
+        uint32_t operator()(const Key& key) const;
+    };
+
+    mutable SkMutex fMutex;
+    mutable SkLRUCache<Key, sk_sp<SkTypeface>, KeyHash> fCache SK_GUARDED_BY(fMutex);
+};
+
+#endif  // SkFontFallbackCache_DEFINED
@@ -155,6 +155,7 @@ static size_t format_alignment(SkMask::Format format) {
         case SkMask::kSDF_Format:
             return alignof(uint8_t);
         case SkMask::kARGB32_Format:
+        case SkMask::kMSDF_Format:
             return alignof(uint32_t);
         case SkMask::kLCD16_Format:
             return alignof(uint16_t);
@@ -659,7 +660,8 @@ void SkGlyphDigest::setActionFor(skglyph::ActionType actionType,
             }
             case kSDFT: {
                 if (this->fitsInAtlasDirect() &&
-                    this->maskFormat() == SkMask::Format::kSDF_Format) {
+                    (this->maskFormat() == SkMask::Format::kSDF_Format ||
+                     this->maskFormat() == SkMask::Format::kMSDF_Format)) {
                     action = GlyphAction::kAccept;
                 }
                 break;
@@ -558,6 +558,7 @@ private:
     // access to all the fields. Scalers are assumed to maintain all the SkGlyph invariants. The
     // consumer side has a tighter interface.
     friend class SkScalerContext;
+    friend class SkStrike;  // for allocImage when rasterizing images in parallel
     friend class SkGlyphTestPeer;
 
     inline static constexpr uint16_t kMaxGlyphWidth = 1u << 13u;
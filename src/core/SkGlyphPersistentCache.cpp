@@ -0,0 +1,100 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkGlyphPersistentCache.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "include/private/base/SkAlign.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkOSFile.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// Each file holds one entry:
+//    uint32_t magic, key size, data size
+//    the key, padded to 4 bytes
+//    the data
+// The file is named for the hash of the key, and the key is checked on load in case two keys
+// have the same hash.
+constexpr uint32_t kMagic = SkSetFourByteTag('s', 'k', 'g', '1');
+constexpr size_t kHeaderSize = 3 * sizeof(uint32_t);
+
+class DirectoryCache final : public SkGlyphPersistentCache {
+public:
+    explicit DirectoryCache(const char* directory) : fDirectory{directory} {}
+
+    sk_sp<SkData> load(const SkData& key) override {
+        const SkString path = this->pathFor(key);
+        sk_sp<SkData> file = SkData::MakeFromFileName(path.c_str());
+        if (file == nullptr || file->size() < kHeaderSize) {
+            return nullptr;
+        }
+
+        uint32_t header[3];
+        memcpy(header, file->data(), kHeaderSize);
+        const size_t keyBytes = SkAlign4(header[1]);
+        if (header[0] != kMagic || header[1] != key.size() ||
+            file->size() - kHeaderSize < keyBytes ||
+            file->size() - kHeaderSize - keyBytes != header[2] ||
+            memcmp(file->bytes() + kHeaderSize, key.data(), key.size()) != 0) {
+            return nullptr;
+        }
+
+        // The subset keeps the mapping of the file alive.
+        return SkData::MakeSubset(file.get(), kHeaderSize + keyBytes, header[2]);
+    }
+
+    void store(const SkData& key, const SkData& data) override {
+        if (!SkTFitsIn<uint32_t>(key.size()) || !SkTFitsIn<uint32_t>(data.size())) {
+            return;
+        }
+        if (!sk_isdir(fDirectory.c_str()) && !sk_mkdir(fDirectory.c_str())) {
+            return;
+        }
+
+        const SkString path = this->pathFor(key);
+        SkFILEWStream file{path.c_str()};
+        if (!file.isValid()) {
+            return;
+        }
+        // A file which is only partly written, e.g. because the disk is full, fails the size
+        // check on load.
+        const uint32_t header[3] = {kMagic, SkToU32(key.size()), SkToU32(data.size())};
+        static constexpr char kPadding[4] = {};
+        if (file.write(header, kHeaderSize) &&
+            file.write(key.data(), key.size()) &&
+            file.write(kPadding, SkAlign4(key.size()) - key.size()) &&
+            file.write(data.data(), data.size())) {
+            file.flush();
+        }
+    }
+
+private:
+    SkString pathFor(const SkData& key) const {
+        return SkStringPrintf("%s/%016llx.glyphs",
+                              fDirectory.c_str(),
+                              (unsigned long long)SkChecksum::Hash64(key.data(), key.size()));
+    }
+
+    const SkString fDirectory;
+};
+
+}  // namespace
+
+std::unique_ptr<SkGlyphPersistentCache> SkGlyphPersistentCache::MakeDirectoryCache(
+        const char* directory) {
+    if (directory == nullptr || directory[0] == '\0') {
+        return nullptr;
+    }
+    return std::make_unique<DirectoryCache>(directory);
+}
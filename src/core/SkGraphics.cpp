@@ -10,14 +10,19 @@
 #include "src/core/SkBitmapProcState.h"
 #include "src/core/SkBlitMask.h"
 #include "src/core/SkBlitRow.h"
+#include "src/core/SkCounters.h"
 #include "src/core/SkCpu.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkMemset.h"
+#include "src/core/SkMipmap.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkRuntimeEffectPriv.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkSwizzlePriv.h"
 #include "src/core/SkTypefaceCache.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLProgramKind.h"
 
 void SkGraphics::Init() {
     // SkGraphics::Init() must be thread-safe and idempotent.
@@ -27,6 +32,7 @@ void SkGraphics::Init() {
     SkOpts::Init_BlitMask();
     SkOpts::Init_BlitRow();
     SkOpts::Init_Memset();
+    SkOpts::Init_Mipmap();
     SkOpts::Init_Swizzler();
 }
 
@@ -41,6 +47,39 @@ void SkGraphics::PurgeAllCaches() {
     SkGraphics::PurgeFontCache();
     SkGraphics::PurgeResourceCache();
     SkImageFilter_Base::PurgeCache();
+    SkRuntimeEffectPriv::PurgeCache();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Constant-initialized, so it can be counted into from other static initializers.
+static SkShardedCounters<kSkCounterCount> gCounters;
+
+SkShardedCounters<kSkCounterCount>& SkGlobalCounters() {
+    return gCounters;
+}
+
+SkGraphics::Stats SkGraphics::Stats::operator-(const Stats& before) const {
+    Stats diff;
+    diff.fStrikeCacheHits       = fStrikeCacheHits       - before.fStrikeCacheHits;
+    diff.fStrikeCacheMisses     = fStrikeCacheMisses     - before.fStrikeCacheMisses;
+    diff.fGlyphImagesRasterized = fGlyphImagesRasterized - before.fGlyphImagesRasterized;
+    diff.fGlyphPathsGenerated   = fGlyphPathsGenerated   - before.fGlyphPathsGenerated;
+    diff.fResourceCacheHits     = fResourceCacheHits     - before.fResourceCacheHits;
+    diff.fResourceCacheMisses   = fResourceCacheMisses   - before.fResourceCacheMisses;
+    return diff;
+}
+
+SkGraphics::Stats SkGraphics::GetStats() {
+    auto get = [](SkCounter counter) { return gCounters.get(static_cast<int>(counter)); };
+    Stats stats;
+    stats.fStrikeCacheHits       = get(SkCounter::kStrikeCacheHits);
+    stats.fStrikeCacheMisses     = get(SkCounter::kStrikeCacheMisses);
+    stats.fGlyphImagesRasterized = get(SkCounter::kGlyphImagesRasterized);
+    stats.fGlyphPathsGenerated   = get(SkCounter::kGlyphPathsGenerated);
+    stats.fResourceCacheHits     = get(SkCounter::kResourceCacheHits);
+    stats.fResourceCacheMisses   = get(SkCounter::kResourceCacheMisses);
+    return stats;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -65,6 +104,19 @@ int SkGraphics::SetFontCacheCountLimit(int count) {
     return SkStrikeCache::GlobalStrikeCache()->setCacheCountLimit(count);
 }
 
+void SkGraphics::SetFontCacheRasterExecutor(SkExecutor* executor) {
+    SkStrikeCache::GlobalStrikeCache()->setGlyphRasterExecutor(executor);
+}
+
+void SkGraphics::SetFontCachePersistentCache(SkGlyphPersistentCache* persistentCache,
+                                             SkExecutor* storeExecutor) {
+    SkStrikeCache::GlobalStrikeCache()->setPersistentCache(persistentCache, storeExecutor);
+}
+
+void SkGraphics::SaveFontCacheToPersistentCache() {
+    SkStrikeCache::GlobalStrikeCache()->storeToPersistentCache();
+}
+
 int SkGraphics::GetFontCacheCountUsed() {
     return SkStrikeCache::GlobalStrikeCache()->getCacheCountUsed();
 }
@@ -90,6 +142,41 @@ int SkGraphics::SetTypefaceCacheCountLimit(int count) {
     return prev;
 }
 
+int SkGraphics::GetRuntimeEffectCacheCountLimit() {
+    return SkRuntimeEffectPriv::GetCacheCountLimit();
+}
+
+int SkGraphics::SetRuntimeEffectCacheCountLimit(int count) {
+    return SkRuntimeEffectPriv::SetCacheCountLimit(count);
+}
+
+int SkGraphics::GetRuntimeEffectCacheCountUsed() {
+    return SkRuntimeEffectPriv::GetCacheCountUsed();
+}
+
+void SkGraphics::PreloadSkSLModules() {
+    // Each kind loads its module along with every module that module builds on.
+    static constexpr SkSL::ProgramKind kKinds[] = {
+        SkSL::ProgramKind::kRuntimeShader,
+        SkSL::ProgramKind::kPrivateRuntimeShader,
+#if defined(SK_GANESH) || defined(SK_GRAPHITE)
+        SkSL::ProgramKind::kFragment,
+        SkSL::ProgramKind::kVertex,
+#endif
+#if defined(SK_GRAPHITE)
+        SkSL::ProgramKind::kCompute,
+        SkSL::ProgramKind::kGraphiteFragment,
+        SkSL::ProgramKind::kGraphiteVertex,
+        SkSL::ProgramKind::kGraphiteFragmentES2,
+        SkSL::ProgramKind::kGraphiteVertexES2,
+#endif
+    };
+    SkSL::Compiler compiler;
+    for (SkSL::ProgramKind kind : kKinds) {
+        compiler.moduleForProgramKind(kind);
+    }
+}
+
 static SkGraphics::OpenTypeSVGDecoderFactory gSVGDecoderFactory = nullptr;
 
 SkGraphics::OpenTypeSVGDecoderFactory
@@ -50,6 +50,7 @@ void List::add(sk_sp<SkIDChangeListener> listener) {
         }
     }
     fListeners.push_back(std::move(listener));
+    fCount.store(fListeners.size(), std::memory_order_release);
 }
 
 int List::count() const {
@@ -58,6 +59,9 @@ int List::count() const {
 }
 
 void List::changed() {
+    if (fCount.load(std::memory_order_acquire) == 0) {
+        return;
+    }
     SkAutoMutexExclusive lock(fMutex);
     for (auto& listener : fListeners) {
         if (!listener->shouldDeregister()) {
@@ -65,9 +69,14 @@ void List::changed() {
         }
     }
     fListeners.clear();
+    fCount.store(0, std::memory_order_relaxed);
 }
 
 void List::reset() {
+    if (fCount.load(std::memory_order_acquire) == 0) {
+        return;
+    }
     SkAutoMutexExclusive lock(fMutex);
     fListeners.clear();
+    fCount.store(0, std::memory_order_relaxed);
 }
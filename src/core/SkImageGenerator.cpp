@@ -31,6 +31,17 @@ bool SkImageGenerator::getPixels(const SkImageInfo& info, void* pixels, size_t r
     return this->onGetPixels(info, pixels, rowBytes, defaultOpts);
 }
 
+bool SkImageGenerator::getSubsetPixels(const SkPixmap& dst, const SkIRect& subset) {
+    if (kUnknown_SkColorType == dst.colorType() || !dst.addr()) {
+        return false;
+    }
+    if (subset.isEmpty() || !SkIRect::MakeSize(fInfo.dimensions()).contains(subset) ||
+        dst.dimensions() != subset.size()) {
+        return false;
+    }
+    return this->onGetSubsetPixels(dst, subset);
+}
+
 bool SkImageGenerator::queryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
                                      SkYUVAPixmapInfo* yuvaPixmapInfo) const {
     SkASSERT(yuvaPixmapInfo);
@@ -31,6 +31,29 @@ SkRuntimeEffect* GetKnownRuntimeEffect(StableKey stableKey) {
                                         options);
             return sBlendEffect;
         }
+        case StableKey::kRRectShadow: {
+            // The analytic shadow of a circular rrect, evaluated at device coordinates. 'rect' and
+            // 'radius' are the shadow rrect outset to the border of the penumbra, and the alpha
+            // falls off over 'blurWidth' inside that border with the same Gaussian curve as
+            // Ganesh's ShadowRRectOp.
+            static SkRuntimeEffect* sRRectShadowEffect =
+                    SkMakeRuntimeEffect(SkRuntimeEffect::MakeForShader,
+                                        "uniform float4 rect;"
+                                        "uniform float radius;"
+                                        "uniform float blurWidth;"
+                                        "layout(color) uniform half4 color;"
+                                        "half4 main(float2 xy) {"
+                                            "float2 q = abs(xy - 0.5*(rect.xy + rect.zw)) -"
+                                                       "0.5*(rect.zw - rect.xy) + radius;"
+                                            "float dist = length(max(q, 0)) +"
+                                                         "min(max(q.x, q.y), 0) - radius;"
+                                            "half d = half(saturate(1 + dist/blurWidth));"
+                                            "half factor = max(exp(-4*d*d) - 0.018, 0);"
+                                            "return half4(color.rgb, 1) * (color.a * factor);"
+                                        "}",
+                                        options);
+            return sRRectShadowEffect;
+        }
     }
 
     SkUNREACHABLE;
@@ -55,8 +55,9 @@ enum class StableKey : uint32_t {
 
     kInvalid = kStart,
     kBlend,
+    kRRectShadow,
 
-    kLast =    kBlend,
+    kLast =    kRRectShadow,
 };
 
 static const int kStableKeyCnt = static_cast<int>(StableKey::kLast) -
@@ -84,6 +84,25 @@ public:
         return fMap.count();
     }
 
+    int maxCount() const {
+        return fMaxCount;
+    }
+
+    // Evicts the least recently used entries until the cache fits the new limit.
+    void setMaxCount(int maxCount) {
+        fMaxCount = maxCount;
+        while (fMap.count() > fMaxCount) {
+            this->remove(fLRU.tail()->fKey);
+        }
+    }
+
+    // Removes the least recently used entry, if the cache isn't empty.
+    void removeLRU() {
+        if (Entry* tail = fLRU.tail()) {
+            this->remove(tail->fKey);
+        }
+    }
+
     template <typename Fn>  // f(K*, V*)
     void foreach(Fn&& fn) {
         typename SkTInternalLList<Entry>::Iter iter;
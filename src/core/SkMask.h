@@ -30,10 +30,12 @@ struct SkMask {
         kARGB32_Format,         //!< SkPMColor
         kLCD16_Format,          //!< 565 alpha for r/g/b
         kSDF_Format,            //!< 8bits representing signed distance field
+        kMSDF_Format,           //!< SkPMColor: r,g,b are a multi-channel signed distance field,
+                                //!< a is the single-channel signed distance field
     };
 
     enum {
-        kCountMaskFormats = kSDF_Format + 1
+        kCountMaskFormats = kMSDF_Format + 1
     };
 
     SkMask(const uint8_t* img, const SkIRect& bounds, uint32_t rowBytes, Format format)
@@ -7,10 +7,14 @@
 
 #include "src/core/SkMaskCache.h"
 
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkFloatingPoint.h"
 #include "src/base/SkTLazy.h"
 #include "src/core/SkCachedData.h"
 #include "src/core/SkMask.h"
@@ -195,3 +199,105 @@ void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style,
     RectsBlurKey key(sigma, style, rects, count);
     return CHECK_LOCAL(localCache, add, Add, new RectsBlurRec(key, mask, data));
 }
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+static unsigned gPathBlurKeyNamespaceLabel;
+
+struct PathBlurKey : public SkResourceCache::Key {
+public:
+    PathBlurKey(SkScalar sigma, SkBlurStyle style, const SkPath& path, const SkMatrix& matrix)
+        : fSigma(sigma)
+        , fStyle(style)
+        , fGenID(path.getGenerationID())
+        , fFillType(static_cast<int32_t>(path.getFillType()))
+        , fScaleX(matrix.getScaleX())
+        , fSkewX(matrix.getSkewX())
+        , fSkewY(matrix.getSkewY())
+        , fScaleY(matrix.getScaleY())
+        , fSubpixelX(matrix.getTranslateX() - sk_float_floor(matrix.getTranslateX()))
+        , fSubpixelY(matrix.getTranslateY() - sk_float_floor(matrix.getTranslateY()))
+    {
+        SkASSERT(matrix.isFinite() && !matrix.hasPerspective());
+        this->init(&gPathBlurKeyNamespaceLabel, 0,
+                   sizeof(fSigma) + sizeof(fStyle) + sizeof(fGenID) + sizeof(fFillType) +
+                   sizeof(fScaleX) + sizeof(fSkewX) + sizeof(fSkewY) + sizeof(fScaleY) +
+                   sizeof(fSubpixelX) + sizeof(fSubpixelY));
+    }
+
+    SkScalar    fSigma;
+    int32_t     fStyle;
+    uint32_t    fGenID;
+    int32_t     fFillType;
+    SkScalar    fScaleX, fSkewX, fSkewY, fScaleY;
+    SkScalar    fSubpixelX, fSubpixelY;
+};
+
+struct PathBlurRec : public SkResourceCache::Rec {
+    PathBlurRec(PathBlurKey key, const SkMask& mask, SkCachedData* data)
+        : fKey(key), fValue({{nullptr, mask.fBounds, mask.fRowBytes, mask.fFormat}, data})
+    {
+        fValue.fData->attachToCacheAndRef();
+    }
+    ~PathBlurRec() override {
+        fValue.fData->detachFromCacheAndUnref();
+    }
+
+    PathBlurKey    fKey;
+    MaskValue      fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fValue.fData->size(); }
+    const char* getCategory() const override { return "path-blur"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override {
+        return fValue.fData->diagnostic_only_getDiscardable();
+    }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PathBlurRec& rec = static_cast<const PathBlurRec&>(baseRec);
+        SkTLazy<MaskValue>* result = static_cast<SkTLazy<MaskValue>*>(contextData);
+
+        SkCachedData* tmpData = rec.fValue.fData;
+        tmpData->ref();
+        if (nullptr == tmpData->data()) {
+            tmpData->unref();
+            return false;
+        }
+        result->init(rec.fValue);
+        return true;
+    }
+};
+
+// The cached masks are stored relative to the integer part of the matrix's translation.
+SkIPoint integer_translate(const SkMatrix& matrix) {
+    return {sk_float_floor2int(matrix.getTranslateX()), sk_float_floor2int(matrix.getTranslateY())};
+}
+} // namespace
+
+SkCachedData* SkMaskCache::FindAndRef(SkScalar sigma, SkBlurStyle style,
+                                      const SkPath& path, const SkMatrix& matrix,
+                                      SkTLazy<SkMask>* mask,
+                                      SkResourceCache* localCache) {
+    SkTLazy<MaskValue> result;
+    PathBlurKey key(sigma, style, path, matrix);
+    if (!CHECK_LOCAL(localCache, find, Find, key, PathBlurRec::Visitor, &result)) {
+        return nullptr;
+    }
+
+    SkIPoint offset = integer_translate(matrix);
+    mask->init(static_cast<const uint8_t*>(result->fData->data()),
+               result->fMask.fBounds.makeOffset(offset.fX, offset.fY),
+               result->fMask.fRowBytes, result->fMask.fFormat);
+    return result->fData;
+}
+
+void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style,
+                      const SkPath& path, const SkMatrix& matrix, const SkMask& mask,
+                      SkCachedData* data, SkResourceCache* localCache) {
+    PathBlurKey key(sigma, style, path, matrix);
+    SkIPoint offset = integer_translate(matrix);
+    SkMask relativeMask(nullptr, mask.fBounds.makeOffset(-offset.fX, -offset.fY),
+                        mask.fRowBytes, mask.fFormat);
+    return CHECK_LOCAL(localCache, add, Add, new PathBlurRec(key, relativeMask, data));
+}
@@ -11,6 +11,8 @@
 #include "include/core/SkScalar.h"
 
 class SkCachedData;
+class SkMatrix;
+class SkPath;
 class SkRRect;
 class SkResourceCache;
 enum SkBlurStyle : int;
@@ -32,6 +34,15 @@ public:
     static SkCachedData* FindAndRef(SkScalar sigma, SkBlurStyle style,
                                     const SkRect rects[], int count, SkTLazy<SkMask>* mask,
                                     SkResourceCache* localCache = nullptr);
+    /**
+     * Finds the blur of a filled 'path' drawn with an affine 'matrix'. The cached mask is shared by
+     * all the matrices that only differ in the integer part of their translation; the returned
+     * mask is moved to the translation of 'matrix'.
+     */
+    static SkCachedData* FindAndRef(SkScalar sigma, SkBlurStyle style,
+                                    const SkPath& path, const SkMatrix& matrix,
+                                    SkTLazy<SkMask>* mask,
+                                    SkResourceCache* localCache = nullptr);
 
     /**
      * Add a mask and its pixel-data to the cache.
@@ -42,6 +53,9 @@ public:
     static void Add(SkScalar sigma, SkBlurStyle style,
                     const SkRect rects[], int count, const SkMask& mask, SkCachedData* data,
                     SkResourceCache* localCache = nullptr);
+    static void Add(SkScalar sigma, SkBlurStyle style,
+                    const SkPath& path, const SkMatrix& matrix, const SkMask& mask,
+                    SkCachedData* data, SkResourceCache* localCache = nullptr);
 };
 
 #endif
@@ -23,12 +23,15 @@
 #include "src/core/SkCachedData.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkMask.h"
+#include "src/core/SkMaskCache.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkRasterClip.h"
+#include "src/core/SkResourceCache.h"
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 class SkRRect;
 struct SkDeserialProcs;
@@ -226,9 +229,24 @@ bool SkMaskFilterBase::filterRRect(const SkRRect& devRRect, const SkMatrix& matr
     return true;
 }
 
+static void blit_clipped_mask(const SkMask& mask, const SkRasterClip& clip, SkBlitter* blitter) {
+    SkAAClipBlitterWrapper wrapper(clip, blitter);
+    blitter = wrapper.getBlitter();
+
+    SkRegion::Cliperator clipper(wrapper.getRgn(), mask.fBounds);
+
+    if (!clipper.done()) {
+        const SkIRect& cr = clipper.rect();
+        do {
+            blitter->blitMask(mask, cr);
+            clipper.next();
+        } while (!clipper.done());
+    }
+}
+
 bool SkMaskFilterBase::filterPath(const SkPath& devPath, const SkMatrix& matrix,
                                   const SkRasterClip& clip, SkBlitter* blitter,
-                                  SkStrokeRec::InitStyle style) const {
+                                  SkStrokeRec::InitStyle style, const SkPath* srcPath) const {
     SkRect rects[2];
     int rectCount = 0;
     if (SkStrokeRec::kFill_InitStyle == style) {
@@ -254,6 +272,24 @@ bool SkMaskFilterBase::filterPath(const SkPath& devPath, const SkMatrix& matrix,
         }
     }
 
+    // Blurs of a path that won't be edited are cached. Drawing it again with the same matrix, or
+    // moved by whole pixels, reuses the mask. Inverse fills aren't, since their masks cover the
+    // clip rather than the path.
+    BlurRec blurRec;
+    const bool cacheable = srcPath && !srcPath->isVolatile() && !srcPath->isInverseFillType() &&
+                           SkStrokeRec::kFill_InitStyle == style &&
+                           matrix.isFinite() && !matrix.hasPerspective() &&
+                           this->asABlur(&blurRec);
+    if (cacheable) {
+        SkTLazy<SkMask> cachedMask;
+        sk_sp<SkCachedData> data(SkMaskCache::FindAndRef(blurRec.fSigma, blurRec.fStyle,
+                                                         *srcPath, matrix, &cachedMask));
+        if (data) {
+            blit_clipped_mask(*cachedMask, clip, blitter);
+            return true;
+        }
+    }
+
     SkMaskBuilder srcM, dstM;
 
 #if defined(SK_BUILD_FOR_FUZZER)
@@ -273,20 +309,19 @@ bool SkMaskFilterBase::filterPath(const SkPath& devPath, const SkMatrix& matrix,
     }
     SkAutoMaskFreeImage autoDst(dstM.image());
 
-    // if we get here, we need to (possibly) resolve the clip and blitter
-    SkAAClipBlitterWrapper wrapper(clip, blitter);
-    blitter = wrapper.getBlitter();
-
-    SkRegion::Cliperator clipper(wrapper.getRgn(), dstM.fBounds);
-
-    if (!clipper.done()) {
-        const SkIRect& cr = clipper.rect();
-        do {
-            blitter->blitMask(dstM, cr);
-            clipper.next();
-        } while (!clipper.done());
+    // Only masks of the whole path can be reused, since the next draw may have another clip.
+    const SkIRect unclippedBounds = devPath.getBounds().makeOutset(SK_ScalarHalf,
+                                                                   SK_ScalarHalf).roundOut();
+    if (cacheable && srcM.fBounds == unclippedBounds) {
+        const size_t size = dstM.computeTotalImageSize();
+        if (SkCachedData* data = SkResourceCache::NewCachedData(size)) {
+            memcpy(data->writable_data(), dstM.fImage, size);
+            SkMaskCache::Add(blurRec.fSigma, blurRec.fStyle, *srcPath, matrix, dstM, data);
+            data->unref();
+        }
     }
 
+    blit_clipped_mask(dstM, clip, blitter);
     return true;
 }
 
@@ -168,9 +168,11 @@ private:
      and then call filterMask(). If this returns true, the specified blitter will be called
      to render that mask. Returns false if filterMask() returned false.
      This method is not exported to java.
+     If 'srcPath' is not null, 'devPath' is 'srcPath' transformed by 'ctm', and blurs of filled,
+     non-volatile source paths are cached.
      */
     bool filterPath(const SkPath& devPath, const SkMatrix& ctm, const SkRasterClip&, SkBlitter*,
-                    SkStrokeRec::InitStyle) const;
+                    SkStrokeRec::InitStyle, const SkPath* srcPath = nullptr) const;
 
     /** Helper method that, given a roundRect in device space, will rasterize it into a kA8_Format
      mask and then call filterMask(). If this returns true, the specified blitter will be called
@@ -957,6 +957,25 @@ void SkMatrix::Persp_pts(const SkMatrix& m, SkPoint dst[],
                          const SkPoint src[], int count) {
     SkASSERT(m.hasPerspective());
 
+    // Map four points at a time, with their xs and ys split into separate vectors. This is the
+    // same math as the loop below, so points map the same whichever path they take.
+    const skvx::float4 sx(m.fMat[kMScaleX]), kx(m.fMat[kMSkewX]),  tx(m.fMat[kMTransX]),
+                       ky(m.fMat[kMSkewY]),  sy(m.fMat[kMScaleY]), ty(m.fMat[kMTransY]),
+                       p0(m.fMat[kMPersp0]), p1(m.fMat[kMPersp1]), p2(m.fMat[kMPersp2]);
+    for (; count >= 4; count -= 4) {
+        skvx::float4 srcX, srcY;
+        skvx::strided_load2(&src->fX, srcX, srcY);
+        src += 4;
+
+        skvx::float4 x = srcX * sx + srcY * kx + tx;
+        skvx::float4 y = srcX * ky + srcY * sy + ty;
+        skvx::float4 z = srcX * p0 + srcY * p1 + p2;
+        z = skvx::if_then_else(z != 0, 1 / z, skvx::float4(0));
+
+        skvx::shuffle<0,4,1,5,2,6,3,7>(skvx::join(x * z, y * z)).store(dst);
+        dst += 4;
+    }
+
     if (count > 0) {
         do {
             SkScalar sy = src->fY;
@@ -992,13 +1011,22 @@ void SkMatrix::Affine_vpts(const SkMatrix& m, SkPoint dst[], const SkPoint src[]
         bool trailingElement = (count & 1);
         count >>= 1;
         skvx::float4 src4;
-        for (int i = 0; i < count; ++i) {
+        if (count & 1) {
             src4 = skvx::float4::Load(src);
             skvx::float4 swz4 = skvx::shuffle<1,0,3,2>(src4);  // y0 x0, y1 x1
             (src4 * scale4 + swz4 * skew4 + trans4).store(dst);
             src += 2;
             dst += 2;
         }
+        count >>= 1;
+        for (int i = 0; i < count; ++i) {
+            skvx::float4 src0 = skvx::float4::Load(src+0),
+                         src1 = skvx::float4::Load(src+2);
+            (src0 * scale4 + skvx::shuffle<1,0,3,2>(src0) * skew4 + trans4).store(dst+0);
+            (src1 * scale4 + skvx::shuffle<1,0,3,2>(src1) * skew4 + trans4).store(dst+2);
+            src += 4;
+            dst += 4;
+        }
         if (trailingElement) {
             // We use the same logic here to ensure that the math stays consistent throughout, even
             // though the high float2 is ignored.
@@ -10,8 +10,11 @@
 
 #include "include/core/SkData.h"
 #include "include/core/SkMesh.h"
+#include "include/private/base/SkMutex.h"
 #include "src/core/SkSLTypeShared.h"
 
+#include <algorithm>
+
 struct SkMeshSpecificationPriv {
     using Varying   = SkMeshSpecification::Varying;
     using Attribute = SkMeshSpecification::Attribute;
@@ -106,12 +109,33 @@ public:
 
     size_t size() const override { return fData->size(); }
 
+    /**
+     * A GPU-backed copy of the buffer that draws may use instead of uploading the data each time
+     * (see GrMeshBuffers.cpp). fDirtyStart/End bound the bytes updated since the copy was last
+     * brought up to date.
+     */
+    struct GpuCopy {
+        sk_sp<Base> fBuffer;
+        size_t      fDirtyStart = 0;
+        size_t      fDirtyEnd   = 0;
+        int         fDrawCount  = 0;
+        bool        fRewrittenBetweenDraws = false;
+    };
+
+    /** Calls fn(const SkData&, GpuCopy&) with updates to the buffer locked out. */
+    template <typename Fn> auto withGpuCopy(Fn&& fn) {
+        SkAutoMutexExclusive lock(fMutex);
+        return fn(*fData, fGpuCopy);
+    }
+
 private:
     CpuBuffer(sk_sp<SkData> data) : fData(std::move(data)) {}
 
     bool onUpdate(GrDirectContext*, const void* data, size_t offset, size_t size) override;
 
     sk_sp<SkData> fData;
+    SkMutex       fMutex;
+    GpuCopy       fGpuCopy SK_GUARDED_BY(fMutex);
 };
 
 using CpuIndexBuffer  = CpuBuffer<IB>;
@@ -139,7 +163,17 @@ template <typename Base> bool SkMeshPriv::CpuBuffer<Base>::onUpdate(GrDirectCont
     if (dc) {
         return false;
     }
+    SkAutoMutexExclusive lock(fMutex);
     std::memcpy(SkTAddOffset<void>(fData->writable_data(), offset), data, size);
+    if (fGpuCopy.fBuffer) {
+        if (fGpuCopy.fDirtyStart == fGpuCopy.fDirtyEnd) {
+            fGpuCopy.fDirtyStart = offset;
+            fGpuCopy.fDirtyEnd   = offset + size;
+        } else {
+            fGpuCopy.fDirtyStart = std::min(fGpuCopy.fDirtyStart, offset);
+            fGpuCopy.fDirtyEnd   = std::max(fGpuCopy.fDirtyEnd, offset + size);
+        }
+    }
     return true;
 }
 
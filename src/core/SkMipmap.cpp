@@ -14,7 +14,9 @@
 #include "src/base/SkMathPriv.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkMipmapBuilder.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
 #include <new>
 
 //
@@ -26,6 +28,44 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Builds one level, splitting it into bands of rows which run in parallel on 'executor' when the
+// level is big enough for that to pay off.
+static void build_level(SkMipmapDownSampler* downsampler,
+                        const SkPixmap& dst,
+                        const SkPixmap& src,
+                        SkExecutor* executor) {
+    static constexpr int kMinPixelsPerBand = 64 * 1024;
+    static constexpr int kMaxBands = 8;
+
+    int bands = 1;
+    if (executor && downsampler->canBuildInBands()) {
+        bands = (int)std::min<int64_t>(dst.dimensions().area() / kMinPixelsPerBand, kMaxBands);
+        bands = std::min(bands, dst.height());
+    }
+    if (bands <= 1) {
+        downsampler->buildLevel(dst, src);
+        return;
+    }
+
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(bands, [&](int band) {
+        const int top = dst.height() * band / bands;
+        const int bottom = dst.height() * (band + 1) / bands;
+        // Each dst row is filtered from the two src rows beneath it, plus the next one when the
+        // src height is odd.
+        const int srcTop = 2 * top;
+        const int srcBottom = std::min(src.height(), 2 * bottom + (src.height() & 1));
+
+        SkPixmap dstBand, srcBand;
+        SkAssertResult(dst.extractSubset(&dstBand,
+                                         SkIRect::MakeLTRB(0, top, dst.width(), bottom)));
+        SkAssertResult(src.extractSubset(&srcBand,
+                                         SkIRect::MakeLTRB(0, srcTop, src.width(), srcBottom)));
+        downsampler->buildLevel(dstBand, srcBand);
+    });
+    taskGroup.wait();
+}
+
 SkMipmap::SkMipmap(void* malloc, size_t size) : SkCachedData(malloc, size) {}
 SkMipmap::SkMipmap(size_t size, SkDiscardableMemory* dm) : SkCachedData(size, dm) {}
 
@@ -43,7 +83,7 @@ size_t SkMipmap::AllocLevelsSize(int levelCount, size_t pixelSize) {
 }
 
 SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
-                          bool computeContents) {
+                          bool computeContents, SkExecutor* executor) {
     if (src.width() <= 1 && src.height() <= 1) {
         return nullptr;
     }
@@ -120,7 +160,7 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
 
         const SkPixmap& dstPM = levels[i].fPixmap;
         if (downsampler) {
-            downsampler->buildLevel(dstPM, srcPM);
+            build_level(downsampler.get(), dstPM, srcPM, executor);
         }
         srcPM = dstPM;
         addr += height * rowBytes;
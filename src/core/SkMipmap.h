@@ -19,6 +19,7 @@
 class SkBitmap;
 class SkData;
 class SkDiscardableMemory;
+class SkExecutor;
 class SkMipmapBuilder;
 
 typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
@@ -27,6 +28,10 @@ struct SkMipmapDownSampler {
     virtual ~SkMipmapDownSampler() {}
 
     virtual void buildLevel(const SkPixmap& dst, const SkPixmap& src) = 0;
+
+    // Returns true if buildLevel() can be called concurrently on bands of a level's rows, where
+    // each band of dst rows is paired with the src rows that cover it.
+    virtual bool canBuildInBands() const { return false; }
 };
 
 /*
@@ -41,8 +46,10 @@ public:
     ~SkMipmap() override;
     // Allocate and fill-in a mipmap. If computeContents is false, we just allocated
     // and compute the sizes/rowbytes, but leave the pixel-data uninitialized.
+    // If an executor is provided, large levels are split into bands of rows which are built on it
+    // in parallel.
     static SkMipmap* Build(const SkPixmap& src, SkDiscardableFactoryProc,
-                           bool computeContents = true);
+                           bool computeContents = true, SkExecutor* executor = nullptr);
 
     static SkMipmap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
 
@@ -99,4 +106,14 @@ private:
     static size_t AllocLevelsSize(int levelCount, size_t pixelSize);
 };
 
+namespace SkOpts {
+    // 2x2 box filters used by SkMipmap::MakeDownSampler() for even-sized levels of 8888, 8-bit
+    // and RGBA F16 pixels. Each writes 'count' dst pixels from two src rows, 'srcRB' bytes apart.
+    extern void (*downsample_2_2_8888)(void* dst, const void* src, size_t srcRB, int count);
+    extern void (*downsample_2_2_8)(void* dst, const void* src, size_t srcRB, int count);
+    extern void (*downsample_2_2_f16)(void* dst, const void* src, size_t srcRB, int count);
+
+    void Init_Mipmap();
+}  // namespace SkOpts
+
 #endif
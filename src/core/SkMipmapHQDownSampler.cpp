@@ -388,6 +388,10 @@ struct HQDownSampler : SkMipmapDownSampler {
     FilterProc* proc_3_3 = nullptr;
 
     void buildLevel(const SkPixmap& dst, const SkPixmap& src) override;
+
+    // Each dst row only reads the src rows directly beneath it, and the choice of filter only
+    // depends on the parity of the src dimensions, which a band of src rows preserves.
+    bool canBuildInBands() const override { return true; }
 };
 
 void HQDownSampler::buildLevel(const SkPixmap& dst, const SkPixmap& src) {
@@ -454,7 +458,7 @@ std::unique_ptr<SkMipmapDownSampler> SkMipmap::MakeDownSampler(const SkPixmap& r
             proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
+            proc_2_2 = SkOpts::downsample_2_2_8888;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
@@ -486,7 +490,7 @@ std::unique_ptr<SkMipmapDownSampler> SkMipmap::MakeDownSampler(const SkPixmap& r
             proc_1_2 = downsample_1_2<ColorTypeFilter_8>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8>;
+            proc_2_2 = SkOpts::downsample_2_2_8;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8>;
@@ -497,7 +501,7 @@ std::unique_ptr<SkMipmapDownSampler> SkMipmap::MakeDownSampler(const SkPixmap& r
             proc_1_2 = downsample_1_2<ColorTypeFilter_RGBA_F16>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_RGBA_F16>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_RGBA_F16>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_RGBA_F16>;
+            proc_2_2 = SkOpts::downsample_2_2_f16;
             proc_2_3 = downsample_2_3<ColorTypeFilter_RGBA_F16>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_RGBA_F16>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_RGBA_F16>;
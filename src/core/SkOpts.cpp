@@ -43,11 +43,25 @@ namespace SkOpts {
             SK_OPTS_NS::lowp::start_pipeline;
 #undef M
 
+    // Filled in by init(), since only the ops with mediump stages have entries.
+    StageFn ops_mediump[kNumRasterPipelineHighpOps] = {};
+    StageFn just_return_mediump = (StageFn)SK_OPTS_NS::mediump::just_return;
+    void (*start_pipeline_mediump)(size_t, size_t, size_t, size_t, SkRasterPipelineStage*,
+                                   SkSpan<SkRasterPipeline_MemoryCtxPatch>,
+                                   uint8_t*) =
+            SK_OPTS_NS::mediump::start_pipeline;
+
     // Each Init_foo() is defined in src/opts/SkOpts_foo.cpp.
     void Init_hsw();
     void Init_skx();
+    void Init_rvv();
+    void Init_armv82();
 
     static bool init() {
+    #define M(st) ops_mediump[(int)SkRasterPipelineOp::st] = (StageFn)SK_OPTS_NS::mediump::st;
+        SK_RASTER_PIPELINE_OPS_MEDIUMP(M)
+    #undef M
+
     #if defined(SK_ENABLE_OPTIMIZE_SIZE)
         // All Init_foo functions are omitted when optimizing for size
     #elif defined(SK_CPU_X86)
@@ -59,6 +73,16 @@ namespace SkOpts {
             if (SkCpu::Supports(SkCpu::SKX)) { Init_skx(); }
         #endif
 
+    #elif defined(__riscv) && defined(SK_ENABLE_RVV_OPTS)
+        #if !defined(__riscv_v)
+            if (SkCpu::Supports(SkCpu::RVV)) { Init_rvv(); }
+        #endif
+
+    #elif defined(SK_CPU_ARM64) && defined(SK_ENABLE_ARMV82_OPTS)
+        #if !defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC) || !defined(__ARM_FEATURE_DOTPROD)
+            if (SkCpu::Supports(SkCpu::ARMV82)) { Init_armv82(); }
+        #endif
+
     #endif
         return true;
     }
@@ -72,6 +72,8 @@ namespace SkOpts {
     using StageFn = void(*)(void);
     extern StageFn ops_highp[kNumRasterPipelineHighpOps], just_return_highp;
     extern StageFn ops_lowp [kNumRasterPipelineLowpOps ], just_return_lowp;
+    // Indexed like ops_highp, with nullptr for ops that have no mediump stage.
+    extern StageFn ops_mediump[kNumRasterPipelineHighpOps], just_return_mediump;
 
     extern void (*start_pipeline_highp)(size_t,size_t,size_t,size_t, SkRasterPipelineStage*,
                                         SkSpan<SkRasterPipeline_MemoryCtxPatch>,
@@ -79,6 +81,9 @@ namespace SkOpts {
     extern void (*start_pipeline_lowp )(size_t,size_t,size_t,size_t, SkRasterPipelineStage*,
                                         SkSpan<SkRasterPipeline_MemoryCtxPatch>,
                                         uint8_t*);
+    extern void (*start_pipeline_mediump)(size_t,size_t,size_t,size_t, SkRasterPipelineStage*,
+                                          SkSpan<SkRasterPipeline_MemoryCtxPatch>,
+                                          uint8_t*);
 
     extern size_t raster_pipeline_lowp_stride;
     extern size_t raster_pipeline_highp_stride;
@@ -2199,6 +2199,52 @@ struct Convexicator {
         return SkPathConvexity::kConvex;  // that is, it may be convex, don't know yet
     }
 
+    // Checks a contour of lines, points[0] to points[count - 1] and back, by the sign of the
+    // cross product at every corner, 4 corners at a time. If they all turn the same way, the
+    // Convexicator would find the contour convex in that direction (given BySign() ruled out
+    // turning around more than once), so this returns that direction. Otherwise (a repeated
+    // point, a straight or reversed corner, mixed turns or overflow) it returns kUnknown and the
+    // contour needs the Convexicator.
+    static SkPathFirstDirection ByCross(const SkPoint points[], int count) {
+        if (count > 1 && points[count - 1] == points[0]) {
+            count -= 1;  // closed with a line back to the start
+        }
+        if (count < 3) {
+            return SkPathFirstDirection::kUnknown;
+        }
+        auto cross = [](SkPoint prev, SkPoint curr, SkPoint next) {
+            return SkPoint::CrossProduct(curr - prev, next - curr);
+        };
+        // The corners at points[0] and points[count - 1] wrap around.
+        const float first = cross(points[count - 1], points[0], points[1]),
+                    last  = cross(points[count - 2], points[count - 1], points[0]);
+        bool cw  = first > 0 && last > 0 && first < SK_FloatInfinity && last < SK_FloatInfinity,
+             ccw = first < 0 && last < 0 && first > -SK_FloatInfinity && last > -SK_FloatInfinity;
+
+        int i = 1;
+        skvx::int4 cw4 = cw ? ~0 : 0,
+                  ccw4 = ccw ? ~0 : 0;
+        for (; i + 4 < count && any(cw4 | ccw4); i += 4) {
+            skvx::float8 prev = skvx::float8::Load(points + i - 1),
+                         curr = skvx::float8::Load(points + i),
+                         next = skvx::float8::Load(points + i + 1);
+            skvx::float8 products = (curr - prev) * skvx::shuffle<1,0,3,2,5,4,7,6>(next - curr);
+            skvx::float4 cross4 = skvx::shuffle<0,2,4,6>(products) -
+                                  skvx::shuffle<1,3,5,7>(products);
+            cw4  =  cw4 & (cross4 > 0) & (cross4 <  SK_FloatInfinity);
+            ccw4 = ccw4 & (cross4 < 0) & (cross4 > -SK_FloatInfinity);
+        }
+        cw  = all(cw4);
+        ccw = all(ccw4);
+        for (; i < count - 1 && (cw || ccw); ++i) {
+            float c = cross(points[i - 1], points[i], points[i + 1]);
+            cw  =  cw && c > 0 && c <  SK_FloatInfinity;
+            ccw = ccw && c < 0 && c > -SK_FloatInfinity;
+        }
+        return cw  ? SkPathFirstDirection::kCW  :
+               ccw ? SkPathFirstDirection::kCCW : SkPathFirstDirection::kUnknown;
+    }
+
     bool close() {
         // If this was an explicit close, there was already a lineTo to fFirstPoint, so this
         // addPt() is a no-op. Otherwise, the addPt implicitly closes the contour. In either case,
@@ -2317,6 +2363,30 @@ SkPathConvexity SkPath::computeConvexity() const {
         return setComputedConvexity(SkPathConvexity::kConcave);
     }
 
+    // A single contour of lines (the common case for big polygons) can usually skip the
+    // Convexicator.
+    if (this->getSegmentMasks() == kLine_SegmentMask) {
+        const uint8_t* verbs    = fPathRef->verbsBegin() + skipCount + 1;
+        const uint8_t* verbsEnd = fPathRef->verbsEnd();
+        const uint8_t* lines    = verbs;
+        while (verbs < verbsEnd && *verbs == kLine_Verb) {
+            verbs++;
+        }
+        int contourPoints = 1 + SkToInt(verbs - lines);
+        if (verbs < verbsEnd && *verbs == kClose_Verb) {
+            verbs++;
+        }
+        if (std::all_of(verbs, verbsEnd, [](uint8_t v) { return v == kMove_Verb; })) {
+            SkPathFirstDirection dir = Convexicator::ByCross(points, contourPoints);
+            if (dir != SkPathFirstDirection::kUnknown) {
+                if (this->getFirstDirection() == SkPathFirstDirection::kUnknown) {
+                    this->setFirstDirection(dir);
+                }
+                return setComputedConvexity(SkPathConvexity::kConvex);
+            }
+        }
+    }
+
     int contourCount = 0;
     bool needsClose = false;
     Convexicator state;
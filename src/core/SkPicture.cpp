@@ -7,13 +7,16 @@
 
 #include "include/core/SkPicture.h"
 
+#include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkMathPriv.h"
+#include "src/core/SkBigPicture.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkPictureData.h"
 #include "src/core/SkPicturePlayback.h"
@@ -55,6 +58,31 @@ SkPicture::~SkPicture() {
     }
 }
 
+void SkPicture::playbackRects(SkCanvas* canvas, SkSpan<const SkRect> rects,
+                              AbortCallback* callback) const {
+    SkASSERT(canvas);
+    if (rects.empty()) {
+        return;
+    }
+
+    SkAutoCanvasRestore acr(canvas, /*doSave=*/true);
+    if (rects.size() == 1) {
+        canvas->clipRect(rects[0]);
+    } else {
+        SkPath clip;
+        for (const SkRect& rect : rects) {
+            clip.addRect(rect);
+        }
+        canvas->clipPath(clip);
+    }
+
+    if (const SkBigPicture* bigPicture = this->asSkBigPicture()) {
+        bigPicture->playbackRects(canvas, rects, callback);
+    } else {
+        this->playback(canvas, callback);
+    }
+}
+
 static const char kMagic[] = { 's', 'k', 'i', 'a', 'p', 'i', 'c', 't' };
 
 SkPictInfo SkPicture::createHeader() const {
@@ -165,8 +193,18 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
     return MakeFromStreamPriv(&stream, procs, nullptr, kNestedSKPLimit);
 }
 
+sk_sp<SkPicture> SkPicture::MakeFromSharedData(sk_sp<SkData> data,
+                                               const SkDeserialProcs* procs) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    return MakeFromStreamPriv(&stream, procs, nullptr, kNestedSKPLimit, data.get());
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStreamPriv(SkStream* stream, const SkDeserialProcs* procsPtr,
-                                               SkTypefacePlayback* typefaces, int recursionLimit) {
+                                               SkTypefacePlayback* typefaces, int recursionLimit,
+                                               const SkData* sharedData) {
     if (recursionLimit <= 0) {
         return nullptr;
     }
@@ -186,7 +224,7 @@ sk_sp<SkPicture> SkPicture::MakeFromStreamPriv(SkStream* stream, const SkDeseria
         case kPictureData_TrailingStreamByteAfterPictInfo: {
             std::unique_ptr<SkPictureData> data(
                     SkPictureData::CreateFromStream(stream, info, procs, typefaces,
-                                                    recursionLimit));
+                                                    recursionLimit, sharedData));
             return Forwardport(info, data.get(), nullptr);
         }
         case kCustom_TrailingStreamByteAfterPictInfo: {
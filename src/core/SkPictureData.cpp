@@ -7,28 +7,33 @@
 
 #include "src/core/SkPictureData.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/base/SkAlign.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkAutoMalloc.h"
+#include "src/core/SkFontDescriptor.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkPictureRecord.h"
 #include "src/core/SkPtrRecorder.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkStreamPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTHash.h"
 #include "src/core/SkTextBlobPriv.h"
 #include "src/core/SkVerticesPriv.h"
 #include "src/core/SkWriteBuffer.h"
 
 #include <cstring>
+#include <memory>
 #include <utility>
 
 using namespace skia_private;
@@ -101,6 +106,18 @@ static void write_tag_size(SkWStream* stream, uint32_t tag, size_t size) {
     stream->write32(SkToU32(size));
 }
 
+// Writes a padding tag if needed, so that the data of the next tag starts at a 4-byte aligned
+// offset in 'stream'. Readers of memory-mapped pictures can then use that data in place.
+static void write_padding(SkWStream* stream) {
+    // The padding tag and its size don't change the alignment, only the padding bytes do.
+    if (size_t misalignment = stream->bytesWritten() & 3) {
+        static constexpr char kZeros[3] = {};
+        const size_t padding = 4 - misalignment;
+        write_tag_size(stream, SK_PICT_PADDING_TAG, padding);
+        stream->write(kZeros, padding);
+    }
+}
+
 void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
     int count = rec.count();
 
@@ -227,6 +244,7 @@ static SkSerialProcs skip_typeface_proc(const SkSerialProcs& procs) {
 void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
                               SkRefCntSet* topLevelTypeFaceSet, bool textBlobsOnly) const {
     // This can happen at pretty much any time, so might as well do it first.
+    write_padding(stream);
     write_tag_size(stream, SK_PICT_READER_TAG, fOpData->size());
     stream->write(fOpData->bytes(), fOpData->size());
 
@@ -264,6 +282,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     WriteTypefaces(stream, *typefaceSet, procs);
 
     // Write the buffer.
+    write_padding(stream);
     write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, buffer.bytesWritten());
     buffer.writeToStream(stream);
 
@@ -303,20 +322,47 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Returns a pointer to the next 'size' bytes of 'stream', without reading them, if the stream is
+// backed by memory and they are 4-byte aligned (as SkReadBuffer requires). Otherwise returns null.
+static const char* peek_aligned_memory(SkStream* stream, size_t size) {
+    const char* base = static_cast<const char*>(stream->getMemoryBase());
+    if (!base || !stream->hasPosition() || StreamRemainingLengthIsBelow(stream, size)) {
+        return nullptr;
+    }
+    const char* ptr = base + stream->getPosition();
+    return SkIsAlign4(reinterpret_cast<uintptr_t>(ptr)) ? ptr : nullptr;
+}
+
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
                                    const SkDeserialProcs& procs,
                                    SkTypefacePlayback* topLevelTFPlayback,
-                                   int recursionLimit) {
+                                   int recursionLimit,
+                                   const SkData* sharedData) {
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            if (const char* ptr = sharedData ? peek_aligned_memory(stream, size) : nullptr) {
+                // Play the ops back from the shared data, in place.
+                SkASSERT(stream->getMemoryBase() == sharedData->data());
+                fOpData = SkData::MakeSubset(
+                        sharedData, ptr - static_cast<const char*>(sharedData->data()), size);
+                if (stream->skip(size) != size) {
+                    return false;
+                }
+            } else {
+                fOpData = SkData::MakeFromStream(stream, size);
+            }
             if (!fOpData) {
                 return false;
             }
             break;
+        case SK_PICT_PADDING_TAG:
+            if (size > 3 || stream->skip(size) != size) {
+                return false;
+            }
+            break;
         case SK_PICT_FACTORY_TAG: {
             if (!stream->readU32(&size)) { return false; }
             if (StreamRemainingLengthIsBelow(stream, size)) {
@@ -342,11 +388,23 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                 return false;
             }
             fTFPlayback.setCount(size);
+            // The descriptors of the typefaces that are created on procs.fExecutor.
+            TArray<std::unique_ptr<SkFontDescriptor>> descriptors;
             for (uint32_t i = 0; i < size; ++i) {
                 if (stream->isAtEnd()) {
                     return false;
                 }
                 sk_sp<SkTypeface> tf;
+                if (procs.fExecutor && !procs.fTypefaceProc) {
+                    // Only read the descriptor here; the typeface is created below. A descriptor
+                    // that fails to deserialize is left null and gets an empty typeface.
+                    auto desc = std::make_unique<SkFontDescriptor>();
+                    if (!SkFontDescriptor::Deserialize(stream, desc.get())) {
+                        desc = nullptr;
+                    }
+                    descriptors.push_back(std::move(desc));
+                    continue;
+                }
                 if (procs.fTypefaceProc) {
                     tf = procs.fTypefaceProc(&stream, sizeof(stream), procs.fTypefaceCtx);
                 }
@@ -360,6 +418,20 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                 }
                 fTFPlayback[i] = std::move(tf);
             }
+            if (!descriptors.empty()) {
+                // Paints refer to the typefaces, so they must all exist before the next tag.
+                SkTaskGroup tasks(*procs.fExecutor);
+                for (int i = 0; i < descriptors.size(); ++i) {
+                    tasks.add([&, i] {
+                        sk_sp<SkTypeface> tf;
+                        if (descriptors[i]) {
+                            tf = SkTypeface::MakeFromDescriptor(descriptors[i].get(), nullptr);
+                        }
+                        fTFPlayback[i] = tf ? std::move(tf) : SkTypeface::MakeEmpty();
+                    });
+                }
+                tasks.wait();
+            }
         } break;
         case SK_PICT_PICTURE_TAG: {
             SkASSERT(fPictures.empty());
@@ -370,7 +442,8 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
 
             for (uint32_t i = 0; i < size; i++) {
                 auto pic = SkPicture::MakeFromStreamPriv(stream, &procs,
-                                                         topLevelTFPlayback, recursionLimit - 1);
+                                                         topLevelTFPlayback, recursionLimit - 1,
+                                                         sharedData);
                 if (!pic) {
                     return false;
                 }
@@ -381,13 +454,27 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             if (StreamRemainingLengthIsBelow(stream, size)) {
                 return false;
             }
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
-                return false;
+            // Memory-backed streams are parsed in place rather than copied first.
+            SkAutoMalloc storage;
+            const void* memory = peek_aligned_memory(stream, size);
+            const bool inPlace = memory != nullptr;
+            if (inPlace) {
+                if (stream->skip(size) != size) {
+                    return false;
+                }
+            } else {
+                storage.reset(size);
+                if (stream->read(storage.get(), size) != size) {
+                    return false;
+                }
+                memory = storage.get();
             }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(memory, size);
             buffer.setVersion(fInfo.getVersion());
+            if (sharedData && inPlace) {
+                buffer.setSharedData(sharedData);
+            }
 
             if (!fFactoryPlayback) {
                 return false;
@@ -449,6 +536,32 @@ bool new_array_from_buffer(SkReadBuffer& buffer, uint32_t inCount,
     return true;
 }
 
+// Like new_array_from_buffer(), but only reads the encoded images from the buffer, and decodes
+// them concurrently on 'executor'.
+static bool new_images_from_buffer(SkReadBuffer& buffer, uint32_t inCount,
+                                   TArray<sk_sp<const SkImage>>& array, SkExecutor* executor) {
+    if (!buffer.validate(array.empty() && SkTFitsIn<int>(inCount))) {
+        return false;
+    }
+
+    // Don't reserve inCount entries up front, since a corrupt count could be huge.
+    TArray<SkReadBuffer::ImageData> images;
+    for (uint32_t i = 0; i < inCount; ++i) {
+        if (!buffer.readImageData(&images.push_back())) {
+            return false;
+        }
+    }
+
+    array.push_back_n(images.size());
+    const SkDeserialProcs& procs = buffer.getDeserialProcs();
+    SkTaskGroup tasks(*executor);
+    for (int i = 0; i < images.size(); ++i) {
+        tasks.add([&, i] { array[i] = SkReadBuffer::DecodeImage(images[i], procs); });
+    }
+    tasks.wait();
+    return true;
+}
+
 void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t size) {
     switch (tag) {
         case SK_PICT_PAINT_BUFFER_TAG: {
@@ -487,7 +600,11 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
             new_array_from_buffer(buffer, size, fVertices, SkVerticesPriv::Decode);
             break;
         case SK_PICT_IMAGE_BUFFER_TAG:
-            new_array_from_buffer(buffer, size, fImages, create_image_from_buffer);
+            if (SkExecutor* executor = buffer.getDeserialProcs().fExecutor) {
+                new_images_from_buffer(buffer, size, fImages, executor);
+            } else {
+                new_array_from_buffer(buffer, size, fImages, create_image_from_buffer);
+            }
             break;
         case SK_PICT_READER_TAG: {
             // Preflight check that we can initialize all data from the buffer
@@ -519,13 +636,14 @@ SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
                                                const SkDeserialProcs& procs,
                                                SkTypefacePlayback* topLevelTFPlayback,
-                                               int recursionLimit) {
+                                               int recursionLimit,
+                                               const SkData* sharedData) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
     if (!topLevelTFPlayback) {
         topLevelTFPlayback = &data->fTFPlayback;
     }
 
-    if (!data->parseStream(stream, procs, topLevelTFPlayback, recursionLimit)) {
+    if (!data->parseStream(stream, procs, topLevelTFPlayback, recursionLimit, sharedData)) {
         return nullptr;
     }
     return data.release();
@@ -545,7 +663,8 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 bool SkPictureData::parseStream(SkStream* stream,
                                 const SkDeserialProcs& procs,
                                 SkTypefacePlayback* topLevelTFPlayback,
-                                int recursionLimit) {
+                                int recursionLimit,
+                                const SkData* sharedData) {
     for (;;) {
         uint32_t tag;
         if (!stream->readU32(&tag)) { return false; }
@@ -555,7 +674,8 @@ bool SkPictureData::parseStream(SkStream* stream,
 
         uint32_t size;
         if (!stream->readU32(&size)) { return false; }
-        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, recursionLimit)) {
+        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, recursionLimit,
+                                  sharedData)) {
             return false; // we're invalid
         }
     }
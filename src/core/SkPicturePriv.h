@@ -115,6 +115,7 @@ public:
     // V102: Convolution image filter uses ::Crop to apply tile mode
     // V103: Remove deprecated per-image filter crop rect
     // v104: SaveLayer supports multiple image filters
+    // v105: Padding tags keep the op data and buffer of SkPictureData streams 4-byte aligned
 
     enum Version {
         kPictureShaderFilterParam_Version   = 82,
@@ -140,6 +141,7 @@ public:
         kConvolutionImageFilterTilingUpdate = 102,
         kRemoveDeprecatedCropRect           = 103,
         kMultipleFiltersOnSaveLayer         = 104,
+        kPictureDataPadding                 = 105,
 
         // Only SKPs within the min/current picture version range (inclusive) can be read.
         //
@@ -164,7 +166,7 @@ public:
         //
         // Contact the Infra Gardener if the above steps do not work for you.
         kMin_Version     = kPictureShaderFilterParam_Version,
-        kCurrent_Version = kMultipleFiltersOnSaveLayer
+        kCurrent_Version = kPictureDataPadding
     };
 };
 
@@ -9,6 +9,8 @@
 
 #include "include/core/SkBBHFactory.h"
 #include "include/core/SkDrawable.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkMatrix.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTemplates.h"
@@ -18,7 +20,9 @@
 #include "src/core/SkRecordOpts.h"
 #include "src/core/SkRecordedDrawable.h"
 #include "src/core/SkRecorder.h"
+#include "src/core/SkRecords.h"
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <utility>
@@ -33,28 +37,125 @@ SkPictureRecorder::SkPictureRecorder() {
 SkPictureRecorder::~SkPictureRecorder() {}
 
 SkCanvas* SkPictureRecorder::beginRecording(const SkRect& userCullRect,
-                                            sk_sp<SkBBoxHierarchy> bbh) {
+                                            sk_sp<SkBBoxHierarchy> bbh,
+                                            uint32_t recordFlags) {
     const SkRect cullRect = userCullRect.isEmpty() ? SkRect::MakeEmpty() : userCullRect;
 
     fCullRect = cullRect;
     fBBH = std::move(bbh);
+    fPlaceholders.clear();
 
     if (!fRecord) {
         fRecord.reset(new SkRecord);
     }
     fRecorder->reset(fRecord.get(), cullRect);
+    fRecorder->setInternPaints(recordFlags & kInternPaints_RecordFlag);
     fActivelyRecording = true;
     return this->getRecordingCanvas();
 }
 
-SkCanvas* SkPictureRecorder::beginRecording(const SkRect& bounds, SkBBHFactory* factory) {
-    return this->beginRecording(bounds, factory ? (*factory)() : nullptr);
+SkCanvas* SkPictureRecorder::beginRecording(const SkRect& bounds,
+                                            SkBBHFactory* factory,
+                                            uint32_t recordFlags) {
+    return this->beginRecording(bounds, factory ? (*factory)() : nullptr, recordFlags);
 }
 
 SkCanvas* SkPictureRecorder::getRecordingCanvas() {
     return fActivelyRecording ? fRecorder.get() : nullptr;
 }
 
+struct SkPictureRecorder::SubRecording::Placeholder : public SkNVRefCnt<Placeholder> {
+    // The index of the placeholder's NoOp in the parent's record.
+    int fIndex = 0;
+    // The parent's matrix at the placeholder, relative to the start of its recording.
+    SkM44 fCTM;
+
+    // Written by the sub-recording before fFinished is set.
+    sk_sp<SkRecord> fRecord = sk_make_sp<SkRecord>();
+    std::unique_ptr<SkDrawableList> fDrawables;
+    size_t fSubPictureBytes = 0;
+    std::atomic<bool> fFinished{false};
+};
+
+SkPictureRecorder::SubRecording::SubRecording(sk_sp<Placeholder> placeholder,
+                                              const SkRect& bounds)
+        : fPlaceholder(std::move(placeholder))
+        , fRecorder(std::make_unique<SkRecorder>(fPlaceholder->fRecord.get(), bounds)) {}
+
+SkPictureRecorder::SubRecording::~SubRecording() {}
+
+SkCanvas* SkPictureRecorder::SubRecording::getRecordingCanvas() {
+    return fRecorder.get();
+}
+
+void SkPictureRecorder::SubRecording::finish() {
+    if (!fRecorder) {
+        return;
+    }
+    fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
+    fPlaceholder->fDrawables = fRecorder->detachDrawableList();
+    fPlaceholder->fSubPictureBytes = fRecorder->approxBytesUsedBySubPictures();
+    fRecorder.reset();
+    fPlaceholder->fFinished.store(true, std::memory_order_release);
+}
+
+std::unique_ptr<SkPictureRecorder::SubRecording> SkPictureRecorder::beginSubRecording(
+        const SkRect& bounds) {
+    if (!fActivelyRecording) {
+        return nullptr;
+    }
+    auto placeholder = sk_make_sp<SubRecording::Placeholder>();
+    placeholder->fCTM = fRecorder->getLocalToDevice();
+    placeholder->fIndex = fRecorder->appendPlaceholder();
+    fPlaceholders.push_back(placeholder);
+    std::unique_ptr<SubRecording> sub(new SubRecording(std::move(placeholder), bounds));
+    sub->fRecorder->setInternPaints(fRecorder->internPaints());
+    return sub;
+}
+
+namespace {
+// Rebases the ops of a sub-recording onto the parent's recording: matrices that the ops set
+// directly are relative to the placeholder's matrix, and drawables are indexed in the parent's
+// drawable list.
+struct RebaseSubRecording {
+    const SkM44& fCTM;
+    int fDrawableOffset;
+
+    template <typename T>
+    void operator()(T*) {}
+
+    void operator()(SkRecords::SetMatrix* op) {
+        op->matrix = SkMatrix::Concat(fCTM.asM33(), op->matrix);
+    }
+    void operator()(SkRecords::SetM44* op) { op->matrix = fCTM * op->matrix; }
+    void operator()(SkRecords::Restore* op) {
+        op->matrix = SkMatrix::Concat(fCTM.asM33(), op->matrix);
+    }
+    void operator()(SkRecords::DrawDrawable* op) { op->index += fDrawableOffset; }
+};
+}  // namespace
+
+size_t SkPictureRecorder::spliceSubRecordings() {
+    size_t subPictureBytes = 0;
+    TArray<SkRecord::Splice> splices;
+    for (const sk_sp<SubRecording::Placeholder>& placeholder : fPlaceholders) {
+        if (!placeholder->fFinished.load(std::memory_order_acquire)) {
+            continue;  // Its placeholder stays a NoOp.
+        }
+        SkRecord* record = placeholder->fRecord.get();
+        RebaseSubRecording rebase{placeholder->fCTM,
+                                  fRecorder->appendDrawables(placeholder->fDrawables.get())};
+        for (int i = 0; i < record->count(); ++i) {
+            record->mutate(i, rebase);
+        }
+        subPictureBytes += placeholder->fSubPictureBytes;
+        splices.push_back({placeholder->fIndex, std::move(placeholder->fRecord)});
+    }
+    fPlaceholders.clear();
+    fRecord->splice(splices);
+    return subPictureBytes;
+}
+
 class SkEmptyPicture final : public SkPicture {
 public:
     void playback(SkCanvas*, AbortCallback*) const override { }
@@ -67,6 +168,7 @@ public:
 sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture() {
     fActivelyRecording = false;
     fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
+    size_t subPictureBytes = this->spliceSubRecordings();
 
     if (fRecord->count() == 0) {
         return sk_make_sp<SkEmptyPicture>();
@@ -97,7 +199,7 @@ sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture() {
         fCullRect = bbhBound;
     }
 
-    size_t subPictureBytes = fRecorder->approxBytesUsedBySubPictures();
+    subPictureBytes += fRecorder->approxBytesUsedBySubPictures();
     for (int i = 0; pictList && i < pictList->count(); i++) {
         subPictureBytes += pictList->begin()[i]->approximateBytesUsed();
     }
@@ -132,6 +234,7 @@ void SkPictureRecorder::partialReplay(SkCanvas* canvas) const {
 sk_sp<SkDrawable> SkPictureRecorder::finishRecordingAsDrawable() {
     fActivelyRecording = false;
     fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
+    this->spliceSubRecordings();
 
     SkRecordOptimize(fRecord.get());
 
@@ -162,21 +162,30 @@ float SkPixmap::getAlphaf(int x, int y) const {
     return value;
 }
 
-bool SkPixmap::readPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRB,
-                          int x, int y) const {
-    if (!SkImageInfoValidConversion(dstInfo, fInfo)) {
+static bool read_pixels(const SkPixmap& src, const SkImageInfo& dstInfo, void* dstPixels,
+                        size_t dstRB, int x, int y, SkExecutor* executor) {
+    if (!SkImageInfoValidConversion(dstInfo, src.info())) {
         return false;
     }
 
     SkReadPixelsRec rec(dstInfo, dstPixels, dstRB, x, y);
-    if (!rec.trim(fInfo.width(), fInfo.height())) {
+    if (!rec.trim(src.width(), src.height())) {
         return false;
     }
 
-    const void* srcPixels = this->addr(rec.fX, rec.fY);
-    const SkImageInfo srcInfo = fInfo.makeDimensions(rec.fInfo.dimensions());
+    const void* srcPixels = src.addr(rec.fX, rec.fY);
+    const SkImageInfo srcInfo = src.info().makeDimensions(rec.fInfo.dimensions());
     return SkConvertPixels(rec.fInfo, rec.fPixels, rec.fRowBytes, srcInfo, srcPixels,
-                           this->rowBytes());
+                           src.rowBytes(), executor);
+}
+
+bool SkPixmap::readPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRB,
+                          int x, int y) const {
+    return read_pixels(*this, dstInfo, dstPixels, dstRB, x, y, nullptr);
+}
+
+bool SkPixmap::readPixels(const SkPixmap& dst, int x, int y, SkExecutor* executor) const {
+    return read_pixels(*this, dst.info(), dst.writable_addr(), dst.rowBytes(), x, y, executor);
 }
 
 SkColor SkPixmap::getColor(int x, int y) const {
@@ -11,6 +11,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -20,13 +21,23 @@
 #include "include/core/SkShader.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkTileMode.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/shaders/SkImageShader.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <utility>
 
 struct SkSamplingOptions;
 
-bool SkPixmap::scalePixels(const SkPixmap& actualDst, const SkSamplingOptions& sampling) const {
+bool SkPixmap::scalePixels(const SkPixmap& dst, const SkSamplingOptions& sampling) const {
+    return this->scalePixels(dst, sampling, nullptr);
+}
+
+bool SkPixmap::scalePixels(const SkPixmap& actualDst,
+                           const SkSamplingOptions& sampling,
+                           SkExecutor* executor) const {
     // We may need to tweak how we interpret these just a little below, so we make copies.
     SkPixmap src = *this,
              dst = actualDst;
@@ -39,7 +50,7 @@ bool SkPixmap::scalePixels(const SkPixmap& actualDst, const SkSamplingOptions& s
 
     // no scaling involved?
     if (src.width() == dst.width() && src.height() == dst.height()) {
-        return src.readPixels(dst);
+        return src.readPixels(dst, 0, 0, executor);
     }
 
     // If src and dst are both unpremul, we'll fake the source out to appear as if premul,
@@ -72,15 +83,46 @@ bool SkPixmap::scalePixels(const SkPixmap& actualDst, const SkSamplingOptions& s
                                                  &scale,
                                                  clampAsIfUnpremul);
 
-    sk_sp<SkSurface> surface =
-            SkSurfaces::WrapPixels(dst.info(), dst.writable_addr(), dst.rowBytes());
-    if (!shader || !surface) {
+    if (!shader) {
         return false;
     }
-
     SkPaint paint;
     paint.setBlendMode(SkBlendMode::kSrc);
     paint.setShader(std::move(shader));
-    surface->getCanvas()->drawPaint(paint);
-    return true;
+
+    // Each band of rows is drawn by its own surface, which is only worth it for large images.
+    static constexpr int kMinPixelsPerBand = 64 * 1024;
+    static constexpr int kMaxBands = 8;
+    int bands = 1;
+    if (executor) {
+        bands = (int)std::min<int64_t>(dst.info().dimensions().area() / kMinPixelsPerBand,
+                                       kMaxBands);
+        bands = std::max(1, std::min(bands, dst.height()));
+    }
+
+    std::atomic<bool> ok{true};
+    auto drawBand = [&](int band) {
+        const int top = dst.height() * band / bands;
+        const int bottom = dst.height() * (band + 1) / bands;
+        sk_sp<SkSurface> surface =
+                SkSurfaces::WrapPixels(dst.info().makeWH(dst.width(), bottom - top),
+                                       dst.writable_addr(0, top),
+                                       dst.rowBytes());
+        if (!surface) {
+            ok = false;
+            return;
+        }
+        // The shader maps the whole source onto the whole destination.
+        surface->getCanvas()->translate(0, -top);
+        surface->getCanvas()->drawPaint(paint);
+    };
+
+    if (bands > 1) {
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(bands, drawBand);
+        taskGroup.wait();
+    } else {
+        drawBand(0);
+    }
+    return ok;
 }
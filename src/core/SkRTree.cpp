@@ -9,8 +9,12 @@
 
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
+#include "src/base/SkVx.h"
 
-SkRTree::SkRTree() : fCount(0) {}
+#include <algorithm>
+#include <cmath>
+
+SkRTree::SkRTree() : fCount(0), fSorted(false) {}
 
 void SkRTree::insert(const SkRect boundsArray[], int N) {
     SkASSERT(0 == fCount);
@@ -26,7 +30,7 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
 
         Branch b;
         b.fBounds = bounds;
-        b.fOpIndex = i;
+        b.fChild.fOpIndex = i;
         branches.push_back(b);
     }
 
@@ -35,17 +39,51 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
         if (1 == fCount) {
             fNodes.reserve(1);
             Node* n = this->allocateNodeAtLevel(0);
+            n->setChild(0, branches[0]);
             n->fNumChildren = 1;
-            n->fChildren[0] = branches[0];
-            fRoot.fSubtree = n;
+            fRoot.fChild.fSubtree = n;
             fRoot.fBounds  = branches[0].fBounds;
         } else {
+            // Big pictures spend more time culling than they do recording, so it pays to sort them
+            // into tiles that overlap as little as possible.
+            if (fCount >= kMinSortedCount) {
+                SortTileRecursive(&branches);
+                fSorted = true;
+            }
             fNodes.reserve(CountNodes(fCount));
             fRoot = this->bulkLoad(&branches);
         }
     }
 }
 
+void SkRTree::Node::setChild(int i, const Branch& branch) {
+    fLeft[i]     = branch.fBounds.fLeft;
+    fTop[i]      = branch.fBounds.fTop;
+    fRight[i]    = branch.fBounds.fRight;
+    fBottom[i]   = branch.fBounds.fBottom;
+    fChildren[i] = branch.fChild;
+}
+
+void SkRTree::SortTileRecursive(std::vector<Branch>* branches) {
+    // Twice the centers, which sort the same.
+    auto byX = [](const Branch& a, const Branch& b) {
+        return a.fBounds.fLeft + a.fBounds.fRight < b.fBounds.fLeft + b.fBounds.fRight;
+    };
+    auto byY = [](const Branch& a, const Branch& b) {
+        return a.fBounds.fTop + a.fBounds.fBottom < b.fBounds.fTop + b.fBounds.fBottom;
+    };
+
+    const size_t count = branches->size();
+    const size_t leaves = (count + kMaxChildren - 1) / kMaxChildren;
+    const size_t slices = (size_t)std::ceil(std::sqrt((double)leaves));
+    const size_t sliceSize = (leaves + slices - 1) / slices * kMaxChildren;
+
+    std::sort(branches->begin(), branches->end(), byX);
+    for (size_t i = 0; i < count; i += sliceSize) {
+        std::sort(branches->begin() + i, branches->begin() + std::min(i + sliceSize, count), byY);
+    }
+}
+
 SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
     SkDEBUGCODE(Node* p = fNodes.data());
     fNodes.push_back(Node{});
@@ -126,14 +164,14 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
         }
         Node* n = allocateNodeAtLevel(level);
         n->fNumChildren = 1;
-        n->fChildren[0] = (*branches)[currentBranch];
+        n->setChild(0, (*branches)[currentBranch]);
         Branch b;
         b.fBounds = (*branches)[currentBranch].fBounds;
-        b.fSubtree = n;
+        b.fChild.fSubtree = n;
         ++currentBranch;
         for (int k = 1; k < incrementBy && currentBranch < (int)branches->size(); ++k) {
             b.fBounds.join((*branches)[currentBranch].fBounds);
-            n->fChildren[k] = (*branches)[currentBranch];
+            n->setChild(k, (*branches)[currentBranch]);
             ++n->fNumChildren;
             ++currentBranch;
         }
@@ -146,17 +184,38 @@ SkRTree::Branch SkRTree::bulkLoad(std::vector<Branch>* branches, int level) {
 
 void SkRTree::search(const SkRect& query, std::vector<int>* results) const {
     if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
-        this->search(fRoot.fSubtree, query, results);
+        const size_t start = results->size();
+        this->search(fRoot.fChild.fSubtree, query, results);
+        if (fSorted) {
+            // The tiles are out of op order, but callers draw the results in order.
+            std::sort(results->begin() + start, results->end());
+        }
     }
 }
 
-void SkRTree::search(Node* node, const SkRect& query, std::vector<int>* results) const {
-    for (int i = 0; i < node->fNumChildren; ++i) {
-        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
-            if (0 == node->fLevel) {
-                results->push_back(node->fChildren[i].fOpIndex);
-            } else {
-                this->search(node->fChildren[i].fSubtree, query, results);
+void SkRTree::search(const Node* node, const SkRect& query, std::vector<int>* results) const {
+    using float4 = skvx::float4;
+    using int4 = skvx::int4;
+    const float4 left(query.fLeft), top(query.fTop), right(query.fRight), bottom(query.fBottom);
+
+    for (int i = 0; i < node->fNumChildren; i += 4) {
+        // Same as SkRect::Intersects(), for four children at once. The lanes past the last child
+        // are masked off.
+        const int4 hits = (max(float4::Load(node->fLeft + i), left) <
+                           min(float4::Load(node->fRight + i), right)) &
+                          (max(float4::Load(node->fTop + i), top) <
+                           min(float4::Load(node->fBottom + i), bottom)) &
+                          (int4(i, i + 1, i + 2, i + 3) < node->fNumChildren);
+        if (!any(hits)) {
+            continue;
+        }
+        for (int k = 0; k < 4; ++k) {
+            if (hits[k]) {
+                if (0 == node->fLevel) {
+                    results->push_back(node->fChildren[i + k].fOpIndex);
+                } else {
+                    this->search(node->fChildren[i + k].fSubtree, query, results);
+                }
             }
         }
     }
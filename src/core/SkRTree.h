@@ -20,7 +20,12 @@
  * bounding rectangles.
  *
  * It only supports bulk-loading, i.e. creation from a batch of bounding rectangles.
- * This performs a bottom-up bulk load using the STR (sort-tile-recursive) algorithm.
+ * This performs a bottom-up bulk load using the STR (sort-tile-recursive) algorithm. Small
+ * trees skip the sort and keep the rects in the order they were given, which is usually good
+ * enough for pictures and makes them cheaper to build.
+ *
+ * Each node stores its children's bounds as four arrays of edges, so that searches can test
+ * four children against the query at once.
  *
  * TODO: Experiment with other bulk-load algorithms (in particular the Hilbert pack variant,
  * which groups rects by position on the Hilbert curve, is probably worth a look). There also
@@ -42,32 +47,47 @@ public:
     // Methods and constants below here are only public for tests.
 
     // Return the depth of the tree structure.
-    int getDepth() const { return fCount ? fRoot.fSubtree->fLevel + 1 : 0; }
+    int getDepth() const { return fCount ? fRoot.fChild.fSubtree->fLevel + 1 : 0; }
     // Insertion count (not overall node count, which may be greater).
     int getCount() const { return fCount; }
 
     // These values were empirically determined to produce reasonable performance in most cases.
+    // kMaxChildren is a multiple of 4 so that nodes can be searched four children at a time.
     static const int kMinChildren = 6,
-                     kMaxChildren = 11;
+                     kMaxChildren = 12;
+
+    // Trees with at least this many rects are sorted into STR tiles. Their searches then have
+    // to sort their results back into op order.
+    static const int kMinSortedCount = 4096;
 
 private:
     struct Node;
 
+    union Child {
+        Node* fSubtree;
+        int fOpIndex;
+    };
+
     struct Branch {
-        union {
-            Node* fSubtree;
-            int fOpIndex;
-        };
+        Child fChild;
         SkRect fBounds;
     };
 
     struct Node {
         uint16_t fNumChildren;
         uint16_t fLevel;
-        Branch fChildren[kMaxChildren];
+        float fLeft[kMaxChildren], fTop[kMaxChildren], fRight[kMaxChildren],
+              fBottom[kMaxChildren];
+        Child fChildren[kMaxChildren];
+
+        void setChild(int i, const Branch&);
     };
 
-    void search(Node* root, const SkRect& query, std::vector<int>* results) const;
+    void search(const Node* root, const SkRect& query, std::vector<int>* results) const;
+
+    // Sorts the rects into vertical slices of about sqrt(N/kMaxChildren) leaves, each sorted
+    // from top to bottom.
+    static void SortTileRecursive(std::vector<Branch>* branches);
 
     // Consumes the input array.
     Branch bulkLoad(std::vector<Branch>* branches, int level = 0);
@@ -79,6 +99,7 @@ private:
 
     // This is the count of data elements (rather than total nodes in the tree)
     int fCount;
+    bool fSorted;
     Branch fRoot;
     std::vector<Node> fNodes;
 };
@@ -27,6 +27,7 @@ using namespace skia_private;
 using Op = SkRasterPipelineOp;
 
 bool gForceHighPrecisionRasterPipeline;
+bool gAllowMediumpRasterPipeline;
 
 SkRasterPipeline::SkRasterPipeline(SkArenaAlloc* alloc) : fAlloc(alloc) {
     this->reset();
@@ -253,35 +254,52 @@ void SkRasterPipeline::appendSetRGB(SkArenaAlloc* alloc, const float rgb[3]) {
     this->uncheckedAppend(op, arg);
 }
 
-void SkRasterPipeline::appendConstantColor(SkArenaAlloc* alloc, const float rgba[4]) {
+SkRasterPipelineOp SkRasterPipeline::ConstantColorOp(const float rgba[4]) {
+    if (rgba[0] == 0 && rgba[1] == 0 && rgba[2] == 0 && rgba[3] == 1) {
+        return Op::black_color;
+    }
+    if (rgba[0] == 1 && rgba[1] == 1 && rgba[2] == 1 && rgba[3] == 1) {
+        return Op::white_color;
+    }
+    // uniform_color requires colors in range and can go lowp,
+    // while unbounded_uniform_color supports out-of-range colors too but not lowp.
+    if (0 <= rgba[0] && rgba[0] <= rgba[3] &&
+        0 <= rgba[1] && rgba[1] <= rgba[3] &&
+        0 <= rgba[2] && rgba[2] <= rgba[3]) {
+        return Op::uniform_color;
+    }
+    return Op::unbounded_uniform_color;
+}
+
+void SkRasterPipeline::FillUniformColorCtx(SkRasterPipeline_UniformColorCtx* ctx,
+                                           const float rgba[4]) {
+    skvx::float4 color = skvx::float4::Load(rgba);
+    color.store(&ctx->r);
+
+    if (ConstantColorOp(rgba) == Op::uniform_color) {
+        // To make loads more direct, we store 8-bit values in 16-bit slots.
+        color = color * 255.0f + 0.5f;
+        ctx->rgba[0] = (uint16_t)color[0];
+        ctx->rgba[1] = (uint16_t)color[1];
+        ctx->rgba[2] = (uint16_t)color[2];
+        ctx->rgba[3] = (uint16_t)color[3];
+    }
+}
+
+SkRasterPipeline_UniformColorCtx* SkRasterPipeline::appendConstantColor(SkArenaAlloc* alloc,
+                                                                        const float rgba[4]) {
     // r,g,b might be outside [0,1], but alpha should probably always be in [0,1].
     SkASSERT(0 <= rgba[3] && rgba[3] <= 1);
 
-    if (rgba[0] == 0 && rgba[1] == 0 && rgba[2] == 0 && rgba[3] == 1) {
-        this->append(Op::black_color);
-    } else if (rgba[0] == 1 && rgba[1] == 1 && rgba[2] == 1 && rgba[3] == 1) {
-        this->append(Op::white_color);
-    } else {
-        auto ctx = alloc->make<SkRasterPipeline_UniformColorCtx>();
-        skvx::float4 color = skvx::float4::Load(rgba);
-        color.store(&ctx->r);
-
-        // uniform_color requires colors in range and can go lowp,
-        // while unbounded_uniform_color supports out-of-range colors too but not lowp.
-        if (0 <= rgba[0] && rgba[0] <= rgba[3] &&
-            0 <= rgba[1] && rgba[1] <= rgba[3] &&
-            0 <= rgba[2] && rgba[2] <= rgba[3]) {
-            // To make loads more direct, we store 8-bit values in 16-bit slots.
-            color = color * 255.0f + 0.5f;
-            ctx->rgba[0] = (uint16_t)color[0];
-            ctx->rgba[1] = (uint16_t)color[1];
-            ctx->rgba[2] = (uint16_t)color[2];
-            ctx->rgba[3] = (uint16_t)color[3];
-            this->uncheckedAppend(Op::uniform_color, ctx);
-        } else {
-            this->uncheckedAppend(Op::unbounded_uniform_color, ctx);
-        }
+    SkRasterPipelineOp op = ConstantColorOp(rgba);
+    if (op == Op::black_color || op == Op::white_color) {
+        this->append(op);
+        return nullptr;
     }
+    auto ctx = alloc->make<SkRasterPipeline_UniformColorCtx>();
+    FillUniformColorCtx(ctx, rgba);
+    this->uncheckedAppend(op, ctx);
+    return ctx;
 }
 
 void SkRasterPipeline::appendMatrix(SkArenaAlloc* alloc, const SkMatrix& matrix) {
@@ -555,6 +573,27 @@ bool SkRasterPipeline::buildLowpPipeline(SkRasterPipelineStage* ip) const {
     return true;
 }
 
+bool SkRasterPipeline::buildMediumpPipeline(SkRasterPipelineStage* ip) const {
+    // Mediump stages exist only for loading and storing F16 pixels, coverage and simple blends.
+    // Every intermediate is rounded to a half float, though, so results can drift a few ulps from
+    // highp, and products of large F16 values can overflow to infinity where floats wouldn't.
+    // That's why mediump is opt-in.
+    if (!gAllowMediumpRasterPipeline || gForceHighPrecisionRasterPipeline || fRewindCtx ||
+        !SkOpts::just_return_mediump) {
+        return false;
+    }
+    prepend_to_pipeline(ip, SkOpts::just_return_mediump, /*ctx=*/nullptr);
+    for (const StageList* st = fStages; st; st = st->prev) {
+        SkOpts::StageFn fn = SkOpts::ops_mediump[(int)st->stage];
+        if (!fn) {
+            // This program contains a stage that doesn't exist in mediump.
+            return false;
+        }
+        prepend_to_pipeline(ip, fn, st->ctx);
+    }
+    return true;
+}
+
 void SkRasterPipeline::buildHighpPipeline(SkRasterPipelineStage* ip) const {
     // We assemble the pipeline in reverse, since the stage list is stored backwards.
     prepend_to_pipeline(ip, SkOpts::just_return_highp, /*ctx=*/nullptr);
@@ -574,10 +613,14 @@ void SkRasterPipeline::buildHighpPipeline(SkRasterPipelineStage* ip) const {
 }
 
 SkRasterPipeline::StartPipelineFn SkRasterPipeline::buildPipeline(SkRasterPipelineStage* ip) const {
-    // We try to build a lowp pipeline first; if that fails, we fall back to a highp float pipeline.
+    // We try to build a lowp pipeline first, then a half-float mediump pipeline; if those fail,
+    // we fall back to a highp float pipeline.
     if (this->buildLowpPipeline(ip)) {
         return SkOpts::start_pipeline_lowp;
     }
+    if (this->buildMediumpPipeline(ip)) {
+        return SkOpts::start_pipeline_mediump;
+    }
 
     this->buildHighpPipeline(ip);
     return SkOpts::start_pipeline_highp;
@@ -108,13 +108,21 @@ public:
     void appendMatrix(SkArenaAlloc*, const SkMatrix&);
 
     // Appends a stage for a constant uniform color.
-    // Tries to optimize the stage based on the color.
-    void appendConstantColor(SkArenaAlloc*, const float rgba[4]);
-
-    void appendConstantColor(SkArenaAlloc* alloc, const SkColor4f& color) {
-        this->appendConstantColor(alloc, color.vec());
+    // Tries to optimize the stage based on the color. Returns the stage's context, which can be
+    // refilled with FillUniformColorCtx() to change the color to any other with the same
+    // ConstantColorOp(), or nullptr if the stage doesn't need one.
+    SkRasterPipeline_UniformColorCtx* appendConstantColor(SkArenaAlloc*, const float rgba[4]);
+
+    SkRasterPipeline_UniformColorCtx* appendConstantColor(SkArenaAlloc* alloc,
+                                                          const SkColor4f& color) {
+        return this->appendConstantColor(alloc, color.vec());
     }
 
+    // The stage appendConstantColor() uses for a color: black_color, white_color, uniform_color
+    // or unbounded_uniform_color.
+    static SkRasterPipelineOp ConstantColorOp(const float rgba[4]);
+    static void FillUniformColorCtx(SkRasterPipeline_UniformColorCtx*, const float rgba[4]);
+
     // Like appendConstantColor() but only affecting r,g,b, ignoring the alpha channel.
     void appendSetRGB(SkArenaAlloc*, const float rgb[3]);
 
@@ -136,6 +144,7 @@ public:
 
 private:
     bool buildLowpPipeline(SkRasterPipelineStage* ip) const;
+    bool buildMediumpPipeline(SkRasterPipelineStage* ip) const;
     void buildHighpPipeline(SkRasterPipelineStage* ip) const;
 
     using StartPipelineFn = void (*)(size_t, size_t, size_t, size_t,
@@ -19,6 +19,7 @@
 #include "include/core/SkSurfaceProps.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkCPUTypes.h"
+#include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkBlendModePriv.h"
@@ -26,7 +27,9 @@
 #include "src/core/SkBlitter.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
+#include "src/core/SkCoreBlitters.h"
 #include "src/core/SkEffectPriv.h"
+#include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMemset.h"
 #include "src/core/SkRasterPipeline.h"
@@ -47,14 +50,14 @@ class SkShader;
 class SkRasterPipelineBlitter final : public SkBlitter {
 public:
     // This is our common entrypoint for creating the blitter once we've sorted out shaders.
-    static SkBlitter* Create(const SkPixmap& dst,
-                             const SkPaint& paint,
-                             const SkColor4f& dstPaintColor,
-                             SkArenaAlloc* alloc,
-                             const SkRasterPipeline& shaderPipeline,
-                             bool is_opaque,
-                             bool is_constant,
-                             const SkShader* clipShader);
+    static SkRasterPipelineBlitter* Create(const SkPixmap& dst,
+                                           const SkPaint& paint,
+                                           const SkColor4f& dstPaintColor,
+                                           SkArenaAlloc* alloc,
+                                           const SkRasterPipeline& shaderPipeline,
+                                           bool is_opaque,
+                                           bool is_constant,
+                                           const SkShader* clipShader);
 
     SkRasterPipelineBlitter(SkPixmap dst,
                             SkArenaAlloc* alloc)
@@ -72,8 +75,15 @@ public:
     void blitRect  (int x, int y, int width, int height)            override;
     void blitV     (int x, int y, int height, SkAlpha alpha)        override;
 
+    const SkPixmap& dst() const { return fDst; }
+
+    // Changes the color drawn by a blitter whose color pipeline collapsed into a constant. The new
+    // color must need the same SkRasterPipeline::ConstantColorOp() as the original.
+    void setConstantColor(const SkPMColor4f& color);
+
 private:
     void blitRectWithTrace(int x, int y, int w, int h, bool trace);
+    void updateMemsetColor();
     void appendLoadDst      (SkRasterPipeline*) const;
     void appendStore        (SkRasterPipeline*) const;
 
@@ -89,6 +99,8 @@ private:
     std::optional<SkBlendMode> fBlendMode;
     // set to pipeline storage (for alpha) if we have a clipShader
     void*                  fClipShaderBuffer = nullptr; // "native" : float or U16
+    // set if the color pipeline is a constant color read from this context
+    SkRasterPipeline_UniformColorCtx* fConstantColorCtx = nullptr;
 
     SkRasterPipeline_MemoryCtx
         fDstPtr       = {nullptr,0},  // Always points to the top-left of fDst.
@@ -172,14 +184,14 @@ SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap& dst,
                                            clipShader.get());
 }
 
-SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
-                                           const SkPaint& paint,
-                                           const SkColor4f& dstPaintColor,
-                                           SkArenaAlloc* alloc,
-                                           const SkRasterPipeline& shaderPipeline,
-                                           bool is_opaque,
-                                           bool is_constant,
-                                           const SkShader* clipShader) {
+SkRasterPipelineBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
+                                                         const SkPaint& paint,
+                                                         const SkColor4f& dstPaintColor,
+                                                         SkArenaAlloc* alloc,
+                                                         const SkRasterPipeline& shaderPipeline,
+                                                         bool is_opaque,
+                                                         bool is_constant,
+                                                         const SkShader* clipShader) {
     auto blitter = alloc->make<SkRasterPipelineBlitter>(dst, alloc);
 
     // Our job in this factory is to fill out the blitter's color and blend pipelines.
@@ -284,7 +296,7 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
         colorPipeline->append(SkRasterPipelineOp::store_f32, &constantColorPtr);
         colorPipeline->run(0,0,1,1);
         colorPipeline->reset();
-        colorPipeline->appendConstantColor(alloc, constantColor);
+        blitter->fConstantColorCtx = colorPipeline->appendConstantColor(alloc, constantColor);
 
         is_opaque = constantColor.fA == 1.0f;
     }
@@ -306,13 +318,7 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
     // (The previous two optimizations help find more opportunities for this one.)
     if (is_constant && as_BB(blender)->asBlendMode() == SkBlendMode::kSrc &&
         dst.info().bytesPerPixel() <= static_cast<int>(sizeof(blitter->fMemsetColor))) {
-        // Run our color pipeline all the way through to produce what we'd memset when we can.
-        // Not all blits can memset, so we need to keep colorPipeline too.
-        SkRasterPipeline_<256> p;
-        p.extend(*colorPipeline);
-        blitter->fDstPtr = SkRasterPipeline_MemoryCtx{&blitter->fMemsetColor, 0};
-        blitter->appendStore(&p);
-        p.run(0,0,1,1);
+        blitter->updateMemsetColor();
 
         switch (blitter->fDst.shiftPerPixel()) {
             case 0: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h, uint64_t c) {
@@ -357,6 +363,31 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
     return blitter;
 }
 
+void SkRasterPipelineBlitter::updateMemsetColor() {
+    // Run our color pipeline all the way through to produce what we'd memset when we can.
+    // Not all blits can memset, so we need to keep colorPipeline too.
+    SkRasterPipeline_<256> p;
+    p.extend(fColorPipeline);
+    SkRasterPipeline_MemoryCtx dstPtr = fDstPtr;
+    fDstPtr = SkRasterPipeline_MemoryCtx{&fMemsetColor, 0};
+    this->appendStore(&p);
+    p.run(0,0,1,1);
+    fDstPtr = dstPtr;
+}
+
+void SkRasterPipelineBlitter::setConstantColor(const SkPMColor4f& color) {
+    SkASSERT(!fConstantColorCtx ||
+             fColorPipeline.getStageList()->stage == SkRasterPipeline::ConstantColorOp(color.vec()));
+    if (!fConstantColorCtx) {
+        // black_color and white_color have nothing to change.
+        return;
+    }
+    SkRasterPipeline::FillUniformColorCtx(fConstantColorCtx, color.vec());
+    if (fMemset2D) {
+        this->updateMemsetColor();
+    }
+}
+
 void SkRasterPipelineBlitter::appendLoadDst(SkRasterPipeline* p) const {
     p->appendLoadDst(fDst.info().colorType(), &fDstPtr);
     if (fDst.info().alphaType() == kUnpremul_SkAlphaType) {
@@ -597,3 +628,58 @@ void SkRasterPipelineBlitter::blitMask(const SkMask& mask, const SkIRect& clip)
     SkASSERT(blitter);
     (*blitter)(clip.left(),clip.top(), clip.width(),clip.height());
 }
+
+SkRasterPipelineBlitterCache::SkRasterPipelineBlitterCache() : fAlloc(4096) {}
+
+SkRasterPipelineBlitterCache::~SkRasterPipelineBlitterCache() = default;
+
+SkBlitter* SkRasterPipelineBlitterCache::find(const SkPixmap& dst, const SkPaint& paint) {
+    std::optional<SkBlendMode> blendMode = paint.asBlendMode();
+    if (paint.getShader() || paint.getColorFilter() || !blendMode || !dst.addr()) {
+        return nullptr;
+    }
+
+    // Work out the constant color SkRasterPipelineBlitter::Create() collapses the paint into, and
+    // the stages it would build for it.
+    const SkColor4f dstPaintColor = paint_color_to_dst(paint, dst);
+    SkPMColor4f color = dstPaintColor.premul();
+    if (SkColorTypeIsNormalized(dst.colorType())) {
+        color = {SkTPin(color.fR, 0.0f, 1.0f),
+                 SkTPin(color.fG, 0.0f, 1.0f),
+                 SkTPin(color.fB, 0.0f, 1.0f),
+                 SkTPin(color.fA, 0.0f, 1.0f)};
+    }
+    const SkRasterPipelineOp colorOp = SkRasterPipeline::ConstantColorOp(color.vec());
+    if (*blendMode == SkBlendMode::kSrcOver && color.fA == 1.0f) {
+        blendMode = SkBlendMode::kSrc;
+    }
+
+    for (const Entry& entry : fEntries) {
+        const SkPixmap& cached = entry.fBlitter->dst();
+        if (entry.fBlendMode == *blendMode && entry.fColorOp == colorOp &&
+            cached.addr() == dst.addr() && cached.rowBytes() == dst.rowBytes() &&
+            cached.info() == dst.info()) {
+            entry.fBlitter->setConstantColor(color);
+            return entry.fBlitter;
+        }
+    }
+
+    if (fEntries.size() == kMaxEntries) {
+        fEntries.clear();
+        fAlloc.reset();
+    }
+    SkRasterPipeline_<256> shaderPipeline;
+    shaderPipeline.appendConstantColor(&fAlloc, dstPaintColor.premul().vec());
+    SkRasterPipelineBlitter* blitter = SkRasterPipelineBlitter::Create(dst,
+                                                                       paint,
+                                                                       dstPaintColor,
+                                                                       &fAlloc,
+                                                                       shaderPipeline,
+                                                                       dstPaintColor.fA == 1.0f,
+                                                                       /*is_constant=*/true,
+                                                                       /*clipShader=*/nullptr);
+    if (blitter) {
+        fEntries.push_back({blitter, *blendMode, colorOp});
+    }
+    return blitter;
+}
@@ -18,7 +18,7 @@ namespace SkSL { class TraceHook; }
 // of pixels we handle in the highp pipeline. Many of the context structs in this file are only used
 // by stages that have no lowp implementation. They can therefore use the (smaller) highp value to
 // save memory in the arena.
-inline static constexpr int SkRasterPipeline_kMaxStride = 16;
+inline static constexpr int SkRasterPipeline_kMaxStride = 32;
 inline static constexpr int SkRasterPipeline_kMaxStride_highp = 16;
 
 // How much space to allocate for each MemoryCtx scratch buffer, as part of tail-pixel handling.
@@ -174,6 +174,9 @@ struct SkRasterPipeline_GradientCtx {
     size_t stopCount;
     float* fs[4];
     float* bs[4];
+    // For the `gradient` stage, ts[1..stopCount-1] are the sorted stop positions. The array is
+    // padded with NaNs to at least twice the largest power of two <= stopCount-1, so that the
+    // binary search used for many stops never needs to bounds check its probes.
     float* ts;
 };
 
@@ -52,6 +52,19 @@
     M(emboss)                                                      \
     M(swizzle)
 
+// `SK_RASTER_PIPELINE_OPS_MEDIUMP` defines ops that also have half-float (mediump) implementations.
+// Every op here is found in `SK_RASTER_PIPELINE_OPS_ALL` as well; mediump stages are looked up by
+// SkRasterPipelineOp, so this list needn't be kept in any particular order.
+#define SK_RASTER_PIPELINE_OPS_MEDIUMP(M)                          \
+    M(move_src_dst) M(move_dst_src) M(swap_src_dst)                \
+    M(clamp_01) M(premul) M(force_opaque)                          \
+    M(black_color) M(white_color) M(uniform_color)                 \
+    M(load_f16) M(load_f16_dst) M(store_f16)                       \
+    M(scale_1_float) M(scale_u8) M(lerp_1_float) M(lerp_u8)        \
+    M(dstatop) M(dstin) M(dstout) M(dstover)                       \
+    M(srcatop) M(srcin) M(srcout) M(srcover)                       \
+    M(clear) M(modulate) M(multiply) M(plus_) M(screen) M(xor_)
+
 // `SK_RASTER_PIPELINE_OPS_SKSL` defines ops used by SkSL.
 #define SK_RASTER_PIPELINE_OPS_SKSL(M)                                                          \
     M(init_lane_masks) M(store_device_xy01) M(exchange_src)                                     \
@@ -320,6 +320,16 @@ sk_sp<SkData> SkReadBuffer::readByteArrayAsData() {
         return nullptr;
     }
 
+    if (fSharedData) {
+        (void)this->readUInt();  // The count that getArrayCount() peeked at.
+        const char* bytes = static_cast<const char*>(this->skip(numBytes));
+        if (!bytes) {
+            return nullptr;
+        }
+        return SkData::MakeSubset(
+                fSharedData, bytes - static_cast<const char*>(fSharedData->data()), numBytes);
+    }
+
     SkAutoMalloc buffer(numBytes);
     if (!this->readByteArray(buffer.get(), numBytes)) {
         return nullptr;
@@ -409,41 +419,49 @@ static sk_sp<SkImage> add_mipmaps(sk_sp<SkImage> img, sk_sp<SkData> data,
 // If we see a corrupt stream, we return null (fail). If we just fail trying to decode
 // the image, we don't fail, but return a 1x1 empty image.
 sk_sp<SkImage> SkReadBuffer::readImage() {
-    uint32_t flags = this->read32();
-
-    std::optional<SkAlphaType> alphaType = std::nullopt;
-    if (flags & SkWriteBufferImageFlags::kUnpremul) {
-        alphaType = kUnpremul_SkAlphaType;
+    ImageData data;
+    if (!this->readImageData(&data)) {
+        return nullptr;
     }
-    sk_sp<SkImage> image;
-    {
-        sk_sp<SkData> data = this->readByteArrayAsData();
-        if (!data) {
-            this->validate(false);
-            return nullptr;
-        }
-        image = deserialize_image(data, fProcs, alphaType);
+    return DecodeImage(data, fProcs);
+}
+
+bool SkReadBuffer::readImageData(ImageData* data) {
+    data->fFlags = this->read32();
+    data->fEncoded = this->readByteArrayAsData();
+    if (!data->fEncoded) {
+        this->validate(false);
+        return false;
     }
 
     // This flag is not written by new SKPs anymore.
-    if (flags & SkWriteBufferImageFlags::kHasSubsetRect) {
-        SkIRect subset;
-        this->readIRect(&subset);
-        if (image) {
-            image = image->makeSubset(nullptr, subset);
-        }
+    if (data->fFlags & SkWriteBufferImageFlags::kHasSubsetRect) {
+        this->readIRect(&data->fSubset);
     }
 
-    if (flags & SkWriteBufferImageFlags::kHasMipmap) {
-        sk_sp<SkData> data = this->readByteArrayAsData();
-        if (!data) {
+    if (data->fFlags & SkWriteBufferImageFlags::kHasMipmap) {
+        data->fMipmaps = this->readByteArrayAsData();
+        if (!data->fMipmaps) {
             this->validate(false);
-            return nullptr;
-        }
-        if (image) {
-            image = add_mipmaps(image, std::move(data), fProcs, alphaType);
+            return false;
         }
     }
+    return true;
+}
+
+sk_sp<SkImage> SkReadBuffer::DecodeImage(const ImageData& data, const SkDeserialProcs& procs) {
+    std::optional<SkAlphaType> alphaType = std::nullopt;
+    if (data.fFlags & SkWriteBufferImageFlags::kUnpremul) {
+        alphaType = kUnpremul_SkAlphaType;
+    }
+    sk_sp<SkImage> image = deserialize_image(data.fEncoded, procs, alphaType);
+
+    if (image && (data.fFlags & SkWriteBufferImageFlags::kHasSubsetRect)) {
+        image = image->makeSubset(nullptr, data.fSubset);
+    }
+    if (image && (data.fFlags & SkWriteBufferImageFlags::kHasMipmap)) {
+        image = add_mipmaps(image, data.fMipmaps, procs, alphaType);
+    }
     return image ? image : MakeEmptyImage(1, 1);
 }
 
@@ -10,6 +10,7 @@
 
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkPaint.h"
@@ -37,7 +38,6 @@
 #include <cstdint>
 
 class SkBlender;
-class SkData;
 class SkImage;
 class SkM44;
 class SkMaskFilter;
@@ -62,6 +62,16 @@ public:
 
     void setMemory(const void*, size_t);
 
+    /**
+     *  'data' must contain the buffer's memory and outlive the buffer. Byte arrays read with
+     *  readByteArrayAsData() (e.g. encoded images) then reference 'data' instead of being copied.
+     */
+    void setSharedData(const SkData* data) {
+        SkASSERT(!data || (data->bytes() <= (const uint8_t*)fBase &&
+                           (const uint8_t*)fStop <= data->bytes() + data->size()));
+        fSharedData = data;
+    }
+
     /**
      *  Returns true IFF the version is older than the specified version.
      */
@@ -169,6 +179,18 @@ public:
     // be created (e.g. it was not originally encoded) then this returns an image that doesn't
     // draw.
     sk_sp<SkImage> readImage();
+
+    // The serialized parts of an image. readImage() reads them with readImageData() and then
+    // decodes them with DecodeImage(), which may also be called on another thread.
+    struct ImageData {
+        uint32_t      fFlags = 0;
+        sk_sp<SkData> fEncoded;
+        SkIRect       fSubset = SkIRect::MakeEmpty();
+        sk_sp<SkData> fMipmaps;
+    };
+    bool readImageData(ImageData*);
+    static sk_sp<SkImage> DecodeImage(const ImageData&, const SkDeserialProcs&);
+
     sk_sp<SkTypeface> readTypeface();
 
     void setTypefaceArray(sk_sp<SkTypeface> array[], int count) {
@@ -244,6 +266,8 @@ private:
     const char* fStop = nullptr;  // end of buffer
     const char* fBase = nullptr;  // beginning of buffer
 
+    const SkData* fSharedData = nullptr;
+
     // Only used if we do not have an fFactoryArray.
     skia_private::THashMap<uint32_t, SkFlattenable::Factory> fFlattenableDict;
 
@@ -7,13 +7,54 @@
 
 #include "src/core/SkRecord.h"
 
+#include "include/core/SkPaint.h"
+#include "src/core/SkChecksum.h"
+
 #include <algorithm>
+#include <cstring>
+#include <new>
 
 SkRecord::~SkRecord() {
     Destroyer destroyer;
     for (int i = 0; i < this->count(); i++) {
         this->mutate(i, destroyer);
     }
+    fInternedPaints.foreach([](const SkPaint** paint) { (*paint)->~SkPaint(); });
+}
+
+uint32_t SkRecord::InternedPaintTraits::Hash(const SkPaint& paint) {
+    // Everything that SkPaint's operator== compares, with effects compared by identity.
+    struct {
+        const void* effects[6];
+        SkColor4f   color;
+        float       width, miter;
+        uint32_t    flags;
+    } key;
+    memset(&key, 0, sizeof(key));  // Hash the padding too.
+    key.effects[0] = paint.getPathEffect();
+    key.effects[1] = paint.getShader();
+    key.effects[2] = paint.getMaskFilter();
+    key.effects[3] = paint.getColorFilter();
+    key.effects[4] = paint.getImageFilter();
+    key.effects[5] = paint.getBlender();
+    key.color = paint.getColor4f();
+    key.width = paint.getStrokeWidth();
+    key.miter = paint.getStrokeMiter();
+    key.flags = (uint32_t)paint.isAntiAlias()         |
+                (uint32_t)paint.isDither()      << 1  |
+                (uint32_t)paint.getStrokeCap()  << 2  |
+                (uint32_t)paint.getStrokeJoin() << 4  |
+                (uint32_t)paint.getStyle()      << 6;
+    return SkChecksum::Hash32(&key, sizeof(key));
+}
+
+const SkPaint* SkRecord::internPaint(const SkPaint& paint) {
+    if (const SkPaint* const* interned = fInternedPaints.find(paint)) {
+        return *interned;
+    }
+    const SkPaint* copy = new (this->alloc<SkPaint>()) SkPaint(paint);
+    fInternedPaints.set(copy);
+    return copy;
 }
 
 void SkRecord::grow() {
@@ -35,3 +76,49 @@ void SkRecord::defrag() {
                                    [](Record op) { return op.type() == SkRecords::NoOp_Type; });
     fCount = noops - fRecords.get();
 }
+
+void SkRecord::reorder(int begin, SkSpan<const int> order) {
+    SkASSERT(begin >= 0 && begin + (int)order.size() <= fCount);
+    skia_private::AutoSTMalloc<64, Record> ops(order.size());
+    std::copy_n(fRecords.get() + begin, order.size(), ops.get());
+    for (size_t i = 0; i < order.size(); ++i) {
+        fRecords[begin + i] = ops[order[i]];
+    }
+}
+
+void SkRecord::splice(SkSpan<Splice> splices) {
+    if (splices.empty()) {
+        return;
+    }
+    int newCount = fCount;
+    for (const Splice& s : splices) {
+        newCount += s.fRecord->count() - 1;
+    }
+
+    skia_private::AutoTMalloc<Record> records(newCount);
+    int src = 0, dst = 0;
+    for (Splice& s : splices) {
+        SkASSERT(s.fIndex >= src && s.fIndex < fCount);
+        SkASSERT(s.fRecord.get() != this);
+        std::copy_n(fRecords.get() + src, s.fIndex - src, records.get() + dst);
+        dst += s.fIndex - src;
+
+        Destroyer destroyer;
+        this->mutate(s.fIndex, destroyer);
+        src = s.fIndex + 1;
+
+        SkRecord* other = s.fRecord.get();
+        std::copy_n(other->fRecords.get(), other->fCount, records.get() + dst);
+        dst += other->fCount;
+        fApproxBytesAllocated += other->fApproxBytesAllocated;
+        // The ops now belong to this record, so the other one must not destroy them.
+        other->fCount = other->fReserved = 0;
+        other->fRecords.reset();
+        fSplicedRecords.push_back(std::move(s.fRecord));
+    }
+    std::copy_n(fRecords.get() + src, fCount - src, records.get() + dst);
+    SkASSERT(dst + fCount - src == newCount);
+
+    fRecords = std::move(records);
+    fCount = fReserved = newCount;
+}
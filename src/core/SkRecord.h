@@ -9,10 +9,13 @@
 #define SkRecord_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkRecords.h"
+#include "src/core/SkTHash.h"
 
 #include <cstddef>
 #include <type_traits>
@@ -89,6 +92,13 @@ public:
         return fRecords[i].set(this->allocCommand<T>());
     }
 
+    // Returns this record's copy of a paint equal to 'paint', making one if there is none yet.
+    // Ops that record the same paint many times can point to it instead of each holding a copy.
+    // It is destroyed with the record.
+    const SkPaint* internPaint(const SkPaint& paint);
+
+    int internedPaintCount() const { return fInternedPaints.count(); }
+
     // Does not return the bytes in any pointers embedded in the Records; callers
     // need to iterate with a visitor to measure those they care for.
     size_t bytesUsed() const;
@@ -97,6 +107,19 @@ public:
     // May change count() and the indices of ops, but preserves their order.
     void defrag();
 
+    // Rearrange the ops in [begin, begin + order.size()) so that the i-th of them is the op that
+    // was at begin + order[i]. order must be a permutation of [0, order.size()).
+    void reorder(int begin, SkSpan<const int> order);
+
+    // Replaces each op at Splice::fIndex (in increasing order) with all the ops of Splice::fRecord,
+    // which is left empty. The spliced ops are not copied: they stay in the memory of the other
+    // records, which this SkRecord keeps alive.
+    struct Splice {
+        int             fIndex;
+        sk_sp<SkRecord> fRecord;
+    };
+    void splice(SkSpan<Splice> splices);
+
 private:
     // An SkRecord is structured as an array of pointers into a big chunk of memory where
     // records representing each canvas draw call are stored:
@@ -180,6 +203,15 @@ private:
     // chunks, returning a stable handle to that data for later retrieval.
     SkArenaAlloc fAlloc{256};
     size_t       fApproxBytesAllocated{0};
+
+    struct InternedPaintTraits {
+        static const SkPaint& GetKey(const SkPaint* paint) { return *paint; }
+        static uint32_t Hash(const SkPaint& paint);
+    };
+    skia_private::THashTable<const SkPaint*, SkPaint, InternedPaintTraits> fInternedPaints;
+
+    // Records whose ops were spliced into this one, and whose fAlloc they still live in.
+    skia_private::TArray<sk_sp<SkRecord>> fSplicedRecords;
 };
 
 #endif//SkRecord_DEFINED
@@ -28,9 +28,11 @@
 #include "include/private/base/SkTDArray.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/chromium/Slug.h"
+#include "src/core/SkBigPicture.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkDrawShadowInfo.h"
 #include "src/core/SkImageFilter_Base.h"
+#include "src/core/SkPicturePriv.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecords.h"
 #include "src/effects/colorfilters/SkColorFilterBase.h"
@@ -62,16 +64,7 @@ void SkRecordDraw(const SkRecord& record,
         std::vector<int> ops;
         bbh->search(query, &ops);
 
-        SkRecords::Draw draw(canvas, drawablePicts, drawables, drawableCount);
-        for (int i = 0; i < (int)ops.size(); i++) {
-            if (callback && callback->abort()) {
-                return;
-            }
-            // This visit call uses the SkRecords::Draw::operator() to call
-            // methods on the |canvas|, wrapped by methods defined with the
-            // DRAW() macro.
-            record.visit(ops[i], draw);
-        }
+        SkRecordDrawOps(record, canvas, drawablePicts, drawables, drawableCount, ops, callback);
     } else {
         // Draw all ops.
         SkRecords::Draw draw(canvas, drawablePicts, drawables, drawableCount);
@@ -87,6 +80,25 @@ void SkRecordDraw(const SkRecord& record,
     }
 }
 
+void SkRecordDrawOps(const SkRecord& record,
+                     SkCanvas* canvas,
+                     SkPicture const* const drawablePicts[],
+                     SkDrawable* const drawables[],
+                     int drawableCount,
+                     SkSpan<const int> ops,
+                     SkPicture::AbortCallback* callback) {
+    SkRecords::Draw draw(canvas, drawablePicts, drawables, drawableCount);
+    for (int op : ops) {
+        if (callback && callback->abort()) {
+            return;
+        }
+        // This visit call uses the SkRecords::Draw::operator() to call
+        // methods on the |canvas|, wrapped by methods defined with the
+        // DRAW() macro.
+        record.visit(op, draw);
+    }
+}
+
 namespace SkRecords {
 
 // NoOps draw nothing.
@@ -157,6 +169,10 @@ DRAW(DrawRRect, drawRRect(r.rrect, r.paint))
 DRAW(DrawRect, drawRect(r.rect, r.paint))
 DRAW(DrawRegion, drawRegion(r.region, r.paint))
 DRAW(DrawTextBlob, drawTextBlob(r.blob.get(), r.x, r.y, r.paint))
+DRAW(DrawRectInterned, drawRect(r.rect, *r.paint))
+DRAW(DrawImageRectInterned, drawImageRect(r.image.get(), r.src, r.dst, r.sampling, r.paint,
+                                          r.constraint))
+DRAW(DrawTextBlobInterned, drawTextBlob(r.blob.get(), r.x, r.y, *r.paint))
 DRAW(DrawSlug, drawSlug(r.slug.get()))
 DRAW(DrawAtlas, drawAtlas(r.atlas.get(), r.xforms, r.texs, r.colors, r.count, r.mode, r.sampling,
                           r.cull, r.paint))
@@ -411,6 +427,9 @@ private:
     Bounds bounds(const NoOp&)  const { return Bounds::MakeEmpty(); }    // NoOps don't draw.
 
     Bounds bounds(const DrawRect& op) const { return this->adjustAndMap(op.rect, &op.paint); }
+    Bounds bounds(const DrawRectInterned& op) const {
+        return this->adjustAndMap(op.rect, op.paint);
+    }
     Bounds bounds(const DrawRegion& op) const {
         SkRect rect = SkRect::Make(op.region.getBounds());
         return this->adjustAndMap(rect, &op.paint);
@@ -436,6 +455,9 @@ private:
     Bounds bounds(const DrawImageRect& op) const {
         return this->adjustAndMap(op.dst, op.paint);
     }
+    Bounds bounds(const DrawImageRectInterned& op) const {
+        return this->adjustAndMap(op.dst, op.paint);
+    }
     Bounds bounds(const DrawPath& op) const {
         return op.path.isInverseFillType() ? fCullRect
                                            : this->adjustAndMap(op.path.getBounds(), &op.paint);
@@ -478,7 +500,10 @@ private:
     }
 
     Bounds bounds(const DrawPicture& op) const {
-        SkRect dst = op.picture->cullRect();
+        // A nested picture's ops may cover much less than its cull rect, so use their bounds
+        // when we have them; this lets a BBH over the outer picture cull the whole nested one.
+        const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(op.picture);
+        SkRect dst = big ? big->contentBounds() : op.picture->cullRect();
         op.matrix.mapRect(&dst);
         return this->adjustAndMap(dst, op.paint);
     }
@@ -488,6 +513,11 @@ private:
         dst.offset(op.x, op.y);
         return this->adjustAndMap(dst, &op.paint);
     }
+    Bounds bounds(const DrawTextBlobInterned& op) const {
+        SkRect dst = op.blob->bounds();
+        dst.offset(op.x, op.y);
+        return this->adjustAndMap(dst, op.paint);
+    }
 
     Bounds bounds(const DrawSlug& op) const {
         SkRect dst = op.slug->sourceBoundsWithOrigin();
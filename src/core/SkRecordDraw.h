@@ -12,6 +12,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkM44.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkSpan.h"
 #include "include/private/base/SkNoncopyable.h"
 
 class SkDrawable;
@@ -27,6 +28,11 @@ void SkRecordDraw(const SkRecord&, SkCanvas*, SkPicture const* const drawablePic
                   SkDrawable* const drawables[], int drawableCount,
                   const SkBBoxHierarchy*, SkPicture::AbortCallback*);
 
+// Draw only the ops at the given indices, in the order given.
+void SkRecordDrawOps(const SkRecord&, SkCanvas*, SkPicture const* const drawablePicts[],
+                     SkDrawable* const drawables[], int drawableCount,
+                     SkSpan<const int> ops, SkPicture::AbortCallback*);
+
 namespace SkRecords {
 
 // This is an SkRecord visitor that will draw that SkRecord to an SkCanvas.
@@ -11,15 +11,28 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkTextBlob.h"
 #include "include/private/base/SkMath.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/core/SkPaintPriv.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecordPattern.h"
 #include "src/core/SkRecords.h"
+#include "src/core/SkRectPriv.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <optional>
+#include <type_traits>
+#include <vector>
 
 using namespace SkRecords;
 
@@ -266,6 +279,316 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// What SkRecordReorderDraws() needs to know about a draw it may move.
+struct ReorderableDraw {
+    Type fType;
+    const SkPaint* fPaint;  // May be null for image draws.
+    const SkImage* fImage;  // Only set for image draws.
+    SkIRect fDeviceBounds;  // Includes every pixel the draw may touch.
+};
+
+// Returns false for ops that can't be moved, or whose bounds aren't known.
+class GetReorderableDraw {
+public:
+    explicit GetReorderableDraw(const SkMatrix& ctm) : fCTM(ctm) {}
+
+    template <typename T> bool operator()(const T&) { return false; }
+
+    bool operator()(const DrawRect& op) { return this->set(op, &op.paint, nullptr, op.rect); }
+    bool operator()(const DrawRRect& op) {
+        return this->set(op, &op.paint, nullptr, op.rrect.getBounds());
+    }
+    bool operator()(const DrawOval& op) { return this->set(op, &op.paint, nullptr, op.oval); }
+    bool operator()(const DrawImage& op) {
+        return this->set(op, op.paint, op.image.get(),
+                         SkRect::MakeXYWH(op.left, op.top, op.image->width(), op.image->height()));
+    }
+    bool operator()(const DrawImageRect& op) {
+        return this->set(op, op.paint, op.image.get(), op.dst);
+    }
+    bool operator()(const DrawTextBlob& op) {
+        return this->set(op, &op.paint, nullptr, op.blob->bounds().makeOffset(op.x, op.y));
+    }
+
+    const ReorderableDraw& draw() const { return fDraw; }
+
+private:
+    template <typename T>
+    bool set(const T&, const SkPaint* paint, const SkImage* image, SkRect bounds) {
+        bounds.sort();
+        if (paint) {
+            if (!paint->canComputeFastBounds()) {
+                return false;
+            }
+            bounds = paint->computeFastBounds(bounds, &bounds);
+        }
+        SkRect device = fCTM.mapRect(bounds);
+        if (!device.isFinite()) {
+            return false;
+        }
+        // Antialiasing may touch the pixels just outside of the rounded out bounds too.
+        fDraw = {T::kType, paint, image, device.roundOut().makeOutset(1, 1)};
+        return true;
+    }
+
+    const SkMatrix& fCTM;
+    ReorderableDraw fDraw;
+};
+
+// Tracks the CTM like SkRecordFillBounds() does.
+class TrackCTM {
+public:
+    template <typename T> void operator()(const T&) {}
+    void operator()(const Restore& op)   { fCTM = op.matrix; }
+    void operator()(const SetMatrix& op) { fCTM = op.matrix; }
+    void operator()(const SetM44& op)    { fCTM = op.matrix.asM33(); }
+    void operator()(const Concat44& op)  { fCTM.preConcat(op.matrix.asM33()); }
+    void operator()(const Concat& op)    { fCTM.preConcat(op.matrix); }
+    void operator()(const Scale& op)     { fCTM.preScale(op.sx, op.sy); }
+    void operator()(const Translate& op) { fCTM.preTranslate(op.dx, op.dy); }
+
+    const SkMatrix& ctm() const { return fCTM; }
+
+private:
+    SkMatrix fCTM = SkMatrix::I();
+};
+
+bool same_batch(const ReorderableDraw& a, const ReorderableDraw& b) {
+    if (a.fType != b.fType || a.fImage != b.fImage) {
+        return false;
+    }
+    return a.fPaint && b.fPaint ? *a.fPaint == *b.fPaint : a.fPaint == b.fPaint;
+}
+
+// Reorders the draws of a run that starts at 'begin'. Draws that don't touch the same pixels
+// can be drawn in any order, since nothing changes the matrix or clip between them.
+void reorder_run(SkRecord* record, int begin, SkSpan<const ReorderableDraw> run) {
+    if (run.size() < 3) {
+        return;
+    }
+
+    struct Batch {
+        int fFirst;            // The first draw, which the others are compatible with.
+        SkIRect fBounds;       // The union of the draws' bounds.
+        skia_private::STArray<4, int, true> fDraws;
+    };
+    skia_private::TArray<Batch> batches;
+    for (int i = 0; i < (int)run.size(); ++i) {
+        const ReorderableDraw& draw = run[i];
+        // Look for the last compatible batch that the draw can move up to without passing any
+        // draw it overlaps.
+        Batch* target = nullptr;
+        for (int b = batches.size() - 1; b >= 0; --b) {
+            Batch& batch = batches[b];
+            if (same_batch(run[batch.fFirst], draw)) {
+                target = &batch;
+                break;
+            }
+            if (SkIRect::Intersects(batch.fBounds, draw.fDeviceBounds) &&
+                std::any_of(batch.fDraws.begin(), batch.fDraws.end(), [&](int j) {
+                    return SkIRect::Intersects(run[j].fDeviceBounds, draw.fDeviceBounds);
+                })) {
+                break;
+            }
+        }
+        if (!target) {
+            target = &batches.push_back();
+            target->fFirst = i;
+            target->fBounds = SkIRect::MakeEmpty();
+        }
+        target->fDraws.push_back(i);
+        target->fBounds.join(draw.fDeviceBounds);
+    }
+    if (batches.size() == (int)run.size()) {
+        return;
+    }
+
+    skia_private::AutoSTMalloc<64, int> order(run.size());
+    int n = 0;
+    for (const Batch& batch : batches) {
+        for (int i : batch.fDraws) {
+            order[n++] = i;
+        }
+    }
+    record->reorder(begin, {order.get(), run.size()});
+}
+
+}  // namespace
+
+void SkRecordReorderDraws(SkRecord* record) {
+    // Keeps the cost of the overlap tests down on pictures with very long runs of draws.
+    static constexpr size_t kMaxRunLength = 256;
+
+    TrackCTM tracker;
+    std::vector<ReorderableDraw> run;
+    for (int i = 0; i < record->count(); ++i) {
+        GetReorderableDraw get(tracker.ctm());
+        if (!tracker.ctm().hasPerspective() && record->visit(i, get)) {
+            if (run.size() == kMaxRunLength) {
+                reorder_run(record, i - (int)run.size(), run);
+                run.clear();
+            }
+            run.push_back(get.draw());
+            continue;
+        }
+        reorder_run(record, i - (int)run.size(), run);
+        run.clear();
+        record->visit(i, tracker);
+    }
+    reorder_run(record, record->count() - (int)run.size(), run);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// What SkRecordNoopOccludedDraws() needs to know about a draw.
+struct OcclusionDraw {
+    SkIRect fDeviceBounds;  // Includes every pixel the draw may touch.
+    SkIRect fOpaqueBounds;  // Only pixels the draw replaces with opaque colors. May be empty.
+};
+
+bool is_opaque_fill(const SkPaint& paint) {
+    return paint.getStyle() == SkPaint::kFill_Style &&
+           !paint.getPathEffect() &&
+           !paint.getMaskFilter() &&
+           !paint.getImageFilter() &&
+           SkPaintPriv::Overwrites(&paint, SkPaintPriv::kNone_ShaderOverrideOpacity);
+}
+
+// Returns false for ops whose bounds aren't known. Only opaque rect and paint draws hide others.
+class GetOcclusionDraw {
+public:
+    explicit GetOcclusionDraw(const SkMatrix& ctm) : fCTM(ctm) {}
+
+    template <typename T> bool operator()(const T& op) {
+        return this->setDeviceBounds(op, SkIRect::MakeEmpty());
+    }
+    bool operator()(const DrawRect& op) {
+        SkIRect opaque = SkIRect::MakeEmpty();
+        if (is_opaque_fill(op.paint) && fCTM.rectStaysRect()) {
+            SkRect device = fCTM.mapRect(op.rect.makeSorted());
+            // Antialiased edges only partially cover the pixels they cross.
+            if (device.isFinite()) {
+                opaque = device.roundIn();
+            }
+        }
+        return this->setDeviceBounds(op, opaque);
+    }
+    bool operator()(const DrawPaint& op) {
+        fDraw = {SkRectPriv::MakeILarge(),
+                 is_opaque_fill(op.paint) ? SkRectPriv::MakeILarge() : SkIRect::MakeEmpty()};
+        return true;
+    }
+
+    const OcclusionDraw& draw() const { return fDraw; }
+
+private:
+    template <typename T>
+    bool setDeviceBounds(const T& op, const SkIRect& opaque) {
+        GetReorderableDraw get(fCTM);
+        if (!get(op)) {
+            return false;
+        }
+        SkIRect bounds = get.draw().fDeviceBounds;
+        // Without antialiasing, shapes and images only touch the pixels whose centers they cover,
+        // so they stay inside their rounded out bounds. Glyphs are antialiased by their font.
+        const SkPaint* paint = get.draw().fPaint;
+        if (!std::is_same_v<T, DrawTextBlob> && !(paint && paint->isAntiAlias())) {
+            bounds.inset(1, 1);
+        }
+        fDraw = {bounds, opaque};
+        return true;
+    }
+
+    const SkMatrix& fCTM;
+    OcclusionDraw fDraw;
+};
+
+// Tracks whether the clip may have antialiased edges. Draws under such a clip only partially
+// cover the pixels along its edges, so the draws under them can show through.
+class TrackSoftClip {
+public:
+    explicit TrackSoftClip(const SkMatrix& ctm) : fCTM(ctm) {}
+
+    template <typename T> void operator()(const T&) {}
+    void operator()(const Save&)       { fSaved.push_back(fSoft); }
+    void operator()(const SaveLayer&)  { fSaved.push_back(fSoft); }
+    void operator()(const SaveBehind&) { fSaved.push_back(fSoft); }
+    void operator()(const Restore&) {
+        if (!fSaved.empty()) {
+            fSoft = fSaved.back();
+            fSaved.pop_back();
+        }
+    }
+    void operator()(const ResetClip&)  { fSoft = false; }
+    void operator()(const ClipRect& op) {
+        fSoft |= op.opAA.aa() && !this->isPixelAligned(op.rect);
+    }
+    void operator()(const ClipRRect& op) { fSoft |= op.opAA.aa(); }
+    void operator()(const ClipPath& op)  { fSoft |= op.opAA.aa(); }
+    void operator()(const ClipShader&)   { fSoft = true; }
+
+    bool soft() const { return fSoft; }
+
+private:
+    bool isPixelAligned(const SkRect& rect) const {
+        if (!fCTM.rectStaysRect()) {
+            return false;
+        }
+        SkRect device = fCTM.mapRect(rect);
+        return device.isFinite() && device == SkRect::Make(device.round());
+    }
+
+    const SkMatrix& fCTM;
+    bool fSoft = false;
+    skia_private::STArray<16, bool> fSaved;
+};
+
+// Noops the draws of a run that starts at 'begin' that are hidden by later draws in the run.
+// Nothing changes the matrix or clip between them, so a draw that only touches pixels a later draw
+// overwrites never shows.
+void noop_occluded_draws(SkRecord* record, int begin, SkSpan<const OcclusionDraw> run) {
+    // Keeps the cost of the containment tests down on pictures with very long runs of draws.
+    static constexpr int kMaxOccluders = 8;
+
+    skia_private::STArray<kMaxOccluders, SkIRect> occluders;
+    for (int i = (int)run.size() - 1; i >= 0; --i) {
+        const OcclusionDraw& draw = run[i];
+        if (std::any_of(occluders.begin(), occluders.end(), [&](const SkIRect& occluder) {
+                return occluder.contains(draw.fDeviceBounds);
+            })) {
+            record->replace<NoOp>(begin + i);
+        } else if (!draw.fOpaqueBounds.isEmpty() && occluders.size() < kMaxOccluders) {
+            occluders.push_back(draw.fOpaqueBounds);
+        }
+    }
+}
+
+}  // namespace
+
+void SkRecordNoopOccludedDraws(SkRecord* record) {
+    TrackCTM ctmTracker;
+    TrackSoftClip clipTracker(ctmTracker.ctm());
+    std::vector<OcclusionDraw> run;
+    for (int i = 0; i < record->count(); ++i) {
+        GetOcclusionDraw get(ctmTracker.ctm());
+        if (!clipTracker.soft() && !ctmTracker.ctm().hasPerspective() && record->visit(i, get)) {
+            run.push_back(get.draw());
+            continue;
+        }
+        noop_occluded_draws(record, i - (int)run.size(), run);
+        run.clear();
+        record->visit(i, clipTracker);
+        record->visit(i, ctmTracker);
+    }
+    noop_occluded_draws(record, record->count() - (int)run.size(), run);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 void SkRecordOptimize(SkRecord* record) {
     // This might be useful  as a first pass in the future if we want to weed
     // out junk for other optimization passes.  Right now, nothing needs it,
@@ -284,5 +607,14 @@ void SkRecordOptimize(SkRecord* record) {
 #endif
     SkRecordMergeSvgOpacityAndFilterLayers(record);
 
+#if defined(SK_ENABLE_RECORD_OCCLUSION_CULLING)
+    SkRecordNoopOccludedDraws(record);
+#endif
+
     record->defrag();
+
+#if defined(SK_ENABLE_RECORD_DRAW_REORDERING)
+    // NoOps end runs of draws, so this goes after defrag().
+    SkRecordReorderDraws(record);
+#endif
 }
@@ -26,4 +26,19 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Within runs of rect, rrect, oval, image and text blob draws that aren't separated by any state
+// change, moves each draw up next to the last earlier draw of the same kind with the same paint
+// (and image), as long as it doesn't cross any draw it overlaps. This makes draws that backends
+// can batch adjacent. It is not part of SkRecordOptimize() unless SK_ENABLE_RECORD_DRAW_REORDERING
+// is defined.
+void SkRecordReorderDraws(SkRecord*);
+
+// Within runs of rect, rrect, oval, image, text blob and paint draws that aren't separated by any
+// state change, no-ops the draws whose pixels are all overwritten by later opaque rect or paint
+// draws. Runs under antialiased clips are left alone. The picture's own clips are checked, but not
+// the clip it is played back under: a picture played back under an antialiased clip can show the
+// dropped draws through the clip's edges. So this is not part of SkRecordOptimize() unless
+// SK_ENABLE_RECORD_OCCLUSION_CULLING is defined.
+void SkRecordNoopOccludedDraws(SkRecord*);
+
 #endif//SkRecordOpts_DEFINED
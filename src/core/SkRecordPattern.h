@@ -54,6 +54,7 @@ public:
         return true;
     }
 
+    // Draws without a paint, or with an interned one, which must not be modified.
     template <typename T>
     std::enable_if_t<(T::kTags & kDrawWithPaint_Tag) == kDraw_Tag, bool> operator()(T* draw) {
         fPaint = nullptr;
@@ -92,15 +93,18 @@ public:
 
     template <typename T>
     std::enable_if_t<(T::kTags & kDrawWithPaint_Tag) == kDraw_Tag &&
-                             !(T::kTags & kMultiDraw_Tag),
+                             !(T::kTags & (kMultiDraw_Tag | kInternedPaint_Tag)),
                      bool>
     operator()(T* draw) {
         fPaint = nullptr;
         return true;
     }
 
+    // Draws with interned paints don't match, since their paints can't be modified.
     template <typename T>
-    std::enable_if_t<!(T::kTags & kDraw_Tag) || (T::kTags & kMultiDraw_Tag), bool>
+    std::enable_if_t<!(T::kTags & kDraw_Tag) ||
+                             (T::kTags & (kMultiDraw_Tag | kInternedPaint_Tag)),
+                     bool>
     operator()(T* draw) {
         fPaint = nullptr;
         return false;
@@ -118,6 +118,28 @@ void SkRecorder::forgetRecord() {
     fRecord = nullptr;
 }
 
+int SkRecorder::appendPlaceholder() {
+    this->append<SkRecords::Save>();
+    const int index = fRecord->count();
+    this->append<SkRecords::NoOp>();
+    this->append<SkRecords::Restore>(this->getTotalMatrix());
+    return index;
+}
+
+int SkRecorder::appendDrawables(const SkDrawableList* drawables) {
+    if (!drawables || drawables->count() == 0) {
+        return 0;
+    }
+    if (!fDrawableList) {
+        fDrawableList = std::make_unique<SkDrawableList>();
+    }
+    const int offset = fDrawableList->count();
+    for (SkDrawable* drawable : *drawables) {
+        fDrawableList->append(drawable);
+    }
+    return offset;
+}
+
 // To make appending to fRecord a little less verbose.
 template<typename T, typename... Args>
 void SkRecorder::append(Args&&... args) {
@@ -186,6 +208,10 @@ void SkRecorder::onDrawPoints(PointMode mode,
 }
 
 void SkRecorder::onDrawRect(const SkRect& rect, const SkPaint& paint) {
+    if (fInternPaints) {
+        this->append<SkRecords::DrawRectInterned>(fRecord->internPaint(paint), rect);
+        return;
+    }
     this->append<SkRecords::DrawRect>(paint, rect);
 }
 
@@ -230,6 +256,12 @@ void SkRecorder::onDrawImage2(const SkImage* image, SkScalar x, SkScalar y,
 void SkRecorder::onDrawImageRect2(const SkImage* image, const SkRect& src, const SkRect& dst,
                                   const SkSamplingOptions& sampling, const SkPaint* paint,
                                   SrcRectConstraint constraint) {
+    if (fInternPaints && paint) {
+        this->append<SkRecords::DrawImageRectInterned>(fRecord->internPaint(*paint),
+                                                       sk_ref_sp(image), src, dst, sampling,
+                                                       constraint);
+        return;
+    }
     this->append<SkRecords::DrawImageRect>(this->copy(paint), sk_ref_sp(image), src, dst,
                                            sampling, constraint);
 }
@@ -247,6 +279,11 @@ void SkRecorder::onDrawImageLattice2(const SkImage* image, const Lattice& lattic
 
 void SkRecorder::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
                                 const SkPaint& paint) {
+    if (fInternPaints) {
+        this->append<SkRecords::DrawTextBlobInterned>(fRecord->internPaint(paint),
+                                                      sk_ref_sp(blob), x, y);
+        return;
+    }
     this->append<SkRecords::DrawTextBlob>(paint, sk_ref_sp(blob), x, y);
 }
 
@@ -90,6 +90,19 @@ public:
     // Make SkRecorder forget entirely about its SkRecord*; all calls to SkRecorder will fail.
     void forgetRecord();
 
+    // If set, DrawRect, DrawImageRect and DrawTextBlob ops are recorded in their compact forms,
+    // which point to paints interned by the SkRecord.
+    void setInternPaints(bool internPaints) { fInternPaints = internPaints; }
+    bool internPaints() const { return fInternPaints; }
+
+    // Appends Save, NoOp, Restore, and returns the index of the NoOp, which is later replaced by
+    // the ops of a sub-recording (see SkRecord::splice()).
+    int appendPlaceholder();
+
+    // Appends the drawables of a sub-recording to this recorder's drawable list, and returns the
+    // amount by which the indices of the sub-recording's DrawDrawable ops must be offset.
+    int appendDrawables(const SkDrawableList*);
+
     void willSave() override;
     SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
     bool onDoSaveBehind(const SkRect*) override;
@@ -171,6 +184,7 @@ private:
     size_t fApproxBytesUsedBySubPictures;
     SkRecord* fRecord;
     std::unique_ptr<SkDrawableList> fDrawableList;
+    bool fInternPaints = false;
 };
 
 #endif//SkRecorder_DEFINED
@@ -95,7 +95,10 @@ namespace SkRecords {
     M(DrawShadowRec)                                                \
     M(DrawAnnotation)                                               \
     M(DrawEdgeAAQuad)                                               \
-    M(DrawEdgeAAImageSet)
+    M(DrawEdgeAAImageSet)                                           \
+    M(DrawRectInterned)                                             \
+    M(DrawImageRectInterned)                                        \
+    M(DrawTextBlobInterned)
 
 
 // Defines SkRecords::Type, an enum of all record types.
@@ -162,6 +165,8 @@ enum Tags {
     kHasPaint_Tag  = 8,   // May have an SkPaint field, at least optionally.
     kMultiDraw_Tag = 16,  // Drawing operations that render multiple independent primitives.
                           //   These draws are capable of blending with themselves.
+    kInternedPaint_Tag = 32,  // Points to a paint interned by the SkRecord, which other ops
+                              //   share, so it must not be modified.
 
     kDrawWithPaint_Tag = kDraw_Tag | kHasPaint_Tag,
 };
@@ -364,6 +369,25 @@ RECORD(DrawEdgeAAImageSet, kDraw_Tag|kHasImage_Tag|kHasPaint_Tag|kMultiDraw_Tag,
        PODArray<SkMatrix> preViewMatrices;
        SkSamplingOptions sampling;
        SkCanvas::SrcRectConstraint constraint)
+
+// Compact forms of DrawRect, DrawImageRect (with a paint) and DrawTextBlob, which SkRecorder
+// appends instead when it interns paints (see SkRecord::internPaint()). They point to the
+// record's copy of their paint instead of holding their own.
+RECORD(DrawRectInterned, kDraw_Tag|kInternedPaint_Tag,
+       const SkPaint* paint;
+       SkRect rect)
+RECORD(DrawImageRectInterned, kDraw_Tag|kHasImage_Tag|kInternedPaint_Tag,
+       const SkPaint* paint;
+       sk_sp<const SkImage> image;
+       SkRect src;
+       SkRect dst;
+       SkSamplingOptions sampling;
+       SkCanvas::SrcRectConstraint constraint)
+RECORD(DrawTextBlobInterned, kDraw_Tag|kHasText_Tag|kInternedPaint_Tag,
+       const SkPaint* paint;
+       sk_sp<const SkTextBlob> blob;
+       SkScalar x;
+       SkScalar y)
 #undef RECORD
 
 }  // namespace SkRecords
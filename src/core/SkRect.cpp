@@ -78,7 +78,7 @@ bool SkRect::setBoundsCheck(const SkPoint pts[], int count) {
     }
 
     skvx::float4 accum = min * 0;
-    while (count) {
+    if (count & 2) {
         skvx::float4 xy = skvx::float4::Load(pts);
         accum = accum * xy;
         min = skvx::min(min, xy);
@@ -87,6 +87,24 @@ bool SkRect::setBoundsCheck(const SkPoint pts[], int count) {
         count -= 2;
     }
 
+    // The rest go 4 points at a time, in two independent chains.
+    skvx::float4 min1 = min, max1 = max, accum1 = accum;
+    while (count) {
+        skvx::float4 xy0 = skvx::float4::Load(pts),
+                     xy1 = skvx::float4::Load(pts + 2);
+        accum  = accum  * xy0;
+        accum1 = accum1 * xy1;
+        min  = skvx::min(min,  xy0);
+        min1 = skvx::min(min1, xy1);
+        max  = skvx::max(max,  xy0);
+        max1 = skvx::max(max1, xy1);
+        pts   += 4;
+        count -= 4;
+    }
+    min = skvx::min(min, min1);
+    max = skvx::max(max, max1);
+    accum = accum * accum1;
+
     const bool all_finite = all(accum * 0 == 0);
     if (all_finite) {
         this->setLTRB(std::min(min[0], min[2]), std::min(min[1], min[3]),
@@ -10,10 +10,12 @@
 #include "include/private/base/SkMacros.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkMath.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkBuffer.h"
 #include "src/base/SkSafeMath.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkRegionPriv.h"
 
 #include <algorithm>
@@ -655,15 +657,83 @@ void SkRegion::translate(int dx, int dy, SkRegion* dst) const {
 ///////////////////////////////////////////////////////////////////////////////
 
 bool SkRegion::setRects(const SkIRect rects[], int count) {
-    if (0 == count) {
-        this->setEmpty();
-    } else {
-        this->setRect(rects[0]);
-        for (int i = 1; i < count; i++) {
-            this->op(rects[i], kUnion_Op);
+    // Sort the rects by their top edge, and sweep the scanlines between consecutive y edges,
+    // keeping the rects that cover the current scanline sorted by their left edge. Each scanline's
+    // intervals then come out of a single pass over those rects, instead of one op() per rect.
+    TArray<const SkIRect*> sorted;
+    TArray<RunType> ys;
+    sorted.reserve_exact(count);
+    ys.reserve_exact(2 * count);
+    for (int i = 0; i < count; ++i) {
+        const SkIRect& r = rects[i];
+        // Skip the same rects that setRect() would make empty.
+        if (!r.isEmpty() &&
+            SkRegion_kRunTypeSentinel != r.right() &&
+            SkRegion_kRunTypeSentinel != r.bottom()) {
+            sorted.push_back(&r);
+            ys.push_back(r.fTop);
+            ys.push_back(r.fBottom);
         }
     }
-    return !this->isEmpty();
+    if (sorted.size() <= 1) {
+        return sorted.empty() ? this->setEmpty() : this->setRect(*sorted[0]);
+    }
+
+    auto byTop = [](const SkIRect* a, const SkIRect* b) { return a->fTop < b->fTop; };
+    auto byLeft = [](const SkIRect* a, const SkIRect* b) { return a->fLeft < b->fLeft; };
+    std::sort(sorted.begin(), sorted.end(), byTop);
+    std::sort(ys.begin(), ys.end());
+    ys.resize_back(std::unique(ys.begin(), ys.end()) - ys.begin());
+
+    TArray<const SkIRect*> active;
+    TArray<RunType> runs;
+    runs.push_back(ys[0]);   // top
+    int prevSpan = -1;       // index of the previous scanline's bottom
+    int nextRect = 0;
+    for (int y = 0; y + 1 < ys.size(); ++y) {
+        const RunType top = ys[y];
+        const RunType bottom = ys[y + 1];
+
+        // Drop the rects that ended above this scanline, and merge in the ones that start on it.
+        active.resize_back(std::remove_if(active.begin(), active.end(),
+                                          [top](const SkIRect* r) { return r->fBottom <= top; }) -
+                           active.begin());
+        const int oldActive = active.size();
+        while (nextRect < sorted.size() && sorted[nextRect]->fTop == top) {
+            active.push_back(sorted[nextRect++]);
+        }
+        if (active.size() > oldActive) {
+            std::sort(active.begin() + oldActive, active.end(), byLeft);
+            std::inplace_merge(active.begin(), active.begin() + oldActive, active.end(), byLeft);
+        }
+
+        const int span = runs.size();
+        runs.push_back(bottom);
+        runs.push_back(0);   // interval count
+        for (const SkIRect* r : active) {
+            if (runs.size() > span + 2 && r->fLeft <= runs.back()) {
+                runs.back() = std::max(runs.back(), r->fRight);
+            } else {
+                runs.push_back(r->fLeft);
+                runs.push_back(r->fRight);
+            }
+        }
+        runs.push_back(SkRegion_kRunTypeSentinel);
+        const int len = runs.size() - span - 1;   // interval count, intervals and sentinel
+        runs[span + 1] = (len - 2) >> 1;
+
+        if (prevSpan >= 0 && span - prevSpan == runs.size() - span &&
+            !memcmp(&runs[prevSpan + 1], &runs[span + 1], len * sizeof(RunType))) {
+            // Same intervals as the scanline above, so just extend it.
+            runs[prevSpan] = bottom;
+            runs.resize_back(span);
+        } else {
+            prevSpan = span;
+        }
+    }
+    runs.push_back(SkRegion_kRunTypeSentinel);
+
+    return this->setRuns(runs.data(), runs.size());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -773,42 +843,127 @@ struct spanRec {
     }
 };
 
-static int distance_to_sentinel(const SkRegionPriv::RunType* runs) {
-    const SkRegionPriv::RunType* ptr = runs;
-    while (*ptr != SkRegion_kRunTypeSentinel) { ptr += 2; }
-    return ptr - runs;
+using RunType = SkRegionPriv::RunType;
+
+// A scanline's lefts and rights form one increasing sequence, so the number of them that are less
+// than x tells where x falls: 2k means it is in the gap before interval k, and 2k+1 means it is
+// inside interval k. Damage regions can have long scanlines, so compare 8 values at a time.
+static int count_values_below(const RunType runs[], int count, int x) {
+    int n = 0;
+    for (; n + 8 <= count; n += 8) {
+        if (!skvx::all(skvx::int8::Load(runs + n) < x)) {
+            break;
+        }
+    }
+    while (n < count && runs[n] < x) {
+        n += 1;
+    }
+    return n;
+}
+
+static RunType* copy_values(const RunType src[], int count, RunType* dst) {
+    memcpy(dst, src, count * sizeof(RunType));
+    return dst + count;
+}
+
+// The intervals of 'runs' minus [left, rite).
+static RunType* difference_with_interval(const RunType runs[], int count,
+                                         int left, int rite, RunType* dst) {
+    const int lo = count_values_below(runs, count, left + 1);
+    dst = copy_values(runs, lo & ~1, dst);
+    if ((lo & 1) && runs[lo - 1] < left) {
+        *dst++ = runs[lo - 1];
+        *dst++ = left;
+    }
+    const int hi = lo + count_values_below(runs + lo, count - lo, rite + 1);
+    if (hi & 1) {
+        *dst++ = rite;
+        *dst++ = runs[hi];
+    }
+    return copy_values(runs + hi + (hi & 1), count - hi - (hi & 1), dst);
+}
+
+// The intervals of 'runs' intersected with [left, rite).
+static RunType* intersect_with_interval(const RunType runs[], int count,
+                                        int left, int rite, RunType* dst) {
+    const int lo = count_values_below(runs, count, left + 1) & ~1;
+    const int hi = lo + count_values_below(runs + lo, count - lo, rite);
+    for (int i = lo; i < hi; i += 2) {
+        *dst++ = std::max<int>(runs[i], left);
+        *dst++ = std::min<int>(runs[i + 1], rite);
+    }
+    return dst;
+}
+
+// The intervals of 'runs' unioned with [left, rite), merging the ones that touch it.
+static RunType* union_with_interval(const RunType runs[], int count,
+                                    int left, int rite, RunType* dst) {
+    const int lo = count_values_below(runs, count, left);
+    dst = copy_values(runs, lo & ~1, dst);
+    *dst++ = (lo & 1) ? runs[lo - 1] : left;
+    const int hi = lo + count_values_below(runs + lo, count - lo, rite + 1);
+    *dst++ = (hi & 1) ? runs[hi] : rite;
+    return copy_values(runs + hi + (hi & 1), count - hi - (hi & 1), dst);
 }
 
 static int operate_on_span(const SkRegionPriv::RunType a_runs[],
                            const SkRegionPriv::RunType b_runs[],
                            RunArray* array, int dstOffset,
                            int min, int max) {
+    // The runs start right after their scanline's interval count.
+    const int a_count = a_runs[-1] * 2;
+    const int b_count = b_runs[-1] * 2;
+
     // This is a worst-case for this span plus two for TWO terminating sentinels.
-    array->resizeToAtLeast(
-            dstOffset + distance_to_sentinel(a_runs) + distance_to_sentinel(b_runs) + 2);
+    array->resizeToAtLeast(dstOffset + a_count + b_count + 2);
     SkRegionPriv::RunType* dst = &(*array)[dstOffset]; // get pointer AFTER resizing.
 
-    spanRec rec;
-    bool    firstInterval = true;
-
-    rec.init(a_runs, b_runs);
-
-    while (!rec.done()) {
-        rec.next();
-
-        int left = rec.fLeft;
-        int rite = rec.fRite;
-
-        // add left,rite to our dst buffer (checking for coincidence
-        if ((unsigned)(rec.fInside - min) <= (unsigned)(max - min) &&
-                left < rite) {    // skip if equal
-            if (firstInterval || *(dst - 1) < left) {
-                *dst++ = (SkRegionPriv::RunType)(left);
-                *dst++ = (SkRegionPriv::RunType)(rite);
-                firstInterval = false;
-            } else {
-                // update the right edge
-                *(dst - 1) = (SkRegionPriv::RunType)(rite);
+    // Handle the scanlines where one side is empty or a single interval (e.g. ops with a rect, or
+    // between regions built from many rects) directly; the intervals are already sorted and
+    // separated, so most of them can be copied without walking them one edge at a time.
+    const bool keepA = (unsigned)(1 - min) <= (unsigned)(max - min);
+    const bool keepB = (unsigned)(2 - min) <= (unsigned)(max - min);
+    const bool keepBoth = (unsigned)(3 - min) <= (unsigned)(max - min);
+    if (0 == a_count || 0 == b_count) {
+        if (0 == b_count && keepA) {
+            dst = copy_values(a_runs, a_count, dst);
+        } else if (0 == a_count && keepB) {
+            dst = copy_values(b_runs, b_count, dst);
+        }
+    } else if (2 == b_count && keepA && !keepB) {
+        dst = keepBoth ? union_with_interval(a_runs, a_count, b_runs[0], b_runs[1], dst)
+                       : difference_with_interval(a_runs, a_count, b_runs[0], b_runs[1], dst);
+    } else if ((2 == a_count || 2 == b_count) && keepA == keepB && keepBoth) {
+        // Union and intersection don't depend on the order of their operands.
+        const bool aIsInterval = 2 == a_count;
+        const RunType* runs = aIsInterval ? b_runs : a_runs;
+        const RunType* interval = aIsInterval ? a_runs : b_runs;
+        const int count = aIsInterval ? b_count : a_count;
+        dst = keepA ? union_with_interval(runs, count, interval[0], interval[1], dst)
+                    : intersect_with_interval(runs, count, interval[0], interval[1], dst);
+    } else {
+        spanRec rec;
+        bool    firstInterval = true;
+
+        rec.init(a_runs, b_runs);
+
+        while (!rec.done()) {
+            rec.next();
+
+            int left = rec.fLeft;
+            int rite = rec.fRite;
+
+            // add left,rite to our dst buffer (checking for coincidence
+            if ((unsigned)(rec.fInside - min) <= (unsigned)(max - min) &&
+                    left < rite) {    // skip if equal
+                if (firstInterval || *(dst - 1) < left) {
+                    *dst++ = (SkRegionPriv::RunType)(left);
+                    *dst++ = (SkRegionPriv::RunType)(rite);
+                    firstInterval = false;
+                } else {
+                    // update the right edge
+                    *(dst - 1) = (SkRegionPriv::RunType)(rite);
+                }
             }
         }
     }
@@ -17,8 +17,10 @@
 #include "include/private/base/SkMath.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkThreadAnnotations.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkCachedData.h"
+#include "src/core/SkCounters.h"
 #include "src/core/SkChecksum.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkMessageBus.h"
@@ -29,6 +31,9 @@
 #endif
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 
 using namespace skia_private;
 
@@ -133,12 +138,15 @@ bool SkResourceCache::find(const Key& key, FindVisitor visitor, void* context) {
         Rec* rec = *found;
         if (visitor(*rec, context)) {
             this->moveToHead(rec);  // for our LRU
+            SkCount(SkCounter::kResourceCacheHits);
             return true;
         } else {
             this->remove(rec);  // stale
+            SkCount(SkCounter::kResourceCacheMisses);
             return false;
         }
     }
+    SkCount(SkCounter::kResourceCacheMisses);
     return false;
 }
 
@@ -224,9 +232,17 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
         byteLimit = fTotalByteLimit;
     }
 
+    if (forcePurge) {
+        byteLimit = 0;
+        countLimit = 0;
+    }
+    this->purgeToLimits(byteLimit, countLimit);
+}
+
+void SkResourceCache::purgeToLimits(size_t byteLimit, int countLimit) {
     Rec* rec = fTail;
     while (rec) {
-        if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
+        if (fTotalBytesUsed < byteLimit && fCount < countLimit) {
             break;
         }
 
@@ -463,94 +479,229 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static SkResourceCache* gResourceCache = nullptr;
-static SkMutex& resource_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex);
-    return mutex;
-}
+// The global cache is split into stripes by key hash. Each stripe is an SkResourceCache with its
+// own mutex, so threads looking up unrelated keys do not contend. The stripes are not budgeted on
+// their own: the byte limit (or the count limit, with discardable memory) applies to all of them
+// together, and is enforced by purge_stripes_as_needed().
+namespace {
+constexpr int kStripeBits = 3;
+constexpr int kStripeCount = 1 << kStripeBits;
+
+struct Stripe {
+    SkMutex          fMutex;
+    SkResourceCache* fCache SK_GUARDED_BY(fMutex);
 
-/** Must hold resource_cache_mutex() when calling. */
-static SkResourceCache* get_cache() {
-    // resource_cache_mutex() is always held when this is called, so we don't need to be fancy in here.
-    resource_cache_mutex().assertHeld();
-    if (nullptr == gResourceCache) {
+    // Copies of fCache's totals, readable without fMutex.
+    std::atomic<size_t> fBytesUsed{0};
+    std::atomic<int>    fCount{0};
+
+    void updateTotals() SK_REQUIRES(fMutex) {
+        fBytesUsed.store(fCache->getTotalBytesUsed(), std::memory_order_relaxed);
+        fCount.store(fCache->getCount(), std::memory_order_relaxed);
+    }
+};
+
+struct GlobalResourceCache {
+    GlobalResourceCache() {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+        fDiscardableFactory = SkDiscardableMemory::Create;
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        fTotalByteLimit = SK_DEFAULT_IMAGE_CACHE_LIMIT;
 #endif
+        for (Stripe& stripe : fStripes) {
+            SkAutoMutexExclusive am(stripe.fMutex);
+            stripe.fCache = fDiscardableFactory ? new SkResourceCache(fDiscardableFactory)
+                                                : new SkResourceCache(SIZE_MAX);
+        }
+    }
+
+    Stripe& stripeFor(const SkResourceCache::Key& key) {
+        // THashTable indexes by the low bits of the hash, so pick the stripe by the high bits.
+        return fStripes[key.hash() >> (32 - kStripeBits)];
+    }
+
+    size_t totalBytesUsed() const {
+        size_t total = 0;
+        for (const Stripe& stripe : fStripes) {
+            total += stripe.fBytesUsed.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    int totalCount() const {
+        int total = 0;
+        for (const Stripe& stripe : fStripes) {
+            total += stripe.fCount.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    std::array<Stripe, kStripeCount>    fStripes;
+    SkResourceCache::DiscardableFactory fDiscardableFactory = nullptr;
+    std::atomic<size_t>                 fTotalByteLimit{0};
+    std::atomic<size_t>                 fSingleAllocationByteLimit{0};
+    std::atomic<uint32_t>               fNextPurgeStripe{0};
+};
+}  // namespace
+
+static GlobalResourceCache& global_cache() {
+    static GlobalResourceCache* cache = new GlobalResourceCache;
+    return *cache;
+}
+
+// Must be called with no stripe mutex held.
+static void purge_stripes_as_needed(GlobalResourceCache& global) {
+    size_t byteLimit;
+    int    countLimit;
+
+    if (global.fDiscardableFactory) {
+        countLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
+        byteLimit = UINT32_MAX;  // no limit based on bytes
+    } else {
+        countLimit = SK_MaxS32; // no limit based on count
+        byteLimit = global.fTotalByteLimit;
+    }
+
+    // Each purge starts one stripe further along than the last, so that every stripe gives up
+    // its least recently used Recs in turn.
+    const uint32_t first = global.fNextPurgeStripe.fetch_add(1, std::memory_order_relaxed);
+    for (int i = 0; i < kStripeCount; ++i) {
+        const size_t bytesUsed = global.totalBytesUsed();
+        const int    count     = global.totalCount();
+        if (bytesUsed < byteLimit && count < countLimit) {
+            return;
+        }
+
+        Stripe& stripe = global.fStripes[(first + i) % kStripeCount];
+        SkAutoMutexExclusive am(stripe.fMutex);
+        const size_t stripeBytes = stripe.fCache->getTotalBytesUsed();
+        const int    stripeCount = stripe.fCache->getCount();
+
+        // Ask this stripe to shed just enough to bring the whole cache under its limits.
+        size_t stripeByteLimit = SIZE_MAX;
+        if (bytesUsed >= byteLimit) {
+            const size_t excess = bytesUsed - byteLimit + 1;
+            stripeByteLimit = stripeBytes >= excess ? stripeBytes - excess + 1 : 0;
+        }
+        int stripeCountLimit = SK_MaxS32;
+        if (count >= countLimit) {
+            const int excess = count - countLimit + 1;
+            stripeCountLimit = stripeCount >= excess ? stripeCount - excess + 1 : 0;
+        }
+        stripe.fCache->purgeToLimits(stripeByteLimit, stripeCountLimit);
+        stripe.updateTotals();
     }
-    return gResourceCache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalBytesUsed();
+    return global_cache().totalBytesUsed();
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getTotalByteLimit();
+    return global_cache().fTotalByteLimit;
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setTotalByteLimit(newLimit);
+    GlobalResourceCache& global = global_cache();
+    size_t prevLimit = global.fTotalByteLimit.exchange(newLimit);
+    if (newLimit < prevLimit) {
+        purge_stripes_as_needed(global);
+    }
+    return prevLimit;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->discardableFactory();
+    return global_cache().fDiscardableFactory;
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->newCachedData(bytes);
+    // This only allocates, so there is no stripe to lock. Pending purge messages are picked up by
+    // each stripe on its next find() or add().
+    if (DiscardableFactory factory = global_cache().fDiscardableFactory) {
+        SkDiscardableMemory* dm = factory(bytes);
+        return dm ? new SkCachedData(bytes, dm) : nullptr;
+    }
+    return new SkCachedData(sk_malloc_throw(bytes), bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->dump();
+    GlobalResourceCache& global = global_cache();
+    for (Stripe& stripe : global.fStripes) {
+        SkAutoMutexExclusive am(stripe.fMutex);
+        stripe.fCache->dump();
+    }
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->setSingleAllocationByteLimit(size);
+    return global_cache().fSingleAllocationByteLimit.exchange(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getSingleAllocationByteLimit();
+    return global_cache().fSingleAllocationByteLimit;
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    GlobalResourceCache& global = global_cache();
+
+    // fSingleAllocationByteLimit == 0 means the caller is asking for our default
+    size_t limit = global.fSingleAllocationByteLimit;
+
+    // if we're not discardable (i.e. we are fixed-budget) then cap the single-limit
+    // to our budget.
+    if (nullptr == global.fDiscardableFactory) {
+        if (0 == limit) {
+            limit = global.fTotalByteLimit;
+        } else {
+            limit = std::min<size_t>(limit, global.fTotalByteLimit);
+        }
+    }
+    return limit;
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->purgeAll();
+    GlobalResourceCache& global = global_cache();
+    for (Stripe& stripe : global.fStripes) {
+        SkAutoMutexExclusive am(stripe.fMutex);
+        stripe.fCache->purgeAll();
+        stripe.updateTotals();
+    }
 }
 
 void SkResourceCache::CheckMessages() {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->checkMessages();
+    GlobalResourceCache& global = global_cache();
+    for (Stripe& stripe : global.fStripes) {
+        SkAutoMutexExclusive am(stripe.fMutex);
+        stripe.fCache->checkMessages();
+        stripe.updateTotals();
+    }
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    return get_cache()->find(key, visitor, context);
+    Stripe& stripe = global_cache().stripeFor(key);
+    SkAutoMutexExclusive am(stripe.fMutex);
+    bool found = stripe.fCache->find(key, visitor, context);
+    stripe.updateTotals();
+    return found;
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->add(rec, payload);
+    GlobalResourceCache& global = global_cache();
+    {
+        Stripe& stripe = global.stripeFor(rec->getKey());
+        SkAutoMutexExclusive am(stripe.fMutex);
+        stripe.fCache->add(rec, payload);
+        stripe.updateTotals();
+    }
+    // since the new rec may push us over-budget, we perform a purge check now
+    purge_stripes_as_needed(global);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexExclusive am(resource_cache_mutex());
-    get_cache()->visitAll(visitor, context);
+    GlobalResourceCache& global = global_cache();
+    for (Stripe& stripe : global.fStripes) {
+        SkAutoMutexExclusive am(stripe.fMutex);
+        stripe.fCache->visitAll(visitor, context);
+    }
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
@@ -224,6 +224,7 @@ public:
 
     size_t getTotalBytesUsed() const { return fTotalBytesUsed; }
     size_t getTotalByteLimit() const { return fTotalByteLimit; }
+    int getCount() const { return fCount; }
 
     /**
      *  This is respected by SkBitmapProcState::possiblyScaleImage.
@@ -249,6 +250,13 @@ public:
         this->purgeAsNeeded(true);
     }
 
+    /**
+     *  Purge Recs, least recently used first, until fewer than byteLimit bytes and fewer than
+     *  countLimit Recs remain (or nothing left can be purged). This ignores the cache's own
+     *  budget, and is meant for callers that budget several caches together.
+     */
+    void purgeToLimits(size_t byteLimit, int countLimit);
+
     DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
 
     SkCachedData* newCachedData(size_t bytes);
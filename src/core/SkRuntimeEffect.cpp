@@ -222,11 +222,13 @@ const SkSL::RP::Program* SkRuntimeEffect::getRPProgram(SkSL::DebugTracePriv* deb
         // We generally do not run the inliner when an SkRuntimeEffect program is initially created,
         // because the final compile to native shader code will do this. However, in SkRP, there's
         // no additional compilation occurring, so we need to manually inline here if we want the
-        // performance boost of inlining.
+        // performance boost of inlining. Inlining tends to leave repeated expressions behind, and
+        // nothing will share them or move them out of loops for us, so we do that here as well.
         if (!(fFlags & kDisableOptimization_Flag)) {
             SkSL::Compiler compiler;
             fBaseProgram->fConfig->fSettings.fInlineThreshold = SkSL::kDefaultInlineThreshold;
             compiler.runInliner(*fBaseProgram);
+            compiler.runRasterPipelineOptimizations(*fBaseProgram);
         }
 
         SkSL::DebugTracePriv tempDebugTrace;
@@ -464,9 +466,121 @@ SkSL::ProgramSettings SkRuntimeEffect::MakeSettings(const Options& options) {
 // in the IR generator would provide better errors messages (with locations).
 #define RETURN_FAILURE(...) return Result{nullptr, SkStringPrintf(__VA_ARGS__)}
 
+namespace {
+
+// Everything that goes into compiling an effect from source.
+struct EffectCacheKey {
+    EffectCacheKey(const SkString& sksl,
+                   SkSL::ProgramKind kind,
+                   bool forceUnoptimized,
+                   bool allowPrivateAccess,
+                   uint32_t stableKey,
+                   SkSL::Version maxVersionAllowed)
+            : fSkSL(sksl)
+            , fKind(kind)
+            , fForceUnoptimized(forceUnoptimized)
+            , fAllowPrivateAccess(allowPrivateAccess)
+            , fStableKey(stableKey)
+            , fMaxVersionAllowed(maxVersionAllowed) {
+        fHash = SkChecksum::Hash32(sksl.c_str(), sksl.size());
+        uint32_t bits[] = {(uint32_t)fKind,
+                           (uint32_t)fForceUnoptimized,
+                           (uint32_t)fAllowPrivateAccess,
+                           fStableKey,
+                           (uint32_t)fMaxVersionAllowed};
+        fHash = SkChecksum::Hash32(bits, sizeof(bits), fHash);
+    }
+
+    bool operator==(const EffectCacheKey& that) const {
+        return fHash == that.fHash &&
+               fKind == that.fKind &&
+               fForceUnoptimized == that.fForceUnoptimized &&
+               fAllowPrivateAccess == that.fAllowPrivateAccess &&
+               fStableKey == that.fStableKey &&
+               fMaxVersionAllowed == that.fMaxVersionAllowed &&
+               fSkSL == that.fSkSL;
+    }
+
+    struct Hash {
+        uint32_t operator()(const EffectCacheKey& key) const { return key.fHash; }
+    };
+
+    SkString fSkSL;
+    SkSL::ProgramKind fKind;
+    bool fForceUnoptimized;
+    bool fAllowPrivateAccess;
+    uint32_t fStableKey;
+    SkSL::Version fMaxVersionAllowed;
+    uint32_t fHash;
+};
+
+// Skia's own effects are few, but clients may create hundreds of them.
+static constexpr int kDefaultEffectCacheCountLimit = 256;
+
+using EffectCache = SkLRUCache<EffectCacheKey, sk_sp<SkRuntimeEffect>, EffectCacheKey::Hash>;
+
+static SkMutex& effect_cache_mutex() {
+    static SkNoDestructor<SkMutex> mutex;
+    return *mutex;
+}
+
+// Must be called with effect_cache_mutex() held.
+static EffectCache& effect_cache() {
+    static SkNoDestructor<EffectCache> cache(kDefaultEffectCacheCountLimit);
+    return *cache;
+}
+
+}  // namespace
+
+int SkRuntimeEffectPriv::GetCacheCountLimit() {
+    SkAutoMutexExclusive _(effect_cache_mutex());
+    return effect_cache().maxCount();
+}
+
+int SkRuntimeEffectPriv::SetCacheCountLimit(int count) {
+    SkAutoMutexExclusive _(effect_cache_mutex());
+    const int prev = effect_cache().maxCount();
+    effect_cache().setMaxCount(std::max(count, 0));
+    return prev;
+}
+
+int SkRuntimeEffectPriv::GetCacheCountUsed() {
+    SkAutoMutexExclusive _(effect_cache_mutex());
+    return effect_cache().count();
+}
+
+void SkRuntimeEffectPriv::PurgeCache() {
+    SkAutoMutexExclusive _(effect_cache_mutex());
+    effect_cache().reset();
+}
+
 SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
                                                         const Options& options,
                                                         SkSL::ProgramKind kind) {
+    // Effects are immutable, so one compiled from the same SkSL with the same options can be
+    // shared. Only successful compiles are cached; errors are rare and cheap to reproduce.
+    EffectCacheKey key(sksl, kind, options.forceUnoptimized, options.allowPrivateAccess,
+                       options.fStableKey, options.maxVersionAllowed);
+    {
+        SkAutoMutexExclusive _(effect_cache_mutex());
+        if (sk_sp<SkRuntimeEffect>* found = effect_cache().find(key)) {
+            return Result{*found, SkString()};
+        }
+    }
+
+    Result result = CompileFromSource(std::move(sksl), options, kind);
+    if (result.effect) {
+        SkAutoMutexExclusive _(effect_cache_mutex());
+        if (effect_cache().maxCount() > 0) {
+            effect_cache().insert_or_update(key, result.effect);
+        }
+    }
+    return result;
+}
+
+SkRuntimeEffect::Result SkRuntimeEffect::CompileFromSource(SkString sksl,
+                                                           const Options& options,
+                                                           SkSL::ProgramKind kind) {
     SkSL::Compiler compiler;
     SkSL::ProgramSettings settings = MakeSettings(options);
     std::unique_ptr<SkSL::Program> program =
@@ -680,31 +794,16 @@ SkRuntimeEffect::Result SkRuntimeEffect::MakeForBlender(SkString sksl, const Opt
 sk_sp<SkRuntimeEffect> SkMakeCachedRuntimeEffect(
         SkRuntimeEffect::Result (*make)(SkString sksl, const SkRuntimeEffect::Options&),
         SkString sksl) {
-    static SkNoDestructor<SkMutex> mutex;
-    static SkNoDestructor<SkLRUCache<uint64_t, sk_sp<SkRuntimeEffect>>> cache(11 /*arbitrary*/);
-
-    uint64_t key = SkChecksum::Hash64(sksl.c_str(), sksl.size());
-    {
-        SkAutoMutexExclusive _(*mutex);
-        if (sk_sp<SkRuntimeEffect>* found = cache->find(key)) {
-            return *found;
-        }
-    }
-
     SkRuntimeEffect::Options options;
     SkRuntimeEffectPriv::AllowPrivateAccess(&options);
 
+    // The effect cache lives in MakeFromSource, which every `make` goes through.
     auto [effect, err] = make(std::move(sksl), options);
     if (!effect) {
         SkDEBUGFAILF("%s", err.c_str());
         return nullptr;
     }
     SkASSERT(err.isEmpty());
-
-    {
-        SkAutoMutexExclusive _(*mutex);
-        cache->insert_or_update(key, effect);
-    }
     return effect;
 }
 
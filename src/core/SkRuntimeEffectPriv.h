@@ -100,6 +100,12 @@ public:
         options->fStableKey = stableKey;
     }
 
+    // The process-wide cache of effects compiled from SkSL (see SkGraphics).
+    static int GetCacheCountLimit();
+    static int SetCacheCountLimit(int count);
+    static int GetCacheCountUsed();
+    static void PurgeCache();
+
     static SkRuntimeEffect::Uniform VarAsUniform(const SkSL::Variable&,
                                                  const SkSL::Context&,
                                                  size_t* offset);
@@ -134,13 +140,9 @@ public:
                                   SkSpan<const SkRuntimeEffect::ChildPtr> children);
 };
 
-// These internal APIs for creating runtime effects vary from the public API in two ways:
-//
-//     1) they're used in contexts where it's not useful to receive an error message;
-//     2) they're cached.
-//
-// Users of the public SkRuntimeEffect::Make*() can of course cache however they like themselves;
-// keeping these APIs private means users will not be forced into our cache or cache policy.
+// These internal APIs for creating runtime effects vary from the public API in that they're used
+// in contexts where it's not useful to receive an error message. Like the public
+// SkRuntimeEffect::Make*(), they go through the effect cache that SkGraphics controls.
 
 sk_sp<SkRuntimeEffect> SkMakeCachedRuntimeEffect(
         SkRuntimeEffect::Result (*make)(SkString sksl, const SkRuntimeEffect::Options&),
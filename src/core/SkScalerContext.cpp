@@ -30,7 +30,9 @@
 #include "src/base/SkAutoMalloc.h"
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkBlitter_A8.h"
+#include "src/core/SkCounters.h"
 #include "src/core/SkDescriptor.h"
+#include "src/core/SkDistanceFieldGen.h"
 #include "src/core/SkDrawBase.h"
 #include "src/core/SkFontPriv.h"
 #include "src/core/SkGlyph.h"
@@ -585,6 +587,7 @@ void SkScalerContext::GenerateImageFromPath(
 
 void SkScalerContext::getImage(const SkGlyph& origGlyph) {
     SkASSERT(origGlyph.fAdvancesBoundsFormatAndInitialPathDone);
+    SkCount(SkCounter::kGlyphImagesRasterized);
 
     const SkGlyph* unfilteredGlyph = &origGlyph;
     // in case we need to call generateImage on a mask-format that is different
@@ -608,6 +611,25 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
             tmpGlyph.fImage = tmpGlyphImageStorage.get();
         }
         unfilteredGlyph = &tmpGlyph;
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+        // Multi-channel distance fields come from the outline instead of from a mask, because
+        // the mask has already lost the outline's corners.
+        if (origGlyph.fMaskFormat == SkMask::kMSDF_Format) {
+            if (!tmpGlyph.setPathHasBeenCalled()) {
+                this->internalGetPath(tmpGlyph, &tmpGlyphPathDataStorage);
+            }
+            if (const SkPath* devPath = tmpGlyph.path(); devPath && !tmpGlyph.pathIsHairline()) {
+                SkPath texelPath;
+                devPath->offset(-origGlyph.fLeft, -origGlyph.fTop, &texelPath);
+                if (SkGenerateMultiChannelDistanceFieldFromPath(
+                            static_cast<uint32_t*>(origGlyph.fImage), texelPath,
+                            origGlyph.width(), origGlyph.height(), origGlyph.rowBytes())) {
+                    return;
+                }
+            }
+        }
+#endif
     }
 
     if (!fGenerateImageFromPath) {
@@ -669,6 +691,9 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
                                               origGlyph.maskFormat());
         SkIRect origBounds = dstMask.fBounds;
 
+        // Multi-channel distance fields are the only 32-bit masks which are filtered.
+        const int bytesPerPixel = SkMask::kMSDF_Format == srcMask.fFormat ? 4 : 1;
+
         // Find the intersection of src and dst while updating the fImages.
         if (srcMask.fBounds.fTop < dstMask.fBounds.fTop) {
             int32_t topDiff = dstMask.fBounds.fTop - srcMask.fBounds.fTop;
@@ -683,12 +708,12 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
 
         if (srcMask.fBounds.fLeft < dstMask.fBounds.fLeft) {
             int32_t leftDiff = dstMask.fBounds.fLeft - srcMask.fBounds.fLeft;
-            srcMask.image() += leftDiff;
+            srcMask.image() += leftDiff * bytesPerPixel;
             srcMask.bounds().fLeft = dstMask.fBounds.fLeft;
         }
         if (dstMask.fBounds.fLeft < srcMask.fBounds.fLeft) {
             int32_t leftDiff = srcMask.fBounds.fLeft - dstMask.fBounds.fLeft;
-            dstMask.image() += leftDiff;
+            dstMask.image() += leftDiff * bytesPerPixel;
             dstMask.bounds().fLeft = srcMask.fBounds.fLeft;
         }
 
@@ -707,7 +732,7 @@ void SkScalerContext::getImage(const SkGlyph& origGlyph) {
         }
 
         SkASSERT(srcMask.fBounds == dstMask.fBounds);
-        int width = srcMask.fBounds.width();
+        int width = srcMask.fBounds.width() * bytesPerPixel;
         int height = srcMask.fBounds.height();
         int dstRB = dstMask.fRowBytes;
         int srcRB = srcMask.fRowBytes;
@@ -764,6 +789,7 @@ void SkScalerContext::internalGetPath(SkGlyph& glyph, SkArenaAlloc* alloc) {
     bool hairline = false;
 
     SkPackedGlyphID glyphID = glyph.getPackedID();
+    SkCount(SkCounter::kGlyphPathsGenerated);
     if (!generatePath(glyph, &path)) {
         glyph.setPath(alloc, (SkPath*)nullptr, hairline);
         return;
@@ -15,6 +15,7 @@
 
 class SkBlitter;
 class SkPath;
+class SkRRect;
 class SkRasterClip;
 class SkRegion;
 
@@ -50,6 +51,10 @@ public:
     static void FillRect(const SkRect&, const SkRasterClip&, SkBlitter*);
     static void AntiFillRect(const SkRect&, const SkRasterClip&, SkBlitter*);
     static void AntiFillXRect(const SkXRect&, const SkRasterClip&, SkBlitter*);
+    // Ovals and simple rrects with radii of at least a pixel are filled analytically. The rrect
+    // must already be in device space.
+    static bool CanAntiFillRRect(const SkRRect&);
+    static void AntiFillRRect(const SkRRect&, const SkRasterClip&, SkBlitter*);
     static void FillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void FrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -71,6 +76,16 @@ public:
     // Needed by SkRegion::setPath
     static void FillPath(const SkPath&, const SkRegion& clip, SkBlitter*);
 
+    // The analytic scan converters behind AntiFillPath, public so tests and benches can pick one
+    // per call. pathIR is the rounded-out path bounds and nothing outside clipBounds is blitted;
+    // for inverse fills the caller blits the area outside pathIR.
+    static void AAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
+                            const SkIRect& clipBounds, bool forceRLE);
+    // Fills non-inverse paths by binning their edges into tiles instead of walking sorted edges.
+    // AntiFillPath uses this instead of AAAFillPath when gSkUseSparseAA is set.
+    static void SparseAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
+                                 const SkIRect& clipBounds);
+
 private:
     friend class SkAAClip;
     friend class SkRegion;
@@ -80,6 +95,7 @@ private:
     static void FillRect(const SkRect&, const SkRegion* clip, SkBlitter*);
     static void AntiFillRect(const SkRect&, const SkRegion* clip, SkBlitter*);
     static void AntiFillXRect(const SkXRect&, const SkRegion*, SkBlitter*);
+    static void AntiFillRRect(const SkRRect&, const SkRegion& clip, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRegion& clip, SkBlitter*, bool forceRLE);
     static void FillTriangle(const SkPoint pts[], const SkRegion*, SkBlitter*);
 
@@ -87,8 +103,6 @@ private:
                               const SkRegion*, SkBlitter*);
     static void HairLineRgn(const SkPoint[], int count, const SkRegion*, SkBlitter*);
     static void AntiHairLineRgn(const SkPoint[], int count, const SkRegion*, SkBlitter*);
-    static void AAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
-                            const SkIRect& clipBounds, bool forceRLE);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
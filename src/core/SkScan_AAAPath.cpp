@@ -1012,7 +1012,7 @@ static bool operator<(const SkAnalyticEdge& a, const SkAnalyticEdge& b) {
 }
 
 static SkAnalyticEdge* sort_edges(SkAnalyticEdge* list[], int count, SkAnalyticEdge** last) {
-    SkTQSort(list, list + count);
+    SkSortEdges(list, count, [](const SkAnalyticEdge& edge) { return edge.fUpperY; });
 
     // now make the edges linked in sorted order
     for (int i = 1; i < count; ++i) {
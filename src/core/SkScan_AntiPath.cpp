@@ -19,6 +19,9 @@
 
 #include <cstdint>
 
+// Hacks for testing.
+bool gSkUseSparseAA{false};
+
 static SkIRect safeRoundOut(const SkRect& src) {
     // roundOut will pin huge floats to max/min int
     SkIRect dst = src.roundOut();
@@ -126,7 +129,11 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
         sk_blit_above(blitter, ir, *clipRgn);
     }
 
-    SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+    if (gSkUseSparseAA && !isInverse) {
+        SkScan::SparseAAFillPath(path, blitter, ir, clipRgn->getBounds());
+    } else {
+        SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
+    }
 
     if (isInverse) {
         sk_blit_below(blitter, ir, *clipRgn);
@@ -0,0 +1,208 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkRasterClip.h"
+#include "src/core/SkScan.h"
+#include "src/core/SkScanPriv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/*
+ *  Ovals and simple rrects are filled without building a path. The rows that lie entirely between
+ *  the top and bottom corners are an axis-aligned rect and are handed to AntiFillRect. The other
+ *  rows compute each pixel's coverage directly from its distance to the edge, four pixels at a
+ *  time, like Ganesh's analytic rrect ops do in their fragment shaders:
+ *
+ *  - next to a straight edge the coverage is the exact overlap of the pixel and the shape;
+ *  - in a corner it is 1/2 minus the distance from the pixel center to the ellipse, estimated
+ *    as f / |grad f| for f = x^2/rx^2 + y^2/ry^2 - 1.
+ *
+ *  The distance estimate gets worse as the radii get smaller, so corners with radii under a pixel
+ *  are left to the path scan converters.
+ */
+
+static constexpr SkScalar kMinRadius = 1;
+
+// The longest run that blitAntiH accepts.
+static constexpr int kMaxRun = 32767;
+
+bool SkScan::CanAntiFillRRect(const SkRRect& rrect) {
+    if (!rrect.isOval() && !rrect.isSimple()) {
+        return false;
+    }
+    const SkVector radii = rrect.getSimpleRadii();
+    if (radii.fX < kMinRadius || radii.fY < kMinRadius) {
+        return false;
+    }
+    // Keep the bounds small enough that rounding them to ints can't overflow.
+    const SkRect& r = rrect.rect();
+    constexpr SkScalar kMaxCoord = SK_MaxS32 >> 2;
+    return r.fLeft > -kMaxCoord && r.fTop > -kMaxCoord &&
+           r.fRight < kMaxCoord && r.fBottom < kMaxCoord;
+}
+
+namespace {
+
+class RRectRowBlitter {
+public:
+    RRectRowBlitter(const SkRRect& rrect, int left, int right, SkBlitter* blitter)
+            : fLeft(left)
+            , fWidth(right - left)
+            , fBlitter(blitter) {
+        const SkRect& r = rrect.rect();
+        const SkVector radii = rrect.getSimpleRadii();
+        fRX = radii.fX;
+        fRY = radii.fY;
+        fInvRX2 = 1 / (fRX * fRX);
+        fInvRY2 = 1 / (fRY * fRY);
+        fCenterL = r.fLeft + fRX;
+        fCenterR = r.fRight - fRX;
+        fCenterT = r.fTop + fRY;
+        fCenterB = r.fBottom - fRY;
+
+        // Pixels in [fMidL, fMidR) have their centers between the left and right corners, so
+        // they all get the same coverage in a given row.
+        fMidL = SkTPin(sk_float_ceil2int(fCenterL - 0.5f), left, right);
+        fMidR = SkTPin(sk_float_floor2int(fCenterR - 0.5f) + 1, fMidL, right);
+
+        // The corners are computed four pixels at a time, so leave room for the last batch.
+        fAlpha.reset(fWidth + 4);
+        fRuns.reset(fWidth + 1);
+    }
+
+    void blitRow(int y) {
+        const float py = y + 0.5f;
+        const float ey = std::max({fCenterT - py, py - fCenterB, 0.f});
+
+        // The left corner may write a few alphas past its end, so it goes before the middle.
+        this->cornerCoverage(fLeft, fMidL, ey);
+        // Between the corners only the distance to the top or bottom edge matters.
+        const float midCoverage = ey > 0 ? SkTPin(0.5f + fRY - ey, 0.f, 1.f) : 1.f;
+        memset(fAlpha.get() + (fMidL - fLeft), coverage_to_alpha(midCoverage), fMidR - fMidL);
+        this->cornerCoverage(fMidR, fLeft + fWidth, ey);
+        this->blitAlphas(y);
+    }
+
+private:
+    static uint8_t coverage_to_alpha(float coverage) {
+        return SkToU8(static_cast<int>(coverage * 255 + 0.5f));
+    }
+
+    void cornerCoverage(int x0, int x1, float ey) {
+        using float4 = skvx::float4;
+        const float ey2 = ey * ey * fInvRY2;
+        const float gy = ey * fInvRY2;
+        for (int x = x0; x < x1; x += 4) {
+            float4 px = float4(x + 0.5f) + float4(0, 1, 2, 3);
+            float4 ex = max(max(fCenterL - px, px - fCenterR), 0.f);
+
+            float4 coverage;
+            if (ey > 0) {
+                float4 f = ex * ex * fInvRX2 + ey2 - 1;
+                float4 gx = ex * fInvRX2;
+                // The gradient vanishes at the center of the ellipse, which is deep inside.
+                float4 grad = max(2 * sqrt(gx * gx + gy * gy), 1e-6f);
+                coverage = if_then_else(ex > 0, 0.5f - f / grad, float4(0.5f + fRY - ey));
+            } else {
+                coverage = 0.5f + fRX - ex;
+            }
+            coverage = pin(coverage, float4(0), float4(1));
+            skvx::cast<uint8_t>(coverage * 255 + 0.5f).store(fAlpha.get() + (x - fLeft));
+        }
+    }
+
+    // Merges the row of alphas into runs.
+    void blitAlphas(int y) {
+        const uint8_t* alpha = fAlpha.get();
+        int16_t* runs = fRuns.get();
+        int x = 0;
+        while (x < fWidth) {
+            int n = 1;
+            while (x + n < fWidth && n < kMaxRun && alpha[x + n] == alpha[x]) {
+                ++n;
+            }
+            runs[x] = SkToS16(n);
+            x += n;
+        }
+        runs[fWidth] = 0;
+        fBlitter->blitAntiH(fLeft, y, fAlpha.get(), fRuns.get());
+    }
+
+    const int fLeft;
+    const int fWidth;
+    SkBlitter* const fBlitter;
+
+    float fRX, fRY;
+    float fInvRX2, fInvRY2;
+    float fCenterL, fCenterR, fCenterT, fCenterB;
+    int fMidL, fMidR;
+
+    skia_private::AutoSTMalloc<256, uint8_t> fAlpha;
+    skia_private::AutoSTMalloc<256, int16_t> fRuns;
+};
+
+}  // namespace
+
+void SkScan::AntiFillRRect(const SkRRect& rrect, const SkRegion& clip, SkBlitter* blitter) {
+    SkASSERT(CanAntiFillRRect(rrect));
+
+    const SkIRect ir = rrect.getBounds().roundOut();
+    SkIRect bounds = ir;
+    if (!bounds.intersect(clip.getBounds())) {
+        return;
+    }
+    SkScanClipper clipper(blitter, &clip, ir);
+    blitter = clipper.getBlitter();
+    if (!blitter) {
+        return;
+    }
+
+    // Rows that don't reach into a corner are a plain rect.
+    const SkRect& r = rrect.rect();
+    const SkVector radii = rrect.getSimpleRadii();
+    const int midTop = SkTPin(sk_float_ceil2int(r.fTop + radii.fY), bounds.fTop, bounds.fBottom);
+    const int midBottom = SkTPin(sk_float_floor2int(r.fBottom - radii.fY), midTop, bounds.fBottom);
+
+    RRectRowBlitter rows(rrect, bounds.fLeft, bounds.fRight, blitter);
+    for (int y = bounds.fTop; y < midTop; ++y) {
+        rows.blitRow(y);
+    }
+    if (midTop < midBottom) {
+        SkRect mid = SkRect::MakeLTRB(r.fLeft, midTop, r.fRight, midBottom);
+        if (mid.intersect(SkRect::Make(bounds))) {
+            AntiFillRect(mid, nullptr, blitter);
+        }
+    }
+    for (int y = midBottom; y < bounds.fBottom; ++y) {
+        rows.blitRow(y);
+    }
+}
+
+void SkScan::AntiFillRRect(const SkRRect& rrect, const SkRasterClip& clip, SkBlitter* blitter) {
+    if (clip.isEmpty()) {
+        return;
+    }
+    if (clip.isBW()) {
+        AntiFillRRect(rrect, clip.bwRgn(), blitter);
+    } else {
+        SkAAClipBlitterWrapper wrap(clip, blitter);
+        AntiFillRRect(rrect, wrap.getRgn(), wrap.getBlitter());
+    }
+}
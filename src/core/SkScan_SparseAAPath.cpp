@@ -0,0 +1,429 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTPin.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkScan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+/*
+ *  Sparse AA is a scan converter in the style of font-rs and sparse strips. Each line of the
+ *  flattened path adds the signed area it covers to the pixels it crosses, and the running sum of
+ *  those areas along a row is the pixel's coverage. That needs no edge sorting and no active edge
+ *  list, which is where AAA spends most of its time on paths with many edges such as text and
+ *  maps.
+ *
+ *  The lines are binned into rows of tiles, kTileSize pixels on a side. Each row of tiles is
+ *  accumulated into a small buffer and the blitter is only called for the spans that have
+ *  coverage: tiles that no line touches all have the coverage coming in from their left edge.
+ *
+ *  Summing the areas gives each pixel its winding averaged over the pixel, which is its exact
+ *  coverage unless edges cross within the pixel. Where the path crosses itself or overlapping
+ *  contours' edges cross, the pixel can come out lighter or darker than it does with AAA.
+ */
+
+namespace {
+
+constexpr int kTileSize = 16;
+
+// How far, in pixels, the flattened curves may be from the curves.
+constexpr float kFlattenTolerance = 1.f / 16;
+constexpr int kMaxLinesPerCurve = 256;
+
+using float4 = skvx::float4;
+
+struct Line {
+    SkPoint fP0;
+    SkPoint fP1;
+};
+
+class SparseRasterizer {
+public:
+    SparseRasterizer(const SkIRect& bounds, bool evenOdd)
+            : fBounds(bounds)
+            , fEvenOdd(evenOdd)
+            , fWidth(bounds.width())
+            , fHeight(bounds.height())
+            , fTileColumns((fWidth + 2 + kTileSize - 1) / kTileSize)
+            , fTileRows((fHeight + kTileSize - 1) / kTileSize)
+            , fStride(fTileColumns * kTileSize) {}
+
+    void addPath(const SkPath& path) {
+        SkPoint start = {0, 0};
+        SkPoint last = {0, 0};
+        for (auto [verb, pts, weight] : SkPathPriv::Iterate(path)) {
+            switch (verb) {
+                case SkPathVerb::kMove:
+                    this->addLine(last, start);
+                    start = last = pts[0];
+                    break;
+                case SkPathVerb::kLine:
+                    this->addLine(pts[0], pts[1]);
+                    last = pts[1];
+                    break;
+                case SkPathVerb::kQuad:
+                    this->addQuad(pts);
+                    last = pts[2];
+                    break;
+                case SkPathVerb::kConic: {
+                    SkAutoConicToQuads quadder;
+                    const SkPoint* quads = quadder.computeQuads(pts, *weight, kFlattenTolerance);
+                    for (int i = 0; i < quadder.countQuads(); ++i) {
+                        this->addQuad(quads + 2 * i);
+                    }
+                    last = pts[2];
+                    break;
+                }
+                case SkPathVerb::kCubic:
+                    this->addCubic(pts);
+                    last = pts[3];
+                    break;
+                case SkPathVerb::kClose:
+                    this->addLine(last, start);
+                    last = start;
+                    break;
+            }
+        }
+        this->addLine(last, start);
+    }
+
+    void blit(SkBlitter* blitter) {
+        if (fLines.empty()) {
+            return;
+        }
+
+        // Bin the lines by the rows of tiles they cross. Counting first lets the bins share one
+        // array.
+        skia_private::AutoTMalloc<int> binStarts(fTileRows + 1);
+        std::fill_n(binStarts.get(), fTileRows + 1, 0);
+        for (const Line& line : fLines) {
+            auto [first, last] = this->tileRowRange(line);
+            for (int row = first; row <= last; ++row) {
+                binStarts[row + 1]++;
+            }
+        }
+        for (int row = 0; row < fTileRows; ++row) {
+            binStarts[row + 1] += binStarts[row];
+        }
+        skia_private::AutoTMalloc<int> bins(binStarts[fTileRows]);
+        skia_private::AutoTMalloc<int> binEnds(fTileRows);
+        std::copy_n(binStarts.get(), fTileRows, binEnds.get());
+        for (int i = 0; i < fLines.size(); ++i) {
+            auto [first, last] = this->tileRowRange(fLines[i]);
+            for (int row = first; row <= last; ++row) {
+                bins[binEnds[row]++] = i;
+            }
+        }
+
+        fAreas.reset(kTileSize * fStride);
+        memset(fAreas.get(), 0, kTileSize * fStride * sizeof(float));
+        fTouched.reset(fTileColumns);
+        std::fill_n(fTouched.get(), fTileColumns, false);
+        fAlpha.reset(fWidth + 1);
+        fRuns.reset(fWidth + 1);
+
+        for (int row = 0; row < fTileRows; ++row) {
+            if (binStarts[row] == binStarts[row + 1]) {
+                // No lines cross this row, so nothing in it is covered.
+                continue;
+            }
+            const int top = row * kTileSize;
+            const int height = std::min(kTileSize, fHeight - top);
+            for (int i = binStarts[row]; i < binStarts[row + 1]; ++i) {
+                this->accumulate(fLines[bins[i]], top, height);
+            }
+            this->blitTileRow(blitter, top, height);
+        }
+    }
+
+private:
+    std::pair<int, int> tileRowRange(const Line& line) const {
+        float top = std::min(line.fP0.fY, line.fP1.fY);
+        float bottom = std::max(line.fP0.fY, line.fP1.fY);
+        int first = SkTPin((int)top / kTileSize, 0, fTileRows - 1);
+        int last = SkTPin((int)std::ceil(bottom - 1) / kTileSize, 0, fTileRows - 1);
+        return {first, last};
+    }
+
+    // Adds the line from p0 to p1, in device space, after clipping it to the bounds. The parts to
+    // the right of the bounds don't cover any of its pixels and are dropped. The parts to the left
+    // are moved onto its left edge, which keeps the winding they add to the pixels to their right.
+    void addLine(SkPoint p0, SkPoint p1) {
+        p0 -= {(float)fBounds.fLeft, (float)fBounds.fTop};
+        p1 -= {(float)fBounds.fLeft, (float)fBounds.fTop};
+        const float w = fWidth;
+        const float h = fHeight;
+        if (p0.fY == p1.fY || (p0.fY <= 0 && p1.fY <= 0) || (p0.fY >= h && p1.fY >= h) ||
+            (p0.fX >= w && p1.fX >= w)) {
+            return;
+        }
+
+        // Split the line where it crosses the left and right edges.
+        float ts[4] = {0, 0, 0, 1};
+        int count = 1;
+        if (p0.fX != p1.fX) {
+            for (float edge : {0.f, w}) {
+                float t = (edge - p0.fX) / (p1.fX - p0.fX);
+                if (t > 0 && t < 1) {
+                    ts[count++] = t;
+                }
+            }
+        }
+        ts[count++] = 1;
+        std::sort(ts + 1, ts + count - 1);
+
+        auto lerp = [&](float t) { return p0 + (p1 - p0) * t; };
+        SkPoint from = p0;
+        for (int i = 1; i < count; ++i) {
+            SkPoint to = i == count - 1 ? p1 : lerp(ts[i]);
+            if (from.fX + to.fX < 2 * w) {
+                fLines.push_back({{SkTPin(from.fX, 0.f, w), from.fY},
+                                  {SkTPin(to.fX, 0.f, w), to.fY}});
+            }
+            from = to;
+        }
+    }
+
+    void addQuad(const SkPoint pts[3]) {
+        // A quad's distance from its chords is at most |p0 - 2p1 + p2| / (4n^2).
+        float dd = (pts[0] - pts[1] * 2 + pts[2]).length();
+        int n = SkTPin((int)std::ceil(std::sqrt(dd / (4 * kFlattenTolerance))),
+                       1, kMaxLinesPerCurve);
+        SkPoint from = pts[0];
+        for (int i = 1; i < n; ++i) {
+            float t = (float)i / n;
+            float mt = 1 - t;
+            SkPoint to = pts[0] * (mt * mt) + pts[1] * (2 * t * mt) + pts[2] * (t * t);
+            this->addLine(from, to);
+            from = to;
+        }
+        this->addLine(from, pts[2]);
+    }
+
+    void addCubic(const SkPoint pts[4]) {
+        // A cubic's distance from its chords is at most 3 * max|p[i] - 2p[i+1] + p[i+2]| / (4n^2).
+        float dd = std::max((pts[0] - pts[1] * 2 + pts[2]).length(),
+                            (pts[1] - pts[2] * 2 + pts[3]).length());
+        int n = SkTPin((int)std::ceil(std::sqrt(3 * dd / (4 * kFlattenTolerance))),
+                       1, kMaxLinesPerCurve);
+        SkPoint from = pts[0];
+        for (int i = 1; i < n; ++i) {
+            float t = (float)i / n;
+            float mt = 1 - t;
+            SkPoint to = pts[0] * (mt * mt * mt) + pts[1] * (3 * t * mt * mt) +
+                         pts[2] * (3 * t * t * mt) + pts[3] * (t * t * t);
+            this->addLine(from, to);
+            from = to;
+        }
+        this->addLine(from, pts[3]);
+    }
+
+    void touch(int x0, int x1) {
+        for (int tile = x0 / kTileSize; tile <= x1 / kTileSize; ++tile) {
+            fTouched[tile] = true;
+        }
+    }
+
+    // Adds the signed area that the part of 'line' in rows [top, top + height) covers to the
+    // pixels each of its points is on, and the remainder of the pixel's height to the pixel to
+    // its right, so that summing the areas along a row gives each pixel's coverage.
+    void accumulate(const Line& line, int top, int height) {
+        SkPoint p0 = line.fP0 - SkPoint{0, (float)top};
+        SkPoint p1 = line.fP1 - SkPoint{0, (float)top};
+        float dir = 1;
+        if (p0.fY > p1.fY) {
+            std::swap(p0, p1);
+            dir = -1;
+        }
+        if (p1.fY <= 0 || p0.fY >= height) {
+            return;
+        }
+
+        const float w = fWidth;
+        const float dxdy = (p1.fX - p0.fX) / (p1.fY - p0.fY);
+        float x = p0.fX;
+        float y0 = p0.fY;
+        if (y0 < 0) {
+            x -= y0 * dxdy;
+            y0 = 0;
+        }
+        const float y1 = std::min(p1.fY, (float)height);
+
+        for (int y = (int)y0; y < y1; ++y) {
+            float* areas = fAreas.get() + y * fStride;
+            const float dy = std::min((float)(y + 1), y1) - std::max((float)y, y0);
+            const float xNext = x + dxdy * dy;
+            const float d = dy * dir;
+            const float left = SkTPin(std::min(x, xNext), 0.f, w);
+            const float right = SkTPin(std::max(x, xNext), 0.f, w);
+            const float leftFloor = std::floor(left);
+            const int x0 = (int)leftFloor;
+            const float rightCeil = std::ceil(right);
+            const int x1 = (int)rightCeil;
+
+            if (x1 <= x0 + 1) {
+                // The line stays within one pixel in this row.
+                const float mid = 0.5f * (left + right) - leftFloor;
+                areas[x0] += d - d * mid;
+                areas[x0 + 1] += d * mid;
+                this->touch(x0, x0 + 1);
+            } else {
+                const float s = 1 / (right - left);
+                const float leftFrac = left - leftFloor;
+                const float a0 = 0.5f * s * (1 - leftFrac) * (1 - leftFrac);
+                const float rightFrac = right - rightCeil + 1;
+                const float am = 0.5f * s * rightFrac * rightFrac;
+                areas[x0] += d * a0;
+                if (x1 == x0 + 2) {
+                    areas[x0 + 1] += d * (1 - a0 - am);
+                } else {
+                    const float a1 = s * (1.5f - leftFrac);
+                    areas[x0 + 1] += d * (a1 - a0);
+                    for (int xi = x0 + 2; xi < x1 - 1; ++xi) {
+                        areas[xi] += d * s;
+                    }
+                    const float a2 = a1 + (x1 - x0 - 3) * s;
+                    areas[x1 - 1] += d * (1 - a2 - am);
+                }
+                areas[x1] += d * am;
+                this->touch(x0, x1);
+            }
+            x = xNext;
+        }
+    }
+
+    float4 coverage(float4 winding) const {
+        float4 c = abs(winding);
+        if (fEvenOdd) {
+            c = c - 2 * floor(c * 0.5f);
+            c = min(c, 2 - c);
+        }
+        return min(c, 1);
+    }
+
+    SkAlpha toAlpha(float winding) const {
+        return SkToU8(lrint(this->coverage(float4(winding))[0] * 255));
+    }
+
+    // Appends a span of 'count' pixels with the same alpha to the row being built, blitting the
+    // row's spans so far if that alpha is 0.
+    void addSpan(SkBlitter* blitter, int x, int y, int count, SkAlpha alpha) {
+        if (alpha == 0) {
+            this->flushSpans(blitter, x, y);
+            return;
+        }
+        if (fSpanStart < 0) {
+            fSpanStart = x;
+        } else if (fAlpha[fLastRun] == alpha) {
+            fRuns[fLastRun] += count;
+            return;
+        }
+        fAlpha[x] = alpha;
+        fRuns[x] = SkToS16(count);
+        fLastRun = x;
+    }
+
+    void flushSpans(SkBlitter* blitter, int x, int y) {
+        if (fSpanStart >= 0) {
+            fRuns[x] = 0;
+            blitter->blitAntiH(fBounds.fLeft + fSpanStart,
+                               fBounds.fTop + y,
+                               fAlpha.get() + fSpanStart,
+                               fRuns.get() + fSpanStart);
+            fSpanStart = -1;
+        }
+    }
+
+    void blitTileRow(SkBlitter* blitter, int top, int height) {
+        for (int y = 0; y < height; ++y) {
+            float* areas = fAreas.get() + y * fStride;
+            float winding = 0;
+            for (int tile = 0; tile < fTileColumns; ++tile) {
+                const int x = tile * kTileSize;
+                const int count = std::min(kTileSize, fWidth - x);
+                if (!fTouched[tile]) {
+                    if (count > 0) {
+                        this->addSpan(blitter, x, top + y, count, this->toAlpha(winding));
+                    }
+                    continue;
+                }
+
+                // Sum the areas along the tile four pixels at a time, carrying the sum between
+                // groups, and clear them for the next row of tiles.
+                SkAlpha alpha[kTileSize];
+                for (int i = 0; i < kTileSize; i += 4) {
+                    float4 a = float4::Load(areas + x + i);
+                    a += skvx::shuffle<0, 0, 1, 2>(a) * float4(0, 1, 1, 1);
+                    a += skvx::shuffle<0, 0, 0, 1>(a) * float4(0, 0, 1, 1);
+                    a += winding;
+                    winding = a[3];
+                    skvx::cast<uint8_t>(lrint(this->coverage(a) * 255)).store(alpha + i);
+                    float4(0).store(areas + x + i);
+                }
+                for (int i = 0; i < count; ++i) {
+                    this->addSpan(blitter, x + i, top + y, 1, alpha[i]);
+                }
+            }
+            this->flushSpans(blitter, fWidth, top + y);
+        }
+        std::fill_n(fTouched.get(), fTileColumns, false);
+    }
+
+    const SkIRect fBounds;
+    const bool fEvenOdd;
+    const int fWidth;
+    const int fHeight;
+    const int fTileColumns;
+    const int fTileRows;
+    const int fStride;
+
+    skia_private::TArray<Line> fLines;
+
+    // The areas of one row of tiles, fStride floats per row of pixels.
+    skia_private::AutoTMalloc<float> fAreas;
+    skia_private::AutoTMalloc<bool> fTouched;
+
+    // The runs of the row being blitted.
+    skia_private::AutoTMalloc<SkAlpha> fAlpha;
+    skia_private::AutoTMalloc<int16_t> fRuns;
+    int fSpanStart = -1;
+    int fLastRun = -1;
+};
+
+}  // namespace
+
+void SkScan::SparseAAFillPath(const SkPath& path,
+                              SkBlitter* blitter,
+                              const SkIRect& ir,
+                              const SkIRect& clipBounds) {
+    SkASSERT(!path.isInverseFillType());
+    SkIRect bounds;
+    if (!bounds.intersect(ir, clipBounds)) {
+        return;
+    }
+
+    SparseRasterizer rasterizer(bounds, path.getFillType() == SkPathFillType::kEvenOdd);
+    rasterizer.addPath(path);
+    rasterizer.blit(blitter);
+}
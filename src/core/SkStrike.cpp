@@ -7,7 +7,9 @@
 
 #include "src/core/SkStrike.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkDrawable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
@@ -15,6 +17,7 @@
 #include "include/core/SkTraceMemoryDump.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkSemaphore.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkMask.h"
@@ -24,6 +27,8 @@
 #include "src/core/SkWriteBuffer.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <new>
 #include <optional>
@@ -115,18 +120,19 @@ SkStrike::FlattenGlyphsByType(SkWriteBuffer& buffer,
 }
 
 bool SkStrike::mergeFromBuffer(SkReadBuffer& buffer) {
+    Monitor m{this};
+    return this->internalMergeFromBuffer(buffer);
+}
+
+bool SkStrike::internalMergeFromBuffer(SkReadBuffer& buffer) {
     // Read glyphs with images for the current strike.
     const int imagesCount = buffer.readInt();
     if (imagesCount == 0 && !buffer.isValid()) {
         return false;
     }
-
-    {
-        Monitor m{this};
-        for (int curImage = 0; curImage < imagesCount; ++curImage) {
-            if (!this->mergeGlyphAndImageFromBuffer(buffer)) {
-                return false;
-            }
+    for (int curImage = 0; curImage < imagesCount; ++curImage) {
+        if (!this->mergeGlyphAndImageFromBuffer(buffer)) {
+            return false;
         }
     }
 
@@ -135,12 +141,9 @@ bool SkStrike::mergeFromBuffer(SkReadBuffer& buffer) {
     if (pathsCount == 0 && !buffer.isValid()) {
         return false;
     }
-    {
-        Monitor m{this};
-        for (int curPath = 0; curPath < pathsCount; ++curPath) {
-            if (!this->mergeGlyphAndPathFromBuffer(buffer)) {
-                return false;
-            }
+    for (int curPath = 0; curPath < pathsCount; ++curPath) {
+        if (!this->mergeGlyphAndPathFromBuffer(buffer)) {
+            return false;
         }
     }
 
@@ -149,18 +152,51 @@ bool SkStrike::mergeFromBuffer(SkReadBuffer& buffer) {
     if (drawablesCount == 0 && !buffer.isValid()) {
         return false;
     }
-    {
-        Monitor m{this};
-        for (int curDrawable = 0; curDrawable < drawablesCount; ++curDrawable) {
-            if (!this->mergeGlyphAndDrawableFromBuffer(buffer)) {
-                return false;
-            }
+    for (int curDrawable = 0; curDrawable < drawablesCount; ++curDrawable) {
+        if (!this->mergeGlyphAndDrawableFromBuffer(buffer)) {
+            return false;
         }
     }
 
     return true;
 }
 
+bool SkStrike::mergeFromPersistentCache(const SkData& data) {
+    SkReadBuffer buffer{data.data(), data.size()};
+    SkAutoMutexExclusive lock{fStrikeLock};
+    fMemoryIncrease = 0;
+    const bool merged = this->internalMergeFromBuffer(buffer);
+    fMemoryUsed += fMemoryIncrease;
+    fMemoryIncrease = 0;
+    return merged;
+}
+
+sk_sp<SkData> SkStrike::serializeForPersistentCache() {
+    // The strike may already have been purged from the strike cache, so take the strike lock
+    // directly: the Monitor would report the memory use to the cache.
+    SkAutoMutexExclusive lock{fStrikeLock};
+    if (!fHasUnpersistedGlyphs) {
+        return nullptr;
+    }
+    fHasUnpersistedGlyphs = false;
+
+    std::vector<SkGlyph> images, paths;
+    for (SkGlyph* glyph : fGlyphForIndex) {
+        if (glyph->setImageHasBeenCalled()) {
+            images.push_back(*glyph);
+        }
+        if (glyph->setPathHasBeenCalled()) {
+            paths.push_back(*glyph);
+        }
+    }
+
+    // Drawables hold pictures, which would need to be serialized with their own procs, so they
+    // are left for the scaler context to make again.
+    SkBinaryWriteBuffer buffer{nullptr, 0, {}};
+    FlattenGlyphsByType(buffer, images, paths, {});
+    return buffer.snapshotAsData();
+}
+
 SkGlyph* SkStrike::mergeGlyphAndImage(SkPackedGlyphID toID, const SkGlyph& fromGlyph) {
     Monitor m{this};
     // TODO(herb): remove finding the glyph when setting the metrics and image are separated
@@ -231,6 +267,11 @@ SkSpan<const SkGlyph*> SkStrike::prepareImages(
         SkSpan<const SkPackedGlyphID> glyphIDs, const SkGlyph* results[]) {
     const SkGlyph** cursor = results;
     Monitor m{this};
+    if (SkExecutor* executor = fStrikeCache != nullptr ? fStrikeCache->glyphRasterExecutor()
+                                                       : nullptr;
+        executor != nullptr && glyphIDs.size() >= kMinParallelGlyphCount) {
+        this->prepareImagesInParallel(glyphIDs, executor);
+    }
     for (auto glyphID : glyphIDs) {
         SkGlyph* glyph = this->glyph(glyphID);
         this->prepareForImage(glyph);
@@ -240,6 +281,71 @@ SkSpan<const SkGlyph*> SkStrike::prepareImages(
     return {results, glyphIDs.size()};
 }
 
+void SkStrike::prepareImagesInParallel(SkSpan<const SkPackedGlyphID> glyphIDs,
+                                       SkExecutor* executor) {
+    // The shared state outlives this call if a helper task only starts after all the glyphs
+    // are done. Such a late task finds nothing left to claim and never touches the strike.
+    struct RasterWork {
+        std::vector<SkGlyph*> fGlyphs;
+        std::atomic<size_t> fNext{0};
+        SkSemaphore fHelperDone;  // Signaled once for each glyph rasterized by a helper.
+    };
+    auto work = std::make_shared<RasterWork>();
+
+    for (auto glyphID : glyphIDs) {
+        SkGlyph* glyph = this->glyph(glyphID);
+        if (!glyph->setImageHasBeenCalled()) {
+            work->fGlyphs.push_back(glyph);
+        }
+    }
+    if (work->fGlyphs.size() < kMinParallelGlyphCount) {
+        return;
+    }
+
+    // All the allocation happens here, under the strike lock. A glyph which appears more than
+    // once is only allocated, and so only queued, the first time.
+    size_t queued = 0;
+    for (SkGlyph* glyph : work->fGlyphs) {
+        if (!glyph->setImageHasBeenCalled()) {
+            fMemoryIncrease += glyph->allocImage(&fAlloc);
+            work->fGlyphs[queued++] = glyph;
+            fHasUnpersistedGlyphs = true;
+        }
+    }
+    work->fGlyphs.resize(queued);
+
+    const size_t helperCount =
+            std::min(queued / kGlyphsPerRasterTask, kMaxRasterTasks) - 1;
+    for (size_t i = 0; i < helperCount; ++i) {
+        executor->add([work, spec = &fStrikeSpec]() {
+            std::unique_ptr<SkScalerContext> scalerContext;
+            for (size_t index = work->fNext.fetch_add(1, std::memory_order_relaxed);
+                 index < work->fGlyphs.size();
+                 index = work->fNext.fetch_add(1, std::memory_order_relaxed)) {
+                if (scalerContext == nullptr) {
+                    scalerContext = spec->createScalerContext();
+                }
+                scalerContext->getImage(*work->fGlyphs[index]);
+                work->fHelperDone.signal();
+            }
+        });
+    }
+
+    // Work through the queue here too, so the glyphs get done even if the executor is busy.
+    // This thread holds the strike lock, so it must not run other tasks from the executor
+    // while it waits: they may need this strike.
+    size_t doneHere = 0;
+    for (size_t index = work->fNext.fetch_add(1, std::memory_order_relaxed);
+         index < work->fGlyphs.size();
+         index = work->fNext.fetch_add(1, std::memory_order_relaxed)) {
+        fScalerContext->getImage(*work->fGlyphs[index]);
+        doneHere++;
+    }
+    for (size_t i = doneHere; i < work->fGlyphs.size(); ++i) {
+        work->fHelperDone.wait();
+    }
+}
+
 SkSpan<const SkGlyph*> SkStrike::prepareDrawables(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
     const SkGlyph** cursor = results;
@@ -359,6 +465,7 @@ SkGlyphDigest* SkStrike::addGlyphAndDigest(SkGlyph* glyph) {
 bool SkStrike::prepareForImage(SkGlyph* glyph) {
     if (glyph->setImage(&fAlloc, fScalerContext.get())) {
         fMemoryIncrease += glyph->imageSize();
+        fHasUnpersistedGlyphs = true;
     }
     return glyph->image() != nullptr;
 }
@@ -366,6 +473,7 @@ bool SkStrike::prepareForImage(SkGlyph* glyph) {
 bool SkStrike::prepareForPath(SkGlyph* glyph) {
     if (glyph->setPath(&fAlloc, fScalerContext.get())) {
         fMemoryIncrease += glyph->path()->approximateBytesUsed();
+        fHasUnpersistedGlyphs = true;
     }
     return glyph->path() !=nullptr;
 }
@@ -445,11 +553,13 @@ SkSpan<const SkGlyph*> SkStrike::internalPrepare(
 
 void SkStrike::updateMemoryUsage(size_t increase) {
     if (increase > 0) {
-        // fRemoved and the cache's total memory are managed under the cache's lock. This allows
+        // fRemoved and the shard's total memory are managed under the shard's lock. This allows
         // them to be accessed under LRU operation.
-        SkAutoMutexExclusive lock{fStrikeCache->fLock};
+        SkStrikeCache::Shard& shard = fStrikeCache->shardFor(this->getDescriptor());
+        SkAutoMutexExclusive lock{shard.fLock};
         fMemoryUsed += increase;
         if (!fRemoved) {
+            shard.fTotalMemoryUsed += increase;
             fStrikeCache->fTotalMemoryUsed += increase;
         }
     }
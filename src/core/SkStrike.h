@@ -25,8 +25,10 @@
 #include <memory>
 #include <vector>
 
+class SkData;
 class SkDescriptor;
 class SkDrawable;
+class SkExecutor;
 class SkPath;
 class SkReadBuffer;
 class SkStrikeCache;
@@ -57,6 +59,11 @@ public:
     bool prepareForDrawable(SkGlyph*) override SK_REQUIRES(fStrikeLock);
 
     bool mergeFromBuffer(SkReadBuffer& buffer) SK_EXCLUDES(fStrikeLock);
+
+    // Serialize the glyphs with images or paths for an SkGlyphPersistentCache, in the format
+    // read by mergeFromBuffer. Returns nullptr if no glyph got an image or path since the strike
+    // was created or last serialized.
+    sk_sp<SkData> serializeForPersistentCache() SK_EXCLUDES(fStrikeLock);
     static void FlattenGlyphsByType(SkWriteBuffer& buffer,
                                     SkSpan<SkGlyph> images,
                                     SkSpan<SkGlyph> paths,
@@ -145,11 +152,22 @@ private:
     // Generate the glyph digest information and update structures to add the glyph.
     SkGlyphDigest* addGlyphAndDigest(SkGlyph* glyph) SK_REQUIRES(fStrikeLock);
 
+    bool internalMergeFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
+
+    // Merge glyphs loaded from an SkGlyphPersistentCache into a strike which is not in its
+    // SkStrikeCache yet, so the memory goes straight into fMemoryUsed.
+    bool mergeFromPersistentCache(const SkData& data) SK_EXCLUDES(fStrikeLock);
+
     SkGlyph* mergeGlyphFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndImageFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndPathFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndDrawableFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
 
+    // Rasterize the images of the glyphs which have none yet, spread over the executor's threads
+    // and the calling thread. Does nothing if there are too few of them to be worth it.
+    void prepareImagesInParallel(SkSpan<const SkPackedGlyphID> glyphIDs, SkExecutor* executor)
+            SK_REQUIRES(fStrikeLock);
+
     // Maintain memory use statistics.
     void updateMemoryUsage(size_t increase) SK_EXCLUDES(fStrikeLock);
 
@@ -190,14 +208,24 @@ private:
     // Used while changing the strike to track memory increase.
     size_t fMemoryIncrease SK_GUARDED_BY(fStrikeLock) {0};
 
+    // Set when the scaler context makes a glyph image or path, so the strike has something new
+    // for the persistent cache.
+    bool fHasUnpersistedGlyphs SK_GUARDED_BY(fStrikeLock) {false};
+
     // So, we don't grow our arrays a lot.
     inline static constexpr size_t kMinGlyphCount = 8;
     inline static constexpr size_t kMinGlyphImageSize = 16 /* height */ * 8 /* width */;
     inline static constexpr size_t kMinAllocAmount = kMinGlyphImageSize * kMinGlyphCount;
 
+    // Batches smaller than this are rasterized on the calling thread; each helper task gets
+    // at least kGlyphsPerRasterTask glyphs to pay for making its scaler context.
+    inline static constexpr size_t kMinParallelGlyphCount = 32;
+    inline static constexpr size_t kGlyphsPerRasterTask = 16;
+    inline static constexpr size_t kMaxRasterTasks = 8;
+
     SkArenaAlloc            fAlloc SK_GUARDED_BY(fStrikeLock) {kMinAllocAmount};
 
-    // The following are protected by the SkStrikeCache's mutex.
+    // The following are protected by the mutex of this strike's SkStrikeCache shard.
     SkStrike*                       fNext{nullptr};
     SkStrike*                       fPrev{nullptr};
     std::unique_ptr<SkStrikePinner> fPinner;
@@ -7,18 +7,27 @@
 
 #include "src/core/SkStrikeCache.h"
 
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkGlyphPersistentCache.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkTraceMemoryDump.h"
+#include "include/core/SkTypeface.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkCounters.h"
 #include "src/core/SkDescriptor.h"
+#include "src/core/SkScalerContext.h"
 #include "src/core/SkStrike.h"
 #include "src/core/SkStrikeSpec.h"
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 class SkScalerContext;
 struct SkFontMetrics;
@@ -27,6 +36,53 @@ using namespace sktext;
 
 bool gSkUseThreadLocalStrikeCaches_IAcknowledgeThisIsIncrediblyExperimental = false;
 
+// A strike's key in the persistent cache is its descriptor, with the typeface ID, which is only
+// meaningful in this process, replaced by data identifying the font file across processes.
+static sk_sp<SkData> persistent_cache_key(const SkStrikeSpec& strikeSpec) {
+    const SkTypeface& typeface = strikeSpec.typeface();
+    SkDynamicMemoryWStream key;
+
+    // The names, style, collection index and variation position of the font.
+    sk_sp<SkData> fontDescriptor =
+            typeface.serialize(SkTypeface::SerializeBehavior::kDontIncludeData);
+    if (fontDescriptor == nullptr) {
+        return nullptr;
+    }
+    key.write32(SkToU32(fontDescriptor->size()));
+    key.write(fontDescriptor->data(), fontDescriptor->size());
+
+    // Fonts with the same names may still differ, e.g. after an update; the checksum of the
+    // whole file ('head' checkSumAdjustment) and the glyph count tell those apart.
+    uint32_t checksum = 0;
+    typeface.getTableData(SkSetFourByteTag('h', 'e', 'a', 'd'), 8, sizeof(checksum), &checksum);
+    key.write32(checksum);
+    key.write32(SkToU32(typeface.countGlyphs()));
+
+    SkAutoDescriptor desc{strikeSpec.descriptor()};
+    uint32_t recLength = 0;
+    auto rec = static_cast<SkScalerContextRec*>(
+            const_cast<void*>(desc.getDesc()->findEntry(kRec_SkDescriptorTag, &recLength)));
+    if (rec == nullptr || recLength != sizeof(SkScalerContextRec)) {
+        return nullptr;
+    }
+    rec->fTypefaceID = 0;
+    desc.getDesc()->computeChecksum();
+    key.write(desc.getDesc(), desc.getDesc()->getLength());
+
+    return key.detachAsData();
+}
+
+static void store_strikes(SkGlyphPersistentCache* persistentCache,
+                          const std::vector<sk_sp<SkStrike>>& strikes) {
+    for (const sk_sp<SkStrike>& strike : strikes) {
+        if (sk_sp<SkData> data = strike->serializeForPersistentCache()) {
+            if (sk_sp<SkData> key = persistent_cache_key(strike->strikeSpec())) {
+                persistentCache->store(*key, *data);
+            }
+        }
+    }
+}
+
 SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
     if (gSkUseThreadLocalStrikeCaches_IAcknowledgeThisIsIncrediblyExperimental) {
         static thread_local auto* cache = new SkStrikeCache;
@@ -36,13 +92,25 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
     return cache;
 }
 
+auto SkStrikeCache::shardFor(const SkDescriptor& desc) -> Shard& {
+    // The shard's hash table uses the low bits of the checksum, so pick the shard by the high bits.
+    return fShards[desc.getChecksum() >> (32 - kShardBits)];
+}
+
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
-    if (strike == nullptr) {
-        strike = this->internalCreateStrike(strikeSpec);
+    Shard& shard = this->shardFor(strikeSpec.descriptor());
+    sk_sp<SkStrike> strike;
+    {
+        SkAutoMutexExclusive ac(shard.fLock);
+        strike = this->internalFindStrikeOrNull(&shard, strikeSpec.descriptor());
+        if (strike == nullptr) {
+            SkCount(SkCounter::kStrikeCacheMisses);
+            strike = this->internalCreateStrike(&shard, strikeSpec);
+        } else {
+            SkCount(SkCounter::kStrikeCacheHits);
+        }
     }
-    this->internalPurge();
+    this->purge();
     return strike;
 }
 
@@ -90,34 +158,40 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 sk_sp<SkStrike> SkStrikeCache::findStrike(const SkDescriptor& desc) {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
-    this->internalPurge();
+    Shard& shard = this->shardFor(desc);
+    sk_sp<SkStrike> result;
+    {
+        SkAutoMutexExclusive ac(shard.fLock);
+        result = this->internalFindStrikeOrNull(&shard, desc);
+    }
+    this->purge();
     return result;
 }
 
-auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<SkStrike> {
+auto SkStrikeCache::internalFindStrikeOrNull(Shard* shard, const SkDescriptor& desc)
+        -> sk_sp<SkStrike> {
 
     // Check head because it is likely the strike we are looking for.
-    if (fHead != nullptr && fHead->getDescriptor() == desc) { return sk_ref_sp(fHead); }
+    SkStrike* head = shard->fHead;
+    if (head != nullptr && head->getDescriptor() == desc) { return sk_ref_sp(head); }
 
     // Do the heavy search looking for the strike.
-    sk_sp<SkStrike>* strikeHandle = fStrikeLookup.find(desc);
+    sk_sp<SkStrike>* strikeHandle = shard->fStrikeLookup.find(desc);
     if (strikeHandle == nullptr) { return nullptr; }
     SkStrike* strikePtr = strikeHandle->get();
     SkASSERT(strikePtr != nullptr);
-    if (fHead != strikePtr) {
+    if (head != strikePtr) {
         // Make most recently used
         strikePtr->fPrev->fNext = strikePtr->fNext;
         if (strikePtr->fNext != nullptr) {
             strikePtr->fNext->fPrev = strikePtr->fPrev;
         } else {
-            fTail = strikePtr->fPrev;
+            shard->fTail = strikePtr->fPrev;
         }
-        fHead->fPrev = strikePtr;
-        strikePtr->fNext = fHead;
+        head->fPrev = strikePtr;
+        strikePtr->fNext = head;
         strikePtr->fPrev = nullptr;
-        fHead = strikePtr;
+        shard->fHead = strikePtr;
     }
     return sk_ref_sp(strikePtr);
 }
@@ -126,57 +200,104 @@ sk_sp<SkStrike> SkStrikeCache::createStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) {
-    SkAutoMutexExclusive ac(fLock);
-    return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
+    Shard& shard = this->shardFor(strikeSpec.descriptor());
+    SkAutoMutexExclusive ac(shard.fLock);
+    return this->internalCreateStrike(&shard, strikeSpec, maybeMetrics, std::move(pinner));
 }
 
 auto SkStrikeCache::internalCreateStrike(
+        Shard* shard,
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) -> sk_sp<SkStrike> {
     std::unique_ptr<SkScalerContext> scaler = strikeSpec.createScalerContext();
     auto strike =
         sk_make_sp<SkStrike>(this, strikeSpec, std::move(scaler), maybeMetrics, std::move(pinner));
-    this->internalAttachToHead(strike);
+    if (SkGlyphPersistentCache* persistentCache = fPersistentCache.load()) {
+        if (sk_sp<SkData> key = persistent_cache_key(strikeSpec)) {
+            if (sk_sp<SkData> data = persistentCache->load(*key)) {
+                // Stale or damaged data leaves the glyphs read so far, which are still valid
+                // glyphs of this strike; the rest come from the scaler context as usual.
+                strike->mergeFromPersistentCache(*data);
+            }
+        }
+    }
+    this->internalAttachToHead(shard, strike);
     return strike;
 }
 
 void SkStrikeCache::purgePinned(size_t minBytesNeeded) {
-    SkAutoMutexExclusive ac(fLock);
-    this->internalPurge(minBytesNeeded, /* checkPinners= */ true);
+    this->purge(minBytesNeeded, /* checkPinners= */ true);
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoMutexExclusive ac(fLock);
-    this->internalPurge(fTotalMemoryUsed, /* checkPinners= */ true);
+    this->purge(fTotalMemoryUsed, /* checkPinners= */ true);
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoMutexExclusive ac(fLock);
     return fTotalMemoryUsed;
 }
 
+void SkStrikeCache::setGlyphRasterExecutor(SkExecutor* executor) {
+    fGlyphRasterExecutor.store(executor, std::memory_order_release);
+}
+
+SkExecutor* SkStrikeCache::glyphRasterExecutor() const {
+    return fGlyphRasterExecutor.load(std::memory_order_acquire);
+}
+
+void SkStrikeCache::setPersistentCache(SkGlyphPersistentCache* persistentCache,
+                                       SkExecutor* storeExecutor) {
+    fPersistentCacheStoreExecutor.store(storeExecutor);
+    fPersistentCache.store(persistentCache);
+}
+
+void SkStrikeCache::storeToPersistentCache() {
+    SkGlyphPersistentCache* persistentCache = fPersistentCache.load();
+    if (persistentCache == nullptr) {
+        return;
+    }
+    // Only the list of strikes is taken under the shard locks; serializing and writing them
+    // happens after, so drawing with the strikes isn't held up by the persistent cache's I/O.
+    std::vector<sk_sp<SkStrike>> strikes;
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive ac(shard.fLock);
+        for (SkStrike* strike = shard.fHead; strike != nullptr; strike = strike->fNext) {
+            strikes.push_back(sk_ref_sp(strike));
+        }
+    }
+    store_strikes(persistentCache, strikes);
+}
+
+void SkStrikeCache::storePurgedStrikes(std::vector<sk_sp<SkStrike>> strikes) {
+    SkGlyphPersistentCache* persistentCache = fPersistentCache.load();
+    if (persistentCache == nullptr || strikes.empty()) {
+        return;
+    }
+    if (SkExecutor* executor = fPersistentCacheStoreExecutor.load()) {
+        executor->add([persistentCache, strikes = std::move(strikes)] {
+            store_strikes(persistentCache, strikes);
+        });
+    } else {
+        store_strikes(persistentCache, strikes);
+    }
+}
+
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoMutexExclusive ac(fLock);
     return fCacheCount;
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoMutexExclusive ac(fLock);
     return fCacheCountLimit;
 }
 
 size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
-    SkAutoMutexExclusive ac(fLock);
-
-    size_t prevLimit = fCacheSizeLimit;
-    fCacheSizeLimit = newLimit;
-    this->internalPurge();
+    size_t prevLimit = fCacheSizeLimit.exchange(newLimit);
+    this->purge();
     return prevLimit;
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoMutexExclusive ac(fLock);
     return fCacheSizeLimit;
 }
 
@@ -185,48 +306,52 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoMutexExclusive ac(fLock);
-
-    int prevCount = fCacheCountLimit;
-    fCacheCountLimit = newCount;
-    this->internalPurge();
+    int prevCount = fCacheCountLimit.exchange(newCount);
+    this->purge();
     return prevCount;
 }
 
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
-    SkAutoMutexExclusive ac(fLock);
+    for (const Shard& shard : fShards) {
+        SkAutoMutexExclusive ac(shard.fLock);
 
-    this->validate();
+        shard.validate();
 
-    for (SkStrike* strike = fHead; strike != nullptr; strike = strike->fNext) {
-        visitor(*strike);
+        for (SkStrike* strike = shard.fHead; strike != nullptr; strike = strike->fNext) {
+            visitor(*strike);
+        }
     }
 }
 
-size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
+size_t SkStrikeCache::purge(size_t minBytesNeeded, bool checkPinners) {
 #ifndef SK_STRIKE_CACHE_DOESNT_AUTO_CHECK_PINNERS
     // Temporarily default to checking pinners, for staging.
     checkPinners = true;
 #endif
 
-    if (fPinnerCount == fCacheCount && !checkPinners)
+    // The totals are read without a lock, so a concurrent purge might already be freeing the same
+    // bytes. At worst that makes this purge larger than strictly needed.
+    const size_t totalMemoryUsed = fTotalMemoryUsed;
+    const int32_t cacheCount = fCacheCount;
+
+    if (fPinnerCount == cacheCount && !checkPinners)
         return 0;
 
     size_t bytesNeeded = 0;
-    if (fTotalMemoryUsed > fCacheSizeLimit) {
-        bytesNeeded = fTotalMemoryUsed - fCacheSizeLimit;
+    if (totalMemoryUsed > fCacheSizeLimit) {
+        bytesNeeded = totalMemoryUsed - fCacheSizeLimit;
     }
     bytesNeeded = std::max(bytesNeeded, minBytesNeeded);
     if (bytesNeeded) {
         // no small purges!
-        bytesNeeded = std::max(bytesNeeded, fTotalMemoryUsed >> 2);
+        bytesNeeded = std::max(bytesNeeded, totalMemoryUsed >> 2);
     }
 
     int countNeeded = 0;
-    if (fCacheCount > fCacheCountLimit) {
-        countNeeded = fCacheCount - fCacheCountLimit;
+    if (cacheCount > fCacheCountLimit) {
+        countNeeded = cacheCount - fCacheCountLimit;
         // no small purges!
-        countNeeded = std::max(countNeeded, fCacheCount >> 2);
+        countNeeded = std::max(countNeeded, cacheCount >> 2);
     }
 
     // early exit
@@ -236,23 +361,42 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
 
     size_t  bytesFreed = 0;
     int     countFreed = 0;
-
-    // Start at the tail and proceed backwards deleting; the list is in LRU
-    // order, with unimportant entries at the tail.
-    SkStrike* strike = fTail;
-    while (strike != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
-        SkStrike* prev = strike->fPrev;
-
-        // Only delete if the strike is not pinned.
-        if (strike->fPinner == nullptr || (checkPinners && strike->fPinner->canDelete())) {
-            bytesFreed += strike->fMemoryUsed;
-            countFreed += 1;
-            this->internalRemoveStrike(strike);
+    // Purged strikes are kept alive until their glyphs are stored, after the shard locks are
+    // released.
+    std::vector<sk_sp<SkStrike>> purged;
+    const bool storePurged = fPersistentCache.load() != nullptr;
+
+    // Each purge starts one shard further along than the last, so that every shard gives up its
+    // least recently used strikes in turn. Only one shard lock is ever held at a time.
+    const int firstIndex =
+            SkToInt(fNextPurgeShard.fetch_add(1, std::memory_order_relaxed) % kShardCount);
+    for (int i = 0; i < kShardCount && (bytesFreed < bytesNeeded || countFreed < countNeeded);
+         ++i) {
+        Shard& shard = fShards[(firstIndex + i) % kShardCount];
+        SkAutoMutexExclusive ac(shard.fLock);
+
+        // Start at the tail and proceed backwards deleting; the list is in LRU
+        // order, with unimportant entries at the tail.
+        SkStrike* strike = shard.fTail;
+        while (strike != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
+            SkStrike* prev = strike->fPrev;
+
+            // Only delete if the strike is not pinned.
+            if (strike->fPinner == nullptr || (checkPinners && strike->fPinner->canDelete())) {
+                bytesFreed += strike->fMemoryUsed;
+                countFreed += 1;
+                if (storePurged) {
+                    purged.push_back(sk_ref_sp(strike));
+                }
+                this->internalRemoveStrike(&shard, strike);
+            }
+            strike = prev;
         }
-        strike = prev;
+
+        shard.validate();
     }
 
-    this->validate();
+    this->storePurgedStrikes(std::move(purged));
 
 #ifdef SPEW_PURGE_STATUS
     if (countFreed) {
@@ -264,30 +408,34 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
     return bytesFreed;
 }
 
-void SkStrikeCache::internalAttachToHead(sk_sp<SkStrike> strike) {
-    SkASSERT(fStrikeLookup.find(strike->getDescriptor()) == nullptr);
+void SkStrikeCache::internalAttachToHead(Shard* shard, sk_sp<SkStrike> strike) {
+    SkASSERT(shard->fStrikeLookup.find(strike->getDescriptor()) == nullptr);
     SkStrike* strikePtr = strike.get();
-    fStrikeLookup.set(std::move(strike));
+    shard->fStrikeLookup.set(std::move(strike));
     SkASSERT(nullptr == strikePtr->fPrev && nullptr == strikePtr->fNext);
 
+    shard->fCacheCount += 1;
+    shard->fTotalMemoryUsed += strikePtr->fMemoryUsed;
     fCacheCount += 1;
     fPinnerCount += strikePtr->fPinner != nullptr ? 1 : 0;
     fTotalMemoryUsed += strikePtr->fMemoryUsed;
 
-    if (fHead != nullptr) {
-        fHead->fPrev = strikePtr;
-        strikePtr->fNext = fHead;
+    if (shard->fHead != nullptr) {
+        shard->fHead->fPrev = strikePtr;
+        strikePtr->fNext = shard->fHead;
     }
 
-    if (fTail == nullptr) {
-        fTail = strikePtr;
+    if (shard->fTail == nullptr) {
+        shard->fTail = strikePtr;
     }
 
-    fHead = strikePtr; // Transfer ownership of strike to the cache list.
+    shard->fHead = strikePtr; // Transfer ownership of strike to the cache list.
 }
 
-void SkStrikeCache::internalRemoveStrike(SkStrike* strike) {
-    SkASSERT(fCacheCount > 0);
+void SkStrikeCache::internalRemoveStrike(Shard* shard, SkStrike* strike) {
+    SkASSERT(shard->fCacheCount > 0);
+    shard->fCacheCount -= 1;
+    shard->fTotalMemoryUsed -= strike->fMemoryUsed;
     fCacheCount -= 1;
     fPinnerCount -= strike->fPinner != nullptr ? 1 : 0;
     fTotalMemoryUsed -= strike->fMemoryUsed;
@@ -295,20 +443,20 @@ void SkStrikeCache::internalRemoveStrike(SkStrike* strike) {
     if (strike->fPrev) {
         strike->fPrev->fNext = strike->fNext;
     } else {
-        fHead = strike->fNext;
+        shard->fHead = strike->fNext;
     }
     if (strike->fNext) {
         strike->fNext->fPrev = strike->fPrev;
     } else {
-        fTail = strike->fPrev;
+        shard->fTail = strike->fPrev;
     }
 
     strike->fPrev = strike->fNext = nullptr;
     strike->fRemoved = true;
-    fStrikeLookup.remove(strike->getDescriptor());
+    shard->fStrikeLookup.remove(strike->getDescriptor());
 }
 
-void SkStrikeCache::validate() const {
+void SkStrikeCache::Shard::validate() const {
 #ifdef SK_DEBUG
     size_t computedBytes = 0;
     int computedCount = 0;
@@ -332,11 +480,11 @@ void SkStrikeCache::validate() const {
 #endif
 }
 
-const SkDescriptor& SkStrikeCache::StrikeTraits::GetKey(const sk_sp<SkStrike>& strike) {
+const SkDescriptor& SkStrikeCache::Shard::StrikeTraits::GetKey(const sk_sp<SkStrike>& strike) {
     return strike->getDescriptor();
 }
 
-uint32_t SkStrikeCache::StrikeTraits::Hash(const SkDescriptor& descriptor) {
+uint32_t SkStrikeCache::Shard::StrikeTraits::Hash(const SkDescriptor& descriptor) {
     return descriptor.getChecksum();
 }
 
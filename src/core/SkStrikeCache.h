@@ -16,12 +16,17 @@
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 class SkDescriptor;
+class SkExecutor;
+class SkGlyphPersistentCache;
 class SkStrikeSpec;
 class SkTraceMemoryDump;
 struct SkFontMetrics;
@@ -44,17 +49,17 @@ public:
 
     static SkStrikeCache* GlobalStrikeCache();
 
-    sk_sp<SkStrike> findStrike(const SkDescriptor& desc) SK_EXCLUDES(fLock);
+    sk_sp<SkStrike> findStrike(const SkDescriptor& desc);
 
     sk_sp<SkStrike> createStrike(
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_EXCLUDES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr);
 
-    sk_sp<SkStrike> findOrCreateStrike(const SkStrikeSpec& strikeSpec) SK_EXCLUDES(fLock);
+    sk_sp<SkStrike> findOrCreateStrike(const SkStrikeSpec& strikeSpec);
 
     sk_sp<sktext::StrikeForGPU> findOrCreateScopedStrike(
-            const SkStrikeSpec& strikeSpec) override SK_EXCLUDES(fLock);
+            const SkStrikeSpec& strikeSpec) override;
 
     static void PurgeAll();
     static void Dump();
@@ -63,55 +68,96 @@ public:
     // SkTraceMemoryDump interface.
     static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
 
-    void purgeAll() SK_EXCLUDES(fLock); // does not change budget
-    void purgePinned(size_t minBytesNeeded = 0) SK_EXCLUDES(fLock);
+    void purgeAll(); // does not change budget
+    void purgePinned(size_t minBytesNeeded = 0);
 
-    int getCacheCountLimit() const SK_EXCLUDES(fLock);
-    int setCacheCountLimit(int limit) SK_EXCLUDES(fLock);
-    int getCacheCountUsed() const SK_EXCLUDES(fLock);
+    int getCacheCountLimit() const;
+    int setCacheCountLimit(int limit);
+    int getCacheCountUsed() const;
 
-    size_t getCacheSizeLimit() const SK_EXCLUDES(fLock);
-    size_t setCacheSizeLimit(size_t limit) SK_EXCLUDES(fLock);
-    size_t getTotalMemoryUsed() const SK_EXCLUDES(fLock);
+    size_t getCacheSizeLimit() const;
+    size_t setCacheSizeLimit(size_t limit);
+    size_t getTotalMemoryUsed() const;
+
+    // If set, strikes rasterize large batches of uncached glyph images on this executor, each
+    // task with its own scaler context. The executor must outlive its use by this cache.
+    void setGlyphRasterExecutor(SkExecutor* executor);
+    SkExecutor* glyphRasterExecutor() const;
+
+    // If set, new strikes start with the glyphs stored for them in the persistent cache, and
+    // strikes store their glyphs there when they are purged or storeToPersistentCache() is
+    // called. Purged strikes are stored on storeExecutor if it is set, and otherwise on the
+    // purging thread once it has released the shard locks. The persistent cache and executor
+    // must outlive their use by this cache.
+    void setPersistentCache(SkGlyphPersistentCache* persistentCache,
+                            SkExecutor* storeExecutor = nullptr);
+    void storeToPersistentCache();
 
 private:
     friend class SkStrike;  // for SkStrike::updateDelta
     static constexpr char kGlyphCacheDumpName[] = "skia/sk_glyph_cache";
-    sk_sp<SkStrike> internalFindStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
+
+    // Strikes are partitioned by descriptor hash into shards, each with its own lock, lookup
+    // table and LRU list, so that threads working on different strikes rarely contend. The
+    // budgets apply to the sum over all shards.
+    inline static constexpr int kShardBits = 4;
+    inline static constexpr int kShardCount = 1 << kShardBits;
+
+    struct Shard {
+        // A simple accounting of what each glyph cache reports and the shard total.
+        void validate() const SK_REQUIRES(fLock);
+
+        mutable SkMutex fLock;
+        SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
+        SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
+        struct StrikeTraits {
+            static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike);
+            static uint32_t Hash(const SkDescriptor& descriptor);
+        };
+        skia_private::THashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup
+                SK_GUARDED_BY(fLock);
+
+        // Per-shard accounting; the cache-wide totals below are the sum over all shards.
+        size_t  fTotalMemoryUsed SK_GUARDED_BY(fLock) {0};
+        int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
+    };
+
+    Shard& shardFor(const SkDescriptor& desc);
+
+    sk_sp<SkStrike> internalFindStrikeOrNull(Shard* shard, const SkDescriptor& desc)
+            SK_REQUIRES(shard->fLock);
     sk_sp<SkStrike> internalCreateStrike(
+            Shard* shard,
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(shard->fLock);
 
-    // The following methods can only be called when mutex is already held.
-    void internalRemoveStrike(SkStrike* strike) SK_REQUIRES(fLock);
-    void internalAttachToHead(sk_sp<SkStrike> strike) SK_REQUIRES(fLock);
+    // The following methods can only be called when the shard's mutex is already held.
+    void internalRemoveStrike(Shard* shard, SkStrike* strike) SK_REQUIRES(shard->fLock);
+    void internalAttachToHead(Shard* shard, sk_sp<SkStrike> strike) SK_REQUIRES(shard->fLock);
 
     // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
-    // and attempt to purge caches to match.
+    // and attempt to purge caches to match. Must be called without any shard lock held.
     // Returns number of bytes freed.
-    size_t internalPurge(size_t minBytesNeeded = 0, bool checkPinners = false) SK_REQUIRES(fLock);
+    size_t purge(size_t minBytesNeeded = 0, bool checkPinners = false);
 
-    // A simple accounting of what each glyph cache reports and the strike cache total.
-    void validate() const SK_REQUIRES(fLock);
+    // Stores the glyphs of strikes that were purged in the persistent cache. Must be called
+    // without any shard lock held.
+    void storePurgedStrikes(std::vector<sk_sp<SkStrike>> strikes);
 
-    void forEachStrike(std::function<void(const SkStrike&)> visitor) const SK_EXCLUDES(fLock);
+    void forEachStrike(std::function<void(const SkStrike&)> visitor) const;
 
-    mutable SkMutex fLock;
-    SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
-    SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
-    struct StrikeTraits {
-        static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike);
-        static uint32_t Hash(const SkDescriptor& descriptor);
-    };
-    skia_private::THashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup
-            SK_GUARDED_BY(fLock);
-
-    size_t  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
-    size_t  fTotalMemoryUsed SK_GUARDED_BY(fLock) {0};
-    int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
-    int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
-    int32_t fPinnerCount SK_GUARDED_BY(fLock) {0};
+    std::array<Shard, kShardCount> fShards;
+
+    std::atomic<size_t>  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
+    std::atomic<size_t>  fTotalMemoryUsed{0};
+    std::atomic<int32_t> fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
+    std::atomic<int32_t> fCacheCount{0};
+    std::atomic<int32_t> fPinnerCount{0};
+    std::atomic<uint32_t> fNextPurgeShard{0};
+    std::atomic<SkExecutor*> fGlyphRasterExecutor{nullptr};
+    std::atomic<SkGlyphPersistentCache*> fPersistentCache{nullptr};
+    std::atomic<SkExecutor*> fPersistentCacheStoreExecutor{nullptr};
 };
 
 #endif  // SkStrikeCache_DEFINED
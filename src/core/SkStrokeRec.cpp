@@ -7,10 +7,14 @@
 
 #include "include/core/SkStrokeRec.h"
 
+#include "include/core/SkPath.h"
+#include "src/base/SkTLazy.h"
 #include "src/core/SkPaintDefaults.h"
+#include "src/core/SkResourceCache.h"
 #include "src/core/SkStroke.h"
 
 #include <algorithm>
+#include <cstdint>
 
 // must be < 0, since ==0 means hairline, and >0 means normal stroke
 #define kStrokeRec_FillStyleWidth     (-SK_Scalar1)
@@ -104,23 +108,92 @@ void SkStrokeRec::setStrokeStyle(SkScalar width, bool strokeAndFill) {
     SkScalar gDebugStrokerError;
 #endif
 
+namespace {
+static unsigned gStrokedPathKeyNamespaceLabel;
+
+// Paths with fewer verbs than this are cheaper to stroke again than to look up, and are often
+// temporaries (lines, rects) that would only churn the cache.
+static constexpr int kMinCachedStrokeVerbs = 8;
+
+struct StrokedPathKey : public SkResourceCache::Key {
+public:
+    StrokedPathKey(const SkPath& path, SkScalar width, SkScalar miterLimit, SkScalar resScale,
+                   uint32_t cap, uint32_t join, bool strokeAndFill)
+        : fGenID(path.getGenerationID())
+        , fFillType(static_cast<uint32_t>(path.getFillType()))
+        , fWidth(width)
+        , fMiterLimit(miterLimit)
+        , fResScale(resScale)
+        , fStyle(cap | (join << 8) | (strokeAndFill << 16))
+    {
+        this->init(&gStrokedPathKeyNamespaceLabel, 0,
+                   sizeof(fGenID) + sizeof(fFillType) + sizeof(fWidth) + sizeof(fMiterLimit) +
+                   sizeof(fResScale) + sizeof(fStyle));
+    }
+
+    uint32_t    fGenID;
+    uint32_t    fFillType;
+    SkScalar    fWidth;
+    SkScalar    fMiterLimit;
+    SkScalar    fResScale;
+    uint32_t    fStyle;
+};
+
+struct StrokedPathRec : public SkResourceCache::Rec {
+    StrokedPathRec(const StrokedPathKey& key, const SkPath& stroked)
+        : fKey(key), fStroked(stroked) {}
+
+    StrokedPathKey fKey;
+    SkPath         fStroked;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fStroked.approximateBytesUsed();
+    }
+    const char* getCategory() const override { return "stroked-path"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const StrokedPathRec& rec = static_cast<const StrokedPathRec&>(baseRec);
+        *static_cast<SkPath*>(contextData) = rec.fStroked;
+        return true;
+    }
+};
+} // namespace
+
 bool SkStrokeRec::applyToPath(SkPath* dst, const SkPath& src) const {
     if (fWidth <= 0) {  // hairline or fill
         return false;
     }
 
+#ifdef SK_DEBUG
+    SkScalar resScale = gDebugStrokerErrorSet ? gDebugStrokerError : fResScale;
+#else
+    SkScalar resScale = fResScale;
+#endif
+
+    // Stroking the same path again (e.g. an icon drawn every frame) reuses the earlier result.
+    // The stroke only depends on the path's contents, so the key is its generation ID.
+    SkTLazy<StrokedPathKey> key;
+    if (!src.isVolatile() && src.countVerbs() >= kMinCachedStrokeVerbs) {
+        key.init(src, fWidth, fMiterLimit, resScale,
+                 (uint32_t)fCap, (uint32_t)fJoin, (bool)fStrokeAndFill);
+        if (SkResourceCache::Find(*key, StrokedPathRec::Visitor, dst)) {
+            return true;
+        }
+    }
+
     SkStroke stroker;
     stroker.setCap((SkPaint::Cap)fCap);
     stroker.setJoin((SkPaint::Join)fJoin);
     stroker.setMiterLimit(fMiterLimit);
     stroker.setWidth(fWidth);
     stroker.setDoFill(fStrokeAndFill);
-#ifdef SK_DEBUG
-    stroker.setResScale(gDebugStrokerErrorSet ? gDebugStrokerError : fResScale);
-#else
-    stroker.setResScale(fResScale);
-#endif
+    stroker.setResScale(resScale);
     stroker.strokePath(src, dst);
+
+    if (key.isValid()) {
+        SkResourceCache::Add(new StrokedPathRec(*key, *dst));
+    }
     return true;
 }
 
@@ -29,7 +29,23 @@ namespace SkOpts {
                            RGB_to_BGR1,     // i.e. swap RB and insert an opaque alpha
                            gray_to_RGB1,    // i.e. expand to color channels + an opaque alpha
                            grayA_to_RGBA,   // i.e. expand to color channels
-                           grayA_to_rgbA;   // i.e. expand to color channels and premultiply
+                           grayA_to_rgbA,   // i.e. expand to color channels and premultiply
+                           RGB16_to_RGB1,   // i.e. keep the high byte and insert an opaque alpha
+                           RGB16_to_BGR1,   // i.e. keep the high byte, swap RB, and insert alpha
+                           RGBA16_to_RGBA,  // i.e. keep the high byte
+                           RGBA16_to_BGRA,  // i.e. keep the high byte and swap RB
+                           RGBA16_to_rgbA,  // i.e. keep the high byte and premultiply
+                           RGBA16_to_bgrA;  // i.e. keep the high byte, swap RB, and premultiply
+
+    using Swizzle_565_u8 = void (*)(uint16_t*, const uint8_t*, int);
+    extern Swizzle_565_u8 gray_to_565;
+
+    using Swizzle_A8_u8 = void (*)(uint8_t*, const uint8_t*, int);
+    extern Swizzle_A8_u8 grayA_to_A8;       // i.e. keep the alpha
+
+    // Looks up each 8-bit index in a table of 256 8888 pixels.
+    using Swizzle_8888_index = void (*)(uint32_t*, const uint8_t*, int, const uint32_t table[]);
+    extern Swizzle_8888_index index_to_8888;
 
     void Init_Swizzler();
 }  // namespace SkOpts
@@ -14,18 +14,24 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkFixed.h"
 #include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "include/private/base/SkTo.h"
 #include "include/utils/SkCustomTypeface.h"
 #include "src/base/SkBitmaskEnum.h"
 #include "src/base/SkEndian.h"
 #include "src/base/SkNoDestructor.h"
 #include "src/base/SkUTF.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkDescriptor.h"
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkFontPriv.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkTypefaceCache.h"
 #include "src/sfnt/SkOTTable_OS_2.h"
@@ -49,6 +55,7 @@
 
 #include <cstddef>
 #include <cstring>
+#include <utility>
 #include <vector>
 
 using namespace skia_private;
@@ -187,8 +194,79 @@ namespace {
 
 }  // namespace
 
+namespace {
+
+// Animating a variable font's axes asks for the same instances over and over. Each new instance is
+// a new typeface, with its own face to parse and its own strikes, so the instances made recently
+// are kept and handed out again.
+class CloneCache {
+public:
+    // The key holds the typeface's ID, then the arguments, with the axis values quantized to 16.16
+    // fixed point (the precision FreeType keeps).
+    using Key = std::vector<uint32_t>;
+
+    static Key MakeKey(SkTypefaceID typefaceID, const SkFontArguments& args) {
+        const SkFontArguments::VariationPosition position = args.getVariationDesignPosition();
+        const SkFontArguments::Palette palette = args.getPalette();
+        Key key;
+        key.reserve(5 + 2 * position.coordinateCount + 2 * palette.overrideCount);
+        key.push_back(typefaceID);
+        key.push_back(SkToU32(args.getCollectionIndex()));
+        key.push_back(SkToU32(position.coordinateCount));
+        for (int i = 0; i < position.coordinateCount; ++i) {
+            key.push_back(position.coordinates[i].axis);
+            key.push_back(SkFloatToFixed(position.coordinates[i].value));
+        }
+        key.push_back(SkToU32(palette.index));
+        key.push_back(SkToU32(palette.overrideCount));
+        for (int i = 0; i < palette.overrideCount; ++i) {
+            key.push_back(palette.overrides[i].index);
+            key.push_back(palette.overrides[i].color);
+        }
+        return key;
+    }
+
+    sk_sp<SkTypeface> find(const Key& key) {
+        SkAutoMutexExclusive lock(fMutex);
+        sk_sp<SkTypeface>* clone = fCache.find(key);
+        return clone ? *clone : nullptr;
+    }
+
+    void add(const Key& key, sk_sp<SkTypeface> clone) {
+        SkAutoMutexExclusive lock(fMutex);
+        fCache.insert_or_update(key, std::move(clone));
+    }
+
+private:
+    struct KeyHash {
+        uint32_t operator()(const Key& key) const {
+            return SkChecksum::Hash32(key.data(), key.size() * sizeof(uint32_t));
+        }
+    };
+
+    inline static constexpr int kMaxCount = 64;
+
+    SkMutex fMutex;
+    SkLRUCache<Key, sk_sp<SkTypeface>, KeyHash> fCache SK_GUARDED_BY(fMutex){kMaxCount};
+};
+
+CloneCache* clone_cache() {
+    static SkNoDestructor<CloneCache> cache;
+    return cache.get();
+}
+
+}  // namespace
+
 sk_sp<SkTypeface> SkTypeface::makeClone(const SkFontArguments& args) const {
-    return this->onMakeClone(args);
+    const CloneCache::Key key = CloneCache::MakeKey(this->uniqueID(), args);
+    if (sk_sp<SkTypeface> clone = clone_cache()->find(key)) {
+        return clone;
+    }
+    sk_sp<SkTypeface> clone = this->onMakeClone(args);
+    if (clone) {
+        clone_cache()->add(key, clone);
+    }
+    return clone;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -243,7 +321,12 @@ sk_sp<SkTypeface> SkTypeface::MakeDeserialize(SkStream* stream, sk_sp<SkFontMgr>
     if (!SkFontDescriptor::Deserialize(stream, &desc)) {
         return nullptr;
     }
+    return MakeFromDescriptor(&desc, std::move(lastResortMgr));
+}
 
+sk_sp<SkTypeface> SkTypeface::MakeFromDescriptor(SkFontDescriptor* descPtr,
+                                                 sk_sp<SkFontMgr> lastResortMgr) {
+    SkFontDescriptor& desc = *descPtr;
     if (desc.hasStream()) {
         for (const DecoderProc& proc : *decoders()) {
             if (proc.id == desc.getFactoryId()) {
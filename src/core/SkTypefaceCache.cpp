@@ -12,58 +12,153 @@
 #include "include/core/SkString.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMutex.h"
+#include "src/base/SkNoDestructor.h"
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
+#include <thread>
 #include <utility>
 
+namespace {
+
+// Epoch-based reclamation for the typeface lists of every SkTypefaceCache. A search announces
+// itself in the current epoch for as long as it reads a list. Readers are counted in
+// cache-line-aligned shards, one per thread, so concurrent searches rarely share a line. After
+// publishing a new list, a writer flips the epoch and waits for the readers of the old one to
+// leave, twice, so that no search that could have seen the old list is still running.
+class ReadEpochs {
+public:
+    int enter() {
+        int epoch = fEpoch.load();
+        fShards[ThreadShard()].fReaders[epoch].fetch_add(1);
+        return epoch;
+    }
+
+    void exit(int epoch) { fShards[ThreadShard()].fReaders[epoch].fetch_sub(1); }
+
+    void synchronize() {
+        SkAutoMutexExclusive lock(fSynchronizeMutex);
+        for (int flips = 0; flips < 2; ++flips) {
+            int old = fEpoch.load();
+            fEpoch.store(old ^ 1);
+            while (this->readers(old) != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    static constexpr int kShardCount = 8;
+
+    static int ThreadShard() {
+        static std::atomic<int> gNextShard{0};
+        static thread_local const int tShard =
+                gNextShard.fetch_add(1, std::memory_order_relaxed) & (kShardCount - 1);
+        return tShard;
+    }
+
+    int64_t readers(int epoch) const {
+        int64_t sum = 0;
+        for (const Shard& shard : fShards) {
+            sum += shard.fReaders[epoch].load();
+        }
+        return sum;
+    }
+
+    struct alignas(64) Shard {
+        std::atomic<int64_t> fReaders[2] = {};
+    };
+
+    std::atomic<int> fEpoch{0};
+    Shard fShards[kShardCount];
+    SkMutex fSynchronizeMutex;
+};
+
+ReadEpochs& read_epochs() {
+    static SkNoDestructor<ReadEpochs> epochs;
+    return *epochs;
+}
+
+}  // namespace
+
 SkTypefaceCache::SkTypefaceCache() {}
 
+SkTypefaceCache::~SkTypefaceCache() {
+    // There can be no searches of a cache that is being destroyed.
+    delete fTypefaces.load();
+}
+
 void SkTypefaceCache::add(sk_sp<SkTypeface> face) {
     const auto limit = SkGraphics::GetTypefaceCacheCountLimit();
 
-    if (fTypefaces.size() >= limit) {
-        this->purge(limit >> 2);
+    SkAutoMutexExclusive lock(fWriteMutex);
+    const Typefaces* typefaces = fTypefaces.load();
+    int numToPurge = 0;
+    if (typefaces && typefaces->size() >= limit) {
+        numToPurge = limit >> 2;
+    }
+    if (limit <= 0) {
+        face = nullptr;
     }
-    if (limit > 0) {
-        fTypefaces.emplace_back(std::move(face));
+    if (numToPurge > 0 || face) {
+        this->update(numToPurge, std::move(face));
     }
 }
 
 sk_sp<SkTypeface> SkTypefaceCache::findByProcAndRef(FindProc proc, void* ctx) const {
-    for (const sk_sp<SkTypeface>& typeface : fTypefaces) {
-        if (proc(typeface.get(), ctx)) {
-            return typeface;
+    ReadEpochs& epochs = read_epochs();
+    int epoch = epochs.enter();
+    sk_sp<SkTypeface> found;
+    if (const Typefaces* typefaces = fTypefaces.load()) {
+        for (const sk_sp<SkTypeface>& typeface : *typefaces) {
+            if (proc(typeface.get(), ctx)) {
+                found = typeface;
+                break;
+            }
         }
     }
-    return nullptr;
+    epochs.exit(epoch);
+    return found;
 }
 
-void SkTypefaceCache::purge(int numToPurge) {
-    int count = fTypefaces.size();
-    int i = 0;
-    while (i < count) {
-        if (fTypefaces[i]->unique()) {
-            fTypefaces.removeShuffle(i);
-            --count;
-            if (--numToPurge == 0) {
-                return;
+void SkTypefaceCache::update(int numToPurge, sk_sp<SkTypeface> face) {
+    const Typefaces* old = fTypefaces.load();
+    auto typefaces = std::make_unique<Typefaces>();
+    if (old) {
+        typefaces->reserve_exact(old->size() + (face ? 1 : 0));
+        for (const sk_sp<SkTypeface>& typeface : *old) {
+            // A typeface only the old list owns can't be gaining owners, except from searches
+            // that find it before it is purged, which keep it alive themselves.
+            if (numToPurge > 0 && typeface->unique()) {
+                --numToPurge;
+                continue;
             }
-        } else {
-            ++i;
+            typefaces->push_back(typeface);
         }
     }
+    if (face) {
+        typefaces->push_back(std::move(face));
+    }
+    fTypefaces.store(typefaces.release());
+    if (old) {
+        read_epochs().synchronize();
+        delete old;
+    }
 }
 
 void SkTypefaceCache::purgeAll() {
-    this->purge(fTypefaces.size());
+    SkAutoMutexExclusive lock(fWriteMutex);
+    if (const Typefaces* typefaces = fTypefaces.load()) {
+        this->update(typefaces->size(), nullptr);
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 SkTypefaceCache& SkTypefaceCache::Get() {
-    static SkTypefaceCache gCache;
-    return gCache;
+    static SkNoDestructor<SkTypefaceCache> gCache;
+    return *gCache;
 }
 
 SkTypefaceID SkTypefaceCache::NewTypefaceID() {
@@ -71,23 +166,15 @@ SkTypefaceID SkTypefaceCache::NewTypefaceID() {
     return nextID.fetch_add(1, std::memory_order_relaxed);
 }
 
-static SkMutex& typeface_cache_mutex() {
-    static SkMutex& mutex = *(new SkMutex);
-    return mutex;
-}
-
 void SkTypefaceCache::Add(sk_sp<SkTypeface> face) {
-    SkAutoMutexExclusive ama(typeface_cache_mutex());
     Get().add(std::move(face));
 }
 
 sk_sp<SkTypeface> SkTypefaceCache::FindByProcAndRef(FindProc proc, void* ctx) {
-    SkAutoMutexExclusive ama(typeface_cache_mutex());
     return Get().findByProcAndRef(proc, ctx);
 }
 
 void SkTypefaceCache::PurgeAll() {
-    SkAutoMutexExclusive ama(typeface_cache_mutex());
     Get().purgeAll();
 }
 
@@ -12,16 +12,30 @@
 
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/base/SkMutex.h"
 #include "include/private/base/SkTArray.h"
+#include "include/private/base/SkThreadAnnotations.h"
 
+#include <atomic>
+
+/**
+ *  A list of typefaces searched by a FindProc. The cache is safe to use from any thread:
+ *  findByProcAndRef() takes no lock and never blocks, while add() and purgeAll() replace the
+ *  list under a lock and free the old one once no search can still be reading it.
+ */
 class SkTypefaceCache {
 public:
     SkTypefaceCache();
+    ~SkTypefaceCache();
+
+    SkTypefaceCache(const SkTypefaceCache&) = delete;
+    SkTypefaceCache& operator=(const SkTypefaceCache&) = delete;
 
     /**
      * Callback for FindByProc. Returns true if the given typeface is a match
      * for the given context. The passed typeface is owned by the cache and is
      * not additionally ref()ed. The typeface may be in the disposed state.
+     * The proc must not add to or purge any SkTypefaceCache.
      */
     typedef bool(*FindProc)(SkTypeface*, void* context);
 
@@ -64,11 +78,17 @@ public:
     static void Dump();
 
 private:
+    using Typefaces = skia_private::TArray<sk_sp<SkTypeface>>;
+
     static SkTypefaceCache& Get();
 
-    void purge(int count);
+    // Replaces fTypefaces with a copy without up to numToPurge of the typefaces only the cache
+    // owns, plus |face| if it isn't null.
+    void update(int numToPurge, sk_sp<SkTypeface> face) SK_REQUIRES(fWriteMutex);
 
-    skia_private::TArray<sk_sp<SkTypeface>> fTypefaces;
+    SkMutex fWriteMutex;
+    // Never modified once published; replaced as a whole by update().
+    std::atomic<const Typefaces*> fTypefaces{nullptr};
 };
 
 #endif
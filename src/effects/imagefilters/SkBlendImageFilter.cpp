@@ -31,6 +31,8 @@
 #include "src/core/SkWriteBuffer.h"
 
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <optional>
 #include <utility>
 
@@ -88,6 +90,22 @@ private:
 
     sk_sp<SkShader> makeBlendShader(sk_sp<SkShader> bg, sk_sp<SkShader> fg) const;
 
+    // Returns the bounds both children must fill to produce this blend's output within 'ctx', or
+    // an empty optional if the blend produces nothing there.
+    std::optional<skif::LayerSpace<SkIRect>> requiredInputBounds(const skif::Context& ctx) const;
+
+    // Returns the child at 'index' if it is a blend filter that can be evaluated as part of this
+    // filter's shader instead of being rendered to its own intermediate image.
+    const SkBlendImageFilter* fusableChild(int index) const;
+
+    // Adds this blend's inputs to 'builder', recursing into fusable children instead of rendering
+    // them, and returns the function that combines the added inputs' shaders into this blend.
+    // 'inputCount' tracks the number of inputs added to 'builder' so far.
+    using FusedShaderFn = std::function<sk_sp<SkShader>(SkSpan<sk_sp<SkShader>>)>;
+    FusedShaderFn addFusedInputs(const skif::Context& inputCtx,
+                                 skif::FilterResult::Builder* builder,
+                                 int* inputCount) const;
+
     sk_sp<SkBlender> fBlender;
 
     // Normally runtime SkBlenders are pessimistic about the bounds they affect. For Arithmetic,
@@ -292,7 +310,8 @@ sk_sp<SkShader> SkBlendImageFilter::makeBlendShader(sk_sp<SkShader> bg, sk_sp<Sk
     return SkShaders::Blend(fBlender, std::move(bg), std::move(fg));
 }
 
-skif::FilterResult SkBlendImageFilter::onFilterImage(const skif::Context& ctx) const {
+std::optional<skif::LayerSpace<SkIRect>> SkBlendImageFilter::requiredInputBounds(
+        const skif::Context& ctx) const {
     // We could just request 'desiredOutput' for the blend's required input size, since that's what
     // it is expected to fill. However, some blend modes restrict the output to something other
     // than the union of the foreground and background. To make this restriction available to both
@@ -306,15 +325,73 @@ skif::FilterResult SkBlendImageFilter::onFilterImage(const skif::Context& ctx) c
     } else {
         requiredInput = ctx.desiredOutput();
     }
+    return requiredInput;
+}
+
+const SkBlendImageFilter* SkBlendImageFilter::fusableChild(int index) const {
+    const SkImageFilter* child = this->getInput(index);
+    // A child that is shared with other parts of the DAG is rendered once and then found in the
+    // image filter cache, so fusing it would evaluate it repeatedly instead.
+    if (!child || !child->unique() ||
+        strcmp(child->getTypeName(), "SkBlendImageFilter") != 0) {
+        return nullptr;
+    }
+    // The child's image would be clamped to [0,1] when it's rendered, which is a no-op for blend
+    // modes but not for arbitrary blenders (e.g. arithmetic without enforcing premul).
+    const auto* blend = static_cast<const SkBlendImageFilter*>(child);
+    return as_BB(blend->fBlender)->asBlendMode().has_value() ? blend : nullptr;
+}
+
+SkBlendImageFilter::FusedShaderFn SkBlendImageFilter::addFusedInputs(
+        const skif::Context& inputCtx,
+        skif::FilterResult::Builder* builder,
+        int* inputCount) const {
+    // Each fused blend nests another SkShaders::Blend in the final shader, so bound the size of the
+    // program that is generated for a long chain of blends.
+    static constexpr int kMaxFusedInputs = 8;
+
+    FusedShaderFn childFns[2];
+    int inputIndices[2] = {-1, -1};
+    for (int i : {kBackground, kForeground}) {
+        const SkBlendImageFilter* child = this->fusableChild(i);
+        if (child && *inputCount + 2 <= kMaxFusedInputs) {
+            // The child's output outside of its required input is transparent black, as it would
+            // be in the child's rendered image, so its inputs can be sampled over this blend's
+            // output bounds.
+            if (auto childInput = child->requiredInputBounds(inputCtx)) {
+                inputCtx.markVisitedImageFilter();
+                childFns[i] = child->addFusedInputs(
+                        inputCtx.withNewDesiredOutput(*childInput), builder, inputCount);
+                continue;
+            }
+        }
+        inputIndices[i] = (*inputCount)++;
+        builder->add(this->getChildOutput(i, inputCtx));
+    }
+
+    return [this, childFns, inputIndices](SkSpan<sk_sp<SkShader>> inputs) {
+        sk_sp<SkShader> shaders[2];
+        for (int i : {kBackground, kForeground}) {
+            shaders[i] = childFns[i] ? childFns[i](inputs) : inputs[inputIndices[i]];
+        }
+        return this->makeBlendShader(std::move(shaders[kBackground]),
+                                     std::move(shaders[kForeground]));
+    };
+}
+
+skif::FilterResult SkBlendImageFilter::onFilterImage(const skif::Context& ctx) const {
+    auto requiredInput = this->requiredInputBounds(ctx);
+    if (!requiredInput) {
+        return {};
+    }
 
+    // Children that are themselves blends are folded into this blend's shader, so a chain of
+    // blends renders its leaf inputs in a single pass instead of one intermediate image per blend.
     skif::Context inputCtx = ctx.withNewDesiredOutput(*requiredInput);
     skif::FilterResult::Builder builder{ctx};
-    builder.add(this->getChildOutput(kBackground, inputCtx));
-    builder.add(this->getChildOutput(kForeground, inputCtx));
-    return builder.eval(
-            [&](SkSpan<sk_sp<SkShader>> inputs) -> sk_sp<SkShader> {
-                return this->makeBlendShader(inputs[kBackground], inputs[kForeground]);
-            }, requiredInput);
+    int inputCount = 0;
+    FusedShaderFn shaderFn = this->addFusedInputs(inputCtx, &builder, &inputCount);
+    return builder.eval(shaderFn, requiredInput);
 }
 
 skif::LayerSpace<SkIRect> SkBlendImageFilter::onGetInputLayerBounds(
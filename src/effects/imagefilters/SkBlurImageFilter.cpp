@@ -28,6 +28,7 @@
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkWriteBuffer.h"
 
 #include <algorithm>
@@ -768,6 +769,41 @@ private:
     skvx::Vec<4, uint32_t>* fBuffer1Cursor;
 };
 
+// Layers with fewer pixels than this are blurred on the calling thread.
+static constexpr int kMinPixelsPerStrip = 128 * 1024;
+static constexpr int kMaxStrips = 16;
+
+// Calls 'blurLines(pass, start, end)' on strips of the lines in [start, end) of a 1D pass, where
+// each line is 'lineLength' pixels long. Every line is blurred independently, so big layers are
+// split into strips that the default SkExecutor may run in parallel, each with its own Pass. The
+// result does not depend on how the lines were split.
+template <typename Fn>
+void for_each_strip(int start, int end, int lineLength, const PassMaker& maker, Fn&& blurLines) {
+    auto blurStrip = [&](int stripStart, int stripEnd) {
+        SkSTArenaAlloc<256> alloc;
+        void* buffer = alloc.makeBytesAlignedTo(maker.bufferSizeBytes(),
+                                                alignof(skvx::Vec<4, uint32_t>));
+        blurLines(maker.makePass(buffer, &alloc), stripStart, stripEnd);
+    };
+
+    const int lineCount = end - start;
+    const int64_t pixels = (int64_t)lineCount * lineLength;
+    const int strips = (int)std::min<int64_t>({pixels / kMinPixelsPerStrip, lineCount, kMaxStrips});
+    if (strips <= 1) {
+        blurStrip(start, end);
+        return;
+    }
+
+    SkTaskGroup tasks;
+    for (int i = 0; i < strips; ++i) {
+        tasks.add([=, &blurStrip] {
+            blurStrip(start + (int)((int64_t)lineCount * i / strips),
+                      start + (int)((int64_t)lineCount * (i + 1) / strips));
+        });
+    }
+    tasks.wait();
+}
+
 // TODO: Implement CPU backend for different fTileMode. This is still worth doing inline with the
 // blur; at the moment the tiling is applied via the CropImageFilter and carried as metadata on
 // the FilterResult. This is forcefully applied in onFilterImage() to get a simple SkSpecialImage to
@@ -833,10 +869,6 @@ sk_sp<SkSpecialImage> cpu_blur(const skif::Context& ctx,
     }
     dst.eraseColor(SK_ColorTRANSPARENT);
 
-    auto buffer = alloc.makeBytesAlignedTo(std::max(makerX->bufferSizeBytes(),
-                                                    makerY->bufferSizeBytes()),
-                                           alignof(skvx::Vec<4, uint32_t>));
-
     // Basic Plan: The three cases to handle
     // * Horizontal and Vertical - blur horizontally while copying values from the source to
     //     the destination. Then, do an in-place vertical blur.
@@ -854,20 +886,21 @@ sk_sp<SkSpecialImage> cpu_blur(const skif::Context& ctx,
         loopStart = std::max(srcBounds.top(),    dstBounds.top());
         loopEnd   = std::min(srcBounds.bottom(), dstBounds.bottom());
 
-        auto srcAddr = src.getAddr32(0, loopStart - srcBounds.top());
-        auto dstAddr = dst.getAddr32(0, loopStart - dstBounds.top());
-
         // Iterate over each row to calculate 1D blur along X.
-        Pass* pass = makerX->makePass(buffer, &alloc);
-        for (int y = loopStart; y < loopEnd; ++y) {
-            pass->blur(srcBounds.left()  - dstBounds.left(),
-                       srcBounds.right() - dstBounds.left(),
-                       dstBounds.width(),
-                       srcAddr, 1,
-                       dstAddr, 1);
-            srcAddr += src.rowBytesAsPixels();
-            dstAddr += dst.rowBytesAsPixels();
-        }
+        for_each_strip(loopStart, loopEnd, dstBounds.width(), *makerX,
+                       [&](Pass* pass, int start, int end) {
+            auto srcAddr = src.getAddr32(0, start - srcBounds.top());
+            auto dstAddr = dst.getAddr32(0, start - dstBounds.top());
+            for (int y = start; y < end; ++y) {
+                pass->blur(srcBounds.left()  - dstBounds.left(),
+                           srcBounds.right() - dstBounds.left(),
+                           dstBounds.width(),
+                           srcAddr, 1,
+                           dstAddr, 1);
+                srcAddr += src.rowBytesAsPixels();
+                dstAddr += dst.rowBytesAsPixels();
+            }
+        });
 
         // Set up the Y pass to blur from the full dst into the non-outset portion of dst
         src = dst;
@@ -885,19 +918,20 @@ sk_sp<SkSpecialImage> cpu_blur(const skif::Context& ctx,
     // Iterate over each column to calculate 1D blur along Y. This is either blurring from src into
     // dst for a 1D blur; or it's blurring from dst into dst for the second pass of a 2D blur.
     if (makerY->window() > 1) {
-        auto srcAddr = src.getAddr32(loopStart - srcBounds.left(), 0);
-        auto dstAddr = dst.getAddr32(loopStart - dstBounds.left(), dstYOffset);
-
-        Pass* pass = makerY->makePass(buffer, &alloc);
-        for (int x = loopStart; x < loopEnd; ++x) {
-            pass->blur(srcBounds.top()    - dstBounds.top(),
-                       srcBounds.bottom() - dstBounds.top(),
-                       dstBounds.height(),
-                       srcAddr, src.rowBytesAsPixels(),
-                       dstAddr, dst.rowBytesAsPixels());
-            srcAddr += 1;
-            dstAddr += 1;
-        }
+        for_each_strip(loopStart, loopEnd, dstBounds.height(), *makerY,
+                       [&](Pass* pass, int start, int end) {
+            auto srcAddr = src.getAddr32(start - srcBounds.left(), 0);
+            auto dstAddr = dst.getAddr32(start - dstBounds.left(), dstYOffset);
+            for (int x = start; x < end; ++x) {
+                pass->blur(srcBounds.top()    - dstBounds.top(),
+                           srcBounds.bottom() - dstBounds.top(),
+                           dstBounds.height(),
+                           srcAddr, src.rowBytesAsPixels(),
+                           dstAddr, dst.rowBytesAsPixels());
+                srcAddr += 1;
+                dstAddr += 1;
+            }
+        });
     }
 
     originalDstBounds.offset(-dstOrigin); // Make relative to dst's pixels
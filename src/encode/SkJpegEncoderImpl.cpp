@@ -11,8 +11,10 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkYUVAInfo.h"
@@ -22,19 +24,23 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkNoncopyable.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "src/base/SkMSAN.h"
 #include "src/codec/SkJpegConstants.h"
 #include "src/codec/SkJpegPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 #include "src/encode/SkJPEGWriteUtility.h"
 #include "src/image/SkImage_Base.h"
 
+#include <algorithm>
 #include <csetjmp>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
 class GrDirectContext;
 class SkColorSpace;
@@ -260,7 +266,8 @@ static std::unique_ptr<SkEncoder> Make(SkWStream* dst,
                                        const SkPixmap* src,
                                        const SkYUVAPixmaps* srcYUVA,
                                        const SkColorSpace* srcYUVAColorSpace,
-                                       const SkJpegEncoder::Options& options) {
+                                       const SkJpegEncoder::Options& options,
+                                       unsigned int restartInterval = 0) {
     // Exactly one of |src| or |srcYUVA| should be specified.
     if (srcYUVA) {
         SkASSERT(!src);
@@ -292,6 +299,11 @@ static std::unique_ptr<SkEncoder> Make(SkWStream* dst,
     }
 
     jpeg_set_quality(encoderMgr->cinfo(), options.fQuality, TRUE);
+    if (restartInterval) {
+        // Bands encoded separately must share the standard Huffman tables to be joined.
+        encoderMgr->cinfo()->optimize_coding = FALSE;
+        encoderMgr->cinfo()->restart_interval = restartInterval;
+    }
     jpeg_start_compress(encoderMgr->cinfo(), TRUE);
 
     // Write XMP metadata. This will only write the standard XMP segment.
@@ -391,9 +403,134 @@ bool SkJpegEncoderImpl::onEncodeRows(int numRows) {
     return true;
 }
 
+// When encoding on an executor, the image is split into bands of whole MCU rows, about this many
+// bytes of source pixels each, independent of the number of threads.
+static constexpr size_t kParallelBandBytes = 128 * 1024;
+
+// Finds the entropy-coded data of a JPEG written by libjpeg-turbo: the bytes between its (only)
+// SOS segment and its EOI marker. Also finds the offset of the image height in its SOF segment.
+static bool find_scan_data(const SkData& jpeg,
+                           size_t* heightOffset,
+                           size_t* scanStart,
+                           size_t* scanEnd) {
+    const uint8_t* bytes = jpeg.bytes();
+    const size_t size = jpeg.size();
+    if (size < 2 * kJpegMarkerCodeSize || bytes[0] != 0xFF ||
+        bytes[1] != kJpegMarkerStartOfImage || bytes[size - 2] != 0xFF ||
+        bytes[size - 1] != kJpegMarkerEndOfImage) {
+        return false;
+    }
+    *heightOffset = 0;
+    size_t offset = kJpegMarkerCodeSize;
+    while (offset + kJpegMarkerCodeSize + kJpegSegmentParameterLengthSize <= size) {
+        if (bytes[offset] != 0xFF) {
+            return false;
+        }
+        const uint8_t marker = bytes[offset + 1];
+        const size_t segmentSize = kJpegMarkerCodeSize + (bytes[offset + 2] << 8 | bytes[offset + 3]);
+        if (marker >= 0xC0 && marker <= 0xC2) {
+            // SOF: marker, length, sample precision, then the 16-bit height.
+            *heightOffset = offset + kJpegMarkerCodeSize + kJpegSegmentParameterLengthSize + 1;
+        }
+        offset += segmentSize;
+        if (marker == kJpegMarkerStartOfScan) {
+            *scanStart = offset;
+            *scanEnd = size - kJpegMarkerCodeSize;
+            return *heightOffset != 0 && *scanStart <= *scanEnd;
+        }
+    }
+    return false;
+}
+
+// Encodes |src| in bands on |options.fExecutor|. Each band but the last is one restart interval,
+// so the scan data of the bands, joined by RSTn markers and behind the headers of the first band,
+// is a baseline JPEG of the whole image. Returns false with nothing written if |src| is too small
+// to split, or can't be encoded.
+static bool encode_in_bands(SkWStream* dst,
+                            const SkPixmap& src,
+                            const SkJpegEncoder::Options& options) {
+    SkASSERT(options.fExecutor);
+    int mcuWidth = 0, mcuHeight = 0, components = 0;
+    {
+        std::unique_ptr<SkJpegEncoderMgr> probe = SkJpegEncoderMgr::Make(dst);
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(probe->errorMgr());
+        if (setjmp(jmp) || !SkPixmapIsValid(src) || !probe->setParams(src.info(), options)) {
+            return false;
+        }
+        const jpeg_compress_struct* cinfo = probe->cinfo();
+        int maxHSamp = 1, maxVSamp = 1;
+        for (int i = 0; i < cinfo->num_components; ++i) {
+            maxHSamp = std::max(maxHSamp, cinfo->comp_info[i].h_samp_factor);
+            maxVSamp = std::max(maxVSamp, cinfo->comp_info[i].v_samp_factor);
+        }
+        mcuWidth = DCTSIZE * maxHSamp;
+        mcuHeight = DCTSIZE * maxVSamp;
+        components = cinfo->input_components;
+    }
+
+    const size_t mcusPerRow = (src.width() + mcuWidth - 1) / mcuWidth;
+    const size_t mcuRowBytes = (size_t)mcuHeight * src.width() * components;
+    // The restart interval, in MCUs, must fit in the 16 bits of the DRI segment.
+    const int bandMcuRows = SkToInt(std::clamp<size_t>(kParallelBandBytes / mcuRowBytes,
+                                                       1,
+                                                       0xFFFF / mcusPerRow));
+    const int bandRows = bandMcuRows * mcuHeight;
+    const int bandCount = (src.height() + bandRows - 1) / bandRows;
+    if (bandCount < 2) {
+        return false;
+    }
+
+    std::vector<sk_sp<SkData>> bands(bandCount);
+    SkTaskGroup tasks(*options.fExecutor);
+    tasks.batch(bandCount, [&](int i) {
+        const int top = i * bandRows;
+        SkPixmap band;
+        SkAssertResult(src.extractSubset(
+                &band, SkIRect::MakeLTRB(0, top, src.width(), std::min(top + bandRows,
+                                                                      src.height()))));
+        SkDynamicMemoryWStream stream;
+        std::unique_ptr<SkEncoder> encoder =
+                Make(&stream, &band, nullptr, nullptr, options, mcusPerRow * bandMcuRows);
+        if (encoder && encoder->encodeRows(band.height())) {
+            bands[i] = stream.detachAsData();
+        }
+    });
+    tasks.wait();
+
+    std::vector<size_t> scanStarts(bandCount), scanEnds(bandCount);
+    size_t heightOffset = 0;
+    for (int i = 0; i < bandCount; ++i) {
+        if (!bands[i] || !find_scan_data(*bands[i], &heightOffset, &scanStarts[i], &scanEnds[i])) {
+            return false;
+        }
+    }
+
+    // The headers of the first band, with the height of the whole image.
+    std::vector<uint8_t> header(bands[0]->bytes(), bands[0]->bytes() + scanStarts[0]);
+    header[heightOffset + 0] = (uint8_t)(src.height() >> 8);
+    header[heightOffset + 1] = (uint8_t)(src.height() & 0xFF);
+    bool success = dst->write(header.data(), header.size());
+    for (int i = 0; i < bandCount; ++i) {
+        if (i > 0) {
+            const uint8_t restart[] = {0xFF, (uint8_t)(JPEG_RST0 + ((i - 1) & 7))};
+            success = success && dst->write(restart, sizeof(restart));
+        }
+        success = success && dst->write(bands[i]->bytes() + scanStarts[i],
+                                        scanEnds[i] - scanStarts[i]);
+    }
+    const uint8_t endOfImage[] = {0xFF, kJpegMarkerEndOfImage};
+    return success && dst->write(endOfImage, sizeof(endOfImage));
+}
+
 namespace SkJpegEncoder {
 
 bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
+    if (options.fExecutor) {
+        SkDynamicMemoryWStream banded;
+        if (encode_in_bands(&banded, src, options)) {
+            return banded.writeToAndReset(dst);
+        }
+    }
     auto encoder = Make(dst, src, options);
     return encoder.get() && encoder->encodeRows(src.height());
 }
@@ -13,6 +13,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -24,9 +25,11 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkNoncopyable.h"
 #include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
 #include "modules/skcms/skcms.h"
 #include "src/base/SkMSAN.h"
 #include "src/codec/SkPngPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 #include "src/image/SkImage_Base.h"
@@ -34,6 +37,7 @@
 #include <algorithm>
 #include <csetjmp>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <utility>
@@ -42,6 +46,8 @@
 #include <png.h>
 #include <pngconf.h>
 
+#include "zlib.h"  // NO_G3_REWRITE
+
 class GrDirectContext;
 class SkImage;
 
@@ -81,7 +87,14 @@ public:
     bool setColorSpace(const SkImageInfo& info, const SkPngEncoder::Options& options);
     bool writeInfo(const SkImageInfo& srcInfo);
     void chooseProc(const SkImageInfo& srcInfo);
+    void chooseParallelEncoding(const SkImageInfo& srcInfo, const SkPngEncoder::Options& options);
+
+    // Only used when parallelEncoding() is true. Encodes the rows of |src| before |endRow|, and
+    // finishes the png after the last row. Rows are encoded in batches of bands that do not
+    // depend on how the rows were passed in, so rows at the end may wait for a later call.
+    bool encodeRowsInParallel(const SkPixmap& src, int endRow);
 
+    bool parallelEncoding() const { return fExecutor != nullptr; }
     png_structp pngPtr() { return fPngPtr; }
     png_infop infoPtr() { return fInfoPtr; }
     int pngBytesPerPixel() const { return fPngBytesPerPixel; }
@@ -92,10 +105,26 @@ public:
 private:
     SkPngEncoderMgr(png_structp pngPtr, png_infop infoPtr) : fPngPtr(pngPtr), fInfoPtr(infoPtr) {}
 
+    void transformRow(const SkPixmap& src, int y, uint8_t* dst) const;
+    bool encodeBatch(const SkPixmap& src, int batchStart, int batchRows);
+    bool writeIDAT(const SkData& band, bool first, bool last);
+
     png_structp fPngPtr;
     png_infop fInfoPtr;
     int fPngBytesPerPixel;
     transform_scanline_proc fProc;
+
+    // State for encodeRowsInParallel().
+    SkExecutor* fExecutor = nullptr;
+    int fFilters = 0;
+    int fZLibLevel = 0;
+    int fZLibStrategy = Z_DEFAULT_STRATEGY;
+    bool fStripFiller = false;    // Rows are transformed to RGBA but written as RGB.
+    size_t fPngRowBytes = 0;      // Bytes per row in the png, excluding the filter type byte.
+    int fRowsPerBand = 0;
+    int fNextRow = 0;             // The first row that has not been encoded yet.
+    uLong fAdler = 1;             // adler32 of the filtered rows written so far.
+    std::vector<uint8_t> fDictionary;  // Up to the last 32K of filtered rows written so far.
 };
 
 std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
@@ -433,6 +462,293 @@ bool SkPngEncoderMgr::writeInfo(const SkImageInfo& srcInfo) {
 
 void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) { fProc = choose_proc(srcInfo); }
 
+// Rows are filtered and compressed in bands of about this many bytes (of filtered data)...
+static constexpr size_t kParallelBandBytes = 128 * 1024;
+// ... and this many bands at a time, to bound the memory used for filtered and compressed rows.
+static constexpr int kParallelBandsPerBatch = 64;
+// Each band is compressed with the end of the data before it as its dictionary.
+static constexpr size_t kDictionarySize = 32 * 1024;
+
+void SkPngEncoderMgr::chooseParallelEncoding(const SkImageInfo& srcInfo,
+                                             const SkPngEncoder::Options& options) {
+    fStripFiller = kRGBA_F16_SkColorType == srcInfo.colorType() &&
+                   kOpaque_SkAlphaType == srcInfo.alphaType();
+    fPngRowBytes = (size_t)(fStripFiller ? 6 : fPngBytesPerPixel) * srcInfo.width();
+
+    // Smaller images are not worth splitting up.
+    const size_t filteredBytes = (fPngRowBytes + 1) * srcInfo.height();
+    if (!options.fExecutor || !fProc || filteredBytes < 2 * kParallelBandBytes) {
+        return;
+    }
+    fExecutor = options.fExecutor;
+    fRowsPerBand = SkToInt(std::max<size_t>(1, kParallelBandBytes / (fPngRowBytes + 1)));
+    fFilters = (int)options.fFilterFlags & (int)SkPngEncoder::FilterFlag::kAll;
+    if (fFilters == 0) {
+        fFilters = PNG_FILTER_NONE;
+    }
+    fZLibLevel = std::min(std::max(0, options.fZLibLevel), 9);
+    // These match libpng's defaults for the IDAT stream.
+    fZLibStrategy = fFilters == PNG_FILTER_NONE ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+}
+
+void SkPngEncoderMgr::transformRow(const SkPixmap& src, int y, uint8_t* dst) const {
+    fProc((char*)dst, (const char*)src.addr(0, y), src.width(),
+          SkColorTypeBytesPerPixel(src.colorType()));
+    if (fStripFiller) {
+        // What png_set_filler() does for the serial encoder.
+        for (int x = 0; x < src.width(); ++x) {
+            memmove(dst + 6 * x, dst + 8 * x, 6);
+        }
+    }
+}
+
+static uint8_t paeth_predictor(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return (uint8_t)a;
+    }
+    return (uint8_t)(pb <= pc ? b : c);
+}
+
+static void apply_filter(int filter, uint8_t* dst, const uint8_t* row, const uint8_t* prev,
+                         size_t n, size_t bpp) {
+    switch (filter) {
+        case PNG_FILTER_NONE:
+            *dst++ = PNG_FILTER_VALUE_NONE;
+            memcpy(dst, row, n);
+            break;
+        case PNG_FILTER_SUB:
+            *dst++ = PNG_FILTER_VALUE_SUB;
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = (uint8_t)(row[i] - (i >= bpp ? row[i - bpp] : 0));
+            }
+            break;
+        case PNG_FILTER_UP:
+            *dst++ = PNG_FILTER_VALUE_UP;
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = (uint8_t)(row[i] - prev[i]);
+            }
+            break;
+        case PNG_FILTER_AVG:
+            *dst++ = PNG_FILTER_VALUE_AVG;
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = (uint8_t)(row[i] - (((i >= bpp ? row[i - bpp] : 0) + prev[i]) >> 1));
+            }
+            break;
+        case PNG_FILTER_PAETH:
+            *dst++ = PNG_FILTER_VALUE_PAETH;
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = (uint8_t)(row[i] - (i >= bpp ? paeth_predictor(row[i - bpp], prev[i],
+                                                                        prev[i - bpp])
+                                                      : prev[i]));
+            }
+            break;
+        default:
+            SkUNREACHABLE;
+    }
+}
+
+// Writes the filter type byte and the n filtered bytes of |row| to |dst|. If more than one filter
+// is allowed, this uses the same heuristic as libpng: the filter with the smallest sum of the
+// absolute values of the filtered bytes (as signed bytes). |scratch| must hold n + 1 bytes.
+static void filter_row(int filters, uint8_t* dst, uint8_t* scratch, const uint8_t* row,
+                       const uint8_t* prev, size_t n, size_t bpp) {
+    if ((filters & (filters - 1)) == 0) {
+        apply_filter(filters, dst, row, prev, n, bpp);
+        return;
+    }
+    uint8_t* best = nullptr;
+    uint64_t bestSum = 0;
+    for (int filter : {PNG_FILTER_NONE, PNG_FILTER_SUB, PNG_FILTER_UP, PNG_FILTER_AVG,
+                       PNG_FILTER_PAETH}) {
+        if (!(filters & filter)) {
+            continue;
+        }
+        uint8_t* candidate = best == dst ? scratch : dst;
+        apply_filter(filter, candidate, row, prev, n, bpp);
+        uint64_t sum = 0;
+        for (size_t i = 1; i <= n; ++i) {
+            sum += candidate[i] < 128 ? candidate[i] : 256 - candidate[i];
+        }
+        if (!best || sum < bestSum) {
+            best = candidate;
+            bestSum = sum;
+        }
+    }
+    if (best != dst) {
+        memcpy(dst, best, n + 1);
+    }
+}
+
+// Compresses |length| bytes at |data| as raw deflate data, primed with the |dictionaryLength|
+// bytes before it. Unless |last|, the output ends with a sync flush, so that the next band's
+// output can follow it in the same zlib stream.
+static sk_sp<SkData> deflate_band(const uint8_t* data, size_t length, size_t dictionaryLength,
+                                  bool last, int level, int strategy) {
+    z_stream zStream = {};
+    if (Z_OK != deflateInit2(&zStream, level, Z_DEFLATED, -MAX_WBITS, 8, strategy)) {
+        return nullptr;
+    }
+    if (dictionaryLength > 0) {
+        deflateSetDictionary(&zStream, data - dictionaryLength, SkToUInt(dictionaryLength));
+    }
+    SkDynamicMemoryWStream out;
+    uint8_t buffer[16384];
+    zStream.next_in = const_cast<uint8_t*>(data);
+    zStream.avail_in = SkToUInt(length);
+    int result;
+    do {
+        zStream.next_out = buffer;
+        zStream.avail_out = sizeof(buffer);
+        result = deflate(&zStream, last ? Z_FINISH : Z_SYNC_FLUSH);
+        out.write(buffer, sizeof(buffer) - zStream.avail_out);
+    } while (result == Z_OK && (zStream.avail_in || !zStream.avail_out));
+    (void)deflateEnd(&zStream);
+    if (result != (last ? Z_STREAM_END : Z_OK)) {
+        return nullptr;
+    }
+    return out.detachAsData();
+}
+
+// The header deflate() would write for this level and strategy.
+static void zlib_header(int level, int strategy, uint8_t header[2]) {
+    unsigned levelFlags = (strategy >= Z_HUFFMAN_ONLY || level < 2) ? 0
+                        : level < 6                                 ? 1
+                        : level == 6                                ? 2
+                                                                    : 3;
+    unsigned bits = ((Z_DEFLATED + ((MAX_WBITS - 8) << 4)) << 8) | (levelFlags << 6);
+    bits += 31 - (bits % 31);
+    header[0] = (uint8_t)(bits >> 8);
+    header[1] = (uint8_t)bits;
+}
+
+bool SkPngEncoderMgr::writeIDAT(const SkData& band, bool first, bool last) {
+    if (setjmp(png_jmpbuf(fPngPtr))) {
+        return false;
+    }
+
+    uint8_t header[2];
+    zlib_header(fZLibLevel, fZLibStrategy, header);
+    const uint8_t adler[4] = {(uint8_t)(fAdler >> 24), (uint8_t)(fAdler >> 16),
+                              (uint8_t)(fAdler >> 8), (uint8_t)fAdler};
+    const size_t length = (first ? sizeof(header) : 0) + band.size() + (last ? sizeof(adler) : 0);
+    if (length > PNG_UINT_31_MAX) {
+        return false;
+    }
+
+    png_write_chunk_start(fPngPtr, (png_const_bytep)"IDAT", (png_uint_32)length);
+    if (first) {
+        png_write_chunk_data(fPngPtr, header, sizeof(header));
+    }
+    png_write_chunk_data(fPngPtr, band.bytes(), band.size());
+    if (last) {
+        png_write_chunk_data(fPngPtr, adler, sizeof(adler));
+    }
+    png_write_chunk_end(fPngPtr);
+    if (last) {
+        // png_write_end() would check for rows written through libpng, but there is nothing else
+        // for it to write after the image data.
+        png_write_chunk(fPngPtr, (png_const_bytep)"IEND", nullptr, 0);
+    }
+    return true;
+}
+
+bool SkPngEncoderMgr::encodeRowsInParallel(const SkPixmap& src, int endRow) {
+    SkASSERT(fExecutor);
+    const int rowsPerBatch = fRowsPerBand * kParallelBandsPerBatch;
+    while (fNextRow < endRow) {
+        const int batchRows = std::min(rowsPerBatch, endRow - fNextRow);
+        if (batchRows < rowsPerBatch && endRow < src.height()) {
+            break;
+        }
+        if (!this->encodeBatch(src, fNextRow, batchRows)) {
+            return false;
+        }
+        fNextRow += batchRows;
+    }
+    return true;
+}
+
+bool SkPngEncoderMgr::encodeBatch(const SkPixmap& src, int batchStart, int batchRows) {
+    const size_t bpp = std::max<size_t>(1, fPngRowBytes / src.width());
+    const size_t filteredRowBytes = fPngRowBytes + 1;
+    const size_t transformedRowBytes = (size_t)fPngBytesPerPixel * src.width();
+    const int rowsPerBand = fRowsPerBand;
+    const int numBands = (batchRows + rowsPerBand - 1) / rowsPerBand;
+    const bool lastBatch = batchStart + batchRows == src.height();
+
+    // The filtered rows, after the end of the rows filtered before this batch, so that every
+    // band can find its dictionary right before it.
+    const size_t dictionaryLength = fDictionary.size();
+    std::vector<uint8_t> filtered(dictionaryLength + (size_t)batchRows * filteredRowBytes);
+    if (dictionaryLength) {
+        memcpy(filtered.data(), fDictionary.data(), dictionaryLength);
+    }
+    uint8_t* batch = filtered.data() + dictionaryLength;
+
+    // Bands are filtered first, since each band needs the filtered data before it to be
+    // compressed.
+    SkTaskGroup tasks(*fExecutor);
+    tasks.batch(numBands, [&](int band) {
+        const int y0 = batchStart + band * rowsPerBand;
+        const int y1 = std::min(y0 + rowsPerBand, batchStart + batchRows);
+        std::unique_ptr<uint8_t[]> storage(new uint8_t[3 * transformedRowBytes + 1]);
+        uint8_t* row = storage.get();
+        uint8_t* prev = row + transformedRowBytes;
+        uint8_t* scratch = prev + transformedRowBytes;
+        if (y0 > 0) {
+            this->transformRow(src, y0 - 1, prev);
+        } else {
+            memset(prev, 0, transformedRowBytes);
+        }
+        for (int y = y0; y < y1; ++y) {
+            const uint8_t* srcRow = (const uint8_t*)src.addr(0, y);
+            sk_msan_assert_initialized(srcRow, srcRow + (src.width() << src.shiftPerPixel()));
+            this->transformRow(src, y, row);
+            filter_row(fFilters, batch + (size_t)(y - batchStart) * filteredRowBytes, scratch, row,
+                       prev, fPngRowBytes, bpp);
+            std::swap(row, prev);
+        }
+    });
+    tasks.wait();
+
+    auto bandOffset = [&](int band) { return (size_t)band * rowsPerBand * filteredRowBytes; };
+    auto bandLength = [&](int band) {
+        return std::min((size_t)rowsPerBand * filteredRowBytes,
+                        (size_t)batchRows * filteredRowBytes - bandOffset(band));
+    };
+
+    std::vector<sk_sp<SkData>> compressed(numBands);
+    std::vector<uLong> adlers(numBands);
+    tasks.batch(numBands, [&](int band) {
+        const size_t offset = bandOffset(band);
+        const size_t length = bandLength(band);
+        const uint8_t* data = batch + offset;
+        adlers[band] = adler32(1, data, SkToUInt(length));
+        compressed[band] = deflate_band(data, length,
+                                        std::min(dictionaryLength + offset, kDictionarySize),
+                                        lastBatch && band == numBands - 1,
+                                        fZLibLevel, fZLibStrategy);
+    });
+    tasks.wait();
+
+    for (int band = 0; band < numBands; ++band) {
+        if (!compressed[band]) {
+            return false;
+        }
+        fAdler = adler32_combine(fAdler, adlers[band], (z_off_t)bandLength(band));
+        const bool last = lastBatch && band == numBands - 1;
+        if (!this->writeIDAT(*compressed[band], batchStart == 0 && band == 0, last)) {
+            return false;
+        }
+    }
+
+    const size_t keep = std::min(filtered.size(), kDictionarySize);
+    fDictionary.assign(filtered.end() - keep, filtered.end());
+    return true;
+}
+
 SkPngEncoderImpl::SkPngEncoderImpl(std::unique_ptr<SkPngEncoderMgr> encoderMgr, const SkPixmap& src)
         : SkEncoder(src, encoderMgr->pngBytesPerPixel() * src.width())
         , fEncoderMgr(std::move(encoderMgr)) {}
@@ -440,6 +756,11 @@ SkPngEncoderImpl::SkPngEncoderImpl(std::unique_ptr<SkPngEncoderMgr> encoderMgr,
 SkPngEncoderImpl::~SkPngEncoderImpl() {}
 
 bool SkPngEncoderImpl::onEncodeRows(int numRows) {
+    if (fEncoderMgr->parallelEncoding()) {
+        fCurrRow += numRows;
+        return fEncoderMgr->encodeRowsInParallel(fSrc, fCurrRow);
+    }
+
     if (setjmp(png_jmpbuf(fEncoderMgr->pngPtr()))) {
         return false;
     }
@@ -490,6 +811,7 @@ std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Optio
     }
 
     encoderMgr->chooseProc(src.info());
+    encoderMgr->chooseParallelEncoding(src.info(), options);
 
     return std::make_unique<SkPngEncoderImpl>(std::move(encoderMgr), src);
 }
@@ -142,6 +142,25 @@ std::pair<const void*, SkIRect> Plot::prepareForUpload() {
     return { dataPtr, offsetRect };
 }
 
+bool Plot::copyFrom(const Plot& that) {
+    SkASSERT(fWidth == that.fWidth && fHeight == that.fHeight);
+    SkASSERT(fBytesPerPixel == that.fBytesPerPixel);
+    if (!that.fData) {
+        return false;
+    }
+
+    const size_t size = fBytesPerPixel * fWidth * fHeight;
+    if (!fData) {
+        fData = reinterpret_cast<unsigned char*>(sk_malloc_throw(size));
+    }
+    memcpy(fData, that.fData, size);
+    fRectanizer.copyFrom(that.fRectanizer);
+
+    fDirtyRect.setWH(fWidth, fHeight);
+    SkDEBUGCODE(fDirty = true;)
+    return true;
+}
+
 void Plot::resetRects() {
     fRectanizer.reset();
     fGenID = fGenerationCounter->next();
@@ -479,6 +479,15 @@ public:
     std::pair<const void*, SkIRect> prepareForUpload();
     void resetRects();
 
+    /**
+     * Replaces the subimages in this plot with copies of those in 'that', which must be the same
+     * size, and marks the whole plot as needing an upload. Each subimage keeps its position
+     * relative to the plot's offset. Returns false, leaving this plot unchanged, if 'that' has no
+     * backing data to copy.
+     */
+    bool copyFrom(const Plot& that);
+    SkIPoint16 offset() const { return fOffset; }
+
     /**
      * Create a clone of this plot. The cloned plot will take the place of the current plot in
      * the atlas
@@ -463,6 +463,13 @@ struct TextureUploadWriter : public BufferWriter {
         SkRectMemcpy(dst, dstRowBytes, src, srcRowBytes, trimRowBytes, rowCount);
     }
 
+    // Returns the address of the `size` bytes starting at `offset`, for image data that the caller
+    // produces in place instead of copying from elsewhere with write().
+    void* writableAddr(size_t offset, size_t size) {
+        this->validate(offset + size);
+        return SkTAddOffset<void>(fPtr, offset);
+    }
+
     void convertAndWrite(size_t offset,
                          const SkImageInfo& srcInfo, const void* src, size_t srcRowBytes,
                          const SkImageInfo& dstInfo, size_t dstRowBytes) {
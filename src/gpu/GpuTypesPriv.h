@@ -9,8 +9,11 @@
 #define skgpu_GpuTypesPriv_DEFINED
 
 #include "include/core/SkTypes.h"
+#include "include/gpu/GpuTypes.h"
+#include "src/core/SkCounters.h"
 
 #include <chrono>
+#include <cstdint>
 
 namespace skgpu {
 
@@ -23,6 +26,49 @@ using StdSteadyClock = std::chrono::monotonic_clock;
 using StdSteadyClock = std::chrono::steady_clock;
 #endif
 
+// The counters behind GpuCounters.
+enum class GpuCounter : int {
+    kPipelineCompiles,
+    kPipelineCompileNanos,
+    kTextureUploadBytes,
+    kRenderPasses,
+    kDrawsRecorded,
+    kDrawCalls,
+
+    kLast = kDrawCalls,
+};
+static constexpr int kGpuCounterCount = static_cast<int>(GpuCounter::kLast) + 1;
+
+// The always-on counters of one GPU context. They are sharded (see SkShardedCounters), so Graphite
+// Recorders on different threads can count into their shared context without contending.
+class GpuCounterSet {
+public:
+    void add(GpuCounter counter, uint64_t n = 1) { fCounters.add(static_cast<int>(counter), n); }
+
+    // Counts a pipeline compile that began at 'start'.
+    void addPipelineCompile(StdSteadyClock::time_point start) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                StdSteadyClock::now() - start);
+        this->add(GpuCounter::kPipelineCompiles);
+        this->add(GpuCounter::kPipelineCompileNanos, static_cast<uint64_t>(elapsed.count()));
+    }
+
+    GpuCounters snapshot() const {
+        auto get = [this](GpuCounter counter) { return fCounters.get(static_cast<int>(counter)); };
+        GpuCounters counters;
+        counters.fPipelineCompiles     = get(GpuCounter::kPipelineCompiles);
+        counters.fPipelineCompileNanos = get(GpuCounter::kPipelineCompileNanos);
+        counters.fTextureUploadBytes   = get(GpuCounter::kTextureUploadBytes);
+        counters.fRenderPasses         = get(GpuCounter::kRenderPasses);
+        counters.fDrawsRecorded        = get(GpuCounter::kDrawsRecorded);
+        counters.fDrawCalls            = get(GpuCounter::kDrawCalls);
+        return counters;
+    }
+
+private:
+    SkShardedCounters<kGpuCounterCount> fCounters;
+};
+
 } // namespace skgpu
 
 #endif // skgpu_GpuTypesPriv_DEFINED
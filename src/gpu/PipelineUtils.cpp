@@ -8,6 +8,7 @@
 #include "src/gpu/PipelineUtils.h"
 
 #include "include/gpu/ShaderErrorHandler.h"
+#include "src/core/SkTraceEvent.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLProgramKind.h"
 #include "src/sksl/SkSLProgramSettings.h"
@@ -15,6 +16,7 @@
 #include "src/sksl/ir/SkSLProgram.h"
 #include "src/utils/SkShaderUtils.h"
 
+#include <chrono>
 #include <string>
 
 namespace skgpu {
@@ -27,15 +29,36 @@ bool SkSLToBackend(const SkSL::ShaderCaps* caps,
                    const SkSL::ProgramSettings& settings,
                    std::string* output,
                    SkSL::ProgramInterface* outInterface,
-                   ShaderErrorHandler* errorHandler) {
+                   ShaderErrorHandler* errorHandler,
+                   ShaderCompileTimes* times) {
 #ifdef SK_DEBUG
     std::string src = SkShaderUtils::PrettyPrint(sksl);
 #else
     const std::string& src = sksl;
 #endif
+    using Clock = std::chrono::steady_clock;
+    auto elapsed = [](Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    };
+
     SkSL::Compiler compiler;
+    auto start = Clock::now();
     std::unique_ptr<SkSL::Program> program = compiler.convertProgram(programKind, src, settings);
-    if (!program || !(*toBackend)(*program, caps, output)) {
+    if (times) {
+        std::chrono::nanoseconds convertTime = elapsed(start);
+        times->fParse += convertTime - compiler.lastOptimizeTime();
+        times->fOptimize += compiler.lastOptimizeTime();
+    }
+    bool generated = false;
+    if (program) {
+        TRACE_EVENT0("skia.shaders", "SkSL::codegen");
+        start = Clock::now();
+        generated = (*toBackend)(*program, caps, output);
+        if (times) {
+            times->fCodegen += elapsed(start);
+        }
+    }
+    if (!generated) {
         errorHandler->compileError(src.c_str(),
                                    compiler.errorText().c_str(),
                                    /*shaderWasCached=*/false);
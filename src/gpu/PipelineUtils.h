@@ -8,6 +8,7 @@
 #ifndef skgpu_PipelineUtils_DEFINED
 #define skgpu_PipelineUtils_DEFINED
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 
@@ -25,7 +26,18 @@ namespace skgpu {
 
 class ShaderErrorHandler;
 
-/** Wrapper for the SkSL compiler with useful logging and error handling. */
+/** Where the time building a program's shaders went. Each stage sums over the program's shaders. */
+struct ShaderCompileTimes {
+    std::chrono::nanoseconds fParse{0};     // SkSL parsing and IR generation
+    std::chrono::nanoseconds fOptimize{0};  // SkSL finalization, inlining and optimization
+    std::chrono::nanoseconds fCodegen{0};   // SkSL IR to the backend's shading language
+    std::chrono::nanoseconds fDriver{0};    // The driver compiling and linking the result
+};
+
+/**
+ * Wrapper for the SkSL compiler with useful logging and error handling. If 'times' is not null,
+ * the time spent in each SkSL stage is added to it.
+ */
 bool SkSLToBackend(const SkSL::ShaderCaps* caps,
                    bool (*toBackend)(SkSL::Program&, const SkSL::ShaderCaps*, std::string*),
                    const char* backendLabel,
@@ -34,7 +46,8 @@ bool SkSLToBackend(const SkSL::ShaderCaps* caps,
                    const SkSL::ProgramSettings& settings,
                    std::string* output,
                    SkSL::ProgramInterface* outInterface,
-                   ShaderErrorHandler* errorHandler);
+                   ShaderErrorHandler* errorHandler,
+                   ShaderCompileTimes* times = nullptr);
 
 }  // namespace skgpu
 
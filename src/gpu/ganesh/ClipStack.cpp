@@ -1139,6 +1139,10 @@ static constexpr int kMaskStackIncrement = 4;
 // Historically we limited it to 4 based on Blink's call pattern, so we keep the limit as-is since
 // it's so close to the empirically encountered max.
 static constexpr int kMaxAnalyticFPs = 4;
+// Clip elements that can't be analytic FPs are drawn into the atlas path renderer's per-flush
+// coverage atlas and sampled by their own FP, which keeps draws under complex clips batchable
+// without stencil or an extra pass. They all sample the same atlas, so they get their own budget.
+static constexpr int kMaxAtlasClipFPs = 4;
 // The number of stack-allocated mask pointers to store before extending the arrays.
 // Stack size determined empirically, the maximum number of elements put in a SW mask was 4
 // across our set of GMs, SKPs, and SVGs used for testing.
@@ -1356,6 +1360,7 @@ GrClip::Effect ClipStack::apply(GrRecordingContext* rContext,
     SkDEBUGCODE(bool opClippedInternally = false;)
 
     int remainingAnalyticFPs = kMaxAnalyticFPs;
+    int remainingAtlasClipFPs = kMaxAtlasClipFPs;
 
     // If window rectangles are supported, we can use them to exclude inner bounds of difference ops
     int maxWindowRectangles = sdc->maxWindowRectangles();
@@ -1438,17 +1443,21 @@ GrClip::Effect ClipStack::apply(GrRecordingContext* rContext,
                     std::tie(fullyApplied, clipFP) = analytic_clip_fp(e.asElement(),
                                                                       *caps->shaderCaps(),
                                                                       std::move(clipFP));
-                    if (!fullyApplied && atlasPathRenderer) {
-                        std::tie(fullyApplied, clipFP) = clip_atlas_fp(sdc, op,
-                                                                       atlasPathRenderer,
-                                                                       scissorBounds, e.asElement(),
-                                                                       std::move(clipFP));
-                    }
                     if (fullyApplied) {
                         remainingAnalyticFPs--;
                     }
                 }
 
+                if (!fullyApplied && atlasPathRenderer && remainingAtlasClipFPs > 0) {
+                    std::tie(fullyApplied, clipFP) = clip_atlas_fp(sdc, op,
+                                                                   atlasPathRenderer,
+                                                                   scissorBounds, e.asElement(),
+                                                                   std::move(clipFP));
+                    if (fullyApplied) {
+                        remainingAtlasClipFPs--;
+                    }
+                }
+
                 if (!fullyApplied) {
                     elementsForMask.push_back(&e.asElement());
                     maskRequiresAA |= (e.aa() == GrAA::kYes);
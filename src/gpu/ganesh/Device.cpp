@@ -77,6 +77,7 @@
 #include "src/gpu/ganesh/GrFragmentProcessor.h"
 #include "src/gpu/ganesh/GrFragmentProcessors.h"
 #include "src/gpu/ganesh/GrImageInfo.h"
+#include "src/gpu/ganesh/GrOpsTypes.h"
 #include "src/gpu/ganesh/GrPaint.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
@@ -628,6 +629,66 @@ void Device::drawEdgeAAQuad(const SkRect& rect,
     }
 }
 
+void Device::drawBulk(const SkCanvas::BulkSet& set,
+                      const SkSamplingOptions& sampling,
+                      const SkPaint& paint) {
+    ASSERT_SINGLE_OWNER
+    GR_CREATE_TRACE_MARKER_CONTEXT("skgpu::ganesh::Device", "drawBulk", fContext.get());
+
+    // Runs of rects are drawn as one quad set, with each entry's color as its vertex color. That
+    // only works when the paint color is the input to nothing but the blend, since the quads'
+    // colors replace the GrPaint's.
+    if (paint.getShader() || paint.getColorFilter() || paint.getMaskFilter() ||
+        paint.getPathEffect() || paint.getStyle() != SkPaint::kFill_Style) {
+        this->SkDevice::drawBulk(set, sampling, paint);
+        return;
+    }
+
+    const GrQuadAAFlags aaFlags = paint.isAntiAlias() ? GrQuadAAFlags::kAll : GrQuadAAFlags::kNone;
+    TArray<GrQuadSetEntry> quads;
+    for (int start = 0; start < set.fCount;) {
+        const bool isRect = set.fItems[start] == SkCanvas::BulkItem::kRect;
+        int end = start + 1;
+        while (end < set.fCount && (set.fItems[end] == SkCanvas::BulkItem::kRect) == isRect) {
+            ++end;
+        }
+
+        if (!isRect) {
+            SkCanvas::BulkSet run = set;
+            run.fCount = end - start;
+            run.fItems += start;
+            run.fRects += start;
+            run.fRadii = set.fRadii ? set.fRadii + start : nullptr;
+            run.fSrcRects = set.fSrcRects ? set.fSrcRects + start : nullptr;
+            run.fColors = set.fColors ? set.fColors + start : nullptr;
+            this->SkDevice::drawBulk(run, sampling, paint);
+        } else {
+            quads.clear();
+            for (int i = start; i < end; ++i) {
+                const SkColor4f color = set.fColors ? set.fColors[i] : paint.getColor4f();
+                quads.push_back({set.fRects[i],
+                                 SkColor4fPrepForDst(color,
+                                                     fSurfaceDrawContext->colorInfo()).premul(),
+                                 SkMatrix::I(),
+                                 aaFlags});
+            }
+
+            GrPaint grPaint;
+            if (!SkPaintToGrPaint(this->recordingContext(),
+                                  fSurfaceDrawContext->colorInfo(),
+                                  paint,
+                                  this->localToDevice(),
+                                  fSurfaceDrawContext->surfaceProps(),
+                                  &grPaint)) {
+                return;
+            }
+            fSurfaceDrawContext->drawQuadSet(this->clip(), std::move(grPaint),
+                                             this->localToDevice(), quads.data(), quads.size());
+        }
+        start = end;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void Device::drawRRect(const SkRRect& rrect, const SkPaint& paint) {
@@ -1497,6 +1558,17 @@ sk_sp<sktext::gpu::Slug>
 Device::convertGlyphRunListToSlug(const sktext::GlyphRunList& glyphRunList,
                                   const SkPaint& initialPaint,
                                   const SkPaint& drawingPaint) {
+    if (fContext->priv().options().fDrawSlugGlyphsAsPaths) {
+        // Draw the glyphs from their outlines, so the Slug stays sharp at any scale.
+        const sktext::gpu::SDFTControl outlinesOnly = fSDFTControl.makeOutlinesOnly();
+        return sktext::gpu::SlugImpl::Make(
+                this->localToDevice(),
+                glyphRunList,
+                initialPaint,
+                drawingPaint,
+                {this->surfaceProps(), this->scalerContextFlags(), &outlinesOnly},
+                SkStrikeCache::GlobalStrikeCache());
+    }
     return sktext::gpu::SlugImpl::Make(this->localToDevice(),
                                        glyphRunList,
                                        initialPaint,
@@ -222,6 +222,7 @@ public:
     void drawEdgeAAImageSet(const SkCanvas::ImageSetEntry[], int count, const SkPoint dstClips[],
                             const SkMatrix preViewMatrices[], const SkSamplingOptions&,
                             const SkPaint&, SkCanvas::SrcRectConstraint) override;
+    void drawBulk(const SkCanvas::BulkSet&, const SkSamplingOptions&, const SkPaint&) override;
 
     // Assumes the src and dst rects have already been optimized to fit the proxy.
     // Only implemented by the gpu devices.
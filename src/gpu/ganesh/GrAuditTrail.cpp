@@ -134,6 +134,7 @@ void GrAuditTrail::fullReset() {
     // free all client ops
     fClientIDLookup.foreach ([](const int&, Ops** ops) { delete *ops; });
     fClientIDLookup.reset();
+    fRenderPassesSaved = 0;
     fOpPool.clear();  // must be last, frees all of the memory
 }
 
@@ -157,6 +158,7 @@ void GrAuditTrail::JsonifyTArray(SkJSONWriter& writer, const char* name, const T
 void GrAuditTrail::toJson(SkJSONWriter& writer) const {
     writer.beginObject();
     JsonifyTArray(writer, "Ops", fOpsTask);
+    writer.appendS32("RenderPassesSaved", fRenderPassesSaved);
     writer.endObject();
 }
 
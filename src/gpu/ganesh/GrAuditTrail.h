@@ -84,6 +84,15 @@ public:
 
     void opsCombined(const GrOp* consumer, const GrOp* consumed);
 
+    // Records that `count` render tasks were merged into an earlier task with the same target after
+    // the DAG was reordered, each saving a render pass.
+    void renderPassesSaved(int count) {
+        SkASSERT(fEnabled);
+        fRenderPassesSaved += count;
+    }
+
+    int numRenderPassesSaved() const { return fRenderPassesSaved; }
+
     // Because op combining is heavily dependent on sequence of draw calls, these calls will only
     // produce valid information for the given draw sequence which preceeded them. Specifically, ops
     // of future draw calls may combine with previous ops and thus would invalidate the json. What
@@ -158,6 +167,7 @@ private:
 
     // The client can pass in an optional client ID which we will use to mark the ops
     int fClientID;
+    int fRenderPassesSaved = 0;
     bool fEnabled;
 };
 
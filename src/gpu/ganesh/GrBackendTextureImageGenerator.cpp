@@ -28,11 +28,10 @@ GrBackendTextureImageGenerator::RefHelper::RefHelper(
         std::unique_ptr<GrSemaphore> semaphore)
         : fOriginalTexture(std::move(texture))
         , fOwningContextID(owningContextID)
-        , fBorrowingContextReleaseProc(nullptr)
         , fSemaphore(std::move(semaphore)) {}
 
 GrBackendTextureImageGenerator::RefHelper::~RefHelper() {
-    SkASSERT(!fBorrowingContextID.isValid());
+    SkASSERT(fBorrowers.empty());
     // Generator has been freed, and no one is borrowing the texture. Notify the original cache
     // that it can free the last ref, so it happens on the correct thread.
     GrResourceCache::ReturnResourceFromThread(std::move(fOriginalTexture), fOwningContextID);
@@ -70,7 +69,11 @@ GrBackendTextureImageGenerator::GrBackendTextureImageGenerator(
         : INHERITED(SkImageInfo::Make(texture->dimensions(), info))
         , fRefHelper(new RefHelper(texture, owningContextID, std::move(semaphore)))
         , fBackendTexture(texture->getBackendTexture())
-        , fSurfaceOrigin(origin) {}
+        , fSurfaceOrigin(origin) {
+    static const auto kDomain = skgpu::UniqueKey::GenerateDomain();
+    skgpu::UniqueKey::Builder builder(&fRefHelper->fBorrowedTextureKey, kDomain, 1);
+    builder[0] = this->uniqueID();
+}
 
 GrBackendTextureImageGenerator::~GrBackendTextureImageGenerator() {
     fRefHelper->unref();
@@ -83,11 +86,20 @@ bool GrBackendTextureImageGenerator::onIsProtected() const {
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GrBackendTextureImageGenerator::ReleaseRefHelper_TextureReleaseProc(void* ctx) {
-    RefHelper* refHelper = static_cast<RefHelper*>(ctx);
+    std::unique_ptr<BorrowerReleaseContext> releaseContext(
+            static_cast<BorrowerReleaseContext*>(ctx));
+    RefHelper* refHelper = releaseContext->fRefHelper;
     SkASSERT(refHelper);
 
-    refHelper->fBorrowingContextReleaseProc = nullptr;
-    refHelper->fBorrowingContextID.makeInvalid();
+    {
+        SkAutoMutexExclusive lock(refHelper->fBorrowingMutex);
+        for (int i = 0; i < refHelper->fBorrowers.size(); ++i) {
+            if (refHelper->fBorrowers[i].fContextID == releaseContext->fContextID) {
+                refHelper->fBorrowers.removeShuffle(i);
+                break;
+            }
+        }
+    }
     refHelper->unref();
 }
 
@@ -117,37 +129,28 @@ GrSurfaceProxyView GrBackendTextureImageGenerator::onGenerateTexture(
 
     auto proxyProvider = dContext->priv().proxyProvider();
 
-    fBorrowingMutex.acquire();
     sk_sp<skgpu::RefCntedCallback> releaseProcHelper;
-    if (fRefHelper->fBorrowingContextID.isValid()) {
-        if (fRefHelper->fBorrowingContextID != dContext->directContextID()) {
-            fBorrowingMutex.release();
-            rContext->priv().printWarningMessage(
-                    "GrBackendTextureImageGenerator: Trying to use texture on two GrContexts!\n");
-            return {};
-        } else {
-            SkASSERT(fRefHelper->fBorrowingContextReleaseProc);
-            // Ref the release proc to be held by the proxy we make below
-            releaseProcHelper = sk_ref_sp(fRefHelper->fBorrowingContextReleaseProc);
+    {
+        SkAutoMutexExclusive lock(fRefHelper->fBorrowingMutex);
+        GrDirectContext::DirectContextID contextID = dContext->directContextID();
+        for (const RefHelper::Borrower& borrower : fRefHelper->fBorrowers) {
+            if (borrower.fContextID == contextID) {
+                SkASSERT(borrower.fReleaseProc);
+                // Ref the release proc to be held by the proxy we make below
+                releaseProcHelper = sk_ref_sp(borrower.fReleaseProc);
+                break;
+            }
+        }
+        if (!releaseProcHelper) {
+            // The ref we add to fRefHelper here will be passed into and owned by the
+            // skgpu::RefCntedCallback.
+            fRefHelper->ref();
+            releaseProcHelper = skgpu::RefCntedCallback::Make(
+                    ReleaseRefHelper_TextureReleaseProc,
+                    new BorrowerReleaseContext{fRefHelper, contextID});
+            fRefHelper->fBorrowers.push_back({contextID, releaseProcHelper.get()});
         }
-    } else {
-        SkASSERT(!fRefHelper->fBorrowingContextReleaseProc);
-        // The ref we add to fRefHelper here will be passed into and owned by the
-        // skgpu::RefCntedCallback.
-        fRefHelper->ref();
-        releaseProcHelper =
-                skgpu::RefCntedCallback::Make(ReleaseRefHelper_TextureReleaseProc, fRefHelper);
-        fRefHelper->fBorrowingContextReleaseProc = releaseProcHelper.get();
-    }
-    fRefHelper->fBorrowingContextID = dContext->directContextID();
-    if (!fRefHelper->fBorrowedTextureKey.isValid()) {
-        static const auto kDomain = skgpu::UniqueKey::GenerateDomain();
-        skgpu::UniqueKey::Builder builder(&fRefHelper->fBorrowedTextureKey, kDomain, 1);
-        builder[0] = this->uniqueID();
     }
-    fBorrowingMutex.release();
-
-    SkASSERT(fRefHelper->fBorrowingContextID == dContext->directContextID());
 
     GrBackendFormat backendFormat = fBackendTexture.getBackendFormat();
     SkASSERT(backendFormat.isValid());
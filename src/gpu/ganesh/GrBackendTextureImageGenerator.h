@@ -11,6 +11,7 @@
 #include "include/gpu/GrBackendSurface.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/gpu/ganesh/GrTextureGenerator.h"
 #include "src/gpu/ResourceKey.h"
 #include "src/gpu/ganesh/GrSurfaceProxyView.h"
@@ -20,15 +21,17 @@ class GrSemaphore;
 
 /*
  * This ImageGenerator is used to wrap a texture in one GrContext and can then be used as a source
- * in another GrContext. It holds onto a semaphore which the producing GrContext will signal and the
- * consuming GrContext will wait on before using the texture. Only one GrContext can ever be used
- * as a consumer (this is mostly because Vulkan can't allow multiple things to wait on the same
- * semaphore).
+ * in other GrContexts. It holds onto a semaphore which the producing GrContext will signal and the
+ * consuming GrContexts will wait on before using the texture.
  *
  * In practice, this capability is used by clients to create backend-specific texture resources in
  * one thread (with, say, GrContext-A) and then ship them over to another GrContext (say,
  * GrContext-B) which will then use the texture as a source for draws. GrContext-A uses the
- * semaphore to notify GrContext-B when the shared texture is ready to use.
+ * semaphore to notify GrContext-B when the shared texture is ready to use. Any number of
+ * GrContexts may borrow the texture at the same time, so an image drawn in several windows is
+ * only uploaded once. The texture is never written after it is made, and only GL hands out a
+ * semaphore (a sync object, which any context in the share group can wait on); Vulkan and Metal
+ * finish the upload with a barrier or a submit instead.
  */
 class GrBackendTextureImageGenerator : public GrTextureGenerator {
 public:
@@ -61,6 +64,14 @@ private:
 
     static void ReleaseRefHelper_TextureReleaseProc(void* ctx);
 
+    class RefHelper;
+
+    // The context passed to ReleaseRefHelper_TextureReleaseProc for one borrowing context.
+    struct BorrowerReleaseContext {
+        RefHelper*                       fRefHelper;
+        GrDirectContext::DirectContextID fContextID;
+    };
+
     class RefHelper : public SkNVRefCnt<RefHelper> {
     public:
         RefHelper(sk_sp<GrTexture>,
@@ -69,28 +80,34 @@ private:
 
         ~RefHelper();
 
+        struct Borrower {
+            GrDirectContext::DirectContextID fContextID;
+            // There is no ref associated with this pointer. The borrower is removed by the release
+            // proc before the pointer becomes invalid, and the release proc runs on the borrowing
+            // context's thread, so it is safe to use from that context. A ref to this release proc
+            // is owned by all proxies and gpu uses of the backend texture in that context.
+            skgpu::RefCntedCallback*         fReleaseProc;
+        };
+
         sk_sp<GrTexture>                 fOriginalTexture;
         GrDirectContext::DirectContextID fOwningContextID;
 
+        // This Mutex guards the list of borrowing contexts and the creation of their release procs,
+        // which can happen from any context's thread, or from two threads with the same consuming
+        // GrContext that try to generate a texture at the same time.
+        SkMutex                          fBorrowingMutex;
+        skia_private::STArray<1, Borrower> fBorrowers SK_GUARDED_BY(fBorrowingMutex);
+
         // We use this key so that we don't rewrap the GrBackendTexture in a GrTexture for each
-        // proxy created from this generator for a particular borrowing context.
+        // proxy created from this generator for a particular borrowing context. Each context has
+        // its own resource cache, so the same key serves all of them. It is set when the generator
+        // is made and not changed after.
         skgpu::UniqueKey                 fBorrowedTextureKey;
-        // There is no ref associated with this pointer. We rely on our atomic bookkeeping with the
-        // context ID to know when this pointer is valid and safe to use. This is used to make sure
-        // all uses of the wrapped texture are finished on the borrowing context before we open
-        // this back up to other contexts. In general a ref to this release proc is owned by all
-        // proxies and gpu uses of the backend texture.
-        skgpu::RefCntedCallback*         fBorrowingContextReleaseProc;
-        GrDirectContext::DirectContextID fBorrowingContextID;
 
         std::unique_ptr<GrSemaphore>     fSemaphore;
     };
 
     RefHelper*       fRefHelper;
-    // This Mutex is used to guard the borrowing of the texture to one GrContext at a time as well
-    // as the creation of the fBorrowingContextReleaseProc. The latter happening if two threads with
-    // the same consuming GrContext try to generate a texture at the same time.
-    SkMutex          fBorrowingMutex;
 
     GrBackendTexture fBackendTexture;
     GrSurfaceOrigin  fSurfaceOrigin;
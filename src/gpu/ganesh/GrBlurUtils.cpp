@@ -2594,8 +2594,23 @@ std::unique_ptr<skgpu::ganesh::SurfaceDrawContext> GaussianBlur(GrRecordingConte
                                                                                                 : 0;
 #endif
 
-    float scaleX = sigmaX > kMaxSigma ? kMaxSigma / sigmaX : 1.f;
-    float scaleY = sigmaY > kMaxSigma ? kMaxSigma / sigmaY : 1.f;
+    // Huge sigmas are rescaled further, so that the Gaussian passes run on a quarter of the pixels
+    // with half the samples. Re-expanding from that resolution stays smooth because a blur of 2px
+    // leaves no detail that linear filtering can't reconstruct.
+#if defined(SK_IGNORE_HUGE_BLUR_RESCALE)
+    static constexpr float kHugeSigma = SK_FloatInfinity;
+#else
+    static constexpr float kHugeSigma = 8 * kMaxSigma;
+#endif
+    static constexpr float kHugeRescaledSigma = kMaxSigma / 2;
+    auto rescaleFactor = [](float sigma) {
+        if (sigma <= kMaxSigma) {
+            return 1.f;
+        }
+        return (sigma > kHugeSigma ? kHugeRescaledSigma : kMaxSigma) / sigma;
+    };
+    float scaleX = rescaleFactor(sigmaX);
+    float scaleY = rescaleFactor(sigmaY);
     // We round down here so that when we recalculate sigmas we know they will be below
     // kMaxSigma (but clamp to 1 do we don't have an empty texture).
     SkISize rescaledSize = {std::max(sk_float_floor2int(srcBounds.width() * scaleX), 1),
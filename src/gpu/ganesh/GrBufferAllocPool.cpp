@@ -19,6 +19,7 @@
 #include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrGpuBuffer.h"
 #include "src/gpu/ganesh/GrResourceProvider.h"
+#include "src/gpu/ganesh/GrRingBuffer.h"
 
 sk_sp<GrBufferAllocPool::CpuBufferCache> GrBufferAllocPool::CpuBufferCache::Make(
         int maxBuffersToCache) {
@@ -80,7 +81,7 @@ void GrBufferAllocPool::CpuBufferCache::releaseAll() {
     do {                                                                             \
         TRACE_EVENT_INSTANT1("skia.gpu", "GrBufferAllocPool Unmapping Buffer",       \
                              TRACE_EVENT_SCOPE_THREAD, "percent_unwritten",          \
-                             (float)((block).fBytesFree) / (block).fBuffer->size()); \
+                             (float)((block).fBytesFree) / (block).fSize);           \
         SkASSERT(!block.fBuffer->isCpuBuffer());                                     \
         static_cast<GrGpuBuffer*>(block.fBuffer.get())->unmap();                     \
     } while (false)
@@ -128,7 +129,7 @@ void GrBufferAllocPool::unmap() {
             if (static_cast<GrGpuBuffer*>(buffer)->isMapped()) {
                 UNMAP_BUFFER(block);
             } else {
-                size_t flushSize = block.fBuffer->size() - block.fBytesFree;
+                size_t flushSize = block.fSize - block.fBytesFree;
                 this->flushCpuData(fBlocks.back(), flushSize);
             }
         }
@@ -152,15 +153,17 @@ void GrBufferAllocPool::validate(bool unusedBlockAllowed) const {
     }
     size_t bytesInUse = 0;
     for (int i = 0; i < fBlocks.size() - 1; ++i) {
+        // Ring slices may share their buffer with the current block, which is mapped.
         const GrBuffer* buffer = fBlocks[i].fBuffer.get();
-        SkASSERT(buffer->isCpuBuffer() || !static_cast<const GrGpuBuffer*>(buffer)->isMapped());
+        SkASSERT(buffer->isCpuBuffer() || fBlocks[i].fIsRingSlice ||
+                 !static_cast<const GrGpuBuffer*>(buffer)->isMapped());
     }
     for (int i = 0; !wasDestroyed && i < fBlocks.size(); ++i) {
         GrBuffer* buffer = fBlocks[i].fBuffer.get();
         if (!buffer->isCpuBuffer() && static_cast<GrGpuBuffer*>(buffer)->wasDestroyed()) {
             wasDestroyed = true;
         } else {
-            size_t bytes = fBlocks[i].fBuffer->size() - fBlocks[i].fBytesFree;
+            size_t bytes = fBlocks[i].fSize - fBlocks[i].fBytesFree;
             bytesInUse += bytes;
             SkASSERT(bytes || unusedBlockAllowed);
         }
@@ -197,8 +200,8 @@ void* GrBufferAllocPool::makeSpace(size_t size,
 
     if (fBufferPtr) {
         BufferBlock& back = fBlocks.back();
-        size_t usedBytes = back.fBuffer->size() - back.fBytesFree;
-        size_t pad = align_up_pad(usedBytes, alignment);
+        size_t usedBytes = back.fSize - back.fBytesFree;
+        size_t pad = align_up_pad(back.fOffset + usedBytes, alignment);
         SkSafeMath safeMath;
         size_t alignedSize = safeMath.add(pad, size);
         if (!safeMath.ok()) {
@@ -207,7 +210,7 @@ void* GrBufferAllocPool::makeSpace(size_t size,
         if (alignedSize <= back.fBytesFree) {
             memset((void*)(reinterpret_cast<intptr_t>(fBufferPtr) + usedBytes), 0, pad);
             usedBytes += pad;
-            *offset = usedBytes;
+            *offset = back.fOffset + usedBytes;
             *buffer = back.fBuffer;
             back.fBytesFree -= alignedSize;
             fBytesInUse += alignedSize;
@@ -224,18 +227,22 @@ void* GrBufferAllocPool::makeSpace(size_t size,
     // the buffer in updateData() if the amount of data passed was less than
     // the full buffer size. This is old code and both concerns may be obsolete.
 
-    if (!this->createBlock(size)) {
+    if (!this->createBlock(size, alignment)) {
         return nullptr;
     }
     SkASSERT(fBufferPtr);
 
-    *offset = 0;
+    // Only ring slices can start at an offset that needs padding.
     BufferBlock& back = fBlocks.back();
+    size_t pad = align_up_pad(back.fOffset, alignment);
+    SkASSERT(pad + size <= back.fBytesFree);
+    memset(fBufferPtr, 0, pad);
+    *offset = back.fOffset + pad;
     *buffer = back.fBuffer;
-    back.fBytesFree -= size;
-    fBytesInUse += size;
+    back.fBytesFree -= pad + size;
+    fBytesInUse += pad + size;
     VALIDATE();
-    return fBufferPtr;
+    return static_cast<char*>(fBufferPtr) + pad;
 }
 
 void* GrBufferAllocPool::makeSpaceAtLeast(size_t minSize,
@@ -250,17 +257,17 @@ void* GrBufferAllocPool::makeSpaceAtLeast(size_t minSize,
     SkASSERT(offset);
     SkASSERT(actualSize);
 
-    size_t usedBytes = (fBlocks.empty()) ? 0 : fBlocks.back().fBuffer->size() -
-                                               fBlocks.back().fBytesFree;
-    size_t pad = align_up_pad(usedBytes, alignment);
+    size_t usedBytes = (fBlocks.empty()) ? 0 : fBlocks.back().fSize - fBlocks.back().fBytesFree;
+    size_t pad = (fBlocks.empty()) ? 0 : align_up_pad(fBlocks.back().fOffset + usedBytes,
+                                                      alignment);
     if (!fBufferPtr || fBlocks.empty() || (minSize + pad) > fBlocks.back().fBytesFree) {
         // We either don't have a block yet or the current block doesn't have enough free space.
         // Create a new one.
-        if (!this->createBlock(fallbackSize)) {
+        if (!this->createBlock(fallbackSize, alignment)) {
             return nullptr;
         }
         usedBytes = 0;
-        pad = 0;
+        pad = align_up_pad(fBlocks.back().fOffset, alignment);
     }
     SkASSERT(fBufferPtr);
 
@@ -272,7 +279,7 @@ void* GrBufferAllocPool::makeSpaceAtLeast(size_t minSize,
 
     // Give caller all remaining space in this block (but aligned correctly)
     size_t size = align_down(fBlocks.back().fBytesFree, alignment);
-    *offset = usedBytes;
+    *offset = fBlocks.back().fOffset + usedBytes;
     *buffer = fBlocks.back().fBuffer;
     *actualSize = size;
     fBlocks.back().fBytesFree -= size;
@@ -293,7 +300,7 @@ void GrBufferAllocPool::putBack(size_t bytes) {
     // we should not have a case where someone is putting back bytes that are greater than the
     // current block.
     // It is possible the caller returns all their allocated bytes thus the <= and not just <.
-    SkASSERT(bytes <= (block.fBuffer->size() - block.fBytesFree));
+    SkASSERT(bytes <= (block.fSize - block.fBytesFree));
     block.fBytesFree += bytes;
     fBytesInUse -= bytes;
 
@@ -303,7 +310,7 @@ void GrBufferAllocPool::putBack(size_t bytes) {
     // will usually be cached so the new block shouldn't be too expensive to make.
     // TODO: This was true in older versions and uses of this class but is it still needed to
     // have this restriction?
-    if (block.fBytesFree == block.fBuffer->size()) {
+    if (block.fBytesFree == block.fSize) {
         GrBuffer* buffer = block.fBuffer.get();
         if (!buffer->isCpuBuffer() && static_cast<GrGpuBuffer*>(buffer)->isMapped()) {
             UNMAP_BUFFER(block);
@@ -314,20 +321,25 @@ void GrBufferAllocPool::putBack(size_t bytes) {
     VALIDATE();
 }
 
-bool GrBufferAllocPool::createBlock(size_t requestSize) {
+bool GrBufferAllocPool::createBlock(size_t requestSize, size_t alignment) {
     size_t size = std::max(requestSize, kDefaultBufferSize);
 
     VALIDATE();
 
     BufferBlock& block = fBlocks.push_back();
 
-    block.fBuffer = this->getBuffer(size);
-    if (!block.fBuffer) {
-        fBlocks.pop_back();
-        return false;
+    if (!this->getRingSlice(size, alignment, &block)) {
+        block.fBuffer = this->getBuffer(size);
+        if (!block.fBuffer) {
+            fBlocks.pop_back();
+            return false;
+        }
+        block.fOffset = 0;
+        block.fSize = block.fBuffer->size();
+        block.fIsRingSlice = false;
     }
 
-    block.fBytesFree = block.fBuffer->size();
+    block.fBytesFree = block.fSize;
     if (fBufferPtr) {
         SkASSERT(fBlocks.size() > 1);
         BufferBlock& prev = fBlocks.fromBack(1);
@@ -336,7 +348,7 @@ bool GrBufferAllocPool::createBlock(size_t requestSize) {
             if (static_cast<GrGpuBuffer*>(buffer)->isMapped()) {
                 UNMAP_BUFFER(prev);
             } else {
-                this->flushCpuData(prev, prev.fBuffer->size() - prev.fBytesFree);
+                this->flushCpuData(prev, prev.fSize - prev.fBytesFree);
             }
         }
         fBufferPtr = nullptr;
@@ -350,6 +362,15 @@ bool GrBufferAllocPool::createBlock(size_t requestSize) {
     if (block.fBuffer->isCpuBuffer()) {
         fBufferPtr = static_cast<GrCpuBuffer*>(block.fBuffer.get())->data();
         SkASSERT(fBufferPtr);
+    } else if (block.fIsRingSlice) {
+        // Ring buffers stay mapped while the GPU reads from them, so this is a plain memcpy
+        // target that never needs to be flushed.
+        if (void* ringPtr = static_cast<GrGpuBuffer*>(block.fBuffer.get())->map()) {
+            fBufferPtr = static_cast<char*>(ringPtr) + block.fOffset;
+        } else {
+            fBlocks.pop_back();
+            return false;
+        }
     } else {
         if (GrCaps::kNone_MapFlags != fGpu->caps()->mapBufferFlags() &&
             size > fGpu->caps()->bufferMapThreshold()) {
@@ -410,6 +431,27 @@ void GrBufferAllocPool::flushCpuData(const BufferBlock& block, size_t flushSize)
     VALIDATE(true);
 }
 
+bool GrBufferAllocPool::getRingSlice(size_t size, size_t alignment, BufferBlock* block) {
+    GrRingBuffer* ringBuffer = fGpu->streamingRingBuffer(fBufferType);
+    // Requests that are large relative to the ring would force it to grow, so they get a
+    // dedicated buffer instead.
+    if (!ringBuffer || size > ringBuffer->size() / 4) {
+        return false;
+    }
+    // Reserve enough room to align the first allocation relative to the start of the buffer,
+    // since the slice offset is only aligned to the ring's own alignment.
+    size_t sliceSize = size + alignment - 1;
+    GrRingBuffer::Slice slice = ringBuffer->suballocate(sliceSize);
+    if (!slice.fBuffer) {
+        return false;
+    }
+    block->fBuffer = sk_ref_sp(slice.fBuffer);
+    block->fOffset = slice.fOffset;
+    block->fSize = sliceSize;
+    block->fIsRingSlice = true;
+    return true;
+}
+
 sk_sp<GrBuffer> GrBufferAllocPool::getBuffer(size_t size) {
     const GrCaps& caps = *fGpu->caps();
     auto resourceProvider = fGpu->getContext()->priv().resourceProvider();
@@ -147,13 +147,19 @@ private:
     struct BufferBlock {
         size_t fBytesFree;
         sk_sp<GrBuffer> fBuffer;
+        // The block occupies [fOffset, fOffset + fSize) of fBuffer. This is the entire buffer
+        // unless the block is a slice of the GrGpu's streaming ring buffer.
+        size_t fOffset;
+        size_t fSize;
+        bool fIsRingSlice;
 
         static_assert(::sk_is_trivially_relocatable<decltype(fBuffer)>::value);
 
         using sk_is_trivially_relocatable = std::true_type;
     };
 
-    bool createBlock(size_t requestSize);
+    bool createBlock(size_t requestSize, size_t alignment);
+    bool getRingSlice(size_t size, size_t alignment, BufferBlock*);
     void destroyBlock();
     void deleteBlocks();
     void flushCpuData(const BufferBlock& block, size_t flushSize);
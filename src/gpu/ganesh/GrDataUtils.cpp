@@ -36,6 +36,7 @@
 #include "src/gpu/ganesh/GrPixmap.h"
 
 #include <algorithm>
+#include <climits>
 #include <cstdint>
 #include <cstring>
 #include <functional>
@@ -255,6 +256,108 @@ static void fillin_BC1_with_color(SkISize dimensions, const SkColor4f& colorf, c
     }
 }
 
+// Encode one 4x4 block of an opaque RGBA_8888 pixmap, starting at ('left', 'top'). Texels past the
+// right or bottom edge replicate the last column or row. The endpoints are the block's bounding box
+// in RGB, inset slightly and oriented along the covariance of red and blue with green.
+static BC1Block compress_opaque_BC1_block(const SkPixmap& pixmap, int left, int top) {
+    int rgb[16][3];
+    int lo[3] = {255, 255, 255};
+    int hi[3] = {0, 0, 0};
+    int sum[3] = {0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        int x = std::min(left + (i & 3), pixmap.width() - 1);
+        int y = std::min(top + (i >> 2), pixmap.height() - 1);
+        const uint8_t* texel = static_cast<const uint8_t*>(pixmap.addr(x, y));
+        for (int c = 0; c < 3; ++c) {
+            rgb[i][c] = texel[c];
+            lo[c] = std::min(lo[c], rgb[i][c]);
+            hi[c] = std::max(hi[c], rgb[i][c]);
+            sum[c] += rgb[i][c];
+        }
+    }
+
+    // Pull the endpoints in by 1/16th of the range so the interpolated colors land closer to the
+    // texels, then flip red and blue if they run against green within the block.
+    int covRG = 0, covBG = 0;
+    for (int i = 0; i < 16; ++i) {
+        int dg = 16 * rgb[i][1] - sum[1];
+        covRG += (16 * rgb[i][0] - sum[0]) * dg;
+        covBG += (16 * rgb[i][2] - sum[2]) * dg;
+    }
+    for (int c = 0; c < 3; ++c) {
+        int inset = (hi[c] - lo[c]) >> 4;
+        lo[c] += inset;
+        hi[c] -= inset;
+    }
+    if (covRG < 0) {
+        std::swap(lo[0], hi[0]);
+    }
+    if (covBG < 0) {
+        std::swap(lo[2], hi[2]);
+    }
+
+    BC1Block block;
+    block.fColor0 = to565(SkColorSetRGB(hi[0], hi[1], hi[2]));
+    block.fColor1 = to565(SkColorSetRGB(lo[0], lo[1], lo[2]));
+    if (block.fColor0 < block.fColor1) {
+        // fColor0 > fColor1 selects the opaque four color mode.
+        std::swap(block.fColor0, block.fColor1);
+    }
+    block.fIndices = 0;
+    if (block.fColor0 == block.fColor1) {
+        return block;
+    }
+
+    // The palette as the GPU decodes it: color0, color1, 2/3*color0 + 1/3*color1, and
+    // 1/3*color0 + 2/3*color1.
+    auto expand = [](uint16_t c565, int* dst) {
+        int r5 = c565 >> 11, g6 = (c565 >> 5) & 0x3F, b5 = c565 & 0x1F;
+        dst[0] = (r5 << 3) | (r5 >> 2);
+        dst[1] = (g6 << 2) | (g6 >> 4);
+        dst[2] = (b5 << 3) | (b5 >> 2);
+    };
+    int palette[4][3];
+    expand(block.fColor0, palette[0]);
+    expand(block.fColor1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        uint32_t best = 0;
+        int bestDist = INT_MAX;
+        for (uint32_t p = 0; p < 4; ++p) {
+            int dist = 0;
+            for (int c = 0; c < 3; ++c) {
+                int d = rgb[i][c] - palette[p][c];
+                dist += d * d;
+            }
+            if (dist < bestDist) {
+                bestDist = dist;
+                best = p;
+            }
+        }
+        block.fIndices |= best << (2 * i);
+    }
+    return block;
+}
+
+void GrCompressOpaqueBC1(const SkPixmap& pixmap, char* dstPixels) {
+    TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+    SkASSERT(pixmap.colorType() == kRGBA_8888_SkColorType ||
+             pixmap.colorType() == kRGB_888x_SkColorType);
+
+    BC1Block* dstBlocks = reinterpret_cast<BC1Block*>(dstPixels);
+    int numXBlocks = num_4x4_blocks(pixmap.width());
+    int numYBlocks = num_4x4_blocks(pixmap.height());
+    for (int y = 0; y < numYBlocks; ++y) {
+        for (int x = 0; x < numXBlocks; ++x) {
+            dstBlocks[y*numXBlocks + x] = compress_opaque_BC1_block(pixmap, 4 * x, 4 * y);
+        }
+    }
+}
+
 #if defined(GR_TEST_UTILS)
 
 // Fill in 'dstPixels' with BC1 blocks derived from the 'pixmap'.
@@ -47,6 +47,13 @@ void GrFillInCompressedData(SkTextureCompressionType,
                             char* dest,
                             const SkColor4f& color);
 
+/**
+ * BC1 compress an arbitrary opaque RGBA_8888 (or RGB_888x) image as kBC1_RGB8_UNORM. 'dstPixels'
+ * must hold GrNumBlocks(kBC1_RGB8_UNORM, pixmap.dimensions()) blocks. This is a fast range-fit
+ * encoder meant for compressing images at upload time, not an offline quality encoder.
+ */
+void GrCompressOpaqueBC1(const SkPixmap& pixmap, char* dstPixels);
+
 bool GrConvertPixels(const GrPixmap& dst, const GrCPixmap& src, bool flipY = false);
 
 /** Clears the dst image to a constant color. */
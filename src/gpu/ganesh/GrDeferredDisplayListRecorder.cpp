@@ -10,6 +10,8 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkSurface.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrRecordingContext.h"
@@ -19,6 +21,7 @@
 #include "include/private/chromium/GrSurfaceCharacterization.h"
 #include "include/private/chromium/SkImageChromium.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/Device.h"
 #include "src/gpu/ganesh/GrCaps.h"
@@ -253,3 +256,60 @@ sk_sp<SkImage> GrDeferredDisplayListRecorder::makeYUVAPromiseTexture(
                                             textureContexts);
 }
 #endif // !SK_MAKE_PROMISE_TEXTURE_DISABLE_LEGACY_API
+
+namespace skgpu::ganesh {
+
+std::vector<sk_sp<GrDeferredDisplayList>> RecordTiledDDLs(const GrSurfaceCharacterization& c,
+                                                          const SkPicture* picture,
+                                                          int numXDivisions,
+                                                          int numYDivisions,
+                                                          SkExecutor* executor) {
+    if (!c.isValid() || !picture || numXDivisions <= 0 || numYDivisions <= 0) {
+        return {};
+    }
+
+    const int xTileSize = c.width() / numXDivisions;
+    const int yTileSize = c.height() / numYDivisions;
+    if (!xTileSize || !yTileSize) {
+        return {};
+    }
+
+    std::vector<sk_sp<GrDeferredDisplayList>> ddls(numXDivisions * numYDivisions);
+    auto recordTile = [&](int index) {
+        const int x = index % numXDivisions;
+        const int y = index / numXDivisions;
+        // The last tile in each row and column takes up whatever the division left over.
+        const int xOff = x * xTileSize;
+        const int yOff = y * yTileSize;
+        const int xSize = x < numXDivisions - 1 ? xTileSize : c.width() - xOff;
+        const int ySize = y < numYDivisions - 1 ? yTileSize : c.height() - yOff;
+
+        GrDeferredDisplayListRecorder recorder(c);
+        SkCanvas* canvas = recorder.getCanvas();
+        if (!canvas) {
+            return;
+        }
+        canvas->clipRect(SkRect::Make(SkIRect::MakeXYWH(xOff, yOff, xSize, ySize)));
+        canvas->drawPicture(picture);
+        ddls[index] = recorder.detach();
+    };
+
+    if (executor) {
+        SkTaskGroup tasks(*executor);
+        tasks.batch(SkToInt(ddls.size()), recordTile);
+        tasks.wait();
+    } else {
+        for (int i = 0; i < SkToInt(ddls.size()); ++i) {
+            recordTile(i);
+        }
+    }
+
+    for (const sk_sp<GrDeferredDisplayList>& ddl : ddls) {
+        if (!ddl) {
+            return {};
+        }
+    }
+    return ddls;
+}
+
+}  // namespace skgpu::ganesh
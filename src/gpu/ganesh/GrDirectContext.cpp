@@ -24,6 +24,7 @@
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/base/SkAutoMalloc.h"
 #include "src/core/SkCompressedDataUtils.h"
+#include "src/core/SkImageFilterCache.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
@@ -41,6 +42,7 @@
 #include "src/gpu/ganesh/GrDrawOpAtlas.h"
 #include "src/gpu/ganesh/GrDrawingManager.h"
 #include "src/gpu/ganesh/GrGpu.h"
+#include "src/gpu/ganesh/GrGpuOpTimer.h"
 #include "src/gpu/ganesh/GrPixmap.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
 #include "src/gpu/ganesh/GrRenderTargetProxy.h"
@@ -111,6 +113,8 @@ GrDirectContext::~GrDirectContext() {
     // We need to make sure all work is finished on the gpu before we start releasing resources.
     this->syncAllOutstandingGpuWork(/*shouldExecuteWhileAbandoned=*/false);
 
+    // Cached image filter results hold proxies, which must be released before the resources.
+    fImageFilterCache.reset();
     this->destroyDrawingManager();
 
     // Ideally we could just let the ptr drop, but resource cache queries this ptr in releaseAll.
@@ -245,6 +249,10 @@ void GrDirectContext::freeGpuResources() {
 
     this->drawingManager()->freeGpuResources();
 
+    if (fImageFilterCache) {
+        fImageFilterCache->purge();
+    }
+
     fResourceCache->purgeUnlockedResources(GrPurgeResourceOptions::kAllResources);
 }
 
@@ -268,6 +276,7 @@ bool GrDirectContext::init() {
                                                        this->contextID());
     fResourceCache->setProxyProvider(this->proxyProvider());
     fResourceCache->setThreadSafeCache(this->threadSafeCache());
+    fResourceCache->setAdaptiveBudget(this->options().fAdaptiveResourceCacheBudget);
 #if defined(GR_TEST_UTILS)
     if (this->options().fResourceCacheLimitOverride != -1) {
         this->setResourceCacheLimit(this->options().fResourceCacheLimitOverride);
@@ -287,6 +296,10 @@ bool GrDirectContext::init() {
 
     fPersistentCache = this->options().fPersistentCache;
 
+    if (this->options().fImageFilterCacheBytes) {
+        fImageFilterCache = SkImageFilterCache::Create(this->options().fImageFilterCacheBytes);
+    }
+
     GrDrawOpAtlas::AllowMultitexturing allowMultitexturing;
     if (GrContextOptions::Enable::kNo == this->options().fAllowMultipleGlyphCacheTextures ||
         // multitexturing supported only if range can represent the index + texcoords fully
@@ -462,7 +475,9 @@ bool GrDirectContext::submit(GrSyncCpu sync) {
         return false;
     }
 
-    return fGpu->submitToGpu(sync);
+    bool submitted = fGpu->submitToGpu(sync);
+    fResourceCache->didEndFrame();
+    return submitted;
 }
 
 GrSemaphoresSubmitted GrDirectContext::flush(const sk_sp<const SkImage>& image,
@@ -538,6 +553,9 @@ void GrDirectContext::flush(SkSurface* surface) {
 void GrDirectContext::checkAsyncWorkCompletion() {
     if (fGpu) {
         fGpu->checkFinishProcs();
+        if (GrGpuOpTimer* opTimer = fGpu->opTimer()) {
+            opTimer->resolve();
+        }
     }
 }
 
@@ -558,17 +576,70 @@ void GrDirectContext::storeVkPipelineCacheData() {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool GrDirectContext::supportsGpuOpTimings() const {
+    return fGpu && fGpu->supportsTimestampQueries();
+}
+
+void GrDirectContext::setGpuOpTimingsEnabled(bool enabled) {
+    ASSERT_SINGLE_OWNER
+    if (this->abandoned()) {
+        return;
+    }
+    fGpu->setOpTimingsEnabled(enabled);
+}
+
+std::vector<GrDirectContext::GpuOpTiming> GrDirectContext::takeGpuOpTimings() {
+    ASSERT_SINGLE_OWNER
+    if (this->abandoned() || !fGpu->opTimer()) {
+        return {};
+    }
+    return fGpu->opTimer()->takeTimings();
+}
+
+void GrDirectContext::setShaderCompileTimingsEnabled(bool enabled) {
+    ASSERT_SINGLE_OWNER
+    if (this->abandoned()) {
+        return;
+    }
+    fGpu->setShaderCompileTimingsEnabled(enabled);
+}
+
+std::vector<GrDirectContext::ShaderCompileTiming> GrDirectContext::takeShaderCompileTimings() {
+    ASSERT_SINGLE_OWNER
+    if (this->abandoned()) {
+        return {};
+    }
+    return fGpu->takeShaderCompileTimings();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool GrDirectContext::supportsDistanceFieldText() const {
     return this->caps()->shaderCaps()->supportsDistanceFieldText();
 }
 
+skgpu::GpuCounters GrDirectContext::getGpuCounters() const {
+    if (!fGpu) {
+        return {};
+    }
+    return fGpu->counters()->snapshot();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 void GrDirectContext::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     ASSERT_SINGLE_OWNER
     fResourceCache->dumpMemoryStatistics(traceMemoryDump);
+    if (fGpu) {
+        fGpu->dumpMemoryStatistics(traceMemoryDump);
+    }
     traceMemoryDump->dumpNumericValue("skia/gr_text_blob_cache", "size", "bytes",
                                       this->getTextBlobRedrawCoordinator()->usedBytes());
+    // drawingManager() isn't const, but reading its arena's size doesn't change anything.
+    if (auto drawingManager = const_cast<GrDirectContext*>(this)->drawingManager()) {
+        traceMemoryDump->dumpNumericValue("skia/gr_flush_arena", "size", "bytes",
+                                          drawingManager->flushArenaBytes());
+    }
 }
 
 GrBackendTexture GrDirectContext::createBackendTexture(int width,
@@ -315,7 +315,51 @@ GrDrawOpAtlas::ErrorCode GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceP
     return ErrorCode::kSucceeded;
 }
 
+bool GrDrawOpAtlas::movePlot(Plot* src, Plot* dst) {
+    SkASSERT(src != dst);
+    this->processEvictionAndResetRects(dst);
+    bool moved = dst->copyFrom(*src);
+    if (moved) {
+        dst->setLastUseToken(src->lastUseToken());
+        dst->resetFlushesSinceLastUsed();
+        fRelocations.push_back({src->plotLocator(), dst->plotLocator()});
+    }
+    this->processEvictionAndResetRects(src);
+    return moved;
+}
+
+bool GrDrawOpAtlas::relocate(GrDeferredUploadTarget* target, AtlasLocator* atlasLocator) {
+    const PlotLocator from = atlasLocator->plotLocator();
+    for (const Relocation& relocation : fRelocations) {
+        if (!(relocation.fFrom == from)) {
+            continue;
+        }
+        if (!this->hasID(relocation.fTo)) {
+            return false;
+        }
+
+        Plot* src = fPages[from.pageIndex()].fPlotArray[from.plotIndex()].get();
+        Plot* dst = fPages[relocation.fTo.pageIndex()].fPlotArray[relocation.fTo.plotIndex()].get();
+        const int dx = dst->offset().fX - src->offset().fX;
+        const int dy = dst->offset().fY - src->offset().fY;
+        const SkIPoint topLeft = atlasLocator->topLeft();
+        atlasLocator->updateRect(skgpu::IRect16::MakeXYWH(topLeft.fX + dx,
+                                                          topLeft.fY + dy,
+                                                          atlasLocator->width(),
+                                                          atlasLocator->height()));
+        return this->updatePlot(target, atlasLocator, dst);
+    }
+    return false;
+}
+
 void GrDrawOpAtlas::compact(AtlasToken startTokenForNextFlush) {
+    // Forget the moves whose destination has been evicted since.
+    for (int i = fRelocations.size() - 1; i >= 0; --i) {
+        if (!this->hasID(fRelocations[i].fTo)) {
+            fRelocations.removeShuffle(i);
+        }
+    }
+
     if (fNumActivePages < 1) {
         fPrevFlushToken = startTokenForNextFlush;
         return;
@@ -420,9 +464,10 @@ void GrDrawOpAtlas::compact(AtlasToken startTokenForNextFlush) {
         }
 
         // If recently used plots in the last page are using less than a quarter of the page, try
-        // to evict them if there's available space in earlier pages. Since we prioritize uploading
-        // to the first pages, this will eventually clear out usage of this page unless we have a
-        // large need.
+        // to move them to available space in earlier pages. Since we prioritize uploading to the
+        // first pages, this will eventually clear out usage of this page unless we have a large
+        // need. The moved plots are uploaded again from their backing data, which is much cheaper
+        // than rasterizing and adding each of their entries again.
         if (!availablePlots.empty() && usedPlots && usedPlots <= fNumPlots / 4) {
             plotIter.init(fPages[lastPageIndex].fPlotList, PlotList::Iter::kHead_IterStart);
             while (Plot* plot = plotIter.get()) {
@@ -432,8 +477,7 @@ void GrDrawOpAtlas::compact(AtlasToken startTokenForNextFlush) {
                     // We need to be somewhat harsh here so that a handful of plots that are
                     // consistently in use don't end up locking the page in memory.
                     if (!availablePlots.empty()) {
-                        this->processEvictionAndResetRects(plot);
-                        this->processEvictionAndResetRects(availablePlots.back());
+                        this->movePlot(plot, availablePlots.back());
                         availablePlots.pop_back();
                         --usedPlots;
                     }
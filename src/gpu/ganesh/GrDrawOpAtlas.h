@@ -156,6 +156,14 @@ public:
 
     void compact(skgpu::AtlasToken startTokenForNextFlush);
 
+    /**
+     * compact() may move the contents of a plot that is still in use to a plot in an earlier page
+     * instead of evicting them. If the plot 'atlasLocator' refers to was moved, this updates the
+     * locator to the subimage's new position, schedules the new plot's upload if needed and
+     * returns true. Otherwise the subimage has to be added again, and this returns false.
+     */
+    bool relocate(GrDeferredUploadTarget*, skgpu::AtlasLocator*);
+
     void instantiate(GrOnFlushResourceProvider*);
 
     uint32_t maxPages() const {
@@ -201,6 +209,16 @@ private:
         plot->resetRects();
     }
 
+    // Copies the contents of 'src' into 'dst', evicting both. Returns false if 'src' had no data
+    // to copy, in which case both are just evicted.
+    bool movePlot(skgpu::Plot* src, skgpu::Plot* dst);
+
+    // A plot whose contents were copied to another plot by movePlot().
+    struct Relocation {
+        skgpu::PlotLocator fFrom;
+        skgpu::PlotLocator fTo;
+    };
+
     GrBackendFormat       fFormat;
     SkColorType           fColorType;
     size_t                fBytesPerPixel;
@@ -222,6 +240,9 @@ private:
     // nextFlushToken() value at the end of the previous flush
     skgpu::AtlasToken fPrevFlushToken;
 
+    // The moves made by compact() whose destination plot hasn't been evicted since.
+    skia_private::TArray<Relocation> fRelocations;
+
     // the number of flushes since this atlas has been last used
     int                   fFlushesSinceLastUse;
 
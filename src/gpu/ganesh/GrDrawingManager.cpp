@@ -15,6 +15,7 @@
 #include "include/gpu/GrRecordingContext.h"
 #include "include/private/chromium/GrDeferredDisplayList.h"
 #include "src/base/SkTInternalLList.h"
+#include "src/gpu/ganesh/GrAuditTrail.h"
 #include "src/gpu/ganesh/GrBufferTransferRenderTask.h"
 #include "src/gpu/ganesh/GrBufferUpdateRenderTask.h"
 #include "src/gpu/ganesh/GrClientMappedBufferManager.h"
@@ -70,6 +71,10 @@ bool GrDrawingManager::wasAbandoned() const {
     return fContext->abandoned();
 }
 
+size_t GrDrawingManager::flushArenaBytes() const {
+    return fFlushArena ? fFlushArena->retainedBytes() : 0;
+}
+
 void GrDrawingManager::freeGpuResources() {
     for (int i = fOnFlushCBObjects.size() - 1; i >= 0; --i) {
         if (!fOnFlushCBObjects[i]->retainOnFreeGpuResources()) {
@@ -149,7 +154,13 @@ bool GrDrawingManager::flush(SkSpan<GrSurfaceProxy*> proxies,
         fCpuBufferCache = GrBufferAllocPool::CpuBufferCache::Make(maxCachedBuffers);
     }
 
-    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache);
+    if (!fFlushArena) {
+        fFlushArena = std::make_unique<SkRetainingArenaAlloc>(
+                GrOpFlushState::kArenaFirstHeapAllocation);
+    }
+
+    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache,
+                              fFlushArena.get());
 
     GrOnFlushResourceProvider onFlushProvider(this);
 
@@ -170,6 +181,7 @@ bool GrDrawingManager::flush(SkSpan<GrSurfaceProxy*> proxies,
                 resourceAllocator.reset();
             }
         }
+        this->resolveStencilLiveness();
 
 #if 0
         // Enable this to print out verbose GrOp information
@@ -412,6 +424,7 @@ bool GrDrawingManager::reorderTasks(GrResourceAllocator* resourceAllocator) {
     reorder_array_by_llist(llist, &fDAG);
 
     int newCount = 0;
+    int mergedCount = 0;
     for (int i = 0; i < fDAG.size(); i++) {
         sk_sp<GrRenderTask>& task = fDAG[i];
         if (auto opsTask = task->asOpsTask()) {
@@ -422,13 +435,35 @@ bool GrDrawingManager::reorderTasks(GrResourceAllocator* resourceAllocator) {
                 removed->disown(this);
             }
             i += removeCount;
+            mergedCount += removeCount;
         }
         fDAG[newCount++] = std::move(task);
     }
     fDAG.resize_back(newCount);
+    GR_AUDIT_TRAIL_INVOKE_GUARD(fContext->priv().auditTrail(), renderPassesSaved, mergedCount);
     return true;
 }
 
+void GrDrawingManager::resolveStencilLiveness() {
+    if (!fContext->priv().caps()->discardStencilValuesAfterRenderPass()) {
+        return;
+    }
+    // Walk backwards so that each opsTask knows whether the next opsTask on its target reads the
+    // stencil values it leaves behind. Tasks on the same target are never reordered relative to
+    // each other, so this is their execution order.
+    THashMap<GrSurfaceProxy*, bool> nextTaskReadsStencil;
+    for (int i = fDAG.size() - 1; i >= 0; --i) {
+        skgpu::ganesh::OpsTask* opsTask = fDAG[i] ? fDAG[i]->asOpsTask() : nullptr;
+        if (!opsTask) {
+            continue;
+        }
+        GrSurfaceProxy* target = opsTask->target(0);
+        const bool* nextReads = nextTaskReadsStencil.find(target);
+        nextTaskReadsStencil.set(target,
+                                 opsTask->resolveStencilLiveness(!nextReads || *nextReads));
+    }
+}
+
 void GrDrawingManager::closeAllTasks() {
     for (auto& task : fDAG) {
         if (task) {
@@ -25,6 +25,7 @@
 #define GR_PATH_RENDERER_SPEW 0
 
 class GrArenas;
+class SkRetainingArenaAlloc;
 class GrDeferredDisplayList;
 class GrGpuBuffer;
 class GrOnFlushCallbackObject;
@@ -163,6 +164,9 @@ public:
 
     void addOnFlushCallbackObject(GrOnFlushCallbackObject*);
 
+    // The memory that the flush arena keeps between flushes.
+    size_t flushArenaBytes() const;
+
 #if defined(GR_TEST_UTILS)
     void testingOnly_removeOnFlushCallbackObject(GrOnFlushCallbackObject*);
     PathRendererChain::Options testingOnly_getOptionsForPathRendererChain() {
@@ -206,6 +210,10 @@ private:
     // acceptable. If it returns true, fDAG has been updated to reflect the reordered tasks.
     bool reorderTasks(GrResourceAllocator*);
 
+    // On tilers, walks the final task order to find stencil values that no later task reads, so
+    // their opsTasks can skip loading and storing them.
+    void resolveStencilLiveness();
+
     void closeAllTasks();
 
     GrRenderTask* appendTask(sk_sp<GrRenderTask>);
@@ -227,6 +235,9 @@ private:
     // This cache is used by both the vertex and index pools. It reuses memory across multiple
     // flushes.
     sk_sp<GrBufferAllocPool::CpuBufferCache>   fCpuBufferCache;
+    // Holds the flush state's pipelines and draws. It keeps its memory across flushes so that
+    // flushes of similar size don't allocate from the heap.
+    std::unique_ptr<SkRetainingArenaAlloc>     fFlushArena;
 
     skia_private::TArray<sk_sp<GrRenderTask>>  fDAG;
     std::vector<int>                           fReorderBlockerTaskIndices;
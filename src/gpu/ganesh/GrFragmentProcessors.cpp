@@ -24,6 +24,7 @@
 #include "include/core/SkSpan.h"
 #include "include/effects/SkRuntimeEffect.h"
 #include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrRecordingContext.h"
 #include "include/gpu/GrTypes.h"
 #include "include/gpu/ganesh/SkSurfaceGanesh.h"
@@ -716,12 +717,14 @@ static std::unique_ptr<GrFragmentProcessor> make_shader_fp(const SkPictureShader
         dstCS = sk_ref_sp(args.fDstColorInfo->colorSpace());
     }
 
+    const bool snapScale = ctx->priv().options().fSnapPictureShaderScales;
     auto info = SkPictureShader::CachedImageInfo::Make(shader->tile(),
                                                        mRec.totalMatrix(),
                                                        dstColorType,
                                                        dstCS.get(),
                                                        ctx->priv().caps()->maxTextureSize(),
-                                                       args.fSurfaceProps);
+                                                       args.fSurfaceProps,
+                                                       snapScale);
     if (!info.success) {
         return nullptr;
     }
@@ -20,6 +20,7 @@
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDataUtils.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrGpuOpTimer.h"
 #include "src/gpu/ganesh/GrGpuResourcePriv.h"
 #include "src/gpu/ganesh/GrNativeRect.h"
 #include "src/gpu/ganesh/GrPipeline.h"
@@ -42,6 +43,9 @@ using namespace skia_private;
 GrGpu::GrGpu(GrDirectContext* direct) : fResetBits(kAll_GrBackendState), fContext(direct) {}
 
 GrGpu::~GrGpu() {
+    // Backends that support timestamp queries must stop timing in their own destructors, while
+    // they can still delete the queries.
+    SkASSERT(!fOpTimer);
     this->callSubmittedProcs(false);
 }
 
@@ -49,7 +53,44 @@ void GrGpu::initCaps(sk_sp<const GrCaps> caps) {
     fCaps = std::move(caps);
 }
 
-void GrGpu::disconnect(DisconnectType type) {}
+void GrGpu::disconnect(DisconnectType type) {
+    if (fOpTimer) {
+        if (type == DisconnectType::kAbandon) {
+            fOpTimer->abandon();
+        }
+        fOpTimer.reset();
+    }
+}
+
+void GrGpu::setOpTimingsEnabled(bool enabled) {
+    if (!enabled) {
+        fOpTimer.reset();
+    } else if (!fOpTimer && this->supportsTimestampQueries()) {
+        fOpTimer = std::make_unique<GrGpuOpTimer>(this);
+    }
+}
+
+void GrGpu::setShaderCompileTimingsEnabled(bool enabled) {
+    fShaderCompileTimingsEnabled = enabled;
+    if (!enabled) {
+        fShaderCompileTimings.clear();
+    }
+}
+
+void GrGpu::addShaderCompileTiming(const SkData& key, const skgpu::ShaderCompileTimes& times) {
+    if (!fShaderCompileTimingsEnabled) {
+        return;
+    }
+    fShaderCompileTimings.push_back({SkData::MakeWithCopy(key.data(), key.size()),
+                                     times.fParse,
+                                     times.fOptimize,
+                                     times.fCodegen,
+                                     times.fDriver});
+}
+
+std::vector<GrDirectContext::ShaderCompileTiming> GrGpu::takeShaderCompileTimings() {
+    return std::exchange(fShaderCompileTimings, {});
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -408,6 +449,13 @@ sk_sp<GrGpuBuffer> GrGpu::createBuffer(size_t size,
     return buffer;
 }
 
+sk_sp<GrGpuBuffer> GrGpu::createRingBufferBuffer(size_t size, GrGpuBufferType type) {
+    return fContext->priv().resourceProvider()->createBuffer(size,
+                                                             type,
+                                                             kDynamic_GrAccessPattern,
+                                                             GrResourceProvider::ZeroInit::kNo);
+}
+
 bool GrGpu::copySurface(GrSurface* dst, const SkIRect& dstRect,
                         GrSurface* src, const SkIRect& srcRect,
                         GrSamplerState::Filter filter) {
@@ -505,6 +553,13 @@ bool GrGpu::writePixels(GrSurface* surface,
 
     this->didWriteToSurface(surface, kTopLeft_GrSurfaceOrigin, &rect, mipLevelCount);
     fStats.incTextureUploads();
+    size_t bpp = GrColorTypeBytesPerPixel(srcColorType);
+    for (int i = 0; i < mipLevelCount; ++i) {
+        if (texels[i].fPixels) {
+            fCounters.add(skgpu::GpuCounter::kTextureUploadBytes,
+                          bpp * std::max(rect.width() >> i, 1) * std::max(rect.height() >> i, 1));
+        }
+    }
 
     return true;
 }
@@ -586,6 +641,8 @@ bool GrGpu::transferPixelsTo(GrTexture* texture,
 
     this->didWriteToSurface(texture, kTopLeft_GrSurfaceOrigin, &rect);
     fStats.incTransfersToTexture();
+    fCounters.add(skgpu::GpuCounter::kTextureUploadBytes,
+                  GrColorTypeBytesPerPixel(bufferColorType) * rect.width() * rect.height());
 
     return true;
 }
@@ -742,6 +799,7 @@ GrOpsRenderPass* GrGpu::getOpsRenderPass(
     fCurrentSubmitRenderPassCount++;
 #endif
     fStats.incRenderPasses();
+    fCounters.add(skgpu::GpuCounter::kRenderPasses);
     return this->onGetOpsRenderPass(renderTarget, useMSAASurface, stencil, origin, bounds,
                                     colorInfo, stencilInfo, sampledProxies, renderPassXferBarriers);
 }
@@ -756,6 +814,11 @@ bool GrGpu::submitToGpu(GrSyncCpu sync) {
     if (auto uniformsBuffer = this->uniformsRingBuffer()) {
         uniformsBuffer->startSubmit(this);
     }
+    for (GrGpuBufferType type : {GrGpuBufferType::kVertex, GrGpuBufferType::kIndex}) {
+        if (auto streamingBuffer = this->streamingRingBuffer(type)) {
+            streamingBuffer->startSubmit(this);
+        }
+    }
 
     bool submitted = this->onSubmitToGpu(sync);
 
@@ -829,6 +892,8 @@ void GrGpu::Stats::dump(SkString* out) {
                  fNumScratchMSAAAttachmentsReused);
     out->appendf("Number of Render Passes: %d\n", fRenderPasses);
     out->appendf("Reordered DAGs Over Budget: %d\n", fNumReorderedDAGsOverBudget);
+    out->appendf("Attachment Bytes Saved: %zu\n", fAttachmentBytesSaved);
+    out->appendf("Flush Arena Heap Allocations: %d\n", fArenaHeapAllocations);
 
     // enable this block to output CSV-style stats for program pre-compilation
 #if 0
@@ -851,6 +916,10 @@ void GrGpu::Stats::dumpKeyValuePairs(TArray<SkString>* keys, TArray<double>* val
     values->push_back(fRenderPasses);
     keys->push_back(SkString("reordered_dags_over_budget"));
     values->push_back(fNumReorderedDAGsOverBudget);
+    keys->push_back(SkString("attachment_bytes_saved"));
+    values->push_back(fAttachmentBytesSaved);
+    keys->push_back(SkString("arena_heap_allocations"));
+    values->push_back(fArenaHeapAllocations);
 }
 
 #endif // GR_GPU_STATS
@@ -8,13 +8,17 @@
 #ifndef GrGpu_DEFINED
 #define GrGpu_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkSpan.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
+#include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrTypes.h"
 #include "include/private/base/SkTArray.h"
 #include "src/base/SkTInternalLList.h"
+#include "src/gpu/GpuTypesPriv.h"
+#include "src/gpu/PipelineUtils.h"
 #include "src/gpu/RefCntedCallback.h"
 #include "src/gpu/Swizzle.h"
 #include "src/gpu/ganesh/GrAttachment.h"
@@ -32,6 +36,7 @@ class GrDirectContext;
 class GrGLContext;
 class GrPipeline;
 class GrGeometryProcessor;
+class GrGpuOpTimer;
 class GrRenderTarget;
 class GrRingBuffer;
 class GrSemaphore;
@@ -42,6 +47,7 @@ class GrTexture;
 class GrThreadSafePipelineBuilder;
 struct GrVkDrawableInfo;
 class SkJSONWriter;
+class SkTraceMemoryDump;
 enum class SkTextureCompressionType;
 
 namespace SkSL {
@@ -66,6 +72,16 @@ public:
 
     virtual GrRingBuffer* uniformsRingBuffer() { return nullptr; }
 
+    // If non-null, GrBufferAllocPool suballocates dynamic data of the given type from this ring
+    // instead of creating (and mapping or updating) a buffer per block.
+    virtual GrRingBuffer* streamingRingBuffer(GrGpuBufferType) { return nullptr; }
+
+    /**
+     * Creates the backing buffer of a GrRingBuffer. By default this is a dynamic buffer from the
+     * resource provider. Backends can override this to create buffers that stay mapped.
+     */
+    virtual sk_sp<GrGpuBuffer> createRingBufferBuffer(size_t size, GrGpuBufferType);
+
     enum class DisconnectType {
         // No cleanup should be attempted, immediately cease making backend API calls
         kAbandon,
@@ -420,6 +436,34 @@ public:
     // NOLINTNEXTLINE(performance-unnecessary-value-param)
     virtual void takeOwnershipOfBuffer(sk_sp<GrGpuBuffer>) {}
 
+    /**
+     * Timestamp queries, used by GrGpuOpTimer to measure how long ops take on the GPU. A backend
+     * that supports them overrides all of these. writeTimestamp() records the time at which the
+     * commands recorded so far in the render pass finish, and returns 0 if it can't. The result
+     * is in nanoseconds, and getTimestampResult() returns false until it is available. Every
+     * query that is written must be deleted. checkTimestampsDisjoint() returns whether something
+     * like a GPU clock change has made the results fetched since the last call meaningless, and
+     * resets that state.
+     */
+    using TimestampQuery = uint32_t;
+    virtual bool supportsTimestampQueries() const { return false; }
+    virtual TimestampQuery writeTimestamp(GrOpsRenderPass*) { return 0; }
+    virtual bool getTimestampResult(TimestampQuery, uint64_t* nanoseconds) { return false; }
+    virtual bool checkTimestampsDisjoint() { return false; }
+    virtual void deleteTimestampQuery(TimestampQuery) {}
+
+    // Starts or stops timing ops (see GrDirectContext::setGpuOpTimingsEnabled). While enabled,
+    // opTimer() is not null.
+    void setOpTimingsEnabled(bool enabled);
+    GrGpuOpTimer* opTimer() { return fOpTimer.get(); }
+
+    // See GrDirectContext::setShaderCompileTimingsEnabled(). Program builders only need to gather
+    // the times while shaderCompileTimingsEnabled() is true, but it is harmless if they always do.
+    void setShaderCompileTimingsEnabled(bool enabled);
+    bool shaderCompileTimingsEnabled() const { return fShaderCompileTimingsEnabled; }
+    void addShaderCompileTiming(const SkData& key, const skgpu::ShaderCompileTimes&);
+    std::vector<GrDirectContext::ShaderCompileTiming> takeShaderCompileTimings();
+
     /**
      * Checks if we detected an OOM from the underlying 3D API and if so returns true and resets
      * the internal OOM state to false. Otherwise, returns false.
@@ -493,6 +537,16 @@ public:
         int numReorderedDAGsOverBudget() const { return fNumReorderedDAGsOverBudget; }
         void incNumReorderedDAGsOverBudget() { fNumReorderedDAGsOverBudget++; }
 
+        // Bytes of attachment memory traffic avoided by not loading or not storing an attachment
+        // at the start or end of a render pass.
+        size_t attachmentBytesSaved() const { return fAttachmentBytesSaved; }
+        void incAttachmentBytesSaved(size_t bytes) { fAttachmentBytesSaved += bytes; }
+
+        // Heap allocations made by the flush-time arena. Zero in steady state, once the arena has
+        // grown to fit the largest flush.
+        int arenaHeapAllocations() const { return fArenaHeapAllocations; }
+        void incArenaHeapAllocations(int count) { fArenaHeapAllocations += count; }
+
 #if defined(GR_TEST_UTILS)
         void dump(SkString*);
         void dumpKeyValuePairs(
@@ -513,6 +567,8 @@ public:
         int fNumScratchMSAAAttachmentsReused = 0;
         int fRenderPasses = 0;
         int fNumReorderedDAGsOverBudget = 0;
+        size_t fAttachmentBytesSaved = 0;
+        int fArenaHeapAllocations = 0;
 
 #else  // !GR_GPU_STATS
 
@@ -534,12 +590,17 @@ public:
         void incNumScratchMSAAAttachmentsReused() {}
         void incRenderPasses() {}
         void incNumReorderedDAGsOverBudget() {}
+        void incAttachmentBytesSaved(size_t) {}
+        void incArenaHeapAllocations(int) {}
 #endif
     };
 
     Stats* stats() { return &fStats; }
     void dumpJSON(SkJSONWriter*) const;
 
+    // Unlike Stats, these are always on. See GrDirectContext::getGpuCounters().
+    skgpu::GpuCounterSet* counters() { return &fCounters; }
+
 
     /**
      * Creates a texture directly in the backend API without wrapping it in a GrTexture.
@@ -607,6 +668,13 @@ public:
      */
     virtual bool compile(const GrProgramDesc&, const GrProgramInfo&) = 0;
 
+    /**
+     * Called while a flush is prepared, with the program a draw will bind when the flush executes.
+     * Backends that compile pipelines on another thread start compiling it here, so the compile
+     * overlaps with preparing the rest of the flush.
+     */
+    virtual void willBindProgram(const GrProgramInfo&) {}
+
     virtual bool precompileShader(const SkData& key, const SkData& data) { return false; }
 
 #if defined(GR_TEST_UTILS)
@@ -671,6 +739,10 @@ public:
 
     virtual void storeVkPipelineCacheData() {}
 
+    // Dumps memory used by the backend that isn't owned by a GrGpuResource, such as the free
+    // space in suballocated device memory.
+    virtual void dumpMemoryStatistics(SkTraceMemoryDump*) const {}
+
     // Called before certain draws in order to guarantee coherent results from dst reads.
     virtual void xferBarrier(GrRenderTarget*, GrXferBarrierType) = 0;
 
@@ -690,6 +762,7 @@ protected:
     void setOOMed() { fOOMed = true; }
 
     Stats                            fStats;
+    skgpu::GpuCounterSet             fCounters;
 
     // Subclass must call this to initialize caps in its constructor.
     void initCaps(sk_sp<const GrCaps> caps);
@@ -876,6 +949,11 @@ private:
 
     bool fOOMed = false;
 
+    std::unique_ptr<GrGpuOpTimer> fOpTimer;
+
+    bool fShaderCompileTimingsEnabled = false;
+    std::vector<GrDirectContext::ShaderCompileTiming> fShaderCompileTimings;
+
 #if SK_HISTOGRAMS_ENABLED
     int fCurrentSubmitRenderPassCount = 0;
 #endif
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/GrGpuOpTimer.h"
+
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkTraceEvent.h"
+
+#include <chrono>
+
+GrGpuOpTimer::~GrGpuOpTimer() {
+    if (fCurrentStart) {
+        fGpu->deleteTimestampQuery(fCurrentStart);
+    }
+    for (const Pending& pending : fPending) {
+        fGpu->deleteTimestampQuery(pending.fStart);
+        fGpu->deleteTimestampQuery(pending.fEnd);
+    }
+}
+
+void GrGpuOpTimer::beginOp(GrOpsRenderPass* renderPass, const char* opName) {
+    SkASSERT(!fCurrentStart);
+    fCurrentOpName = opName;
+    fCurrentStart = fGpu->writeTimestamp(renderPass);
+}
+
+void GrGpuOpTimer::endOp(GrOpsRenderPass* renderPass) {
+    if (!fCurrentStart) {
+        return;
+    }
+    GrGpu::TimestampQuery end = fGpu->writeTimestamp(renderPass);
+    if (end) {
+        fPending.push_back({fCurrentOpName, fCurrentStart, end});
+    } else {
+        fGpu->deleteTimestampQuery(fCurrentStart);
+    }
+    fCurrentStart = 0;
+}
+
+void GrGpuOpTimer::resolve() {
+    struct Resolved {
+        const char* fOpName;
+        uint64_t fNanoseconds;
+    };
+    skia_private::STArray<16, Resolved> resolved;
+    while (!fPending.empty()) {
+        const Pending& pending = fPending.front();
+        uint64_t start, end;
+        // The end timestamp is written last, so once it is available the start is too.
+        if (!fGpu->getTimestampResult(pending.fEnd, &end)) {
+            break;
+        }
+        if (fGpu->getTimestampResult(pending.fStart, &start) && end >= start) {
+            resolved.push_back({pending.fOpName, end - start});
+        }
+        fGpu->deleteTimestampQuery(pending.fStart);
+        fGpu->deleteTimestampQuery(pending.fEnd);
+        fPending.pop_front();
+    }
+
+    // The results can only be trusted if the GPU's timer ran continuously while they were taken.
+    if (resolved.empty() || fGpu->checkTimestampsDisjoint()) {
+        return;
+    }
+    for (const Resolved& r : resolved) {
+        GrDirectContext::GpuOpTiming* timing = fTimings.find(r.fOpName);
+        if (!timing) {
+            timing = fTimings.set(r.fOpName, {r.fOpName, 0, {}});
+        }
+        timing->fCount++;
+        timing->fTime += std::chrono::nanoseconds(r.fNanoseconds);
+        TRACE_COUNTER1("skia.gpu.optime", r.fOpName, r.fNanoseconds);
+    }
+}
+
+std::vector<GrDirectContext::GpuOpTiming> GrGpuOpTimer::takeTimings() {
+    this->resolve();
+    std::vector<GrDirectContext::GpuOpTiming> timings;
+    timings.reserve(fTimings.count());
+    fTimings.foreach([&](std::string_view, GrDirectContext::GpuOpTiming* timing) {
+        timings.push_back(*timing);
+    });
+    fTimings.reset();
+    return timings;
+}
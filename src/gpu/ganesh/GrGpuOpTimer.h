@@ -0,0 +1,64 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrGpuOpTimer_DEFINED
+#define GrGpuOpTimer_DEFINED
+
+#include "include/gpu/GrDirectContext.h"
+#include "src/core/SkTHash.h"
+#include "src/gpu/ganesh/GrGpu.h"
+
+#include <deque>
+#include <string_view>
+#include <vector>
+
+class GrOpsRenderPass;
+
+/**
+ * Measures how long the op chains executed by OpsTasks take on the GPU, using a pair of
+ * timestamp queries around each chain, and sums the times by op class (GrOp::name()).
+ *
+ * The GPU finishes the chains in the order they were executed, so the queries are resolved in that
+ * order too. Each resolved chain is also reported as a trace counter, which shows up as a track
+ * per op class in Perfetto.
+ */
+class GrGpuOpTimer {
+public:
+    explicit GrGpuOpTimer(GrGpu* gpu) : fGpu(gpu) {}
+
+    // Deletes any queries that have not been resolved.
+    ~GrGpuOpTimer();
+
+    // Called around the execution of an op chain whose head op is named 'opName', which must be
+    // a string literal.
+    void beginOp(GrOpsRenderPass*, const char* opName);
+    void endOp(GrOpsRenderPass*);
+
+    // Adds the chains the GPU has finished to the totals.
+    void resolve();
+
+    // Resolves what it can and returns the totals, which are then reset.
+    std::vector<GrDirectContext::GpuOpTiming> takeTimings();
+
+    // The backend API objects are gone, so the queries must not be deleted.
+    void abandon() { fPending.clear(); }
+
+private:
+    struct Pending {
+        const char* fOpName;
+        GrGpu::TimestampQuery fStart;
+        GrGpu::TimestampQuery fEnd;
+    };
+
+    GrGpu* fGpu;
+    std::deque<Pending> fPending;
+    const char* fCurrentOpName = nullptr;
+    GrGpu::TimestampQuery fCurrentStart = 0;
+    skia_private::THashMap<std::string_view, GrDirectContext::GpuOpTiming> fTimings;
+};
+
+#endif
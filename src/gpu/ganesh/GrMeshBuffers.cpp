@@ -101,6 +101,67 @@ bool GrMeshBuffer<Base, Type>::onUpdate(GrDirectContext* dc,
     return true;
 }
 
+template <typename Base, GrGpuBufferType Type>
+static sk_sp<Base> gpu_copy_for_draw(GrDirectContext* dc, Base* buffer) {
+    if (!dc || dc->abandoned() || !buffer || buffer->isGaneshBacked() || !buffer->peek()) {
+        return nullptr;
+    }
+    // Any buffer that isn't Ganesh-backed but has data is a CPU buffer.
+    auto* cpuBuffer = static_cast<SkMeshPriv::CpuBuffer<Base>*>(buffer);
+    return cpuBuffer->withGpuCopy([dc](const SkData& data, auto& copy) -> sk_sp<Base> {
+        using GpuBuffer = GrMeshBuffer<Base, Type>;
+        if (copy.fBuffer &&
+            static_cast<GpuBuffer*>(copy.fBuffer.get())->asGpuBuffer()->getContext() != dc) {
+            // The copy was made for another context (or one that's since been abandoned).
+            copy.fBuffer.reset();
+            copy.fDrawCount = 0;
+        }
+        if (copy.fRewrittenBetweenDraws) {
+            // Uploading the data with each draw is as cheap as keeping a copy up to date.
+            return nullptr;
+        }
+        if (!copy.fBuffer) {
+            if (++copy.fDrawCount < 2) {
+                return nullptr;
+            }
+            copy.fBuffer = GpuBuffer::Make(dc, data.data(), data.size());
+            copy.fDirtyStart = copy.fDirtyEnd = 0;
+            return copy.fBuffer;
+        }
+        size_t start = copy.fDirtyStart;
+        size_t end   = copy.fDirtyEnd;
+        copy.fDirtyStart = copy.fDirtyEnd = 0;
+        if (start == end) {
+            return copy.fBuffer;
+        }
+        if (start == 0 && end == data.size()) {
+            copy.fBuffer.reset();
+            copy.fRewrittenBetweenDraws = true;
+            return nullptr;
+        }
+        // Updates are 4-byte aligned so the union of their ranges is too.
+        if (!copy.fBuffer->update(dc,
+                                  SkTAddOffset<const void>(data.data(), start),
+                                  start,
+                                  end - start)) {
+            copy.fBuffer.reset();
+            copy.fDrawCount = 0;
+            return nullptr;
+        }
+        return copy.fBuffer;
+    });
+}
+
+namespace SkMeshPriv {
+sk_sp<IB> GaneshCopyForDraw(GrDirectContext* dc, IB* buffer) {
+    return gpu_copy_for_draw<IB, GrGpuBufferType::kIndex>(dc, buffer);
+}
+
+sk_sp<VB> GaneshCopyForDraw(GrDirectContext* dc, VB* buffer) {
+    return gpu_copy_for_draw<VB, GrGpuBufferType::kVertex>(dc, buffer);
+}
+}  // namespace SkMeshPriv
+
 namespace SkMeshes {
 sk_sp<SkMesh::IndexBuffer> MakeIndexBuffer(GrDirectContext* dc, const void* data, size_t size) {
     if (!dc) {
@@ -44,6 +44,15 @@ private:
 namespace SkMeshPriv {
 using GaneshIndexBuffer  = GrMeshBuffer<SkMeshPriv::IB, GrGpuBufferType::kIndex >;
 using GaneshVertexBuffer = GrMeshBuffer<SkMeshPriv::VB, GrGpuBufferType::kVertex>;
+
+/**
+ * Returns a GPU-backed buffer to draw in place of a CPU-backed buffer that has been drawn with 'dc'
+ * before, so its data needn't be copied and uploaded again. The copy is made the second time the
+ * buffer is drawn and is brought up to date with any ranges written by update() since its last
+ * draw. Returns null if the buffer should be drawn from its CPU data.
+ */
+sk_sp<IB> GaneshCopyForDraw(GrDirectContext*, IB*);
+sk_sp<VB> GaneshCopyForDraw(GrDirectContext*, VB*);
 }  // namespace SkMeshPriv
 
 #endif
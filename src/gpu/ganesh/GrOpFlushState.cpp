@@ -9,22 +9,30 @@
 
 #include "include/core/SkColorSpace.h"
 #include "include/gpu/GrDirectContext.h"
+#include "include/private/base/SkTArray.h"
 #include "src/core/SkConvertPixels.h"
+#include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDataUtils.h"
+#include "src/gpu/ganesh/GrDrawIndirectCommand.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrDrawOpAtlas.h"
 #include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrImageInfo.h"
 #include "src/gpu/ganesh/GrProgramInfo.h"
 #include "src/gpu/ganesh/GrResourceProvider.h"
+#include "src/gpu/ganesh/GrSimpleMesh.h"
 #include "src/gpu/ganesh/GrTexture.h"
 
 //////////////////////////////////////////////////////////////////////////////
 
 GrOpFlushState::GrOpFlushState(GrGpu* gpu, GrResourceProvider* resourceProvider,
                                skgpu::TokenTracker* tokenTracker,
-                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache)
-        : fVertexPool(gpu, cpuBufferCache)
+                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache,
+                               SkRetainingArenaAlloc* arena)
+        : fOwnedArena(arena ? nullptr
+                            : std::make_unique<SkRetainingArenaAlloc>(kArenaFirstHeapAllocation))
+        , fArena(arena ? arena : fOwnedArena.get())
+        , fVertexPool(gpu, cpuBufferCache)
         , fIndexPool(gpu, cpuBufferCache)
         , fDrawIndirectPool(gpu, std::move(cpuBufferCache))
         , fGpu(gpu)
@@ -65,9 +73,27 @@ void GrOpFlushState::executeDrawsAndUploadsForMeshDrawOp(
         this->bindPipelineAndScissorClip(programInfo, chainBounds);
         this->bindTextures(programInfo.geomProc(), fCurrDraw->fGeomProcProxies,
                            programInfo.pipeline());
-        for (int i = 0; i < fCurrDraw->fMeshCnt; ++i) {
-            this->drawMesh(fCurrDraw->fMeshes[i]);
+        const IndirectRun* run = fCurrDraw->fIndirectRuns;
+        const IndirectRun* runEnd = run + fCurrDraw->fIndirectRunCnt;
+        for (int i = 0; i < fCurrDraw->fMeshCnt;) {
+            if (run != runEnd && run->fFirstMesh == i) {
+                const GrSimpleMesh& mesh = fCurrDraw->fMeshes[i];
+                this->bindBuffers(mesh.fIndexBuffer, nullptr, mesh.fVertexBuffer,
+                                  mesh.fPrimitiveRestart);
+                if (mesh.fIndexBuffer) {
+                    this->drawIndexedIndirect(run->fIndirectBuffer.get(), run->fIndirectOffset,
+                                              run->fMeshCnt);
+                } else {
+                    this->drawIndirect(run->fIndirectBuffer.get(), run->fIndirectOffset,
+                                       run->fMeshCnt);
+                }
+                i += run->fMeshCnt;
+                ++run;
+            } else {
+                this->drawMesh(fCurrDraw->fMeshes[i++]);
+            }
         }
+        SkASSERT(run == runEnd);
 
         fTokenTracker->issueFlushToken();
         ++fCurrDraw;
@@ -93,7 +119,8 @@ void GrOpFlushState::reset() {
     fVertexPool.reset();
     fIndexPool.reset();
     fDrawIndirectPool.reset();
-    fArena.reset();
+    fArena->reset();
+    fGpu->stats()->incArenaHeapAllocations(fArena->lastHeapAllocationCount());
     fASAPUploads.reset();
     fInlineUploads.reset();
     fDraws.reset();
@@ -143,12 +170,12 @@ void GrOpFlushState::doUpload(GrDeferredTextureUploadFn& upload,
 }
 
 skgpu::AtlasToken GrOpFlushState::addInlineUpload(GrDeferredTextureUploadFn&& upload) {
-    return fInlineUploads.append(&fArena, std::move(upload), fTokenTracker->nextDrawToken())
+    return fInlineUploads.append(fArena->get(), std::move(upload), fTokenTracker->nextDrawToken())
             .fUploadBeforeToken;
 }
 
 skgpu::AtlasToken GrOpFlushState::addASAPUpload(GrDeferredTextureUploadFn&& upload) {
-    fASAPUploads.append(&fArena, std::move(upload));
+    fASAPUploads.append(fArena->get(), std::move(upload));
     return fTokenTracker->nextFlushToken();
 }
 
@@ -161,7 +188,7 @@ void GrOpFlushState::recordDraw(
     SkASSERT(fOpArgs);
     SkDEBUGCODE(fOpArgs->validate());
     bool firstDraw = fDraws.begin() == fDraws.end();
-    auto& draw = fDraws.append(&fArena);
+    auto& draw = fDraws.append(fArena->get());
     skgpu::AtlasToken token = fTokenTracker->issueDrawToken();
     for (int i = 0; i < geomProc->numTextureSamplers(); ++i) {
         SkASSERT(geomProcProxies && geomProcProxies[i]);
@@ -173,11 +200,89 @@ void GrOpFlushState::recordDraw(
     draw.fMeshCnt = meshCnt;
     draw.fOp = fOpArgs->op();
     draw.fPrimitiveType = primitiveType;
+    if (meshCnt > 1 && !geomProc->hasInstanceAttributes()) {
+        this->recordIndirectRuns(&draw);
+    }
     if (firstDraw) {
         fBaseDrawToken = token;
     }
 }
 
+// Two meshes can share a multi-draw indirect call if they bind the same buffers and each of them
+// is a single direct draw.
+static bool can_draw_indirect(const GrSimpleMesh& mesh, const GrCaps& caps) {
+    if (!mesh.fVertexBuffer || mesh.fVertexBuffer->isCpuBuffer()) {
+        return false;
+    }
+    if (!mesh.fIndexBuffer) {
+        return true;
+    }
+    return !mesh.fIndexBuffer->isCpuBuffer() &&
+           0 == mesh.fPatternRepeatCount &&
+           !caps.nativeDrawIndexedIndirectIsBroken();
+}
+
+static bool share_buffers(const GrSimpleMesh& a, const GrSimpleMesh& b) {
+    return a.fVertexBuffer == b.fVertexBuffer &&
+           a.fIndexBuffer == b.fIndexBuffer &&
+           a.fPrimitiveRestart == b.fPrimitiveRestart;
+}
+
+void GrOpFlushState::recordIndirectRuns(Draw* draw) {
+    const GrCaps& caps = this->caps();
+    if (!caps.drawInstancedSupport() || !caps.nativeDrawIndirectSupport()) {
+        // Without native support, indirect draws are polyfilled with a loop of direct draws.
+        return;
+    }
+
+    skia_private::STArray<4, IndirectRun> runs;
+    const GrSimpleMesh* meshes = draw->fMeshes;
+    for (int i = 0; i < draw->fMeshCnt;) {
+        int runEnd = i + 1;
+        if (can_draw_indirect(meshes[i], caps)) {
+            while (runEnd < draw->fMeshCnt && share_buffers(meshes[i], meshes[runEnd])) {
+                ++runEnd;
+            }
+        }
+        int runCnt = runEnd - i;
+        if (runCnt < 2) {
+            ++i;
+            continue;
+        }
+
+        sk_sp<const GrBuffer> indirectBuffer;
+        size_t indirectOffset;
+        if (meshes[i].fIndexBuffer) {
+            GrDrawIndexedIndirectWriter writer =
+                    this->makeDrawIndexedIndirectSpace(runCnt, &indirectBuffer, &indirectOffset);
+            if (!writer) {
+                break;
+            }
+            for (int j = i; j < runEnd; ++j) {
+                writer.writeIndexed(meshes[j].fIndexCount, meshes[j].fBaseIndex, 1, 0,
+                                    meshes[j].fBaseVertex);
+            }
+        } else {
+            GrDrawIndirectWriter writer =
+                    this->makeDrawIndirectSpace(runCnt, &indirectBuffer, &indirectOffset);
+            if (!writer) {
+                break;
+            }
+            for (int j = i; j < runEnd; ++j) {
+                writer.write(1, 0, meshes[j].fVertexCount, meshes[j].fBaseVertex);
+            }
+        }
+        runs.push_back({i, runCnt, std::move(indirectBuffer), indirectOffset});
+        i = runEnd;
+    }
+
+    if (!runs.empty()) {
+        draw->fIndirectRuns = fArena->get()->makeInitializedArray<IndirectRun>(
+                runs.size(), [&](size_t i) { return std::move(runs[i]); });
+        draw->fIndirectRunCnt = runs.size();
+    }
+}
+
 void* GrOpFlushState::makeVertexSpace(size_t vertexSize, int vertexCount,
                                       sk_sp<const GrBuffer>* buffer, int* startVertex) {
     return fVertexPool.makeSpace(vertexSize, vertexCount, buffer, startVertex);
@@ -8,6 +8,7 @@
 #ifndef GrOpFlushState_DEFINED
 #define GrOpFlushState_DEFINED
 
+#include <memory>
 #include <utility>
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkArenaAllocList.h"
@@ -26,11 +27,18 @@ class GrResourceProvider;
 /** Tracks the state across all the GrOps (really just the GrDrawOps) in a OpsTask flush. */
 class GrOpFlushState final : public GrDeferredUploadTarget, public GrMeshDrawTarget {
 public:
+    // The first heap allocation of the flush arena, before it has learned how much a flush needs.
+    static constexpr size_t kArenaFirstHeapAllocation = sizeof(GrPipeline) * 100;
+
     // vertexSpace and indexSpace may either be null or an alloation of size
     // GrBufferAllocPool::kDefaultBufferSize. If the latter, then CPU memory is only allocated for
     // vertices/indices when a buffer larger than kDefaultBufferSize is required.
+    //
+    // If 'arena' is provided, it holds the pipelines, draws, and inline uploads, and is reset with
+    // the flush state, so that a caller that keeps it across flushes can reuse its memory.
     GrOpFlushState(GrGpu*, GrResourceProvider*, skgpu::TokenTracker*,
-                   sk_sp<GrBufferAllocPool::CpuBufferCache> = nullptr);
+                   sk_sp<GrBufferAllocPool::CpuBufferCache> = nullptr,
+                   SkRetainingArenaAlloc* arena = nullptr);
 
     ~GrOpFlushState() final { this->reset(); }
 
@@ -189,7 +197,7 @@ public:
 #endif
 
     /** GrMeshDrawTarget override. */
-    SkArenaAlloc* allocator() override { return &fArena; }
+    SkArenaAlloc* allocator() override { return fArena->get(); }
 
     // This is a convenience method that binds the given pipeline, and then, if our applied clip has
     // a scissor, sets the scissor rect from the applied clip.
@@ -271,6 +279,15 @@ private:
         skgpu::AtlasToken fUploadBeforeToken;
     };
 
+    // A run of consecutive meshes in a Draw that share their buffers and are issued with a single
+    // multi-draw indirect call. The run's commands are written to fIndirectBuffer at prepare time.
+    struct IndirectRun {
+        int fFirstMesh;
+        int fMeshCnt;
+        sk_sp<const GrBuffer> fIndirectBuffer;
+        size_t fIndirectOffset;
+    };
+
     // A set of contiguous draws that share a draw token, geometry processor, and pipeline. The
     // meshes for the draw are stored in the fMeshes array. The reason for coalescing meshes
     // that share a geometry processor into a Draw is that it allows the Gpu object to setup
@@ -286,10 +303,19 @@ private:
         const GrOp* fOp = nullptr;
         int fMeshCnt = 0;
         GrPrimitiveType fPrimitiveType;
+        // Runs of fMeshes that are drawn indirectly, in increasing order of fFirstMesh. Meshes
+        // outside of a run are drawn one at a time with drawMesh().
+        const IndirectRun* fIndirectRuns = nullptr;
+        int fIndirectRunCnt = 0;
     };
 
+    // Finds runs of meshes in the draw that can be combined into multi-draw indirect calls and
+    // writes their commands to the draw-indirect pool.
+    void recordIndirectRuns(Draw*);
+
     // Storage for ops' pipelines, draws, and inline uploads.
-    SkArenaAllocWithReset fArena{sizeof(GrPipeline) * 100};
+    std::unique_ptr<SkRetainingArenaAlloc> fOwnedArena;
+    SkRetainingArenaAlloc* fArena;
 
     // Store vertex and index data on behalf of ops that are flushed.
     GrVertexBufferAllocPool fVertexPool;
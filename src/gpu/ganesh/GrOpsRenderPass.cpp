@@ -213,6 +213,7 @@ bool GrOpsRenderPass::prepareToDraw() {
     if (kNone_GrXferBarrierType != fXferBarrierType) {
         this->gpu()->xferBarrier(fRenderTarget, fXferBarrierType);
     }
+    this->gpu()->counters()->add(skgpu::GpuCounter::kDrawCalls);
     return true;
 }
 
@@ -17,6 +17,7 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/core/SkImageFilterCache.h"
 #include "src/gpu/ganesh/GrAuditTrail.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrContextThreadSafeProxyPriv.h"
@@ -90,6 +91,8 @@ bool GrRecordingContext::init() {
 void GrRecordingContext::abandonContext() {
     GrImageContext::abandonContext();
 
+    // The cached results reference proxies that must not outlive the resource cache.
+    fImageFilterCache.reset();
     this->destroyDrawingManager();
 }
 
@@ -70,9 +70,11 @@ sktext::gpu::SDFTControl GrRecordingContextPriv::getSDFTControl(bool useSDFTForS
             useSDFTForSmallText,
             !this->caps()->disablePerspectiveSDFText(),
             this->options().fMinDistanceFieldFontSize,
-            this->options().fGlyphsAsPathsFontSize};
+            this->options().fGlyphsAsPathsFontSize,
+            this->options().fMaxGlyphMaskDimension,
+            this->options().fMultiChannelDistanceFieldText};
 #else
-    return sktext::gpu::SDFTControl{};
+    return sktext::gpu::SDFTControl{this->options().fMaxGlyphMaskDimension};
 #endif
 }
 
@@ -11,6 +11,7 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkTypes.h"
 #include "include/gpu/GrRecordingContext.h"
+#include "src/core/SkImageFilterCache.h"
 #include "src/gpu/RefCntedCallback.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/Device.h"
@@ -76,6 +77,12 @@ public:
 
     GrAuditTrail* auditTrail() { return this->context()->fAuditTrail.get(); }
 
+    // The cross-draw image filter cache, or null if each image filter evaluation should use its
+    // own transient cache.
+    sk_sp<SkImageFilterCache> imageFilterCache() const {
+        return this->context()->fImageFilterCache;
+    }
+
 #if defined(GR_TEST_UTILS)
     // Used by tests that intentionally exercise codepaths that print warning messages, in order to
     // not confuse users with output that looks like a testing failure.
@@ -7,6 +7,7 @@
 
 #include "src/gpu/ganesh/GrRenderTaskCluster.h"
 
+#include "include/private/base/SkTArray.h"
 #include "src/core/SkTHash.h"
 #include "src/gpu/ganesh/GrRenderTask.h"
 
@@ -88,9 +89,11 @@ static bool depends_on(GrRenderTask* depender, GrRenderTask* dependee) {
     return false;
 }
 
-// Returns whether reordering occurred.
+// Returns whether reordering occurred. Tasks that must stay behind the cluster are removed from
+// llist and added to deferredTasks; the caller appends them after `task`.
 static bool task_cluster_visit(GrRenderTask* task, SkTInternalLList<GrRenderTask>* llist,
-                               THashMap<GrSurfaceProxy*, GrRenderTask*>* lastTaskMap) {
+                               THashMap<GrSurfaceProxy*, GrRenderTask*>* lastTaskMap,
+                               TArray<GrRenderTask*>* deferredTasks) {
     CLUSTER_DEBUGF("Cluster: ***Step***\nLooking at %s\n",
                    describe_task(task).c_str());
     if (task->numTargets() != 1) {
@@ -132,25 +135,54 @@ static bool task_cluster_visit(GrRenderTask* task, SkTInternalLList<GrRenderTask
         clusterHead = clusterHead->fPrev;
     }
 
-    // We can't reorder if any moved task depends on anything in the cluster.
-    // Time complexity here is high, but making a hash set is worse in profiling.
+    // Moved tasks that depend on anything in the cluster, directly or through another such task,
+    // have to stay behind the cluster. Time complexity here is high, but making a hash set is worse
+    // in profiling.
+    TArray<GrRenderTask*> pinned;
     for (GrRenderTask* moved = movedHead; moved; moved = moved->fNext) {
+        bool isPinned = false;
         for (GrRenderTask* passed = clusterHead; passed != movedHead; passed = passed->fNext) {
             if (depends_on(moved, passed)) {
-                return false;
+                isPinned = true;
+                break;
             }
         }
+        for (int i = 0; !isPinned && i < pinned.size(); ++i) {
+            isPinned = depends_on(moved, pinned[i]);
+        }
+        if (isPinned) {
+            pinned.push_back(moved);
+        }
     }
 
-    // Grab the moved tasks and pull them before clusterHead.
+    // If some tasks have to stay behind the cluster, we can still extend the cluster by placing
+    // the new task ahead of them, as long as it is independent of all of them. This is common for
+    // offscreen layers that are redrawn after the cluster samples them.
+    for (GrRenderTask* p : pinned) {
+        if (depends_on(task, p) || depends_on(p, task)) {
+            return false;
+        }
+    }
+
+    // Grab the independent moved tasks and pull them before clusterHead. The pinned ones are
+    // deferred until after the new task.
+    int pinnedIndex = 0;
     for (GrRenderTask* moved = movedHead; moved;) {
-        CLUSTER_DEBUGF("Cluster: Reorder %s behind %s.\n",
-                       describe_task(moved).c_str(),
-                       describe_task(clusterHead).c_str());
         // Be careful to save fNext before each move.
         GrRenderTask* nextMoved = moved->fNext;
         llist->remove(moved);
-        llist->addBefore(moved, clusterHead);
+        if (pinnedIndex < pinned.size() && moved == pinned[pinnedIndex]) {
+            CLUSTER_DEBUGF("Cluster: Defer %s past %s.\n",
+                           describe_task(moved).c_str(),
+                           describe_task(task).c_str());
+            deferredTasks->push_back(moved);
+            ++pinnedIndex;
+        } else {
+            CLUSTER_DEBUGF("Cluster: Reorder %s behind %s.\n",
+                           describe_task(moved).c_str(),
+                           describe_task(clusterHead).c_str());
+            llist->addBefore(moved, clusterHead);
+        }
         moved = nextMoved;
     }
     return true;
@@ -170,10 +202,15 @@ bool GrClusterRenderTasks(SkSpan<const sk_sp<GrRenderTask>> input,
     CLUSTER_DEBUGF("Cluster: Original order is %s\n", describe_tasks(input).c_str());
 
     THashMap<GrSurfaceProxy*, GrRenderTask*> lastTaskMap;
+    TArray<GrRenderTask*> deferredTasks;
     bool didReorder = false;
     for (const auto& t : input) {
-        didReorder |= task_cluster_visit(t.get(), llist, &lastTaskMap);
+        didReorder |= task_cluster_visit(t.get(), llist, &lastTaskMap, &deferredTasks);
         llist->addToTail(t.get());
+        for (GrRenderTask* deferred : deferredTasks) {
+            llist->addToTail(deferred);
+        }
+        deferredTasks.clear();
         CLUSTER_DEBUGF("Cluster: Output order is now: %s\n", describe_tasks(*llist).c_str());
     }
 
@@ -22,7 +22,9 @@ class GrRenderTask;
 // Otherwise, returns true and populates the provided llist as such:
 //   - Contains the same set of tasks as `input`.
 //   - Obeys the dependency rules in `input`.
-//   - Places tasks with the same target adjacent to each other.
+//   - Places tasks with the same target adjacent to each other. Tasks that have to stay behind
+//     a cluster (e.g. a layer that is redrawn after the cluster samples it) are moved after a
+//     later task that extends the cluster, if that task is independent of them.
 //   - Tasks with multiple targets act as reordering barriers for all their targets.
 bool GrClusterRenderTasks(SkSpan<const sk_sp<GrRenderTask>> input,
                           SkTInternalLList<GrRenderTask>* llist);
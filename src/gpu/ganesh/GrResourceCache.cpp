@@ -8,6 +8,7 @@
 #include "src/gpu/ganesh/GrResourceCache.h"
 #include <atomic>
 #include <vector>
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/base/SingleOwner.h"
 #include "include/private/base/SkTo.h"
@@ -68,6 +69,51 @@ void GrResourceCache::setLimit(size_t bytes) {
     this->purgeAsNeeded();
 }
 
+void GrResourceCache::didEndFrame() {
+    if (!fAdaptiveBudget) {
+        return;
+    }
+
+    fWorkingSetHistory[fWorkingSetHistoryIndex] = fCurrentFrame.fWorkingSetBytes;
+    fWorkingSetHistoryIndex = (fWorkingSetHistoryIndex + 1) % kAdaptiveBudgetFrames;
+
+    // Only resources that weren't used in this frame are purged, so the working set survives even
+    // when it's larger than the budget.
+    const size_t budget = this->getAdaptiveBudget();
+    while (fBudgetedBytes > budget && fPurgeableQueue.count()) {
+        GrGpuResource* resource = fPurgeableQueue.peek();
+        if (resource->cacheAccess().timestamp() >= fFrameStartTimestamp) {
+            break;
+        }
+        fCurrentFrame.fPurgedBytes += resource->gpuMemorySize();
+        resource->cacheAccess().release();
+    }
+
+    TRACE_EVENT_INSTANT2("skia.gpu.cache", "GrResourceCache::didEndFrame",
+                         TRACE_EVENT_SCOPE_THREAD,
+                         "working_set", fCurrentFrame.fWorkingSetBytes,
+                         "budget", budget);
+    fLastFrame = fCurrentFrame;
+    fCurrentFrame = {};
+    fFrameStartTimestamp = fTimestamp;
+}
+
+size_t GrResourceCache::getAdaptiveBudget() const {
+    size_t peak = 0;
+    for (size_t bytes : fWorkingSetHistory) {
+        peak = std::max(peak, bytes);
+    }
+    return std::min(fMaxBytes, peak + peak / 2);
+}
+
+void GrResourceCache::noteResourceUse(const GrGpuResource* resource) {
+    if (fAdaptiveBudget &&
+        resource->resourcePriv().budgetedType() == GrBudgetedType::kBudgeted &&
+        resource->cacheAccess().timestamp() < fFrameStartTimestamp) {
+        fCurrentFrame.fWorkingSetBytes += resource->gpuMemorySize();
+    }
+}
+
 void GrResourceCache::insertResource(GrGpuResource* resource) {
     ASSERT_SINGLE_OWNER
     SkASSERT(resource);
@@ -91,6 +137,11 @@ void GrResourceCache::insertResource(GrGpuResource* resource) {
     if (GrBudgetedType::kBudgeted == resource->resourcePriv().budgetedType()) {
         ++fBudgetedCount;
         fBudgetedBytes += size;
+        if (fAdaptiveBudget) {
+            fCurrentFrame.fWorkingSetBytes += size;
+            ++fCurrentFrame.fMisses;
+            fCurrentFrame.fMissBytes += size;
+        }
         TRACE_COUNTER2("skia.gpu.cache", "skia budget", "used",
                        fBudgetedBytes, "free", fMaxBytes - fBudgetedBytes);
 #if GR_CACHE_STATS
@@ -212,6 +263,7 @@ GrGpuResource* GrResourceCache::findAndRefScratchResource(const skgpu::ScratchKe
 
     GrGpuResource* resource = fScratchMap.find(scratchKey);
     if (resource) {
+        ++fCurrentFrame.fHits;
         fScratchMap.remove(scratchKey, resource);
         this->refAndMakeResourceMRU(resource);
         this->validate();
@@ -306,6 +358,7 @@ void GrResourceCache::refAndMakeResourceMRU(GrGpuResource* resource) {
     }
     resource->cacheAccess().ref();
 
+    this->noteResourceUse(resource);
     resource->cacheAccess().setTimestamp(this->getNextTimestamp());
     this->validate();
 }
@@ -662,6 +715,9 @@ uint32_t GrResourceCache::getNextTimestamp() {
     // If we wrap then all the existing resources will appear older than any resources that get
     // a timestamp after the wrap.
     if (0 == fTimestamp) {
+        // The current frame starts over as well, so everything still in the cache looks like it
+        // was used in it. That only means the adaptive budget doesn't purge this frame.
+        fFrameStartTimestamp = 0;
         int count = this->getResourceCount();
         if (count) {
             // Reset all the timestamps. We sort the resources by timestamp and then assign
@@ -727,6 +783,22 @@ void GrResourceCache::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) c
     for (int i = 0; i < fPurgeableQueue.count(); ++i) {
         fPurgeableQueue.at(i)->dumpMemoryStatistics(traceMemoryDump);
     }
+
+    if (fAdaptiveBudget) {
+        // Resources that are created again soon after being purged show up as misses in a frame
+        // that follows a frame with purged bytes.
+        static constexpr char kDumpName[] = "skia/gpu_resources/resource_cache";
+        traceMemoryDump->dumpNumericValue(kDumpName, "adaptive_budget", "bytes",
+                                          this->getAdaptiveBudget());
+        traceMemoryDump->dumpNumericValue(kDumpName, "working_set_size", "bytes",
+                                          fLastFrame.fWorkingSetBytes);
+        traceMemoryDump->dumpNumericValue(kDumpName, "hits", "objects", fLastFrame.fHits);
+        traceMemoryDump->dumpNumericValue(kDumpName, "misses", "objects", fLastFrame.fMisses);
+        traceMemoryDump->dumpNumericValue(kDumpName, "miss_size", "bytes",
+                                          fLastFrame.fMissBytes);
+        traceMemoryDump->dumpNumericValue(kDumpName, "purged_size", "bytes",
+                                          fLastFrame.fPurgedBytes);
+    }
 }
 
 #if GR_CACHE_STATS
@@ -22,6 +22,8 @@
 #include "src/gpu/ganesh/GrGpuResourceCacheAccess.h"
 #include "src/gpu/ganesh/GrGpuResourcePriv.h"
 
+#include <array>
+
 class GrCaps;
 class GrProxyProvider;
 class SkString;
@@ -89,6 +91,21 @@ public:
     /** Sets the max gpu memory byte size of the cache. */
     void setLimit(size_t bytes);
 
+    /** Enables the budgeting described by GrContextOptions::fAdaptiveResourceCacheBudget. */
+    void setAdaptiveBudget(bool enabled) { fAdaptiveBudget = enabled; }
+
+    /**
+     * Marks the end of a frame. If the adaptive budget is enabled, this purges unlocked resources
+     * that weren't used in the frame until the cache fits in getAdaptiveBudget().
+     */
+    void didEndFrame();
+
+    /**
+     * Returns the byte budget the cache purges down to at the end of a frame if the adaptive
+     * budget is enabled. It is never more than getMaxResourceBytes().
+     */
+    size_t getAdaptiveBudget() const;
+
     /**
      * Returns the number of resources.
      */
@@ -151,6 +168,7 @@ public:
     GrGpuResource* findAndRefUniqueResource(const skgpu::UniqueKey& key) {
         GrGpuResource* resource = fUniqueHash.find(key);
         if (resource) {
+            ++fCurrentFrame.fHits;
             this->refAndMakeResourceMRU(resource);
         }
         return resource;
@@ -316,6 +334,10 @@ private:
 
     uint32_t getNextTimestamp();
 
+    // Adds the resource to the current frame's working set if it's budgeted and this is its first
+    // use in the frame. Must be called before the resource gets its new timestamp.
+    void noteResourceUse(const GrGpuResource*);
+
     void purgeUnlockedResources(const skgpu::StdSteadyClock::time_point* purgeTime,
                                 GrPurgeResourceOptions opts);
 
@@ -375,6 +397,23 @@ private:
     // our budget, used in purgeAsNeeded()
     size_t                              fMaxBytes = kDefaultMaxSize;
 
+    // The state of the adaptive budget. A resource whose timestamp is at least
+    // fFrameStartTimestamp has been used in the current frame.
+    struct FrameStats {
+        size_t fWorkingSetBytes = 0;
+        int    fHits = 0;
+        int    fMisses = 0;
+        size_t fMissBytes = 0;
+        size_t fPurgedBytes = 0;
+    };
+    static constexpr int kAdaptiveBudgetFrames = 60;
+    bool                                fAdaptiveBudget = false;
+    uint32_t                            fFrameStartTimestamp = 0;
+    FrameStats                          fCurrentFrame;
+    FrameStats                          fLastFrame;
+    std::array<size_t, kAdaptiveBudgetFrames> fWorkingSetHistory = {};
+    int                                 fWorkingSetHistoryIndex = 0;
+
 #if GR_CACHE_STATS
     int                                 fHighWaterCount = 0;
     size_t                              fHighWaterBytes = 0;
@@ -7,9 +7,7 @@
 
 #include "src/gpu/ganesh/GrRingBuffer.h"
 
-#include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrGpu.h"
-#include "src/gpu/ganesh/GrResourceProvider.h"
 
 // Get offset into buffer that has enough space for size
 // Returns fTotalSize if no space
@@ -68,13 +66,10 @@ GrRingBuffer::Slice GrRingBuffer::suballocate(size_t size) {
         fPreviousBuffers.push_back(std::move(fCurrentBuffer));
     }
 
-    GrResourceProvider* resourceProvider = fGpu->getContext()->priv().resourceProvider();
-    fCurrentBuffer = resourceProvider->createBuffer(fTotalSize,
-                                                    fType,
-                                                    kDynamic_GrAccessPattern,
-                                                    GrResourceProvider::ZeroInit::kNo);
-
-    SkASSERT(fCurrentBuffer);
+    fCurrentBuffer = fGpu->createRingBufferBuffer(fTotalSize, fType);
+    if (!fCurrentBuffer) {
+        return { nullptr, 0 };
+    }
     fHead = 0;
     fTail = 0;
     fGenID++;
@@ -86,7 +81,9 @@ GrRingBuffer::Slice GrRingBuffer::suballocate(size_t size) {
 // used when current command buffer/command list is submitted
 void GrRingBuffer::startSubmit(GrGpu* gpu) {
     for (unsigned int i = 0; i < fPreviousBuffers.size(); ++i) {
-        fPreviousBuffers[i]->unmap();
+        if (fPreviousBuffers[i]->isMapped()) {
+            fPreviousBuffers[i]->unmap();
+        }
         gpu->takeOwnershipOfBuffer(std::move(fPreviousBuffers[i]));
     }
     fPreviousBuffers.clear();
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/gpu/ganesh/GrStreamingReadback.h"
+
+#include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/private/base/SkTArray.h"
+#include "src/gpu/ganesh/Device.h"
+#include "src/gpu/ganesh/GrClientMappedBufferManager.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrGpuBuffer.h"
+#include "src/gpu/ganesh/GrResourceProvider.h"
+#include "src/gpu/ganesh/SurfaceDrawContext.h"
+#include "src/gpu/ganesh/surface/SkSurface_Ganesh.h"
+#include "src/image/SkSurface_Base.h"
+
+class GrStreamingReadback::Pool : public SkNVRefCnt<Pool> {
+public:
+    explicit Pool(int frameCount) : fFrames(frameCount) {
+        fFrames.push_back_n(frameCount);
+    }
+
+    // Returns the index of a frame whose transfer buffer may be reused, or -1 if there is none.
+    int findFreeFrame() const {
+        for (int i = 0; i < fFrames.size(); ++i) {
+            if (fFrames[i].isFree()) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int framesInFlight() const {
+        int count = 0;
+        for (const Frame& frame : fFrames) {
+            count += frame.isFree() ? 0 : 1;
+        }
+        return count;
+    }
+
+    int frameCount() const { return fFrames.size(); }
+
+    // Returns the transfer buffer of frame 'index', (re)creating it if it is too small.
+    sk_sp<GrGpuBuffer> bufferForFrame(GrResourceProvider* resourceProvider,
+                                      int index,
+                                      size_t size) {
+        Frame& frame = fFrames[index];
+        SkASSERT(frame.fState == Frame::State::kPending);
+        if (!frame.fBuffer || frame.fBuffer->size() < size) {
+            // Like one-shot reads, use a stream buffer that stays out of the scratch cache (see
+            // skbug.com/11297). Reuse comes from the pool holding on to it instead.
+            frame.fBuffer = resourceProvider->createBuffer(size,
+                                                           GrGpuBufferType::kXferGpuToCpu,
+                                                           GrAccessPattern::kStream_GrAccessPattern,
+                                                           GrResourceProvider::ZeroInit::kNo);
+        }
+        return frame.fBuffer;
+    }
+
+    void markPending(int index) { fFrames[index].fState = Frame::State::kPending; }
+    void markDelivered(int index) { fFrames[index].fState = Frame::State::kDelivered; }
+
+private:
+    struct Frame {
+        enum class State {
+            kFree,
+            kPending,    // The read was issued and the callback hasn't been called yet.
+            kDelivered,  // The result may still reference the mapped buffer.
+        };
+
+        bool isFree() const {
+            // Once the client destroys the result, GrClientMappedBufferManager unmaps the buffer.
+            return fState == State::kFree ||
+                   (fState == State::kDelivered && (!fBuffer || !fBuffer->isMapped()));
+        }
+
+        sk_sp<GrGpuBuffer> fBuffer;
+        State fState = State::kFree;
+    };
+
+    skia_private::TArray<Frame> fFrames;
+};
+
+std::unique_ptr<GrStreamingReadback> GrStreamingReadback::Make(GrDirectContext* context,
+                                                               int maxFramesInFlight) {
+    if (!context || context->abandoned() || maxFramesInFlight < 1) {
+        return nullptr;
+    }
+    return std::unique_ptr<GrStreamingReadback>(
+            new GrStreamingReadback(context, sk_make_sp<Pool>(maxFramesInFlight)));
+}
+
+GrStreamingReadback::GrStreamingReadback(GrDirectContext* context, sk_sp<Pool> pool)
+        : fContext(context), fPool(std::move(pool)) {}
+
+GrStreamingReadback::~GrStreamingReadback() = default;
+
+int GrStreamingReadback::framesInFlight() const { return fPool->framesInFlight(); }
+
+int GrStreamingReadback::maxFramesInFlight() const { return fPool->frameCount(); }
+
+bool GrStreamingReadback::readFrame(SkSurface* surface,
+                                    const SkImageInfo& dstInfo,
+                                    const SkIRect& srcRect,
+                                    SkImage::RescaleGamma rescaleGamma,
+                                    SkImage::RescaleMode rescaleMode,
+                                    SkImage::ReadPixelsCallback callback,
+                                    SkImage::ReadPixelsContext callbackContext) {
+    // Pick up finished reads and unmap the buffers of results the client has released so their
+    // frames can be reused.
+    fContext->checkAsyncWorkCompletion();
+    fContext->priv().clientMappedBufferManager()->process();
+
+    int frameIndex = fPool->findFreeFrame();
+    if (frameIndex < 0) {
+        return false;
+    }
+
+    if (!surface || fContext->abandoned() || surface->recordingContext() != fContext ||
+        !asSB(surface)->isGaneshBacked() ||
+        !SkIRect::MakeSize(surface->imageInfo().dimensions()).contains(srcRect)) {
+        callback(callbackContext, nullptr);
+        return true;
+    }
+
+    struct FrameContext {
+        sk_sp<Pool> fPool;
+        int fFrameIndex;
+        SkImage::ReadPixelsCallback* fClientCallback;
+        SkImage::ReadPixelsContext fClientContext;
+    };
+    auto* frameContext = new FrameContext{fPool, frameIndex, callback, callbackContext};
+    auto frameCallback = [](SkImage::ReadPixelsContext c,
+                            std::unique_ptr<const SkImage::AsyncReadResult> result) {
+        auto* context = static_cast<FrameContext*>(c);
+        context->fPool->markDelivered(context->fFrameIndex);
+        (*context->fClientCallback)(context->fClientContext, std::move(result));
+        delete context;
+    };
+
+    GrResourceProvider* resourceProvider = fContext->priv().resourceProvider();
+    skgpu::ganesh::SurfaceContext::TransferBufferProvider bufferProvider =
+            [pool = fPool.get(), resourceProvider, frameIndex](size_t size) {
+                return pool->bufferForFrame(resourceProvider, frameIndex, size);
+            };
+
+    fPool->markPending(frameIndex);
+    auto sdc = static_cast<SkSurface_Ganesh*>(surface)->getDevice()->surfaceDrawContext();
+    sdc->asyncRescaleAndReadPixels(fContext,
+                                   dstInfo,
+                                   srcRect,
+                                   rescaleGamma,
+                                   rescaleMode,
+                                   frameCallback,
+                                   frameContext,
+                                   &bufferProvider);
+    return true;
+}
@@ -8,6 +8,7 @@
 #include "src/gpu/ganesh/GrThreadSafeCache.h"
 
 #include "include/gpu/GrDirectContext.h"
+#include "include/private/base/SkTArray.h"
 #include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
@@ -17,6 +18,8 @@
 #include "src/gpu/ganesh/GrResourceCache.h"
 #include "src/gpu/ganesh/GrTexture.h"
 
+#include <algorithm>
+
 GrThreadSafeCache::VertexData::~VertexData () {
     this->reset();
 }
@@ -31,20 +34,20 @@ GrThreadSafeCache::~GrThreadSafeCache() {
 
 #if defined(GR_TEST_UTILS)
 int GrThreadSafeCache::numEntries() const {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexShared lock{fLock};
 
     return fUniquelyKeyedEntryMap.count();
 }
 
 size_t GrThreadSafeCache::approxBytesUsedForHash() const {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexShared lock{fLock};
 
     return fUniquelyKeyedEntryMap.approxBytesUsed();
 }
 #endif
 
 void GrThreadSafeCache::dropAllRefs() {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexExclusive lock{fLock};
 
     fUniquelyKeyedEntryMap.reset();
     while (auto tmp = fUniquelyKeyedEntryList.head()) {
@@ -57,7 +60,9 @@ void GrThreadSafeCache::dropAllRefs() {
 // TODO: If iterating becomes too expensive switch to using something like GrIORef for the
 // GrSurfaceProxy
 void GrThreadSafeCache::dropUniqueRefs(GrResourceCache* resourceCache) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexExclusive lock{fLock};
+
+    this->sortEntriesMRU();
 
     // Iterate from LRU to MRU
     Entry* cur = fUniquelyKeyedEntryList.tail();
@@ -80,14 +85,16 @@ void GrThreadSafeCache::dropUniqueRefs(GrResourceCache* resourceCache) {
 }
 
 void GrThreadSafeCache::dropUniqueRefsOlderThan(skgpu::StdSteadyClock::time_point purgeTime) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexExclusive lock{fLock};
+
+    this->sortEntriesMRU();
 
     // Iterate from LRU to MRU
     Entry* cur = fUniquelyKeyedEntryList.tail();
     Entry* prev = cur ? cur->fPrev : nullptr;
 
     while (cur) {
-        if (cur->fLastAccess >= purgeTime) {
+        if (cur->fLastAccess.load(std::memory_order_relaxed) >= purgeTime) {
             // This entry and all the remaining ones in the list will be newer than 'purgeTime'
             return;
         }
@@ -103,19 +110,33 @@ void GrThreadSafeCache::dropUniqueRefsOlderThan(skgpu::StdSteadyClock::time_poin
     }
 }
 
-void GrThreadSafeCache::makeExistingEntryMRU(Entry* entry) {
-    SkASSERT(fUniquelyKeyedEntryList.isInList(entry));
+void GrThreadSafeCache::markAccessed(Entry* entry) {
+    entry->fLastAccess.store(skgpu::StdSteadyClock::now(), std::memory_order_relaxed);
+    entry->fAccessStamp.store(fNextAccessStamp.fetch_add(1, std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+}
+
+void GrThreadSafeCache::sortEntriesMRU() {
+    skia_private::TArray<Entry*> entries(fUniquelyKeyedEntryMap.count());
+    while (Entry* entry = fUniquelyKeyedEntryList.head()) {
+        fUniquelyKeyedEntryList.remove(entry);
+        entries.push_back(entry);
+    }
 
-    entry->fLastAccess = skgpu::StdSteadyClock::now();
-    fUniquelyKeyedEntryList.remove(entry);
-    fUniquelyKeyedEntryList.addToHead(entry);
+    std::sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b) {
+        return a->fAccessStamp.load(std::memory_order_relaxed) >
+               b->fAccessStamp.load(std::memory_order_relaxed);
+    });
+    for (Entry* entry : entries) {
+        fUniquelyKeyedEntryList.addToTail(entry);
+    }
 }
 
 std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::internalFind(
                                                        const skgpu::UniqueKey& key) {
     Entry* tmp = fUniquelyKeyedEntryMap.find(key);
     if (tmp) {
-        this->makeExistingEntryMRU(tmp);
+        this->markAccessed(tmp);
         return { tmp->view(), tmp->refCustomData() };
     }
 
@@ -124,7 +145,7 @@ std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::internalFind(
 
 #ifdef SK_DEBUG
 bool GrThreadSafeCache::has(const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexShared lock{fLock};
 
     Entry* tmp = fUniquelyKeyedEntryMap.find(key);
     return SkToBool(tmp);
@@ -132,7 +153,7 @@ bool GrThreadSafeCache::has(const skgpu::UniqueKey& key) {
 #endif
 
 GrSurfaceProxyView GrThreadSafeCache::find(const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexShared lock{fLock};
 
     GrSurfaceProxyView view;
     std::tie(view, std::ignore) = this->internalFind(key);
@@ -141,7 +162,7 @@ GrSurfaceProxyView GrThreadSafeCache::find(const skgpu::UniqueKey& key) {
 
 std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::findWithData(
         const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexShared lock{fLock};
 
     return this->internalFind(key);
 }
@@ -164,7 +185,7 @@ GrThreadSafeCache::Entry* GrThreadSafeCache::getEntry(const skgpu::UniqueKey& ke
 }
 
 GrThreadSafeCache::Entry* GrThreadSafeCache::makeNewEntryMRU(Entry* entry) {
-    entry->fLastAccess = skgpu::StdSteadyClock::now();
+    this->markAccessed(entry);
     fUniquelyKeyedEntryList.addToHead(entry);
     fUniquelyKeyedEntryMap.add(entry);
     return entry;
@@ -211,7 +232,7 @@ std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::internalAdd(
 
 GrSurfaceProxyView GrThreadSafeCache::add(const skgpu::UniqueKey& key,
                                           const GrSurfaceProxyView& view) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexExclusive lock{fLock};
 
     GrSurfaceProxyView newView;
     std::tie(newView, std::ignore) = this->internalAdd(key, view);
@@ -221,14 +242,14 @@ GrSurfaceProxyView GrThreadSafeCache::add(const skgpu::UniqueKey& key,
 std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::addWithData(
                                                                 const skgpu::UniqueKey& key,
                                                                 const GrSurfaceProxyView& view) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexExclusive lock{fLock};
 
     return this->internalAdd(key, view);
 }
 
 GrSurfaceProxyView GrThreadSafeCache::findOrAdd(const skgpu::UniqueKey& key,
                                                 const GrSurfaceProxyView& v) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexExclusive lock{fLock};
 
     GrSurfaceProxyView view;
     std::tie(view, std::ignore) = this->internalFind(key);
@@ -243,7 +264,7 @@ GrSurfaceProxyView GrThreadSafeCache::findOrAdd(const skgpu::UniqueKey& key,
 std::tuple<GrSurfaceProxyView, sk_sp<SkData>> GrThreadSafeCache::findOrAddWithData(
                                                                       const skgpu::UniqueKey& key,
                                                                       const GrSurfaceProxyView& v) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexExclusive lock{fLock};
 
     auto [view, data] = this->internalFind(key);
     if (view) {
@@ -269,7 +290,7 @@ std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>>
         GrThreadSafeCache::internalFindVerts(const skgpu::UniqueKey& key) {
     Entry* tmp = fUniquelyKeyedEntryMap.find(key);
     if (tmp) {
-        this->makeExistingEntryMRU(tmp);
+        this->markAccessed(tmp);
         return { tmp->vertexData(), tmp->refCustomData() };
     }
 
@@ -278,7 +299,7 @@ std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>>
 
 std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>>
         GrThreadSafeCache::findVertsWithData(const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexShared lock{fLock};
 
     return this->internalFindVerts(key);
 }
@@ -305,13 +326,13 @@ std::tuple<sk_sp<GrThreadSafeCache::VertexData>, sk_sp<SkData>> GrThreadSafeCach
                                                                     const skgpu::UniqueKey& key,
                                                                     sk_sp<VertexData> vertData,
                                                                     IsNewerBetter isNewerBetter) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexExclusive lock{fLock};
 
     return this->internalAddVerts(key, std::move(vertData), isNewerBetter);
 }
 
 void GrThreadSafeCache::remove(const skgpu::UniqueKey& key) {
-    SkAutoSpinlock lock{fSpinLock};
+    SkAutoSharedMutexExclusive lock{fLock};
 
     Entry* tmp = fUniquelyKeyedEntryMap.find(key);
     if (tmp) {
@@ -10,13 +10,16 @@
 
 #include "include/core/SkRefCnt.h"
 #include "src/base/SkArenaAlloc.h"
-#include "src/base/SkSpinlock.h"
+#include "src/base/SkSharedMutex.h"
 #include "src/base/SkTInternalLList.h"
 #include "src/core/SkTDynamicHash.h"
 #include "src/gpu/ganesh/GrGpuBuffer.h"
 #include "src/gpu/ganesh/GrSurfaceProxy.h"
 #include "src/gpu/ganesh/GrSurfaceProxyView.h"
 
+#include <atomic>
+#include <cstdint>
+
 // Ganesh creates a lot of utility textures (e.g., blurred-rrect masks) that need to be shared
 // between the direct context and all the DDL recording contexts. This thread-safe cache
 // allows this sharing.
@@ -31,6 +34,11 @@
 // add a place holder view and then queue up the draw calls to complete it. In this way the
 // gpu-thread has precedence over the recording threads.
 //
+// Lookups far outnumber additions once the DDL threads have warmed the cache up, so lookups only
+// hold the lock shared and many recorders can find entries at the same time. To allow that, a
+// lookup doesn't move the entry it finds to the head of the LRU list. It just stamps the entry,
+// and the list is put back into MRU order, under the exclusive lock, before it is purged.
+//
 // The invariants for this cache differ a bit from those of the proxy and resource caches.
 // For this cache:
 //
@@ -69,36 +77,36 @@ public:
     ~GrThreadSafeCache();
 
 #if defined(GR_TEST_UTILS)
-    int numEntries() const  SK_EXCLUDES(fSpinLock);
+    int numEntries() const  SK_EXCLUDES(fLock);
 
-    size_t approxBytesUsedForHash() const  SK_EXCLUDES(fSpinLock);
+    size_t approxBytesUsedForHash() const  SK_EXCLUDES(fLock);
 #endif
 
-    void dropAllRefs()  SK_EXCLUDES(fSpinLock);
+    void dropAllRefs()  SK_EXCLUDES(fLock);
 
     // Drop uniquely held refs until under the resource cache's budget.
     // A null parameter means drop all uniquely held refs.
-    void dropUniqueRefs(GrResourceCache* resourceCache)  SK_EXCLUDES(fSpinLock);
+    void dropUniqueRefs(GrResourceCache* resourceCache)  SK_EXCLUDES(fLock);
 
     // Drop uniquely held refs that were last accessed before 'purgeTime'
     void dropUniqueRefsOlderThan(
-            skgpu::StdSteadyClock::time_point purgeTime)  SK_EXCLUDES(fSpinLock);
+            skgpu::StdSteadyClock::time_point purgeTime)  SK_EXCLUDES(fLock);
 
-    SkDEBUGCODE(bool has(const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);)
+    SkDEBUGCODE(bool has(const skgpu::UniqueKey&)  SK_EXCLUDES(fLock);)
 
-    GrSurfaceProxyView find(const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);
+    GrSurfaceProxyView find(const skgpu::UniqueKey&)  SK_EXCLUDES(fLock);
     std::tuple<GrSurfaceProxyView, sk_sp<SkData>> findWithData(
-            const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);
+            const skgpu::UniqueKey&)  SK_EXCLUDES(fLock);
 
     GrSurfaceProxyView add(
-            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_EXCLUDES(fSpinLock);
+            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_EXCLUDES(fLock);
     std::tuple<GrSurfaceProxyView, sk_sp<SkData>> addWithData(
-            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_EXCLUDES(fSpinLock);
+            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_EXCLUDES(fLock);
 
     GrSurfaceProxyView findOrAdd(const skgpu::UniqueKey&,
-                                 const GrSurfaceProxyView&)  SK_EXCLUDES(fSpinLock);
+                                 const GrSurfaceProxyView&)  SK_EXCLUDES(fLock);
     std::tuple<GrSurfaceProxyView, sk_sp<SkData>> findOrAddWithData(
-            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_EXCLUDES(fSpinLock);
+            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_EXCLUDES(fLock);
 
     // To hold vertex data in the cache and have it transparently transition from cpu-side to
     // gpu-side while being shared between all the threads we need a ref counted object that
@@ -165,16 +173,16 @@ public:
                                             size_t vertexSize);
 
     std::tuple<sk_sp<VertexData>, sk_sp<SkData>> findVertsWithData(
-            const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);
+            const skgpu::UniqueKey&)  SK_EXCLUDES(fLock);
 
     typedef bool (*IsNewerBetter)(SkData* incumbent, SkData* challenger);
 
     std::tuple<sk_sp<VertexData>, sk_sp<SkData>> addVertsWithData(
                                                         const skgpu::UniqueKey&,
                                                         sk_sp<VertexData>,
-                                                        IsNewerBetter)  SK_EXCLUDES(fSpinLock);
+                                                        IsNewerBetter)  SK_EXCLUDES(fLock);
 
-    void remove(const skgpu::UniqueKey&)  SK_EXCLUDES(fSpinLock);
+    void remove(const skgpu::UniqueKey&)  SK_EXCLUDES(fLock);
 
     // To allow gpu-created resources to have priority, we pre-emptively place a lazy proxy
     // in the thread-safe cache (with findOrAdd). The Trampoline object allows that lazy proxy to
@@ -268,8 +276,11 @@ private:
             fTag = kVertData;
         }
 
-        // The thread-safe cache gets to directly manipulate the llist and last-access members
-        skgpu::StdSteadyClock::time_point fLastAccess;
+        // The thread-safe cache gets to directly manipulate the llist and last-access members.
+        // The last-access members are written by lookups, which only hold the lock shared.
+        std::atomic<skgpu::StdSteadyClock::time_point> fLastAccess;
+        // Orders the entries by their last access; larger is more recent.
+        std::atomic<uint64_t> fAccessStamp;
         SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
 
         // for SkTDynamicHash
@@ -294,36 +305,39 @@ private:
         } fTag { kEmpty };
     };
 
-    void makeExistingEntryMRU(Entry*)  SK_REQUIRES(fSpinLock);
-    Entry* makeNewEntryMRU(Entry*)  SK_REQUIRES(fSpinLock);
+    void markAccessed(Entry*)  SK_REQUIRES_SHARED(fLock);
+    void sortEntriesMRU()  SK_REQUIRES(fLock);
+    Entry* makeNewEntryMRU(Entry*)  SK_REQUIRES(fLock);
 
-    Entry* getEntry(const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_REQUIRES(fSpinLock);
-    Entry* getEntry(const skgpu::UniqueKey&, sk_sp<VertexData>)  SK_REQUIRES(fSpinLock);
+    Entry* getEntry(const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_REQUIRES(fLock);
+    Entry* getEntry(const skgpu::UniqueKey&, sk_sp<VertexData>)  SK_REQUIRES(fLock);
 
-    void recycleEntry(Entry*)  SK_REQUIRES(fSpinLock);
+    void recycleEntry(Entry*)  SK_REQUIRES(fLock);
 
     std::tuple<GrSurfaceProxyView, sk_sp<SkData>> internalFind(
-            const skgpu::UniqueKey&)  SK_REQUIRES(fSpinLock);
+            const skgpu::UniqueKey&)  SK_REQUIRES_SHARED(fLock);
     std::tuple<GrSurfaceProxyView, sk_sp<SkData>> internalAdd(
-            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_REQUIRES(fSpinLock);
+            const skgpu::UniqueKey&, const GrSurfaceProxyView&)  SK_REQUIRES(fLock);
 
     std::tuple<sk_sp<VertexData>, sk_sp<SkData>> internalFindVerts(
-            const skgpu::UniqueKey&)  SK_REQUIRES(fSpinLock);
+            const skgpu::UniqueKey&)  SK_REQUIRES_SHARED(fLock);
     std::tuple<sk_sp<VertexData>, sk_sp<SkData>> internalAddVerts(
-            const skgpu::UniqueKey&, sk_sp<VertexData>, IsNewerBetter)  SK_REQUIRES(fSpinLock);
+            const skgpu::UniqueKey&, sk_sp<VertexData>, IsNewerBetter)  SK_REQUIRES(fLock);
 
-    mutable SkSpinlock fSpinLock;
+    mutable SkSharedMutex fLock;
 
-    SkTDynamicHash<Entry, skgpu::UniqueKey> fUniquelyKeyedEntryMap  SK_GUARDED_BY(fSpinLock);
+    SkTDynamicHash<Entry, skgpu::UniqueKey> fUniquelyKeyedEntryMap  SK_GUARDED_BY(fLock);
     // The head of this list is the MRU
-    SkTInternalLList<Entry>            fUniquelyKeyedEntryList  SK_GUARDED_BY(fSpinLock);
+    SkTInternalLList<Entry>            fUniquelyKeyedEntryList  SK_GUARDED_BY(fLock);
 
     // TODO: empirically determine this from the skps
     static const int kInitialArenaSize = 64 * sizeof(Entry);
 
     char                         fStorage[kInitialArenaSize];
     SkArenaAlloc                 fEntryAllocator{fStorage, kInitialArenaSize, kInitialArenaSize};
-    Entry*                       fFreeEntryList  SK_GUARDED_BY(fSpinLock);
+    Entry*                       fFreeEntryList  SK_GUARDED_BY(fLock);
+
+    std::atomic<uint64_t>        fNextAccessStamp{0};
 };
 
 #endif // GrThreadSafeCache_DEFINED
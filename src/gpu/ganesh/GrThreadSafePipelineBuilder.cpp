@@ -50,11 +50,16 @@ void GrThreadSafePipelineBuilder::Stats::dump(SkString* out) {
     out->appendf("Total number of partial compilation successes %d\n",
                  fNumPartialCompilationSuccesses.load());
     out->appendf("Total number of compilation successes %d\n", fNumCompilationSuccesses.load());
+    out->appendf("Number of async compilations %d\n", fNumAsyncCompilations.load());
+    out->appendf("Number of async compilation stalls %d\n", fNumAsyncCompilationStalls.load());
 }
 
 void GrThreadSafePipelineBuilder::Stats::dumpKeyValuePairs(TArray<SkString>* keys,
                                                            TArray<double>* values) {
     keys->push_back(SkString("shader_compilations")); values->push_back(fShaderCompilations);
+    keys->push_back(SkString("async_compilations")); values->push_back(fNumAsyncCompilations);
+    keys->push_back(SkString("async_compilation_stalls"));
+    values->push_back(fNumAsyncCompilationStalls);
 }
 
 #endif // defined(GR_TEST_UTILS)
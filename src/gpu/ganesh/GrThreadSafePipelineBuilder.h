@@ -68,6 +68,15 @@ public:
         int numCompilationSuccesses() const { return fNumCompilationSuccesses; }
         void incNumCompilationSuccesses() { ++fNumCompilationSuccesses; }
 
+        // Programs the driver compiled on another thread.
+        int numAsyncCompilations() const { return fNumAsyncCompilations; }
+        void incNumAsyncCompilations() { ++fNumAsyncCompilations; }
+
+        // Pipeline binds that had to wait because their program was still being compiled on
+        // another thread.
+        int numAsyncCompilationStalls() const { return fNumAsyncCompilationStalls; }
+        void incNumAsyncCompilationStalls() { ++fNumAsyncCompilationStalls; }
+
 #if defined(GR_TEST_UTILS)
         void dump(SkString*);
         void dumpKeyValuePairs(skia_private::TArray<SkString>* keys, skia_private::TArray<double>* values);
@@ -86,6 +95,9 @@ public:
         std::atomic<int> fNumPartialCompilationSuccesses{0};
         std::atomic<int> fNumCompilationSuccesses{0};
 
+        std::atomic<int> fNumAsyncCompilations{0};
+        std::atomic<int> fNumAsyncCompilationStalls{0};
+
 #else
         void incShaderCompilations() {}
         void incNumInlineCompilationFailures() {}
@@ -95,6 +107,8 @@ public:
         void incNumCompilationFailures() {}
         void incNumPartialCompilationSuccesses() {}
         void incNumCompilationSuccesses() {}
+        void incNumAsyncCompilations() {}
+        void incNumAsyncCompilationStalls() {}
 
 #if defined(GR_TEST_UTILS)
         void dump(SkString*) {}
@@ -556,7 +556,8 @@ void SurfaceContext::asyncRescaleAndReadPixels(GrDirectContext* dContext,
                                                RescaleGamma rescaleGamma,
                                                RescaleMode rescaleMode,
                                                ReadPixelsCallback callback,
-                                               ReadPixelsContext callbackContext) {
+                                               ReadPixelsContext callbackContext,
+                                               const TransferBufferProvider* bufferProvider) {
     if (!dContext) {
         callback(callbackContext, nullptr);
         return;
@@ -618,14 +619,16 @@ void SurfaceContext::asyncRescaleAndReadPixels(GrDirectContext* dContext,
                                    SkIRect::MakePtSize({x, y}, info.dimensions()),
                                    info.colorType(),
                                    callback,
-                                   callbackContext);
+                                   callbackContext,
+                                   bufferProvider);
 }
 
 void SurfaceContext::asyncReadPixels(GrDirectContext* dContext,
                                      const SkIRect& rect,
                                      SkColorType colorType,
                                      ReadPixelsCallback callback,
-                                     ReadPixelsContext callbackContext) {
+                                     ReadPixelsContext callbackContext,
+                                     const TransferBufferProvider* bufferProvider) {
     using AsyncReadResult = skgpu::TAsyncReadResult<GrGpuBuffer, GrDirectContext::DirectContextID,
                                                     PixelTransferResult>;
 
@@ -639,7 +642,8 @@ void SurfaceContext::asyncReadPixels(GrDirectContext* dContext,
 
     auto mappedBufferManager = dContext->priv().clientMappedBufferManager();
 
-    auto transferResult = this->transferPixels(SkColorTypeToGrColorType(colorType), rect);
+    auto transferResult =
+            this->transferPixels(SkColorTypeToGrColorType(colorType), rect, bufferProvider);
 
     if (!transferResult.fTransferBuffer) {
         auto ii = SkImageInfo::Make(rect.size(), colorType, this->colorInfo().alphaType(),
@@ -1287,8 +1291,10 @@ bool SurfaceContext::rescaleInto(SurfaceFillContext* dst,
     return true;
 }
 
-SurfaceContext::PixelTransferResult SurfaceContext::transferPixels(GrColorType dstCT,
-                                                                   const SkIRect& rect) {
+SurfaceContext::PixelTransferResult SurfaceContext::transferPixels(
+        GrColorType dstCT,
+        const SkIRect& rect,
+        const TransferBufferProvider* bufferProvider) {
     SkASSERT(rect.fLeft >= 0 && rect.fRight <= this->width());
     SkASSERT(rect.fTop >= 0 && rect.fBottom <= this->height());
     auto direct = fContext->asDirectContext();
@@ -1320,14 +1326,20 @@ SurfaceContext::PixelTransferResult SurfaceContext::transferPixels(GrColorType d
     size_t rowBytes = GrColorTypeBytesPerPixel(supportedRead.fColorType) * rect.width();
     rowBytes = SkAlignTo(rowBytes, this->caps()->transferBufferRowBytesAlignment());
     size_t size = rowBytes * rect.height();
-    // By using kStream_GrAccessPattern here, we are not able to cache and reuse the buffer for
-    // multiple reads. Switching to kDynamic_GrAccessPattern would allow for this, however doing
-    // so causes a crash in a chromium test. See skbug.com/11297
-    auto buffer = direct->priv().resourceProvider()->createBuffer(
-            size,
-            GrGpuBufferType::kXferGpuToCpu,
-            GrAccessPattern::kStream_GrAccessPattern,
-            GrResourceProvider::ZeroInit::kNo);
+    sk_sp<GrGpuBuffer> buffer;
+    if (bufferProvider) {
+        buffer = (*bufferProvider)(size);
+        SkASSERT(!buffer || (buffer->size() >= size && !buffer->isMapped()));
+    } else {
+        // By using kStream_GrAccessPattern here, we are not able to cache and reuse the buffer for
+        // multiple reads. Switching to kDynamic_GrAccessPattern would allow for this, however
+        // doing so causes a crash in a chromium test. See skbug.com/11297
+        buffer = direct->priv().resourceProvider()->createBuffer(
+                size,
+                GrGpuBufferType::kXferGpuToCpu,
+                GrAccessPattern::kStream_GrAccessPattern,
+                GrResourceProvider::ZeroInit::kNo);
+    }
     if (!buffer) {
         return {};
     }
@@ -22,6 +22,8 @@
 #include "src/gpu/ganesh/GrSurfaceProxy.h"
 #include "src/gpu/ganesh/GrSurfaceProxyView.h"
 
+#include <functional>
+
 class GrDrawingManager;
 class GrRecordingContext;
 class GrRenderTargetProxy;
@@ -80,14 +82,20 @@ public:
     using RescaleGamma       = SkImage::RescaleGamma;
     using RescaleMode        = SkImage::RescaleMode;
 
-    // GPU implementation for SkImage:: and SkSurface::asyncRescaleAndReadPixels.
+    // Supplies the GPU-to-CPU transfer buffer of at least 'size' bytes that an async read
+    // transfers into. Returning null falls back to a synchronous read.
+    using TransferBufferProvider = std::function<sk_sp<GrGpuBuffer>(size_t size)>;
+
+    // GPU implementation for SkImage:: and SkSurface::asyncRescaleAndReadPixels. If
+    // 'bufferProvider' is null, a new transfer buffer is created for the read.
     void asyncRescaleAndReadPixels(GrDirectContext*,
                                    const SkImageInfo& info,
                                    const SkIRect& srcRect,
                                    RescaleGamma rescaleGamma,
                                    RescaleMode,
                                    ReadPixelsCallback callback,
-                                   ReadPixelsContext callbackContext);
+                                   ReadPixelsContext callbackContext,
+                                   const TransferBufferProvider* bufferProvider = nullptr);
 
     // GPU implementation for SkImage:: and SkSurface::asyncRescaleAndReadPixelsYUV420.
     void asyncRescaleAndReadPixelsYUV420(GrDirectContext*,
@@ -200,14 +208,17 @@ protected:
         // from the transfer buffer's color type to the requested color type.
         std::function<ConversionFn> fPixelConverter;
     };
-    PixelTransferResult transferPixels(GrColorType colorType, const SkIRect& rect);
+    PixelTransferResult transferPixels(GrColorType colorType,
+                                       const SkIRect& rect,
+                                       const TransferBufferProvider* bufferProvider = nullptr);
 
     // The async read step of asyncRescaleAndReadPixels()
     void asyncReadPixels(GrDirectContext*,
                          const SkIRect& srcRect,
                          SkColorType,
                          ReadPixelsCallback,
-                         ReadPixelsContext);
+                         ReadPixelsContext,
+                         const TransferBufferProvider* bufferProvider = nullptr);
 
 private:
     friend class ::GrRecordingContextPriv; // for validate
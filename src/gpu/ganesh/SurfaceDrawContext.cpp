@@ -9,6 +9,7 @@
 
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkDrawable.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkTypes.h"
 #include "include/core/SkVertices.h"
 #include "include/gpu/GrBackendSemaphore.h"
@@ -842,6 +843,7 @@ void SurfaceDrawContext::internalStencilClear(const SkIRect* scissor, bool insid
                         FillRectOp::MakeNonAARect(fContext, std::move(paint), SkMatrix::I(),
                                                   SkRect::Make(scissorState.rect()), ss));
     } else {
+        this->getOpsTask()->setUsesStencil();
         this->addOp(ClearOp::MakeStencilClip(fContext, scissorState, insideStencilMask));
     }
 }
@@ -1100,196 +1102,37 @@ bool SurfaceDrawContext::drawFastShadow(const GrClip* clip,
     SkDEBUGCODE(this->validate();)
     GR_CREATE_TRACE_MARKER_CONTEXT("SurfaceDrawContext", "drawFastShadow", fContext);
 
-    // check z plane
-    bool tiltZPlane = SkToBool(!SkScalarNearlyZero(rec.fZPlaneParams.fX) ||
-                               !SkScalarNearlyZero(rec.fZPlaneParams.fY));
-    bool skipAnalytic = SkToBool(rec.fFlags & SkShadowFlags::kGeometricOnly_ShadowFlag);
-    if (tiltZPlane || skipAnalytic || !viewMatrix.rectStaysRect() || !viewMatrix.isSimilarity()) {
+    SkDrawShadowMetrics::RRectShadow ambient, spot;
+    if (!SkDrawShadowMetrics::GetRRectShadows(path, rec, viewMatrix, &ambient, &spot)) {
         return false;
     }
 
-    SkRRect rrect;
-    SkRect rect;
-    // we can only handle rects, circles, and simple rrects with circular corners
-    bool isRRect = path.isRRect(&rrect) && SkRRectPriv::IsNearlySimpleCircular(rrect) &&
-                   rrect.getSimpleRadii().fX > SK_ScalarNearlyZero;
-    if (!isRRect &&
-        path.isOval(&rect) && SkScalarNearlyEqual(rect.width(), rect.height()) &&
-        rect.width() > SK_ScalarNearlyZero) {
-        rrect.setOval(rect);
-        isRRect = true;
-    }
-    if (!isRRect && path.isRect(&rect)) {
-        rrect.setRect(rect);
-        isRRect = true;
-    }
-
-    if (!isRRect) {
-        return false;
-    }
-
-    if (rrect.isEmpty()) {
-        return true;
-    }
-
     AutoCheckFlush acf(this->drawingManager());
 
-    SkPoint3 devLightPos = rec.fLightPos;
-    bool directional = SkToBool(rec.fFlags & kDirectionalLight_ShadowFlag);
-    if (!directional) {
-        // transform light
-        viewMatrix.mapPoints((SkPoint*)&devLightPos.fX, 1);
-    }
-
-    // 1/scale
-    SkScalar devToSrcScale = viewMatrix.isScaleTranslate() ?
-        SkScalarInvert(SkScalarAbs(viewMatrix[SkMatrix::kMScaleX])) :
-        sk_float_rsqrt(viewMatrix[SkMatrix::kMScaleX] * viewMatrix[SkMatrix::kMScaleX] +
-                       viewMatrix[SkMatrix::kMSkewX] * viewMatrix[SkMatrix::kMSkewX]);
-
-    SkScalar occluderHeight = rec.fZPlaneParams.fZ;
-    bool transparent = SkToBool(rec.fFlags & SkShadowFlags::kTransparentOccluder_ShadowFlag);
-
-    if (SkColorGetA(rec.fAmbientColor) > 0) {
-        SkScalar devSpaceInsetWidth = SkDrawShadowMetrics::AmbientBlurRadius(occluderHeight);
-        const SkScalar umbraRecipAlpha = SkDrawShadowMetrics::AmbientRecipAlpha(occluderHeight);
-        const SkScalar devSpaceAmbientBlur = devSpaceInsetWidth * umbraRecipAlpha;
-
-        // Outset the shadow rrect to the border of the penumbra
-        SkScalar ambientPathOutset = devSpaceInsetWidth * devToSrcScale;
-        SkRRect ambientRRect;
-        SkRect outsetRect = rrect.rect().makeOutset(ambientPathOutset, ambientPathOutset);
-        // If the rrect was an oval then its outset will also be one.
-        // We set it explicitly to avoid errors.
-        if (rrect.isOval()) {
-            ambientRRect = SkRRect::MakeOval(outsetRect);
-        } else {
-            SkScalar outsetRad = SkRRectPriv::GetSimpleRadii(rrect).fX + ambientPathOutset;
-            ambientRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
-        }
-
-        // The ShadowRRectOp still uses 8888 colors, so it might get clamped if the shadow color
-        // does not fit in bytes after being transformed to the destination color space. This can
-        // happen if the destination color space is smaller than sRGB, which is highly unlikely.
+    // The ShadowRRectOp still uses 8888 colors, so it might get clamped if the shadow color
+    // does not fit in bytes after being transformed to the destination color space. This can
+    // happen if the destination color space is smaller than sRGB, which is highly unlikely.
+    if (!ambient.fRRect.isEmpty()) {
         GrColor ambientColor = SkColorToPMColor4f(rec.fAmbientColor, colorInfo()).toBytes_RGBA();
-        if (transparent) {
-            // set a large inset to force a fill
-            devSpaceInsetWidth = ambientRRect.width();
-        }
-
         GrOp::Owner op = ShadowRRectOp::Make(fContext,
                                              ambientColor,
                                              viewMatrix,
-                                             ambientRRect,
-                                             devSpaceAmbientBlur,
-                                             devSpaceInsetWidth);
+                                             ambient.fRRect,
+                                             ambient.fBlurWidth,
+                                             ambient.fInsetWidth);
         if (op) {
             this->addDrawOp(clip, std::move(op));
         }
     }
 
-    if (SkColorGetA(rec.fSpotColor) > 0) {
-        SkScalar devSpaceSpotBlur;
-        SkScalar spotScale;
-        SkVector spotOffset;
-        if (directional) {
-            SkDrawShadowMetrics::GetDirectionalParams(occluderHeight, devLightPos.fX,
-                                                      devLightPos.fY, devLightPos.fZ,
-                                                      rec.fLightRadius, &devSpaceSpotBlur,
-                                                      &spotScale, &spotOffset);
-        } else {
-            SkDrawShadowMetrics::GetSpotParams(occluderHeight, devLightPos.fX, devLightPos.fY,
-                                               devLightPos.fZ, rec.fLightRadius,
-                                               &devSpaceSpotBlur, &spotScale, &spotOffset);
-        }
-        // handle scale of radius due to CTM
-        const SkScalar srcSpaceSpotBlur = devSpaceSpotBlur * devToSrcScale;
-
-        // Adjust translate for the effect of the scale.
-        spotOffset.fX += spotScale*viewMatrix[SkMatrix::kMTransX];
-        spotOffset.fY += spotScale*viewMatrix[SkMatrix::kMTransY];
-        // This offset is in dev space, need to transform it into source space.
-        SkMatrix ctmInverse;
-        if (viewMatrix.invert(&ctmInverse)) {
-            ctmInverse.mapPoints(&spotOffset, 1);
-        } else {
-            // Since the matrix is a similarity, this should never happen, but just in case...
-            SkDebugf("Matrix is degenerate. Will not render spot shadow correctly!\n");
-            SkASSERT(false);
-        }
-
-        // Compute the transformed shadow rrect
-        SkRRect spotShadowRRect;
-        SkMatrix shadowTransform;
-        shadowTransform.setScaleTranslate(spotScale, spotScale, spotOffset.fX, spotOffset.fY);
-        rrect.transform(shadowTransform, &spotShadowRRect);
-        SkScalar spotRadius = spotShadowRRect.getSimpleRadii().fX;
-
-        // Compute the insetWidth
-        SkScalar blurOutset = srcSpaceSpotBlur;
-        SkScalar insetWidth = blurOutset;
-        if (transparent) {
-            // If transparent, just do a fill
-            insetWidth += spotShadowRRect.width();
-        } else {
-            // For shadows, instead of using a stroke we specify an inset from the penumbra
-            // border. We want to extend this inset area so that it meets up with the caster
-            // geometry. The inset geometry will by default already be inset by the blur width.
-            //
-            // We compare the min and max corners inset by the radius between the original
-            // rrect and the shadow rrect. The distance between the two plus the difference
-            // between the scaled radius and the original radius gives the distance from the
-            // transformed shadow shape to the original shape in that corner. The max
-            // of these gives the maximum distance we need to cover.
-            //
-            // Since we are outsetting by 1/2 the blur distance, we just add the maxOffset to
-            // that to get the full insetWidth.
-            SkScalar maxOffset;
-            if (rrect.isRect()) {
-                // Manhattan distance works better for rects
-                maxOffset = std::max(std::max(SkTAbs(spotShadowRRect.rect().fLeft -
-                                                 rrect.rect().fLeft),
-                                          SkTAbs(spotShadowRRect.rect().fTop -
-                                                 rrect.rect().fTop)),
-                                   std::max(SkTAbs(spotShadowRRect.rect().fRight -
-                                                 rrect.rect().fRight),
-                                          SkTAbs(spotShadowRRect.rect().fBottom -
-                                                 rrect.rect().fBottom)));
-            } else {
-                SkScalar dr = spotRadius - SkRRectPriv::GetSimpleRadii(rrect).fX;
-                SkPoint upperLeftOffset = SkPoint::Make(spotShadowRRect.rect().fLeft -
-                                                        rrect.rect().fLeft + dr,
-                                                        spotShadowRRect.rect().fTop -
-                                                        rrect.rect().fTop + dr);
-                SkPoint lowerRightOffset = SkPoint::Make(spotShadowRRect.rect().fRight -
-                                                         rrect.rect().fRight - dr,
-                                                         spotShadowRRect.rect().fBottom -
-                                                         rrect.rect().fBottom - dr);
-                maxOffset = SkScalarSqrt(std::max(SkPointPriv::LengthSqd(upperLeftOffset),
-                                                  SkPointPriv::LengthSqd(lowerRightOffset))) + dr;
-            }
-            insetWidth += std::max(blurOutset, maxOffset);
-        }
-
-        // Outset the shadow rrect to the border of the penumbra
-        SkRect outsetRect = spotShadowRRect.rect().makeOutset(blurOutset, blurOutset);
-        if (spotShadowRRect.isOval()) {
-            spotShadowRRect = SkRRect::MakeOval(outsetRect);
-        } else {
-            SkScalar outsetRad = spotRadius + blurOutset;
-            spotShadowRRect = SkRRect::MakeRectXY(outsetRect, outsetRad, outsetRad);
-        }
-
-        // The ShadowRRectOp still uses 8888 colors, so it might get clamped if the shadow color
-        // does not fit in bytes after being transformed to the destination color space. This can
-        // happen if the destination color space is smaller than sRGB, which is highly unlikely.
+    if (!spot.fRRect.isEmpty()) {
         GrColor spotColor = SkColorToPMColor4f(rec.fSpotColor, colorInfo()).toBytes_RGBA();
         GrOp::Owner op = ShadowRRectOp::Make(fContext,
                                              spotColor,
                                              viewMatrix,
-                                             spotShadowRRect,
-                                             2.0f * devSpaceSpotBlur,
-                                             insetWidth);
+                                             spot.fRRect,
+                                             spot.fBlurWidth,
+                                             spot.fInsetWidth);
         if (op) {
             this->addDrawOp(clip, std::move(op));
         }
@@ -1806,7 +1649,8 @@ void SurfaceDrawContext::drawShapeUsingPathRenderer(const GrClip* clip,
 
     SkIRect clipConservativeBounds = get_clip_bounds(this, clip);
 
-    // Always allow paths to trigger DMSAA.
+    // Allow paths to trigger DMSAA. Simple fills may still stay on coverage AA below, if that is
+    // cheaper (see preferCoverageAAForPath()).
     GrAAType aaType = fCanUseDynamicMSAA ? GrAAType::kMSAA : this->chooseAAType(aa);
 
     PathRenderer::CanDrawPathArgs canDrawArgs;
@@ -1850,9 +1694,29 @@ void SurfaceDrawContext::drawShapeUsingPathRenderer(const GrClip* clip,
             }
         }
 
-        // Try a 1st time without applying any of the style to the geometry (and barring sw)
-        pr = this->drawingManager()->getPathRenderer(canDrawArgs, kDisallowSWPathRenderer,
-                                                     DrawType::kColor);
+        float coverageCost;
+        if (fCanUseDynamicMSAA && aa == GrAA::kYes && shape.style().isSimpleFill() &&
+            !shape.inverseFilled() &&
+            this->preferCoverageAAForPath(viewMatrix, shape, clipConservativeBounds,
+                                          &coverageCost)) {
+            // Only keep coverage AA if a GPU path renderer can draw it. Falling back on the SW
+            // renderer would cost more than the MSAA attachment.
+            canDrawArgs.fAAType = GrAAType::kCoverage;
+            pr = this->drawingManager()->getPathRenderer(canDrawArgs, kDisallowSWPathRenderer,
+                                                         DrawType::kColor);
+            if (pr) {
+                aaType = GrAAType::kCoverage;
+                fCoveragePathsCost += coverageCost;
+            } else {
+                canDrawArgs.fAAType = aaType;
+            }
+        }
+
+        if (!pr) {
+            // Try a 1st time without applying any of the style to the geometry (and barring sw)
+            pr = this->drawingManager()->getPathRenderer(canDrawArgs, kDisallowSWPathRenderer,
+                                                         DrawType::kColor);
+        }
     }
 
     SkScalar styleScale =  GrStyle::MatrixToScaleFactor(viewMatrix);
@@ -1907,6 +1771,58 @@ void SurfaceDrawContext::drawShapeUsingPathRenderer(const GrClip* clip,
     pr->drawPath(args);
 }
 
+bool SurfaceDrawContext::preferCoverageAAForPath(const SkMatrix& viewMatrix,
+                                                 const GrStyledShape& shape,
+                                                 const SkIRect& clipBounds,
+                                                 float* cost) {
+    SkASSERT(fCanUseDynamicMSAA);
+    // The rough cost, in pixels written, of each verb and each draw with coverage AA. The verbs
+    // are rasterized or tessellated into an atlas or analytic geometry, and every draw is at least
+    // one more op.
+    constexpr static float kCoverageCostPerVerb = 32;
+    constexpr static float kCoverageCostPerDraw = 1024;
+
+    OpsTask* opsTask = this->getOpsTask();
+    if (opsTask->uniqueID() != fCoveragePathsOpsTaskID) {
+        fCoveragePathsOpsTaskID = opsTask->uniqueID();
+        fCoveragePathsCost = 0;
+    }
+    if (opsTask->usesMSAASurface()) {
+        // The OpsTask already pays for the MSAA attachment, so MSAA is the cheaper choice.
+        TRACE_EVENT_INSTANT0("skia.gpu", "DMSAA path: already multisampled",
+                             TRACE_EVENT_SCOPE_THREAD);
+        return false;
+    }
+
+    SkRect devBounds = viewMatrix.mapRect(shape.bounds());
+    if (!devBounds.intersect(SkRect::Make(clipBounds))) {
+        devBounds.setEmpty();
+    }
+    SkPath path;
+    shape.asPath(&path);
+    *cost = devBounds.width() * devBounds.height() +
+            path.countVerbs() * kCoverageCostPerVerb +
+            kCoverageCostPerDraw;
+
+    // Switching to MSAA loads and stores the attachment once, or twice when it has to be resolved
+    // by hand.
+    float msaaCost = (float)this->width() * this->height();
+    if (!this->caps()->msaaResolvesAutomatically()) {
+        msaaCost *= 2;
+    }
+
+    if (fCoveragePathsCost + *cost > msaaCost) {
+        TRACE_EVENT_INSTANT2("skia.gpu", "DMSAA path: msaa", TRACE_EVENT_SCOPE_THREAD,
+                             "coverage_cost", (int)(fCoveragePathsCost + *cost),
+                             "msaa_cost", (int)msaaCost);
+        return false;
+    }
+    TRACE_EVENT_INSTANT2("skia.gpu", "DMSAA path: coverage", TRACE_EVENT_SCOPE_THREAD,
+                         "coverage_cost", (int)(fCoveragePathsCost + *cost),
+                         "msaa_cost", (int)msaaCost);
+    return true;
+}
+
 void SurfaceDrawContext::addDrawOp(const GrClip* clip,
                                    GrOp::Owner op,
                                    const std::function<WillAddOpFn>& willAddFn) {
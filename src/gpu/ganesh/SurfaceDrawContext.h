@@ -677,6 +677,14 @@ private:
     void drawShapeUsingPathRenderer(const GrClip*, GrPaint&&, GrAA, const SkMatrix&,
                                     GrStyledShape&&, bool attemptDrawSimple = false);
 
+    // With DMSAA, an AA path fill can either trigger the MSAA attachment for the rest of the
+    // OpsTask or be drawn with a coverage AA path renderer. Coverage AA costs roughly the pixels
+    // and verbs of each path, while the MSAA attachment costs roughly a load and store of the whole
+    // target, once. Returns true if the coverage AA paths drawn so far in the OpsTask, plus this
+    // one, still cost less than switching to MSAA. 'cost' is this path's share.
+    bool preferCoverageAAForPath(const SkMatrix&, const GrStyledShape&, const SkIRect& clipBounds,
+                                 float* cost);
+
     // Makes a copy of the proxy if it is necessary for the draw and places the texture that should
     // be used by GrXferProcessor to access the destination color in 'result'. If the return
     // value is false then a texture copy could not be made.
@@ -693,6 +701,11 @@ private:
 
     bool fNeedsStencil = false;
 
+    // The cost of the coverage AA paths drawn by preferCoverageAAForPath() into the current
+    // OpsTask.
+    uint32_t fCoveragePathsOpsTaskID = SK_InvalidUniqueID;
+    float fCoveragePathsCost = 0;
+
 #if defined(GR_TEST_UTILS)
     bool fPreserveOpsOnFullClear_TestingOnly = false;
 #endif
@@ -80,7 +80,10 @@ void GrD3DDescriptorTableManager::Heap::onRecycle() const {
 
 GrD3DDescriptorTableManager::HeapPool::HeapPool(GrD3DGpu* gpu, D3D12_DESCRIPTOR_HEAP_TYPE heapType)
     : fHeapType(heapType)
-    , fCurrentHeapDescriptorCount(kInitialHeapDescriptorCount) {
+    , fCurrentHeapDescriptorCount(kInitialHeapDescriptorCount)
+    , fMaxHeapDescriptorCount(heapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
+                                      ? kMaxSamplerHeapDescriptorCount
+                                      : kMaxShaderViewHeapDescriptorCount) {
     sk_sp<Heap> heap = Heap::Make(gpu, fHeapType, fCurrentHeapDescriptorCount);
     fDescriptorHeaps.push_back(heap);
 }
@@ -104,7 +107,8 @@ sk_sp<GrD3DDescriptorTable> GrD3DDescriptorTableManager::HeapPool::allocateTable
     }
 
     // Out of available heaps, need to allocate a new one
-    fCurrentHeapDescriptorCount = std::min(2*fCurrentHeapDescriptorCount, 2048u);
+    fCurrentHeapDescriptorCount = std::min(2*fCurrentHeapDescriptorCount,
+                                           fMaxHeapDescriptorCount);
     sk_sp<GrD3DDescriptorTableManager::Heap> heap =
             GrD3DDescriptorTableManager::Heap::Make(gpu, fHeapType, fCurrentHeapDescriptorCount);
     gpu->currentCommandList()->addRecycledResource(heap);
@@ -125,7 +129,6 @@ void GrD3DDescriptorTableManager::HeapPool::prepForSubmit(GrD3DGpu* gpu) {
     }
 
     if (fDescriptorHeaps.size() == 0) {
-        fCurrentHeapDescriptorCount = std::min(fCurrentHeapDescriptorCount, 2048u);
         sk_sp<GrD3DDescriptorTableManager::Heap> heap =
             GrD3DDescriptorTableManager::Heap::Make(gpu, fHeapType, fCurrentHeapDescriptorCount);
         fDescriptorHeaps.push_back(heap);
@@ -110,10 +110,18 @@ private:
 
     private:
         inline static constexpr int kInitialHeapDescriptorCount = 256;
+        // Every time a command list runs out of space in a heap it has to switch to a new one with
+        // SetDescriptorHeaps(), which can flush the GPU's descriptor caches. So heaps keep
+        // doubling until they're big enough for a whole flush, up to these limits. Shader-visible
+        // sampler heaps can't hold more than 2048 descriptors.
+        inline static constexpr unsigned int kMaxShaderViewHeapDescriptorCount = 1 << 16;
+        inline static constexpr unsigned int kMaxSamplerHeapDescriptorCount =
+                D3D12_MAX_SHADER_VISIBLE_SAMPLER_HEAP_SIZE;
 
         std::vector<sk_sp<Heap>> fDescriptorHeaps;
         D3D12_DESCRIPTOR_HEAP_TYPE fHeapType;
         unsigned int fCurrentHeapDescriptorCount;
+        unsigned int fMaxHeapDescriptorCount;
     };
 
     void recycle(Heap*);
@@ -121,6 +121,7 @@ private:
         bool isSimilarity   = SkToBool(dfTexEffect.fFlags & kSimilarity_DistanceFieldEffectFlag  );
         bool isGammaCorrect = SkToBool(dfTexEffect.fFlags & kGammaCorrect_DistanceFieldEffectFlag);
         bool isAliased      = SkToBool(dfTexEffect.fFlags & kAliased_DistanceFieldEffectFlag     );
+        bool isMultiChannel = SkToBool(dfTexEffect.fFlags & kMultiChannel_DistanceFieldEffectFlag);
 
         // Use highp to work around aliasing issues
         fragBuilder->codeAppendf("float2 uv = %s;\n", uv.fsIn());
@@ -128,6 +129,12 @@ private:
         append_multitexture_lookup(args, dfTexEffect.numTextureSamplers(),
                                    texIdx, "uv", "texColor");
 
+        if (isMultiChannel) {
+            // The median of the three channels keeps the corners of the field sharp.
+            fragBuilder->codeAppend("texColor.r = max(min(texColor.r, texColor.g), "
+                                                     "min(max(texColor.r, texColor.g), "
+                                                         "texColor.b));");
+        }
         fragBuilder->codeAppend("half distance = "
                       SK_DistanceFieldMultiplier "*(texColor.r - " SK_DistanceFieldThreshold ");");
 #ifdef SK_GAMMA_APPLY_TO_A8
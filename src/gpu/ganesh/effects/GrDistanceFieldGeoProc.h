@@ -35,8 +35,9 @@ enum GrDistanceFieldEffectFlags {
     kGammaCorrect_DistanceFieldEffectFlag = 0x040, // assume gamma-correct output (linear blending)
     kAliased_DistanceFieldEffectFlag      = 0x080, // monochrome output
     kWideColor_DistanceFieldEffectFlag    = 0x100, // use wide color (only for path)
+    kMultiChannel_DistanceFieldEffectFlag = 0x200, // median of a multi-channel distance field
 
-    kInvalid_DistanceFieldEffectFlag      = 0x200,   // invalid state (for initialization)
+    kInvalid_DistanceFieldEffectFlag      = 0x400,   // invalid state (for initialization)
 
     kUniformScale_DistanceFieldEffectMask = kSimilarity_DistanceFieldEffectFlag |
                                             kScaleOnly_DistanceFieldEffectFlag,
@@ -45,7 +46,8 @@ enum GrDistanceFieldEffectFlags {
                                             kScaleOnly_DistanceFieldEffectFlag |
                                             kPerspective_DistanceFieldEffectFlag |
                                             kGammaCorrect_DistanceFieldEffectFlag |
-                                            kAliased_DistanceFieldEffectFlag,
+                                            kAliased_DistanceFieldEffectFlag |
+                                            kMultiChannel_DistanceFieldEffectFlag,
     // The subset of the flags relevant to GrDistanceFieldPathGeoProc
     kPath_DistanceFieldEffectMask         = kSimilarity_DistanceFieldEffectFlag |
                                             kScaleOnly_DistanceFieldEffectFlag |
@@ -64,7 +66,8 @@ enum GrDistanceFieldEffectFlags {
 
 /**
  * The output color of this effect is a modulation of the input color and a sample from a
- * distance field texture (using a smoothed step function near 0.5).
+ * distance field texture (using a smoothed step function near 0.5). With
+ * kMultiChannel_DistanceFieldEffectFlag the distance is the median of the texture's r, g and b.
  * It allows explicit specification of the filtering and wrap modes (GrSamplerState). The input
  * coords are a custom attribute. Gamma correction is handled via a texture LUT.
  */
@@ -145,7 +148,8 @@ private:
 
 /**
  * The output color of this effect is a modulation of the input color and a sample from a
- * distance field texture (using a smoothed step function near 0.5).
+ * distance field texture (using a smoothed step function near 0.5). With
+ * kMultiChannel_DistanceFieldEffectFlag the distance is the median of the texture's r, g and b.
  * It allows explicit specification of the filtering and wrap modes (GrSamplerState). The input
  * coords are a custom attribute. No gamma correct blending is applied. Used for paths only.
  */
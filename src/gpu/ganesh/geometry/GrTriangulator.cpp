@@ -7,15 +7,19 @@
 
 #include "src/gpu/ganesh/geometry/GrTriangulator.h"
 
+#include "include/private/base/SkTo.h"
 #include "src/gpu/BufferWriter.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
 #include "src/gpu/ganesh/geometry/GrPathUtils.h"
 
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPointPriv.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
+#include <memory>
 #include <tuple>
+#include <vector>
 
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 
@@ -1785,4 +1789,185 @@ int GrTriangulator::polysToTriangles(Poly* polys, GrEagerVertexAllocator* vertex
     return actualCount;
 }
 
+// Paths that linearize to fewer vertices than this per band aren't worth the cost of cutting up.
+static constexpr int kMinVerticesPerBand = 4096;
+static constexpr int kMaxBands = 8;
+
+// Finds where the edge pq crosses the horizontal line at y. The result only depends on the edge and
+// not its direction, so the two bands that share y cut it at exactly the same point.
+static SkPoint intersect_horizontal(SkPoint p, SkPoint q, float y) {
+    if (q.fY < p.fY || (q.fY == p.fY && q.fX < p.fX)) {
+        std::swap(p, q);
+    }
+    float t = (y - p.fY) / (q.fY - p.fY);
+    return {p.fX + (q.fX - p.fX) * t, y};
+}
+
+// One Sutherland-Hodgman pass clipping the closed polygon 'in' to the side of the line at y where
+// inside(y) holds. The winding number of every point on that side is unchanged; the polygon just
+// gains (possibly overlapping) edges along the line, which cancel out in the triangulation.
+template <typename Inside>
+static void clip_to_half_plane(const std::vector<SkPoint>& in, float y, Inside inside,
+                               std::vector<SkPoint>* out) {
+    out->clear();
+    for (size_t i = 0; i < in.size(); ++i) {
+        SkPoint prev = in[i ? i - 1 : in.size() - 1];
+        SkPoint curr = in[i];
+        bool prevInside = inside(prev.fY);
+        bool currInside = inside(curr.fY);
+        if (prevInside != currInside) {
+            out->push_back(intersect_horizontal(prev, curr, y));
+        }
+        if (currInside) {
+            out->push_back(curr);
+        }
+    }
+}
+
+int GrTriangulator::PathToTrianglesInBands(const SkPath& path, SkScalar tolerance,
+                                           const SkRect& clipBounds,
+                                           GrEagerVertexAllocator* vertexAllocator, bool* isLinear,
+                                           SkExecutor* executor, BandInfo* bandInfo) {
+    SkASSERT(executor);
+    SkArenaAlloc alloc(kArenaDefaultChunkSize);
+    GrTriangulator triangulator(path, &alloc);
+
+    int contourCnt = get_contour_count(path, tolerance);
+    if (contourCnt <= 0) {
+        *isLinear = true;
+        return 0;
+    }
+    if (SkPathFillType_IsInverse(path.getFillType())) {
+        contourCnt++;
+    }
+    std::unique_ptr<VertexList[]> contours(new VertexList[contourCnt]);
+    triangulator.pathToContours(tolerance, clipBounds, contours.get(), isLinear);
+
+    // Linearize once, then band by the distribution of the vertices in Y.
+    std::vector<std::vector<SkPoint>> polygons(contourCnt);
+    std::vector<float> ys;
+    for (int i = 0; i < contourCnt; ++i) {
+        for (Vertex* v = contours[i].fHead; v; v = v->fNext) {
+            polygons[i].push_back(v->fPoint);
+            ys.push_back(v->fPoint.fY);
+        }
+    }
+    int bandCnt = std::min(SkToInt(ys.size()) / kMinVerticesPerBand, kMaxBands);
+    std::vector<float> cuts;
+    for (int i = 1; i < bandCnt; ++i) {
+        auto nth = ys.begin() + ys.size() * i / bandCnt;
+        std::nth_element(ys.begin(), nth, ys.end());
+        if (SkScalarIsFinite(*nth) && (cuts.empty() || *nth > cuts.back())) {
+            cuts.push_back(*nth);
+        }
+    }
+    if (cuts.empty()) {
+        auto [polys, success] = triangulator.contoursToPolys(contours.get(), contourCnt);
+        return success ? triangulator.polysToTriangles(polys, vertexAllocator) : 0;
+    }
+    bandCnt = SkToInt(cuts.size()) + 1;
+
+    // Each band owns its triangulator by value, like PathToTriangles() does on the stack, since
+    // only GrTriangulator's members can destroy one.
+    struct Band {
+        explicit Band(const SkPath& path)
+                : fAlloc(kArenaDefaultChunkSize), fTriangulator(path, &fAlloc) {}
+
+        SkArenaAlloc fAlloc;
+        GrTriangulator fTriangulator;
+        Poly* fPolys = nullptr;
+        bool fSuccess = false;
+    };
+    std::vector<std::unique_ptr<Band>> bands(bandCnt);
+    for (std::unique_ptr<Band>& band : bands) {
+        band = std::make_unique<Band>(path);
+    }
+
+    // Every band's triangulator reads the path's bounds, which are computed lazily.
+    path.updateBoundsCache();
+
+    auto triangulateBand = [&](int i) {
+        float top = i > 0 ? cuts[i - 1] : -SK_FloatInfinity;
+        float bottom = i < bandCnt - 1 ? cuts[i] : SK_FloatInfinity;
+        Band& band = *bands[i];
+
+        std::unique_ptr<VertexList[]> bandContours(new VertexList[contourCnt]);
+        int bandContourCnt = 0;
+        std::vector<SkPoint> belowTop, clipped;
+        for (const std::vector<SkPoint>& polygon : polygons) {
+            clip_to_half_plane(polygon, top, [top](float y) { return y >= top; }, &belowTop);
+            clip_to_half_plane(belowTop, bottom, [bottom](float y) { return y <= bottom; },
+                               &clipped);
+            if (clipped.size() < 3) {
+                continue;
+            }
+            for (SkPoint p : clipped) {
+                band.fTriangulator.appendPointToContour(p, &bandContours[bandContourCnt]);
+            }
+            ++bandContourCnt;
+        }
+        if (bandContourCnt == 0) {
+            band.fSuccess = true;
+            return;
+        }
+        std::tie(band.fPolys, band.fSuccess) =
+                band.fTriangulator.contoursToPolys(bandContours.get(), bandContourCnt);
+    };
+
+    {
+        SkTaskGroup taskGroup(*executor);
+        for (int i = 1; i < bandCnt; ++i) {
+            taskGroup.add([&triangulateBand, i] { triangulateBand(i); });
+        }
+        triangulateBand(0);
+        taskGroup.wait();
+    }
+
+    int64_t count64 = 0;
+    for (int i = 0; i < bandCnt; ++i) {
+        if (!bands[i]->fSuccess) {
+            // Some band failed to simplify; let the whole path have a go at it instead.
+            auto [polys, success] = triangulator.contoursToPolys(contours.get(), contourCnt);
+            return success ? triangulator.polysToTriangles(polys, vertexAllocator) : 0;
+        }
+        count64 += CountPoints(bands[i]->fPolys, path.getFillType());
+    }
+    if (0 == count64 || count64 > SK_MaxS32) {
+        return 0;
+    }
+    int count = count64;
+
+    size_t vertexStride = sizeof(SkPoint);
+    skgpu::VertexWriter verts = vertexAllocator->lockWriter(vertexStride, count);
+    if (!verts) {
+        SkDebugf("Could not allocate vertices\n");
+        return 0;
+    }
+
+    TESS_LOG("emitting %d verts in %d bands\n", count, bandCnt);
+
+    skgpu::BufferWriter::Mark start = verts.mark();
+    for (int i = 0; i < bandCnt; ++i) {
+        [[maybe_unused]] skgpu::BufferWriter::Mark bandStart = verts.mark();
+        verts = bands[i]->fTriangulator.polysToTriangles(bands[i]->fPolys, path.getFillType(),
+                                                          std::move(verts));
+#if defined(GR_TEST_UTILS)
+        if (bandInfo) {
+            bandInfo->fVertexCounts.push_back(
+                    static_cast<int>((verts.mark() - bandStart) / vertexStride));
+        }
+#endif
+    }
+#if defined(GR_TEST_UTILS)
+    if (bandInfo) {
+        bandInfo->fCuts = cuts;
+    }
+#endif
+
+    int actualCount = static_cast<int>((verts.mark() - start) / vertexStride);
+    SkASSERT(actualCount <= count);
+    vertexAllocator->unlock(actualCount);
+    return actualCount;
+}
+
 #endif // SK_ENABLE_OPTIMIZE_SIZE
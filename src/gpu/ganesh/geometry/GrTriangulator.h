@@ -16,7 +16,10 @@
 #include "src/base/SkArenaAlloc.h"
 #include "src/gpu/ganesh/GrColor.h"
 
+#include <vector>
+
 class GrEagerVertexAllocator;
+class SkExecutor;
 struct SkRect;
 
 #define TRIANGULATOR_LOGGING 0
@@ -29,11 +32,20 @@ class GrTriangulator {
 public:
     constexpr static int kArenaDefaultChunkSize = 16 * 1024;
 
+    /**
+     * If an 'executor' is given, paths that linearize to many vertices are cut into horizontal
+     * bands that are triangulated concurrently on it.
+     */
     static int PathToTriangles(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
-                               GrEagerVertexAllocator* vertexAllocator, bool* isLinear) {
+                               GrEagerVertexAllocator* vertexAllocator, bool* isLinear,
+                               SkExecutor* executor = nullptr) {
         if (!path.isFinite()) {
             return 0;
         }
+        if (executor) {
+            return PathToTrianglesInBands(path, tolerance, clipBounds, vertexAllocator, isLinear,
+                                          executor);
+        }
         SkArenaAlloc alloc(kArenaDefaultChunkSize);
         GrTriangulator triangulator(path, &alloc);
         auto [ polys, success ] = triangulator.pathToPolys(tolerance, clipBounds, isLinear);
@@ -44,6 +56,31 @@ public:
         return count;
     }
 
+#if defined(GR_TEST_UTILS)
+    // How PathToTriangles() cut a path into bands: the Ys it cut at, top to bottom, and the number
+    // of vertices each band emitted, in the order they were emitted.
+    struct BandInfo {
+        std::vector<float> fCuts;
+        std::vector<int> fVertexCounts;
+    };
+
+    // PathToTriangles() with an executor, reporting the bands. 'bandInfo' is left empty if the
+    // path wasn't cut into bands.
+    static int PathToTrianglesInBandsForTesting(const SkPath& path, SkScalar tolerance,
+                                                const SkRect& clipBounds,
+                                                GrEagerVertexAllocator* vertexAllocator,
+                                                bool* isLinear, SkExecutor* executor,
+                                                BandInfo* bandInfo) {
+        if (!path.isFinite()) {
+            return 0;
+        }
+        return PathToTrianglesInBands(path, tolerance, clipBounds, vertexAllocator, isLinear,
+                                      executor, bandInfo);
+    }
+#else
+    struct BandInfo;
+#endif
+
     // Enums used by GrTriangulator internals.
     typedef enum { kLeft_Side, kRight_Side } Side;
     enum class EdgeType { kInner, kOuter, kConnector };
@@ -192,6 +229,9 @@ protected:
                       bool* isLinear);
     static int64_t CountPoints(Poly* polys, SkPathFillType overrideFillType);
     int polysToTriangles(Poly*, GrEagerVertexAllocator*) const;
+    static int PathToTrianglesInBands(const SkPath&, SkScalar tolerance, const SkRect& clipBounds,
+                                      GrEagerVertexAllocator*, bool* isLinear, SkExecutor*,
+                                      BandInfo* = nullptr);
 
     // FIXME: fPath should be plumbed through function parameters instead.
     const SkPath fPath;
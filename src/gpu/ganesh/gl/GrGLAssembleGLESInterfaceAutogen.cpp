@@ -163,6 +163,12 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
         GET_PROC_SUFFIX(GenVertexArrays, OES);
     }
 
+    if (glVer >= GR_GL_VER(3,0)) {
+        GET_PROC(BindBufferRange);
+        GET_PROC(GetUniformBlockIndex);
+        GET_PROC(UniformBlockBinding);
+    }
+
     if (glVer >= GR_GL_VER(3,2)) {
         GET_PROC(PatchParameteri);
     } else if (extensions.has("GL_OES_tessellation_shader")) {
@@ -362,6 +368,10 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
         GET_PROC_SUFFIX(MapBufferRange, EXT);
     }
 
+    if (extensions.has("GL_EXT_buffer_storage")) {
+        GET_PROC_SUFFIX(BufferStorage, EXT);
+    }
+
     if (extensions.has("GL_EXT_debug_marker")) {
         GET_PROC_SUFFIX(InsertEventMarker, EXT);
         GET_PROC_SUFFIX(PopGroupMarker, EXT);
@@ -432,25 +442,34 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
     }
 
     if (glVer >= GR_GL_VER(3,0)) {
-#if defined(GR_TEST_UTILS)
-        GET_PROC(BeginQuery);
         GET_PROC(DeleteQueries);
-        GET_PROC(EndQuery);
         GET_PROC(GenQueries);
         GET_PROC(GetQueryObjectuiv);
+#if defined(GR_TEST_UTILS)
+        GET_PROC(BeginQuery);
+        GET_PROC(EndQuery);
         GET_PROC(GetQueryiv);
 #endif
     } else if (extensions.has("GL_EXT_occlusion_query_boolean")) {
-#if defined(GR_TEST_UTILS)
-        GET_PROC_SUFFIX(BeginQuery, EXT);
         GET_PROC_SUFFIX(DeleteQueries, EXT);
-        GET_PROC_SUFFIX(EndQuery, EXT);
         GET_PROC_SUFFIX(GenQueries, EXT);
         GET_PROC_SUFFIX(GetQueryObjectuiv, EXT);
+#if defined(GR_TEST_UTILS)
+        GET_PROC_SUFFIX(BeginQuery, EXT);
+        GET_PROC_SUFFIX(EndQuery, EXT);
         GET_PROC_SUFFIX(GetQueryiv, EXT);
 #endif
     }
 
+    if (extensions.has("GL_EXT_disjoint_timer_query")) {
+        GET_PROC_SUFFIX(GetQueryObjecti64v, EXT);
+        GET_PROC_SUFFIX(GetQueryObjectui64v, EXT);
+    }
+
+    if (extensions.has("GL_EXT_disjoint_timer_query")) {
+        GET_PROC_SUFFIX(QueryCounter, EXT);
+    }
+
     if (glVer >= GR_GL_VER(3,0)) {
         GET_PROC(InvalidateFramebuffer);
         GET_PROC(InvalidateSubFramebuffer);
@@ -173,6 +173,16 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
         GET_PROC_SUFFIX(GenVertexArrays, APPLE);
     }
 
+    if (glVer >= GR_GL_VER(3,1)) {
+        GET_PROC(BindBufferRange);
+        GET_PROC(GetUniformBlockIndex);
+        GET_PROC(UniformBlockBinding);
+    } else if (extensions.has("GL_ARB_uniform_buffer_object")) {
+        GET_PROC(BindBufferRange);
+        GET_PROC(GetUniformBlockIndex);
+        GET_PROC(UniformBlockBinding);
+    }
+
     if (glVer >= GR_GL_VER(4,0)) {
         GET_PROC(PatchParameteri);
     } else if (extensions.has("GL_ARB_tessellation_shader")) {
@@ -357,6 +367,12 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
         GET_PROC(MapBufferRange);
     }
 
+    if (glVer >= GR_GL_VER(4,4)) {
+        GET_PROC(BufferStorage);
+    } else if (extensions.has("GL_ARB_buffer_storage")) {
+        GET_PROC(BufferStorage);
+    }
+
     if (extensions.has("GL_EXT_debug_marker")) {
         GET_PROC_SUFFIX(InsertEventMarker, EXT);
         GET_PROC_SUFFIX(PopGroupMarker, EXT);
@@ -438,12 +454,12 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
 
     GET_PROC(GetQueryObjectiv);
 
-#if defined(GR_TEST_UTILS)
-    GET_PROC(BeginQuery);
     GET_PROC(DeleteQueries);
-    GET_PROC(EndQuery);
     GET_PROC(GenQueries);
     GET_PROC(GetQueryObjectuiv);
+#if defined(GR_TEST_UTILS)
+    GET_PROC(BeginQuery);
+    GET_PROC(EndQuery);
     GET_PROC(GetQueryiv);
 #endif
 
@@ -155,6 +155,12 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledWebGLInterface(void *ctx, GrGLGetPro
         GET_PROC_SUFFIX(GenVertexArrays, OES);
     }
 
+    if (glVer >= GR_GL_VER(2,0)) {
+        GET_PROC(BindBufferRange);
+        GET_PROC(GetUniformBlockIndex);
+        GET_PROC(UniformBlockBinding);
+    }
+
     if (glVer >= GR_GL_VER(2,0)) {
         GET_PROC(DrawArraysInstanced);
         GET_PROC(DrawElementsInstanced);
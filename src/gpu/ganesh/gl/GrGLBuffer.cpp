@@ -39,7 +39,22 @@ sk_sp<GrGLBuffer> GrGLBuffer::Make(GrGLGpu* gpu,
     }
 
     sk_sp<GrGLBuffer> buffer(new GrGLBuffer(gpu, size, intendedType, accessPattern,
-                                            /*label=*/"MakeGlBuffer"));
+                                            /*persistent=*/false, /*label=*/"MakeGlBuffer"));
+    if (0 == buffer->bufferID()) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+sk_sp<GrGLBuffer> GrGLBuffer::MakePersistent(GrGLGpu* gpu,
+                                             size_t size,
+                                             GrGpuBufferType intendedType) {
+    SkASSERT(gpu->glCaps().persistentlyMappedBufferSupport());
+    // Stream buffers never get a scratch key so these won't be recycled by anyone expecting a
+    // regular mutable buffer.
+    sk_sp<GrGLBuffer> buffer(new GrGLBuffer(gpu, size, intendedType, kStream_GrAccessPattern,
+                                            /*persistent=*/true,
+                                            /*label=*/"MakePersistentGlBuffer"));
     if (0 == buffer->bufferID()) {
         return nullptr;
     }
@@ -104,6 +119,7 @@ GrGLBuffer::GrGLBuffer(GrGLGpu* gpu,
                        size_t size,
                        GrGpuBufferType intendedType,
                        GrAccessPattern accessPattern,
+                       bool persistent,
                        std::string_view label)
         : INHERITED(gpu, size, intendedType, accessPattern, label)
         , fIntendedType(intendedType)
@@ -113,11 +129,28 @@ GrGLBuffer::GrGLBuffer(GrGLGpu* gpu,
     GL_CALL(GenBuffers(1, &fBufferID));
     if (fBufferID) {
         GrGLenum target = gpu->bindBuffer(fIntendedType, this);
-        GrGLenum error = GL_ALLOC_CALL(this->glGpu(), BufferData(target,
-                                                                 (GrGLsizeiptr)size,
-                                                                 nullptr,
-                                                                 fUsage));
+        GrGLenum error;
+        if (persistent) {
+            static constexpr GrGLbitfield kFlags =
+                    GR_GL_MAP_WRITE_BIT | GR_GL_MAP_PERSISTENT_BIT | GR_GL_MAP_COHERENT_BIT;
+            error = GL_ALLOC_CALL(this->glGpu(), BufferStorage(target,
+                                                               (GrGLsizeiptr)size,
+                                                               nullptr,
+                                                               kFlags));
+            if (error == GR_GL_NO_ERROR) {
+                GL_CALL_RET(fPersistentPtr, MapBufferRange(target, 0, size, kFlags));
+                if (!fPersistentPtr) {
+                    error = GR_GL_INVALID_OPERATION;
+                }
+            }
+        } else {
+            error = GL_ALLOC_CALL(this->glGpu(), BufferData(target,
+                                                            (GrGLsizeiptr)size,
+                                                            nullptr,
+                                                            fUsage));
+        }
         if (error != GR_GL_NO_ERROR) {
+            fPersistentPtr = nullptr;
             GL_CALL(DeleteBuffers(1, &fBufferID));
             fBufferID = 0;
         }
@@ -147,6 +180,7 @@ void GrGLBuffer::onRelease() {
             fBufferID = 0;
         }
         fMapPtr = nullptr;
+        fPersistentPtr = nullptr;
     }
 
     INHERITED::onRelease();
@@ -155,6 +189,7 @@ void GrGLBuffer::onRelease() {
 void GrGLBuffer::onAbandon() {
     fBufferID = 0;
     fMapPtr = nullptr;
+    fPersistentPtr = nullptr;
     INHERITED::onAbandon();
 }
 
@@ -180,6 +215,13 @@ void GrGLBuffer::onMap(MapType type) {
     SkASSERT(!this->wasDestroyed());
     SkASSERT(!this->isMapped());
 
+    if (fPersistentPtr) {
+        // Persistent buffers are write-only and are never invalidated; the owner fences reuse.
+        SkASSERT(type == MapType::kWriteDiscard);
+        fMapPtr = fPersistentPtr;
+        return;
+    }
+
     // Handling dirty context is done in the bindBuffer call
     switch (this->glCaps().mapBufferType()) {
         case GrGLCaps::kNone_MapBufferType:
@@ -225,6 +267,11 @@ void GrGLBuffer::onMap(MapType type) {
 
 void GrGLBuffer::onUnmap(MapType) {
     SkASSERT(fBufferID);
+    if (fPersistentPtr) {
+        // Coherent mappings need no flush and stay mapped until the buffer is deleted.
+        fMapPtr = nullptr;
+        return;
+    }
     // bind buffer handles the dirty context
     switch (this->glCaps().mapBufferType()) {
         case GrGLCaps::kNone_MapBufferType:
@@ -263,6 +310,12 @@ bool GrGLBuffer::onClearToZero() {
 bool GrGLBuffer::onUpdateData(const void* src, size_t offset, size_t size, bool preserve) {
     SkASSERT(fBufferID);
 
+    if (fPersistentPtr) {
+        // Immutable storage can't be respecified, and the mapped range is already coherent.
+        memcpy(static_cast<char*>(fPersistentPtr) + offset, src, size);
+        return true;
+    }
+
     // bindbuffer handles dirty context
     GrGLenum target = this->glGpu()->bindBuffer(fIntendedType, this);
     if (!preserve) {
@@ -21,6 +21,14 @@ public:
                                   GrGpuBufferType intendedType,
                                   GrAccessPattern);
 
+    /**
+     * Makes a buffer with immutable storage that stays mapped for its whole lifetime
+     * (GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT). map() and unmap() are effectively free. The
+     * caller is responsible for fencing writes against in-flight GPU reads, e.g. via GrRingBuffer.
+     * Requires GrGLCaps::persistentlyMappedBufferSupport().
+     */
+    static sk_sp<GrGLBuffer> MakePersistent(GrGLGpu*, size_t size, GrGpuBufferType intendedType);
+
     ~GrGLBuffer() override {
         // either release or abandon should have been called by the owner of this object.
         SkASSERT(0 == fBufferID);
@@ -36,6 +44,7 @@ protected:
                size_t size,
                GrGpuBufferType intendedType,
                GrAccessPattern,
+               bool persistent,
                std::string_view label);
 
     void onAbandon() override;
@@ -58,6 +67,7 @@ private:
     GrGLuint        fBufferID;
     GrGLenum        fUsage;
     bool            fHasAttachedToTexture;
+    void*           fPersistentPtr = nullptr;
 
     using INHERITED = GrGpuBuffer;
 };
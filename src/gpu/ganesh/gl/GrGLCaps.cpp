@@ -74,6 +74,8 @@ GrGLCaps::GrGLCaps(const GrContextOptions& contextOptions,
     fDoManualMipmapping = false;
     fClearToBoundaryValuesIsBroken = false;
     fClearTextureSupport = false;
+    fTimestampQuerySupport = false;
+    fTimestampQueriesCanBeDisjoint = false;
     fDrawArraysBaseVertexIsBroken = false;
     fDisallowTexSubImageForUnormConfigTexturesEverBoundToFBO = false;
     fUseDrawInsteadOfAllRenderTargetWrites = false;
@@ -97,6 +99,8 @@ GrGLCaps::GrGLCaps(const GrContextOptions& contextOptions,
     fTextureSwizzleSupport = false;
     fTiledRenderingSupport = false;
     fFenceSyncSupport = false;
+    fPersistentlyMappedBufferSupport = false;
+    fUniformBufferSupport = false;
     fFBFetchRequiresEnablePerSample = false;
     fSRGBWriteControl = false;
     fSkipErrorChecks = false;
@@ -367,6 +371,21 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
         fClearTextureSupport = false;
     }
 
+    // WebGL's timer query extension is not loaded into the interface.
+    if (GR_IS_GR_GL(standard)) {
+        fTimestampQuerySupport = version >= GR_GL_VER(3,3) ||
+                                 ctxInfo.hasExtension("GL_ARB_timer_query");
+    } else if (GR_IS_GR_GL_ES(standard)) {
+        fTimestampQuerySupport = ctxInfo.hasExtension("GL_EXT_disjoint_timer_query");
+        fTimestampQueriesCanBeDisjoint = fTimestampQuerySupport;
+    }
+    fTimestampQuerySupport = fTimestampQuerySupport &&
+                             gli->fFunctions.fQueryCounter &&
+                             gli->fFunctions.fGetQueryObjectui64v &&
+                             gli->fFunctions.fGenQueries &&
+                             gli->fFunctions.fDeleteQueries &&
+                             gli->fFunctions.fGetQueryObjectuiv;
+
 #if defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
     fSupportsAHardwareBufferImages = true;
 #endif
@@ -831,6 +850,39 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
         fTiledRenderingSupport = ctxInfo.hasExtension("GL_QCOM_tiled_rendering");
     }
 
+    if (GR_IS_GR_GL(standard)) {
+        fPersistentlyMappedBufferSupport = version >= GR_GL_VER(4, 4) ||
+                                           ctxInfo.hasExtension("GL_ARB_buffer_storage");
+    } else if (GR_IS_GR_GL_ES(standard)) {
+        fPersistentlyMappedBufferSupport = ctxInfo.hasExtension("GL_EXT_buffer_storage");
+    } // Not supported in WebGL
+
+    if (GR_IS_GR_GL(standard)) {
+        fUniformBufferSupport = version >= GR_GL_VER(3, 1) ||
+                                ctxInfo.hasExtension("GL_ARB_uniform_buffer_object");
+        // We declare the uniform block with layout(std140), which requires GLSL 1.40.
+        fUniformBufferSupport &= shaderCaps->fGLSLGeneration >= SkSL::GLSLGeneration::k140;
+    } else if (GR_IS_GR_GL_ES(standard)) {
+        fUniformBufferSupport = version >= GR_GL_VER(3, 0) &&
+                                shaderCaps->fGLSLGeneration >= SkSL::GLSLGeneration::k300es;
+    } else if (GR_IS_GR_WEBGL(standard)) {
+        fUniformBufferSupport = version >= GR_GL_VER(2, 0) &&
+                                shaderCaps->fGLSLGeneration >= SkSL::GLSLGeneration::k300es;
+    }
+    if (fUniformBufferSupport) {
+        GrGLint alignment = 0;
+        GrGLint maxBlockSize = 0;
+        GR_GL_GetIntegerv(gli, GR_GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        GR_GL_GetIntegerv(gli, GR_GL_MAX_UNIFORM_BLOCK_SIZE, &maxBlockSize);
+        // Uniform slices are suballocated from a GrRingBuffer, which needs a power of 2 alignment.
+        if (alignment > 0 && SkIsPow2(alignment) && maxBlockSize > 0) {
+            fUniformBufferOffsetAlignment = alignment;
+            fMaxUniformBlockSize = maxBlockSize;
+        } else {
+            fUniformBufferSupport = false;
+        }
+    }
+
     if (ctxInfo.vendor() == GrGLVendor::kARM) {
         fShouldCollapseSrcOverToSrcWhenAble = true;
     }
@@ -851,6 +903,21 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
                                                 &formatWorkarounds);
     }
 
+    // Persistent mappings are created with glMapBufferRange and rely on fences to know when the
+    // GPU has finished reading a region so it can be overwritten. Check this after the workarounds
+    // since they may disable buffer mapping. glBufferStorage is optional in the interface so that
+    // we don't reject clients that advertise the extension without providing the function.
+    if (fMapBufferType != kMapBufferRange_MapBufferType || !fFenceSyncSupport ||
+        !gli->fFunctions.fBufferStorage) {
+        fPersistentlyMappedBufferSupport = false;
+    }
+
+    // The uniform block functions are optional in the interface for the same reason.
+    if (!gli->fFunctions.fBindBufferRange || !gli->fFunctions.fGetUniformBlockIndex ||
+        !gli->fFunctions.fUniformBlockBinding) {
+        fUniformBufferSupport = false;
+    }
+
     // Requires msaa support, ES compatibility have already been detected.
     this->initFormatTable(ctxInfo, gli, formatWorkarounds);
 
@@ -1289,6 +1356,8 @@ void GrGLCaps::onDumpJSON(SkJSONWriter* writer) const {
     writer->appendBool("Mipmap LOD control support", fMipmapLodControlSupport);
     writer->appendBool("Mipmap level control support", fMipmapLevelControlSupport);
     writer->appendBool("Clear texture support", fClearTextureSupport);
+    writer->appendBool("Timestamp query support", fTimestampQuerySupport);
+    writer->appendBool("Timestamp queries can be disjoint", fTimestampQueriesCanBeDisjoint);
     writer->appendBool("Program binary support", fProgramBinarySupport);
     writer->appendBool("Program parameters support", fProgramParameterSupport);
     writer->appendBool("Sampler object support", fSamplerObjectSupport);
@@ -1296,6 +1365,8 @@ void GrGLCaps::onDumpJSON(SkJSONWriter* writer) const {
     writer->appendBool("Texture swizzle support", fTextureSwizzleSupport);
     writer->appendBool("Tiled rendering support", fTiledRenderingSupport);
     writer->appendBool("Fence sync support", fFenceSyncSupport);
+    writer->appendBool("Persistently mapped buffer support", fPersistentlyMappedBufferSupport);
+    writer->appendBool("Uniform buffer support", fUniformBufferSupport);
     writer->appendBool("FB fetch requires enable per sample", fFBFetchRequiresEnablePerSample);
     writer->appendBool("sRGB Write Control", fSRGBWriteControl);
 
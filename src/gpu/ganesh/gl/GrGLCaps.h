@@ -331,6 +331,24 @@ public:
     /** Supports using GrGLsync. */
     bool fenceSyncSupport() const { return fFenceSyncSupport; }
 
+    /**
+     * Supports immutable buffer storage that stays mapped (persistent and coherent) while the GPU
+     * reads from it. Used to stream dynamic vertex and index data through ring buffers.
+     */
+    bool persistentlyMappedBufferSupport() const { return fPersistentlyMappedBufferSupport; }
+
+    /**
+     * Supports sourcing program uniforms from a std140 uniform block that is bound to a range of a
+     * buffer with glBindBufferRange.
+     */
+    bool uniformBufferSupport() const { return fUniformBufferSupport; }
+
+    /** Required alignment of uniform buffer offsets passed to glBindBufferRange. */
+    size_t uniformBufferOffsetAlignment() const { return fUniformBufferOffsetAlignment; }
+
+    /** The maximum size in bytes of a uniform block. */
+    size_t maxUniformBlockSize() const { return fMaxUniformBlockSize; }
+
     /// How is GrGLsync implemented?
     FenceType fenceType() const { return fFenceType; }
 
@@ -401,6 +419,13 @@ public:
     /// glClearTex(Sub)Image support
     bool clearTextureSupport() const { return fClearTextureSupport; }
 
+    /// glQueryCounter(GL_TIMESTAMP) support
+    bool timestampQuerySupport() const { return fTimestampQuerySupport; }
+
+    /// Whether GL_GPU_DISJOINT must be checked before trusting timestamps
+    /// (GL_EXT_disjoint_timer_query)
+    bool timestampQueriesCanBeDisjoint() const { return fTimestampQueriesCanBeDisjoint; }
+
     // Adreno/MSAA drops a draw on the imagefiltersbase GM if the base vertex param to
     // glDrawArrays is nonzero.
     // https://bugs.chromium.org/p/skia/issues/detail?id=6650
@@ -593,6 +618,8 @@ private:
     skia_private::TArray<GrGLenum, true> fProgramBinaryFormats;
 
     int fMaxFragmentUniformVectors = 0;
+    size_t fUniformBufferOffsetAlignment = 0;
+    size_t fMaxUniformBlockSize = 0;
     float fMaxTextureMaxAnisotropy = 1.f;
 
     MSFBOType            fMSFBOType            = kNone_MSFBOType;
@@ -619,6 +646,8 @@ private:
     bool fMipmapLevelControlSupport : 1;
     bool fMipmapLodControlSupport : 1;
     bool fClearTextureSupport : 1;
+    bool fTimestampQuerySupport : 1;
+    bool fTimestampQueriesCanBeDisjoint : 1;
     bool fProgramBinarySupport : 1;
     bool fProgramParameterSupport : 1;
     bool fSamplerObjectSupport : 1;
@@ -626,6 +655,8 @@ private:
     bool fTextureSwizzleSupport : 1;
     bool fTiledRenderingSupport : 1;
     bool fFenceSyncSupport : 1;
+    bool fPersistentlyMappedBufferSupport : 1;
+    bool fUniformBufferSupport : 1;
     bool fFBFetchRequiresEnablePerSample : 1;
     bool fSRGBWriteControl : 1;
     bool fSkipErrorChecks : 1;
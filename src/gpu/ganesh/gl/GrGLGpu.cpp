@@ -62,6 +62,7 @@
 #include "src/gpu/ganesh/gl/GrGLProgram.h"
 #include "src/gpu/ganesh/gl/GrGLSemaphore.h"
 #include "src/gpu/ganesh/gl/GrGLTextureRenderTarget.h"
+#include "src/gpu/ganesh/gl/GrGLUniformHandler.h"
 #include "src/gpu/ganesh/gl/builders/GrGLShaderStringBuilder.h"
 #include "src/sksl/SkSLProgramKind.h"
 #include "src/sksl/SkSLProgramSettings.h"
@@ -452,6 +453,9 @@ GrGLGpu::GrGLGpu(std::unique_ptr<GrGLContext> ctx, GrDirectContext* dContext)
     this->hwBufferState(GrGpuBufferType::kVertex)->fGLTarget = GR_GL_ARRAY_BUFFER;
     this->hwBufferState(GrGpuBufferType::kIndex)->fGLTarget = GR_GL_ELEMENT_ARRAY_BUFFER;
     this->hwBufferState(GrGpuBufferType::kDrawIndirect)->fGLTarget = GR_GL_DRAW_INDIRECT_BUFFER;
+    if (this->glCaps().uniformBufferSupport()) {
+        this->hwBufferState(GrGpuBufferType::kUniform)->fGLTarget = GR_GL_UNIFORM_BUFFER;
+    }
     if (GrGLCaps::TransferBufferType::kChromium == this->glCaps().transferBufferType()) {
         this->hwBufferState(GrGpuBufferType::kXferCpuToGpu)->fGLTarget =
                 GR_GL_PIXEL_UNPACK_TRANSFER_BUFFER_CHROMIUM;
@@ -464,13 +468,34 @@ GrGLGpu::GrGLGpu(std::unique_ptr<GrGLContext> ctx, GrDirectContext* dContext)
     for (int i = 0; i < kGrGpuBufferTypeCount; ++i) {
         fHWBufferState[i].invalidate();
     }
+    fHWUniformBufferRange.invalidate();
 
     if (this->glCaps().useSamplerObjects()) {
         fSamplerObjectCache = std::make_unique<SamplerObjectCache>(this);
     }
+
+    if (this->glCaps().persistentlyMappedBufferSupport() &&
+        !this->glCaps().preferClientSideDynamicBuffers()) {
+        static constexpr size_t kRingSize = 1 << 20;
+        static constexpr size_t kRingAlignment = 16;
+        fVertexRingBuffer = std::make_unique<GrRingBuffer>(this, kRingSize, kRingAlignment,
+                                                           GrGpuBufferType::kVertex);
+        fIndexRingBuffer = std::make_unique<GrRingBuffer>(this, kRingSize, kRingAlignment,
+                                                          GrGpuBufferType::kIndex);
+    }
+
+    if (this->glCaps().uniformBufferSupport()) {
+        static constexpr size_t kUniformRingSize = 128 * 1024;
+        fUniformsRingBuffer = std::make_unique<GrRingBuffer>(
+                this, kUniformRingSize, this->glCaps().uniformBufferOffsetAlignment(),
+                GrGpuBufferType::kUniform);
+    }
 }
 
 GrGLGpu::~GrGLGpu() {
+    // Delete any outstanding timestamp queries while we still can.
+    this->setOpTimingsEnabled(false);
+
     // Ensure any GrGpuResource objects get deleted first, since they may require a working GrGLGpu
     // to release the resources held by the objects themselves.
     fCopyProgramArrayBuffer.reset();
@@ -595,6 +620,10 @@ void GrGLGpu::onResetContext(uint32_t resetBits) {
 
         this->hwBufferState(GrGpuBufferType::kXferCpuToGpu)->invalidate();
         this->hwBufferState(GrGpuBufferType::kXferGpuToCpu)->invalidate();
+        if (this->glCaps().uniformBufferSupport()) {
+            this->hwBufferState(GrGpuBufferType::kUniform)->invalidate();
+            fHWUniformBufferRange.invalidate();
+        }
 
         if (GR_IS_GR_GL(this->glStandard())) {
 #ifndef USE_NSIGHT
@@ -2079,7 +2108,10 @@ bool GrGLGpu::flushGLState(GrRenderTarget* renderTarget, bool useMultisampleFBO,
     this->flushBlendAndColorWrite(programInfo.pipeline().getXferProcessor().getBlendInfo(),
                                   programInfo.pipeline().writeSwizzle());
 
-    fHWProgram->updateUniforms(renderTarget, programInfo);
+    if (!fHWProgram->updateUniforms(renderTarget, programInfo)) {
+        GrCapsDebugf(this->caps(), "Failed to upload uniforms!\n");
+        return false;
+    }
 
     GrGLRenderTarget* glRT = static_cast<GrGLRenderTarget*>(renderTarget);
     GrStencilSettings stencil;
@@ -2166,6 +2198,28 @@ GrGLenum GrGLGpu::bindBuffer(GrGpuBufferType type, const GrBuffer* buffer) {
     return bufferState->fGLTarget;
 }
 
+void GrGLGpu::bindUniformBufferRange(const GrGpuBuffer* buffer, size_t offset, size_t size) {
+    SkASSERT(this->glCaps().uniformBufferSupport());
+    SkASSERT(!buffer->isCpuBuffer());
+
+    if (buffer->uniqueID() == fHWUniformBufferRange.fBufferUniqueID &&
+        offset == fHWUniformBufferRange.fOffset &&
+        size == fHWUniformBufferRange.fSize) {
+        return;
+    }
+    const GrGLBuffer* glBuffer = static_cast<const GrGLBuffer*>(buffer);
+    GL_CALL(BindBufferRange(GR_GL_UNIFORM_BUFFER, GrGLUniformHandler::kUniformBlockBinding,
+                            glBuffer->bufferID(), offset, size));
+    fHWUniformBufferRange.fBufferUniqueID = glBuffer->uniqueID();
+    fHWUniformBufferRange.fOffset = offset;
+    fHWUniformBufferRange.fSize = size;
+
+    // glBindBufferRange also binds the buffer to the generic uniform buffer binding point.
+    auto* bufferState = this->hwBufferState(GrGpuBufferType::kUniform);
+    bufferState->fBufferZeroKnownBound = false;
+    bufferState->fBoundBufferUniqueID = glBuffer->uniqueID();
+}
+
 void GrGLGpu::clear(const GrScissorState& scissor,
                     std::array<float, 4> color,
                     GrRenderTarget* target,
@@ -4338,6 +4392,24 @@ void GrGLGpu::deleteFence(GrGLsync fence) {
     }
 }
 
+GrRingBuffer* GrGLGpu::streamingRingBuffer(GrGpuBufferType type) {
+    switch (type) {
+        case GrGpuBufferType::kVertex:
+            return fVertexRingBuffer.get();
+        case GrGpuBufferType::kIndex:
+            return fIndexRingBuffer.get();
+        default:
+            return nullptr;
+    }
+}
+
+sk_sp<GrGpuBuffer> GrGLGpu::createRingBufferBuffer(size_t size, GrGpuBufferType type) {
+    if (this->glCaps().persistentlyMappedBufferSupport()) {
+        return GrGLBuffer::MakePersistent(this, size, type);
+    }
+    return INHERITED::createRingBufferBuffer(size, type);
+}
+
 [[nodiscard]] std::unique_ptr<GrSemaphore> GrGLGpu::makeSemaphore(bool isOwned) {
     SkASSERT(this->caps()->semaphoreSupport());
     return GrGLSemaphore::Make(this, isOwned);
@@ -4374,6 +4446,46 @@ void GrGLGpu::finishOutstandingGpuWork() {
     GL_CALL(Finish());
 }
 
+bool GrGLGpu::supportsTimestampQueries() const {
+    return this->glCaps().timestampQuerySupport();
+}
+
+GrGpu::TimestampQuery GrGLGpu::writeTimestamp(GrOpsRenderPass*) {
+    // GL commands are issued as they are recorded, so the timestamp doesn't depend on the pass.
+    GrGLuint query = 0;
+    GL_CALL(GenQueries(1, &query));
+    if (query) {
+        GL_CALL(QueryCounter(query, GR_GL_TIMESTAMP));
+    }
+    return query;
+}
+
+bool GrGLGpu::getTimestampResult(TimestampQuery query, uint64_t* nanoseconds) {
+    GrGLuint available = 0;
+    GL_CALL(GetQueryObjectuiv(query, GR_GL_QUERY_RESULT_AVAILABLE, &available));
+    if (!available) {
+        return false;
+    }
+    GrGLuint64 result = 0;
+    GL_CALL(GetQueryObjectui64v(query, GR_GL_QUERY_RESULT, &result));
+    *nanoseconds = result;
+    return true;
+}
+
+bool GrGLGpu::checkTimestampsDisjoint() {
+    if (!this->glCaps().timestampQueriesCanBeDisjoint()) {
+        return false;
+    }
+    // Reading GL_GPU_DISJOINT also clears it.
+    GrGLint disjoint = 0;
+    GR_GL_GetIntegerv(this->glInterface(), GR_GL_GPU_DISJOINT, &disjoint);
+    return disjoint;
+}
+
+void GrGLGpu::deleteTimestampQuery(TimestampQuery query) {
+    GL_CALL(DeleteQueries(1, &query));
+}
+
 void GrGLGpu::clearErrorsAndCheckForOOM() {
     while (this->getErrorAndCheckForOOM() != GR_GL_NO_ERROR) {}
 }
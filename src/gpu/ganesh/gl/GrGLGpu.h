@@ -32,6 +32,7 @@
 #include "src/gpu/ganesh/GrNativeRect.h"
 #include "src/gpu/ganesh/GrOpsRenderPass.h"
 #include "src/gpu/ganesh/GrProgramDesc.h"
+#include "src/gpu/ganesh/GrRingBuffer.h"
 #include "src/gpu/ganesh/GrSamplerState.h"
 #include "src/gpu/ganesh/GrScissorState.h"
 #include "src/gpu/ganesh/GrShaderCaps.h"
@@ -130,6 +131,9 @@ public:
     // If the caller wishes to bind an index buffer to a specific VAO, it can call glBind directly.
     GrGLenum bindBuffer(GrGpuBufferType type, const GrBuffer*);
 
+    // Binds a range of a uniform buffer to GrGLUniformHandler::kUniformBlockBinding.
+    void bindUniformBufferRange(const GrGpuBuffer*, size_t offset, size_t size);
+
     // Flushes state from GrProgramInfo to GL. Returns false if the state couldn't be set.
     bool flushGLState(GrRenderTarget*, bool useMultisampleFBO, const GrProgramInfo&);
     void flushScissorRect(const SkIRect& scissor, int rtHeight, GrSurfaceOrigin);
@@ -253,8 +257,18 @@ public:
     void waitSemaphore(GrSemaphore* semaphore) override;
 
     void checkFinishProcs() override;
+
+    GrRingBuffer* uniformsRingBuffer() override { return fUniformsRingBuffer.get(); }
+    GrRingBuffer* streamingRingBuffer(GrGpuBufferType) override;
+    sk_sp<GrGpuBuffer> createRingBufferBuffer(size_t size, GrGpuBufferType) override;
     void finishOutstandingGpuWork() override;
 
+    bool supportsTimestampQueries() const override;
+    TimestampQuery writeTimestamp(GrOpsRenderPass*) override;
+    bool getTimestampResult(TimestampQuery, uint64_t* nanoseconds) override;
+    bool checkTimestampsDisjoint() override;
+    void deleteTimestampQuery(TimestampQuery) override;
+
     // Calls glGetError() until no errors are reported. Also looks for OOMs.
     void clearErrorsAndCheckForOOM();
     // Calls glGetError() once and returns the result. Also looks for an OOM.
@@ -752,10 +766,19 @@ private:
     auto* hwBufferState(GrGpuBufferType type) {
         unsigned typeAsUInt = static_cast<unsigned>(type);
         SkASSERT(typeAsUInt < std::size(fHWBufferState));
-        SkASSERT(type != GrGpuBufferType::kUniform);
+        SkASSERT(type != GrGpuBufferType::kUniform || this->glCaps().uniformBufferSupport());
         return &fHWBufferState[typeAsUInt];
     }
 
+    // The range of a uniform buffer bound to GrGLUniformHandler::kUniformBlockBinding.
+    struct {
+        GrGpuResource::UniqueID fBufferUniqueID;
+        size_t                  fOffset;
+        size_t                  fSize;
+
+        void invalidate() { fBufferUniqueID.makeInvalid(); }
+    }                                       fHWUniformBufferRange;
+
     enum class FlushType {
         kIfRequired,
         kForce,
@@ -857,6 +880,14 @@ private:
 
     std::unique_ptr<GrStagingBufferManager> fStagingBufferManager;
 
+    // Persistently mapped rings that GrBufferAllocPool streams vertex and index data through.
+    // Only created when GrGLCaps::persistentlyMappedBufferSupport() is true.
+    std::unique_ptr<GrRingBuffer> fVertexRingBuffer;
+    std::unique_ptr<GrRingBuffer> fIndexRingBuffer;
+    // Ring that program uniform blocks are suballocated from. Only created when
+    // GrGLCaps::uniformBufferSupport() is true.
+    std::unique_ptr<GrRingBuffer> fUniformsRingBuffer;
+
     GrGLFinishCallbacks fFinishCallbacks;
 
     // If we've called a command that requires us to call glFlush than this will be set to true
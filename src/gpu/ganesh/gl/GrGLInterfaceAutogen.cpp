@@ -713,10 +713,7 @@ bool GrGLInterface::validate() const {
           fExtensions.has("GL_EXT_occlusion_query_boolean")))) {
 #if defined(GR_TEST_UTILS)
         if (!fFunctions.fBeginQuery ||
-            !fFunctions.fDeleteQueries ||
             !fFunctions.fEndQuery ||
-            !fFunctions.fGenQueries ||
-            !fFunctions.fGetQueryObjectuiv ||
             !fFunctions.fGetQueryiv) {
             RETURN_FALSE_INTERFACE;
         }
@@ -727,7 +724,9 @@ bool GrGLInterface::validate() const {
     if ((GR_IS_GR_GL(fStandard) && (
           (glVer >= GR_GL_VER(3,3)) ||
           fExtensions.has("GL_ARB_timer_query") ||
-          fExtensions.has("GL_EXT_timer_query")))) {
+          fExtensions.has("GL_EXT_timer_query"))) ||
+       (GR_IS_GR_GL_ES(fStandard) && (
+          fExtensions.has("GL_EXT_disjoint_timer_query")))) {
         if (!fFunctions.fGetQueryObjecti64v ||
             !fFunctions.fGetQueryObjectui64v) {
             RETURN_FALSE_INTERFACE;
@@ -736,7 +735,9 @@ bool GrGLInterface::validate() const {
 
     if ((GR_IS_GR_GL(fStandard) && (
           (glVer >= GR_GL_VER(3,3)) ||
-          fExtensions.has("GL_ARB_timer_query")))) {
+          fExtensions.has("GL_ARB_timer_query"))) ||
+       (GR_IS_GR_GL_ES(fStandard) && (
+          fExtensions.has("GL_EXT_disjoint_timer_query")))) {
         if (!fFunctions.fQueryCounter) {
             RETURN_FALSE_INTERFACE;
         }
@@ -29,6 +29,7 @@ sk_sp<GrGLProgram> GrGLProgram::Make(
         const GrGLSLBuiltinUniformHandles& builtinUniforms,
         GrGLuint programID,
         const UniformInfoArray& uniforms,
+        uint32_t uniformBlockSize,
         const UniformInfoArray& textureSamplers,
         std::unique_ptr<GrGeometryProcessor::ProgramImpl> gpImpl,
         std::unique_ptr<GrXferProcessor::ProgramImpl> xpImpl,
@@ -42,6 +43,7 @@ sk_sp<GrGLProgram> GrGLProgram::Make(
                                                builtinUniforms,
                                                programID,
                                                uniforms,
+                                               uniformBlockSize,
                                                textureSamplers,
                                                std::move(gpImpl),
                                                std::move(xpImpl),
@@ -61,6 +63,7 @@ GrGLProgram::GrGLProgram(GrGLGpu* gpu,
                          const GrGLSLBuiltinUniformHandles& builtinUniforms,
                          GrGLuint programID,
                          const UniformInfoArray& uniforms,
+                         uint32_t uniformBlockSize,
                          const UniformInfoArray& textureSamplers,
                          std::unique_ptr<GrGeometryProcessor::ProgramImpl> gpImpl,
                          std::unique_ptr<GrXferProcessor::ProgramImpl> xpImpl,
@@ -81,7 +84,7 @@ GrGLProgram::GrGLProgram(GrGLGpu* gpu,
         , fVertexStride(vertexStride)
         , fInstanceStride(instanceStride)
         , fGpu(gpu)
-        , fProgramDataManager(gpu, uniforms)
+        , fProgramDataManager(gpu, uniforms, uniformBlockSize)
         , fNumTextureSamplers(textureSamplers.count()) {}
 
 GrGLProgram::~GrGLProgram() {
@@ -96,7 +99,7 @@ void GrGLProgram::abandon() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void GrGLProgram::updateUniforms(const GrRenderTarget* renderTarget,
+bool GrGLProgram::updateUniforms(const GrRenderTarget* renderTarget,
                                  const GrProgramInfo& programInfo) {
     this->setRenderTargetState(renderTarget, programInfo.origin(), programInfo.geomProc());
 
@@ -118,6 +121,8 @@ void GrGLProgram::updateUniforms(const GrRenderTarget* renderTarget,
 
     programInfo.pipeline().setDstTextureUniforms(fProgramDataManager, &fBuiltinUniformHandles);
     fXPImpl->setData(fProgramDataManager, programInfo.pipeline().getXferProcessor());
+
+    return fProgramDataManager.uploadUniformBlock();
 }
 
 void GrGLProgram::bindTextures(const GrGeometryProcessor& geomProc,
@@ -55,6 +55,7 @@ public:
             const GrGLSLBuiltinUniformHandles&,
             GrGLuint programID,
             const UniformInfoArray& uniforms,
+            uint32_t uniformBlockSize,
             const UniformInfoArray& textureSamplers,
             std::unique_ptr<GrGeometryProcessor::ProgramImpl>,
             std::unique_ptr<GrXferProcessor::ProgramImpl>,
@@ -95,11 +96,12 @@ public:
     };
 
     /**
-     * This function uploads uniforms and calls each GrGLSL*Processor's setData.
+     * This function uploads uniforms and calls each GrGLSL*Processor's setData. Returns false if
+     * the program's uniform block could not be uploaded.
      *
      * It is the caller's responsibility to ensure the program is bound before calling.
      */
-    void updateUniforms(const GrRenderTarget*, const GrProgramInfo&);
+    bool updateUniforms(const GrRenderTarget*, const GrProgramInfo&);
 
     /**
      * Binds all geometry processor and fragment processor textures.
@@ -128,6 +130,7 @@ private:
                 const GrGLSLBuiltinUniformHandles&,
                 GrGLuint programID,
                 const UniformInfoArray& uniforms,
+                uint32_t uniformBlockSize,
                 const UniformInfoArray& textureSamplers,
                 std::unique_ptr<GrGeometryProcessor::ProgramImpl>,
                 std::unique_ptr<GrXferProcessor::ProgramImpl>,
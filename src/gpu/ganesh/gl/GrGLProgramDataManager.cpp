@@ -6,15 +6,45 @@
  */
 
 #include "include/core/SkMatrix.h"
+#include "src/gpu/ganesh/GrRingBuffer.h"
+#include "src/gpu/ganesh/GrUniformDataManager.h"
 #include "src/gpu/ganesh/gl/GrGLGpu.h"
 #include "src/gpu/ganesh/gl/GrGLProgramDataManager.h"
 #include "src/gpu/ganesh/glsl/GrGLSLUniformHandler.h"
 
+#include <algorithm>
+
 #define ASSERT_ARRAY_UPLOAD_IN_BOUNDS(UNI, COUNT) \
          SkASSERT((COUNT) <= (UNI).fArrayCount || \
                   (1 == (COUNT) && GrShaderVar::kNonArray == (UNI).fArrayCount))
 
-GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, const UniformInfoArray& uniforms)
+// Stores the std140 uniform block of a program on the CPU. Only the uniforms in the block are
+// written through it; the remaining entries are never referenced.
+class GrGLProgramDataManager::UniformBlock : public GrUniformDataManager {
+public:
+    UniformBlock(const UniformInfoArray& uniforms, uint32_t uniformBlockSize)
+            : INHERITED(uniforms.count(), uniformBlockSize) {
+        int i = 0;
+        for (const GLUniformInfo& uniformInfo : uniforms.items()) {
+            Uniform& uniform = fUniforms[i++];
+            SkDEBUGCODE(
+                uniform.fArrayCount = uniformInfo.fVariable.getArrayCount();
+            )
+            uniform.fOffset = std::max(uniformInfo.fBlockOffset, 0);
+            uniform.fType = uniformInfo.fVariable.getType();
+        }
+    }
+
+    const void* data() const { return fUniformData.get(); }
+    uint32_t size() const { return fUniformSize; }
+
+private:
+    using INHERITED = GrUniformDataManager;
+};
+
+GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu,
+                                               const UniformInfoArray& uniforms,
+                                               uint32_t uniformBlockSize)
         : fGpu(gpu) {
     fUniforms.push_back_n(uniforms.count());
     int i = 0;
@@ -27,9 +57,33 @@ GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, const UniformInfoAr
             uniform.fType = builderUniform.fVariable.getType();
         )
         uniform.fLocation = builderUniform.fLocation;
+        uniform.fInBlock = uniformBlockSize && builderUniform.fBlockOffset >= 0;
+    }
+    if (uniformBlockSize) {
+        fUniformBlock = std::make_unique<UniformBlock>(uniforms, uniformBlockSize);
     }
 }
 
+GrGLProgramDataManager::~GrGLProgramDataManager() = default;
+
+bool GrGLProgramDataManager::uploadUniformBlock() const {
+    if (!fUniformBlock) {
+        return true;
+    }
+    GrRingBuffer* ringBuffer = fGpu->uniformsRingBuffer();
+    if (!ringBuffer) {
+        return false;
+    }
+    GrRingBuffer::Slice slice = ringBuffer->suballocate(fUniformBlock->size());
+    if (!slice.fBuffer ||
+        !slice.fBuffer->updateData(fUniformBlock->data(), slice.fOffset, fUniformBlock->size(),
+                                   /*preserve=*/true)) {
+        return false;
+    }
+    fGpu->bindUniformBufferRange(slice.fBuffer, slice.fOffset, fUniformBlock->size());
+    return true;
+}
+
 void GrGLProgramDataManager::setSamplerUniforms(const UniformInfoArray& samplers,
                                                 int startUnit) const {
     int i = 0;
@@ -44,6 +98,10 @@ void GrGLProgramDataManager::setSamplerUniforms(const UniformInfoArray& samplers
 
 void GrGLProgramDataManager::set1i(UniformHandle u, int32_t i) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set1i(u, i);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kInt || uni.fType == SkSLType::kShort);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
     if (kUnusedUniform != uni.fLocation) {
@@ -55,6 +113,10 @@ void GrGLProgramDataManager::set1iv(UniformHandle u,
                                     int arrayCount,
                                     const int32_t v[]) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set1iv(u, arrayCount, v);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kInt || uni.fType == SkSLType::kShort);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
@@ -65,6 +127,10 @@ void GrGLProgramDataManager::set1iv(UniformHandle u,
 
 void GrGLProgramDataManager::set1f(UniformHandle u, float v0) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set1f(u, v0);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kFloat || uni.fType == SkSLType::kHalf);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
     if (kUnusedUniform != uni.fLocation) {
@@ -76,6 +142,10 @@ void GrGLProgramDataManager::set1fv(UniformHandle u,
                                     int arrayCount,
                                     const float v[]) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set1fv(u, arrayCount, v);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kFloat || uni.fType == SkSLType::kHalf);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
@@ -90,6 +160,10 @@ void GrGLProgramDataManager::set1fv(UniformHandle u,
 
 void GrGLProgramDataManager::set2i(UniformHandle u, int32_t i0, int32_t i1) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set2i(u, i0, i1);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kInt2 || uni.fType == SkSLType::kShort2);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
     if (kUnusedUniform != uni.fLocation) {
@@ -101,6 +175,10 @@ void GrGLProgramDataManager::set2iv(UniformHandle u,
                                     int arrayCount,
                                     const int32_t v[]) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set2iv(u, arrayCount, v);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kInt2 || uni.fType == SkSLType::kShort2);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
@@ -111,6 +189,10 @@ void GrGLProgramDataManager::set2iv(UniformHandle u,
 
 void GrGLProgramDataManager::set2f(UniformHandle u, float v0, float v1) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set2f(u, v0, v1);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kFloat2 || uni.fType == SkSLType::kHalf2);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
     if (kUnusedUniform != uni.fLocation) {
@@ -122,6 +204,10 @@ void GrGLProgramDataManager::set2fv(UniformHandle u,
                                     int arrayCount,
                                     const float v[]) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set2fv(u, arrayCount, v);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kFloat2 || uni.fType == SkSLType::kHalf2);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
@@ -132,6 +218,10 @@ void GrGLProgramDataManager::set2fv(UniformHandle u,
 
 void GrGLProgramDataManager::set3i(UniformHandle u, int32_t i0, int32_t i1, int32_t i2) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set3i(u, i0, i1, i2);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kInt3 || uni.fType == SkSLType::kShort3);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
     if (kUnusedUniform != uni.fLocation) {
@@ -143,6 +233,10 @@ void GrGLProgramDataManager::set3iv(UniformHandle u,
                                     int arrayCount,
                                     const int32_t v[]) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set3iv(u, arrayCount, v);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kInt3 || uni.fType == SkSLType::kShort3);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
@@ -153,6 +247,10 @@ void GrGLProgramDataManager::set3iv(UniformHandle u,
 
 void GrGLProgramDataManager::set3f(UniformHandle u, float v0, float v1, float v2) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set3f(u, v0, v1, v2);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kFloat3 || uni.fType == SkSLType::kHalf3);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
     if (kUnusedUniform != uni.fLocation) {
@@ -164,6 +262,10 @@ void GrGLProgramDataManager::set3fv(UniformHandle u,
                                     int arrayCount,
                                     const float v[]) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set3fv(u, arrayCount, v);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kFloat3 || uni.fType == SkSLType::kHalf3);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
@@ -178,6 +280,10 @@ void GrGLProgramDataManager::set4i(UniformHandle u,
                                    int32_t i2,
                                    int32_t i3) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set4i(u, i0, i1, i2, i3);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kInt4 || uni.fType == SkSLType::kShort4);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
     if (kUnusedUniform != uni.fLocation) {
@@ -189,6 +295,10 @@ void GrGLProgramDataManager::set4iv(UniformHandle u,
                                     int arrayCount,
                                     const int32_t v[]) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set4iv(u, arrayCount, v);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kInt4 || uni.fType == SkSLType::kShort4);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
@@ -203,6 +313,10 @@ void GrGLProgramDataManager::set4f(UniformHandle u,
                                    float v2,
                                    float v3) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set4f(u, v0, v1, v2, v3);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kFloat4 || uni.fType == SkSLType::kHalf4);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
     if (kUnusedUniform != uni.fLocation) {
@@ -214,6 +328,10 @@ void GrGLProgramDataManager::set4fv(UniformHandle u,
                                     int arrayCount,
                                     const float v[]) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        fUniformBlock->set4fv(u, arrayCount, v);
+        return;
+    }
     SkASSERT(uni.fType == SkSLType::kFloat4 || uni.fType == SkSLType::kHalf4);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
@@ -252,6 +370,16 @@ template<int N> inline void GrGLProgramDataManager::setMatrices(UniformHandle u,
                                                                 int arrayCount,
                                                                 const float matrices[]) const {
     const Uniform& uni = fUniforms[u.toIndex()];
+    if (uni.fInBlock) {
+        if constexpr (N == 2) {
+            fUniformBlock->setMatrix2fv(u, arrayCount, matrices);
+        } else if constexpr (N == 3) {
+            fUniformBlock->setMatrix3fv(u, arrayCount, matrices);
+        } else {
+            fUniformBlock->setMatrix4fv(u, arrayCount, matrices);
+        }
+        return;
+    }
     SkASSERT(static_cast<int>(uni.fType) == static_cast<int>(SkSLType::kFloat2x2) + (N - 2) ||
              static_cast<int>(uni.fType) == static_cast<int>(SkSLType::kHalf2x2) + (N - 2));
     SkASSERT(arrayCount > 0);
@@ -16,6 +16,8 @@
 
 #include "include/private/base/SkTArray.h"
 
+#include <memory>
+
 class GrGLGpu;
 class SkMatrix;
 class GrGLProgram;
@@ -28,6 +30,9 @@ class GrGLProgramDataManager : public GrGLSLProgramDataManager {
 public:
     struct GLUniformInfo : public GrGLSLUniformHandler::UniformInfo {
         GrGLint fLocation;
+        // Offset of the uniform in the program's std140 uniform block, or -1 if the uniform is
+        // not part of the block and is set with glUniform* instead.
+        int32_t fBlockOffset = -1;
     };
 
     struct VaryingInfo {
@@ -41,7 +46,10 @@ public:
     typedef SkTBlockList<GLUniformInfo> UniformInfoArray;
     typedef SkTBlockList<VaryingInfo>   VaryingInfoArray;
 
-    GrGLProgramDataManager(GrGLGpu*, const UniformInfoArray&);
+    // A non-zero uniformBlockSize means the uniforms with a block offset are packed into a std140
+    // uniform buffer rather than set with glUniform*.
+    GrGLProgramDataManager(GrGLGpu*, const UniformInfoArray&, uint32_t uniformBlockSize);
+    ~GrGLProgramDataManager() override;
 
     void setSamplerUniforms(const UniformInfoArray& samplers, int startUnit) const;
 
@@ -73,13 +81,21 @@ public:
     void setMatrix3fv(UniformHandle, int arrayCount, const float matrices[]) const override;
     void setMatrix4fv(UniformHandle, int arrayCount, const float matrices[]) const override;
 
+    // Copies the uniform block to a new slice of the GPU's uniform ring buffer and binds it. This
+    // must be called for every draw that uses the program, since ring buffer slices can't be reused
+    // across submits. Returns false if the uniforms could not be uploaded.
+    bool uploadUniformBlock() const;
+
 private:
+    class UniformBlock;
+
     enum {
         kUnusedUniform = -1,
     };
 
     struct Uniform {
         GrGLint     fLocation;
+        bool        fInBlock;
 #ifdef SK_DEBUG
         SkSLType    fType;
         int         fArrayCount;
@@ -91,6 +107,7 @@ private:
 
     skia_private::TArray<Uniform, true> fUniforms;
     GrGLGpu* fGpu;
+    std::unique_ptr<UniformBlock> fUniformBlock;
 
     using INHERITED = GrGLSLProgramDataManager;
 };
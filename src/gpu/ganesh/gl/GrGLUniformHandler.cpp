@@ -7,6 +7,7 @@
 
 #include "src/gpu/ganesh/gl/GrGLUniformHandler.h"
 
+#include "include/private/base/SkAlign.h"
 #include "src/gpu/ganesh/GrTexture.h"
 #include "src/gpu/ganesh/GrUtil.h"
 #include "src/gpu/ganesh/gl/GrGLCaps.h"
@@ -17,6 +18,136 @@
 #define GL_CALL(X) GR_GL_CALL(this->glGpu()->glInterface(), X)
 #define GL_CALL_RET(R, X) GR_GL_CALL_RET(this->glGpu()->glInterface(), R, X)
 
+// Returns the std140 base alignment of a non-array uniform of the given type, minus one. Arrays and
+// matrix columns are always aligned to 16 bytes. These rules are from the OpenGL 4.5 spec, section
+// 7.6.2.2 "Standard Uniform Block Layout". Shorts are declared as 32 bit ints in GLSL.
+static uint32_t sksltype_to_std140_alignment_mask(SkSLType type) {
+    switch (type) {
+        case SkSLType::kShort:
+        case SkSLType::kUShort:
+        case SkSLType::kInt:
+        case SkSLType::kUInt:
+        case SkSLType::kHalf:
+        case SkSLType::kFloat:
+            return 0x3;
+        case SkSLType::kShort2:
+        case SkSLType::kUShort2:
+        case SkSLType::kInt2:
+        case SkSLType::kUInt2:
+        case SkSLType::kHalf2:
+        case SkSLType::kFloat2:
+            return 0x7;
+        case SkSLType::kShort3:
+        case SkSLType::kShort4:
+        case SkSLType::kUShort3:
+        case SkSLType::kUShort4:
+        case SkSLType::kInt3:
+        case SkSLType::kInt4:
+        case SkSLType::kUInt3:
+        case SkSLType::kUInt4:
+        case SkSLType::kHalf3:
+        case SkSLType::kFloat3:
+        case SkSLType::kHalf4:
+        case SkSLType::kFloat4:
+        case SkSLType::kHalf2x2:
+        case SkSLType::kFloat2x2:
+        case SkSLType::kHalf3x3:
+        case SkSLType::kFloat3x3:
+        case SkSLType::kHalf4x4:
+        case SkSLType::kFloat4x4:
+            return 0xF;
+
+        // This query is only valid for certain types.
+        case SkSLType::kVoid:
+        case SkSLType::kBool:
+        case SkSLType::kBool2:
+        case SkSLType::kBool3:
+        case SkSLType::kBool4:
+        case SkSLType::kTexture2DSampler:
+        case SkSLType::kTextureExternalSampler:
+        case SkSLType::kTexture2DRectSampler:
+        case SkSLType::kSampler:
+        case SkSLType::kTexture2D:
+        case SkSLType::kInput:
+            break;
+    }
+    SK_ABORT("Unexpected type");
+}
+
+// Returns the std140 size in bytes of a non-array uniform of the given type. Matrix columns are
+// padded to 16 bytes.
+static uint32_t sksltype_to_std140_size(SkSLType type) {
+    switch (type) {
+        case SkSLType::kShort:
+        case SkSLType::kUShort:
+        case SkSLType::kInt:
+        case SkSLType::kUInt:
+        case SkSLType::kHalf:
+        case SkSLType::kFloat:
+            return 4;
+        case SkSLType::kShort2:
+        case SkSLType::kUShort2:
+        case SkSLType::kInt2:
+        case SkSLType::kUInt2:
+        case SkSLType::kHalf2:
+        case SkSLType::kFloat2:
+            return 8;
+        case SkSLType::kShort3:
+        case SkSLType::kUShort3:
+        case SkSLType::kInt3:
+        case SkSLType::kUInt3:
+        case SkSLType::kHalf3:
+        case SkSLType::kFloat3:
+            return 12;
+        case SkSLType::kShort4:
+        case SkSLType::kUShort4:
+        case SkSLType::kInt4:
+        case SkSLType::kUInt4:
+        case SkSLType::kHalf4:
+        case SkSLType::kFloat4:
+            return 16;
+        case SkSLType::kHalf2x2:
+        case SkSLType::kFloat2x2:
+            return 32;
+        case SkSLType::kHalf3x3:
+        case SkSLType::kFloat3x3:
+            return 48;
+        case SkSLType::kHalf4x4:
+        case SkSLType::kFloat4x4:
+            return 64;
+
+        // This query is only valid for certain types.
+        case SkSLType::kVoid:
+        case SkSLType::kBool:
+        case SkSLType::kBool2:
+        case SkSLType::kBool3:
+        case SkSLType::kBool4:
+        case SkSLType::kTexture2DSampler:
+        case SkSLType::kTextureExternalSampler:
+        case SkSLType::kTexture2DRectSampler:
+        case SkSLType::kSampler:
+        case SkSLType::kTexture2D:
+        case SkSLType::kInput:
+            break;
+    }
+    SK_ABORT("Unexpected type");
+}
+
+// Given the current offset into the uniform block, returns the std140 offset of a uniform of the
+// given type and advances currentOffset past it.
+static uint32_t get_std140_offset(uint32_t* currentOffset, SkSLType type, int arrayCount) {
+    uint32_t alignmentMask = arrayCount ? 0xF : sksltype_to_std140_alignment_mask(type);
+    uint32_t offset = (*currentOffset + alignmentMask) & ~alignmentMask;
+    if (arrayCount) {
+        uint32_t elementSize = std::max<uint32_t>(16, sksltype_to_std140_size(type));
+        SkASSERT(0 == (elementSize & 0xF));
+        *currentOffset = offset + elementSize * arrayCount;
+    } else {
+        *currentOffset = offset + sksltype_to_std140_size(type);
+    }
+    return offset;
+}
+
 bool valid_name(const char* name) {
     // disallow unknown names that start with "sk_"
     if (!strncmp(name, GR_NO_MANGLE_PREFIX, strlen(GR_NO_MANGLE_PREFIX))) {
@@ -25,6 +156,13 @@ bool valid_name(const char* name) {
     return true;
 }
 
+GrGLUniformHandler::GrGLUniformHandler(GrGLSLProgramBuilder* program)
+        : INHERITED(program)
+        , fUniforms(kUniformsPerBlock)
+        , fSamplers(kUniformsPerBlock)
+        , fUseUniformBlock(
+                  static_cast<GrGLProgramBuilder*>(program)->gpu()->glCaps().uniformBufferSupport()) {}
+
 GrGLSLUniformHandler::UniformHandle GrGLUniformHandler::internalAddUniformArray(
                                                                    const GrProcessor* owner,
                                                                    uint32_t visibility,
@@ -49,16 +187,23 @@ GrGLSLUniformHandler::UniformHandle GrGLUniformHandler::internalAddUniformArray(
     }
     SkString resolvedName = fProgramBuilder->nameVariable(prefix, name, mangleName);
 
+    // Members of an interface block can't have a type modifier, so uniforms that may end up in the
+    // block get theirs when they're declared outside of it.
+    const bool blockCandidate = fUseUniformBlock && !fUniformDeclsAppended;
     GLUniformInfo tempInfo;
     tempInfo.fVariable = GrShaderVar{std::move(resolvedName),
                                      type,
-                                     GrShaderVar::TypeModifier::Uniform,
+                                     blockCandidate ? GrShaderVar::TypeModifier::None
+                                                    : GrShaderVar::TypeModifier::Uniform,
                                      arrayCount};
 
     tempInfo.fVisibility = visibility;
     tempInfo.fOwner      = owner;
     tempInfo.fRawName    = SkString(name);
     tempInfo.fLocation   = -1;
+    if (blockCandidate) {
+        tempInfo.fBlockOffset = get_std140_offset(&fCurrentBlockOffset, type, arrayCount);
+    }
 
     fUniforms.push_back(tempInfo);
 
@@ -98,12 +243,27 @@ GrGLSLUniformHandler::SamplerHandle GrGLUniformHandler::addSampler(
 }
 
 void GrGLUniformHandler::appendUniformDecls(GrShaderFlags visibility, SkString* out) const {
-    for (const UniformInfo& uniform : fUniforms.items()) {
-        if (uniform.fVisibility & visibility) {
-            uniform.fVariable.appendDecl(fProgramBuilder->shaderCaps(), out);
+    fUniformDeclsAppended = true;
+
+    SkString blockUniforms;
+    for (const GLUniformInfo& uniform : fUniforms.items()) {
+        if (this->inUniformBlock(uniform)) {
+            // GLSL requires a uniform block to be declared identically in every shader stage, so
+            // block uniforms are declared regardless of their visibility.
+            uniform.fVariable.appendDecl(fProgramBuilder->shaderCaps(), &blockUniforms);
+            blockUniforms.append(";\n");
+        } else if (uniform.fVisibility & visibility) {
+            // A block that turned out too large is declared as individual uniforms instead.
+            GrShaderVar variable = uniform.fVariable;
+            variable.setTypeModifier(GrShaderVar::TypeModifier::Uniform);
+            variable.appendDecl(fProgramBuilder->shaderCaps(), out);
             out->append(";");
         }
     }
+    if (!blockUniforms.isEmpty()) {
+        out->appendf("layout (std140) uniform %s\n{\n%s};\n",
+                     kUniformBlockName, blockUniforms.c_str());
+    }
     for (const UniformInfo& sampler : fSamplers.items()) {
         if (sampler.fVisibility & visibility) {
             sampler.fVariable.appendDecl(fProgramBuilder->shaderCaps(), out);
@@ -116,6 +276,9 @@ void GrGLUniformHandler::bindUniformLocations(GrGLuint programID, const GrGLCaps
     if (caps.bindUniformLocationSupport()) {
         int currUniform = 0;
         for (GLUniformInfo& uniform : fUniforms.items()) {
+            if (this->inUniformBlock(uniform)) {
+                continue;
+            }
             GL_CALL(BindUniformLocation(programID, currUniform, uniform.fVariable.c_str()));
             uniform.fLocation = currUniform;
             ++currUniform;
@@ -131,6 +294,9 @@ void GrGLUniformHandler::bindUniformLocations(GrGLuint programID, const GrGLCaps
 void GrGLUniformHandler::getUniformLocations(GrGLuint programID, const GrGLCaps& caps, bool force) {
     if (!caps.bindUniformLocationSupport() || force) {
         for (GLUniformInfo& uniform : fUniforms.items()) {
+            if (this->inUniformBlock(uniform)) {
+                continue;
+            }
             GrGLint location;
             GL_CALL_RET(location, GetUniformLocation(programID, uniform.fVariable.c_str()));
             uniform.fLocation = location;
@@ -141,6 +307,35 @@ void GrGLUniformHandler::getUniformLocations(GrGLuint programID, const GrGLCaps&
             sampler.fLocation = location;
         }
     }
+
+    // The block binding is not part of the program's source, so it has to be set even when the
+    // program came from a binary.
+    if (this->uniformBlockSize()) {
+        GrGLuint blockIndex;
+        GL_CALL_RET(blockIndex, GetUniformBlockIndex(programID, kUniformBlockName));
+        if (blockIndex != GR_GL_INVALID_INDEX) {
+            GL_CALL(UniformBlockBinding(programID, blockIndex, kUniformBlockBinding));
+        }
+    }
+}
+
+bool GrGLUniformHandler::hasUniformBlock(GrGLuint programID) const {
+    if (!this->uniformBlockSize()) {
+        return true;
+    }
+    GrGLuint blockIndex;
+    GL_CALL_RET(blockIndex, GetUniformBlockIndex(programID, kUniformBlockName));
+    return blockIndex != GR_GL_INVALID_INDEX;
+}
+
+bool GrGLUniformHandler::useUniformBlock() const {
+    return fUseUniformBlock && fCurrentBlockOffset > 0 &&
+           fCurrentBlockOffset <= this->glGpu()->glCaps().maxUniformBlockSize();
+}
+
+uint32_t GrGLUniformHandler::uniformBlockSize() const {
+    // The size of a std140 block is rounded up to the alignment of a vec4.
+    return this->useUniformBlock() ? SkAlignTo(fCurrentBlockOffset, 16) : 0;
 }
 
 const GrGLGpu* GrGLUniformHandler::glGpu() const {
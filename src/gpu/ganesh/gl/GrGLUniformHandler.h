@@ -19,6 +19,11 @@ class GrGLUniformHandler : public GrGLSLUniformHandler {
 public:
     static const int kUniformsPerBlock = 8;
 
+    // When GrGLCaps::uniformBufferSupport() is true, uniforms are declared in a single std140
+    // uniform block with this name that is bound to this uniform buffer binding point.
+    static constexpr char kUniformBlockName[] = "uniformBuffer";
+    static constexpr GrGLuint kUniformBlockBinding = 0;
+
     const GrShaderVar& getUniformVariable(UniformHandle u) const override {
         return fUniforms.item(u.toIndex()).fVariable;
     }
@@ -39,10 +44,7 @@ public:
     }
 
 private:
-    explicit GrGLUniformHandler(GrGLSLProgramBuilder* program)
-        : INHERITED(program)
-        , fUniforms(kUniformsPerBlock)
-        , fSamplers(kUniformsPerBlock) {}
+    explicit GrGLUniformHandler(GrGLSLProgramBuilder* program);
 
     UniformHandle internalAddUniformArray(const GrProcessor* owner,
                                           uint32_t visibility,
@@ -71,6 +73,13 @@ private:
     // Updates the loction of the Uniforms if we cannot bind uniform locations manually
     void getUniformLocations(GrGLuint programID, const GrGLCaps& caps, bool force);
 
+    // Returns false if this handler laid uniforms out in a block that the linked program doesn't
+    // declare, e.g. a program binary stored before uniform blocks were in use.
+    bool hasUniformBlock(GrGLuint programID) const;
+
+    // Returns the size of the uniform block, or 0 if the program doesn't use one.
+    uint32_t uniformBlockSize() const;
+
     const GrGLGpu* glGpu() const;
 
     typedef GrGLProgramDataManager::GLUniformInfo GLUniformInfo;
@@ -80,6 +89,18 @@ private:
     UniformInfoArray         fSamplers;
     skia_private::TArray<skgpu::Swizzle> fSamplerSwizzles;
 
+    // A block that is too large for the driver falls back to individual uniforms.
+    bool useUniformBlock() const;
+    bool inUniformBlock(const GLUniformInfo& uniform) const {
+        return uniform.fBlockOffset >= 0 && this->useUniformBlock();
+    }
+
+    bool fUseUniformBlock;
+    uint32_t fCurrentBlockOffset = 0;
+    // Uniforms added after the declarations are written (e.g. the RT flip uniform that SkSL
+    // declares itself) can't be part of the block.
+    mutable bool fUniformDeclsAppended = false;
+
     friend class GrGLProgramBuilder;
 
     using INHERITED = GrGLSLUniformHandler;
@@ -9,9 +9,11 @@
 
 #include "include/gpu/GrDirectContext.h"
 #include "src/base/SkAutoMalloc.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/core/SkWriteBuffer.h"
+#include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/PipelineUtils.h"
 #include "src/gpu/Swizzle.h"
 #include "src/gpu/ganesh/GrAutoLocaleSetter.h"
@@ -101,6 +103,7 @@ bool GrGLProgramBuilder::compileAndAttachShaders(const std::string& glsl,
                                                  bool shaderWasCached,
                                                  GrContextOptions::ShaderErrorHandler* errHandler) {
     GrGLGpu* gpu = this->gpu();
+    auto start = skgpu::StdSteadyClock::now();
     GrGLuint shaderId = GrGLCompileAndAttachShader(gpu->glContext(),
                                                    programId,
                                                    type,
@@ -108,6 +111,7 @@ bool GrGLProgramBuilder::compileAndAttachShaders(const std::string& glsl,
                                                    shaderWasCached,
                                                    gpu->pipelineBuilder()->stats(),
                                                    errHandler);
+    fCompileTimes.fDriver += skgpu::StdSteadyClock::now() - start;
     if (!shaderId) {
         return false;
     }
@@ -210,7 +214,8 @@ void GrGLProgramBuilder::storeShaderInCache(const SkSL::Program::Interface& inte
 }
 
 sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* precompiledProgram) {
-    TRACE_EVENT0("skia.shaders", TRACE_FUNC);
+    TRACE_EVENT1("skia.shaders", TRACE_FUNC, "key", SkChecksum::Hash32(this->desc().asKey(),
+                                                                         this->desc().keyLength()));
 
     // verify we can get a program id
     GrGLuint programID;
@@ -280,6 +285,7 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* pr
                     cached = false;
                     break;
                 }
+                auto start = skgpu::StdSteadyClock::now();
                 GL_CALL(ProgramBinary(programID, binaryFormat, const_cast<void*>(binary), length));
                 // Pass nullptr for the error handler. We don't want to treat this as a compile
                 // failure (we can still recover by compiling the program from source, below).
@@ -287,6 +293,12 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* pr
                 // events, and from the traffic to the persistent cache.
                 cached = GrGLCheckLinkStatus(fGpu, programID, /*shaderWasCached=*/true,
                                              /*errorHandler=*/nullptr, nullptr, nullptr);
+                fCompileTimes.fDriver += skgpu::StdSteadyClock::now() - start;
+                // A binary without the uniform block would draw with every uniform reading zero,
+                // so recompile it from source instead.
+                if (cached && !fUniformHandler.hasUniformBlock(programID)) {
+                    cached = false;
+                }
                 if (cached) {
                     this->addInputVars(interface);
                     this->computeCountsAndStrides(programID, geomProc, false);
@@ -298,6 +310,15 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* pr
             case kGLSL_Tag:
                 // Source cache hit, we don't need to compile the SkSL->GLSL
                 GrPersistentCacheUtils::UnpackCachedShaders(&reader, glsl, &interface, 1);
+                // Likewise for GLSL that was stored without the uniform block.
+                if (fUniformHandler.uniformBlockSize() &&
+                    glsl[kFragment_GrShaderType].find(GrGLUniformHandler::kUniformBlockName) ==
+                            std::string::npos) {
+                    for (std::string& shader : glsl) {
+                        shader.clear();
+                    }
+                    cached = false;
+                }
                 break;
 
             case kSKSL_Tag:
@@ -337,7 +358,8 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* pr
                                    settings,
                                    &glsl[kFragment_GrShaderType],
                                    &interface,
-                                   errorHandler)) {
+                                   errorHandler,
+                                   &fCompileTimes)) {
                 cleanup_program(fGpu, programID, shadersToDelete);
                 return nullptr;
             }
@@ -366,7 +388,8 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* pr
                                    settings,
                                    &glsl[kVertex_GrShaderType],
                                    &unusedInterface,
-                                   errorHandler)) {
+                                   errorHandler,
+                                   &fCompileTimes)) {
                 cleanup_program(fGpu, programID, shadersToDelete);
                 return nullptr;
             }
@@ -388,8 +411,11 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* pr
 
         {
             TRACE_EVENT0_ALWAYS("skia.shaders", "driver_link_program");
+            auto start = skgpu::StdSteadyClock::now();
             GL_CALL(LinkProgram(programID));
-            if (!GrGLCheckLinkStatus(fGpu, programID, cached, errorHandler, sksl, glsl)) {
+            bool linked = GrGLCheckLinkStatus(fGpu, programID, cached, errorHandler, sksl, glsl);
+            fCompileTimes.fDriver += skgpu::StdSteadyClock::now() - start;
+            if (!linked) {
                 cleanup_program(fGpu, programID, shadersToDelete);
                 return nullptr;
             }
@@ -412,6 +438,9 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* pr
         }
         this->storeShaderInCache(interface, programID, glsl, isSkSL, &settings);
     }
+    fGpu->addShaderCompileTiming(
+            *SkData::MakeWithoutCopy(this->desc().asKey(), this->desc().keyLength()),
+            fCompileTimes);
     return this->createProgram(programID);
 }
 
@@ -439,6 +468,7 @@ sk_sp<GrGLProgram> GrGLProgramBuilder::createProgram(GrGLuint programID) {
                              fUniformHandles,
                              programID,
                              fUniformHandler.fUniforms,
+                             fUniformHandler.uniformBlockSize(),
                              fUniformHandler.fSamplers,
                              std::move(fGPImpl),
                              std::move(fXPImpl),
@@ -9,6 +9,7 @@
 #define GrGLProgramBuilder_DEFINED
 
 #include "include/gpu/GrContextOptions.h"
+#include "src/gpu/PipelineUtils.h"
 #include "src/gpu/ganesh/GrPipeline.h"
 #include "src/gpu/ganesh/gl/GrGLProgram.h"
 #include "src/gpu/ganesh/gl/GrGLProgramDataManager.h"
@@ -101,6 +102,9 @@ private:
     // (all remaining bytes) char[] binary
     sk_sp<SkData> fCached;
 
+    // Reported to GrGpu::addShaderCompileTiming() once the program is built.
+    skgpu::ShaderCompileTimes fCompileTimes;
+
     using INHERITED = GrGLSLProgramBuilder;
 };
 #endif
@@ -41,9 +41,10 @@ inline bool SkSLToGLSL(const SkSL::ShaderCaps* caps,
                        const SkSL::ProgramSettings& settings,
                        std::string* glsl,
                        SkSL::ProgramInterface* outInterface,
-                       ShaderErrorHandler* errorHandler) {
+                       ShaderErrorHandler* errorHandler,
+                       ShaderCompileTimes* times = nullptr) {
     return SkSLToBackend(caps, &SkSL::ToGLSL, "GLSL",
-                         sksl, programKind, settings, glsl, outInterface, errorHandler);
+                         sksl, programKind, settings, glsl, outInterface, errorHandler, times);
 }
 
 }  // namespace skgpu
@@ -10,8 +10,10 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkPixelRef.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
@@ -19,6 +21,7 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkTextureCompressionType.h"
 #include "include/core/SkTypes.h"
 #include "include/core/SkYUVAInfo.h"
 #include "include/core/SkYUVAPixmaps.h"
@@ -35,6 +38,7 @@
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkBlurEngine.h"
 #include "src/core/SkCachedData.h"
+#include "src/core/SkCompressedDataUtils.h"
 #include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkSamplingPriv.h"
@@ -46,6 +50,7 @@
 #include "src/gpu/ganesh/GrBlurUtils.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrColorSpaceXform.h"
+#include "src/gpu/ganesh/GrDataUtils.h"
 #include "src/gpu/ganesh/GrFragmentProcessor.h"
 #include "src/gpu/ganesh/GrImageInfo.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
@@ -97,11 +102,96 @@ GrSurfaceProxyView CopyView(GrRecordingContext* context,
                                     /*label=*/label);
 }
 
+// Makes a BC1 compressed view of an opaque 8888 bitmap, finding it in or adding it to the resource
+// cache. Returns an empty view if the bitmap or the backend can't be used with BC1.
+static GrSurfaceProxyView make_cached_compressed_bitmap_view(GrRecordingContext* rContext,
+                                                             const SkBitmap& bitmap) {
+    static constexpr SkTextureCompressionType kType = SkTextureCompressionType::kBC1_RGB8_UNORM;
+
+    if (!bitmap.isOpaque()) {
+        return {};
+    }
+    switch (bitmap.colorType()) {
+        case kRGBA_8888_SkColorType:
+        case kBGRA_8888_SkColorType:
+        case kRGB_888x_SkColorType:
+            break;
+        default:
+            return {};
+    }
+    SkPixmap pixmap;
+    if (!bitmap.peekPixels(&pixmap)) {
+        return {};
+    }
+
+    GrProxyProvider* proxyProvider = rContext->priv().proxyProvider();
+    const GrCaps* caps = rContext->priv().caps();
+    GrBackendFormat format = caps->getBackendFormatFromCompressionType(kType);
+    if (!format.isValid() || !caps->isFormatTexturable(format, GrTextureType::k2D)) {
+        return {};
+    }
+
+    // The compressed texture must not be found by lookups for the uncompressed one (e.g. for
+    // color tables and gradients), so it lives in its own key domain.
+    static const skgpu::UniqueKey::Domain kDomain = skgpu::UniqueKey::GenerateDomain();
+    skgpu::UniqueKey key;
+    SkIRect subset = SkIRect::MakePtSize(bitmap.pixelRefOrigin(), bitmap.dimensions());
+    {
+        skgpu::UniqueKey::Builder builder(&key, kDomain, 5, "Compressed Image");
+        builder[0] = bitmap.pixelRef()->getGenerationID();
+        builder[1] = subset.fLeft;
+        builder[2] = subset.fTop;
+        builder[3] = subset.fRight;
+        builder[4] = subset.fBottom;
+    }
+
+    if (sk_sp<GrTextureProxy> proxy = proxyProvider->findOrCreateProxyByUniqueKey(key)) {
+        return GrSurfaceProxyView(std::move(proxy));
+    }
+
+    SkBitmap rgba;
+    if (pixmap.colorType() == kBGRA_8888_SkColorType) {
+        if (!rgba.tryAllocPixels(pixmap.info().makeColorType(kRGBA_8888_SkColorType)) ||
+            !pixmap.readPixels(rgba.pixmap())) {
+            return {};
+        }
+        pixmap = rgba.pixmap();
+    }
+
+    sk_sp<SkData> data = SkData::MakeUninitialized(GrNumBlocks(kType, pixmap.dimensions()) *
+                                                   SkCompressedBlockSize(kType));
+    GrCompressOpaqueBC1(pixmap, static_cast<char*>(data->writable_data()));
+
+    sk_sp<GrTextureProxy> proxy = proxyProvider->createCompressedTextureProxy(
+            pixmap.dimensions(),
+            skgpu::Budgeted::kYes,
+            skgpu::Mipmapped::kNo,
+            GrProtected::kNo,
+            kType,
+            std::move(data));
+    if (!proxy) {
+        return {};
+    }
+    auto listener = GrMakeUniqueKeyInvalidationListener(&key, proxyProvider->contextID());
+    bitmap.pixelRef()->addGenIDChangeListener(std::move(listener));
+    proxyProvider->assignUniqueKeyToProxy(key, proxy.get());
+    return GrSurfaceProxyView(std::move(proxy));
+}
+
 std::tuple<GrSurfaceProxyView, GrColorType> RasterAsView(GrRecordingContext* rContext,
                                                          const SkImage_Raster* raster,
                                                          skgpu::Mipmapped mipmapped,
                                                          GrImageTexGenPolicy policy) {
     if (policy == GrImageTexGenPolicy::kDraw) {
+        // BC1 textures can't have their mipmaps generated on the GPU, so only compress images
+        // that are drawn without them.
+        if (rContext->priv().options().fCompressOpaqueRasterImages &&
+            mipmapped == skgpu::Mipmapped::kNo && !raster->hasMipmaps()) {
+            if (GrSurfaceProxyView view =
+                        make_cached_compressed_bitmap_view(rContext, raster->bitmap())) {
+                return {std::move(view), GrColorType::kRGB_888x};
+            }
+        }
         // If the draw doesn't require mipmaps but this SkImage has them go ahead and make a
         // mipmapped texture. There are three reasons for this:
         // 1) Avoiding another texture creation if a later draw requires mipmaps.
@@ -730,14 +820,22 @@ namespace skif {
 namespace {
 
 class GaneshBackend : public Backend, private SkBlurEngine, private SkBlurEngine::Algorithm {
+    // Use the context's cache to reuse results across draws if it has one. Otherwise results are
+    // only shared within a single evaluation of the filter DAG.
+    static sk_sp<SkImageFilterCache> MakeCache(GrRecordingContext* context) {
+        if (sk_sp<SkImageFilterCache> cache = context->priv().imageFilterCache()) {
+            return cache;
+        }
+        return SkImageFilterCache::Create(SkImageFilterCache::kDefaultTransientSize);
+    }
+
 public:
 
     GaneshBackend(sk_sp<GrRecordingContext> context,
                   GrSurfaceOrigin origin,
                   const SkSurfaceProps& surfaceProps,
                   SkColorType colorType)
-            : Backend(SkImageFilterCache::Create(SkImageFilterCache::kDefaultTransientSize),
-                      surfaceProps, colorType)
+            : Backend(MakeCache(context.get()), surfaceProps, colorType)
             , fContext(std::move(context))
             , fOrigin(origin) {}
 
@@ -348,9 +348,9 @@ GrFPResult AtlasPathRenderer::makeAtlasClipEffect(const SurfaceDrawContext* sdc,
                                         : GrFPFailure(std::move(inputFP));
     }
 
-    auto fallbackAAType = (sdc->numSamples() > 1 || sdc->canUseDynamicMSAA()) ? GrAAType::kMSAA
-                                                                              : GrAAType::kCoverage;
-    if (!this->pathFitsInAtlas(pathDevBounds, fallbackAAType)) {
+    // Unlike a path draw, a clip that doesn't fit falls back to a stencil or SW mask, which costs
+    // an extra pass and breaks batching even when MSAA is available, so use the larger limit.
+    if (!this->pathFitsInAtlas(pathDevBounds, GrAAType::kCoverage)) {
         // The path is too big.
         return GrFPFailure(std::move(inputFP));
     }
@@ -38,8 +38,8 @@ public:
     //
     // Returns 'inputFP' wrapped in GrFPFailure() if the path was too large, or if the current atlas
     // is full and already used by either opBeingClipped or inputFP. (Currently, "too large" means
-    // larger than fMaxAtlasSize in either dimension, more than 256^2 total pixels, or more than
-    // 128^2 total pixels if the surfaceDrawContext supports MSAA or DMSAA.)
+    // larger than fMaxAtlasSize in either dimension, or more than 256^2 total pixels, even if the
+    // surfaceDrawContext supports MSAA or DMSAA.)
     //
     // Also returns GrFPFailure() if the view matrix has perspective.
     GrFPResult makeAtlasClipEffect(const skgpu::ganesh::SurfaceDrawContext*,
@@ -215,13 +215,17 @@ private:
             case MaskType::kColorBitmap:
                 return skgpu::MaskFormat::kARGB;
             case MaskType::kGrayscaleCoverage:
+                return skgpu::MaskFormat::kA8;
 #if !defined(SK_DISABLE_SDF_TEXT)
             case MaskType::kAliasedDistanceField:
             case MaskType::kGrayscaleDistanceField:
             case MaskType::kLCDDistanceField:
             case MaskType::kLCDBGRDistanceField:
+                // Multi-channel distance fields are stored in the color atlas.
+                return fDFGPFlags & kMultiChannel_DistanceFieldEffectFlag
+                               ? skgpu::MaskFormat::kARGB
+                               : skgpu::MaskFormat::kA8;
 #endif
-                return skgpu::MaskFormat::kA8;
         }
         // SkUNREACHABLE;
         return skgpu::MaskFormat::kA8;
@@ -265,7 +269,7 @@ private:
     int fNumGlyphs; // Sum of glyphs in each geometry's subrun
 
     // All combinable atlas ops have equal bit field values
-    uint32_t fDFGPFlags                    : 10; // Distance field properties
+    uint32_t fDFGPFlags                    : 11; // Distance field properties
     uint32_t fMaskType                     : 3;  // MaskType
     uint32_t fUsesLocalCoords              : 1;  // Filled in post processor analysis
     uint32_t fNeedsGlyphTransform          : 1;
@@ -273,7 +277,8 @@ private:
     uint32_t fUseGammaCorrectDistanceTable : 1;
     static_assert(kMaskTypeCount <= 8, "MaskType does not fit in 3 bits");
 #if !defined(SK_DISABLE_SDF_TEXT)
-    static_assert(kInvalid_DistanceFieldEffectFlag <= (1 << 9), "DFGP Flags do not fit in 10 bits");
+    static_assert(kInvalid_DistanceFieldEffectFlag <= (1 << 10),
+                  "DFGP Flags do not fit in 11 bits");
 #endif
 
     // Only needed for color emoji
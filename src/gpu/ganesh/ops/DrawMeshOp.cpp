@@ -9,16 +9,22 @@
 
 #include "include/core/SkData.h"
 #include "include/core/SkMesh.h"
+#include "include/private/base/SkMutex.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkAutoMalloc.h"
+#include "src/base/SkNoDestructor.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkMeshPriv.h"
 #include "src/core/SkRuntimeEffectPriv.h"
 #include "src/core/SkVerticesPriv.h"
 #include "src/gpu/BufferWriter.h"
 #include "src/gpu/KeyBuilder.h"
+#include "src/gpu/ResourceKey.h"
 #include "src/gpu/ganesh/GrGeometryProcessor.h"
 #include "src/gpu/ganesh/GrMeshBuffers.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
 #include "src/gpu/ganesh/GrProgramInfo.h"
+#include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/effects/GrTextureEffect.h"
 #include "src/gpu/ganesh/glsl/GrGLSLColorSpaceXformHelper.h"
 #include "src/gpu/ganesh/glsl/GrGLSLFragmentShaderBuilder.h"
@@ -592,6 +598,7 @@ public:
     MeshOp(GrProcessorSet*,
            const SkPMColor4f&,
            const SkMesh&,
+           GrDirectContext*,
            TArray<std::unique_ptr<GrFragmentProcessor>> children,
            GrAAType,
            sk_sp<GrColorSpaceXform>,
@@ -646,6 +653,11 @@ private:
 
     GrGeometryProcessor* makeGP(SkArenaAlloc*);
 
+    // Returns static vertex and index buffers holding the data of our one SkVertices if it has
+    // been drawn before, or null buffers if its data should be written for this draw.
+    std::tuple<sk_sp<const GrBuffer>, sk_sp<const GrBuffer>> findOrMakeVerticesBuffers(
+            GrMeshDrawTarget*) const;
+
     CombineResult onCombineIfPossible(GrOp* t, SkArenaAlloc*, const GrCaps&) override;
 
     /**
@@ -656,7 +668,7 @@ private:
     class Mesh {
     public:
         Mesh() = delete;
-        explicit Mesh(const SkMesh& mesh);
+        Mesh(const SkMesh& mesh, GrDirectContext*);
         Mesh(sk_sp<SkVertices>, const SkMatrix& viewMatrix);
         Mesh(const Mesh&) = delete;
         Mesh(Mesh&& m);
@@ -778,12 +790,21 @@ private:
     using INHERITED = GrMeshDrawOp;
 };
 
-MeshOp::Mesh::Mesh(const SkMesh& mesh) {
+MeshOp::Mesh::Mesh(const SkMesh& mesh, GrDirectContext* dc) {
     new (&fMeshData) MeshData();
     SkASSERT(mesh.vertexBuffer());
-    fMeshData.vb = sk_ref_sp(static_cast<SkMeshPriv::VB*>(mesh.vertexBuffer()));
-    if (mesh.indexBuffer()) {
-        fMeshData.ib = sk_ref_sp(static_cast<SkMeshPriv::IB*>(mesh.indexBuffer()));
+    auto* vb = static_cast<SkMeshPriv::VB*>(mesh.vertexBuffer());
+    if (auto gpuCopy = SkMeshPriv::GaneshCopyForDraw(dc, vb)) {
+        fMeshData.vb = std::move(gpuCopy);
+    } else {
+        fMeshData.vb = sk_ref_sp(vb);
+    }
+    if (auto* ib = static_cast<SkMeshPriv::IB*>(mesh.indexBuffer())) {
+        if (auto gpuCopy = SkMeshPriv::GaneshCopyForDraw(dc, ib)) {
+            fMeshData.ib = std::move(gpuCopy);
+        } else {
+            fMeshData.ib = sk_ref_sp(ib);
+        }
     }
     fMeshData.vcount  = mesh.vertexCount();
     fMeshData.voffset = mesh.vertexOffset();
@@ -861,6 +882,7 @@ void MeshOp::Mesh::writeVertices(skgpu::VertexWriter& writer,
 MeshOp::MeshOp(GrProcessorSet*                              processorSet,
                const SkPMColor4f&                           color,
                const SkMesh&                                mesh,
+               GrDirectContext*                             dc,
                TArray<std::unique_ptr<GrFragmentProcessor>> children,
                GrAAType                                     aaType,
                sk_sp<GrColorSpaceXform>                     colorSpaceXform,
@@ -871,7 +893,7 @@ MeshOp::MeshOp(GrProcessorSet*                              processorSet,
         , fColorSpaceXform(std::move(colorSpaceXform))
         , fColor(color)
         , fViewMatrix(viewMatrix) {
-    fMeshes.emplace_back(mesh);
+    fMeshes.emplace_back(mesh, dc);
 
     fSpecification = mesh.refSpec();
     fUniforms = SkRuntimeEffectPriv::TransformUniforms(
@@ -1057,12 +1079,82 @@ void MeshOp::onCreateProgramInfo(const GrCaps* caps,
                                              colorLoadOp);
 }
 
+// SkVertices are immutable, so when one is drawn again its data is kept in static GPU buffers,
+// keyed by its unique ID, rather than written to dynamic buffers for every draw. Returns whether
+// the vertices have been drawn before, remembering the most recently drawn few.
+static bool vertices_drawn_before(uint32_t verticesID) {
+    static SkMutex gMutex;
+    static SkNoDestructor<SkLRUCache<uint32_t, bool>> gDrawn(32);
+    SkAutoMutexExclusive lock(gMutex);
+    if (gDrawn->find(verticesID)) {
+        return true;
+    }
+    gDrawn->insert(verticesID, true);
+    return false;
+}
+
+static void make_vertices_buffer_key(uint32_t verticesID,
+                                     GrGpuBufferType type,
+                                     skgpu::UniqueKey* key) {
+    static const skgpu::UniqueKey::Domain kDomain = skgpu::UniqueKey::GenerateDomain();
+    skgpu::UniqueKey::Builder builder(key, kDomain, 2, "SkVertices Buffer");
+    builder[0] = verticesID;
+    builder[1] = static_cast<uint32_t>(type);
+}
+
+std::tuple<sk_sp<const GrBuffer>, sk_sp<const GrBuffer>> MeshOp::findOrMakeVerticesBuffers(
+        GrMeshDrawTarget* target) const {
+    SkASSERT(fMeshes.size() == 1 && fMeshes[0].isFromVertices());
+    const SkVertices* vertices = fMeshes[0].vertices();
+    if (!vertices_drawn_before(vertices->uniqueID())) {
+        return {};
+    }
+    GrResourceProvider* resourceProvider = target->resourceProvider();
+
+    skgpu::UniqueKey vertexKey;
+    make_vertices_buffer_key(vertices->uniqueID(), GrGpuBufferType::kVertex, &vertexKey);
+    sk_sp<const GrBuffer> vertexBuffer =
+            resourceProvider->findByUniqueKey<GrGpuBuffer>(vertexKey);
+    if (!vertexBuffer) {
+        size_t size = fSpecification->stride() * fVertexCount;
+        SkAutoMalloc storage(size);
+        skgpu::VertexWriter writer(storage.get(), size);
+        fMeshes[0].writeVertices(writer, *fSpecification, /*transform=*/false);
+        vertexBuffer = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kVertex, size, storage.get(), vertexKey);
+        if (!vertexBuffer) {
+            return {};
+        }
+    }
+
+    sk_sp<const GrBuffer> indexBuffer;
+    if (fIndexCount) {
+        skgpu::UniqueKey indexKey;
+        make_vertices_buffer_key(vertices->uniqueID(), GrGpuBufferType::kIndex, &indexKey);
+        indexBuffer = resourceProvider->findOrMakeStaticBuffer(GrGpuBufferType::kIndex,
+                                                               fIndexCount * sizeof(uint16_t),
+                                                               fMeshes[0].indices(),
+                                                               indexKey);
+        if (!indexBuffer) {
+            return {};
+        }
+    }
+    return {std::move(vertexBuffer), std::move(indexBuffer)};
+}
+
 void MeshOp::onPrepareDraws(GrMeshDrawTarget* target) {
     size_t vertexStride = fSpecification->stride();
     sk_sp<const GrBuffer> vertexBuffer;
     int firstVertex;
     std::tie(vertexBuffer, firstVertex) = fMeshes[0].gpuVB();
 
+    sk_sp<const GrBuffer> indexBuffer;
+    int firstIndex = 0;
+
+    if (fMeshes.size() == 1 && fMeshes[0].isFromVertices()) {
+        std::tie(vertexBuffer, indexBuffer) = this->findOrMakeVerticesBuffers(target);
+    }
+
     if (!vertexBuffer) {
         skgpu::VertexWriter verts = target->makeVertexWriter(vertexStride,
                                                              fVertexCount,
@@ -1083,10 +1175,9 @@ void MeshOp::onPrepareDraws(GrMeshDrawTarget* target) {
         firstVertex /= fSpecification->stride();
     }
 
-    sk_sp<const GrBuffer> indexBuffer;
-    int firstIndex = 0;
-
-    std::tie(indexBuffer, firstIndex) = fMeshes[0].gpuIB();
+    if (!indexBuffer) {
+        std::tie(indexBuffer, firstIndex) = fMeshes[0].gpuIB();
+    }
     if (fIndexCount && !indexBuffer) {
         uint16_t* indices = nullptr;
         indices = target->makeIndexSpace(fIndexCount, &indexBuffer, &firstIndex);
@@ -1239,6 +1330,7 @@ GrOp::Owner Make(GrRecordingContext* context,
     return GrSimpleMeshDrawOpHelper::FactoryHelper<MeshOp>(context,
                                                            std::move(paint),
                                                            mesh,
+                                                           context->asDirectContext(),
                                                            std::move(children),
                                                            aaType,
                                                            std::move(colorSpaceXform),
@@ -7,6 +7,7 @@
 
 #include "src/gpu/ganesh/ops/GrMeshDrawOp.h"
 
+#include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
 #include "src/gpu/ganesh/GrOpsRenderPass.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
@@ -14,7 +15,14 @@
 
 GrMeshDrawOp::GrMeshDrawOp(uint32_t classID) : INHERITED(classID) {}
 
-void GrMeshDrawOp::onPrepare(GrOpFlushState* state) { this->onPrepareDraws(state); }
+void GrMeshDrawOp::onPrepare(GrOpFlushState* state) {
+    this->onPrepareDraws(state);
+
+    // Ops that made their program while preparing let the GPU start compiling it now.
+    if (const GrProgramInfo* programInfo = this->programInfo()) {
+        state->gpu()->willBindProgram(*programInfo);
+    }
+}
 
 void GrMeshDrawOp::createProgramInfo(GrMeshDrawTarget* target) {
     this->createProgramInfo(&target->caps(),
@@ -7,6 +7,7 @@
 
 #include "src/gpu/ganesh/ops/OpsTask.h"
 
+#include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrRecordingContext.h"
 #include "src/base/SkScopeExit.h"
 #include "src/core/SkRectPriv.h"
@@ -14,7 +15,9 @@
 #include "src/gpu/ganesh/GrAttachment.h"
 #include "src/gpu/ganesh/GrAuditTrail.h"
 #include "src/gpu/ganesh/GrCaps.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrGpu.h"
+#include "src/gpu/ganesh/GrGpuOpTimer.h"
 #include "src/gpu/ganesh/GrMemoryPool.h"
 #include "src/gpu/ganesh/GrNativeRect.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
@@ -25,6 +28,7 @@
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/GrTexture.h"
 #include "src/gpu/ganesh/geometry/GrRect.h"
+#include "src/gpu/ganesh/ops/GrDrawOp.h"
 
 using namespace skia_private;
 
@@ -437,6 +441,9 @@ void OpsTask::addDrawOp(GrDrawingManager* drawingMgr, GrOp::Owner op, bool usesM
 
     op->visitProxies(addDependency);
     clip.visitProxies(addDependency);
+    if (clip.hasStencilClip() || static_cast<GrDrawOp*>(op.get())->usesStencil()) {
+        this->setUsesStencil();
+    }
     if (dstProxyView.proxy()) {
         if (!(dstProxyView.dstSampleFlags() & GrDstSampleFlags::kAsInputAttachment)) {
             this->addSampledTexture(dstProxyView.proxy());
@@ -453,6 +460,11 @@ void OpsTask::addDrawOp(GrDrawingManager* drawingMgr, GrOp::Owner op, bool usesM
         fRenderPassXferBarriers |= GrXferBarrierFlags::kBlend;
     }
 
+    // Draws recorded into a DDL are not counted; only their draw calls are, when it is replayed.
+    if (auto dContext = drawingMgr->getContext()->asDirectContext()) {
+        dContext->priv().getGpu()->counters()->add(skgpu::GpuCounter::kDrawsRecorded);
+    }
+
     this->recordOp(std::move(op), usesMSAA, processorAnalysis, clip.doesClip() ? &clip : nullptr,
                    &dstProxyView, caps);
 }
@@ -599,16 +611,30 @@ bool OpsTask::onExecute(GrOpFlushState* flushState) {
     }
 
     // NOTE: If fMustPreserveStencil is set, then we are executing a surfaceDrawContext that split
-    // its opsTask.
+    // its opsTask and a later task of this flush may read our stencil values. The drawing manager
+    // clears it again (see resolveStencilLiveness) when no later task actually does.
     //
-    // FIXME: We don't currently flag render passes that don't use stencil at all. In that case
-    // their store op might be "discard", and we currently make the assumption that a discard will
-    // not invalidate what's already in main memory. This is probably ok for now, but certainly
-    // something we want to address soon.
+    // FIXME: Render passes that don't use stencil at all might still store a "discard", and we
+    // currently make the assumption that a discard will not invalidate what's already in main
+    // memory. This is probably ok for now, but certainly something we want to address soon.
     GrStoreOp stencilStoreOp = (caps.discardStencilValuesAfterRenderPass() && !fMustPreserveStencil)
             ? GrStoreOp::kDiscard
             : GrStoreOp::kStore;
 
+    if (stencil) {
+        // Every stencil load or store that was avoided is a full attachment's worth of memory
+        // traffic on a tiler.
+        size_t stencilBytes = stencil->gpuMemorySize();
+        size_t bytesSaved = 0;
+        if (stencilLoadOp != GrLoadOp::kLoad) {
+            bytesSaved += stencilBytes;
+        }
+        if (stencilStoreOp == GrStoreOp::kDiscard) {
+            bytesSaved += stencilBytes;
+        }
+        flushState->gpu()->stats()->incAttachmentBytesSaved(bytesSaved);
+    }
+
     GrOpsRenderPass* renderPass = create_render_pass(flushState->gpu(),
                                                      proxy->peekRenderTarget(),
                                                      fUsesMSAASurface,
@@ -629,6 +655,7 @@ bool OpsTask::onExecute(GrOpFlushState* flushState) {
     renderPass->begin();
 
     GrSurfaceProxyView dstView(sk_ref_sp(this->target(0)), fTargetOrigin, fTargetSwizzle);
+    GrGpuOpTimer* opTimer = flushState->gpu()->opTimer();
 
     // Draw all the generated geometry.
     for (const auto& chain : fOpChains) {
@@ -645,7 +672,13 @@ bool OpsTask::onExecute(GrOpFlushState* flushState) {
                                       fColorLoadOp);
 
         flushState->setOpArgs(&opArgs);
+        if (opTimer) {
+            opTimer->beginOp(renderPass, chain.head()->name());
+        }
         chain.head()->execute(flushState, chain.bounds());
+        if (opTimer) {
+            opTimer->endOp(renderPass);
+        }
         flushState->setOpArgs(nullptr);
     }
 
@@ -726,6 +759,7 @@ int OpsTask::mergeFrom(SkSpan<const sk_sp<GrRenderTask>> tasks) {
             fInitialStencilContent = toMerge->fInitialStencilContent;
         }
         fUsesMSAASurface |= toMerge->fUsesMSAASurface;
+        fUsesStencil |= toMerge->fUsesStencil;
         SkDEBUGCODE(fNumClips += toMerge->fNumClips);
     }
 
@@ -754,6 +788,19 @@ int OpsTask::mergeFrom(SkSpan<const sk_sp<GrRenderTask>> tasks) {
     return mergedCount;
 }
 
+bool OpsTask::resolveStencilLiveness(bool nextTaskReadsStencil) {
+    if (!nextTaskReadsStencil) {
+        // The task that split from us never looks at the stencil, so there is nothing to preserve.
+        fMustPreserveStencil = false;
+    }
+    if (fInitialStencilContent == StencilContent::kPreserved && !fUsesStencil &&
+        !fMustPreserveStencil) {
+        // Neither our ops nor any later task read the preserved values. Don't load them.
+        fInitialStencilContent = StencilContent::kDontCare;
+    }
+    return fInitialStencilContent == StencilContent::kPreserved;
+}
+
 bool OpsTask::resetForFullscreenClear(CanDiscardPreviousOps canDiscardPreviousOps) {
     if (CanDiscardPreviousOps::kYes == canDiscardPreviousOps || this->isEmpty()) {
         this->deleteOps();
@@ -81,6 +81,17 @@ public:
 
     void discard();
 
+    // Called by the drawing manager once every task of a flush is known, walking the flush in
+    // reverse. 'nextTaskReadsStencil' tells whether the next opsTask of this flush that targets the
+    // same surface loads the stencil values this task leaves behind (callers must pass true when
+    // there is no such task, since a later flush may still read them). If nothing reads them, the
+    // stencil store is dropped, and if this task doesn't touch stencil itself, so is the load.
+    // Returns whether this task loads the stencil values left behind by the task before it.
+    //
+    // Only valid when caps.discardStencilValuesAfterRenderPass() is true, since kUserBitsCleared
+    // tasks must then clear the stencil rather than rely on previously stored values.
+    bool resolveStencilLiveness(bool nextTaskReadsStencil);
+
     enum class CanDiscardPreviousOps : bool {
         kYes = true,
         kNo = false
@@ -114,6 +125,10 @@ public:
     const char* name() const final { return "Ops"; }
     int numOpChains() const { return fOpChains.size(); }
     const GrOp* getChain(int index) const { return fOpChains[index].head(); }
+    bool mustPreserveStencil() const { return fMustPreserveStencil; }
+    bool loadsPreservedStencil() const {
+        return fInitialStencilContent == StencilContent::kPreserved;
+    }
 #endif
 
 protected:
@@ -155,6 +170,9 @@ private:
     // get preserved across its split tasks.
     void setMustPreserveStencil() { fMustPreserveStencil = true; }
 
+    // Notes that an op in this task reads or writes the stencil buffer.
+    void setUsesStencil() { fUsesStencil = true; }
+
     // Prevents this opsTask from merging backward. This is used by DMSAA when a non-multisampled
     // opsTask cannot be promoted to MSAA, or when we split a multisampled opsTask in order to
     // resolve its texture.
@@ -279,6 +297,7 @@ private:
     std::array<float, 4> fLoadClearColor = {0, 0, 0, 0};
     StencilContent fInitialStencilContent = StencilContent::kDontCare;
     bool fMustPreserveStencil = false;
+    bool fUsesStencil = false;
     bool fCannotMergeBackward = false;
 
     uint32_t fLastClipStackGenID = SK_InvalidUniqueID;
@@ -8,18 +8,24 @@
 
 #include "src/gpu/ganesh/ops/TriangulatingPathRenderer.h"
 
+#include "include/gpu/GrDirectContext.h"
 #include "include/private/SkIDChangeListener.h"
+#include "src/base/SkTLazy.h"
 #include "src/core/SkGeometry.h"
+#include "src/core/SkResourceCache.h"
 #include "src/gpu/ganesh/GrAuditTrail.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrDefaultGeoProcFactory.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrDrawOpTest.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
+#include "src/gpu/ganesh/GrGpu.h"
 #include "src/gpu/ganesh/GrOpFlushState.h"
 #include "src/gpu/ganesh/GrProgramInfo.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/GrResourceCache.h"
 #include "src/gpu/ganesh/GrResourceProvider.h"
+#include "src/gpu/ganesh/GrResourceProviderPriv.h"
 #include "src/gpu/ganesh/GrSimpleMesh.h"
 #include "src/gpu/ganesh/GrStyle.h"
 #include "src/gpu/ganesh/GrThreadSafeCache.h"
@@ -97,6 +103,66 @@ private:
     }
 };
 
+// With GrContextOptions::fShareTriangulatedPaths, triangulations are also kept in the process-wide
+// SkResourceCache. They are in the shape's own space and only depend on the tolerance, so every
+// context drawing the same shape can upload them instead of triangulating it again.
+static unsigned gSharedTriangulationKeyNamespaceLabel;
+
+struct SharedTriangulationKey : public SkResourceCache::Key {
+public:
+    static constexpr int kClipBoundsCnt = sizeof(SkIRect) / sizeof(uint32_t);
+    // Shapes with longer keys are small paths keyed by their points, which are cheap to
+    // triangulate again.
+    static constexpr int kMaxDataCnt = 64;
+
+    static bool Fits(const GrStyledShape& shape) {
+        return shape.unstyledKeySize() + kClipBoundsCnt <= kMaxDataCnt;
+    }
+
+    SharedTriangulationKey(const GrStyledShape& shape, const SkIRect& devClipBounds) {
+        SkASSERT(Fits(shape));
+        int shapeKeyDataCnt = shape.unstyledKeySize();
+        shape.writeUnstyledKey(fData);
+        // For inverse fills, the tessellation is dependent on clip bounds.
+        if (shape.inverseFilled()) {
+            memcpy(&fData[shapeKeyDataCnt], &devClipBounds, sizeof(devClipBounds));
+        } else {
+            memset(&fData[shapeKeyDataCnt], 0, sizeof(devClipBounds));
+        }
+        this->init(&gSharedTriangulationKeyNamespaceLabel, 0,
+                   (shapeKeyDataCnt + kClipBoundsCnt) * sizeof(uint32_t));
+    }
+
+    uint32_t fData[kMaxDataCnt];
+};
+
+struct SharedTriangulation {
+    sk_sp<SkData> fVertices;
+    int           fNumVertices;
+    size_t        fVertexSize;
+    sk_sp<SkData> fInfo;    // TessInfo
+};
+
+struct SharedTriangulationRec : public SkResourceCache::Rec {
+    SharedTriangulationRec(const SharedTriangulationKey& key, SharedTriangulation triangulation)
+            : fKey(key), fTriangulation(std::move(triangulation)) {}
+
+    SharedTriangulationKey fKey;
+    SharedTriangulation    fTriangulation;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fTriangulation.fVertices->size();
+    }
+    const char* getCategory() const override { return "triangulated-path"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const SharedTriangulationRec& rec = static_cast<const SharedTriangulationRec&>(baseRec);
+        *static_cast<SharedTriangulation*>(contextData) = rec.fTriangulation;
+        return true;
+    }
+};
+
 class StaticVertexAllocator : public GrEagerVertexAllocator {
 public:
     StaticVertexAllocator(GrResourceProvider* resourceProvider, bool canMapVB)
@@ -269,7 +335,8 @@ private:
                            const GrStyledShape& shape,
                            const SkIRect& devClipBounds,
                            SkScalar tol,
-                           bool* isLinear) {
+                           bool* isLinear,
+                           SkExecutor* executor) {
         SkRect clipBounds = SkRect::Make(devClipBounds);
 
         SkMatrix vmi;
@@ -282,7 +349,53 @@ private:
         SkPath path;
         shape.asPath(&path);
 
-        return GrTriangulator::PathToTriangles(path, tol, clipBounds, allocator, isLinear);
+        return GrTriangulator::PathToTriangles(path, tol, clipBounds, allocator, isLinear,
+                                               executor);
+    }
+
+    // Triangulates 'shape' into CPU memory, and sets 'info' to its TessInfo. If 'share' is set,
+    // looks for a matching triangulation from any context first, and shares the result with the
+    // others.
+    static sk_sp<GrThreadSafeCache::VertexData> TriangulateToCpu(const SkMatrix& viewMatrix,
+                                                                 const GrStyledShape& shape,
+                                                                 const SkIRect& devClipBounds,
+                                                                 SkScalar tol,
+                                                                 SkExecutor* executor,
+                                                                 bool share,
+                                                                 sk_sp<SkData>* info) {
+        SkTLazy<SharedTriangulationKey> sharedKey;
+        if (share && SharedTriangulationKey::Fits(shape)) {
+            sharedKey.init(shape, devClipBounds);
+            SharedTriangulation shared;
+            if (SkResourceCache::Find(*sharedKey, SharedTriangulationRec::Visitor, &shared) &&
+                cache_match(shared.fInfo.get(), tol)) {
+                // VertexData owns its vertices, so it gets a copy of the shared ones.
+                size_t size = shared.fVertices->size();
+                void* vertices = sk_malloc_throw(size);
+                memcpy(vertices, shared.fVertices->data(), size);
+                *info = std::move(shared.fInfo);
+                return GrThreadSafeCache::MakeVertexData(vertices, shared.fNumVertices,
+                                                         shared.fVertexSize);
+            }
+        }
+
+        GrCpuVertexAllocator allocator;
+        bool isLinear;
+        int vertexCount = Triangulate(&allocator, viewMatrix, shape, devClipBounds, tol,
+                                      &isLinear, executor);
+        if (vertexCount == 0) {
+            return nullptr;
+        }
+        sk_sp<GrThreadSafeCache::VertexData> vertexData = allocator.detachVertexData();
+        *info = create_data(vertexCount, isLinear, tol);
+
+        if (sharedKey.isValid()) {
+            SkResourceCache::Add(new SharedTriangulationRec(
+                    *sharedKey,
+                    {SkData::MakeWithCopy(vertexData->vertices(), vertexData->size()),
+                     vertexData->numVertices(), vertexData->vertexSize(), *info}));
+        }
+        return vertexData;
     }
 
     void createNonAAMesh(GrMeshDrawTarget* target) {
@@ -303,6 +416,29 @@ private:
             }
         }
 
+        const GrContextOptions& options = rp->priv().gpu()->getContext()->priv().options();
+        if (!fVertexData && options.fShareTriangulatedPaths) {
+            // Shared triangulations live in CPU memory, so this can't write straight into a mapped
+            // vertex buffer.
+            sk_sp<SkData> info;
+            fVertexData = TriangulateToCpu(fViewMatrix, fShape, fDevClipBounds, tol,
+                                           options.fExecutor, /*share=*/true, &info);
+            if (!fVertexData) {
+                return;
+            }
+            key.setCustomData(std::move(info));
+
+            auto [tmpV, tmpD] = threadSafeCache->addVertsWithData(key, fVertexData,
+                                                                  is_newer_better);
+            if (tmpV != fVertexData) {
+                SkASSERT(cache_match(tmpD.get(), tol));
+                fVertexData = std::move(tmpV);
+            } else {
+                fShape.addGenIDChangeListener(
+                        sk_make_sp<UniqueKeyInvalidator>(key, target->contextUniqueID()));
+            }
+        }
+
         if (fVertexData) {
             if (!fVertexData->gpuBuffer()) {
                 sk_sp<GrGpuBuffer> buffer = rp->createBuffer(fVertexData->vertices(),
@@ -327,7 +463,7 @@ private:
 
         bool isLinear;
         int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol,
-                                      &isLinear);
+                                      &isLinear, options.fExecutor);
         if (vertexCount == 0) {
             return;
         }
@@ -461,18 +597,15 @@ private:
             return;
         }
 
-        GrCpuVertexAllocator allocator;
-
-        bool isLinear;
-        int vertexCount = Triangulate(&allocator, fViewMatrix, fShape, fDevClipBounds, tol,
-                                      &isLinear);
-        if (vertexCount == 0) {
+        const GrContextOptions& options = rContext->priv().options();
+        sk_sp<SkData> info;
+        fVertexData = TriangulateToCpu(fViewMatrix, fShape, fDevClipBounds, tol,
+                                       options.fExecutor, options.fShareTriangulatedPaths, &info);
+        if (!fVertexData) {
             return;
         }
 
-        fVertexData = allocator.detachVertexData();
-
-        key.setCustomData(create_data(vertexCount, isLinear, tol));
+        key.setCustomData(std::move(info));
 
         // If some other thread created and cached its own triangulation, the 'is_newer_better'
         // predicate will replace the version in the cache if 'fVertexData' is a more accurate
@@ -10,6 +10,7 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkSpan.h"
 #include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTLogic.h"
 #include "src/base/SkAutoMalloc.h"
 #include "src/core/SkDistanceFieldGen.h"
@@ -55,6 +56,13 @@ bool GrAtlasManager::hasGlyph(MaskFormat format, Glyph* glyph) {
     return this->getAtlas(format)->hasID(glyph->fAtlasLocator.plotLocator());
 }
 
+bool GrAtlasManager::relocateGlyph(MaskFormat format,
+                                   Glyph* glyph,
+                                   GrDeferredUploadTarget* target) {
+    SkASSERT(glyph);
+    return this->getAtlas(format)->relocate(target, &glyph->fAtlasLocator);
+}
+
 template <typename INT_TYPE>
 static void expand_bits(INT_TYPE* dst,
                         const uint8_t* src,
@@ -301,13 +309,27 @@ std::tuple<bool, int> GlyphVector::regenerateAtlasForGanesh(
         // Update the atlas information in the GrStrike.
         auto tokenTracker = uploadTarget->tokenTracker();
         auto glyphs = fGlyphs.subspan(begin, end - begin);
+
+        // Fetch the images of all the glyphs missing from the atlas in one batch, which the
+        // strike may rasterize in parallel.
+        skia_private::STArray<64, SkPackedGlyphID> missingIDs;
+        for (const Variant& variant : glyphs) {
+            if (!atlasManager->hasGlyph(maskFormat, variant.glyph)) {
+                missingIDs.push_back(variant.glyph->fPackedID);
+            }
+        }
+        if (missingIDs.size() > 1) {
+            metricsAndImages.glyphs(missingIDs);
+        }
+
         int glyphsPlacedInAtlas = 0;
         bool success = true;
         for (const Variant& variant : glyphs) {
             Glyph* gpuGlyph = variant.glyph;
             SkASSERT(gpuGlyph != nullptr);
 
-            if (!atlasManager->hasGlyph(maskFormat, gpuGlyph)) {
+            if (!atlasManager->hasGlyph(maskFormat, gpuGlyph) &&
+                !atlasManager->relocateGlyph(maskFormat, gpuGlyph, uploadTarget)) {
                 const SkGlyph& skGlyph = *metricsAndImages.glyph(gpuGlyph->fPackedID);
                 auto code = atlasManager->addGlyphToAtlas(
                         skGlyph, gpuGlyph, srcPadding, target->resourceProvider(), uploadTarget);
@@ -66,6 +66,10 @@ public:
 
     bool hasGlyph(skgpu::MaskFormat, sktext::gpu::Glyph*);
 
+    // Returns true if the glyph's plot was moved by the atlas' compaction, in which case the
+    // glyph's locator now refers to its new position and it doesn't need to be added again.
+    bool relocateGlyph(skgpu::MaskFormat, sktext::gpu::Glyph*, GrDeferredUploadTarget*);
+
     GrDrawOpAtlas::ErrorCode addGlyphToAtlas(const SkGlyph&,
                                              sktext::gpu::Glyph*,
                                              int srcPadding,
@@ -402,6 +402,16 @@ void GrVkCaps::init(const GrContextOptions& contextOptions,
         fSupportsDeviceFaultInfo = true;
     }
 
+    auto pipelineLibraryFeatures = skgpu::GetExtensionFeatureStruct<
+            VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>(
+                    features,
+                    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT);
+    if (pipelineLibraryFeatures && pipelineLibraryFeatures->graphicsPipelineLibrary &&
+        extensions.hasExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME, 1) &&
+        extensions.hasExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME, 1)) {
+        fSupportsGraphicsPipelineLibrary = true;
+    }
+
     fMaxInputAttachmentDescriptors = properties.limits.maxDescriptorSetInputAttachments;
 
     fMaxSamplerAnisotropy = properties.limits.maxSamplerAnisotropy;
@@ -169,6 +169,10 @@ public:
 
     bool supportsDeviceFaultInfo() const { return fSupportsDeviceFaultInfo; }
 
+    // Returns true if VK_EXT_graphics_pipeline_library is enabled, so that the shader stages of
+    // pipelines can be compiled separately and linked.
+    bool supportsGraphicsPipelineLibrary() const { return fSupportsGraphicsPipelineLibrary; }
+
     // Returns whether we prefer to record draws directly into a primary command buffer.
     bool preferPrimaryOverSecondaryCommandBuffers() const {
         return fPreferPrimaryOverSecondaryCommandBuffers;
@@ -457,6 +461,8 @@ private:
 
     bool fSupportsDeviceFaultInfo = false;
 
+    bool fSupportsGraphicsPipelineLibrary = false;
+
     bool fPreferPrimaryOverSecondaryCommandBuffers = true;
     bool fMustInvalidatePrimaryCmdBufferStateAfterClearAttachments = false;
 
@@ -8,6 +8,7 @@
 #include "src/gpu/ganesh/vk/GrVkCommandBuffer.h"
 
 #include "include/core/SkRect.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/ganesh/vk/GrVkBuffer.h"
 #include "src/gpu/ganesh/vk/GrVkCommandPool.h"
@@ -21,6 +22,8 @@
 #include "src/gpu/ganesh/vk/GrVkRenderTarget.h"
 #include "src/gpu/ganesh/vk/GrVkUtil.h"
 
+#include <array>
+
 using namespace skia_private;
 
 void GrVkCommandBuffer::invalidateState() {
@@ -170,10 +173,20 @@ void GrVkCommandBuffer::submitPipelineBarriers(const GrVkGpu* gpu, bool forSelfD
         }
 
         VkDependencyFlags dependencyFlags = fBarriersByRegion ? VK_DEPENDENCY_BY_REGION_BIT : 0;
-        GR_VK_CALL(gpu->vkInterface(), CmdPipelineBarrier(
-                fCmdBuffer, fSrcStageMask, fDstStageMask, dependencyFlags, 0, nullptr,
-                fBufferBarriers.size(), fBufferBarriers.begin(),
-                fImageBarriers.size(), fImageBarriers.begin()));
+        VkPipelineStageFlags srcStageMask = fSrcStageMask;
+        VkPipelineStageFlags dstStageMask = fDstStageMask;
+        uint32_t bufferBarrierCount = fBufferBarriers.size();
+        const VkBufferMemoryBarrier* bufferBarriers =
+                this->copyForDeferral(fBufferBarriers.begin(), fBufferBarriers.size());
+        uint32_t imageBarrierCount = fImageBarriers.size();
+        const VkImageMemoryBarrier* imageBarriers =
+                this->copyForDeferral(fImageBarriers.begin(), fImageBarriers.size());
+        this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(vk, CmdPipelineBarrier(
+                    cmdBuffer, srcStageMask, dstStageMask, dependencyFlags, 0, nullptr,
+                    bufferBarrierCount, bufferBarriers,
+                    imageBarrierCount, imageBarriers));
+        });
         fBufferBarriers.clear();
         fImageBarriers.clear();
         fBarriersByRegion = false;
@@ -195,12 +208,10 @@ void GrVkCommandBuffer::bindInputBuffer(GrVkGpu* gpu, uint32_t binding,
     // TODO: once vbuffer->offset() no longer always returns 0, we will need to track the offset
     // to know if we can skip binding or not.
     if (vkBuffer != fBoundInputBuffers[binding]) {
-        VkDeviceSize offset = 0;
-        GR_VK_CALL(gpu->vkInterface(), CmdBindVertexBuffers(fCmdBuffer,
-                                                            binding,
-                                                            1,
-                                                            &vkBuffer,
-                                                            &offset));
+        this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+            VkDeviceSize offset = 0;
+            GR_VK_CALL(vk, CmdBindVertexBuffers(cmdBuffer, binding, 1, &vkBuffer, &offset));
+        });
         fBoundInputBuffers[binding] = vkBuffer;
         this->addGrBuffer(std::move(buffer));
     }
@@ -212,9 +223,10 @@ void GrVkCommandBuffer::bindIndexBuffer(GrVkGpu* gpu, sk_sp<const GrBuffer> buff
     // TODO: once ibuffer->offset() no longer always returns 0, we will need to track the offset
     // to know if we can skip binding or not.
     if (vkBuffer != fBoundIndexBuffer) {
-        GR_VK_CALL(gpu->vkInterface(), CmdBindIndexBuffer(fCmdBuffer,
-                                                          vkBuffer, /*offset=*/0,
-                                                          VK_INDEX_TYPE_UINT16));
+        this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(vk, CmdBindIndexBuffer(cmdBuffer, vkBuffer, /*offset=*/0,
+                                              VK_INDEX_TYPE_UINT16));
+        });
         fBoundIndexBuffer = vkBuffer;
         this->addGrBuffer(std::move(buffer));
     }
@@ -241,11 +253,15 @@ void GrVkCommandBuffer::clearAttachments(const GrVkGpu* gpu,
         }
     }
 #endif
-    GR_VK_CALL(gpu->vkInterface(), CmdClearAttachments(fCmdBuffer,
-                                                       numAttachments,
-                                                       attachments,
-                                                       numRects,
-                                                       clearRects));
+    attachments = this->copyForDeferral(attachments, numAttachments);
+    clearRects = this->copyForDeferral(clearRects, numRects);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdClearAttachments(cmdBuffer,
+                                           numAttachments,
+                                           attachments,
+                                           numRects,
+                                           clearRects));
+    });
     if (gpu->vkCaps().mustInvalidatePrimaryCmdBufferStateAfterClearAttachments()) {
         this->invalidateState();
     }
@@ -259,21 +275,26 @@ void GrVkCommandBuffer::bindDescriptorSets(const GrVkGpu* gpu,
                                            uint32_t dynamicOffsetCount,
                                            const uint32_t* dynamicOffsets) {
     SkASSERT(fIsActive);
-    GR_VK_CALL(gpu->vkInterface(), CmdBindDescriptorSets(fCmdBuffer,
-                                                         VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                         layout,
-                                                         firstSet,
-                                                         setCount,
-                                                         descriptorSets,
-                                                         dynamicOffsetCount,
-                                                         dynamicOffsets));
+    descriptorSets = this->copyForDeferral(descriptorSets, setCount);
+    dynamicOffsets = this->copyForDeferral(dynamicOffsets, dynamicOffsetCount);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdBindDescriptorSets(cmdBuffer,
+                                             VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                             layout,
+                                             firstSet,
+                                             setCount,
+                                             descriptorSets,
+                                             dynamicOffsetCount,
+                                             dynamicOffsets));
+    });
 }
 
 void GrVkCommandBuffer::bindPipeline(const GrVkGpu* gpu, sk_sp<const GrVkPipeline> pipeline) {
     SkASSERT(fIsActive);
-    GR_VK_CALL(gpu->vkInterface(), CmdBindPipeline(fCmdBuffer,
-                                                   VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                   pipeline->pipeline()));
+    VkPipeline vkPipeline = pipeline->pipeline();
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipeline));
+    });
     this->addResource(std::move(pipeline));
 }
 
@@ -284,12 +305,10 @@ void GrVkCommandBuffer::pushConstants(const GrVkGpu* gpu, VkPipelineLayout layou
     // offset and size must be a multiple of 4
     SkASSERT(!SkToBool(offset & 0x3));
     SkASSERT(!SkToBool(size & 0x3));
-    GR_VK_CALL(gpu->vkInterface(), CmdPushConstants(fCmdBuffer,
-                                                    layout,
-                                                    stageFlags,
-                                                    offset,
-                                                    size,
-                                                    values));
+    values = this->copyForDeferral(static_cast<const uint8_t*>(values), size);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdPushConstants(cmdBuffer, layout, stageFlags, offset, size, values));
+    });
 }
 
 void GrVkCommandBuffer::drawIndexed(const GrVkGpu* gpu,
@@ -301,12 +320,14 @@ void GrVkCommandBuffer::drawIndexed(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(fActiveRenderPass);
     this->addingWork(gpu);
-    GR_VK_CALL(gpu->vkInterface(), CmdDrawIndexed(fCmdBuffer,
-                                                  indexCount,
-                                                  instanceCount,
-                                                  firstIndex,
-                                                  vertexOffset,
-                                                  firstInstance));
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdDrawIndexed(cmdBuffer,
+                                      indexCount,
+                                      instanceCount,
+                                      firstIndex,
+                                      vertexOffset,
+                                      firstInstance));
+    });
 }
 
 void GrVkCommandBuffer::draw(const GrVkGpu* gpu,
@@ -317,11 +338,9 @@ void GrVkCommandBuffer::draw(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(fActiveRenderPass);
     this->addingWork(gpu);
-    GR_VK_CALL(gpu->vkInterface(), CmdDraw(fCmdBuffer,
-                                           vertexCount,
-                                           instanceCount,
-                                           firstVertex,
-                                           firstInstance));
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdDraw(cmdBuffer, vertexCount, instanceCount, firstVertex, firstInstance));
+    });
 }
 
 void GrVkCommandBuffer::drawIndirect(const GrVkGpu* gpu,
@@ -334,11 +353,9 @@ void GrVkCommandBuffer::drawIndirect(const GrVkGpu* gpu,
     SkASSERT(!indirectBuffer->isCpuBuffer());
     this->addingWork(gpu);
     VkBuffer vkBuffer = static_cast<const GrVkBuffer*>(indirectBuffer.get())->vkBuffer();
-    GR_VK_CALL(gpu->vkInterface(), CmdDrawIndirect(fCmdBuffer,
-                                                   vkBuffer,
-                                                   offset,
-                                                   drawCount,
-                                                   stride));
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdDrawIndirect(cmdBuffer, vkBuffer, offset, drawCount, stride));
+    });
     this->addGrBuffer(std::move(indirectBuffer));
 }
 
@@ -352,11 +369,9 @@ void GrVkCommandBuffer::drawIndexedIndirect(const GrVkGpu* gpu,
     SkASSERT(!indirectBuffer->isCpuBuffer());
     this->addingWork(gpu);
     VkBuffer vkBuffer = static_cast<const GrVkBuffer*>(indirectBuffer.get())->vkBuffer();
-    GR_VK_CALL(gpu->vkInterface(), CmdDrawIndexedIndirect(fCmdBuffer,
-                                                          vkBuffer,
-                                                          offset,
-                                                          drawCount,
-                                                          stride));
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdDrawIndexedIndirect(cmdBuffer, vkBuffer, offset, drawCount, stride));
+    });
     this->addGrBuffer(std::move(indirectBuffer));
 }
 
@@ -367,10 +382,10 @@ void GrVkCommandBuffer::setViewport(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(1 == viewportCount);
     if (0 != memcmp(viewports, &fCachedViewport, sizeof(VkViewport))) {
-        GR_VK_CALL(gpu->vkInterface(), CmdSetViewport(fCmdBuffer,
-                                                      firstViewport,
-                                                      viewportCount,
-                                                      viewports));
+        VkViewport viewport = viewports[0];
+        this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(vk, CmdSetViewport(cmdBuffer, firstViewport, 1, &viewport));
+        });
         fCachedViewport = viewports[0];
     }
 }
@@ -382,10 +397,10 @@ void GrVkCommandBuffer::setScissor(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(1 == scissorCount);
     if (0 != memcmp(scissors, &fCachedScissor, sizeof(VkRect2D))) {
-        GR_VK_CALL(gpu->vkInterface(), CmdSetScissor(fCmdBuffer,
-                                                     firstScissor,
-                                                     scissorCount,
-                                                     scissors));
+        VkRect2D scissor = scissors[0];
+        this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(vk, CmdSetScissor(cmdBuffer, firstScissor, 1, &scissor));
+        });
         fCachedScissor = scissors[0];
     }
 }
@@ -394,8 +409,12 @@ void GrVkCommandBuffer::setBlendConstants(const GrVkGpu* gpu,
                                           const float blendConstants[4]) {
     SkASSERT(fIsActive);
     if (0 != memcmp(blendConstants, fCachedBlendConstant, 4 * sizeof(float))) {
-        GR_VK_CALL(gpu->vkInterface(), CmdSetBlendConstants(fCmdBuffer, blendConstants));
         memcpy(fCachedBlendConstant, blendConstants, 4 * sizeof(float));
+        std::array<float, 4> constants;
+        memcpy(constants.data(), blendConstants, 4 * sizeof(float));
+        this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(vk, CmdSetBlendConstants(cmdBuffer, constants.data()));
+        });
     }
 }
 
@@ -456,7 +475,23 @@ void GrVkPrimaryCommandBuffer::end(GrVkGpu* gpu, bool abandoningBuffer) {
     // delete it, so we just skip the vulkan API calls and update our own state tracking.
     if (!abandoningBuffer) {
         this->submitPipelineBarriers(gpu);
+    }
+
+    if (fDeferredCommands) {
+        // The secondary command buffers recorded in parallel must be done before the commands
+        // after them can be recorded, and before they are freed.
+        SkASSERT(gpu->parallelRecordingTaskGroup());
+        gpu->parallelRecordingTaskGroup()->wait();
+        for (const auto& secondary : fSecondaryCommandBuffers) {
+            gpu->checkVkResult(secondary->fParallelRecordingResult);
+        }
+        if (!abandoningBuffer) {
+            fDeferredCommands->replay(gpu->vkInterface(), fCmdBuffer);
+        }
+        fDeferredCommands.reset();
+    }
 
+    if (!abandoningBuffer) {
         GR_VK_CALL_ERRCHECK(gpu, EndCommandBuffer(fCmdBuffer));
     }
     this->invalidateState();
@@ -490,12 +525,14 @@ bool GrVkPrimaryCommandBuffer::beginRenderPass(GrVkGpu* gpu,
     beginInfo.framebuffer = framebuffer->framebuffer();
     beginInfo.renderArea = renderArea;
     beginInfo.clearValueCount = renderPass->clearValueCount();
-    beginInfo.pClearValues = clearValues;
+    beginInfo.pClearValues = this->copyForDeferral(clearValues, beginInfo.clearValueCount);
 
     VkSubpassContents contents = forSecondaryCB ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
                                                 : VK_SUBPASS_CONTENTS_INLINE;
 
-    GR_VK_CALL(gpu->vkInterface(), CmdBeginRenderPass(fCmdBuffer, &beginInfo, contents));
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdBeginRenderPass(cmdBuffer, &beginInfo, contents));
+    });
     fActiveRenderPass = renderPass;
     this->addResource(renderPass);
     this->addResource(std::move(framebuffer));
@@ -507,7 +544,9 @@ void GrVkPrimaryCommandBuffer::endRenderPass(const GrVkGpu* gpu) {
     SkASSERT(fIsActive);
     SkASSERT(fActiveRenderPass);
     this->addingWork(gpu);
-    GR_VK_CALL(gpu->vkInterface(), CmdEndRenderPass(fCmdBuffer));
+    this->record(gpu, [](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdEndRenderPass(cmdBuffer));
+    });
     fActiveRenderPass = nullptr;
 }
 
@@ -517,7 +556,9 @@ void GrVkPrimaryCommandBuffer::nexSubpass(GrVkGpu* gpu, bool forSecondaryCB) {
     SkASSERT(fActiveRenderPass);
     VkSubpassContents contents = forSecondaryCB ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
                                                 : VK_SUBPASS_CONTENTS_INLINE;
-    GR_VK_CALL(gpu->vkInterface(), CmdNextSubpass(fCmdBuffer, contents));
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdNextSubpass(cmdBuffer, contents));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::executeCommands(const GrVkGpu* gpu,
@@ -532,7 +573,21 @@ void GrVkPrimaryCommandBuffer::executeCommands(const GrVkGpu* gpu,
 
     this->addingWork(gpu);
 
-    GR_VK_CALL(gpu->vkInterface(), CmdExecuteCommands(fCmdBuffer, 1, &buffer->fCmdBuffer));
+    if (buffer->isRecordedInParallel()) {
+        SkASSERT(gpu->parallelRecordingTaskGroup());
+        GrVkSecondaryCommandBuffer* secondary = buffer.get();
+        gpu->parallelRecordingTaskGroup()->add([gpu, secondary] {
+            secondary->recordDeferredCommands(gpu);
+        });
+        if (!fDeferredCommands) {
+            fDeferredCommands = std::make_unique<DeferredCommands>();
+        }
+    }
+
+    VkCommandBuffer secondaryCmdBuffer = buffer->fCmdBuffer;
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdExecuteCommands(cmdBuffer, 1, &secondaryCmdBuffer));
+    });
     fSecondaryCommandBuffers.push_back(std::move(buffer));
     // When executing a secondary command buffer all state (besides render pass state) becomes
     // invalidated and must be reset. This includes bound buffers, pipelines, dynamic state, etc.
@@ -715,13 +770,18 @@ void GrVkPrimaryCommandBuffer::copyImage(const GrVkGpu* gpu,
     this->addingWork(gpu);
     this->addResource(srcImage->resource());
     this->addResource(dstImage->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyImage(fCmdBuffer,
-                                                srcImage->image(),
-                                                srcLayout,
-                                                dstImage->image(),
-                                                dstLayout,
-                                                copyRegionCount,
-                                                copyRegions));
+    VkImage srcVkImage = srcImage->image();
+    VkImage dstVkImage = dstImage->image();
+    copyRegions = this->copyForDeferral(copyRegions, copyRegionCount);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdCopyImage(cmdBuffer,
+                                    srcVkImage,
+                                    srcLayout,
+                                    dstVkImage,
+                                    dstLayout,
+                                    copyRegionCount,
+                                    copyRegions));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::blitImage(const GrVkGpu* gpu,
@@ -739,14 +799,17 @@ void GrVkPrimaryCommandBuffer::blitImage(const GrVkGpu* gpu,
     this->addingWork(gpu);
     this->addResource(srcResource);
     this->addResource(dstResource);
-    GR_VK_CALL(gpu->vkInterface(), CmdBlitImage(fCmdBuffer,
-                                                srcImage,
-                                                srcLayout,
-                                                dstImage,
-                                                dstLayout,
-                                                blitRegionCount,
-                                                blitRegions,
-                                                filter));
+    blitRegions = this->copyForDeferral(blitRegions, blitRegionCount);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdBlitImage(cmdBuffer,
+                                    srcImage,
+                                    srcLayout,
+                                    dstImage,
+                                    dstLayout,
+                                    blitRegionCount,
+                                    blitRegions,
+                                    filter));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::blitImage(const GrVkGpu* gpu,
@@ -778,12 +841,17 @@ void GrVkPrimaryCommandBuffer::copyImageToBuffer(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addingWork(gpu);
     GrVkBuffer* vkBuffer = static_cast<GrVkBuffer*>(dstBuffer.get());
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyImageToBuffer(fCmdBuffer,
-                                                        srcImage->image(),
-                                                        srcLayout,
-                                                        vkBuffer->vkBuffer(),
-                                                        copyRegionCount,
-                                                        copyRegions));
+    VkImage srcVkImage = srcImage->image();
+    VkBuffer dstVkBuffer = vkBuffer->vkBuffer();
+    copyRegions = this->copyForDeferral(copyRegions, copyRegionCount);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdCopyImageToBuffer(cmdBuffer,
+                                            srcVkImage,
+                                            srcLayout,
+                                            dstVkBuffer,
+                                            copyRegionCount,
+                                            copyRegions));
+    });
     this->addResource(srcImage->resource());
     this->addGrBuffer(std::move(dstBuffer));
 }
@@ -798,12 +866,16 @@ void GrVkPrimaryCommandBuffer::copyBufferToImage(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addingWork(gpu);
 
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyBufferToImage(fCmdBuffer,
-                                                        srcBuffer,
-                                                        dstImage->image(),
-                                                        dstLayout,
-                                                        copyRegionCount,
-                                                        copyRegions));
+    VkImage dstVkImage = dstImage->image();
+    copyRegions = this->copyForDeferral(copyRegions, copyRegionCount);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdCopyBufferToImage(cmdBuffer,
+                                            srcBuffer,
+                                            dstVkImage,
+                                            dstLayout,
+                                            copyRegionCount,
+                                            copyRegions));
+    });
     this->addResource(dstImage->resource());
 }
 
@@ -818,11 +890,10 @@ void GrVkPrimaryCommandBuffer::fillBuffer(GrVkGpu* gpu,
 
     const GrVkBuffer* bufferVk = static_cast<GrVkBuffer*>(buffer.get());
 
-    GR_VK_CALL(gpu->vkInterface(), CmdFillBuffer(fCmdBuffer,
-                                                 bufferVk->vkBuffer(),
-                                                 offset,
-                                                 size,
-                                                 data));
+    VkBuffer vkBuffer = bufferVk->vkBuffer();
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdFillBuffer(cmdBuffer, vkBuffer, offset, size, data));
+    });
     this->addGrBuffer(std::move(buffer));
 }
 
@@ -848,11 +919,12 @@ void GrVkPrimaryCommandBuffer::copyBuffer(GrVkGpu* gpu,
     const GrVkBuffer* srcVk = static_cast<GrVkBuffer*>(srcBuffer.get());
     const GrVkBuffer* dstVk = static_cast<GrVkBuffer*>(dstBuffer.get());
 
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyBuffer(fCmdBuffer,
-                                                 srcVk->vkBuffer(),
-                                                 dstVk->vkBuffer(),
-                                                 regionCount,
-                                                 regions));
+    VkBuffer srcVkBuffer = srcVk->vkBuffer();
+    VkBuffer dstVkBuffer = dstVk->vkBuffer();
+    regions = this->copyForDeferral(regions, regionCount);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdCopyBuffer(cmdBuffer, srcVkBuffer, dstVkBuffer, regionCount, regions));
+    });
     this->addGrBuffer(std::move(srcBuffer));
     this->addGrBuffer(std::move(dstBuffer));
 }
@@ -869,10 +941,12 @@ void GrVkPrimaryCommandBuffer::updateBuffer(GrVkGpu* gpu,
     SkASSERT(dataSize <= 65536);
     SkASSERT(0 == (dataSize & 0x03));  // four byte aligned
     this->addingWork(gpu);
-    GR_VK_CALL(
-            gpu->vkInterface(),
-            CmdUpdateBuffer(
-                    fCmdBuffer, dstBuffer->vkBuffer(), dstOffset, dataSize, (const uint32_t*)data));
+    VkBuffer dstVkBuffer = dstBuffer->vkBuffer();
+    data = this->copyForDeferral(static_cast<const uint32_t*>(data), dataSize / 4);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdUpdateBuffer(cmdBuffer, dstVkBuffer, dstOffset, dataSize,
+                                       (const uint32_t*)data));
+    });
     this->addGrBuffer(std::move(dstBuffer));
 }
 
@@ -885,12 +959,18 @@ void GrVkPrimaryCommandBuffer::clearColorImage(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addingWork(gpu);
     this->addResource(image->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdClearColorImage(fCmdBuffer,
-                                                      image->image(),
-                                                      image->currentLayout(),
-                                                      color,
-                                                      subRangeCount,
-                                                      subRanges));
+    VkImage vkImage = image->image();
+    VkImageLayout layout = image->currentLayout();
+    color = this->copyForDeferral(color, 1);
+    subRanges = this->copyForDeferral(subRanges, subRangeCount);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdClearColorImage(cmdBuffer,
+                                          vkImage,
+                                          layout,
+                                          color,
+                                          subRangeCount,
+                                          subRanges));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::clearDepthStencilImage(const GrVkGpu* gpu,
@@ -902,12 +982,18 @@ void GrVkPrimaryCommandBuffer::clearDepthStencilImage(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addingWork(gpu);
     this->addResource(image->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdClearDepthStencilImage(fCmdBuffer,
-                                                             image->image(),
-                                                             image->currentLayout(),
-                                                             color,
-                                                             subRangeCount,
-                                                             subRanges));
+    VkImage vkImage = image->image();
+    VkImageLayout layout = image->currentLayout();
+    color = this->copyForDeferral(color, 1);
+    subRanges = this->copyForDeferral(subRanges, subRangeCount);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdClearDepthStencilImage(cmdBuffer,
+                                                 vkImage,
+                                                 layout,
+                                                 color,
+                                                 subRangeCount,
+                                                 subRanges));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::resolveImage(GrVkGpu* gpu,
@@ -922,13 +1008,20 @@ void GrVkPrimaryCommandBuffer::resolveImage(GrVkGpu* gpu,
     this->addResource(srcImage.resource());
     this->addResource(dstImage.resource());
 
-    GR_VK_CALL(gpu->vkInterface(), CmdResolveImage(fCmdBuffer,
-                                                   srcImage.image(),
-                                                   srcImage.currentLayout(),
-                                                   dstImage.image(),
-                                                   dstImage.currentLayout(),
-                                                   regionCount,
-                                                   regions));
+    VkImage srcVkImage = srcImage.image();
+    VkImageLayout srcLayout = srcImage.currentLayout();
+    VkImage dstVkImage = dstImage.image();
+    VkImageLayout dstLayout = dstImage.currentLayout();
+    regions = this->copyForDeferral(regions, regionCount);
+    this->record(gpu, [=](const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(vk, CmdResolveImage(cmdBuffer,
+                                       srcVkImage,
+                                       srcLayout,
+                                       dstVkImage,
+                                       dstLayout,
+                                       regionCount,
+                                       regions));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::onFreeGPUData(const GrVkGpu* gpu) const {
@@ -944,13 +1037,11 @@ void GrVkPrimaryCommandBuffer::onFreeGPUData(const GrVkGpu* gpu) const {
 // SecondaryCommandBuffer
 ////////////////////////////////////////////////////////////////////////////////
 
-GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::Create(GrVkGpu* gpu,
-                                                               GrVkCommandPool* cmdPool) {
-    SkASSERT(cmdPool);
+static VkCommandBuffer allocate_secondary_command_buffer(GrVkGpu* gpu, VkCommandPool cmdPool) {
     const VkCommandBufferAllocateInfo cmdInfo = {
         VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,   // sType
         nullptr,                                          // pNext
-        cmdPool->vkCommandPool(),                         // commandPool
+        cmdPool,                                          // commandPool
         VK_COMMAND_BUFFER_LEVEL_SECONDARY,                // level
         1                                                 // bufferCount
     };
@@ -959,11 +1050,33 @@ GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::Create(GrVkGpu* gpu,
     VkResult err;
     GR_VK_CALL_RESULT(gpu, err, AllocateCommandBuffers(gpu->device(), &cmdInfo, &cmdBuffer));
     if (err) {
+        return VK_NULL_HANDLE;
+    }
+    return cmdBuffer;
+}
+
+GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::Create(GrVkGpu* gpu,
+                                                               GrVkCommandPool* cmdPool) {
+    SkASSERT(cmdPool);
+    VkCommandBuffer cmdBuffer = allocate_secondary_command_buffer(gpu, cmdPool->vkCommandPool());
+    if (cmdBuffer == VK_NULL_HANDLE) {
         return nullptr;
     }
     return new GrVkSecondaryCommandBuffer(cmdBuffer, /*externalRenderPass=*/nullptr);
 }
 
+GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::CreateParallel(GrVkGpu* gpu,
+                                                                       VkCommandPool cmdPool,
+                                                                       int parallelPoolIndex) {
+    SkASSERT(parallelPoolIndex >= 0);
+    VkCommandBuffer cmdBuffer = allocate_secondary_command_buffer(gpu, cmdPool);
+    if (cmdBuffer == VK_NULL_HANDLE) {
+        return nullptr;
+    }
+    return new GrVkSecondaryCommandBuffer(cmdBuffer, /*externalRenderPass=*/nullptr,
+                                          parallelPoolIndex);
+}
+
 GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::Create(
         VkCommandBuffer cmdBuffer, const GrVkRenderPass* externalRenderPass) {
     return new GrVkSecondaryCommandBuffer(cmdBuffer, externalRenderPass);
@@ -987,6 +1100,13 @@ void GrVkSecondaryCommandBuffer::begin(GrVkGpu* gpu, const GrVkFramebuffer* fram
     inheritanceInfo.queryFlags = 0;
     inheritanceInfo.pipelineStatistics = 0;
 
+    if (this->isRecordedInParallel()) {
+        fInheritanceInfo = inheritanceInfo;
+        fDeferredCommands = std::make_unique<DeferredCommands>();
+        fIsActive = true;
+        return;
+    }
+
     VkCommandBufferBeginInfo cmdBufferBeginInfo;
     memset(&cmdBufferBeginInfo, 0, sizeof(VkCommandBufferBeginInfo));
     cmdBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -1003,13 +1123,40 @@ void GrVkSecondaryCommandBuffer::begin(GrVkGpu* gpu, const GrVkFramebuffer* fram
 void GrVkSecondaryCommandBuffer::end(GrVkGpu* gpu) {
     SkASSERT(fIsActive);
     SkASSERT(!this->isWrapped());
-    GR_VK_CALL_ERRCHECK(gpu, EndCommandBuffer(fCmdBuffer));
+    // A command buffer recorded in parallel keeps its commands until it is executed.
+    if (!this->isRecordedInParallel()) {
+        GR_VK_CALL_ERRCHECK(gpu, EndCommandBuffer(fCmdBuffer));
+    }
     this->invalidateState();
     fHasWork = false;
     fIsActive = false;
 }
 
+void GrVkSecondaryCommandBuffer::recordDeferredCommands(const GrVkGpu* gpu) {
+    TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+    SkASSERT(fDeferredCommands);
+    VkCommandBufferBeginInfo cmdBufferBeginInfo;
+    memset(&cmdBufferBeginInfo, 0, sizeof(VkCommandBufferBeginInfo));
+    cmdBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    cmdBufferBeginInfo.pNext = nullptr;
+    cmdBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    cmdBufferBeginInfo.pInheritanceInfo = &fInheritanceInfo;
+
+    // The results can't be checked on this thread; the primary command buffer checks them once
+    // this is done.
+    fParallelRecordingResult =
+            GR_VK_CALL(gpu->vkInterface(), BeginCommandBuffer(fCmdBuffer, &cmdBufferBeginInfo));
+    if (fParallelRecordingResult == VK_SUCCESS) {
+        fDeferredCommands->replay(gpu->vkInterface(), fCmdBuffer);
+        fParallelRecordingResult = GR_VK_CALL(gpu->vkInterface(), EndCommandBuffer(fCmdBuffer));
+    }
+    fDeferredCommands.reset();
+}
+
 void GrVkSecondaryCommandBuffer::recycle(GrVkCommandPool* cmdPool) {
+    // Drops the commands of a buffer recorded in parallel that was never executed.
+    fDeferredCommands.reset();
     if (this->isWrapped()) {
         delete this;
     } else {
@@ -9,12 +9,18 @@
 #define GrVkCommandBuffer_DEFINED
 
 #include "include/gpu/vk/GrVkTypes.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/gpu/GpuRefCnt.h"
 #include "src/gpu/ganesh/GrManagedResource.h"
 #include "src/gpu/ganesh/vk/GrVkGpu.h"
 #include "src/gpu/ganesh/vk/GrVkSemaphore.h"
 #include "src/gpu/ganesh/vk/GrVkUtil.h"
 
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
 class GrVkFramebuffer;
 class GrVkImage;
 class GrVkPipeline;
@@ -153,6 +159,75 @@ protected:
 
     void addingWork(const GrVkGpu* gpu);
 
+    // Vulkan commands saved to be recorded into a command buffer later, possibly on another
+    // thread.
+    class DeferredCommands {
+    public:
+        template <typename Command>
+        void add(Command&& command) {
+            Node* node = fArena.make<CommandNode<std::decay_t<Command>>>(
+                    std::forward<Command>(command));
+            *fTail = node;
+            fTail = &node->fNext;
+        }
+
+        // Returns a copy of 'data' that lives as long as the commands.
+        template <typename T>
+        const T* copy(const T* data, size_t count) {
+            static_assert(std::is_trivially_copyable<T>::value);
+            if (!count) {
+                return nullptr;
+            }
+            T* copy = fArena.makeArrayDefault<T>(count);
+            memcpy(copy, data, count * sizeof(T));
+            return copy;
+        }
+
+        void replay(const skgpu::VulkanInterface* vk, VkCommandBuffer cmdBuffer) const {
+            for (const Node* node = fHead; node; node = node->fNext) {
+                node->execute(vk, cmdBuffer);
+            }
+        }
+
+    private:
+        struct Node {
+            virtual ~Node() = default;
+            virtual void execute(const skgpu::VulkanInterface*, VkCommandBuffer) const = 0;
+            Node* fNext = nullptr;
+        };
+
+        template <typename Command>
+        struct CommandNode final : Node {
+            explicit CommandNode(Command command) : fCommand(std::move(command)) {}
+            void execute(const skgpu::VulkanInterface* vk,
+                         VkCommandBuffer cmdBuffer) const override {
+                fCommand(vk, cmdBuffer);
+            }
+            Command fCommand;
+        };
+
+        SkSTArenaAlloc<4096> fArena;
+        Node* fHead = nullptr;
+        Node** fTail = &fHead;
+    };
+
+    // Records a Vulkan command into fCmdBuffer, or saves it in fDeferredCommands if that is set.
+    // Deferred commands may be recorded on another thread, so 'command' must only capture values
+    // and pointers returned by copyForDeferral().
+    template <typename Command>
+    void record(const GrVkGpu* gpu, Command&& command) {
+        if (fDeferredCommands) {
+            fDeferredCommands->add(std::forward<Command>(command));
+        } else {
+            command(gpu->vkInterface(), fCmdBuffer);
+        }
+    }
+
+    template <typename T>
+    const T* copyForDeferral(const T* data, size_t count) {
+        return fDeferredCommands ? fDeferredCommands->copy(data, count) : data;
+    }
+
     void submitPipelineBarriers(const GrVkGpu* gpu, bool forSelfDependency = false);
 
 private:
@@ -178,6 +253,8 @@ protected:
 
     VkCommandBuffer           fCmdBuffer;
 
+    std::unique_ptr<DeferredCommands> fDeferredCommands;
+
     virtual void onReleaseResources() {}
     virtual void onFreeGPUData(const GrVkGpu* gpu) const = 0;
 
@@ -227,7 +304,9 @@ public:
 
     // Submits the SecondaryCommandBuffer into this command buffer. It is required that we are
     // currently inside a render pass that is compatible with the one used to create the
-    // SecondaryCommandBuffer.
+    // SecondaryCommandBuffer. If the SecondaryCommandBuffer is recorded in parallel, this starts
+    // recording it, and all commands added to this command buffer afterwards are deferred until
+    // end() waits for it.
     void executeCommands(const GrVkGpu* gpu,
                          std::unique_ptr<GrVkSecondaryCommandBuffer> secondaryBuffer);
 
@@ -346,6 +425,12 @@ private:
 class GrVkSecondaryCommandBuffer : public GrVkCommandBuffer {
 public:
     static GrVkSecondaryCommandBuffer* Create(GrVkGpu* gpu, GrVkCommandPool* cmdPool);
+    // Creates a command buffer that is recorded in parallel. It must be the only command buffer
+    // allocated from 'cmdPool' that is recording at a time; 'parallelPoolIndex' identifies the
+    // pool to GrVkCommandPool.
+    static GrVkSecondaryCommandBuffer* CreateParallel(GrVkGpu* gpu,
+                                                      VkCommandPool cmdPool,
+                                                      int parallelPoolIndex);
     // Used for wrapping an external secondary command buffer.
     static GrVkSecondaryCommandBuffer* Create(VkCommandBuffer externalSecondaryCB,
                                               const GrVkRenderPass* externalRenderPass);
@@ -356,17 +441,40 @@ public:
 
     void recycle(GrVkCommandPool* cmdPool);
 
-    VkCommandBuffer vkCommandBuffer() { return fCmdBuffer; }
+    // A command buffer that is recorded in parallel only saves the commands added between begin()
+    // and end(). They are recorded into the VkCommandBuffer on a worker thread once it is executed
+    // in a primary command buffer.
+    bool isRecordedInParallel() const { return fParallelPoolIndex >= 0; }
+    int parallelPoolIndex() const { return fParallelPoolIndex; }
+
+    // Callers that record into the VkCommandBuffer themselves can't use a command buffer that is
+    // recorded in parallel.
+    VkCommandBuffer vkCommandBuffer() {
+        SkASSERT(!this->isRecordedInParallel());
+        return fCmdBuffer;
+    }
 
 private:
     explicit GrVkSecondaryCommandBuffer(VkCommandBuffer cmdBuffer,
-                                        const GrVkRenderPass* externalRenderPass)
-            : INHERITED(cmdBuffer, SkToBool(externalRenderPass)) {
+                                        const GrVkRenderPass* externalRenderPass,
+                                        int parallelPoolIndex = -1)
+            : INHERITED(cmdBuffer, SkToBool(externalRenderPass))
+            , fParallelPoolIndex(parallelPoolIndex) {
         fActiveRenderPass = externalRenderPass;
     }
 
     void onFreeGPUData(const GrVkGpu* gpu) const override {}
 
+    // Records the deferred commands into the VkCommandBuffer. Called on a worker thread, so this
+    // only uses the device and interface of 'gpu'.
+    void recordDeferredCommands(const GrVkGpu* gpu);
+
+    const int fParallelPoolIndex;
+    // The inheritance info of begin(), saved for recordDeferredCommands().
+    VkCommandBufferInheritanceInfo fInheritanceInfo;
+    // The result of recordDeferredCommands(), which the primary command buffer checks.
+    VkResult fParallelRecordingResult = VK_SUCCESS;
+
     // Used for accessing fIsActive (on GrVkCommandBuffer)
     friend class GrVkPrimaryCommandBuffer;
 
@@ -12,7 +12,7 @@
 #include "src/gpu/ganesh/vk/GrVkCommandBuffer.h"
 #include "src/gpu/ganesh/vk/GrVkGpu.h"
 
-GrVkCommandPool* GrVkCommandPool::Create(GrVkGpu* gpu) {
+VkCommandPool GrVkCommandPool::CreateVkCommandPool(GrVkGpu* gpu) {
     VkCommandPoolCreateFlags cmdPoolCreateFlags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
     if (gpu->protectedContext()) {
         cmdPoolCreateFlags |= VK_COMMAND_POOL_CREATE_PROTECTED_BIT;
@@ -28,6 +28,14 @@ GrVkCommandPool* GrVkCommandPool::Create(GrVkGpu* gpu) {
     VkCommandPool pool;
     GR_VK_CALL_RESULT(gpu, result, CreateCommandPool(gpu->device(), &cmdPoolInfo, nullptr, &pool));
     if (result != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+    return pool;
+}
+
+GrVkCommandPool* GrVkCommandPool::Create(GrVkGpu* gpu) {
+    VkCommandPool pool = CreateVkCommandPool(gpu);
+    if (pool == VK_NULL_HANDLE) {
         return nullptr;
     }
 
@@ -61,8 +69,37 @@ std::unique_ptr<GrVkSecondaryCommandBuffer> GrVkCommandPool::findOrCreateSeconda
     return result;
 }
 
+std::unique_ptr<GrVkSecondaryCommandBuffer>
+GrVkCommandPool::findOrCreateParallelSecondaryCommandBuffer(GrVkGpu* gpu) {
+    if (fNextParallelPool == fParallelPools.size()) {
+        VkCommandPool pool = CreateVkCommandPool(gpu);
+        if (pool == VK_NULL_HANDLE) {
+            return nullptr;
+        }
+        fParallelPools.push_back({pool, nullptr});
+    }
+    int index = fNextParallelPool;
+    ParallelPool& parallelPool = fParallelPools[index];
+    std::unique_ptr<GrVkSecondaryCommandBuffer> result = std::move(parallelPool.fAvailableBuffer);
+    if (!result) {
+        result.reset(GrVkSecondaryCommandBuffer::CreateParallel(gpu, parallelPool.fCommandPool,
+                                                                index));
+        if (!result) {
+            return nullptr;
+        }
+    }
+    ++fNextParallelPool;
+    return result;
+}
+
 void GrVkCommandPool::recycleSecondaryCommandBuffer(GrVkSecondaryCommandBuffer* buffer) {
     std::unique_ptr<GrVkSecondaryCommandBuffer> scb(buffer);
+    if (buffer->isRecordedInParallel()) {
+        ParallelPool& parallelPool = fParallelPools[buffer->parallelPoolIndex()];
+        SkASSERT(!parallelPool.fAvailableBuffer);
+        parallelPool.fAvailableBuffer = std::move(scb);
+        return;
+    }
     if (fAvailableSecondaryBuffers.size() < fMaxCachedSecondaryCommandBuffers) {
         fAvailableSecondaryBuffers.push_back(std::move(scb));
     } else {
@@ -85,6 +122,14 @@ void GrVkCommandPool::reset(GrVkGpu* gpu) {
     SkDEBUGCODE(VkResult result = )GR_VK_CALL(gpu->vkInterface(),
                                               ResetCommandPool(gpu->device(), fCommandPool, 0));
     SkASSERT(result == VK_SUCCESS || result == VK_ERROR_DEVICE_LOST);
+    for (const ParallelPool& parallelPool : fParallelPools) {
+        SkDEBUGCODE(result = )GR_VK_CALL(gpu->vkInterface(),
+                                         ResetCommandPool(gpu->device(),
+                                                          parallelPool.fCommandPool,
+                                                          0));
+        SkASSERT(result == VK_SUCCESS || result == VK_ERROR_DEVICE_LOST);
+    }
+    fNextParallelPool = 0;
 
     // It should be safe to release the resources before actually resetting the VkCommandPool.
     // However, on qualcomm devices running R drivers there was a few months period where the driver
@@ -116,6 +161,13 @@ void GrVkCommandPool::freeGPUData() const {
     for (const auto& buffer : fAvailableSecondaryBuffers) {
         buffer->freeGPUData(fGpu, fCommandPool);
     }
+    for (const ParallelPool& parallelPool : fParallelPools) {
+        if (parallelPool.fAvailableBuffer) {
+            parallelPool.fAvailableBuffer->freeGPUData(fGpu, parallelPool.fCommandPool);
+        }
+        GR_VK_CALL(fGpu->vkInterface(),
+                   DestroyCommandPool(fGpu->device(), parallelPool.fCommandPool, nullptr));
+    }
     if (fCommandPool != VK_NULL_HANDLE) {
         GR_VK_CALL(fGpu->vkInterface(),
                    DestroyCommandPool(fGpu->device(), fCommandPool, nullptr));
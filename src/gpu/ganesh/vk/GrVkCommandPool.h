@@ -8,11 +8,13 @@
 #ifndef GrVkCommandPool_DEFINED
 #define GrVkCommandPool_DEFINED
 
+#include "include/private/base/SkTArray.h"
 #include "src/gpu/ganesh/vk/GrVkManagedResource.h"
 #include "src/gpu/ganesh/vk/GrVkResourceProvider.h"
 #include "src/gpu/vk/VulkanInterface.h"
 
 #include <cinttypes>
+#include <memory>
 
 class GrVkPrimaryCommandBuffer;
 class GrVkSecondaryCommandBuffer;
@@ -33,6 +35,13 @@ public:
 
     std::unique_ptr<GrVkSecondaryCommandBuffer> findOrCreateSecondaryCommandBuffer(GrVkGpu* gpu);
 
+    // Returns a secondary command buffer whose commands are recorded on a worker thread when it is
+    // executed (see GrVkSecondaryCommandBuffer::CreateParallel). Each buffer returned until the
+    // next reset() is allocated from its own VkCommandPool, since a pool may only be used by one
+    // thread at a time.
+    std::unique_ptr<GrVkSecondaryCommandBuffer> findOrCreateParallelSecondaryCommandBuffer(
+            GrVkGpu* gpu);
+
     void recycleSecondaryCommandBuffer(GrVkSecondaryCommandBuffer* buffer);
 
     // marks that we are finished with this command pool; it is not legal to continue creating or
@@ -54,6 +63,8 @@ private:
 
     GrVkCommandPool(GrVkGpu* gpu, VkCommandPool commandPool, GrVkPrimaryCommandBuffer*);
 
+    static VkCommandPool CreateVkCommandPool(GrVkGpu* gpu);
+
     void releaseResources();
 
     void freeGPUData() const override;
@@ -68,6 +79,15 @@ private:
     skia_private::STArray<4,
         std::unique_ptr<GrVkSecondaryCommandBuffer>, true> fAvailableSecondaryBuffers;
     int fMaxCachedSecondaryCommandBuffers;
+
+    // The pools that the parallel secondary command buffers are allocated from. Each keeps the one
+    // buffer it was created for while that buffer isn't in use.
+    struct ParallelPool {
+        VkCommandPool fCommandPool;
+        std::unique_ptr<GrVkSecondaryCommandBuffer> fAvailableBuffer;
+    };
+    skia_private::TArray<ParallelPool> fParallelPools;
+    int fNextParallelPool = 0;
 };
 
 #endif
@@ -20,6 +20,7 @@
 #include "src/base/SkRectMemcpy.h"
 #include "src/core/SkCompressedDataUtils.h"
 #include "src/core/SkMipmap.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/ganesh/GrBackendUtils.h"
 #include "src/gpu/ganesh/GrDataUtils.h"
@@ -247,6 +248,11 @@ GrVkGpu::GrVkGpu(GrDirectContext* direct,
 
     fResourceProvider.init();
 
+    const GrContextOptions& options = direct->priv().options();
+    if (options.fParallelCommandRecording && options.fExecutor) {
+        fParallelRecordingTaskGroup = std::make_unique<SkTaskGroup>(*options.fExecutor);
+    }
+
     fMainCmdPool = fResourceProvider.findOrCreateCommandPool();
     if (fMainCmdPool) {
         fMainCmdBuffer = fMainCmdPool->getPrimaryCommandBuffer();
@@ -2037,10 +2043,12 @@ void GrVkGpu::deleteBackendTexture(const GrBackendTexture& tex) {
     }
 }
 
-bool GrVkGpu::compile(const GrProgramDesc& desc, const GrProgramInfo& programInfo) {
+// Finds a render pass compatible with the one a draw with 'programInfo' will be recorded into.
+static sk_sp<const GrVkRenderPass> find_compatible_render_pass(GrVkGpu* gpu,
+                                                               const GrProgramInfo& programInfo) {
     GrVkRenderPass::AttachmentsDescriptor attachmentsDescriptor;
     GrVkRenderPass::AttachmentFlags attachmentFlags;
-    GrVkRenderTarget::ReconstructAttachmentsDescriptor(this->vkCaps(), programInfo,
+    GrVkRenderTarget::ReconstructAttachmentsDescriptor(gpu->vkCaps(), programInfo,
                                                        &attachmentsDescriptor, &attachmentFlags);
 
     GrVkRenderPass::SelfDependencyFlags selfDepFlags = GrVkRenderPass::SelfDependencyFlags::kNone;
@@ -2052,12 +2060,16 @@ bool GrVkGpu::compile(const GrProgramDesc& desc, const GrProgramInfo& programInf
     }
 
     GrVkRenderPass::LoadFromResolve loadFromResolve = GrVkRenderPass::LoadFromResolve::kNo;
-    if (this->vkCaps().programInfoWillUseDiscardableMSAA(programInfo) &&
+    if (gpu->vkCaps().programInfoWillUseDiscardableMSAA(programInfo) &&
         programInfo.colorLoadOp() == GrLoadOp::kLoad) {
         loadFromResolve = GrVkRenderPass::LoadFromResolve::kLoad;
     }
-    sk_sp<const GrVkRenderPass> renderPass(this->resourceProvider().findCompatibleRenderPass(
+    return sk_sp<const GrVkRenderPass>(gpu->resourceProvider().findCompatibleRenderPass(
             &attachmentsDescriptor, attachmentFlags, selfDepFlags, loadFromResolve));
+}
+
+bool GrVkGpu::compile(const GrProgramDesc& desc, const GrProgramInfo& programInfo) {
+    sk_sp<const GrVkRenderPass> renderPass = find_compatible_render_pass(this, programInfo);
     if (!renderPass) {
         return false;
     }
@@ -2076,6 +2088,29 @@ bool GrVkGpu::compile(const GrProgramDesc& desc, const GrProgramInfo& programInf
     return stat != GrThreadSafePipelineBuilder::Stats::ProgramCacheResult::kHit;
 }
 
+void GrVkGpu::willBindProgram(const GrProgramInfo& programInfo) {
+    SkTaskGroup* taskGroup = this->getContext()->priv().options().fAsyncPipelineCompilation
+                                     ? this->getContext()->priv().getTaskGroup()
+                                     : nullptr;
+    if (!taskGroup) {
+        return;
+    }
+    // Like a precompile, the desc is built without the render target (whose stencil may not be
+    // attached yet) and matches the one the draw looks up, which then finds the pipeline state,
+    // possibly still compiling on the context's task group.
+    GrProgramDesc desc = this->caps()->makeDesc(/*renderTarget=*/nullptr, programInfo);
+    if (!desc.isValid()) {
+        return;
+    }
+    sk_sp<const GrVkRenderPass> renderPass = find_compatible_render_pass(this, programInfo);
+    if (!renderPass) {
+        return;
+    }
+    GrThreadSafePipelineBuilder::Stats::ProgramCacheResult stat;
+    this->resourceProvider().findOrCreateCompatiblePipelineState(
+            desc, programInfo, renderPass->vkRenderPass(), &stat, taskGroup);
+}
+
 #if defined(GR_TEST_UTILS)
 bool GrVkGpu::isTestingOnlyBackendTexture(const GrBackendTexture& tex) const {
     SkASSERT(GrBackendApi::kVulkan == tex.fBackend);
@@ -21,6 +21,7 @@
 
 class GrDirectContext;
 class GrPipeline;
+class SkTaskGroup;
 class GrVkBuffer;
 class GrVkCommandPool;
 class GrVkFramebuffer;
@@ -72,6 +73,9 @@ public:
     VkQueue  queue() const { return fQueue; }
     uint32_t  queueIndex() const { return fQueueIndex; }
     GrVkCommandPool* cmdPool() const { return fMainCmdPool; }
+    // Records the parallel secondary command buffers. Null unless
+    // GrContextOptions::fParallelCommandRecording is set.
+    SkTaskGroup* parallelRecordingTaskGroup() const { return fParallelRecordingTaskGroup.get(); }
     const VkPhysicalDeviceProperties& physicalDeviceProperties() const {
         return fPhysDevProps;
     }
@@ -100,6 +104,8 @@ public:
 
     bool compile(const GrProgramDesc&, const GrProgramInfo&) override;
 
+    void willBindProgram(const GrProgramInfo&) override;
+
 #if defined(GR_TEST_UTILS)
     bool isTestingOnlyBackendTexture(const GrBackendTexture&) const override;
 
@@ -188,6 +194,10 @@ public:
 
     void storeVkPipelineCacheData() override;
 
+    void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const override {
+        fMemoryAllocator->dumpMemoryStatistics(traceMemoryDump);
+    }
+
     bool beginRenderPass(const GrVkRenderPass*,
                          sk_sp<const GrVkFramebuffer>,
                          const VkClearValue* colorClear,
@@ -419,6 +429,7 @@ private:
     GrVkCommandPool*                                      fMainCmdPool;
     // just a raw pointer; object's lifespan is managed by fCmdPool
     GrVkPrimaryCommandBuffer*                             fMainCmdBuffer;
+    std::unique_ptr<SkTaskGroup>                          fParallelRecordingTaskGroup;
 
     skia_private::STArray<1, GrVkSemaphore::Resource*>    fSemaphoresToWaitOn;
     skia_private::STArray<1, GrVkSemaphore::Resource*>    fSemaphoresToSignal;
@@ -253,9 +253,9 @@ bool GrVkOpsRenderPass::init(const GrOpsRenderPass::LoadAndStoreInfo& colorInfo,
         return false;
     }
 
-    if (!fGpu->vkCaps().preferPrimaryOverSecondaryCommandBuffers()) {
-        SkASSERT(fGpu->cmdPool());
-        fCurrentSecondaryCommandBuffer = fGpu->cmdPool()->findOrCreateSecondaryCommandBuffer(fGpu);
+    if (!fGpu->vkCaps().preferPrimaryOverSecondaryCommandBuffers() ||
+        fGpu->parallelRecordingTaskGroup()) {
+        fCurrentSecondaryCommandBuffer = this->findOrCreateSecondaryCommandBuffer(false);
         if (!fCurrentSecondaryCommandBuffer) {
             fCurrentRenderPass = nullptr;
             return false;
@@ -582,9 +582,9 @@ void GrVkOpsRenderPass::addAdditionalRenderPass(bool mustUseSecondaryCommandBuff
     }
 
     if (!fGpu->vkCaps().preferPrimaryOverSecondaryCommandBuffers() ||
-        mustUseSecondaryCommandBuffer) {
-        SkASSERT(fGpu->cmdPool());
-        fCurrentSecondaryCommandBuffer = fGpu->cmdPool()->findOrCreateSecondaryCommandBuffer(fGpu);
+        fGpu->parallelRecordingTaskGroup() || mustUseSecondaryCommandBuffer) {
+        fCurrentSecondaryCommandBuffer =
+                this->findOrCreateSecondaryCommandBuffer(mustUseSecondaryCommandBuffer);
         if (!fCurrentSecondaryCommandBuffer) {
             fCurrentRenderPass = nullptr;
             return;
@@ -598,6 +598,16 @@ void GrVkOpsRenderPass::addAdditionalRenderPass(bool mustUseSecondaryCommandBuff
     this->beginRenderPass(vkClearColor, loadFromResolve);
 }
 
+std::unique_ptr<GrVkSecondaryCommandBuffer> GrVkOpsRenderPass::findOrCreateSecondaryCommandBuffer(
+        bool needsVkCommandBuffer) {
+    SkASSERT(fGpu->cmdPool());
+    // Drawables write into the VkCommandBuffer themselves, so they can't be recorded in parallel.
+    if (fGpu->parallelRecordingTaskGroup() && !needsVkCommandBuffer) {
+        return fGpu->cmdPool()->findOrCreateParallelSecondaryCommandBuffer(fGpu);
+    }
+    return fGpu->cmdPool()->findOrCreateSecondaryCommandBuffer(fGpu);
+}
+
 void GrVkOpsRenderPass::inlineUpload(GrOpFlushState* state, GrDeferredTextureUploadFn& upload) {
     if (!fCurrentRenderPass) {
         SkASSERT(fGpu->isDeviceLost());
@@ -646,6 +656,14 @@ bool GrVkOpsRenderPass::onBindPipeline(const GrProgramInfo& programInfo, const S
     if (!fCurrentPipelineState) {
         return false;
     }
+    if (fCurrentPipelineState->isPipelineCompiling()) {
+        // Draws are never dropped while their pipeline compiles on another thread; this one waits.
+        fGpu->resourceProvider().pipelineStateCache()->stats()->incNumAsyncCompilationStalls();
+    }
+    if (!fCurrentPipelineState->waitForPipeline()) {
+        fCurrentPipelineState = nullptr;
+        return false;
+    }
 
     fCurrentPipelineState->bindPipeline(fGpu, currentCB);
 
@@ -850,7 +868,12 @@ void GrVkOpsRenderPass::onExecuteDrawable(std::unique_ptr<SkDrawable::GpuDrawHan
     bounds.offset = { 0, 0 };
     bounds.extent = { 0, 0 };
 
-    if (!fCurrentSecondaryCommandBuffer) {
+    if (!fCurrentSecondaryCommandBuffer ||
+        fCurrentSecondaryCommandBuffer->isRecordedInParallel()) {
+        if (fCurrentSecondaryCommandBuffer) {
+            fCurrentSecondaryCommandBuffer->end(fGpu);
+            fGpu->submitSecondaryCommandBuffer(std::move(fCurrentSecondaryCommandBuffer));
+        }
         fGpu->endRenderPass(fRenderTarget, fOrigin, fBounds);
         this->addAdditionalRenderPass(true);
         // We may have failed to start a new render pass
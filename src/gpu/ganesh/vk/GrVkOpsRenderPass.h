@@ -99,6 +99,11 @@ private:
 
     void addAdditionalRenderPass(bool mustUseSecondaryCommandBuffer);
 
+    // Returns a secondary command buffer from the GrVkGpu's command pool. It is recorded in
+    // parallel when that is enabled, unless 'needsVkCommandBuffer' is set.
+    std::unique_ptr<GrVkSecondaryCommandBuffer> findOrCreateSecondaryCommandBuffer(
+            bool needsVkCommandBuffer);
+
     void setAttachmentLayouts(LoadFromResolve loadFromResolve);
 
     void loadResolveIntoMSAA(const SkIRect& nativeBounds);
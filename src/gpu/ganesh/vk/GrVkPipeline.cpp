@@ -7,16 +7,20 @@
 
 #include "src/gpu/ganesh/vk/GrVkPipeline.h"
 
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/ganesh/GrGeometryProcessor.h"
 #include "src/gpu/ganesh/GrPipeline.h"
 #include "src/gpu/ganesh/GrStencilSettings.h"
 #include "src/gpu/ganesh/vk/GrVkCommandBuffer.h"
 #include "src/gpu/ganesh/vk/GrVkGpu.h"
+#include "src/gpu/ganesh/vk/GrVkPipelineLibraryCache.h"
 #include "src/gpu/ganesh/vk/GrVkRenderTarget.h"
 #include "src/gpu/ganesh/vk/GrVkUtil.h"
 #include "src/gpu/vk/VulkanUtilsPriv.h"
 
+#include <iterator>
+
 using namespace skia_private;
 
 #if defined(SK_ENABLE_SCOPED_LSAN_SUPPRESSIONS)
@@ -462,99 +466,435 @@ static void setup_dynamic_state(VkPipelineDynamicStateCreateInfo* dynamicInfo,
     dynamicInfo->pDynamicStates = dynamicStates;
 }
 
-sk_sp<GrVkPipeline> GrVkPipeline::Make(GrVkGpu* gpu,
-                                   const GrGeometryProcessor::AttributeSet& vertexAttribs,
-                                   const GrGeometryProcessor::AttributeSet& instanceAttribs,
-                                   GrPrimitiveType primitiveType,
-                                   GrSurfaceOrigin origin,
-                                   const GrStencilSettings& stencilSettings,
-                                   int numSamples,
-                                   bool isHWAntialiasState,
-                                   const skgpu::BlendInfo& blendInfo,
-                                   bool isWireframe,
-                                   bool useConservativeRaster,
-                                   uint32_t subpass,
-                                   VkPipelineShaderStageCreateInfo* shaderStageInfo,
-                                   int shaderStageCount,
-                                   VkRenderPass compatibleRenderPass,
-                                   VkPipelineLayout layout,
-                                   bool ownsLayout,
-                                   VkPipelineCache cache) {
-    VkPipelineVertexInputStateCreateInfo vertexInputInfo;
-    STArray<2, VkVertexInputBindingDescription, true> bindingDescs;
-    STArray<16, VkVertexInputAttributeDescription> attributeDesc;
+// Everything vkCreateGraphicsPipelines reads. The create info points into the other members, so
+// this must not be copied or moved once init() has been called.
+struct GrVkPipeline::CreateInfo {
+    CreateInfo() = default;
+    CreateInfo(const CreateInfo&) = delete;
+    CreateInfo& operator=(const CreateInfo&) = delete;
+
+    void init(GrVkGpu* gpu,
+              const GrGeometryProcessor::AttributeSet& vertexAttribs,
+              const GrGeometryProcessor::AttributeSet& instanceAttribs,
+              GrPrimitiveType primitiveType,
+              GrSurfaceOrigin origin,
+              const GrStencilSettings& stencilSettings,
+              int numSamples,
+              const skgpu::BlendInfo& blendInfo,
+              bool isWireframe,
+              bool useConservativeRaster,
+              uint32_t subpass,
+              const VkPipelineShaderStageCreateInfo* shaderStageInfo,
+              int shaderStageCount,
+              VkRenderPass compatibleRenderPass,
+              VkPipelineLayout layout);
+
+    void initFromProgramInfo(GrVkGpu* gpu,
+                             const GrProgramInfo& programInfo,
+                             const VkPipelineShaderStageCreateInfo* shaderStageInfo,
+                             int shaderStageCount,
+                             VkRenderPass compatibleRenderPass,
+                             VkPipelineLayout layout,
+                             uint32_t subpass);
+
+    // Makes create() link the pipeline from libraries in 'libraryCache'. Must be called after
+    // init().
+    void initLibraries(GrVkPipelineLibraryCache* libraryCache, const LibraryInfo&);
+
+    // Only reads the device and interface of 'gpu', so this can be called from any thread.
+    VkResult create(const GrVkGpu* gpu, VkPipelineCache cache, VkPipeline* vkPipeline) const;
+
+    // The four parts of a pipeline that VK_EXT_graphics_pipeline_library compiles separately.
+    static constexpr VkGraphicsPipelineLibraryFlagBitsEXT kLibraryParts[] = {
+            VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+            VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+            VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+            VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+    };
+    static constexpr int kLibraryPartCount = std::size(kLibraryParts);
+
+    GrVkPipelineLibraryCache::Library createLibrary(const GrVkGpu* gpu,
+                                                    VkPipelineCache cache,
+                                                    VkGraphicsPipelineLibraryFlagBitsEXT part) const;
+    VkResult link(const GrVkGpu* gpu, VkPipelineCache cache, VkPipeline* vkPipeline) const;
+
+    GrVkPipelineLibraryCache* fLibraryCache = nullptr;
+    GrVkPipelineLibraryCache::Key fLibraryKeys[kLibraryPartCount];
+    // The shader stage libraries are created with their own copy of the pipeline's layout, since
+    // they can outlive it.
+    STArray<3, VkDescriptorSetLayout, true> fSetLayouts;
+    STArray<1, VkPushConstantRange, true> fPushConstantRanges;
+
+    STArray<2, VkVertexInputBindingDescription, true> fBindingDescs;
+    STArray<16, VkVertexInputAttributeDescription> fAttributeDescs;
+    VkPipelineVertexInputStateCreateInfo fVertexInputInfo;
+    VkPipelineInputAssemblyStateCreateInfo fInputAssemblyInfo;
+    VkPipelineDepthStencilStateCreateInfo fDepthStencilInfo;
+    VkPipelineViewportStateCreateInfo fViewportInfo;
+    VkPipelineMultisampleStateCreateInfo fMultisampleInfo;
+    // We will only have one color attachment per pipeline.
+    VkPipelineColorBlendAttachmentState fAttachmentStates[1];
+    VkPipelineColorBlendStateCreateInfo fColorBlendInfo;
+    VkPipelineRasterizationStateCreateInfo fRasterInfo;
+    VkPipelineRasterizationConservativeStateCreateInfoEXT fConservativeRasterInfo;
+    VkDynamicState fDynamicStates[3];
+    VkPipelineDynamicStateCreateInfo fDynamicInfo;
+    VkPipelineShaderStageCreateInfo fShaderStageInfo[3];
+    VkGraphicsPipelineCreateInfo fPipelineCreateInfo;
+};
+
+void GrVkPipeline::CreateInfo::init(GrVkGpu* gpu,
+                                    const GrGeometryProcessor::AttributeSet& vertexAttribs,
+                                    const GrGeometryProcessor::AttributeSet& instanceAttribs,
+                                    GrPrimitiveType primitiveType,
+                                    GrSurfaceOrigin origin,
+                                    const GrStencilSettings& stencilSettings,
+                                    int numSamples,
+                                    const skgpu::BlendInfo& blendInfo,
+                                    bool isWireframe,
+                                    bool useConservativeRaster,
+                                    uint32_t subpass,
+                                    const VkPipelineShaderStageCreateInfo* shaderStageInfo,
+                                    int shaderStageCount,
+                                    VkRenderPass compatibleRenderPass,
+                                    VkPipelineLayout layout) {
     int totalAttributeCnt = vertexAttribs.count() + instanceAttribs.count();
     SkASSERT(totalAttributeCnt <= gpu->vkCaps().maxVertexAttributes());
-    VkVertexInputAttributeDescription* pAttribs = attributeDesc.push_back_n(totalAttributeCnt);
-    setup_vertex_input_state(vertexAttribs, instanceAttribs, &vertexInputInfo, &bindingDescs,
+    VkVertexInputAttributeDescription* pAttribs = fAttributeDescs.push_back_n(totalAttributeCnt);
+    setup_vertex_input_state(vertexAttribs, instanceAttribs, &fVertexInputInfo, &fBindingDescs,
                              pAttribs);
 
-    VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo;
-    setup_input_assembly_state(primitiveType, &inputAssemblyInfo);
+    setup_input_assembly_state(primitiveType, &fInputAssemblyInfo);
 
-    VkPipelineDepthStencilStateCreateInfo depthStencilInfo;
-    setup_depth_stencil_state(stencilSettings, origin, &depthStencilInfo);
+    setup_depth_stencil_state(stencilSettings, origin, &fDepthStencilInfo);
 
-    VkPipelineViewportStateCreateInfo viewportInfo;
-    setup_viewport_scissor_state(&viewportInfo);
+    setup_viewport_scissor_state(&fViewportInfo);
 
-    VkPipelineMultisampleStateCreateInfo multisampleInfo;
-    setup_multisample_state(numSamples, gpu->caps(), &multisampleInfo);
+    setup_multisample_state(numSamples, gpu->caps(), &fMultisampleInfo);
 
-    // We will only have one color attachment per pipeline.
-    VkPipelineColorBlendAttachmentState attachmentStates[1];
-    VkPipelineColorBlendStateCreateInfo colorBlendInfo;
-    setup_color_blend_state(blendInfo, &colorBlendInfo, attachmentStates);
+    setup_color_blend_state(blendInfo, &fColorBlendInfo, fAttachmentStates);
 
-    VkPipelineRasterizationStateCreateInfo rasterInfo;
-    setup_raster_state(isWireframe, gpu->caps(), &rasterInfo);
+    setup_raster_state(isWireframe, gpu->caps(), &fRasterInfo);
 
-    VkPipelineRasterizationConservativeStateCreateInfoEXT conservativeRasterInfo;
     if (useConservativeRaster) {
         SkASSERT(gpu->caps()->conservativeRasterSupport());
-        setup_conservative_raster_info(&conservativeRasterInfo);
-        conservativeRasterInfo.pNext = rasterInfo.pNext;
-        rasterInfo.pNext = &conservativeRasterInfo;
+        setup_conservative_raster_info(&fConservativeRasterInfo);
+        fConservativeRasterInfo.pNext = fRasterInfo.pNext;
+        fRasterInfo.pNext = &fConservativeRasterInfo;
     }
 
-    VkDynamicState dynamicStates[3];
-    VkPipelineDynamicStateCreateInfo dynamicInfo;
-    setup_dynamic_state(&dynamicInfo, dynamicStates);
-
-    VkGraphicsPipelineCreateInfo pipelineCreateInfo;
-    memset(&pipelineCreateInfo, 0, sizeof(VkGraphicsPipelineCreateInfo));
-    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineCreateInfo.pNext = nullptr;
-    pipelineCreateInfo.flags = 0;
-    pipelineCreateInfo.stageCount = shaderStageCount;
-    pipelineCreateInfo.pStages = shaderStageInfo;
-    pipelineCreateInfo.pVertexInputState = &vertexInputInfo;
-    pipelineCreateInfo.pInputAssemblyState = &inputAssemblyInfo;
-    pipelineCreateInfo.pTessellationState = nullptr;
-    pipelineCreateInfo.pViewportState = &viewportInfo;
-    pipelineCreateInfo.pRasterizationState = &rasterInfo;
-    pipelineCreateInfo.pMultisampleState = &multisampleInfo;
-    pipelineCreateInfo.pDepthStencilState = &depthStencilInfo;
-    pipelineCreateInfo.pColorBlendState = &colorBlendInfo;
-    pipelineCreateInfo.pDynamicState = &dynamicInfo;
-    pipelineCreateInfo.layout = layout;
-    pipelineCreateInfo.renderPass = compatibleRenderPass;
-    pipelineCreateInfo.subpass = subpass;
-    pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
-    pipelineCreateInfo.basePipelineIndex = -1;
+    setup_dynamic_state(&fDynamicInfo, fDynamicStates);
+
+    SkASSERT(shaderStageCount <= (int)std::size(fShaderStageInfo));
+    memcpy(fShaderStageInfo, shaderStageInfo, shaderStageCount * sizeof(*shaderStageInfo));
+
+    memset(&fPipelineCreateInfo, 0, sizeof(VkGraphicsPipelineCreateInfo));
+    fPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    fPipelineCreateInfo.pNext = nullptr;
+    fPipelineCreateInfo.flags = 0;
+    fPipelineCreateInfo.stageCount = shaderStageCount;
+    fPipelineCreateInfo.pStages = fShaderStageInfo;
+    fPipelineCreateInfo.pVertexInputState = &fVertexInputInfo;
+    fPipelineCreateInfo.pInputAssemblyState = &fInputAssemblyInfo;
+    fPipelineCreateInfo.pTessellationState = nullptr;
+    fPipelineCreateInfo.pViewportState = &fViewportInfo;
+    fPipelineCreateInfo.pRasterizationState = &fRasterInfo;
+    fPipelineCreateInfo.pMultisampleState = &fMultisampleInfo;
+    fPipelineCreateInfo.pDepthStencilState = &fDepthStencilInfo;
+    fPipelineCreateInfo.pColorBlendState = &fColorBlendInfo;
+    fPipelineCreateInfo.pDynamicState = &fDynamicInfo;
+    fPipelineCreateInfo.layout = layout;
+    fPipelineCreateInfo.renderPass = compatibleRenderPass;
+    fPipelineCreateInfo.subpass = subpass;
+    fPipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+    fPipelineCreateInfo.basePipelineIndex = -1;
+}
+
+void GrVkPipeline::CreateInfo::initFromProgramInfo(
+        GrVkGpu* gpu,
+        const GrProgramInfo& programInfo,
+        const VkPipelineShaderStageCreateInfo* shaderStageInfo,
+        int shaderStageCount,
+        VkRenderPass compatibleRenderPass,
+        VkPipelineLayout layout,
+        uint32_t subpass) {
+    const GrGeometryProcessor& geomProc = programInfo.geomProc();
+    const GrPipeline& pipeline = programInfo.pipeline();
+
+    this->init(gpu,
+               geomProc.vertexAttributes(),
+               geomProc.instanceAttributes(),
+               programInfo.primitiveType(),
+               programInfo.origin(),
+               programInfo.nonGLStencilSettings(),
+               programInfo.numSamples(),
+               pipeline.getXferProcessor().getBlendInfo(),
+               pipeline.isWireframe(),
+               pipeline.usesConservativeRaster(),
+               subpass,
+               shaderStageInfo,
+               shaderStageCount,
+               compatibleRenderPass,
+               layout);
+}
+
+static void add_string_to_key(GrVkPipelineLibraryCache::Key* key, std::string_view str) {
+    key->add32(SkToU32(str.size()));
+    key->add(str.data(), str.size());
+}
+
+void GrVkPipeline::CreateInfo::initLibraries(GrVkPipelineLibraryCache* libraryCache,
+                                             const LibraryInfo& info) {
+    SkASSERT(fPipelineCreateInfo.stageCount == 2 &&
+             fShaderStageInfo[0].stage == VK_SHADER_STAGE_VERTEX_BIT &&
+             fShaderStageInfo[1].stage == VK_SHADER_STAGE_FRAGMENT_BIT);
+    fLibraryCache = libraryCache;
+
+    const VkPipelineLayoutCreateInfo& layoutInfo = *info.fLayoutInfo;
+    fSetLayouts.push_back_n(layoutInfo.setLayoutCount, layoutInfo.pSetLayouts);
+    fPushConstantRanges.push_back_n(layoutInfo.pushConstantRangeCount,
+                                    layoutInfo.pPushConstantRanges);
+
+    // Each key holds the state its part is created from. The render pass handles are cached by
+    // the GrVkResourceProvider for as long as the libraries are, so they identify the render pass.
+    auto addLayout = [&](GrVkPipelineLibraryCache::Key* key) {
+        key->add32(fSetLayouts.size());
+        key->add(fSetLayouts.data(), fSetLayouts.size_bytes());
+        key->add32(fPushConstantRanges.size());
+        key->add(fPushConstantRanges.data(), fPushConstantRanges.size_bytes());
+    };
+    auto addRenderPass = [&](GrVkPipelineLibraryCache::Key* key) {
+        key->add(&fPipelineCreateInfo.renderPass, sizeof(VkRenderPass));
+        key->add32(fPipelineCreateInfo.subpass);
+    };
+
+    for (int i = 0; i < kLibraryPartCount; ++i) {
+        GrVkPipelineLibraryCache::Key* key = &fLibraryKeys[i];
+        key->add32(kLibraryParts[i]);
+        switch (kLibraryParts[i]) {
+            case VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT:
+                key->add32(fBindingDescs.size());
+                key->add(fBindingDescs.data(), fBindingDescs.size_bytes());
+                key->add32(fAttributeDescs.size());
+                key->add(fAttributeDescs.data(), fAttributeDescs.size_bytes());
+                key->add32(fInputAssemblyInfo.topology);
+                break;
+            case VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT:
+                add_string_to_key(key, info.fVertexSPIRV);
+                addLayout(key);
+                addRenderPass(key);
+                key->add32(fRasterInfo.polygonMode);
+                key->add32(fRasterInfo.pNext != nullptr);  // conservative rasterization
+                break;
+            case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT:
+                add_string_to_key(key, info.fFragmentSPIRV);
+                addLayout(key);
+                addRenderPass(key);
+                // These were zeroed before they were filled in and have no pNext chain.
+                key->add(&fDepthStencilInfo, sizeof(fDepthStencilInfo));
+                key->add(&fMultisampleInfo, sizeof(fMultisampleInfo));
+                break;
+            case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT:
+                addRenderPass(key);
+                key->add(fAttachmentStates, sizeof(fAttachmentStates));
+                key->add(&fMultisampleInfo, sizeof(fMultisampleInfo));
+                break;
+            default:
+                SkUNREACHABLE;
+        }
+    }
+}
+
+GrVkPipelineLibraryCache::Library GrVkPipeline::CreateInfo::createLibrary(
+        const GrVkGpu* gpu,
+        VkPipelineCache cache,
+        VkGraphicsPipelineLibraryFlagBitsEXT part) const {
+    GrVkPipelineLibraryCache::Library library;
+
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo;
+    memset(&libraryInfo, 0, sizeof(VkGraphicsPipelineLibraryCreateInfoEXT));
+    libraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    libraryInfo.pNext = nullptr;
+    libraryInfo.flags = part;
+
+    VkGraphicsPipelineCreateInfo createInfo;
+    memset(&createInfo, 0, sizeof(VkGraphicsPipelineCreateInfo));
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext = &libraryInfo;
+    createInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+    createInfo.basePipelineHandle = VK_NULL_HANDLE;
+    createInfo.basePipelineIndex = -1;
+
+    // Viewport and scissor belong to the pre-rasterization state and the blend constants to the
+    // fragment output state (see setup_dynamic_state()).
+    VkPipelineDynamicStateCreateInfo dynamicInfo = fDynamicInfo;
+
+    bool isShaderStage = part == VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT ||
+                         part == VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+    if (isShaderStage) {
+        VkPipelineLayoutCreateInfo layoutCreateInfo;
+        memset(&layoutCreateInfo, 0, sizeof(VkPipelineLayoutCreateInfo));
+        layoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutCreateInfo.setLayoutCount = fSetLayouts.size();
+        layoutCreateInfo.pSetLayouts = fSetLayouts.data();
+        layoutCreateInfo.pushConstantRangeCount = fPushConstantRanges.size();
+        layoutCreateInfo.pPushConstantRanges = fPushConstantRanges.data();
+        VkResult err = GR_VK_CALL(gpu->vkInterface(),
+                                  CreatePipelineLayout(gpu->device(), &layoutCreateInfo, nullptr,
+                                                       &library.fLayout));
+        if (err != VK_SUCCESS) {
+            return {};
+        }
+        createInfo.layout = library.fLayout;
+    }
+
+    switch (part) {
+        case VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT:
+            createInfo.pVertexInputState = &fVertexInputInfo;
+            createInfo.pInputAssemblyState = &fInputAssemblyInfo;
+            break;
+        case VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT:
+            createInfo.stageCount = 1;
+            createInfo.pStages = &fShaderStageInfo[0];
+            createInfo.pViewportState = &fViewportInfo;
+            createInfo.pRasterizationState = &fRasterInfo;
+            dynamicInfo.dynamicStateCount = 2;
+            dynamicInfo.pDynamicStates = &fDynamicStates[0];
+            createInfo.pDynamicState = &dynamicInfo;
+            break;
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT:
+            createInfo.stageCount = 1;
+            createInfo.pStages = &fShaderStageInfo[1];
+            createInfo.pDepthStencilState = &fDepthStencilInfo;
+            createInfo.pMultisampleState = &fMultisampleInfo;
+            break;
+        case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT:
+            createInfo.pColorBlendState = &fColorBlendInfo;
+            createInfo.pMultisampleState = &fMultisampleInfo;
+            dynamicInfo.dynamicStateCount = 1;
+            dynamicInfo.pDynamicStates = &fDynamicStates[2];
+            createInfo.pDynamicState = &dynamicInfo;
+            break;
+        default:
+            SkUNREACHABLE;
+    }
+    if (part != VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT) {
+        createInfo.renderPass = fPipelineCreateInfo.renderPass;
+        createInfo.subpass = fPipelineCreateInfo.subpass;
+    }
 
-    VkPipeline vkPipeline;
     VkResult err;
     {
-        TRACE_EVENT0_ALWAYS("skia.shaders", "CreateGraphicsPipeline");
+        TRACE_EVENT0_ALWAYS("skia.shaders", "CreateGraphicsPipelineLibrary");
 #if defined(SK_ENABLE_SCOPED_LSAN_SUPPRESSIONS)
         // skia:8712
         __lsan::ScopedDisabler lsanDisabler;
 #endif
-        GR_VK_CALL_RESULT(gpu, err, CreateGraphicsPipelines(gpu->device(), cache, 1,
-                                                            &pipelineCreateInfo, nullptr,
-                                                            &vkPipeline));
+        err = GR_VK_CALL(gpu->vkInterface(), CreateGraphicsPipelines(gpu->device(), cache, 1,
+                                                                     &createInfo, nullptr,
+                                                                     &library.fPipeline));
+    }
+    if (err != VK_SUCCESS) {
+        if (library.fLayout != VK_NULL_HANDLE) {
+            GR_VK_CALL(gpu->vkInterface(),
+                       DestroyPipelineLayout(gpu->device(), library.fLayout, nullptr));
+        }
+        return {};
+    }
+    return library;
+}
+
+VkResult GrVkPipeline::CreateInfo::link(const GrVkGpu* gpu,
+                                        VkPipelineCache cache,
+                                        VkPipeline* vkPipeline) const {
+    VkPipeline libraries[kLibraryPartCount];
+    for (int i = 0; i < kLibraryPartCount; ++i) {
+        libraries[i] = fLibraryCache->findOrCreate(fLibraryKeys[i], [&]() {
+            return this->createLibrary(gpu, cache, kLibraryParts[i]);
+        });
+        if (libraries[i] == VK_NULL_HANDLE) {
+            return VK_ERROR_INITIALIZATION_FAILED;
+        }
     }
+
+    VkPipelineLibraryCreateInfoKHR linkInfo;
+    memset(&linkInfo, 0, sizeof(VkPipelineLibraryCreateInfoKHR));
+    linkInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    linkInfo.pNext = nullptr;
+    linkInfo.libraryCount = kLibraryPartCount;
+    linkInfo.pLibraries = libraries;
+
+    // Everything else comes from the libraries. Linking without link time optimization is what
+    // makes this quick.
+    VkGraphicsPipelineCreateInfo createInfo;
+    memset(&createInfo, 0, sizeof(VkGraphicsPipelineCreateInfo));
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext = &linkInfo;
+    createInfo.flags = 0;
+    createInfo.layout = fPipelineCreateInfo.layout;
+    createInfo.renderPass = fPipelineCreateInfo.renderPass;
+    createInfo.subpass = fPipelineCreateInfo.subpass;
+    createInfo.basePipelineHandle = VK_NULL_HANDLE;
+    createInfo.basePipelineIndex = -1;
+
+    TRACE_EVENT0_ALWAYS("skia.shaders", "LinkGraphicsPipeline");
+    return GR_VK_CALL(gpu->vkInterface(), CreateGraphicsPipelines(gpu->device(), cache, 1,
+                                                                  &createInfo, nullptr,
+                                                                  vkPipeline));
+}
+
+VkResult GrVkPipeline::CreateInfo::create(const GrVkGpu* gpu,
+                                          VkPipelineCache cache,
+                                          VkPipeline* vkPipeline) const {
+    if (fLibraryCache && this->link(gpu, cache, vkPipeline) == VK_SUCCESS) {
+        return VK_SUCCESS;
+    }
+    // Without libraries, or if one of them couldn't be created, compile the whole pipeline.
+
+    TRACE_EVENT0_ALWAYS("skia.shaders", "CreateGraphicsPipeline");
+#if defined(SK_ENABLE_SCOPED_LSAN_SUPPRESSIONS)
+    // skia:8712
+    __lsan::ScopedDisabler lsanDisabler;
+#endif
+    return GR_VK_CALL(gpu->vkInterface(), CreateGraphicsPipelines(gpu->device(), cache, 1,
+                                                                  &fPipelineCreateInfo, nullptr,
+                                                                  vkPipeline));
+}
+
+sk_sp<GrVkPipeline> GrVkPipeline::Make(GrVkGpu* gpu,
+                                   const GrGeometryProcessor::AttributeSet& vertexAttribs,
+                                   const GrGeometryProcessor::AttributeSet& instanceAttribs,
+                                   GrPrimitiveType primitiveType,
+                                   GrSurfaceOrigin origin,
+                                   const GrStencilSettings& stencilSettings,
+                                   int numSamples,
+                                   bool isHWAntialiasState,
+                                   const skgpu::BlendInfo& blendInfo,
+                                   bool isWireframe,
+                                   bool useConservativeRaster,
+                                   uint32_t subpass,
+                                   VkPipelineShaderStageCreateInfo* shaderStageInfo,
+                                   int shaderStageCount,
+                                   VkRenderPass compatibleRenderPass,
+                                   VkPipelineLayout layout,
+                                   bool ownsLayout,
+                                   VkPipelineCache cache) {
+    CreateInfo createInfo;
+    createInfo.init(gpu, vertexAttribs, instanceAttribs, primitiveType, origin, stencilSettings,
+                    numSamples, blendInfo, isWireframe, useConservativeRaster, subpass,
+                    shaderStageInfo, shaderStageCount, compatibleRenderPass, layout);
+    return Make(gpu, createInfo, layout, ownsLayout, cache);
+}
+
+sk_sp<GrVkPipeline> GrVkPipeline::Make(GrVkGpu* gpu,
+                                       const CreateInfo& createInfo,
+                                       VkPipelineLayout layout,
+                                       bool ownsLayout,
+                                       VkPipelineCache cache) {
+    VkPipeline vkPipeline;
+    VkResult err = createInfo.create(gpu, cache, &vkPipeline);
+    SkASSERT(VK_SUCCESS == err || VK_ERROR_DEVICE_LOST == err);
+    gpu->checkVkResult(err);
     if (err) {
         SkDebugf("Failed to create pipeline. Error: %d\n", err);
         return nullptr;
@@ -573,28 +913,92 @@ sk_sp<GrVkPipeline> GrVkPipeline::Make(GrVkGpu* gpu,
                                        VkRenderPass compatibleRenderPass,
                                        VkPipelineLayout layout,
                                        VkPipelineCache cache,
-                                       uint32_t subpass) {
-    const GrGeometryProcessor& geomProc = programInfo.geomProc();
-    const GrPipeline& pipeline = programInfo.pipeline();
+                                       uint32_t subpass,
+                                       const LibraryInfo* libraryInfo) {
+    CreateInfo createInfo;
+    createInfo.initFromProgramInfo(gpu, programInfo, shaderStageInfo, shaderStageCount,
+                                   compatibleRenderPass, layout, subpass);
+    if (libraryInfo && gpu->resourceProvider().pipelineLibraryCache()) {
+        createInfo.initLibraries(gpu->resourceProvider().pipelineLibraryCache(), *libraryInfo);
+    }
+    return Make(gpu, createInfo, layout, /*ownsLayout=*/true, cache);
+}
 
-    return Make(gpu,
-                geomProc.vertexAttributes(),
-                geomProc.instanceAttributes(),
-                programInfo.primitiveType(),
-                programInfo.origin(),
-                programInfo.nonGLStencilSettings(),
-                programInfo.numSamples(),
-                programInfo.numSamples() > 1,
-                pipeline.getXferProcessor().getBlendInfo(),
-                pipeline.isWireframe(),
-                pipeline.usesConservativeRaster(),
-                subpass,
-                shaderStageInfo,
-                shaderStageCount,
-                compatibleRenderPass,
-                layout,
-                /*ownsLayout=*/true,
-                cache);
+std::unique_ptr<GrVkPipeline::Pending> GrVkPipeline::MakeAsync(
+        SkTaskGroup* taskGroup,
+        GrVkGpu* gpu,
+        const GrProgramInfo& programInfo,
+        VkPipelineShaderStageCreateInfo* shaderStageInfo,
+        int shaderStageCount,
+        VkRenderPass compatibleRenderPass,
+        VkPipelineLayout layout,
+        VkPipelineCache cache,
+        uint32_t subpass,
+        const LibraryInfo* libraryInfo) {
+    // The create info is filled in now, while the GrProgramInfo is alive, so that the task only
+    // has to call the driver.
+    std::unique_ptr<Pending> pending(new Pending(gpu, layout));
+    pending->fCreateInfo = std::make_unique<CreateInfo>();
+    pending->fCreateInfo->initFromProgramInfo(gpu, programInfo, shaderStageInfo,
+                                              shaderStageCount, compatibleRenderPass, layout,
+                                              subpass);
+    if (libraryInfo && gpu->resourceProvider().pipelineLibraryCache()) {
+        pending->fCreateInfo->initLibraries(gpu->resourceProvider().pipelineLibraryCache(),
+                                            *libraryInfo);
+    }
+
+    // The Pending waits for the task when it is destroyed, so the task can't outlive it.
+    Pending* p = pending.get();
+    taskGroup->add([p, cache]() {
+        p->fResult = p->fCreateInfo->create(p->fGpu, cache, &p->fVkPipeline);
+
+        const CreateInfo& createInfo = *p->fCreateInfo;
+        for (uint32_t i = 0; i < createInfo.fPipelineCreateInfo.stageCount; ++i) {
+            // The modules are only needed to create the pipeline. Calling destroy on a
+            // VK_NULL_HANDLE is allowed, but crashes some drivers (e.g. NVidia).
+            if (createInfo.fShaderStageInfo[i].module) {
+                GR_VK_CALL(p->fGpu->vkInterface(),
+                           DestroyShaderModule(p->fGpu->device(),
+                                               createInfo.fShaderStageInfo[i].module,
+                                               nullptr));
+            }
+        }
+        p->fFinished.store(true, std::memory_order_release);
+        p->fDone.signal();
+    });
+    return pending;
+}
+
+GrVkPipeline::Pending::Pending(GrVkGpu* gpu, VkPipelineLayout layout)
+        : fGpu(gpu), fLayout(layout) {}
+
+GrVkPipeline::Pending::~Pending() {
+    fDone.wait();
+    if (!fTaken) {
+        if (fVkPipeline != VK_NULL_HANDLE) {
+            GR_VK_CALL(fGpu->vkInterface(), DestroyPipeline(fGpu->device(), fVkPipeline, nullptr));
+        }
+        GR_VK_CALL(fGpu->vkInterface(), DestroyPipelineLayout(fGpu->device(), fLayout, nullptr));
+    }
+}
+
+void GrVkPipeline::Pending::wait() {
+    // The destructor waits on the semaphore too, so it's signaled again for it.
+    fDone.wait();
+    fDone.signal();
+}
+
+sk_sp<GrVkPipeline> GrVkPipeline::Pending::takePipeline() {
+    SkASSERT(this->isFinished() && !fTaken);
+    SkASSERT(VK_SUCCESS == fResult || VK_ERROR_DEVICE_LOST == fResult);
+    // The result is only checked now since checkVkResult() must be called on the GrVkGpu's thread.
+    fGpu->checkVkResult(fResult);
+    if (fResult != VK_SUCCESS) {
+        SkDebugf("Failed to create pipeline. Error: %d\n", fResult);
+        return nullptr;
+    }
+    fTaken = true;
+    return sk_sp<GrVkPipeline>(new GrVkPipeline(fGpu, fVkPipeline, fLayout));
 }
 
 void GrVkPipeline::freeGPUData() const {
@@ -9,12 +9,16 @@
 #define GrVkPipeline_DEFINED
 
 #include "include/gpu/vk/GrVkTypes.h"
+#include "include/private/base/SkSemaphore.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/gpu/Blend.h"
 #include "src/gpu/ganesh/GrGeometryProcessor.h"
 #include "src/gpu/ganesh/vk/GrVkManagedResource.h"
 
+#include <atomic>
 #include <cinttypes>
+#include <memory>
+#include <string_view>
 
 class GrPipeline;
 class GrProgramInfo;
@@ -24,6 +28,7 @@ class GrVkCommandBuffer;
 class GrVkGpu;
 class GrVkRenderPass;
 class GrXferProcessor;
+class SkTaskGroup;
 struct SkIRect;
 
 namespace skgpu {
@@ -31,6 +36,9 @@ class Swizzle;
 }
 
 class GrVkPipeline : public GrVkManagedResource {
+    // Defined in GrVkPipeline.cpp.
+    struct CreateInfo;
+
 public:
     static sk_sp<GrVkPipeline> Make(GrVkGpu*,
                                     const GrGeometryProcessor::AttributeSet& vertexAttribs,
@@ -51,6 +59,17 @@ public:
                                     bool ownsLayout,
                                     VkPipelineCache cache);
 
+    /**
+     * What the vertex and fragment shader modules and the layout of a pipeline were made from.
+     * With it, devices that support VK_EXT_graphics_pipeline_library link the pipeline from parts
+     * shared with other pipelines (see GrVkPipelineLibraryCache) instead of compiling it whole.
+     */
+    struct LibraryInfo {
+        std::string_view fVertexSPIRV;
+        std::string_view fFragmentSPIRV;
+        const VkPipelineLayoutCreateInfo* fLayoutInfo;
+    };
+
     static sk_sp<GrVkPipeline> Make(GrVkGpu*,
                                     const GrProgramInfo&,
                                     VkPipelineShaderStageCreateInfo* shaderStageInfo,
@@ -58,7 +77,53 @@ public:
                                     VkRenderPass compatibleRenderPass,
                                     VkPipelineLayout layout,
                                     VkPipelineCache cache,
-                                    uint32_t subpass);
+                                    uint32_t subpass,
+                                    const LibraryInfo* = nullptr);
+
+    /**
+     * A pipeline that the driver compiles as a task on an SkTaskGroup, so that the thread that
+     * needs it doesn't wait for the compile. Destroying a Pending waits for its task to finish.
+     */
+    class Pending {
+    public:
+        ~Pending();
+
+        bool isFinished() const { return fFinished.load(std::memory_order_acquire); }
+
+        // Blocks until the task has finished.
+        void wait();
+
+        // Returns the pipeline, or null if the driver failed to create it. This may only be called
+        // once, after isFinished() returns true, on the thread that uses the GrVkGpu.
+        sk_sp<GrVkPipeline> takePipeline();
+
+    private:
+        friend class GrVkPipeline;
+
+        Pending(GrVkGpu*, VkPipelineLayout);
+
+        GrVkGpu* fGpu;
+        VkPipelineLayout fLayout;
+        std::unique_ptr<CreateInfo> fCreateInfo;
+        VkPipeline fVkPipeline = VK_NULL_HANDLE;
+        VkResult fResult = VK_SUCCESS;
+        bool fTaken = false;
+        std::atomic<bool> fFinished{false};
+        SkSemaphore fDone;
+    };
+
+    // Like Make() but the driver compiles the pipeline on 'taskGroup'. This takes ownership of
+    // 'layout' and of the shader modules in 'shaderStageInfo'.
+    static std::unique_ptr<Pending> MakeAsync(SkTaskGroup* taskGroup,
+                                              GrVkGpu*,
+                                              const GrProgramInfo&,
+                                              VkPipelineShaderStageCreateInfo* shaderStageInfo,
+                                              int shaderStageCount,
+                                              VkRenderPass compatibleRenderPass,
+                                              VkPipelineLayout layout,
+                                              VkPipelineCache cache,
+                                              uint32_t subpass,
+                                              const LibraryInfo* = nullptr);
 
     VkPipeline pipeline() const { return fPipeline; }
     VkPipelineLayout layout() const {
@@ -92,6 +157,12 @@ protected:
     VkPipelineLayout  fPipelineLayout;
 
 private:
+    static sk_sp<GrVkPipeline> Make(GrVkGpu*,
+                                    const CreateInfo&,
+                                    VkPipelineLayout layout,
+                                    bool ownsLayout,
+                                    VkPipelineCache cache);
+
     void freeGPUData() const override;
 
     using INHERITED = GrVkManagedResource;
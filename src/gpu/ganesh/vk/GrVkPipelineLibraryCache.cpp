@@ -0,0 +1,76 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/vk/GrVkPipelineLibraryCache.h"
+
+#include "src/base/SkMathPriv.h"
+#include "src/gpu/ganesh/vk/GrVkGpu.h"
+#include "src/gpu/ganesh/vk/GrVkUtil.h"
+
+#include <cstring>
+
+void GrVkPipelineLibraryCache::Key::add(const void* data, size_t size) {
+    if (!size) {
+        return;
+    }
+    int words = SkToInt(SkAlign4(size) / 4);
+    uint32_t* dst = fData.push_back_n(words);
+    // Zero the padding so that it doesn't affect comparisons.
+    dst[words - 1] = 0;
+    memcpy(dst, data, size);
+}
+
+GrVkPipelineLibraryCache::~GrVkPipelineLibraryCache() {
+    SkAutoMutexExclusive lock(fMutex);
+    SkASSERT(fLibraries.count() == 0);
+}
+
+VkPipeline GrVkPipelineLibraryCache::findOrCreate(const Key& key,
+                                                  const std::function<Library()>& create) {
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        if (Library* library = fLibraries.find(key)) {
+            return library->fPipeline;
+        }
+    }
+
+    // The driver compiles without the lock held, so that threads creating different libraries
+    // don't wait for each other.
+    Library library = create();
+    if (library.fPipeline == VK_NULL_HANDLE) {
+        SkASSERT(library.fLayout == VK_NULL_HANDLE);
+        return VK_NULL_HANDLE;
+    }
+
+    SkAutoMutexExclusive lock(fMutex);
+    if (Library* existing = fLibraries.find(key)) {
+        // Another thread created the same library first.
+        this->destroy(library);
+        return existing->fPipeline;
+    }
+    fLibraries.set(key, library);
+    return library.fPipeline;
+}
+
+void GrVkPipelineLibraryCache::release() {
+    SkAutoMutexExclusive lock(fMutex);
+    fLibraries.foreach([this](const Key&, Library* library) { this->destroy(*library); });
+    fLibraries.reset();
+}
+
+void GrVkPipelineLibraryCache::destroy(const Library& library) const {
+    GR_VK_CALL(fGpu->vkInterface(), DestroyPipeline(fGpu->device(), library.fPipeline, nullptr));
+    if (library.fLayout != VK_NULL_HANDLE) {
+        GR_VK_CALL(fGpu->vkInterface(),
+                   DestroyPipelineLayout(fGpu->device(), library.fLayout, nullptr));
+    }
+}
+
+int GrVkPipelineLibraryCache::count() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fLibraries.count();
+}
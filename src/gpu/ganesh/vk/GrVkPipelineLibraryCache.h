@@ -0,0 +1,80 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrVkPipelineLibraryCache_DEFINED
+#define GrVkPipelineLibraryCache_DEFINED
+
+#include "include/gpu/vk/GrVkTypes.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkTHash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+class GrVkGpu;
+
+/**
+ * Caches the parts of graphics pipelines created with VK_EXT_graphics_pipeline_library, so that
+ * pipelines which only differ in some of their state share the compiled parts of the others. In
+ * particular each vertex and fragment shader is compiled once for all the render passes, blend
+ * modes and vertex layouts it is used with; only the quick link step is done per pipeline.
+ *
+ * A key holds everything the library is built from, so equal keys always describe the same
+ * library. The cache may be used from several threads at once, and the libraries are kept until
+ * release() is called.
+ */
+class GrVkPipelineLibraryCache {
+public:
+    class Key {
+    public:
+        void add(const void* data, size_t size);
+        void add32(uint32_t value) { fData.push_back(value); }
+
+        bool operator==(const Key& that) const { return fData == that.fData; }
+
+        struct Hash {
+            uint32_t operator()(const Key& key) const {
+                return SkChecksum::Hash32(key.fData.data(), key.fData.size_bytes());
+            }
+        };
+
+    private:
+        skia_private::TArray<uint32_t, true> fData;
+    };
+
+    // A library and, for the shader stages, the layout it was created with. The cache owns both.
+    struct Library {
+        VkPipeline fPipeline = VK_NULL_HANDLE;
+        VkPipelineLayout fLayout = VK_NULL_HANDLE;
+    };
+
+    explicit GrVkPipelineLibraryCache(const GrVkGpu* gpu) : fGpu(gpu) {}
+    ~GrVkPipelineLibraryCache();
+
+    // Returns the library for 'key', calling 'create' to make it if it isn't cached yet. Returns
+    // VK_NULL_HANDLE if 'create' fails, in which case 'create' must not return a layout.
+    VkPipeline findOrCreate(const Key& key, const std::function<Library()>& create);
+
+    // Destroys all the libraries. Pipelines linked from them stay valid.
+    void release();
+
+    int count() const;
+
+private:
+    void destroy(const Library&) const;
+
+    const GrVkGpu* fGpu;
+
+    mutable SkMutex fMutex;
+    skia_private::THashMap<Key, Library, Key::Hash> fLibraries SK_GUARDED_BY(fMutex);
+};
+
+#endif
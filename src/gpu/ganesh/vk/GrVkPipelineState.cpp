@@ -31,6 +31,7 @@ using namespace skia_private;
 GrVkPipelineState::GrVkPipelineState(
         GrVkGpu* gpu,
         sk_sp<const GrVkPipeline> pipeline,
+        std::unique_ptr<GrVkPipeline::Pending> pendingPipeline,
         const GrVkDescriptorSetManager::Handle& samplerDSHandle,
         const GrGLSLBuiltinUniformHandles& builtinUniformHandles,
         const UniformInfoArray& uniforms,
@@ -41,6 +42,7 @@ GrVkPipelineState::GrVkPipelineState(
         std::unique_ptr<GrXferProcessor::ProgramImpl> xpImpl,
         std::vector<std::unique_ptr<GrFragmentProcessor::ProgramImpl>> fpImpls)
         : fPipeline(std::move(pipeline))
+        , fPendingPipeline(std::move(pendingPipeline))
         , fSamplerDSHandle(samplerDSHandle)
         , fBuiltinUniformHandles(builtinUniformHandles)
         , fGPImpl(std::move(gpImpl))
@@ -56,14 +58,17 @@ GrVkPipelineState::GrVkPipelineState(
         }
         fImmutableSamplers.push_back(sampler.fImmutableSampler);
     }
+    SkASSERT(SkToBool(fPipeline) != SkToBool(fPendingPipeline));
 }
 
 GrVkPipelineState::~GrVkPipelineState() {
     // Must have freed all GPU resources before this is destroyed
     SkASSERT(!fPipeline);
+    SkASSERT(!fPendingPipeline);
 }
 
 void GrVkPipelineState::freeGPUResources(GrVkGpu* gpu) {
+    fPendingPipeline.reset();
     fPipeline.reset();
     fDataManager.releaseData();
     for (int i = 0; i < fImmutableSamplers.size(); ++i) {
@@ -271,6 +276,15 @@ void GrVkPipelineState::setRenderTargetState(SkISize colorAttachmentDimensions,
     }
 }
 
+bool GrVkPipelineState::waitForPipeline() {
+    if (fPendingPipeline) {
+        fPendingPipeline->wait();
+        fPipeline = fPendingPipeline->takePipeline();
+        fPendingPipeline.reset();
+    }
+    return fPipeline != nullptr;
+}
+
 void GrVkPipelineState::bindPipeline(const GrVkGpu* gpu, GrVkCommandBuffer* commandBuffer) {
     commandBuffer->bindPipeline(gpu, fPipeline);
 }
@@ -14,6 +14,7 @@
 #include "src/gpu/ganesh/glsl/GrGLSLProgramBuilder.h"
 #include "src/gpu/ganesh/vk/GrVkDescriptorSet.h"
 #include "src/gpu/ganesh/vk/GrVkDescriptorSetManager.h"
+#include "src/gpu/ganesh/vk/GrVkPipeline.h"
 #include "src/gpu/ganesh/vk/GrVkPipelineStateDataManager.h"
 
 class GrPipeline;
@@ -39,8 +40,10 @@ public:
     using UniformInfoArray = GrVkPipelineStateDataManager::UniformInfoArray;
     using UniformHandle = GrGLSLProgramDataManager::UniformHandle;
 
+    // Exactly one of the pipeline and the pending pipeline must be set.
     GrVkPipelineState(GrVkGpu*,
                       sk_sp<const GrVkPipeline>,
+                      std::unique_ptr<GrVkPipeline::Pending>,
                       const GrVkDescriptorSetManager::Handle& samplerDSHandle,
                       const GrGLSLBuiltinUniformHandles& builtinUniformHandles,
                       const UniformInfoArray& uniforms,
@@ -68,6 +71,17 @@ public:
     bool setAndBindInputAttachment(GrVkGpu*, gr_rp<const GrVkDescriptorSet> inputDescSet,
                                    GrVkCommandBuffer*);
 
+    // True while the driver is still compiling the pipeline on another thread.
+    bool isPipelineCompiling() const {
+        return fPendingPipeline && !fPendingPipeline->isFinished();
+    }
+
+    /**
+     * Waits for the driver if it is still compiling the pipeline on another thread. Returns false
+     * if it failed to. None of the other functions may be called unless this has returned true.
+     */
+    bool waitForPipeline();
+
     void bindPipeline(const GrVkGpu* gpu, GrVkCommandBuffer* commandBuffer);
 
     void freeGPUResources(GrVkGpu* gpu);
@@ -95,6 +109,7 @@ private:
 
     // GrManagedResources
     sk_sp<const GrVkPipeline> fPipeline;
+    std::unique_ptr<GrVkPipeline::Pending> fPendingPipeline;
 
     const GrVkDescriptorSetManager::Handle fSamplerDSHandle;
 
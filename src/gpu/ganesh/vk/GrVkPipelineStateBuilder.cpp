@@ -8,8 +8,10 @@
 #include "src/gpu/ganesh/vk/GrVkPipelineStateBuilder.h"
 
 #include "include/gpu/GrDirectContext.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkTraceEvent.h"
+#include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/ganesh/GrAutoLocaleSetter.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrPersistentCacheUtils.h"
@@ -28,7 +30,8 @@ GrVkPipelineState* GrVkPipelineStateBuilder::CreatePipelineState(
         const GrProgramDesc& desc,
         const GrProgramInfo& programInfo,
         VkRenderPass compatibleRenderPass,
-        bool overrideSubpassForResolveLoad) {
+        bool overrideSubpassForResolveLoad,
+        SkTaskGroup* asyncTaskGroup) {
 
     GrVkResourceProvider& resourceProvider = gpu->resourceProvider();
 
@@ -45,7 +48,8 @@ GrVkPipelineState* GrVkPipelineStateBuilder::CreatePipelineState(
         return nullptr;
     }
 
-    return builder.finalize(desc, compatibleRenderPass, overrideSubpassForResolveLoad);
+    return builder.finalize(desc, compatibleRenderPass, overrideSubpassForResolveLoad,
+                            asyncTaskGroup);
 }
 
 GrVkPipelineStateBuilder::GrVkPipelineStateBuilder(GrVkGpu* gpu,
@@ -72,7 +76,7 @@ bool GrVkPipelineStateBuilder::createVkShaderModule(VkShaderStageFlagBits stage,
                                                     std::string* outSPIRV,
                                                     SkSL::Program::Interface* outInterface) {
     if (!GrCompileVkShaderModule(fGpu, sksl, stage, shaderModule,
-                                 stageInfo, settings, outSPIRV, outInterface)) {
+                                 stageInfo, settings, outSPIRV, outInterface, &fCompileTimes)) {
         return false;
     }
     if (outInterface->fRTFlipUniform != SkSL::Program::Interface::kRTFlip_None) {
@@ -101,8 +105,8 @@ static constexpr SkFourByteTag kSKSL_Tag = SkSetFourByteTag('S', 'K', 'S', 'L');
 
 int GrVkPipelineStateBuilder::loadShadersFromCache(SkReadBuffer* cached,
                                                    VkShaderModule outShaderModules[],
-                                                   VkPipelineShaderStageCreateInfo* outStageInfo) {
-    std::string shaders[kGrShaderTypeCount];
+                                                   VkPipelineShaderStageCreateInfo* outStageInfo,
+                                                   std::string shaders[]) {
     SkSL::Program::Interface interfaces[kGrShaderTypeCount];
 
     if (!GrPersistentCacheUtils::UnpackCachedShaders(
@@ -157,8 +161,17 @@ void GrVkPipelineStateBuilder::storeShadersInCache(const std::string shaders[],
 
 GrVkPipelineState* GrVkPipelineStateBuilder::finalize(const GrProgramDesc& desc,
                                                       VkRenderPass compatibleRenderPass,
-                                                      bool overrideSubpassForResolveLoad) {
-    TRACE_EVENT0("skia.shaders", TRACE_FUNC);
+                                                      bool overrideSubpassForResolveLoad,
+                                                      SkTaskGroup* asyncTaskGroup) {
+    // Here we shear off the Vk-specific portion of the Desc in order to create the persistent key.
+    // This is bc Vk only caches the SPIRV code, not the fully compiled program, and that only
+    // depends on the base GrProgramDesc data. The +4 is to include the
+    // kShader_PersistentCacheKeyType code the Vulkan backend adds to the key right after the base
+    // key. The compile timings are reported under the same key.
+    sk_sp<SkData> persistentKey = SkData::MakeWithoutCopy(desc.asKey(),
+                                                          desc.initialKeyLength() + 4);
+    TRACE_EVENT1("skia.shaders", TRACE_FUNC, "key", SkChecksum::Hash32(persistentKey->data(),
+                                                                         persistentKey->size()));
 
     VkDescriptorSetLayout dsLayout[GrVkUniformHandler::kDescSetCount];
     VkShaderModule shaderModules[kGrShaderTypeCount] = { VK_NULL_HANDLE,
@@ -196,22 +209,19 @@ GrVkPipelineState* GrVkPipelineStateBuilder::finalize(const GrProgramDesc& desc,
     SkFourByteTag shaderType = 0;
     auto persistentCache = fGpu->getContext()->priv().getPersistentCache();
     if (persistentCache) {
-        // Here we shear off the Vk-specific portion of the Desc in order to create the
-        // persistent key. This is bc Vk only caches the SPIRV code, not the fully compiled
-        // program, and that only depends on the base GrProgramDesc data.
-        // The +4 is to include the kShader_PersistentCacheKeyType code the Vulkan backend adds
-        // to the key right after the base key.
-        sk_sp<SkData> key = SkData::MakeWithoutCopy(desc.asKey(), desc.initialKeyLength()+4);
-        cached = persistentCache->load(*key);
+        cached = persistentCache->load(*persistentKey);
         if (cached) {
             reader.setMemory(cached->data(), cached->size());
             shaderType = GrPersistentCacheUtils::GetType(&reader);
         }
     }
 
+    // The SPIR-V keys the shader stage libraries, if the pipeline is linked from them.
+    std::string spirv[kGrShaderTypeCount];
     int numShaderStages = 0;
     if (kSPIRV_Tag == shaderType) {
-        numShaderStages = this->loadShadersFromCache(&reader, shaderModules, shaderStageInfo);
+        numShaderStages = this->loadShadersFromCache(&reader, shaderModules, shaderStageInfo,
+                                                     spirv);
     }
 
     // Proceed from sources if we didn't get a SPIRV cache (or the cache was invalid)
@@ -260,6 +270,10 @@ GrVkPipelineState* GrVkPipelineStateBuilder::finalize(const GrProgramDesc& desc,
             return nullptr;
         }
 
+        for (int i = 0; i < kGrShaderTypeCount; ++i) {
+            spirv[i] = shaders[i];
+        }
+
         if (persistentCache && !cached) {
             bool isSkSL = false;
             if (fGpu->getContext()->priv().options().fShaderCacheStrategy ==
@@ -319,9 +333,29 @@ GrVkPipelineState* GrVkPipelineStateBuilder::finalize(const GrProgramDesc& desc,
          fGpu->vkCaps().programInfoWillUseDiscardableMSAA(fProgramInfo))) {
         subpass = 1;
     }
+
+    GrVkPipeline::LibraryInfo libraryInfo;
+    libraryInfo.fVertexSPIRV = spirv[kVertex_GrShaderType];
+    libraryInfo.fFragmentSPIRV = spirv[kFragment_GrShaderType];
+    libraryInfo.fLayoutInfo = &layoutCreateInfo;
+
+    if (asyncTaskGroup) {
+        // The task destroys the shader modules and, if the driver fails, the layout.
+        std::unique_ptr<GrVkPipeline::Pending> pendingPipeline =
+                resourceProvider.makePipelineAsync(asyncTaskGroup, fProgramInfo, shaderStageInfo,
+                                                   numShaderStages, compatibleRenderPass,
+                                                   pipelineLayout, subpass, &libraryInfo);
+        resourceProvider.pipelineStateCache()->stats()->incNumAsyncCompilations();
+        // The driver's pipeline compile happens later, on the task group, and isn't included.
+        fGpu->addShaderCompileTiming(*persistentKey, fCompileTimes);
+        return this->makePipelineState(nullptr, std::move(pendingPipeline), samplerDSHandle);
+    }
+
+    auto start = skgpu::StdSteadyClock::now();
     sk_sp<const GrVkPipeline> pipeline = resourceProvider.makePipeline(
             fProgramInfo, shaderStageInfo, numShaderStages, compatibleRenderPass, pipelineLayout,
-            subpass);
+            subpass, &libraryInfo);
+    fCompileTimes.fDriver += skgpu::StdSteadyClock::now() - start;
 
     for (int i = 0; i < kGrShaderTypeCount; ++i) {
         // This if check should not be needed since calling destroy on a VK_NULL_HANDLE is allowed.
@@ -338,8 +372,17 @@ GrVkPipelineState* GrVkPipelineStateBuilder::finalize(const GrProgramDesc& desc,
         return nullptr;
     }
 
+    fGpu->addShaderCompileTiming(*persistentKey, fCompileTimes);
+    return this->makePipelineState(std::move(pipeline), nullptr, samplerDSHandle);
+}
+
+GrVkPipelineState* GrVkPipelineStateBuilder::makePipelineState(
+        sk_sp<const GrVkPipeline> pipeline,
+        std::unique_ptr<GrVkPipeline::Pending> pendingPipeline,
+        const GrVkDescriptorSetManager::Handle& samplerDSHandle) {
     return new GrVkPipelineState(fGpu,
                                  std::move(pipeline),
+                                 std::move(pendingPipeline),
                                  samplerDSHandle,
                                  fUniformHandles,
                                  fUniformHandler.fUniforms,
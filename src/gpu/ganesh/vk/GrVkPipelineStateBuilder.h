@@ -9,6 +9,7 @@
 #define GrVkPipelineStateBuilder_DEFINED
 
 #include "include/gpu/vk/GrVkTypes.h"
+#include "src/gpu/PipelineUtils.h"
 #include "src/gpu/ganesh/GrPipeline.h"
 #include "src/gpu/ganesh/glsl/GrGLSLProgramBuilder.h"
 #include "src/gpu/ganesh/vk/GrVkPipelineState.h"
@@ -21,12 +22,15 @@ class GrProgramDesc;
 class GrVkGpu;
 class GrVkRenderPass;
 class SkReadBuffer;
+class SkTaskGroup;
 
 class GrVkPipelineStateBuilder : public GrGLSLProgramBuilder {
 public:
     /** Generates a pipeline state.
      *
-     * The return GrVkPipelineState implements the supplied GrProgramInfo.
+     * The return GrVkPipelineState implements the supplied GrProgramInfo. If asyncTaskGroup is
+     * not null, the driver compiles the VkPipeline on it and binding the pipeline state waits until
+     * it is done (see GrVkPipelineState::waitForPipeline()).
      *
      * @return the created pipeline if generation was successful; nullptr otherwise
      */
@@ -34,7 +38,8 @@ public:
                                                   const GrProgramDesc&,
                                                   const GrProgramInfo&,
                                                   VkRenderPass compatibleRenderPass,
-                                                  bool overrideSubpassForResolveLoad);
+                                                  bool overrideSubpassForResolveLoad,
+                                                  SkTaskGroup* asyncTaskGroup = nullptr);
 
     const GrCaps* caps() const override;
 
@@ -46,11 +51,16 @@ private:
     GrVkPipelineStateBuilder(GrVkGpu*, const GrProgramDesc&, const GrProgramInfo&);
 
     GrVkPipelineState* finalize(const GrProgramDesc&, VkRenderPass compatibleRenderPass,
-                                bool overrideSupbassForResolveLoad);
+                                bool overrideSupbassForResolveLoad, SkTaskGroup* asyncTaskGroup);
 
-    // returns number of shader stages
+    GrVkPipelineState* makePipelineState(sk_sp<const GrVkPipeline>,
+                                         std::unique_ptr<GrVkPipeline::Pending>,
+                                         const GrVkDescriptorSetManager::Handle& samplerDSHandle);
+
+    // returns number of shader stages and fills out 'outSPIRV' with the cached SPIR-V
     int loadShadersFromCache(SkReadBuffer* cached, VkShaderModule outShaderModules[],
-                             VkPipelineShaderStageCreateInfo* outStageInfo);
+                             VkPipelineShaderStageCreateInfo* outStageInfo,
+                             std::string outSPIRV[]);
 
     void storeShadersInCache(const std::string shaders[],
                              const SkSL::Program::Interface[],
@@ -79,6 +89,9 @@ private:
     GrVkVaryingHandler fVaryingHandler;
     GrVkUniformHandler fUniformHandler;
 
+    // Reported to GrGpu::addShaderCompileTiming() once the pipeline state is built.
+    skgpu::ShaderCompileTimes fCompileTimes;
+
     using INHERITED = GrGLSLProgramBuilder;
 };
 
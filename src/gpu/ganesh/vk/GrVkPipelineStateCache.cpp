@@ -7,6 +7,7 @@
 
 #include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrFragmentProcessor.h"
 #include "src/gpu/ganesh/GrProcessor.h"
@@ -92,9 +93,17 @@ GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::findOrCreatePipelin
         return nullptr;
     }
 
+    // Precompiles only compile asynchronously when the flush asks for it (see
+    // GrVkGpu::willBindProgram()); they already happen off the critical path otherwise.
+    const GrContextOptions& options = fGpu->getContext()->priv().options();
+    SkTaskGroup* asyncTaskGroup = options.fAsyncPipelineCompilation
+                                          ? fGpu->getContext()->priv().getTaskGroup()
+                                          : nullptr;
+
     Stats::ProgramCacheResult stat;
     auto tmp = this->findOrCreatePipelineStateImpl(desc, programInfo, compatibleRenderPass,
-                                                   overrideSubpassForResolveLoad, &stat);
+                                                   overrideSubpassForResolveLoad, &stat,
+                                                   asyncTaskGroup);
     if (!tmp) {
         fStats.incNumInlineCompilationFailures();
     } else {
@@ -109,7 +118,8 @@ GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::findOrCreatePipelin
         const GrProgramInfo& programInfo,
         VkRenderPass compatibleRenderPass,
         bool overrideSubpassForResolveLoad,
-        Stats::ProgramCacheResult* stat) {
+        Stats::ProgramCacheResult* stat,
+        SkTaskGroup* asyncTaskGroup) {
     if (stat) {
         *stat = Stats::ProgramCacheResult::kHit;
     }
@@ -119,8 +129,11 @@ GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::findOrCreatePipelin
         if (stat) {
             *stat = Stats::ProgramCacheResult::kMiss;
         }
+        auto start = skgpu::StdSteadyClock::now();
         GrVkPipelineState* pipelineState(GrVkPipelineStateBuilder::CreatePipelineState(
-                fGpu, desc, programInfo, compatibleRenderPass, overrideSubpassForResolveLoad));
+                fGpu, desc, programInfo, compatibleRenderPass, overrideSubpassForResolveLoad,
+                asyncTaskGroup));
+        fGpu->counters()->addPipelineCompile(start);
         if (!pipelineState) {
             return nullptr;
         }
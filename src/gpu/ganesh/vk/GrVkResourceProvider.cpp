@@ -91,6 +91,10 @@ void GrVkResourceProvider::init() {
     fDescriptorSetManagers.emplace_back(dsm);
     SkASSERT(2 == fDescriptorSetManagers.size());
     fInputDSHandle = GrVkDescriptorSetManager::Handle(1);
+
+    if (fGpu->vkCaps().supportsGraphicsPipelineLibrary()) {
+        fPipelineLibraryCache = std::make_unique<GrVkPipelineLibraryCache>(fGpu);
+    }
 }
 
 sk_sp<const GrVkPipeline> GrVkResourceProvider::makePipeline(
@@ -99,9 +103,25 @@ sk_sp<const GrVkPipeline> GrVkResourceProvider::makePipeline(
         int shaderStageCount,
         VkRenderPass compatibleRenderPass,
         VkPipelineLayout layout,
-        uint32_t subpass) {
+        uint32_t subpass,
+        const GrVkPipeline::LibraryInfo* libraryInfo) {
     return GrVkPipeline::Make(fGpu, programInfo, shaderStageInfo, shaderStageCount,
-                              compatibleRenderPass, layout, this->pipelineCache(), subpass);
+                              compatibleRenderPass, layout, this->pipelineCache(), subpass,
+                              libraryInfo);
+}
+
+std::unique_ptr<GrVkPipeline::Pending> GrVkResourceProvider::makePipelineAsync(
+        SkTaskGroup* taskGroup,
+        const GrProgramInfo& programInfo,
+        VkPipelineShaderStageCreateInfo* shaderStageInfo,
+        int shaderStageCount,
+        VkRenderPass compatibleRenderPass,
+        VkPipelineLayout layout,
+        uint32_t subpass,
+        const GrVkPipeline::LibraryInfo* libraryInfo) {
+    return GrVkPipeline::MakeAsync(taskGroup, fGpu, programInfo, shaderStageInfo,
+                                   shaderStageCount, compatibleRenderPass, layout,
+                                   this->pipelineCache(), subpass, libraryInfo);
 }
 
 // To create framebuffers, we first need to create a simple RenderPass that is
@@ -269,10 +289,12 @@ GrVkPipelineState* GrVkResourceProvider::findOrCreateCompatiblePipelineState(
         const GrProgramDesc& desc,
         const GrProgramInfo& programInfo,
         VkRenderPass compatibleRenderPass,
-        GrThreadSafePipelineBuilder::Stats::ProgramCacheResult* stat) {
+        GrThreadSafePipelineBuilder::Stats::ProgramCacheResult* stat,
+        SkTaskGroup* asyncTaskGroup) {
 
     auto tmp =  fPipelineStateCache->findOrCreatePipelineState(desc, programInfo,
-                                                               compatibleRenderPass, stat);
+                                                               compatibleRenderPass, stat,
+                                                               asyncTaskGroup);
     if (!tmp) {
         fPipelineStateCache->stats()->incNumPreCompilationFailures();
     } else {
@@ -505,6 +527,9 @@ void GrVkResourceProvider::destroyResources() {
     fYcbcrConversions.reset();
 
     fPipelineStateCache->release();
+    if (fPipelineLibraryCache) {
+        fPipelineLibraryCache->release();
+    }
 
     GR_VK_CALL(fGpu->vkInterface(), DestroyPipelineCache(fGpu->device(), fPipelineCache, nullptr));
     fPipelineCache = VK_NULL_HANDLE;
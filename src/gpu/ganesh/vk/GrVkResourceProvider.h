@@ -22,6 +22,8 @@
 #include "src/gpu/ganesh/GrThreadSafePipelineBuilder.h"
 #include "src/gpu/ganesh/vk/GrVkDescriptorPool.h"
 #include "src/gpu/ganesh/vk/GrVkDescriptorSetManager.h"
+#include "src/gpu/ganesh/vk/GrVkPipeline.h"
+#include "src/gpu/ganesh/vk/GrVkPipelineLibraryCache.h"
 #include "src/gpu/ganesh/vk/GrVkPipelineStateBuilder.h"
 #include "src/gpu/ganesh/vk/GrVkRenderPass.h"
 #include "src/gpu/ganesh/vk/GrVkSampler.h"
@@ -36,6 +38,7 @@ class GrVkPrimaryCommandBuffer;
 class GrVkRenderTarget;
 class GrVkSecondaryCommandBuffer;
 class GrVkUniformHandler;
+class SkTaskGroup;
 
 class GrVkResourceProvider {
 public:
@@ -53,12 +56,28 @@ public:
     // Set up any initial vk objects
     void init();
 
+    // Returns null if the device doesn't support graphics pipeline libraries.
+    GrVkPipelineLibraryCache* pipelineLibraryCache() { return fPipelineLibraryCache.get(); }
+
     sk_sp<const GrVkPipeline> makePipeline(const GrProgramInfo&,
                                            VkPipelineShaderStageCreateInfo* shaderStageInfo,
                                            int shaderStageCount,
                                            VkRenderPass compatibleRenderPass,
                                            VkPipelineLayout layout,
-                                           uint32_t subpass);
+                                           uint32_t subpass,
+                                           const GrVkPipeline::LibraryInfo* libraryInfo = nullptr);
+
+    // Like makePipeline() but the driver compiles the pipeline on 'taskGroup'. See
+    // GrVkPipeline::MakeAsync().
+    std::unique_ptr<GrVkPipeline::Pending> makePipelineAsync(
+            SkTaskGroup* taskGroup,
+            const GrProgramInfo&,
+            VkPipelineShaderStageCreateInfo* shaderStageInfo,
+            int shaderStageCount,
+            VkRenderPass compatibleRenderPass,
+            VkPipelineLayout layout,
+            uint32_t subpass,
+            const GrVkPipeline::LibraryInfo* libraryInfo = nullptr);
 
     GR_DEFINE_RESOURCE_HANDLE_CLASS(CompatibleRPHandle)
 
@@ -147,7 +166,8 @@ public:
             const GrProgramDesc&,
             const GrProgramInfo&,
             VkRenderPass compatibleRenderPass,
-            GrThreadSafePipelineBuilder::Stats::ProgramCacheResult* stat);
+            GrThreadSafePipelineBuilder::Stats::ProgramCacheResult* stat,
+            SkTaskGroup* asyncTaskGroup = nullptr);
 
     sk_sp<const GrVkPipeline> findOrCreateMSAALoadPipeline(
             const GrVkRenderPass& renderPass,
@@ -234,9 +254,10 @@ private:
         GrVkPipelineState* findOrCreatePipelineState(const GrProgramDesc& desc,
                                                      const GrProgramInfo& programInfo,
                                                      VkRenderPass compatibleRenderPass,
-                                                     Stats::ProgramCacheResult* stat) {
+                                                     Stats::ProgramCacheResult* stat,
+                                                     SkTaskGroup* asyncTaskGroup = nullptr) {
             return this->findOrCreatePipelineStateImpl(desc, programInfo, compatibleRenderPass,
-                                                       false, stat);
+                                                       false, stat, asyncTaskGroup);
         }
 
     private:
@@ -246,7 +267,8 @@ private:
                                                          const GrProgramInfo&,
                                                          VkRenderPass compatibleRenderPass,
                                                          bool overrideSubpassForResolveLoad,
-                                                         Stats::ProgramCacheResult*);
+                                                         Stats::ProgramCacheResult*,
+                                                         SkTaskGroup* asyncTaskGroup = nullptr);
 
         struct DescHash {
             uint32_t operator()(const GrProgramDesc& desc) const {
@@ -325,6 +347,9 @@ private:
     // Cache of GrVkPipelineStates
     sk_sp<PipelineStateCache> fPipelineStateCache;
 
+    // Shader stages and other pipeline parts shared by the pipelines of fPipelineStateCache
+    std::unique_ptr<GrVkPipelineLibraryCache> fPipelineLibraryCache;
+
     skia_private::STArray<4, std::unique_ptr<GrVkDescriptorSetManager>> fDescriptorSetManagers;
 
     GrVkDescriptorSetManager::Handle fUniformDSHandle;
@@ -9,6 +9,7 @@
 
 #include "include/gpu/GrDirectContext.h"
 #include "src/core/SkTraceEvent.h"
+#include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/PipelineUtils.h"
 #include "src/gpu/ganesh/GrDataUtils.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
@@ -68,7 +69,8 @@ bool GrCompileVkShaderModule(GrVkGpu* gpu,
                              VkPipelineShaderStageCreateInfo* stageInfo,
                              const SkSL::ProgramSettings& settings,
                              std::string* outSPIRV,
-                             SkSL::Program::Interface* outInterface) {
+                             SkSL::Program::Interface* outInterface,
+                             skgpu::ShaderCompileTimes* times) {
     TRACE_EVENT0("skia.shaders", "CompileVkShaderModule");
     skgpu::ShaderErrorHandler* errorHandler = gpu->getContext()->priv().getShaderErrorHandler();
     if (!skgpu::SkSLToSPIRV(gpu->vkCaps().shaderCaps(),
@@ -77,11 +79,17 @@ bool GrCompileVkShaderModule(GrVkGpu* gpu,
                             settings,
                             outSPIRV,
                             outInterface,
-                            errorHandler)) {
+                            errorHandler,
+                            times)) {
         return false;
     }
 
-    return GrInstallVkShaderModule(gpu, *outSPIRV, stage, shaderModule, stageInfo);
+    auto start = skgpu::StdSteadyClock::now();
+    bool installed = GrInstallVkShaderModule(gpu, *outSPIRV, stage, shaderModule, stageInfo);
+    if (times) {
+        times->fDriver += skgpu::StdSteadyClock::now() - start;
+    }
+    return installed;
 }
 
 bool GrInstallVkShaderModule(GrVkGpu* gpu,
@@ -12,6 +12,7 @@
 #include "include/gpu/vk/GrVkTypes.h"
 #include "include/private/base/SkMacros.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/gpu/PipelineUtils.h"
 #include "src/gpu/ganesh/GrColor.h"
 #include "src/gpu/ganesh/GrDataUtils.h"
 #include "src/gpu/vk/VulkanInterface.h"
@@ -114,7 +115,8 @@ bool GrCompileVkShaderModule(GrVkGpu* gpu,
                              VkPipelineShaderStageCreateInfo* stageInfo,
                              const SkSL::ProgramSettings& settings,
                              std::string* outSPIRV,
-                             SkSL::Program::Interface* outInterface);
+                             SkSL::Program::Interface* outInterface,
+                             skgpu::ShaderCompileTimes* times = nullptr);
 
 bool GrInstallVkShaderModule(GrVkGpu* gpu,
                              const std::string& spirv,
@@ -45,8 +45,13 @@ void Caps::finishInitialization(const ContextOptions& options) {
     fGlyphCacheTextureMaximumBytes = options.fGlyphCacheTextureMaximumBytes;
     fMinDistanceFieldFontSize = options.fMinDistanceFieldFontSize;
     fGlyphsAsPathsFontSize = options.fGlyphsAsPathsFontSize;
+    fMaxGlyphMaskDimension = options.fMaxGlyphMaskDimension;
+    fMultiChannelDistanceFieldText = options.fMultiChannelDistanceFieldText;
+    fDrawSlugGlyphsAsPaths = options.fDrawSlugGlyphsAsPaths;
     fAllowMultipleGlyphCacheTextures = options.fAllowMultipleGlyphCacheTextures;
     fSupportBilerpFromGlyphAtlas = options.fSupportBilerpFromGlyphAtlas;
+    fEnableOcclusionCulling = options.fEnableOcclusionCulling;
+    fGenerateMipmapsWithCompute = options.fGenerateMipmapsWithCompute;
     if (options.fDisableCachedGlyphUploads) {
         fRequireOrderedRecordings = true;
     }
@@ -144,9 +149,11 @@ sktext::gpu::SDFTControl Caps::getSDFTControl(bool useSDFTForSmallText) const {
             useSDFTForSmallText,
             true, /*ableToUsePerspectiveSDFT*/
             this->minDistanceFieldFontSize(),
-            this->glyphsAsPathsFontSize()};
+            this->glyphsAsPathsFontSize(),
+            this->maxGlyphMaskDimension(),
+            this->multiChannelDistanceFieldText()};
 #else
-    return sktext::gpu::SDFTControl{};
+    return sktext::gpu::SDFTControl{this->maxGlyphMaskDimension()};
 #endif
 }
 
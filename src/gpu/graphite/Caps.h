@@ -234,6 +234,9 @@ public:
     // Returns whether compute shaders are supported.
     bool computeSupport() const { return fComputeSupport; }
 
+    // Returns whether command buffers can time their draws with timestamp queries.
+    bool gpuTimestampSupport() const { return fGpuTimestampSupport; }
+
     /**
      * Returns true if the given backend supports importing AHardwareBuffers. This will only
      * ever be supported on Android devices with API level >= 26.
@@ -255,6 +258,9 @@ public:
 
     float minDistanceFieldFontSize() const { return fMinDistanceFieldFontSize; }
     float glyphsAsPathsFontSize() const { return fGlyphsAsPathsFontSize; }
+    int maxGlyphMaskDimension() const { return fMaxGlyphMaskDimension; }
+    bool multiChannelDistanceFieldText() const { return fMultiChannelDistanceFieldText; }
+    bool drawSlugGlyphsAsPaths() const { return fDrawSlugGlyphsAsPaths; }
 
     size_t glyphCacheTextureMaximumBytes() const { return fGlyphCacheTextureMaximumBytes; }
 
@@ -263,6 +269,10 @@ public:
 
     bool requireOrderedRecordings() const { return fRequireOrderedRecordings; }
 
+    bool enableOcclusionCulling() const { return fEnableOcclusionCulling; }
+
+    bool generateMipmapsWithCompute() const { return fGenerateMipmapsWithCompute; }
+
     sktext::gpu::SDFTControl getSDFTControl(bool useSDFTForSmallText) const;
 
 protected:
@@ -334,6 +344,7 @@ protected:
     bool fMSAARenderToSingleSampledSupport = false;
 
     bool fComputeSupport = false;
+    bool fGpuTimestampSupport = false;
     bool fSupportsAHardwareBufferImages = false;
 
 #if defined(GRAPHITE_TEST_UTILS)
@@ -360,9 +371,14 @@ protected:
 
     float fMinDistanceFieldFontSize = 18;
     float fGlyphsAsPathsFontSize = 324;
+    int fMaxGlyphMaskDimension = 256;
+    bool fMultiChannelDistanceFieldText = false;
+    bool fDrawSlugGlyphsAsPaths = false;
 
     bool fAllowMultipleGlyphCacheTextures = true;
     bool fSupportBilerpFromGlyphAtlas = false;
+    bool fEnableOcclusionCulling = false;
+    bool fGenerateMipmapsWithCompute = false;
 
     // Set based on client options
     bool fRequireOrderedRecordings = false;
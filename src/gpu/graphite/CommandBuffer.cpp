@@ -11,6 +11,7 @@
 #include "src/gpu/RefCntedCallback.h"
 #include "src/gpu/graphite/Buffer.h"
 #include "src/gpu/graphite/ComputePipeline.h"
+#include "src/gpu/graphite/GpuDrawTimer.h"
 #include "src/gpu/graphite/GraphicsPipeline.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/Sampler.h"
@@ -38,6 +39,7 @@ void CommandBuffer::resetCommandBuffer() {
     this->releaseResources();
     this->onResetCommandBuffer();
     fBuffersToAsyncMap.clear();
+    fTimedDraws.clear();
 }
 
 void CommandBuffer::trackResource(sk_sp<Resource> resource) {
@@ -72,6 +74,22 @@ SkSpan<const sk_sp<Buffer>> CommandBuffer::buffersToAsyncMapOnSubmit() const {
     return fBuffersToAsyncMap;
 }
 
+void CommandBuffer::collectGpuTimings(GpuDrawTimer* timer) {
+    if (fTimedDraws.empty()) {
+        return;
+    }
+    skia_private::TArray<uint64_t> nanoseconds;
+    nanoseconds.push_back_n(fTimedDraws.size(), ~uint64_t(0));
+    if (!this->onReadGpuTimings(nanoseconds)) {
+        return;
+    }
+    for (int i = 0; i < fTimedDraws.size(); ++i) {
+        if (nanoseconds[i] != ~uint64_t(0)) {
+            timer->add(fTimedDraws[i], nanoseconds[i]);
+        }
+    }
+}
+
 bool CommandBuffer::addRenderPass(const RenderPassDesc& renderPassDesc,
                                   sk_sp<Texture> colorTexture,
                                   sk_sp<Texture> resolveTexture,
@@ -17,6 +17,7 @@
 #include "src/gpu/graphite/CommandTypes.h"
 #include "src/gpu/graphite/DrawTypes.h"
 #include "src/gpu/graphite/DrawWriter.h"
+#include "src/gpu/graphite/GraphicsPipelineDesc.h"
 #include "src/gpu/graphite/Resource.h"
 
 namespace skgpu {
@@ -29,6 +30,7 @@ namespace skgpu::graphite {
 class Buffer;
 class DispatchGroup;
 class DrawPass;
+class GpuDrawTimer;
 class SharedContext;
 class GraphicsPipeline;
 class Sampler;
@@ -112,9 +114,21 @@ public:
     void setReplayTranslation(SkIVector translation) { fReplayTranslation = translation; }
     void clearReplayTranslation() { fReplayTranslation = {0, 0}; }
 
+    // Set by the QueueManager each time it hands out the command buffer. Backends that support
+    // timestamps (Caps::gpuTimestampSupport()) only time draws while this is on.
+    void setGpuTimingsEnabled(bool enabled) { fGpuTimingsEnabled = enabled; }
+
+    // Adds the times of the draws timed by this command buffer to the timer. Must only be called
+    // once the command buffer has finished on the GPU.
+    void collectGpuTimings(GpuDrawTimer*);
+
 protected:
     CommandBuffer();
 
+    bool gpuTimingsEnabled() const { return fGpuTimingsEnabled; }
+    // Backends call this for each run of draws they time, in the order they record them.
+    void addTimedDraws(const GraphicsPipelineDesc& desc) { fTimedDraws.push_back(desc); }
+
     SkISize fRenderPassSize;
     SkIVector fReplayTranslation;
 
@@ -155,6 +169,10 @@ private:
     virtual bool onSynchronizeBufferToCpu(const Buffer*, bool* outDidResultInWork) = 0;
     virtual bool onClearBuffer(const Buffer*, size_t offset, size_t size) = 0;
 
+    // Fills in the GPU time of each run of draws passed to addTimedDraws(), or ~0 for runs whose
+    // time could not be read.
+    virtual bool onReadGpuTimings(SkSpan<uint64_t> nanoseconds) { return false; }
+
 #ifdef SK_DEBUG
     bool fHasWork = false;
 #endif
@@ -165,6 +183,9 @@ private:
     TrackedResourceArray<gr_cb<Resource>> fCommandBufferResources;
     skia_private::TArray<sk_sp<RefCntedCallback>> fFinishedProcs;
     skia_private::TArray<sk_sp<Buffer>> fBuffersToAsyncMap;
+
+    bool fGpuTimingsEnabled = false;
+    skia_private::TArray<GraphicsPipelineDesc> fTimedDraws;
 };
 
 } // namespace skgpu::graphite
@@ -8,6 +8,7 @@
 #include "include/gpu/graphite/Context.h"
 
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkTraceMemoryDump.h"
 #include "include/effects/SkRuntimeEffect.h"
@@ -36,6 +37,7 @@
 #include "src/gpu/graphite/Image_Graphite.h"
 #include "src/gpu/graphite/KeyContext.h"
 #include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PipelineManifest.h"
 #include "src/gpu/graphite/QueueManager.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/RecordingPriv.h"
@@ -816,10 +818,15 @@ size_t Context::currentBudgetedBytes() const {
 void Context::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     ASSERT_SINGLE_OWNER
     fResourceProvider->dumpMemoryStatistics(traceMemoryDump);
+    fSharedContext->dumpMemoryStatistics(traceMemoryDump);
     // TODO: What is the graphite equivalent for the text blob cache and how do we print out its
     // used bytes here (see Ganesh implementation).
 }
 
+skgpu::GpuCounters Context::getGpuCounters() const {
+    return fSharedContext->counters()->snapshot();
+}
+
 bool Context::isDeviceLost() const {
     return fSharedContext->isDeviceLost();
 }
@@ -828,6 +835,39 @@ bool Context::supportsProtectedContent() const {
     return fSharedContext->isProtected() == Protected::kYes;
 }
 
+bool Context::supportsGpuDrawTimings() const {
+    return fSharedContext->caps()->gpuTimestampSupport();
+}
+
+void Context::setGpuDrawTimingsEnabled(bool enabled) {
+    ASSERT_SINGLE_OWNER
+
+    fQueueManager->setGpuDrawTimingsEnabled(enabled);
+}
+
+Context::GpuDrawTimings Context::takeGpuDrawTimings() {
+    ASSERT_SINGLE_OWNER
+
+    this->checkAsyncWorkCompletion();
+    return fQueueManager->takeGpuDrawTimings();
+}
+
+sk_sp<SkData> Context::serializePipelineKeys() const {
+    ASSERT_SINGLE_OWNER
+
+    skia_private::TArray<PipelineManifest::Entry> entries =
+            fSharedContext->globalCache()->pipelineManifestEntries();
+    return PipelineManifest::Serialize(fSharedContext.get(), entries);
+}
+
+sk_sp<SkData> Context::serializePipelineMisses() const {
+    ASSERT_SINGLE_OWNER
+
+    skia_private::TArray<PipelineManifest::Entry> entries =
+            fSharedContext->globalCache()->pipelineMissEntries();
+    return PipelineManifest::Serialize(fSharedContext.get(), entries);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 
 #if defined(GRAPHITE_TEST_UTILS)
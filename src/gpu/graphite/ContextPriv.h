@@ -49,6 +49,9 @@ public:
     ResourceProvider* resourceProvider() const {
         return fContext->fResourceProvider.get();
     }
+    SharedContext* sharedContext() const {
+        return fContext->fSharedContext.get();
+    }
 
 #if defined(GRAPHITE_TEST_UTILS)
     void startCapture() {
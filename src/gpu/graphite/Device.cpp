@@ -46,13 +46,16 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkPathEffect.h"
 #include "include/core/SkStrokeRec.h"
+#include "include/effects/SkRuntimeEffect.h"
 
 #include "src/core/SkBlenderBase.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkConvertPixels.h"
+#include "src/core/SkDrawShadowInfo.h"
 #include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkImagePriv.h"
+#include "src/core/SkKnownRuntimeEffects.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkPaintPriv.h"
 #include "src/core/SkRRectPriv.h"
@@ -766,6 +769,50 @@ void Device::drawVertices(const SkVertices* vertices, sk_sp<SkBlender> blender,
                        skipColorXform);
 }
 
+void Device::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
+    const SkMatrix& localToDevice = this->localToDevice();
+    SkDrawShadowMetrics::RRectShadow shadows[2];
+    if (!SkDrawShadowMetrics::GetRRectShadows(path, rec, localToDevice, &shadows[0], &shadows[1])) {
+        // Tessellate the shadows on the CPU and draw them as vertices.
+        this->SkDevice::drawShadow(path, rec);
+        return;
+    }
+
+    // Draw the rrect shadows analytically, with a known runtime effect that evaluates the falloff
+    // per pixel. Every such shadow shares the same pipeline, so they batch together.
+    SkRuntimeEffect* effect =
+            GetKnownRuntimeEffect(SkKnownRuntimeEffects::StableKey::kRRectShadow);
+    const SkColor colors[2] = {rec.fAmbientColor, rec.fSpotColor};
+    for (int i = 0; i < 2; ++i) {
+        const SkDrawShadowMetrics::RRectShadow& shadow = shadows[i];
+        if (shadow.fRRect.isEmpty()) {
+            continue;
+        }
+        // The ctm is a similarity that keeps rects rects, so the radius scales isotropically.
+        SkRect devRect = localToDevice.mapRect(shadow.fRRect.rect());
+        float devRadius = shadow.fRRect.isOval()
+                ? 0.5f * devRect.width()
+                : SkScalarAbs(SkRRectPriv::GetSimpleRadii(shadow.fRRect).fX *
+                              (localToDevice[SkMatrix::kMScaleX] +
+                               localToDevice[SkMatrix::kMSkewX]));
+        struct {
+            SkRect    fRect;
+            float     fRadius;
+            float     fBlurWidth;
+            SkColor4f fColor;
+        } uniforms = {devRect, devRadius, shadow.fBlurWidth, SkColor4f::FromColor(colors[i])};
+
+        SkPaint paint;
+        paint.setShader(effect->makeShader(SkData::MakeWithCopy(&uniforms, sizeof(uniforms)),
+                                           /*children=*/nullptr, /*childCount=*/0));
+        // The shadow is transparent at the edge of its bounds, so it doesn't need AA.
+        paint.setAntiAlias(false);
+        this->drawGeometry(Transform::Identity(), Geometry(Shape(devRect)), paint,
+                           DefaultFillStyle(),
+                           DrawFlags::kIgnorePathEffect | DrawFlags::kIgnoreMaskFilter);
+    }
+}
+
 bool Device::drawAsTiledImageRect(SkCanvas* canvas,
                                   const SkImage* image,
                                   const SkRect* src,
@@ -1123,7 +1170,8 @@ void Device::drawGeometry(const Transform& localToDevice,
     // then we assume that the renderer chosen in PathAtlas::addShape() will have
     // single-channel coverage, require AA bounds outsetting, and have a single renderStep.
     auto [renderer, pathAtlas] =
-            this->chooseRenderer(localToDevice, geometry, style, /*requireMSAA=*/false);
+            this->chooseRenderer(localToDevice, geometry, style, /*requireMSAA=*/false,
+                                 /*allowPathAtlas=*/!(flags & DrawFlags::kNoPathAtlas));
     if (!renderer && !pathAtlas) {
         SKGPU_LOG_W("Skipping draw with no supported renderer or PathAtlas.");
         return;
@@ -1198,11 +1246,13 @@ void Device::drawGeometry(const Transform& localToDevice,
         }
 
         if (!atlasMask) {
-            SKGPU_LOG_E("Failed to add shape to atlas!");
-            // TODO(b/285195175): This can happen if the atlas is not large enough or a compatible
-            // atlas texture cannot be created. Handle the first case in `chooseRenderer` and make
-            // sure that the atlas path renderer is not chosen if the path is larger than the atlas
-            // texture.
+            // This can happen if the shape is larger than the atlas or a compatible atlas texture
+            // cannot be created. Nothing has been recorded for the draw yet, so draw it again
+            // with a renderer that doesn't need the atlas.
+            SKGPU_LOG_D("Failed to add shape to atlas, falling back to a path renderer.");
+            this->drawGeometry(localToDevice, geometry, paint, style,
+                               flags | DrawFlags::kNoPathAtlas,
+                               std::move(primitiveBlender), skipColorXform);
             return;
         }
         // Since addShape() was successful we should have a valid Renderer now.
@@ -1294,12 +1344,18 @@ void Device::drawGeometry(const Transform& localToDevice,
         }
     }
 
-    // TODO: If 'fullyOpaque' is true, it might be useful to store the draw bounds and Z in a
-    // special occluders list for filtering the DrawList/DrawPass when flushing.
-    // const bool fullyOpaque = !dependsOnDst &&
-    //                          clipOrder == DrawOrder::kNoIntersection &&
-    //                          shape.isRect() &&
-    //                          localToDevice.type() <= Transform::Type::kRectStaysRect;
+    // A filled rect with an opaque paint that isn't clipped by anything but the scissor overwrites
+    // every pixel it fully covers, so earlier draws within those pixels can be culled at flush.
+    // Coverage AA only affects partially covered edge pixels, which recordOccluder() rounds away.
+    if (fRecorder->priv().caps()->enableOcclusionCulling() &&
+        styleType == SkStrokeRec::kFill_Style &&
+        geometry.isShape() && geometry.shape().isRect() && !geometry.shape().inverted() &&
+        localToDevice.type() <= Transform::Type::kRectStaysRect &&
+        clipElements.empty() && !clip.shader() && !paint_depends_on_dst(shading)) {
+        Rect occluderBounds = localToDevice.mapRect(geometry.shape().rect());
+        occluderBounds.intersect(SkRect::Make(clip.scissor()));
+        fDC->recordOccluder(occluderBounds, order.depth());
+    }
 
     // Post-draw book keeping (bounds manager, depth tracking, etc.)
     fColorDepthBoundsManager->recordDraw(clip.drawBounds(), order.paintOrder());
@@ -1362,7 +1418,8 @@ void Device::drawClipShape(const Transform& localToDevice,
 std::pair<const Renderer*, PathAtlas*> Device::chooseRenderer(const Transform& localToDevice,
                                                               const Geometry& geometry,
                                                               const SkStrokeRec& style,
-                                                              bool requireMSAA) const {
+                                                              bool requireMSAA,
+                                                              bool allowPathAtlas) const {
     const RendererProvider* renderers = fRecorder->priv().rendererProvider();
     SkASSERT(renderers);
     SkStrokeRec::Style type = style.getStyle();
@@ -1373,6 +1430,9 @@ std::pair<const Renderer*, PathAtlas*> Device::chooseRenderer(const Transform& l
         if (!rendererData.isSDF) {
             return {renderers->bitmapText(rendererData.isLCD), nullptr};
         }
+        if (rendererData.isMultiChannelSDF) {
+            return {renderers->multiChannelSDFText(), nullptr};
+        }
         return {renderers->sdfText(rendererData.isLCD), nullptr};
     } else if (geometry.isVertices()) {
         SkVerticesPriv info(geometry.vertices()->priv());
@@ -1433,24 +1493,26 @@ std::pair<const Renderer*, PathAtlas*> Device::chooseRenderer(const Transform& l
     }
 
     // Use an atlas only if an MSAA technique isn't required.
-    if (!requireMSAA && pathAtlas) {
+    if (!requireMSAA && allowPathAtlas && pathAtlas) {
         // Don't use a coverage mask renderer if the shape is too large for the atlas such that it
         // cannot be efficiently rasterized. The only exception is if hardware MSAA is not supported
         // as a fallback or one of the atlas strategies was explicitly requested.
         //
-        // If the hardware doesn't support MSAA and anti-aliasing is required, then we always render
-        // paths with atlasing.
-        if (!msaaSupported || strategy == PathRendererStrategy::kComputeAnalyticAA ||
-            strategy == PathRendererStrategy::kRasterAA) {
-            return {nullptr, pathAtlas};
-        }
-
         // Use the conservative clip bounds for a rough estimate of the mask size (this avoids
         // having to evaluate the entire clip stack before choosing the renderer as it will have to
         // get evaluated again if we fall back to a different renderer).
         Rect drawBounds = localToDevice.mapRect(shape.bounds());
         drawBounds.intersect(fClip.conservativeBounds());
-        if (pathAtlas->isSuitableForAtlasing(drawBounds)) {
+
+        // If the hardware doesn't support MSAA and anti-aliasing is required, then we render paths
+        // with atlasing unless they could never fit in the atlas. Those fall back to the
+        // tessellating renderers below, which are aliased without MSAA but still draw the shape.
+        if (!msaaSupported || strategy == PathRendererStrategy::kComputeAnalyticAA ||
+            strategy == PathRendererStrategy::kRasterAA) {
+            if (pathAtlas->fitsInAtlas(drawBounds)) {
+                return {nullptr, pathAtlas};
+            }
+        } else if (pathAtlas->isSuitableForAtlasing(drawBounds)) {
             return {nullptr, pathAtlas};
         }
     }
@@ -1686,9 +1748,24 @@ TextureProxyView Device::readSurfaceView() const {
     return fDC->readSurfaceView(fRecorder->priv().caps());
 }
 
+#if defined(GRAPHITE_TEST_UTILS)
+int Device::pendingOccluderCount() const { return fDC->pendingOccluders(); }
+#endif
+
 sk_sp<sktext::gpu::Slug> Device::convertGlyphRunListToSlug(const sktext::GlyphRunList& glyphRunList,
                                                            const SkPaint& initialPaint,
                                                            const SkPaint& drawingPaint) {
+    if (fRecorder->priv().caps()->drawSlugGlyphsAsPaths()) {
+        // Draw the glyphs from their outlines, so the Slug stays sharp at any scale.
+        const sktext::gpu::SDFTControl outlinesOnly = fSDFTControl.makeOutlinesOnly();
+        return sktext::gpu::SlugImpl::Make(
+                this->localToDevice(),
+                glyphRunList,
+                initialPaint,
+                drawingPaint,
+                {this->surfaceProps(), this->scalerContextFlags(), &outlinesOnly},
+                SkStrikeCache::GlobalStrikeCache());
+    }
     return sktext::gpu::SlugImpl::Make(this->localToDevice(),
                                        glyphRunList,
                                        initialPaint,
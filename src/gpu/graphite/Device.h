@@ -90,6 +90,11 @@ public:
     TextureProxy* target();
     TextureProxyView readSurfaceView() const;
 
+#if defined(GRAPHITE_TEST_UTILS)
+    // The number of occluders recorded since the last flush, see DrawList::recordOccluder.
+    int pendingOccluderCount() const;
+#endif
+
     // SkCanvas only uses drawCoverageMask w/o this staging flag, so only enable
     // mask filters in clients that have finished migrating.
 #if !defined(SK_RESOLVE_FILTERS_BEFORE_RESTORE)
@@ -163,7 +168,7 @@ public:
 
     void drawDrawable(SkCanvas*, SkDrawable*, const SkMatrix*) override {}
     void drawMesh(const SkMesh&, sk_sp<SkBlender>, const SkPaint&) override {}
-    void drawShadow(const SkPath&, const SkDrawShadowRec&) override {}
+    void drawShadow(const SkPath&, const SkDrawShadowRec&) override;
 
     // Special images and layers
     sk_sp<SkSurface> makeSurface(const SkImageInfo&, const SkSurfaceProps&) override;
@@ -209,6 +214,10 @@ private:
         // - drawPaint, drawImageLattice, drawImageRect, drawEdgeAAImageSet, drawVertices, drawAtlas
         // - drawShape after it's applied the path effect.
         kIgnorePathEffect = 0b010,
+
+        // The shape is never drawn with a PathAtlas, even when chooseRenderer() would prefer one.
+        // - drawGeometry after the shape couldn't be added to the chosen PathAtlas.
+        kNoPathAtlas      = 0b100,
     };
     SK_DECL_BITMASK_OPS_FRIENDS(DrawFlags)
 
@@ -261,7 +270,8 @@ private:
     std::pair<const Renderer*, PathAtlas*> chooseRenderer(const Transform& localToDevice,
                                                           const Geometry&,
                                                           const SkStrokeRec&,
-                                                          bool requireMSAA) const;
+                                                          bool requireMSAA,
+                                                          bool allowPathAtlas = true) const;
 
     bool needsFlushBeforeDraw(int numNewDraws, DstReadRequirement) const;
 
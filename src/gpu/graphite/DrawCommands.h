@@ -131,6 +131,7 @@ public:
     ~List() = default;
 
     int count() const { return fCommands.count(); }
+    int drawCount() const { return fDrawCount; }
 
     void bindGraphicsPipeline(uint32_t pipelineIndex) {
         this->add<BindGraphicsPipeline>(pipelineIndex);
@@ -165,17 +166,20 @@ public:
     }
 
     void draw(PrimitiveType type, unsigned int baseVertex, unsigned int vertexCount) {
+        ++fDrawCount;
         this->add<Draw>(type, baseVertex, vertexCount);
     }
 
     void drawIndexed(PrimitiveType type, unsigned int baseIndex,
                      unsigned int indexCount, unsigned int baseVertex) {
+        ++fDrawCount;
         this->add<DrawIndexed>(type, baseIndex, indexCount, baseVertex);
     }
 
     void drawInstanced(PrimitiveType type,
                        unsigned int baseVertex, unsigned int vertexCount,
                        unsigned int baseInstance, unsigned int instanceCount) {
+        ++fDrawCount;
         this->add<DrawInstanced>(type, baseVertex, vertexCount, baseInstance, instanceCount);
     }
 
@@ -183,6 +187,7 @@ public:
                               unsigned int baseIndex, unsigned int indexCount,
                               unsigned int baseVertex, unsigned int baseInstance,
                               unsigned int instanceCount) {
+        ++fDrawCount;
         this->add<DrawIndexedInstanced>(type,
                                         baseIndex,
                                         indexCount,
@@ -192,10 +197,12 @@ public:
     }
 
     void drawIndirect(PrimitiveType type) {
+        ++fDrawCount;
         this->add<DrawIndirect>(type);
     }
 
     void drawIndexedIndirect(PrimitiveType type) {
+        ++fDrawCount;
         this->add<DrawIndexedIndirect>(type);
     }
 
@@ -225,6 +232,8 @@ private:
     // fAlloc needs to be a data structure which can append variable length data in contiguous
     // chunks, returning a stable handle to that data for later retrieval.
     SkArenaAlloc fAlloc{256};
+
+    int fDrawCount = 0;
 };
 
 } // namespace DrawPassCommands
@@ -146,12 +146,16 @@ void DrawContext::snapDrawPass(Recorder* recorder) {
     // Instantiate the compute pass that may render an atlas texture used by this draw pass.
     this->snapPathAtlasDispatches(recorder);
 
+    if (!fSortOrderCache && recorder->priv().retainDrawOrder()) {
+        fSortOrderCache = std::make_unique<DrawPass::SortOrderCache>();
+    }
     auto pass = DrawPass::Make(recorder,
                                std::move(fPendingDraws),
                                fTarget,
                                this->imageInfo(),
                                std::make_pair(fPendingLoadOp, fPendingStoreOp),
-                               fPendingClearColor);
+                               fPendingClearColor,
+                               fSortOrderCache.get());
     if (pass) {
         fDrawPasses.push_back(std::move(pass));
     }
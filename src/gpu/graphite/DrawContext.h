@@ -16,6 +16,7 @@
 #include "src/gpu/graphite/AttachmentTypes.h"
 #include "src/gpu/graphite/DrawList.h"
 #include "src/gpu/graphite/DrawOrder.h"
+#include "src/gpu/graphite/DrawPass.h"
 #include "src/gpu/graphite/DrawTypes.h"
 #include "src/gpu/graphite/UploadTask.h"
 
@@ -32,7 +33,6 @@ class Transform;
 class Caps;
 class ComputePathAtlas;
 class DispatchGroup;
-class DrawPass;
 class PathAtlas;
 class RasterPathAtlas;
 class Task;
@@ -64,6 +64,9 @@ public:
     const SkSurfaceProps& surfaceProps() const { return fSurfaceProps; }
 
     int pendingRenderSteps() const { return fPendingDraws->renderStepCount(); }
+#if defined(GRAPHITE_TEST_UTILS)
+    int pendingOccluders() const { return fPendingDraws->occluderCount(); }
+#endif
 
     void clear(const SkColor4f& clearColor);
 
@@ -75,6 +78,11 @@ public:
                     const PaintParams* paint,
                     const StrokeStyle* stroke);
 
+    // See DrawList::recordOccluder.
+    void recordOccluder(const Rect& bounds, PaintersDepth depth) {
+        fPendingDraws->recordOccluder(bounds, depth);
+    }
+
     bool recordUpload(Recorder* recorder,
                       sk_sp<TextureProxy> targetProxy,
                       const SkColorInfo& srcColorInfo,
@@ -176,6 +184,9 @@ private:
     // multiple DrawPassChains is then clearly accumulating subpasses across multiple targets.
     skia_private::TArray<std::unique_ptr<DrawPass>> fDrawPasses;
 
+    // Only created if RecorderOptions::fRetainDrawOrder is set.
+    std::unique_ptr<DrawPass::SortOrderCache> fSortOrderCache;
+
     // Stores the most immediately recorded uploads into Textures. This list is mutable and
     // can be appended to, or have its commands rewritten if they are inlined into a parent DC.
     std::unique_ptr<UploadList> fPendingUploads;
@@ -51,4 +51,42 @@ void DrawList::recordDraw(const Renderer* renderer,
     }
 }
 
+void DrawList::recordOccluder(const Rect& bounds, PaintersDepth depth) {
+    Rect pixelBounds = bounds.makeRoundIn();
+    if (pixelBounds.isEmptyNegativeOrNaN()) {
+        return;
+    }
+
+    if (fOccluders.size() < kMaxOccluders) {
+        fOccluders.push_back({pixelBounds, depth});
+        return;
+    }
+    // Replace the smallest occluder, since larger ones are more likely to hide other draws.
+    Occluder* smallest = &fOccluders[0];
+    for (Occluder& occluder : fOccluders) {
+        if (occluder.fBounds.area() < smallest->fBounds.area()) {
+            smallest = &occluder;
+        }
+    }
+    if (smallest->fBounds.area() < pixelBounds.area()) {
+        *smallest = {pixelBounds, depth};
+    }
+}
+
+bool DrawList::isOccluded(const Draw& draw) const {
+    // Depth-only draws (e.g. clip elements) affect the depth testing of later draws so they must
+    // always be kept, even if hidden themselves.
+    if (!draw.fPaintParams.has_value()) {
+        return false;
+    }
+    const Rect drawBounds = draw.fDrawParams.clip().drawBounds().makeRoundOut();
+    const PaintersDepth drawDepth = draw.fDrawParams.order().depth();
+    for (const Occluder& occluder : fOccluders) {
+        if (drawDepth < occluder.fDepth && occluder.fBounds.contains(drawBounds)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace skgpu::graphite
@@ -9,6 +9,7 @@
 #define skgpu_graphite_DrawList_DEFINED
 
 #include "include/core/SkPaint.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkTBlockList.h"
 
 #include "src/gpu/graphite/DrawOrder.h"
@@ -81,8 +82,18 @@ public:
                     const PaintParams* paint,
                     const StrokeStyle* stroke);
 
+    // Records that every pixel inside the device-space 'bounds' is overwritten with opaque color
+    // by a draw at 'depth'. When the DrawList is converted to a DrawPass, shading draws with a
+    // lower depth whose bounds are contained in an occluder are skipped entirely. Only the largest
+    // kMaxOccluders occluders are kept.
+    void recordOccluder(const Rect& bounds, PaintersDepth depth);
+
     int renderStepCount() const { return fRenderStepCount; }
 
+#if defined(GRAPHITE_TEST_UTILS)
+    int occluderCount() const { return fOccluders.size(); }
+#endif
+
     // Bounds for a dst copy required by this DrawList.
     const Rect& dstCopyBounds() const { return fDstCopyBounds; }
 
@@ -104,12 +115,23 @@ private:
                 , fPaintParams(paint ? std::optional<PaintParams>(*paint) : std::nullopt) {}
     };
 
+    struct Occluder {
+        Rect          fBounds; // Rounded in to the pixels that are fully covered
+        PaintersDepth fDepth;
+    };
+    static constexpr int kMaxOccluders = 16;
+
     // The returned Transform reference remains valid for the lifetime of the DrawList.
     const Transform& deduplicateTransform(const Transform&);
 
+    // Returns true if 'draw' modifies only pixels that a later opaque draw will overwrite.
+    bool isOccluded(const Draw& draw) const;
+
     SkTBlockList<Transform, 16> fTransforms{SkBlockAllocator::GrowthPolicy::kFibonacci};
     SkTBlockList<Draw, 16>      fDraws{SkBlockAllocator::GrowthPolicy::kFibonacci};
 
+    skia_private::STArray<kMaxOccluders, Occluder> fOccluders;
+
     // Running total of RenderSteps for all draws, assuming nothing is culled
     int fRenderStepCount = 0;
 
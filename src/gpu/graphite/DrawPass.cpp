@@ -10,6 +10,7 @@
 #include "include/gpu/graphite/GraphiteTypes.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "include/private/base/SkAlign.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/graphite/Buffer.h"
 #include "src/gpu/graphite/BufferManager.h"
@@ -39,6 +40,8 @@
 #include "src/base/SkTBlockList.h"
 
 #include <algorithm>
+#include <functional>
+#include <numeric>
 #include <unordered_map>
 
 using namespace skia_private;
@@ -124,6 +127,55 @@ struct TextureBinding {
     }
 };
 
+// Sorting is the one step of making a DrawPass that doesn't use the Recorder's caches and buffers,
+// so with an executor the keys of a large DrawPass are sorted in chunks on several threads, and
+// the sorted chunks are merged pairwise, also concurrently. A DrawList holds at most
+// DrawList::kMaxRenderSteps keys, so a chunk has to be a fraction of that for any pass to be split.
+constexpr size_t kMinKeysPerSortTask = 512;
+constexpr size_t kMaxSortTasks = 8;
+static_assert(2 * kMinKeysPerSortTask <= DrawList::kMaxRenderSteps);
+
+// Returns the number of chunks that were sorted concurrently, or 0 if the keys were sorted on the
+// calling thread.
+template <typename Key, typename Less = std::less<Key>>
+size_t sort_keys(SkExecutor* executor, std::vector<Key>* keys, Less less = {}) {
+    const size_t count = keys->size();
+    const size_t numChunks =
+            executor ? std::min(count / kMinKeysPerSortTask, kMaxSortTasks) : 0;
+    if (numChunks < 2) {
+        std::sort(keys->begin(), keys->end(), less);
+        return 0;
+    }
+
+    TRACE_EVENT1("skia.gpu", TRACE_FUNC, "chunks", numChunks);
+    const auto begin = keys->begin();
+    STArray<kMaxSortTasks + 1, size_t> bounds;
+    for (size_t i = 0; i <= numChunks; ++i) {
+        bounds.push_back(count * i / numChunks);
+    }
+
+    SkTaskGroup tasks(*executor);
+    for (size_t i = 0; i < numChunks; ++i) {
+        tasks.add([first = begin + bounds[i], last = begin + bounds[i + 1], less] {
+            std::sort(first, last, less);
+        });
+    }
+    tasks.wait();
+
+    for (size_t width = 1; width < numChunks; width *= 2) {
+        for (size_t i = 0; i + width < numChunks; i += 2 * width) {
+            tasks.add([first = begin + bounds[i],
+                       middle = begin + bounds[i + width],
+                       last = begin + bounds[std::min(i + 2 * width, numChunks)],
+                       less] {
+                std::inplace_merge(first, middle, last, less);
+            });
+        }
+        tasks.wait();
+    }
+    return numChunks;
+}
+
 using UniformCache = DenseBiMap<const UniformDataBlock*, CpuOrGpuData>;
 using TextureBindingCache = DenseBiMap<TextureBinding>;
 using GraphicsPipelineCache = DenseBiMap<GraphicsPipelineDesc>;
@@ -362,6 +414,10 @@ public:
 
     const DrawList::Draw& draw() const { return *fDraw; }
 
+    // The sort order only depends on these two values.
+    uint64_t pipelineKey() const { return fPipelineKey; }
+    uint64_t uniformKey() const { return fUniformKey; }
+
     GraphicsPipelineCache::Index pipelineIndex() const {
         return PipelineField::get(fPipelineKey);
     }
@@ -433,6 +489,44 @@ sk_sp<TextureProxy> add_copy_target_task(Recorder* recorder,
     return copy;
 }
 
+#if defined(GRAPHITE_TEST_UTILS)
+int DrawPass::SortForTesting(SkExecutor* executor, std::vector<uint64_t>* keys) {
+    return static_cast<int>(sort_keys(executor, keys));
+}
+#endif
+
+void DrawPass::SortOrderCache::sortKeys(SkExecutor* executor, std::vector<SortKey>* keys) {
+    const size_t count = keys->size();
+    bool matches = fKeys.size() == 2 * count;
+    for (size_t i = 0; matches && i < count; ++i) {
+        matches = fKeys[2 * i]     == (*keys)[i].pipelineKey() &&
+                  fKeys[2 * i + 1] == (*keys)[i].uniformKey();
+    }
+
+    if (matches) {
+        TRACE_EVENT_INSTANT0("skia.gpu", "DrawPass reused sort order", TRACE_EVENT_SCOPE_THREAD);
+        ++fReuseCount;
+    } else {
+        fKeys.resize(2 * count);
+        for (size_t i = 0; i < count; ++i) {
+            fKeys[2 * i]     = (*keys)[i].pipelineKey();
+            fKeys[2 * i + 1] = (*keys)[i].uniformKey();
+        }
+        fOrder.resize(count);
+        std::iota(fOrder.begin(), fOrder.end(), 0);
+        sort_keys(executor, &fOrder, [keys](uint32_t a, uint32_t b) {
+            return (*keys)[a] < (*keys)[b];
+        });
+    }
+
+    std::vector<SortKey> sorted;
+    sorted.reserve(count);
+    for (uint32_t index : fOrder) {
+        sorted.push_back((*keys)[index]);
+    }
+    *keys = std::move(sorted);
+}
+
 DrawPass::DrawPass(sk_sp<TextureProxy> target,
                    std::pair<LoadOp, StoreOp> ops,
                    std::array<float, 4> clearColor)
@@ -448,7 +542,8 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
                                          sk_sp<TextureProxy> target,
                                          const SkImageInfo& targetInfo,
                                          std::pair<LoadOp, StoreOp> ops,
-                                         std::array<float, 4> clearColor) {
+                                         std::array<float, 4> clearColor,
+                                         SortOrderCache* sortOrderCache) {
     // NOTE: This assert is here to ensure SortKey is as tightly packed as possible. Any change to
     // its size should be done with care and good reason. The performance of sorting the keys is
     // heavily tied to the total size.
@@ -520,6 +615,10 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
     keys.reserve(draws->renderStepCount());
 
     for (const DrawList::Draw& draw : draws->fDraws.items()) {
+        if (draws->isOccluded(draw)) {
+            continue;
+        }
+
         // If we have two different descriptors, such that the uniforms from the PaintParams can be
         // bound independently of those used by the rest of the RenderStep, then we can upload now
         // and remember the location for re-use on any RenderStep that does shading.
@@ -582,7 +681,11 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
     // vs. algorithms that require an extra O(n) storage.
     // TODO: It's not strictly necessary, but would a stable sort be useful or just end up hiding
     // bugs in the DrawOrder determination code?
-    std::sort(keys.begin(), keys.end());
+    if (sortOrderCache) {
+        sortOrderCache->sortKeys(recorder->priv().executor(), &keys);
+    } else {
+        sort_keys(recorder->priv().executor(), &keys);
+    }
 
     // Used to record vertex/instance data, buffer binds, and draw calls
     DrawWriter drawWriter(&drawPass->fCommandList, bufferMgr);
@@ -669,6 +772,10 @@ std::unique_ptr<DrawPass> DrawPass::Make(Recorder* recorder,
     TRACE_COUNTER1("skia.gpu", "# textures", drawPass->fSampledTextures.size());
     TRACE_COUNTER1("skia.gpu", "# commands", drawPass->fCommandList.count());
 
+    GpuCounterSet* counters = recorder->priv().sharedContext()->counters();
+    counters->add(GpuCounter::kDrawsRecorded, draws->fDraws.count());
+    counters->add(GpuCounter::kDrawCalls, drawPass->fCommandList.drawCount());
+
     return drawPass;
 }
 
@@ -677,10 +784,12 @@ bool DrawPass::prepareResources(ResourceProvider* resourceProvider,
                                 const RenderPassDesc& renderPassDesc) {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
 
-    fFullPipelines.reserve(fFullPipelines.size() + fPipelineDescs.size());
-    for (const GraphicsPipelineDesc& pipelineDesc : fPipelineDescs) {
+    // The GraphicsPipelineDescs are small, so unlike the SamplerDescs they are kept once their
+    // pipelines have been created, and only the pipelines that are missing are created.
+    fFullPipelines.reserve(fPipelineDescs.size());
+    for (int i = fFullPipelines.size(); i < fPipelineDescs.size(); ++i) {
         auto pipeline = resourceProvider->findOrCreateGraphicsPipeline(runtimeDict,
-                                                                       pipelineDesc,
+                                                                       fPipelineDescs[i],
                                                                        renderPassDesc);
         if (!pipeline) {
             SKGPU_LOG_W("Failed to create GraphicsPipeline for draw in RenderPass. Dropping pass!");
@@ -688,9 +797,6 @@ bool DrawPass::prepareResources(ResourceProvider* resourceProvider,
         }
         fFullPipelines.push_back(std::move(pipeline));
     }
-    // The DrawPass may be long lived on a Recording and we no longer need the GraphicPipelineDescs
-    // once we've created pipelines, so we drop the storage for them here.
-    fPipelineDescs.clear();
 
     for (int i = 0; i < fSampledTextures.size(); ++i) {
         // TODO: We need to remove this check once we are creating valid SkImages from things like
@@ -20,8 +20,11 @@
 #include "src/gpu/graphite/ResourceTypes.h"
 #include "src/gpu/graphite/TextureProxy.h"
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
+class SkExecutor;
 struct SkImageInfo;
 
 namespace skgpu::graphite {
@@ -52,7 +55,33 @@ enum class UniformSlot;
  * executed by a RenderPassTask.
  */
 class DrawPass {
+private:
+    class SortKey;
+
 public:
+    /**
+     * Remembers the order the sort keys of the last DrawPass made with it were sorted into. The
+     * keys only hold indices that are assigned in draw order, so a frame that records the same
+     * draws as the previous one produces the same keys, and the order is reused without sorting.
+     * Comparing the keys is linear in the number of draws, while sorting them is not.
+     */
+    class SortOrderCache {
+    public:
+        // The number of DrawPasses that reused the order of the one before them.
+        int reuseCount() const { return fReuseCount; }
+
+    private:
+        friend class DrawPass;
+
+        void sortKeys(SkExecutor*, std::vector<SortKey>*);
+
+        // The pipeline and uniform keys of the last sorted keys, in draw order.
+        std::vector<uint64_t> fKeys;
+        // The draw-order index of the key at each sorted position.
+        std::vector<uint32_t> fOrder;
+        int fReuseCount = 0;
+    };
+
     ~DrawPass();
 
     static std::unique_ptr<DrawPass> Make(Recorder*,
@@ -60,7 +89,14 @@ public:
                                           sk_sp<TextureProxy> target,
                                           const SkImageInfo& targetInfo,
                                           std::pair<LoadOp, StoreOp>,
-                                          std::array<float, 4> clearColor);
+                                          std::array<float, 4> clearColor,
+                                          SortOrderCache* = nullptr);
+
+#if defined(GRAPHITE_TEST_UTILS)
+    // Sorts 'keys' the way Make() sorts a DrawPass's keys, and returns the number of chunks that
+    // were sorted concurrently on 'executor' (0 if the keys were sorted on the calling thread).
+    static int SortForTesting(SkExecutor*, std::vector<uint64_t>* keys);
+#endif
 
     // Defined relative to the top-left corner of the surface the DrawPass renders to, and is
     // contained within its dimensions.
@@ -91,6 +127,10 @@ public:
     const GraphicsPipeline* getPipeline(size_t index) const {
         return fFullPipelines[index].get();
     }
+    // The desc the pipeline at 'index' was made from, which labels its draws in GPU timings.
+    const GraphicsPipelineDesc& getPipelineDesc(size_t index) const {
+        return fPipelineDescs[index];
+    }
     const Texture* getTexture(size_t index) const;
     const Sampler* getSampler(size_t index) const;
 
@@ -99,8 +139,6 @@ public:
     void addResourceRefs(CommandBuffer*) const;
 
 private:
-    class SortKey;
-
     DrawPass(sk_sp<TextureProxy> target,
              std::pair<LoadOp, StoreOp> ops,
              std::array<float, 4> clearColor);
@@ -117,7 +155,7 @@ private:
     bool fRequiresMSAA = false;
 
     // The pipelines are referenced by index in BindGraphicsPipeline, but that will index into a
-    // an array of actual GraphicsPipelines.
+    // an array of actual GraphicsPipelines. The descs are kept to label GPU timings.
     skia_private::TArray<GraphicsPipelineDesc> fPipelineDescs;
     skia_private::TArray<SamplerDesc> fSamplerDescs;
 
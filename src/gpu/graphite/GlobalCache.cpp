@@ -55,6 +55,37 @@ sk_sp<GraphicsPipeline> GlobalCache::addGraphicsPipeline(const UniqueKey& key,
     return *entry;
 }
 
+// Bounds the manifest when pipelines are evicted and compiled again over and over.
+static constexpr int kMaxManifestEntries = 4096;
+
+void GlobalCache::addPipelineManifestEntry(const PipelineManifest::Entry& entry) {
+    SkAutoSpinlock lock{fSpinLock};
+
+    if (fPipelineManifest.size() < kMaxManifestEntries) {
+        fPipelineManifest.push_back(entry);
+    }
+}
+
+skia_private::TArray<PipelineManifest::Entry> GlobalCache::pipelineManifestEntries() const {
+    SkAutoSpinlock lock{fSpinLock};
+
+    return fPipelineManifest;
+}
+
+void GlobalCache::addPipelineMissEntry(const PipelineManifest::Entry& entry) {
+    SkAutoSpinlock lock{fSpinLock};
+
+    if (fPipelineMisses.size() < kMaxManifestEntries) {
+        fPipelineMisses.push_back(entry);
+    }
+}
+
+skia_private::TArray<PipelineManifest::Entry> GlobalCache::pipelineMissEntries() const {
+    SkAutoSpinlock lock{fSpinLock};
+
+    return fPipelineMisses;
+}
+
 #if defined(GRAPHITE_TEST_UTILS)
 int GlobalCache::numGraphicsPipelines() const {
     SkAutoSpinlock lock{fSpinLock};
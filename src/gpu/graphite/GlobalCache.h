@@ -13,6 +13,7 @@
 #include "src/base/SkSpinlock.h"
 #include "src/core/SkLRUCache.h"
 #include "src/gpu/ResourceKey.h"
+#include "src/gpu/graphite/PipelineManifest.h"
 
 #include <functional>
 
@@ -58,6 +59,19 @@ public:
             SK_EXCLUDES(fSpinLock);
 #endif
 
+    // Remembers how a newly compiled GraphicsPipeline can be compiled again by a later process.
+    // Entries are not removed when the pipeline is evicted, so pipelines that were evicted and
+    // compiled again are listed more than once.
+    void addPipelineManifestEntry(const PipelineManifest::Entry&) SK_EXCLUDES(fSpinLock);
+    skia_private::TArray<PipelineManifest::Entry> pipelineManifestEntries() const
+            SK_EXCLUDES(fSpinLock);
+
+    // Remembers a pipeline that a draw had to compile because no precompilation had compiled it
+    // first, i.e. a gap in the client's precompile coverage.
+    void addPipelineMissEntry(const PipelineManifest::Entry&) SK_EXCLUDES(fSpinLock);
+    skia_private::TArray<PipelineManifest::Entry> pipelineMissEntries() const
+            SK_EXCLUDES(fSpinLock);
+
     // Find and add operations for ComputePipelines, with the same pattern as GraphicsPipelines.
     sk_sp<ComputePipeline> findComputePipeline(const UniqueKey&) SK_EXCLUDES(fSpinLock);
     sk_sp<ComputePipeline> addComputePipeline(const UniqueKey&,
@@ -87,6 +101,8 @@ private:
     ComputePipelineCache  fComputePipelineCache  SK_GUARDED_BY(fSpinLock);
 
     skia_private::TArray<sk_sp<Resource>> fStaticResource SK_GUARDED_BY(fSpinLock);
+    skia_private::TArray<PipelineManifest::Entry> fPipelineManifest SK_GUARDED_BY(fSpinLock);
+    skia_private::TArray<PipelineManifest::Entry> fPipelineMisses SK_GUARDED_BY(fSpinLock);
 };
 
 }  // namespace skgpu::graphite
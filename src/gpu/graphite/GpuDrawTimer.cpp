@@ -0,0 +1,83 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/GpuDrawTimer.h"
+
+#include "include/core/SkString.h"
+#include "src/gpu/graphite/GraphicsPipelineDesc.h"
+#include "src/gpu/graphite/PaintParamsKey.h"
+#include "src/gpu/graphite/Renderer.h"
+#include "src/gpu/graphite/RendererProvider.h"
+#include "src/gpu/graphite/ShaderCodeDictionary.h"
+#include "src/gpu/graphite/SharedContext.h"
+
+#include <chrono>
+
+namespace skgpu::graphite {
+
+namespace {
+
+std::string render_step_name(const SharedContext* sharedContext, uint32_t renderStepID) {
+    const RenderStep* step = sharedContext->rendererProvider()->lookup(renderStepID);
+    return step ? std::string(step->name()) : std::string("unknown RenderStep");
+}
+
+std::string paint_name(const SharedContext* sharedContext, uint32_t paintID) {
+    if (paintID == UniquePaintParamsID::InvalidID().asUInt()) {
+        // Depth-only and stencil-only steps have no paint.
+        return "no paint";
+    }
+#if defined(GRAPHITE_TEST_UTILS)
+    const ShaderCodeDictionary* dict = sharedContext->shaderCodeDictionary();
+    return std::string(dict->lookup(UniquePaintParamsID(paintID)).toString(dict).c_str());
+#else
+    return SkStringPrintf("paint %u", paintID).c_str();
+#endif
+}
+
+}  // anonymous namespace
+
+void GpuDrawTimer::add(const GraphicsPipelineDesc& desc, uint64_t nanoseconds) {
+    Total* step = fRenderSteps.find(desc.renderStepID());
+    if (!step) {
+        step = fRenderSteps.set(desc.renderStepID(), {});
+    }
+    step->fCount++;
+    step->fNanoseconds += nanoseconds;
+
+    uint64_t pipelineKey = (uint64_t(desc.renderStepID()) << 32) | desc.paintParamsID().asUInt();
+    Total* pipeline = fPipelines.find(pipelineKey);
+    if (!pipeline) {
+        pipeline = fPipelines.set(pipelineKey, {});
+    }
+    pipeline->fCount++;
+    pipeline->fNanoseconds += nanoseconds;
+}
+
+Context::GpuDrawTimings GpuDrawTimer::takeTimings() {
+    Context::GpuDrawTimings timings;
+    timings.fRenderSteps.reserve(fRenderSteps.count());
+    fRenderSteps.foreach([&](uint32_t renderStepID, Total* total) {
+        timings.fRenderSteps.push_back({render_step_name(fSharedContext, renderStepID),
+                                        total->fCount,
+                                        std::chrono::nanoseconds(total->fNanoseconds)});
+    });
+    timings.fPipelines.reserve(fPipelines.count());
+    fPipelines.foreach([&](uint64_t pipelineKey, Total* total) {
+        std::string name = render_step_name(fSharedContext, uint32_t(pipelineKey >> 32));
+        name += " + ";
+        name += paint_name(fSharedContext, uint32_t(pipelineKey));
+        timings.fPipelines.push_back({std::move(name),
+                                      total->fCount,
+                                      std::chrono::nanoseconds(total->fNanoseconds)});
+    });
+    fRenderSteps.reset();
+    fPipelines.reset();
+    return timings;
+}
+
+}  // namespace skgpu::graphite
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_GpuDrawTimer_DEFINED
+#define skgpu_graphite_GpuDrawTimer_DEFINED
+
+#include "include/gpu/graphite/Context.h"
+#include "src/core/SkTHash.h"
+
+#include <cstdint>
+
+namespace skgpu::graphite {
+
+class GraphicsPipelineDesc;
+class SharedContext;
+
+/**
+ * Sums the GPU time that finished command buffers measured for their runs of draws, both by
+ * RenderStep and by full pipeline (RenderStep plus paint key). Names are only looked up when the
+ * totals are taken, so adding a measurement is just a pair of hash map updates.
+ */
+class GpuDrawTimer {
+public:
+    explicit GpuDrawTimer(const SharedContext* sharedContext) : fSharedContext(sharedContext) {}
+
+    void add(const GraphicsPipelineDesc&, uint64_t nanoseconds);
+
+    // Returns the totals, which are then reset.
+    Context::GpuDrawTimings takeTimings();
+
+private:
+    struct Total {
+        int fCount = 0;
+        uint64_t fNanoseconds = 0;
+    };
+
+    const SharedContext* fSharedContext;
+    // Keyed by RenderStep::uniqueID().
+    skia_private::THashMap<uint32_t, Total> fRenderSteps;
+    // Keyed by the RenderStep's ID in the high bits and the UniquePaintParamsID in the low bits.
+    skia_private::THashMap<uint64_t, Total> fPipelines;
+};
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_GpuDrawTimer_DEFINED
@@ -32,6 +32,7 @@ GpuWorkSubmission::GpuWorkSubmission(std::unique_ptr<CommandBuffer> cmdBuffer,
 }
 
 GpuWorkSubmission::~GpuWorkSubmission() {
+    fQueueManager->collectGpuDrawTimings(fCommandBuffer.get());
     fCommandBuffer->callFinishedProcs(/*success=*/true);
     fCommandBuffer->resetCommandBuffer();
     fQueueManager->returnCommandBuffer(std::move(fCommandBuffer));
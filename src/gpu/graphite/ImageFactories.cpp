@@ -8,6 +8,8 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkYUVAInfo.h"
@@ -19,6 +21,7 @@
 #include "include/gpu/graphite/Surface.h"
 #include "include/gpu/graphite/YUVABackendTextures.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTo.h"
 #include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/gpu/RefCntedCallback.h"
@@ -34,11 +37,15 @@
 #include "src/gpu/graphite/TextureProxy.h"
 #include "src/gpu/graphite/TextureProxyView.h"
 #include "src/gpu/graphite/TextureUtils.h"
+#include "src/gpu/graphite/UploadTask.h"
 #include "src/image/SkImage_Base.h"
 #include "src/image/SkImage_Lazy.h"
 #include "src/image/SkImage_Picture.h"
 #include "src/image/SkImage_Raster.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace SkImages {
 
 using namespace skgpu::graphite;
@@ -445,6 +452,105 @@ sk_sp<SkImage> TextureFromYUVAPixmaps(Recorder* recorder,
             kNeedNewImageUniqueID, std::move(yuvaProxies), std::move(imageColorSpace));
 }
 
+std::vector<sk_sp<SkImage>> TextureFromYUVAPlanes(Recorder* recorder,
+                                                  SkSpan<const SkYUVAPixmapInfo> pixmapInfos,
+                                                  const YUVAPlanesWriter& writePlanes,
+                                                  sk_sp<SkColorSpace> imageColorSpace) {
+    std::vector<sk_sp<SkImage>> images(pixmapInfos.size());
+    if (!recorder || !writePlanes) {
+        return images;
+    }
+    const Caps* caps = recorder->priv().caps();
+    const skgpu::Protected isProtected = recorder->priv().isProtected();
+
+    // Make a proxy for every plane of every image that can be uploaded as-is. The planes of the
+    // image at 'i' start at firstPlane[i], or it is -1 if the image cannot be created.
+    std::vector<sk_sp<TextureProxy>> proxies;
+    std::vector<SkColorInfo> colorInfos;
+    std::vector<int> firstPlane(pixmapInfos.size(), -1);
+    for (size_t i = 0; i < pixmapInfos.size(); ++i) {
+        const SkYUVAPixmapInfo& pixmapInfo = pixmapInfos[i];
+        if (!pixmapInfo.isValid()) {
+            continue;
+        }
+        const int first = SkToInt(proxies.size());
+        bool planesValid = true;
+        for (int plane = 0; plane < pixmapInfo.numPlanes() && planesValid; ++plane) {
+            const SkImageInfo& planeInfo = pixmapInfo.planeInfo(plane);
+            const SkColorType ct = planeInfo.colorType();
+            TextureInfo textureInfo = caps->getDefaultSampledTextureInfo(
+                    ct, skgpu::Mipmapped::kNo, isProtected, skgpu::Renderable::kNo);
+            sk_sp<TextureProxy> proxy;
+            if (textureInfo.isValid() &&
+                caps->supportedWritePixelsColorType(ct, textureInfo, ct) ==
+                        std::make_pair(ct, false)) {
+                proxy = TextureProxy::Make(
+                        caps, planeInfo.dimensions(), textureInfo, skgpu::Budgeted::kNo);
+            }
+            planesValid = SkToBool(proxy);
+            proxies.push_back(std::move(proxy));
+            colorInfos.push_back(planeInfo.colorInfo());
+        }
+        if (planesValid) {
+            firstPlane[i] = first;
+        } else {
+            proxies.resize(first);
+            colorInfos.resize(first);
+        }
+    }
+    if (proxies.empty()) {
+        return images;
+    }
+
+    std::vector<SkPixmap> pixmaps(proxies.size());
+    std::vector<UploadInstance> uploads =
+            UploadInstance::MakeInPlace(recorder, proxies, colorInfos, pixmaps);
+    if (uploads.empty()) {
+        return images;
+    }
+
+    UploadList uploadList;
+    for (size_t i = 0; i < pixmapInfos.size(); ++i) {
+        const int first = firstPlane[i];
+        if (first < 0) {
+            continue;
+        }
+        const SkYUVAInfo& yuvaInfo = pixmapInfos[i].yuvaInfo();
+        const int numPlanes = yuvaInfo.numPlanes();
+
+        SkPixmap planePixmaps[SkYUVAInfo::kMaxPlanes];
+        std::copy_n(pixmaps.begin() + first, numPlanes, planePixmaps);
+        SkYUVAPixmaps planes = SkYUVAPixmaps::FromExternalPixmaps(yuvaInfo, planePixmaps);
+        if (!planes.isValid() || !writePlanes(SkToInt(i), planes)) {
+            continue;
+        }
+
+        TextureProxyView views[SkYUVAInfo::kMaxPlanes];
+        for (int plane = 0; plane < numPlanes; ++plane) {
+            const sk_sp<TextureProxy>& proxy = proxies[first + plane];
+            const SkColorType ct = colorInfos[first + plane].colorType();
+            skgpu::Swizzle swizzle = caps->getReadSwizzle(ct, proxy->textureInfo());
+            // Match MakeBitmapProxyView(): alpha-only planes are read from every channel.
+            if (SkColorTypeIsAlphaOnly(ct)) {
+                swizzle = skgpu::Swizzle::Concat(swizzle, skgpu::Swizzle("aaaa"));
+            }
+            views[plane] = TextureProxyView(proxy, swizzle);
+            SkAssertResult(uploadList.recordUpload(std::move(uploads[first + plane])));
+        }
+
+        YUVATextureProxies yuvaProxies(recorder, yuvaInfo, SkSpan<TextureProxyView>(views));
+        SkASSERT(yuvaProxies.isValid());
+        images[i] = sk_make_sp<Image_YUVA>(
+                kNeedNewImageUniqueID, std::move(yuvaProxies), imageColorSpace);
+    }
+
+    // Every image shares a single task, so the planes are all copied out of the buffer together.
+    if (uploadList.size() > 0) {
+        recorder->priv().add(UploadTask::Make(&uploadList));
+    }
+    return images;
+}
+
 sk_sp<SkImage> TextureFromYUVATextures(Recorder* recorder,
                                        const YUVABackendTextures& yuvaTextures,
                                        sk_sp<SkColorSpace> imageColorSpace,
@@ -77,6 +77,12 @@ std::pair<const Renderer*, std::optional<PathAtlas::MaskAndOrigin>> PathAtlas::a
     return std::make_pair(fRecorder->priv().rendererProvider()->coverageMask(), atlasMask);
 }
 
+bool PathAtlas::fitsInAtlas(const Rect& transformedShapeBounds) const {
+    skvx::float2 maskSize = transformedShapeBounds.makeRoundOut().size();
+    return maskSize.x() + 2 * kEntryPadding <= this->width() &&
+           maskSize.y() + 2 * kEntryPadding <= this->height();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////
 
 ComputePathAtlas::ComputePathAtlas(Recorder* recorder)
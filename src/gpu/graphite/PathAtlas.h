@@ -94,6 +94,12 @@ public:
      */
     virtual bool isSuitableForAtlasing(const Rect& transformedShapeBounds) const { return true; }
 
+    /**
+     * Returns false if a path coverage mask with the given device-space bounds can't be added to
+     * the atlas even when it is empty, in which case the shape must be drawn without the atlas.
+     */
+    bool fitsInAtlas(const Rect& transformedShapeBounds) const;
+
     uint32_t width() const { return fWidth; }
     uint32_t height() const { return fHeight; }
 
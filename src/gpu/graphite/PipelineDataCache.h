@@ -35,12 +35,18 @@ public:
             return existing->fPointer;
         } else {
             // Need to make a copy of dataBlock into the arena
-            T* copy = T::Make(dataBlock, &fArena);
+            T* copy = T::Make(dataBlock, fArena.get());
             fDataPointers.add(DataRef{copy});
             return copy;
         }
     }
 
+    // Removes every block from the cache. The arena keeps its memory for the next Recording.
+    void reset() {
+        fDataPointers.reset();
+        fArena.reset();
+    }
+
     // The number of unique T objects in the cache
     int count() const {
         return fDataPointers.count();
@@ -75,7 +81,7 @@ private:
 
     skia_private::THashSet<DataRef, Hash> fDataPointers;
     // Holds the data that is pointed to by fDataPointers
-    SkArenaAlloc fArena{0};
+    SkRetainingArenaAlloc fArena{0};
 };
 
 // A UniformDataCache only lives for a single Recording. It's used to deduplicate uniform data
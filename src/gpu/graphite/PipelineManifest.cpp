@@ -0,0 +1,565 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/PipelineManifest.h"
+
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkData.h"
+#include "include/core/SkString.h"
+#include "include/gpu/graphite/GraphiteTypes.h"
+#include "include/gpu/graphite/TextureInfo.h"
+#include "src/base/SkMathPriv.h"
+#include "src/core/SkKnownRuntimeEffects.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkWriteBuffer.h"
+#include "src/gpu/graphite/BuiltInCodeSnippetID.h"
+#include "src/gpu/graphite/Caps.h"
+#include "src/gpu/graphite/GraphicsPipeline.h"
+#include "src/gpu/graphite/GraphicsPipelineDesc.h"
+#include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PaintParamsKey.h"
+#include "src/gpu/graphite/Renderer.h"
+#include "src/gpu/graphite/RendererProvider.h"
+#include "src/gpu/graphite/ResourceProvider.h"
+#include "src/gpu/graphite/RuntimeEffectDictionary.h"
+#include "src/gpu/graphite/ShaderCodeDictionary.h"
+#include "src/gpu/graphite/SharedContext.h"
+
+#include <algorithm>
+
+namespace skgpu::graphite::PipelineManifest {
+
+namespace {
+
+static constexpr uint32_t kMagic = SkSetFourByteTag('s', 'k', 'p', 'm');
+// Increment this whenever the format changes, or the meaning of something it stores does.
+static constexpr int kCurrentVersion = 1;
+
+// Snippet IDs below this are the same in every process running the same build of Skia. User-defined
+// runtime effects are assigned IDs at or above it as they are first used.
+static constexpr int kFirstUnstableSnippetID =
+        SkKnownRuntimeEffects::kUnknownRuntimeEffectIDStart;
+
+bool is_stable_key(const PaintParamsKey& key) {
+    for (int32_t id : key.data()) {
+        if (id < 0 || id >= kFirstUnstableSnippetID) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that 'data' is a forest of nodes with the number of children the dictionary expects, so
+// that adding it to a PaintParamsKeyBuilder can't trip the builder's checks.
+bool validate_node(const ShaderCodeDictionary* dict, SkSpan<const int32_t> data, size_t* index) {
+    if (*index >= data.size()) {
+        return false;
+    }
+    int32_t id = data[(*index)++];
+    if (id >= kFirstUnstableSnippetID || !dict->isValidID(id)) {
+        return false;
+    }
+    const ShaderSnippet* snippet = dict->getEntry(id);
+    for (int i = 0; i < snippet->fNumChildren; ++i) {
+        if (!validate_node(dict, data, index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void add_node(const ShaderCodeDictionary* dict,
+              SkSpan<const int32_t> data,
+              size_t* index,
+              PaintParamsKeyBuilder* builder) {
+    int32_t id = data[(*index)++];
+    builder->beginBlock(id);
+    const ShaderSnippet* snippet = dict->getEntry(id);
+    for (int i = 0; i < snippet->fNumChildren; ++i) {
+        add_node(dict, data, index, builder);
+    }
+    builder->endBlock();
+}
+
+UniquePaintParamsID find_or_create_paint_id(ShaderCodeDictionary* dict,
+                                            SkSpan<const int32_t> data) {
+    size_t index = 0;
+    while (index < data.size()) {
+        if (!validate_node(dict, data, &index)) {
+            return UniquePaintParamsID::InvalidID();
+        }
+    }
+    PaintParamsKeyBuilder builder(dict);
+    index = 0;
+    while (index < data.size()) {
+        add_node(dict, data, &index, &builder);
+    }
+    return dict->findOrCreate(&builder);
+}
+
+struct EntryHash {
+    uint32_t operator()(const Entry& e) const {
+        const uint32_t fields[] = {e.fRenderStepID,
+                                   e.fPaintID.asUInt(),
+                                   static_cast<uint32_t>(e.fColorType),
+                                   static_cast<uint32_t>(e.fMipmapped),
+                                   static_cast<uint32_t>(e.fDepthStencilFlags.value()),
+                                   static_cast<uint32_t>(e.fLoadOp),
+                                   e.fRequiresMSAA};
+        return SkChecksum::Hash32(fields, sizeof(fields));
+    }
+};
+
+// What the tree of snippets in a PaintParamsKey says about the paint it was made from, in terms of
+// PaintOptions.
+struct PaintSummary {
+    skia_private::TArray<SkString> fShaders;       // PrecompileShaders factory calls
+    skia_private::TArray<SkString> fColorFilters;  // PrecompileColorFilters factory calls
+    skia_private::TArray<SkString> fNotes;         // Anything PaintOptions can't be told
+    std::optional<SkBlendMode> fBlendMode;         // The fixed-function blend mode, if any
+    bool fDither = false;
+};
+
+const char* shader_factory(BuiltInCodeSnippetID id) {
+    switch (id) {
+        case BuiltInCodeSnippetID::kLinearGradientShader4:
+        case BuiltInCodeSnippetID::kLinearGradientShader8:
+        case BuiltInCodeSnippetID::kLinearGradientShaderTexture:
+            return "PrecompileShaders::LinearGradient()";
+        case BuiltInCodeSnippetID::kRadialGradientShader4:
+        case BuiltInCodeSnippetID::kRadialGradientShader8:
+        case BuiltInCodeSnippetID::kRadialGradientShaderTexture:
+            return "PrecompileShaders::RadialGradient()";
+        case BuiltInCodeSnippetID::kSweepGradientShader4:
+        case BuiltInCodeSnippetID::kSweepGradientShader8:
+        case BuiltInCodeSnippetID::kSweepGradientShaderTexture:
+            return "PrecompileShaders::SweepGradient()";
+        case BuiltInCodeSnippetID::kConicalGradientShader4:
+        case BuiltInCodeSnippetID::kConicalGradientShader8:
+        case BuiltInCodeSnippetID::kConicalGradientShaderTexture:
+            return "PrecompileShaders::TwoPointConicalGradient()";
+        case BuiltInCodeSnippetID::kImageShader:
+        case BuiltInCodeSnippetID::kCubicImageShader:
+        case BuiltInCodeSnippetID::kHWImageShader:
+            return "PrecompileShaders::Image()";
+        case BuiltInCodeSnippetID::kYUVImageShader:
+        case BuiltInCodeSnippetID::kCubicYUVImageShader:
+            return "PrecompileShaders::YUVImage()";
+        default:
+            return nullptr;
+    }
+}
+
+const char* color_filter_factory(BuiltInCodeSnippetID id) {
+    switch (id) {
+        case BuiltInCodeSnippetID::kMatrixColorFilter:   return "PrecompileColorFilters::Matrix()";
+        case BuiltInCodeSnippetID::kTableColorFilter:    return "PrecompileColorFilters::Table()";
+        case BuiltInCodeSnippetID::kGaussianColorFilter: return "PrecompileColorFilters::Gaussian()";
+        default:                                         return nullptr;
+    }
+}
+
+bool contains_snippet(SkSpan<const int32_t> data, size_t begin, size_t end,
+                      BuiltInCodeSnippetID id) {
+    for (size_t i = begin; i < end; ++i) {
+        if (data[i] == static_cast<int32_t>(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Summarizes the node at data[*index] and its children, which validate_node() has accepted.
+void summarize_node(const ShaderCodeDictionary* dict,
+                    SkSpan<const int32_t> data,
+                    size_t* index,
+                    PaintSummary* summary) {
+    const size_t begin = *index;
+    const int32_t rawID = data[(*index)++];
+    const ShaderSnippet* snippet = dict->getEntry(rawID);
+    const int shaderCount = summary->fShaders.size();
+    for (int i = 0; i < snippet->fNumChildren; ++i) {
+        summarize_node(dict, data, index, summary);
+    }
+
+    if (rawID >= kBuiltInCodeSnippetIDCount) {
+        summary->fNotes.push_back(SkStringPrintf("uses the runtime effect %s", snippet->fName));
+        return;
+    }
+    const auto id = static_cast<BuiltInCodeSnippetID>(rawID);
+    if (const char* factory = shader_factory(id)) {
+        summary->fShaders.push_back(SkString(factory));
+    } else if (const char* factory = color_filter_factory(id)) {
+        summary->fColorFilters.push_back(SkString(factory));
+    } else if (id >= BuiltInCodeSnippetID::kFirstFixedFunctionBlendMode) {
+        summary->fBlendMode = static_cast<SkBlendMode>(rawID - kFixedFunctionBlendModeIDOffset);
+    } else if (id == BuiltInCodeSnippetID::kLocalMatrixShader) {
+        for (int i = shaderCount; i < summary->fShaders.size(); ++i) {
+            summary->fShaders[i].printf("PrecompileShaders::LocalMatrix(%s)",
+                                        SkString(summary->fShaders[i]).c_str());
+        }
+    } else if (id == BuiltInCodeSnippetID::kDitherShader) {
+        summary->fDither = true;
+    } else if (id == BuiltInCodeSnippetID::kBlendShader &&
+               !contains_snippet(data, begin, *index, BuiltInCodeSnippetID::kPrimitiveColor) &&
+               !contains_snippet(data, begin, *index, BuiltInCodeSnippetID::kDstReadSample) &&
+               !contains_snippet(data, begin, *index, BuiltInCodeSnippetID::kDstReadFetch)) {
+        // Blends that involve the primitive color or the dst are added by Skia, not the paint.
+        summary->fNotes.push_back(SkString(
+                "blends shaders; combine the shaders with PrecompileShaders::Blend()"));
+    } else if (id == BuiltInCodeSnippetID::kDstReadSample ||
+               id == BuiltInCodeSnippetID::kDstReadFetch) {
+        summary->fNotes.push_back(SkString(
+                "blends in the shader; add its SkBlendMode, which the key doesn't record, to "
+                "setBlendModes()"));
+    } else if (id == BuiltInCodeSnippetID::kPerlinNoiseShader) {
+        summary->fNotes.push_back(SkString("uses a Perlin noise shader"));
+    } else if (id == BuiltInCodeSnippetID::kClipShader) {
+        summary->fNotes.push_back(SkString("is clipped by a clip shader"));
+    }
+    // The remaining snippets are added by Skia for every paint, or as parts of the ones above.
+}
+
+}  // anonymous namespace
+
+std::optional<Entry> MakeEntry(const Caps* caps,
+                               const GraphicsPipelineDesc& pipelineDesc,
+                               const RenderPassDesc& renderPassDesc) {
+    // With a resolve attachment the render target is the resolve texture; otherwise the color
+    // attachment is the target texture.
+    const TextureInfo& targetInfo = renderPassDesc.fColorResolveAttachment.fTextureInfo.isValid()
+                                            ? renderPassDesc.fColorResolveAttachment.fTextureInfo
+                                            : renderPassDesc.fColorAttachment.fTextureInfo;
+    if (!targetInfo.isValid() || targetInfo.isProtected() == Protected::kYes) {
+        return std::nullopt;
+    }
+
+    SkEnumBitMask<DepthStencilFlags> depthStencilFlags = DepthStencilFlags::kNone;
+    const TextureInfo& depthStencilInfo = renderPassDesc.fDepthStencilAttachment.fTextureInfo;
+    if (depthStencilInfo.isValid()) {
+        for (DepthStencilFlags flags : {DepthStencilFlags::kDepth,
+                                        DepthStencilFlags::kStencil,
+                                        DepthStencilFlags::kDepthStencil}) {
+            if (caps->getDefaultDepthStencilTextureInfo(flags,
+                                                        renderPassDesc.fSampleCount,
+                                                        Protected::kNo) == depthStencilInfo) {
+                depthStencilFlags = flags;
+                break;
+            }
+        }
+        if (depthStencilFlags == DepthStencilFlags::kNone) {
+            return std::nullopt;
+        }
+    }
+
+    // The color type and load op aren't stored in the RenderPassDesc, so find the first ones that
+    // recreate the same pipeline. This only runs when a pipeline is compiled, which costs far more.
+    const UniqueKey pipelineKey = caps->makeGraphicsPipelineKey(pipelineDesc, renderPassDesc);
+    for (int ct = 1; ct < kSkColorTypeCnt; ++ct) {
+        SkColorType colorType = static_cast<SkColorType>(ct);
+        TextureInfo info = caps->getDefaultSampledTextureInfo(colorType,
+                                                              targetInfo.mipmapped(),
+                                                              Protected::kNo,
+                                                              Renderable::kYes);
+        if (!(info == targetInfo)) {
+            continue;
+        }
+        for (LoadOp loadOp : {LoadOp::kLoad, LoadOp::kClear, LoadOp::kDiscard}) {
+            Entry candidate = {pipelineDesc.renderStepID(),
+                               pipelineDesc.paintParamsID(),
+                               colorType,
+                               targetInfo.mipmapped(),
+                               depthStencilFlags,
+                               loadOp,
+                               renderPassDesc.fSampleCount > 1};
+            if (caps->makeGraphicsPipelineKey(pipelineDesc,
+                                              MakeRenderPassDesc(caps, candidate)) == pipelineKey) {
+                return candidate;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+RenderPassDesc MakeRenderPassDesc(const Caps* caps, const Entry& entry) {
+    TextureInfo info = caps->getDefaultSampledTextureInfo(entry.fColorType,
+                                                          entry.fMipmapped,
+                                                          Protected::kNo,
+                                                          Renderable::kYes);
+    return RenderPassDesc::Make(caps,
+                                info,
+                                entry.fLoadOp,
+                                StoreOp::kStore,
+                                entry.fDepthStencilFlags,
+                                /* clearColor= */ {.0f, .0f, .0f, .0f},
+                                entry.fRequiresMSAA,
+                                caps->getWriteSwizzle(entry.fColorType, info));
+}
+
+sk_sp<SkData> Serialize(const SharedContext* sharedContext, SkSpan<const Entry> entries) {
+    const RendererProvider* rendererProvider = sharedContext->rendererProvider();
+    const ShaderCodeDictionary* dict = sharedContext->shaderCodeDictionary();
+
+    // The GlobalCache records a pipeline again if it was evicted and then recompiled.
+    skia_private::THashSet<Entry, EntryHash> written;
+    SkBinaryWriteBuffer entryWriter({});
+    int count = 0;
+    for (const Entry& entry : entries) {
+        const RenderStep* step = rendererProvider->lookup(entry.fRenderStepID);
+        PaintParamsKey key = dict->lookup(entry.fPaintID);
+        if (!step || !is_stable_key(key) || written.contains(entry)) {
+            continue;
+        }
+        written.add(entry);
+
+        entryWriter.writeString(step->name());
+        entryWriter.writeIntArray(key.data().data(), SkToU32(key.data().size()));
+        entryWriter.writeUInt(static_cast<uint32_t>(entry.fColorType));
+        entryWriter.writeBool(entry.fMipmapped == Mipmapped::kYes);
+        entryWriter.writeUInt(static_cast<uint32_t>(entry.fDepthStencilFlags.value()));
+        entryWriter.writeUInt(static_cast<uint32_t>(entry.fLoadOp));
+        entryWriter.writeBool(entry.fRequiresMSAA);
+        ++count;
+    }
+    if (!count) {
+        return nullptr;
+    }
+
+    SkBinaryWriteBuffer writer({});
+    writer.writeUInt(kMagic);
+    writer.writeInt(kCurrentVersion);
+    // Snippet IDs are only stable within one build, which these counts roughly identify.
+    writer.writeInt(kBuiltInCodeSnippetIDCount);
+    writer.writeInt(SkKnownRuntimeEffects::kStableKeyCnt);
+    writer.writeInt(count);
+    sk_sp<SkData> entryData = entryWriter.snapshotAsData();
+    writer.writePad32(entryData->data(), entryData->size());
+    return writer.snapshotAsData();
+}
+
+bool Read(const SkData& data, const ReadEntryFn& fn) {
+    SkReadBuffer reader(data.data(), data.size());
+    uint32_t magic = reader.readUInt();
+    int version = reader.readInt();
+    int builtInSnippetCount = reader.readInt();
+    int stableKeyCount = reader.readInt();
+    int count = reader.readInt();
+    if (!reader.validate(magic == kMagic &&
+                         version == kCurrentVersion &&
+                         builtInSnippetCount == kBuiltInCodeSnippetIDCount &&
+                         stableKeyCount == SkKnownRuntimeEffects::kStableKeyCnt &&
+                         count >= 0)) {
+        SKGPU_LOG_W("Pipeline manifest is from a different version of Skia; ignoring it.");
+        return false;
+    }
+
+    int read = 0;
+    skia_private::TArray<int32_t> keyData;
+    for (; read < count; ++read) {
+        SkString stepName;
+        reader.readString(&stepName);
+        uint32_t keySize = reader.getArrayCount();
+        if (!reader.validateCanReadN<int32_t>(keySize)) {
+            break;
+        }
+        keyData.resize(keySize);
+        reader.readIntArray(keyData.data(), keySize);
+        // Only the render pass fields are read back; the IDs depend on the reading process.
+        Entry entry = {0, UniquePaintParamsID::InvalidID(), kUnknown_SkColorType, Mipmapped::kNo,
+                       DepthStencilFlags::kNone, LoadOp::kLoad, false};
+        entry.fColorType = reader.read32LE(kLastEnum_SkColorType);
+        entry.fMipmapped = reader.readBool() ? Mipmapped::kYes : Mipmapped::kNo;
+        entry.fDepthStencilFlags = static_cast<DepthStencilFlags>(
+                reader.read32LE(static_cast<int>(DepthStencilFlags::kDepthStencil)));
+        entry.fLoadOp = reader.read32LE(LoadOp::kLast);
+        entry.fRequiresMSAA = reader.readBool();
+        if (!reader.isValid()) {
+            break;
+        }
+        fn(std::string_view(stepName.c_str(), stepName.size()), keyData, entry);
+    }
+    if (!reader.isValid()) {
+        SKGPU_LOG_W("Pipeline manifest is corrupt; stopped after %d entries.", read);
+        return false;
+    }
+    return true;
+}
+
+int Precompile(const SharedContext* sharedContext,
+               ResourceProvider* resourceProvider,
+               ShaderCodeDictionary* dict,
+               const SkData& data) {
+    const Caps* caps = sharedContext->caps();
+    const RendererProvider* rendererProvider = sharedContext->rendererProvider();
+    // None of the pipelines use user-defined runtime effects, so the dictionary stays empty.
+    RuntimeEffectDictionary runtimeDict;
+
+    int compiled = 0;
+    Read(data, [&](std::string_view stepName, SkSpan<const int32_t> keyData, const Entry& entry) {
+        const RenderStep* step = rendererProvider->lookup(stepName);
+        if (!step || step->performsShading() != !keyData.empty()) {
+            return;
+        }
+        UniquePaintParamsID paintID = UniquePaintParamsID::InvalidID();
+        if (!keyData.empty()) {
+            paintID = find_or_create_paint_id(dict, keyData);
+            if (!paintID.isValid()) {
+                return;
+            }
+        }
+
+        GraphicsPipelineDesc pipelineDesc(step, paintID);
+        if (resourceProvider->findOrCreateGraphicsPipeline(
+                    &runtimeDict,
+                    pipelineDesc,
+                    MakeRenderPassDesc(caps, entry),
+                    ResourceProvider::PipelineCreationSource::kPrecompile)) {
+            ++compiled;
+        }
+    });
+    return compiled;
+}
+
+bool MakePaintOptionsSource(const ShaderCodeDictionary* dict,
+                            const SkData& data,
+                            SkString* source,
+                            skia_private::TArray<SkString>* skipped) {
+    struct Group {
+        PaintSummary fSummary;
+        skia_private::TArray<SkBlendMode> fBlendModes;
+        uint8_t fDrawTypes = DrawTypeFlags::kNone;
+        skia_private::TArray<SkString> fRenderSteps;
+        int fPipelineCount = 0;
+    };
+    skia_private::TArray<Group> groups;
+    skia_private::THashMap<SkString, int> groupIndices;
+    int unreadable = 0;
+
+    bool valid = Read(data, [&](std::string_view stepName,
+                                SkSpan<const int32_t> keyData,
+                                const Entry&) {
+        if (keyData.empty()) {
+            // Steps that don't shade are compiled along with the shading steps of their draws.
+            return;
+        }
+        size_t index = 0;
+        while (index < keyData.size()) {
+            if (!validate_node(dict, keyData, &index)) {
+                ++unreadable;
+                return;
+            }
+        }
+        PaintSummary summary;
+        index = 0;
+        while (index < keyData.size()) {
+            summarize_node(dict, keyData, &index, &summary);
+        }
+
+        SkString groupKey;
+        for (const auto* list : {&summary.fShaders, &summary.fColorFilters, &summary.fNotes}) {
+            for (const SkString& item : *list) {
+                groupKey.appendf("%s;", item.c_str());
+            }
+            groupKey.append("|");
+        }
+        groupKey.appendS32(summary.fDither);
+        int* groupIndex = groupIndices.find(groupKey);
+        if (!groupIndex) {
+            groupIndex = groupIndices.set(groupKey, groups.size());
+            groups.push_back().fSummary = summary;
+        }
+        Group& group = groups[*groupIndex];
+
+        if (summary.fBlendMode && std::find(group.fBlendModes.begin(), group.fBlendModes.end(),
+                                            *summary.fBlendMode) == group.fBlendModes.end()) {
+            group.fBlendModes.push_back(*summary.fBlendMode);
+        }
+        // RenderStep names start with their class name, which says what kind of draw uses them.
+        if (stepName.find("Text") != std::string_view::npos) {
+            group.fDrawTypes |= DrawTypeFlags::kText;
+        } else if (stepName.find("Vertices") != std::string_view::npos) {
+            group.fDrawTypes |= DrawTypeFlags::kDrawVertices;
+        } else {
+            group.fDrawTypes |= DrawTypeFlags::kShape;
+        }
+        SkString name(stepName.data(), stepName.size());
+        if (std::find(group.fRenderSteps.begin(), group.fRenderSteps.end(), name) ==
+            group.fRenderSteps.end()) {
+            group.fRenderSteps.push_back(name);
+        }
+        ++group.fPipelineCount;
+    });
+    if (!valid) {
+        return false;
+    }
+
+    source->reset();
+    if (unreadable) {
+        source->appendf("// %d pipelines use paints that this build of Skia can't read.\n",
+                        unreadable);
+    }
+    for (const Group& group : groups) {
+        const PaintSummary& summary = group.fSummary;
+        SkString description = SkStringPrintf("%d pipeline%s:", group.fPipelineCount,
+                                              group.fPipelineCount == 1 ? "" : "s");
+        for (const SkString& step : group.fRenderSteps) {
+            description.appendf(" %s", step.c_str());
+        }
+        if (!summary.fNotes.empty()) {
+            // Precompiling these PaintOptions would compile some other pipeline.
+            if (skipped) {
+                for (const SkString& note : summary.fNotes) {
+                    description.appendf("; the paint %s", note.c_str());
+                }
+                skipped->push_back(std::move(description));
+            }
+            continue;
+        }
+        source->appendf("\n// %s", description.c_str());
+        source->append("\n{\n    PaintOptions paintOptions;\n");
+        auto appendList = [&](const char* setter, const skia_private::TArray<SkString>& list) {
+            if (list.empty()) {
+                return;
+            }
+            source->appendf("    paintOptions.%s({ ", setter);
+            for (int i = 0; i < list.size(); ++i) {
+                source->appendf("%s%s", i ? ", " : "", list[i].c_str());
+            }
+            source->append(" });\n");
+        };
+        appendList("setShaders", summary.fShaders);
+        appendList("setColorFilters", summary.fColorFilters);
+        if (!group.fBlendModes.empty()) {
+            source->append("    SkBlendMode blendModes[] = { ");
+            for (int i = 0; i < group.fBlendModes.size(); ++i) {
+                source->appendf("%sSkBlendMode::k%s", i ? ", " : "",
+                                SkBlendMode_Name(group.fBlendModes[i]));
+            }
+            source->append(" };\n    paintOptions.setBlendModes(blendModes);\n");
+        }
+        if (summary.fDither) {
+            source->append("    paintOptions.setDither(true);\n");
+        }
+
+        SkString drawTypes;
+        for (auto [flag, name] : {std::make_pair(DrawTypeFlags::kText, "kText"),
+                                  std::make_pair(DrawTypeFlags::kDrawVertices, "kDrawVertices"),
+                                  std::make_pair(DrawTypeFlags::kShape, "kShape")}) {
+            if (group.fDrawTypes & flag) {
+                drawTypes.appendf("%sDrawTypeFlags::%s", drawTypes.isEmpty() ? "" : " | ", name);
+            }
+        }
+        if (SkPopCount(group.fDrawTypes) > 1) {
+            drawTypes.printf("static_cast<DrawTypeFlags>(%s)", SkString(drawTypes).c_str());
+        }
+        source->appendf("    Precompile(context, paintOptions, %s);\n}\n", drawTypes.c_str());
+    }
+    return true;
+}
+
+}  // namespace skgpu::graphite::PipelineManifest
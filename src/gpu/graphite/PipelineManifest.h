@@ -0,0 +1,110 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_PipelineManifest_DEFINED
+#define skgpu_graphite_PipelineManifest_DEFINED
+
+#include "include/core/SkColorType.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkString.h"
+#include "include/private/base/SkTArray.h"
+#include "include/gpu/GpuTypes.h"
+#include "src/base/SkEnumBitMask.h"
+#include "src/gpu/graphite/AttachmentTypes.h"
+#include "src/gpu/graphite/ResourceTypes.h"
+#include "src/gpu/graphite/UniquePaintParamsID.h"
+
+#include <functional>
+#include <optional>
+#include <string_view>
+
+class SkData;
+
+namespace skgpu::graphite {
+
+class Caps;
+class GraphicsPipelineDesc;
+class ResourceProvider;
+class ShaderCodeDictionary;
+class SharedContext;
+
+/**
+ * A pipeline manifest lists the GraphicsPipelines a process has compiled in a form that a later
+ * process can compile again before it needs them. A pipeline's UniqueKey can't be used for that:
+ * RenderStep and UniquePaintParamsIDs are assigned at runtime, and the key can't be turned back
+ * into the descs it was made from. Instead the manifest stores the RenderStep's name and the
+ * PaintParamsKey's snippet IDs, and reduces the RenderPassDesc to the choices Precompile() makes.
+ *
+ * Not every pipeline can be described this way. Pipelines that use user-defined runtime effects,
+ * or that render into textures which don't use Caps' default TextureInfo for their color type,
+ * are left out and are compiled on first use as before.
+ */
+namespace PipelineManifest {
+
+struct Entry {
+    uint32_t fRenderStepID;
+    UniquePaintParamsID fPaintID;
+    SkColorType fColorType;
+    Mipmapped fMipmapped;
+    SkEnumBitMask<DepthStencilFlags> fDepthStencilFlags;
+    LoadOp fLoadOp;
+    bool fRequiresMSAA;
+
+    bool operator==(const Entry& that) const {
+        return fRenderStepID == that.fRenderStepID && fPaintID == that.fPaintID &&
+               fColorType == that.fColorType && fMipmapped == that.fMipmapped &&
+               fDepthStencilFlags == that.fDepthStencilFlags && fLoadOp == that.fLoadOp &&
+               fRequiresMSAA == that.fRequiresMSAA;
+    }
+};
+
+// Describes the pipeline made from 'pipelineDesc' and 'renderPassDesc', or returns nullopt if
+// the render pass can't be recreated from an Entry.
+std::optional<Entry> MakeEntry(const Caps*,
+                               const GraphicsPipelineDesc& pipelineDesc,
+                               const RenderPassDesc& renderPassDesc);
+
+RenderPassDesc MakeRenderPassDesc(const Caps*, const Entry&);
+
+// Returns null if none of the entries can be written.
+sk_sp<SkData> Serialize(const SharedContext*, SkSpan<const Entry>);
+
+// Calls 'fn' with the RenderStep name, PaintParamsKey snippet IDs and render pass of each entry in
+// serialized manifest 'data'. Only the render pass fields of the Entry are set. Returns false if
+// the data was written by another version of Skia, or if it is corrupt, in which case 'fn' has
+// been called for the entries before the first bad one.
+using ReadEntryFn = std::function<void(std::string_view renderStepName,
+                                       SkSpan<const int32_t> paintKey,
+                                       const Entry&)>;
+bool Read(const SkData& data, const ReadEntryFn& fn);
+
+// Compiles the pipelines in serialized manifest 'data' that aren't in the GlobalCache yet and
+// returns how many pipelines the manifest lists that are now in the cache. A manifest written by
+// another version of Skia compiles nothing, entries that no longer describe a pipeline are
+// skipped, and corrupt data stops at the first bad entry.
+int Precompile(const SharedContext*,
+               ResourceProvider*,
+               ShaderCodeDictionary*,
+               const SkData& data);
+
+// Writes C++ that passes PaintOptions covering the pipelines in serialized manifest 'data' to
+// Precompile(). Pipelines whose paints differ only in fixed-function blend mode or draw type share
+// one PaintOptions. Paints with features that PaintOptions can't express, or that can't be
+// recovered from a PaintParamsKey (such as the mode of a shader-based blend), get no code; if
+// 'skipped' is set, a description of each is added to it instead. Returns false if 'data' can't
+// be read.
+bool MakePaintOptionsSource(const ShaderCodeDictionary*,
+                            const SkData& data,
+                            SkString* source,
+                            skia_private::TArray<SkString>* skipped = nullptr);
+
+}  // namespace PipelineManifest
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_PipelineManifest_DEFINED
@@ -9,6 +9,12 @@
 
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
+#include "include/private/base/SingleOwner.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/core/SkTraceEvent.h"
+#include "src/gpu/ResourceKey.h"
 #include "src/gpu/graphite/AttachmentTypes.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/ContextPriv.h"
@@ -18,19 +24,64 @@
 #include "src/gpu/graphite/KeyContext.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/PaintOptionsPriv.h"
+#include "src/gpu/graphite/PipelineManifest.h"
+#include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/Renderer.h"
 #include "src/gpu/graphite/RendererProvider.h"
 #include "src/gpu/graphite/ResourceProvider.h"
 #include "src/gpu/graphite/RuntimeEffectDictionary.h"
+#include "src/gpu/graphite/SharedContext.h"
 #include "src/gpu/graphite/UniquePaintParamsID.h"
 
+#include <atomic>
+#include <vector>
+
 namespace {
 
 using namespace skgpu::graphite;
 
-void compile(const RendererProvider* rendererProvider,
-             ResourceProvider* resourceProvider,
-             const KeyContext& keyContext,
+// With an executor, pipelines are compiled on several threads once there are enough of them. Each
+// thread gets its own ResourceProvider, since they aren't thread-safe, and the compiled pipelines
+// meet in the GlobalCache.
+constexpr size_t kMinPipelinesPerTask = 4;
+constexpr size_t kMaxPrecompileTasks = 8;
+
+struct PipelineToCompile {
+    GraphicsPipelineDesc fPipelineDesc;
+    const RenderPassDesc* fRenderPassDesc;
+};
+
+class PipelineCollector {
+public:
+    PipelineCollector(const Caps* caps, GlobalCache* globalCache)
+            : fCaps(caps), fGlobalCache(globalCache) {}
+
+    // Queues a pipeline unless it's compiled or queued already. Steps that don't shade produce
+    // the same pipeline for every paint, so they'd otherwise be compiled many times concurrently.
+    void add(const GraphicsPipelineDesc& pipelineDesc, const RenderPassDesc& renderPassDesc) {
+        skgpu::UniqueKey key = fCaps->makeGraphicsPipelineKey(pipelineDesc, renderPassDesc);
+        if (fSeen.contains(key) || fGlobalCache->findGraphicsPipeline(key)) {
+            return;
+        }
+        fSeen.add(key);
+        fPipelines.push_back({pipelineDesc, &renderPassDesc});
+    }
+
+    const std::vector<PipelineToCompile>& pipelines() const { return fPipelines; }
+
+private:
+    struct KeyHash {
+        uint32_t operator()(const skgpu::UniqueKey& key) const { return key.hash(); }
+    };
+
+    const Caps* fCaps;
+    GlobalCache* fGlobalCache;
+    skia_private::THashSet<skgpu::UniqueKey, KeyHash> fSeen;
+    std::vector<PipelineToCompile> fPipelines;
+};
+
+void collect(const RendererProvider* rendererProvider,
+             PipelineCollector* collector,
              UniquePaintParamsID uniqueID,
              DrawTypeFlags drawTypes,
              SkSpan<RenderPassDesc> renderPassDescs,
@@ -61,24 +112,66 @@ void compile(const RendererProvider* rendererProvider,
             GraphicsPipelineDesc pipelineDesc(s, paintID);
 
             for (const RenderPassDesc& renderPassDesc : renderPassDescs) {
-                auto pipeline = resourceProvider->findOrCreateGraphicsPipeline(
-                        keyContext.rtEffectDict(),
-                        pipelineDesc,
-                        renderPassDesc);
-                if (!pipeline) {
-                    SKGPU_LOG_W("Failed to create GraphicsPipeline in precompile!");
-                    return;
-                }
+                collector->add(pipelineDesc, renderPassDesc);
             }
         }
     }
 }
 
+void compile(ResourceProvider* resourceProvider,
+             const RuntimeEffectDictionary* rtEffectDict,
+             const PipelineToCompile& pipeline) {
+    if (!resourceProvider->findOrCreateGraphicsPipeline(
+                rtEffectDict,
+                pipeline.fPipelineDesc,
+                *pipeline.fRenderPassDesc,
+                ResourceProvider::PipelineCreationSource::kPrecompile)) {
+        SKGPU_LOG_W("Failed to create GraphicsPipeline in precompile!");
+    }
+}
+
+void compile_all(Context* context,
+                 SkExecutor* executor,
+                 const RuntimeEffectDictionary* rtEffectDict,
+                 const std::vector<PipelineToCompile>& pipelines) {
+    const size_t count = pipelines.size();
+    const size_t numTasks =
+            executor ? std::min(count / kMinPipelinesPerTask, kMaxPrecompileTasks) : 0;
+    if (numTasks < 2) {
+        for (const PipelineToCompile& pipeline : pipelines) {
+            compile(context->priv().resourceProvider(), rtEffectDict, pipeline);
+        }
+        return;
+    }
+
+    TRACE_EVENT1("skia.shaders", TRACE_FUNC, "tasks", numTasks);
+    SharedContext* sharedContext = context->priv().sharedContext();
+    std::atomic<size_t> next{0};
+    SkTaskGroup tasks(*executor);
+    for (size_t i = 0; i < numTasks; ++i) {
+        tasks.add([&] {
+            skgpu::SingleOwner singleOwner;
+            // Only the pipelines outlive the task, so the provider doesn't need a budget.
+            std::unique_ptr<ResourceProvider> resourceProvider =
+                    sharedContext->makeResourceProvider(&singleOwner,
+                                                        SK_InvalidGenID,
+                                                        /* resourceBudget= */ 0);
+            for (size_t j = next++; j < count; j = next++) {
+                compile(resourceProvider.get(), rtEffectDict, pipelines[j]);
+            }
+        });
+    }
+    tasks.wait();
+}
+
 } // anonymous namespace
 
 namespace skgpu::graphite {
 
-void Precompile(Context* context, const PaintOptions& options, DrawTypeFlags drawTypes) {
+void Precompile(Context* context,
+                const PaintOptions& options,
+                DrawTypeFlags drawTypes,
+                SkExecutor* executor) {
 
     ShaderCodeDictionary* dict = context->priv().shaderCodeDictionary();
     const Caps* caps = context->priv().caps();
@@ -139,6 +232,8 @@ void Precompile(Context* context, const PaintOptions& options, DrawTypeFlags dra
                              caps->getWriteSwizzle(ci.colorType(), info)),
     };
 
+    // The paint keys are built on this thread; only compiling the pipelines runs concurrently.
+    PipelineCollector collector(caps, context->priv().globalCache());
     for (Coverage coverage : {Coverage::kNone, Coverage::kSingleChannel, Coverage::kLCD}) {
         options.priv().buildCombinations(
             keyContext,
@@ -146,9 +241,8 @@ void Precompile(Context* context, const PaintOptions& options, DrawTypeFlags dra
             /* addPrimitiveBlender= */ false,
             coverage,
              [&](UniquePaintParamsID uniqueID) {
-                 compile(context->priv().rendererProvider(),
-                         context->priv().resourceProvider(),
-                         keyContext, uniqueID,
+                 collect(context->priv().rendererProvider(),
+                         &collector, uniqueID,
                          static_cast<DrawTypeFlags>(drawTypes & ~DrawTypeFlags::kDrawVertices),
                          renderPassDescs, /* withPrimitiveBlender= */ false, coverage);
              });
@@ -162,14 +256,22 @@ void Precompile(Context* context, const PaintOptions& options, DrawTypeFlags dra
                 /* addPrimitiveBlender= */ true,
                 coverage,
                 [&](UniquePaintParamsID uniqueID) {
-                    compile(context->priv().rendererProvider(),
-                            context->priv().resourceProvider(),
-                            keyContext, uniqueID,
+                    collect(context->priv().rendererProvider(),
+                            &collector, uniqueID,
                             DrawTypeFlags::kDrawVertices,
                             renderPassDescs, /* withPrimitiveBlender= */ true, coverage);
                 });
         }
     }
+
+    compile_all(context, executor, rtEffectDict.get(), collector.pipelines());
+}
+
+int PrecompileSerializedPipelines(Recorder* recorder, const SkData& manifest) {
+    return PipelineManifest::Precompile(recorder->priv().sharedContext(),
+                                        recorder->priv().resourceProvider(),
+                                        recorder->priv().shaderCodeDictionary(),
+                                        manifest);
 }
 
 } // namespace skgpu::graphite
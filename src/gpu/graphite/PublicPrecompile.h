@@ -12,10 +12,14 @@
 
 // TODO: this header should be moved to include/gpu/graphite once the precompilation API
 // is made public
+class SkData;
+class SkExecutor;
+
 namespace skgpu::graphite {
 
 class Context;
 class PaintOptions;
+class Recorder;
 
 /**
  * Precompilation allows clients to create pipelines ahead of time based on what they expect
@@ -23,11 +27,32 @@ class PaintOptions;
  * drawing. Graphite will always be able to perform an inline compilation if some SkPaint
  * combination was omitted from precompilation.
  *
+ * With an executor, the pipelines are compiled concurrently on its threads and this returns once
+ * they're all done. Only the backend's pipeline creation runs on the executor; the caller must
+ * still not use the Context on another thread meanwhile.
+ *
  *   @param context        the Context to which the actual draws will be submitted
  *   @param paintOptions   captures a set of SkPaints that will be drawn
  *   @param drawTypes      communicates which primitives those paints will be drawn with
+ *   @param executor       optional executor to compile the pipelines on
+ */
+void Precompile(Context*,
+                const PaintOptions&,
+                DrawTypeFlags = kMostCommon,
+                SkExecutor* executor = nullptr);
+
+/**
+ * Compiles the pipelines listed in a manifest from Context::serializePipelineKeys() that aren't
+ * compiled yet, so a new process doesn't stall on pipelines an earlier run already needed.
+ * Pipelines are compiled through the Recorder's ResourceProvider and shared with all Recorders of
+ * its Context, so a Recorder dedicated to this can warm the cache on a background thread while
+ * other Recorders draw.
+ *
+ *   @param recorder   a Recorder that isn't being used on another thread
+ *   @param manifest   data returned by serializePipelineKeys() in this or an earlier process
+ *   @return           the number of pipelines listed in the manifest that are now compiled
  */
-void Precompile(Context*, const PaintOptions&, DrawTypeFlags = kMostCommon);
+int PrecompileSerializedPipelines(Recorder*, const SkData& manifest);
 
 } // namespace skgpu::graphite
 
@@ -14,6 +14,7 @@
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/CommandBuffer.h"
 #include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/GpuDrawTimer.h"
 #include "src/gpu/graphite/GpuWorkSubmission.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/RecordingPriv.h"
@@ -59,6 +60,7 @@ bool QueueManager::setupCommandBuffer(ResourceProvider* resourceProvider) {
     if (!fCurrentCommandBuffer) {
         return false;
     }
+    fCurrentCommandBuffer->setGpuTimingsEnabled(fGpuDrawTimer != nullptr);
 
     return true;
 }
@@ -283,5 +285,22 @@ void QueueManager::addUploadBufferManagerRefs(UploadBufferManager* uploadManager
     uploadManager->transferToCommandBuffer(fCurrentCommandBuffer.get());
 }
 
+void QueueManager::setGpuDrawTimingsEnabled(bool enabled) {
+    if (!enabled) {
+        fGpuDrawTimer.reset();
+    } else if (!fGpuDrawTimer && fSharedContext->caps()->gpuTimestampSupport()) {
+        fGpuDrawTimer = std::make_unique<GpuDrawTimer>(fSharedContext);
+    }
+}
+
+void QueueManager::collectGpuDrawTimings(CommandBuffer* commandBuffer) {
+    if (fGpuDrawTimer) {
+        commandBuffer->collectGpuTimings(fGpuDrawTimer.get());
+    }
+}
+
+Context::GpuDrawTimings QueueManager::takeGpuDrawTimings() {
+    return fGpuDrawTimer ? fGpuDrawTimer->takeTimings() : Context::GpuDrawTimings();
+}
 
 } // namespace skgpu::graphite
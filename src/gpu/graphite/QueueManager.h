@@ -9,6 +9,7 @@
 #define skgpu_graphite_QueueManager_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/gpu/graphite/Context.h"
 #include "include/gpu/graphite/GraphiteTypes.h"
 #include "include/private/base/SkDeque.h"
 #include "include/private/base/SkTArray.h"
@@ -21,7 +22,7 @@ namespace skgpu::graphite {
 
 class Buffer;
 class CommandBuffer;
-class Context;
+class GpuDrawTimer;
 class GpuWorkSubmission;
 struct InsertRecordingInfo;
 class ResourceProvider;
@@ -59,6 +60,12 @@ public:
 
     void addUploadBufferManagerRefs(UploadBufferManager*);
 
+    // Turns timing on or off for the command buffers handed out from now on.
+    void setGpuDrawTimingsEnabled(bool enabled);
+    // Called as each submission finishes, before its command buffer is reset.
+    void collectGpuDrawTimings(CommandBuffer*);
+    Context::GpuDrawTimings takeGpuDrawTimings();
+
 protected:
     QueueManager(const SharedContext* sharedContext);
 
@@ -78,6 +85,9 @@ private:
     std::vector<std::unique_ptr<CommandBuffer>> fAvailableCommandBuffers;
 
     skia_private::THashMap<uint32_t, uint32_t> fLastAddedRecordingIDs;
+
+    // Non-null while GPU draw timing is enabled.
+    std::unique_ptr<GpuDrawTimer> fGpuDrawTimer;
 };
 
 } // namespace skgpu::graphite
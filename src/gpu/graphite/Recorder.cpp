@@ -17,6 +17,7 @@
 #include "include/gpu/graphite/Recording.h"
 
 #include "src/core/SkConvertPixels.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/AtlasTypes.h"
 #include "src/gpu/RefCntedCallback.h"
@@ -102,6 +103,11 @@ Recorder::Recorder(sk_sp<SharedContext> sharedContext, const RecorderOptions& op
         , fStrikeCache(std::make_unique<sktext::gpu::StrikeCache>())
         , fTextBlobCache(std::make_unique<sktext::gpu::TextBlobRedrawCoordinator>(fUniqueID)) {
     fClientImageProvider = options.fImageProvider;
+    fExecutor = options.fExecutor;
+    if (fExecutor) {
+        fUploadTasks = std::make_unique<SkTaskGroup>(*fExecutor);
+    }
+    fRetainDrawOrder = options.fRetainDrawOrder;
     if (!fClientImageProvider) {
         fClientImageProvider = DefaultImageProvider::Make();
     }
@@ -120,6 +126,10 @@ Recorder::Recorder(sk_sp<SharedContext> sharedContext, const RecorderOptions& op
 
 Recorder::~Recorder() {
     ASSERT_SINGLE_OWNER
+    // Pending upload work writes into buffers that are about to be released.
+    if (fUploadTasks) {
+        fUploadTasks->wait();
+    }
     // Any finished procs that haven't been passed to a Recording fail
     for (int i = 0; i < fFinishedProcs.size(); ++i) {
         fFinishedProcs[i]->setFailureResult();
@@ -143,6 +153,10 @@ std::unique_ptr<Recording> Recorder::snap() {
     TRACE_EVENT0("skia.gpu", TRACE_FUNC);
     ASSERT_SINGLE_OWNER
     this->priv().flushTrackedDevices();
+    if (fUploadTasks) {
+        TRACE_EVENT0("skia.gpu", "Wait for upload work");
+        fUploadTasks->wait();
+    }
 
     std::unordered_set<sk_sp<TextureProxy>, Recording::ProxyHash> nonVolatileLazyProxies;
     std::unordered_set<sk_sp<TextureProxy>, Recording::ProxyHash> volatileLazyProxies;
@@ -169,8 +183,8 @@ std::unique_ptr<Recording> Recorder::snap() {
         fDrawBufferManager = std::make_unique<DrawBufferManager>(fResourceProvider.get(),
                                                                  fSharedContext->caps(),
                                                                  fUploadBufferManager.get());
-        fTextureDataCache = std::make_unique<TextureDataCache>();
-        fUniformDataCache = std::make_unique<UniformDataCache>();
+        fTextureDataCache->reset();
+        fUniformDataCache->reset();
         fGraph->reset();
         fRuntimeEffectDict->reset();
         return nullptr;
@@ -195,8 +209,8 @@ std::unique_ptr<Recording> Recorder::snap() {
 
     fGraph = std::make_unique<TaskGraph>();
     fRuntimeEffectDict->reset();
-    fTextureDataCache = std::make_unique<TextureDataCache>();
-    fUniformDataCache = std::make_unique<UniformDataCache>();
+    fTextureDataCache->reset();
+    fUniformDataCache->reset();
     if (!this->priv().caps()->requireOrderedRecordings()) {
         fAtlasProvider->textAtlasManager()->evictAtlases();
     }
@@ -401,6 +415,15 @@ void RecorderPriv::add(sk_sp<Task> task) {
     fRecorder->fGraph->add(std::move(task));
 }
 
+void RecorderPriv::addUploadWork(std::function<void()> work) {
+    ASSERT_SINGLE_OWNER_PRIV
+    if (fRecorder->fUploadTasks) {
+        fRecorder->fUploadTasks->add(std::move(work));
+    } else {
+        work();
+    }
+}
+
 void RecorderPriv::flushTrackedDevices() {
     ASSERT_SINGLE_OWNER_PRIV
     for (Device* device : fRecorder->fTrackedDevices) {
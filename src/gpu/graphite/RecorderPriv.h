@@ -28,7 +28,13 @@ public:
     void add(sk_sp<Task>);
     void flushTrackedDevices();
 
+    // Runs 'work', which fills upload buffer memory reserved by this Recorder, on the Recorder's
+    // executor if it has one. Otherwise 'work' runs immediately. snap() waits for all such work
+    // before the upload buffers are handed to the Recording.
+    void addUploadWork(std::function<void()> work);
+
     const Caps* caps() const { return fRecorder->fSharedContext->caps(); }
+    const SharedContext* sharedContext() const { return fRecorder->fSharedContext.get(); }
 
     ResourceProvider* resourceProvider() { return fRecorder->fResourceProvider.get(); }
 
@@ -65,6 +71,8 @@ public:
         return fRecorder->fTextBlobCache.get();
     }
     ProxyCache* proxyCache() { return this->resourceProvider()->proxyCache(); }
+    SkExecutor* executor() const { return fRecorder->fExecutor; }
+    bool retainDrawOrder() const { return fRecorder->fRetainDrawOrder; }
 
     static sk_sp<TextureProxy> CreateCachedProxy(Recorder*,
                                                  const SkBitmap&,
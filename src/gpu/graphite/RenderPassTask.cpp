@@ -125,6 +125,7 @@ bool RenderPassTask::addCommands(Context* context,
     // TODO(b/313629288) we always pass in the render target's dimensions as the viewport here.
     // Using the dimensions of the logical device that we're drawing to could reduce flakiness in
     // rendering.
+    context->priv().sharedContext()->counters()->add(GpuCounter::kRenderPasses);
     return commandBuffer->addRenderPass(fRenderPassDesc,
                                         std::move(colorAttachment),
                                         std::move(resolveAttachment),
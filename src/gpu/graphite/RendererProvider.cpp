@@ -76,6 +76,9 @@ RendererProvider::RendererProvider(const Caps* caps, StaticBufferManager* buffer
         fSDFText[lcd] = makeFromStep(std::make_unique<SDFTextRenderStep>(lcd),
                                      DrawTypeFlags::kText);
     }
+    fMultiChannelSDFText = makeFromStep(
+            std::make_unique<SDFTextRenderStep>(/*isLCD=*/false, /*isMultiChannel=*/true),
+            DrawTypeFlags::kText);
     fAnalyticRRect = makeFromStep(std::make_unique<AnalyticRRectRenderStep>(bufferManager),
                                   DrawTypeFlags::kShape);
     fPerEdgeAAQuad = makeFromStep(std::make_unique<PerEdgeAAQuadRenderStep>(bufferManager),
@@ -160,4 +163,13 @@ const RenderStep* RendererProvider::lookup(uint32_t uniqueID) const {
     return nullptr;
 }
 
+const RenderStep* RendererProvider::lookup(std::string_view name) const {
+    for (auto&& rs : fRenderSteps) {
+        if (name == rs->name()) {
+            return rs.get();
+        }
+    }
+    return nullptr;
+}
+
 } // namespace skgpu::graphite
@@ -12,6 +12,7 @@
 #include "include/core/SkVertices.h"
 #include "src/gpu/graphite/Renderer.h"
 
+#include <string_view>
 #include <vector>
 
 namespace skgpu::graphite {
@@ -57,6 +58,7 @@ public:
     // Atlas'ed text rendering
     const Renderer* bitmapText(bool useLCDText) const { return &fBitmapText[useLCDText]; }
     const Renderer* sdfText(bool useLCDText) const { return &fSDFText[useLCDText]; }
+    const Renderer* multiChannelSDFText() const { return &fMultiChannelSDFText; }
 
     // Mesh rendering
     const Renderer* vertices(SkVertices::VertexMode mode, bool hasColors, bool hasTexCoords) const {
@@ -81,6 +83,8 @@ public:
     }
 
     const RenderStep* lookup(uint32_t uniqueID) const;
+    // RenderStep IDs are assigned at runtime, but their names are the same in every process.
+    const RenderStep* lookup(std::string_view name) const;
 
 #ifdef SK_ENABLE_VELLO_SHADERS
     // Compute shader-based path renderer and compositor.
@@ -114,6 +118,7 @@ private:
 
     Renderer fBitmapText[2];  // bool isLCD
     Renderer fSDFText[2]; // bool isLCD
+    Renderer fMultiChannelSDFText;
 
     Renderer fAnalyticRRect;
     Renderer fPerEdgeAAQuad;
@@ -20,6 +20,7 @@
 #include "src/gpu/graphite/GraphicsPipeline.h"
 #include "src/gpu/graphite/GraphicsPipelineDesc.h"
 #include "src/gpu/graphite/Log.h"
+#include "src/gpu/graphite/PipelineManifest.h"
 #include "src/gpu/graphite/ResourceCache.h"
 #include "src/gpu/graphite/Sampler.h"
 #include "src/gpu/graphite/SharedContext.h"
@@ -42,7 +43,8 @@ ResourceProvider::~ResourceProvider() {
 sk_sp<GraphicsPipeline> ResourceProvider::findOrCreateGraphicsPipeline(
         const RuntimeEffectDictionary* runtimeDict,
         const GraphicsPipelineDesc& pipelineDesc,
-        const RenderPassDesc& renderPassDesc) {
+        const RenderPassDesc& renderPassDesc,
+        PipelineCreationSource source) {
     auto globalCache = fSharedContext->globalCache();
     UniqueKey pipelineKey = fSharedContext->caps()->makeGraphicsPipelineKey(pipelineDesc,
                                                                             renderPassDesc);
@@ -54,11 +56,22 @@ sk_sp<GraphicsPipeline> ResourceProvider::findOrCreateGraphicsPipeline(
         // discard the redundant pipeline. While this is wasted effort in the rare event of a race,
         // it allows pipeline creation to be performed without locking the global cache.
         TRACE_EVENT0_ALWAYS("skia.shaders", "createGraphicsPipeline");
+        auto start = StdSteadyClock::now();
         pipeline = this->createGraphicsPipeline(runtimeDict, pipelineDesc, renderPassDesc);
+        fSharedContext->counters()->addPipelineCompile(start);
         if (pipeline) {
             // TODO: Should we store a null pipeline if we failed to create one so that subsequent
             // usage immediately sees that the pipeline cannot be created, vs. retrying every time?
             pipeline = globalCache->addGraphicsPipeline(pipelineKey, std::move(pipeline));
+
+            if (auto entry = PipelineManifest::MakeEntry(fSharedContext->caps(),
+                                                         pipelineDesc,
+                                                         renderPassDesc)) {
+                globalCache->addPipelineManifestEntry(*entry);
+                if (source == PipelineCreationSource::kDraw) {
+                    globalCache->addPipelineMissEntry(*entry);
+                }
+            }
         }
     }
     return pipeline;
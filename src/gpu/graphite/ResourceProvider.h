@@ -51,11 +51,19 @@ class ResourceProvider {
 public:
     virtual ~ResourceProvider();
 
+    enum class PipelineCreationSource {
+        kDraw,
+        // Compiled ahead of any draw that needs it, so compiling it isn't a cache miss to report.
+        kPrecompile,
+    };
+
     // The runtime effect dictionary provides a link between SkCodeSnippetIds referenced in the
     // paint key and the current SkRuntimeEffect that provides the SkSL for that id.
-    sk_sp<GraphicsPipeline> findOrCreateGraphicsPipeline(const RuntimeEffectDictionary*,
-                                                         const GraphicsPipelineDesc&,
-                                                         const RenderPassDesc&);
+    sk_sp<GraphicsPipeline> findOrCreateGraphicsPipeline(
+            const RuntimeEffectDictionary*,
+            const GraphicsPipelineDesc&,
+            const RenderPassDesc&,
+            PipelineCreationSource = PipelineCreationSource::kDraw);
 
     sk_sp<ComputePipeline> findOrCreateComputePipeline(const ComputePipelineDesc&);
 
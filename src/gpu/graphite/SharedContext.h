@@ -13,9 +13,12 @@
 #include "include/core/SkSize.h"
 
 #include "include/gpu/graphite/GraphiteTypes.h"
+#include "src/gpu/GpuTypesPriv.h"
 #include "src/gpu/graphite/GlobalCache.h"
 #include "src/gpu/graphite/ShaderCodeDictionary.h"
 
+class SkTraceMemoryDump;
+
 namespace skgpu {
 class SingleOwner;
 }
@@ -49,6 +52,10 @@ public:
     ShaderCodeDictionary* shaderCodeDictionary() { return &fShaderDictionary; }
     const ShaderCodeDictionary* shaderCodeDictionary() const { return &fShaderDictionary; }
 
+    // Always-on counters of the work done by this context and its Recorders, which may count
+    // from any thread. See Context::getGpuCounters().
+    GpuCounterSet* counters() const { return &fCounters; }
+
     virtual std::unique_ptr<ResourceProvider> makeResourceProvider(SingleOwner*,
                                                                    uint32_t recorderID,
                                                                    size_t resourceBudget) = 0;
@@ -57,6 +64,10 @@ public:
     // gotten into an unrecoverable, lost state.
     virtual bool isDeviceLost() const { return false; }
 
+    // Called by Context::dumpMemoryStatistics() to dump memory used by the backend that isn't
+    // owned by a Resource, such as the free space in suballocated device memory.
+    virtual void dumpMemoryStatistics(SkTraceMemoryDump*) const {}
+
 protected:
     SharedContext(std::unique_ptr<const Caps>, BackendApi);
 
@@ -72,6 +83,7 @@ private:
     GlobalCache fGlobalCache;
     std::unique_ptr<RendererProvider> fRendererProvider;
     ShaderCodeDictionary fShaderDictionary;
+    mutable GpuCounterSet fCounters;
 };
 
 } // namespace skgpu::graphite
@@ -13,6 +13,7 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkSurface.h"
 #include "include/effects/SkRuntimeEffect.h"
+#include "src/base/SkNoDestructor.h"
 #include "src/core/SkBlurEngine.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkImageFilterCache.h"
@@ -33,6 +34,7 @@
 #include "src/gpu/graphite/Buffer.h"
 #include "src/gpu/graphite/Caps.h"
 #include "src/gpu/graphite/CommandBuffer.h"
+#include "src/gpu/graphite/ComputeTask.h"
 #include "src/gpu/graphite/CopyTask.h"
 #include "src/gpu/graphite/Device.h"
 #include "src/gpu/graphite/Image_Graphite.h"
@@ -44,6 +46,8 @@
 #include "src/gpu/graphite/SynchronizeToCpuTask.h"
 #include "src/gpu/graphite/Texture.h"
 #include "src/gpu/graphite/UploadTask.h"
+#include "src/gpu/graphite/compute/DispatchGroup.h"
+#include "src/gpu/graphite/compute/MipmapComputeStep.h"
 
 #include <array>
 
@@ -307,6 +311,10 @@ sk_sp<SkSpecialImage> blur_impl(skgpu::graphite::Recorder* recorder,
     }
 }
 
+// Immutable raster images at least this large copy their pixels into upload buffers on the
+// Recorder's executor, if it has one. Smaller copies aren't worth the cost of a task.
+constexpr size_t kMinAsyncUploadBytes = 256 * 1024;
+
 } // anonymous namespace
 
 namespace skgpu::graphite {
@@ -397,9 +405,29 @@ std::tuple<TextureProxyView, SkColorType> MakeBitmapProxyView(Recorder* recorder
     // Src and dst colorInfo are the same
     const SkColorInfo& colorInfo = bmpToUpload.info().colorInfo();
     // Add UploadTask to Recorder
-    UploadInstance upload = UploadInstance::Make(
-            recorder, proxy, colorInfo, colorInfo, texels,
-            SkIRect::MakeSize(bmpToUpload.dimensions()), std::make_unique<ImageUploadContext>());
+    UploadInstance upload = UploadInstance::Invalid();
+    if (recorder->priv().executor() && mipLevelCount == 1 && bmpToUpload.isImmutable() &&
+        bmpToUpload.computeByteSize() >= kMinAsyncUploadBytes &&
+        caps->supportedWritePixelsColorType(ct, proxy->textureInfo(), ct) ==
+                std::make_pair(ct, false)) {
+        // Reserve the upload buffer memory now but copy the pixels into it on the Recorder's
+        // executor, so large decoded images don't stall recording with a memcpy. The copy holds a
+        // ref on the bitmap's pixels, and snap() waits for it before the buffer is used.
+        SkPixmap dst;
+        std::vector<UploadInstance> uploads = UploadInstance::MakeInPlace(
+                recorder, {&proxy, 1}, {&colorInfo, 1}, {&dst, 1});
+        if (!uploads.empty()) {
+            recorder->priv().addUploadWork([src = bmpToUpload, dst]() {
+                SkAssertResult(src.readPixels(dst));
+            });
+            upload = std::move(uploads[0]);
+        }
+    } else {
+        upload = UploadInstance::Make(
+                recorder, proxy, colorInfo, colorInfo, texels,
+                SkIRect::MakeSize(bmpToUpload.dimensions()),
+                std::make_unique<ImageUploadContext>());
+    }
     if (!upload.isValid()) {
         SKGPU_LOG_E("MakeBitmapProxyView: Could not create UploadInstance");
         return {};
@@ -585,6 +613,54 @@ sk_sp<SkImage> RescaleImage(Recorder* recorder,
     return SkSurfaces::AsImage(dst);
 }
 
+// Downsamples every mip level in one compute pass, with one dispatch per level. Storage textures
+// can't be bound to a single mip level, so each level is written to its own storage texture (which
+// also serves as the source of the next level) and then copied into 'texture'. Nothing is recorded
+// unless every texture and task could be created.
+static bool generate_mipmaps_with_compute(Recorder* recorder, sk_sp<TextureProxy> texture) {
+    static const SkNoDestructor<MipmapDownsampleComputeStep> kStep;
+
+    const Caps* caps = recorder->priv().caps();
+    DispatchGroup::Builder builder(recorder);
+    skia_private::TArray<sk_sp<Task>> copyTasks;
+
+    sk_sp<TextureProxy> src = texture;
+    SkISize srcSize = texture->dimensions();
+    for (int mipLevel = 1; srcSize.width() > 1 || srcSize.height() > 1; ++mipLevel) {
+        const SkISize dstSize = SkISize::Make(std::max(srcSize.width() >> 1, 1),
+                                              std::max(srcSize.height() >> 1, 1));
+
+        sk_sp<TextureProxy> dst = TextureProxy::MakeStorage(
+                caps, dstSize, kRGBA_8888_SkColorType, skgpu::Budgeted::kYes);
+        if (!dst) {
+            return false;
+        }
+        builder.assignSharedTexture(src, kMipmapSlot_Src);
+        builder.assignSharedTexture(dst, kMipmapSlot_Dst);
+        if (!builder.appendStep(kStep.get(), kStep->globalDispatchSize(dstSize))) {
+            return false;
+        }
+
+        sk_sp<CopyTextureToTextureTask> copyTask = CopyTextureToTextureTask::Make(
+                dst, SkIRect::MakeSize(dstSize), texture, {0, 0}, mipLevel);
+        if (!copyTask) {
+            return false;
+        }
+        copyTasks.push_back(std::move(copyTask));
+
+        src = std::move(dst);
+        srcSize = dstSize;
+    }
+
+    ComputeTask::DispatchGroupList groups;
+    groups.push_back(builder.finalize());
+    recorder->priv().add(ComputeTask::Make(std::move(groups)));
+    for (sk_sp<Task>& copyTask : copyTasks) {
+        recorder->priv().add(std::move(copyTask));
+    }
+    return true;
+}
+
 bool GenerateMipmaps(Recorder* recorder,
                      sk_sp<TextureProxy> texture,
                      const SkColorInfo& colorInfo) {
@@ -592,6 +668,16 @@ bool GenerateMipmaps(Recorder* recorder,
 
     SkASSERT(texture->mipmapped() == Mipmapped::kYes);
 
+    // The compute path writes the sampled texels as they are, so only use it when the render path
+    // wouldn't premultiply them either.
+    const Caps* caps = recorder->priv().caps();
+    if (caps->generateMipmapsWithCompute() && caps->computeSupport() &&
+        colorInfo.colorType() == kRGBA_8888_SkColorType &&
+        colorInfo.alphaType() != kUnpremul_SkAlphaType &&
+        generate_mipmaps_with_compute(recorder, texture)) {
+        return true;
+    }
+
     // Within a rescaling pass scratchImg is read from and a scratch surface is written to.
     // At the end of the pass the scratch surface's texture is wrapped and assigned to scratchImg.
     sk_sp<SkImage> scratchImg(
@@ -8,8 +8,10 @@
 #include "src/gpu/graphite/UploadTask.h"
 
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkPixmap.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "include/private/base/SkAlign.h"
+#include "include/private/base/SkTo.h"
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkMipmap.h"
 #include "src/core/SkTraceEvent.h"
@@ -155,8 +157,10 @@ UploadInstance UploadInstance::Make(Recorder* recorder,
     int32_t currentWidth = dstRect.width();
     int32_t currentHeight = dstRect.height();
     bool needsConversion = (srcColorInfo != dstColorInfo);
+    size_t uploadBytes = 0;
     for (unsigned int currentMipLevel = 0; currentMipLevel < mipLevelCount; currentMipLevel++) {
         const size_t trimRowBytes = currentWidth * bpp;
+        uploadBytes += trimRowBytes * currentHeight;
         const size_t srcRowBytes = levels[currentMipLevel].fRowBytes;
         const auto [mipOffset, dstRowBytes] = levelOffsetsAndRowBytes[currentMipLevel];
 
@@ -216,11 +220,79 @@ UploadInstance UploadInstance::Make(Recorder* recorder,
     ATRACE_ANDROID_FRAMEWORK("Upload %sTexture [%ux%u]",
                              mipLevelCount > 1 ? "MipMap " : "",
                              dstRect.width(), dstRect.height());
+    recorder->priv().sharedContext()->counters()->add(GpuCounter::kTextureUploadBytes,
+                                                      uploadBytes);
 
     return {bufferInfo.fBuffer, bpp, std::move(textureProxy), std::move(copyData),
             std::move(condContext)};
 }
 
+std::vector<UploadInstance> UploadInstance::MakeInPlace(
+        Recorder* recorder,
+        SkSpan<const sk_sp<TextureProxy>> targetProxies,
+        SkSpan<const SkColorInfo> colorInfos,
+        SkSpan<SkPixmap> dstPixmaps) {
+    SkASSERT(targetProxies.size() == colorInfos.size());
+    SkASSERT(targetProxies.size() == dstPixmaps.size());
+    const Caps* caps = recorder->priv().caps();
+
+    // Lay out every upload within one allocation, each at an offset that satisfies its own
+    // alignment. The alignments are all powers of two, so the largest one satisfies them all.
+    TArray<std::pair<size_t, size_t>> offsetsAndRowBytes(SkToInt(targetProxies.size()));
+    size_t combinedBufferSize = 0;
+    size_t combinedAlignment = 1;
+    for (size_t i = 0; i < targetProxies.size(); ++i) {
+        const TextureProxy* proxy = targetProxies[i].get();
+        const SkColorType ct = colorInfos[i].colorType();
+        SkASSERT(caps->isTexturable(proxy->textureInfo()));
+        SkASSERT(proxy->mipmapped() == Mipmapped::kNo);
+        SkASSERT(caps->supportedWritePixelsColorType(ct, proxy->textureInfo(), ct) ==
+                 std::make_pair(ct, false));
+
+        TArray<std::pair<size_t, size_t>> levelOffsetsAndRowBytes(1);
+        auto [size, alignment] = compute_combined_buffer_size(caps,
+                                                              /*mipLevelCount=*/1,
+                                                              SkColorTypeBytesPerPixel(ct),
+                                                              proxy->dimensions(),
+                                                              &levelOffsetsAndRowBytes);
+        combinedBufferSize = SkAlignTo(combinedBufferSize, alignment);
+        offsetsAndRowBytes.push_back({combinedBufferSize, levelOffsetsAndRowBytes[0].second});
+        combinedBufferSize += size;
+        combinedAlignment = std::max(combinedAlignment, alignment);
+    }
+
+    UploadBufferManager* bufferMgr = recorder->priv().uploadBufferManager();
+    auto [writer, bufferInfo] =
+            bufferMgr->getTextureUploadWriter(combinedBufferSize, combinedAlignment);
+    if (!bufferInfo.fBuffer) {
+        return {};
+    }
+
+    std::vector<UploadInstance> instances;
+    instances.reserve(targetProxies.size());
+    for (size_t i = 0; i < targetProxies.size(); ++i) {
+        const SkISize dimensions = targetProxies[i]->dimensions();
+        const auto [offset, rowBytes] = offsetsAndRowBytes[i];
+        dstPixmaps[i].reset(SkImageInfo::Make(dimensions, colorInfos[i]),
+                            writer.writableAddr(offset, rowBytes * dimensions.height()),
+                            rowBytes);
+
+        std::vector<BufferTextureCopyData> copyData(1);
+        copyData[0].fBufferOffset = bufferInfo.fOffset + offset;
+        copyData[0].fBufferRowBytes = rowBytes;
+        copyData[0].fRect = SkIRect::MakeSize(dimensions);
+        copyData[0].fMipLevel = 0;
+
+        const size_t bpp = SkColorTypeBytesPerPixel(colorInfos[i].colorType());
+        instances.push_back({bufferInfo.fBuffer,
+                             bpp,
+                             targetProxies[i],
+                             std::move(copyData),
+                             std::make_unique<ImageUploadContext>()});
+    }
+    return instances;
+}
+
 bool UploadInstance::prepareResources(ResourceProvider* resourceProvider) {
     if (!fTextureProxy) {
         SKGPU_LOG_E("No texture proxy specified for UploadTask");
@@ -295,6 +367,15 @@ bool UploadList::recordUpload(Recorder* recorder,
     return true;
 }
 
+bool UploadList::recordUpload(UploadInstance instance) {
+    if (!instance.isValid()) {
+        return false;
+    }
+
+    fInstances.emplace_back(std::move(instance));
+    return true;
+}
+
 //---------------------------------------------------------------------------
 
 sk_sp<UploadTask> UploadTask::Make(UploadList* uploadList) {
@@ -16,6 +16,9 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+
+class SkPixmap;
 
 namespace skgpu::graphite {
 
@@ -77,6 +80,23 @@ public:
                                const std::vector<MipLevel>& levels,
                                const SkIRect& dstRect,
                                std::unique_ptr<ConditionalUploadContext>);
+
+    static UploadInstance Invalid() { return {}; }
+
+    /**
+     * Reserves upload buffer memory for a single level upload to each of 'targetProxies' and
+     * points 'dstPixmaps' at it, instead of copying pixels that already exist elsewhere. The
+     * caller must write the pixels before the Recorder's next snap(). All the uploads share one
+     * buffer allocation, and each upload happens once (as with an ImageUploadContext).
+     *
+     * Each 'colorInfos' entry must be writable to its proxy without conversion. Returns an
+     * instance per proxy, or an empty vector if the memory could not be allocated.
+     */
+    static std::vector<UploadInstance> MakeInPlace(Recorder*,
+                                                   SkSpan<const sk_sp<TextureProxy>> targetProxies,
+                                                   SkSpan<const SkColorInfo> colorInfos,
+                                                   SkSpan<SkPixmap> dstPixmaps);
+
     UploadInstance(UploadInstance&&);
     UploadInstance& operator=(UploadInstance&&);
     ~UploadInstance();
@@ -121,6 +141,7 @@ public:
                       const std::vector<MipLevel>& levels,
                       const SkIRect& dstRect,
                       std::unique_ptr<ConditionalUploadContext>);
+    bool recordUpload(UploadInstance);
 
     int size() { return fInstances.size(); }
 
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/graphite/compute/MipmapComputeStep.h"
+
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkTileMode.h"
+#include "include/private/base/SkAssert.h"
+
+namespace skgpu::graphite {
+namespace {
+
+constexpr uint32_t kWorkgroupSize = 8;
+
+}  // namespace
+
+MipmapDownsampleComputeStep::MipmapDownsampleComputeStep()
+        : ComputeStep(
+                  /*name=*/"MipmapDownsample",
+                  /*localDispatchSize=*/{kWorkgroupSize, kWorkgroupSize, 1},
+                  /*resources=*/
+                  {
+                          {
+                                  /*type=*/ResourceType::kWriteOnlyStorageTexture,
+                                  /*flow=*/DataFlow::kShared,
+                                  /*policy=*/ResourcePolicy::kNone,
+                                  /*slot=*/kMipmapSlot_Dst,
+                                  /*sksl=*/"dst",
+                          },
+                          {
+                                  /*type=*/ResourceType::kSampledTexture,
+                                  /*flow=*/DataFlow::kShared,
+                                  /*policy=*/ResourcePolicy::kNone,
+                                  /*slot=*/kMipmapSlot_Src,
+                                  /*sksl=*/"src",
+                          },
+                  }) {}
+
+std::string MipmapDownsampleComputeStep::computeSkSL() const {
+    return R"(
+        void main() {
+            uint2 dstSize = uint2(textureWidth(dst), textureHeight(dst));
+            uint2 dstCoord = sk_GlobalInvocationID.xy;
+            if (dstCoord.x < dstSize.x && dstCoord.y < dstSize.y) {
+                // Use explicit LOD, as quad derivatives are not available to a compute shader. The
+                // source of the first level is the mipmapped texture itself, whose lower levels
+                // aren't written yet.
+                float2 unormCoord = (float2(dstCoord) + 0.5) / float2(dstSize);
+                textureWrite(dst, dstCoord, sampleLod(src, unormCoord, 0));
+            }
+        }
+    )";
+}
+
+std::tuple<SkISize, SkColorType> MipmapDownsampleComputeStep::calculateTextureParameters(
+        int resourceIndex, const ResourceDesc&) const {
+    SkASSERT(resourceIndex == 0);
+    return {{1, 1}, kRGBA_8888_SkColorType};
+}
+
+SamplerDesc MipmapDownsampleComputeStep::calculateSamplerParameters(int resourceIndex,
+                                                                    const ResourceDesc&) const {
+    SkASSERT(resourceIndex == 1);
+    constexpr SkTileMode kTileModes[2] = {SkTileMode::kClamp, SkTileMode::kClamp};
+    return {SkFilterMode::kLinear, kTileModes};
+}
+
+WorkgroupSize MipmapDownsampleComputeStep::globalDispatchSize(SkISize dstSize) const {
+    return WorkgroupSize((dstSize.width() + kWorkgroupSize - 1) / kWorkgroupSize,
+                         (dstSize.height() + kWorkgroupSize - 1) / kWorkgroupSize,
+                         1);
+}
+
+}  // namespace skgpu::graphite
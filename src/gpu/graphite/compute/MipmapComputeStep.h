@@ -0,0 +1,50 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef skgpu_graphite_compute_MipmapComputeStep_DEFINED
+#define skgpu_graphite_compute_MipmapComputeStep_DEFINED
+
+#include "include/core/SkColorType.h"
+#include "include/core/SkSize.h"
+#include "src/gpu/graphite/compute/ComputeStep.h"
+
+#include <string>
+#include <tuple>
+
+namespace skgpu::graphite {
+
+// Writes one mip level of an RGBA_8888 texture by downsampling the level above it. Each invocation
+// writes one texel of the kMipmapSlot_Dst storage texture with a bilinear sample of the
+// kMipmapSlot_Src texture, taken at the center of that texel. That is a 2x2 box filter for even
+// dimensions and matches the drawImageRect() downsample that GenerateMipmaps() otherwise uses.
+//
+// Both slots must be assigned by the owner with DispatchGroup::Builder::assignSharedTexture()
+// before the step is appended with the global dispatch size from `globalDispatchSize(dstSize)`.
+// Appending one step per level to the same DispatchGroup generates a whole mip chain in a single
+// compute pass, since each dispatch waits for the one that wrote its source.
+constexpr int kMipmapSlot_Src = 0;
+constexpr int kMipmapSlot_Dst = 1;
+
+class MipmapDownsampleComputeStep final : public ComputeStep {
+public:
+    MipmapDownsampleComputeStep();
+    ~MipmapDownsampleComputeStep() override = default;
+
+    std::string computeSkSL() const override;
+
+    // Only used to validate the format of the assigned destination texture.
+    std::tuple<SkISize, SkColorType> calculateTextureParameters(
+            int resourceIndex, const ResourceDesc&) const override;
+
+    SamplerDesc calculateSamplerParameters(int resourceIndex, const ResourceDesc&) const override;
+
+    WorkgroupSize globalDispatchSize(SkISize dstSize) const;
+};
+
+}  // namespace skgpu::graphite
+
+#endif  // skgpu_graphite_compute_MipmapComputeStep_DEFINED
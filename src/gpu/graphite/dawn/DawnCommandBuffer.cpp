@@ -7,6 +7,7 @@
 
 #include "src/gpu/graphite/dawn/DawnCommandBuffer.h"
 
+#include "include/private/base/SkTArray.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/TextureProxy.h"
 #include "src/gpu/graphite/compute/DispatchGroup.h"
@@ -78,6 +79,8 @@ void DawnCommandBuffer::onResetCommandBuffer() {
     fActiveRenderPassEncoder = nullptr;
     fActiveComputePassEncoder = nullptr;
     fCommandEncoder = nullptr;
+    fBoundUniformBindGroup = nullptr;
+    fBoundTextureBindGroup = nullptr;
 
     for (auto& bufferSlot : fBoundUniformBuffers) {
         bufferSlot = nullptr;
@@ -390,6 +393,9 @@ void DawnCommandBuffer::endRenderPass() {
     SkASSERT(fActiveRenderPassEncoder);
     fActiveRenderPassEncoder.End();
     fActiveRenderPassEncoder = nullptr;
+    // Bind groups don't carry over to the next render pass.
+    fBoundUniformBindGroup = nullptr;
+    fBoundTextureBindGroup = nullptr;
 }
 
 void DawnCommandBuffer::addDrawPass(const DrawPass* drawPass) {
@@ -539,48 +545,23 @@ void DawnCommandBuffer::bindTextureAndSamplers(
     SkASSERT(fActiveRenderPassEncoder);
     SkASSERT(fActiveGraphicsPipeline);
 
-    wgpu::BindGroup bindGroup;
-    if (command.fNumTexSamplers == 1) {
-        // Optimize for single texture.
-        SkASSERT(fActiveGraphicsPipeline->numTexturesAndSamplers() == 2);
+    SkASSERT(fActiveGraphicsPipeline->numTexturesAndSamplers() == 2 * command.fNumTexSamplers);
 
-        const auto* texture =
-                static_cast<const DawnTexture*>(drawPass.getTexture(command.fTextureIndices[0]));
-        const auto* sampler =
-                static_cast<const DawnSampler*>(drawPass.getSampler(command.fSamplerIndices[0]));
-
-        bindGroup = fResourceProvider->findOrCreateSingleTextureSamplerBindGroup(sampler, texture);
-    } else {
-        std::vector<wgpu::BindGroupEntry> entries(2 * command.fNumTexSamplers);
-
-        for (int i = 0; i < command.fNumTexSamplers; ++i) {
-            const auto* texture = static_cast<const DawnTexture*>(
-                    drawPass.getTexture(command.fTextureIndices[i]));
-            const auto* sampler = static_cast<const DawnSampler*>(
-                    drawPass.getSampler(command.fSamplerIndices[i]));
-            auto& wgpuTextureView = texture->sampleTextureView();
-            auto& wgpuSampler = sampler->dawnSampler();
-
-            // Assuming shader generator assigns binding slot to sampler then texture,
-            // then the next sampler and texture, and so on, we need to use
-            // 2 * i as base binding index of the sampler and texture.
-            // TODO: https://b.corp.google.com/issues/259457090:
-            // Better configurable way of assigning samplers and textures' bindings.
-            entries[2 * i].binding = 2 * i;
-            entries[2 * i].sampler = wgpuSampler;
-
-            entries[2 * i + 1].binding = 2 * i + 1;
-            entries[2 * i + 1].textureView = wgpuTextureView;
-        }
-
-        wgpu::BindGroupDescriptor desc;
-        const auto& groupLayouts = fActiveGraphicsPipeline->dawnGroupLayouts();
-        desc.layout = groupLayouts[DawnGraphicsPipeline::kTextureBindGroupIndex];
-        desc.entryCount = entries.size();
-        desc.entries = entries.data();
+    skia_private::STArray<4, const DawnSampler*> samplers;
+    skia_private::STArray<4, const DawnTexture*> textures;
+    for (int i = 0; i < command.fNumTexSamplers; ++i) {
+        textures.push_back(
+                static_cast<const DawnTexture*>(drawPass.getTexture(command.fTextureIndices[i])));
+        samplers.push_back(
+                static_cast<const DawnSampler*>(drawPass.getSampler(command.fSamplerIndices[i])));
+    }
 
-        bindGroup = fSharedContext->device().CreateBindGroup(&desc);
+    const wgpu::BindGroup& bindGroup =
+            fResourceProvider->findOrCreateTextureSamplerBindGroup(samplers, textures);
+    if (bindGroup.Get() == fBoundTextureBindGroup.Get()) {
+        return;
     }
+    fBoundTextureBindGroup = bindGroup;
 
     fActiveRenderPassEncoder.SetBindGroup(DawnGraphicsPipeline::kTextureBindGroupIndex, bindGroup);
 }
@@ -625,8 +606,16 @@ void DawnCommandBuffer::syncUniformBuffers() {
             dynamicOffsets[2] = 0;
         }
 
-        auto bindGroup =
+        const wgpu::BindGroup& bindGroup =
                 fResourceProvider->findOrCreateUniformBuffersBindGroup(boundBuffersAndSizes);
+        // Pipeline changes mark the uniforms dirty, but consecutive pipelines often use the same
+        // buffers and offsets.
+        if (bindGroup.Get() == fBoundUniformBindGroup.Get() &&
+            dynamicOffsets == fBoundUniformDynamicOffsets) {
+            return;
+        }
+        fBoundUniformBindGroup = bindGroup;
+        fBoundUniformDynamicOffsets = dynamicOffsets;
 
         fActiveRenderPassEncoder.SetBindGroup(DawnGraphicsPipeline::kUniformBufferBindGroupIndex,
                                               bindGroup,
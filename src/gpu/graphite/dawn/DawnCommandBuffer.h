@@ -143,6 +143,11 @@ private:
     std::array<uint32_t, DawnGraphicsPipeline::kNumUniformBuffers> fBoundUniformBufferOffsets;
     std::array<uint32_t, DawnGraphicsPipeline::kNumUniformBuffers> fBoundUniformBufferSizes;
 
+    // The bind groups last set on the active render pass, to skip setting them again.
+    wgpu::BindGroup fBoundUniformBindGroup;
+    std::array<uint32_t, DawnGraphicsPipeline::kNumUniformBuffers> fBoundUniformDynamicOffsets;
+    wgpu::BindGroup fBoundTextureBindGroup;
+
     wgpu::CommandEncoder fCommandEncoder;
     wgpu::RenderPassEncoder fActiveRenderPassEncoder;
     wgpu::ComputePassEncoder fActiveComputePassEncoder;
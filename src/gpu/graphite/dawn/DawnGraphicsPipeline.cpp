@@ -386,33 +386,11 @@ sk_sp<DawnGraphicsPipeline> DawnGraphicsPipeline::Make(const DawnSharedContext*
 
         bool hasFragmentSamplers = hasFragmentSkSL && numTexturesAndSamplers > 0;
         if (hasFragmentSamplers) {
-            if (numTexturesAndSamplers == 2) {
-                // Common case: single texture + sampler.
-                groupLayouts[1] =
-                        resourceProvider->getOrCreateSingleTextureSamplerBindGroupLayout();
-            } else {
-                std::vector<wgpu::BindGroupLayoutEntry> entries(numTexturesAndSamplers);
-                for (int i = 0; i < numTexturesAndSamplers;) {
-                    entries[i].binding = static_cast<uint32_t>(i);
-                    entries[i].visibility = wgpu::ShaderStage::Fragment;
-                    entries[i].sampler.type = wgpu::SamplerBindingType::Filtering;
-                    ++i;
-                    entries[i].binding = i;
-                    entries[i].visibility = wgpu::ShaderStage::Fragment;
-                    entries[i].texture.sampleType = wgpu::TextureSampleType::Float;
-                    entries[i].texture.viewDimension = wgpu::TextureViewDimension::e2D;
-                    entries[i].texture.multisampled = false;
-                    ++i;
-                }
-
-                wgpu::BindGroupLayoutDescriptor groupLayoutDesc;
-#if defined(SK_DEBUG)
-                groupLayoutDesc.label = step->name();
-#endif
-                groupLayoutDesc.entryCount = entries.size();
-                groupLayoutDesc.entries = entries.data();
-                groupLayouts[1] = device.CreateBindGroupLayout(&groupLayoutDesc);
-            }
+            // Each texture is bound with its sampler, and pipelines sampling the same number of
+            // textures share a layout so their bind groups can be cached across pipelines.
+            SkASSERT(numTexturesAndSamplers % 2 == 0);
+            groupLayouts[1] = resourceProvider->getOrCreateTextureSamplerBindGroupLayout(
+                    numTexturesAndSamplers / 2);
             if (!groupLayouts[1]) {
                 return {};
             }
@@ -9,6 +9,7 @@
 
 #include "include/gpu/graphite/BackendTexture.h"
 #include "include/private/base/SkAlign.h"
+#include "include/private/base/SkTo.h"
 #include "src/gpu/graphite/ComputePipeline.h"
 #include "src/gpu/graphite/dawn/DawnBuffer.h"
 #include "src/gpu/graphite/dawn/DawnComputePipeline.h"
@@ -19,6 +20,8 @@
 #include "src/gpu/graphite/dawn/DawnTexture.h"
 #include "src/sksl/SkSLCompiler.h"
 
+#include <vector>
+
 namespace skgpu::graphite {
 
 namespace {
@@ -147,6 +150,30 @@ UniqueKey make_texture_bind_group_key(const DawnSampler* sampler, const DawnText
 
     return uniqueKey;
 }
+UniqueKey make_textures_bind_group_key(SkSpan<const DawnSampler* const> samplers,
+                                       SkSpan<const DawnTexture* const> textures) {
+    static const UniqueKey::Domain kTexturesBindGroupDomain = UniqueKey::GenerateDomain();
+    SkASSERT(samplers.size() == textures.size());
+
+    UniqueKey uniqueKey;
+    {
+        // The key's length distinguishes bind groups with different numbers of textures, which
+        // have different layouts.
+        UniqueKey::Builder builder(&uniqueKey,
+                                   kTexturesBindGroupDomain,
+                                   SkToInt(2 * samplers.size()),
+                                   "GraphicsPipelineTextureSamplerBindGroup");
+
+        for (size_t i = 0; i < samplers.size(); ++i) {
+            builder[2 * i] = samplers[i]->uniqueID().asUInt();
+            builder[2 * i + 1] = textures[i]->uniqueID().asUInt();
+        }
+
+        builder.finish();
+    }
+
+    return uniqueKey;
+}
 }  // namespace
 
 DawnResourceProvider::DawnResourceProvider(SharedContext* sharedContext,
@@ -155,7 +182,8 @@ DawnResourceProvider::DawnResourceProvider(SharedContext* sharedContext,
                                            size_t resourceBudget)
         : ResourceProvider(sharedContext, singleOwner, recorderID, resourceBudget)
         , fUniformBufferBindGroupCache(kMaxNumberOfCachedBufferBindGroups)
-        , fSingleTextureSamplerBindGroups(kMaxNumberOfCachedTextureBindGroups) {}
+        , fSingleTextureSamplerBindGroups(kMaxNumberOfCachedTextureBindGroups)
+        , fTextureSamplerBindGroups(kMaxNumberOfCachedTextureBindGroups) {}
 
 DawnResourceProvider::~DawnResourceProvider() = default;
 
@@ -401,6 +429,42 @@ DawnResourceProvider::getOrCreateSingleTextureSamplerBindGroupLayout() {
     return fSingleTextureSamplerBindGroupLayout;
 }
 
+const wgpu::BindGroupLayout& DawnResourceProvider::getOrCreateTextureSamplerBindGroupLayout(
+        int numTexSamplers) {
+    SkASSERT(numTexSamplers > 0);
+    if (numTexSamplers == 1) {
+        return this->getOrCreateSingleTextureSamplerBindGroupLayout();
+    }
+    if (const wgpu::BindGroupLayout* layout = fTextureSamplerBindGroupLayouts.find(numTexSamplers)) {
+        return *layout;
+    }
+
+    // The shader generator assigns the binding slot of each sampler followed by its texture.
+    std::vector<wgpu::BindGroupLayoutEntry> entries(2 * numTexSamplers);
+    for (int i = 0; i < numTexSamplers; ++i) {
+        entries[2 * i].binding = 2 * i;
+        entries[2 * i].visibility = wgpu::ShaderStage::Fragment;
+        entries[2 * i].sampler.type = wgpu::SamplerBindingType::Filtering;
+
+        entries[2 * i + 1].binding = 2 * i + 1;
+        entries[2 * i + 1].visibility = wgpu::ShaderStage::Fragment;
+        entries[2 * i + 1].texture.sampleType = wgpu::TextureSampleType::Float;
+        entries[2 * i + 1].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+        entries[2 * i + 1].texture.multisampled = false;
+    }
+
+    wgpu::BindGroupLayoutDescriptor groupLayoutDesc;
+#if defined(SK_DEBUG)
+    groupLayoutDesc.label = "Multiple textures + samplers bind group layout";
+#endif
+
+    groupLayoutDesc.entryCount = entries.size();
+    groupLayoutDesc.entries = entries.data();
+    return *fTextureSamplerBindGroupLayouts.set(
+            numTexSamplers,
+            this->dawnSharedContext()->device().CreateBindGroupLayout(&groupLayoutDesc));
+}
+
 const wgpu::Buffer& DawnResourceProvider::getOrCreateNullBuffer() {
     if (!fNullBuffer) {
         wgpu::BufferDescriptor desc;
@@ -490,4 +554,38 @@ const wgpu::BindGroup& DawnResourceProvider::findOrCreateSingleTextureSamplerBin
     return *fSingleTextureSamplerBindGroups.insert(key, bindGroup);
 }
 
+const wgpu::BindGroup& DawnResourceProvider::findOrCreateTextureSamplerBindGroup(
+        SkSpan<const DawnSampler* const> samplers, SkSpan<const DawnTexture* const> textures) {
+    SkASSERT(samplers.size() == textures.size());
+    if (samplers.size() == 1) {
+        return this->findOrCreateSingleTextureSamplerBindGroup(samplers[0], textures[0]);
+    }
+
+    auto key = make_textures_bind_group_key(samplers, textures);
+    auto* existingBindGroup = fTextureSamplerBindGroups.find(key);
+    if (existingBindGroup) {
+        // cache hit.
+        return *existingBindGroup;
+    }
+
+    std::vector<wgpu::BindGroupEntry> entries(2 * samplers.size());
+    for (size_t i = 0; i < samplers.size(); ++i) {
+        entries[2 * i].binding = 2 * i;
+        entries[2 * i].sampler = samplers[i]->dawnSampler();
+
+        entries[2 * i + 1].binding = 2 * i + 1;
+        entries[2 * i + 1].textureView = textures[i]->sampleTextureView();
+    }
+
+    wgpu::BindGroupDescriptor desc;
+    desc.layout = this->getOrCreateTextureSamplerBindGroupLayout(samplers.size());
+    desc.entryCount = entries.size();
+    desc.entries = entries.data();
+
+    const auto& device = this->dawnSharedContext()->device();
+    auto bindGroup = device.CreateBindGroup(&desc);
+
+    return *fTextureSamplerBindGroups.insert(key, bindGroup);
+}
+
 } // namespace skgpu::graphite
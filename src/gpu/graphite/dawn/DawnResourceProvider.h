@@ -8,6 +8,7 @@
 #ifndef skgpu_graphite_DawnResourceProvider_DEFINED
 #define skgpu_graphite_DawnResourceProvider_DEFINED
 
+#include "include/core/SkSpan.h"
 #include "src/core/SkLRUCache.h"
 #include "src/core/SkTHash.h"
 #include "src/gpu/graphite/ResourceProvider.h"
@@ -39,6 +40,9 @@ public:
 
     const wgpu::BindGroupLayout& getOrCreateUniformBuffersBindGroupLayout();
     const wgpu::BindGroupLayout& getOrCreateSingleTextureSamplerBindGroupLayout();
+    // Layouts for more than one texture + sampler are shared by every pipeline that samples the
+    // same number of textures, so that their bind groups can be shared too.
+    const wgpu::BindGroupLayout& getOrCreateTextureSamplerBindGroupLayout(int numTexSamplers);
 
     // Find the cached bind group or create a new one based on the bound buffers and their
     // binding sizes (boundBuffersAndSizes) for these uniforms (in order):
@@ -52,6 +56,11 @@ public:
     const wgpu::BindGroup& findOrCreateSingleTextureSamplerBindGroup(const DawnSampler* sampler,
                                                                      const DawnTexture* texture);
 
+    // Find or create a bind group containing the given samplers & textures, for the layout
+    // returned by getOrCreateTextureSamplerBindGroupLayout(samplers.size()).
+    const wgpu::BindGroup& findOrCreateTextureSamplerBindGroup(
+            SkSpan<const DawnSampler* const> samplers, SkSpan<const DawnTexture* const> textures);
+
 private:
     sk_sp<GraphicsPipeline> createGraphicsPipeline(const RuntimeEffectDictionary*,
                                                    const GraphicsPipelineDesc&,
@@ -76,6 +85,7 @@ private:
 
     wgpu::BindGroupLayout fUniformBuffersBindGroupLayout;
     wgpu::BindGroupLayout fSingleTextureSamplerBindGroupLayout;
+    skia_private::THashMap<int, wgpu::BindGroupLayout> fTextureSamplerBindGroupLayouts;
 
     wgpu::Buffer fNullBuffer;
 
@@ -87,6 +97,7 @@ private:
 
     BindGroupCache fUniformBufferBindGroupCache;
     BindGroupCache fSingleTextureSamplerBindGroups;
+    BindGroupCache fTextureSamplerBindGroups;
 };
 
 } // namespace skgpu::graphite
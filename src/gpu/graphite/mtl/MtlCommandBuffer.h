@@ -100,7 +100,7 @@ private:
     void bindIndexBuffer(const Buffer* indexBuffer, size_t offset);
     void bindIndirectBuffer(const Buffer* indirectBuffer, size_t offset);
 
-    void bindTextureAndSampler(const Texture*, const Sampler*, unsigned int bindIndex);
+    void bindTexturesAndSamplers(const DrawPass&, const DrawPassCommands::BindTexturesAndSamplers&);
 
     void setScissor(unsigned int left, unsigned int top,
                     unsigned int width, unsigned int height);
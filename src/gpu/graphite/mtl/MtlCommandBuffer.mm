@@ -377,11 +377,7 @@ void MtlCommandBuffer::addDrawPass(const DrawPass* drawPass) {
             }
             case DrawPassCommands::Type::kBindTexturesAndSamplers: {
                 auto bts = static_cast<DrawPassCommands::BindTexturesAndSamplers*>(cmdPtr);
-                for (int j = 0; j < bts->fNumTexSamplers; ++j) {
-                    this->bindTextureAndSampler(drawPass->getTexture(bts->fTextureIndices[j]),
-                                                drawPass->getSampler(bts->fSamplerIndices[j]),
-                                                j);
-                }
+                this->bindTexturesAndSamplers(*drawPass, *bts);
                 break;
             }
             case DrawPassCommands::Type::kSetScissor: {
@@ -546,16 +542,23 @@ void MtlCommandBuffer::bindIndirectBuffer(const Buffer* indirectBuffer, size_t o
     }
 }
 
-void MtlCommandBuffer::bindTextureAndSampler(const Texture* texture,
-                                             const Sampler* sampler,
-                                             unsigned int bindIndex) {
-    SkASSERT(texture && sampler);
+void MtlCommandBuffer::bindTexturesAndSamplers(
+        const DrawPass& drawPass, const DrawPassCommands::BindTexturesAndSamplers& command) {
     SkASSERT(fActiveRenderCommandEncoder);
 
-    id<MTLTexture> mtlTexture = ((const MtlTexture*)texture)->mtlTexture();
-    id<MTLSamplerState> mtlSamplerState = ((const MtlSampler*)sampler)->mtlSamplerState();
-    fActiveRenderCommandEncoder->setFragmentTexture(mtlTexture, bindIndex);
-    fActiveRenderCommandEncoder->setFragmentSamplerState(mtlSamplerState, bindIndex);
+    SkASSERT(command.fNumTexSamplers <= MtlRenderCommandEncoder::kMaxExpectedTextures);
+    id<MTLTexture> mtlTextures[MtlRenderCommandEncoder::kMaxExpectedTextures];
+    id<MTLSamplerState> mtlSamplerStates[MtlRenderCommandEncoder::kMaxExpectedTextures];
+    for (int i = 0; i < command.fNumTexSamplers; ++i) {
+        const Texture* texture = drawPass.getTexture(command.fTextureIndices[i]);
+        const Sampler* sampler = drawPass.getSampler(command.fSamplerIndices[i]);
+        SkASSERT(texture && sampler);
+        mtlTextures[i] = ((const MtlTexture*)texture)->mtlTexture();
+        mtlSamplerStates[i] = ((const MtlSampler*)sampler)->mtlSamplerState();
+    }
+    fActiveRenderCommandEncoder->setFragmentTexturesAndSamplers(mtlTextures,
+                                                                mtlSamplerStates,
+                                                                command.fNumTexSamplers);
 }
 
 void MtlCommandBuffer::setScissor(unsigned int left, unsigned int top,
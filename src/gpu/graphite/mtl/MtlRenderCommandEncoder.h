@@ -14,6 +14,8 @@
 
 #import <Metal/Metal.h>
 
+#include <algorithm>
+
 namespace skgpu::graphite {
 
 /**
@@ -21,6 +23,8 @@ namespace skgpu::graphite {
  */
 class MtlRenderCommandEncoder : public Resource {
 public:
+    inline static constexpr int kMaxExpectedTextures = 16;
+
     static sk_sp<MtlRenderCommandEncoder> Make(const SharedContext* sharedContext,
                                                id<MTLCommandBuffer> commandBuffer,
                                                MTLRenderPassDescriptor* descriptor) {
@@ -153,6 +157,38 @@ public:
         }
     }
 
+    // Binds count textures and samplers to indices [0, count), encoding one call for each of the
+    // textures and samplers that covers only the slots that changed.
+    void setFragmentTexturesAndSamplers(const id<MTLTexture> textures[],
+                                        const id<MTLSamplerState> samplers[],
+                                        int count) {
+        SkASSERT(count <= kMaxExpectedTextures);
+        int firstTexture = count, lastTexture = -1;
+        int firstSampler = count, lastSampler = -1;
+        for (int i = 0; i < count; i++) {
+            if (fCurrentTexture[i] != textures[i]) {
+                firstTexture = std::min(firstTexture, i);
+                lastTexture = i;
+                fCurrentTexture[i] = textures[i];
+            }
+            if (fCurrentSampler[i] != samplers[i]) {
+                firstSampler = std::min(firstSampler, i);
+                lastSampler = i;
+                fCurrentSampler[i] = samplers[i];
+            }
+        }
+        if (lastTexture >= firstTexture) {
+            NSRange range = NSMakeRange(firstTexture, lastTexture - firstTexture + 1);
+            [(*fCommandEncoder) setFragmentTextures:textures + firstTexture
+                                          withRange:range];
+        }
+        if (lastSampler >= firstSampler) {
+            NSRange range = NSMakeRange(firstSampler, lastSampler - firstSampler + 1);
+            [(*fCommandEncoder) setFragmentSamplerStates:samplers + firstSampler
+                                               withRange:range];
+        }
+    }
+
     void setBlendColor(float blendConst[4]) {
         [(*fCommandEncoder) setBlendColorRed: blendConst[0]
                                        green: blendConst[1]
@@ -251,7 +287,6 @@ public:
 
 private:
     inline static constexpr int kMaxExpectedBuffers = 5;
-    inline static constexpr int kMaxExpectedTextures = 16;
 
     MtlRenderCommandEncoder(const SharedContext* sharedContext,
                             sk_cfp<id<MTLRenderCommandEncoder>> encoder)
@@ -30,9 +30,9 @@ constexpr int kNumSDFAtlasTextures = 4;
 
 }  // namespace
 
-SDFTextRenderStep::SDFTextRenderStep(bool isLCD)
+SDFTextRenderStep::SDFTextRenderStep(bool isLCD, bool isMultiChannel)
         : RenderStep("SDFTextRenderStep",
-                     isLCD ? "565" : "A8",
+                     isMultiChannel ? "MSDF" : isLCD ? "565" : "A8",
                      isLCD ? Flags::kPerformsShading | Flags::kHasTextures | Flags::kEmitsCoverage |
                              Flags::kLCDCoverage
                            : Flags::kPerformsShading | Flags::kHasTextures | Flags::kEmitsCoverage,
@@ -54,8 +54,9 @@ SDFTextRenderStep::SDFTextRenderStep(bool isLCD)
                      /*varyings=*/
                      {{"unormTexCoords", SkSLType::kFloat2},
                       {"textureCoords", SkSLType::kFloat2},
-                      {"texIndex", SkSLType::kFloat}}) {
-    // TODO: store if it's A8 and adjust shader
+                      {"texIndex", SkSLType::kFloat}})
+        , fIsMultiChannel(isMultiChannel) {
+    SkASSERT(!(isLCD && isMultiChannel));
 }
 
 SDFTextRenderStep::~SDFTextRenderStep() {}
@@ -100,6 +101,19 @@ const char* SDFTextRenderStep::fragmentCoverageSkSL() const {
     // TODO: Need to add 565 support.
     // TODO: Need aliased and possibly sRGB support.
     static_assert(kNumSDFAtlasTextures == 4);
+    if (fIsMultiChannel) {
+        // The median of the three channels keeps the corners of the field sharp.
+        return "half4 msdf = sample_indexed_atlas(textureCoords, "
+                                                 "int(texIndex), "
+                                                 "sdf_atlas_0, "
+                                                 "sdf_atlas_1, "
+                                                 "sdf_atlas_2, "
+                                                 "sdf_atlas_3);"
+               "outputCoverage = sdf_text_coverage_fn(max(min(msdf.r, msdf.g), "
+                                                         "min(max(msdf.r, msdf.g), msdf.b)), "
+                                                     "half(distAdjust), "
+                                                     "unormTexCoords);";
+    }
     return "outputCoverage = sdf_text_coverage_fn(sample_indexed_atlas(textureCoords, "
                                                                       "int(texIndex), "
                                                                       "sdf_atlas_0, "
@@ -16,7 +16,9 @@ namespace skgpu::graphite {
 
 class SDFTextRenderStep final : public RenderStep {
 public:
-    SDFTextRenderStep(bool isLCD);
+    // A multi-channel step samples the color atlas and takes the median of r, g and b as the
+    // distance.
+    SDFTextRenderStep(bool isLCD, bool isMultiChannel = false);
 
     ~SDFTextRenderStep() override;
 
@@ -27,6 +29,9 @@ public:
 
     void writeVertices(DrawWriter*, const DrawParams&, skvx::ushort2 ssboIndices) const override;
     void writeUniformsAndTextures(const DrawParams&, PipelineDataGatherer*) const override;
+
+private:
+    const bool fIsMultiChannel;
 };
 
 }  // namespace skgpu::graphite
@@ -9,6 +9,7 @@
 
 #include "include/core/SkColorSpace.h"
 #include "include/gpu/graphite/Recorder.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkAutoMalloc.h"
 #include "src/core/SkDistanceFieldGen.h"
 #include "src/core/SkMasks.h"
@@ -339,6 +340,19 @@ std::tuple<bool, int> GlyphVector::regenerateAtlasForGraphite(int begin,
 
         // Update the atlas information in the GrStrike.
         auto glyphs = fGlyphs.subspan(begin, end - begin);
+
+        // Fetch the images of all the glyphs missing from the atlas in one batch, which the
+        // strike may rasterize in parallel.
+        skia_private::STArray<64, SkPackedGlyphID> missingIDs;
+        for (const Variant& variant : glyphs) {
+            if (!atlasManager->hasGlyph(maskFormat, variant.glyph)) {
+                missingIDs.push_back(variant.glyph->fPackedID);
+            }
+        }
+        if (missingIDs.size() > 1) {
+            metricsAndImages.glyphs(missingIDs);
+        }
+
         int glyphsPlacedInAtlas = 0;
         bool success = true;
         for (const Variant& variant : glyphs) {
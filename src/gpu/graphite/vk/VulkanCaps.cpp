@@ -134,6 +134,14 @@ void VulkanCaps::init(const ContextOptions& contextOptions,
     }
     fMaxUniformBufferRange = physDevProperties.limits.maxUniformBufferRange;
 
+    // timestampComputeAndGraphics guarantees that every graphics queue supports timestamps, so we
+    // don't need to know which queue family the context was made with. Protected command buffers
+    // are not timed.
+    fTimestampPeriod = physDevProperties.limits.timestampPeriod;
+    fGpuTimestampSupport = physDevProperties.limits.timestampComputeAndGraphics &&
+                           fTimestampPeriod > 0 &&
+                           isProtected == Protected::kNo;
+
 #ifdef SK_BUILD_FOR_ANDROID
     if (extensions->hasExtension(
             VK_ANDROID_EXTERNAL_MEMORY_ANDROID_HARDWARE_BUFFER_EXTENSION_NAME, 2)) {
@@ -86,6 +86,9 @@ public:
     }
     uint64_t maxUniformBufferRange() const { return fMaxUniformBufferRange; }
 
+    // The number of nanoseconds per timestamp query tick.
+    float timestampPeriod() const { return fTimestampPeriod; }
+
     const VkPhysicalDeviceMemoryProperties2& physicalDeviceMemoryProperties2() const {
         return fPhysicalDeviceMemoryProperties2;
     }
@@ -227,6 +230,7 @@ private:
 
     uint32_t fMaxVertexAttributes;
     uint64_t fMaxUniformBufferRange;
+    float fTimestampPeriod = 0;
     VkPhysicalDeviceMemoryProperties2 fPhysicalDeviceMemoryProperties2;
 
     // Various bools to define whether certain Vulkan features are supported.
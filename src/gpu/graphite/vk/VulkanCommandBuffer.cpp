@@ -16,6 +16,7 @@
 #include "src/gpu/graphite/Surface_Graphite.h"
 #include "src/gpu/graphite/TextureProxy.h"
 #include "src/gpu/graphite/vk/VulkanBuffer.h"
+#include "src/gpu/graphite/vk/VulkanCaps.h"
 #include "src/gpu/graphite/vk/VulkanDescriptorSet.h"
 #include "src/gpu/graphite/vk/VulkanFramebuffer.h"
 #include "src/gpu/graphite/vk/VulkanGraphiteUtilsPriv.h"
@@ -117,6 +118,11 @@ VulkanCommandBuffer::~VulkanCommandBuffer() {
                                                               fSubmitFence,
                                                               nullptr));
     }
+    if (VK_NULL_HANDLE != fTimestampQueryPool) {
+        VULKAN_CALL(fSharedContext->interface(), DestroyQueryPool(fSharedContext->device(),
+                                                                  fTimestampQueryPool,
+                                                                  nullptr));
+    }
     // This should delete any command buffers as well.
     VULKAN_CALL(fSharedContext->interface(), DestroyCommandPool(fSharedContext->device(),
                                                                 fPool,
@@ -146,6 +152,8 @@ void VulkanCommandBuffer::onResetCommandBuffer() {
     for (auto& boundInputOffset : fBoundInputBufferOffsets) {
         boundInputOffset = 0;
     }
+    fTimestampQueryPoolReset = false;
+    fTimestampQueryCount = 0;
 }
 
 bool VulkanCommandBuffer::setNewCommandBufferResources() {
@@ -425,6 +433,8 @@ bool VulkanCommandBuffer::onAddRenderPass(const RenderPassDesc& renderPassDesc,
 
     this->updateRtAdjustUniform(viewport);
     this->setViewport(viewport);
+    // Queries can only be reset outside of a render pass.
+    this->prepareTimestampQueries();
 
     if (!this->beginRenderPass(renderPassDesc, colorTexture, resolveTexture, depthStencilTexture)) {
         return false;
@@ -819,7 +829,9 @@ void VulkanCommandBuffer::addDrawPass(const DrawPass* drawPass) {
         switch (type) {
             case DrawPassCommands::Type::kBindGraphicsPipeline: {
                 auto bgp = static_cast<DrawPassCommands::BindGraphicsPipeline*>(cmdPtr);
+                this->endTimedDraws();
                 this->bindGraphicsPipeline(drawPass->getPipeline(bgp->fPipelineIndex));
+                this->beginTimedDraws(drawPass->getPipelineDesc(bgp->fPipelineIndex));
                 break;
             }
             case DrawPassCommands::Type::kSetBlendConstants: {
@@ -891,6 +903,68 @@ void VulkanCommandBuffer::addDrawPass(const DrawPass* drawPass) {
             }
         }
     }
+    this->endTimedDraws();
+}
+
+bool VulkanCommandBuffer::prepareTimestampQueries() {
+    if (!this->gpuTimingsEnabled()) {
+        return false;
+    }
+    if (fTimestampQueryPoolReset) {
+        return true;
+    }
+    SkASSERT(!fActiveRenderPass);
+    if (fTimestampQueryPool == VK_NULL_HANDLE) {
+        VkQueryPoolCreateInfo createInfo;
+        memset(&createInfo, 0, sizeof(VkQueryPoolCreateInfo));
+        createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount = kMaxTimestampQueries;
+        VkResult result;
+        VULKAN_CALL_RESULT(fSharedContext->interface(), result,
+                           CreateQueryPool(fSharedContext->device(),
+                                           &createInfo,
+                                           nullptr,
+                                           &fTimestampQueryPool));
+        if (result != VK_SUCCESS) {
+            fTimestampQueryPool = VK_NULL_HANDLE;
+            return false;
+        }
+    }
+    VULKAN_CALL(fSharedContext->interface(), CmdResetQueryPool(fPrimaryCommandBuffer,
+                                                               fTimestampQueryPool,
+                                                               0,
+                                                               kMaxTimestampQueries));
+    fTimestampQueryPoolReset = true;
+    return true;
+}
+
+void VulkanCommandBuffer::beginTimedDraws(const GraphicsPipelineDesc& pipelineDesc) {
+    SkASSERT(!fTimingDraws);
+    if (!fTimestampQueryPoolReset || !this->gpuTimingsEnabled() ||
+        fTimestampQueryCount + 2 > kMaxTimestampQueries) {
+        return;
+    }
+    // Both timestamps are taken at the bottom of the pipe, so a run is measured from when the work
+    // before it finished to when its own work finished.
+    VULKAN_CALL(fSharedContext->interface(), CmdWriteTimestamp(fPrimaryCommandBuffer,
+                                                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                                               fTimestampQueryPool,
+                                                               fTimestampQueryCount));
+    this->addTimedDraws(pipelineDesc);
+    fTimingDraws = true;
+}
+
+void VulkanCommandBuffer::endTimedDraws() {
+    if (!fTimingDraws) {
+        return;
+    }
+    VULKAN_CALL(fSharedContext->interface(), CmdWriteTimestamp(fPrimaryCommandBuffer,
+                                                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                                               fTimestampQueryPool,
+                                                               fTimestampQueryCount + 1));
+    fTimestampQueryCount += 2;
+    fTimingDraws = false;
 }
 
 void VulkanCommandBuffer::bindGraphicsPipeline(const GraphicsPipeline* graphicsPipeline) {
@@ -1481,6 +1555,37 @@ bool VulkanCommandBuffer::onClearBuffer(const Buffer*, size_t offset, size_t siz
     return false;
 }
 
+bool VulkanCommandBuffer::onReadGpuTimings(SkSpan<uint64_t> nanoseconds) {
+    SkASSERT(nanoseconds.size() * 2 == fTimestampQueryCount);
+    if (!fTimestampQueryCount) {
+        return false;
+    }
+    // The command buffer has finished, so every query is available and there is no need to wait.
+    skia_private::AutoTMalloc<uint64_t> timestamps(fTimestampQueryCount);
+    VkResult result;
+    VULKAN_CALL_RESULT(fSharedContext->interface(), result,
+                       GetQueryPoolResults(fSharedContext->device(),
+                                           fTimestampQueryPool,
+                                           0,
+                                           fTimestampQueryCount,
+                                           fTimestampQueryCount * sizeof(uint64_t),
+                                           timestamps.get(),
+                                           sizeof(uint64_t),
+                                           VK_QUERY_RESULT_64_BIT));
+    if (result != VK_SUCCESS) {
+        return false;
+    }
+    const double period = static_cast<const VulkanCaps*>(fSharedContext->caps())->timestampPeriod();
+    for (size_t i = 0; i < nanoseconds.size(); ++i) {
+        uint64_t start = timestamps[2 * i];
+        uint64_t end = timestamps[2 * i + 1];
+        if (end >= start) {
+            nanoseconds[i] = static_cast<uint64_t>((end - start) * period);
+        }
+    }
+    return true;
+}
+
 void VulkanCommandBuffer::addBufferMemoryBarrier(const Resource* resource,
                                                  VkPipelineStageFlags srcStageMask,
                                                  VkPipelineStageFlags dstStageMask,
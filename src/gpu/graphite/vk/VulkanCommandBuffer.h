@@ -82,6 +82,11 @@ private:
 
     void addDrawPass(const DrawPass*);
 
+    // Write timestamps around each run of draws recorded with one pipeline while GPU timing is on.
+    bool prepareTimestampQueries();
+    void beginTimedDraws(const GraphicsPipelineDesc&);
+    void endTimedDraws();
+
     // Track descriptor changes for binding prior to draw calls
     void recordBufferBindingInfo(const BindBufferInfo& info, UniformSlot);
     void recordTextureAndSamplerDescSet(
@@ -144,6 +149,8 @@ private:
     bool onSynchronizeBufferToCpu(const Buffer*, bool* outDidResultInWork) override;
     bool onClearBuffer(const Buffer*, size_t offset, size_t size) override;
 
+    bool onReadGpuTimings(SkSpan<uint64_t> nanoseconds) override;
+
     enum BarrierType {
         kBufferMemory_BarrierType,
         kImageMemory_BarrierType
@@ -218,6 +225,13 @@ private:
     size_t fBoundIndirectBufferOffset = 0;
 
     float fCachedBlendConstant[4];
+
+    // Two queries per run of timed draws. Runs past the pool's capacity are not timed.
+    static constexpr uint32_t kMaxTimestampQueries = 1024;
+    VkQueryPool fTimestampQueryPool = VK_NULL_HANDLE;
+    bool fTimestampQueryPoolReset = false;
+    uint32_t fTimestampQueryCount = 0;
+    bool fTimingDraws = false;
 };
 
 } // namespace skgpu::graphite
@@ -9,6 +9,7 @@
 
 #include "include/gpu/graphite/ContextOptions.h"
 #include "include/gpu/vk/VulkanBackendContext.h"
+#include "include/gpu/vk/VulkanMemoryAllocator.h"
 #include "include/private/base/SkMutex.h"
 #include "src/gpu/graphite/Log.h"
 #include "src/gpu/graphite/ResourceTypes.h"
@@ -215,4 +216,9 @@ bool VulkanSharedContext::checkVkResult(VkResult result) const {
         return false;
     }
 }
+
+void VulkanSharedContext::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
+    fMemoryAllocator->dumpMemoryStatistics(traceMemoryDump);
+}
+
 } // namespace skgpu::graphite
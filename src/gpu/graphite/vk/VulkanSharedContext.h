@@ -50,6 +50,8 @@ public:
         return fDeviceIsLost;
     }
 
+    void dumpMemoryStatistics(SkTraceMemoryDump*) const override;
+
 private:
     VulkanSharedContext(const VulkanBackendContext&,
                         sk_sp<const skgpu::VulkanInterface> interface,
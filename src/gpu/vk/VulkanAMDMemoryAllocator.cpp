@@ -7,6 +7,8 @@
 
 #include "src/gpu/vk/VulkanAMDMemoryAllocator.h"
 
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/gpu/vk/VulkanExtensions.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/vk/VulkanInterface.h"
@@ -134,6 +136,12 @@ VkResult VulkanAMDMemoryAllocator::allocateImageMemory(VkImage image,
         info.requiredFlags |= VK_MEMORY_PROPERTY_PROTECTED_BIT;
     }
 
+    // Images (textures, atlases and render targets) mostly live in the resource cache for many
+    // frames, so it's worth the extra search to place them in the smallest free range that fits.
+    // This keeps large free ranges intact for later images instead of splintering them, which is
+    // what otherwise leads to allocation failures long before the budget is reached.
+    info.flags |= VMA_ALLOCATION_CREATE_STRATEGY_MIN_MEMORY_BIT;
+
     VmaAllocation allocation;
     VkResult result = vmaAllocateMemoryForImage(fAllocator, image, &info, &allocation, nullptr);
     if (VK_SUCCESS == result) {
@@ -275,6 +283,43 @@ std::pair<uint64_t, uint64_t> VulkanAMDMemoryAllocator::totalAllocatedAndUsedMem
     return {stats.total.statistics.blockBytes, stats.total.statistics.allocationBytes};
 }
 
+void VulkanAMDMemoryAllocator::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
+    VmaTotalStatistics stats;
+    vmaCalculateStatistics(fAllocator, &stats);
+    const VkPhysicalDeviceMemoryProperties* memoryProperties;
+    vmaGetMemoryProperties(fAllocator, &memoryProperties);
+
+    for (uint32_t i = 0; i < memoryProperties->memoryHeapCount; ++i) {
+        const VmaDetailedStatistics& heapStats = stats.memoryHeap[i];
+        if (heapStats.statistics.blockCount == 0) {
+            continue;
+        }
+        SkString dumpName = SkStringPrintf("skia/gpu_vulkan_memory/heap_%u", i);
+        const uint64_t unusedBytes =
+                heapStats.statistics.blockBytes - heapStats.statistics.allocationBytes;
+        // Free space that isn't part of the largest free range can only be used by allocations
+        // smaller than that range, so it's a measure of how fragmented the heap is.
+        const uint64_t fragmentedBytes =
+                heapStats.unusedRangeCount > 0 ? unusedBytes - heapStats.unusedRangeSizeMax : 0;
+
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "size", "bytes",
+                                          heapStats.statistics.blockBytes);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "allocated_size", "bytes",
+                                          heapStats.statistics.allocationBytes);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "unused_size", "bytes", unusedBytes);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "largest_unused_range", "bytes",
+                                          heapStats.unusedRangeCount > 0
+                                                  ? heapStats.unusedRangeSizeMax
+                                                  : 0);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "fragmented_size", "bytes",
+                                          fragmentedBytes);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "unused_range_count", "objects",
+                                          heapStats.unusedRangeCount);
+        traceMemoryDump->dumpNumericValue(dumpName.c_str(), "block_count", "objects",
+                                          heapStats.statistics.blockCount);
+    }
+}
+
 #endif // SK_USE_VMA
 
 } // namespace skgpu
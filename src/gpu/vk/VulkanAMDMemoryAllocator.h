@@ -65,6 +65,8 @@ public:
 
     std::pair<uint64_t, uint64_t> totalAllocatedAndUsedMemory() const override;
 
+    void dumpMemoryStatistics(SkTraceMemoryDump*) const override;
+
 private:
     VulkanAMDMemoryAllocator(VmaAllocator allocator);
 
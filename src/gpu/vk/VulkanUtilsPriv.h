@@ -41,9 +41,10 @@ inline bool SkSLToSPIRV(const SkSL::ShaderCaps* caps,
                         const SkSL::ProgramSettings& settings,
                         std::string* spirv,
                         SkSL::ProgramInterface* outInterface,
-                        ShaderErrorHandler* errorHandler) {
+                        ShaderErrorHandler* errorHandler,
+                        ShaderCompileTimes* times = nullptr) {
     return SkSLToBackend(caps, &SkSL::ToSPIRV, /*backendLabel=*/nullptr,
-                         sksl, programKind, settings, spirv, outInterface, errorHandler);
+                         sksl, programKind, settings, spirv, outInterface, errorHandler, times);
 }
 
 static constexpr uint32_t VkFormatChannels(VkFormat vkFormat) {
@@ -117,10 +117,15 @@ void SkImage::asyncRescaleAndReadPixelsYUVA420(SkYUVColorSpace yuvColorSpace,
 
 bool SkImage::scalePixels(const SkPixmap& dst, const SkSamplingOptions& sampling,
                           CachingHint chint) const {
+    return this->scalePixels(dst, sampling, nullptr, chint);
+}
+
+bool SkImage::scalePixels(const SkPixmap& dst, const SkSamplingOptions& sampling,
+                          SkExecutor* executor, CachingHint chint) const {
     // Context TODO: Elevate GrDirectContext requirement to public API.
     auto dContext = as_IB(this)->directContext();
     if (this->width() == dst.width() && this->height() == dst.height()) {
-        return this->readPixels(dContext, dst, 0, 0, chint);
+        return this->readPixels(dContext, dst, 0, 0, executor, chint);
     }
 
     // Idea: If/when SkImageGenerator supports a native-scaling API (where the generator itself
@@ -133,7 +138,7 @@ bool SkImage::scalePixels(const SkPixmap& dst, const SkSamplingOptions& sampling
         //       is (currently) only being applied to the getROPixels. If we get a request to
         //       also attempt to cache the final (scaled) result, we would add that logic here.
         //
-        return bm.peekPixels(&pmap) && pmap.scalePixels(dst, sampling);
+        return bm.peekPixels(&pmap) && pmap.scalePixels(dst, sampling, executor);
     }
     return false;
 }
@@ -214,6 +219,16 @@ bool SkImage::readPixels(GrDirectContext* dContext, const SkPixmap& pmap, int sr
                             srcY, chint);
 }
 
+bool SkImage::readPixels(GrDirectContext* dContext, const SkPixmap& pmap, int srcX, int srcY,
+                         SkExecutor* executor, CachingHint chint) const {
+    // Only raster images can hand their pixels straight to the CPU conversion.
+    SkPixmap src;
+    if (executor && this->peekPixels(&src)) {
+        return src.readPixels(pmap, srcX, srcY, executor);
+    }
+    return this->readPixels(dContext, pmap, srcX, srcY, chint);
+}
+
 #ifndef SK_IMAGE_READ_PIXELS_DISABLE_LEGACY_API
 bool SkImage::readPixels(const SkPixmap& pmap, int srcX, int srcY, CachingHint chint) const {
     auto dContext = as_IB(this)->directContext();
@@ -14,6 +14,7 @@
 #include "include/core/SkPixmap.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkYUVAInfo.h"
+#include "include/private/base/SkFloatingPoint.h"
 #include "src/core/SkBitmapCache.h"
 #include "src/core/SkCachedData.h"
 #include "src/core/SkNextID.h"
@@ -150,6 +151,88 @@ bool SkImage_Lazy::getROPixels(GrDirectContext* ctx, SkBitmap* bitmap,
     return true;
 }
 
+bool SkImage_Lazy::getROPixelsForSubset(GrDirectContext* ctx,
+                                        SkIRect* subset,
+                                        SkBitmap* bitmap) const {
+    const SkIRect bounds = this->bounds();
+    if (!subset->intersect(bounds)) {
+        return false;
+    }
+
+    // Decoding the whole image once is better than decoding most of it for every draw.
+    constexpr int64_t kMaxSubsetFraction = 2;
+    const bool smallSubset = kMaxSubsetFraction * subset->width() * subset->height() <=
+                             static_cast<int64_t>(bounds.width()) * bounds.height();
+    if (!smallSubset || SkBitmapCache::Find(SkBitmapCacheDesc::Make(this), bitmap)) {
+        *subset = bounds;
+        return this->getROPixels(ctx, bitmap, kAllow_CachingHint);
+    }
+
+    auto desc = SkBitmapCacheDesc::Make(this->uniqueID(), *subset);
+    if (SkBitmapCache::Find(desc, bitmap)) {
+        return true;
+    }
+
+    SkPixmap pmap;
+    SkBitmapCache::RecPtr cacheRec =
+            SkBitmapCache::Alloc(desc, this->imageInfo().makeDimensions(subset->size()), &pmap);
+    if (cacheRec) {
+        ScopedGenerator generator(fSharedGenerator);
+        if (!fSharedGenerator->fSubsetDecodeFailed) {
+            if (generator->getSubsetPixels(pmap, *subset)) {
+                SkBitmapCache::Add(std::move(cacheRec), bitmap);
+                this->notifyAddedToRasterCache();
+                return true;
+            }
+            fSharedGenerator->fSubsetDecodeFailed = true;
+        }
+    }
+
+    *subset = bounds;
+    return this->getROPixels(ctx, bitmap, kAllow_CachingHint);
+}
+
+bool SkImage_Lazy::getROPixelsForScale(GrDirectContext* ctx,
+                                       float scale,
+                                       SkBitmap* bitmap) const {
+    // Only downscaling by at least half is worth a separate decode.
+    constexpr float kMaxDecodeScale = 0.5f;
+    if (!(scale > 0 && scale <= kMaxDecodeScale) ||
+        SkBitmapCache::Find(SkBitmapCacheDesc::Make(this), bitmap)) {
+        return this->getROPixels(ctx, bitmap, kAllow_CachingHint);
+    }
+
+    {   // make sure ScopedGenerator goes out of scope before we fall back to getROPixels
+        ScopedGenerator generator(fSharedGenerator);
+        const SkISize dims = this->dimensions();
+        const SkISize scaledDims = generator->getScaledDimensions(scale);
+        // The scaled decode has to keep at least as many pixels as the draw needs.
+        const bool useScaledDims =
+                !fSharedGenerator->fScaledDecodeFailed && !scaledDims.isEmpty() &&
+                scaledDims.width() < dims.width() && scaledDims.height() < dims.height() &&
+                scaledDims.width() >= sk_float_floor2int(dims.width() * scale) &&
+                scaledDims.height() >= sk_float_floor2int(dims.height() * scale);
+        if (useScaledDims) {
+            auto desc = SkBitmapCacheDesc::MakeScaled(this, scaledDims);
+            if (SkBitmapCache::Find(desc, bitmap)) {
+                return true;
+            }
+            SkPixmap pmap;
+            SkBitmapCache::RecPtr cacheRec = SkBitmapCache::Alloc(
+                    desc, this->imageInfo().makeDimensions(scaledDims), &pmap);
+            if (cacheRec) {
+                if (generator->getPixels(pmap)) {
+                    SkBitmapCache::Add(std::move(cacheRec), bitmap);
+                    this->notifyAddedToRasterCache();
+                    return true;
+                }
+                fSharedGenerator->fScaledDecodeFailed = true;
+            }
+        }
+    }
+    return this->getROPixels(ctx, bitmap, kAllow_CachingHint);
+}
+
 sk_sp<SharedGenerator> SkImage_Lazy::generator() const {
     return fSharedGenerator;
 }
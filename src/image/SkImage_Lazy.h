@@ -70,6 +70,18 @@ public:
                                 RequiredProperties) const override;
 
     bool getROPixels(GrDirectContext*, SkBitmap*, CachingHint) const override;
+
+    // Like getROPixels(), but only decodes 'subset' if the generator supports it and the subset
+    // is small compared to the image. The decoded subset is cached on its own. On return,
+    // 'subset' holds the bounds that 'bitmap' covers, which are those of the whole image if it
+    // was decoded (or found in the cache) instead.
+    bool getROPixelsForSubset(GrDirectContext*, SkIRect* subset, SkBitmap* bitmap) const;
+
+    // Like getROPixels(), but if the image is drawn at no more than 'scale' (< 1), and the
+    // generator can decode it directly at a smaller size that still has at least that many
+    // pixels, decodes (and caches) that instead. In that case 'bitmap' is smaller than the image,
+    // and callers need to scale their draw to match.
+    bool getROPixelsForScale(GrDirectContext*, float scale, SkBitmap* bitmap) const;
     SkImage_Base::Type type() const override { return SkImage_Base::Type::kLazy; }
     sk_sp<SkImage> onMakeColorTypeAndColorSpace(SkColorType, sk_sp<SkColorSpace>,
                                                 GrDirectContext*) const override;
@@ -116,6 +128,10 @@ public:
 
     std::unique_ptr<SkImageGenerator> fGenerator;
     SkMutex                           fMutex;
+    // Set once the generator fails to decode a subset, so we stop trying. Guarded by fMutex.
+    bool                              fSubsetDecodeFailed = false;
+    // Likewise for decoding at a smaller size.
+    bool                              fScaledDecodeFailed = false;
 
 private:
     explicit SharedGenerator(std::unique_ptr<SkImageGenerator> gen);
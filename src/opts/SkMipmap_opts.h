@@ -0,0 +1,129 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMipmap_opts_DEFINED
+#define SkMipmap_opts_DEFINED
+
+#include "src/base/SkVx.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// 2x2 box filters for the even-sized mipmap levels, which are by far the most common. Each one
+// writes 'count' dst pixels, averaging 2*count pixels from the src row at 'src' with the 2*count
+// pixels of the row 'srcRB' bytes below it.
+//
+// These must match the portable downsample_2_2<> in SkMipmapHQDownSampler.cpp bit for bit, so
+// a level doesn't depend on which CPU built it.
+
+namespace SK_OPTS_NS {
+
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    static constexpr int kMipmapVecBytes = 32;
+#else
+    static constexpr int kMipmapVecBytes = 16;
+#endif
+
+    // Each uint64_t lane holds two horizontally adjacent 8888 pixels. Their channels are spread
+    // into 16-bit lanes (R and B in 'lo', G and A in 'hi') so that four of them can be summed
+    // without overflow, just like ColorTypeFilter_8888 does one pixel at a time.
+    template <int N>
+    static skvx::Vec<N,uint32_t> box_8888(const skvx::Vec<N,uint64_t>& r0,
+                                          const skvx::Vec<N,uint64_t>& r1) {
+        constexpr uint64_t kMask = 0x00FF'00FF'00FF'00FF;
+        skvx::Vec<N,uint64_t> lo = (r0 & kMask) + (r1 & kMask),
+                              hi = ((r0 >> 8) & kMask) + ((r1 >> 8) & kMask);
+        // Add the right pixel's channels to the left pixel's, then divide by 4.
+        lo = ((lo + (lo >> 32)) >> 2) & 0x00FF'00FF;
+        hi = ((hi + (hi >> 32)) >> 2) & 0x00FF'00FF;
+        return skvx::cast<uint32_t>(lo | (hi << 8));
+    }
+
+    /*not static*/ inline void downsample_2_2_8888(void* dst, const void* src, size_t srcRB,
+                                                   int count) {
+        static constexpr int N = kMipmapVecBytes / sizeof(uint64_t);
+        auto p0 = static_cast<const uint64_t*>(src);
+        auto p1 = (const uint64_t*)((const char*)src + srcRB);
+        auto d  = static_cast<uint32_t*>(dst);
+
+        for (; count >= N; count -= N) {
+            box_8888(skvx::Vec<N,uint64_t>::Load(p0), skvx::Vec<N,uint64_t>::Load(p1)).store(d);
+            p0 += N;
+            p1 += N;
+            d  += N;
+        }
+        for (; count > 0; --count) {
+            box_8888(skvx::Vec<1,uint64_t>::Load(p0), skvx::Vec<1,uint64_t>::Load(p1)).store(d);
+            p0 += 1;
+            p1 += 1;
+            d  += 1;
+        }
+    }
+
+    // Each uint16_t lane holds two horizontally adjacent 8-bit pixels.
+    template <int N>
+    static skvx::Vec<N,uint8_t> box_8(const skvx::Vec<N,uint16_t>& r0,
+                                      const skvx::Vec<N,uint16_t>& r1) {
+        return skvx::cast<uint8_t>(((r0 & 0xFF) + (r0 >> 8) + (r1 & 0xFF) + (r1 >> 8)) >> 2);
+    }
+
+    /*not static*/ inline void downsample_2_2_8(void* dst, const void* src, size_t srcRB,
+                                                int count) {
+        static constexpr int N = kMipmapVecBytes / sizeof(uint16_t);
+        auto p0 = static_cast<const uint16_t*>(src);
+        auto p1 = (const uint16_t*)((const char*)src + srcRB);
+        auto d  = static_cast<uint8_t*>(dst);
+
+        for (; count >= N; count -= N) {
+            box_8(skvx::Vec<N,uint16_t>::Load(p0), skvx::Vec<N,uint16_t>::Load(p1)).store(d);
+            p0 += N;
+            p1 += N;
+            d  += N;
+        }
+        for (; count > 0; --count) {
+            box_8(skvx::Vec<1,uint16_t>::Load(p0), skvx::Vec<1,uint16_t>::Load(p1)).store(d);
+            p0 += 1;
+            p1 += 1;
+            d  += 1;
+        }
+    }
+
+    // The sums are accumulated in the same order as the portable filter, (c00 + c10) + c01 + c11,
+    // since float addition isn't associative.
+    /*not static*/ inline void downsample_2_2_f16(void* dst, const void* src, size_t srcRB,
+                                                  int count) {
+        auto p0 = static_cast<const uint16_t*>(src);
+        auto p1 = (const uint16_t*)((const char*)src + srcRB);
+        auto d  = static_cast<uint16_t*>(dst);
+
+        // Two dst pixels at a time, from four src pixels in each row.
+        for (; count >= 2; count -= 2) {
+            skvx::Vec<16,float> r0 = skvx::from_half(skvx::Vec<16,uint16_t>::Load(p0)),
+                                r1 = skvx::from_half(skvx::Vec<16,uint16_t>::Load(p1));
+            auto left  = [](const skvx::Vec<16,float>& v) {
+                return skvx::shuffle<0,1,2,3, 8,9,10,11>(v);
+            };
+            auto right = [](const skvx::Vec<16,float>& v) {
+                return skvx::shuffle<4,5,6,7, 12,13,14,15>(v);
+            };
+            skvx::Vec<8,float> c = left(r0) + left(r1) + right(r0) + right(r1);
+            skvx::to_half(c * 0.25f).store(d);
+            p0 += 16;
+            p1 += 16;
+            d  += 8;
+        }
+        if (count > 0) {
+            skvx::Vec<8,float> r0 = skvx::from_half(skvx::Vec<8,uint16_t>::Load(p0)),
+                               r1 = skvx::from_half(skvx::Vec<8,uint16_t>::Load(p1));
+            skvx::Vec<4,float> c = r0.lo + r1.lo + r0.hi + r1.hi;
+            skvx::to_half(c * 0.25f).store(d);
+        }
+    }
+
+}  // namespace SK_OPTS_NS
+
+#endif  // SkMipmap_opts_DEFINED
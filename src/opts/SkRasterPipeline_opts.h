@@ -69,12 +69,16 @@ using NoCtx = const void*;
 
 #if defined(JUMPER_IS_SCALAR) || defined(JUMPER_IS_NEON) || defined(JUMPER_IS_HSW) || \
         defined(JUMPER_IS_SKX) || defined(JUMPER_IS_AVX) || defined(JUMPER_IS_SSE41) || \
-        defined(JUMPER_IS_SSE2)
+        defined(JUMPER_IS_SSE2) || defined(JUMPER_IS_RVV) || defined(JUMPER_IS_WASM_SIMD)
     // Honor the existing setting
 #elif !defined(__clang__) && !defined(__GNUC__)
     #define JUMPER_IS_SCALAR
 #elif defined(SK_ARM_HAS_NEON)
     #define JUMPER_IS_NEON
+#elif defined(__riscv_v) && defined(__riscv_v_min_vlen) && __riscv_v_min_vlen >= 128
+    #define JUMPER_IS_RVV
+#elif defined(__wasm_simd128__)
+    #define JUMPER_IS_WASM_SIMD
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
     #define JUMPER_IS_SKX
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
@@ -103,10 +107,12 @@ using NoCtx = const void*;
     #endif
 #endif
 
-#if defined(JUMPER_IS_SCALAR)
+#if defined(JUMPER_IS_SCALAR) || defined(JUMPER_IS_RVV)
     #include <math.h>
 #elif defined(JUMPER_IS_NEON)
     #include <arm_neon.h>
+#elif defined(JUMPER_IS_WASM_SIMD)
+    #include <wasm_simd128.h>
 #else
     #include <immintrin.h>
 #endif
@@ -901,6 +907,280 @@ namespace SK_OPTS_NS {
         _mm_storeu_ps(ptr + 8, b);
         _mm_storeu_ps(ptr +12, a);
     }
+
+#elif defined(JUMPER_IS_WASM_SIMD)
+    // WebAssembly SIMD128 has fixed 128-bit registers, so like SSE this path is 4 lanes wide.
+    template <typename T> using V = Vec<4, T>;
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    SI F if_then_else(I32 c, F t, F e) {
+        return (F)wasm_v128_bitselect((v128_t)t, (v128_t)e, (v128_t)c);
+    }
+    SI I32 if_then_else(I32 c, I32 t, I32 e) {
+        return (I32)wasm_v128_bitselect((v128_t)t, (v128_t)e, (v128_t)c);
+    }
+
+    // pmin(b,a) and pmax(b,a) are a<b?a:b and b<a?a:b, returning b for NaN like _mm_min/max_ps.
+    SI F   min(F a, F b)     { return (F)wasm_f32x4_pmin((v128_t)b, (v128_t)a); }
+    SI F   max(F a, F b)     { return (F)wasm_f32x4_pmax((v128_t)b, (v128_t)a); }
+    SI I32 min(I32 a, I32 b) { return (I32)wasm_i32x4_min((v128_t)a, (v128_t)b); }
+    SI U32 min(U32 a, U32 b) { return (U32)wasm_u32x4_min((v128_t)a, (v128_t)b); }
+    SI I32 max(I32 a, I32 b) { return (I32)wasm_i32x4_max((v128_t)a, (v128_t)b); }
+    SI U32 max(U32 a, U32 b) { return (U32)wasm_u32x4_max((v128_t)a, (v128_t)b); }
+
+    SI F   mad(F f, F m, F a)  { return a+f*m; }
+    SI F  nmad(F f, F m, F a)  { return a-f*m; }
+    SI F   abs_(F v)           { return (F)wasm_f32x4_abs((v128_t)v); }
+    SI I32 abs_(I32 v)         { return (I32)wasm_i32x4_abs((v128_t)v); }
+    SI F    sqrt_(F v)         { return (F)wasm_f32x4_sqrt((v128_t)v); }
+    // There are no reciprocal estimates in SIMD128 (only in relaxed-simd), so divide.
+    SI F   rcp_approx(F v)     { return 1.0f / v; }  // use rcp_fast instead
+    SI F   rcp_precise (F v)   { return 1.0f / v; }
+    SI F   rsqrt_approx(F v)   { return 1.0f / sqrt_(v); }
+
+    // Round to nearest even, as _mm_cvtps_epi32 does.
+    SI I32 iround(F v) {
+        return (I32)wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_nearest((v128_t)v));
+    }
+    SI U32 round(F v)          { return (U32)iround(v); }
+    SI U32 round(F v, F scale) { return (U32)iround(v*scale); }
+
+    SI U16 pack(U32 v) {
+        // Keep the low 16 bits of each lane, like the SSE2 path.
+        auto p = wasm_i16x8_shuffle((v128_t)v, (v128_t)v, 0,2,4,6, 0,2,4,6);
+        return sk_unaligned_load<U16>(&p);  // We have two copies.  Return (the lower) one.
+    }
+    SI U8 pack(U16 v) {
+        auto r = widen_cast<v128_t>(v);
+        r = wasm_u8x16_narrow_i16x8(r,r);
+        return sk_unaligned_load<U8>(&r);
+    }
+
+    // NOTE: This only checks the top bit of each lane, and is incorrect with non-mask values.
+    SI bool any(I32 c) { return wasm_i32x4_bitmask((v128_t)c) != 0b0000; }
+    SI bool all(I32 c) { return wasm_i32x4_bitmask((v128_t)c) == 0b1111; }
+
+    SI F floor_(F v) { return (F)wasm_f32x4_floor((v128_t)v); }
+    SI F ceil_ (F v) { return (F)wasm_f32x4_ceil ((v128_t)v); }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return V<T>{p[ix[0]], p[ix[1]], p[ix[2]], p[ix[3]]};
+    }
+    SI void scatter_masked(I32 src, int* dst, U32 ix, I32 mask) {
+        I32 before = gather(dst, ix);
+        I32 after = if_then_else(mask, src, before);
+        dst[ix[0]] = after[0];
+        dst[ix[1]] = after[1];
+        dst[ix[2]] = after[2];
+        dst[ix[3]] = after[3];
+    }
+    SI void load2(const uint16_t* ptr, U16* r, U16* g) {
+        v128_t _01 = wasm_v128_load(ptr);                               // r0 g0 r1 g1 r2 g2 r3 g3
+        v128_t rg  = wasm_i16x8_shuffle(_01, _01, 0,2,4,6, 1,3,5,7);    // r0 r1 r2 r3 g0 g1 g2 g3
+        *r = sk_unaligned_load<U16>((uint16_t*)&rg + 0);
+        *g = sk_unaligned_load<U16>((uint16_t*)&rg + 4);
+    }
+    SI void store2(uint16_t* ptr, U16 r, U16 g) {
+        v128_t rg = wasm_i16x8_shuffle(widen_cast<v128_t>(r), widen_cast<v128_t>(g),
+                                       0,8, 1,9, 2,10, 3,11);
+        wasm_v128_store(ptr, rg);
+    }
+
+    SI void load4(const uint16_t* ptr, U16* r, U16* g, U16* b, U16* a) {
+        v128_t _01 = wasm_v128_load(ptr + 0),  // r0 g0 b0 a0 r1 g1 b1 a1
+               _23 = wasm_v128_load(ptr + 8);  // r2 g2 b2 a2 r3 g3 b3 a3
+
+        v128_t rg = wasm_i16x8_shuffle(_01, _23, 0,4,8,12, 1,5,9,13),   // r0 r1 r2 r3 g0 g1 g2 g3
+               ba = wasm_i16x8_shuffle(_01, _23, 2,6,10,14, 3,7,11,15); // b0 b1 b2 b3 a0 a1 a2 a3
+
+        *r = sk_unaligned_load<U16>((uint16_t*)&rg + 0);
+        *g = sk_unaligned_load<U16>((uint16_t*)&rg + 4);
+        *b = sk_unaligned_load<U16>((uint16_t*)&ba + 0);
+        *a = sk_unaligned_load<U16>((uint16_t*)&ba + 4);
+    }
+
+    SI void store4(uint16_t* ptr, U16 r, U16 g, U16 b, U16 a) {
+        v128_t rg = wasm_i16x8_shuffle(widen_cast<v128_t>(r), widen_cast<v128_t>(g),
+                                       0,8, 1,9, 2,10, 3,11),
+               ba = wasm_i16x8_shuffle(widen_cast<v128_t>(b), widen_cast<v128_t>(a),
+                                       0,8, 1,9, 2,10, 3,11);
+
+        wasm_v128_store(ptr + 0, wasm_i32x4_shuffle(rg, ba, 0,4, 1,5));
+        wasm_v128_store(ptr + 8, wasm_i32x4_shuffle(rg, ba, 2,6, 3,7));
+    }
+
+    // Transposes four rows of four floats, like _MM_TRANSPOSE4_PS.
+    SI void transpose4(v128_t* _0, v128_t* _1, v128_t* _2, v128_t* _3) {
+        v128_t t0 = wasm_i32x4_shuffle(*_0, *_1, 0,4, 1,5),
+               t1 = wasm_i32x4_shuffle(*_2, *_3, 0,4, 1,5),
+               t2 = wasm_i32x4_shuffle(*_0, *_1, 2,6, 3,7),
+               t3 = wasm_i32x4_shuffle(*_2, *_3, 2,6, 3,7);
+        *_0 = wasm_i64x2_shuffle(t0, t1, 0,2);
+        *_1 = wasm_i64x2_shuffle(t0, t1, 1,3);
+        *_2 = wasm_i64x2_shuffle(t2, t3, 0,2);
+        *_3 = wasm_i64x2_shuffle(t2, t3, 1,3);
+    }
+
+    SI void load4(const float* ptr, F* r, F* g, F* b, F* a) {
+        v128_t _0 = wasm_v128_load(ptr + 0),
+               _1 = wasm_v128_load(ptr + 4),
+               _2 = wasm_v128_load(ptr + 8),
+               _3 = wasm_v128_load(ptr +12);
+        transpose4(&_0,&_1,&_2,&_3);
+        *r = (F)_0;
+        *g = (F)_1;
+        *b = (F)_2;
+        *a = (F)_3;
+    }
+
+    SI void store4(float* ptr, F r, F g, F b, F a) {
+        v128_t _0 = (v128_t)r,
+               _1 = (v128_t)g,
+               _2 = (v128_t)b,
+               _3 = (v128_t)a;
+        transpose4(&_0,&_1,&_2,&_3);
+        wasm_v128_store(ptr + 0, _0);
+        wasm_v128_store(ptr + 4, _1);
+        wasm_v128_store(ptr + 8, _2);
+        wasm_v128_store(ptr +12, _3);
+    }
+
+#elif defined(JUMPER_IS_RVV)
+    // RVV registers don't have a fixed width we can target with intrinsics, so this path is
+    // written entirely with portable vector operations. The compiler lowers these fixed-size
+    // vectors onto RVV (VLEN >= 128), so an 8-wide F occupies one or two vector registers.
+    template <typename T> using V = Vec<8, T>;
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    SI F if_then_else(I32 c, F t, F e) {
+        return sk_bit_cast<F>((sk_bit_cast<I32>(t) & c) | (sk_bit_cast<I32>(e) & ~c));
+    }
+    SI I32 if_then_else(I32 c, I32 t, I32 e) { return (t & c) | (e & ~c); }
+
+    SI F   min(F a, F b)     { return if_then_else(a < b, a, b); }
+    SI I32 min(I32 a, I32 b) { return if_then_else(a < b, a, b); }
+    SI U32 min(U32 a, U32 b) {
+        return sk_bit_cast<U32>(if_then_else(a < b, sk_bit_cast<I32>(a), sk_bit_cast<I32>(b)));
+    }
+    SI F   max(F a, F b)     { return if_then_else(a > b, a, b); }
+    SI I32 max(I32 a, I32 b) { return if_then_else(a > b, a, b); }
+    SI U32 max(U32 a, U32 b) {
+        return sk_bit_cast<U32>(if_then_else(a > b, sk_bit_cast<I32>(a), sk_bit_cast<I32>(b)));
+    }
+
+    SI F   mad(F f, F m, F a)  { return a+f*m; }
+    SI F  nmad(F f, F m, F a)  { return a-f*m; }
+    SI F   abs_(F v)           { return sk_bit_cast<F>(sk_bit_cast<I32>(v) & 0x7fffffff); }
+    SI I32 abs_(I32 v)         { return max(v, -v); }
+
+    SI F sqrt_(F v) {
+    #if defined(__clang__) && __has_builtin(__builtin_elementwise_sqrt)
+        return __builtin_elementwise_sqrt(v);
+    #else
+        F r;
+        SK_UNROLL for (int i = 0; i < 8; ++i) { r[i] = sqrtf(v[i]); }
+        return r;
+    #endif
+    }
+    // RVV's reciprocal estimates aren't reachable without intrinsics; division is cheap enough.
+    SI F rcp_approx  (F v) { return 1.0f / v; }  // use rcp_fast instead
+    SI F rcp_precise (F v) { return 1.0f / v; }
+    SI F rsqrt_approx(F v) { return 1.0f / sqrt_(v); }
+
+    SI I32 iround(F v)         { return __builtin_convertvector(v + 0.5f, I32); }
+    SI U32 round(F v)          { return __builtin_convertvector(v + 0.5f, U32); }
+    SI U32 round(F v, F scale) { return __builtin_convertvector(mad(v, scale, F() + 0.5f), U32); }
+
+    SI U16 pack(U32 v) { return __builtin_convertvector(v, U16); }
+    SI U8  pack(U16 v) { return __builtin_convertvector(v,  U8); }
+
+    SI bool any(I32 c) {
+        I32 lanes = c;
+        SK_UNROLL for (int i = 1; i < 8; ++i) { lanes[0] |= c[i]; }
+        return lanes[0] != 0;
+    }
+    SI bool all(I32 c) {
+        I32 lanes = c;
+        SK_UNROLL for (int i = 1; i < 8; ++i) { lanes[0] &= c[i]; }
+        return lanes[0] != 0;
+    }
+
+    SI F floor_(F v) {
+        F roundtrip = __builtin_convertvector(__builtin_convertvector(v, I32), F);
+        return roundtrip - if_then_else(roundtrip > v, F() + 1, F() + 0);
+    }
+    SI F ceil_(F v) {
+        F roundtrip = __builtin_convertvector(__builtin_convertvector(v, I32), F);
+        return roundtrip + if_then_else(roundtrip < v, F() + 1, F() + 0);
+    }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return V<T>{p[ix[0]], p[ix[1]], p[ix[2]], p[ix[3]],
+                    p[ix[4]], p[ix[5]], p[ix[6]], p[ix[7]]};
+    }
+    SI void scatter_masked(I32 src, int* dst, U32 ix, I32 mask) {
+        I32 before = gather(dst, ix);
+        I32 after = if_then_else(mask, src, before);
+        SK_UNROLL for (int i = 0; i < 8; ++i) { dst[ix[i]] = after[i]; }
+    }
+
+    // These interleaved loops are the shapes RVV's segment loads and stores (vlseg/vsseg) cover.
+    SI void load2(const uint16_t* ptr, U16* r, U16* g) {
+        SK_UNROLL for (int i = 0; i < 8; ++i) {
+            (*r)[i] = ptr[2*i+0];
+            (*g)[i] = ptr[2*i+1];
+        }
+    }
+    SI void store2(uint16_t* ptr, U16 r, U16 g) {
+        SK_UNROLL for (int i = 0; i < 8; ++i) {
+            ptr[2*i+0] = r[i];
+            ptr[2*i+1] = g[i];
+        }
+    }
+    SI void load4(const uint16_t* ptr, U16* r, U16* g, U16* b, U16* a) {
+        SK_UNROLL for (int i = 0; i < 8; ++i) {
+            (*r)[i] = ptr[4*i+0];
+            (*g)[i] = ptr[4*i+1];
+            (*b)[i] = ptr[4*i+2];
+            (*a)[i] = ptr[4*i+3];
+        }
+    }
+    SI void store4(uint16_t* ptr, U16 r, U16 g, U16 b, U16 a) {
+        SK_UNROLL for (int i = 0; i < 8; ++i) {
+            ptr[4*i+0] = r[i];
+            ptr[4*i+1] = g[i];
+            ptr[4*i+2] = b[i];
+            ptr[4*i+3] = a[i];
+        }
+    }
+    SI void load4(const float* ptr, F* r, F* g, F* b, F* a) {
+        SK_UNROLL for (int i = 0; i < 8; ++i) {
+            (*r)[i] = ptr[4*i+0];
+            (*g)[i] = ptr[4*i+1];
+            (*b)[i] = ptr[4*i+2];
+            (*a)[i] = ptr[4*i+3];
+        }
+    }
+    SI void store4(float* ptr, F r, F g, F b, F a) {
+        SK_UNROLL for (int i = 0; i < 8; ++i) {
+            ptr[4*i+0] = r[i];
+            ptr[4*i+1] = g[i];
+            ptr[4*i+2] = b[i];
+            ptr[4*i+3] = a[i];
+        }
+    }
 #endif
 
 // Helpers to do scalar -> vector promotion on GCC (clang does this automatically)
@@ -3014,13 +3294,35 @@ STAGE(evenly_spaced_gradient, const SkRasterPipeline_GradientCtx* c) {
     gradient_lookup(c, idx, t, &r, &g, &b, &a);
 }
 
+// Above this many stops, the gradient stages find each pixel's interval with a branchless binary
+// search (log2(stops) gathers) instead of comparing t against every stop.
+static constexpr size_t kMaxLinearGradientSearchStops = 16;
+
+SI size_t gradient_search_step(const SkRasterPipeline_GradientCtx* c) {
+    // The largest power of two <= stopCount-1.
+    size_t step = 1;
+    while (step * 2 <= c->stopCount - 1) {
+        step *= 2;
+    }
+    return step;
+}
+
 STAGE(gradient, const SkRasterPipeline_GradientCtx* c) {
     auto t = r;
     U32 idx = U32_(0);
 
-    // N.B. The loop starts at 1 because idx 0 is the color to use before the first stop.
-    for (size_t i = 1; i < c->stopCount; i++) {
-        idx += (U32)if_then_else(t >= c->ts[i], I32_(1), I32_(0));
+    if (c->stopCount <= kMaxLinearGradientSearchStops) {
+        // N.B. The loop starts at 1 because idx 0 is the color to use before the first stop.
+        for (size_t i = 1; i < c->stopCount; i++) {
+            idx += (U32)if_then_else(t >= c->ts[i], I32_(1), I32_(0));
+        }
+    } else {
+        // Find the last stop <= t, as the loop above would. Probes past the last stop read the NaN
+        // padding of ts, which never compares as <= t.
+        for (size_t step = gradient_search_step(c); step > 0; step >>= 1) {
+            U32 probe = idx + (uint32_t)step;
+            idx = (U32)if_then_else(t >= gather(c->ts, probe), (I32)probe, (I32)idx);
+        }
     }
 
     gradient_lookup(c, idx, t, &r, &g, &b, &a);
@@ -4646,7 +4948,10 @@ namespace lowp {
 
 #else  // We are compiling vector code with Clang... let's make some lowp stages!
 
-#if defined(JUMPER_IS_SKX) || defined(JUMPER_IS_HSW)
+#if defined(JUMPER_IS_SKX)
+    // AVX-512BW holds 32 lanes of 16-bit values in one register.
+    template <typename T> using V = Vec<32, T>;
+#elif defined(JUMPER_IS_HSW)
     template <typename T> using V = Vec<16, T>;
 #else
     template <typename T> using V = Vec<8, T>;
@@ -4981,8 +5286,9 @@ SI U32 trunc_(F x) { return (U32)cast<I32>(x); }
 // Use approximate instructions and one Newton-Raphson step to calculate 1/x.
 SI F rcp_precise(F x) {
 #if defined(JUMPER_IS_SKX)
-    F e = _mm512_rcp14_ps(x);
-    return _mm512_fnmadd_ps(x, e, _mm512_set1_ps(2.0f)) * e;
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(SK_OPTS_NS::rcp_precise(lo), SK_OPTS_NS::rcp_precise(hi));
 #elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
@@ -5001,7 +5307,9 @@ SI F rcp_precise(F x) {
 }
 SI F sqrt_(F x) {
 #if defined(JUMPER_IS_SKX)
-    return _mm512_sqrt_ps(x);
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_sqrt_ps(lo), _mm512_sqrt_ps(hi));
 #elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
@@ -5024,6 +5332,10 @@ SI F sqrt_(F x) {
     float32x4_t lo,hi;
     split(x, &lo,&hi);
     return join<F>(sqrt(lo), sqrt(hi));
+#elif defined(JUMPER_IS_WASM_SIMD)
+    v128_t lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(wasm_f32x4_sqrt(lo), wasm_f32x4_sqrt(hi));
 #else
     return F{
         sqrtf(x[0]), sqrtf(x[1]), sqrtf(x[2]), sqrtf(x[3]),
@@ -5038,7 +5350,9 @@ SI F floor_(F x) {
     split(x, &lo,&hi);
     return join<F>(vrndmq_f32(lo), vrndmq_f32(hi));
 #elif defined(JUMPER_IS_SKX)
-    return _mm512_floor_ps(x);
+    __m512 lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(_mm512_floor_ps(lo), _mm512_floor_ps(hi));
 #elif defined(JUMPER_IS_HSW)
     __m256 lo,hi;
     split(x, &lo,&hi);
@@ -5047,6 +5361,10 @@ SI F floor_(F x) {
     __m128 lo,hi;
     split(x, &lo,&hi);
     return join<F>(_mm_floor_ps(lo), _mm_floor_ps(hi));
+#elif defined(JUMPER_IS_WASM_SIMD)
+    v128_t lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(wasm_f32x4_floor(lo), wasm_f32x4_floor(hi));
 #else
     F roundtrip = cast<F>(cast<I32>(x));
     return roundtrip - if_then_else(roundtrip > x, F_(1), F_(0));
@@ -5057,10 +5375,10 @@ SI F floor_(F x) {
 // this multiply is:
 //     (2 * a * b + (1 << 15)) >> 16
 // The result is a number on [-1, 1).
-// Note: on neon this is a saturating multiply while the others are not.
+// Note: on neon and wasm this is a saturating multiply while the others are not.
 SI I16 scaled_mult(I16 a, I16 b) {
 #if defined(JUMPER_IS_SKX)
-    return (I16)_mm256_mulhrs_epi16((__m256i)a, (__m256i)b);
+    return (I16)_mm512_mulhrs_epi16((__m512i)a, (__m512i)b);
 #elif defined(JUMPER_IS_HSW)
     return (I16)_mm256_mulhrs_epi16((__m256i)a, (__m256i)b);
 #elif defined(JUMPER_IS_SSE41) || defined(JUMPER_IS_AVX)
@@ -5069,6 +5387,9 @@ SI I16 scaled_mult(I16 a, I16 b) {
     return vqrdmulhq_s16(a, b);
 #elif defined(JUMPER_IS_NEON)
     return vqrdmulhq_s16(a, b);
+#elif defined(JUMPER_IS_WASM_SIMD)
+    // Like NEON, this saturates.
+    return (I16)wasm_i16x8_q15mulr_sat((v128_t)a, (v128_t)b);
 #else
     const I32 roundingTerm = I32_(1 << 14);
     return cast<I16>((cast<I32>(a) * cast<I32>(b) + roundingTerm) >> 15);
@@ -5102,6 +5423,8 @@ STAGE_GG(seed_shader, NoCtx) {
     static constexpr float iota[] = {
         0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
         8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
+       16.5f,17.5f,18.5f,19.5f,20.5f,21.5f,22.5f,23.5f,
+       24.5f,25.5f,26.5f,27.5f,28.5f,29.5f,30.5f,31.5f,
     };
     static_assert(std::size(iota) >= SkRasterPipeline_kMaxStride);
 
@@ -5343,17 +5666,29 @@ SI void store(T* ptr, V v) {
         return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
                   ptr[ix[ 4]], ptr[ix[ 5]], ptr[ix[ 6]], ptr[ix[ 7]],
                   ptr[ix[ 8]], ptr[ix[ 9]], ptr[ix[10]], ptr[ix[11]],
-                  ptr[ix[12]], ptr[ix[13]], ptr[ix[14]], ptr[ix[15]], };
+                  ptr[ix[12]], ptr[ix[13]], ptr[ix[14]], ptr[ix[15]],
+                  ptr[ix[16]], ptr[ix[17]], ptr[ix[18]], ptr[ix[19]],
+                  ptr[ix[20]], ptr[ix[21]], ptr[ix[22]], ptr[ix[23]],
+                  ptr[ix[24]], ptr[ix[25]], ptr[ix[26]], ptr[ix[27]],
+                  ptr[ix[28]], ptr[ix[29]], ptr[ix[30]], ptr[ix[31]], };
     }
 
     template<>
     F gather(const float* ptr, U32 ix) {
-        return _mm512_i32gather_ps((__m512i)ix, ptr, 4);
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<F>(_mm512_i32gather_ps(lo, ptr, 4),
+                       _mm512_i32gather_ps(hi, ptr, 4));
     }
 
     template<>
     U32 gather(const uint32_t* ptr, U32 ix) {
-        return (U32)_mm512_i32gather_epi32((__m512i)ix, ptr, 4);
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<U32>(_mm512_i32gather_epi32(lo, ptr, 4),
+                         _mm512_i32gather_epi32(hi, ptr, 4));
     }
 
 #elif defined(JUMPER_IS_HSW)
@@ -5395,10 +5730,18 @@ SI void store(T* ptr, V v) {
 
 SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
 #if defined(JUMPER_IS_SKX)
-    rgba = (U32)_mm512_permutexvar_epi64(_mm512_setr_epi64(0,1,4,5,2,3,6,7), (__m512i)rgba);
+    // _mm512_packus_epi32() interleaves its inputs 128 bits at a time, so gather the even
+    // 128-bit lanes into one half and the odd ones into the other to keep pixels in order.
+    __m512i _01,_23;
+    split(rgba, &_01, &_23);
+    __m512i _even = _mm512_permutex2var_epi64(_01, _mm512_setr_epi64(0,1,4,5, 8, 9,12,13), _23),
+            _odd  = _mm512_permutex2var_epi64(_01, _mm512_setr_epi64(2,3,6,7,10,11,14,15), _23);
+    rgba = join<U32>(_even, _odd);
+
     auto cast_U16 = [](U32 v) -> U16 {
-        return (U16)_mm256_packus_epi32(_mm512_castsi512_si256((__m512i)v),
-                    _mm512_extracti64x4_epi64((__m512i)v, 1));
+        __m512i _even,_odd;
+        split(v, &_even,&_odd);
+        return (U16)_mm512_packus_epi32(_even,_odd);
     };
 #elif defined(JUMPER_IS_HSW)
     // Swap the middle 128-bit lanes to make _mm256_packus_epi32() in cast_U16() work out nicely.
@@ -5887,9 +6230,17 @@ STAGE_GP(gradient, const SkRasterPipeline_GradientCtx* c) {
     auto t = x;
     U32 idx = U32_(0);
 
-    // N.B. The loop starts at 1 because idx 0 is the color to use before the first stop.
-    for (size_t i = 1; i < c->stopCount; i++) {
-        idx += if_then_else(t >= c->ts[i], U32_(1), U32_(0));
+    if (c->stopCount <= kMaxLinearGradientSearchStops) {
+        // N.B. The loop starts at 1 because idx 0 is the color to use before the first stop.
+        for (size_t i = 1; i < c->stopCount; i++) {
+            idx += if_then_else(t >= c->ts[i], U32_(1), U32_(0));
+        }
+    } else {
+        // See the highp gradient stage.
+        for (size_t step = gradient_search_step(c); step > 0; step >>= 1) {
+            U32 probe = idx + (uint32_t)step;
+            idx = if_then_else(t >= gather<F>(c->ts, probe), probe, idx);
+        }
     }
 
     gradient_lookup(c, idx, t, &r, &g, &b, &a);
@@ -6070,6 +6421,229 @@ STAGE_PP(swizzle, void* ctx) {
 #endif//defined(JUMPER_IS_SCALAR) controlling whether we build lowp stages
 }  // namespace lowp
 
+namespace mediump {
+#if !defined(JUMPER_IS_NEON) || !defined(SK_CPU_ARM64) || defined(SK_ENABLE_OPTIMIZE_SIZE) || \
+        !defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+    // Mediump stages do their math in half floats, so we only generate them when the target has
+    // native half-float vector arithmetic (ARMv8.2's FEAT_FP16).
+    //
+    // Having nullptr for every stage will cause SkRasterPipeline to skip mediump. Only SkOpts.cpp
+    // and SkOpts_armv82.cpp look these up, so they're unused in the other opts.
+    #define M(st) [[maybe_unused]] static constexpr void (*st)(void) = nullptr;
+        SK_RASTER_PIPELINE_OPS_MEDIUMP(M)
+    #undef M
+    [[maybe_unused]] static constexpr void (*just_return)(void) = nullptr;
+
+    [[maybe_unused]] static void start_pipeline(size_t,size_t,size_t,size_t,
+                                                SkRasterPipelineStage*,
+                                                SkSpan<SkRasterPipeline_MemoryCtxPatch>,
+                                                uint8_t* tailPointer) {}
+
+#else  // We have FEAT_FP16... let's make some mediump stages!
+
+// Eight half floats fill a NEON register, twice the pixels of a highp stage.
+using H = float16x8_t;
+
+static constexpr size_t N = sizeof(H) / sizeof(float16_t);
+
+SI H H_(float x) { return vdupq_n_f16((float16_t)x); }
+
+// Mediump only exists on ARM64, so we always use wide stages.
+using Stage = void (ABI*)(SkRasterPipelineStage* program, size_t dx, size_t dy,
+                          H  r, H  g, H  b, H  a,
+                          H dr, H dg, H db, H da);
+
+static void start_pipeline(size_t x0,     size_t y0,
+                           size_t xlimit, size_t ylimit,
+                           SkRasterPipelineStage* program,
+                           SkSpan<SkRasterPipeline_MemoryCtxPatch> memoryCtxPatches,
+                           uint8_t* tailPointer) {
+    uint8_t unreferencedTail;
+    if (!tailPointer) {
+        tailPointer = &unreferencedTail;
+    }
+    auto start = (Stage)program->fn;
+    const H H0 = H_(0);
+    for (size_t dy = y0; dy < ylimit; dy++) {
+        size_t dx = x0;
+        for (; dx + N <= xlimit; dx += N) {
+            start(program, dx,dy, H0,H0,H0,H0, H0,H0,H0,H0);
+        }
+        if (size_t tail = xlimit - dx) {
+            *tailPointer = tail;
+            patch_memory_contexts(memoryCtxPatches, dx, dy, tail);
+            start(program, dx,dy, H0,H0,H0,H0, H0,H0,H0,H0);
+            restore_memory_contexts(memoryCtxPatches, dx, dy, tail);
+            *tailPointer = 0xFF;
+        }
+    }
+}
+
+static void ABI just_return(SkRasterPipelineStage*, size_t,size_t,
+                            H,H,H,H, H,H,H,H) {}
+
+// Every mediump stage takes and produces pixels, like lowp's STAGE_PP.
+#define STAGE_H(name, ARG)                                                                 \
+    SI void name##_k(ARG, size_t dx, size_t dy,                                            \
+                     H&  r, H&  g, H&  b, H&  a,                                           \
+                     H& dr, H& dg, H& db, H& da);                                          \
+    static void ABI name(SkRasterPipelineStage* program,                                   \
+                         size_t dx, size_t dy,                                             \
+                         H  r, H  g, H  b, H  a,                                           \
+                         H dr, H dg, H db, H da) {                                         \
+        name##_k(Ctx{program}, dx,dy, r,g,b,a, dr,dg,db,da);                               \
+        auto fn = (Stage)(++program)->fn;                                                  \
+        fn(program, dx,dy, r,g,b,a, dr,dg,db,da);                                          \
+    }                                                                                      \
+    SI void name##_k(ARG, size_t dx, size_t dy,                                            \
+                     H&  r, H&  g, H&  b, H&  a,                                           \
+                     H& dr, H& dg, H& db, H& da)
+
+SI H min(H a, H b)        { return vminq_f16(a, b); }
+SI H max(H a, H b)        { return vmaxq_f16(a, b); }
+SI H mad(H f, H m, H a)   { return vfmaq_f16(a, f, m); }
+SI H inv(H v)             { return H_(1) - v; }
+SI H lerp(H from, H to, H t) { return mad(to - from, t, from); }
+
+SI H load_coverage(const SkRasterPipeline_MemoryCtx* ctx, size_t dx, size_t dy) {
+    auto ptr = ptr_at_xy<const uint8_t>(ctx, dx,dy);
+    return vcvtq_f16_u16(vmovl_u8(vld1_u8(ptr))) * H_(1/255.0f);
+}
+
+// ~~~~~~ Loads and stores ~~~~~~ //
+
+STAGE_H(load_f16, const SkRasterPipeline_MemoryCtx* ctx) {
+    float16x8x4_t px = vld4q_f16((const float16_t*)ptr_at_xy<const uint64_t>(ctx, dx,dy));
+    r = px.val[0];
+    g = px.val[1];
+    b = px.val[2];
+    a = px.val[3];
+}
+STAGE_H(load_f16_dst, const SkRasterPipeline_MemoryCtx* ctx) {
+    float16x8x4_t px = vld4q_f16((const float16_t*)ptr_at_xy<const uint64_t>(ctx, dx,dy));
+    dr = px.val[0];
+    dg = px.val[1];
+    db = px.val[2];
+    da = px.val[3];
+}
+STAGE_H(store_f16, const SkRasterPipeline_MemoryCtx* ctx) {
+    vst4q_f16((float16_t*)ptr_at_xy<uint64_t>(ctx, dx,dy), (float16x8x4_t{{r,g,b,a}}));
+}
+
+// ~~~~~~ Colors and moves ~~~~~~ //
+
+STAGE_H(uniform_color, const SkRasterPipeline_UniformColorCtx* c) {
+    r = H_(c->r);
+    g = H_(c->g);
+    b = H_(c->b);
+    a = H_(c->a);
+}
+STAGE_H(black_color, NoCtx) {
+    r = g = b = H_(0);
+    a = H_(1);
+}
+STAGE_H(white_color, NoCtx) {
+    r = g = b = a = H_(1);
+}
+
+STAGE_H(move_src_dst, NoCtx) {
+    dr = r;
+    dg = g;
+    db = b;
+    da = a;
+}
+STAGE_H(move_dst_src, NoCtx) {
+    r = dr;
+    g = dg;
+    b = db;
+    a = da;
+}
+STAGE_H(swap_src_dst, NoCtx) {
+    std::swap(r, dr);
+    std::swap(g, dg);
+    std::swap(b, db);
+    std::swap(a, da);
+}
+
+STAGE_H(clamp_01, NoCtx) {
+    r = min(max(H_(0), r), H_(1));
+    g = min(max(H_(0), g), H_(1));
+    b = min(max(H_(0), b), H_(1));
+    a = min(max(H_(0), a), H_(1));
+}
+STAGE_H(premul, NoCtx) {
+    r = r * a;
+    g = g * a;
+    b = b * a;
+}
+STAGE_H(force_opaque, NoCtx) {
+    a = H_(1);
+}
+
+// ~~~~~~ Coverage scales / lerps ~~~~~~ //
+
+STAGE_H(scale_1_float, const float* f) {
+    H c = H_(*f);
+    r = r * c;
+    g = g * c;
+    b = b * c;
+    a = a * c;
+}
+STAGE_H(scale_u8, const SkRasterPipeline_MemoryCtx* ctx) {
+    H c = load_coverage(ctx, dx,dy);
+    r = r * c;
+    g = g * c;
+    b = b * c;
+    a = a * c;
+}
+STAGE_H(lerp_1_float, const float* f) {
+    H c = H_(*f);
+    r = lerp(dr, r, c);
+    g = lerp(dg, g, c);
+    b = lerp(db, b, c);
+    a = lerp(da, a, c);
+}
+STAGE_H(lerp_u8, const SkRasterPipeline_MemoryCtx* ctx) {
+    H c = load_coverage(ctx, dx,dy);
+    r = lerp(dr, r, c);
+    g = lerp(dg, g, c);
+    b = lerp(db, b, c);
+    a = lerp(da, a, c);
+}
+
+// ~~~~~~ Blend modes ~~~~~~ //
+
+// These match the highp blend modes above, channel for channel.
+#define BLEND_MODE(name)                       \
+    SI H name##_channel(H s, H d, H sa, H da); \
+    STAGE_H(name, NoCtx) {                     \
+        r = name##_channel(r,dr,a,da);         \
+        g = name##_channel(g,dg,a,da);         \
+        b = name##_channel(b,db,a,da);         \
+        a = name##_channel(a,da,a,da);         \
+    }                                          \
+    SI H name##_channel(H s, H d, H sa, H da)
+
+BLEND_MODE(clear)    { return H_(0); }
+BLEND_MODE(srcatop)  { return s*da + d*inv(sa); }
+BLEND_MODE(dstatop)  { return d*sa + s*inv(da); }
+BLEND_MODE(srcin)    { return s * da; }
+BLEND_MODE(dstin)    { return d * sa; }
+BLEND_MODE(srcout)   { return s * inv(da); }
+BLEND_MODE(dstout)   { return d * inv(sa); }
+BLEND_MODE(srcover)  { return mad(d, inv(sa), s); }
+BLEND_MODE(dstover)  { return mad(s, inv(da), d); }
+
+BLEND_MODE(modulate) { return s*d; }
+BLEND_MODE(multiply) { return s*inv(da) + d*inv(sa) + s*d; }
+BLEND_MODE(plus_)    { return min(s + d, H_(1)); }
+BLEND_MODE(screen)   { return s + d - s*d; }
+BLEND_MODE(xor_)     { return s*inv(da) + d*inv(sa); }
+#undef BLEND_MODE
+
+#endif//defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC) controlling whether we build mediump stages
+}  // namespace mediump
+
 /* This gives us SK_OPTS::lowp::N if lowp::N has been set, or SK_OPTS::N if it hasn't. */
 namespace lowp { static constexpr size_t lowp_N = N; }
 
@@ -10,6 +10,7 @@
 #include "include/core/SkPoint.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkDebug.h"
+#include "include/private/base/SkTArray.h"
 #include "src/pathops/SkIntersectionHelper.h"
 #include "src/pathops/SkIntersections.h"
 #include "src/pathops/SkOpCoincidence.h"
@@ -23,6 +24,7 @@
 #include "src/pathops/SkPathOpsQuad.h"
 #include "src/pathops/SkPathOpsTypes.h"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -272,6 +274,129 @@ static void debugShowCubicIntersection(int , const SkIntersectionHelper& ,
 }
 #endif
 
+namespace {
+
+// Walks the segments of 'next' which may intersect a segment of 'test'. A long contour's segments
+// are bucketed into bands across its longer side first, so that each test segment only visits
+// the segments in the bands it spans instead of the whole contour. Either way the segments are visited in
+// contour order, so the intersections are added in the same order.
+class SegmentFinder {
+public:
+    SegmentFinder(SkOpContour* contour) : fContour(contour) {
+        if (contour->count() < kMinBandedSegments) {
+            return;
+        }
+        const SkPathOpsBounds& bounds = contour->bounds();
+        fVertical = bounds.width() > bounds.height();
+        int bandCount = std::min(contour->count() / kSegmentsPerBand, kMaxBands);
+        float bandSize = (this->high(bounds) - this->low(bounds)) / bandCount;
+        // The bounds tests allow a few ulps of slop, so a band must be much wider than that for
+        // the query below, padded by one band, to find every segment the tests would accept.
+        if (!(bandSize > (std::fabs(this->low(bounds)) + std::fabs(this->high(bounds))) * 1e-4f)) {
+            return;
+        }
+        fBandStart = this->low(bounds);
+        fBandScale = 1 / bandSize;
+        fBandCount = bandCount;
+
+        for (SkOpSegment* segment = contour->first(); segment; segment = segment->next()) {
+            fSegments.push_back(segment);
+        }
+        // Lay the bands out one after another: fBandEntry[b] is the first entry of band b.
+        fBandEntry.push_back_n(bandCount + 1, 0);
+        for (const SkOpSegment* segment : fSegments) {
+            for (int band = this->band(this->low(segment->bounds()));
+                    band <= this->band(this->high(segment->bounds())); ++band) {
+                ++fBandEntry[band + 1];
+            }
+        }
+        for (int band = 0; band < bandCount; ++band) {
+            fBandEntry[band + 1] += fBandEntry[band];
+        }
+        fBandSegments.push_back_n(fBandEntry[bandCount]);
+        skia_private::TArray<int> fill(fBandEntry);
+        for (int index = 0; index < fSegments.size(); ++index) {
+            const SkPathOpsBounds& segmentBounds = fSegments[index]->bounds();
+            for (int band = this->band(this->low(segmentBounds));
+                    band <= this->band(this->high(segmentBounds)); ++band) {
+                fBandSegments[fill[band]++] = index;
+            }
+        }
+    }
+
+    // Points 'wn' at the first segment which may intersect 'wt', which is the 'wtIndex'th segment
+    // of its contour. If 'after' is set, only the segments following wt's index are visited.
+    // Returns false if there are none.
+    bool first(const SkIntersectionHelper& wt, int wtIndex, bool after, SkIntersectionHelper* wn) {
+        if (!fBandCount) {
+            wn->init(fContour);
+            return !after || wn->startAfter(wt);
+        }
+        int minIndex = after ? wtIndex : -1;
+        int firstBand = std::max(this->band(this->low(wt.bounds())) - 1, 0);
+        int lastBand = std::min(this->band(this->high(wt.bounds())) + 1, fBandCount - 1);
+        fFound.clear();
+        for (int band = firstBand; band <= lastBand; ++band) {
+            for (int entry = fBandEntry[band]; entry < fBandEntry[band + 1]; ++entry) {
+                int index = fBandSegments[entry];
+                if (index > minIndex &&
+                        SkPathOpsBounds::Intersects(wt.bounds(), fSegments[index]->bounds())) {
+                    fFound.push_back(index);
+                }
+            }
+        }
+        if (firstBand != lastBand) {
+            std::sort(fFound.begin(), fFound.end());
+            fFound.resize(std::unique(fFound.begin(), fFound.end()) - fFound.begin());
+        }
+        fNextFound = 0;
+        return this->next(wn);
+    }
+
+    bool next(SkIntersectionHelper* wn) {
+        if (!fBandCount) {
+            return wn->advance();
+        }
+        if (fNextFound >= fFound.size()) {
+            return false;
+        }
+        wn->set(fSegments[fFound[fNextFound++]]);
+        return true;
+    }
+
+private:
+    static constexpr int kMinBandedSegments = 64;
+    static constexpr int kSegmentsPerBand = 4;
+    static constexpr int kMaxBands = 1024;
+
+    float low(const SkPathOpsBounds& bounds) const {
+        return fVertical ? bounds.fLeft : bounds.fTop;
+    }
+
+    float high(const SkPathOpsBounds& bounds) const {
+        return fVertical ? bounds.fRight : bounds.fBottom;
+    }
+
+    int band(float coord) const {
+        float band = (coord - fBandStart) * fBandScale;
+        // Written so that NaN maps to band zero.
+        return !(band > 0) ? 0 : band >= fBandCount ? fBandCount - 1 : (int)band;
+    }
+
+    SkOpContour* fContour;
+    bool fVertical = false;  // The bands are vertical strips, split along x.
+    int fBandCount = 0;
+    float fBandStart = 0;
+    float fBandScale = 0;
+    skia_private::TArray<SkOpSegment*> fSegments;
+    skia_private::TArray<int> fBandEntry;
+    skia_private::TArray<int> fBandSegments;
+    skia_private::TArray<int> fFound;
+    int fNextFound = 0;
+};
+
+}  // namespace
+
 bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coincidence) {
     if (test != next) {
         if (AlmostLessUlps(test->bounds().fBottom, next->bounds().fTop)) {
@@ -282,14 +407,15 @@ bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coinc
             return true;
         }
     }
+    SegmentFinder finder(next);
     SkIntersectionHelper wt;
     wt.init(test);
+    int wtIndex = 0;
     do {
         SkIntersectionHelper wn;
-        wn.init(next);
         test->debugValidate();
         next->debugValidate();
-        if (test == next && !wn.startAfter(wt)) {
+        if (!finder.first(wt, wtIndex, test == next, &wn)) {
             continue;
         }
         do {
@@ -589,7 +715,7 @@ bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coinc
                 coinIndex = -1;
             }
             SkOPOBJASSERT(coincidence, coinIndex < 0);  // expect coincidence to be paired
-        } while (wn.advance());
-    } while (wt.advance());
+        } while (finder.next(&wn));
+    } while (++wtIndex, wt.advance());
     return true;
 }
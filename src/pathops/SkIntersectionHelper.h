@@ -77,6 +77,10 @@ public:
         return kLine_Segment;
     }
 
+    void set(SkOpSegment* segment) {
+        fSegment = segment;
+    }
+
     bool startAfter(const SkIntersectionHelper& after) {
         fSegment = after.fSegment->next();
         return fSegment != nullptr;
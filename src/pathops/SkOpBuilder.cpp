@@ -137,6 +137,47 @@ void SkOpBuilder::reset() {
     fOps.reset();
 }
 
+// Returns true if every op is the same union, intersect or xor, so that the paths can be combined
+// in any grouping.
+bool SkOpBuilder::IsAssociative(const SkPathOp ops[], int count) {
+    SkPathOp op = ops[0];
+    if (op != kUnion_SkPathOp && op != kIntersect_SkPathOp && op != kXOR_SkPathOp) {
+        return false;
+    }
+    for (int index = 1; index < count; ++index) {
+        if (ops[index] != op) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Combining the paths one at a time makes every op intersect the whole result so far, which for
+   n overlapping paths costs O(n^2) segments. Combining neighbors in pairs, then pairs of those
+   results, and so on, keeps the two sides of each op about the same size and touches each
+   segment only O(log n) times. */
+bool SkOpBuilder::resolvePairwise(SkPathOp op, SkPath* result) {
+    SkPath original = *result;
+    int live = fPathRefs.size();
+    while (live > 1) {
+        int next = 0;
+        for (int index = 0; index + 1 < live; index += 2) {
+            if (!Op(fPathRefs[index], fPathRefs[index + 1], op, &fPathRefs[next++])) {
+                reset();
+                *result = original;
+                return false;
+            }
+        }
+        if (live & 1) {
+            fPathRefs[next++] = fPathRefs[live - 1];
+        }
+        live = next;
+    }
+    *result = fPathRefs[0];
+    reset();
+    return true;
+}
+
 /* OPTIMIZATION: Union doesn't need to be all-or-nothing. A run of three or more convex
    paths with union ops could be locally resolved and still improve over doing the
    ops one at a time. */
@@ -176,6 +217,9 @@ bool SkOpBuilder::resolve(SkPath* result) {
         }
     }
     if (!allUnion) {
+        if (count > 2 && IsAssociative(fOps.begin() + 1, count - 1)) {
+            return this->resolvePairwise(fOps[1], result);
+        }
         *result = fPathRefs[0];
         for (int index = 1; index < count; ++index) {
             if (!Op(*result, fPathRefs[index], fOps[index], result)) {
@@ -8,13 +8,19 @@
 #include "src/pdf/SkDeflate.h"
 
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkSemaphore.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkTraceEvent.h"
 
 #include "zlib.h"  // NO_G3_REWRITE
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <memory>
 
 namespace {
 
@@ -91,6 +97,223 @@ SkDeflateWStream::SkDeflateWStream(SkWStream* out,
     SkASSERT(Z_OK == r);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// One block of input, compressed as raw deflate data that ends on a byte boundary (or with the
+// final block bit set, if it is the last block), so that the blocks can simply be concatenated.
+struct DeflateBlock {
+    // The dictionary (the end of the previous block) followed by this block's data.
+    std::unique_ptr<uint8_t[]> fInput;
+    size_t fDictionaryLength = 0;
+    size_t fLength = 0;
+    bool fLast = false;
+
+    SkDynamicMemoryWStream fOutput;
+    uLong fCheck = 0;  // adler32 (or crc32 for gzip) of this block's data.
+
+    std::atomic<bool> fClaimed{false};
+    std::atomic<bool> fFinished{false};
+    SkSemaphore fDone;  // Signaled when a thread other than the writer finishes the block.
+
+    void compress(int compressionLevel, bool gzip) {
+        const uint8_t* data = fInput.get() + fDictionaryLength;
+        fCheck = gzip ? crc32(0, data, SkToUInt(fLength))
+                      : adler32(1, data, SkToUInt(fLength));
+
+        z_stream zStream;
+        zStream.next_in = nullptr;
+        zStream.zalloc = &skia_alloc_func;
+        zStream.zfree = &skia_free_func;
+        zStream.opaque = nullptr;
+        SkDEBUGCODE(int r =) deflateInit2(&zStream, compressionLevel, Z_DEFLATED,
+                                          -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+        SkASSERT(Z_OK == r);
+        if (fDictionaryLength > 0) {
+            deflateSetDictionary(&zStream, fInput.get(), SkToUInt(fDictionaryLength));
+        }
+        zStream.next_in = const_cast<uint8_t*>(data);
+        zStream.avail_in = SkToUInt(fLength);
+        unsigned char outBuffer[SKDEFLATEWSTREAM_OUTPUT_BUFFER_SIZE];
+        do {
+            zStream.next_out = outBuffer;
+            zStream.avail_out = sizeof(outBuffer);
+            deflate(&zStream, fLast ? Z_FINISH : Z_SYNC_FLUSH);
+            fOutput.write(outBuffer, sizeof(outBuffer) - zStream.avail_out);
+        } while (zStream.avail_in || !zStream.avail_out);
+        (void)deflateEnd(&zStream);
+        fInput.reset();
+    }
+};
+
+}  // namespace
+
+struct SkDeflateWStream::Blocks {
+    SkExecutor* fExecutor;
+    int fCompressionLevel;
+    bool fGzip;
+
+    std::shared_ptr<DeflateBlock> fCurrent;
+    std::deque<std::shared_ptr<DeflateBlock>> fInFlight;
+    uLong fCheck;
+    size_t fTotalIn = 0;
+};
+
+// Bounds how much compressed and uncompressed data can be queued at once.
+static constexpr size_t kMaxBlocksInFlight = 16;
+
+static std::shared_ptr<DeflateBlock> make_block(const DeflateBlock* previous) {
+    auto block = std::make_shared<DeflateBlock>();
+    block->fInput.reset(new uint8_t[SkDeflateWStream::kDictionarySize +
+                                    SkDeflateWStream::kBlockSize]);
+    if (previous) {
+        size_t dictionaryLength = std::min(previous->fDictionaryLength + previous->fLength,
+                                           SkDeflateWStream::kDictionarySize);
+        const uint8_t* end = previous->fInput.get() + previous->fDictionaryLength +
+                             previous->fLength;
+        memcpy(block->fInput.get(), end - dictionaryLength, dictionaryLength);
+        block->fDictionaryLength = dictionaryLength;
+    }
+    return block;
+}
+
+static void write_be32(SkWStream* out, uint32_t v) {
+    uint8_t bytes[4] = {(uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v};
+    out->write(bytes, 4);
+}
+
+static void write_le32(SkWStream* out, uint32_t v) {
+    uint8_t bytes[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+    out->write(bytes, 4);
+}
+
+// Writes the header zlib's deflate() would for these settings.
+static void write_header(SkWStream* out, int compressionLevel, bool gzip) {
+    if (compressionLevel == Z_DEFAULT_COMPRESSION) {
+        compressionLevel = 6;
+    }
+    if (gzip) {
+        uint8_t xfl = compressionLevel == 9 ? 2 : compressionLevel < 2 ? 4 : 0;
+        const uint8_t header[10] = {0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, xfl, 255 /*unknown OS*/};
+        out->write(header, sizeof(header));
+        return;
+    }
+    unsigned levelFlags = compressionLevel < 2  ? 0
+                        : compressionLevel < 6  ? 1
+                        : compressionLevel == 6 ? 2
+                                                : 3;
+    unsigned header = ((Z_DEFLATED + ((MAX_WBITS - 8) << 4)) << 8) | (levelFlags << 6);
+    header += 31 - (header % 31);
+    const uint8_t bytes[2] = {(uint8_t)(header >> 8), (uint8_t)header};
+    out->write(bytes, sizeof(bytes));
+}
+
+SkDeflateWStream::SkDeflateWStream(SkWStream* out,
+                                   int compressionLevel,
+                                   bool gzip,
+                                   SkExecutor* executor)
+    : fImpl(std::make_unique<SkDeflateWStream::Impl>())
+    , fBlocks(std::make_unique<Blocks>()) {
+    SkASSERT(compressionLevel != 0);
+    SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
+    fImpl->fOut = out;
+    fImpl->fInBufferIndex = 0;
+    fBlocks->fExecutor = executor;
+    fBlocks->fCompressionLevel = compressionLevel;
+    fBlocks->fGzip = gzip;
+    fBlocks->fCheck = gzip ? crc32(0, nullptr, 0) : adler32(0, nullptr, 0);
+    if (!fImpl->fOut) {
+        return;
+    }
+    fBlocks->fCurrent = make_block(nullptr);
+    write_header(fImpl->fOut, compressionLevel, gzip);
+}
+
+// Writes out finished blocks in order. If 'wait', also finishes (or waits for) the rest.
+static void write_blocks(SkWStream* out, bool wait,
+                         std::deque<std::shared_ptr<DeflateBlock>>* inFlight,
+                         uLong* check, int compressionLevel, bool gzip) {
+    while (!inFlight->empty()) {
+        DeflateBlock* block = inFlight->front().get();
+        if (!block->fFinished.load(std::memory_order_acquire)) {
+            if (!wait && inFlight->size() <= kMaxBlocksInFlight) {
+                return;
+            }
+            if (!block->fClaimed.exchange(true)) {
+                // Nobody has started on this block yet, so do it here rather than wait.
+                block->compress(compressionLevel, gzip);
+            } else {
+                block->fDone.wait();
+            }
+        }
+        block->fOutput.writeToAndReset(out);
+        *check = gzip ? crc32_combine(*check, block->fCheck, (z_off_t)block->fLength)
+                      : adler32_combine(*check, block->fCheck, (z_off_t)block->fLength);
+        inFlight->pop_front();
+    }
+}
+
+void SkDeflateWStream::submitBlock(bool last) {
+    Blocks* blocks = fBlocks.get();
+    std::shared_ptr<DeflateBlock> block = std::move(blocks->fCurrent);
+    block->fLast = last;
+    if (!last) {
+        blocks->fCurrent = make_block(block.get());
+    }
+    if (blocks->fExecutor && !last) {
+        blocks->fInFlight.push_back(block);
+        int compressionLevel = blocks->fCompressionLevel;
+        bool gzip = blocks->fGzip;
+        blocks->fExecutor->add([block, compressionLevel, gzip]() {
+            if (!block->fClaimed.exchange(true)) {
+                block->compress(compressionLevel, gzip);
+                block->fFinished.store(true, std::memory_order_release);
+                block->fDone.signal();
+            }
+        });
+    } else {
+        block->fClaimed = true;
+        block->compress(blocks->fCompressionLevel, blocks->fGzip);
+        block->fFinished = true;
+        blocks->fInFlight.push_back(std::move(block));
+    }
+    write_blocks(fImpl->fOut, last, &blocks->fInFlight, &blocks->fCheck,
+                 blocks->fCompressionLevel, blocks->fGzip);
+}
+
+bool SkDeflateWStream::writeBlocks(const void* void_buffer, size_t len) {
+    const uint8_t* buffer = (const uint8_t*)void_buffer;
+    Blocks* blocks = fBlocks.get();
+    while (len > 0) {
+        DeflateBlock* block = blocks->fCurrent.get();
+        size_t tocopy = std::min(len, kBlockSize - block->fLength);
+        memcpy(block->fInput.get() + block->fDictionaryLength + block->fLength, buffer, tocopy);
+        block->fLength += tocopy;
+        blocks->fTotalIn += tocopy;
+        buffer += tocopy;
+        len -= tocopy;
+        if (block->fLength == kBlockSize) {
+            this->submitBlock(/*last=*/false);
+        }
+    }
+    return true;
+}
+
+void SkDeflateWStream::finalizeBlocks() {
+    Blocks* blocks = fBlocks.get();
+    this->submitBlock(/*last=*/true);
+    SkASSERT(blocks->fInFlight.empty());
+    if (blocks->fGzip) {
+        write_le32(fImpl->fOut, (uint32_t)blocks->fCheck);
+        write_le32(fImpl->fOut, (uint32_t)blocks->fTotalIn);
+    } else {
+        write_be32(fImpl->fOut, (uint32_t)blocks->fCheck);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 SkDeflateWStream::~SkDeflateWStream() { this->finalize(); }
 
 void SkDeflateWStream::finalize() {
@@ -98,6 +321,11 @@ void SkDeflateWStream::finalize() {
     if (!fImpl->fOut) {
         return;
     }
+    if (fBlocks) {
+        this->finalizeBlocks();
+        fImpl->fOut = nullptr;
+        return;
+    }
     do_deflate(Z_FINISH, &fImpl->fZStream, fImpl->fOut, fImpl->fInBuffer,
                fImpl->fInBufferIndex);
     (void)deflateEnd(&fImpl->fZStream);
@@ -109,6 +337,9 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
     if (!fImpl->fOut) {
         return false;
     }
+    if (fBlocks) {
+        return this->writeBlocks(void_buffer, len);
+    }
     const char* buffer = (const char*)void_buffer;
     while (len > 0) {
         size_t tocopy =
@@ -130,5 +361,8 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 }
 
 size_t SkDeflateWStream::bytesWritten() const {
+    if (fBlocks) {
+        return fBlocks->fTotalIn;
+    }
     return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
@@ -11,6 +11,10 @@
 
 #include "include/core/SkStream.h"
 
+#include <memory>
+
+class SkExecutor;
+
 /**
   * Wrap a stream in this class to compress the information written to
   * this stream using the Deflate algorithm.
@@ -34,6 +38,20 @@ public:
                      int compressionLevel,
                      bool gzip = false);
 
+    /** Like the constructor above, but compresses the input in independent kBlockSize blocks,
+        each primed with the kDictionarySize bytes of input before it (the way pigz does).
+        Blocks are compressed on 'executor' if it is not null, otherwise on the writing thread.
+        The output depends only on the input, compressionLevel and gzip, never on the executor.
+        It is usually a few bytes per block larger than the output of the constructor above.
+     */
+    SkDeflateWStream(SkWStream*,
+                     int compressionLevel,
+                     bool gzip,
+                     SkExecutor* executor);
+
+    static constexpr size_t kBlockSize = 128 * 1024;
+    static constexpr size_t kDictionarySize = 32 * 1024;
+
     /** The destructor calls finalize(). */
     ~SkDeflateWStream() override;
 
@@ -47,7 +65,13 @@ public:
 
 private:
     struct Impl;
+    struct Blocks;
+    void submitBlock(bool last);
+    bool writeBlocks(const void*, size_t);
+    void finalizeBlocks();
+
     std::unique_ptr<Impl> fImpl;
+    std::unique_ptr<Blocks> fBlocks;
 };
 
 #endif  // SkFlate_DEFINED
@@ -128,7 +128,8 @@ void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectRefe
     SkWStream* stream = &buffer;
     std::optional<SkDeflateWStream> deflateWStream;
     if (format == SkPDFStreamFormat::Flate) {
-        deflateWStream.emplace(&buffer, SkToInt(compressionLevel));
+        deflateWStream.emplace(&buffer, SkToInt(compressionLevel), /*gzip=*/false,
+                               doc->executor());
         stream = &*deflateWStream;
     }
     if (kAlpha_8_SkColorType == pm.colorType()) {
@@ -205,7 +206,8 @@ void do_deflated_image(const SkPixmap& pm,
     SkWStream* stream = &buffer;
     std::optional<SkDeflateWStream> deflateWStream;
     if (format == SkPDFStreamFormat::Flate) {
-        deflateWStream.emplace(&buffer, SkToInt(compressionLevel));
+        deflateWStream.emplace(&buffer, SkToInt(compressionLevel), /*gzip=*/false,
+                               doc->executor());
         stream = &*deflateWStream;
     }
     SkPDFUnion colorSpace = SkPDFUnion::Name("DeviceGray");
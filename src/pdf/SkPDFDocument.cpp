@@ -12,6 +12,7 @@
 #include "include/docs/SkPDFDocument.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pdf/SkPDFDevice.h"
 #include "src/pdf/SkPDFFont.h"
 #include "src/pdf/SkPDFGradientShader.h"
@@ -20,6 +21,7 @@
 #include "src/pdf/SkPDFTag.h"
 #include "src/pdf/SkPDFUtils.h"
 
+#include <algorithm>
 #include <utility>
 
 // For use in SkCanvas::drawAnnotation
@@ -59,12 +61,16 @@ static size_t difference(size_t minuend, size_t subtrahend) {
 }
 
 void SkPDFOffsetMap::markStartOfObject(int referenceNumber, const SkWStream* s) {
+    this->markStartOfObject(referenceNumber, s->bytesWritten());
+}
+
+void SkPDFOffsetMap::markStartOfObject(int referenceNumber, size_t bytesWritten) {
     SkASSERT(referenceNumber > 0);
     size_t index = SkToSizeT(referenceNumber - 1);
     if (index >= fOffsets.size()) {
         fOffsets.resize(index + 1);
     }
-    fOffsets[index] = SkToInt(difference(s->bytesWritten(), fBaseOffset));
+    fOffsets[index] = SkToInt(difference(bytesWritten, fBaseOffset));
 }
 
 int SkPDFOffsetMap::objectCount() const {
@@ -102,12 +108,16 @@ static void serializeHeader(SkPDFOffsetMap* offsetMap, SkWStream* wStream) {
 }
 #undef SKPDF_MAGIC
 
+static void write_object_header(SkPDFIndirectReference ref, SkWStream* s) {
+    s->writeDecAsText(ref.fValue);
+    s->writeText(" 0 obj\n");  // Generation number is always 0.
+}
+
 static void begin_indirect_object(SkPDFOffsetMap* offsetMap,
                                   SkPDFIndirectReference ref,
                                   SkWStream* s) {
     offsetMap->markStartOfObject(ref.fValue, s);
-    s->writeDecAsText(ref.fValue);
-    s->writeText(" 0 obj\n");  // Generation number is always 0.
+    write_object_header(ref, s);
 }
 
 static void end_indirect_object(SkWStream* s) { s->writeText("\nendobj\n"); }
@@ -135,68 +145,105 @@ static void serialize_footer(const SkPDFOffsetMap& offsetMap,
     wStream->writeText("\n%%EOF\n");
 }
 
+// PDF wants a tree describing all the pages in the document.  We arbitrary
+// choose 8 (kPageTreeNodeSize) as the number of allowed children.  The internal
+// nodes have type "Pages" with an array of children, a parent pointer, and
+// the number of leaves below the node as "Count."  The leaves have type "Page"
+// and need a parent pointer.
+static constexpr size_t kPageTreeNodeSize = 8;
+
+namespace {
+struct PageTreeNode {
+    std::unique_ptr<SkPDFDict> fNode;
+    SkPDFIndirectReference fReservedRef;
+    int fPageObjectDescendantCount;
+
+    // Builds the next layer up, skipping internal nodes that would have only one child.
+    static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
+        std::vector<PageTreeNode> result;
+        const size_t n = vec.size();
+        SkASSERT(n >= 1);
+        const size_t result_len = (n - 1) / kPageTreeNodeSize + 1;
+        SkASSERT(result_len >= 1);
+        SkASSERT(n == 1 || result_len < n);
+        result.reserve(result_len);
+        size_t index = 0;
+        for (size_t i = 0; i < result_len; ++i) {
+            if (n != 1 && index + 1 == n) {  // No need to create a new node.
+                result.push_back(std::move(vec[index++]));
+                continue;
+            }
+            SkPDFIndirectReference parent = doc->reserveRef();
+            auto kids_list = SkPDFMakeArray();
+            int descendantCount = 0;
+            for (size_t j = 0; j < kPageTreeNodeSize && index < n; ++j) {
+                PageTreeNode& node = vec[index++];
+                node.fNode->insertRef("Parent", parent);
+                kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
+                descendantCount += node.fPageObjectDescendantCount;
+            }
+            auto next = SkPDFMakeDict("Pages");
+            next->insertInt("Count", descendantCount);
+            next->insertObject("Kids", std::move(kids_list));
+            result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
+        }
+        return result;
+    }
+};
+}  // namespace
+
+static SkPDFIndirectReference emit_page_tree(SkPDFDocument* doc,
+                                             std::vector<PageTreeNode> currentLayer) {
+    SkASSERT(!currentLayer.empty());
+    currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+    while (currentLayer.size() > 1) {
+        currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+    }
+    SkASSERT(currentLayer.size() == 1);
+    const PageTreeNode& root = currentLayer[0];
+    return doc->emit(*root.fNode, root.fReservedRef);
+}
+
 static SkPDFIndirectReference generate_page_tree(
         SkPDFDocument* doc,
         std::vector<std::unique_ptr<SkPDFDict>> pages,
         const std::vector<SkPDFIndirectReference>& pageRefs) {
-    // PDF wants a tree describing all the pages in the document.  We arbitrary
-    // choose 8 (kNodeSize) as the number of allowed children.  The internal
-    // nodes have type "Pages" with an array of children, a parent pointer, and
-    // the number of leaves below the node as "Count."  The leaves are passed
-    // into the method, have type "Page" and need a parent pointer. This method
-    // builds the tree bottom up, skipping internal nodes that would have only
-    // one child.
+    // This method builds the tree bottom up from the unwritten page objects.
     SkASSERT(pages.size() > 0);
-    struct PageTreeNode {
-        std::unique_ptr<SkPDFDict> fNode;
-        SkPDFIndirectReference fReservedRef;
-        int fPageObjectDescendantCount;
-
-        static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
-            std::vector<PageTreeNode> result;
-            static constexpr size_t kMaxNodeSize = 8;
-            const size_t n = vec.size();
-            SkASSERT(n >= 1);
-            const size_t result_len = (n - 1) / kMaxNodeSize + 1;
-            SkASSERT(result_len >= 1);
-            SkASSERT(n == 1 || result_len < n);
-            result.reserve(result_len);
-            size_t index = 0;
-            for (size_t i = 0; i < result_len; ++i) {
-                if (n != 1 && index + 1 == n) {  // No need to create a new node.
-                    result.push_back(std::move(vec[index++]));
-                    continue;
-                }
-                SkPDFIndirectReference parent = doc->reserveRef();
-                auto kids_list = SkPDFMakeArray();
-                int descendantCount = 0;
-                for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
-                    PageTreeNode& node = vec[index++];
-                    node.fNode->insertRef("Parent", parent);
-                    kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
-                    descendantCount += node.fPageObjectDescendantCount;
-                }
-                auto next = SkPDFMakeDict("Pages");
-                next->insertInt("Count", descendantCount);
-                next->insertObject("Kids", std::move(kids_list));
-                result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
-            }
-            return result;
-        }
-    };
     std::vector<PageTreeNode> currentLayer;
     currentLayer.reserve(pages.size());
     SkASSERT(pages.size() == pageRefs.size());
     for (size_t i = 0; i < pages.size(); ++i) {
         currentLayer.push_back(PageTreeNode{std::move(pages[i]), pageRefs[i], 1});
     }
-    currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
-    while (currentLayer.size() > 1) {
-        currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+    return emit_page_tree(doc, std::move(currentLayer));
+}
+
+// When streaming, each page was written as it ended, with one of 'leaves' as its parent.
+static SkPDFIndirectReference generate_streamed_page_tree(
+        SkPDFDocument* doc,
+        const std::vector<SkPDFIndirectReference>& leaves,
+        const std::vector<SkPDFIndirectReference>& pageRefs) {
+    SkASSERT(leaves.size() == (pageRefs.size() - 1) / kPageTreeNodeSize + 1);
+    std::vector<PageTreeNode> currentLayer;
+    currentLayer.reserve(leaves.size());
+    for (size_t i = 0; i < leaves.size(); ++i) {
+        auto kids_list = SkPDFMakeArray();
+        size_t first = i * kPageTreeNodeSize,
+               end = std::min(first + kPageTreeNodeSize, pageRefs.size());
+        for (size_t j = first; j < end; ++j) {
+            kids_list->appendRef(pageRefs[j]);
+        }
+        auto node = SkPDFMakeDict("Pages");
+        node->insertInt("Count", SkToInt(end - first));
+        node->insertObject("Kids", std::move(kids_list));
+        currentLayer.push_back(PageTreeNode{std::move(node), leaves[i], SkToInt(end - first)});
     }
-    SkASSERT(currentLayer.size() == 1);
-    const PageTreeNode& root = currentLayer[0];
-    return doc->emit(*root.fNode, root.fReservedRef);
+    if (currentLayer.size() == 1) {
+        // Layer() leaves a lone node alone, so this leaf is the root.
+        return doc->emit(*currentLayer[0].fNode, currentLayer[0].fReservedRef);
+    }
+    return emit_page_tree(doc, std::move(currentLayer));
 }
 
 template<typename T, typename... Args>
@@ -227,20 +274,83 @@ SkPDFDocument::~SkPDFDocument() {
     this->close();
 }
 
+struct SkPDFDocument::PendingOutput {
+    SkDynamicMemoryWStream fBytes;
+    // Reference number and offset in fBytes of each object.
+    std::vector<std::pair<int, size_t>> fObjectStarts;
+    bool fDone = false;
+};
+
+thread_local SkPDFDocument::PendingOutput* SkPDFDocument::tJobOutput = nullptr;
+
 SkPDFIndirectReference SkPDFDocument::emit(const SkPDFObject& object, SkPDFIndirectReference ref){
     SkAutoMutexExclusive lock(fMutex);
-    object.emitObject(this->beginObject(ref));
-    this->endObject();
+    SkWStream* stream = this->beginObject(ref);
+    object.emitObject(stream);
+    this->endObject(stream);
     return ref;
 }
 
 SkWStream* SkPDFDocument::beginObject(SkPDFIndirectReference ref) SK_REQUIRES(fMutex) {
+    PendingOutput* pending = tJobOutput;
+    if (!pending && !fPendingOutput.empty()) {
+        // Something started earlier hasn't been written yet, so this has to wait behind it.
+        if (!fPendingOutput.back()->fDone) {
+            fPendingOutput.push_back(std::make_unique<PendingOutput>());
+            fPendingOutput.back()->fDone = true;
+        }
+        pending = fPendingOutput.back().get();
+    }
+    if (pending) {
+        pending->fObjectStarts.emplace_back(ref.fValue, pending->fBytes.bytesWritten());
+        write_object_header(ref, &pending->fBytes);
+        return &pending->fBytes;
+    }
     begin_indirect_object(&fOffsetMap, ref, this->getStream());
     return this->getStream();
 }
 
-void SkPDFDocument::endObject() SK_REQUIRES(fMutex) {
-    end_indirect_object(this->getStream());
+void SkPDFDocument::endObject(SkWStream* stream) SK_REQUIRES(fMutex) {
+    end_indirect_object(stream);
+}
+
+void SkPDFDocument::writePendingOutput() SK_REQUIRES(fMutex) {
+    SkWStream* stream = this->getStream();
+    while (!fPendingOutput.empty() && fPendingOutput.front()->fDone) {
+        PendingOutput* pending = fPendingOutput.front().get();
+        size_t base = stream->bytesWritten();
+        for (auto [referenceNumber, offset] : pending->fObjectStarts) {
+            fOffsetMap.markStartOfObject(referenceNumber, base + offset);
+        }
+        pending->fBytes.writeToAndReset(stream);
+        fPendingOutput.pop_front();
+    }
+}
+
+void SkPDFDocument::serializeInOrder(std::function<void()> job) {
+    if (!fExecutor || tJobOutput) {
+        // Without an executor, or when already inside a job, the call order is the output order.
+        job();
+        return;
+    }
+    PendingOutput* pending;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        fPendingOutput.push_back(std::make_unique<PendingOutput>());
+        pending = fPendingOutput.back().get();
+    }
+    this->incrementJobCount();
+    fExecutor->add([this, pending, job = std::move(job)]() {
+        tJobOutput = pending;
+        job();
+        tJobOutput = nullptr;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            pending->fDone = true;
+            this->writePendingOutput();
+        }
+        this->signalJobComplete();
+    });
 }
 
 static SkSize operator*(SkISize u, SkScalar s) { return SkSize{u.width() * s, u.height() * s}; }
@@ -248,7 +358,7 @@ static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.h
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         // if this is the first page if the document.
         {
             SkAutoMutexExclusive autoMutexAcquire(fMutex);
@@ -376,7 +486,43 @@ void SkPDFDocument::onEndPage() {
     // The StructParents unique identifier for each page is just its
     // 0-based page index.
     page->insertInt("StructParents", SkToInt(this->currentPageIndex()));
-    fPages.emplace_back(std::move(page));
+
+    if (fMetadata.fStreaming) {
+        if (fEndedPageCount % kPageTreeNodeSize == 0) {
+            fPageTreeLeaves.push_back(this->reserveRef());
+        }
+        page->insertRef("Parent", fPageTreeLeaves.back());
+        this->emit(*page, fPageRefs[fEndedPageCount]);
+        if (this->retainedFontBytes() > fMetadata.fMaxRetainedFontBytes) {
+            // Write out the fonts used so far and start over with new subsets. The cached
+            // metrics go too, so that the new subsets get new subset tags.
+            this->emitFonts();
+            fFontMap.reset();
+            fTypefaceMetrics.reset();
+            fToUnicodeMap.reset();
+            fType1GlyphNames.reset();
+        }
+    } else {
+        fPages.emplace_back(std::move(page));
+    }
+    fEndedPageCount++;
+}
+
+size_t SkPDFDocument::retainedFontBytes() const {
+    size_t bytes = 0;
+    for (const auto& [unused, font] : fFontMap) {
+        const SkPDFGlyphUse& glyphUsage = font.glyphUsage();
+        bytes += (glyphUsage.lastGlyph() - glyphUsage.firstNonZero() + 2 + 7) / 8;
+    }
+    for (const auto& [unused, unicodes] : fToUnicodeMap) {
+        bytes += unicodes.size() * sizeof(SkUnichar);
+    }
+    for (const auto& [unused, names] : fType1GlyphNames) {
+        for (const SkString& name : names) {
+            bytes += sizeof(SkString) + name.size();
+        }
+    }
+    return bytes;
 }
 
 void SkPDFDocument::onAbort() {
@@ -583,9 +729,34 @@ SkString SkPDFDocument::nextFontSubsetTag() {
     return subsetTag;
 }
 
+void SkPDFDocument::emitFonts() {
+    // Subsetting fonts and measuring their glyphs doesn't depend on the rest of the document,
+    // so fan it out before emitting the fonts in order.
+    std::vector<const SkPDFFont*> fonts = get_fonts(*this);
+    std::vector<const SkAdvancedTypefaceMetrics*> fontMetrics(fonts.size(), nullptr);
+    std::vector<SkPDFFont::PreparedSubset> preparedFonts(fExecutor ? fonts.size() : 0);
+    if (fExecutor) {
+        for (size_t i = 0; i < fonts.size(); ++i) {
+            if (fonts[i]->multiByteGlyphs()) {
+                fontMetrics[i] = SkPDFFont::GetMetrics(fonts[i]->typeface(), this);
+            }
+        }
+        SkTaskGroup tasks(*fExecutor);
+        tasks.batch(SkToInt(fonts.size()), [&](int i) {
+            if (fontMetrics[i]) {
+                preparedFonts[i] = fonts[i]->prepareSubset(*fontMetrics[i], fMetadata.fSubsetter);
+            }
+        });
+        tasks.wait();
+    }
+    for (size_t i = 0; i < fonts.size(); ++i) {
+        fonts[i]->emitSubset(this, fontMetrics[i] ? &preparedFonts[i] : nullptr);
+    }
+}
+
 void SkPDFDocument::onClose(SkWStream* stream) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         this->waitForJobs();
         return;
     }
@@ -598,7 +769,10 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
     }
 
-    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    docCatalog->insertRef("Pages",
+                          fMetadata.fStreaming
+                                  ? generate_streamed_page_tree(this, fPageTreeLeaves, fPageRefs)
+                                  : generate_page_tree(this, std::move(fPages), fPageRefs));
 
     if (!fNamedDestinations.empty()) {
         docCatalog->insertRef("Dests", append_destinations(this, fNamedDestinations));
@@ -635,13 +809,12 @@ void SkPDFDocument::onClose(SkWStream* stream) {
 
     auto docCatalogRef = this->emit(*docCatalog);
 
-    for (const SkPDFFont* f : get_fonts(*this)) {
-        f->emitSubset(this);
-    }
+    this->emitFonts();
 
     this->waitForJobs();
     {
         SkAutoMutexExclusive autoMutexAcquire(fMutex);
+        SkASSERT(fPendingOutput.empty());
         serialize_footer(fOffsetMap, this->getStream(), fInfoDict, docCatalogRef, fUUID);
     }
 }
@@ -19,6 +19,8 @@
 #include "src/pdf/SkPDFTag.h"
 
 #include <atomic>
+#include <deque>
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -40,6 +42,7 @@ class SkPDFOffsetMap {
 public:
     void markStartOfDocument(const SkWStream*);
     void markStartOfObject(int referenceNumber, const SkWStream*);
+    void markStartOfObject(int referenceNumber, size_t bytesWritten);
     int objectCount() const;
     int emitCrossReferenceTable(SkWStream* s) const;
 private:
@@ -107,7 +110,7 @@ public:
         stream->writeText(" stream\n");
         writeStream(stream);
         stream->writeText("\nendstream");
-        this->endObject();
+        this->endObject(stream);
     }
 
     const SkPDF::Metadata& metadata() const { return fMetadata; }
@@ -138,7 +141,13 @@ public:
     SkExecutor* executor() const { return fExecutor; }
     void incrementJobCount();
     void signalJobComplete();
-    size_t currentPageIndex() { return fPages.size(); }
+
+    // Runs 'job' on the executor, or right away if there is none. Objects emitted by the job are
+    // written out in the order the job was started relative to all other emitted objects, so the
+    // document is byte-identical to one made without an executor, as long as the job only
+    // uses references reserved before it was started.
+    void serializeInOrder(std::function<void()> job);
+    size_t currentPageIndex() { return fEndedPageCount; }
     size_t pageCount() { return fPageRefs.size(); }
 
     const SkMatrix& currentPageTransform() const;
@@ -176,6 +185,10 @@ private:
     SkCanvas fCanvas;
     std::vector<std::unique_ptr<SkPDFDict>> fPages;
     std::vector<SkPDFIndirectReference> fPageRefs;
+    size_t fEndedPageCount = 0;
+    // With fMetadata.fStreaming, pages are written as they end, so the lowest "Pages" nodes of
+    // the page tree (one per kPageTreeNodeSize pages) are reserved before their pages.
+    std::vector<SkPDFIndirectReference> fPageTreeLeaves;
 
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
@@ -195,9 +208,18 @@ private:
     SkMutex fMutex;
     SkSemaphore fSemaphore;
 
+    // Output that can't be written yet because a job started before it is still running.
+    struct PendingOutput;
+    std::deque<std::unique_ptr<PendingOutput>> fPendingOutput SK_GUARDED_BY(fMutex);
+    // The output of the serializeInOrder() job running on this thread, if any.
+    static thread_local PendingOutput* tJobOutput;
+
     void waitForJobs();
+    void emitFonts();
+    size_t retainedFontBytes() const;
     SkWStream* beginObject(SkPDFIndirectReference);
-    void endObject();
+    void endObject(SkWStream*);
+    void writePendingOutput();
 };
 
 #endif  // SkPDFDocumentPriv_DEFINED
@@ -282,21 +282,30 @@ void SkPDFFont::PopulateCommonFontDescriptor(SkPDFDict* descriptor,
 //  Type0Font
 ///////////////////////////////////////////////////////////////////////////////
 
-// if possible, make no copy.
-static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
-    SkASSERT(stream);
-    (void)stream->rewind();
-    SkASSERT(stream->hasLength());
-    size_t size = stream->getLength();
-    if (const void* base = stream->getMemoryBase()) {
-        SkData::ReleaseProc proc =
-            [](const void*, void* ctx) { delete (SkStreamAsset*)ctx; };
-        return SkData::MakeWithProc(base, size, proc, stream.release());
+static bool is_subsettable_truetype(const SkPDFFont& font,
+                                    const SkAdvancedTypefaceMetrics& metrics) {
+    return font.getType() == SkAdvancedTypefaceMetrics::kTrueType_Font &&
+           !SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag);
+}
+
+SkPDFFont::PreparedSubset SkPDFFont::prepareSubset(const SkAdvancedTypefaceMetrics& metrics,
+                                                   SkPDF::Metadata::Subsetter subsetter) const {
+    SkASSERT(this->multiByteGlyphs());
+    PreparedSubset prepared;
+    SkTypeface* face = this->typeface();
+    SkASSERT(face);
+    if (is_subsettable_truetype(*this, metrics)) {
+        SkASSERT(this->firstGlyphID() == 1);
+        prepared.fFontData = SkPDFSubsetFontCached(*face, this->glyphUsage(), subsetter,
+                                                   metrics.fFontName.c_str());
     }
-    return SkData::MakeFromStream(stream.get(), size);
+    prepared.fWidths = SkPDFMakeCIDGlyphWidthsArray(*face, this->glyphUsage(),
+                                                    &prepared.fDefaultWidth);
+    return prepared;
 }
 
-static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
+static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc,
+                              SkPDFFont::PreparedSubset* prepared) {
     const SkAdvancedTypefaceMetrics* metricsPtr =
         SkPDFFont::GetMetrics(font.typeface(), doc);
     SkASSERT(metricsPtr);
@@ -321,13 +330,14 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     } else {
         switch (type) {
             case SkAdvancedTypefaceMetrics::kTrueType_Font: {
-                if (!SkToBool(metrics.fFlags &
-                              SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
+                if (is_subsettable_truetype(font, metrics)) {
                     SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
-                            stream_to_data(std::move(fontAsset)), font.glyphUsage(),
-                            doc->metadata().fSubsetter,
-                            metrics.fFontName.c_str(), ttcIndex);
+                    sk_sp<SkData> subsetFontData =
+                            prepared ? prepared->fFontData
+                                     : SkPDFSubsetFontCached(*face,
+                                                             font.glyphUsage(),
+                                                             doc->metadata().fSubsetter,
+                                                             metrics.fFontName.c_str());
                     if (subsetFontData) {
                         std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
                         tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
@@ -339,10 +349,6 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                         break;
                     }
                     // If subsetting fails, fall back to original font data.
-                    fontAsset = face->openStream(&ttcIndex);
-                    SkASSERT(fontAsset);
-                    SkASSERT(fontAsset->getLength() == fontSize);
-                    if (!fontAsset || fontAsset->getLength() == 0) { break; }
                 }
                 std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
                 tmp->insertInt("Length1", fontSize);
@@ -389,8 +395,13 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     // Unfortunately, poppler enforces DW (default width) must be an integer.
     int32_t defaultWidth = 0;
     {
-        std::unique_ptr<SkPDFArray> widths = SkPDFMakeCIDGlyphWidthsArray(
-                *face, font.glyphUsage(), &defaultWidth);
+        std::unique_ptr<SkPDFArray> widths;
+        if (prepared) {
+            widths = std::move(prepared->fWidths);
+            defaultWidth = prepared->fDefaultWidth;
+        } else {
+            widths = SkPDFMakeCIDGlyphWidthsArray(*face, font.glyphUsage(), &defaultWidth);
+        }
         if (widths && widths->size() > 0) {
             newCIDFont->insertObject("W", std::move(widths));
         }
@@ -704,11 +715,12 @@ static void emit_subset_type3(const SkPDFFont& pdfFont, SkPDFDocument* doc) {
     doc->emit(font, pdfFont.indirectReference());
 }
 
-void SkPDFFont::emitSubset(SkPDFDocument* doc) const {
+void SkPDFFont::emitSubset(SkPDFDocument* doc, PreparedSubset* prepared) const {
+    SkASSERT(!prepared || this->multiByteGlyphs());
     switch (fFontType) {
         case SkAdvancedTypefaceMetrics::kType1CID_Font:
         case SkAdvancedTypefaceMetrics::kTrueType_Font:
-            return emit_subset_type0(*this, doc);
+            return emit_subset_type0(*this, doc, prepared);
 #ifndef SK_PDF_DO_NOT_SUPPORT_TYPE_1_FONTS
         case SkAdvancedTypefaceMetrics::kType1_Font:
             return SkPDFEmitType1Font(*this, doc);
@@ -7,14 +7,17 @@
 #ifndef SkPDFFont_DEFINED
 #define SkPDFFont_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/docs/SkPDFDocument.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/pdf/SkPDFGlyphUse.h"
 #include "src/pdf/SkPDFTypes.h"
 
+#include <memory>
 #include <vector>
 
 class SkPDFDocument;
@@ -106,7 +109,19 @@ public:
                                              uint16_t emSize,
                                              int16_t defaultWidth);
 
-    void emitSubset(SkPDFDocument*) const;
+    /** The parts of emitSubset() for multi-byte fonts that are expensive but don't touch the
+     *  document: subsetting the font program and measuring the glyph advances. Computing these
+     *  ahead of time (on any thread) leaves the output of emitSubset() unchanged.
+     */
+    struct PreparedSubset {
+        sk_sp<SkData> fFontData;              // nullptr if the font is not subset.
+        std::unique_ptr<SkPDFArray> fWidths;
+        int32_t fDefaultWidth = 0;
+    };
+    PreparedSubset prepareSubset(const SkAdvancedTypefaceMetrics&,
+                                 SkPDF::Metadata::Subsetter) const;
+
+    void emitSubset(SkPDFDocument*, PreparedSubset* = nullptr) const;
 
     /**
      *  Return false iff the typeface has its NotEmbeddable flag set.
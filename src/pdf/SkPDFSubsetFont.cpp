@@ -3,6 +3,17 @@
 
 #include "src/pdf/SkPDFSubsetFont.h"
 
+#include "include/core/SkStream.h"
+#include "include/core/SkTypeface.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkNoDestructor.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
 #if defined(SK_PDF_USE_HARFBUZZ_SUBSET)
 
 #include "include/private/base/SkTemplates.h"
@@ -206,3 +217,176 @@ sk_sp<SkData> SkPDFSubsetFont(sk_sp<SkData>, const SkPDFGlyphUse&, SkPDF::Metada
     return nullptr;
 }
 #endif  // defined(SK_PDF_USE_SFNTLY)
+
+////////////////////////////////////////////////////////////////////////////////
+
+// if possible, make no copy.
+static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
+    SkASSERT(stream);
+    (void)stream->rewind();
+    SkASSERT(stream->hasLength());
+    size_t size = stream->getLength();
+    if (const void* base = stream->getMemoryBase()) {
+        SkData::ReleaseProc proc =
+            [](const void*, void* ctx) { delete (SkStreamAsset*)ctx; };
+        return SkData::MakeWithProc(base, size, proc, stream.release());
+    }
+    return SkData::MakeFromStream(stream.get(), size);
+}
+
+namespace {
+// Subsets are shared by every document in the process. A document whose glyphs are all in a
+// cached subset of the same typeface embeds that subset, as long as the subset doesn't carry too
+// many glyphs the document doesn't use. A document that uses only a few glyphs a cached subset is
+// missing replaces it with a subset of the union, so documents drawing nearly the same text
+// converge on one subset.
+class SubsetFontCache {
+public:
+    static constexpr size_t kByteLimit = 8 * 1024 * 1024;
+
+    static SubsetFontCache* Get() {
+        static SkNoDestructor<SubsetFontCache> gCache;
+        return gCache.get();
+    }
+
+    sk_sp<SkData> subset(const SkTypeface& typeface,
+                         const SkPDFGlyphUse& glyphUsage,
+                         SkPDF::Metadata::Subsetter subsetter,
+                         const char* fontName) {
+        std::vector<SkGlyphID> glyphs;
+        glyphUsage.getSetValues([&glyphs](unsigned gid) { glyphs.push_back(SkToU16(gid)); });
+        if (glyphs.empty()) {
+            return nullptr;
+        }
+
+        std::vector<SkGlyphID> merged;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            for (const std::unique_ptr<Entry>& entry : fEntries) {
+                if (entry->fTypefaceID != typeface.uniqueID() || entry->fSubsetter != subsetter) {
+                    continue;
+                }
+                size_t missing, extra;
+                count_differences(glyphs, entry->fGlyphs, &missing, &extra);
+                if (extra > max_extra_glyphs(glyphs.size())) {
+                    continue;
+                }
+                if (missing == 0) {
+                    entry->fLastUse = ++fUseCount;
+                    return entry->fSubset;
+                }
+                if (missing <= max_missing_glyphs(glyphs.size()) && merged.empty()) {
+                    std::set_union(glyphs.begin(), glyphs.end(),
+                                   entry->fGlyphs.begin(), entry->fGlyphs.end(),
+                                   std::back_inserter(merged));
+                }
+            }
+        }
+        std::vector<SkGlyphID>& subsetGlyphs = merged.empty() ? glyphs : merged;
+
+        // Subset without holding the lock. Two documents may race to make the same subset, and
+        // the second one to finish replaces the first in the cache.
+        int ttcIndex;
+        std::unique_ptr<SkStreamAsset> fontAsset = typeface.openStream(&ttcIndex);
+        if (!fontAsset || fontAsset->getLength() == 0) {
+            return nullptr;
+        }
+        SkPDFGlyphUse subsetUsage(1, subsetGlyphs.back() ? subsetGlyphs.back() : 1);
+        for (SkGlyphID gid : subsetGlyphs) {
+            subsetUsage.set(gid);
+        }
+        sk_sp<SkData> subset = SkPDFSubsetFont(stream_to_data(std::move(fontAsset)),
+                                               subsetUsage, subsetter, fontName, ttcIndex);
+        if (!subset || subset->size() > kByteLimit) {
+            return subset;
+        }
+
+        SkAutoMutexExclusive lock(fMutex);
+        // Drop the cached subsets the new one covers.
+        for (size_t i = 0; i < fEntries.size();) {
+            const Entry& entry = *fEntries[i];
+            if (entry.fTypefaceID == typeface.uniqueID() && entry.fSubsetter == subsetter &&
+                std::includes(subsetGlyphs.begin(), subsetGlyphs.end(),
+                              entry.fGlyphs.begin(), entry.fGlyphs.end())) {
+                this->remove(i);
+            } else {
+                ++i;
+            }
+        }
+        while (!fEntries.empty() && fBytes + subset->size() > kByteLimit) {
+            size_t oldest = 0;
+            for (size_t i = 1; i < fEntries.size(); ++i) {
+                if (fEntries[i]->fLastUse < fEntries[oldest]->fLastUse) {
+                    oldest = i;
+                }
+            }
+            this->remove(oldest);
+        }
+        fBytes += subset->size();
+        fEntries.push_back(std::make_unique<Entry>(
+                Entry{typeface.uniqueID(), subsetter, std::move(subsetGlyphs), subset,
+                      ++fUseCount}));
+        return subset;
+    }
+
+    void purge() {
+        SkAutoMutexExclusive lock(fMutex);
+        fEntries.clear();
+        fBytes = 0;
+    }
+
+private:
+    struct Entry {
+        SkTypefaceID fTypefaceID;
+        SkPDF::Metadata::Subsetter fSubsetter;
+        std::vector<SkGlyphID> fGlyphs;  // sorted
+        sk_sp<SkData> fSubset;
+        uint64_t fLastUse;
+    };
+
+    // A cached subset may have a few glyphs the document doesn't use, and a subset may be
+    // extended by a few glyphs, relative to the size of the document's glyph set.
+    static size_t max_extra_glyphs(size_t used) { return used / 2 + 32; }
+    static size_t max_missing_glyphs(size_t used) { return used / 4 + 8; }
+
+    // Both glyph lists are sorted. Counts the glyphs of a that aren't in b, and the other way.
+    static void count_differences(const std::vector<SkGlyphID>& a,
+                                  const std::vector<SkGlyphID>& b,
+                                  size_t* onlyInA, size_t* onlyInB) {
+        size_t i = 0, j = 0, common = 0;
+        while (i < a.size() && j < b.size()) {
+            if (a[i] < b[j]) {
+                ++i;
+            } else if (b[j] < a[i]) {
+                ++j;
+            } else {
+                ++i; ++j; ++common;
+            }
+        }
+        *onlyInA = a.size() - common;
+        *onlyInB = b.size() - common;
+    }
+
+    void remove(size_t i) SK_REQUIRES(fMutex) {
+        fBytes -= fEntries[i]->fSubset->size();
+        fEntries[i] = std::move(fEntries.back());
+        fEntries.pop_back();
+    }
+
+    SkMutex fMutex;
+    std::vector<std::unique_ptr<Entry>> fEntries SK_GUARDED_BY(fMutex);
+    size_t fBytes SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fUseCount SK_GUARDED_BY(fMutex) = 0;
+};
+}  // namespace
+
+sk_sp<SkData> SkPDFSubsetFontCached(const SkTypeface& typeface,
+                                    const SkPDFGlyphUse& glyphUsage,
+                                    SkPDF::Metadata::Subsetter subsetter,
+                                    const char* fontName) {
+    return SubsetFontCache::Get()->subset(typeface, glyphUsage, subsetter, fontName);
+}
+
+void SkPDFPurgeSubsetFontCache() {
+    SubsetFontCache::Get()->purge();
+}
@@ -7,10 +7,25 @@
 #include "include/docs/SkPDFDocument.h"
 #include "src/pdf/SkPDFGlyphUse.h"
 
+class SkTypeface;
+
 sk_sp<SkData> SkPDFSubsetFont(sk_sp<SkData> fontData,
                               const SkPDFGlyphUse& glyphUsage,
                               SkPDF::Metadata::Subsetter subsetter,
                               const char* fontName,
                               int ttcIndex);
 
+/**
+ *  Subsets the typeface's font data to at least the used glyphs, sharing subsets with every other
+ *  document in the process. The result may contain glyphs beyond glyphUsage (glyph IDs are always
+ *  retained), so that documents with nearly the same glyphs can embed the same subset.
+ */
+sk_sp<SkData> SkPDFSubsetFontCached(const SkTypeface&,
+                                    const SkPDFGlyphUse& glyphUsage,
+                                    SkPDF::Metadata::Subsetter subsetter,
+                                    const char* fontName);
+
+/** Frees the subsets held by SkPDFSubsetFontCached(). */
+void SkPDFPurgeSubsetFontCache();
+
 #endif  // SkPDFSubsetFont_DEFINED
@@ -8,7 +8,6 @@
 #include "src/pdf/SkPDFTypes.h"
 
 #include "include/core/SkData.h"
-#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkStreamPriv.h"
@@ -552,7 +551,8 @@ static void serialize_stream(SkPDFDict* origDict,
         stream->getLength() > kMinimumSavings)
     {
         SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData,SkToInt(doc->metadata().fCompressionLevel));
+        SkDeflateWStream deflateWStream(&compressedData,SkToInt(doc->metadata().fCompressionLevel),
+                                        /*gzip=*/false, doc->executor());
         SkStreamCopy(&deflateWStream, stream);
         deflateWStream.finalize();
         #ifdef SK_PDF_BASE85_BINARY
@@ -587,17 +587,15 @@ SkPDFIndirectReference SkPDFStreamOut(std::unique_ptr<SkPDFDict> dict,
                                       SkPDFDocument* doc,
                                       SkPDFSteamCompressionEnabled compress) {
     SkPDFIndirectReference ref = doc->reserveRef();
-    if (SkExecutor* executor = doc->executor()) {
+    if (doc->executor()) {
         SkPDFDict* dictPtr = dict.release();
         SkStreamAsset* contentPtr = content.release();
         // Pass ownership of both pointers into a std::function, which should
         // only be executed once.
-        doc->incrementJobCount();
-        executor->add([dictPtr, contentPtr, compress, doc, ref]() {
+        doc->serializeInOrder([dictPtr, contentPtr, compress, doc, ref]() {
             serialize_stream(dictPtr, contentPtr, compress, doc, ref);
             delete dictPtr;
             delete contentPtr;
-            doc->signalJobComplete();
         });
         return ref;
     }
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAlign.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/chromium/SkDiscardableMemory.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+// Written to the first word of every page while the memory is unlocked. The kernel replaces the
+// pages it reclaims after MADV_FREE with zero-filled ones, so a page whose first word is no longer
+// the cookie was discarded.
+constexpr intptr_t kPageCookie = static_cast<intptr_t>(0x5ce1f7ee);
+
+static_assert(sizeof(std::atomic<intptr_t>) == sizeof(intptr_t));
+
+/**
+ *  Discardable memory backed by a private anonymous mapping. While it is unlocked, its pages are
+ *  marked with MADV_FREE, so the kernel may reclaim them under memory pressure instead of
+ *  swapping them out, without Skia having to purge anything. Pages that aren't reclaimed keep
+ *  their contents, and writing to them cancels the MADV_FREE.
+ *
+ *  This is the scheme that Chromium uses on POSIX: unlock() saves the first word of each page and
+ *  replaces it with kPageCookie, and lock() restores it with a compare-and-swap that fails if the
+ *  page was reclaimed. The CAS is a write, so once it succeeds the page can't be reclaimed anymore.
+ *
+ *  Kernels without MADV_FREE (before Linux 4.5) reject the madvise() call, and the memory then
+ *  just stays resident.
+ */
+class SkDiscardableMemoryMadvise final : public SkDiscardableMemory {
+public:
+    static SkDiscardableMemoryMadvise* Make(size_t bytes) {
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        if (bytes == 0 || bytes > SIZE_MAX - pageSize) {
+            return nullptr;
+        }
+        const size_t mappedBytes = SkAlignTo(bytes, pageSize);
+        void* addr = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            return nullptr;
+        }
+        return new SkDiscardableMemoryMadvise(addr, mappedBytes, pageSize);
+    }
+
+    ~SkDiscardableMemoryMadvise() override {
+        SkASSERT(!fLocked);
+        munmap(fAddr, fMappedBytes);
+    }
+
+    bool lock() override {
+        SkASSERT(!fLocked);
+        if (fDiscarded) {
+            return false;
+        }
+        for (size_t i = 0; i < fPageCount; ++i) {
+            intptr_t expected = kPageCookie;
+            if (!this->pageWord(i)->compare_exchange_strong(expected, fFirstWords[i],
+                                                            std::memory_order_relaxed)) {
+                // The pages restored so far are intact, but the contents as a whole are lost.
+                fDiscarded = true;
+                return false;
+            }
+        }
+        fLocked = true;
+        return true;
+    }
+
+    void* data() override {
+        SkASSERT(fLocked);
+        return fAddr;
+    }
+
+    void unlock() override {
+        SkASSERT(fLocked);
+        for (size_t i = 0; i < fPageCount; ++i) {
+            fFirstWords[i] = this->pageWord(i)->exchange(kPageCookie, std::memory_order_relaxed);
+        }
+#if defined(MADV_FREE)
+        madvise(fAddr, fMappedBytes, MADV_FREE);
+#endif
+        fLocked = false;
+    }
+
+private:
+    SkDiscardableMemoryMadvise(void* addr, size_t mappedBytes, size_t pageSize)
+            : fAddr(addr)
+            , fMappedBytes(mappedBytes)
+            , fPageSize(pageSize)
+            , fPageCount(mappedBytes / pageSize)
+            , fFirstWords(fPageCount) {}
+
+    std::atomic<intptr_t>* pageWord(size_t index) {
+        return reinterpret_cast<std::atomic<intptr_t>*>(static_cast<char*>(fAddr) +
+                                                        index * fPageSize);
+    }
+
+    void* const fAddr;
+    const size_t fMappedBytes;
+    const size_t fPageSize;
+    const size_t fPageCount;
+    skia_private::AutoTMalloc<intptr_t> fFirstWords;  // Valid while unlocked.
+    bool fLocked = true;
+    bool fDiscarded = false;
+};
+
+}  // namespace
+
+SkDiscardableMemory* SkDiscardableMemory::Create(size_t bytes) {
+    return SkDiscardableMemoryMadvise::Make(bytes);
+}
@@ -1713,8 +1713,9 @@ SkTypeface_FreeType::~SkTypeface_FreeType() {
     }
 }
 
-// Just made up, so we don't end up storing 1000s of entries
-constexpr int kMaxC2GCacheCount = 512;
+// Enough for 64 pages of BMP unichars, e.g. a few scripts plus the common CJK ideographs, so the
+// cache isn't kept for a face which has been asked for nearly every unichar it maps.
+constexpr size_t kMaxC2GCacheBytes = 32 * 1024;
 
 void SkTypeface_FreeType::onCharsToGlyphs(const SkUnichar uni[], int count,
                                           SkGlyphID glyphs[]) const {
@@ -1726,13 +1727,7 @@ void SkTypeface_FreeType::onCharsToGlyphs(const SkUnichar uni[], int count,
     {
         // Optimistically use a shared lock.
         SkAutoSharedMutexShared ama(fC2GCacheMutex);
-        for (i = 0; i < count; ++i) {
-            int index = fC2GCache.findGlyphIndex(uni[i]);
-            if (index < 0) {
-                break;
-            }
-            glyphs[i] = SkToU16(index);
-        }
+        i = fC2GCache.findGlyphs(uni, count, glyphs);
         if (i == count) {
             // we're done, no need to access the freetype objects
             return;
@@ -1759,7 +1754,7 @@ void SkTypeface_FreeType::onCharsToGlyphs(const SkUnichar uni[], int count,
         }
     }
 
-    if (fC2GCache.count() > kMaxC2GCacheCount) {
+    if (fC2GCache.bytesUsed() > kMaxC2GCacheBytes) {
         fC2GCache.reset();
     }
 }
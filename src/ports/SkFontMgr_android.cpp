@@ -16,11 +16,13 @@
 #include "include/core/SkString.h"
 #include "include/ports/SkFontMgr_android.h"
 #include "include/private/base/SkFixed.h"
+#include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTDArray.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/base/SkTSearch.h"
 #include "src/core/SkFontDescriptor.h"
+#include "src/core/SkFontFallbackCache.h"
 #include "src/core/SkFontScanner.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkTypefaceCache.h"
@@ -80,9 +82,17 @@ public:
     }
 
     std::unique_ptr<SkStreamAsset> makeStream() const {
+        // Share one mapping of the file, rather than mapping it again for each stream. Its pages
+        // are only read in as FreeType touches them.
+        fMapOnce([this] {
+            fMappedFile = fFile ? SkData::MakeFromFILE(fFile)
+                                : SkData::MakeFromFileName(fPathName.c_str());
+        });
+        if (fMappedFile) {
+            return std::make_unique<SkMemoryStream>(fMappedFile);
+        }
         if (fFile) {
-            sk_sp<SkData> data(SkData::MakeFromFILE(fFile));
-            return data ? std::make_unique<SkMemoryStream>(std::move(data)) : nullptr;
+            return nullptr;
         }
         return SkStream::MakeFromFile(fPathName.c_str());
     }
@@ -126,6 +136,8 @@ public:
     const STArray<4, SkLanguage, true> fLang;
     const FontVariant fVariantStyle;
     SkAutoTCallVProc<FILE, sk_fclose> fFile;
+    mutable SkOnce fMapOnce;
+    mutable sk_sp<SkData> fMappedFile;
 
     using INHERITED = SkTypeface_Android;
 };
@@ -369,6 +381,20 @@ protected:
                                                   const char* bcp47[],
                                                   int bcp47Count,
                                                   SkUnichar character) const override {
+        sk_sp<SkTypeface> typeface;
+        if (fFallbackCache.find(familyName, style, bcp47, bcp47Count, character, &typeface)) {
+            return typeface;
+        }
+        typeface = this->findFallback(familyName, style, bcp47, bcp47Count, character);
+        fFallbackCache.add(familyName, style, bcp47, bcp47Count, character, typeface);
+        return typeface;
+    }
+
+    sk_sp<SkTypeface> findFallback(const char familyName[],
+                                   const SkFontStyle& style,
+                                   const char* bcp47[],
+                                   int bcp47Count,
+                                   SkUnichar character) const {
         // The variant 'elegant' is 'not squashed', 'compact' is 'stays in ascent/descent'.
         // The variant 'default' means 'compact and elegant'.
         // As a result, it is not possible to know the variant context from the font alone.
@@ -447,6 +473,9 @@ private:
     TArray<NameToFamily, true> fNameToFamilyMap;
     TArray<NameToFamily, true> fFallbackNameToFamilyMap;
 
+    // The fallback fonts never change, so the typeface found for a character can be reused.
+    SkFontFallbackCache fFallbackCache;
+
     void addFamily(FontFamily& family, const bool isolated, int familyIndex) {
         TArray<NameToFamily, true>* nameToFamily = &fNameToFamilyMap;
         if (family.fIsFallbackFont) {
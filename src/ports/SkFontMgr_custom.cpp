@@ -65,6 +65,12 @@ SkTypeface_File::SkTypeface_File(const SkFontStyle& style, bool isFixedPitch, bo
 
 std::unique_ptr<SkStreamAsset> SkTypeface_File::onOpenStream(int* ttcIndex) const {
     *ttcIndex = this->getIndex();
+    // Share one mapping of the file, rather than mapping it again for each stream. Its pages
+    // are only read in as FreeType touches them.
+    fMapOnce([this] { fMappedFile = SkData::MakeFromFileName(fPath.c_str()); });
+    if (fMappedFile) {
+        return std::make_unique<SkMemoryStream>(fMappedFile);
+    }
     return SkStream::MakeFromFile(fPath.c_str());
 }
 
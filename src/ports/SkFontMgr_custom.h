@@ -8,11 +8,13 @@
 #ifndef SkFontMgr_custom_DEFINED
 #define SkFontMgr_custom_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTArray.h"
 #include "src/ports/SkTypeface_FreeType.h"
 
@@ -71,6 +73,10 @@ protected:
 private:
     SkString fPath;
 
+    // The file is mapped on the first openStream and the mapping is shared by every stream after.
+    mutable SkOnce fMapOnce;
+    mutable sk_sp<SkData> fMappedFile;
+
     using INHERITED = SkTypeface_Custom;
 };
 
@@ -25,6 +25,7 @@
 #include "src/base/SkTSort.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
 #include "src/core/SkFontDescriptor.h"
+#include "src/core/SkFontFallbackCache.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkTypefaceCache.h"
@@ -657,6 +658,10 @@ class SkFontMgr_fontconfig : public SkFontMgr {
 
     mutable SkMutex fTFCacheMutex;
     mutable SkTypefaceCache fTFCache;
+
+    // Matching a character with FcFontMatch is slow, and fFC doesn't change, so matches are
+    // reused.
+    SkFontFallbackCache fFallbackCache;
     /** Creates a typeface using a typeface cache.
      *  @param pattern a complete pattern from FcFontRenderPrepare.
      */
@@ -665,16 +670,21 @@ class SkFontMgr_fontconfig : public SkFontMgr {
             return nullptr;
         }
         // Cannot hold FCLocker when calling fTFCache.add; an evicted typeface may need to lock.
-        // Must hold fTFCacheMutex when interacting with fTFCache.
-        SkAutoMutexExclusive ama(fTFCacheMutex);
-        sk_sp<SkTypeface> face = [&]() {
+        auto find = [&]() {
             FCLocker lock;
             sk_sp<SkTypeface> face = fTFCache.findByProcAndRef(FindByFcPattern, pattern);
             if (face) {
                 pattern.reset();
             }
             return face;
-        }();
+        };
+        // Searching fTFCache takes no lock. Hold fTFCacheMutex to search again before making and
+        // adding a typeface, so that two threads don't add the same one.
+        if (sk_sp<SkTypeface> face = find()) {
+            return face;
+        }
+        SkAutoMutexExclusive ama(fTFCacheMutex);
+        sk_sp<SkTypeface> face = find();
         if (!face) {
             face = SkTypeface_fontconfig::Make(std::move(pattern), fSysroot);
             if (face) {
@@ -894,6 +904,21 @@ protected:
                                                   const char* bcp47[],
                                                   int bcp47Count,
                                                   SkUnichar character) const override
+    {
+        sk_sp<SkTypeface> typeface;
+        if (fFallbackCache.find(familyName, style, bcp47, bcp47Count, character, &typeface)) {
+            return typeface;
+        }
+        typeface = this->findFallback(familyName, style, bcp47, bcp47Count, character);
+        fFallbackCache.add(familyName, style, bcp47, bcp47Count, character, typeface);
+        return typeface;
+    }
+
+    sk_sp<SkTypeface> findFallback(const char familyName[],
+                                   const SkFontStyle& style,
+                                   const char* bcp47[],
+                                   int bcp47Count,
+                                   SkUnichar character) const
     {
         SkAutoFcPattern font([&](){
             FCLocker lock;
@@ -294,8 +294,13 @@ sk_sp<SkTypeface> SkFontMgr_DirectWrite::makeTypefaceFromDWriteFont(
         IDWriteFontFace* fontFace,
         IDWriteFont* font,
         IDWriteFontFamily* fontFamily) const {
-    SkAutoMutexExclusive ama(fTFCacheMutex);
     ProtoDWriteTypeface spec = { fontFace, font, fontFamily };
+    // Searching fTFCache takes no lock. Hold fTFCacheMutex to search again before making and
+    // adding a typeface, so that two threads don't add the same one.
+    if (sk_sp<SkTypeface> face = fTFCache.findByProcAndRef(FindByDWriteFont, &spec)) {
+        return face;
+    }
+    SkAutoMutexExclusive ama(fTFCacheMutex);
     sk_sp<SkTypeface> face = fTFCache.findByProcAndRef(FindByDWriteFont, &spec);
     if (nullptr == face) {
         face = DWriteFontTypeface::Make(fFactory.get(), fontFace, font, fontFamily, nullptr,
@@ -14,6 +14,14 @@
 #include <android/data_space.h>
 #include <android/imagedecoder.h>
 
+#if defined(SK_GANESH)
+#include "include/android/SkImageAndroid.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+
+#include <android/hardware_buffer.h>
+#endif
+
 namespace {
 class ImageGeneratorNDK : public SkImageGenerator {
 public:
@@ -220,3 +228,89 @@ bool ImageGeneratorNDK::onGetPixels(const SkImageInfo& info, void* pixels, size_
 sk_sp<SkData> ImageGeneratorNDK::onRefEncodedData() {
     return fData;
 }
+
+#if defined(SK_GANESH)
+
+// The AHardwareBuffer format to decode a color type into, or 0 if there isn't one.
+static uint32_t buffer_format(SkColorType ct) {
+    switch (ct) {
+        case kRGBA_8888_SkColorType: return AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+        case kRGBA_F16_SkColorType:  return AHARDWAREBUFFER_FORMAT_R16G16B16A16_FLOAT;
+        case kRGB_565_SkColorType:   return AHARDWAREBUFFER_FORMAT_R5G6B5_UNORM;
+        default:                     return 0;
+    }
+}
+
+sk_sp<SkImage> SkImageGeneratorNDK::DecodeToHardwareBufferImage(sk_sp<SkData> data) {
+    if (!data) return nullptr;
+
+    AImageDecoder* decoder;
+    if (!ok(AImageDecoder_createFromBuffer(data->data(), data->size(), &decoder))) {
+        return nullptr;
+    }
+    std::unique_ptr<AImageDecoder, decltype(&AImageDecoder_delete)> autoDecoder(
+            decoder, AImageDecoder_delete);
+
+    const AImageDecoderHeaderInfo* headerInfo = AImageDecoder_getHeaderInfo(decoder);
+    int32_t width  = AImageDecoderHeaderInfo_getWidth(headerInfo);
+    int32_t height = AImageDecoderHeaderInfo_getHeight(headerInfo);
+    // Unlike MakeFromEncodedNDK, don't pick gray: there's no widely supported 8 bit buffer format
+    // that samples as gray, so gray images decode to RGBA.
+    auto format = static_cast<AndroidBitmapFormat>(
+            AImageDecoderHeaderInfo_getAndroidBitmapFormat(headerInfo));
+    SkColorType ct = SkNDKConversions::toColorType(format);
+    if (!buffer_format(ct) || !set_android_bitmap_format(decoder, ct)) {
+        ct = kRGBA_8888_SkColorType;
+        if (!set_android_bitmap_format(decoder, ct)) {
+            return nullptr;
+        }
+    }
+    SkAlphaType at = AImageDecoderHeaderInfo_getAlphaFlags(headerInfo)
+            == ANDROID_BITMAP_FLAGS_ALPHA_OPAQUE ? kOpaque_SkAlphaType : kPremul_SkAlphaType;
+
+    AHardwareBuffer_Desc desc = {};
+    desc.width = width;
+    desc.height = height;
+    desc.layers = 1;
+    desc.format = buffer_format(ct);
+    desc.usage = AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN | AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE;
+    AHardwareBuffer* buffer;
+    if (AHardwareBuffer_allocate(&desc, &buffer) != 0) {
+        return nullptr;
+    }
+    // The image takes its own reference.
+    std::unique_ptr<AHardwareBuffer, decltype(&AHardwareBuffer_release)> autoBuffer(
+            buffer, AHardwareBuffer_release);
+    AHardwareBuffer_describe(buffer, &desc);
+
+    void* pixels;
+    if (AHardwareBuffer_lock(buffer, AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN, -1, nullptr,
+                             &pixels) != 0) {
+        return nullptr;
+    }
+    size_t rowBytes = desc.stride * SkColorTypeBytesPerPixel(ct);
+    int result = AImageDecoder_decodeImage(decoder, pixels, rowBytes, rowBytes * height);
+    if (AHardwareBuffer_unlock(buffer, nullptr) != 0) {
+        return nullptr;
+    }
+    switch (result) {
+        case ANDROID_IMAGE_DECODER_INCOMPLETE:
+        case ANDROID_IMAGE_DECODER_ERROR:
+            // As in onGetPixels, a partial image is still returned.
+        case ANDROID_IMAGE_DECODER_SUCCESS:
+            break;
+        default:
+            return nullptr;
+    }
+    return SkImages::DeferredFromAHardwareBuffer(buffer, at, get_default_colorSpace(headerInfo));
+}
+
+void SkImageGeneratorNDK::DecodeToHardwareBufferImageAsync(
+        sk_sp<SkData> data, SkExecutor* executor, std::function<void(sk_sp<SkImage>)> done) {
+    SkASSERT(executor);
+    executor->add([data = std::move(data), done = std::move(done)]() mutable {
+        done(DecodeToHardwareBufferImage(std::move(data)));
+    });
+}
+
+#endif  // defined(SK_GANESH)
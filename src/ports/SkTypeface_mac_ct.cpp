@@ -252,6 +252,11 @@ sk_sp<SkTypeface> SkTypeface_Mac::Make(SkUniqueCFRef<CTFontRef> font,
         return makeTypeface();
     }
 
+    // Searching gTFCache takes no lock. Hold gTFCacheMutex to search again before making and
+    // adding a typeface, so that two threads don't add the same one.
+    if (sk_sp<SkTypeface> face = gTFCache.findByProcAndRef(find_by_CTFontRef, (void*)font.get())) {
+        return face;
+    }
     SkAutoMutexExclusive ama(gTFCacheMutex);
     sk_sp<SkTypeface> face = gTFCache.findByProcAndRef(find_by_CTFontRef, (void*)font.get());
     if (!face) {
@@ -12,15 +12,19 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
 #include "include/effects/SkRuntimeEffect.h"
 #include "include/private/SkGainmapInfo.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkColorFilterPriv.h"
 #include "src/core/SkImageInfoPriv.h"
 
+#include <algorithm>
 #include <cstdint>
 
 static constexpr char gGainmapSKSL[] =
@@ -78,6 +82,24 @@ static bool all_channels_equal(const SkColor4f& c) {
     return c.fR == c.fG && c.fR == c.fB;
 }
 
+// The weight W from SkGainmapInfo, less one if the base image is the HDR rendition.
+static float compute_weight(const SkGainmapInfo& gainmapInfo, float dstHdrRatio) {
+    float W = 0.f;
+    if (dstHdrRatio > gainmapInfo.fDisplayRatioSdr) {
+        if (dstHdrRatio < gainmapInfo.fDisplayRatioHdr) {
+            W = (sk_float_log(dstHdrRatio) - sk_float_log(gainmapInfo.fDisplayRatioSdr)) /
+                (sk_float_log(gainmapInfo.fDisplayRatioHdr) -
+                 sk_float_log(gainmapInfo.fDisplayRatioSdr));
+        } else {
+            W = 1.f;
+        }
+    }
+    if (gainmapInfo.fBaseImageType == SkGainmapInfo::BaseImageType::kHDR) {
+        W -= 1.f;
+    }
+    return W;
+}
+
 sk_sp<SkShader> SkGainmapShader::Make(const sk_sp<const SkImage>& baseImage,
                                       const SkRect& baseRect,
                                       const SkSamplingOptions& baseSamplingOptions,
@@ -105,21 +127,8 @@ sk_sp<SkShader> SkGainmapShader::Make(const sk_sp<const SkImage>& baseImage,
     const SkMatrix gainmapRectToDstRect = SkMatrix::RectToRect(gainmapRect, dstRect);
 
     // Compute the weight parameter that will be used to blend between the images.
-    float W = 0.f;
-    if (dstHdrRatio > gainmapInfo.fDisplayRatioSdr) {
-        if (dstHdrRatio < gainmapInfo.fDisplayRatioHdr) {
-            W = (sk_float_log(dstHdrRatio) - sk_float_log(gainmapInfo.fDisplayRatioSdr)) /
-                (sk_float_log(gainmapInfo.fDisplayRatioHdr) -
-                 sk_float_log(gainmapInfo.fDisplayRatioSdr));
-        } else {
-            W = 1.f;
-        }
-    }
-
+    const float W = compute_weight(gainmapInfo, dstHdrRatio);
     const bool baseImageIsHdr = (gainmapInfo.fBaseImageType == SkGainmapInfo::BaseImageType::kHDR);
-    if (baseImageIsHdr) {
-        W -= 1.f;
-    }
 
     // Return the base image directly if the gainmap will not be applied at all.
     if (W == 0.f) {
@@ -192,3 +201,147 @@ sk_sp<SkShader> SkGainmapShader::Make(const sk_sp<const SkImage>& baseImage,
     // Return a shader that will apply the gainmap and then convert to the destination color space.
     return gainmapMathShader->makeWithColorFilter(colorXformGainmapToDst);
 }
+
+// The same approximations SkRasterPipeline uses to evaluate pow() and exp().
+static skvx::float4 approx_log2(skvx::float4 x) {
+    skvx::float4 e = skvx::cast<float>(sk_bit_cast<skvx::uint4>(x)) * (1.0f / (1 << 23));
+    skvx::float4 m = sk_bit_cast<skvx::float4>((sk_bit_cast<skvx::uint4>(x) & 0x007fffff) |
+                                               0x3f000000);
+    return e - 124.225514990f - 1.498030302f * m - 1.725879990f / (0.3520887068f + m);
+}
+
+static skvx::float4 approx_pow2(skvx::float4 x) {
+    constexpr float kInfinityBits = 0x7f800000;
+    skvx::float4 f = x - skvx::floor(x);
+    skvx::float4 approx = x + 121.274057500f - f * 1.490129070f + 27.728023300f / (4.84252568f - f);
+    approx = skvx::pin(approx * (1.0f * (1 << 23)), skvx::float4(0), skvx::float4(kInfinityBits));
+    return sk_bit_cast<skvx::float4>(skvx::cast<uint32_t>(approx + 0.5f));
+}
+
+static skvx::float4 mix(skvx::float4 a, skvx::float4 b, float t) { return a + (b - a) * t; }
+
+bool SkGainmapShader::ApplyToPixmap(const SkPixmap& base,
+                                    const SkPixmap& gainmap,
+                                    const SkGainmapInfo& gainmapInfo,
+                                    float dstHdrRatio,
+                                    const SkPixmap& dst) {
+    if (base.dimensions() != dst.dimensions() || dst.dimensions().isEmpty() ||
+        gainmap.dimensions().isEmpty()) {
+        return false;
+    }
+    const int width = dst.width(), gainmapWidth = gainmap.width();
+    const float W = compute_weight(gainmapInfo, dstHdrRatio);
+
+    sk_sp<SkColorSpace> baseColorSpace =
+            base.colorSpace() ? base.refColorSpace() : SkColorSpace::MakeSRGB();
+    sk_sp<SkColorSpace> gainmapMathColorSpace =
+            gainmapInfo.fGainmapMathColorSpace
+                    ? gainmapInfo.fGainmapMathColorSpace->makeLinearGamma()
+                    : baseColorSpace->makeLinearGamma();
+
+    // Rows are converted to and from unpremul F32 in the gainmap math color space by
+    // readPixels(). The gainmap is read raw, ignoring any color space it has.
+    const SkImageInfo mathRowInfo = SkImageInfo::Make(
+            width, 1, kRGBA_F32_SkColorType, kUnpremul_SkAlphaType, gainmapMathColorSpace);
+    const SkImageInfo gainmapRowInfo = SkImageInfo::Make(
+            gainmapWidth, 1, kRGBA_F32_SkColorType, kUnpremul_SkAlphaType, nullptr);
+    const SkPixmap rawGainmap(gainmap.info().makeColorSpace(nullptr), gainmap.addr(),
+                              gainmap.rowBytes());
+    const SkPixmap baseInMath(base.info().makeColorSpace(baseColorSpace), base.addr(),
+                              base.rowBytes());
+
+    skia_private::AutoTMalloc<skvx::float4> row(width),
+                                            gainmapRows(2 * gainmapWidth);
+    skvx::float4* gainmapRow[2] = {gainmapRows.get(), gainmapRows.get() + gainmapWidth};
+    int gainmapRowY[2] = {-1, -1};
+
+    // Horizontal linear filtering of the gainmap, stretched to dst's width.
+    skia_private::AutoTMalloc<int> gx0(width), gx1(width);
+    skia_private::AutoTMalloc<float> gfx(width);
+    const float scaleX = gainmapWidth / (float)width;
+    for (int x = 0; x < width; ++x) {
+        float gx = std::clamp((x + 0.5f) * scaleX - 0.5f, 0.f, gainmapWidth - 1.f);
+        gx0[x] = (int)gx;
+        gx1[x] = std::min(gx0[x] + 1, gainmapWidth - 1);
+        gfx[x] = gx - gx0[x];
+    }
+
+    const uint32_t channelFlags = SkColorTypeChannelFlags(gainmap.colorType());
+    const bool gainmapIsAlpha = channelFlags == kAlpha_SkColorChannelFlag;
+    const bool gainmapIsRed = channelFlags == kRed_SkColorChannelFlag;
+    const bool noGamma = gainmapInfo.fGainmapGamma.fR == 1.f &&
+                         gainmapInfo.fGainmapGamma.fG == 1.f &&
+                         gainmapInfo.fGainmapGamma.fB == 1.f;
+    const bool baseImageIsHdr = gainmapInfo.fBaseImageType == SkGainmapInfo::BaseImageType::kHDR;
+    const SkColor4f& epsilonBase =
+            baseImageIsHdr ? gainmapInfo.fEpsilonHdr : gainmapInfo.fEpsilonSdr;
+    const SkColor4f& epsilonOther =
+            baseImageIsHdr ? gainmapInfo.fEpsilonSdr : gainmapInfo.fEpsilonHdr;
+
+    // exp(L * W) = 2^(mix(log2(min), log2(max), G) * W); fold W into the endpoints. Alpha gets
+    // a log2 gain of 0, and the epsilons 0, so it passes through.
+    const SkColor4f& ratioMin = gainmapInfo.fGainmapRatioMin;
+    const SkColor4f& ratioMax = gainmapInfo.fGainmapRatioMax;
+    const skvx::float4 log2Lo = skvx::float4{sk_float_log2(ratioMin.fR),
+                                             sk_float_log2(ratioMin.fG),
+                                             sk_float_log2(ratioMin.fB), 0} * W;
+    const skvx::float4 log2Span = skvx::float4{sk_float_log2(ratioMax.fR),
+                                               sk_float_log2(ratioMax.fG),
+                                               sk_float_log2(ratioMax.fB), 0} * W - log2Lo;
+    const skvx::float4 gamma = skvx::float4::Load(gainmapInfo.fGainmapGamma.vec());
+    const skvx::float4 epsBase = {epsilonBase.fR, epsilonBase.fG, epsilonBase.fB, 0},
+                       epsOther = {epsilonOther.fR, epsilonOther.fG, epsilonOther.fB, 0};
+
+    auto readGainmapRow = [&](int slot, int y) {
+        if (gainmapRowY[slot] == y) {
+            return true;
+        }
+        if (!rawGainmap.readPixels(gainmapRowInfo, gainmapRow[slot], gainmapRowInfo.minRowBytes(),
+                                   0, y)) {
+            return false;
+        }
+        for (int x = 0; x < gainmapWidth; ++x) {
+            skvx::float4& g = gainmapRow[slot][x];
+            if (gainmapIsAlpha) {
+                g = skvx::float4(g[3]);
+            } else if (gainmapIsRed) {
+                g = skvx::float4(g[0]);
+            }
+            g = skvx::pin(g, skvx::float4(0), skvx::float4(1));
+            if (!noGamma) {
+                g = skvx::if_then_else(g == 0, g, approx_pow2(approx_log2(g) * gamma));
+            }
+        }
+        gainmapRowY[slot] = y;
+        return true;
+    };
+
+    const float scaleY = gainmap.height() / (float)dst.height();
+    for (int y = 0; y < dst.height(); ++y) {
+        if (!baseInMath.readPixels(mathRowInfo, row.get(), mathRowInfo.minRowBytes(), 0, y)) {
+            return false;
+        }
+        if (W != 0.f) {
+            float gy = std::clamp((y + 0.5f) * scaleY - 0.5f, 0.f, gainmap.height() - 1.f);
+            int gy0 = (int)gy, gy1 = std::min(gy0 + 1, gainmap.height() - 1);
+            float fy = gy - gy0;
+            if (!readGainmapRow(gy0 & 1, gy0) || !readGainmapRow(gy1 & 1, gy1)) {
+                return false;
+            }
+            const skvx::float4* g0 = gainmapRow[gy0 & 1];
+            const skvx::float4* g1 = gainmapRow[gy1 & 1];
+            for (int x = 0; x < width; ++x) {
+                skvx::float4 top = mix(g0[gx0[x]], g0[gx1[x]], gfx[x]),
+                             bot = mix(g1[gx0[x]], g1[gx1[x]], gfx[x]);
+                skvx::float4 G = mix(top, bot, fy);
+                row[x] = (row[x] + epsBase) * approx_pow2(log2Lo + log2Span * G) - epsOther;
+            }
+        }
+        const SkPixmap mathRow(mathRowInfo, row.get(), mathRowInfo.minRowBytes());
+        if (!mathRow.readPixels(dst.info().makeWH(width, 1), dst.writable_addr(0, y),
+                                dst.rowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -182,7 +182,8 @@ SkPictureShader::CachedImageInfo SkPictureShader::CachedImageInfo::Make(
         SkColorType dstColorType,
         SkColorSpace* dstColorSpace,
         const int maxTextureSize,
-        const SkSurfaceProps& propsIn) {
+        const SkSurfaceProps& propsIn,
+        bool snapScaleToPow2) {
     SkSurfaceProps props = propsIn.cloneWithPixelGeometry(kUnknown_SkPixelGeometry);
 
     const SkSize scaledSize = [&]() {
@@ -197,6 +198,13 @@ SkPictureShader::CachedImageInfo SkPictureShader::CachedImageInfo::Make(
                 size.fWidth = size.fHeight = SkScalarSqrt(area);
             }
         }
+        if (snapScaleToPow2) {
+            auto snap = [](SkScalar scale) {
+                return scale > 0 ? SkScalarPow(2, SkScalarCeilToScalar(SkScalarLog2(scale)))
+                                 : scale;
+            };
+            size.set(snap(size.width()), snap(size.height()));
+        }
         size.fWidth *= bounds.width();
         size.fHeight *= bounds.height();
 
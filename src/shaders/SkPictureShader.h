@@ -59,12 +59,16 @@ public:
         SkImageInfo imageInfo;
         SkSurfaceProps props;
 
+        // If 'snapScaleToPow2' is true, the tile is rendered at the next power-of-two scale at or
+        // above the one 'totalM' requires, so that every scale within an octave maps to the same
+        // tile (and cache entry), at the cost of minifying it when sampled.
         static CachedImageInfo Make(const SkRect& bounds,
                                     const SkMatrix& totalM,
                                     SkColorType dstColorType,
                                     SkColorSpace* dstColorSpace,
                                     const int maxTextureSize,
-                                    const SkSurfaceProps& propsIn);
+                                    const SkSurfaceProps& propsIn,
+                                    bool snapScaleToPow2 = false);
 
         sk_sp<SkImage> makeImage(sk_sp<SkSurface> surf, const SkPicture* pict) const;
     };
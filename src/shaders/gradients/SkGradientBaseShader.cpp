@@ -23,6 +23,7 @@
 #include "include/private/base/SkTPin.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkMathPriv.h"
 #include "src/base/SkVx.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
@@ -366,7 +367,10 @@ void SkGradientBaseShader::AppendGradientFillStages(SkRasterPipeline* p,
         } else {
             // Handle arbitrary stops.
 
-            ctx->ts = alloc->makeArray<float>(count + 1);
+            // The stage's binary search probes up to twice the largest power of two below the
+            // stop count; see SkRasterPipeline_GradientCtx.
+            const int tsCount = std::max(count + 1, 2 * SkPrevPow2(count));
+            ctx->ts = alloc->makeArray<float>(tsCount);
 
             // Remove the default stops inserted by SkGradientBaseShader::SkGradientBaseShader
             // because they are naturally handled by the search method.
@@ -402,6 +406,7 @@ void SkGradientBaseShader::AppendGradientFillStages(SkRasterPipeline* p,
 
             ctx->ts[stopCount] = t_l;
             add_const_color(ctx, stopCount++, c_l);
+            std::fill(ctx->ts + stopCount, ctx->ts + tsCount, SK_FloatNaN);
 
             ctx->stopCount = stopCount;
             p->append(SkRasterPipelineOp::gradient, ctx);
@@ -23,6 +23,7 @@
 #include "src/sksl/ir/SkSLSymbolTable.h"  // IWYU pragma: keep
 #include "src/sksl/transform/SkSLTransform.h"
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <utility>
@@ -208,6 +209,7 @@ std::unique_ptr<Program> Compiler::convertProgram(ProgramKind kind,
                                                   std::string programSource,
                                                   const ProgramSettings& settings) {
     TRACE_EVENT0("skia.shaders", "SkSL::Compiler::convertProgram");
+    fLastOptimizeTime = std::chrono::nanoseconds(0);
 
     // Wrap the program source in a pointer so it is guaranteed to be stable across moves.
     auto sourcePtr = std::make_unique<std::string>(std::move(programSource));
@@ -236,8 +238,15 @@ std::unique_ptr<SkSL::Program> Compiler::releaseProgram(
                                                   std::move(fPool));
     fContext->fSymbolTable = nullptr;
 
-    bool success = this->finalize(*result) &&
-                   this->optimize(*result);
+    bool success;
+    {
+        TRACE_EVENT0("skia.shaders", "SkSL::Compiler::optimize");
+        auto start = std::chrono::steady_clock::now();
+        success = this->finalize(*result) &&
+                  this->optimize(*result);
+        fLastOptimizeTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start);
+    }
     if (pool) {
         pool->detachFromThread();
     }
@@ -351,6 +360,7 @@ bool Compiler::optimize(Program& program) {
         while (Transform::EliminateDeadLocalVariables(program)) {
             // Removing dead variables may cause more variables to become unreferenced. Try again.
         }
+
         while (Transform::EliminateDeadGlobalVariables(program)) {
             // Repeat until no changes occur.
         }
@@ -373,6 +383,28 @@ void Compiler::runInliner(Program& program) {
 #endif
 }
 
+void Compiler::runRasterPipelineOptimizations(Program& program) {
+    if (!program.fConfig->fSettings.fOptimize) {
+        return;
+    }
+
+    // The passes build new IR with the program's own context, whose error reporter may have gone
+    // away along with the compiler that created the program.
+    Context& context = *program.fContext;
+    ErrorReporter* oldErrors = context.fErrors;
+    context.setErrorReporter(&this->errorReporter());
+    {
+        AutoProgramConfig autoConfig(context, program.fConfig.get());
+        AutoAttachPoolToThread attach(program.fPool.get());
+        Transform::EliminateCommonSubexpressions(program);
+        Transform::HoistLoopInvariants(program);
+    }
+    context.setErrorReporter(oldErrors);
+
+    // Make sure that program usage is still correct after the optimization pass is complete.
+    SkASSERT(*program.usage() == *Analysis::GetUsage(program));
+}
+
 bool Compiler::runInliner(Inliner* inliner,
                           const std::vector<std::unique_ptr<ProgramElement>>& elements,
                           SymbolTable* symbols,
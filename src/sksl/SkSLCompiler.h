@@ -17,6 +17,7 @@
 #include "src/sksl/ir/SkSLSymbolTable.h"
 
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -125,6 +126,12 @@ public:
                                             std::string programSource,
                                             const ProgramSettings& settings);
 
+    /**
+     * The time the last convertProgram() spent in finalize() and optimize(), after the program was
+     * parsed. Zero if parsing failed.
+     */
+    std::chrono::nanoseconds lastOptimizeTime() const { return fLastOptimizeTime; }
+
     void handleError(std::string_view msg, Position pos);
 
     std::string errorText(bool showCount = true);
@@ -166,6 +173,13 @@ public:
     /** Run the inliner on a program which was compiled earlier (with inlining turned off). */
     void runInliner(Program& program);
 
+    /**
+     * Shares repeated subexpressions and hoists loop invariants in a program which is about to be
+     * converted for the Raster Pipeline, which evaluates the program exactly as written. GPU
+     * drivers run their own optimizers, so this is not part of the regular optimization pass.
+     */
+    void runRasterPipelineOptimizations(Program& program);
+
 private:
     class CompilerErrorReporter : public ErrorReporter {
     public:
@@ -223,6 +237,7 @@ private:
     std::unique_ptr<Pool> fPool;
 
     std::string fErrorText;
+    std::chrono::nanoseconds fLastOptimizeTime{0};
 
     static OverrideFlag sOptimizer;
     static OverrideFlag sInliner;
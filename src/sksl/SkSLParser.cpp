@@ -1096,6 +1096,7 @@ SkSL::Layout Parser::layout() {
             {"local_size_x",                SkSL::LayoutFlag::kLocalSizeX},
             {"local_size_y",                SkSL::LayoutFlag::kLocalSizeY},
             {"local_size_z",                SkSL::LayoutFlag::kLocalSizeZ},
+            {"std140",                      SkSL::LayoutFlag::kStd140},
     });
 
     Layout result;
@@ -219,7 +219,64 @@ void Builder::unary_op(BuilderOp op, int32_t slots) {
     }
 }
 
+static bool is_commutative_op(BuilderOp op) {
+    switch (op) {
+        case BuilderOp::add_n_floats:
+        case BuilderOp::add_n_ints:
+        case BuilderOp::mul_n_floats:
+        case BuilderOp::mul_n_ints:
+        case BuilderOp::bitwise_and_n_ints:
+        case BuilderOp::bitwise_xor_n_ints:
+        case BuilderOp::cmpeq_n_floats:
+        case BuilderOp::cmpeq_n_ints:
+        case BuilderOp::cmpne_n_floats:
+        case BuilderOp::cmpne_n_ints:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool Builder::simplifyCommutativeConstantOp(BuilderOp op, int32_t slots) {
+    // If we detect a pattern of 'push constant, push slots, commutative op', the operands can be
+    // swapped so that the constant becomes an immediate. The push of the other operand must not
+    // depend on the stack layout, since it's about to move down.
+    Instruction* pushInstruction  = this->lastInstruction(/*fromBack=*/0);
+    Instruction* constInstruction = this->lastInstruction(/*fromBack=*/1);
+    if (!pushInstruction || !constInstruction || !is_commutative_op(op)) {
+        return false;
+    }
+    if (constInstruction->fOp != BuilderOp::push_constant || constInstruction->fImmA < slots) {
+        return false;
+    }
+    if ((pushInstruction->fOp != BuilderOp::push_slots &&
+         pushInstruction->fOp != BuilderOp::push_immutable &&
+         pushInstruction->fOp != BuilderOp::push_uniform) ||
+        pushInstruction->fImmA != slots) {
+        return false;
+    }
+    int32_t constantValue = constInstruction->fImmB;
+    BuilderOp immOp = convert_n_way_op_to_immediate(op, slots, &constantValue);
+    if (immOp == op) {
+        return false;
+    }
+    // Remove the constants from the stack; if none are left, the push goes away entirely. The push
+    // of the other operand is the last instruction, so it moves into the constant's place.
+    constInstruction->fImmA -= slots;
+    if (constInstruction->fImmA == 0) {
+        fInstructions.removeShuffle(fInstructions.size() - 2);
+    }
+    this->appendInstruction(immOp, {}, slots, constantValue);
+    return true;
+}
+
 void Builder::binary_op(BuilderOp op, int32_t slots) {
+    // If the constant was pushed first, we may be able to swap it with the other operand.
+    if (this->simplifyCommutativeConstantOp(op, slots)) {
+        return;
+    }
+
     if (Instruction* lastInstruction = this->lastInstruction()) {
         // If we just pushed or splatted a constant onto the stack...
         if (lastInstruction->fOp == BuilderOp::push_constant &&
@@ -742,6 +742,7 @@ private:
     Instruction* lastInstructionOnAnyStack(int fromBack = 0);
     void simplifyPopSlotsUnmasked(SlotRange* dst);
     bool simplifyImmediateUnmaskedOp();
+    bool simplifyCommutativeConstantOp(BuilderOp op, int32_t slots);
 
     skia_private::TArray<Instruction> fInstructions;
     int fNumLabels = 0;
@@ -76,6 +76,9 @@ std::string Layout::paddedDescription() const {
     if (fFlags & LayoutFlag::kPushConstant) {
         result += separator() + "push_constant";
     }
+    if (fFlags & LayoutFlag::kStd140) {
+        result += separator() + "std140";
+    }
     if (fFlags & LayoutFlag::kColor) {
         result += separator() + "color";
     }
@@ -129,6 +132,7 @@ bool Layout::checkPermittedLayout(const Context& context,
         { LayoutFlag::kLocalSizeX,               "local_size_x"},
         { LayoutFlag::kLocalSizeY,               "local_size_y"},
         { LayoutFlag::kLocalSizeZ,               "local_size_z"},
+        { LayoutFlag::kStd140,                   "std140"},
     };
 
     bool success = true;
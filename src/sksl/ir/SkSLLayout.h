@@ -57,6 +57,9 @@ enum class LayoutFlag : int {
     kLocalSizeX                 = 1 << 20,
     kLocalSizeY                 = 1 << 21,
     kLocalSizeZ                 = 1 << 22,
+
+    // Requests the std140 memory layout for a uniform interface block in GLSL.
+    kStd140                     = 1 << 23,
 };
 
 }  // namespace SkSL
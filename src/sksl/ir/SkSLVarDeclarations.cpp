@@ -273,6 +273,10 @@ void VarDeclaration::ErrorCheck(const Context& context,
         permittedLayoutFlags &= ~LayoutFlag::kSet;
         permittedLayoutFlags &= ~LayoutFlag::kAllBackends;
     }
+    // The `std140` block layout only applies to interface blocks.
+    if (!baseType->isInterfaceBlock()) {
+        permittedLayoutFlags &= ~LayoutFlag::kStd140;
+    }
     if (ProgramConfig::IsRuntimeEffect(context.fConfig->fKind)) {
         // Disallow all layout flags except 'color' in runtime effects
         permittedLayoutFlags &= LayoutFlag::kColor;
@@ -0,0 +1,520 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkTArray.h"
+#include "src/sksl/SkSLAnalysis.h"
+#include "src/sksl/SkSLContext.h"
+#include "src/sksl/SkSLDefines.h"
+#include "src/sksl/SkSLMangler.h"
+#include "src/sksl/SkSLOperator.h"
+#include "src/sksl/SkSLProgramSettings.h"
+#include "src/sksl/analysis/SkSLProgramUsage.h"
+#include "src/sksl/analysis/SkSLProgramVisitor.h"
+#include "src/sksl/ir/SkSLBinaryExpression.h"
+#include "src/sksl/ir/SkSLBlock.h"
+#include "src/sksl/ir/SkSLChildCall.h"
+#include "src/sksl/ir/SkSLConstructor.h"
+#include "src/sksl/ir/SkSLExpression.h"
+#include "src/sksl/ir/SkSLExpressionStatement.h"
+#include "src/sksl/ir/SkSLFieldAccess.h"
+#include "src/sksl/ir/SkSLFunctionCall.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
+#include "src/sksl/ir/SkSLIRNode.h"
+#include "src/sksl/ir/SkSLIndexExpression.h"
+#include "src/sksl/ir/SkSLLiteral.h"
+#include "src/sksl/ir/SkSLPrefixExpression.h"
+#include "src/sksl/ir/SkSLProgram.h"
+#include "src/sksl/ir/SkSLReturnStatement.h"
+#include "src/sksl/ir/SkSLStatement.h"
+#include "src/sksl/ir/SkSLSwizzle.h"
+#include "src/sksl/ir/SkSLSymbolTable.h"
+#include "src/sksl/ir/SkSLTernaryExpression.h"
+#include "src/sksl/ir/SkSLType.h"
+#include "src/sksl/ir/SkSLVarDeclarations.h"
+#include "src/sksl/ir/SkSLVariable.h"
+#include "src/sksl/ir/SkSLVariableReference.h"
+#include "src/sksl/transform/SkSLProgramWriter.h"
+#include "src/sksl/transform/SkSLTransform.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace skia_private;
+
+namespace SkSL {
+
+// Replacing an expression with a scratch variable costs a copy, so an expression must perform at
+// least this much work before it is worth sharing.
+static constexpr int kMinSharedWeight = 2;
+
+// Bounds the number of rescans of a single block, since each one is quadratic in the number of
+// candidate subexpressions.
+static constexpr int kMaxReplacementsPerBlock = 32;
+
+// Estimates how much work an expression performs. Calls count double, since they usually stand for
+// several instructions.
+static int expression_weight(const Expression& expr) {
+    class WeightVisitor : public ProgramVisitor {
+    public:
+        bool visitExpression(const Expression& e) override {
+            switch (e.kind()) {
+                case Expression::Kind::kBinary:
+                case Expression::Kind::kPrefix:
+                case Expression::Kind::kTernary:
+                    fWeight += 1;
+                    break;
+
+                case Expression::Kind::kChildCall:
+                case Expression::Kind::kFunctionCall:
+                    fWeight += 2;
+                    break;
+
+                default:
+                    break;
+            }
+            return INHERITED::visitExpression(e);
+        }
+
+        int fWeight = 0;
+        using INHERITED = ProgramVisitor;
+    };
+
+    WeightVisitor visitor;
+    visitor.visitExpression(expr);
+    return visitor.fWeight;
+}
+
+// Like Analysis::IsSameExpressionTree, but also matches operators and calls. Both expressions are
+// known to be free of side effects.
+static bool is_same_expression(const Expression& left, const Expression& right) {
+    if (left.kind() != right.kind() || !left.type().matches(right.type())) {
+        return false;
+    }
+    auto sameArguments = [](const ExpressionArray& a, const ExpressionArray& b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (int index = 0; index < a.size(); ++index) {
+            if (!is_same_expression(*a[index], *b[index])) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    switch (left.kind()) {
+        case Expression::Kind::kLiteral:
+            return left.as<Literal>().value() == right.as<Literal>().value();
+
+        case Expression::Kind::kConstructorArray:
+        case Expression::Kind::kConstructorArrayCast:
+        case Expression::Kind::kConstructorCompound:
+        case Expression::Kind::kConstructorCompoundCast:
+        case Expression::Kind::kConstructorDiagonalMatrix:
+        case Expression::Kind::kConstructorMatrixResize:
+        case Expression::Kind::kConstructorScalarCast:
+        case Expression::Kind::kConstructorStruct:
+        case Expression::Kind::kConstructorSplat: {
+            const auto leftSpan = left.asAnyConstructor().argumentSpan();
+            const auto rightSpan = right.asAnyConstructor().argumentSpan();
+            if (leftSpan.size() != rightSpan.size()) {
+                return false;
+            }
+            for (size_t index = 0; index < leftSpan.size(); ++index) {
+                if (!is_same_expression(*leftSpan[index], *rightSpan[index])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case Expression::Kind::kBinary: {
+            const BinaryExpression& l = left.as<BinaryExpression>();
+            const BinaryExpression& r = right.as<BinaryExpression>();
+            return l.getOperator().kind() == r.getOperator().kind() &&
+                   is_same_expression(*l.left(), *r.left()) &&
+                   is_same_expression(*l.right(), *r.right());
+        }
+        case Expression::Kind::kChildCall:
+            return &left.as<ChildCall>().child() == &right.as<ChildCall>().child() &&
+                   sameArguments(left.as<ChildCall>().arguments(),
+                                 right.as<ChildCall>().arguments());
+
+        case Expression::Kind::kFieldAccess:
+            return left.as<FieldAccess>().fieldIndex() == right.as<FieldAccess>().fieldIndex() &&
+                   is_same_expression(*left.as<FieldAccess>().base(),
+                                      *right.as<FieldAccess>().base());
+
+        case Expression::Kind::kFunctionCall:
+            return &left.as<FunctionCall>().function() == &right.as<FunctionCall>().function() &&
+                   sameArguments(left.as<FunctionCall>().arguments(),
+                                 right.as<FunctionCall>().arguments());
+
+        case Expression::Kind::kIndex:
+            return is_same_expression(*left.as<IndexExpression>().index(),
+                                      *right.as<IndexExpression>().index()) &&
+                   is_same_expression(*left.as<IndexExpression>().base(),
+                                      *right.as<IndexExpression>().base());
+
+        case Expression::Kind::kPrefix:
+            return left.as<PrefixExpression>().getOperator().kind() ==
+                           right.as<PrefixExpression>().getOperator().kind() &&
+                   is_same_expression(*left.as<PrefixExpression>().operand(),
+                                      *right.as<PrefixExpression>().operand());
+
+        case Expression::Kind::kSwizzle:
+            return left.as<Swizzle>().components() == right.as<Swizzle>().components() &&
+                   is_same_expression(*left.as<Swizzle>().base(), *right.as<Swizzle>().base());
+
+        case Expression::Kind::kTernary: {
+            const TernaryExpression& l = left.as<TernaryExpression>();
+            const TernaryExpression& r = right.as<TernaryExpression>();
+            return is_same_expression(*l.test(), *r.test()) &&
+                   is_same_expression(*l.ifTrue(), *r.ifTrue()) &&
+                   is_same_expression(*l.ifFalse(), *r.ifFalse());
+        }
+        case Expression::Kind::kVariableReference:
+            return left.as<VariableReference>().variable() ==
+                   right.as<VariableReference>().variable();
+
+        default:
+            return false;
+    }
+}
+
+// Returns the variable written by an assignment target like `x`, `x.yz`, `s.f` or `a[i]`, or null
+// if the target is anything more complicated.
+static const Variable* assigned_variable(const Expression& expr) {
+    switch (expr.kind()) {
+        case Expression::Kind::kVariableReference:
+            return expr.as<VariableReference>().variable();
+
+        case Expression::Kind::kSwizzle:
+            return assigned_variable(*expr.as<Swizzle>().base());
+
+        case Expression::Kind::kFieldAccess:
+            return assigned_variable(*expr.as<FieldAccess>().base());
+
+        case Expression::Kind::kIndex: {
+            const IndexExpression& index = expr.as<IndexExpression>();
+            return Analysis::HasSideEffects(*index.index()) ? nullptr
+                                                             : assigned_variable(*index.base());
+        }
+        default:
+            return nullptr;
+    }
+}
+
+// Returns true if the expression reads `var`.
+static bool reads_variable(const Expression& expr, const Variable* var) {
+    class ReadVisitor : public ProgramVisitor {
+    public:
+        ReadVisitor(const Variable* var) : fVar(var) {}
+
+        bool visitExpression(const Expression& e) override {
+            if (e.is<VariableReference>() && e.as<VariableReference>().variable() == fVar) {
+                return true;
+            }
+            return INHERITED::visitExpression(e);
+        }
+
+        const Variable* fVar;
+        using INHERITED = ProgramVisitor;
+    };
+
+    ReadVisitor visitor(var);
+    return visitor.visitExpression(expr);
+}
+
+namespace {
+
+// A statement that the eliminator can look inside of. Its expressions are free of side effects,
+// apart from a single assignment into `fWrittenVar`.
+struct SegmentStatement {
+    bool fEligible = false;
+    const Variable* fWrittenVar = nullptr;
+};
+
+// An expression that might be shared with an identical expression elsewhere in the block.
+struct Occurrence {
+    std::unique_ptr<Expression>* fExpr;
+    int fStatement;
+    int fWeight;
+};
+
+class CommonSubexpressionEliminator : public ProgramWriter {
+public:
+    CommonSubexpressionEliminator(const Context& context,
+                                  ProgramUsage* usage,
+                                  SymbolTable* symbols)
+            : fContext(context)
+            , fUsage(usage) {
+        fSymbolTableStack.push_back(symbols);
+    }
+
+    using ProgramWriter::visitProgramElement;
+
+    bool visitExpressionPtr(std::unique_ptr<Expression>& expr) override {
+        // Blocks can't appear inside of an expression, so there's no need to look inside of them.
+        return false;
+    }
+
+    bool visitStatementPtr(std::unique_ptr<Statement>& stmt) override {
+        Analysis::SymbolTableStackBuilder scopedStackBuilder(stmt.get(), &fSymbolTableStack);
+
+        // Handle the innermost blocks first. Nested blocks are barriers to the outer block, so the
+        // order doesn't affect the result.
+        INHERITED::visitStatementPtr(stmt);
+        if (stmt->is<Block>()) {
+            this->eliminateInBlock(stmt->as<Block>().children());
+        }
+        return false;
+    }
+
+private:
+    static SegmentStatement Classify(const Statement& stmt) {
+        SegmentStatement result;
+        switch (stmt.kind()) {
+            case Statement::Kind::kNop:
+                result.fEligible = true;
+                break;
+
+            case Statement::Kind::kVarDeclaration: {
+                const VarDeclaration& decl = stmt.as<VarDeclaration>();
+                result.fEligible = !decl.value() || !Analysis::HasSideEffects(*decl.value());
+                result.fWrittenVar = decl.var();
+                break;
+            }
+            case Statement::Kind::kExpression: {
+                const Expression& expr = *stmt.as<ExpressionStatement>().expression();
+                if (expr.is<BinaryExpression>()) {
+                    const BinaryExpression& binary = expr.as<BinaryExpression>();
+                    if (binary.getOperator().isAssignment() &&
+                        !Analysis::HasSideEffects(*binary.right())) {
+                        result.fWrittenVar = assigned_variable(*binary.left());
+                        result.fEligible = result.fWrittenVar != nullptr;
+                    }
+                }
+                break;
+            }
+            case Statement::Kind::kReturn: {
+                const std::unique_ptr<Expression>& expr = stmt.as<ReturnStatement>().expression();
+                result.fEligible = !expr || !Analysis::HasSideEffects(*expr);
+                break;
+            }
+            default:
+                break;
+        }
+        return result;
+    }
+
+    // Collects the candidate subexpressions of a statement which are always evaluated when the
+    // statement runs. The right side of `&&` and `||` and the branches of a ternary are skipped,
+    // since evaluating them up front would waste work whenever they are short-circuited.
+    class CandidateFinder : public ProgramWriter {
+    public:
+        CandidateFinder(TArray<Occurrence>* occurrences) : fOccurrences(occurrences) {}
+
+        void findInStatement(Statement& stmt, int index) {
+            fStatement = index;
+            switch (stmt.kind()) {
+                case Statement::Kind::kVarDeclaration:
+                    if (stmt.as<VarDeclaration>().value()) {
+                        this->visitExpressionPtr(stmt.as<VarDeclaration>().value());
+                    }
+                    break;
+
+                case Statement::Kind::kExpression:
+                    this->visitExpressionPtr(
+                            stmt.as<ExpressionStatement>().expression()->as<BinaryExpression>()
+                                                                        .right());
+                    break;
+
+                case Statement::Kind::kReturn:
+                    if (stmt.as<ReturnStatement>().expression()) {
+                        this->visitExpressionPtr(stmt.as<ReturnStatement>().expression());
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        bool visitExpressionPtr(std::unique_ptr<Expression>& expr) override {
+            const Type& type = expr->type();
+            if ((type.isScalar() || type.isVector() || type.isMatrix()) && !type.isLiteral() &&
+                !Analysis::IsCompileTimeConstant(*expr)) {
+                int weight = expression_weight(*expr);
+                if (weight >= kMinSharedWeight) {
+                    fOccurrences->push_back({&expr, fStatement, weight});
+                }
+            }
+            switch (expr->kind()) {
+                case Expression::Kind::kBinary: {
+                    BinaryExpression& binary = expr->as<BinaryExpression>();
+                    Operator::Kind op = binary.getOperator().kind();
+                    if (op == Operator::Kind::LOGICALAND || op == Operator::Kind::LOGICALOR) {
+                        return this->visitExpressionPtr(binary.left());
+                    }
+                    break;
+                }
+                case Expression::Kind::kTernary:
+                    return this->visitExpressionPtr(expr->as<TernaryExpression>().test());
+
+                default:
+                    break;
+            }
+            return INHERITED::visitExpressionPtr(expr);
+        }
+
+        bool visitStatementPtr(std::unique_ptr<Statement>&) override {
+            return false;
+        }
+
+    private:
+        TArray<Occurrence>* fOccurrences;
+        int fStatement = 0;
+
+        using INHERITED = ProgramWriter;
+    };
+
+    void eliminateInBlock(StatementArray& stmts) {
+        int replacements = 0;
+        int begin = 0;
+        while (begin < stmts.size()) {
+            if (!Classify(*stmts[begin]).fEligible) {
+                ++begin;
+                continue;
+            }
+            int end = begin + 1;
+            while (end < stmts.size() && Classify(*stmts[end]).fEligible) {
+                ++end;
+            }
+            // Each replacement adds a declaration to the segment.
+            while (replacements < kMaxReplacementsPerBlock &&
+                   this->eliminateInSegment(stmts, begin, end)) {
+                ++replacements;
+                ++end;
+            }
+            begin = end;
+        }
+    }
+
+    // Replaces the most profitable set of matching subexpressions within a run of eligible
+    // statements. Returns true if a replacement was made.
+    bool eliminateInSegment(StatementArray& stmts, int begin, int end) {
+        TArray<Occurrence> occurrences;
+        TArray<const Variable*> writtenVars;
+        CandidateFinder finder(&occurrences);
+        for (int index = begin; index < end; ++index) {
+            writtenVars.push_back(Classify(*stmts[index]).fWrittenVar);
+            finder.findInStatement(*stmts[index], index);
+        }
+
+        // An occurrence can only reuse an earlier one if no statement in between, including the
+        // earlier one's own, writes to a variable that the expression reads.
+        auto isKilledBetween = [&](const Expression& expr, int fromStmt, int toStmt) {
+            for (int index = fromStmt; index < toStmt; ++index) {
+                const Variable* var = writtenVars[index - begin];
+                if (var && reads_variable(expr, var)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        TArray<int> bestGroup;
+        int bestSavings = 0;
+        TArray<bool> grouped;
+        grouped.push_back_n(occurrences.size(), false);
+        for (int first = 0; first < occurrences.size(); ++first) {
+            if (grouped[first]) {
+                continue;
+            }
+            const Occurrence& occurrence = occurrences[first];
+            const Expression& expr = **occurrence.fExpr;
+            TArray<int> group;
+            group.push_back(first);
+            for (int next = first + 1; next < occurrences.size(); ++next) {
+                const Occurrence& candidate = occurrences[next];
+                if (candidate.fWeight != occurrence.fWeight ||
+                    !is_same_expression(expr, **candidate.fExpr)) {
+                    continue;
+                }
+                if (isKilledBetween(expr, occurrences[group.back()].fStatement,
+                                    candidate.fStatement)) {
+                    break;
+                }
+                group.push_back(next);
+                grouped[next] = true;
+            }
+            int savings = (group.size() - 1) * occurrence.fWeight;
+            if (savings > bestSavings) {
+                bestSavings = savings;
+                bestGroup = std::move(group);
+            }
+        }
+        if (bestGroup.empty()) {
+            return false;
+        }
+
+        // Evaluate the expression into a scratch variable just ahead of its first use...
+        const Occurrence& first = occurrences[bestGroup.front()];
+        const Expression& expr = **first.fExpr;
+        Variable::ScratchVariable scratch = Variable::MakeScratchVariable(fContext,
+                                                                         fMangler,
+                                                                         "cse",
+                                                                         &expr.type(),
+                                                                         fSymbolTableStack.back(),
+                                                                         expr.clone());
+        fUsage->add(scratch.fVarDecl.get());
+
+        // ... and read the variable everywhere the expression appeared.
+        for (int index : bestGroup) {
+            std::unique_ptr<Expression>& occurrence = *occurrences[index].fExpr;
+            Position pos = occurrence->fPosition;
+            fUsage->remove(occurrence.get());
+            occurrence = VariableReference::Make(pos, scratch.fVarSymbol);
+            fUsage->add(occurrence.get());
+        }
+
+        StatementArray newStmts;
+        newStmts.reserve_exact(stmts.size() + 1);
+        for (int index = 0; index < stmts.size(); ++index) {
+            if (index == first.fStatement) {
+                newStmts.push_back(std::move(scratch.fVarDecl));
+            }
+            newStmts.push_back(std::move(stmts[index]));
+        }
+        stmts = std::move(newStmts);
+        return true;
+    }
+
+    const Context& fContext;
+    ProgramUsage* fUsage;
+    Mangler fMangler;
+    std::vector<SymbolTable*> fSymbolTableStack;
+
+    using INHERITED = ProgramWriter;
+};
+
+}  // namespace
+
+void Transform::EliminateCommonSubexpressions(Program& program) {
+    CommonSubexpressionEliminator visitor(*program.fContext,
+                                          program.fUsage.get(),
+                                          program.fSymbols.get());
+    for (std::unique_ptr<ProgramElement>& pe : program.fOwnedElements) {
+        if (pe->is<FunctionDefinition>()) {
+            visitor.visitProgramElement(*pe);
+        }
+    }
+}
+
+}  // namespace SkSL
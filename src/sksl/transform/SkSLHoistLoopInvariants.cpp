@@ -0,0 +1,224 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+#include "src/core/SkTHash.h"
+#include "src/sksl/SkSLAnalysis.h"
+#include "src/sksl/SkSLDefines.h"
+#include "src/sksl/SkSLPosition.h"
+#include "src/sksl/analysis/SkSLProgramUsage.h"
+#include "src/sksl/analysis/SkSLProgramVisitor.h"
+#include "src/sksl/ir/SkSLBlock.h"
+#include "src/sksl/ir/SkSLExpression.h"
+#include "src/sksl/ir/SkSLForStatement.h"
+#include "src/sksl/ir/SkSLFunctionCall.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLFunctionDefinition.h"
+#include "src/sksl/ir/SkSLIRNode.h"
+#include "src/sksl/ir/SkSLNop.h"
+#include "src/sksl/ir/SkSLProgram.h"
+#include "src/sksl/ir/SkSLStatement.h"
+#include "src/sksl/ir/SkSLSymbolTable.h"
+#include "src/sksl/ir/SkSLVarDeclarations.h"
+#include "src/sksl/ir/SkSLVariable.h"
+#include "src/sksl/ir/SkSLVariableReference.h"
+#include "src/sksl/transform/SkSLProgramWriter.h"
+#include "src/sksl/transform/SkSLTransform.h"
+
+#include <memory>
+#include <utility>
+
+using namespace skia_private;
+
+namespace SkSL {
+
+class Context;
+
+namespace {
+
+// Gathers the variables that a loop declares or assigns to.
+class LoopWriteFinder : public ProgramVisitor {
+public:
+    bool visitExpression(const Expression& expr) override {
+        if (expr.is<VariableReference>()) {
+            const VariableReference& ref = expr.as<VariableReference>();
+            if (ref.refKind() != VariableReference::RefKind::kRead) {
+                fWrittenVars.add(ref.variable());
+            }
+        } else if (expr.is<FunctionCall>()) {
+            // A call to a user function might assign to any global variable.
+            fCallsUserFunctions |= !expr.as<FunctionCall>().function().isBuiltin();
+        }
+        return INHERITED::visitExpression(expr);
+    }
+
+    bool visitStatement(const Statement& stmt) override {
+        if (stmt.is<VarDeclaration>()) {
+            fWrittenVars.add(stmt.as<VarDeclaration>().var());
+        }
+        return INHERITED::visitStatement(stmt);
+    }
+
+    THashSet<const Variable*> fWrittenVars;
+    bool fCallsUserFunctions = false;
+
+    using INHERITED = ProgramVisitor;
+};
+
+// Returns true if an expression only reads variables which keep the same value on every iteration
+// of the loop.
+static bool is_loop_invariant(const Expression& expr,
+                              const LoopWriteFinder& loop,
+                              const THashSet<const Variable*>& hoistedVars) {
+    class InvariantVisitor : public ProgramVisitor {
+    public:
+        InvariantVisitor(const LoopWriteFinder& loop, const THashSet<const Variable*>& hoisted)
+                : fLoop(loop)
+                , fHoistedVars(hoisted) {}
+
+        bool visitExpression(const Expression& e) override {
+            if (e.is<VariableReference>()) {
+                const Variable* var = e.as<VariableReference>().variable();
+                if (fHoistedVars.contains(var)) {
+                    return false;
+                }
+                if (fLoop.fWrittenVars.contains(var)) {
+                    return true;
+                }
+                if (fLoop.fCallsUserFunctions && var->storage() == Variable::Storage::kGlobal) {
+                    return true;
+                }
+            }
+            return INHERITED::visitExpression(e);
+        }
+
+        const LoopWriteFinder& fLoop;
+        const THashSet<const Variable*>& fHoistedVars;
+
+        using INHERITED = ProgramVisitor;
+    };
+
+    // The visitor returns true as soon as it finds a variable which varies.
+    InvariantVisitor visitor(loop, hoistedVars);
+    return !visitor.visitExpression(expr);
+}
+
+class LoopInvariantHoister : public ProgramWriter {
+public:
+    LoopInvariantHoister(const Context& context, ProgramUsage* usage)
+            : fContext(context)
+            , fUsage(usage) {}
+
+    using ProgramWriter::visitProgramElement;
+
+    bool visitExpressionPtr(std::unique_ptr<Expression>& expr) override {
+        // Loops can't appear inside of an expression, so there's no need to look inside of them.
+        return false;
+    }
+
+    bool visitStatementPtr(std::unique_ptr<Statement>& stmt) override {
+        // Hoist out of inner loops first, so their invariants can be considered by outer loops.
+        INHERITED::visitStatementPtr(stmt);
+        if (stmt->is<ForStatement>()) {
+            this->hoistFromLoop(stmt);
+        }
+        return false;
+    }
+
+private:
+    struct HoistState {
+        const LoopWriteFinder& fWrites;
+        const SymbolTable* fOutsideSymbols;
+        THashSet<const Variable*> fHoistedVars;
+        StatementArray fHoistedStmts;
+    };
+
+    void collectHoistable(StatementArray& stmts, HoistState* state) {
+        for (std::unique_ptr<Statement>& child : stmts) {
+            if (child->is<Block>() && !child->as<Block>().isScope()) {
+                // The inliner emits unscoped blocks; their declarations live in the body's scope.
+                this->collectHoistable(child->as<Block>().children(), state);
+                continue;
+            }
+            if (!child->is<VarDeclaration>()) {
+                continue;
+            }
+            VarDeclaration& decl = child->as<VarDeclaration>();
+            const Variable* var = decl.var();
+            const ProgramUsage::VariableCounts counts = fUsage->get(*var);
+            if (!decl.value() || counts.fWrite != 1 ||
+                Analysis::IsCompileTimeConstant(*decl.value()) ||
+                Analysis::HasSideEffects(*decl.value()) ||
+                !is_loop_invariant(*decl.value(), state->fWrites, state->fHoistedVars)) {
+                continue;
+            }
+            // The variable's name must not collide with anything visible from outside the body, or
+            // the hoisted variable would shadow it.
+            if (state->fOutsideSymbols && state->fOutsideSymbols->find(var->name())) {
+                continue;
+            }
+            state->fHoistedVars.add(var);
+            state->fHoistedStmts.push_back(std::move(child));
+            child = Nop::Make();
+        }
+    }
+
+    void hoistFromLoop(std::unique_ptr<Statement>& stmt) {
+        ForStatement& loop = stmt->as<ForStatement>();
+        SymbolTable* loopSymbols = loop.symbols();
+        if (!loopSymbols || !loop.statement()->is<Block>()) {
+            return;
+        }
+        // The braces of a loop body usually share the loop's scope, but they may have their own.
+        Block& body = loop.statement()->as<Block>();
+        SymbolTable* bodySymbols = body.symbolTable() ? body.symbolTable() : loopSymbols;
+        SymbolTable* outsideSymbols = bodySymbols == loopSymbols ? loopSymbols->fParent
+                                                                 : loopSymbols;
+
+        LoopWriteFinder writes;
+        writes.visitStatement(loop);
+
+        // Only declarations at the top level of the loop body are considered; they are evaluated
+        // on every iteration which gets that far.
+        HoistState state{writes, outsideSymbols, {}, {}};
+        this->collectHoistable(body.children(), &state);
+        StatementArray& hoistedStmts = state.fHoistedStmts;
+        if (hoistedStmts.empty()) {
+            return;
+        }
+
+        // Wrap the loop in a scope which holds the hoisted declarations.
+        std::unique_ptr<SymbolTable> outerSymbols = loopSymbols->insertNewParent();
+        for (const std::unique_ptr<Statement>& hoisted : hoistedStmts) {
+            bodySymbols->moveSymbolTo(outerSymbols.get(),
+                                      hoisted->as<VarDeclaration>().var(),
+                                      fContext);
+        }
+        Position pos = stmt->fPosition;
+        hoistedStmts.push_back(std::move(stmt));
+        stmt = Block::MakeBlock(pos, std::move(hoistedStmts), Block::Kind::kBracedScope,
+                                std::move(outerSymbols));
+    }
+
+    const Context& fContext;
+    ProgramUsage* fUsage;
+
+    using INHERITED = ProgramWriter;
+};
+
+}  // namespace
+
+void Transform::HoistLoopInvariants(Program& program) {
+    LoopInvariantHoister visitor(*program.fContext, program.fUsage.get());
+    for (std::unique_ptr<ProgramElement>& pe : program.fOwnedElements) {
+        if (pe->is<FunctionDefinition>()) {
+            visitor.visitProgramElement(*pe);
+        }
+    }
+}
+
+}  // namespace SkSL
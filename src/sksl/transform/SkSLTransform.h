@@ -98,6 +98,20 @@ bool EliminateDeadGlobalVariables(const Context& context,
                                   bool onlyPrivateGlobals);
 bool EliminateDeadGlobalVariables(Program& program);
 
+/**
+ * Finds identical side-effect-free subexpressions within a run of straight-line statements, and
+ * evaluates them once into a scratch variable declared ahead of the first use. For example,
+ * `a = x * y + z; b = x * y + w;` becomes `float t = x * y; a = t + z; b = t + w;`.
+ */
+void EliminateCommonSubexpressions(Program& program);
+
+/**
+ * Moves variable declarations whose values can't change between iterations out of the body of a
+ * for loop, into a new scope wrapped around the loop. The variables must never be reassigned, and
+ * their initial values must be free of side effects.
+ */
+void HoistLoopInvariants(Program& program);
+
 /** Renames private functions and function-local variables to minimize code size. */
 void RenamePrivateSymbols(Context& context, Module& module, ProgramUsage* usage, ProgramKind kind);
 
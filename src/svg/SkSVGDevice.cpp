@@ -50,11 +50,13 @@
 #include "src/core/SkClipStack.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkFontPriv.h"
+#include "src/core/SkGeometry.h"
 #include "src/core/SkTHash.h"
 #include "src/image/SkImage_Base.h"
 #include "src/shaders/SkColorShader.h"
 #include "src/shaders/SkShaderBase.h"
 #include "src/text/GlyphRun.h"
+#include "src/utils/SkFloatToDecimal.h"
 #include "src/xml/SkXMLWriter.h"
 
 #include <cstring>
@@ -232,6 +234,74 @@ void AddPath(const sktext::GlyphRun& glyphRun, const SkPoint& offset, SkPath* pa
             }, &rec);
 }
 
+// Writes the path's data like SkParsePath::ToSVGString(), but formats coordinates with
+// SkFloatToDecimal, which is exact and much faster than printf for paths with many points.
+sk_sp<SkData> svg_path_data(const SkPath& path, SkParsePath::PathEncoding encoding) {
+    SkDynamicMemoryWStream stream;
+    SkPoint currentPoint = {0, 0};
+    const bool relative = encoding == SkParsePath::PathEncoding::Relative;
+
+    auto appendCommand = [&](char cmd, const SkPoint pts[], size_t count) {
+        SkASSERT(count > 0);
+        // Use lower case cmds for relative encoding.
+        if (relative) {
+            cmd += 'a' - 'A';
+        }
+        stream.write(&cmd, 1);
+
+        for (size_t i = 0; i < count; ++i) {
+            const SkPoint pt = pts[i] - currentPoint;
+            char buffer[2 * kMaximumSkFloatToDecimalLength + 2];
+            size_t length = 0;
+            if (i > 0) {
+                buffer[length++] = ' ';
+            }
+            length += SkFloatToDecimal(pt.fX, buffer + length);
+            buffer[length++] = ' ';
+            length += SkFloatToDecimal(pt.fY, buffer + length);
+            stream.write(buffer, length);
+        }
+
+        // For relative encoding, track the current point (otherwise == origin).
+        if (relative) {
+            currentPoint = pts[count - 1];
+        }
+    };
+
+    SkPath::Iter iter(path, false);
+    SkPoint      pts[4];
+    for (SkPath::Verb verb; (verb = iter.next(pts)) != SkPath::kDone_Verb;) {
+        switch (verb) {
+            case SkPath::kConic_Verb: {
+                const SkScalar tol = SK_Scalar1 / 1024; // how close to a quad
+                SkAutoConicToQuads quadder;
+                const SkPoint* quadPts = quadder.computeQuads(pts, iter.conicWeight(), tol);
+                for (int i = 0; i < quadder.countQuads(); ++i) {
+                    appendCommand('Q', &quadPts[i*2 + 1], 2);
+                }
+            } break;
+            case SkPath::kMove_Verb:
+                appendCommand('M', &pts[0], 1);
+                break;
+            case SkPath::kLine_Verb:
+                appendCommand('L', &pts[1], 1);
+                break;
+            case SkPath::kQuad_Verb:
+                appendCommand('Q', &pts[1], 2);
+                break;
+            case SkPath::kCubic_Verb:
+                appendCommand('C', &pts[1], 3);
+                break;
+            case SkPath::kClose_Verb:
+                stream.write("Z", 1);
+                break;
+            case SkPath::kDone_Verb:
+                SkUNREACHABLE;
+        }
+    }
+    return stream.detachAsData();
+}
+
 }  // namespace
 
 // For now all this does is serve unique serial IDs, but it will eventually evolve to track
@@ -327,6 +397,10 @@ public:
         fWriter->addScalarAttribute(name, val);
     }
 
+    void addAttribute(const char name[], const SkData& val) {
+        fWriter->addAttributeLen(name, static_cast<const char*>(val.data()), val.size());
+    }
+
     void addText(const SkString& text) {
         fWriter->addText(text.c_str(), text.size());
     }
@@ -678,7 +752,7 @@ void SkSVGDevice::AutoElement::addRectAttributes(const SkRect& rect) {
 
 void SkSVGDevice::AutoElement::addPathAttributes(const SkPath& path,
                                                  SkParsePath::PathEncoding encoding) {
-    this->addAttribute("d", SkParsePath::ToSVGString(path, encoding));
+    this->addAttribute("d", *svg_path_data(path, encoding));
 }
 
 void SkSVGDevice::AutoElement::addTextAttributes(const SkFont& font) {
@@ -962,6 +1036,18 @@ void SkSVGDevice::drawPath(const SkPath& path, const SkPaint& paint, bool pathIs
       path_paint.writable()->setPathEffect(nullptr); // path effect processed
     }
 
+    // Paths drawn again are drawn as a <use> of a shared definition. Paths made by path effects
+    // are new each time.
+    const SkString* defID = paint.getPathEffect() ? nullptr : this->reusablePathDef(*pathPtr);
+    if (defID) {
+        AutoElement elem("use", this, fResourceBucket.get(), MxCp(this), *path_paint);
+        elem.addAttribute("xlink:href", SkStringPrintf("#%s", defID->c_str()));
+        if (pathPtr->getFillType() == SkPathFillType::kEvenOdd) {
+            elem.addAttribute("fill-rule", "evenodd");
+        }
+        return;
+    }
+
     // Create path element.
     AutoElement elem("path", this, fResourceBucket.get(), MxCp(this), *path_paint);
     elem.addPathAttributes(*pathPtr, this->pathEncoding());
@@ -972,6 +1058,29 @@ void SkSVGDevice::drawPath(const SkPath& path, const SkPaint& paint, bool pathIs
     }
 }
 
+const SkString* SkSVGDevice::reusablePathDef(const SkPath& path) {
+    // Referencing a definition takes more space than drawing small paths directly.
+    static constexpr int kMinReusedPoints = 8;
+    if (!(fFlags & SkSVGCanvas::kReusePaths_Flag) || path.countPoints() < kMinReusedPoints) {
+        return nullptr;
+    }
+
+    // Paths are only defined when drawn a second time, so paths drawn once aren't written twice.
+    SkString* defID = fPathDefs.find(path.getGenerationID());
+    if (!defID) {
+        fPathDefs.set(path.getGenerationID(), SkString());
+        return nullptr;
+    }
+    if (defID->isEmpty()) {
+        *defID = fResourceBucket->addPath();
+        AutoElement defs("defs", fWriter);
+        AutoElement pathDef("path", fWriter);
+        pathDef.addAttribute("id", *defID);
+        pathDef.addPathAttributes(path, this->pathEncoding());
+    }
+    return defID;
+}
+
 static sk_sp<SkData> encode(const SkBitmap& src) {
     SkDynamicMemoryWStream buf;
     return SkPngEncoder::Encode(&buf, src.pixmap(), {}) ? buf.detachAsData() : nullptr;
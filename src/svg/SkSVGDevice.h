@@ -10,11 +10,13 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTypeTraits.h"
 #include "include/utils/SkParsePath.h"
 #include "src/core/SkClipStackDevice.h"
+#include "src/core/SkTHash.h"
 
 #include <cstddef>
 #include <cstdint>
@@ -79,6 +81,10 @@ private:
 
     SkParsePath::PathEncoding pathEncoding() const;
 
+    // Returns the ID of a <defs> entry to <use> for drawing the path, or null if it should be
+    // drawn directly.
+    const SkString* reusablePathDef(const SkPath&);
+
     class AutoElement;
     class ResourceBucket;
 
@@ -97,6 +103,10 @@ private:
 
     std::unique_ptr<AutoElement> fRootElement;
     skia_private::TArray<ClipRec> fClipStack;
+
+    // With kReusePaths_Flag, the paths drawn so far by generation ID, mapped to the ID of their
+    // definition once they've been drawn a second time.
+    skia_private::THashMap<uint32_t, SkString> fPathDefs;
 };
 
 #endif // SkSVGDevice_DEFINED
@@ -28,6 +28,8 @@ public:
             case SkMask::kLCD16_Format:
                 return skgpu::MaskFormat::kA565;
             case SkMask::kARGB32_Format:
+            case SkMask::kMSDF_Format:
+                // multi-channel distance fields are stored in the color cache
                 return skgpu::MaskFormat::kARGB;
         }
 
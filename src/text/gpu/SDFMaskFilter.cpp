@@ -7,15 +7,19 @@
 
 #include "src/text/gpu/SDFMaskFilter.h"
 
+#include "include/core/SkColorPriv.h"
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "src/core/SkDistanceFieldGen.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMaskFilterBase.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkWriteBuffer.h"
+
+#include <cstdint>
 
 class SkMatrix;
-class SkReadBuffer;
 
 #if !defined(SK_DISABLE_SDF_TEXT)
 
@@ -23,7 +27,7 @@ namespace sktext::gpu {
 
 class SDFMaskFilterImpl : public SkMaskFilterBase {
 public:
-    SDFMaskFilterImpl();
+    explicit SDFMaskFilterImpl(bool multiChannel);
 
     // overrides from SkMaskFilterBase
     //  This method is not exported to java.
@@ -34,16 +38,21 @@ public:
     SkMaskFilterBase::Type type() const override { return SkMaskFilterBase::Type::kSDF; }
     void computeFastBounds(const SkRect&, SkRect*) const override;
 
+protected:
+    void flatten(SkWriteBuffer&) const override;
+
 private:
     SK_FLATTENABLE_HOOKS(SDFMaskFilterImpl)
+
+    const bool fMultiChannel;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SDFMaskFilterImpl::SDFMaskFilterImpl() {}
+SDFMaskFilterImpl::SDFMaskFilterImpl(bool multiChannel) : fMultiChannel(multiChannel) {}
 
 SkMask::Format SDFMaskFilterImpl::getFormat() const {
-    return SkMask::kSDF_Format;
+    return fMultiChannel ? SkMask::kMSDF_Format : SkMask::kSDF_Format;
 }
 
 bool SDFMaskFilterImpl::filterMask(SkMaskBuilder* dst, const SkMask& src,
@@ -62,6 +71,10 @@ bool SDFMaskFilterImpl::filterMask(SkMaskBuilder* dst, const SkMask& src,
     }
 
     if (src.fImage == nullptr) {
+        if (fMultiChannel) {
+            dst->format() = SkMask::kMSDF_Format;
+            dst->rowBytes() *= sizeof(uint32_t);
+        }
         return true;
     }
     if (dst->fImage == nullptr) {
@@ -69,19 +82,42 @@ bool SDFMaskFilterImpl::filterMask(SkMaskBuilder* dst, const SkMask& src,
         return false;
     }
 
+    bool success;
     if (src.fFormat == SkMask::kA8_Format) {
-        return SkGenerateDistanceFieldFromA8Image(dst->image(), src.fImage,
-                                                  src.fBounds.width(), src.fBounds.height(),
-                                                  src.fRowBytes);
-    } else if (src.fFormat == SkMask::kLCD16_Format) {
-        return SkGenerateDistanceFieldFromLCD16Mask(dst->image(), src.fImage,
+        success = SkGenerateDistanceFieldFromA8Image(dst->image(), src.fImage,
                                                      src.fBounds.width(), src.fBounds.height(),
                                                      src.fRowBytes);
+    } else if (src.fFormat == SkMask::kLCD16_Format) {
+        success = SkGenerateDistanceFieldFromLCD16Mask(dst->image(), src.fImage,
+                                                       src.fBounds.width(), src.fBounds.height(),
+                                                       src.fRowBytes);
     } else {
-        return SkGenerateDistanceFieldFromBWImage(dst->image(), src.fImage,
-                                                  src.fBounds.width(), src.fBounds.height(),
-                                                  src.fRowBytes);
+        success = SkGenerateDistanceFieldFromBWImage(dst->image(), src.fImage,
+                                                     src.fBounds.width(), src.fBounds.height(),
+                                                     src.fRowBytes);
     }
+    if (!success || !fMultiChannel) {
+        return success;
+    }
+
+    // Glyphs only get a real multi-channel distance field from their outline (see
+    // SkScalerContext::getImage). Without one, put the single-channel field in all the channels.
+    const int width = dst->fBounds.width(),
+              height = dst->fBounds.height();
+    const uint8_t* sdf = dst->fImage;
+    uint8_t* msdf = SkMaskBuilder::AllocImage(dst->computeImageSize() * sizeof(uint32_t));
+    for (int y = 0; y < height; ++y) {
+        uint32_t* msdfRow = reinterpret_cast<uint32_t*>(msdf) + y * width;
+        for (int x = 0; x < width; ++x) {
+            const uint8_t d = sdf[y * dst->fRowBytes + x];
+            msdfRow[x] = SkPackARGB32NoCheck(d, d, d, d);
+        }
+    }
+    SkMaskBuilder::FreeImage(dst->image());
+    dst->image() = msdf;
+    dst->format() = SkMask::kMSDF_Format;
+    dst->rowBytes() = width * sizeof(uint32_t);
+    return true;
 }
 
 void SDFMaskFilterImpl::computeFastBounds(const SkRect& src,
@@ -90,14 +126,22 @@ void SDFMaskFilterImpl::computeFastBounds(const SkRect& src,
                  src.fRight + SK_DistanceFieldPad, src.fBottom + SK_DistanceFieldPad);
 }
 
+void SDFMaskFilterImpl::flatten(SkWriteBuffer& buffer) const {
+    buffer.writeBool(fMultiChannel);
+}
+
 sk_sp<SkFlattenable> SDFMaskFilterImpl::CreateProc(SkReadBuffer& buffer) {
-    return SDFMaskFilter::Make();
+    return buffer.readBool() ? SDFMaskFilter::MakeMultiChannel() : SDFMaskFilter::Make();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 sk_sp<SkMaskFilter> SDFMaskFilter::Make() {
-    return sk_sp<SkMaskFilter>(new SDFMaskFilterImpl());
+    return sk_sp<SkMaskFilter>(new SDFMaskFilterImpl(/*multiChannel=*/false));
+}
+
+sk_sp<SkMaskFilter> SDFMaskFilter::MakeMultiChannel() {
+    return sk_sp<SkMaskFilter>(new SDFMaskFilterImpl(/*multiChannel=*/true));
 }
 
 }  // namespace sktext::gpu
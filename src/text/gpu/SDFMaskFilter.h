@@ -24,6 +24,11 @@ namespace sktext::gpu {
 class SDFMaskFilter : public SkMaskFilter {
 public:
     static sk_sp<SkMaskFilter> Make();
+
+    // Produces SkMask::kMSDF_Format multi-channel distance fields, which keep the glyph's corners
+    // sharp when magnified. The scaler context generates them from the glyph's outline; the
+    // filter itself only replicates a single-channel distance field for glyphs without one.
+    static sk_sp<SkMaskFilter> MakeMultiChannel();
 };
 
 }  // namespace sktext::gpu
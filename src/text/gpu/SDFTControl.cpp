@@ -43,15 +43,25 @@ SkScalar SDFTControl::MinSDFTRange(bool useSDFTForSmallText, SkScalar min) {
 
 SDFTControl::SDFTControl(
         bool ableToUseSDFT, bool useSDFTForSmallText, bool useSDFTForPerspectiveText,
-        SkScalar min, SkScalar max)
+        SkScalar min, SkScalar max, int maxMaskDimension, bool useMultiChannelSDFT)
         : fMinDistanceFieldFontSize{MinSDFTRange(useSDFTForSmallText, min)}
         , fMaxDistanceFieldFontSize{max}
         , fAbleToUseSDFT{ableToUseSDFT}
-        , fAbleToUsePerspectiveSDFT{useSDFTForPerspectiveText} {
+        , fAbleToUsePerspectiveSDFT{useSDFTForPerspectiveText}
+        , fUseMultiChannel{useMultiChannelSDFT}
+        , fMaxMaskDimension{maxMaskDimension} {
     SkASSERT_RELEASE(0 < min && min <= max);
 }
 #endif // !defined(SK_DISABLE_SDF_TEXT)
 
+static_assert(SDFTControl::kDefaultMaxMaskDimension == SkGlyphDigest::kSkSideTooBigForAtlas);
+
+SDFTControl SDFTControl::makeOutlinesOnly() const {
+    SDFTControl control{*this};
+    control.fOutlinesOnly = true;
+    return control;
+}
+
 bool SDFTControl::isDirect(SkScalar approximateDeviceTextSize, const SkPaint& paint,
                            const SkMatrix& matrix) const {
 #if !defined(SK_DISABLE_SDF_TEXT)
@@ -93,7 +103,12 @@ SDFTControl::getSDFFont(const SkFont& font, const SkMatrix& viewMatrix,
     SkScalar dfMaskScaleFloor;
     SkScalar dfMaskScaleCeil;
     SkScalar dfMaskSize;
-    if (scaledTextSize <= kSmallDFFontLimit) {
+    if (fUseMultiChannel) {
+        // The corners survive magnification, so the medium size covers the whole range.
+        dfMaskScaleFloor = fMinDistanceFieldFontSize;
+        dfMaskScaleCeil = fMaxDistanceFieldFontSize;
+        dfMaskSize = kMediumDFFontLimit;
+    } else if (scaledTextSize <= kSmallDFFontLimit) {
         dfMaskScaleFloor = fMinDistanceFieldFontSize;
         dfMaskScaleCeil = kSmallDFFontLimit;
         dfMaskSize = kSmallDFFontLimit;
@@ -40,9 +40,14 @@ private:
 
 class SDFTControl {
 public:
+    // The largest glyph mask which fits in the glyph atlas, SkGlyphDigest::kSkSideTooBigForAtlas.
+    inline static constexpr int kDefaultMaxMaskDimension = 256;
+
 #if !defined(SK_DISABLE_SDF_TEXT)
     SDFTControl(bool ableToUseSDFT, bool useSDFTForSmallText, bool useSDFTForPerspectiveText,
-                SkScalar min, SkScalar max);
+                SkScalar min, SkScalar max,
+                int maxMaskDimension = kDefaultMaxMaskDimension,
+                bool useMultiChannelSDFT = false);
 
     // Produce a font, a scale factor from the nominal size to the source space size, and matrix
     // range where this font can be reused.
@@ -52,12 +57,26 @@ public:
     bool isSDFT(SkScalar approximateDeviceTextSize, const SkPaint& paint,
                 const SkMatrix& matrix) const;
     SkScalar maxSize() const { return fMaxDistanceFieldFontSize; }
+
+    // Multi-channel distance fields keep corners sharp at any scale, so a single strike serves
+    // the whole SDFT size range.
+    bool useMultiChannel() const { return fUseMultiChannel; }
 #else
-    SDFTControl() {}
+    explicit SDFTControl(int maxMaskDimension = kDefaultMaxMaskDimension)
+            : fMaxMaskDimension{maxMaskDimension} {}
 #endif
     bool isDirect(SkScalar approximateDeviceTextSize, const SkPaint& paint,
                   const SkMatrix& matrix) const;
 
+    // Non-color glyphs whose masks are larger than this in either dimension are drawn as paths,
+    // rasterized by the GPU, instead of from CPU masks uploaded to the glyph atlas.
+    int maxMaskDimension() const { return fMaxMaskDimension; }
+
+    // Returns a copy of this control which draws every glyph that has an outline as a path, so
+    // that the sub runs made with it don't depend on the scale they were made at.
+    SDFTControl makeOutlinesOnly() const;
+    bool outlinesOnly() const { return fOutlinesOnly; }
+
 
 private:
 #if !defined(SK_DISABLE_SDF_TEXT)
@@ -72,7 +91,11 @@ private:
 
     const bool fAbleToUseSDFT;
     const bool fAbleToUsePerspectiveSDFT;
+    const bool fUseMultiChannel;
 #endif
+
+    const int fMaxMaskDimension;
+    bool fOutlinesOnly = false;
 };
 
 }  // namespace sktext::gpu
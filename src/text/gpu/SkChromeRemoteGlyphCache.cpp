@@ -23,6 +23,7 @@
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkPoint_impl.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTFitsIn.h"
 #include "include/private/base/SkTo.h"
 #include "include/private/chromium/Slug.h"
@@ -321,11 +322,11 @@ void SkStrikeServerImpl::writeStrikeData(std::vector<uint8_t>* memory) {
     // We can use the default SkSerialProcs because we do not currently need to encode any SkImages.
     SkBinaryWriteBuffer buffer{nullptr, 0, {}};
 
-    // Gather statistics about what needs to be sent.
-    size_t strikesToSend = 0;
+    // Gather the strikes which need to be sent, so that only they are walked below.
+    STArray<32, RemoteStrike*> strikesToSend;
     fRemoteStrikesToSend.foreach([&](RemoteStrike* strike) {
         if (strike->hasPendingGlyphs()) {
-            strikesToSend++;
+            strikesToSend.push_back(strike);
         } else {
             // This strike has nothing to send, so drop its scaler context to reduce memory.
             strike->resetScalerContext();
@@ -333,7 +334,7 @@ void SkStrikeServerImpl::writeStrikeData(std::vector<uint8_t>* memory) {
     });
 
     // If there are no strikes or typefaces to send, then cleanup and return.
-    if (strikesToSend == 0 && fTypefacesToSend.empty()) {
+    if (strikesToSend.empty() && fTypefacesToSend.empty()) {
         fRemoteStrikesToSend.reset();
         return;
     }
@@ -347,20 +348,16 @@ void SkStrikeServerImpl::writeStrikeData(std::vector<uint8_t>* memory) {
     }
     fTypefacesToSend.clear();
 
-    buffer.writeInt(strikesToSend);
-    fRemoteStrikesToSend.foreach(
-            [&](RemoteStrike* strike) {
-                if (strike->hasPendingGlyphs()) {
-                    strike->writePendingGlyphs(buffer);
-                    strike->resetScalerContext();
-                }
-            }
-    );
+    buffer.writeInt(strikesToSend.size());
+    for (RemoteStrike* strike : strikesToSend) {
+        strike->writePendingGlyphs(buffer);
+        strike->resetScalerContext();
+    }
     fRemoteStrikesToSend.reset();
 
-    // Copy data into the vector.
-    auto data = buffer.snapshotAsData();
-    memory->assign(data->bytes(), data->bytes() + data->size());
+    // Copy data into the vector, straight from the buffer's storage.
+    memory->resize(buffer.bytesWritten());
+    buffer.writeToMemory(memory->data());
 }
 
 sk_sp<StrikeForGPU> SkStrikeServerImpl::findOrCreateScopedStrike(
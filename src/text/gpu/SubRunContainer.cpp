@@ -1072,7 +1072,8 @@ static std::tuple<AtlasTextOp::MaskType, uint32_t, bool> calculate_sdf_parameter
         const skgpu::ganesh::SurfaceDrawContext& sdc,
         const SkMatrix& drawMatrix,
         bool useLCDText,
-        bool isAntiAliased) {
+        bool isAntiAliased,
+        bool isMultiChannel) {
     const GrColorInfo& colorInfo = sdc.colorInfo();
     const SkSurfaceProps& props = sdc.surfaceProps();
     bool isBGR = SkPixelGeometryIsBGR(props.pixelGeometry());
@@ -1089,6 +1090,7 @@ static std::tuple<AtlasTextOp::MaskType, uint32_t, bool> calculate_sdf_parameter
     DFGPFlags |= useGammaCorrectDistanceTable ? kGammaCorrect_DistanceFieldEffectFlag : 0;
     DFGPFlags |= MT::kAliasedDistanceField == maskType ? kAliased_DistanceFieldEffectFlag : 0;
     DFGPFlags |= drawMatrix.hasPerspective() ? kPerspective_DistanceFieldEffectFlag : 0;
+    DFGPFlags |= isMultiChannel ? kMultiChannel_DistanceFieldEffectFlag : 0;
 
     if (isLCD) {
         DFGPFlags |= kUseLCD_DistanceFieldEffectFlag;
@@ -1118,8 +1120,10 @@ public:
                             const SkMatrix& creationMatrix,
                             SkRect creationBounds,
                             const SDFTMatrixRange& matrixRange,
+                            bool isMultiChannel,
                             SubRunAllocator* alloc) {
-        auto vertexFiller = VertexFiller::Make(MaskFormat::kA8,
+        // Multi-channel distance fields live in the color atlas.
+        auto vertexFiller = VertexFiller::Make(isMultiChannel ? MaskFormat::kARGB : MaskFormat::kA8,
                                                creationMatrix,
                                                creationBounds,
                                                get_positions(accepted),
@@ -1130,7 +1134,7 @@ public:
                 std::move(strikePromise), get_packedIDs(accepted), alloc);
 
         return alloc->makeUnique<SDFTSubRun>(
-                runFont.getEdging() == SkFont::Edging::kSubpixelAntiAlias,
+                !isMultiChannel && runFont.getEdging() == SkFont::Edging::kSubpixelAntiAlias,
                 has_some_antialiasing(runFont),
                 matrixRange,
                 std::move(vertexFiller),
@@ -1145,7 +1149,8 @@ public:
         SDFTMatrixRange matrixRange = SDFTMatrixRange::MakeFromBuffer(buffer);
         auto vertexFiller = VertexFiller::MakeFromBuffer(buffer, alloc);
         if (!buffer.validate(vertexFiller.has_value())) { return nullptr; }
-        if (!buffer.validate(vertexFiller.value().grMaskType() == MaskFormat::kA8)) {
+        if (!buffer.validate(vertexFiller.value().grMaskType() == MaskFormat::kA8 ||
+                             vertexFiller.value().grMaskType() == MaskFormat::kARGB)) {
             return nullptr;
         }
         auto glyphVector = GlyphVector::MakeFromBuffer(buffer, client, alloc);
@@ -1175,10 +1180,7 @@ public:
     }
 
     int glyphCount() const override { return fVertexFiller.count(); }
-    MaskFormat maskFormat() const override {
-        SkASSERT(fVertexFiller.grMaskType() == MaskFormat::kA8);
-        return MaskFormat::kA8;
-    }
+    MaskFormat maskFormat() const override { return fVertexFiller.grMaskType(); }
     int glyphSrcPadding() const override { return SK_DistanceFieldInset; }
 
     SkSpan<const Glyph*> glyphs() const override {
@@ -1186,7 +1188,7 @@ public:
     }
 
     unsigned short instanceFlags() const override {
-        return (unsigned short)MaskFormat::kA8;
+        return (unsigned short)this->maskFormat();
     }
 
     void draw(SkCanvas*,
@@ -1195,7 +1197,8 @@ public:
               sk_sp<SkRefCnt> subRunStorage,
               const AtlasDrawDelegate& drawAtlas) const override {
         drawAtlas(this, drawOrigin, paint, std::move(subRunStorage),
-                  {/* isSDF = */true, /* isLCD = */fUseLCDText});
+                  {/* isSDF = */true, /* isLCD = */fUseLCDText,
+                   /* isMultiChannelSDF = */this->isMultiChannel()});
     }
 
 #if defined(SK_GANESH) || defined(SK_USE_LEGACY_GANESH_TEXT_APIS)
@@ -1220,7 +1223,8 @@ public:
                                                     &grPaint);
 
         auto [maskType, DFGPFlags, useGammaCorrectDistanceTable] =
-                calculate_sdf_parameters(*sdc, viewMatrix, fUseLCDText, fAntiAliased);
+                calculate_sdf_parameters(*sdc, viewMatrix, fUseLCDText, fAntiAliased,
+                                         this->isMultiChannel());
 
         auto geometry = AtlasTextOp::Geometry::Make(*this,
                                                     viewMatrix,
@@ -1266,7 +1270,7 @@ public:
 
     std::tuple<bool, int> regenerateAtlas(int begin, int end,
                                           RegenerateAtlasDelegate regenerateAtlas) const override {
-        return regenerateAtlas(&fGlyphs, begin, end, MaskFormat::kA8, this->glyphSrcPadding());
+        return regenerateAtlas(&fGlyphs, begin, end, this->maskFormat(), this->glyphSrcPadding());
     }
 
     const VertexFiller& vertexFiller() const override { return fVertexFiller; }
@@ -1282,6 +1286,8 @@ protected:
     }
 
 private:
+    bool isMultiChannel() const { return fVertexFiller.grMaskType() == MaskFormat::kARGB; }
+
     const bool fUseLCDText;
     const bool fAntiAliased;
     const SDFTMatrixRange fMatrixRange;
@@ -1487,6 +1493,7 @@ std::tuple<SkZip<const SkPackedGlyphID, const SkPoint, const SkMask::Format>,
            SkRect>
 prepare_for_direct_mask_drawing(StrikeForGPU* strike,
                                 const SkMatrix& positionMatrix,
+                                int maxMaskDimension,
                                 SkZip<const SkGlyphID, const SkPoint> source,
                                 SkZip<SkPackedGlyphID, SkPoint, SkMask::Format> acceptedBuffer,
                                 SkZip<SkGlyphID, SkPoint> rejectedBuffer) {
@@ -1512,6 +1519,13 @@ prepare_for_direct_mask_drawing(StrikeForGPU* strike,
         switch (const SkGlyphDigest digest = strike->digestFor(skglyph::kDirectMask, packedID);
                 digest.actionFor(skglyph::kDirectMask)) {
             case GlyphAction::kAccept: {
+                // Leave large glyphs to be drawn from their paths on the GPU. Color glyphs have
+                // no path, so they are always drawn as masks.
+                if (digest.maxDimension() > maxMaskDimension &&
+                    digest.maskFormat() != SkMask::kARGB32_Format) {
+                    rejectedBuffer[rejectedSize++] = std::make_tuple(glyphID, pos);
+                    break;
+                }
                 const SkPoint roundedPos{SkScalarFloorToScalar(mappedPos.x()),
                                          SkScalarFloorToScalar(mappedPos.y())};
                 const SkGlyphRect glyphBounds = digest.bounds().offset(roundedPos);
@@ -1637,7 +1651,8 @@ make_sdft_strike_spec(const SkFont& font, const SkPaint& paint,
                       const SkPoint& textLocation, const sktext::gpu::SDFTControl& control) {
     // Add filter to the paint which creates the SDFT data for A8 masks.
     SkPaint dfPaint{paint};
-    dfPaint.setMaskFilter(sktext::gpu::SDFMaskFilter::Make());
+    dfPaint.setMaskFilter(control.useMultiChannel() ? sktext::gpu::SDFMaskFilter::MakeMultiChannel()
+                                                    : sktext::gpu::SDFMaskFilter::Make());
 
     auto [dfFont, strikeToSourceScale, matrixRange] = control.getSDFFont(font, deviceMatrix,
                                                                          textLocation);
@@ -1702,6 +1717,8 @@ SubRunContainerOwner SubRunContainer::MakeInAlloc(
 #else
     const SkScalar maxMaskSize = 256;
 #endif
+    const int maxMaskDimension = strikeDeviceInfo.fSDFTControl->maxMaskDimension();
+    const bool outlinesOnly = strikeDeviceInfo.fSDFTControl->outlinesOnly();
 
     // TODO: hoist the buffer structure to the GlyphRunBuilder. The buffer structure here is
     //  still begin tuned, and this is expected to be slower until tuned.
@@ -1739,8 +1756,9 @@ SubRunContainerOwner SubRunContainer::MakeInAlloc(
 
         // Atlas mask cases - SDFT and direct mask
         // Only consider using direct or SDFT drawing if not drawing hairlines and not too big.
+        // When drawing from outlines only, leave the glyphs to the drawable and path cases.
         if ((runPaint.getStyle() != SkPaint::kStroke_Style || runPaint.getStrokeWidth() != 0) &&
-                approximateDeviceTextSize < maxMaskSize) {
+                approximateDeviceTextSize < maxMaskSize && !outlinesOnly) {
 
 #if !defined(SK_DISABLE_SDF_TEXT)
             // SDFT case
@@ -1778,6 +1796,7 @@ SubRunContainerOwner SubRunContainer::MakeInAlloc(
                                 creationMatrix,
                                 creationBounds,
                                 matrixRange,
+                                SDFTControl.useMultiChannel(),
                                 alloc));
                     }
                 }
@@ -1800,7 +1819,8 @@ SubRunContainerOwner SubRunContainer::MakeInAlloc(
                                                 acceptedPositions,
                                                 acceptedFormats);
                 auto [accepted, rejected, creationBounds] = prepare_for_direct_mask_drawing(
-                        strike.get(), positionMatrix, source, acceptedBuffer, rejectedBuffer);
+                        strike.get(), positionMatrix, maxMaskDimension, source, acceptedBuffer,
+                        rejectedBuffer);
                 source = rejected;
 
                 if (creationBehavior == kAddSubRuns && !accepted.empty()) {
@@ -14,6 +14,10 @@ SkCharToGlyphCache::SkCharToGlyphCache() {
 SkCharToGlyphCache::~SkCharToGlyphCache() {}
 
 void SkCharToGlyphCache::reset() {
+    fBMPPageIndex.fill(kNoPage);
+    fPages.clear();
+    fBMPCount = 0;
+
     fK32.reset();
     fV16.reset();
 
@@ -93,6 +97,14 @@ static int find_with_slope(const SkUnichar base[], int count, SkUnichar value, d
 }
 
 int SkCharToGlyphCache::findGlyphIndex(SkUnichar unichar) const {
+    if (0 <= unichar && unichar < 0x10000) {
+        const int glyph = this->findBMPGlyph(unichar);
+        if (glyph >= 0) {
+            return glyph;
+        }
+        // Fall through, since a glyphID of kNotCached is kept in the sorted arrays.
+    }
+
     const int count = fK32.size();
     int index;
     if (count <= kSmallCountLimit) {
@@ -106,7 +118,31 @@ int SkCharToGlyphCache::findGlyphIndex(SkUnichar unichar) const {
     return index;
 }
 
+int SkCharToGlyphCache::findGlyphs(const SkUnichar chars[], int count,
+                                   SkGlyphID glyphs[]) const {
+    for (int i = 0; i < count; ++i) {
+        const int index = this->findGlyphIndex(chars[i]);
+        if (index < 0) {
+            return i;
+        }
+        glyphs[i] = SkToU16(index);
+    }
+    return count;
+}
+
 void SkCharToGlyphCache::insertCharAndGlyph(int index, SkUnichar unichar, SkGlyphID glyph) {
+    if (0 <= unichar && unichar < 0x10000 && glyph != kNotCached) {
+        uint16_t& page = fBMPPageIndex[unichar >> 8];
+        if (page == kNoPage) {
+            page = SkToU16(fPages.size());
+            fPages.push_back().fill(kNotCached);
+        }
+        SkASSERT(fPages[page][unichar & 0xFF] == kNotCached);
+        fPages[page][unichar & 0xFF] = glyph;
+        fBMPCount += 1;
+        return;
+    }
+
     SkASSERT(fK32.size() == fV16.size());
     SkASSERT(index < fK32.size());
     SkASSERT(unichar < fK32[index]);
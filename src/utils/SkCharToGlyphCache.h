@@ -10,8 +10,11 @@
 
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTDArray.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
 
+#include <array>
+
 #include <cstdint>
 
 class SkCharToGlyphCache {
@@ -21,7 +24,12 @@ public:
 
     // return number of unichars cached
     int count() const {
-        return fK32.size();
+        return fBMPCount + fK32.size() - 2;
+    }
+
+    // return the bytes used by the cached entries
+    size_t bytesUsed() const {
+        return fPages.size() * sizeof(Page) + fK32.size() * (sizeof(int32_t) + sizeof(uint16_t));
     }
 
     void reset();       // forget all cache entries (to save memory)
@@ -42,10 +50,17 @@ public:
 
     /**
      *  Insert a new char/glyph pair into the cache at the specified index.
-     *  See charToGlyph() for how to compute the bit-not of the index.
+     *  See charToGlyph() for how to compute the bit-not of the index. The index is not used
+     *  for unichars in the BMP.
      */
     void insertCharAndGlyph(int index, SkUnichar, SkGlyphID);
 
+    /**
+     *  Look up the leading unichars in 'chars', stopping at the first one which isn't cached.
+     *  Returns how many were found, and writes their glyphIDs to 'glyphs'.
+     */
+    int findGlyphs(const SkUnichar chars[], int count, SkGlyphID glyphs[]) const;
+
     // helper to pre-seed an entry in the cache
     void addCharAndGlyph(SkUnichar unichar, SkGlyphID glyph) {
         int index = this->findGlyphIndex(unichar);
@@ -57,6 +72,30 @@ public:
     }
 
 private:
+    // Unichars in the BMP are looked up in a two level table: fBMPPageIndex maps the high byte to
+    // a page (or to kNoPage), and the page maps the low byte to a glyphID (or to kNotCached).
+    // Only the pages which are used are allocated, so the table stays small for text in a few
+    // scripts (e.g. ASCII needs only one page) while lookups don't depend on how many unichars
+    // are cached, as they do for the sorted arrays below.
+    static constexpr uint16_t kNoPage = 0xFFFF;
+    static constexpr uint16_t kNotCached = 0xFFFF;
+    using Page = std::array<uint16_t, 256>;
+
+    int findBMPGlyph(SkUnichar c) const {
+        SkASSERT(0 <= c && c < 0x10000);
+        const uint16_t page = fBMPPageIndex[c >> 8];
+        if (page == kNoPage) {
+            return -1;
+        }
+        const uint16_t glyph = fPages[page][c & 0xFF];
+        return glyph == kNotCached ? -1 : glyph;
+    }
+
+    std::array<uint16_t, 256>    fBMPPageIndex;
+    skia_private::TArray<Page>  fPages;
+    int                         fBMPCount;
+
+    // Unichars outside the BMP, and any glyphID equal to kNotCached, are kept in sorted arrays.
     SkTDArray<int32_t>   fK32;
     SkTDArray<uint16_t>  fV16;
     double               fDenom;
@@ -7,6 +7,7 @@
 
 #include "src/utils/SkDashPathPriv.h"
 
+#include "include/core/SkContourMeasure.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathEffect.h"
@@ -18,10 +19,13 @@
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkAlign.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTo.h"
+#include "src/base/SkTLazy.h"
 #include "src/core/SkPathEnums.h"
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkPointPriv.h"
+#include "src/core/SkResourceCache.h"
 
 #include <algorithm>
 #include <cmath>
@@ -305,6 +309,71 @@ private:
     SkScalar fPathLength;
 };
 
+namespace {
+static unsigned gMeasuredPathKeyNamespaceLabel;
+
+struct MeasuredPathKey : public SkResourceCache::Key {
+public:
+    MeasuredPathKey(const SkPath& path, SkScalar resScale)
+        : fGenID(path.getGenerationID())
+        , fResScale(resScale)
+    {
+        this->init(&gMeasuredPathKeyNamespaceLabel, 0, sizeof(fGenID) + sizeof(fResScale));
+    }
+
+    uint32_t    fGenID;
+    SkScalar    fResScale;
+};
+
+using Contours = skia_private::TArray<sk_sp<SkContourMeasure>>;
+
+struct MeasuredPathRec : public SkResourceCache::Rec {
+    MeasuredPathRec(const MeasuredPathKey& key, const SkPath& path, const Contours& contours)
+        : fKey(key)
+        , fContours(contours)
+        // The measures copy the path's points and add a distance record for every piece a curve
+        // is flattened into, typically a few per point.
+        , fBytesUsed(sizeof(*this) + contours.size() * sizeof(SkContourMeasure) +
+                     4 * path.approximateBytesUsed()) {}
+
+    MeasuredPathKey fKey;
+    Contours        fContours;
+    size_t          fBytesUsed;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return fBytesUsed; }
+    const char* getCategory() const override { return "dash-measure"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const MeasuredPathRec& rec = static_cast<const MeasuredPathRec&>(baseRec);
+        *static_cast<Contours*>(contextData) = rec.fContours;
+        return true;
+    }
+};
+} // namespace
+
+// Measuring the contours is most of the work of dashing a curved path, and doesn't depend on the
+// intervals or the phase. Animated dashes redash the same path every frame with a new phase, so
+// keep the measurements of non-volatile paths around.
+static void measure_contours(const SkPath& path, SkScalar resScale, bool cacheable,
+                             Contours* contours) {
+    SkTLazy<MeasuredPathKey> key;
+    if (cacheable) {
+        key.init(path, resScale);
+        if (SkResourceCache::Find(*key, MeasuredPathRec::Visitor, contours)) {
+            return;
+        }
+    }
+
+    SkContourMeasureIter iter(path, false, resScale);
+    while (sk_sp<SkContourMeasure> contour = iter.next()) {
+        contours->push_back(std::move(contour));
+    }
+
+    if (key.isValid()) {
+        SkResourceCache::Add(new MeasuredPathRec(*key, path, *contours));
+    }
+}
 
 bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
                                 const SkRect* cullRect, const SkScalar aIntervals[],
@@ -383,12 +452,14 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
     bool specialLine = (StrokeRecApplication::kAllow == strokeRecApplication) &&
                        lineRec.init(*srcPtr, dst, rec, count >> 1, intervalLength);
 
-    SkPathMeasure   meas(*srcPtr, false, rec->getResScale());
+    // A culled path is a one-off, so only the measurements of the original path are worth caching.
+    Contours contours;
+    measure_contours(*srcPtr, rec->getResScale(), srcPtr == &src && !src.isVolatile(), &contours);
 
-    do {
-        bool        skipFirstSegment = meas.isClosed();
+    for (const sk_sp<SkContourMeasure>& meas : contours) {
+        bool        skipFirstSegment = meas->isClosed();
         bool        addedSegment = false;
-        SkScalar    length = meas.getLength();
+        SkScalar    length = meas->length();
         int         index = initialDashIndex;
 
         // Since the path length / dash length ratio may be arbitrarily large, we can exert
@@ -422,9 +493,9 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
                                        SkDoubleToScalar(distance + dlen),
                                        dst);
                 } else {
-                    meas.getSegment(SkDoubleToScalar(distance),
-                                    SkDoubleToScalar(distance + dlen),
-                                    dst, true);
+                    (void)meas->getSegment(SkDoubleToScalar(distance),
+                                           SkDoubleToScalar(distance + dlen),
+                                           dst, true);
                 }
             }
             distance += dlen;
@@ -444,12 +515,12 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         }
 
         // extend if we ended on a segment and we need to join up with the (skipped) initial segment
-        if (meas.isClosed() && is_even(initialDashIndex) &&
+        if (meas->isClosed() && is_even(initialDashIndex) &&
             initialDashLength >= 0) {
-            meas.getSegment(0, initialDashLength, dst, !addedSegment);
+            (void)meas->getSegment(0, initialDashLength, dst, !addedSegment);
             ++segCount;
         }
-    } while (meas.nextContour());
+    }
 
     // TODO: do we still need this?
     if (segCount > 1) {
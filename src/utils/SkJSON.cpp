@@ -16,11 +16,13 @@
 #include "include/private/base/SkTo.h"
 #include "include/utils/SkParse.h"
 #include "src/base/SkUTF.h"
+#include "src/base/SkVx.h"
 
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <memory>
 #include <new>
 #include <tuple>
 #include <vector>
@@ -277,6 +279,33 @@ static inline const char* skip_ws(const char* p) {
     return p;
 }
 
+// Skips the 16-char blocks at p which only hold plain string chars (no is_eostring() chars),
+// without reading past p_stop.  This is kept out of line so find_eostring() stays cheap to inline.
+SK_NEVER_INLINE static const char* skip_string_blocks(const char* p, const char* p_stop) {
+    using V = skvx::Vec<16, uint8_t>;
+    while (p_stop - p >= 16) {
+        const V c = V::Load(p);
+        if (any((c < 0x20) | (c == '"') | (c == '\\') | (c == '}') | (c == ']'))) {
+            break;
+        }
+        p += 16;
+    }
+    return p;
+}
+
+// Returns the first string terminator at or after p.  Most strings are short keys, but long
+// strings (e.g. embedded base64 images) make up the bulk of some inputs, and are scanned in blocks.
+static inline const char* find_eostring(const char* p, const char* p_stop) {
+    for (int i = 0; i < 16; ++i, ++p) {
+        if (is_eostring(*p)) {
+            return p;
+        }
+    }
+
+    for (p = skip_string_blocks(p, p_stop); !is_eostring(*p); ++p);
+    return p;
+}
+
 static inline float pow10(int32_t exp) {
     static constexpr float g_pow10_table[63] =
     {
@@ -704,7 +733,7 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            p = find_eostring(p + 1, p_stop);
 
             if (*p == '"') {
                 // Valid string found.
@@ -907,6 +936,206 @@ void Write(const Value& v, SkWStream* stream) {
     }
 }
 
+// The binary DOM format is a 4-byte magic and a 32-bit version, followed by the root value.
+// Each value is a one byte tag followed by its payload, all little-endian:
+//
+//   null, false, true:  no payload
+//   int, float:         4 bytes
+//   string:             uint32 length, then the (unterminated) chars
+//   array:              uint32 count, then count values
+//   object:             uint32 count, then count untagged string keys, each followed by a value
+//
+// Loading it still builds a regular DOM, but there is no tokenizing, unescaping or number parsing.
+enum class BinaryTag : uint8_t {
+    kNull,
+    kFalse,
+    kTrue,
+    kInt,
+    kFloat,
+    kString,
+    kArray,
+    kObject,
+};
+
+static constexpr char     kBinaryMagic[4] = { 's', 'k', 'j', 'b' };
+static constexpr uint32_t kBinaryVersion  = 1;
+static constexpr size_t   kBinaryHeaderSize = sizeof(kBinaryMagic) + sizeof(kBinaryVersion);
+
+// Deeper nesting is rejected when loading, to bound the reader's recursion.
+static constexpr int kMaxBinaryDepth = 1024;
+
+void WriteBinaryString(const StringValue& str, SkWStream* stream) {
+    stream->write32(SkToU32(str.size()));
+    stream->write(str.begin(), str.size());
+}
+
+void WriteBinary(const Value& v, SkWStream* stream) {
+    switch (v.getType()) {
+    case Value::Type::kNull:
+        stream->write8(SkToU8(BinaryTag::kNull));
+        break;
+    case Value::Type::kBool:
+        stream->write8(SkToU8(*v.as<BoolValue>() ? BinaryTag::kTrue : BinaryTag::kFalse));
+        break;
+    case Value::Type::kNumber: {
+        // Numbers are stored as either int32 or float, so the double always converts back
+        // exactly to one of them.
+        const double d = *v.as<NumberValue>();
+        if (d >= std::numeric_limits<int32_t>::min() &&
+            d <= std::numeric_limits<int32_t>::max() &&
+            d == static_cast<int32_t>(d)) {
+            const int32_t i = static_cast<int32_t>(d);
+            stream->write8(SkToU8(BinaryTag::kInt));
+            stream->write(&i, sizeof(i));
+        } else {
+            const float f = static_cast<float>(d);
+            stream->write8(SkToU8(BinaryTag::kFloat));
+            stream->write(&f, sizeof(f));
+        }
+        break;
+    }
+    case Value::Type::kString:
+        stream->write8(SkToU8(BinaryTag::kString));
+        WriteBinaryString(v.as<StringValue>(), stream);
+        break;
+    case Value::Type::kArray: {
+        const auto& array = v.as<ArrayValue>();
+        stream->write8(SkToU8(BinaryTag::kArray));
+        stream->write32(SkToU32(array.size()));
+        for (const auto& entry : array) {
+            WriteBinary(entry, stream);
+        }
+        break;
+    }
+    case Value::Type::kObject:
+        const auto& object = v.as<ObjectValue>();
+        stream->write8(SkToU8(BinaryTag::kObject));
+        stream->write32(SkToU32(object.size()));
+        for (const auto& member : object) {
+            WriteBinaryString(member.fKey, stream);
+            WriteBinary(member.fValue, stream);
+        }
+        break;
+    }
+}
+
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* data, size_t size, SkArenaAlloc& alloc)
+        : fAlloc(alloc)
+        , fPtr(data)
+        , fEnd(data + size) {
+        fValueStack.reserve(kValueStackReserve);
+    }
+
+    Value read() {
+        if (!this->readValue(0) || fPtr != fEnd) {
+            return NullValue();
+        }
+        SkASSERT(fValueStack.size() == 1);
+        return fValueStack.front();
+    }
+
+private:
+    template <typename T>
+    bool readRaw(T* v) {
+        if (SkToSizeT(fEnd - fPtr) < sizeof(T)) {
+            return false;
+        }
+        memcpy(v, fPtr, sizeof(T));
+        fPtr += sizeof(T);
+        return true;
+    }
+
+    bool readString() {
+        uint32_t size;
+        if (!this->readRaw(&size) || size > SkToSizeT(fEnd - fPtr)) {
+            return false;
+        }
+        // The length prefix makes it safe for FastString to peek at the byte before the chars.
+        const char* chars = reinterpret_cast<const char*>(fPtr);
+        fValueStack.push_back(FastString(chars, size, reinterpret_cast<const char*>(fEnd),
+                                         fAlloc));
+        fPtr += size;
+        return true;
+    }
+
+    template <typename VectorT>
+    void popScopeAsVec(size_t scope_start, size_t count) {
+        using T = typename VectorT::ValueT;
+        const auto* begin = reinterpret_cast<const T*>(fValueStack.data() + scope_start);
+        const Value vec = VectorT(begin, count, fAlloc);
+        fValueStack.resize(scope_start);
+        fValueStack.push_back(vec);
+    }
+
+    bool readValue(int depth) {
+        uint8_t tag;
+        if (!this->readRaw(&tag)) {
+            return false;
+        }
+
+        switch (static_cast<BinaryTag>(tag)) {
+        case BinaryTag::kNull:
+            fValueStack.push_back(NullValue());
+            return true;
+        case BinaryTag::kFalse:
+        case BinaryTag::kTrue:
+            fValueStack.push_back(BoolValue(static_cast<BinaryTag>(tag) == BinaryTag::kTrue));
+            return true;
+        case BinaryTag::kInt: {
+            int32_t i;
+            if (!this->readRaw(&i)) {
+                return false;
+            }
+            fValueStack.push_back(NumberValue(i));
+            return true;
+        }
+        case BinaryTag::kFloat: {
+            float f;
+            if (!this->readRaw(&f)) {
+                return false;
+            }
+            fValueStack.push_back(NumberValue(f));
+            return true;
+        }
+        case BinaryTag::kString:
+            return this->readString();
+        case BinaryTag::kArray:
+        case BinaryTag::kObject: {
+            const bool is_object = static_cast<BinaryTag>(tag) == BinaryTag::kObject;
+            uint32_t count;
+            // Every entry takes at least one byte, which bounds counts in truncated input.
+            if (depth >= kMaxBinaryDepth || !this->readRaw(&count) ||
+                count > SkToSizeT(fEnd - fPtr)) {
+                return false;
+            }
+            const size_t scope_start = fValueStack.size();
+            for (uint32_t i = 0; i < count; ++i) {
+                if ((is_object && !this->readString()) || !this->readValue(depth + 1)) {
+                    return false;
+                }
+            }
+            if (is_object) {
+                this->popScopeAsVec<ObjectValue>(scope_start, count);
+            } else {
+                this->popScopeAsVec<ArrayValue>(scope_start, count);
+            }
+            return true;
+        }
+        }
+
+        return false;
+    }
+
+    SkArenaAlloc&      fAlloc;
+    const uint8_t*     fPtr;
+    const uint8_t*     fEnd;
+
+    inline static constexpr size_t kValueStackReserve = 256;
+    std::vector<Value> fValueStack;
+};
+
 } // namespace
 
 SkString Value::toString() const {
@@ -930,4 +1159,40 @@ void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
 
+bool DOM::IsBinary(const void* data, size_t size) {
+    return size >= kBinaryHeaderSize && !memcmp(data, kBinaryMagic, sizeof(kBinaryMagic));
+}
+
+std::unique_ptr<DOM> DOM::MakeFromBinary(const void* data, size_t size) {
+    uint32_t version;
+    if (!IsBinary(data, size)) {
+        return nullptr;
+    }
+    memcpy(&version, static_cast<const uint8_t*>(data) + sizeof(kBinaryMagic), sizeof(version));
+    if (version != kBinaryVersion) {
+        return nullptr;
+    }
+
+    std::unique_ptr<DOM> dom(new DOM());
+    BinaryReader reader(static_cast<const uint8_t*>(data) + kBinaryHeaderSize,
+                        size - kBinaryHeaderSize,
+                        dom->fAlloc);
+    dom->fRoot = reader.read();
+
+    // Like the text parser, the reader returns a null root on failure.
+    if (dom->fRoot.is<NullValue>()) {
+        return nullptr;
+    }
+
+    return dom;
+}
+
+void DOM::writeBinary(SkWStream* stream) const {
+    stream->write(kBinaryMagic, sizeof(kBinaryMagic));
+    stream->write32(kBinaryVersion);
+    WriteBinary(fRoot, stream);
+}
+
+DOM::DOM() : fAlloc(kMinChunkSize) {}
+
 } // namespace skjson
@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string_view>
 
 class SkString;
@@ -341,11 +342,30 @@ class DOM final : public SkNoncopyable {
 public:
     DOM(const char*, size_t);
 
+    /**
+     * Returns true if the data starts with the header written by writeBinary().
+     */
+    static bool IsBinary(const void*, size_t);
+
+    /**
+     * Loads a DOM from the binary form produced by writeBinary(), which is much faster than
+     * parsing the equivalent JSON text.  Returns null if the data is truncated or malformed.
+     */
+    static std::unique_ptr<DOM> MakeFromBinary(const void*, size_t);
+
     const Value& root() const { return fRoot; }
 
     void write(SkWStream*) const;
 
+    /**
+     * Writes the DOM in a compact binary form.  Numbers are stored as int32 or float, exactly as
+     * the DOM holds them, so the result can be loaded back without any loss.
+     */
+    void writeBinary(SkWStream*) const;
+
 private:
+    DOM();
+
     SkArenaAlloc fAlloc;
     Value        fRoot;
 };
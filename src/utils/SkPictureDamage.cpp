@@ -0,0 +1,582 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkPictureDamage.h"
+
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkClipOp.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageFilter.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRSXform.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkSpan.h"
+#include "include/core/SkTextBlob.h"
+#include "include/core/SkTypeface.h"
+#include "include/core/SkVertices.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "include/utils/SkNoDrawCanvas.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkCanvasPriv.h"
+#include "src/core/SkChecksum.h"
+#include "src/core/SkDrawShadowInfo.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecords.h"
+#include "src/core/SkTextBlobPriv.h"
+#include "src/core/SkWriteBuffer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+using namespace skia_private;
+
+/*
+ *  Each draw of a picture is reduced to a 64 bit key that hashes everything that affects its
+ *  pixels: the draw's arguments and paint, the matrix, and every clip in effect. Drawing the
+ *  pictures into a canvas does the bookkeeping of the matrix and clip stacks for us. The keys of
+ *  the two pictures are then matched up in order, and whatever is left over is damage.
+ */
+
+namespace {
+
+// Images, typefaces and pictures would otherwise be encoded or serialized into the key. Their
+// unique IDs are much cheaper and identify them just as well.
+template <typename T>
+sk_sp<SkData> serialize_id(T* obj, void*) {
+    const uint32_t id = obj->uniqueID();
+    return SkData::MakeWithCopy(&id, sizeof(id));
+}
+
+class HashingCanvas final : public SkNoDrawCanvas {
+public:
+    explicit HashingCanvas(const SkIRect& bounds) : SkNoDrawCanvas(bounds) {
+        fProcs.fImageProc = serialize_id<SkImage>;
+        fProcs.fTypefaceProc = serialize_id<SkTypeface>;
+        fProcs.fPictureProc = serialize_id<SkPicture>;
+    }
+
+    // Starts a new op of the given type.
+    void beginOp(SkRecords::Type type) {
+        fType = type;
+        fHashed = false;
+    }
+    // Returns whether the current op was hashed, and its hash if it was.
+    bool opHash(uint64_t* hash) const {
+        *hash = fHash;
+        return fHashed;
+    }
+
+protected:
+    void willSave() override { fSavedStates.push_back(fState); }
+    SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+        fSavedStates.push_back(fState);
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            write_optional(buffer, rec.fBounds);
+            write_optional(buffer, rec.fPaint);
+            buffer.writeFlattenable(rec.fBackdrop);
+            buffer.writeUInt(rec.fSaveLayerFlags);
+            buffer.writeScalar(SkCanvasPriv::GetBackdropScaleFactor(rec));
+            buffer.writeUInt(SkToU32(rec.fFilters.size()));
+            for (const sk_sp<SkImageFilter>& filter : rec.fFilters) {
+                buffer.writeFlattenable(filter.get());
+            }
+        });
+        return this->INHERITED::getSaveLayerStrategy(rec);
+    }
+    bool onDoSaveBehind(const SkRect* subset) override {
+        this->hashOp([&](SkWriteBuffer& buffer) { write_optional(buffer, subset); });
+        return this->INHERITED::onDoSaveBehind(subset);
+    }
+    void willRestore() override {
+        if (!fSavedStates.empty()) {
+            fState = fSavedStates.back();
+            fSavedStates.pop_back();
+        }
+    }
+
+    void onClipRect(const SkRect& rect, SkClipOp op, ClipEdgeStyle edgeStyle) override {
+        this->hashClip(op, edgeStyle, [&](SkWriteBuffer& buffer) { buffer.writeRect(rect); });
+        this->INHERITED::onClipRect(rect, op, edgeStyle);
+    }
+    void onClipRRect(const SkRRect& rrect, SkClipOp op, ClipEdgeStyle edgeStyle) override {
+        this->hashClip(op, edgeStyle, [&](SkWriteBuffer& buffer) { write_rrect(buffer, rrect); });
+        this->INHERITED::onClipRRect(rrect, op, edgeStyle);
+    }
+    void onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle edgeStyle) override {
+        this->hashClip(op, edgeStyle, [&](SkWriteBuffer& buffer) { buffer.writePath(path); });
+        this->INHERITED::onClipPath(path, op, edgeStyle);
+    }
+    void onClipShader(sk_sp<SkShader> shader, SkClipOp op) override {
+        this->hashClip(op, kHard_ClipEdgeStyle, [&](SkWriteBuffer& buffer) {
+            buffer.writeFlattenable(shader.get());
+        });
+        this->INHERITED::onClipShader(std::move(shader), op);
+    }
+    void onClipRegion(const SkRegion& deviceRgn, SkClipOp op) override {
+        this->hashClip(op, kHard_ClipEdgeStyle, [&](SkWriteBuffer& buffer) {
+            buffer.writeRegion(deviceRgn);
+        });
+        this->INHERITED::onClipRegion(deviceRgn, op);
+    }
+    void onResetClip() override {
+        this->hashClip(SkClipOp::kIntersect, kHard_ClipEdgeStyle, [](SkWriteBuffer&) {});
+        this->INHERITED::onResetClip();
+    }
+
+    void onDrawPaint(const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) { buffer.writePaint(paint); });
+    }
+    void onDrawBehind(const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) { buffer.writePaint(paint); });
+    }
+    void onDrawRect(const SkRect& rect, const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeRect(rect);
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawRRect(const SkRRect& rrect, const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            write_rrect(buffer, rrect);
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawDRRect(const SkRRect& outer, const SkRRect& inner, const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            write_rrect(buffer, outer);
+            write_rrect(buffer, inner);
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawOval(const SkRect& rect, const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeRect(rect);
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawArc(const SkRect& rect, SkScalar startAngle, SkScalar sweepAngle, bool useCenter,
+                   const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeRect(rect);
+            buffer.writeScalar(startAngle);
+            buffer.writeScalar(sweepAngle);
+            buffer.writeBool(useCenter);
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawPath(const SkPath& path, const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writePath(path);
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawRegion(const SkRegion& region, const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeRegion(region);
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                        const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            SkTextBlobPriv::Flatten(*blob, buffer);
+            buffer.writePoint({x, y});
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawPatch(const SkPoint cubics[12], const SkColor colors[4], const SkPoint texCoords[4],
+                     SkBlendMode mode, const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writePointArray(cubics, 12);
+            buffer.writeColorArray(colors, colors ? 4 : 0);
+            buffer.writePointArray(texCoords, texCoords ? 4 : 0);
+            buffer.writeUInt(SkToU32(mode));
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawPoints(PointMode mode, size_t count, const SkPoint pts[],
+                      const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeUInt(SkToU32(mode));
+            buffer.writePointArray(pts, SkToU32(count));
+            buffer.writePaint(paint);
+        });
+    }
+
+    void onDrawImage2(const SkImage* image, SkScalar x, SkScalar y,
+                      const SkSamplingOptions& sampling, const SkPaint* paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeUInt(image->uniqueID());
+            buffer.writePoint({x, y});
+            buffer.writeSampling(sampling);
+            write_optional(buffer, paint);
+        });
+    }
+    void onDrawImageRect2(const SkImage* image, const SkRect& src, const SkRect& dst,
+                          const SkSamplingOptions& sampling, const SkPaint* paint,
+                          SrcRectConstraint constraint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeUInt(image->uniqueID());
+            buffer.writeRect(src);
+            buffer.writeRect(dst);
+            buffer.writeSampling(sampling);
+            write_optional(buffer, paint);
+            buffer.writeUInt(constraint);
+        });
+    }
+    void onDrawImageLattice2(const SkImage* image, const Lattice& lattice, const SkRect& dst,
+                             SkFilterMode filter, const SkPaint* paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeUInt(image->uniqueID());
+            buffer.writeIntArray(lattice.fXDivs, lattice.fXCount);
+            buffer.writeIntArray(lattice.fYDivs, lattice.fYCount);
+            const int cells = (lattice.fXCount + 1) * (lattice.fYCount + 1);
+            buffer.writeByteArray(lattice.fRectTypes, lattice.fRectTypes ? cells : 0);
+            buffer.writeColorArray(lattice.fColors, lattice.fColors ? cells : 0);
+            write_optional(buffer, lattice.fBounds);
+            buffer.writeRect(dst);
+            buffer.writeUInt(SkToU32(filter));
+            write_optional(buffer, paint);
+        });
+    }
+    void onDrawAtlas2(const SkImage* image, const SkRSXform xforms[], const SkRect src[],
+                      const SkColor colors[], int count, SkBlendMode mode,
+                      const SkSamplingOptions& sampling, const SkRect* cull,
+                      const SkPaint* paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeUInt(image->uniqueID());
+            buffer.writeByteArray(xforms, count * sizeof(SkRSXform));
+            buffer.writeByteArray(src, count * sizeof(SkRect));
+            buffer.writeColorArray(colors, colors ? count : 0);
+            buffer.writeUInt(SkToU32(mode));
+            buffer.writeSampling(sampling);
+            write_optional(buffer, cull);
+            write_optional(buffer, paint);
+        });
+    }
+    void onDrawEdgeAAImageSet2(const ImageSetEntry set[], int count, const SkPoint dstClips[],
+                               const SkMatrix preViewMatrices[],
+                               const SkSamplingOptions& sampling, const SkPaint* paint,
+                               SrcRectConstraint constraint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            int clipCount = 0;
+            int matrixCount = 0;
+            buffer.writeInt(count);
+            for (int i = 0; i < count; ++i) {
+                buffer.writeUInt(set[i].fImage->uniqueID());
+                buffer.writeRect(set[i].fSrcRect);
+                buffer.writeRect(set[i].fDstRect);
+                buffer.writeInt(set[i].fMatrixIndex);
+                buffer.writeScalar(set[i].fAlpha);
+                buffer.writeUInt(set[i].fAAFlags);
+                buffer.writeBool(set[i].fHasClip);
+                clipCount += set[i].fHasClip ? 4 : 0;
+                matrixCount = std::max(matrixCount, set[i].fMatrixIndex + 1);
+            }
+            buffer.writePointArray(dstClips, clipCount);
+            for (int i = 0; i < matrixCount; ++i) {
+                buffer.writeMatrix(preViewMatrices[i]);
+            }
+            buffer.writeSampling(sampling);
+            write_optional(buffer, paint);
+            buffer.writeUInt(constraint);
+        });
+    }
+
+    void onDrawVerticesObject(const SkVertices* vertices, SkBlendMode mode,
+                              const SkPaint& paint) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeUInt(vertices->uniqueID());
+            buffer.writeUInt(SkToU32(mode));
+            buffer.writePaint(paint);
+        });
+    }
+    void onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writePath(path);
+            buffer.writePoint3(rec.fZPlaneParams);
+            buffer.writePoint3(rec.fLightPos);
+            buffer.writeScalar(rec.fLightRadius);
+            buffer.writeColor(rec.fAmbientColor);
+            buffer.writeColor(rec.fSpotColor);
+            buffer.writeUInt(rec.fFlags);
+        });
+    }
+    void onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                       const SkPaint* paint) override {
+        // Drawables are played back as pictures too, so this covers both.
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeUInt(picture->uniqueID());
+            buffer.writeBool(matrix != nullptr);
+            if (matrix) {
+                buffer.writeMatrix(*matrix);
+            }
+            write_optional(buffer, paint);
+        });
+    }
+    void onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4], QuadAAFlags aaFlags,
+                          const SkColor4f& color, SkBlendMode mode) override {
+        this->hashOp([&](SkWriteBuffer& buffer) {
+            buffer.writeRect(rect);
+            buffer.writePointArray(clip, clip ? 4 : 0);
+            buffer.writeUInt(aaFlags);
+            buffer.writeColor4f(color);
+            buffer.writeUInt(SkToU32(mode));
+        });
+    }
+
+    // Meshes and slugs are left unhashed, so they always count as damage.
+
+private:
+    static void write_rrect(SkWriteBuffer& buffer, const SkRRect& rrect) {
+        char storage[SkRRect::kSizeInMemory];
+        rrect.writeToMemory(storage);
+        buffer.writePad32(storage, sizeof(storage));
+    }
+    static void write_optional(SkWriteBuffer& buffer, const SkRect* rect) {
+        buffer.writeBool(rect != nullptr);
+        if (rect) {
+            buffer.writeRect(*rect);
+        }
+    }
+    static void write_optional(SkWriteBuffer& buffer, const SkIRect* rect) {
+        buffer.writeBool(rect != nullptr);
+        if (rect) {
+            buffer.writeIRect(*rect);
+        }
+    }
+    static void write_optional(SkWriteBuffer& buffer, const SkPaint* paint) {
+        buffer.writeBool(paint != nullptr);
+        if (paint) {
+            buffer.writePaint(*paint);
+        }
+    }
+
+    // Hashes whatever 'write' writes, along with the current matrix, into a key seeded by 'seed'.
+    template <typename Fn>
+    uint64_t hash(uint64_t seed, uint32_t tag, Fn&& write) {
+        // Most ops fit in the stack storage, so they can be hashed without copying them.
+        char storage[1024];
+        SkBinaryWriteBuffer buffer(storage, sizeof(storage), fProcs);
+        buffer.writeUInt(tag);
+        buffer.write(this->getLocalToDevice());
+        write(buffer);
+        if (buffer.usingInitialStorage()) {
+            return SkChecksum::Hash64(storage, buffer.bytesWritten(), seed);
+        }
+        sk_sp<SkData> data = buffer.snapshotAsData();
+        return SkChecksum::Hash64(data->data(), data->size(), seed);
+    }
+
+    template <typename Fn>
+    void hashOp(Fn&& write) {
+        fHash = this->hash(fState, fType, std::forward<Fn>(write));
+        fHashed = true;
+    }
+
+    template <typename Fn>
+    void hashClip(SkClipOp op, ClipEdgeStyle edgeStyle, Fn&& write) {
+        const uint32_t tag = (SkToU32(op) << 1) | (edgeStyle == kSoft_ClipEdgeStyle);
+        fState = this->hash(fState, tag, std::forward<Fn>(write));
+    }
+
+    SkSerialProcs fProcs;
+
+    // Hash of the clip stack. Ops are seeded with it, so a draw under a different clip never
+    // matches.
+    uint64_t fState = 0;
+    TArray<uint64_t, true> fSavedStates;
+
+    SkRecords::Type fType = SkRecords::NoOp_Type;
+    uint64_t fHash = 0;
+    bool fHashed = false;
+
+    using INHERITED = SkNoDrawCanvas;
+};
+
+struct Op {
+    uint64_t fKey;
+    bool fMatchable;
+    SkIRect fBounds;
+};
+
+struct TypeAndTags {
+    template <typename T>
+    std::pair<SkRecords::Type, int> operator()(const T&) const {
+        return {T::kType, T::kTags};
+    }
+};
+
+// Lists the ops of 'picture', whose nested pictures are 'drawablePicts', that may change pixels,
+// in drawing order.
+void collect_ops(const SkBigPicture& picture,
+                 SkSpan<const SkPicture* const> drawablePicts,
+                 const SkIRect& canvasBounds,
+                 uint64_t* uniqueKey,
+                 TArray<Op>* ops) {
+    const SkRecord& record = *picture.record();
+    const int count = record.count();
+
+    AutoTArray<SkRect> bounds(count);
+    SkRecordFillBounds(picture.cullRect(), record, bounds.data(), nullptr);
+
+    HashingCanvas canvas(canvasBounds);
+    SkRecords::Draw draw(&canvas, drawablePicts.data(), nullptr, SkToInt(drawablePicts.size()));
+    for (int i = 0; i < count; ++i) {
+        const auto [type, tags] = record.visit(i, TypeAndTags());
+        canvas.beginOp(type);
+        record.visit(i, draw);
+
+        const bool draws = (tags & SkRecords::kDraw_Tag) || type == SkRecords::SaveLayer_Type ||
+                           type == SkRecords::SaveBehind_Type;
+        if (!draws || bounds[i].isEmpty()) {
+            continue;
+        }
+        Op& op = ops->push_back();
+        op.fMatchable = canvas.opHash(&op.fKey);
+        if (!op.fMatchable) {
+            op.fKey = (*uniqueKey)++;
+        }
+        op.fBounds = bounds[i].roundOut();
+    }
+}
+
+bool same(const Op& a, const Op& b) {
+    return a.fMatchable && b.fMatchable && a.fKey == b.fKey;
+}
+
+// Marks the ops of 'a' and 'b' that belong to a longest common subsequence of the two.
+void match_ops(SkSpan<const Op> a, SkSpan<const Op> b, bool aMatched[], bool bMatched[]) {
+    // Frames usually change in a few places, so most ops are taken care of here.
+    size_t prefix = 0;
+    while (prefix < a.size() && prefix < b.size() && same(a[prefix], b[prefix])) {
+        aMatched[prefix] = bMatched[prefix] = true;
+        ++prefix;
+    }
+    size_t suffix = 0;
+    while (suffix < a.size() - prefix && suffix < b.size() - prefix &&
+           same(a[a.size() - 1 - suffix], b[b.size() - 1 - suffix])) {
+        aMatched[a.size() - 1 - suffix] = bMatched[b.size() - 1 - suffix] = true;
+        ++suffix;
+    }
+    a = a.subspan(prefix, a.size() - prefix - suffix);
+    b = b.subspan(prefix, b.size() - prefix - suffix);
+    aMatched += prefix;
+    bMatched += prefix;
+
+    const size_t n = a.size(), m = b.size();
+    if (n == 0 || m == 0) {
+        return;
+    }
+    // The LCS table is quadratic. Past this size, pair the remaining ops up by position instead,
+    // which is still correct but gives up on draws that moved.
+    static constexpr size_t kMaxTableSize = 1 << 20;
+    if (n * m > kMaxTableSize) {
+        for (size_t i = 0; i < std::min(n, m); ++i) {
+            aMatched[i] = bMatched[i] = same(a[i], b[i]);
+        }
+        return;
+    }
+
+    // lcs[i*(m+1) + j] is the length of the LCS of a[i:] and b[j:]. It is at most
+    // min(n, m) <= 1024, so 16 bits are enough.
+    const size_t stride = m + 1;
+    AutoTMalloc<uint16_t> lcs((n + 1) * stride);
+    for (size_t j = 0; j <= m; ++j) {
+        lcs[n * stride + j] = 0;
+    }
+    for (size_t i = n; i-- > 0;) {
+        lcs[i * stride + m] = 0;
+        for (size_t j = m; j-- > 0;) {
+            lcs[i * stride + j] = same(a[i], b[j])
+                    ? lcs[(i + 1) * stride + j + 1] + 1
+                    : std::max(lcs[(i + 1) * stride + j], lcs[i * stride + j + 1]);
+        }
+    }
+    for (size_t i = 0, j = 0; i < n && j < m;) {
+        if (same(a[i], b[j])) {
+            aMatched[i++] = bMatched[j++] = true;
+        } else if (lcs[(i + 1) * stride + j] >= lcs[i * stride + j + 1]) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+}
+
+}  // namespace
+
+SkRegion SkPictureDamage::Compute(const SkPicture* before, const SkPicture* after) {
+    if (!before || !after) {
+        const SkPicture* picture = before ? before : after;
+        return picture ? SkRegion(picture->cullRect().roundOut()) : SkRegion();
+    }
+    if (before->uniqueID() == after->uniqueID()) {
+        return SkRegion();
+    }
+
+    SkRect cull = before->cullRect();
+    cull.join(after->cullRect());
+    const SkIRect everything = cull.roundOut();
+
+    // Draws that can't be hashed get keys that are never matched.
+    uint64_t uniqueKey = 0;
+    // Returns false if the picture can't be broken down into ops.
+    auto collect = [&](const SkPicture* picture, TArray<Op>* ops) {
+        if (picture->approximateOpCount() == 0) {
+            return true;
+        }
+        const SkBigPicture* big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture));
+        if (!big) {
+            return false;
+        }
+        collect_ops(*big, {big->drawablePicts(), SkToSizeT(big->drawableCount())}, everything,
+                    &uniqueKey, ops);
+        return true;
+    };
+    TArray<Op> beforeOps, afterOps;
+    if (!collect(before, &beforeOps) || !collect(after, &afterOps)) {
+        return SkRegion(everything);
+    }
+
+    AutoTMalloc<bool> beforeMatched(beforeOps.size()), afterMatched(afterOps.size());
+    std::fill_n(beforeMatched.get(), beforeOps.size(), false);
+    std::fill_n(afterMatched.get(), afterOps.size(), false);
+    match_ops(beforeOps, afterOps, beforeMatched.get(), afterMatched.get());
+
+    TArray<SkIRect, true> damage;
+    for (int i = 0; i < beforeOps.size(); ++i) {
+        if (!beforeMatched[i]) {
+            damage.push_back(beforeOps[i].fBounds);
+        }
+    }
+    for (int i = 0; i < afterOps.size(); ++i) {
+        if (!afterMatched[i]) {
+            damage.push_back(afterOps[i].fBounds);
+        }
+    }
+    SkRegion region;
+    region.setRects(damage.data(), damage.size());
+    return region;
+}
@@ -568,6 +568,22 @@ void SkShadowUtils::DrawShadow(SkCanvas* canvas, const SkPath& path, const SkPoi
     canvas->private_draw_shadow_rec(path, rec);
 }
 
+void SkShadowUtils::DrawShadows(SkCanvas* canvas, const SkPath paths[],
+                                const SkPoint3 zPlaneParams[], int count,
+                                const SkPoint3& lightPos, SkScalar lightRadius,
+                                SkColor ambientColor, SkColor spotColor, uint32_t flags) {
+    const SkMatrix ctm = canvas->getTotalMatrix();
+    for (int i = 0; i < count; ++i) {
+        SkDrawShadowRec rec;
+        if (!fill_shadow_rec(paths[i], zPlaneParams[i], lightPos, lightRadius, ambientColor,
+                             spotColor, flags, ctm, &rec)) {
+            return;
+        }
+
+        canvas->private_draw_shadow_rec(paths[i], rec);
+    }
+}
+
 bool SkShadowUtils::GetLocalBounds(const SkMatrix& ctm, const SkPath& path,
                                    const SkPoint3& zPlaneParams, const SkPoint3& lightPos,
                                    SkScalar lightRadius, uint32_t flags, SkRect* bounds) {
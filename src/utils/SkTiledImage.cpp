@@ -0,0 +1,343 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkTiledImage.h"
+
+#include "include/codec/SkAndroidCodec.h"
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
+#include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "include/private/base/SkTFitsIn.h"
+#include "src/core/SkLRUCache.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+using namespace skia_private;
+
+class SkTiledImage::Impl {
+public:
+    // The index used for the placeholder in the decode queue.
+    static constexpr int kPlaceholder = -1;
+
+    Impl(std::unique_ptr<SkAndroidCodec> codec, const Options& options, int tileSize)
+            : fCodec(std::move(codec))
+            , fTileSize(tileSize)
+            , fTilesX((fCodec->getInfo().width() + tileSize - 1) / tileSize)
+            , fTilesY((fCodec->getInfo().height() + tileSize - 1) / tileSize)
+            , fMaxResidentTiles(std::max(options.fMaxResidentTiles, 1))
+            , fTiles(fMaxResidentTiles)
+            , fTasks(options.fExecutor ? *options.fExecutor : SkExecutor::GetDefault()) {
+        fColorType = fCodec->computeOutputColorType(kN32_SkColorType);
+        fAlphaType = fCodec->computeOutputAlphaType(/*requestedUnpremul=*/false);
+        fColorSpace = fCodec->computeOutputColorSpace(fColorType);
+
+        if (options.fPlaceholderSize > 0) {
+            const SkISize dims = fCodec->getInfo().dimensions();
+            fPlaceholderSampleSize =
+                    std::max(std::max(dims.width(), dims.height()) / options.fPlaceholderSize, 1);
+        }
+    }
+
+    ~Impl() {
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            fQueue.clear();
+        }
+        fTasks.wait();
+    }
+
+    SkISize dimensions() const { return fCodec->getInfo().dimensions(); }
+
+    int residentTileCount() const { return fTiles.count(); }
+
+    void waitForPendingDecodes() {
+        fTasks.wait();
+        this->collectDecoded();
+    }
+
+    bool draw(SkCanvas* canvas,
+              const SkRect& src,
+              const SkRect& dst,
+              const SkSamplingOptions& sampling,
+              const SkPaint* paint) {
+        if (src.isEmpty() || dst.isEmpty()) {
+            return true;
+        }
+        const SkMatrix srcToDst = SkMatrix::RectToRect(src, dst);
+        SkMatrix dstToSrc;
+        if (!srcToDst.invert(&dstToSrc)) {
+            return true;
+        }
+        SkRect clippedSrc = src;
+        if (!clippedSrc.intersect(SkRect::Make(this->dimensions()))) {
+            return true;
+        }
+        SkRect visible = dstToSrc.mapRect(canvas->getLocalClipBounds());
+        if (!visible.intersect(clippedSrc)) {
+            return true;
+        }
+
+        SkIRect tiles = SkIRect::MakeLTRB(
+                sk_float_floor2int(visible.fLeft / fTileSize),
+                sk_float_floor2int(visible.fTop / fTileSize),
+                sk_float_ceil2int(visible.fRight / fTileSize),
+                sk_float_ceil2int(visible.fBottom / fTileSize));
+        if (!tiles.intersect(SkIRect::MakeWH(fTilesX, fTilesY))) {
+            return true;
+        }
+
+        // Make room for every visible tile, so that decoding one doesn't evict another.
+        fTiles.setMaxCount(std::max(fMaxResidentTiles, tiles.width() * tiles.height()));
+        this->collectDecoded();
+
+        TArray<int> missing;
+        bool complete = true;
+        for (int y = tiles.fTop; y < tiles.fBottom; ++y) {
+            for (int x = tiles.fLeft; x < tiles.fRight; ++x) {
+                const int index = y * fTilesX + x;
+                const SkIRect tileRect = this->tileRect(index);
+                SkRect tileSrc = SkRect::Make(tileRect);
+                if (!tileSrc.intersect(clippedSrc)) {
+                    continue;
+                }
+                const SkRect tileDst = srcToDst.mapRect(tileSrc);
+
+                if (sk_sp<SkImage>* tile = fTiles.find(index)) {
+                    canvas->drawImageRect(tile->get(),
+                                          tileSrc.makeOffset(-tileRect.fLeft, -tileRect.fTop),
+                                          tileDst,
+                                          sampling,
+                                          paint,
+                                          SkCanvas::kFast_SrcRectConstraint);
+                    continue;
+                }
+
+                complete = false;
+                if (!fFailed.contains(index)) {
+                    missing.push_back(index);
+                }
+                if (fPlaceholder) {
+                    const SkISize dims = this->dimensions();
+                    const SkMatrix toPlaceholder = SkMatrix::Scale(
+                            fPlaceholder->width() / (float)dims.width(),
+                            fPlaceholder->height() / (float)dims.height());
+                    canvas->drawImageRect(fPlaceholder.get(),
+                                          toPlaceholder.mapRect(tileSrc),
+                                          tileDst,
+                                          sampling,
+                                          paint,
+                                          SkCanvas::kFast_SrcRectConstraint);
+                }
+            }
+        }
+
+        this->schedule(missing);
+        return complete;
+    }
+
+private:
+    struct Decoded {
+        int fIndex;
+        sk_sp<SkImage> fImage;  // Null if the decode failed.
+    };
+
+    SkIRect tileRect(int index) const {
+        SkIRect rect = SkIRect::MakeXYWH((index % fTilesX) * fTileSize,
+                                         (index / fTilesX) * fTileSize,
+                                         fTileSize,
+                                         fTileSize);
+        SkAssertResult(rect.intersect(SkIRect::MakeSize(this->dimensions())));
+        return rect;
+    }
+
+    // Moves the tiles that have finished decoding into the cache. Only called on the owner's
+    // thread.
+    void collectDecoded() {
+        TArray<Decoded> decoded;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            decoded = std::move(fDecoded);
+            fDecoded.clear();
+        }
+        for (Decoded& d : decoded) {
+            if (!d.fImage) {
+                fFailed.add(d.fIndex);
+            } else if (d.fIndex == kPlaceholder) {
+                fPlaceholder = std::move(d.fImage);
+            } else {
+                fTiles.insert_or_update(d.fIndex, std::move(d.fImage));
+            }
+        }
+    }
+
+    // Replaces the queue of tiles that haven't started decoding with 'missing', preceded by the
+    // placeholder if it is still needed, and makes sure a task is draining the queue.
+    void schedule(const TArray<int>& missing) {
+        SkAutoMutexExclusive lock(fMutex);
+        fQueue.clear();
+        if (fPlaceholderSampleSize > 0 && !fPlaceholder && !fFailed.contains(kPlaceholder) &&
+            !this->isDecodingOrDecoded(kPlaceholder)) {
+            fQueue.push_back(kPlaceholder);
+        }
+        for (int index : missing) {
+            if (!this->isDecodingOrDecoded(index)) {
+                fQueue.push_back(index);
+            }
+        }
+
+        if (!fDraining && !fQueue.empty()) {
+            fDraining = true;
+            fTasks.add([this] { this->drain(); });
+        }
+    }
+
+    bool isDecodingOrDecoded(int index) const SK_REQUIRES(fMutex) {
+        if (index == fDecoding) {
+            return true;
+        }
+        return std::any_of(fDecoded.begin(), fDecoded.end(), [index](const Decoded& d) {
+            return d.fIndex == index;
+        });
+    }
+
+    // Decodes queued tiles until the queue is empty. At most one drain() runs at a time, since
+    // the codec can only decode one subset at a time.
+    void drain() {
+        for (;;) {
+            int index;
+            {
+                SkAutoMutexExclusive lock(fMutex);
+                if (fQueue.empty()) {
+                    fDraining = false;
+                    return;
+                }
+                index = fQueue.front();
+                fQueue.pop_front();
+                fDecoding = index;
+            }
+            sk_sp<SkImage> image = this->decode(index);
+            {
+                SkAutoMutexExclusive lock(fMutex);
+                fDecoded.push_back({index, std::move(image)});
+                fDecoding = kNone;
+            }
+        }
+    }
+
+    sk_sp<SkImage> decode(int index) {
+        SkAndroidCodec::AndroidOptions options;
+        SkIRect subset;
+        SkISize dims;
+        if (index == kPlaceholder) {
+            options.fSampleSize = fPlaceholderSampleSize;
+            dims = fCodec->getSampledDimensions(fPlaceholderSampleSize);
+        } else {
+            subset = this->tileRect(index);
+            SkIRect supported = subset;
+            if (!fCodec->getSupportedSubset(&supported) || supported != subset) {
+                return nullptr;
+            }
+            options.fSubset = &subset;
+            dims = subset.size();
+        }
+
+        SkBitmap bitmap;
+        if (!bitmap.tryAllocPixels(SkImageInfo::Make(dims, fColorType, fAlphaType, fColorSpace))) {
+            return nullptr;
+        }
+        switch (fCodec->getAndroidPixels(bitmap.info(), bitmap.getPixels(), bitmap.rowBytes(),
+                                         &options)) {
+            case SkCodec::kSuccess:
+            case SkCodec::kIncompleteInput:
+            case SkCodec::kErrorInInput:
+                break;
+            default:
+                return nullptr;
+        }
+        bitmap.setImmutable();
+        return bitmap.asImage();
+    }
+
+    static constexpr int kNone = -2;
+
+    // Only used by drain(), or before any task was added.
+    std::unique_ptr<SkAndroidCodec> fCodec;
+    SkColorType fColorType;
+    SkAlphaType fAlphaType;
+    sk_sp<SkColorSpace> fColorSpace;
+
+    const int fTileSize;
+    const int fTilesX;
+    const int fTilesY;
+    const int fMaxResidentTiles;
+    int fPlaceholderSampleSize = 0;
+
+    // Only used on the owner's thread.
+    SkLRUCache<int, sk_sp<SkImage>> fTiles;
+    sk_sp<SkImage> fPlaceholder;
+    THashSet<int> fFailed;
+
+    SkMutex fMutex;
+    std::deque<int> fQueue SK_GUARDED_BY(fMutex);
+    TArray<Decoded> fDecoded SK_GUARDED_BY(fMutex);
+    int fDecoding SK_GUARDED_BY(fMutex) = kNone;
+    bool fDraining SK_GUARDED_BY(fMutex) = false;
+
+    SkTaskGroup fTasks;
+};
+
+std::unique_ptr<SkTiledImage> SkTiledImage::Make(std::unique_ptr<SkCodec> codec,
+                                                 const Options& options) {
+    if (!codec) {
+        return nullptr;
+    }
+    std::unique_ptr<SkAndroidCodec> androidCodec = SkAndroidCodec::MakeFromCodec(std::move(codec));
+    if (!androidCodec || androidCodec->getInfo().isEmpty()) {
+        return nullptr;
+    }
+    const int tileSize = std::max(options.fTileSize + (options.fTileSize & 1), 2);
+    const SkISize dims = androidCodec->getInfo().dimensions();
+    const int64_t tileCount = static_cast<int64_t>((dims.width() + tileSize - 1) / tileSize) *
+                              ((dims.height() + tileSize - 1) / tileSize);
+    if (!SkTFitsIn<int>(tileCount)) {
+        return nullptr;
+    }
+    return std::unique_ptr<SkTiledImage>(new SkTiledImage(
+            std::make_unique<Impl>(std::move(androidCodec), options, tileSize)));
+}
+
+SkTiledImage::SkTiledImage(std::unique_ptr<Impl> impl) : fImpl(std::move(impl)) {}
+
+SkTiledImage::~SkTiledImage() = default;
+
+SkISize SkTiledImage::dimensions() const { return fImpl->dimensions(); }
+
+bool SkTiledImage::draw(SkCanvas* canvas,
+                        const SkRect& src,
+                        const SkRect& dst,
+                        const SkSamplingOptions& sampling,
+                        const SkPaint* paint) {
+    if (!canvas) {
+        return false;
+    }
+    return fImpl->draw(canvas, src, dst, sampling, paint);
+}
+
+int SkTiledImage::residentTileCount() const { return fImpl->residentTileCount(); }
+
+void SkTiledImage::waitForPendingDecodes() { fImpl->waitForPendingDecodes(); }
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/utils/SkTiledRaster.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkAlign.h"
+#include "include/private/base/SkTFitsIn.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace SkTiledRaster {
+
+bool DrawPicture(const SkPixmap& dst,
+                 const SkPicture* picture,
+                 const SkMatrix& matrix,
+                 const Options& options) {
+    if (!picture || !dst.addr() || dst.width() <= 0 || dst.height() <= 0) {
+        return false;
+    }
+    // Make sure the destination is something SkCanvas::MakeRasterDirect can target before we
+    // fan out, so that we fail as a whole instead of tile by tile.
+    if (!SkCanvas::MakeRasterDirect(dst.info(), dst.writable_addr(), dst.rowBytes())) {
+        return false;
+    }
+
+    const int tileW = (int)SkAlignTo(std::max(options.fTileSize.width(), 1), kTileAlignment);
+    const int tileH = (int)SkAlignTo(std::max(options.fTileSize.height(), 1), kTileAlignment);
+    const int tilesX = (dst.width()  + tileW - 1) / tileW;
+    const int tilesY = (dst.height() + tileH - 1) / tileH;
+    if (!SkTFitsIn<int>(static_cast<int64_t>(tilesX) * tilesY)) {
+        return false;
+    }
+
+    auto drawTile = [&](int index) {
+        const int x = (index % tilesX) * tileW,
+                  y = (index / tilesX) * tileH;
+        SkPixmap tile;
+        if (!dst.extractSubset(&tile, SkIRect::MakeXYWH(x, y, tileW, tileH))) {
+            return;
+        }
+        std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(tile.info(),
+                                                                      tile.writable_addr(),
+                                                                      tile.rowBytes(),
+                                                                      &options.fSurfaceProps);
+        SkASSERT(canvas);
+        canvas->translate(SkIntToScalar(-x), SkIntToScalar(-y));
+        canvas->concat(matrix);
+        picture->playback(canvas.get());
+    };
+
+    const int tileCount = tilesX * tilesY;
+    if (tileCount == 1) {
+        drawTile(0);
+        return true;
+    }
+
+    SkExecutor& executor = options.fExecutor ? *options.fExecutor : SkExecutor::GetDefault();
+    SkTaskGroup tasks(executor);
+    tasks.batch(tileCount, drawTile);
+    tasks.wait();
+    return true;
+}
+
+}  // namespace SkTiledRaster
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTiledRaster_DEFINED
+#define SkTiledRaster_DEFINED
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkSurfaceProps.h"
+
+class SkExecutor;
+class SkPicture;
+class SkPixmap;
+
+namespace SkTiledRaster {
+
+struct Options {
+    // Tiles are rounded up to a multiple of kTileAlignment in each dimension so that
+    // device-space dependent effects (e.g. dithering) line up with an untiled draw.
+    SkISize fTileSize = {256, 256};
+
+    // Tiles are rendered on this executor. If null, SkExecutor::GetDefault() is used.
+    SkExecutor* fExecutor = nullptr;
+
+    SkSurfaceProps fSurfaceProps;
+};
+
+inline constexpr int kTileAlignment = 16;
+
+/**
+ *  Plays back 'picture' into 'dst' (transformed by 'matrix'), splitting 'dst' into tiles that
+ *  are each replayed independently on the executor in 'options'. Each tile canvas is clipped to
+ *  its tile, so pictures recorded with a bounding box hierarchy (e.g. SkRTreeFactory) only
+ *  replay the ops that touch that tile.
+ *
+ *  The result matches drawing 'picture' into a single raster canvas wrapping 'dst', except that
+ *  antialiased or curved geometry crossing a tile seam is clipped to each tile before it is scan
+ *  converted, so pixels along the seam may round slightly differently.
+ *
+ *  Returns false if 'dst' cannot be drawn into with a raster canvas.
+ */
+bool DrawPicture(const SkPixmap& dst,
+                 const SkPicture* picture,
+                 const SkMatrix& matrix = SkMatrix::I(),
+                 const Options& options = {});
+
+}  // namespace SkTiledRaster
+
+#endif  // SkTiledRaster_DEFINED
@@ -85,45 +85,31 @@ void SkXMLWriter::startElement(const char name[]) {
     this->startElementLen(name, strlen(name));
 }
 
-static const char* escape_char(char c, char storage[2]) {
-    static const char* gEscapeChars[] = {
-        "<&lt;",
-        ">&gt;",
-        //"\"&quot;",
-        //"'&apos;",
-        "&&amp;"
-    };
-
-    const char** array = gEscapeChars;
-    for (unsigned i = 0; i < std::size(gEscapeChars); i++) {
-        if (array[i][0] == c) {
-            return &array[i][1];
-        }
-    }
-    storage[0] = c;
-    storage[1] = 0;
-    return storage;
-}
-
+// Returns how many more chars 'src' takes with markup escaped, and writes the escaped chars to
+// 'dst' if it is not null.
 static size_t escape_markup(char dst[], const char src[], size_t length) {
     size_t      extra = 0;
     const char* stop = src + length;
 
-    while (src < stop) {
-        char        orig[2];
-        const char* seq = escape_char(*src, orig);
-        size_t      seqSize = strlen(seq);
-
+    for (; src < stop; ++src) {
+        const char* seq;
+        switch (*src) {
+            case '<': seq = "&lt;";  break;
+            case '>': seq = "&gt;";  break;
+            case '&': seq = "&amp;"; break;
+            default:
+                if (dst) {
+                    *dst++ = *src;
+                }
+                continue;
+        }
+        size_t seqSize = strlen(seq);
         if (dst) {
             memcpy(dst, seq, seqSize);
             dst += seqSize;
         }
-
         // now record the extra size needed
         extra += seqSize - 1;   // minus one to subtract the original char
-
-        // bump to the next src char
-        src += 1;
     }
     return extra;
 }
@@ -196,27 +182,47 @@ SkXMLStreamWriter::SkXMLStreamWriter(SkWStream* stream, uint32_t flags)
 
 SkXMLStreamWriter::~SkXMLStreamWriter() {
     this->flush();
+    this->flushBuffer();
+}
+
+void SkXMLStreamWriter::write(const char text[], size_t length) {
+    if (length > sizeof(fBuffer) - fBufferUsed) {
+        this->flushBuffer();
+        if (length > sizeof(fBuffer)) {
+            fStream.write(text, length);
+            return;
+        }
+    }
+    memcpy(fBuffer + fBufferUsed, text, length);
+    fBufferUsed += length;
+}
+
+void SkXMLStreamWriter::flushBuffer() {
+    if (fBufferUsed) {
+        fStream.write(fBuffer, fBufferUsed);
+        fBufferUsed = 0;
+    }
 }
 
 void SkXMLStreamWriter::onAddAttributeLen(const char name[], const char value[], size_t length) {
     SkASSERT(!fElems.back()->fHasChildren && !fElems.back()->fHasText);
-    fStream.writeText(" ");
-    fStream.writeText(name);
-    fStream.writeText("=\"");
-    fStream.write(value, length);
-    fStream.writeText("\"");
+    this->writeText(" ");
+    this->writeText(name);
+    this->writeText("=\"");
+    this->write(value, length);
+    this->writeText("\"");
 }
 
 void SkXMLStreamWriter::onAddText(const char text[], size_t length) {
     Elem* elem = fElems.back();
 
     if (!elem->fHasChildren && !elem->fHasText) {
-        fStream.writeText(">");
+        this->writeText(">");
         this->newline();
     }
 
     this->tab(fElems.size() + 1);
-    fStream.write(text, length);
+    this->write(text, length);
     this->newline();
 }
 
@@ -224,11 +230,11 @@ void SkXMLStreamWriter::onEndElement() {
     Elem* elem = getEnd();
     if (elem->fHasChildren || elem->fHasText) {
         this->tab(fElems.size());
-        fStream.writeText("</");
-        fStream.writeText(elem->fName.c_str());
-        fStream.writeText(">");
+        this->writeText("</");
+        this->write(elem->fName.c_str(), elem->fName.size());
+        this->writeText(">");
     } else {
-        fStream.writeText("/>");
+        this->writeText("/>");
     }
     this->newline();
     doEnd(elem);
@@ -238,31 +244,30 @@ void SkXMLStreamWriter::onStartElementLen(const char name[], size_t length) {
     int level = fElems.size();
     if (this->doStart(name, length)) {
         // the first child, need to close with >
-        fStream.writeText(">");
+        this->writeText(">");
         this->newline();
     }
 
     this->tab(level);
-    fStream.writeText("<");
-    fStream.write(name, length);
+    this->writeText("<");
+    this->write(name, length);
 }
 
 void SkXMLStreamWriter::writeHeader() {
-    const char* header = getHeader();
-    fStream.write(header, strlen(header));
+    this->writeText(getHeader());
     this->newline();
 }
 
 void SkXMLStreamWriter::newline() {
     if (!(fFlags & kNoPretty_Flag)) {
-        fStream.newline();
+        this->writeText("\n");
     }
 }
 
 void SkXMLStreamWriter::tab(int level) {
     if (!(fFlags & kNoPretty_Flag)) {
         for (int i = 0; i < level; i++) {
-            fStream.writeText("\t");
+            this->writeText("\t");
         }
     }
 }
@@ -12,6 +12,8 @@
 #include "include/private/base/SkTDArray.h"
 #include "src/xml/SkDOM.h"
 
+#include <cstring>
+
 class SkWStream;
 class SkXMLParser;
 
@@ -61,6 +63,10 @@ private:
     SkXMLWriter& operator=(const SkXMLWriter&);
 };
 
+/**
+ * Writes XML to a stream. Output is buffered, and only guaranteed to have been written to the
+ * stream once the writer is destroyed.
+ */
 class SkXMLStreamWriter : public SkXMLWriter {
 public:
     enum : uint32_t {
@@ -81,8 +87,16 @@ private:
     void newline();
     void tab(int lvl);
 
+    // Many small pieces are written per element, so they're gathered in fBuffer rather than each
+    // being passed to the stream.
+    void write(const char text[], size_t length);
+    void writeText(const char text[]) { this->write(text, strlen(text)); }
+    void flushBuffer();
+
     SkWStream&      fStream;
     const uint32_t  fFlags;
+    size_t          fBufferUsed = 0;
+    char            fBuffer[4096];
 };
 
 class SkXMLParserWriter : public SkXMLWriter {
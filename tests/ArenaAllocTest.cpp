@@ -140,6 +140,51 @@ DEF_TEST(ArenaAllocIsEmpty, r) {
     }
 }
 
+DEF_TEST(RetainingArenaAlloc, r) {
+    static int destroyed = 0;
+    struct Node {
+        ~Node() { destroyed++; }
+        char filler[64];
+    };
+
+    SkRetainingArenaAlloc arena(256);
+    auto fill = [&](int count) {
+        for (int i = 0; i < count; i++) {
+            arena.get()->make<Node>();
+        }
+    };
+
+    // The first use spills into heap blocks, and the reset grows the retained block to fit it.
+    fill(100);
+    REPORTER_ASSERT(r, arena.get()->heapAllocationCount() > 1);
+    arena.reset();
+    REPORTER_ASSERT(r, destroyed == 100);
+    REPORTER_ASSERT(r, arena.lastHeapAllocationCount() > 1);
+    const size_t retained = arena.retainedBytes();
+    REPORTER_ASSERT(r, retained >= 100 * sizeof(Node));
+
+    // Later uses of the same size don't allocate.
+    for (int frame = 0; frame < 3; frame++) {
+        fill(100);
+        REPORTER_ASSERT(r, arena.get()->heapAllocationCount() == 0);
+        arena.reset();
+        REPORTER_ASSERT(r, arena.lastHeapAllocationCount() == 0);
+        REPORTER_ASSERT(r, arena.retainedBytes() == retained);
+    }
+    REPORTER_ASSERT(r, destroyed == 400);
+
+    // Uses that need much less memory eventually shrink the block.
+    for (int frame = 0; frame < SkRetainingArenaAlloc::kDecayResets; frame++) {
+        REPORTER_ASSERT(r, arena.retainedBytes() == retained);
+        fill(10);
+        arena.reset();
+    }
+    REPORTER_ASSERT(r, arena.retainedBytes() < retained);
+    REPORTER_ASSERT(r, arena.retainedBytes() >= 10 * sizeof(Node));
+    fill(10);
+    REPORTER_ASSERT(r, arena.get()->heapAllocationCount() == 0);
+}
+
 DEF_TEST(ArenaAllocWithMultipleBlocks, r) {
     // Make sure that multiple blocks are handled correctly.
     static int created = 0,
@@ -26,6 +26,7 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
+#include "include/effects/SkImageFilters.h"
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrDirectContext.h"
@@ -47,6 +48,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <initializer_list>
 
 struct GrContextOptions;
@@ -358,6 +360,57 @@ DEF_TEST(BlurSigmaRange, reporter) {
     }
 }
 
+// GrBlurUtils::GaussianBlur runs sigmas above 8 * kMaxLinearBlurSigma at a coarser scale than
+// smaller ones. Check that the re-expanded result still matches an unscaled Gaussian.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(BlurHugeSigmaRescale,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    static constexpr int kWidth = 1024;
+    static constexpr int kHeight = 30;
+    static constexpr int kHalfStep = 200;
+    static constexpr int kSize = kWidth / 2;
+    // Downscaling and the linear re-expansion both soften the profile slightly.
+    static constexpr int kTolerance = 8;
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(kWidth, kHeight);
+    auto surface(SkSurfaces::RenderTarget(ctxInfo.directContext(), skgpu::Budgeted::kNo, info));
+    if (!surface) {
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(info);
+    int expected[kSize];
+    // 24 takes the regular rescale, the others the coarser one.
+    for (float sigma : {24.f, 40.f, 48.f, 64.f}) {
+        // Only blur horizontally, so that every row is the 1D convolution of a step.
+        SkPaint paint;
+        paint.setColor(SK_ColorWHITE);
+        paint.setImageFilter(SkImageFilters::Blur(sigma, 0, nullptr));
+        canvas->clear(SK_ColorBLACK);
+        canvas->drawRect(SkRect::MakeLTRB(kSize - kHalfStep, 0, kSize + kHalfStep, kHeight), paint);
+        if (!surface->readPixels(bitmap, 0, 0)) {
+            ERRORF(reporter, "readPixels failed");
+            return;
+        }
+
+        // The rect covers the pixels kHalfStep to the left of the center through kHalfStep - 1 to
+        // the right of it, so compare both halves outwards from there.
+        brute_force_1d(-kHalfStep - 1, kHalfStep, sigma, expected, kSize);
+        for (int i = 0; i < kSize; ++i) {
+            int right = SkColorGetR(bitmap.getColor(kSize + i, kHeight / 2));
+            int left = SkColorGetR(bitmap.getColor(kSize - 1 - i, kHeight / 2));
+            if (abs(right - expected[i]) > kTolerance || abs(left - expected[i]) > kTolerance) {
+                ERRORF(reporter, "sigma %g: %d pixels from the center got %d and %d, expected %d",
+                       sigma, i, left, right, expected[i]);
+                break;
+            }
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 
 DEF_TEST(BlurAsABlur, reporter) {
@@ -586,3 +639,49 @@ DEF_TEST(zero_blur, reporter) {
     SkIPoint offset;
     bitmap.extractAlpha(&alpha, &paint, nullptr, &offset);
 }
+
+// Blurred paths are cached by the path and the fractional part of the translation. Drawing the
+// same path moved by whole pixels, whether or not the mask comes from the cache, and drawing it
+// partially clipped must all match a blur drawn from a fresh path.
+DEF_TEST(BlurredPathCache, reporter) {
+    SkPath path;
+    path.moveTo(4, 2);
+    path.lineTo(30, 10);
+    path.quadTo(20, 30, 2, 26);
+    path.close();
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 2));
+
+    auto draw = [&](const SkPath& p, SkScalar dx, SkScalar dy, const SkIRect* clip,
+                    SkBitmap* bitmap) {
+        bitmap->allocPixels(SkImageInfo::MakeA8(64, 64));
+        bitmap->eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(*bitmap);
+        if (clip) {
+            canvas.clipIRect(*clip);
+        }
+        canvas.translate(dx, dy);
+        canvas.drawPath(p, paint);
+    };
+
+    SkBitmap expected, first, again, clipped;
+    draw(SkPath(path).setIsVolatile(true), 16.25f, 16.5f, nullptr, &expected);
+    draw(path, 3.25f, 4.5f, nullptr, &first);
+    draw(path, 16.25f, 16.5f, nullptr, &again);
+    const SkIRect clip = SkIRect::MakeLTRB(0, 0, 30, 64);
+    draw(path, 16.25f, 16.5f, &clip, &clipped);
+
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            const uint8_t a = *expected.getAddr8(x, y);
+            REPORTER_ASSERT(reporter, *again.getAddr8(x, y) == a);
+            REPORTER_ASSERT(reporter, *clipped.getAddr8(x, y) == (x < clip.fRight ? a : 0));
+            if (x >= 13 && y >= 12) {
+                // Rasterizing at another offset can round the edges differently.
+                REPORTER_ASSERT(reporter, std::abs(*first.getAddr8(x - 13, y - 12) - a) <= 1);
+            }
+        }
+    }
+}
@@ -12,6 +12,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkDocument.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -20,6 +21,7 @@
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkPoint.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkRegion.h"
@@ -41,9 +43,11 @@
 #include "src/core/SkRecords.h"
 #include "src/utils/SkCanvasStack.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
 #include <cstddef>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <utility>
 
@@ -722,3 +726,79 @@ DEF_TEST(canvas_savelayer_destructor, reporter) {
     do_test(2, 0);
     check_pixels(SK_ColorRED);
 }
+
+DEF_TEST(Canvas_DrawBulk, reporter) {
+    SkBitmap imageBitmap;
+    imageBitmap.allocN32Pixels(8, 8);
+    imageBitmap.eraseColor(SK_ColorGREEN);
+    sk_sp<SkImage> image = imageBitmap.asImage();
+
+    const SkCanvas::BulkItem items[] = {SkCanvas::BulkItem::kRect,
+                                        SkCanvas::BulkItem::kRect,
+                                        SkCanvas::BulkItem::kRRect,
+                                        SkCanvas::BulkItem::kImageRect,
+                                        SkCanvas::BulkItem::kImageRect,
+                                        SkCanvas::BulkItem::kRect};
+    const SkRect rects[] = {SkRect::MakeXYWH(2, 2, 20, 10),
+                            SkRect::MakeXYWH(10, 8, 12, 30),
+                            SkRect::MakeXYWH(30, 4, 24, 24),
+                            SkRect::MakeXYWH(4, 40, 16, 16),
+                            SkRect::MakeXYWH(24, 36, 30, 20),
+                            SkRect::MakeXYWH(40, 50, 20, 12)};
+    const SkVector radii[] = {{0, 0}, {0, 0}, {6, 4}, {0, 0}, {0, 0}, {0, 0}};
+    const SkRect srcRects[] = {{}, {}, {}, SkRect::MakeWH(8, 8), SkRect::MakeXYWH(2, 2, 4, 4), {}};
+    const SkColor4f colors[] = {SkColors::kRed, SkColors::kBlue, {0, 1, 1, 0.5f},
+                                {1, 1, 1, 0.75f}, SkColors::kWhite, SkColors::kYellow};
+
+    SkCanvas::BulkSet set;
+    set.fCount = std::size(items);
+    set.fItems = items;
+    set.fRects = rects;
+    set.fRadii = radii;
+    set.fSrcRects = srcRects;
+    set.fColors = colors;
+    set.fImage = image.get();
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    const SkSamplingOptions sampling(SkFilterMode::kLinear);
+
+    SkBitmap bulk, separate;
+    bulk.allocN32Pixels(64, 64);
+    separate.allocN32Pixels(64, 64);
+    bulk.eraseColor(SK_ColorTRANSPARENT);
+    separate.eraseColor(SK_ColorTRANSPARENT);
+
+    SkCanvas(bulk).experimental_DrawBulk(set, sampling, paint);
+
+    SkCanvas separateCanvas(separate);
+    for (size_t i = 0; i < std::size(items); ++i) {
+        SkPaint entryPaint = paint;
+        entryPaint.setColor4f(colors[i]);
+        switch (items[i]) {
+            case SkCanvas::BulkItem::kRect:
+                separateCanvas.drawRect(rects[i], entryPaint);
+                break;
+            case SkCanvas::BulkItem::kRRect:
+                separateCanvas.drawRRect(SkRRect::MakeRectXY(rects[i], radii[i].fX, radii[i].fY),
+                                         entryPaint);
+                break;
+            case SkCanvas::BulkItem::kImageRect:
+                separateCanvas.drawImageRect(image.get(), srcRects[i], rects[i], sampling,
+                                             &entryPaint, SkCanvas::kFast_SrcRectConstraint);
+                break;
+        }
+    }
+    REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(bulk.pixmap(), separate.pixmap()));
+
+    // Recording canvases see the entries as separate draws.
+    SkPictureRecorder recorder;
+    recorder.beginRecording(64, 64)->experimental_DrawBulk(set, sampling, paint);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(reporter, picture->approximateOpCount() == (int)std::size(items));
+
+    // Entries that need an array the set doesn't have draw nothing.
+    set.fRadii = nullptr;
+    recorder.beginRecording(64, 64)->experimental_DrawBulk(set, sampling, paint);
+    REPORTER_ASSERT(reporter, recorder.finishRecordingAsPicture()->approximateOpCount() == 0);
+}
@@ -46,6 +46,10 @@ DEF_TEST(GoodHash, r) {
     // 4 bytes --> hits SkChecksum::Mix fast path.
     REPORTER_ASSERT(r, SkGoodHash()(( int32_t)4) ==  614249093);
     REPORTER_ASSERT(r, SkGoodHash()((uint32_t)4) ==  614249093);
+
+    // 8 bytes --> hits SkChecksum::Mix64 fast path.
+    REPORTER_ASSERT(r, SkGoodHash()(( int64_t)4) == 2834307189);
+    REPORTER_ASSERT(r, SkGoodHash()((uint64_t)4) == 2834307189);
 }
 
 DEF_TEST(ChecksumCollisions, r) {
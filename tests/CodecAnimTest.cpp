@@ -13,6 +13,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -21,11 +22,14 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkTo.h"
+#include "src/codec/SkParallelFrameDecoder.h"
 #include "tests/CodecPriv.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
 #include "tools/ToolUtils.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <initializer_list>
@@ -567,6 +571,87 @@ DEF_TEST(AndroidCodec_animated_gif, r) {
     test_animated_AndroidCodec(r, "images/required.gif");
 }
 
+// Decodes every frame of 'codec' in order, each onto a copy of its required frame.
+static std::vector<SkBitmap> decode_frames_serially(skiatest::Reporter* r, SkCodec* codec) {
+    std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
+    std::vector<SkBitmap> frames(std::max<size_t>(frameInfos.size(), 1));
+    for (size_t i = 0; i < frames.size(); ++i) {
+        SkImageInfo info = codec->getInfo();
+        SkCodec::Options options;
+        options.fFrameIndex = SkToInt(i);
+        if (!frameInfos.empty()) {
+            if (frameInfos[i].fAlphaType != kOpaque_SkAlphaType && info.isOpaque()) {
+                info = info.makeAlphaType(kPremul_SkAlphaType);
+            }
+        }
+        frames[i].allocPixels(info);
+        if (!frameInfos.empty() && frameInfos[i].fRequiredFrame != SkCodec::kNoFrame) {
+            const int required = frameInfos[i].fRequiredFrame;
+            REPORTER_ASSERT(r, frames[required].readPixels(frames[i].pixmap()));
+            options.fPriorFrame = required;
+        }
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(frames[i].pixmap(), &options));
+    }
+    return frames;
+}
+
+DEF_TEST(Codec_ParallelFrameDecoder, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (const char* file : {"images/required.gif", "images/required.webp",
+                             "images/alphabetAnim.gif", "images/stoplight.webp",
+                             "images/randPixelsAnim.gif", "images/randPixels.png"}) {
+        sk_sp<SkData> data = GetResourceAsData(file);
+        std::unique_ptr<SkCodec> codec = data ? SkCodec::MakeFromData(data) : nullptr;
+        if (!codec) {
+            continue;
+        }
+        const std::vector<SkBitmap> expected = decode_frames_serially(r, codec.get());
+        const int frameCount = SkToInt(expected.size());
+
+        for (SkExecutor* exec : {(SkExecutor*)nullptr, executor.get()}) {
+            SkParallelFrameDecoder::Options options;
+            options.fExecutor = exec;
+            options.fPrefetchCount = 2;
+            options.fMaxPooledFrames = 3;  // Small enough to evict required frames.
+            auto decoder = SkParallelFrameDecoder::Make(data, options);
+            REPORTER_ASSERT(r, decoder);
+            if (!decoder) {
+                continue;
+            }
+            REPORTER_ASSERT(r, decoder->frameCount() == frameCount);
+
+            std::vector<sk_sp<SkImage>> keyframes = decoder->decodeKeyframes();
+            REPORTER_ASSERT(r, SkToInt(keyframes.size()) == frameCount);
+            for (int i = 0; i < frameCount; ++i) {
+                const bool independent = decoder->frameInfo(i).fRequiredFrame == SkCodec::kNoFrame;
+                REPORTER_ASSERT(r, independent == SkToBool(keyframes[i]), "%s frame %d", file, i);
+                if (keyframes[i]) {
+                    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected[i].asImage().get(),
+                                                               keyframes[i].get()),
+                                    "%s keyframe %d", file, i);
+                }
+            }
+
+            // Play forwards (which prefetches), then backwards (which has to re-decode evicted
+            // required frames).
+            std::vector<int> order;
+            for (int i = 0; i < frameCount; ++i) {
+                order.push_back(i);
+            }
+            for (int i = frameCount - 1; i >= 0; --i) {
+                order.push_back(i);
+            }
+            for (int i : order) {
+                sk_sp<SkImage> frame = decoder->getFrame(i);
+                REPORTER_ASSERT(r, frame && ToolUtils::equal_pixels(expected[i].asImage().get(),
+                                                                    frame.get()),
+                                "%s frame %d (%s executor)", file, i, exec ? "with" : "no");
+            }
+        }
+    }
+}
+
 DEF_TEST(EncodedOriginToMatrixTest, r) {
     // SkAnimCodecPlayer relies on the fact that these matrices are invertible.
     for (auto origin : { kTopLeft_SkEncodedOrigin     ,
@@ -325,6 +325,94 @@ DEF_TEST(Codec_partialAnim, r) {
     }
 }
 
+namespace {
+// Counts the bytes the codec reads, to check that streaming does not re-read data.
+class CountingHaltingStream : public HaltingStream {
+public:
+    CountingHaltingStream(sk_sp<SkData> data, size_t initialLimit)
+        : HaltingStream(std::move(data), initialLimit) {}
+
+    size_t read(void* buffer, size_t size) override {
+        size_t bytesRead = HaltingStream::read(buffer, size);
+        fBytesRead += bytesRead;
+        return bytesRead;
+    }
+
+    size_t bytesRead() const { return fBytesRead; }
+
+private:
+    size_t fBytesRead = 0;
+};
+}  // namespace
+
+// Feed an animated gif to a codec a little at a time, asking for the frames after each chunk
+// while the first frame is being decoded incrementally, like a client decoding from the network.
+DEF_TEST(Codec_partialAnimFrameCount, r) {
+    auto path = "images/test640x479.gif";
+    sk_sp<SkData> file = GetResourceAsData(path);
+    if (!file) {
+        return;
+    }
+    std::unique_ptr<SkCodec> fullCodec(SkCodec::MakeFromData(file));
+    if (!fullCodec) {
+        ERRORF(r, "Failed to create codec from %s", path);
+        return;
+    }
+    const std::vector<SkCodec::FrameInfo> fullInfo = fullCodec->getFrameInfo();
+    SkBitmap truth;
+    if (!create_truth(file, &truth)) {
+        ERRORF(r, "Failed to decode %s", path);
+        return;
+    }
+
+    constexpr size_t kChunkSize = 64;
+    CountingHaltingStream* stream = new CountingHaltingStream(file, 455);
+    std::unique_ptr<SkCodec> partialCodec(
+            SkCodec::MakeFromStream(std::unique_ptr<SkStream>(stream)));
+    if (!partialCodec) {
+        ERRORF(r, "Failed to create a partial codec from %s", path);
+        return;
+    }
+
+    const SkImageInfo info = standardize_info(partialCodec.get());
+    SkBitmap frame;
+    frame.allocPixels(info);
+    bool started = false;
+    SkCodec::Result result = SkCodec::kIncompleteInput;
+
+    size_t lastCount = 0;
+    while (!stream->isAllDataReceived()) {
+        stream->addNewData(kChunkSize);
+
+        std::vector<SkCodec::FrameInfo> partialInfo = partialCodec->getFrameInfo();
+        REPORTER_ASSERT(r, partialInfo.size() >= lastCount);
+        REPORTER_ASSERT(r, partialInfo.size() <= fullInfo.size());
+        for (size_t i = lastCount; i < partialInfo.size() && i < fullInfo.size(); i++) {
+            REPORTER_ASSERT(r, partialInfo[i].fRequiredFrame == fullInfo[i].fRequiredFrame);
+            REPORTER_ASSERT(r, partialInfo[i].fDuration == fullInfo[i].fDuration);
+            REPORTER_ASSERT(r, partialInfo[i].fFrameRect == fullInfo[i].fFrameRect);
+        }
+        lastCount = partialInfo.size();
+
+        // Counting frames must not disturb the incremental decode in progress.
+        if (!started) {
+            started = SkCodec::kSuccess == partialCodec->startIncrementalDecode(
+                                                   info, frame.getPixels(), frame.rowBytes());
+        }
+        if (started && result == SkCodec::kIncompleteInput) {
+            result = partialCodec->incrementalDecode();
+        }
+    }
+    REPORTER_ASSERT(r, SkCodec::kSuccess == result);
+    REPORTER_ASSERT(r, lastCount == fullInfo.size());
+    compare_bitmaps(r, truth, frame);
+
+    // Decoding the first frame and counting the frames each read the file once. Without resuming
+    // where the last count stopped, each count re-reads at least the current frame.
+    REPORTER_ASSERT(r, stream->bytesRead() < 3 * file->size(),
+                    "read %zu bytes of %zu", stream->bytesRead(), file->size());
+}
+
 // Test that calling getPixels when an incremental decode has been
 // started (but not finished) makes the next call to incrementalDecode
 // require a call to startIncrementalDecode.
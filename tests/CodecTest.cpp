@@ -18,6 +18,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkImageInfo.h"
@@ -2007,3 +2008,97 @@ DEF_TEST(Codec_gif_null_param, r) {
     REPORTER_ASSERT(r, result == SkCodec::kSuccess);
     REPORTER_ASSERT(r, codec);
 }
+
+DEF_TEST(Codec_jpeg_restartIntervals, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // All but the last have restart markers. The first is 4:2:0 with a restart after each MCU
+    // row, so its bands have to decode the rows around them for chroma upsampling.
+    for (const char* path : {"images/iphone_13_pro.jpeg", "images/icc-v2-gbr.jpg",
+                             "images/mandrill_cmyk.jpg", "images/crbug1465627.jpeg",
+                             "images/wide_gamut_yellow_224_224_64.jpeg",
+                             "images/mandrill_512_q075.jpg"}) {
+        sk_sp<SkData> data(GetResourceAsData(path));
+        if (!data) {
+            SkDebugf("Missing resource '%s'\n", path);
+            continue;
+        }
+        // Also check that a truncated file still decodes like it does serially.
+        for (sk_sp<SkData> input : {data, SkData::MakeSubset(data.get(), 0, data->size() / 2)}) {
+            if (!SkCodec::MakeFromData(input)) {
+                // Half of the file may not include all of the headers.
+                REPORTER_ASSERT(r, input != data, "Could not create a codec for '%s'", path);
+                continue;
+            }
+            for (SkColorType colorType : {kN32_SkColorType, kRGBA_F16_SkColorType}) {
+                SkBitmap bitmaps[2];
+                SkCodec::Result results[2];
+                for (int i = 0; i < 2; ++i) {
+                    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(input);
+                    SkCodec::Options options;
+                    options.fExecutor = i ? executor.get() : nullptr;
+                    bitmaps[i].allocPixels(codec->getInfo().makeColorType(colorType));
+                    bitmaps[i].eraseColor(SK_ColorTRANSPARENT);
+                    results[i] = codec->getPixels(bitmaps[i].pixmap(), &options);
+                }
+                REPORTER_ASSERT(r, results[0] == results[1], "%s", path);
+                REPORTER_ASSERT(r, ToolUtils::equal_pixels(bitmaps[0], bitmaps[1]),
+                                "%s decodes differently with an executor", path);
+            }
+        }
+    }
+}
+
+// Codecs read memory-backed streams in place rather than copying them; make sure that
+// produces the same pixels as reading the same bytes from a stream without a memory base.
+DEF_TEST(Codec_memoryBackedStream, r) {
+    for (const char* path : {"images/mandrill_512_q075.jpg",
+                             "images/plane_interlaced.png",
+                             "images/color_wheel.png",
+                             "images/flightAnim.gif",
+                             "images/box.gif"}) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            SkDebugf("Missing resource '%s'\n", path);
+            continue;
+        }
+        if (!SkCodec::MakeFromData(data)) {
+            // The decoder for this format is not compiled in.
+            continue;
+        }
+
+        auto decode = [&](std::unique_ptr<SkStream> stream, bool incremental) {
+            SkBitmap bm;
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromStream(std::move(stream));
+            if (!codec) {
+                return bm;
+            }
+            SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+            bm.allocPixels(info);
+            if (incremental) {
+                if (SkCodec::kSuccess !=
+                            codec->startIncrementalDecode(info, bm.getPixels(), bm.rowBytes()) ||
+                    SkCodec::kSuccess != codec->incrementalDecode()) {
+                    bm.reset();
+                }
+            } else if (SkCodec::kSuccess != codec->getPixels(bm.pixmap())) {
+                bm.reset();
+            }
+            return bm;
+        };
+
+        for (bool incremental : {false, true}) {
+            SkBitmap inPlace = decode(SkMemoryStream::Make(data), incremental);
+            SkBitmap copied = decode(std::make_unique<NotAssetMemStream>(data), incremental);
+            if (incremental && inPlace.isNull() && copied.isNull()) {
+                // This codec does not support incremental decoding.
+                continue;
+            }
+            if (!inPlace.isNull() && !copied.isNull()) {
+                REPORTER_ASSERT(r, md5(inPlace) == md5(copied), "%s", path);
+            } else {
+                ERRORF(r, "failed to decode %s", path);
+            }
+        }
+    }
+}
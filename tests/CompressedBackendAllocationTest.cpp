@@ -6,11 +6,13 @@
  */
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkData.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
@@ -43,6 +45,8 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <initializer_list>
 #include <memory>
@@ -373,3 +377,46 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(CompressedBackendAllocationTest,
         }
     }
 }
+
+// Round trip an opaque diagonal gradient, whose dimensions aren't a multiple of the block size,
+// through the upload-time BC1 encoder and check that it decompresses to nearly the same colors.
+// Red and green run in opposite directions so the encoder has to orient its endpoints.
+DEF_TEST(CompressOpaqueBC1, reporter) {
+    SkAutoPixmapStorage src;
+    src.alloc(SkImageInfo::Make(13, 9, kRGBA_8888_SkColorType, kOpaque_SkAlphaType));
+    for (int y = 0; y < src.height(); ++y) {
+        for (int x = 0; x < src.width(); ++x) {
+            uint8_t* texel = static_cast<uint8_t*>(src.writable_addr(x, y));
+            texel[0] = 12 * (x + y);
+            texel[1] = 255 - 10 * (x + y);
+            texel[2] = 128;
+            texel[3] = 0xFF;
+        }
+    }
+
+    constexpr SkTextureCompressionType kType = SkTextureCompressionType::kBC1_RGB8_UNORM;
+    sk_sp<SkData> data = SkData::MakeUninitialized(GrNumBlocks(kType, src.dimensions()) *
+                                                   SkCompressedBlockSize(kType));
+    GrCompressOpaqueBC1(src, static_cast<char*>(data->writable_data()));
+
+    SkBitmap dst;
+    if (!SkDecompress(std::move(data), src.dimensions(), kType, &dst)) {
+        ERRORF(reporter, "Could not decompress BC1 data");
+        return;
+    }
+
+    // The colors of each block lie on a line, so only the 565 endpoints and the 2 bit
+    // interpolation contribute error.
+    constexpr int kTolerance = 16;
+    for (int y = 0; y < src.height(); ++y) {
+        for (int x = 0; x < src.width(); ++x) {
+            SkColor expected = src.getColor(x, y);
+            SkColor actual = dst.getColor(x, y);
+            int maxDiff = std::max({std::abs((int)SkColorGetR(expected) - (int)SkColorGetR(actual)),
+                                    std::abs((int)SkColorGetG(expected) - (int)SkColorGetG(actual)),
+                                    std::abs((int)SkColorGetB(expected) - (int)SkColorGetB(actual))});
+            REPORTER_ASSERT(reporter, maxDiff <= kTolerance && SkColorGetA(actual) == 0xFF,
+                            "(%d, %d): expected 0x%08x got 0x%08x", x, y, expected, actual);
+        }
+    }
+}
@@ -16,6 +16,7 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
@@ -37,10 +38,15 @@
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkBlendModePriv.h"
 #include "src/gpu/SkBackingFit.h"
+#include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrPaint.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrPixmap.h"
+#include "src/gpu/ganesh/GrShaderCaps.h"
+#include "src/gpu/ganesh/GrStyle.h"
 #include "src/gpu/ganesh/GrXferProcessor.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
+#include "src/gpu/ganesh/ops/OpsTask.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 #include "tools/gpu/ContextType.h"
@@ -255,6 +261,52 @@ DEF_GANESH_TEST_FOR_CONTEXTS(DMSAA_dst_read_with_existing_barrier,
     check_sdc_color(reporter, sdc.get(), dContext, dstColor);
 }
 
+DEF_GANESH_TEST_FOR_CONTEXTS(DMSAA_simple_paths_stay_coverage,
+                             &skgpu::IsRenderingContext,
+                             reporter,
+                             ctxInfo,
+                             nullptr,
+                             CtsEnforcement::kNextRelease) {
+    auto dContext = ctxInfo.directContext();
+    auto sdc = skgpu::ganesh::SurfaceDrawContext::Make(dContext,
+                                                       GrColorType::kRGBA_8888,
+                                                       nullptr,
+                                                       SkBackingFit::kExact,
+                                                       {256, 256},
+                                                       kDMSAAProps,
+                                                       /*label=*/{});
+    if (!sdc || !sdc->canUseDynamicMSAA()) {
+        return;
+    }
+
+    auto drawPath = [&](const SkPath& path) {
+        GrPaint paint;
+        paint.setColor4f(kTransCyan);
+        sdc->drawPath(nullptr, std::move(paint), GrAA::kYes, SkMatrix::I(), path,
+                      GrStyle::SimpleFill());
+    };
+
+    // A small convex path is cheaper with coverage AA than with an MSAA attachment for the whole
+    // target.
+    if (dContext->priv().caps()->shaderCaps()->fShaderDerivativeSupport) {
+        drawPath(SkPath::Polygon({{10, 10}, {40, 12}, {20, 35}}, /*isClosed=*/true));
+        REPORTER_ASSERT(reporter, !sdc->getOpsTask()->usesMSAASurface());
+    }
+
+    // Enough large, complex paths switch the OpsTask to MSAA.
+    SkPath star;
+    for (int i = 0; i < 11; ++i) {
+        SkScalar r = (i & 1) ? 40 : 120;
+        SkPoint pt = {128 + r * SkScalarCos(i * SK_ScalarPI / 5),
+                      128 + r * SkScalarSin(i * SK_ScalarPI / 5)};
+        i ? star.lineTo(pt) : star.moveTo(pt);
+    }
+    for (int i = 0; i < 8; ++i) {
+        drawPath(star);
+    }
+    REPORTER_ASSERT(reporter, sdc->getOpsTask()->usesMSAASurface());
+}
+
 // This test is used to test for crbug.com/1241134. The bug appears on Adreno5xx devices with OS
 // PQ3A. It does not repro on the earlier PPR1 version since the extend blend func extension was not
 // present on the older driver.
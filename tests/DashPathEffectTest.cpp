@@ -145,3 +145,26 @@ DEF_TEST(DashCrazy_crbug_875494, r) {
     skpathutils::FillPathWithPaint(path, paint, &path2, &cull);
 }
 
+
+// Redashing a path with a new phase reuses its cached contour measurements. The result has to
+// match dashing a volatile copy, which is always measured from scratch.
+DEF_TEST(DashPathEffectTest_cachedMeasure, r) {
+    SkPath path;
+    path.moveTo(10, 10);
+    path.cubicTo(60, -20, 80, 90, 120, 40);
+    path.quadTo(160, 0, 200, 60);
+    path.close();
+    SkPath volatilePath = path;
+    volatilePath.setIsVolatile(true);
+
+    const SkScalar intervals[] = { 7, 3 };
+    for (SkScalar phase : {0.f, 2.5f, 5.f, 7.5f}) {
+        sk_sp<SkPathEffect> dash(SkDashPathEffect::Make(intervals, std::size(intervals), phase));
+
+        SkStrokeRec rec(SkStrokeRec::kHairline_InitStyle);
+        SkPath cached, fresh;
+        REPORTER_ASSERT(r, dash->filterPath(&cached, path, &rec, nullptr));
+        REPORTER_ASSERT(r, dash->filterPath(&fresh, volatilePath, &rec, nullptr));
+        REPORTER_ASSERT(r, cached == fresh);
+    }
+}
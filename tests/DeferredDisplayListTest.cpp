@@ -11,8 +11,11 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
@@ -47,6 +50,7 @@
 #include <initializer_list>
 #include <memory>
 #include <utility>
+#include <vector>
 
 class SkImage;
 struct GrContextOptions;
@@ -1315,6 +1319,62 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(DDLMultipleDDLs, reporter, ctxInfo, CtsEn
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Check that a picture recorded into tiled DDLs, on several threads, draws the same as the
+// picture drawn directly.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(DDLTiledPicture, reporter, ctxInfo, CtsEnforcement::kNever) {
+    auto context = ctxInfo.directContext();
+
+    SkImageInfo ii = SkImageInfo::MakeN32Premul(61, 47);
+    sk_sp<SkSurface> direct = SkSurfaces::RenderTarget(context, skgpu::Budgeted::kNo, ii);
+    sk_sp<SkSurface> tiled = SkSurfaces::RenderTarget(context, skgpu::Budgeted::kNo, ii);
+    if (!direct || !tiled) {
+        ERRORF(reporter, "Could not create surfaces");
+        return;
+    }
+
+    // Content that crosses the tile boundaries.
+    SkPictureRecorder pictureRecorder;
+    SkCanvas* pictureCanvas = pictureRecorder.beginRecording(SkRect::Make(ii.bounds()));
+    pictureCanvas->clear(SK_ColorWHITE);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorRED);
+    pictureCanvas->drawCircle(30, 23, 20, paint);
+    paint.setColor(0x800000FF);
+    pictureCanvas->drawRect(SkRect::MakeXYWH(5, 30, 50, 10), paint);
+    sk_sp<SkPicture> picture = pictureRecorder.finishRecordingAsPicture();
+
+    direct->getCanvas()->drawPicture(picture);
+
+    GrSurfaceCharacterization characterization;
+    SkAssertResult(tiled->characterize(&characterization));
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(3);
+    std::vector<sk_sp<GrDeferredDisplayList>> ddls =
+            skgpu::ganesh::RecordTiledDDLs(characterization, picture.get(), 3, 2, executor.get());
+    REPORTER_ASSERT(reporter, ddls.size() == 6);
+    for (const sk_sp<GrDeferredDisplayList>& ddl : ddls) {
+        REPORTER_ASSERT(reporter, skgpu::ganesh::DrawDDL(tiled, ddl));
+    }
+
+    SkBitmap expected, actual;
+    expected.allocPixels(ii);
+    actual.allocPixels(ii);
+    SkAssertResult(direct->readPixels(expected, 0, 0));
+    SkAssertResult(tiled->readPixels(actual, 0, 0));
+    for (int y = 0; y < ii.height(); ++y) {
+        for (int x = 0; x < ii.width(); ++x) {
+            if (expected.getColor(x, y) != actual.getColor(x, y)) {
+                ERRORF(reporter, "Pixel (%d, %d) differs when drawn from tiled DDLs", x, y);
+                return; // we only really need to report the error once
+            }
+        }
+    }
+
+    REPORTER_ASSERT(reporter,
+                    skgpu::ganesh::RecordTiledDDLs(characterization, picture.get(), 0, 2).empty());
+}
+
 #ifdef SK_GL
 
 static sk_sp<GrPromiseImageTexture> noop_fulfill_proc(void*) {
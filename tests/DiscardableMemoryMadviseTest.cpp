@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+// Only built with skia_enable_discardable_image_cache, where SkDiscardableMemory::Create comes
+// from SkDiscardableMemory_madvise.cpp.
+
+#include "include/private/chromium/SkDiscardableMemory.h"
+#include "tests/Test.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+static size_t page_size() {
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// Fills every byte, including the first word of each page that unlock() swaps for its cookie.
+static void fill(void* data, size_t bytes, uint8_t seed) {
+    auto* p = static_cast<uint8_t*>(data);
+    for (size_t i = 0; i < bytes; ++i) {
+        p[i] = static_cast<uint8_t>(seed + i * 7);
+    }
+}
+
+static bool check(const void* data, size_t bytes, uint8_t seed) {
+    auto* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < bytes; ++i) {
+        if (p[i] != static_cast<uint8_t>(seed + i * 7)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DEF_TEST(DiscardableMemoryMadvise_Create, r) {
+    REPORTER_ASSERT(r, !SkDiscardableMemory::Create(0));
+    REPORTER_ASSERT(r, !SkDiscardableMemory::Create(SIZE_MAX));
+
+    std::unique_ptr<SkDiscardableMemory> dm(SkDiscardableMemory::Create(1));
+    REPORTER_ASSERT(r, dm && dm->data());
+    if (dm) {
+        dm->unlock();
+    }
+}
+
+DEF_TEST(DiscardableMemoryMadvise_Relock, r) {
+    // Spans several pages, and doesn't end on a page boundary.
+    const size_t bytes = 3 * page_size() + 100;
+    std::unique_ptr<SkDiscardableMemory> dm(SkDiscardableMemory::Create(bytes));
+    REPORTER_ASSERT(r, dm);
+    if (!dm) {
+        return;
+    }
+    // Created locked.
+    fill(dm->data(), bytes, 0);
+    dm->unlock();
+
+    // Nothing is under memory pressure here, so the MADV_FREE'd pages all survive, and every
+    // lock() must restore exactly what was there.
+    for (uint8_t seed = 1; seed <= 3; ++seed) {
+        REPORTER_ASSERT(r, dm->lock());
+        REPORTER_ASSERT(r, check(dm->data(), bytes, seed - 1), "seed %d", seed);
+        fill(dm->data(), bytes, seed);
+        dm->unlock();
+    }
+}
+
+DEF_TEST(DiscardableMemoryMadvise_Purged, r) {
+    const size_t pageSize = page_size();
+    const size_t bytes = 4 * pageSize;
+    std::unique_ptr<SkDiscardableMemory> dm(SkDiscardableMemory::Create(bytes));
+    REPORTER_ASSERT(r, dm);
+    if (!dm) {
+        return;
+    }
+    void* data = dm->data();
+    fill(data, bytes, 0);
+    dm->unlock();
+
+    // Drop one page the way the kernel reclaims a MADV_FREE'd one: it reads back as zeros.
+    void* page = static_cast<char*>(data) + 2 * pageSize;
+    REPORTER_ASSERT(r, madvise(page, pageSize, MADV_DONTNEED) == 0);
+
+    REPORTER_ASSERT(r, !dm->lock());
+    // Stays discarded, even though the other pages restored fine.
+    REPORTER_ASSERT(r, !dm->lock());
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkColorPriv.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTypes.h"
+#include "src/core/SkDistanceFieldGen.h"
+#include "tests/Test.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+
+DEF_TEST(DistanceFieldGen_MultiChannelKeepsCorners, r) {
+    static constexpr int kSize = 48;
+    uint32_t field[kSize * kSize];
+    const SkPath square = SkPath::Rect(SkRect::MakeLTRB(8, 8, 40, 40));
+    REPORTER_ASSERT(r, SkGenerateMultiChannelDistanceFieldFromPath(
+                               field, square, kSize, kSize, kSize * sizeof(uint32_t)));
+
+    auto median = [](uint32_t c) {
+        const int r = SkGetPackedR32(c), g = SkGetPackedG32(c), b = SkGetPackedB32(c);
+        return std::max(std::min(r, g), std::min(std::max(r, g), b));
+    };
+
+    // Deep inside and far outside are clamped to the ends of the range.
+    const uint32_t center = field[24 * kSize + 24];
+    REPORTER_ASSERT(r, median(center) == 255 && SkGetPackedA32(center) == 255);
+    const uint32_t far = field[0];
+    REPORTER_ASSERT(r, median(far) == 0 && SkGetPackedA32(far) == 0);
+
+    // Next to an edge, the channels agree with the single-channel distance in alpha.
+    const uint32_t nearEdge = field[24 * kSize + 41];
+    REPORTER_ASSERT(r, median(nearEdge) < 128);
+    REPORTER_ASSERT(r, std::abs(median(nearEdge) - (int)SkGetPackedA32(nearEdge)) <= 1);
+
+    // Diagonally past a corner, the median keeps following both edges, 1.5 texels away, while
+    // the true distance is rounded, 1.5 * sqrt(2) texels away. That is what keeps the corner sharp.
+    // The 8-bit encoding maps a distance d outside to 128 - 32 * d.
+    const uint32_t pastCorner = field[41 * kSize + 41];
+    REPORTER_ASSERT(r, std::abs(median(pastCorner) - 80) <= 1, "%d", median(pastCorner));
+    REPORTER_ASSERT(r, std::abs((int)SkGetPackedA32(pastCorner) - 60) <= 1);
+}
+
+#endif  // !defined(SK_DISABLE_SDF_TEXT)
@@ -12,6 +12,7 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPoint.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
@@ -177,6 +178,99 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas,
     check(reporter, atlas.get(), 1, 4, 1);
 }
 
+class CountingEvictor : public skgpu::PlotEvictionCallback {
+public:
+    void evict(skgpu::PlotLocator) override { ++fEvictions; }
+
+    int fEvictions = 0;
+};
+
+// Verifies that compacting away a page whose only live plot fits in an earlier page moves that
+// plot instead of dropping it, and that relocate() points its subimages at the new location.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(DrawOpAtlasRelocation,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto context = ctxInfo.directContext();
+    auto proxyProvider = context->priv().proxyProvider();
+    auto resourceProvider = context->priv().resourceProvider();
+    auto drawingManager = context->priv().drawingManager();
+    const GrCaps* caps = context->priv().caps();
+
+    GrOnFlushResourceProvider onFlushResourceProvider(drawingManager);
+    TestingUploadTarget uploadTarget;
+
+    GrColorType atlasColorType = GrColorType::kAlpha_8;
+    GrBackendFormat format = caps->getDefaultBackendFormat(atlasColorType,
+                                                           GrRenderable::kNo);
+
+    CountingEvictor evictor;
+    skgpu::AtlasGenerationCounter counter;
+
+    std::unique_ptr<GrDrawOpAtlas> atlas = GrDrawOpAtlas::Make(
+                                                proxyProvider,
+                                                format,
+                                                GrColorTypeToSkColorType(atlasColorType),
+                                                GrColorTypeBytesPerPixel(atlasColorType),
+                                                kAtlasSize, kAtlasSize,
+                                                kAtlasSize/kNumPlots, kAtlasSize/kNumPlots,
+                                                &counter,
+                                                GrDrawOpAtlas::AllowMultitexturing::kYes,
+                                                &evictor,
+                                                /*label=*/"DrawOpAtlasRelocationTest");
+
+    // Fill up the first page, then put one more subimage on a second page.
+    skgpu::AtlasLocator firstPage[kNumPlots * kNumPlots];
+    for (int i = 0; i < kNumPlots * kNumPlots; ++i) {
+        REPORTER_ASSERT(reporter, fill_plot(
+                atlas.get(), resourceProvider, &uploadTarget, &firstPage[i], i * 32));
+    }
+    atlas->instantiate(&onFlushResourceProvider);
+    skgpu::AtlasLocator secondPage;
+    REPORTER_ASSERT(reporter,
+                    fill_plot(atlas.get(), resourceProvider, &uploadTarget, &secondPage, 4 * 32));
+    atlas->instantiate(&onFlushResourceProvider);
+    check(reporter, atlas.get(), 2, 4, 2);
+    REPORTER_ASSERT(reporter, secondPage.pageIndex() == 1);
+
+    // Keep drawing only the subimage on the second page. Once the first page's plots age out, it
+    // is moved into one of them and the second page goes away.
+    for (int i = 0; i < 512 && atlas->numActivePages() > 1; ++i) {
+        atlas->setLastUseToken(secondPage, uploadTarget.tokenTracker()->nextDrawToken());
+        uploadTarget.issueDrawToken();
+        uploadTarget.issueFlushToken();
+        atlas->compact(uploadTarget.tokenTracker()->nextFlushToken());
+    }
+    check(reporter, atlas.get(), 1, 4, 1);
+    REPORTER_ASSERT(reporter, !atlas->hasID(secondPage.plotLocator()));
+    REPORTER_ASSERT(reporter, evictor.fEvictions > 0);
+
+    // Subimages on plots that weren't moved have nothing to relocate.
+    skgpu::AtlasLocator unmoved = firstPage[0];
+    REPORTER_ASSERT(reporter, !atlas->relocate(&uploadTarget, &unmoved));
+    REPORTER_ASSERT(reporter, unmoved.getUVs() == firstPage[0].getUVs());
+
+    skgpu::AtlasLocator moved = secondPage;
+    REPORTER_ASSERT(reporter, atlas->relocate(&uploadTarget, &moved));
+    REPORTER_ASSERT(reporter, atlas->hasID(moved.plotLocator()));
+    REPORTER_ASSERT(reporter, moved.pageIndex() == 0);
+    // The UVs now address the first page, at the same spot within the new plot.
+    REPORTER_ASSERT(reporter, moved.getUVs()[0] >> 13 == 0 && moved.getUVs()[2] >> 13 == 0);
+    REPORTER_ASSERT(reporter, moved.width() == secondPage.width() &&
+                              moved.height() == secondPage.height());
+    const SkIPoint oldTopLeft = secondPage.topLeft();
+    const SkIPoint newTopLeft = moved.topLeft();
+    REPORTER_ASSERT(reporter, oldTopLeft.fX % kPlotSize == newTopLeft.fX % kPlotSize &&
+                              oldTopLeft.fY % kPlotSize == newTopLeft.fY % kPlotSize);
+
+    // The moved plot is in use again, so it isn't evicted.
+    atlas->setLastUseToken(moved, uploadTarget.tokenTracker()->nextDrawToken());
+    uploadTarget.issueDrawToken();
+    uploadTarget.issueFlushToken();
+    atlas->compact(uploadTarget.tokenTracker()->nextFlushToken());
+    REPORTER_ASSERT(reporter, atlas->hasID(moved.plotLocator()));
+}
+
 // This test verifies that the AtlasTextOp::onPrepare method correctly handles a failure
 // when allocating an atlas page.
 DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrAtlasTextOpPreparation,
@@ -22,11 +22,15 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkStrokeRec.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkDashPathEffect.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 // test that we can draw an aa-rect at coordinates > 32K (bigger than fixedpoint)
 static void test_big_aa_rect(skiatest::Reporter* reporter) {
@@ -406,6 +410,101 @@ static void test_crbug_472147_actual(skiatest::Reporter* reporter) {
     canvas->drawRect(r2, p);
 }
 
+// Paths with many verbs may be drawn in bands when the surface allows it. The bands have to
+// match the path drawn in one go, and drawing the same path has to give the same pixels.
+static void test_parallel_bands(skiatest::Reporter* reporter) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(256, 512);
+    SkPath path;
+    path.moveTo(8, 8);
+    for (int i = 0; i < 1 << 16; ++i) {
+        float y = 8 + 496.f * i / (1 << 16);
+        path.lineTo(i & 1 ? 248 - (i % 200) : 8 + (i % 150), y);
+    }
+    path.lineTo(8, 504);
+    path.close();
+
+    auto draw = [&](uint32_t flags, SkBitmap* bitmap) {
+        SkSurfaceProps props(flags, kUnknown_SkPixelGeometry);
+        auto surface = SkSurfaces::Raster(info, &props);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setColor(SK_ColorBLUE);
+        surface->getCanvas()->clear(SK_ColorWHITE);
+        surface->getCanvas()->drawPath(path, paint);
+        bitmap->allocPixels(info);
+        surface->readPixels(*bitmap, 0, 0);
+    };
+
+    SkBitmap whole, bands, bandsAgain;
+    draw(0, &whole);
+    draw(SkSurfaceProps::kParallelizeLargePaths_Flag, &bands);
+    draw(SkSurfaceProps::kParallelizeLargePaths_Flag, &bandsAgain);
+
+    int maxDiff = 0;
+    for (int y = 0; y < info.height(); ++y) {
+        for (int x = 0; x < info.width(); ++x) {
+            SkColor a = whole.getColor(x, y);
+            SkColor b = bands.getColor(x, y);
+            maxDiff = std::max({maxDiff,
+                                std::abs((int)SkColorGetR(a) - (int)SkColorGetR(b)),
+                                std::abs((int)SkColorGetG(a) - (int)SkColorGetG(b)),
+                                std::abs((int)SkColorGetB(a) - (int)SkColorGetB(b))});
+        }
+    }
+    REPORTER_ASSERT(reporter, maxDiff <= 8, "max difference %d", maxDiff);
+    REPORTER_ASSERT(reporter, !memcmp(bands.getPixels(), bandsAgain.getPixels(),
+                                      bands.computeByteSize()));
+}
+
+#if !defined(SK_LEGACY_AA_RRECT_AS_PATH)
+// Antialiased ovals and simple rrects are filled analytically. Their coverage has to be close to
+// the area of each pixel that the shape covers, and must respect the clip.
+static void test_analytic_rrects(skiatest::Reporter* reporter) {
+    const SkRRect rrects[] = {
+        SkRRect::MakeOval(SkRect::MakeXYWH(3.5f, 3.5f, 20, 20)),
+        SkRRect::MakeOval(SkRect::MakeXYWH(5.2f, 30.9f, 55, 25)),
+        SkRRect::MakeRectXY(SkRect::MakeXYWH(10.3f, 20.7f, 45, 30), 8, 8),
+        SkRRect::MakeRectXY(SkRect::MakeXYWH(5.25f, 5.75f, 50, 30), 3, 12),
+        SkRRect::MakeRectXY(SkRect::MakeXYWH(28.4f, 2.6f, 30, 20), 1, 1),
+    };
+    const SkImageInfo info = SkImageInfo::MakeA8(64, 64);
+    constexpr int kSamples = 16;
+
+    for (const SkRRect& rrect : rrects) {
+        for (bool clip : {false, true}) {
+            SkBitmap bitmap;
+            bitmap.allocPixels(info);
+            bitmap.eraseColor(SK_ColorTRANSPARENT);
+            SkCanvas canvas(bitmap);
+            if (clip) {
+                canvas.clipRect(SkRect::MakeWH(32, 64));
+            }
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            canvas.drawRRect(rrect, paint);
+
+            int maxDiff = 0;
+            for (int y = 0; y < info.height(); ++y) {
+                for (int x = 0; x < info.width(); ++x) {
+                    int covered = 0;
+                    for (int j = 0; j < kSamples && (!clip || x < 32); ++j) {
+                        for (int i = 0; i < kSamples; ++i) {
+                            SkRect sample = SkRect::MakeXYWH(x + (i + 0.5f) / kSamples,
+                                                             y + (j + 0.5f) / kSamples,
+                                                             0, 0).makeOutset(1e-4f, 1e-4f);
+                            covered += rrect.contains(sample);
+                        }
+                    }
+                    int expected = covered * 255 / (kSamples * kSamples);
+                    maxDiff = std::max(maxDiff, std::abs(*bitmap.getAddr8(x, y) - expected));
+                }
+            }
+            REPORTER_ASSERT(reporter, maxDiff <= 24, "max difference %d", maxDiff);
+        }
+    }
+}
+#endif
+
 DEF_TEST(DrawPath, reporter) {
     test_giantaa();
     test_bug533();
@@ -423,4 +522,8 @@ DEF_TEST(DrawPath, reporter) {
     test_crbug_1239558(reporter);
     test_big_aa_rect(reporter);
     test_halfway();
+    test_parallel_bands(reporter);
+#if !defined(SK_LEGACY_AA_RRECT_AS_PATH)
+    test_analytic_rrects(reporter);
+#endif
 }
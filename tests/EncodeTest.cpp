@@ -15,6 +15,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
@@ -28,6 +29,7 @@
 #include "include/encode/SkWebpEncoder.h"
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "tests/Test.h"
 #include "tools/DecodeUtils.h"
@@ -37,6 +39,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <string>
@@ -343,7 +346,191 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+// Decodes |data| to the codec's own info, so that e.g. 16-bit pngs are compared at full precision.
+static bool decode_data(const SkData* data, SkBitmap* dst) {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(SkData::MakeWithoutCopy(data->data(),
+                                                                                   data->size()));
+    if (!codec) {
+        return false;
+    }
+    dst->allocPixels(codec->getInfo());
+    return SkCodec::kSuccess == codec->getPixels(dst->pixmap());
+}
+
+static bool same_pixels(const SkBitmap& a, const SkBitmap& b) {
+    if (a.info() != b.info()) {
+        return false;
+    }
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr(0, y), b.getAddr(0, y), a.info().minRowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DEF_TEST(Encode_PngExecutor, r) {
+    SkBitmap mandrill;
+    if (!ToolUtils::GetResourceAsBitmap("images/mandrill_512.png", &mandrill)) {
+        return;
+    }
+
+    // A noisy image that needs more than one batch of bands, with alpha.
+    SkBitmap noise;
+    noise.allocPixels(SkImageInfo::Make(1200, 1800, kRGBA_8888_SkColorType,
+                                        kUnpremul_SkAlphaType));
+    SkRandom random;
+    for (int y = 0; y < noise.height(); ++y) {
+        for (int x = 0; x < noise.width(); ++x) {
+            *noise.getAddr32(x, y) = (random.nextU() & 0x0F0F0F0F) | ((x + y) & 0xFF) << 24;
+        }
+    }
+
+    std::vector<SkBitmap> sources = {mandrill, noise};
+    for (SkColorType colorType : {kRGBA_F16_SkColorType, kGray_8_SkColorType,
+                                  kRGBA_8888_SkColorType}) {
+        SkBitmap converted;
+        SkImageInfo info = mandrill.info().makeColorType(colorType);
+        if (colorType == kRGBA_8888_SkColorType) {
+            info = info.makeAlphaType(kPremul_SkAlphaType);
+        }
+        converted.allocPixels(info);
+        REPORTER_ASSERT(r, mandrill.readPixels(converted.pixmap()));
+        sources.push_back(converted);
+    }
+
+    std::unique_ptr<SkExecutor> executors[] = {SkExecutor::MakeFIFOThreadPool(1),
+                                               SkExecutor::MakeFIFOThreadPool(4)};
+
+    struct {
+        SkPngEncoder::FilterFlag fFilters;
+        int fZLibLevel;
+    } settings[] = {
+            {SkPngEncoder::FilterFlag::kAll, 6},
+            {SkPngEncoder::FilterFlag::kZero, 1},
+            {SkPngEncoder::FilterFlag::kSub, 9},
+            {SkPngEncoder::FilterFlag::kUp, 0},
+            {SkPngEncoder::FilterFlag::kAvg, 6},
+            {SkPngEncoder::FilterFlag::kPaeth, 6},
+    };
+
+    for (const SkBitmap& source : sources) {
+        for (const auto& setting : settings) {
+            if (source.width() > 1000 && setting.fZLibLevel != 1) {
+                continue;  // Keep the test fast.
+            }
+            SkPngEncoder::Options options;
+            options.fFilterFlags = setting.fFilters;
+            options.fZLibLevel = setting.fZLibLevel;
+
+            SkDynamicMemoryWStream serialStream;
+            REPORTER_ASSERT(r, SkPngEncoder::Encode(&serialStream, source.pixmap(), options));
+            sk_sp<SkData> serial = serialStream.detachAsData();
+
+            sk_sp<SkData> parallel[2];
+            for (int i = 0; i < 2; ++i) {
+                options.fExecutor = executors[i].get();
+                SkDynamicMemoryWStream stream;
+                if (i == 0) {
+                    REPORTER_ASSERT(r, SkPngEncoder::Encode(&stream, source.pixmap(), options));
+                } else {
+                    // Encoding in several calls gives the same result as in one.
+                    auto encoder = SkPngEncoder::Make(&stream, source.pixmap(), options);
+                    REPORTER_ASSERT(r, encoder);
+                    for (int y = 0; y < source.height(); y += 77) {
+                        REPORTER_ASSERT(r, encoder->encodeRows(77));
+                    }
+                }
+                parallel[i] = stream.detachAsData();
+            }
+            REPORTER_ASSERT(r, parallel[0]->equals(parallel[1].get()));
+
+            SkBitmap expected, actual;
+            REPORTER_ASSERT(r, decode_data(serial.get(), &expected));
+            REPORTER_ASSERT(r, decode_data(parallel[0].get(), &actual));
+            REPORTER_ASSERT(r, same_pixels(expected, actual),
+                            "color type %d filters %d level %d", source.colorType(),
+                            (int)setting.fFilters, setting.fZLibLevel);
+        }
+    }
+}
+
+DEF_TEST(Encode_JpegExecutor, r) {
+    SkBitmap mandrill;
+    if (!ToolUtils::GetResourceAsBitmap("images/mandrill_512.png", &mandrill)) {
+        return;
+    }
+
+    // Sizes that aren't whole MCUs, so the last band and column are partial.
+    std::vector<SkBitmap> sources;
+    for (SkColorType colorType : {kRGBA_8888_SkColorType, kGray_8_SkColorType,
+                                  kRGB_565_SkColorType}) {
+        SkBitmap converted;
+        converted.allocPixels(SkImageInfo::Make(501, 487, colorType, kOpaque_SkAlphaType));
+        REPORTER_ASSERT(r, mandrill.readPixels(converted.pixmap()));
+        sources.push_back(converted);
+    }
+
+    std::unique_ptr<SkExecutor> executors[] = {SkExecutor::MakeFIFOThreadPool(1),
+                                               SkExecutor::MakeFIFOThreadPool(4)};
+
+    for (const SkBitmap& source : sources) {
+        for (auto downsample : {SkJpegEncoder::Downsample::k420,
+                                SkJpegEncoder::Downsample::k422,
+                                SkJpegEncoder::Downsample::k444}) {
+            SkJpegEncoder::Options options;
+            options.fQuality = 90;
+            options.fDownsample = downsample;
+
+            SkDynamicMemoryWStream serialStream;
+            REPORTER_ASSERT(r, SkJpegEncoder::Encode(&serialStream, source.pixmap(), options));
+            sk_sp<SkData> serial = serialStream.detachAsData();
+
+            sk_sp<SkData> parallel[2];
+            for (int i = 0; i < 2; ++i) {
+                options.fExecutor = executors[i].get();
+                SkDynamicMemoryWStream stream;
+                REPORTER_ASSERT(r, SkJpegEncoder::Encode(&stream, source.pixmap(), options));
+                parallel[i] = stream.detachAsData();
+            }
+            REPORTER_ASSERT(r, parallel[0]->equals(parallel[1].get()));
+
+            // Only the entropy coding differs, so the pixels are exactly the same.
+            SkBitmap expected, actual;
+            REPORTER_ASSERT(r, decode_data(serial.get(), &expected));
+            REPORTER_ASSERT(r, decode_data(parallel[0].get(), &actual));
+            REPORTER_ASSERT(r, same_pixels(expected, actual),
+                            "color type %d downsample %d", source.colorType(), (int)downsample);
+        }
+    }
+}
+
 #ifndef SK_BUILD_FOR_GOOGLE3
+DEF_TEST(Encode_WebpExecutor, r) {
+    SkBitmap mandrill;
+    if (!ToolUtils::GetResourceAsBitmap("images/mandrill_512.png", &mandrill)) {
+        return;
+    }
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+
+    for (auto compression : {SkWebpEncoder::Compression::kLossy,
+                             SkWebpEncoder::Compression::kLossless}) {
+        SkWebpEncoder::Options options;
+        options.fCompression = compression;
+        options.fQuality = 90;
+
+        SkDynamicMemoryWStream serialStream, parallelStream;
+        REPORTER_ASSERT(r, SkWebpEncoder::Encode(&serialStream, mandrill.pixmap(), options));
+        options.fExecutor = executor.get();
+        REPORTER_ASSERT(r, SkWebpEncoder::Encode(&parallelStream, mandrill.pixmap(), options));
+
+        SkBitmap expected, actual;
+        REPORTER_ASSERT(r, decode_data(serialStream.detachAsData().get(), &expected));
+        REPORTER_ASSERT(r, decode_data(parallelStream.detachAsData().get(), &actual));
+        REPORTER_ASSERT(r, same_pixels(expected, actual), "compression %d", (int)compression);
+    }
+}
+
 DEF_TEST(Encode_WebpQuality, r) {
     SkBitmap bm;
     bm.allocN32Pixels(100, 100);
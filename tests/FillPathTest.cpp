@@ -8,14 +8,18 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkScan.h"
 #include "tests/Test.h"
 
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 
 struct FakeBlitter : public SkBlitter {
     FakeBlitter()
@@ -52,3 +56,154 @@ DEF_TEST(FillPathInverse, reporter) {
 
     REPORTER_ASSERT(reporter, blitter.m_blitCount == expected_lines);
 }
+
+struct CoverageBlitter : public SkBlitter {
+    static constexpr int kSize = 32;
+
+    void blitH(int x, int y, int width) override {
+        for (int i = 0; i < width; ++i) {
+            fCoverage[y][x + i] = 0xFF;
+        }
+    }
+
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override {
+        for (int i = 0; runs[i]; i += runs[i]) {
+            for (int j = 0; j < runs[i]; ++j) {
+                fCoverage[y][x + i + j] = antialias[i];
+            }
+        }
+    }
+
+    SkAlpha fCoverage[kSize][kSize] = {};
+};
+
+static void sparse_fill(const SkPath& path, CoverageBlitter* blitter) {
+    SkScan::SparseAAFillPath(path,
+                             blitter,
+                             path.getBounds().roundOut(),
+                             SkIRect::MakeWH(CoverageBlitter::kSize, CoverageBlitter::kSize));
+}
+
+// Coverage of pixel (x, y) estimated from a 32x32 grid of samples.
+static int supersampled_coverage(const SkPath& path, int x, int y) {
+    constexpr int kSamples = 32;
+    int inside = 0;
+    for (int j = 0; j < kSamples; ++j) {
+        for (int i = 0; i < kSamples; ++i) {
+            inside += path.contains(x + (i + 0.5f) / kSamples, y + (j + 0.5f) / kSamples);
+        }
+    }
+    return (int)std::lrint(inside * 255.f / (kSamples * kSamples));
+}
+
+// Compares sparse coverage against a supersampled reference. Pixels within a pixel and a half of
+// one of the crossings are held to crossingTolerance, every other pixel to tolerance, and the
+// total coverage has to match to within 1%.
+static void check_against_supersampled(skiatest::Reporter* reporter,
+                                       const char* name,
+                                       const SkPath& path,
+                                       int tolerance,
+                                       SkSpan<const SkPoint> crossings = {},
+                                       int crossingTolerance = 0) {
+    CoverageBlitter blitter;
+    sparse_fill(path, &blitter);
+
+    int64_t expectedTotal = 0, actualTotal = 0;
+    for (int y = 0; y < CoverageBlitter::kSize; ++y) {
+        for (int x = 0; x < CoverageBlitter::kSize; ++x) {
+            int expected = supersampled_coverage(path, x, y);
+            int actual = blitter.fCoverage[y][x];
+            expectedTotal += expected;
+            actualTotal += actual;
+
+            bool nearCrossing = false;
+            for (SkPoint p : crossings) {
+                nearCrossing |= std::abs(p.fX - (x + 0.5f)) < 1.5f &&
+                                std::abs(p.fY - (y + 0.5f)) < 1.5f;
+            }
+            int allowed = nearCrossing ? crossingTolerance : tolerance;
+            REPORTER_ASSERT(reporter, std::abs(actual - expected) <= allowed,
+                            "%s (%d, %d): expected %d, got %d", name, x, y, expected, actual);
+        }
+    }
+    REPORTER_ASSERT(reporter, std::abs(actualTotal - expectedTotal) * 100 <= expectedTotal,
+                    "%s: expected total %lld, got %lld",
+                    name, (long long)expectedTotal, (long long)actualTotal);
+}
+
+// Sparse AA computes the exact area each pixel covers, as long as the edges of overlapping
+// contours don't cross within a pixel.
+DEF_TEST(FillPathSparseAA, reporter) {
+    const SkRect rect = SkRect::MakeLTRB(3.25f, 4.5f, 10.75f, 8.25f);
+    const SkRect overlap = SkRect::MakeLTRB(6, 2, 14, 6);
+    auto area = [](const SkRect& r, int x, int y) {
+        SkRect pixel = SkRect::MakeXYWH(x, y, 1, 1);
+        return pixel.intersect(r) ? pixel.width() * pixel.height() : 0.f;
+    };
+
+    for (SkPathFillType fillType : {SkPathFillType::kWinding, SkPathFillType::kEvenOdd}) {
+        SkPath path;
+        path.addRect(rect);
+        path.addRect(overlap);
+        path.setFillType(fillType);
+
+        CoverageBlitter blitter;
+        sparse_fill(path, &blitter);
+
+        for (int y = 0; y < CoverageBlitter::kSize; ++y) {
+            for (int x = 0; x < CoverageBlitter::kSize; ++x) {
+                float a = area(rect, x, y);
+                float b = area(overlap, x, y);
+                SkRect both = rect;
+                float ab = both.intersect(overlap) ? area(both, x, y) : 0.f;
+                float coverage = fillType == SkPathFillType::kWinding ? a + b - ab
+                                                                      : a + b - 2 * ab;
+                int expected = (int)std::lrint(coverage * 255);
+                int actual = blitter.fCoverage[y][x];
+                REPORTER_ASSERT(reporter, std::abs(actual - expected) <= 1,
+                                "(%d, %d): expected %d, got %d", x, y, expected, actual);
+            }
+        }
+    }
+}
+
+// Curves are flattened to lines before binning, so coverage along them is approximate.
+DEF_TEST(FillPathSparseAACurves, reporter) {
+    check_against_supersampled(reporter, "circle", SkPath::Circle(16, 16, 12.3f), 20);
+
+    SkPath cubic;
+    cubic.moveTo(2, 30).cubicTo(2, -10, 30, 40, 30, 2).lineTo(20, 30).close();
+    check_against_supersampled(reporter, "cubic", cubic, 20);
+}
+
+// Where edges cross inside a pixel the accumulated area can't tell winding from even-odd, so those
+// pixels are only roughly right; everywhere else coverage matches the reference.
+DEF_TEST(FillPathSparseAASelfIntersecting, reporter) {
+    const SkPoint center = {16, 16.3f};
+    const float outer = 14;
+    const float inner = outer * std::cos(2 * SK_ScalarPI / 5) / std::cos(SK_ScalarPI / 5);
+    SkPath star;
+    SkPoint crossings[5];
+    for (int i = 0; i < 5; ++i) {
+        float a = -SK_ScalarPI / 2 + i * 4 * SK_ScalarPI / 5;
+        SkPoint p = center + SkPoint{outer * std::cos(a), outer * std::sin(a)};
+        if (i == 0) {
+            star.moveTo(p);
+        } else {
+            star.lineTo(p);
+        }
+        float b = -SK_ScalarPI / 2 + SK_ScalarPI / 5 + i * 2 * SK_ScalarPI / 5;
+        crossings[i] = center + SkPoint{inner * std::cos(b), inner * std::sin(b)};
+    }
+    star.close();
+
+    star.setFillType(SkPathFillType::kWinding);
+    check_against_supersampled(reporter, "star winding", star, 3, crossings, 64);
+    star.setFillType(SkPathFillType::kEvenOdd);
+    check_against_supersampled(reporter, "star even-odd", star, 3, crossings, 64);
+
+    SkPath bowtie;
+    bowtie.moveTo(3, 3).lineTo(29, 29).lineTo(29, 3).lineTo(3, 29).close();
+    const SkPoint bowtieCrossing[] = {{16, 16}};
+    check_against_supersampled(reporter, "bowtie", bowtie, 3, bowtieCrossing, 8);
+}
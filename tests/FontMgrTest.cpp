@@ -19,6 +19,7 @@
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMalloc.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h" // IWYU pragma: keep
+#include "src/core/SkFontFallbackCache.h"
 #include "src/core/SkFontPriv.h"
 #include "src/core/SkScalerContext.h"
 #include "tests/Test.h"
@@ -804,3 +805,32 @@ DEF_TEST(FontMgr_MatchCharacter, reporter) {
     fm->matchFamilyStyleCharacter("Blah", SkFontStyle::Normal(), nullptr, 0, 0x1FFFFF);
     fm->matchFamilyStyleCharacter("Blah", SkFontStyle::Normal(), nullptr, 0, -1);
 }
+
+DEF_TEST(FontMgr_FallbackCache, reporter) {
+    SkFontFallbackCache cache;
+    sk_sp<SkTypeface> face = ToolUtils::DefaultPortableTypeface();
+    const char* langs[] = {"ab", "c"};
+
+    sk_sp<SkTypeface> found;
+    REPORTER_ASSERT(reporter,
+                    !cache.find("Blah", SkFontStyle::Normal(), langs, 2, 'A', &found));
+    cache.add("Blah", SkFontStyle::Normal(), langs, 2, 'A', face);
+    REPORTER_ASSERT(reporter, cache.find("Blah", SkFontStyle::Normal(), langs, 2, 'A', &found));
+    REPORTER_ASSERT(reporter, found == face);
+
+    // A request which found nothing is remembered as a null typeface.
+    cache.add(nullptr, SkFontStyle::Normal(), nullptr, 0, 'B', nullptr);
+    found = face;
+    REPORTER_ASSERT(reporter, cache.find(nullptr, SkFontStyle::Normal(), nullptr, 0, 'B', &found));
+    REPORTER_ASSERT(reporter, !found);
+
+    // Each part of the request is part of the key.
+    const char* joinedLangs[] = {"a", "bc"};
+    REPORTER_ASSERT(reporter,
+                    !cache.find("Blah", SkFontStyle::Normal(), joinedLangs, 2, 'A', &found));
+    REPORTER_ASSERT(reporter,
+                    !cache.find("Blah", SkFontStyle::Bold(), langs, 2, 'A', &found));
+    REPORTER_ASSERT(reporter,
+                    !cache.find("Blah", SkFontStyle::Normal(), langs, 2, 'C', &found));
+    REPORTER_ASSERT(reporter, !cache.find("", SkFontStyle::Normal(), nullptr, 0, 'B', &found));
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#ifdef SK_GL
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/gl/GrGLCaps.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+
+#include <cstdlib>
+
+struct GrContextOptions;
+
+// Draws with a runtime shader whose uniforms have every std140 alignment class (scalar, vec3,
+// scalar array, mat3), so the program's uniforms live in a uniform block and any mismatch between
+// the block declaration and the offsets GrGLUniformHandler packs values at shows up as a wrong
+// color.
+DEF_GANESH_TEST_FOR_GL_CONTEXT(GLUniformBlockDraw, reporter, ctxInfo, CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    const auto* glCaps = static_cast<const GrGLCaps*>(dContext->priv().caps());
+    if (!glCaps->uniformBufferSupport()) {
+        return;
+    }
+
+    auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString(R"(
+        uniform float a;
+        uniform float3 b;
+        uniform float c[3];
+        uniform float3x3 m;
+        uniform half4 d;
+        half4 main(float2 p) {
+            float3 v = m * b;
+            return half4(a + c[0], v.y, c[2] - c[1], d.a);
+        }
+    )"));
+    REPORTER_ASSERT(reporter, effect, "%s", error.c_str());
+    if (!effect) {
+        return;
+    }
+
+    SkRuntimeShaderBuilder builder(effect);
+    builder.uniform("a") = 0.25f;
+    builder.uniform("b") = SkV3{0.f, 1.5f, 0.f};
+    const float c[3] = {0.25f, 0.125f, 0.625f};
+    builder.uniform("c").set(c, 3);
+    // Column-major; only the diagonal is non-zero so v.y == m[1][1] * b.y.
+    const float m[9] = {1.f, 0.f, 0.f,
+                        0.f, 0.5f, 0.f,
+                        0.f, 0.f, 1.f};
+    builder.uniform("m").set(m, 9);
+    builder.uniform("d") = SkV4{0.f, 0.f, 0.f, 1.f};
+
+    const SkImageInfo info = SkImageInfo::Make(8, 8, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, info);
+    if (!surface) {
+        ERRORF(reporter, "Could not create surface");
+        return;
+    }
+
+    SkPaint paint;
+    paint.setShader(builder.makeShader());
+    // Draw twice so the second draw sources its block from a later slice of the uniform ring.
+    for (int i = 0; i < 2; ++i) {
+        surface->getCanvas()->drawPaint(paint);
+    }
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(info);
+    if (!surface->readPixels(bitmap, 0, 0)) {
+        ERRORF(reporter, "Could not read pixels");
+        return;
+    }
+
+    const SkColor expected = SkColorSetARGB(255, 128, 191, 128);
+    for (int y = 0; y < info.height(); ++y) {
+        for (int x = 0; x < info.width(); ++x) {
+            SkColor actual = bitmap.getColor(x, y);
+            bool close = SkColorGetA(actual) == 255 &&
+                         std::abs((int)SkColorGetR(actual) - (int)SkColorGetR(expected)) <= 1 &&
+                         std::abs((int)SkColorGetG(actual) - (int)SkColorGetG(expected)) <= 1 &&
+                         std::abs((int)SkColorGetB(actual) - (int)SkColorGetB(expected)) <= 1;
+            if (!close) {
+                ERRORF(reporter, "(%d, %d): expected 0x%08x, got 0x%08x",
+                       x, y, expected, actual);
+                return;
+            }
+        }
+    }
+}
+#endif
@@ -315,3 +315,63 @@ DEF_TEST(GainmapShader_colorSpace, r) {
             sdrImage, gainmapImage, gainmapInfo, gainmapInfo.fDisplayRatioHdr, dstColorSpace);
     REPORTER_ASSERT(r, !approx_equal(color, kExpectedColor));
 }
+
+// Verify that applying the gainmap on the CPU matches drawing with the gainmap shader, including
+// a gainmap that is smaller than the base image and filtered up to its size.
+DEF_TEST(GainmapShader_applyToPixmap, r) {
+    constexpr int kW = 8, kH = 6;
+    SkBitmap base;
+    base.allocPixels(SkImageInfo::MakeN32(kW, kH, kOpaque_SkAlphaType, SkColorSpace::MakeSRGB()));
+    for (int y = 0; y < kH; ++y) {
+        for (int x = 0; x < kW; ++x) {
+            *base.getAddr32(x, y) = SkPreMultiplyARGB(0xFF, 30 * x, 40 * y, 255 - 20 * x);
+        }
+    }
+    SkBitmap gainmap;
+    gainmap.allocPixels(SkImageInfo::Make(kW / 2, kH / 2, kGray_8_SkColorType,
+                                          kOpaque_SkAlphaType));
+    for (int y = 0; y < kH / 2; ++y) {
+        for (int x = 0; x < kW / 2; ++x) {
+            *gainmap.getAddr8(x, y) = (uint8_t)(60 * x + 50 * y);
+        }
+    }
+    SkGainmapInfo gainmapInfo = simple_gainmap_info(4.f);
+    gainmapInfo.fGainmapRatioMin = {0.5f, 0.5f, 0.5f, 1.f};
+    gainmapInfo.fGainmapGamma = {0.8f, 0.8f, 0.8f, 1.f};
+    gainmapInfo.fEpsilonSdr = {0.01f, 0.01f, 0.01f, 1.f};
+    gainmapInfo.fEpsilonHdr = {0.02f, 0.02f, 0.02f, 1.f};
+
+    const SkImageInfo dstInfo = SkImageInfo::Make(
+            kW, kH, kRGBA_F32_SkColorType, kPremul_SkAlphaType, SkColorSpace::MakeSRGBLinear());
+    const SkRect rect = SkRect::MakeIWH(kW, kH);
+    for (float dstRatio : {1.f, 2.f, 4.f}) {
+        SkBitmap drawn;
+        drawn.allocPixels(dstInfo);
+        drawn.eraseColor(SK_ColorTRANSPARENT);
+        const SkSamplingOptions linear(SkFilterMode::kLinear);
+        SkPaint paint;
+        paint.setShader(SkGainmapShader::Make(base.asImage(), rect, linear,
+                                              gainmap.asImage(), SkRect::Make(gainmap.bounds()),
+                                              linear, gainmapInfo, rect, dstRatio,
+                                              dstInfo.refColorSpace()));
+        SkCanvas(drawn).drawRect(rect, paint);
+
+        SkBitmap applied;
+        applied.allocPixels(dstInfo);
+        REPORTER_ASSERT(r, SkGainmapShader::ApplyToPixmap(base.pixmap(), gainmap.pixmap(),
+                                                          gainmapInfo, dstRatio,
+                                                          applied.pixmap()));
+        for (int y = 0; y < kH; ++y) {
+            for (int x = 0; x < kW; ++x) {
+                SkColor4f a = drawn.getColor4f(x, y), b = applied.getColor4f(x, y);
+                // Both evaluate exp() and pow() approximately, so allow a little more than
+                // approx_equal() does.
+                REPORTER_ASSERT(r,
+                                std::abs(a.fR - b.fR) < 1e-2f && std::abs(a.fG - b.fG) < 1e-2f &&
+                                std::abs(a.fB - b.fB) < 1e-2f && std::abs(a.fA - b.fA) < 1e-2f,
+                                "ratio %g pixel (%d, %d): drew (%g %g %g), applied (%g %g %g)",
+                                dstRatio, x, y, a.fR, a.fG, a.fB, b.fR, b.fG, b.fB);
+            }
+        }
+    }
+}
@@ -33,6 +33,7 @@
 #include "src/gpu/ganesh/GrAppliedClip.h"
 #include "src/gpu/ganesh/GrClip.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrDrawingManager.h"
 #include "src/gpu/ganesh/GrPaint.h"
 #include "src/gpu/ganesh/GrProcessorSet.h"
 #include "src/gpu/ganesh/GrProxyProvider.h"
@@ -2193,3 +2194,47 @@ DEF_GANESH_TEST_FOR_CONTEXTS(ClipStack_SWMask,
     cs = nullptr;
     verifyKeys({}, {keyADepth1, keyBDepth1});
 }
+
+DEF_GANESH_TEST_FOR_CONTEXTS(ClipStack_AtlasClips,
+                             skgpu::IsRenderingContext,
+                             r,
+                             ctxInfo,
+                             nullptr,
+                             CtsEnforcement::kNextRelease) {
+    using ClipStack = skgpu::ganesh::ClipStack;
+    using SurfaceDrawContext = skgpu::ganesh::SurfaceDrawContext;
+
+    GrDirectContext* context = ctxInfo.directContext();
+    if (!context->priv().drawingManager()->getAtlasPathRenderer()) {
+        return;
+    }
+    std::unique_ptr<SurfaceDrawContext> sdc = SurfaceDrawContext::Make(
+            context, GrColorType::kRGBA_8888, nullptr, SkBackingFit::kExact, kDeviceBounds.size(),
+            SkSurfaceProps(), /*label=*/{});
+
+    // More analytic and atlas clip elements together than the analytic FP limit alone allows.
+    // None of them contains another, so none is dropped by the stack.
+    ClipStack cs(kDeviceBounds, &SkMatrix::I(), false);
+    for (int i = 0; i < 3; ++i) {
+        SkScalar offset = 2.f * i;
+        cs.clipPath(SkMatrix::I(), make_octagon(SkRect::MakeLTRB(10.f + offset, 10.f, 70.f + offset,
+                                                                 70.f)),
+                    GrAA::kYes, SkClipOp::kIntersect);
+
+        SkPath path;
+        path.addCircle(40.f - offset, 40.f, 30.f);
+        path.addCircle(45.f - offset, 45.f, 8.f);
+        path.setFillType(SkPathFillType::kEvenOdd);
+        cs.clipPath(SkMatrix::I(), path, GrAA::kYes, SkClipOp::kIntersect);
+    }
+
+    SkRect drawBounds = {20.f, 20.f, 60.f, 60.f};
+    GrAppliedClip out(kDeviceBounds.size());
+    GrClip::Effect effect = cs.apply(context, sdc.get(), NoOp::Get(), GrAAType::kCoverage, &out,
+                                     &drawBounds);
+    REPORTER_ASSERT(r, effect == GrClip::Effect::kClipped, "Draw should be clipped");
+    REPORTER_ASSERT(r, out.hasCoverageFragmentProcessor(), "Clip should use coverage FPs");
+    REPORTER_ASSERT(r, !out.hardClip().hasStencilClip(), "Clip should not need stencil");
+    REPORTER_ASSERT(r, !cs.testingOnly_getLastSWMaskKey().isValid(),
+                    "Clip should not need a SW mask");
+}
@@ -14,6 +14,7 @@
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
 #include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
 #include "include/private/SkColorData.h"
 #include "include/private/base/SkAlign.h"
 #include "include/private/base/SkTemplates.h"
@@ -37,6 +38,7 @@
 #include "src/gpu/ganesh/GrProcessorSet.h"
 #include "src/gpu/ganesh/GrProgramInfo.h"
 #include "src/gpu/ganesh/GrResourceProvider.h"
+#include "src/gpu/ganesh/GrRingBuffer.h"
 #include "src/gpu/ganesh/GrSimpleMesh.h"
 #include "src/gpu/ganesh/GrUserStencilSettings.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
@@ -54,6 +56,7 @@
 #include <memory>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 class GrDstProxyView;
 class GrGLSLProgramDataManager;
@@ -485,3 +488,84 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrGpuBufferUpdateDataTest,
         }
     }
 }
+
+// Streams data through the GPU's vertex ring (the persistently mapped one on GL), wrapping it
+// several times over a few submits. Memory may only be handed out again once the submit that last
+// used it has finished on the GPU, and until then it must keep what was written to it.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrGpuBufferStreamingRingTest,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    GrDirectContext* dc = ctxInfo.directContext();
+    GrRingBuffer* ring = dc->priv().getGpu()->streamingRingBuffer(GrGpuBufferType::kVertex);
+    if (!ring) {
+        return;
+    }
+
+    static constexpr int kSubmitCount = 9;
+    static constexpr int kSlicesPerSubmit = 6;
+    // Each submit takes 3/4 of the ring's initial size.
+    const size_t sliceSize = ring->size() / 8;
+
+    struct Slice {
+        sk_sp<GrGpuBuffer> fBuffer;
+        size_t fOffset;
+        uint8_t fValue;
+        int fSubmit;
+    };
+    std::vector<Slice> slices;
+    // finished[i] is set by a finished proc flushed just before submit i, so it can only be set
+    // once the ring has been told that the slices of submit i are done.
+    bool finished[kSubmitCount] = {};
+    int reuseCount = 0;
+
+    for (int submit = 0; submit < kSubmitCount; ++submit) {
+        for (int i = 0; i < kSlicesPerSubmit; ++i) {
+            GrRingBuffer::Slice slice = ring->suballocate(sliceSize);
+            if (!slice.fBuffer) {
+                ERRORF(reporter, "Could not suballocate from the ring");
+                return;
+            }
+            for (const Slice& prev : slices) {
+                if (prev.fBuffer.get() == slice.fBuffer &&
+                    prev.fOffset < slice.fOffset + sliceSize &&
+                    slice.fOffset < prev.fOffset + sliceSize) {
+                    REPORTER_ASSERT(reporter, finished[prev.fSubmit],
+                                    "submit %d reused memory of unfinished submit %d",
+                                    submit, prev.fSubmit);
+                    ++reuseCount;
+                }
+            }
+            auto data = static_cast<uint8_t*>(slice.fBuffer->map());
+            if (!data) {
+                ERRORF(reporter, "Could not map the ring");
+                return;
+            }
+            const uint8_t value = static_cast<uint8_t>(slices.size() + 1);
+            memset(data + slice.fOffset, value, sliceSize);
+            slices.push_back({sk_ref_sp(slice.fBuffer), slice.fOffset, value, submit});
+        }
+
+        for (const Slice& slice : slices) {
+            if (finished[slice.fSubmit]) {
+                continue;
+            }
+            auto data = static_cast<const uint8_t*>(slice.fBuffer->map()) + slice.fOffset;
+            REPORTER_ASSERT(reporter,
+                            data[0] == slice.fValue && data[sliceSize - 1] == slice.fValue,
+                            "slice of submit %d was overwritten", slice.fSubmit);
+        }
+
+        GrFlushInfo flushInfo;
+        flushInfo.fFinishedProc = [](GrGpuFinishedContext context) {
+            *static_cast<bool*>(context) = true;
+        };
+        flushInfo.fFinishedContext = &finished[submit];
+        dc->flush(flushInfo);
+        // Wait now and then, so that the ring is known to wrap rather than only grow.
+        dc->submit(submit % 3 == 2 ? GrSyncCpu::kYes : GrSyncCpu::kNo);
+    }
+    dc->submit(GrSyncCpu::kYes);
+
+    REPORTER_ASSERT(reporter, reuseCount > 0);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+
+struct GrContextOptions;
+
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrGpuCounters, reporter, ctxInfo, CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(
+            dContext, skgpu::Budgeted::kNo, SkImageInfo::MakeN32Premul(64, 64));
+    REPORTER_ASSERT(reporter, surface);
+    SkCanvas* canvas = surface->getCanvas();
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+
+    // Rects of one color batch into fewer draw calls than draws.
+    constexpr int kRects = 3;
+    skgpu::GpuCounters before = dContext->getGpuCounters();
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    for (int i = 0; i < kRects; ++i) {
+        canvas->drawRect(SkRect::MakeXYWH(8 * i, 8 * i, 16, 16), paint);
+    }
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+    skgpu::GpuCounters diff = dContext->getGpuCounters() - before;
+    REPORTER_ASSERT(reporter, diff.fRenderPasses >= 1);
+    REPORTER_ASSERT(reporter, diff.fDrawsRecorded == kRects, "%llu",
+                    (unsigned long long)diff.fDrawsRecorded);
+    REPORTER_ASSERT(reporter, diff.fDrawCalls >= 1 && diff.fDrawCalls <= kRects, "%llu",
+                    (unsigned long long)diff.fDrawCalls);
+
+    // Drawing a raster image uploads at least its pixels.
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType));
+    bitmap.eraseColor(SK_ColorGREEN);
+    before = dContext->getGpuCounters();
+    canvas->drawImage(bitmap.asImage(), 0, 0);
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+    diff = dContext->getGpuCounters() - before;
+    REPORTER_ASSERT(reporter, diff.fTextureUploadBytes >= bitmap.computeByteSize(), "%llu",
+                    (unsigned long long)diff.fTextureUploadBytes);
+    REPORTER_ASSERT(reporter, diff.fDrawsRecorded >= 1 && diff.fDrawCalls >= 1);
+    REPORTER_ASSERT(reporter, diff.fRenderPasses >= 1);
+
+    // Nothing is counted while the context is idle.
+    before = dContext->getGpuCounters();
+    dContext->flushAndSubmit(GrSyncCpu::kYes);
+    diff = dContext->getGpuCounters() - before;
+    REPORTER_ASSERT(reporter, diff.fRenderPasses == 0 && diff.fDrawsRecorded == 0 &&
+                              diff.fDrawCalls == 0 && diff.fTextureUploadBytes == 0);
+}
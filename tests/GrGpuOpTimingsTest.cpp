@@ -0,0 +1,127 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+#include "tools/gpu/ContextType.h"
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+struct GrContextOptions;
+
+static void draw_rects(GrDirectContext* dContext, SkSurface* surface) {
+    SkPaint paint;
+    for (int i = 0; i < 16; ++i) {
+        paint.setColor(i & 1 ? SK_ColorRED : SK_ColorBLUE);
+        surface->getCanvas()->drawRect(SkRect::MakeXYWH(i, i, 32, 32), paint);
+    }
+    dContext->flushAndSubmit(surface, GrSyncCpu::kYes);
+}
+
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrGpuOpTimings,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(
+            dContext, skgpu::Budgeted::kNo, SkImageInfo::MakeN32Premul(64, 64));
+    REPORTER_ASSERT(reporter, surface);
+
+    // Nothing is measured until timing is enabled.
+    draw_rects(dContext, surface.get());
+    REPORTER_ASSERT(reporter, dContext->takeGpuOpTimings().empty());
+
+    dContext->setGpuOpTimingsEnabled(true);
+    draw_rects(dContext, surface.get());
+    std::vector<GrDirectContext::GpuOpTiming> timings = dContext->takeGpuOpTimings();
+    if (!dContext->supportsGpuOpTimings()) {
+        REPORTER_ASSERT(reporter, timings.empty());
+        return;
+    }
+
+    // On GL ES a disjoint timer (e.g. a GPU clock change) drops a batch of timings, so retry.
+    for (int attempt = 0; timings.empty() && attempt < 3; ++attempt) {
+        draw_rects(dContext, surface.get());
+        timings = dContext->takeGpuOpTimings();
+    }
+    REPORTER_ASSERT(reporter, !timings.empty());
+    for (const GrDirectContext::GpuOpTiming& timing : timings) {
+        REPORTER_ASSERT(reporter, timing.fOpName && strlen(timing.fOpName) > 0);
+        REPORTER_ASSERT(reporter, timing.fCount > 0);
+        REPORTER_ASSERT(reporter, timing.fTime >= std::chrono::nanoseconds(0));
+    }
+    // Taking the timings resets them.
+    REPORTER_ASSERT(reporter, dContext->takeGpuOpTimings().empty());
+
+    dContext->setGpuOpTimingsEnabled(false);
+    draw_rects(dContext, surface.get());
+    REPORTER_ASSERT(reporter, dContext->takeGpuOpTimings().empty());
+}
+
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrShaderCompileTimings,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    if (dContext->backend() != GrBackendApi::kOpenGL &&
+        dContext->backend() != GrBackendApi::kVulkan) {
+        return;
+    }
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(
+            dContext, skgpu::Budgeted::kNo, SkImageInfo::MakeN32Premul(64, 64));
+    REPORTER_ASSERT(reporter, surface);
+
+    // Each draw uses a runtime effect that no other test uses, so it needs a new program.
+    auto draw_with_new_program = [&](float red) {
+        SkString sksl = SkStringPrintf("half4 main(float2 p) { return half4(%g, 0.5, 0.25, 1); }",
+                                       red);
+        auto [effect, error] = SkRuntimeEffect::MakeForShader(sksl);
+        REPORTER_ASSERT(reporter, effect, "%s", error.c_str());
+        SkPaint paint;
+        paint.setShader(effect->makeShader(nullptr, {}));
+        surface->getCanvas()->drawPaint(paint);
+        dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+    };
+
+    draw_with_new_program(0.1234f);
+    REPORTER_ASSERT(reporter, dContext->takeShaderCompileTimings().empty());
+
+    dContext->setShaderCompileTimingsEnabled(true);
+    draw_with_new_program(0.5678f);
+    std::vector<GrDirectContext::ShaderCompileTiming> timings =
+            dContext->takeShaderCompileTimings();
+    REPORTER_ASSERT(reporter, !timings.empty());
+    for (const GrDirectContext::ShaderCompileTiming& timing : timings) {
+        REPORTER_ASSERT(reporter, timing.fKey && timing.fKey->size() > 0);
+        REPORTER_ASSERT(reporter, timing.fParseTime >= std::chrono::nanoseconds(0));
+        REPORTER_ASSERT(reporter, timing.fOptimizeTime >= std::chrono::nanoseconds(0));
+        REPORTER_ASSERT(reporter, timing.fCodegenTime >= std::chrono::nanoseconds(0));
+        REPORTER_ASSERT(reporter, timing.fDriverTime >= std::chrono::nanoseconds(0));
+    }
+    REPORTER_ASSERT(reporter, dContext->takeShaderCompileTimings().empty());
+
+    dContext->setShaderCompileTimingsEnabled(false);
+    draw_with_new_program(0.9012f);
+    REPORTER_ASSERT(reporter, dContext->takeShaderCompileTimings().empty());
+}
@@ -7,14 +7,20 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
+#include "include/core/SkBlender.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMesh.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
 #include "include/gpu/GrDirectContext.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "include/private/SkColorData.h"
 #include "include/private/base/SkAlignedStorage.h"
 #include "include/private/base/SkOnce.h"
@@ -43,6 +49,7 @@
 #include "src/gpu/ganesh/GrResourceProvider.h"
 #include "src/gpu/ganesh/GrShaderCaps.h"
 #include "src/gpu/ganesh/GrShaderVar.h"
+#include "src/gpu/ganesh/GrSimpleMesh.h"
 #include "src/gpu/ganesh/GrUserStencilSettings.h"
 #include "src/gpu/ganesh/SurfaceDrawContext.h"
 #include "src/gpu/ganesh/glsl/GrGLSLFragmentShaderBuilder.h"
@@ -95,7 +102,7 @@ constexpr uint16_t kIndexPattern[6] = {0, 1, 2, 1, 2, 3};
 
 class DrawMeshHelper {
 public:
-    DrawMeshHelper(GrOpFlushState* state) : fState(state) {}
+    DrawMeshHelper(GrOpFlushState* state, const GrOp* op) : fState(state), fOp(op) {}
 
     sk_sp<const GrBuffer> getIndexBuffer();
 
@@ -121,8 +128,16 @@ public:
 
     GrOpsRenderPass* bindPipeline(GrPrimitiveType, bool isInstanced, bool hasVertexBuffer);
 
+    // Records non-instanced triangle meshes with GrOpFlushState::recordDraw() at prepare time, and
+    // then draws everything recorded this way at execute time, as a GrMeshDrawOp would.
+    void recordDraw(const GrSimpleMesh meshes[], int meshCnt);
+    void executeRecordedDraws();
+
 private:
+    const GrPipeline* makePipeline();
+
     GrOpFlushState* fState;
+    const GrOp* fOp;
 };
 
 struct Box {
@@ -148,6 +163,43 @@ static void run_test(GrDirectContext*,
                      std::function<void(DrawMeshHelper*)> prepareFn,
                      std::function<void(DrawMeshHelper*)> executeFn);
 
+// Fills 'boxes' with the checkerboard of boxes, row by row, 'vertexData' with the four corners of
+// each box (in kIndexPattern order), and 'gold' with the expected rendering.
+static void make_boxes(TArray<Box>* boxes,
+                       TArray<std::array<Box, 4>>* vertexData,
+                       SkBitmap* gold) {
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    gold->allocN32Pixels(kImageWidth, kImageHeight);
+
+    SkCanvas goldCanvas(*gold);
+
+    for (int y = 0; y < kBoxCountY; ++y) {
+        for (int x = 0; x < kBoxCountX; ++x) {
+            int c = y + x;
+            int rgb[3] = {-(c & 1) & 0xff, -((c >> 1) & 1) & 0xff, -((c >> 2) & 1) & 0xff};
+
+            const Box box = boxes->push_back() = {
+                    float(x * kBoxSize),
+                    float(y * kBoxSize),
+                    GrColorPackRGBA(rgb[0], rgb[1], rgb[2], 255)
+            };
+
+            std::array<Box, 4>& boxVertices = vertexData->push_back();
+            for (int i = 0; i < 4; ++i) {
+                boxVertices[i] = {
+                        box.fX + (i / 2) * kBoxSize,
+                        box.fY + (i % 2) * kBoxSize,
+                        box.fColor
+                };
+            }
+
+            paint.setARGB(255, rgb[0], rgb[1], rgb[2]);
+            goldCanvas.drawRect(SkRect::MakeXYWH(box.fX, box.fY, kBoxSize, kBoxSize), paint);
+        }
+    }
+}
+
 #ifdef WRITE_PNG_CONTEXT_TYPE
 static bool IsContextTypeForOutputPNGs(skgpu::ContextType type) {
     return type == skgpu::ContextType::WRITE_PNG_CONTEXT_TYPE;
@@ -176,36 +228,7 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrMeshTest, reporter, ctxInfo, CtsEnforce
 
     // ---- setup ----------
 
-    SkPaint paint;
-    paint.setBlendMode(SkBlendMode::kSrc);
-    gold.allocN32Pixels(kImageWidth, kImageHeight);
-
-    SkCanvas goldCanvas(gold);
-
-    for (int y = 0; y < kBoxCountY; ++y) {
-        for (int x = 0; x < kBoxCountX; ++x) {
-            int c = y + x;
-            int rgb[3] = {-(c & 1) & 0xff, -((c >> 1) & 1) & 0xff, -((c >> 2) & 1) & 0xff};
-
-            const Box box = boxes.push_back() = {
-                    float(x * kBoxSize),
-                    float(y * kBoxSize),
-                    GrColorPackRGBA(rgb[0], rgb[1], rgb[2], 255)
-            };
-
-            std::array<Box, 4>& boxVertices = vertexData.push_back();
-            for (int i = 0; i < 4; ++i) {
-                boxVertices[i] = {
-                        box.fX + (i / 2) * kBoxSize,
-                        box.fY + (i % 2) * kBoxSize,
-                        box.fColor
-                };
-            }
-
-            paint.setARGB(255, rgb[0], rgb[1], rgb[2]);
-            goldCanvas.drawRect(SkRect::MakeXYWH(box.fX, box.fY, kBoxSize, kBoxSize), paint);
-        }
-    }
+    make_boxes(&boxes, &vertexData, &gold);
 
     // ---- tests ----------
 
@@ -479,7 +502,7 @@ private:
                       GrXferBarrierFlags renderPassXferBarriers,
                       GrLoadOp colorLoadOp) override {}
     void onPrepare(GrOpFlushState* state) override {
-        fHelper = std::make_unique<DrawMeshHelper>(state);
+        fHelper = std::make_unique<DrawMeshHelper>(state, this);
         fPrepareFn(fHelper.get());
     }
     void onExecute(GrOpFlushState* state, const SkRect& chainBounds) override {
@@ -606,8 +629,7 @@ sk_sp<const GrBuffer> DrawMeshHelper::getIndexBuffer() {
             kIndexPattern, 6, kIndexPatternRepeatCount, 4, gIndexBufferKey);
 }
 
-GrOpsRenderPass* DrawMeshHelper::bindPipeline(GrPrimitiveType primitiveType, bool isInstanced,
-                                              bool hasVertexBuffer) {
+const GrPipeline* DrawMeshHelper::makePipeline() {
     GrProcessorSet processorSet(SkBlendMode::kSrc);
 
     // TODO: add a GrProcessorSet testing helper to make this easier
@@ -620,9 +642,14 @@ GrOpsRenderPass* DrawMeshHelper::bindPipeline(GrPrimitiveType primitiveType, boo
                           GrClampType::kAuto,
                           &overrideColor);
 
-    auto pipeline = GrSimpleMeshDrawOpHelper::CreatePipeline(fState,
-                                                             std::move(processorSet),
-                                                             GrPipeline::InputFlags::kNone);
+    return GrSimpleMeshDrawOpHelper::CreatePipeline(fState,
+                                                    std::move(processorSet),
+                                                    GrPipeline::InputFlags::kNone);
+}
+
+GrOpsRenderPass* DrawMeshHelper::bindPipeline(GrPrimitiveType primitiveType, bool isInstanced,
+                                              bool hasVertexBuffer) {
+    const GrPipeline* pipeline = this->makePipeline();
 
     GrGeometryProcessor* mtp = MeshTestProcessor::Make(fState->allocator(), isInstanced,
                                                        hasVertexBuffer);
@@ -635,6 +662,18 @@ GrOpsRenderPass* DrawMeshHelper::bindPipeline(GrPrimitiveType primitiveType, boo
     return fState->opsRenderPass();
 }
 
+void DrawMeshHelper::recordDraw(const GrSimpleMesh meshes[], int meshCnt) {
+    GrGeometryProcessor* mtp = MeshTestProcessor::Make(fState->allocator(), false, true);
+    fState->recordDraw(mtp, meshes, meshCnt, nullptr, GrPrimitiveType::kTriangles);
+}
+
+void DrawMeshHelper::executeRecordedDraws() {
+    fState->executeDrawsAndUploadsForMeshDrawOp(fOp,
+                                                SkRect::MakeIWH(kImageWidth, kImageHeight),
+                                                this->makePipeline(),
+                                                &GrUserStencilSettings::kUnused);
+}
+
 static void run_test(GrDirectContext* dContext,
                      const char* testName,
                      skiatest::Reporter* reporter,
@@ -680,3 +719,199 @@ static void run_test(GrDirectContext* dContext,
         }
     }
 }
+
+// CPU-backed mesh buffers that are drawn repeatedly get drawn from a GPU copy. Updates to the
+// buffer between draws must still show up, whether they rewrite part or all of it.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrMeshTest_CpuMeshBufferUpdates,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNextRelease) {
+    using Attribute = SkMeshSpecification::Attribute;
+    using Varying = SkMeshSpecification::Varying;
+    static constexpr int kSize = 4;
+
+    auto dContext = ctxInfo.directContext();
+
+    const Attribute attributes[] = {{Attribute::Type::kFloat2, 0, SkString("pos")},
+                                    {Attribute::Type::kUByte4_unorm, 8, SkString("color")}};
+    const Varying varyings[] = {{Varying::Type::kHalf4, SkString("color")}};
+    auto [spec, error] = SkMeshSpecification::Make(attributes,
+                                                   /*vertexStride=*/12,
+                                                   varyings,
+                                                   SkString(R"(
+            Varyings main(const Attributes a) {
+                Varyings v;
+                v.position = a.pos;
+                v.color = a.color;
+                return v;
+            })"),
+                                                   SkString(R"(
+            float2 main(const Varyings v, out half4 color) {
+                color = v.color;
+                return v.position;
+            })"));
+    if (!spec) {
+        ERRORF(reporter, "%s", error.c_str());
+        return;
+    }
+
+    struct Vertex {
+        SkPoint pos;
+        uint8_t rgba[4];
+    };
+    static_assert(sizeof(Vertex) == 12);
+    // Two quads, each covering half of the surface.
+    Vertex vertices[12];
+    auto setQuad = [&](int quad, SkColor color) {
+        float l = quad * kSize / 2, r = l + kSize / 2;
+        const SkPoint pts[6] = {{l, 0}, {r, 0}, {l, kSize}, {l, kSize}, {r, 0}, {r, kSize}};
+        for (int i = 0; i < 6; ++i) {
+            vertices[6*quad + i] = {pts[i],
+                                    {static_cast<uint8_t>(SkColorGetR(color)),
+                                     static_cast<uint8_t>(SkColorGetG(color)),
+                                     static_cast<uint8_t>(SkColorGetB(color)),
+                                     static_cast<uint8_t>(SkColorGetA(color))}};
+        }
+    };
+    setQuad(0, SK_ColorRED);
+    setQuad(1, SK_ColorRED);
+
+    sk_sp<SkMesh::VertexBuffer> vb = SkMeshes::MakeVertexBuffer(vertices, sizeof(vertices));
+    SkMesh::Result result = SkMesh::Make(spec,
+                                         SkMesh::Mode::kTriangles,
+                                         vb,
+                                         std::size(vertices),
+                                         /*vertexOffset=*/0,
+                                         /*uniforms=*/nullptr,
+                                         /*children=*/{},
+                                         SkRect::MakeIWH(kSize, kSize));
+    if (!result.mesh.isValid()) {
+        ERRORF(reporter, "%s", result.error.c_str());
+        return;
+    }
+
+    SkImageInfo info = SkImageInfo::Make(kSize, kSize, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, info);
+    if (!surface) {
+        ERRORF(reporter, "Could not make surface.");
+        return;
+    }
+
+    auto drawAndCheck = [&](const char* step, SkColor left, SkColor right) {
+        surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+        surface->getCanvas()->drawMesh(result.mesh, SkBlender::Mode(SkBlendMode::kDst), SkPaint());
+        SkBitmap bitmap;
+        bitmap.allocPixels(info);
+        if (!surface->readPixels(bitmap, 0, 0)) {
+            ERRORF(reporter, "%s: could not read pixels.", step);
+            return;
+        }
+        REPORTER_ASSERT(reporter, bitmap.getColor(0, 0) == left, "%s", step);
+        REPORTER_ASSERT(reporter, bitmap.getColor(kSize - 1, 0) == right, "%s", step);
+    };
+
+    drawAndCheck("first draw", SK_ColorRED, SK_ColorRED);
+    drawAndCheck("second draw", SK_ColorRED, SK_ColorRED);
+
+    setQuad(1, SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, vb->update(nullptr, vertices + 6, 6*sizeof(Vertex), 6*sizeof(Vertex)));
+    drawAndCheck("partial update", SK_ColorRED, SK_ColorGREEN);
+
+    setQuad(0, SK_ColorBLUE);
+    setQuad(1, SK_ColorBLUE);
+    REPORTER_ASSERT(reporter, vb->update(nullptr, vertices, 0, sizeof(vertices)));
+    drawAndCheck("full update", SK_ColorBLUE, SK_ColorBLUE);
+    drawAndCheck("draw after full update", SK_ColorBLUE, SK_ColorBLUE);
+}
+
+// GrOpFlushState combines consecutive meshes of a recorded draw that share their buffers into
+// multi-draw indirect calls. Draw one mesh per row of boxes, with the middle row coming from a
+// different (but identical) vertex buffer so that it splits the rows around it into two runs, and
+// compare against drawing each mesh as its own recorded draw, which never goes indirect.
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrMeshTest_IndirectRuns,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+
+    auto sdc = skgpu::ganesh::SurfaceDrawContext::Make(dContext,
+                                                       GrColorType::kRGBA_8888,
+                                                       nullptr,
+                                                       SkBackingFit::kExact,
+                                                       {kImageWidth, kImageHeight},
+                                                       SkSurfaceProps(),
+                                                       /*label=*/{});
+    if (!sdc) {
+        ERRORF(reporter, "could not create render target context.");
+        return;
+    }
+
+    TArray<Box> boxes;
+    TArray<std::array<Box, 4>> vertexData;
+    SkBitmap gold;
+    make_boxes(&boxes, &vertexData, &gold);
+
+    TArray<Box> expandedVertexData;
+    TArray<uint16_t> rowIndices;
+    for (int i = 0; i < kBoxCount; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            expandedVertexData.push_back(vertexData[i][kIndexPattern[j]]);
+            if (i < kBoxCountX) {
+                rowIndices.push_back(4 * i + kIndexPattern[j]);
+            }
+        }
+    }
+
+    static constexpr int kSplitRow = kBoxCountY / 2;
+    static_assert(kSplitRow >= 2 && kBoxCountY - kSplitRow - 1 >= 2);
+
+    for (bool indexed : {false, true}) {
+        for (bool combined : {false, true}) {
+            SkString name = SkStringPrintf("%s rows, %s",
+                                           indexed ? "indexed" : "non-indexed",
+                                           combined ? "one draw" : "one draw per row");
+            run_test(dContext, name.c_str(), reporter, sdc, gold,
+                     [&](DrawMeshHelper* helper) {
+                         if (indexed) {
+                             helper->fIndexBuffer = helper->makeIndexBuffer(rowIndices.begin(),
+                                                                            rowIndices.size());
+                             helper->fVertBuffer = helper->makeVertexBuffer(vertexData);
+                             helper->fVertBuffer2 = helper->makeVertexBuffer(vertexData);
+                         } else {
+                             helper->fVertBuffer = helper->makeVertexBuffer(expandedVertexData);
+                             helper->fVertBuffer2 = helper->makeVertexBuffer(expandedVertexData);
+                         }
+                         VALIDATE(helper->fVertBuffer);
+                         VALIDATE(helper->fVertBuffer2);
+
+                         GrSimpleMesh* meshes = helper->target()->allocMeshes(kBoxCountY);
+                         for (int y = 0; y < kBoxCountY; ++y) {
+                             const sk_sp<const GrBuffer>& vertBuffer =
+                                     y == kSplitRow ? helper->fVertBuffer2 : helper->fVertBuffer;
+                             if (indexed) {
+                                 meshes[y].setIndexed(helper->fIndexBuffer,
+                                                      6 * kBoxCountX,
+                                                      /*baseIndex=*/0,
+                                                      /*minIndexValue=*/0,
+                                                      /*maxIndexValue=*/4 * kBoxCountX - 1,
+                                                      GrPrimitiveRestart::kNo,
+                                                      vertBuffer,
+                                                      /*baseVertex=*/4 * kBoxCountX * y);
+                             } else {
+                                 meshes[y].set(vertBuffer,
+                                               6 * kBoxCountX,
+                                               /*baseVertex=*/6 * kBoxCountX * y);
+                             }
+                         }
+                         if (combined) {
+                             helper->recordDraw(meshes, kBoxCountY);
+                         } else {
+                             for (int y = 0; y < kBoxCountY; ++y) {
+                                 helper->recordDraw(meshes + y, 1);
+                             }
+                         }
+                     },
+                     [&](DrawMeshHelper* helper) { helper->executeRecordedDraws(); });
+        }
+    }
+}
@@ -9,6 +9,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
@@ -17,16 +18,25 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "include/private/SkColorData.h"
+#include "include/private/gpu/ganesh/GrTypesPriv.h"
+#include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
 #include "src/gpu/ganesh/GrGpu.h"
+#include "src/gpu/ganesh/SurfaceDrawContext.h"
+#include "src/gpu/ganesh/ops/OpsTask.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 
 #include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
 
 struct GrContextOptions;
 
@@ -103,3 +113,89 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(OpsTaskFlushCount,
     REPORTER_ASSERT(reporter, surface2->readPixels(readbackBitmap, 0, 0));
     REPORTER_ASSERT(reporter, check_read(reporter, readbackBitmap));
 }
+
+using skgpu::ganesh::OpsTask;
+using skgpu::ganesh::SurfaceDrawContext;
+
+// Closes the SDC's current opsTask, the way sampling its target would, and returns the opsTask
+// that takes over. The SDC hands its stencil values from one to the other.
+static OpsTask* split_ops_task(GrRecordingContext* rContext, SurfaceDrawContext* sdc) {
+    sdc->getOpsTask()->makeClosed(rContext);
+    return sdc->getOpsTask();
+}
+
+// Does what GrDrawingManager::resolveStencilLiveness does for a single target. The drawing
+// manager only runs it when discardStencilValuesAfterRenderPass() is on, which no backend
+// reports yet, so drive it directly. 'tasks' are in execution order.
+static void resolve_stencil_liveness(std::initializer_list<OpsTask*> tasks) {
+    bool nextTaskReadsStencil = true;
+    for (auto it = std::rbegin(tasks); it != std::rend(tasks); ++it) {
+        nextTaskReadsStencil = (*it)->resolveStencilLiveness(nextTaskReadsStencil);
+    }
+}
+
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(OpsTaskStencilLiveness,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+
+    static constexpr SkIRect kStencilRect = SkIRect::MakeLTRB(2, 2, 6, 6);
+    static constexpr SkIRect kColorRect = SkIRect::MakeLTRB(8, 8, 12, 12);
+    auto make_sdc = [&] {
+        return SurfaceDrawContext::Make(dContext, GrColorType::kRGBA_8888, nullptr,
+                                        SkBackingFit::kExact, {16, 16}, SkSurfaceProps(),
+                                        /*label=*/{});
+    };
+
+    // Nothing after the split reads the stencil, so neither side keeps it.
+    {
+        auto sdc = make_sdc();
+        if (!sdc) {
+            return;
+        }
+        sdc->clearStencilClip(kStencilRect, false);
+        OpsTask* first = sdc->getOpsTask();
+        OpsTask* second = split_ops_task(dContext, sdc.get());
+        sdc->clear(kColorRect, SK_PMColor4fWHITE);
+        REPORTER_ASSERT(reporter, first->mustPreserveStencil());
+        REPORTER_ASSERT(reporter, second->loadsPreservedStencil());
+
+        resolve_stencil_liveness({first, second});
+        REPORTER_ASSERT(reporter, !first->mustPreserveStencil());
+        REPORTER_ASSERT(reporter, !second->loadsPreservedStencil());
+        dContext->flushAndSubmit();
+    }
+
+    // The task after the split uses the stencil, so it is stored and loaded again.
+    {
+        auto sdc = make_sdc();
+        sdc->clearStencilClip(kStencilRect, false);
+        OpsTask* first = sdc->getOpsTask();
+        OpsTask* second = split_ops_task(dContext, sdc.get());
+        sdc->clearStencilClip(kColorRect, true);
+
+        resolve_stencil_liveness({first, second});
+        REPORTER_ASSERT(reporter, first->mustPreserveStencil());
+        REPORTER_ASSERT(reporter, second->loadsPreservedStencil());
+        dContext->flushAndSubmit();
+    }
+
+    // Only the last task uses the stencil. The one in the middle has to carry it through.
+    {
+        auto sdc = make_sdc();
+        sdc->clearStencilClip(kStencilRect, false);
+        OpsTask* first = sdc->getOpsTask();
+        OpsTask* middle = split_ops_task(dContext, sdc.get());
+        sdc->clear(kColorRect, SK_PMColor4fWHITE);
+        OpsTask* last = split_ops_task(dContext, sdc.get());
+        sdc->clearStencilClip(kColorRect, true);
+
+        resolve_stencil_liveness({first, middle, last});
+        REPORTER_ASSERT(reporter, first->mustPreserveStencil());
+        REPORTER_ASSERT(reporter, middle->loadsPreservedStencil());
+        REPORTER_ASSERT(reporter, middle->mustPreserveStencil());
+        REPORTER_ASSERT(reporter, last->loadsPreservedStencil());
+        dContext->flushAndSubmit();
+    }
+}
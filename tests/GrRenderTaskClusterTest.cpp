@@ -133,12 +133,38 @@ static void create_graph3(TArray<sk_sp<GrMockRenderTask>>* graph,
     // expected is empty. Can't reorder.
 }
 
+/*
+ * Write-after-read case where the cluster can still be extended.
+ * In:   A1 B1 C1 A2
+ * Used: A1(B)
+ * Out:  C1 A1 A2 B1. B1 must stay after A1, but A2 can go ahead of it.
+ */
+static void create_graph4(TArray<sk_sp<GrMockRenderTask>>* graph,
+                          TArray<sk_sp<GrMockRenderTask>>* expected) {
+    TArray<sk_sp<GrSurfaceProxy>> proxies;
+    make_proxies(3, &proxies);
+    make_tasks(4, graph);
+
+    graph->at(0)->addTarget(proxies[0]);
+    graph->at(1)->addTarget(proxies[1]);
+    graph->at(2)->addTarget(proxies[2]);
+    graph->at(3)->addTarget(proxies[0]);
+
+    graph->at(0)->addUsed(proxies[1]);
+
+    expected->push_back(graph->at(2));
+    expected->push_back(graph->at(0));
+    expected->push_back(graph->at(3));
+    expected->push_back(graph->at(1));
+}
+
 DEF_TEST(GrRenderTaskCluster, reporter) {
     CreateGraphPF tests[] = {
         create_graph0,
         create_graph1,
         create_graph2,
-        create_graph3
+        create_graph3,
+        create_graph4
     };
 
     for (size_t i = 0; i < std::size(tests); ++i) {
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/ganesh/GrStreamingReadback.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "src/gpu/ganesh/GrClientMappedBufferManager.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+#include "tools/gpu/ContextType.h"
+#include "tools/gpu/GrContextFactory.h"
+
+#include <chrono>
+#include <iterator>
+#include <memory>
+
+struct GrContextOptions;
+
+using namespace sk_gpu_test;
+
+namespace {
+
+struct Frame {
+    int fCallCount = 0;
+    std::unique_ptr<const SkImage::AsyncReadResult> fResult;
+};
+
+void frame_callback(SkImage::ReadPixelsContext context,
+                    std::unique_ptr<const SkImage::AsyncReadResult> result) {
+    auto* frame = static_cast<Frame*>(context);
+    ++frame->fCallCount;
+    frame->fResult = std::move(result);
+}
+
+bool read_frame(GrStreamingReadback* readback, SkSurface* surface, Frame* frame) {
+    return readback->readFrame(surface,
+                               surface->imageInfo(),
+                               SkIRect::MakeSize(surface->imageInfo().dimensions()),
+                               SkImage::RescaleGamma::kSrc,
+                               SkImage::RescaleMode::kNearest,
+                               frame_callback,
+                               frame);
+}
+
+void wait_for_frame(GrDirectContext* dContext, Frame* frame, skiatest::Reporter* reporter) {
+    auto begin = std::chrono::steady_clock::now();
+    while (!frame->fCallCount &&
+           std::chrono::steady_clock::now() - begin < std::chrono::seconds(1)) {
+        dContext->checkAsyncWorkCompletion();
+    }
+    REPORTER_ASSERT(reporter, frame->fCallCount == 1);
+}
+
+void check_frame(const SkImageInfo& info,
+                 const Frame& frame,
+                 SkColor expected,
+                 skiatest::Reporter* reporter) {
+    REPORTER_ASSERT(reporter, frame.fResult && frame.fResult->count() == 1);
+    if (!frame.fResult) {
+        return;
+    }
+    SkPixmap pixmap(info, frame.fResult->data(0), frame.fResult->rowBytes(0));
+    for (int y = 0; y < info.height(); ++y) {
+        for (int x = 0; x < info.width(); ++x) {
+            if (pixmap.getColor(x, y) != expected) {
+                ERRORF(reporter, "Pixel (%d, %d) is %08x, expected %08x",
+                       x, y, pixmap.getColor(x, y), expected);
+                return;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(GrStreamingReadback_InFlight,
+                                       reporter,
+                                       ctxInfo,
+                                       CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+
+    REPORTER_ASSERT(reporter, !GrStreamingReadback::Make(nullptr, 2));
+    REPORTER_ASSERT(reporter, !GrStreamingReadback::Make(dContext, 0));
+
+    const SkImageInfo info = SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, info);
+    if (!surface) {
+        return;
+    }
+    std::unique_ptr<GrStreamingReadback> readback = GrStreamingReadback::Make(dContext, 2);
+    REPORTER_ASSERT(reporter, readback && readback->maxFramesInFlight() == 2);
+
+    static constexpr SkColor kColors[] = {
+            SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorCYAN, SK_ColorMAGENTA, SK_ColorYELLOW};
+    static constexpr int kFrameCount = std::size(kColors);
+    Frame frames[kFrameCount];
+
+    // Fill both slots. Each read is flushed before the surface is drawn to again, so every frame
+    // must come back with its own color.
+    for (int i = 0; i < 2; ++i) {
+        surface->getCanvas()->clear(kColors[i]);
+        REPORTER_ASSERT(reporter, read_frame(readback.get(), surface.get(), &frames[i]));
+    }
+    REPORTER_ASSERT(reporter, readback->framesInFlight() == 2);
+
+    // A third read has nowhere to go until one of the first two is delivered and released.
+    Frame rejected;
+    REPORTER_ASSERT(reporter, !read_frame(readback.get(), surface.get(), &rejected));
+    REPORTER_ASSERT(reporter, !rejected.fCallCount);
+
+    dContext->submit();
+    for (int i = 2; i < kFrameCount; ++i) {
+        // Deliver and check the oldest frame, then hand its buffer back to the pool.
+        Frame& oldest = frames[i - 2];
+        wait_for_frame(dContext, &oldest, reporter);
+        check_frame(info, oldest, kColors[i - 2], reporter);
+        oldest.fResult.reset();
+
+        surface->getCanvas()->clear(kColors[i]);
+        REPORTER_ASSERT(reporter, read_frame(readback.get(), surface.get(), &frames[i]), "%d", i);
+        dContext->submit();
+    }
+    for (int i = kFrameCount - 2; i < kFrameCount; ++i) {
+        wait_for_frame(dContext, &frames[i], reporter);
+        check_frame(info, frames[i], kColors[i], reporter);
+        frames[i].fResult.reset();
+    }
+
+    dContext->priv().clientMappedBufferManager()->process();
+    REPORTER_ASSERT(reporter, readback->framesInFlight() == 0);
+    for (const Frame& frame : frames) {
+        REPORTER_ASSERT(reporter, frame.fCallCount == 1);
+    }
+}
+
+DEF_GANESH_TEST(GrStreamingReadback_Abandon, reporter, options, CtsEnforcement::kNever) {
+    for (int i = 0; i < skgpu::kContextTypeCount; ++i) {
+        auto type = static_cast<skgpu::ContextType>(i);
+        if (!skgpu::IsRenderingContext(type)) {
+            continue;
+        }
+        // The context gets abandoned, so it can't be shared with other tests.
+        GrContextFactory factory(options);
+        GrDirectContext* dContext = factory.get(type);
+        if (!dContext) {
+            continue;
+        }
+        const SkImageInfo info =
+                SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+        sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, info);
+        if (!surface) {
+            continue;
+        }
+
+        Frame frames[2];
+        Frame late;
+        {
+            std::unique_ptr<GrStreamingReadback> readback = GrStreamingReadback::Make(dContext, 3);
+            for (Frame& frame : frames) {
+                surface->getCanvas()->clear(SK_ColorRED);
+                REPORTER_ASSERT(reporter, read_frame(readback.get(), surface.get(), &frame));
+            }
+            dContext->submit();
+
+            // Abandoning mid-stream must still deliver every frame that was started, whether or
+            // not its pixels made it back.
+            dContext->abandonContext();
+            for (const Frame& frame : frames) {
+                REPORTER_ASSERT(reporter, frame.fCallCount == 1);
+            }
+
+            // A read started after the abandon fails right away.
+            if (read_frame(readback.get(), surface.get(), &late)) {
+                REPORTER_ASSERT(reporter, late.fCallCount == 1 && !late.fResult);
+            } else {
+                REPORTER_ASSERT(reporter, !late.fCallCount);
+            }
+            REPORTER_ASSERT(reporter, !GrStreamingReadback::Make(dContext, 1));
+        }
+        // Results may outlive both the readback and the abandoned context's buffers.
+        for (Frame& frame : frames) {
+            frame.fResult.reset();
+        }
+    }
+}
@@ -29,14 +29,18 @@
 #include "include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkScalerContext.h"
+#include "src/core/SkStrikeCache.h"
+#include "src/gpu/AtlasTypes.h"
 #include "src/text/GlyphRun.h"
 #include "src/text/gpu/SDFTControl.h"
 #include "src/text/gpu/SubRunAllocator.h"
+#include "src/text/gpu/SubRunContainer.h"
 #include "src/text/gpu/TextBlob.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
+#include "tools/text/gpu/TextBlobTools.h"
 
 #include <cmath>
 #include <cstddef>
@@ -384,3 +388,100 @@ DEF_TEST(KeyEqualityOnPerspective, r) {
     REPORTER_ASSERT(r, key1 == key2);
     REPORTER_ASSERT(r, key1 == key3);
 }
+
+DEF_TEST(MaxMaskDimensionDrawsLargeGlyphsAsPaths, r) {
+    SkTextBlobBuilder builder;
+    SkFont font(ToolUtils::DefaultPortableTypeface(), 100);
+    auto runBuffer = builder.allocRun(font, 1, 0.0f, 0.0f);
+    runBuffer.glyphs[0] = font.unicharToGlyph('M');
+    auto blob = builder.make();
+    sktext::GlyphRunBuilder grBuilder;
+    auto glyphRunList = grBuilder.blobToGlyphRunList(*blob, {100, 100});
+    SkPaint paint;
+    SkSurfaceProps props;
+
+    auto firstSubRun = [&](int maxMaskDimension) {
+#if !defined(SK_DISABLE_SDF_TEXT)
+        sktext::gpu::SDFTControl control(false, false, false, 1, 200, maxMaskDimension);
+#else
+        sktext::gpu::SDFTControl control{maxMaskDimension};
+#endif
+        SkStrikeDeviceInfo strikeDevice{props, SkScalerContextFlags::kBoostContrast, &control};
+        sk_sp<TextBlob> textBlob = TextBlob::Make(glyphRunList, paint, SkMatrix::I(),
+                                                  strikeDevice, SkStrikeCache::GlobalStrikeCache());
+        return sktext::gpu::TextBlobTools::FirstSubRun(textBlob.get());
+    };
+
+    // With the default, the glyph fits in the atlas and is drawn as a mask.
+    REPORTER_ASSERT(r, firstSubRun(sktext::gpu::SDFTControl::kDefaultMaxMaskDimension));
+
+    // With a small limit, it is drawn as a path, which has no atlas sub run.
+    REPORTER_ASSERT(r, !firstSubRun(16));
+}
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+DEF_TEST(MultiChannelSDFTReusesOneStrikeAcrossScales, r) {
+    SkTextBlobBuilder builder;
+    SkFont font(ToolUtils::DefaultPortableTypeface(), 40);
+    auto runBuffer = builder.allocRun(font, 1, 0.0f, 0.0f);
+    runBuffer.glyphs[0] = font.unicharToGlyph('M');
+    auto blob = builder.make();
+    sktext::GlyphRunBuilder grBuilder;
+    auto glyphRunList = grBuilder.blobToGlyphRunList(*blob, {100, 100});
+    SkPaint paint;
+    SkSurfaceProps props;
+
+    for (bool multiChannel : {false, true}) {
+        sktext::gpu::SDFTControl control(true, true, true, 18, 324,
+                                         sktext::gpu::SDFTControl::kDefaultMaxMaskDimension,
+                                         multiChannel);
+        SkStrikeDeviceInfo strikeDevice{props, SkScalerContextFlags::kBoostContrast, &control};
+        sk_sp<TextBlob> textBlob = TextBlob::Make(glyphRunList, paint, SkMatrix::I(),
+                                                  strikeDevice, SkStrikeCache::GlobalStrikeCache());
+        const sktext::gpu::AtlasSubRun* subRun =
+                sktext::gpu::TextBlobTools::FirstSubRun(textBlob.get());
+        REPORTER_ASSERT(r, subRun);
+        if (!subRun) {
+            continue;
+        }
+        REPORTER_ASSERT(r, subRun->maskFormat() ==
+                           (multiChannel ? skgpu::MaskFormat::kARGB : skgpu::MaskFormat::kA8));
+
+        // Zooming in 5x, to 200px, needs a new strike unless the field keeps its corners.
+        REPORTER_ASSERT(r, textBlob->canReuse(paint, SkMatrix::Scale(5, 5)) == multiChannel);
+        REPORTER_ASSERT(r, textBlob->canReuse(paint, SkMatrix::I()));
+    }
+}
+#endif
+
+DEF_TEST(OutlinesOnlyDrawsGlyphsAsPaths, r) {
+    SkTextBlobBuilder builder;
+    SkFont font(ToolUtils::DefaultPortableTypeface(), 12);
+    auto runBuffer = builder.allocRun(font, 1, 0.0f, 0.0f);
+    runBuffer.glyphs[0] = font.unicharToGlyph('M');
+    auto blob = builder.make();
+    sktext::GlyphRunBuilder grBuilder;
+    auto glyphRunList = grBuilder.blobToGlyphRunList(*blob, {100, 100});
+    SkPaint paint;
+    SkSurfaceProps props;
+
+#if !defined(SK_DISABLE_SDF_TEXT)
+    const sktext::gpu::SDFTControl control(true, true, true, 1, 200);
+#else
+    const sktext::gpu::SDFTControl control;
+#endif
+    auto firstSubRun = [&](const sktext::gpu::SDFTControl& c) {
+        SkStrikeDeviceInfo strikeDevice{props, SkScalerContextFlags::kBoostContrast, &c};
+        sk_sp<TextBlob> textBlob = TextBlob::Make(glyphRunList, paint, SkMatrix::I(),
+                                                  strikeDevice, SkStrikeCache::GlobalStrikeCache());
+        return sktext::gpu::TextBlobTools::FirstSubRun(textBlob.get());
+    };
+
+    // Small text is normally drawn from the atlas.
+    REPORTER_ASSERT(r, firstSubRun(control));
+
+    // From outlines only, it is drawn as a path, which has no atlas sub run.
+    REPORTER_ASSERT(r, !control.outlinesOnly());
+    REPORTER_ASSERT(r, control.makeOutlinesOnly().outlinesOnly());
+    REPORTER_ASSERT(r, !firstSubRun(control.makeOutlinesOnly()));
+}
@@ -5,15 +5,18 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
 #include "include/private/chromium/SkDiscardableMemory.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
 #include "tests/Test.h"
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 namespace {
 static void* gGlobalAddress;
@@ -154,3 +157,34 @@ DEF_TEST(ImageCache_doubleAdd, r) {
     REPORTER_ASSERT(r, cache.find(key, TestingRec::Visitor, &value));
     REPORTER_ASSERT(r, 2 == value || 3 == value);
 }
+
+DEF_TEST(ImageCache_globalThreaded, r) {
+    // The global cache is striped by key; adds and finds from many threads must still see each
+    // other's Recs.
+    static constexpr int kThreads = 4;
+    static constexpr int kPerThread = 64;
+    // Offset the keys so this test does not collide with anything else using gGlobalAddress.
+    static constexpr intptr_t kBase = 1 << 20;
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(kThreads);
+    SkTaskGroup tasks(*executor);
+    tasks.batch(kThreads, [&](int thread) {
+        for (int i = 0; i < kPerThread; ++i) {
+            intptr_t v = kBase + thread * kPerThread + i;
+            SkResourceCache::Add(new TestingRec(TestingKey(v), v));
+        }
+    });
+    tasks.wait();
+
+    tasks.batch(kThreads * kPerThread, [&](int i) {
+        intptr_t v = kBase + i;
+        intptr_t value = -1;
+        if (SkResourceCache::Find(TestingKey(v), TestingRec::Visitor, &value)) {
+            REPORTER_ASSERT(r, value == v);
+        }
+    });
+    tasks.wait();
+
+    REPORTER_ASSERT(r, SkResourceCache::GetTotalBytesUsed() <=
+                       SkResourceCache::GetTotalByteLimit());
+}
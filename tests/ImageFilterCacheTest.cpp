@@ -15,17 +15,23 @@
 #include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkImageFilters.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrBackendSurface.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/gpu/GrTypes.h"
 #include "include/gpu/ganesh/SkImageGanesh.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkImageFilterCache.h"
@@ -33,6 +39,7 @@
 #include "src/core/SkSpecialImage.h"
 #include "src/gpu/ganesh/GrColorInfo.h" // IWYU pragma: keep
 #include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/GrSurfaceProxy.h"
 #include "src/gpu/ganesh/GrSurfaceProxyView.h"
 #include "src/gpu/ganesh/GrTexture.h"
@@ -40,13 +47,13 @@
 #include "src/gpu/ganesh/image/SkSpecialImage_Ganesh.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
+#include "tools/gpu/ContextType.h"
 
 #include <cstddef>
 #include <tuple>
 #include <utility>
 
 class GrRecordingContext;
-struct GrContextOptions;
 
 static const int kSmallerSize = 10;
 static const int kPad = 3;
@@ -328,3 +335,49 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(ImageFilterCache_GPUBacked,
     test_internal_purge(reporter, fullImg);
     test_explicit_purging(reporter, fullImg, subsetImg);
 }
+
+// With GrContextOptions::fImageFilterCacheBytes, filter results outlive the draw that made them
+// until the context frees its GPU resources.
+DEF_GANESH_TEST(ImageFilterCache_CrossDraw, reporter, originalOptions, CtsEnforcement::kNever) {
+    GrContextOptions options = originalOptions;
+    options.fImageFilterCacheBytes = 4 * 1024 * 1024;
+    sk_gpu_test::GrContextFactory factory(options);
+    for (int ct = 0; ct < skgpu::kContextTypeCount; ++ct) {
+        auto contextType = static_cast<skgpu::ContextType>(ct);
+        if (!skgpu::IsRenderingContext(contextType)) {
+            continue;
+        }
+        GrDirectContext* dContext = factory.get(contextType);
+        if (!dContext) {
+            continue;
+        }
+        sk_sp<SkImageFilterCache> cache =
+                static_cast<GrRecordingContext*>(dContext)->priv().imageFilterCache();
+        REPORTER_ASSERT(reporter, cache);
+        if (!cache) {
+            continue;
+        }
+
+        auto info = SkImageInfo::Make(kFullSize, kFullSize, kRGBA_8888_SkColorType,
+                                      kPremul_SkAlphaType);
+        auto surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, info);
+        if (!surface) {
+            continue;
+        }
+        // The filter doesn't read the layer's content, so it gives the same result every draw.
+        SkPaint paint;
+        paint.setImageFilter(SkImageFilters::Blur(2, 2, SkImageFilters::Image(
+                create_bm().asImage(), SkSamplingOptions())));
+        surface->getCanvas()->drawPaint(paint);
+        dContext->flushAndSubmit(surface.get(), GrSyncCpu::kNo);
+        SkDEBUGCODE(int count = cache->count();)
+        SkDEBUGCODE(REPORTER_ASSERT(reporter, count > 0);)
+
+        surface->getCanvas()->drawPaint(paint);
+        dContext->flushAndSubmit(surface.get(), GrSyncCpu::kNo);
+        SkDEBUGCODE(REPORTER_ASSERT(reporter, cache->count() == count);)
+
+        dContext->freeGpuResources();
+        SkDEBUGCODE(REPORTER_ASSERT(reporter, cache->count() == 0);)
+    }
+}
@@ -80,6 +80,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <utility>
 #include <limits>
@@ -1866,6 +1867,64 @@ DEF_TEST(ImageFilterMakeWithFilter, reporter) {
     test_make_with_filter(reporter, createRasterSurface, raster);
 }
 
+// A blend whose children are other blends evaluates them in one shader when they aren't shared
+// with the rest of the DAG. That must match rendering each child to its own image, up to the
+// rounding of those intermediate images.
+DEF_TEST(ImageFilterFusedBlend, reporter) {
+    const SkPoint pts[] = {{0, 0}, {32, 32}};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorTRANSPARENT, SK_ColorBLUE};
+    sk_sp<SkImage> src = make_gradient_circle(32, 32).asImage();
+    sk_sp<SkImageFilter> gradient = SkImageFilters::Shader(SkGradientShader::MakeLinear(
+            pts, colors, nullptr, std::size(colors), SkTileMode::kClamp));
+    sk_sp<SkImageFilter> color = SkImageFilters::Shader(SkShaders::Color(0x80FFFF00),
+                                                        SkIRect::MakeXYWH(4, 4, 20, 20));
+
+    // Holding on to the intermediate blends in 'keepAlive' shares them, which prevents fusing.
+    auto makeFilter = [&](TArray<sk_sp<SkImageFilter>>* keepAlive) {
+        auto keep = [keepAlive](sk_sp<SkImageFilter> filter) {
+            if (keepAlive) {
+                keepAlive->push_back(filter);
+            }
+            return filter;
+        };
+        auto inner = keep(SkImageFilters::Blend(SkBlendMode::kMultiply, color, nullptr));
+        auto screen = keep(SkImageFilters::Blend(SkBlendMode::kScreen, inner, gradient));
+        auto dstIn = keep(SkImageFilters::Blend(SkBlendMode::kDstIn, gradient, nullptr));
+        return SkImageFilters::Blend(SkBlendMode::kSrcOver, std::move(screen), std::move(dstIn));
+    };
+    TArray<sk_sp<SkImageFilter>> keepAlive;
+    sk_sp<SkImageFilter> fused = makeFilter(nullptr);
+    sk_sp<SkImageFilter> unfused = makeFilter(&keepAlive);
+
+    auto filter = [&](const SkImageFilter* imageFilter, SkBitmap* result) {
+        SkIRect outSubset;
+        SkIPoint offset;
+        sk_sp<SkImage> image = SkImages::MakeWithFilter(src, imageFilter, src->bounds(),
+                                                        src->bounds(), &outSubset, &offset);
+        REPORTER_ASSERT(reporter, image);
+        REPORTER_ASSERT(reporter, result->tryAllocPixels(src->imageInfo().makeWH(
+                outSubset.width(), outSubset.height())));
+        REPORTER_ASSERT(reporter, image->readPixels(nullptr, result->pixmap(),
+                                                    outSubset.fLeft, outSubset.fTop));
+    };
+    SkBitmap fusedResult, unfusedResult;
+    filter(fused.get(), &fusedResult);
+    filter(unfused.get(), &unfusedResult);
+
+    REPORTER_ASSERT(reporter, fusedResult.dimensions() == unfusedResult.dimensions());
+    for (int y = 0; y < fusedResult.height(); ++y) {
+        for (int x = 0; x < fusedResult.width(); ++x) {
+            SkColor a = fusedResult.getColor(x, y);
+            SkColor b = unfusedResult.getColor(x, y);
+            int maxDiff = std::max({std::abs((int)SkColorGetA(a) - (int)SkColorGetA(b)),
+                                    std::abs((int)SkColorGetR(a) - (int)SkColorGetR(b)),
+                                    std::abs((int)SkColorGetG(a) - (int)SkColorGetG(b)),
+                                    std::abs((int)SkColorGetB(a) - (int)SkColorGetB(b))});
+            REPORTER_ASSERT(reporter, maxDiff <= 2, "(%d, %d): 0x%08x vs 0x%08x", x, y, a, b);
+        }
+    }
+}
+
 DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(ImageFilterMakeWithFilter_Ganesh,
                                        reporter,
                                        ctxInfo,
@@ -2327,3 +2386,58 @@ DEF_TEST(DropShadowImageFilter_Huge, reporter) {
     surf->getCanvas()->saveLayer(nullptr, &paint);
     surf->getCanvas()->restore();
 }
+
+// Layers wider than the maximum image filter tile size are filtered one tile at a time. A blur that
+// crosses the seam between tiles must match filtering the whole image at once.
+DEF_TEST(ImageFilterTiledLayer, reporter) {
+    static constexpr int kWidth = 4096 + 64;
+    static constexpr int kHeight = 32;
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(kWidth, kHeight);
+
+    SkBitmap content;
+    content.allocPixels(info);
+    content.eraseColor(SK_ColorWHITE);
+    for (int x = 0; x < kWidth; x += 16) {
+        content.erase(SK_ColorBLUE, SkIRect::MakeXYWH(x, 0, 8, kHeight));
+    }
+    sk_sp<SkImage> image = content.asImage();
+    sk_sp<SkImageFilter> blur = SkImageFilters::Blur(4.f, 4.f, nullptr);
+
+    auto surface = SkSurfaces::Raster(info);
+    SkPaint paint;
+    paint.setImageFilter(blur);
+    surface->getCanvas()->saveLayer(nullptr, &paint);
+    surface->getCanvas()->drawImage(image, 0, 0);
+    surface->getCanvas()->restore();
+
+    SkIRect outSubset;
+    SkIPoint offset;
+    sk_sp<SkImage> expected = SkImages::MakeWithFilter(image, blur.get(), image->bounds(),
+                                                       image->bounds(), &outSubset, &offset);
+    if (!expected) {
+        ERRORF(reporter, "Could not filter the reference image");
+        return;
+    }
+
+    // Compare the pixels around the seam, away from the image's edges.
+    const SkIRect seam = SkIRect::MakeLTRB(4096 - 32, 12, 4096 + 32, kHeight - 12);
+    SkBitmap actualPixels, expectedPixels;
+    actualPixels.allocPixels(info.makeDimensions(seam.size()));
+    expectedPixels.allocPixels(info.makeDimensions(seam.size()));
+    REPORTER_ASSERT(reporter, surface->readPixels(actualPixels, seam.fLeft, seam.fTop));
+    REPORTER_ASSERT(reporter, expected->readPixels(nullptr, expectedPixels.pixmap(),
+                                                   outSubset.fLeft + seam.fLeft - offset.fX,
+                                                   outSubset.fTop + seam.fTop - offset.fY));
+    for (int y = 0; y < seam.height(); ++y) {
+        for (int x = 0; x < seam.width(); ++x) {
+            SkColor a = actualPixels.getColor(x, y);
+            SkColor e = expectedPixels.getColor(x, y);
+            int maxDiff = std::max({std::abs((int)SkColorGetA(a) - (int)SkColorGetA(e)),
+                                    std::abs((int)SkColorGetR(a) - (int)SkColorGetR(e)),
+                                    std::abs((int)SkColorGetG(a) - (int)SkColorGetG(e)),
+                                    std::abs((int)SkColorGetB(a) - (int)SkColorGetB(e))});
+            REPORTER_ASSERT(reporter, maxDiff <= 1, "(%d, %d): 0x%08x vs 0x%08x",
+                            seam.fLeft + x, seam.fTop + y, a, e);
+        }
+    }
+}
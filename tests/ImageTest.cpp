@@ -15,6 +15,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkImageInfo.h"
@@ -436,6 +437,69 @@ DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(SkImage_Ganesh2Cpu,
     }
 }
 
+// Drawing a small part of a lazy image into a raster canvas only decodes that part.
+DEF_TEST(Image_LazySubsetDecode, reporter) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64, /*isOpaque=*/true);
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            *bitmap.getAddr32(x, y) = SkPackARGB32(0xFF, x * 4, y * 4, (x ^ y) * 4);
+        }
+    }
+    SkDynamicMemoryWStream stream;
+    SkASSERT_RELEASE(SkPngEncoder::Encode(&stream, bitmap.pixmap(), {}));
+    sk_sp<SkImage> lazy = SkImages::DeferredFromEncodedData(stream.detachAsData());
+    REPORTER_ASSERT(reporter, lazy && lazy->isLazyGenerated());
+    if (!lazy) {
+        return;
+    }
+    sk_sp<SkImage> raster = bitmap.asImage();
+
+    const SkRect src = SkRect::MakeXYWH(8, 8, 16, 16);
+    const SkRect dst = SkRect::MakeWH(32, 32);
+    auto draw = [&](SkImage* image) {
+        auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(32, 32));
+        surface->getCanvas()->drawImageRect(image, src, dst, SkSamplingOptions(), nullptr,
+                                            SkCanvas::kStrict_SrcRectConstraint);
+        return surface->makeImageSnapshot();
+    };
+    sk_sp<SkImage> expected = draw(raster.get());
+    sk_sp<SkImage> actual = draw(lazy.get());
+    REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(expected.get(), actual.get()));
+
+    // The whole image was never decoded (and so never cached).
+    SkBitmap cached;
+    REPORTER_ASSERT(reporter, !SkBitmapCache::Find(SkBitmapCacheDesc::Make(lazy.get()), &cached));
+}
+
+// Drawing a lazy JPEG much smaller than its size, with mipmaps, into a raster canvas decodes it at
+// a smaller size.
+DEF_TEST(Image_LazyScaledDecode, reporter) {
+    sk_sp<SkData> data = GetResourceAsData("images/brickwork-texture.jpg");
+    if (!data) {
+        return;
+    }
+    sk_sp<SkImage> lazy = SkImages::DeferredFromEncodedData(data);
+    REPORTER_ASSERT(reporter, lazy && lazy->width() == 512);
+    if (!lazy) {
+        return;
+    }
+
+    auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(64, 64));
+    surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+    surface->getCanvas()->drawImageRect(lazy, SkRect::MakeWH(64, 64),
+                                        SkSamplingOptions(SkFilterMode::kLinear,
+                                                          SkMipmapMode::kLinear));
+    SkBitmap result;
+    result.allocN32Pixels(64, 64);
+    REPORTER_ASSERT(reporter, surface->readPixels(result, 0, 0));
+    REPORTER_ASSERT(reporter, SkColorGetA(result.getColor(32, 32)) == 0xFF);
+
+    // The full size image was never decoded (and so never cached).
+    SkBitmap cached;
+    REPORTER_ASSERT(reporter, !SkBitmapCache::Find(SkBitmapCacheDesc::Make(lazy.get()), &cached));
+}
+
 DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(SkImage_makeTextureImage,
                                        reporter,
                                        contextInfo,
@@ -1094,55 +1158,40 @@ static void test_cross_context_image(
             otherCtx->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
         }
 
-        // Case #6: Verify that only one context can be using the image at a time
+        // Case #6: Verify that several contexts can be using the image at the same time
         {
-            // Suppress warnings about trying to use a texture in two contexts.
-            GrRecordingContextPriv::AutoSuppressWarningMessages aswm(otherCtx);
-
             testContext->makeCurrent();
             sk_sp <SkImage> refImg(imageMaker(dContext));
             GrSurfaceProxyView view, otherView, viewSecondRef;
 
-            // Any context should be able to borrow the texture at this point
-
             std::tie(view, std::ignore) =
                     skgpu::ganesh::AsView(dContext, refImg, skgpu::Mipmapped::kNo);
             REPORTER_ASSERT(reporter, view);
 
-            // But once it's borrowed, no other context should be able to borrow
+            // Another context can borrow the texture while the first one still is
             otherTestContext->makeCurrent();
             std::tie(otherView, std::ignore) =
                     skgpu::ganesh::AsView(otherCtx, refImg, skgpu::Mipmapped::kNo);
-            REPORTER_ASSERT(reporter, !otherView);
+            REPORTER_ASSERT(reporter, otherView);
+            canvas->drawImage(refImg, 0, 0);
+            otherCtx->flushAndSubmit(surface.get(), GrSyncCpu::kNo);
 
-            // Original context (that's already borrowing) should be okay
+            // Original context (that's already borrowing) should still be okay
             testContext->makeCurrent();
             std::tie(viewSecondRef, std::ignore) =
                     skgpu::ganesh::AsView(dContext, refImg, skgpu::Mipmapped::kNo);
             REPORTER_ASSERT(reporter, viewSecondRef);
 
-            // Release first ref from the original context
+            // Release the original context's refs, then the other context's
             view.reset();
-
-            // We released one proxy but not the other from the current borrowing context. Make sure
-            // a new context is still not able to borrow the texture.
-            otherTestContext->makeCurrent();
-            std::tie(otherView, std::ignore) =
-                    skgpu::ganesh::AsView(otherCtx, refImg, skgpu::Mipmapped::kNo);
-            REPORTER_ASSERT(reporter, !otherView);
-
-            // Release second ref from the original context
-            testContext->makeCurrent();
             viewSecondRef.reset();
 
-            // Now we should be able to borrow the texture from the other context
             otherTestContext->makeCurrent();
-            std::tie(otherView, std::ignore) =
-                    skgpu::ganesh::AsView(otherCtx, refImg, skgpu::Mipmapped::kNo);
-            REPORTER_ASSERT(reporter, otherView);
+            otherView.reset();
+            otherCtx->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
 
             // Release everything
-            otherView.reset();
+            testContext->makeCurrent();
             refImg.reset(nullptr);
         }
     }
@@ -1502,6 +1551,46 @@ DEF_TEST(ImageScalePixels, reporter) {
     test_scale_pixels(reporter, codecImage.get(), pmRed);
 }
 
+DEF_TEST(ImageReadAndScalePixels_Executor, reporter) {
+    sk_sp<SkImage> image = ToolUtils::GetResourceAsImage("images/mandrill_512.png");
+    if (!image) {
+        return;
+    }
+    image = image->makeRasterImage(nullptr);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // Converting in bands must give exactly the same pixels as converting in one go.
+    SkImageInfo info = image->imageInfo().makeColorType(kRGBA_F16_SkColorType)
+                                         .makeColorSpace(SkColorSpace::MakeSRGBLinear());
+    SkAutoPixmapStorage expected, actual;
+    expected.alloc(info);
+    actual.alloc(info);
+    REPORTER_ASSERT(reporter, image->readPixels(nullptr, expected, 0, 0));
+    REPORTER_ASSERT(reporter, image->readPixels(nullptr, actual, 0, 0, executor.get()));
+    REPORTER_ASSERT(reporter, !memcmp(expected.addr(), actual.addr(), expected.computeByteSize()));
+
+    // Each band of a scale maps its rows back onto the source through its own matrix, which can
+    // round differently, so allow a little slop.
+    SkSamplingOptions sampling(SkFilterMode::kLinear);
+    for (SkISize size : {SkISize{700, 613}, SkISize{333, 257}}) {
+        SkImageInfo scaledInfo = image->imageInfo().makeDimensions(size);
+        expected.alloc(scaledInfo);
+        actual.alloc(scaledInfo);
+        REPORTER_ASSERT(reporter, image->scalePixels(expected, sampling));
+        REPORTER_ASSERT(reporter, image->scalePixels(actual, sampling, executor.get()));
+
+        int maxDiff = 0;
+        for (int y = 0; y < size.height(); ++y) {
+            const uint8_t* e = static_cast<const uint8_t*>(expected.addr(0, y));
+            const uint8_t* a = static_cast<const uint8_t*>(actual.addr(0, y));
+            for (size_t i = 0; i < scaledInfo.minRowBytes(); ++i) {
+                maxDiff = std::max(maxDiff, std::abs(e[i] - a[i]));
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= 1, "max difference %d", maxDiff);
+    }
+}
+
 DEF_GANESH_TEST_FOR_RENDERING_CONTEXTS(ImageScalePixels_Gpu,
                                        reporter,
                                        ctxInfo,
@@ -15,6 +15,7 @@
 #include "tests/Test.h"
 
 #include <cstring>
+#include <string>
 #include <string_view>
 
 using namespace skjson;
@@ -473,3 +474,79 @@ DEF_TEST(JSON_ParseNumber, reporter) {
         REPORTER_ASSERT(reporter, SkScalarNearlyEqual(**jnumber, test.value, test.tolerance));
     }
 }
+
+DEF_TEST(JSON_DOM_binary, reporter) {
+    static constexpr char json[] =
+        "{"
+            "\"null\":null,\"bools\":[true,false],"
+            "\"numbers\":[0,-1,2147483647,-2147483648,42.75,1e+30,-0.5],"
+            "\"short\":\"foo\",\"long\":\"the quick brown fox\",\"\":\"\","
+            "\"nested\":[[],{},[{\"a\":[1,[2,[3]]]}]]"
+        "}";
+    const DOM dom(json, strlen(json));
+    REPORTER_ASSERT(reporter, dom.root().is<ObjectValue>());
+
+    SkDynamicMemoryWStream stream;
+    dom.writeBinary(&stream);
+    const auto binary = stream.detachAsData();
+    REPORTER_ASSERT(reporter, DOM::IsBinary(binary->data(), binary->size()));
+    REPORTER_ASSERT(reporter, !DOM::IsBinary(json, strlen(json)));
+
+    const auto loaded = DOM::MakeFromBinary(binary->data(), binary->size());
+    REPORTER_ASSERT(reporter, loaded);
+    if (loaded) {
+        REPORTER_ASSERT(reporter, loaded->root().toString().equals(dom.root().toString()));
+        const auto& numbers = loaded->root().as<ObjectValue>()["numbers"].as<ArrayValue>();
+        REPORTER_ASSERT(reporter, *numbers[3].as<NumberValue>() == -2147483648.0);
+        REPORTER_ASSERT(reporter, *numbers[4].as<NumberValue>() == 42.75);
+    }
+
+    // Truncated or corrupt data is rejected.
+    for (size_t size = 0; size < binary->size(); ++size) {
+        REPORTER_ASSERT(reporter, !DOM::MakeFromBinary(binary->data(), size));
+    }
+    auto corrupt = SkData::MakeWithCopy(binary->data(), binary->size());
+    static_cast<uint8_t*>(corrupt->writable_data())[8] = 0xff;
+    REPORTER_ASSERT(reporter, !DOM::MakeFromBinary(corrupt->data(), corrupt->size()));
+}
+
+DEF_TEST(JSON_LongStrings, reporter) {
+    // Long strings are scanned in blocks, so place the interesting chars at every offset.
+    for (size_t len = 0; len < 80; ++len) {
+        for (size_t pos = 0; pos < len; ++pos) {
+            std::string str(len, 'x');
+            str[pos] = 'y';
+            const std::string json = "[\"" + str + "\"]",
+                              escaped = "[\"" + str.substr(0, pos) + "\\n" +
+                                        str.substr(pos + 1) + "\"]",
+                              brackets = "[\"" + str.substr(0, pos) + "]}" +
+                                         str.substr(pos + 1) + "\"]",
+                              invalid = "[\"" + str.substr(0, pos) + "\t" +
+                                        str.substr(pos + 1) + "\"]";
+
+            const DOM dom(json.data(), json.size());
+            REPORTER_ASSERT(reporter, dom.root().as<ArrayValue>()[0].as<StringValue>().str() ==
+                                      str);
+
+            const DOM escaped_dom(escaped.data(), escaped.size());
+            const auto expected = str.substr(0, pos) + "\n" + str.substr(pos + 1);
+            REPORTER_ASSERT(reporter,
+                            escaped_dom.root().as<ArrayValue>()[0].as<StringValue>().str() ==
+                            expected);
+
+            const DOM brackets_dom(brackets.data(), brackets.size());
+            REPORTER_ASSERT(reporter,
+                            brackets_dom.root().as<ArrayValue>()[0].as<StringValue>().size() ==
+                            len + 1);
+
+            // Unescaped control chars are not allowed in strings.
+            const DOM invalid_dom(invalid.data(), invalid.size());
+            REPORTER_ASSERT(reporter, invalid_dom.root().is<NullValue>());
+        }
+    }
+
+    // A string which runs into the end of the input.
+    const std::string unterminated = "[\"" + std::string(64, 'x') + "]";
+    const DOM dom(unterminated.data(), unterminated.size());
+    REPORTER_ASSERT(reporter, dom.root().is<NullValue>());
+}
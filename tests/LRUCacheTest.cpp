@@ -70,3 +70,21 @@ DEF_TEST(LRUCacheRandom, r) {
     }
     REPORTER_ASSERT(r, 0 == instances);
 }
+
+DEF_TEST(LRUCacheRemoveLRU, r) {
+    int instances = 0;
+    {
+        SkLRUCache<int, std::unique_ptr<Value>> test(10);
+        test.removeLRU();
+        for (int i = 0; i < 3; i++) {
+            test.insert(i, std::make_unique<Value>(i, &instances));
+        }
+        // Using 0 makes 1 the least recently used.
+        REPORTER_ASSERT(r, test.find(0));
+        test.removeLRU();
+        REPORTER_ASSERT(r, 2 == instances);
+        REPORTER_ASSERT(r, !test.find(1));
+        REPORTER_ASSERT(r, test.find(0) && test.find(2));
+    }
+    REPORTER_ASSERT(r, 0 == instances);
+}
@@ -5,7 +5,16 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlurTypes.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkMaskFilter.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPathTypes.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
@@ -108,3 +117,89 @@ DEF_TEST(RectsMaskCache, reporter) {
     check_data(reporter, data, 1, kNotInCache, kLocked);
     data->unref();
 }
+
+DEF_TEST(PathMaskCache, reporter) {
+    SkResourceCache cache(1024);
+
+    SkScalar sigma = 0.8f;
+    SkPath path = SkPath::Circle(50, 50, 40);
+    SkBlurStyle style = kNormal_SkBlurStyle;
+    SkMatrix matrix = SkMatrix::Translate(10.25f, 20.5f);
+    SkTLazy<SkMask> lazyMask;
+
+    SkCachedData* data = SkMaskCache::FindAndRef(sigma, style, path, matrix, &lazyMask, &cache);
+    REPORTER_ASSERT(reporter, nullptr == data);
+    REPORTER_ASSERT(reporter, !lazyMask.isValid());
+
+    size_t size = 256;
+    data = cache.newCachedData(size);
+    memset(data->writable_data(), 0xff, size);
+    SkMask mask(nullptr, SkIRect::MakeXYWH(10, 20, 100, 100), 100, SkMask::kBW_Format);
+    SkMaskCache::Add(sigma, style, path, matrix, mask, data, &cache);
+    check_data(reporter, data, 2, kInCache, kLocked);
+
+    data->unref();
+    check_data(reporter, data, 1, kInCache, kUnlocked);
+
+    // Moving the path by whole pixels finds the same mask, moved with it.
+    lazyMask.reset();
+    data = SkMaskCache::FindAndRef(sigma, style, path, SkMatrix::Translate(13.25f, 25.5f),
+                                   &lazyMask, &cache);
+    REPORTER_ASSERT(reporter, data);
+    REPORTER_ASSERT(reporter, data->size() == size);
+    REPORTER_ASSERT(reporter, lazyMask->fBounds == SkIRect::MakeXYWH(13, 25, 100, 100));
+    REPORTER_ASSERT(reporter, data->data() == static_cast<const void*>(lazyMask->fImage));
+    check_data(reporter, data, 2, kInCache, kLocked);
+    data->unref();
+
+    // Other subpixel offsets, scales, and edited paths need masks of their own.
+    lazyMask.reset();
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(sigma, style, path,
+                                                       SkMatrix::Translate(10.5f, 20.5f),
+                                                       &lazyMask, &cache));
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(sigma, style, path,
+                                                       SkMatrix::Scale(2, 2).postTranslate(10, 20),
+                                                       &lazyMask, &cache));
+    path.lineTo(0, 0);
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(sigma, style, path, matrix,
+                                                       &lazyMask, &cache));
+    REPORTER_ASSERT(reporter, !lazyMask.isValid());
+}
+
+// Blurred inverse fills cover the clip, so a mask made under one clip must not be reused under
+// another. Each draw has to match drawing a volatile copy of the path, which is never cached.
+DEF_TEST(PathMaskCacheInverseFill, reporter) {
+    SkPath path = SkPath::Circle(32, 32, 16);
+    path.setFillType(SkPathFillType::kInverseWinding);
+    SkPath volatilePath = path;
+    volatilePath.setIsVolatile(true);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 3));
+
+    auto draw = [&](const SkPath& p, const SkRect& clip, float dx) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::MakeA8(96, 64));
+        bitmap.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bitmap);
+        canvas.clipRect(clip);
+        canvas.translate(dx, 0);
+        canvas.drawPath(p, paint);
+        return bitmap;
+    };
+
+    // Outset by the blur's margin, the first clip is exactly the path's bounds, which is all the
+    // mask of a filled path would cover.
+    const SkRect clips[] = {SkRect::MakeLTRB(23, 23, 41, 41),
+                            SkRect::MakeWH(64, 64),
+                            SkRect::MakeLTRB(8, 0, 96, 48)};
+    for (const SkRect& clip : clips) {
+        for (float dx : {0.f, 16.f}) {
+            SkBitmap actual = draw(path, clip, dx);
+            SkBitmap expected = draw(volatilePath, clip, dx);
+            REPORTER_ASSERT(reporter, !memcmp(actual.getPixels(), expected.getPixels(),
+                                              actual.computeByteSize()));
+        }
+    }
+}
@@ -22,6 +22,7 @@
 #include "src/core/SkPointPriv.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cstring>
 #include <initializer_list>
 #include <string>
@@ -1150,3 +1151,69 @@ DEF_TEST(Matrix_rectStaysRect_zeroScale, r) {
     }
 
     }
+
+DEF_TEST(Matrix_mapPoints_persp, r) {
+    SkMatrix m = SkMatrix::Translate(2, 3);
+    m.postRotate(15);
+    m.setPerspX(0.5f);
+    m.setPerspY(0.002f);
+
+    // Enough points to take both the vectorized and the remainder loop. (-2, 0) maps to w == 0,
+    // which maps to (0, 0).
+    SkRandom rand;
+    SkPoint src[11];
+    for (SkPoint& p : src) {
+        p.set(rand.nextSScalar1(), rand.nextSScalar1());
+    }
+    src[5].set(-2, 0);
+
+    SkPoint dst[11];
+    m.mapPoints(dst, src, std::size(src));
+    for (size_t i = 0; i < std::size(src); ++i) {
+        SkPoint expected = m.mapPoint(src[i]);
+        REPORTER_ASSERT(r, SkScalarNearlyEqual(dst[i].fX, expected.fX) &&
+                           SkScalarNearlyEqual(dst[i].fY, expected.fY),
+                        "%zu: (%g, %g) != (%g, %g)",
+                        i, dst[i].fX, dst[i].fY, expected.fX, expected.fY);
+    }
+    REPORTER_ASSERT(r, dst[5] == SkPoint::Make(0, 0));
+
+    // Mapping in place gives the same points.
+    m.mapPoints(src, std::size(src));
+    for (size_t i = 0; i < std::size(src); ++i) {
+        REPORTER_ASSERT(r, src[i] == dst[i]);
+    }
+}
+
+DEF_TEST(Matrix_mapPoints_affine, r) {
+    SkMatrix m = SkMatrix::MakeAll(1.5f, 0.25f, 3, -0.5f, 2, -7, 0, 0, 1);
+    REPORTER_ASSERT(r, m.getType() & SkMatrix::kAffine_Mask);
+
+    // Affine_vpts maps 1, then 2 and then 4 points at a time; cover every remainder.
+    constexpr int kMaxCount = 21;
+    SkRandom rand;
+    SkPoint src[kMaxCount];
+    for (SkPoint& p : src) {
+        p.set(rand.nextRangeF(-100, 100), rand.nextRangeF(-100, 100));
+    }
+
+    for (int n = 0; n <= kMaxCount; ++n) {
+        SkPoint dst[kMaxCount];
+        m.mapPoints(dst, src, n);
+        for (int i = 0; i < n; ++i) {
+            const SkPoint expected = {
+                    src[i].fX * m.getScaleX() + src[i].fY * m.getSkewX()  + m.getTranslateX(),
+                    src[i].fX * m.getSkewY()  + src[i].fY * m.getScaleY() + m.getTranslateY()};
+            REPORTER_ASSERT(r, SkScalarNearlyEqual(dst[i].fX, expected.fX, 1e-3f) &&
+                               SkScalarNearlyEqual(dst[i].fY, expected.fY, 1e-3f),
+                            "count %d, %d: (%g, %g) != (%g, %g)",
+                            n, i, dst[i].fX, dst[i].fY, expected.fX, expected.fY);
+        }
+
+        // Mapping in place gives the same points.
+        SkPoint inPlace[kMaxCount];
+        std::copy(src, src + n, inPlace);
+        m.mapPoints(inPlace, n);
+        REPORTER_ASSERT(r, std::equal(inPlace, inPlace + n, dst), "count %d", n);
+    }
+}
@@ -10,6 +10,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
@@ -27,6 +28,9 @@
 #include "tests/Test.h"
 #include "tools/DecodeUtils.h"
 
+#include <cstring>
+#include <memory>
+
 static void make_bitmap(SkBitmap* bm, int width, int height) {
     bm->allocN32Pixels(width, height);
     bm->eraseColor(SK_ColorWHITE);
@@ -235,6 +239,80 @@ DEF_TEST(MipMap_F16, reporter) {
     sk_sp<SkMipmap> mipmap(SkMipmap::Build(bmp, nullptr));
 }
 
+// Expected value of an 8-bit channel in an even-sized level: the truncated 2x2 box average.
+static uint8_t box_channel(const SkPixmap& src, int x, int y, int byte) {
+    auto channel = [&](int sx, int sy) {
+        return static_cast<const uint8_t*>(src.addr(sx, sy))[byte];
+    };
+    return (channel(2*x, 2*y) + channel(2*x + 1, 2*y) +
+            channel(2*x, 2*y + 1) + channel(2*x + 1, 2*y + 1)) >> 2;
+}
+
+static bool same_levels(const SkMipmap& a, const SkMipmap& b) {
+    if (a.countLevels() != b.countLevels()) {
+        return false;
+    }
+    for (int i = 0; i < a.countLevels(); ++i) {
+        SkMipmap::Level la, lb;
+        SkAssertResult(a.getLevel(i, &la) && b.getLevel(i, &lb));
+        for (int y = 0; y < la.fPixmap.height(); ++y) {
+            if (memcmp(la.fPixmap.addr(0, y), lb.fPixmap.addr(0, y),
+                       la.fPixmap.info().minRowBytes()) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The vectorized 2x2 filters must match the portable box filter, and building the large levels
+// in bands must not change the result.
+DEF_TEST(MipMap_BoxFilterAndBands, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    SkRandom rand;
+    SkBitmap bm8888;
+    // Big enough that the first level is split into bands, and odd-sized further down.
+    bm8888.allocPixels(SkImageInfo::Make(1030, 514, kRGBA_8888_SkColorType, kPremul_SkAlphaType));
+    for (int y = 0; y < bm8888.height(); ++y) {
+        for (int x = 0; x < bm8888.width(); ++x) {
+            *bm8888.getAddr32(x, y) = rand.nextU();
+        }
+    }
+
+    for (SkColorType ct : {kRGBA_8888_SkColorType, kAlpha_8_SkColorType, kRGBA_F16_SkColorType}) {
+        SkBitmap bm;
+        bm.allocPixels(bm8888.info().makeColorType(ct));
+        SkAssertResult(bm8888.readPixels(bm.pixmap()));
+
+        sk_sp<SkMipmap> serial(SkMipmap::Build(bm.pixmap(), nullptr));
+        sk_sp<SkMipmap> banded(SkMipmap::Build(bm.pixmap(), nullptr, true, executor.get()));
+        REPORTER_ASSERT(reporter, serial && banded);
+        if (!serial || !banded) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, same_levels(*serial, *banded), "color type %d", ct);
+
+        if (ct == kRGBA_F16_SkColorType) {
+            continue;
+        }
+        SkMipmap::Level level;
+        SkAssertResult(serial->getLevel(0, &level));
+        const int bytes = SkColorTypeBytesPerPixel(ct);
+        for (int y = 0; y < level.fPixmap.height(); ++y) {
+            for (int x = 0; x < level.fPixmap.width(); ++x) {
+                for (int byte = 0; byte < bytes; ++byte) {
+                    uint8_t actual = static_cast<const uint8_t*>(level.fPixmap.addr(x, y))[byte];
+                    if (actual != box_channel(bm.pixmap(), x, y, byte)) {
+                        ERRORF(reporter, "color type %d: mismatch at (%d, %d)", ct, x, y);
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
 static void fill_in_mips(SkMipmapBuilder* builder, sk_sp<SkImage> img) {
     int count = builder->countLevels();
     for (int i = 0; i < count; ++i) {
@@ -30,10 +30,14 @@
 #include "include/core/SkTypeface.h"
 #include "include/docs/SkMultiPictureDocument.h"
 #include "tests/Test.h"
+#include "tools/MSKPCapture.h"
+#include "tools/MSKPPlayer.h"
 #include "tools/SkSharingProc.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -181,6 +185,68 @@ DEF_TEST(SkMultiPictureDocument_Serialize_and_deserialize, reporter) {
     }
 }
 
+// Confirm that frames captured with MSKPCapture replay correctly through MSKPPlayer, including
+// draws after a context call that splits the frame while a save is outstanding, and that the
+// context calls come back as markers in the order they were made.
+DEF_TEST(SkMultiPictureDocument_Capture, reporter) {
+    static const int WIDTH = 64;
+    static const int HEIGHT = 64;
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(WIDTH, HEIGHT);
+
+    SkDynamicMemoryWStream stream;
+    auto surface = SkSurfaces::Raster(info);
+    std::vector<sk_sp<SkImage>> expectedImages;
+    {
+        std::unique_ptr<MSKPCapture> capture = MSKPCapture::Make(&stream, nullptr);
+        for (int i = 0; i < 2; ++i) {
+            SkCanvas* canvas = capture->beginFrame(surface.get());
+            canvas->clear(SK_ColorWHITE);
+            canvas->save();
+            canvas->translate(10, 10);
+            canvas->clipRect(SkRect::MakeWH(30, 30));
+            canvas->drawColor(SK_ColorRED);
+            capture->flush();
+            SkPaint paint;
+            paint.setColor(SK_ColorBLUE);
+            canvas->drawRect(SkRect::MakeWH(20 + 20 * i, 20), paint);
+            canvas->restore();
+            canvas->drawRect(SkRect::MakeXYWH(40, 40, 10, 10), paint);
+            capture->mark("Drawn");
+            capture->endFrame();
+            capture->submit();
+            expectedImages.push_back(surface->makeImageSnapshot());
+        }
+        capture->finish();
+    }
+
+    std::unique_ptr<SkStreamAsset> writtenStream = stream.detachAsStream();
+    std::unique_ptr<MSKPPlayer> player = MSKPPlayer::Make(writtenStream.get());
+    REPORTER_ASSERT(reporter, player);
+    if (!player) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, player->numFrames() == 2);
+
+    static constexpr const char* kExpectedLabels[] = {
+            "FrameBegin", "Flush", "Drawn", "FrameEnd", "Submit"};
+    for (int i = 0; i < player->numFrames(); ++i) {
+        const std::vector<MSKPPlayer::Marker>& markers = player->markers(i);
+        REPORTER_ASSERT(reporter, markers.size() == std::size(kExpectedLabels),
+                        "Frame %d has %zu markers", i, markers.size());
+        for (size_t m = 0; m < std::min(markers.size(), std::size(kExpectedLabels)); ++m) {
+            REPORTER_ASSERT(reporter, markers[m].fLabel.equals(kExpectedLabels[m]),
+                            "Frame %d marker %zu is %s", i, m, markers[m].fLabel.c_str());
+            REPORTER_ASSERT(reporter, m == 0 || markers[m].fTimeMs >= markers[m - 1].fTimeMs);
+        }
+
+        auto surf = SkSurfaces::Raster(info);
+        REPORTER_ASSERT(reporter, player->playFrame(surf->getCanvas(), i));
+        auto img = surf->makeImageSnapshot();
+        REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(img.get(), expectedImages[i].get()),
+                        "Frame %d is wrong", i);
+    }
+}
+
 
 #if defined(SK_GANESH) && defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26
 
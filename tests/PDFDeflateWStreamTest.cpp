@@ -8,6 +8,8 @@
 #include "include/core/SkTypes.h"
 
 #ifdef SK_SUPPORT_PDF
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkDebug.h"
@@ -41,7 +43,8 @@ void skia_free_func(void*, void* address) { sk_free(address); }
  *  Use the un-deflate compression algorithm to decompress the data in src,
  *  returning the result.  Returns nullptr if an error occurs.
  */
-std::unique_ptr<SkStreamAsset> stream_inflate(skiatest::Reporter* reporter, SkStream* src) {
+std::unique_ptr<SkStreamAsset> stream_inflate(skiatest::Reporter* reporter, SkStream* src,
+                                              bool gzip = false) {
     SkDynamicMemoryWStream decompressedDynamicMemoryWStream;
     SkWStream* dst = &decompressedDynamicMemoryWStream;
 
@@ -57,7 +60,7 @@ std::unique_ptr<SkStreamAsset> stream_inflate(skiatest::Reporter* reporter, SkSt
     flateData.next_out = outputBuffer;
     flateData.avail_out = kBufferSize;
     int rc;
-    rc = inflateInit(&flateData);
+    rc = inflateInit2(&flateData, gzip ? 16 + MAX_WBITS : MAX_WBITS);
     if (rc != Z_OK) {
         ERRORF(reporter, "Zlib: inflateInit failed");
         return nullptr;
@@ -177,4 +180,47 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+static sk_sp<SkData> deflate_in_blocks(const uint8_t* data, size_t size, bool gzip,
+                                       SkExecutor* executor, SkRandom* random) {
+    SkDynamicMemoryWStream dst;
+    SkDeflateWStream deflateWStream(&dst, -1, gzip, executor);
+    size_t j = 0;
+    while (j < size) {
+        size_t writeSize = std::min<size_t>(size - j, random->nextRangeU(1, 100000));
+        deflateWStream.write(data + j, writeSize);
+        j += writeSize;
+    }
+    SkASSERT(deflateWStream.bytesWritten() == size);
+    deflateWStream.finalize();
+    return dst.detachAsData();
+}
+
+DEF_TEST(SkPDF_DeflateWStream_Blocks, r) {
+    constexpr size_t kBlock = SkDeflateWStream::kBlockSize;
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom random(654321);
+    for (size_t size : {size_t(0), size_t(1), kBlock - 1, kBlock, kBlock + 1,
+                        5 * kBlock + 123, 40 * kBlock}) {
+        // Repetitive enough to have matches that reach back across block boundaries.
+        AutoTMalloc<uint8_t> buffer(size);
+        for (size_t j = 0; j < size; ++j) {
+            buffer[j] = (j % 12289) < 64 ? random.nextU() & 0xff : (j % 251);
+        }
+        for (bool gzip : {false, true}) {
+            sk_sp<SkData> serial   = deflate_in_blocks(buffer, size, gzip, nullptr, &random),
+                          threaded = deflate_in_blocks(buffer, size, gzip, executor.get(),
+                                                       &random);
+            REPORTER_ASSERT(r, serial->equals(threaded.get()));
+
+            SkMemoryStream compressed(serial);
+            std::unique_ptr<SkStreamAsset> decompressed = stream_inflate(r, &compressed, gzip);
+            REPORTER_ASSERT(r, decompressed && decompressed->getLength() == size);
+            if (decompressed && size > 0) {
+                sk_sp<SkData> data = SkData::MakeFromStream(decompressed.get(), size);
+                REPORTER_ASSERT(r, data && 0 == memcmp(data->data(), buffer, size));
+            }
+        }
+    }
+}
+
 #endif
@@ -13,9 +13,11 @@
 #include "include/core/SkFont.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
 #include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
+#include "include/core/SkTypeface.h"
 #include "include/docs/SkPDFDocument.h"
 #include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
@@ -267,3 +269,96 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+static sk_sp<SkData> make_multipage_pdf(SkExecutor* executor) {
+    SkPDF::Metadata metadata;
+    metadata.fExecutor = executor;
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+
+    sk_sp<SkTypeface> roboto = ToolUtils::CreateTypefaceFromResource("fonts/Roboto-Regular.ttf");
+    SkFont fonts[] = {ToolUtils::DefaultPortableFont(), SkFont(roboto, 12)};
+    SkPaint paint;
+    for (int i = 0; i < 20; ++i) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        for (int line = 0; line < 40; ++line) {
+            paint.setColor(SkColorSetARGB(0xFF, (uint8_t)(i * 12), (uint8_t)(line * 6), 0x80));
+            SkString text = SkStringPrintf("Page %d, line %d: the quick brown fox", i, line);
+            canvas->drawString(text, 36, 36.0f + 18 * line, fonts[(i + line) % 2], paint);
+            canvas->drawRect(SkRect::MakeXYWH(400, 24.0f + 18 * line, 10.0f + i, 12), paint);
+        }
+        doc->endPage();
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+// Serializing on an executor must not change a single byte of the document.
+DEF_TEST(SkPDF_executor_output_matches_serial, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_executor_output_matches_serial, r);
+    sk_sp<SkData> expected = make_multipage_pdf(nullptr);
+    REPORTER_ASSERT(r, expected && expected->size() > 0);
+
+    std::unique_ptr<SkExecutor> executors[] = {
+        SkExecutor::MakeFIFOThreadPool(4),
+        SkExecutor::MakeWorkStealingThreadPool(4),
+    };
+    for (const std::unique_ptr<SkExecutor>& executor : executors) {
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            sk_sp<SkData> actual = make_multipage_pdf(executor.get());
+            REPORTER_ASSERT(r, actual && actual->equals(expected.get()));
+        }
+    }
+}
+
+static int count_occurrences(const SkData* data, const char* needle) {
+    int count = 0;
+    size_t len = strlen(needle);
+    const uint8_t* bytes = data->bytes();
+    for (size_t i = 0; i + len <= data->size(); ++i) {
+        count += 0 == memcmp(bytes + i, needle, len);
+    }
+    return count;
+}
+
+static sk_sp<SkData> make_streamed_pdf(sk_sp<SkTypeface> typeface,
+                                       bool streaming,
+                                       size_t maxRetainedFontBytes,
+                                       int pages) {
+    SkPDF::Metadata metadata;
+    metadata.fStreaming = streaming;
+    metadata.fMaxRetainedFontBytes = maxRetainedFontBytes;
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    SkFont font(std::move(typeface), 12);
+    for (int i = 0; i < pages; ++i) {
+        SkString text = SkStringPrintf("Page %d", i);
+        doc->beginPage(612, 792)->drawString(text, 36, 36, font, SkPaint());
+        doc->endPage();
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+DEF_TEST(SkPDF_streaming, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_streaming, r);
+    sk_sp<SkTypeface> roboto = ToolUtils::CreateTypefaceFromResource("fonts/Roboto-Regular.ttf");
+    if (!roboto) {
+        return;
+    }
+    for (int pages : {1, 7, 8, 9, 65, 100}) {
+        sk_sp<SkData> serial   = make_streamed_pdf(roboto, false, 0, pages),
+                      streamed = make_streamed_pdf(roboto, true, 1 << 20, pages),
+                      tight    = make_streamed_pdf(roboto, true, 0, pages);
+        for (const sk_sp<SkData>& data : {serial, streamed, tight}) {
+            REPORTER_ASSERT(r, count_occurrences(data.get(), "/Type /Page\n") == pages);
+            SkString count = SkStringPrintf("/Count %d\n", pages);
+            REPORTER_ASSERT(r, count_occurrences(data.get(), count.c_str()) == 1);
+        }
+        // With room to spare, the font is written once, as with the serial document. With no
+        // room at all, it is written after every page.
+        REPORTER_ASSERT(r, count_occurrences(serial.get(),   "/Subtype /Type0") == 1);
+        REPORTER_ASSERT(r, count_occurrences(streamed.get(), "/Subtype /Type0") == 1);
+        REPORTER_ASSERT(r, count_occurrences(tight.get(),    "/Subtype /Type0") == pages);
+    }
+}
@@ -39,6 +39,8 @@
 #include "src/pdf/SkClusterator.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 #include "src/pdf/SkPDFFont.h"
+#include "src/pdf/SkPDFGlyphUse.h"
+#include "src/pdf/SkPDFSubsetFont.h"
 #include "src/pdf/SkPDFTypes.h"
 #include "src/pdf/SkPDFUnion.h"
 #include "src/pdf/SkPDFUtils.h"
@@ -349,6 +351,39 @@ DEF_TEST(SkPDF_FontCanEmbedTypeface, reporter) {
 }
 
 
+DEF_TEST(SkPDF_SubsetFontCache, reporter) {
+    sk_sp<SkTypeface> typeface = ToolUtils::CreateTypefaceFromResource("fonts/Roboto-Regular.ttf");
+    if (!typeface) {
+        return;
+    }
+    SkPDFPurgeSubsetFontCache();
+    auto subset = [&](std::initializer_list<SkGlyphID> glyphs) {
+        SkPDFGlyphUse use(1, SkToU16(typeface->countGlyphs() - 1));
+        for (SkGlyphID gid : glyphs) {
+            use.set(gid);
+        }
+        return SkPDFSubsetFontCached(*typeface, use, SkPDF::Metadata::kHarfbuzz_Subsetter,
+                                     "Roboto");
+    };
+
+    sk_sp<SkData> first = subset({0, 40, 41, 42, 43, 44});
+    if (!first) {
+        return;  // No subsetter in this build.
+    }
+    // The same glyphs, and fewer glyphs, share the subset.
+    REPORTER_ASSERT(reporter, subset({0, 40, 41, 42, 43, 44}) == first);
+    REPORTER_ASSERT(reporter, subset({0, 41, 43}) == first);
+
+    // A few more glyphs extend the subset, and the extended subset covers the first glyphs too.
+    sk_sp<SkData> extended = subset({0, 40, 41, 42, 43, 44, 45});
+    REPORTER_ASSERT(reporter, extended && extended != first);
+    REPORTER_ASSERT(reporter, subset({0, 40, 41, 42, 43, 44}) == extended);
+
+    SkPDFPurgeSubsetFontCache();
+    REPORTER_ASSERT(reporter, subset({0, 40, 41, 42, 43, 44}) != extended);
+    SkPDFPurgeSubsetFontCache();
+}
+
 // test to see that all finite scalars round trip via scanf().
 static void check_pdf_scalar_serialization(
         skiatest::Reporter* reporter, float inputFloat) {
@@ -82,6 +82,34 @@ DEF_TEST(PathOpsBuilder, reporter) {
     REPORTER_ASSERT(reporter, pixelDiff == 0);
 }
 
+// Overlapping concave paths can't be summed and simplified at once, so the builder combines them
+// in pairs; the result must match applying the ops one at a time.
+DEF_TEST(PathOpsBuilderPairwise, reporter) {
+    auto chevron = [](SkScalar x, SkScalar y) {
+        SkPath path;
+        path.moveTo(x, y);
+        path.lineTo(x + 6, y + 3);
+        path.lineTo(x, y + 6);
+        path.lineTo(x + 2, y + 3);
+        path.close();
+        return path;
+    };
+    for (SkPathOp op : {kUnion_SkPathOp, kIntersect_SkPathOp, kXOR_SkPathOp}) {
+        SkOpBuilder builder;
+        SkPath expected = chevron(0, 0);
+        builder.add(expected, kUnion_SkPathOp);
+        for (int index = 1; index < 7; ++index) {
+            SkPath path = chevron(index * 0.75f, index * 0.5f);
+            builder.add(path, op);
+            REPORTER_ASSERT(reporter, Op(expected, path, op, &expected));
+        }
+        SkPath result;
+        REPORTER_ASSERT(reporter, builder.resolve(&result));
+        int pixelDiff = comparePaths(reporter, __FUNCTION__, expected, result);
+        REPORTER_ASSERT(reporter, pixelDiff == 0);
+    }
+}
+
 DEF_TEST(BuilderIssue3838, reporter) {
     SkPath path;
     path.moveTo(200, 170);
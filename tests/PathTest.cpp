@@ -6012,3 +6012,83 @@ DEF_TEST(path_walk_simple_edges_1154864, r) {
     paint.setAntiAlias(true);
     surface->getCanvas()->drawPath(path, paint);
 }
+
+// A single contour of lines is checked for convexity by the sign of its corners before falling
+// back to the Convexicator. A degenerate quad at the end doesn't change the contour, but forces
+// the Convexicator, so the two paths must agree.
+DEF_TEST(path_convexity_lines_match_convexicator, r) {
+    auto check = [r](const std::vector<SkPoint>& pts, const char* name) {
+        for (bool explicitClose : {false, true}) {
+            SkPath lines, reference;
+            lines.moveTo(pts[0]);
+            reference.moveTo(pts[0]);
+            for (size_t i = 1; i < pts.size(); ++i) {
+                lines.lineTo(pts[i]);
+                reference.lineTo(pts[i]);
+            }
+            if (explicitClose) {
+                lines.lineTo(pts[0]);
+                reference.lineTo(pts[0]);
+            }
+            reference.quadTo(reference.getPoint(reference.countPoints() - 1),
+                             reference.getPoint(reference.countPoints() - 1));
+            lines.close();
+            reference.close();
+
+            REPORTER_ASSERT(r, lines.isConvex() == reference.isConvex(),
+                            "%s (explicit close %d): convex %d != %d",
+                            name, explicitClose, lines.isConvex(), reference.isConvex());
+            REPORTER_ASSERT(r, SkPathPriv::ComputeFirstDirection(lines) ==
+                               SkPathPriv::ComputeFirstDirection(reference),
+                            "%s (explicit close %d): direction differs", name, explicitClose);
+        }
+    };
+
+    // Regular polygons, wound both ways, with enough corners to take every remainder.
+    for (int n = 3; n <= 20; ++n) {
+        std::vector<SkPoint> cw, ccw;
+        for (int i = 0; i < n; ++i) {
+            const float angle = 2 * SK_ScalarPI * i / n;
+            cw.push_back({50 + 40 * std::cos(angle), 50 + 40 * std::sin(angle)});
+        }
+        ccw.assign(cw.rbegin(), cw.rend());
+        check(cw, "cw polygon");
+        check(ccw, "ccw polygon");
+        REPORTER_ASSERT(r, SkPath::Polygon(cw.data(), n, true).isConvex());
+
+        // Pulling any one corner in just past the line between its neighbors makes a single,
+        // shallow reflex turn, which every lane has to see.
+        for (int dent = 0; n > 3 && dent < n; ++dent) {
+            std::vector<SkPoint> dented = cw;
+            const float scale = (40 * std::cos(2 * SK_ScalarPI / n) - 2) / 40;
+            dented[dent] = {50 + (dented[dent].fX - 50) * scale,
+                            50 + (dented[dent].fY - 50) * scale};
+            check(dented, "dented polygon");
+            REPORTER_ASSERT(r, !SkPath::Polygon(dented.data(), n, true).isConvex());
+        }
+    }
+
+    // A star alternates its turns.
+    std::vector<SkPoint> star;
+    for (int i = 0; i < 10; ++i) {
+        const float angle = 2 * SK_ScalarPI * i / 10, radius = (i & 1) ? 15 : 40;
+        star.push_back({50 + radius * std::cos(angle), 50 + radius * std::sin(angle)});
+    }
+    check(star, "star");
+
+    // A pentagram turns the same way at every corner, but winds around twice.
+    std::vector<SkPoint> pentagram;
+    for (int i = 0; i < 5; ++i) {
+        const float angle = 2 * SK_ScalarPI * ((2 * i) % 5) / 5;
+        pentagram.push_back({50 + 40 * std::cos(angle), 50 + 40 * std::sin(angle)});
+    }
+    check(pentagram, "pentagram");
+    REPORTER_ASSERT(r, !SkPath::Polygon(pentagram.data(), 5, true).isConvex());
+
+    check({{0, 0}, {10, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 5}}, "repeated point");
+    check({{0, 0}, {5, 0}, {10, 0}, {15, 0}, {15, 10}, {0, 10}}, "collinear points");
+    check({{0, 0}, {10, 0}, {20, 0}, {30, 0}, {40, 0}}, "line");
+    check({{0, 0}, {10, 0}, {5, 0}, {20, 0}, {0, 0}, {30, 0}}, "back and forth");
+    check({{3, 3}, {3, 3}, {3, 3}, {3, 3}, {3, 3}, {3, 3}}, "all the same point");
+    check({{0, 0}, {10, 10}}, "two points");
+}
@@ -9,13 +9,23 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
+#include "include/private/base/SkAlign.h"
+#include "src/base/SkRandom.h"
+#include "src/utils/SkTiledRaster.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
+
+#include <memory>
+#include <vector>
 
 class PictureBBHTestBase {
 public:
@@ -125,3 +135,107 @@ DEF_TEST(PictureNegativeSpace, r) {
         REPORTER_ASSERT(r, pic->cullRect() == (SkRect{-20,-20,-10,-10}));
     }
 }
+
+// Non-antialiased rects are the same no matter where a tile seam cuts them. Antialiased and
+// curved geometry is chopped at each tile's edges before scan conversion, which can change how
+// the whole chopped piece rounds, so anything crossing a seam may differ anywhere inside its
+// bounds. Their bounds are returned in seamSensitive.
+static sk_sp<SkPicture> make_tiled_raster_picture(int w, int h, bool seamInvariantOnly,
+                                                  std::vector<SkRect>* seamSensitive) {
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(w, h), &factory);
+    SkRandom rand;
+    for (int i = 0; i < 50; ++i) {
+        SkPaint paint;
+        paint.setAntiAlias(!seamInvariantOnly && rand.nextBool());
+        paint.setColor(rand.nextU() | 0x80000000);
+        SkRect rect = SkRect::MakeXYWH(rand.nextRangeF(-20, w), rand.nextRangeF(-20, h),
+                                       rand.nextRangeF(1, 80), rand.nextRangeF(1, 80));
+        if (seamInvariantOnly || i % 3 == 2) {
+            canvas->drawRect(rect, paint);
+        } else if (i % 3 == 0) {
+            canvas->drawOval(rect, paint);
+        } else {
+            SkPath path;
+            path.moveTo(rect.fLeft, rect.fTop);
+            path.quadTo(rect.fRight, rect.fTop, rect.fRight, rect.fBottom);
+            path.lineTo(rect.fLeft, rect.fBottom);
+            canvas->drawPath(path, paint);
+        }
+        if (paint.isAntiAlias() || i % 3 != 2) {
+            seamSensitive->push_back(rect);
+        }
+    }
+    return recorder.finishRecordingAsPicture();
+}
+
+DEF_TEST(PictureTiledRaster, r) {
+    constexpr int kW = 300, kH = 200;
+    const SkMatrix matrix = SkMatrix::Scale(1.25f, 1.25f);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (bool seamInvariantOnly : {true, false}) {
+        std::vector<SkRect> seamSensitive;
+        sk_sp<SkPicture> picture = make_tiled_raster_picture(kW, kH, seamInvariantOnly,
+                                                             &seamSensitive);
+
+        SkBitmap expected;
+        expected.allocN32Pixels(kW, kH);
+        expected.eraseColor(SK_ColorWHITE);
+        {
+            SkCanvas direct(expected);
+            direct.concat(matrix);
+            direct.drawPicture(picture);
+        }
+
+        for (SkISize tileSize : {SkISize{32, 32}, SkISize{100, 37}, SkISize{1000, 1000}}) {
+            SkBitmap tiled;
+            tiled.allocN32Pixels(kW, kH);
+            tiled.eraseColor(SK_ColorWHITE);
+
+            SkTiledRaster::Options options;
+            options.fTileSize = tileSize;
+            options.fExecutor = executor.get();
+            REPORTER_ASSERT(r, SkTiledRaster::DrawPicture(tiled.pixmap(), picture.get(),
+                                                          matrix, options));
+            if (seamInvariantOnly) {
+                REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, tiled),
+                                "tile size %dx%d", tileSize.width(), tileSize.height());
+                continue;
+            }
+
+            // Seams fall on multiples of the aligned tile size. Only geometry that a seam cuts
+            // through may come out differently, and only within its own (outset) bounds.
+            const int tileW = SkAlignTo(tileSize.width(), SkTiledRaster::kTileAlignment),
+                      tileH = SkAlignTo(tileSize.height(), SkTiledRaster::kTileAlignment);
+            std::vector<SkIRect> cutBySeam;
+            for (const SkRect& rect : seamSensitive) {
+                SkIRect bounds = matrix.mapRect(rect).roundOut().makeOutset(1, 1);
+                if (!bounds.intersect(SkIRect::MakeWH(kW, kH))) {
+                    continue;
+                }
+                if (bounds.fLeft / tileW != (bounds.fRight - 1) / tileW ||
+                    bounds.fTop / tileH != (bounds.fBottom - 1) / tileH) {
+                    cutBySeam.push_back(bounds);
+                }
+            }
+            for (int y = 0; y < kH; ++y) {
+                for (int x = 0; x < kW; ++x) {
+                    if (*expected.getAddr32(x, y) == *tiled.getAddr32(x, y)) {
+                        continue;
+                    }
+                    bool allowed = false;
+                    for (const SkIRect& bounds : cutBySeam) {
+                        allowed |= bounds.contains(x, y);
+                    }
+                    if (!allowed) {
+                        ERRORF(r, "tile size %dx%d: pixel (%d, %d) is %08x, expected %08x",
+                               tileSize.width(), tileSize.height(), x, y,
+                               *tiled.getAddr32(x, y), *expected.getAddr32(x, y));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
+#include "include/utils/SkPictureDamage.h"
+#include "tests/Test.h"
+
+#include <functional>
+
+static sk_sp<SkPicture> record(const std::function<void(SkCanvas*)>& draw) {
+    SkPictureRecorder recorder;
+    draw(recorder.beginRecording(SkRect::MakeWH(100, 100)));
+    return recorder.finishRecordingAsPicture();
+}
+
+// Draws three rects, the middle one in 'color', optionally clipped.
+static void draw_frame(SkCanvas* canvas, SkColor color, const SkRect* clip = nullptr) {
+    SkPaint paint;
+    canvas->drawRect(SkRect::MakeXYWH(0, 0, 10, 10), paint);
+    canvas->save();
+    if (clip) {
+        canvas->clipRect(*clip);
+    }
+    paint.setColor(color);
+    canvas->drawRect(SkRect::MakeXYWH(20, 20, 10, 10), paint);
+    canvas->restore();
+    paint.setColor(SK_ColorBLACK);
+    canvas->drawRect(SkRect::MakeXYWH(40, 40, 10, 10), paint);
+}
+
+DEF_TEST(PictureDamage, r) {
+    sk_sp<SkPicture> frame = record([](SkCanvas* c) { draw_frame(c, SK_ColorRED); });
+
+    // A picture doesn't differ from itself or from a picture drawn the same way.
+    REPORTER_ASSERT(r, SkPictureDamage::Compute(frame.get(), frame.get()).isEmpty());
+    sk_sp<SkPicture> same = record([](SkCanvas* c) { draw_frame(c, SK_ColorRED); });
+    REPORTER_ASSERT(r, SkPictureDamage::Compute(frame.get(), same.get()).isEmpty());
+
+    // Changing the paint of a draw damages just that draw.
+    sk_sp<SkPicture> recolored = record([](SkCanvas* c) { draw_frame(c, SK_ColorBLUE); });
+    SkRegion damage = SkPictureDamage::Compute(frame.get(), recolored.get());
+    REPORTER_ASSERT(r, damage == SkRegion(SkIRect::MakeXYWH(20, 20, 10, 10)));
+
+    // So does changing the clip it's drawn with.
+    const SkRect clip = SkRect::MakeXYWH(0, 0, 25, 25);
+    sk_sp<SkPicture> clipped = record([&](SkCanvas* c) { draw_frame(c, SK_ColorRED, &clip); });
+    damage = SkPictureDamage::Compute(frame.get(), clipped.get());
+    REPORTER_ASSERT(r, damage == SkRegion(SkIRect::MakeXYWH(20, 20, 10, 10)));
+
+    // Inserted draws are damage, and so are both places of a draw that moved.
+    sk_sp<SkPicture> inserted = record([](SkCanvas* c) {
+        draw_frame(c, SK_ColorRED);
+        c->drawRect(SkRect::MakeXYWH(60, 60, 10, 10), SkPaint());
+    });
+    damage = SkPictureDamage::Compute(frame.get(), inserted.get());
+    REPORTER_ASSERT(r, damage == SkRegion(SkIRect::MakeXYWH(60, 60, 10, 10)));
+    damage = SkPictureDamage::Compute(inserted.get(), frame.get());
+    REPORTER_ASSERT(r, damage == SkRegion(SkIRect::MakeXYWH(60, 60, 10, 10)));
+
+    sk_sp<SkPicture> moved = record([](SkCanvas* c) {
+        draw_frame(c, SK_ColorRED);
+        c->drawRect(SkRect::MakeXYWH(70, 70, 10, 10), SkPaint());
+    });
+    SkRegion expected;
+    expected.op(SkIRect::MakeXYWH(60, 60, 10, 10), SkRegion::kUnion_Op);
+    expected.op(SkIRect::MakeXYWH(70, 70, 10, 10), SkRegion::kUnion_Op);
+    REPORTER_ASSERT(r, SkPictureDamage::Compute(inserted.get(), moved.get()) == expected);
+
+    // Without a previous frame everything is damaged.
+    damage = SkPictureDamage::Compute(nullptr, frame.get());
+    REPORTER_ASSERT(r, damage == SkRegion(frame->cullRect().roundOut()));
+}
@@ -8,15 +8,19 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTileMode.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkResourceCache.h"
+#include "src/shaders/SkPictureShader.h"
 #include "tests/Test.h"
 
 #include <cstdint>
@@ -117,3 +121,31 @@ DEF_TEST(PictureShader_caching2, reporter) {
     SkResourceCache::VisitAll(counter, &data);
     REPORTER_ASSERT(reporter, data.counter == 0);
 }
+
+// Check that snapping the tile scale maps every scale within an octave to the same tile, and that
+// the tile is never rendered at less than the requested scale.
+DEF_TEST(PictureShader_snapScaleToPow2, reporter) {
+    const SkRect tile = SkRect::MakeWH(100, 100);
+    auto make = [&](SkScalar scale, bool snap) {
+        return SkPictureShader::CachedImageInfo::Make(tile,
+                                                      SkMatrix::Scale(scale, scale),
+                                                      kRGBA_8888_SkColorType,
+                                                      /*dstColorSpace=*/nullptr,
+                                                      /*maxTextureSize=*/0,
+                                                      SkSurfaceProps(),
+                                                      snap);
+    };
+
+    auto unsnapped = make(1.3f, false);
+    REPORTER_ASSERT(reporter, unsnapped.imageInfo.width() == 130);
+
+    for (SkScalar scale : {1.1f, 1.3f, 1.9f, 2.f}) {
+        auto info = make(scale, true);
+        REPORTER_ASSERT(reporter, info.success);
+        REPORTER_ASSERT(reporter, info.imageInfo.dimensions() == SkISize::Make(200, 200));
+        REPORTER_ASSERT(reporter, info.tileScale == SkSize::Make(2, 2));
+    }
+
+    auto minified = make(0.3f, true);
+    REPORTER_ASSERT(reporter, minified.imageInfo.dimensions() == SkISize::Make(50, 50));
+}
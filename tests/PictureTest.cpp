@@ -11,6 +11,7 @@
 #include "include/core/SkClipOp.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
@@ -26,18 +27,24 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/utils/SkNoDrawCanvas.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkRectPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
+#include "tools/DecodeUtils.h"
+#include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <vector>
 
 class SkRRect;
@@ -794,6 +801,201 @@ DEF_TEST(Picture_empty_serial, reporter) {
 }
 
 
+DEF_TEST(Picture_MakeFromSharedData, r) {
+    sk_sp<SkImage> image = ToolUtils::GetResourceAsImage("images/mandrill_128.png");
+    if (!image) {
+        return;
+    }
+    SkPictureRecorder rec;
+    SkCanvas* canvas = rec.beginRecording(128, 128);
+    canvas->drawImage(image, 0, 0);
+    canvas->drawRect({32, 32, 96, 96}, SkPaint(SkColors::kBlue));
+    sk_sp<SkPicture> pic = rec.finishRecordingAsPicture();
+
+    SkSerialProcs sProcs;
+    sProcs.fImageProc = [](SkImage* img, void*) { return img->refEncodedData(); };
+    sk_sp<SkData> data = pic->serialize(&sProcs);
+    REPORTER_ASSERT(r, data && data->unique());
+
+    SkDeserialProcs dProcs;
+    dProcs.fImageDataProc = [](sk_sp<SkData> encoded, std::optional<SkAlphaType>, void*) {
+        return SkImages::DeferredFromEncodedData(std::move(encoded));
+    };
+    sk_sp<SkPicture> pic2 = SkPicture::MakeFromSharedData(data, &dProcs);
+    REPORTER_ASSERT(r, pic2);
+    if (!pic2) {
+        return;
+    }
+    // The op data and the encoded image reference 'data' instead of copies of it.
+    REPORTER_ASSERT(r, !data->unique());
+
+    SkBitmap expected, actual;
+    expected.allocN32Pixels(128, 128);
+    actual.allocN32Pixels(128, 128);
+    SkCanvas(expected).drawPicture(pic);
+    SkCanvas(actual).drawPicture(pic2);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+
+    pic2.reset();
+    REPORTER_ASSERT(r, data->unique());
+}
+
+DEF_TEST(Picture_DeserializeWithExecutor, r) {
+    sk_sp<SkImage> mandrill = ToolUtils::GetResourceAsImage("images/mandrill_128.png");
+    sk_sp<SkImage> color = ToolUtils::GetResourceAsImage("images/color_wheel.png");
+    if (!mandrill || !color) {
+        return;
+    }
+    SkPictureRecorder rec;
+    SkCanvas* canvas = rec.beginRecording(256, 256);
+    canvas->drawImage(mandrill, 0, 0);
+    canvas->drawImage(color, 128, 0);
+    canvas->drawImageRect(mandrill, {0, 128, 128, 256}, SkSamplingOptions());
+    SkFont font(ToolUtils::DefaultPortableTypeface(), 20);
+    canvas->drawString("Hello", 140, 200, font, SkPaint());
+    sk_sp<SkData> data = rec.finishRecordingAsPicture()->serialize();
+    REPORTER_ASSERT(r, data);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkDeserialProcs procs;
+    procs.fExecutor = executor.get();
+    sk_sp<SkPicture> serial = SkPicture::MakeFromData(data.get());
+    sk_sp<SkPicture> parallel = SkPicture::MakeFromData(data.get(), &procs);
+    REPORTER_ASSERT(r, serial && parallel);
+    if (!serial || !parallel) {
+        return;
+    }
+    REPORTER_ASSERT(r, parallel->approximateOpCount() == serial->approximateOpCount());
+
+    SkBitmap expected, actual;
+    expected.allocN32Pixels(256, 256);
+    actual.allocN32Pixels(256, 256);
+    expected.eraseColor(SK_ColorWHITE);
+    actual.eraseColor(SK_ColorWHITE);
+    SkCanvas(expected).drawPicture(serial);
+    SkCanvas(actual).drawPicture(parallel);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+}
+
+DEF_TEST(Picture_SubRecordings, r) {
+    // Each subtree draws into its own 100x100 cell, relative to the cell's origin.
+    auto drawSubtree = [](SkCanvas* canvas, int i, bool relative) {
+        canvas->drawRect({0, 0, 100, 100}, SkPaint(SkColors::kYellow));
+        canvas->save();
+        if (relative) {
+            // A sub-recording's setMatrix() is relative to its placeholder.
+            canvas->setMatrix(SkMatrix::Translate(10 + i, 10));
+        } else {
+            canvas->translate(10 + i, 10);
+        }
+        canvas->drawCircle(20, 20, 20, SkPaint(SkColors::kBlue));
+        canvas->restore();
+        canvas->drawRect({50, 50, 90, 90}, SkPaint(SkColors::kGreen));
+    };
+    auto drawParent = [](SkCanvas* canvas, int i) {
+        canvas->translate(100 * (i % 2), 100 * (i / 2));
+    };
+
+    SkPictureRecorder expectedRecorder;
+    SkCanvas* canvas = expectedRecorder.beginRecording(200, 200);
+    for (int i = 0; i < 4; ++i) {
+        canvas->save();
+        drawParent(canvas, i);
+        drawSubtree(canvas, i, /*relative=*/false);
+        canvas->restore();
+    }
+    sk_sp<SkPicture> expected = expectedRecorder.finishRecordingAsPicture();
+
+    SkPictureRecorder recorder;
+    SkRTreeFactory factory;
+    canvas = recorder.beginRecording(SkRect::MakeWH(200, 200), &factory);
+    std::vector<std::unique_ptr<SkPictureRecorder::SubRecording>> subs;
+    for (int i = 0; i < 4; ++i) {
+        canvas->save();
+        drawParent(canvas, i);
+        subs.push_back(recorder.beginSubRecording(SkRect::MakeWH(100, 100)));
+        canvas->restore();
+    }
+    // This one is never finished, so it is dropped.
+    std::unique_ptr<SkPictureRecorder::SubRecording> unfinished =
+            recorder.beginSubRecording(SkRect::MakeWH(200, 200));
+    unfinished->getRecordingCanvas()->drawPaint(SkPaint(SkColors::kRed));
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkTaskGroup tasks(*executor);
+    for (int i = 0; i < 4; ++i) {
+        tasks.add([&, i] {
+            drawSubtree(subs[i]->getRecordingCanvas(), i, /*relative=*/true);
+            subs[i]->finish();
+            REPORTER_ASSERT(r, !subs[i]->getRecordingCanvas());
+        });
+    }
+    tasks.wait();
+    sk_sp<SkPicture> actual = recorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(r, actual->approximateOpCount() > 4 * 4);
+
+    SkBitmap expectedBitmap, actualBitmap;
+    expectedBitmap.allocN32Pixels(200, 200);
+    actualBitmap.allocN32Pixels(200, 200);
+    expectedBitmap.eraseColor(SK_ColorWHITE);
+    actualBitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas(expectedBitmap).drawPicture(expected);
+    SkCanvas(actualBitmap).drawPicture(actual);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expectedBitmap, actualBitmap));
+
+    // The spliced ops are culled by the picture's bounding box hierarchy like any other.
+    actualBitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas clipped(actualBitmap);
+    clipped.clipRect({100, 100, 200, 200});
+    clipped.drawPicture(actual);
+    REPORTER_ASSERT(r, actualBitmap.getColor(50, 50) == SK_ColorWHITE);
+    REPORTER_ASSERT(r, actualBitmap.getColor(150, 150) == expectedBitmap.getColor(150, 150));
+}
+
+DEF_TEST(Picture_InternPaints, r) {
+    sk_sp<SkImage> image = ToolUtils::GetResourceAsImage("images/mandrill_128.png");
+    if (!image) {
+        return;
+    }
+    auto draw = [&](SkCanvas* canvas) {
+        SkPaint stroke(SkColors::kBlue);
+        stroke.setStyle(SkPaint::kStroke_Style);
+        stroke.setStrokeWidth(3);
+        SkPaint translucent;
+        translucent.setAlphaf(0.5f);
+        SkFont font(ToolUtils::DefaultPortableTypeface(), 12);
+        for (int i = 0; i < 8; ++i) {
+            canvas->drawRect(SkRect::MakeXYWH(i * 16, 0, 12, 12), stroke);
+            canvas->drawImageRect(image, SkRect::MakeXYWH(i * 16, 16, 16, 16), SkSamplingOptions(),
+                                  &translucent);
+            canvas->drawString("A", i * 16, 48, font, stroke);
+        }
+        // A layer that the optimizer would fold into its draw, if the draw's paint weren't shared.
+        canvas->saveLayerAlphaf(nullptr, 0.5f);
+        canvas->drawRect(SkRect::MakeXYWH(0, 64, 64, 64), stroke);
+        canvas->restore();
+        canvas->drawRect(SkRect::MakeXYWH(64, 64, 64, 64), stroke);
+    };
+
+    SkPictureRecorder recorder;
+    SkRTreeFactory factory;
+    draw(recorder.beginRecording(SkRect::MakeWH(128, 128), &factory));
+    sk_sp<SkPicture> expected = recorder.finishRecordingAsPicture();
+    draw(recorder.beginRecording(SkRect::MakeWH(128, 128), &factory,
+                                 SkPictureRecorder::kInternPaints_RecordFlag));
+    sk_sp<SkPicture> interned = recorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(r, interned->approximateBytesUsed() < expected->approximateBytesUsed());
+
+    SkBitmap expectedBitmap, actualBitmap;
+    expectedBitmap.allocN32Pixels(128, 128);
+    actualBitmap.allocN32Pixels(128, 128);
+    expectedBitmap.eraseColor(SK_ColorWHITE);
+    actualBitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas(expectedBitmap).drawPicture(expected);
+    SkCanvas(actualBitmap).drawPicture(interned);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expectedBitmap, actualBitmap));
+}
+
 DEF_TEST(Picture_drawsNothing, r) {
     // Tests that pic->cullRect().isEmpty() is a good way to test a picture
     // recorded with an R-tree draws nothing.
@@ -924,3 +1126,65 @@ DEF_TEST(Picture_nested_op_count, r) {
     check(make_pic(10, leaf1),  10,  10);
     check(make_pic(10, leaf10), 10, 100);
 }
+
+DEF_TEST(Picture_playbackRects, r) {
+    // A picture without a BBH: a 10x10 grid of cells, and a nested picture whose cull rect covers
+    // the whole picture but whose only op is in the bottom right cell.
+    SkPictureRecorder rec;
+    SkCanvas* c = rec.beginRecording({0,0, 100,100});
+    c->drawRect({92,92, 98,98}, SkPaint{});
+    c->drawRect({92,92, 98,98}, SkPaint{});
+    sk_sp<SkPicture> nested = rec.finishRecordingAsPicture();
+
+    c = rec.beginRecording({0,0, 100,100});
+    SkPaint paint;
+    for (int y = 0; y < 10; y++) {
+        for (int x = 0; x < 10; x++) {
+            paint.setColor(SkColorSetRGB(25 * x, 25 * y, 128));
+            c->drawRect(SkRect::MakeXYWH(10 * x + 1, 10 * y + 1, 8, 8), paint);
+        }
+    }
+    c->drawPicture(nested);
+    sk_sp<SkPicture> picture = rec.finishRecordingAsPicture();
+    REPORTER_ASSERT(r, SkPicturePriv::AsSkBigPicture(picture));
+
+    const SkRect dirty[] = {{12,12, 18,18}, {50,70, 70,80}, {14,14, 16,16}};
+
+    // Playing back the rects draws the same pixels as playing back everything clipped to them.
+    SkBitmap expected, actual;
+    expected.allocN32Pixels(100, 100);
+    actual.allocN32Pixels(100, 100);
+    expected.eraseColor(SK_ColorWHITE);
+    actual.eraseColor(SK_ColorWHITE);
+    {
+        SkCanvas canvas(expected);
+        SkPath clip;
+        for (const SkRect& rect : dirty) {
+            clip.addRect(rect);
+        }
+        canvas.clipPath(clip);
+        picture->playback(&canvas);
+    }
+    for (int i = 0; i < 3; i++) {
+        SkCanvas canvas(actual);
+        picture->playbackRects(&canvas, dirty);
+        REPORTER_ASSERT(r, canvas.getSaveCount() == 1);
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+    }
+
+    // Once the picture has been played back partially, it culls with its own BBH, which skips the
+    // cells outside the rects and the nested picture.
+    struct CountingCanvas : public SkNoDrawCanvas {
+        CountingCanvas() : SkNoDrawCanvas(100, 100) {}
+        void onDrawRect(const SkRect&, const SkPaint&) override { fRects++; }
+        int fRects = 0;
+    } counter;
+    picture->playbackRects(&counter, dirty);
+    REPORTER_ASSERT(r, counter.fRects == 3, "drew %d rects, want 3", counter.fRects);
+
+    // The nested picture is drawn when a rect touches its op.
+    counter.fRects = 0;
+    const SkRect corner = {95,95, 100,100};
+    picture->playbackRects(&counter, {&corner, 1});
+    REPORTER_ASSERT(r, counter.fRects == 3, "drew %d rects, want 3", counter.fRects);
+}
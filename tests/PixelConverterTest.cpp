@@ -0,0 +1,108 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkConvertPixels.h"
+#include "tests/Test.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Fills an unpremul 8888 image with noise, then converts it to 'info' to get valid pixels.
+static std::vector<char> make_pixels(const SkImageInfo& info, size_t rowBytes) {
+    SkImageInfo noiseInfo = info.makeColorType(kRGBA_8888_SkColorType)
+                                .makeAlphaType(kUnpremul_SkAlphaType);
+    std::vector<uint32_t> noise(noiseInfo.width() * noiseInfo.height());
+    SkRandom random;
+    for (uint32_t& pixel : noise) {
+        pixel = random.nextU();
+    }
+    std::vector<char> pixels(rowBytes * info.height());
+    SkAssertResult(SkConvertPixels(info, pixels.data(), rowBytes,
+                                   noiseInfo, noise.data(), noiseInfo.minRowBytes()));
+    return pixels;
+}
+
+DEF_TEST(PixelConverter, r) {
+    sk_sp<SkColorSpace> srgb = SkColorSpace::MakeSRGB();
+    sk_sp<SkColorSpace> p3 = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                   SkNamedGamut::kDisplayP3);
+    sk_sp<SkColorSpace> linear = SkColorSpace::MakeSRGBLinear();
+
+    struct {
+        SkColorInfo fSrc, fDst;
+    } tests[] = {
+        // A plain copy and a swizzle take the fast paths.
+        {{kRGBA_8888_SkColorType, kPremul_SkAlphaType, srgb},
+         {kRGBA_8888_SkColorType, kPremul_SkAlphaType, srgb}},
+        {{kRGBA_8888_SkColorType, kUnpremul_SkAlphaType, srgb},
+         {kBGRA_8888_SkColorType, kPremul_SkAlphaType, srgb}},
+        {{kRGBA_F16_SkColorType, kPremul_SkAlphaType, srgb},
+         {kAlpha_8_SkColorType, kPremul_SkAlphaType, nullptr}},
+        // These need a pipeline.
+        {{kRGBA_F16_SkColorType, kPremul_SkAlphaType, linear},
+         {kRGBA_8888_SkColorType, kPremul_SkAlphaType, srgb}},
+        {{kRGBA_8888_SkColorType, kPremul_SkAlphaType, p3},
+         {kRGBA_F32_SkColorType, kUnpremul_SkAlphaType, srgb}},
+        {{kRGBA_F32_SkColorType, kUnpremul_SkAlphaType, srgb},
+         {kRGBA_F16_SkColorType, kPremul_SkAlphaType, p3}},
+    };
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (const auto& test : tests) {
+        SkPixelConverter converter(test.fDst, test.fSrc);
+        REPORTER_ASSERT(r, converter.isValid());
+
+        // Convert a few small images with the same converter, then one big enough to be split into
+        // bands. The odd widths leave a partial span at the end of each row.
+        for (SkISize size : {SkISize{13, 7}, SkISize{1, 1}, SkISize{67, 5}, SkISize{509, 700}}) {
+            SkImageInfo srcInfo = SkImageInfo::Make(size, test.fSrc);
+            SkImageInfo dstInfo = SkImageInfo::Make(size, test.fDst);
+            // Leave some padding at the end of each row.
+            size_t srcRB = srcInfo.minRowBytes() + 3 * srcInfo.bytesPerPixel();
+            size_t dstRB = dstInfo.minRowBytes() + 2 * dstInfo.bytesPerPixel();
+            std::vector<char> src = make_pixels(srcInfo, srcRB);
+
+            std::vector<char> expected(dstRB * size.height());
+            REPORTER_ASSERT(r, SkConvertPixels(dstInfo, expected.data(), dstRB,
+                                               srcInfo, src.data(), srcRB));
+
+            for (SkExecutor* exec : {static_cast<SkExecutor*>(nullptr), executor.get()}) {
+                std::vector<char> actual(dstRB * size.height());
+                REPORTER_ASSERT(r, converter.convert(size, actual.data(), dstRB,
+                                                     src.data(), srcRB, exec));
+                for (int y = 0; y < size.height(); ++y) {
+                    REPORTER_ASSERT(r, !memcmp(actual.data() + y * dstRB,
+                                               expected.data() + y * dstRB,
+                                               dstInfo.minRowBytes()));
+                }
+            }
+        }
+    }
+
+    // Row bytes must hold a whole number of pixels.
+    SkPixelConverter converter({kRGBA_F16_SkColorType, kPremul_SkAlphaType, srgb},
+                               {kRGBA_8888_SkColorType, kPremul_SkAlphaType, srgb});
+    uint64_t dst[4];
+    uint32_t src[4] = {};
+    REPORTER_ASSERT(r, !converter.convert({2, 2}, dst, 17, src, 8));
+
+    // Unknown color types can't be converted.
+    SkPixelConverter invalid({kUnknown_SkColorType, kPremul_SkAlphaType, srgb},
+                             {kRGBA_8888_SkColorType, kPremul_SkAlphaType, srgb});
+    REPORTER_ASSERT(r, !invalid.isValid());
+}
@@ -17,8 +17,12 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkImageFilters.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkRandom.h"
 #include "tests/Test.h"
 
+#include <iterator>
+
 static void test_drawBitmap(skiatest::Reporter* reporter) {
     SkBitmap src;
     src.allocN32Pixels(10, 10);
@@ -127,3 +131,42 @@ DEF_TEST(QuickReject_MatrixState, reporter) {
     // quickReject() will assert if the matrix is out of sync.
     canvas.quickReject(SkRect::MakeWH(100.0f, 100.0f));
 }
+
+DEF_TEST(QuickReject_Rects, reporter) {
+    SkCanvas canvas(100, 100);
+    canvas.clipRect(SkRect::MakeLTRB(10, 20, 70, 90));
+    canvas.translate(5, -3);
+
+    SkRandom rand;
+    SkRect rects[67];
+    for (SkRect& r : rects) {
+        r = SkRect::MakeXYWH(rand.nextRangeF(-50, 150), rand.nextRangeF(-50, 150),
+                             rand.nextRangeF(0, 20), rand.nextRangeF(0, 20));
+    }
+    rects[5] = SkRect::MakeLTRB(0, 0, SK_ScalarInfinity, 10);
+    rects[6] = SkRect::MakeLTRB(SK_ScalarNaN, 0, 10, 10);
+
+    SkMatrix perspective = SkMatrix::Scale(2, 2);
+    perspective.setPerspX(0.001f);
+    for (const SkMatrix& matrix : {SkMatrix::I(),
+                                   SkMatrix::Scale(0.5f, 1.5f),
+                                   SkMatrix::RotateDeg(30, {50, 50}),
+                                   perspective}) {
+        uint32_t visible[3];
+        const int count = canvas.quickRejectRects(rects, matrix, visible);
+
+        canvas.save();
+        canvas.concat(matrix);
+        int expectedCount = 0;
+        for (size_t i = 0; i < std::size(rects); ++i) {
+            const bool expected = !canvas.quickReject(rects[i]);
+            expectedCount += expected;
+            REPORTER_ASSERT(reporter, expected == SkToBool(visible[i / 32] & (1u << (i % 32))),
+                            "rect %zu", i);
+        }
+        canvas.restore();
+        REPORTER_ASSERT(reporter, count == expectedCount);
+        REPORTER_ASSERT(reporter, count > 0 && count < (int)std::size(rects));
+        REPORTER_ASSERT(reporter, (visible[2] >> 3) == 0);
+    }
+}
@@ -34,10 +34,11 @@ static SkRect random_rect(SkRandom& rand) {
     return rect;
 }
 
-static bool verify_query(SkRect query, SkRect rects[], const std::vector<int>& found) {
+static bool verify_query(SkRect query, SkRect rects[], const std::vector<int>& found,
+                         int numRects = NUM_RECTS) {
     std::vector<int> expected;
     // manually intersect with every rectangle
-    for (int i = 0; i < NUM_RECTS; ++i) {
+    for (int i = 0; i < numRects; ++i) {
         if (SkRect::Intersects(query, rects[i])) {
             expected.push_back(i);
         }
@@ -97,3 +98,24 @@ DEF_TEST(RTree, reporter) {
                                   expectedDepthMax >= rtree.getDepth());
     }
 }
+
+// Trees this big are sorted into tiles, but they must still find the rects in op order.
+DEF_TEST(RTree_Sorted, reporter) {
+    const int count = SkRTree::kMinSortedCount + 100;
+    SkRandom rand;
+    AutoTArray<SkRect> rects(count);
+    for (int i = 0; i < count; ++i) {
+        rects[i] = SkRect::MakeXYWH(rand.nextRangeF(0, 1000), rand.nextRangeF(0, 1000),
+                                    rand.nextRangeF(1, 50), rand.nextRangeF(1, 50));
+    }
+    SkRTree rtree;
+    rtree.insert(rects.data(), count);
+    REPORTER_ASSERT(reporter, count == rtree.getCount());
+
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        std::vector<int> hits;
+        SkRect query = random_rect(rand);
+        rtree.search(query, &hits);
+        REPORTER_ASSERT(reporter, verify_query(query, rects.data(), hits, count));
+    }
+}
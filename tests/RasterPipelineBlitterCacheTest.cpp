@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "tests/Test.h"
+
+#include <cstring>
+
+// Draws a sequence of solid-color rects into one surface, whose device reuses its blitters from
+// draw to draw, and checks each draw against the same draw into a fresh surface.
+DEF_TEST(RasterPipelineBlitterCache, r) {
+    struct Draw {
+        SkColor4f fColor;
+        SkBlendMode fMode;
+        bool fAntiAlias;
+        float fRotate;
+    };
+    const Draw draws[] = {
+        {{1, 0, 0, 1},       SkBlendMode::kSrcOver,  false, 0},
+        {{0, 0, 1, 1},       SkBlendMode::kSrcOver,  false, 0},  // Same stages, new color.
+        {{0, 1, 0, 0.5f},    SkBlendMode::kSrcOver,  true,  0},
+        {{1, 1, 0, 0.25f},   SkBlendMode::kSrcOver,  true,  30},
+        {{0, 0, 0, 1},       SkBlendMode::kSrc,      true,  45},
+        {{1, 1, 1, 1},       SkBlendMode::kSrc,      false, 0},
+        {{0.2f, 0.4f, 0.6f, 0.8f}, SkBlendMode::kSrc, false, 0},
+        {{0.6f, 0.4f, 0.2f, 0.8f}, SkBlendMode::kSrc, false, 0},
+        {{1.5f, 0.5f, -0.25f, 1},  SkBlendMode::kSrcOver, true,  10},
+        {{0.5f, 0.25f, 1, 0.75f},  SkBlendMode::kMultiply, true, 20},
+        {{0.25f, 1, 0.5f, 0.75f},  SkBlendMode::kMultiply, true, 20},
+    };
+
+    sk_sp<SkColorSpace> p3 = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                   SkNamedGamut::kDisplayP3);
+    const SkImageInfo infos[] = {
+        SkImageInfo::Make(64, 64, kRGBA_F16_SkColorType, kPremul_SkAlphaType),
+        SkImageInfo::Make(64, 64, kRGBA_8888_SkColorType, kPremul_SkAlphaType, p3),
+        SkImageInfo::Make(64, 64, kRGB_565_SkColorType, kOpaque_SkAlphaType),
+    };
+
+    for (const SkImageInfo& info : infos) {
+        sk_sp<SkSurface> surface = SkSurfaces::Raster(info);
+        surface->getCanvas()->clear(SK_ColorGRAY);
+
+        // Go through the draws twice, so every kind of draw finds its blitter already built.
+        for (int pass = 0; pass < 2; ++pass) {
+            for (const Draw& draw : draws) {
+                SkPaint paint(draw.fColor);
+                paint.setBlendMode(draw.fMode);
+                paint.setAntiAlias(draw.fAntiAlias);
+                auto drawRect = [&](SkCanvas* canvas) {
+                    canvas->save();
+                    canvas->rotate(draw.fRotate, 32, 32);
+                    canvas->drawRect(SkRect::MakeXYWH(8.5f, 12.25f, 40, 30), paint);
+                    canvas->restore();
+                };
+
+                SkPixmap before;
+                REPORTER_ASSERT(r, surface->peekPixels(&before));
+                sk_sp<SkSurface> fresh = SkSurfaces::Raster(info);
+                fresh->writePixels(before, 0, 0);
+                drawRect(fresh->getCanvas());
+                drawRect(surface->getCanvas());
+
+                SkPixmap expected, actual;
+                REPORTER_ASSERT(r, fresh->peekPixels(&expected));
+                REPORTER_ASSERT(r, surface->peekPixels(&actual));
+                bool same = true;
+                for (int y = 0; y < info.height(); ++y) {
+                    same &= !memcmp(expected.addr(0, y), actual.addr(0, y), info.minRowBytes());
+                }
+                REPORTER_ASSERT(r, same, "color type %d, pass %d", info.colorType(), pass);
+            }
+        }
+    }
+}
@@ -426,3 +426,113 @@ DEF_TEST(savelayer_srcmode_alpha, r) {
     do_savelayer_srcmode(r, 0x80FF0000);
 }
 
+
+DEF_TEST(RecordOpts_ReorderDraws, r) {
+    SkPaint red, blue;
+    red.setColor(SK_ColorRED);
+    blue.setColor(SK_ColorBLUE);
+
+    auto assert_rect = [&](const SkRecord& record, int index, const SkRect& rect) {
+        const SkRecords::DrawRect* draw = assert_type<SkRecords::DrawRect>(r, record, index);
+        REPORTER_ASSERT(r, draw && draw->rect == rect);
+    };
+
+    const SkRect a = SkRect::MakeXYWH(0, 0, 50, 50),
+                 b = SkRect::MakeXYWH(100, 0, 50, 50),
+                 c = SkRect::MakeXYWH(200, 0, 50, 50);
+    {
+        // The second red rect moves up next to the first one.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        recorder.drawRect(a, red);
+        recorder.drawRect(b, blue);
+        recorder.drawRect(c, red);
+        SkRecordReorderDraws(&record);
+        assert_rect(record, 0, a);
+        assert_rect(record, 1, c);
+        assert_rect(record, 2, b);
+    }
+    {
+        // It can't pass a draw that it overlaps, even by one pixel with antialiasing.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        recorder.drawRect(a, red);
+        recorder.drawRect(b, blue);
+        recorder.drawRect(SkRect::MakeXYWH(150, 0, 50, 50), red);
+        SkRecordReorderDraws(&record);
+        assert_rect(record, 1, b);
+    }
+    {
+        // Or any state change.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        recorder.drawRect(a, red);
+        recorder.drawRect(b, blue);
+        recorder.translate(1, 0);
+        recorder.drawRect(c, red);
+        SkRecordReorderDraws(&record);
+        assert_rect(record, 1, b);
+        assert_rect(record, 3, c);
+    }
+}
+
+DEF_TEST(RecordOpts_NoopOccludedDraws, r) {
+    SkPaint red, blue, translucent;
+    red.setColor(SK_ColorRED);
+    blue.setColor(SK_ColorBLUE);
+    translucent.setColor(0x80FF0000);
+
+    const SkRect card = SkRect::MakeXYWH(10, 10, 50, 50),
+                 cover = SkRect::MakeXYWH(0, 0, 100, 100);
+    {
+        // An opaque rect hides the draws under it, and an opaque paint hides everything.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        recorder.drawRect(cover, blue);
+        recorder.drawRect(card, red);
+        recorder.drawRect(cover, blue);
+        recorder.drawRect(SkRect::MakeXYWH(90, 90, 50, 50), red);
+        SkRecordNoopOccludedDraws(&record);
+        REPORTER_ASSERT(r, 2 == count_instances_of_type<SkRecords::NoOp>(record));
+        assert_type<SkRecords::NoOp>(r, record, 0);
+        assert_type<SkRecords::NoOp>(r, record, 1);
+
+        recorder.drawPaint(red);
+        SkRecordNoopOccludedDraws(&record);
+        REPORTER_ASSERT(r, 4 == count_instances_of_type<SkRecords::NoOp>(record));
+    }
+    {
+        // Translucent draws don't hide anything, and only whole pixels of a rect are opaque.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        recorder.drawRect(card, red);
+        recorder.drawRect(cover, translucent);
+        recorder.drawRect(SkRect::MakeLTRB(10.5f, 10, 60, 60), blue);
+        SkRecordNoopOccludedDraws(&record);
+        REPORTER_ASSERT(r, 0 == count_instances_of_type<SkRecords::NoOp>(record));
+    }
+    {
+        // An antialiased draw may touch the pixels around its rounded out bounds.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        SkPaint aa = red;
+        aa.setAntiAlias(true);
+        recorder.drawRect(card, aa);
+        recorder.drawRect(card, blue);
+        SkRecordNoopOccludedDraws(&record);
+        REPORTER_ASSERT(r, 0 == count_instances_of_type<SkRecords::NoOp>(record));
+    }
+    {
+        // Draws aren't hidden across state changes, or under antialiased clips.
+        SkRecord record;
+        SkRecorder recorder(&record, W, H);
+        recorder.drawRect(card, red);
+        recorder.translate(1, 0);
+        recorder.drawRect(cover, blue);
+        recorder.clipRect(SkRect::MakeWH(99.5f, 99.5f), true);
+        recorder.drawRect(card, red);
+        recorder.drawRect(cover, blue);
+        SkRecordNoopOccludedDraws(&record);
+        REPORTER_ASSERT(r, 0 == count_instances_of_type<SkRecords::NoOp>(record));
+    }
+}
@@ -58,6 +58,31 @@ DEF_TEST(Recorder, r) {
     REPORTER_ASSERT(r, 1 == tally.count<SkRecords::DrawRect>());
 }
 
+DEF_TEST(Recorder_InternPaints, r) {
+    SkPaint blue(SkColors::kBlue), red(SkColors::kRed);
+    red.setShader(SkShaders::Color(SK_ColorRED));
+    {
+        SkRecord record;
+        SkRecorder recorder(&record, 1920, 1080);
+        recorder.setInternPaints(true);
+        for (int i = 0; i < 100; ++i) {
+            recorder.drawRect(SkRect::MakeXYWH(i, i, 10, 10), i % 2 ? blue : red);
+        }
+        recorder.drawOval(SkRect::MakeWH(10, 10), blue);
+
+        Tally tally;
+        tally.apply(record);
+        REPORTER_ASSERT(r, 100 == tally.count<SkRecords::DrawRectInterned>());
+        REPORTER_ASSERT(r, 0 == tally.count<SkRecords::DrawRect>());
+        REPORTER_ASSERT(r, 1 == tally.count<SkRecords::DrawOval>());
+        REPORTER_ASSERT(r, 2 == record.internedPaintCount());
+
+        // Only the record's copy refs the shader, not every op.
+        REPORTER_ASSERT(r, !red.getShader()->unique());
+    }
+    REPORTER_ASSERT(r, red.getShader()->unique());
+}
+
 // Regression test for leaking refs held by optional arguments.
 DEF_TEST(Recorder_RefLeaking, r) {
     // We use SaveLayer to test:
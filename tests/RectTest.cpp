@@ -22,6 +22,7 @@
 #include "src/core/SkRectPriv.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <climits>
 #include <initializer_list>
 #include <string>
@@ -154,6 +155,50 @@ DEF_TEST(Rect_setbounds, reporter) {
     }
 }
 
+// setBoundsCheck walks the points 2 and then 4 at a time; check every remainder against a plain
+// min/max, and that a non-finite value is caught wherever it lands.
+DEF_TEST(Rect_setBoundsCheck_matchesScalar, reporter) {
+    constexpr int kMaxCount = 21;
+    SkPoint pts[kMaxCount];
+    for (int i = 0; i < kMaxCount; ++i) {
+        pts[i] = {(float)((i * 7) % 11) - 5.5f, (float)((i * 5) % 13) * 0.25f - 1};
+    }
+
+    for (int n = 1; n <= kMaxCount; ++n) {
+        SkRect expected = {pts[0].fX, pts[0].fY, pts[0].fX, pts[0].fY};
+        for (int i = 1; i < n; ++i) {
+            expected.fLeft   = std::min(expected.fLeft,   pts[i].fX);
+            expected.fTop    = std::min(expected.fTop,    pts[i].fY);
+            expected.fRight  = std::max(expected.fRight,  pts[i].fX);
+            expected.fBottom = std::max(expected.fBottom, pts[i].fY);
+        }
+        SkRect r;
+        REPORTER_ASSERT(reporter, r.setBoundsCheck(pts, n));
+        REPORTER_ASSERT(reporter, r == expected, "count %d", n);
+
+        for (int bad = 0; bad < n; ++bad) {
+            for (float value : {SK_ScalarNaN, SK_ScalarInfinity, SK_ScalarNegativeInfinity}) {
+                for (bool inY : {false, true}) {
+                    const SkPoint saved = pts[bad];
+                    (inY ? pts[bad].fY : pts[bad].fX) = value;
+                    REPORTER_ASSERT(reporter, !r.setBoundsCheck(pts, n));
+                    REPORTER_ASSERT(reporter, r == SkRect::MakeEmpty(),
+                                    "count %d, bad point %d", n, bad);
+                    pts[bad] = saved;
+                }
+            }
+        }
+    }
+
+    SkPoint same[kMaxCount];
+    std::fill(same, same + kMaxCount, SkPoint{3, -4});
+    for (int n = 1; n <= kMaxCount; ++n) {
+        SkRect r;
+        REPORTER_ASSERT(reporter, r.setBoundsCheck(same, n));
+        REPORTER_ASSERT(reporter, r == SkRect::MakeLTRB(3, -4, 3, -4));
+    }
+}
+
 static float make_big_value(skiatest::Reporter* reporter) {
     // need to make a big value, one that will cause rect.width() to overflow to inf.
     // however, the windows compiler wants about this if it can see the big value inlined.
@@ -584,3 +584,37 @@ DEF_TEST(region_very_large, reporter) {
     REPORTER_ASSERT(reporter, smallRegion.contains(499, 0));
     REPORTER_ASSERT(reporter, smallRegion.contains(499, 499));
 }
+
+// Ops where one side is a rect or has single-interval scanlines take shortcuts, so check every op
+// against its definition, pixel by pixel.
+DEF_TEST(Region_OpsMatchPixels, reporter) {
+    SkRandom rand;
+    for (int i = 0; i < 500; ++i) {
+        SkIRect rects[16];
+        for (SkIRect& r : rects) {
+            rand_rect(&r, rand);
+        }
+        SkRegion a, b;
+        a.setRects(rects, 12);
+        if (i & 1) {
+            b.setRect(rects[12]);
+        } else {
+            b.setRects(rects + 12, 4);
+        }
+
+        for (int op = 0; op <= SkRegion::kReverseDifference_Op; ++op) {
+            SkRegion ab, ba;
+            ab.op(a, b, (SkRegion::Op)op);
+            ba.op(b, a, (SkRegion::Op)op);
+            for (int y = -1; y <= 64; ++y) {
+                for (int x = -1; x <= 64; ++x) {
+                    const bool inA = a.contains(x, y), inB = b.contains(x, y);
+                    bool expected[] = {inA && !inB, inA && inB, inA || inB, inA != inB, !inA && inB};
+                    bool reversed[] = {inB && !inA, inA && inB, inA || inB, inA != inB, !inB && inA};
+                    REPORTER_ASSERT(reporter, ab.contains(x, y) == expected[op]);
+                    REPORTER_ASSERT(reporter, ba.contains(x, y) == reversed[op]);
+                }
+            }
+        }
+    }
+}
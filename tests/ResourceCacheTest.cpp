@@ -1287,6 +1287,62 @@ static void test_timestamp_wrap(skiatest::Reporter* reporter) {
     }
 }
 
+static void test_adaptive_budget(skiatest::Reporter* reporter) {
+    Mock mock(100000);
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = mock.gpu();
+    cache->setAdaptiveBudget(true);
+
+    auto addResources = [&](int first, int count) {
+        for (int i = first; i < first + count; ++i) {
+            TestResource* r = new TestResource(gpu, /*label=*/{}, skgpu::Budgeted::kYes, 1000);
+            skgpu::UniqueKey k;
+            make_unique_key<0>(&k, i);
+            r->resourcePriv().setUniqueKey(k);
+            r->unref();
+        }
+    };
+    auto useResource = [&](int i) {
+        skgpu::UniqueKey k;
+        make_unique_key<0>(&k, i);
+        GrGpuResource* r = cache->findAndRefUniqueResource(k);
+        SkSafeUnref(r);
+        return SkToBool(r);
+    };
+
+    // Everything was used in the first frame, so nothing is purged.
+    addResources(0, 10);
+    cache->didEndFrame();
+    REPORTER_ASSERT(reporter, 15000 == cache->getAdaptiveBudget());
+    REPORTER_ASSERT(reporter, 10 == cache->getResourceCount());
+
+    // Once the first frame drops out of the history the budget shrinks to fit the two resources
+    // that are still used, and the least recently used of the others are purged.
+    for (int frame = 0; frame < 60; ++frame) {
+        REPORTER_ASSERT(reporter, useResource(0));
+        REPORTER_ASSERT(reporter, useResource(1));
+        cache->didEndFrame();
+        if (frame < 59) {
+            REPORTER_ASSERT(reporter, 10 == cache->getResourceCount());
+        }
+    }
+    REPORTER_ASSERT(reporter, 3000 == cache->getAdaptiveBudget());
+    REPORTER_ASSERT(reporter, 3 == cache->getResourceCount());
+    REPORTER_ASSERT(reporter, useResource(0));
+    REPORTER_ASSERT(reporter, useResource(1));
+
+    // A burst may use more than the adaptive budget, up to the limit, and raises the budget.
+    addResources(10, 20);
+    cache->didEndFrame();
+    REPORTER_ASSERT(reporter, 23 == cache->getResourceCount());
+    REPORTER_ASSERT(reporter, 33000 == cache->getAdaptiveBudget());
+
+    // The budget never exceeds the limit.
+    addResources(30, 70);
+    cache->didEndFrame();
+    REPORTER_ASSERT(reporter, 100000 == cache->getAdaptiveBudget());
+}
+
 static void test_time_purge(skiatest::Reporter* reporter) {
     Mock mock(1000000);
     auto dContext = mock.dContext();
@@ -1682,6 +1738,7 @@ DEF_GANESH_TEST(ResourceCacheMisc, reporter, /* options */, CtsEnforcement::kApi
     test_cache_chained_purge(reporter);
     test_timestamp_wrap(reporter);
     test_time_purge(reporter);
+    test_adaptive_budget(reporter);
     test_partial_purge(reporter);
     test_custom_data(reporter);
     test_abandoned(reporter);
@@ -13,6 +13,7 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkPathEffect.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
@@ -22,6 +23,7 @@
 #include "include/private/base/SkTo.h"
 #include "include/svg/SkSVGCanvas.h"
 #include "include/utils/SkParse.h"
+#include "include/utils/SkParsePath.h"
 #include "src/shaders/SkImageShader.h"
 #include "src/svg/SkSVGDevice.h"
 #include "src/xml/SkDOM.h"
@@ -667,4 +669,74 @@ DEF_TEST(SVGDevice_parse_minmax, reporter) {
     check(static_cast<int64_t>(std::numeric_limits<int>::min()) - 1, false);
 }
 
+DEF_TEST(SVGDevice_reuse_paths, reporter) {
+    SkDOM dom;
+    {
+        auto svgCanvas = MakeDOMCanvas(&dom, SkSVGCanvas::kReusePaths_Flag);
+        SkPath star;
+        star.moveTo(50, 0);
+        for (int i = 1; i < 10; ++i) {
+            SkScalar r = (i & 1) ? 20 : 50;
+            star.lineTo(50 + r * SkScalarSin(i * SK_ScalarPI / 5),
+                        50 - r * SkScalarCos(i * SK_ScalarPI / 5));
+        }
+        star.close();
+
+        SkPaint paint;
+        for (int i = 0; i < 3; ++i) {
+            svgCanvas->drawPath(star, paint);
+            svgCanvas->translate(10, 0);
+        }
+    }
+
+    const auto* rootElement = dom.finishParsing();
+    REPORTER_ASSERT(reporter, rootElement, "root element not found");
+
+    // The first draw is written directly, and the star is defined when it's drawn again.
+    REPORTER_ASSERT(reporter, dom.countChildren(rootElement, "path") == 1);
+    REPORTER_ASSERT(reporter, dom.countChildren(rootElement, "defs") == 1);
+    REPORTER_ASSERT(reporter, dom.countChildren(rootElement, "use") == 2);
+
+    const auto* defsElement = dom.getFirstChild(rootElement, "defs");
+    const auto* pathDef = dom.getFirstChild(defsElement, "path");
+    REPORTER_ASSERT(reporter, pathDef, "path definition not found");
+    const auto* path = dom.getFirstChild(rootElement, "path");
+    REPORTER_ASSERT(reporter, !strcmp(dom.findAttr(path, "d"), dom.findAttr(pathDef, "d")));
+
+    for (const auto* use = dom.getFirstChild(rootElement, "use"); use;
+         use = dom.getNextSibling(use, "use")) {
+        SkString href = SkStringPrintf("#%s", dom.findAttr(pathDef, "id"));
+        REPORTER_ASSERT(reporter, !strcmp(dom.findAttr(use, "xlink:href"), href.c_str()));
+        REPORTER_ASSERT(reporter, dom.findAttr(use, "transform"));
+    }
+}
+
+DEF_TEST(SVGDevice_stream_output, reporter) {
+    // Enough output to fill the stream writer's buffer several times.
+    SkDynamicMemoryWStream stream;
+    {
+        auto svgCanvas = SkSVGCanvas::Make(SkRect::MakeWH(100, 100), &stream);
+        SkPath path;
+        for (int i = 0; i < 1000; ++i) {
+            path.lineTo(i % 100, i / 10 + 0.25f);
+        }
+        svgCanvas->drawPath(path, SkPaint());
+        svgCanvas->drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    }
+
+    sk_sp<SkData> data = stream.detachAsData();
+    SkDOM dom;
+    const auto* rootElement = dom.build(*SkMemoryStream::Make(data));
+    REPORTER_ASSERT(reporter, rootElement, "could not parse output");
+    REPORTER_ASSERT(reporter, dom.countChildren(rootElement, "path") == 1);
+    REPORTER_ASSERT(reporter, dom.countChildren(rootElement, "rect") == 1);
+
+    SkPath parsed;
+    const auto* pathElement = dom.getFirstChild(rootElement, "path");
+    REPORTER_ASSERT(reporter,
+                    SkParsePath::FromSVGString(dom.findAttr(pathElement, "d"), &parsed));
+    REPORTER_ASSERT(reporter, parsed.countPoints() == 1001);
+    REPORTER_ASSERT(reporter, parsed.getPoint(1000) == SkPoint::Make(99, 99.25f));
+}
+
 #endif
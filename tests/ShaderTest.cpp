@@ -11,6 +11,7 @@
 #include "include/core/SkBlender.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkColorFilter.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImage.h"
@@ -34,6 +35,7 @@
 #include "tests/Test.h"
 
 #include <cmath>
+#include <thread>
 #include <vector>
 
 #if defined(SK_GANESH) || defined(SK_GRAPHITE)
@@ -209,3 +211,44 @@ DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(ShaderTestNestedBlendsGraphite, reporte
     test_nested_blends(reporter, surface.get());
 }
 #endif
+
+// Effects may be freed on a different thread than the one that made them, which matters when they
+// come from per-thread pools (SK_POOL_FLATTENABLES).
+DEF_TEST(Shader_FreedOnOtherThread, reporter) {
+    constexpr int kCount = 1000;
+    std::vector<sk_sp<SkShader>> shaders;
+    std::vector<sk_sp<SkColorFilter>> filters;
+    for (int round = 0; round < 4; ++round) {
+        std::thread maker([&] {
+            for (int i = 0; i < kCount; ++i) {
+                shaders.push_back(SkShaders::Color(SkColorSetARGB(0xFF, i, round, 0)));
+                filters.push_back(SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kSrcIn));
+            }
+        });
+        maker.join();
+
+        std::thread dropper([&] {
+            for (int i = 0; i < kCount; i += 2) {
+                shaders[i].reset();
+                filters[i].reset();
+            }
+        });
+        dropper.join();
+
+        for (int i = 1; i < kCount; i += 2) {
+            SkBlendMode mode;
+            REPORTER_ASSERT(reporter, shaders[i]->isOpaque());
+            REPORTER_ASSERT(reporter, filters[i]->asAColorMode(nullptr, &mode) &&
+                                      mode == SkBlendMode::kSrcIn);
+        }
+        shaders.clear();
+        filters.clear();
+    }
+
+#if defined(SK_POOL_FLATTENABLES)
+    // A freed effect's memory is reused by the next effect of the same size on this thread.
+    const void* first = SkShaders::Color(SK_ColorBLUE).get();
+    sk_sp<SkShader> second = SkShaders::Color(SK_ColorGREEN);
+    REPORTER_ASSERT(reporter, second.get() == first);
+#endif
+}
@@ -5,7 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPoint.h"
@@ -14,6 +17,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
 #include "include/core/SkVertices.h"
 #include "include/private/base/SkTo.h"
@@ -23,6 +27,8 @@
 #include "src/utils/SkShadowTessellator.h"
 #include "tests/Test.h"
 
+#include <cstring>
+
 #if !defined(SK_ENABLE_OPTIMIZE_SIZE)
 
 enum ExpectVerts {
@@ -219,4 +225,78 @@ DEF_TEST(ShadowBounds, reporter) {
     check_bounds(reporter, path);
 }
 
+DEF_TEST(ShadowUtils_DrawShadows, reporter) {
+    SkPath concave;
+    concave.moveTo(20, 120).lineTo(90, 120).lineTo(55, 150).lineTo(90, 180).lineTo(20, 180).close();
+    const SkPath paths[] = {
+        SkPath::RRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(20, 20, 90, 70), 8, 8)),
+        SkPath::Circle(150, 50, 30),
+        concave,
+    };
+    const SkPoint3 zPlaneParams[] = {{0, 0, 4}, {0, 0, 8}, {0, 0, 12}};
+    const SkPoint3 lightPos = {100, 0, 600};
+    constexpr SkScalar kLightRadius = 800;
+    constexpr SkColor kAmbient = 0x40000000, kSpot = 0x80000000;
+
+    auto info = SkImageInfo::MakeN32Premul(200, 200);
+    auto expected = SkSurfaces::Raster(info);
+    auto actual = SkSurfaces::Raster(info);
+    for (SkCanvas* canvas : {expected->getCanvas(), actual->getCanvas()}) {
+        canvas->clear(SK_ColorWHITE);
+        canvas->translate(3, 5);
+        canvas->scale(0.9f, 0.9f);
+    }
+    for (int i = 0; i < 3; ++i) {
+        SkShadowUtils::DrawShadow(expected->getCanvas(), paths[i], zPlaneParams[i], lightPos,
+                                  kLightRadius, kAmbient, kSpot);
+    }
+    SkShadowUtils::DrawShadows(actual->getCanvas(), paths, zPlaneParams, 3, lightPos,
+                               kLightRadius, kAmbient, kSpot);
+
+    SkBitmap expectedBM, actualBM;
+    expectedBM.allocPixels(info);
+    actualBM.allocPixels(info);
+    REPORTER_ASSERT(reporter, expected->readPixels(expectedBM, 0, 0));
+    REPORTER_ASSERT(reporter, actual->readPixels(actualBM, 0, 0));
+    bool drewShadow = false;
+    for (int y = 0; y < info.height() && !drewShadow; ++y) {
+        for (int x = 0; x < info.width() && !drewShadow; ++x) {
+            drewShadow = expectedBM.getColor(x, y) != SK_ColorWHITE;
+        }
+    }
+    REPORTER_ASSERT(reporter, drewShadow);
+    REPORTER_ASSERT(reporter, !memcmp(expectedBM.getPixels(), actualBM.getPixels(),
+                                      expectedBM.computeByteSize()));
+}
+
+DEF_TEST(ShadowUtils_RRectShadows, reporter) {
+    SkDrawShadowRec rec = {{0, 0, 8}, {100, 0, 600}, 800, 0x40000000, 0x80000000, 0};
+    SkDrawShadowMetrics::RRectShadow ambient, spot;
+    SkPath rrect = SkPath::RRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(20, 20, 90, 70), 8, 8));
+    REPORTER_ASSERT(reporter, SkDrawShadowMetrics::GetRRectShadows(rrect, rec, SkMatrix::I(),
+                                                                   &ambient, &spot));
+    // Both shadows extend past the occluder, and the spot shadow is offset away from the light.
+    REPORTER_ASSERT(reporter, ambient.fRRect.rect().contains(rrect.getBounds()));
+    REPORTER_ASSERT(reporter, spot.fRRect.rect().centerX() < rrect.getBounds().centerX());
+    REPORTER_ASSERT(reporter, ambient.fBlurWidth > 0 && spot.fBlurWidth > 0);
+
+    // A transparent color skips that shadow.
+    SkDrawShadowRec noSpot = rec;
+    noSpot.fSpotColor = SK_ColorTRANSPARENT;
+    REPORTER_ASSERT(reporter, SkDrawShadowMetrics::GetRRectShadows(rrect, noSpot, SkMatrix::I(),
+                                                                   &ambient, &spot));
+    REPORTER_ASSERT(reporter, !ambient.fRRect.isEmpty() && spot.fRRect.isEmpty());
+
+    // Tilted occluders, skewed matrices and other paths need the general shadow code.
+    SkDrawShadowRec tilted = rec;
+    tilted.fZPlaneParams = {0.1f, 0, 8};
+    REPORTER_ASSERT(reporter, !SkDrawShadowMetrics::GetRRectShadows(rrect, tilted, SkMatrix::I(),
+                                                                    &ambient, &spot));
+    REPORTER_ASSERT(reporter, !SkDrawShadowMetrics::GetRRectShadows(
+                                      rrect, rec, SkMatrix::Skew(0.5f, 0), &ambient, &spot));
+    SkPath triangle = SkPath::Polygon({{0, 0}, {50, 0}, {0, 50}}, /*isClosed=*/true);
+    REPORTER_ASSERT(reporter, !SkDrawShadowMetrics::GetRRectShadows(triangle, rec, SkMatrix::I(),
+                                                                    &ambient, &spot));
+}
+
 #endif // !defined(SK_ENABLE_OPTIMIZE_SIZE)
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "src/core/SkTaskGroup.h"
+#include "tests/Test.h"
+
+#include <atomic>
+#include <memory>
+
+static void test_executor(skiatest::Reporter* r, SkExecutor& executor) {
+    // Flat batch from outside the pool.
+    {
+        std::atomic<int> sum{0};
+        SkTaskGroup tasks(executor);
+        tasks.batch(1000, [&](int i) { sum.fetch_add(i, std::memory_order_relaxed); });
+        tasks.wait();
+        REPORTER_ASSERT(r, sum.load() == 999 * 1000 / 2);
+    }
+
+    // Nested batches: each task waits on a group of its own, which only finishes if waiting
+    // threads (including pool threads) can borrow queued work.
+    {
+        std::atomic<int> count{0};
+        SkTaskGroup outer(executor);
+        outer.batch(16, [&](int) {
+            SkTaskGroup inner(executor);
+            inner.batch(64, [&](int) {
+                SkTaskGroup innermost(executor);
+                innermost.batch(4, [&](int) { count.fetch_add(1, std::memory_order_relaxed); });
+                innermost.wait();
+            });
+            inner.wait();
+        });
+        outer.wait();
+        REPORTER_ASSERT(r, count.load() == 16 * 64 * 4);
+    }
+}
+
+DEF_TEST(SkExecutor_ThreadPools, r) {
+    for (int threads : {1, 2, 4, 8}) {
+        test_executor(r, *SkExecutor::MakeFIFOThreadPool(threads));
+        test_executor(r, *SkExecutor::MakeLIFOThreadPool(threads));
+        test_executor(r, *SkExecutor::MakeWorkStealingThreadPool(threads));
+    }
+}
+
+DEF_TEST(SkExecutor_WorkStealingShutdown, r) {
+    // Destroying the pool with work still queued must neither hang nor leak.
+    for (int i = 0; i < 20; i++) {
+        std::atomic<int> ran{0};
+        {
+            std::unique_ptr<SkExecutor> owner = SkExecutor::MakeWorkStealingThreadPool(4);
+            SkExecutor* pool = owner.get();
+            for (int j = 0; j < 100; j++) {
+                pool->add([&ran, pool] {
+                    ran.fetch_add(1, std::memory_order_relaxed);
+                    for (int k = 0; k < 8; k++) {
+                        pool->add([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+                    }
+                });
+            }
+        }
+        REPORTER_ASSERT(r, ran.load() <= 100 * 9);
+    }
+}
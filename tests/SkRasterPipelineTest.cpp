@@ -5,8 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "include/private/base/SkFloatingPoint.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkHalf.h"
+#include "src/base/SkMathPriv.h"
 #include "src/base/SkUtils.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
@@ -15,8 +17,10 @@
 #include "src/sksl/tracing/SkSLTraceHook.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <vector>
 
 using namespace skia_private;
 
@@ -3269,6 +3273,110 @@ DEF_TEST(SkRasterPipeline_lowp, r) {
     }
 }
 
+extern bool gForceHighPrecisionRasterPipeline;
+extern bool gAllowMediumpRasterPipeline;
+
+DEF_TEST(SkRasterPipeline_mediump, r) {
+    // When allowed, F16 blends with coverage can run in half floats (on CPUs with FEAT_FP16).
+    // Either way, these inputs should match the highp results to within a few half-float ulps.
+    static constexpr int kW = 37;  // Leaves a tail for both 4- and 8-wide stages.
+    SkHalf src[4*kW], dst[4*kW], want[4*kW];
+    uint8_t coverage[kW];
+    for (int i = 0; i < kW; i++) {
+        float a = (i % 8) / 7.0f;
+        for (int c = 0; c < 4; c++) {
+            src[4*i+c] = SkFloatToHalf(c == 3 ? a : a * ((i + c) % 5) / 4.0f);
+            dst[4*i+c] = SkFloatToHalf(c == 3 ? 1.0f : ((i * 3 + c) % 7) / 6.0f);
+        }
+        coverage[i] = SkTo<uint8_t>(i * 7);
+    }
+    memcpy(want, dst, sizeof(dst));
+
+    auto blend = [&](SkHalf* d) {
+        SkRasterPipeline_MemoryCtx srcCtx = {src, 0},
+                                   dstCtx = {d, 0},
+                                   covCtx = {coverage, 0};
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipelineOp::load_f16, &srcCtx);
+        p.append(SkRasterPipelineOp::load_f16_dst, &dstCtx);
+        p.append(SkRasterPipelineOp::srcover);
+        p.append(SkRasterPipelineOp::lerp_u8, &covCtx);
+        p.append(SkRasterPipelineOp::store_f16, &dstCtx);
+        p.run(0,0,kW,1);
+    };
+
+    gForceHighPrecisionRasterPipeline = true;
+    blend(want);
+    gForceHighPrecisionRasterPipeline = false;
+    gAllowMediumpRasterPipeline = true;
+    blend(dst);
+    gAllowMediumpRasterPipeline = false;
+
+    for (int i = 0; i < 4*kW; i++) {
+        float got = SkHalfToFloat(dst[i]),
+              exp = SkHalfToFloat(want[i]);
+        if (std::fabs(got - exp) > 2/1024.0f) {
+            ERRORF(r, "pixel %d channel %d: got %g, want %g\n", i/4, i%4, got, exp);
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_GradientManyStops, r) {
+    // Past 16 stops the gradient stage binary searches for t's interval instead of counting the
+    // stops <= t. Either way it must pick the same interval, including t exactly on a stop and at
+    // repeated (hard) stops. Each interval's color is its index, so the stored red is the index.
+    static constexpr int kW = 80;  // t runs 0.5, 1.5, ... 79.5, past every stop below.
+    for (int stopCount : {16, 17, 18, 31, 32, 33, 64, 65}) {
+        for (bool repeats : {false, true}) {
+            const int tsCount = std::max(stopCount, 2 * SkPrevPow2(stopCount - 1));
+            std::vector<float> ts(tsCount, SK_FloatNaN), zero(stopCount, 0.f),
+                               index(stopCount);
+            for (int i = 1; i < stopCount; ++i) {
+                // Stops every half pixel, so t lands on every other one. With repeats, every
+                // stop is on a pixel center and comes in a run of three.
+                ts[i] = 0.5f * (repeats ? 1 + 2 * (i / 3) : i);
+            }
+            for (int i = 0; i < stopCount; ++i) {
+                index[i] = i / 255.f;
+            }
+
+            SkRasterPipeline_GradientCtx ctx;
+            ctx.stopCount = stopCount;
+            for (int c = 0; c < 4; ++c) {
+                ctx.fs[c] = zero.data();
+                ctx.bs[c] = index.data();
+            }
+            ctx.ts = ts.data();
+
+            for (bool highp : {false, true}) {
+                uint32_t rgba[kW] = {};
+                SkRasterPipeline_MemoryCtx ptr = {rgba, 0};
+
+                SkRasterPipeline_<256> p;
+                p.append(SkRasterPipelineOp::seed_shader);
+                p.append(SkRasterPipelineOp::gradient, &ctx);
+                p.append(SkRasterPipelineOp::store_8888, &ptr);
+                gForceHighPrecisionRasterPipeline = highp;
+                p.run(0,0,kW,1);
+                gForceHighPrecisionRasterPipeline = false;
+
+                for (int x = 0; x < kW; ++x) {
+                    const float t = x + 0.5f;
+                    uint32_t want = 0;
+                    for (int i = 1; i < stopCount; ++i) {
+                        want += t >= ts[i];
+                    }
+                    if ((rgba[x] & 0xff) != want) {
+                        ERRORF(r, "%d stops%s (%s), t=%g: got interval %u, want %u\n",
+                               stopCount, repeats ? " with repeats" : "",
+                               highp ? "highp" : "lowp", t, rgba[x] & 0xff, want);
+                    }
+                }
+            }
+        }
+    }
+}
+
 DEF_TEST(SkRasterPipeline_swizzle, r) {
     // This takes the lowp code path
     {
@@ -14,6 +14,7 @@
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
@@ -165,6 +166,26 @@ DEF_TEST(SkRuntimeEffectCanEnableVersion300, r) {
     test_valid         (r, "#version 300\nfloat f[2] = float[2](0, 1);" EMPTY_MAIN);
 }
 
+DEF_TEST(SkRuntimeEffectCache, r) {
+    const SkString sksl("half4 main(float2 p) { return half4(p.xy01); }");
+    sk_sp<SkRuntimeEffect> effect = SkRuntimeEffect::MakeForShader(sksl).effect;
+    REPORTER_ASSERT(r, effect);
+
+    // The same SkSL and options returns the same effect...
+    REPORTER_ASSERT(r, SkRuntimeEffect::MakeForShader(sksl).effect == effect);
+    REPORTER_ASSERT(r, SkGraphics::GetRuntimeEffectCacheCountUsed() > 0);
+
+    // ... but different options compile a new one.
+    SkRuntimeEffect::Options opt = SkRuntimeEffectPriv::ES3Options();
+    REPORTER_ASSERT(r, SkRuntimeEffect::MakeForShader(sksl, opt).effect != effect);
+
+    // Without a cache, every compile produces a new effect.
+    const int limit = SkGraphics::SetRuntimeEffectCacheCountLimit(0);
+    REPORTER_ASSERT(r, SkGraphics::GetRuntimeEffectCacheCountUsed() == 0);
+    REPORTER_ASSERT(r, SkRuntimeEffect::MakeForShader(sksl).effect != effect);
+    REPORTER_ASSERT(r, SkGraphics::SetRuntimeEffectCacheCountLimit(limit) == 0);
+}
+
 DEF_TEST(SkRuntimeEffectUniformFlags, r) {
     auto [effect, errorText] = SkRuntimeEffect::MakeForShader(SkString(R"(
         uniform int simple;                      // should have no flags
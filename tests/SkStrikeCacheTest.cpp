@@ -5,21 +5,37 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
+#include "include/core/SkGlyphPersistentCache.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkSemaphore.h"
+#include "src/core/SkGlyph.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrike.h"  // IWYU pragma: keep
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
 DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
     SkStrikeCache cache;
 
@@ -61,3 +77,247 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
 
 
 }
+
+DEF_TEST(SkStrikeCache_Stats, Reporter) {
+    SkStrikeCache cache;
+
+    SkFont font = ToolUtils::DefaultPortableFont();
+    font.setSize(37);
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    // The counters are process-wide and other tests may be counting too, so only check that they
+    // went up by at least the work done here.
+    const SkGraphics::Stats before = SkGraphics::GetStats();
+    sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+    strike = strikeSpec.findOrCreateStrike(&cache);
+    const SkGraphics::Stats diff = SkGraphics::GetStats() - before;
+
+    REPORTER_ASSERT(Reporter, diff.fStrikeCacheMisses >= 1);
+    REPORTER_ASSERT(Reporter, diff.fStrikeCacheHits >= 1);
+}
+
+DEF_TEST(SkStrikeCache_ConcurrentBudget, Reporter) {
+    SkStrikeCache cache;
+    constexpr int kCountLimit = 8;
+    cache.setCacheCountLimit(kCountLimit);
+
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Italic());
+
+    // Strikes of many sizes land in different shards; the budget applies across all of them.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkTaskGroup tasks(*executor);
+    tasks.batch(64, [&](int i) {
+        SkFont font(typeface, 8 + i);
+        font.setEdging(SkFont::Edging::kAntiAlias);
+
+        SkPaint defaultPaint;
+        SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        REPORTER_ASSERT(Reporter, strike->getDescriptor() == strikeSpec.descriptor());
+    });
+    tasks.wait();
+
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() <= kCountLimit);
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() > 0);
+
+    cache.purgeAll();
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
+}
+
+DEF_TEST(SkStrikeCache_ParallelGlyphImages, Reporter) {
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Italic());
+
+    SkFont font(typeface, 24);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSubpixel(true);
+
+    // Repeat some glyphs, with and without subpixel offsets, to check that each image is only
+    // rasterized once.
+    std::vector<SkPackedGlyphID> packedIDs;
+    for (int c = ' '; c < 'z'; c++) {
+        const SkGlyphID glyphID = font.unicharToGlyph(c);
+        packedIDs.push_back(SkPackedGlyphID{glyphID});
+        packedIDs.push_back(SkPackedGlyphID{glyphID, {0.5f, 0}, {1, 0}});
+        packedIDs.push_back(SkPackedGlyphID{glyphID});
+    }
+
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    SkStrikeCache serialCache;
+    std::vector<const SkGlyph*> serialGlyphs(packedIDs.size());
+    sk_sp<SkStrike> serialStrike = strikeSpec.findOrCreateStrike(&serialCache);
+    serialStrike->prepareImages(packedIDs, serialGlyphs.data());
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkStrikeCache parallelCache;
+    parallelCache.setGlyphRasterExecutor(executor.get());
+    std::vector<const SkGlyph*> parallelGlyphs(packedIDs.size());
+    sk_sp<SkStrike> parallelStrike = strikeSpec.findOrCreateStrike(&parallelCache);
+    parallelStrike->prepareImages(packedIDs, parallelGlyphs.data());
+
+    for (size_t i = 0; i < packedIDs.size(); ++i) {
+        const SkGlyph* serial = serialGlyphs[i];
+        const SkGlyph* parallel = parallelGlyphs[i];
+        REPORTER_ASSERT(Reporter, serial->getPackedID() == parallel->getPackedID());
+        REPORTER_ASSERT(Reporter, serial->iRect() == parallel->iRect());
+        if (serial->image() == nullptr || parallel->image() == nullptr) {
+            REPORTER_ASSERT(Reporter, serial->image() == parallel->image());
+            continue;
+        }
+        REPORTER_ASSERT(Reporter, serial->imageSize() == parallel->imageSize());
+        REPORTER_ASSERT(Reporter,
+                        0 == memcmp(serial->image(), parallel->image(), serial->imageSize()));
+    }
+
+    serialStrike.reset();
+    parallelStrike.reset();
+    REPORTER_ASSERT(Reporter,
+                    serialCache.getTotalMemoryUsed() == parallelCache.getTotalMemoryUsed());
+}
+
+namespace {
+class MemoryPersistentCache final : public SkGlyphPersistentCache {
+public:
+    sk_sp<SkData> load(const SkData& key) override {
+        SkAutoMutexExclusive lock{fMutex};
+        fLoads++;
+        for (const auto& [storedKey, data] : fEntries) {
+            if (storedKey->equals(&key)) {
+                return data;
+            }
+        }
+        return nullptr;
+    }
+
+    void store(const SkData& key, const SkData& data) override {
+        SkAutoMutexExclusive lock{fMutex};
+        fStores++;
+        fStoreThread = std::this_thread::get_id();
+        for (auto& [storedKey, storedData] : fEntries) {
+            if (storedKey->equals(&key)) {
+                storedData = SkData::MakeWithCopy(data.data(), data.size());
+                return;
+            }
+        }
+        fEntries.emplace_back(SkData::MakeWithCopy(key.data(), key.size()),
+                              SkData::MakeWithCopy(data.data(), data.size()));
+    }
+
+    SkMutex fMutex;
+    std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> fEntries;
+    int fLoads = 0;
+    int fStores = 0;
+    std::thread::id fStoreThread;
+};
+
+void check_persistent_cache(skiatest::Reporter* reporter,
+                            SkGlyphPersistentCache* persistent,
+                            SkExecutor* storeExecutor = nullptr) {
+    sk_sp<SkTypeface> typeface =
+            ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Italic());
+    SkFont font(typeface, 24);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+
+    std::vector<SkPackedGlyphID> packedIDs;
+    for (int c = ' '; c < 'z'; c++) {
+        packedIDs.push_back(SkPackedGlyphID{font.unicharToGlyph(c)});
+    }
+
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    // Rasterize the glyphs, and store them when the strike is purged.
+    std::vector<const SkGlyph*> firstGlyphs(packedIDs.size());
+    std::vector<std::vector<uint8_t>> firstImages;
+    {
+        SkStrikeCache cache;
+        cache.setPersistentCache(persistent, storeExecutor);
+        sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+        strike->prepareImages(packedIDs, firstGlyphs.data());
+        for (const SkGlyph* glyph : firstGlyphs) {
+            auto image = static_cast<const uint8_t*>(glyph->image());
+            firstImages.emplace_back(image, image + (image ? glyph->imageSize() : 0));
+        }
+        strike.reset();
+        cache.purgeAll();
+        if (storeExecutor) {
+            // Wait for the store of the purged strike.
+            SkSemaphore stored;
+            storeExecutor->add([&stored] { stored.signal(); });
+            stored.wait();
+        }
+    }
+
+    // A new cache starts the strike with the stored glyphs, so nothing new is rasterized.
+    SkStrikeCache cache;
+    cache.setPersistentCache(persistent);
+    sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+    std::vector<const SkGlyph*> glyphs(packedIDs.size());
+    strike->prepareImages(packedIDs, glyphs.data());
+    REPORTER_ASSERT(reporter, strike->serializeForPersistentCache() == nullptr);
+
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        REPORTER_ASSERT(reporter, glyphs[i]->getPackedID() == firstGlyphs[i]->getPackedID());
+        REPORTER_ASSERT(reporter, glyphs[i]->iRect() == firstGlyphs[i]->iRect());
+        REPORTER_ASSERT(reporter, glyphs[i]->advanceX() == firstGlyphs[i]->advanceX());
+        auto image = static_cast<const uint8_t*>(glyphs[i]->image());
+        REPORTER_ASSERT(reporter,
+                        std::vector<uint8_t>(image, image + (image ? glyphs[i]->imageSize() : 0))
+                                == firstImages[i]);
+    }
+
+    // A glyph made by the scaler context is stored again.
+    const SkPackedGlyphID extraID{font.unicharToGlyph('z')};
+    const SkGlyph* extraGlyph;
+    strike->prepareImages({&extraID, 1}, &extraGlyph);
+    REPORTER_ASSERT(reporter, strike->serializeForPersistentCache() != nullptr);
+}
+}  // namespace
+
+DEF_TEST(SkStrikeCache_PersistentCache, Reporter) {
+    MemoryPersistentCache persistent;
+    check_persistent_cache(Reporter, &persistent);
+    REPORTER_ASSERT(Reporter, persistent.fStores == 1);
+    REPORTER_ASSERT(Reporter, persistent.fLoads == 2);
+}
+
+DEF_TEST(SkStrikeCache_PersistentCacheStoreExecutor, Reporter) {
+    MemoryPersistentCache persistent;
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+    check_persistent_cache(Reporter, &persistent, executor.get());
+    REPORTER_ASSERT(Reporter, persistent.fStores == 1);
+    REPORTER_ASSERT(Reporter, persistent.fLoads == 2);
+    REPORTER_ASSERT(Reporter, persistent.fStoreThread != std::this_thread::get_id());
+}
+
+DEF_TEST(SkStrikeCache_DirectoryPersistentCache, Reporter) {
+    SkString directory = skiatest::GetTmpDir();
+    if (directory.isEmpty()) {
+        return;
+    }
+    directory.append("/SkStrikeCache_DirectoryPersistentCache");
+    std::unique_ptr<SkGlyphPersistentCache> persistent =
+            SkGlyphPersistentCache::MakeDirectoryCache(directory.c_str());
+    REPORTER_ASSERT(Reporter, persistent != nullptr);
+
+    sk_sp<SkData> key = SkData::MakeWithCString("key");
+    sk_sp<SkData> data = SkData::MakeWithCString("glyphs");
+    persistent->store(*key, *data);
+    sk_sp<SkData> loaded = persistent->load(*key);
+    REPORTER_ASSERT(Reporter, loaded && loaded->equals(data.get()));
+    REPORTER_ASSERT(Reporter, persistent->load(*SkData::MakeWithCString("other")) == nullptr);
+
+    check_persistent_cache(Reporter, persistent.get());
+}
@@ -9,6 +9,7 @@
 #include "src/base/SkTSort.h"
 #include "tests/Test.h"
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <string>
@@ -60,6 +61,35 @@ DEF_TEST(Sort, reporter) {
         memcpy(workingArray, randomArray, sizeof(randomArray));
         SkTQSort<int>(workingArray, workingArray + count);
         check_sort(reporter, "Quick", workingArray, sortedArray, count);
+
+        int scratch[std::size(randomArray)];
+        memcpy(workingArray, randomArray, sizeof(randomArray));
+        SkTRadixSort(workingArray, scratch, count, [](int x) { return x; });
+        check_sort(reporter, "Radix", workingArray, sortedArray, count);
+    }
+}
+
+DEF_TEST(Sort_RadixStable, reporter) {
+    struct Item {
+        int32_t fKey;
+        int fIndex;
+    };
+    Item items[1000];
+    Item scratch[std::size(items)];
+    SkRandom rand;
+
+    // Keys from the whole int32_t range, and from a small range so that many of them are equal.
+    for (int shift : {0, 24}) {
+        for (int i = 0; i < (int)std::size(items); ++i) {
+            items[i] = {rand.nextS() >> shift, i};
+        }
+        SkTRadixSort(items, scratch, std::size(items), [](const Item& item) { return item.fKey; });
+        for (int i = 1; i < (int)std::size(items); ++i) {
+            REPORTER_ASSERT(reporter, items[i - 1].fKey <= items[i].fKey);
+            if (items[i - 1].fKey == items[i].fKey) {
+                REPORTER_ASSERT(reporter, items[i - 1].fIndex < items[i].fIndex);
+            }
+        }
     }
 }
 
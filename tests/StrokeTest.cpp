@@ -186,9 +186,42 @@ static void test_big_stroke(skiatest::Reporter* reporter) {
     skpathutils::FillPathWithPaint(path, paint, &strokeAndFillPath);
 }
 
+// Stroking a path again is served from the cache, and must match stroking it the first time.
+static void test_cached_stroke(skiatest::Reporter* reporter) {
+    SkPath path;
+    path.moveTo(10, 10);
+    for (int i = 0; i < 4; ++i) {
+        path.cubicTo(20 + i * 30, 0, 30 + i * 30, 40, 40 + i * 30, 10);
+        path.lineTo(40 + i * 30, 20);
+    }
+
+    SkStrokeRec rec(SkStrokeRec::kHairline_InitStyle);
+    rec.setStrokeStyle(5, false);
+    rec.setStrokeParams(SkPaint::kRound_Cap, SkPaint::kRound_Join, 4);
+
+    SkPath first, second;
+    REPORTER_ASSERT(reporter, rec.applyToPath(&first, path));
+    REPORTER_ASSERT(reporter, rec.applyToPath(&second, path));
+    REPORTER_ASSERT(reporter, first == second);
+
+    // A different stroke of the same path doesn't reuse the first one.
+    rec.setStrokeStyle(7, false);
+    SkPath wider;
+    REPORTER_ASSERT(reporter, rec.applyToPath(&wider, path));
+    REPORTER_ASSERT(reporter, wider != first);
+
+    // Neither does the same stroke of an edited path.
+    path.lineTo(200, 50);
+    rec.setStrokeStyle(5, false);
+    SkPath edited;
+    REPORTER_ASSERT(reporter, rec.applyToPath(&edited, path));
+    REPORTER_ASSERT(reporter, edited != first);
+}
+
 DEF_TEST(Stroke, reporter) {
     test_strokecubic(reporter);
     test_strokerect(reporter);
     test_strokerec_equality(reporter);
     test_big_stroke(reporter);
+    test_cached_stroke(reporter);
 }
@@ -151,6 +151,53 @@ DEF_TEST(SwizzleOpts, r) {
     REPORTER_ASSERT(r, dst == 0xFA04ADCA);
 }
 
+DEF_TEST(SwizzleOpts_16BitGrayIndex, r) {
+    // Long enough to exercise the vector loops and leave a tail.
+    constexpr int N = 37;
+    uint8_t src[8*N];
+    for (int i = 0; i < 8*N; i++) {
+        src[i] = (uint8_t)(i*37 + 11);
+    }
+    uint32_t table[256];
+    for (int i = 0; i < 256; i++) {
+        table[i] = 0x01010101u * (uint32_t)(255 - i) ^ (uint32_t)i;
+    }
+
+    uint32_t dst[N];
+    SkOpts::RGB16_to_RGB1(dst, src, N);
+    for (int i = 0; i < N; i++) {
+        const uint8_t* p = src + 6*i;
+        REPORTER_ASSERT(r, dst[i] == (0xFF000000u | p[4] << 16 | p[2] << 8 | p[0]));
+    }
+    SkOpts::RGBA16_to_BGRA(dst, src, N);
+    for (int i = 0; i < N; i++) {
+        const uint8_t* p = src + 8*i;
+        REPORTER_ASSERT(r, dst[i] == ((uint32_t)p[6] << 24 | p[0] << 16 | p[2] << 8 | p[4]));
+    }
+    uint32_t expected[N];
+    SkOpts::RGBA16_to_RGBA(expected, src, N);
+    SkOpts::RGBA_to_rgbA(expected, expected, N);
+    SkOpts::RGBA16_to_rgbA(dst, src, N);
+    REPORTER_ASSERT(r, !memcmp(dst, expected, sizeof(dst)));
+
+    SkOpts::index_to_8888(dst, src, N, table);
+    for (int i = 0; i < N; i++) {
+        REPORTER_ASSERT(r, dst[i] == table[src[i]]);
+    }
+
+    uint16_t dst565[N];
+    SkOpts::gray_to_565(dst565, src, N);
+    for (int i = 0; i < N; i++) {
+        REPORTER_ASSERT(r, dst565[i] == SkPack888ToRGB16(src[i], src[i], src[i]));
+    }
+
+    uint8_t dstA8[N];
+    SkOpts::grayA_to_A8(dstA8, src, N);
+    for (int i = 0; i < N; i++) {
+        REPORTER_ASSERT(r, dstA8[i] == src[2*i + 1]);
+    }
+}
+
 DEF_TEST(PublicSwizzleOpts, r) {
     uint32_t dst, src;
 
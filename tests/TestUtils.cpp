@@ -34,6 +34,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <iterator>
 #include <utility>
 
 void TestReadPixels(skiatest::Reporter* reporter,
@@ -308,3 +309,32 @@ DEF_TEST(chartoglyph_cache, reporter) {
         }
     }
 }
+
+DEF_TEST(chartoglyph_cache_bulk, reporter) {
+    SkCharToGlyphCache cache;
+
+    // BMP unichars, one of them mapping to the largest glyphID, and a few supplementary ones.
+    const SkUnichar chars[] = {'a', 'b', 0x4E00, 0xFFFF, 0x1F600, 0x10FFFF};
+    const SkGlyphID expected[] = {1, 2, 3, 0xFFFF, 5, 6};
+    for (size_t i = 0; i < std::size(chars); ++i) {
+        int index = cache.findGlyphIndex(chars[i]);
+        REPORTER_ASSERT(reporter, index < 0);
+        cache.insertCharAndGlyph(~index, chars[i], expected[i]);
+    }
+    REPORTER_ASSERT(reporter, cache.count() == (int)std::size(chars));
+
+    SkGlyphID glyphs[std::size(chars)];
+    REPORTER_ASSERT(reporter, cache.findGlyphs(chars, std::size(chars), glyphs) ==
+                              (int)std::size(chars));
+    for (size_t i = 0; i < std::size(chars); ++i) {
+        REPORTER_ASSERT(reporter, glyphs[i] == expected[i]);
+    }
+
+    // The lookup stops at the first unichar which isn't cached.
+    const SkUnichar partial[] = {'a', 'c', 'b'};
+    REPORTER_ASSERT(reporter, cache.findGlyphs(partial, std::size(partial), glyphs) == 1);
+
+    cache.reset();
+    REPORTER_ASSERT(reporter, cache.count() == 0);
+    REPORTER_ASSERT(reporter, cache.findGlyphIndex('a') < 0);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/utils/SkTiledImage.h"
+#include "tests/Test.h"
+#include "tools/Resources.h"
+#include "tools/ToolUtils.h"
+
+#include <memory>
+
+DEF_TEST(TiledImage_DecodesVisibleTiles, reporter) {
+    const char* kPath = "images/mandrill_512.png";
+    sk_sp<SkData> data = GetResourceAsData(kPath);
+    if (!data) {
+        return;
+    }
+    sk_sp<SkImage> expected = SkImages::DeferredFromEncodedData(data);
+    REPORTER_ASSERT(reporter, expected);
+    if (!expected) {
+        return;
+    }
+    expected = expected->makeRasterImage();
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+    SkTiledImage::Options options;
+    options.fTileSize = 128;
+    options.fMaxResidentTiles = 4;
+    options.fPlaceholderSize = 64;
+    options.fExecutor = executor.get();
+    auto tiled = SkTiledImage::Make(SkCodec::MakeFromData(data), options);
+    REPORTER_ASSERT(reporter, tiled);
+    if (!tiled) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, tiled->dimensions() == expected->dimensions());
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32Premul(expected->width(), expected->height()));
+    const SkRect dst = SkRect::Make(expected->dimensions());
+
+    // Nothing is decoded before the first draw, so it can't be complete. The clip touches the
+    // top left 2x2 tiles.
+    SkCanvas canvas(bitmap);
+    canvas.clipRect(SkRect::MakeWH(250, 250));
+    REPORTER_ASSERT(reporter, !tiled->draw(&canvas, dst));
+    tiled->waitForPendingDecodes();
+    REPORTER_ASSERT(reporter, tiled->residentTileCount() == 4);
+
+    // The decoded tiles match a full decode.
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+    REPORTER_ASSERT(reporter, tiled->draw(&canvas, dst));
+    SkPixmap decoded, actual, want;
+    REPORTER_ASSERT(reporter, bitmap.pixmap().extractSubset(&actual, SkIRect::MakeWH(250, 250)));
+    REPORTER_ASSERT(reporter, expected->peekPixels(&decoded));
+    REPORTER_ASSERT(reporter, decoded.extractSubset(&want, SkIRect::MakeWH(250, 250)));
+    REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(actual, want));
+
+    // Drawing another tile evicts the least recently used one.
+    SkCanvas other(bitmap);
+    other.clipRect(SkRect::MakeXYWH(260, 260, 120, 120));
+    REPORTER_ASSERT(reporter, !tiled->draw(&other, dst));
+    tiled->waitForPendingDecodes();
+    REPORTER_ASSERT(reporter, tiled->residentTileCount() == 4);
+    REPORTER_ASSERT(reporter, tiled->draw(&other, dst));
+}
@@ -9,6 +9,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
@@ -52,12 +53,14 @@
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <initializer_list>
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -1361,6 +1364,129 @@ static void test_crbug_1262444(skiatest::Reporter* r) {
     REPORTER_ASSERT(r, vertexCount == 0);
 }
 
+static double triangle_area(const SkPoint* verts, int vertexCount) {
+    double area = 0;
+    for (int i = 0; i + 2 < vertexCount; i += 3) {
+        area += std::abs(SkPoint::CrossProduct(verts[i + 1] - verts[i], verts[i + 2] - verts[i]));
+    }
+    return area / 2;
+}
+
+// Returns the first vertex of each triangle that reaches into [top, bottom] in Y.
+static std::vector<int> triangles_in_span(const SkPoint* verts, int vertexCount, float top,
+                                          float bottom) {
+    std::vector<int> triangles;
+    for (int i = 0; i + 2 < vertexCount; i += 3) {
+        float minY = std::min({verts[i].fY, verts[i + 1].fY, verts[i + 2].fY}),
+              maxY = std::max({verts[i].fY, verts[i + 1].fY, verts[i + 2].fY});
+        if (maxY >= top && minY <= bottom) {
+            triangles.push_back(i);
+        }
+    }
+    return triangles;
+}
+
+// Counts the triangles that contain p, edges included.
+static int coverage_count(const SkPoint* verts, const std::vector<int>& triangles, SkPoint p) {
+    int count = 0;
+    for (int i : triangles) {
+        float d0 = SkPoint::CrossProduct(verts[i + 1] - verts[i], p - verts[i]),
+              d1 = SkPoint::CrossProduct(verts[i + 2] - verts[i + 1], p - verts[i + 1]),
+              d2 = SkPoint::CrossProduct(verts[i] - verts[i + 2], p - verts[i + 2]);
+        if ((d0 >= 0 && d1 >= 0 && d2 >= 0) || (d0 <= 0 && d1 <= 0 && d2 <= 0)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+// Triangulating a large path in bands on an executor has to cover the same area as triangulating
+// it in one piece, keep each band's triangles inside the band, and leave no cracks along the cuts.
+DEF_TEST(TriangulatorBands, r) {
+    constexpr int kNumPoints = 20000;
+    constexpr float kInnerRadius = 50, kOuterRadius = 100;
+    SkRandom rand;
+    SkPath path;
+    for (int i = 0; i < kNumPoints; ++i) {
+        float angle = SK_ScalarPI * 2 * i / kNumPoints;
+        float radius = (i & 1) ? kOuterRadius : kInnerRadius + 40 * rand.nextF();
+        SkPoint pt = {radius * std::cos(angle), radius * std::sin(angle)};
+        if (i == 0) {
+            path.moveTo(pt);
+        } else {
+            path.lineTo(pt);
+        }
+    }
+    path.close();
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    for (SkPathFillType fillType : {SkPathFillType::kWinding, SkPathFillType::kEvenOdd,
+                                    SkPathFillType::kInverseWinding}) {
+        path.setFillType(fillType);
+        SkRect clipBounds = SkRect::MakeLTRB(-120, -120, 120, 120);
+        bool isLinear;
+        SimplerVertexAllocator serial, banded;
+        GrTriangulator::BandInfo bandInfo;
+        int serialCount = GrTriangulator::PathToTriangles(path, 0.25f, clipBounds, &serial,
+                                                          &isLinear);
+        int bandedCount = GrTriangulator::PathToTrianglesInBandsForTesting(
+                path, 0.25f, clipBounds, &banded, &isLinear, executor.get(), &bandInfo);
+        REPORTER_ASSERT(r, serialCount > 0 && bandedCount > 0);
+        const SkPoint* serialVerts = (const SkPoint*)serial.fVertexData.get();
+        const SkPoint* bandedVerts = (const SkPoint*)banded.fVertexData.get();
+        double serialArea = triangle_area(serialVerts, serialCount);
+        double bandedArea = triangle_area(bandedVerts, bandedCount);
+        REPORTER_ASSERT(r, std::abs(serialArea - bandedArea) <= serialArea * 1e-4,
+                        "%g != %g", serialArea, bandedArea);
+
+        // The path is big enough to be cut, and every band emits whole triangles that stay
+        // between its cuts.
+        const std::vector<float>& cuts = bandInfo.fCuts;
+        REPORTER_ASSERT(r, cuts.size() >= 2);
+        REPORTER_ASSERT(r, std::is_sorted(cuts.begin(), cuts.end()));
+        REPORTER_ASSERT(r, bandInfo.fVertexCounts.size() == cuts.size() + 1);
+        int first = 0;
+        for (size_t band = 0; band < bandInfo.fVertexCounts.size(); ++band) {
+            int count = bandInfo.fVertexCounts[band];
+            REPORTER_ASSERT(r, count > 0 && count % 3 == 0, "band %zu: %d", band, count);
+            // Allow for rounding where the simplifier splits edges that lie along a cut.
+            float top = band > 0 ? cuts[band - 1] - 1e-3f : -SK_FloatInfinity;
+            float bottom = band < cuts.size() ? cuts[band] + 1e-3f : SK_FloatInfinity;
+            for (int i = first; i < first + count; ++i) {
+                REPORTER_ASSERT(r, bandedVerts[i].fY >= top && bandedVerts[i].fY <= bottom,
+                                "band %zu: %g outside [%g, %g]",
+                                band, bandedVerts[i].fY, top, bottom);
+            }
+            first += count;
+        }
+        REPORTER_ASSERT(r, first == bandedCount);
+
+        // Just above, on and just below each cut, well away from the path's edges, points are
+        // covered exactly when the path contains them, like the serial triangulation.
+        for (float cut : cuts) {
+            std::vector<int> serialTriangles =
+                    triangles_in_span(serialVerts, serialCount, cut - 0.01f, cut + 0.01f);
+            std::vector<int> bandedTriangles =
+                    triangles_in_span(bandedVerts, bandedCount, cut - 0.01f, cut + 0.01f);
+            for (float dy : {-0.01f, 0.f, 0.01f}) {
+                for (float x = -118; x <= 118; x += 0.73f) {
+                    SkPoint p = {x, cut + dy};
+                    float radius = p.length();
+                    if (radius > kInnerRadius - 5 && radius < kOuterRadius + 5) {
+                        continue;
+                    }
+                    bool inside = path.contains(p.fX, p.fY);
+                    int bandedCoverage = coverage_count(bandedVerts, bandedTriangles, p);
+                    REPORTER_ASSERT(r, inside == (bandedCoverage > 0),
+                                    "(%g, %g): covered %d times", p.fX, p.fY, bandedCoverage);
+                    REPORTER_ASSERT(r, (coverage_count(serialVerts, serialTriangles, p) > 0) ==
+                                       (bandedCoverage > 0));
+                }
+            }
+        }
+    }
+}
+
 DEF_TEST(TriangulatorBugs, r) {
     test_crbug_1262444(r);
 }
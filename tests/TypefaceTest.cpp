@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontArguments.h"
 #include "include/core/SkFontMgr.h"
@@ -24,6 +25,7 @@
 #include "src/base/SkUTF.h"
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkFontPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTypefaceCache.h"
 #include "src/sfnt/SkOTTable_OS_2.h"
 #include "src/sfnt/SkOTTable_OS_2_V0.h"
@@ -301,6 +303,43 @@ DEF_TEST(TypefaceAxes, reporter) {
     }
 }
 
+DEF_TEST(TypefaceCloneReusesInstances, reporter) {
+    std::unique_ptr<SkStreamAsset> distortable(GetResourceAsStream("fonts/Distortable.ttf"));
+    if (!distortable) {
+        REPORT_FAILURE(reporter, "distortable", SkString());
+        return;
+    }
+    sk_sp<SkTypeface> typeface = ToolUtils::TestFontMgr()->makeFromStream(std::move(distortable));
+    if (!typeface) {
+        return;
+    }
+
+    auto clone = [&](float weight) {
+        const SkFontArguments::VariationPosition::Coordinate position[] = {
+            { SkSetFourByteTag('w','g','h','t'), weight },
+        };
+        SkFontArguments params;
+        params.setVariationDesignPosition({position, std::size(position)});
+        return typeface->makeClone(params);
+    };
+
+    // Asking for the same instance again returns the one already made.
+    sk_sp<SkTypeface> first = clone(1.5f);
+    REPORTER_ASSERT(reporter, first && first == clone(1.5f));
+
+    // Positions closer than 16.16 fixed point can tell apart are the same instance.
+    REPORTER_ASSERT(reporter, first == clone(1.5f + 1.0f / (1 << 20)));
+
+    // Other instances are their own typefaces.
+    sk_sp<SkTypeface> second = clone(1.75f);
+    SkFontArguments::VariationPosition::Coordinate firstPosition[1], secondPosition[1];
+    if (first->getVariationDesignPosition(firstPosition, 1) == 1 &&
+        second && second->getVariationDesignPosition(secondPosition, 1) == 1 &&
+        firstPosition[0].value != secondPosition[0].value) {
+        REPORTER_ASSERT(reporter, first != second);
+    }
+}
+
 DEF_TEST(TypefaceVariationIndex, reporter) {
     std::unique_ptr<SkStreamAsset> distortable(GetResourceAsStream("fonts/Distortable.ttf"));
     if (!distortable) {
@@ -524,6 +563,43 @@ DEF_TEST(TypefaceCache, reporter) {
     REPORTER_ASSERT(reporter, t1->unique());
 }
 
+static bool find_by_id_proc(SkTypeface* face, void* ctx) {
+    return face->uniqueID() == *static_cast<SkTypefaceID*>(ctx);
+}
+
+DEF_TEST(TypefaceCache_Threaded, reporter) {
+    SkTypefaceCache cache;
+    sk_sp<SkTypeface> kept[8];
+    for (sk_sp<SkTypeface>& typeface : kept) {
+        typeface = TestEmptyTypeface::Make();
+        cache.add(typeface);
+    }
+
+    // Searches run while the cache is added to and purged, and always find the typefaces that
+    // are still owned outside the cache.
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkTaskGroup tasks(*executor);
+    tasks.batch(4, [&](int thread) {
+        for (int i = 0; i < 200; ++i) {
+            if (thread == 0) {
+                cache.add(TestEmptyTypeface::Make());
+                if (i % 16 == 0) {
+                    cache.purgeAll();
+                }
+            } else {
+                const sk_sp<SkTypeface>& typeface = kept[i % std::size(kept)];
+                SkTypefaceID id = typeface->uniqueID();
+                REPORTER_ASSERT(reporter,
+                                cache.findByProcAndRef(find_by_id_proc, &id) == typeface);
+            }
+        }
+    });
+    tasks.wait();
+
+    cache.purgeAll();
+    REPORTER_ASSERT(reporter, count(reporter, cache) == (int)std::size(kept));
+}
+
 static void check_serialize_behaviors(sk_sp<SkTypeface> tf, skiatest::Reporter* reporter) {
     if (!tf) {
         return;
@@ -8,6 +8,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkColorPriv.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPoint.h"
@@ -15,12 +16,14 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkVertices.h"
 #include "src/base/SkAutoMalloc.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkVerticesPriv.h"
 #include "src/core/SkWriteBuffer.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
+#include <algorithm>
 #include <cstdint>
 
 static bool equal(const SkVertices* vert0, const SkVertices* vert1) {
@@ -172,3 +175,44 @@ DEF_TEST(Vertices_clipping, reporter) {
         }
     }
 }
+
+DEF_TEST(Vertices_sharedEdges, reporter) {
+    // A mesh of triangles that share edges, some passing through pixel centers, covering the whole
+    // surface. Blending half-transparent vertex colors src-over shows any pixel drawn twice or
+    // missed.
+    static constexpr int kSize = 32, kCells = 5;
+    auto surf = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kSize, kSize));
+
+    SkRandom random;
+    SkPoint pts[kCells + 1][kCells + 1];
+    for (int y = 0; y <= kCells; ++y) {
+        for (int x = 0; x <= kCells; ++x) {
+            pts[y][x] = {x * kSize / float(kCells), y * kSize / float(kCells)};
+            if (x > 0 && x < kCells && y > 0 && y < kCells) {
+                pts[y][x] += {random.nextRangeF(-1, 1), random.nextRangeF(-1, 1)};
+            }
+        }
+    }
+    pts[2][2] = {12.5f, 12.5f};
+    pts[3][3] = {19.5f, 20};
+
+    SkVertices::Builder builder(SkVertices::kTriangles_VertexMode, 6 * kCells * kCells, 0,
+                                SkVertices::kHasColors_BuilderFlag);
+    SkPoint* positions = builder.positions();
+    for (int y = 0; y < kCells; ++y) {
+        for (int x = 0; x < kCells; ++x) {
+            for (SkIPoint corner : {SkIPoint{0, 0}, {1, 0}, {1, 1}, {0, 0}, {1, 1}, {0, 1}}) {
+                *positions++ = pts[y + corner.fY][x + corner.fX];
+            }
+        }
+    }
+    std::fill_n(builder.colors(), 6 * kCells * kCells, SkColorSetARGB(0x80, 0, 0, 0));
+    surf->getCanvas()->drawVertices(builder.detach(), SkBlendMode::kDst, SkPaint());
+
+    ToolUtils::PixelIter iter(surf.get());
+    SkIPoint loc;
+    while (void* addr = iter.next(&loc)) {
+        REPORTER_ASSERT(reporter, SkGetPackedA32(*(SkPMColor*)addr) == 0x80,
+                        "pixel (%d, %d)", loc.fX, loc.fY);
+    }
+}
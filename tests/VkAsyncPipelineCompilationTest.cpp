@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#if defined(SK_GANESH) && defined(SK_VULKAN)
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/GrGpu.h"
+#include "src/gpu/ganesh/GrThreadSafePipelineBuilder.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+
+#include <memory>
+
+static void enable_async_compilation(GrContextOptions* options) {
+    static std::unique_ptr<SkExecutor> gExecutor = SkExecutor::MakeFIFOThreadPool(1);
+    options->fExecutor = gExecutor.get();
+    options->fAsyncPipelineCompilation = true;
+}
+
+DEF_GANESH_TEST_FOR_CONTEXTS(VkAsyncPipelineCompilation,
+                             &skiatest::IsVulkanContextType,
+                             reporter,
+                             ctxInfo,
+                             enable_async_compilation,
+                             CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    const SkImageInfo ii = SkImageInfo::MakeN32Premul(16, 16);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, ii);
+    REPORTER_ASSERT(reporter, surface);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(ii);
+
+    // Every draw must show up in the first frame, even though its pipeline is compiled on another
+    // thread. The two draws need different pipelines, which compile concurrently.
+    surface->getCanvas()->clear(SK_ColorWHITE);
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    surface->getCanvas()->drawRect(SkRect::MakeWH(8, 16), paint);
+    paint.setColor(SK_ColorBLUE);
+    paint.setAntiAlias(true);
+    surface->getCanvas()->drawOval(SkRect::MakeXYWH(8, 0, 8, 16), paint);
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+    REPORTER_ASSERT(reporter, surface->readPixels(bitmap, 0, 0));
+    REPORTER_ASSERT(reporter, bitmap.getColor(4, 8) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, bitmap.getColor(12, 8) == SK_ColorBLUE);
+
+#if GR_GPU_STATS
+    auto stats = dContext->priv().getGpu()->pipelineBuilder()->stats();
+    REPORTER_ASSERT(reporter, stats->numAsyncCompilations() > 0);
+#endif
+}
+
+#endif
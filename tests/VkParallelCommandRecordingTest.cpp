@@ -0,0 +1,89 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#if defined(SK_GANESH) && defined(SK_VULKAN)
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrContextOptions.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/vk/GrVkGpu.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+
+#include <iterator>
+#include <memory>
+
+static void enable_parallel_recording(GrContextOptions* options) {
+    static std::unique_ptr<SkExecutor> gExecutor = SkExecutor::MakeFIFOThreadPool(2);
+    options->fExecutor = gExecutor.get();
+    options->fParallelCommandRecording = true;
+}
+
+DEF_GANESH_TEST_FOR_CONTEXTS(VkParallelCommandRecording,
+                             &skiatest::IsVulkanContextType,
+                             reporter,
+                             ctxInfo,
+                             enable_parallel_recording,
+                             CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    auto gpu = static_cast<GrVkGpu*>(dContext->priv().getGpu());
+    REPORTER_ASSERT(reporter, gpu->parallelRecordingTaskGroup());
+
+    const SkImageInfo ii = SkImageInfo::MakeN32Premul(16, 16);
+    static constexpr SkColor kColors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE};
+    static constexpr int kNumSurfaces = std::size(kColors);
+    sk_sp<SkSurface> surfaces[kNumSurfaces];
+    for (int i = 0; i < kNumSurfaces; ++i) {
+        surfaces[i] = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, ii);
+        REPORTER_ASSERT(reporter, surfaces[i]);
+        if (!surfaces[i]) {
+            return;
+        }
+    }
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(ii);
+
+    for (int frame = 0; frame < 3; ++frame) {
+        // Each surface is a render pass of its own, recorded on a worker thread.
+        for (int i = 0; i < kNumSurfaces; ++i) {
+            SkPaint paint;
+            paint.setColor(kColors[(i + frame) % kNumSurfaces]);
+            surfaces[i]->getCanvas()->clear(SK_ColorWHITE);
+            surfaces[i]->getCanvas()->drawRect(SkRect::MakeWH(8, 16), paint);
+        }
+        // The last surface reads the first, so their render passes must stay in order.
+        sk_sp<SkImage> image = surfaces[0]->makeImageSnapshot();
+        surfaces[kNumSurfaces - 1]->getCanvas()->drawImage(image, 8, 0);
+        dContext->flushAndSubmit(GrSyncCpu::kYes);
+
+        for (int i = 0; i < kNumSurfaces; ++i) {
+            REPORTER_ASSERT(reporter, surfaces[i]->readPixels(bitmap, 0, 0));
+            SkColor expected = kColors[(i + frame) % kNumSurfaces];
+            REPORTER_ASSERT(reporter, bitmap.getColor(4, 8) == expected);
+            SkColor right = i == kNumSurfaces - 1 ? kColors[frame % kNumSurfaces] : SK_ColorWHITE;
+            REPORTER_ASSERT(reporter, bitmap.getColor(12, 8) == right);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTypes.h"
+
+#if defined(SK_GANESH) && defined(SK_VULKAN)
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/GrTypes.h"
+#include "include/gpu/ganesh/SkSurfaceGanesh.h"
+#include "src/gpu/ganesh/GrDirectContextPriv.h"
+#include "src/gpu/ganesh/vk/GrVkCaps.h"
+#include "src/gpu/ganesh/vk/GrVkGpu.h"
+#include "src/gpu/ganesh/vk/GrVkPipelineLibraryCache.h"
+#include "src/gpu/ganesh/vk/GrVkResourceProvider.h"
+#include "tests/CtsEnforcement.h"
+#include "tests/Test.h"
+
+DEF_GANESH_TEST_FOR_VULKAN_CONTEXT(VkPipelineLibrary, reporter, ctxInfo, CtsEnforcement::kNever) {
+    auto dContext = ctxInfo.directContext();
+    GrVkGpu* gpu = static_cast<GrVkGpu*>(dContext->priv().getGpu());
+    GrVkPipelineLibraryCache* libraryCache = gpu->resourceProvider().pipelineLibraryCache();
+    REPORTER_ASSERT(reporter,
+                    SkToBool(libraryCache) == gpu->vkCaps().supportsGraphicsPipelineLibrary());
+
+    const SkImageInfo ii = SkImageInfo::MakeN32Premul(16, 16);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(dContext, skgpu::Budgeted::kNo, ii);
+    REPORTER_ASSERT(reporter, surface);
+
+    // The same geometry with two blend modes. The second pipeline must at least share the vertex
+    // shader of the first.
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    surface->getCanvas()->clear(SK_ColorWHITE);
+    surface->getCanvas()->drawRect(SkRect::MakeWH(8, 16), paint);
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+    int libraryCount = libraryCache ? libraryCache->count() : 0;
+
+    paint.setBlendMode(SkBlendMode::kModulate);
+    surface->getCanvas()->drawRect(SkRect::MakeXYWH(8, 0, 8, 16), paint);
+    dContext->flushAndSubmit(surface.get(), GrSyncCpu::kYes);
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(ii);
+    REPORTER_ASSERT(reporter, surface->readPixels(bitmap, 0, 0));
+    REPORTER_ASSERT(reporter, bitmap.getColor(4, 8) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, bitmap.getColor(12, 8) == SK_ColorRED);
+
+    if (libraryCache) {
+        REPORTER_ASSERT(reporter, libraryCount > 0);
+        REPORTER_ASSERT(reporter, libraryCache->count() - libraryCount <= 3);
+    }
+}
+
+#endif
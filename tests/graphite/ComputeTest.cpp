@@ -25,6 +25,7 @@
 #include "src/gpu/graphite/UploadTask.h"
 #include "src/gpu/graphite/compute/ComputeStep.h"
 #include "src/gpu/graphite/compute/DispatchGroup.h"
+#include "src/gpu/graphite/compute/MipmapComputeStep.h"
 #include "tools/graphite/GraphiteTestContext.h"
 
 using namespace skgpu::graphite;
@@ -1454,6 +1455,118 @@ DEF_GRAPHITE_TEST_FOR_DAWN_AND_METAL_CONTEXTS(Compute_SampledTexture,
     }
 }
 
+// TODO(b/262427430, b/262429132): Enable this test on other backends once they all support
+// compute programs.
+DEF_GRAPHITE_TEST_FOR_DAWN_AND_METAL_CONTEXTS(Compute_MipmapDownsample,
+                                              reporter,
+                                              context,
+                                              testContext) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+
+    // Initialize a 16x16 checkerboard of alternating red and black pixels, then downsample it
+    // twice in the same DispatchGroup. Every pixel of the 4x4 result averages red and black.
+    constexpr uint32_t kSrcDim = 16;
+    constexpr uint32_t kDstDim = 4;
+
+    class InitStep : public ComputeStep {
+    public:
+        InitStep() : ComputeStep(
+                /*name=*/"Test_MipmapDownsample_Init",
+                /*localDispatchSize=*/{kSrcDim, kSrcDim, 1},
+                /*resources=*/{
+                    {
+                        /*type=*/ResourceType::kWriteOnlyStorageTexture,
+                        /*flow=*/DataFlow::kShared,
+                        /*policy=*/ResourcePolicy::kNone,
+                        /*slot=*/kMipmapSlot_Src,
+                        /*sksl=*/"dst",
+                    }
+                }) {}
+        ~InitStep() override = default;
+
+        std::string computeSkSL() const override {
+            return R"(
+                void main() {
+                    uint2 c = sk_LocalInvocationID.xy;
+                    uint checkerBoardColor = (c.x + (c.y % 2)) % 2;
+                    textureWrite(dst, c, half4(checkerBoardColor, 0, 0, 1));
+                }
+            )";
+        }
+
+        std::tuple<SkISize, SkColorType> calculateTextureParameters(
+                int index, const ResourceDesc& r) const override {
+            SkASSERT(index == 0);
+            return {{kSrcDim, kSrcDim}, kRGBA_8888_SkColorType};
+        }
+
+        WorkgroupSize calculateGlobalDispatchSize() const override {
+            return WorkgroupSize(1, 1, 1);
+        }
+    } initStep;
+
+    MipmapDownsampleComputeStep downsampleStep;
+
+    DispatchGroup::Builder builder(recorder.get());
+    builder.appendStep(&initStep);
+
+    sk_sp<TextureProxy> dst;
+    for (uint32_t dim = kSrcDim / 2; dim >= kDstDim; dim /= 2) {
+        const SkISize dstSize = SkISize::Make(dim, dim);
+        dst = TextureProxy::MakeStorage(recorder->priv().caps(),
+                                        dstSize,
+                                        kRGBA_8888_SkColorType,
+                                        skgpu::Budgeted::kYes);
+        if (!dst) {
+            ERRORF(reporter, "failed to create a %ux%u storage texture", dim, dim);
+            return;
+        }
+        builder.assignSharedTexture(dst, kMipmapSlot_Dst);
+        builder.appendStep(&downsampleStep, downsampleStep.globalDispatchSize(dstSize));
+        builder.assignSharedTexture(dst, kMipmapSlot_Src);
+    }
+
+    // Record the compute task
+    ComputeTask::DispatchGroupList groups;
+    groups.push_back(builder.finalize());
+    recorder->priv().add(ComputeTask::Make(std::move(groups)));
+
+    // Submit the work and wait for it to complete.
+    std::unique_ptr<Recording> recording = recorder->snap();
+    if (!recording) {
+        ERRORF(reporter, "Failed to make recording");
+        return;
+    }
+
+    InsertRecordingInfo insertInfo;
+    insertInfo.fRecording = recording.get();
+    context->insertRecording(insertInfo);
+    testContext->syncedSubmit(context);
+
+    SkBitmap bitmap;
+    SkImageInfo imgInfo =
+            SkImageInfo::Make(kDstDim, kDstDim, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);
+    bitmap.allocPixels(imgInfo);
+
+    SkPixmap pixels;
+    bool peekPixelsSuccess = bitmap.peekPixels(&pixels);
+    REPORTER_ASSERT(reporter, peekPixelsSuccess);
+
+    bool readPixelsSuccess = context->priv().readPixels(pixels, dst.get(), imgInfo, 0, 0);
+    REPORTER_ASSERT(reporter, readPixelsSuccess);
+
+    for (uint32_t x = 0; x < kDstDim; ++x) {
+        for (uint32_t y = 0; y < kDstDim; ++y) {
+            SkColor4f color = pixels.getColor4f(x, y);
+            REPORTER_ASSERT(reporter, color.fR > 0.49 && color.fR < 0.51,
+                            "At position {%u, %u}, "
+                            "expected red channel in range [0.49, 0.51], "
+                            "found {%.3f}",
+                            x, y, color.fR);
+        }
+    }
+}
+
 // TODO(b/260622403): The shader tested here is identical to
 // `resources/sksl/compute/AtomicsOperations.compute`. It would be nice to be able to exercise SkSL
 // features like this as part of SkSLTest.cpp instead of as a graphite test.
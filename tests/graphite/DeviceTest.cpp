@@ -10,10 +10,14 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkVertices.h"
 #include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/ContextOptions.h"
 #include "include/gpu/graphite/Recorder.h"
 #include "include/gpu/graphite/Surface.h"
+#include "src/core/SkCanvasPriv.h"
+#include "src/gpu/graphite/Device.h"
 
 namespace skgpu::graphite {
 
@@ -81,4 +85,80 @@ DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(DeviceTestVertexTransparency, reporter, conte
             reporter, color == expected, "Wrong color, expected %08x, found %08x", expected, color);
 }
 
+static void enable_occlusion_culling(ContextOptions* options) {
+    options->fEnableOcclusionCulling = true;
+}
+
+// Tests that only unclipped opaque rects become occluders, and that culling the draws they hide
+// doesn't change what gets rendered.
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_CONTEXTS(DeviceTestOcclusionCulling,
+                                           skgpu::IsRenderingContext,
+                                           reporter,
+                                           context,
+                                           /*anonymous test_ctx*/,
+                                           enable_occlusion_culling,
+                                           true,
+                                           CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    SkImageInfo ii = SkImageInfo::Make(SkISize::Make(16, 16),
+                                       SkColorType::kRGBA_8888_SkColorType,
+                                       SkAlphaType::kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+    SkCanvas* canvas = surface->getCanvas();
+    Device* device = SkCanvasPriv::TopDevice(canvas)->asGraphiteDevice();
+    SkASSERT(device);
+
+    SkPaint opaquePaint;
+    opaquePaint.setColor(SK_ColorRED);
+    SkPaint translucentPaint;
+    translucentPaint.setColor(0x800000FF);
+
+    canvas->drawRect(SkRect::MakeLTRB(2, 2, 8, 8), opaquePaint);
+    REPORTER_ASSERT(reporter, device->pendingOccluderCount() == 1);
+
+    // Blends with what's underneath.
+    canvas->drawRect(SkRect::MakeWH(16, 16), translucentPaint);
+    REPORTER_ASSERT(reporter, device->pendingOccluderCount() == 1);
+
+    // Doesn't cover its whole rect.
+    canvas->save();
+    canvas->clipRRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(1, 1, 15, 15), 4, 4), true);
+    canvas->drawRect(SkRect::MakeWH(16, 16), opaquePaint);
+    canvas->restore();
+    REPORTER_ASSERT(reporter, device->pendingOccluderCount() == 1);
+
+    canvas->drawOval(SkRect::MakeWH(16, 16), opaquePaint);
+    REPORTER_ASSERT(reporter, device->pendingOccluderCount() == 1);
+
+    canvas->save();
+    canvas->rotate(30.f, 8, 8);
+    canvas->drawRect(SkRect::MakeLTRB(4, 4, 12, 12), opaquePaint);
+    canvas->restore();
+    REPORTER_ASSERT(reporter, device->pendingOccluderCount() == 1);
+
+    // Hides everything drawn so far, so it's the only draw that should reach the DrawPass.
+    SkPaint greenPaint;
+    greenPaint.setColor(SK_ColorGREEN);
+    canvas->drawRect(SkRect::MakeWH(16, 16), greenPaint);
+    REPORTER_ASSERT(reporter, device->pendingOccluderCount() == 2);
+
+    SkBitmap bitmap;
+    SkPixmap pixmap;
+    bitmap.allocPixels(ii);
+    SkAssertResult(bitmap.peekPixels(&pixmap));
+    if (!surface->readPixels(pixmap, 0, 0)) {
+        ERRORF(reporter, "readPixels failed");
+        return;
+    }
+    for (int y = 0; y < ii.height(); ++y) {
+        for (int x = 0; x < ii.width(); ++x) {
+            if (pixmap.getColor(x, y) != SK_ColorGREEN) {
+                ERRORF(reporter, "Pixel (%d, %d) is %08x, expected green",
+                       x, y, pixmap.getColor(x, y));
+                return;
+            }
+        }
+    }
+}
+
 }  // namespace skgpu::graphite
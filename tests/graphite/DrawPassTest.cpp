@@ -7,12 +7,25 @@
 
 #include "tests/Test.h"
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/base/SkRandom.h"
 #include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/DrawCommands.h"
 #include "src/gpu/graphite/DrawList.h"
 #include "src/gpu/graphite/DrawPass.h"
 #include "src/gpu/graphite/RecorderPriv.h"
 #include "src/gpu/graphite/RendererProvider.h"
 
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+
 namespace skgpu::graphite {
 
 // Tests that creating a draw pass that fails a dst copy doesn't result in a segfault.
@@ -61,4 +74,254 @@ DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(DrawPassTestFailedDstCopy,
     REPORTER_ASSERT(reporter, !drawPass);
 }
 
+// Tests that a DrawPass large enough to be sorted on several threads draws the same as one sorted
+// on the snapping thread.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(DrawPassTestConcurrentSort,
+                                         reporter,
+                                         context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    RecorderOptions concurrentOptions;
+    concurrentOptions.fExecutor = executor.get();
+
+    const SkImageInfo ii = SkImageInfo::Make(64, 64, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    SkBitmap results[2];
+    for (int i = 0; i < 2; ++i) {
+        std::unique_ptr<Recorder> recorder =
+                context->makeRecorder(i ? concurrentOptions : RecorderOptions());
+        sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), ii);
+        REPORTER_ASSERT(reporter, surface);
+        if (!surface) {
+            return;
+        }
+
+        // Overlapping translucent rects of a few colors, so that both the pipeline order and the
+        // painter's order matter.
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->clear(SK_ColorWHITE);
+        SkRandom random;
+        static constexpr SkColor kColors[] = {0x80FF0000, 0x8000FF00, 0x800000FF};
+        for (int draw = 0; draw < 20000; ++draw) {
+            SkPaint paint;
+            paint.setColor(kColors[draw % std::size(kColors)]);
+            paint.setAntiAlias(draw % 2);
+            canvas->drawRect(SkRect::MakeXYWH(random.nextRangeF(0, 60),
+                                              random.nextRangeF(0, 60),
+                                              random.nextRangeF(1, 8),
+                                              random.nextRangeF(1, 8)),
+                             paint);
+        }
+
+        std::unique_ptr<Recording> recording = recorder->snap();
+        InsertRecordingInfo info;
+        info.fRecording = recording.get();
+        context->insertRecording(info);
+        context->submit(SyncToCpu::kYes);
+
+        results[i].allocPixels(ii);
+        REPORTER_ASSERT(reporter, surface->readPixels(results[i], 0, 0));
+    }
+
+    for (int y = 0; y < ii.height(); ++y) {
+        for (int x = 0; x < ii.width(); ++x) {
+            if (results[0].getColor(x, y) != results[1].getColor(x, y)) {
+                ERRORF(reporter, "Pixel (%d, %d) differs when sorted concurrently", x, y);
+                return;
+            }
+        }
+    }
+}
+
+// Tests that the keys of a DrawPass of any size up to DrawList::kMaxRenderSteps are split across an
+// executor once there are enough of them, and come out in the same order as std::sort.
+DEF_GRAPHITE_TEST(DrawPassTestConcurrentSortMatchesStdSort, reporter, CtsEnforcement::kNever) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom random;
+
+    static constexpr struct {
+        int fCount;
+        int fExpectedChunks;
+    } kCases[] = {
+        {100, 0},
+        {1023, 0},
+        {1024, 2},
+        {4000, 7},
+        {DrawList::kMaxRenderSteps, 8},
+    };
+    for (const auto& c : kCases) {
+        // Few distinct high bits, so many keys tie on the part that is compared first.
+        std::vector<uint64_t> keys(c.fCount);
+        for (uint64_t& key : keys) {
+            key = (uint64_t(random.nextULessThan(16)) << 32) | random.nextULessThan(64);
+        }
+        std::vector<uint64_t> expected = keys;
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<uint64_t> sequential = keys;
+        REPORTER_ASSERT(reporter, DrawPass::SortForTesting(nullptr, &sequential) == 0);
+        REPORTER_ASSERT(reporter, sequential == expected);
+
+        int chunks = DrawPass::SortForTesting(executor.get(), &keys);
+        REPORTER_ASSERT(reporter, chunks == c.fExpectedChunks,
+                        "%d keys: expected %d chunks, got %d",
+                        c.fCount, c.fExpectedChunks, chunks);
+        REPORTER_ASSERT(reporter, keys == expected, "%d keys sorted differently", c.fCount);
+    }
+}
+
+// Tests that a SortOrderCache only reuses its order for a DrawPass with the same draws as the last.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(DrawPassTestSortOrderCache,
+                                   reporter,
+                                   context,
+                                   CtsEnforcement::kNever) {
+    const Caps* caps = context->priv().caps();
+    // Large passes sort the cached order concurrently, small ones on this thread.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    RecorderOptions options;
+    options.fExecutor = executor.get();
+    std::unique_ptr<Recorder> recorder = context->makeRecorder(options);
+
+    static constexpr SkISize targetSize = SkISize::Make(16, 16);
+    const SkImageInfo targetInfo = SkImageInfo::Make(targetSize,
+                                                     kN32_SkColorType,
+                                                     kPremul_SkAlphaType);
+    sk_sp<TextureProxy> target = TextureProxy::Make(
+            caps,
+            targetSize,
+            caps->getDefaultSampledTextureInfo(
+                    kN32_SkColorType, Mipmapped::kNo, Protected::kNo, Renderable::kYes),
+            Budgeted::kNo);
+
+    auto makeDrawPass = [&](DrawPass::SortOrderCache* cache, int drawCount) {
+        std::unique_ptr<DrawList> drawList = std::make_unique<DrawList>();
+        DrawOrder order(DrawOrder::kClearDepth.next());
+        for (int i = 0; i < drawCount; ++i) {
+            SkPaint paint;
+            paint.setColor(i % 2 ? SK_ColorRED : SK_ColorBLUE);
+            PaintParams paintParams{paint, nullptr, nullptr, DstReadRequirement::kNone, false};
+            const SkIRect bounds = SkIRect::MakeXYWH(i % 8, i % 8, 8, 8);
+            drawList->recordDraw(recorder->priv().rendererProvider()->analyticRRect(),
+                                 Transform::Identity(),
+                                 Geometry(Shape(SkRect::Make(bounds))),
+                                 Clip(Rect::Infinite(), Rect::Infinite(), bounds, nullptr),
+                                 order,
+                                 &paintParams,
+                                 nullptr);
+            order = DrawOrder(order.depth().next());
+        }
+        return DrawPass::Make(recorder.get(),
+                              std::move(drawList),
+                              target,
+                              targetInfo,
+                              {LoadOp::kClear, StoreOp::kStore},
+                              {0.0f, 0.0f, 0.0f, 0.0f},
+                              cache);
+    };
+
+    DrawPass::SortOrderCache cache;
+    REPORTER_ASSERT(reporter, makeDrawPass(&cache, 10));
+    REPORTER_ASSERT(reporter, cache.reuseCount() == 0);
+    REPORTER_ASSERT(reporter, makeDrawPass(&cache, 10));
+    REPORTER_ASSERT(reporter, cache.reuseCount() == 1);
+    REPORTER_ASSERT(reporter, makeDrawPass(&cache, 11));
+    REPORTER_ASSERT(reporter, cache.reuseCount() == 1);
+    REPORTER_ASSERT(reporter, makeDrawPass(&cache, 11));
+    REPORTER_ASSERT(reporter, cache.reuseCount() == 2);
+
+    static constexpr int kConcurrentDrawCount = DrawList::kMaxRenderSteps / 2;
+    REPORTER_ASSERT(reporter, makeDrawPass(&cache, kConcurrentDrawCount));
+    REPORTER_ASSERT(reporter, cache.reuseCount() == 2);
+    REPORTER_ASSERT(reporter, makeDrawPass(&cache, kConcurrentDrawCount));
+    REPORTER_ASSERT(reporter, cache.reuseCount() == 3);
+}
+
+// Counts the instances drawn by 'drawPass', since draws that share a pipeline are batched.
+static int count_instances(const DrawPass& drawPass) {
+    int instances = 0;
+    for (auto [type, cmdPtr] : drawPass.commands()) {
+        switch (type) {
+            case DrawPassCommands::Type::kDrawInstanced:
+                instances += static_cast<DrawPassCommands::DrawInstanced*>(cmdPtr)->fInstanceCount;
+                break;
+            case DrawPassCommands::Type::kDrawIndexedInstanced:
+                instances +=
+                        static_cast<DrawPassCommands::DrawIndexedInstanced*>(cmdPtr)->fInstanceCount;
+                break;
+            case DrawPassCommands::Type::kDraw:
+            case DrawPassCommands::Type::kDrawIndexed:
+            case DrawPassCommands::Type::kDrawIndirect:
+            case DrawPassCommands::Type::kDrawIndexedIndirect:
+                ++instances;
+                break;
+            default:
+                break;
+        }
+    }
+    return instances;
+}
+
+// Tests that a DrawPass skips the draws an occluder hides, and only those.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(DrawPassTestOcclusionCulling,
+                                   reporter,
+                                   context,
+                                   CtsEnforcement::kNever) {
+    const Caps* caps = context->priv().caps();
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+
+    static constexpr SkISize targetSize = SkISize::Make(16, 16);
+    const SkImageInfo targetInfo = SkImageInfo::Make(targetSize,
+                                                     kN32_SkColorType,
+                                                     kPremul_SkAlphaType);
+    sk_sp<TextureProxy> target = TextureProxy::Make(
+            caps,
+            targetSize,
+            caps->getDefaultSampledTextureInfo(
+                    kN32_SkColorType, Mipmapped::kNo, Protected::kNo, Renderable::kYes),
+            Budgeted::kNo);
+
+    // Draws each rect in order, then records an occluder for the 'occluder' index. Returns the
+    // number of instances in the resulting DrawPass.
+    auto drawRects = [&](std::initializer_list<SkIRect> rects, int occluder) {
+        std::unique_ptr<DrawList> drawList = std::make_unique<DrawList>();
+        SkPaint paint;
+        PaintParams paintParams{paint, nullptr, nullptr, DstReadRequirement::kNone, false};
+        DrawOrder order(DrawOrder::kClearDepth.next());
+        int index = 0;
+        for (const SkIRect& bounds : rects) {
+            drawList->recordDraw(recorder->priv().rendererProvider()->analyticRRect(),
+                                 Transform::Identity(),
+                                 Geometry(Shape(SkRect::Make(bounds))),
+                                 Clip(Rect::Infinite(), Rect::Infinite(), bounds, nullptr),
+                                 order,
+                                 &paintParams,
+                                 nullptr);
+            if (index++ == occluder) {
+                drawList->recordOccluder(Rect(SkRect::Make(bounds)), order.depth());
+            }
+            order = DrawOrder(order.depth().next());
+        }
+        std::unique_ptr<DrawPass> drawPass = DrawPass::Make(recorder.get(),
+                                                            std::move(drawList),
+                                                            target,
+                                                            targetInfo,
+                                                            {LoadOp::kClear, StoreOp::kStore},
+                                                            {0.0f, 0.0f, 0.0f, 0.0f});
+        REPORTER_ASSERT(reporter, drawPass);
+        return drawPass ? count_instances(*drawPass) : -1;
+    };
+
+    static constexpr SkIRect kInner = SkIRect::MakeLTRB(4, 4, 12, 12);
+    static constexpr SkIRect kFull = SkIRect::MakeWH(16, 16);
+    static constexpr SkIRect kOverhang = SkIRect::MakeLTRB(8, 8, 14, 14);
+
+    // Without an occluder every draw is kept.
+    REPORTER_ASSERT(reporter, drawRects({kInner, kFull}, /*occluder=*/-1) == 2);
+    // A later occluder hides an earlier draw it contains.
+    REPORTER_ASSERT(reporter, drawRects({kInner, kFull}, /*occluder=*/1) == 1);
+    // Draws after the occluder are on top of it.
+    REPORTER_ASSERT(reporter, drawRects({kFull, kInner}, /*occluder=*/0) == 2);
+    // Draws that reach past the occluder are still visible outside of it.
+    REPORTER_ASSERT(reporter, drawRects({kOverhang, kInner}, /*occluder=*/1) == 2);
+}
+
 }  // namespace skgpu::graphite
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "tools/graphite/GraphiteTestContext.h"
+
+#include <memory>
+
+namespace skgpu::graphite {
+
+namespace {
+
+void snap_and_submit(Context* context,
+                     skiatest::graphite::GraphiteTestContext* testContext,
+                     Recorder* recorder) {
+    std::unique_ptr<Recording> recording = recorder->snap();
+    InsertRecordingInfo info;
+    info.fRecording = recording.get();
+    context->insertRecording(info);
+    testContext->syncedSubmit(context);
+}
+
+}  // anonymous namespace
+
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(GpuCountersTest,
+                                                     reporter,
+                                                     context,
+                                                     testContext,
+                                                     true,
+                                                     CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(),
+                                                        SkImageInfo::MakeN32Premul(64, 64));
+    REPORTER_ASSERT(reporter, surface);
+    SkCanvas* canvas = surface->getCanvas();
+    snap_and_submit(context, testContext, recorder.get());
+
+    // Rects of one color share a pipeline, so they may be drawn with fewer draw calls.
+    constexpr int kRects = 3;
+    skgpu::GpuCounters before = context->getGpuCounters();
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    for (int i = 0; i < kRects; ++i) {
+        canvas->drawRect(SkRect::MakeXYWH(8 * i, 8 * i, 16, 16), paint);
+    }
+    snap_and_submit(context, testContext, recorder.get());
+    skgpu::GpuCounters diff = context->getGpuCounters() - before;
+    REPORTER_ASSERT(reporter, diff.fRenderPasses >= 1);
+    REPORTER_ASSERT(reporter, diff.fDrawsRecorded == kRects, "%llu",
+                    (unsigned long long)diff.fDrawsRecorded);
+    REPORTER_ASSERT(reporter, diff.fDrawCalls >= 1 && diff.fDrawCalls <= kRects, "%llu",
+                    (unsigned long long)diff.fDrawCalls);
+
+    // Drawing a raster image uploads at least its pixels.
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::Make(16, 16, kRGBA_8888_SkColorType, kPremul_SkAlphaType));
+    bitmap.eraseColor(SK_ColorGREEN);
+    before = context->getGpuCounters();
+    canvas->drawImage(bitmap.asImage(), 0, 0);
+    snap_and_submit(context, testContext, recorder.get());
+    diff = context->getGpuCounters() - before;
+    REPORTER_ASSERT(reporter, diff.fTextureUploadBytes >= bitmap.computeByteSize(), "%llu",
+                    (unsigned long long)diff.fTextureUploadBytes);
+    REPORTER_ASSERT(reporter, diff.fDrawsRecorded >= 1 && diff.fDrawCalls >= 1);
+    REPORTER_ASSERT(reporter, diff.fRenderPasses >= 1);
+
+    // Nothing is counted for an empty Recording.
+    before = context->getGpuCounters();
+    snap_and_submit(context, testContext, recorder.get());
+    diff = context->getGpuCounters() - before;
+    REPORTER_ASSERT(reporter, diff.fRenderPasses == 0 && diff.fDrawsRecorded == 0 &&
+                              diff.fDrawCalls == 0 && diff.fTextureUploadBytes == 0);
+}
+
+}  // namespace skgpu::graphite
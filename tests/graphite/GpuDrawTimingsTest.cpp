@@ -0,0 +1,112 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "tools/graphite/GraphiteTestContext.h"
+
+#include <chrono>
+#include <memory>
+
+namespace skgpu::graphite {
+
+namespace {
+
+void draw_and_submit(Context* context,
+                     skiatest::graphite::GraphiteTestContext* testContext,
+                     Recorder* recorder,
+                     SkSurface* surface) {
+    SkCanvas* canvas = surface->getCanvas();
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 8; ++i) {
+        paint.setColor(i & 1 ? SK_ColorRED : SK_ColorBLUE);
+        canvas->drawRect(SkRect::MakeXYWH(i, i, 32, 32), paint);
+    }
+    SkPath path;
+    path.moveTo(4, 4);
+    path.cubicTo(60, 0, 0, 60, 60, 60);
+    path.close();
+    canvas->drawPath(path, paint);
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    InsertRecordingInfo info;
+    info.fRecording = recording.get();
+    context->insertRecording(info);
+    testContext->syncedSubmit(context);
+}
+
+void check_timings(skiatest::Reporter* reporter,
+                   const std::vector<Context::GpuDrawTiming>& timings) {
+    for (const Context::GpuDrawTiming& timing : timings) {
+        REPORTER_ASSERT(reporter, !timing.fName.empty());
+        REPORTER_ASSERT(reporter, timing.fCount > 0);
+        REPORTER_ASSERT(reporter, timing.fTime >= std::chrono::nanoseconds(0));
+    }
+}
+
+}  // anonymous namespace
+
+DEF_CONDITIONAL_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(GpuDrawTimingsTest,
+                                                     reporter,
+                                                     context,
+                                                     testContext,
+                                                     true,
+                                                     CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(),
+                                                        SkImageInfo::MakeN32Premul(64, 64));
+    REPORTER_ASSERT(reporter, surface);
+
+    // Nothing is measured until timing is enabled.
+    draw_and_submit(context, testContext, recorder.get(), surface.get());
+    Context::GpuDrawTimings timings = context->takeGpuDrawTimings();
+    REPORTER_ASSERT(reporter, timings.fRenderSteps.empty() && timings.fPipelines.empty());
+
+    context->setGpuDrawTimingsEnabled(true);
+    draw_and_submit(context, testContext, recorder.get(), surface.get());
+    timings = context->takeGpuDrawTimings();
+    if (!context->supportsGpuDrawTimings()) {
+        REPORTER_ASSERT(reporter, timings.fRenderSteps.empty() && timings.fPipelines.empty());
+        return;
+    }
+
+    REPORTER_ASSERT(reporter, !timings.fRenderSteps.empty());
+    // Every pipeline belongs to a RenderStep, so there are at least as many of them.
+    REPORTER_ASSERT(reporter, timings.fPipelines.size() >= timings.fRenderSteps.size());
+    check_timings(reporter, timings.fRenderSteps);
+    check_timings(reporter, timings.fPipelines);
+
+    // Both groupings count each run of draws once.
+    int stepRuns = 0, pipelineRuns = 0;
+    for (const Context::GpuDrawTiming& timing : timings.fRenderSteps) {
+        stepRuns += timing.fCount;
+    }
+    for (const Context::GpuDrawTiming& timing : timings.fPipelines) {
+        pipelineRuns += timing.fCount;
+    }
+    REPORTER_ASSERT(reporter, stepRuns == pipelineRuns);
+
+    // Taking the timings resets them.
+    timings = context->takeGpuDrawTimings();
+    REPORTER_ASSERT(reporter, timings.fRenderSteps.empty() && timings.fPipelines.empty());
+
+    context->setGpuDrawTimingsEnabled(false);
+    draw_and_submit(context, testContext, recorder.get(), surface.get());
+    timings = context->takeGpuDrawTimings();
+    REPORTER_ASSERT(reporter, timings.fRenderSteps.empty() && timings.fPipelines.empty());
+}
+
+}  // namespace skgpu::graphite
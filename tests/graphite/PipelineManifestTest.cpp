@@ -0,0 +1,187 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/effects/SkPerlinNoiseShader.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Recording.h"
+#include "include/gpu/graphite/Surface.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/GlobalCache.h"
+#include "src/gpu/graphite/PipelineManifest.h"
+#include "src/gpu/graphite/PublicPrecompile.h"
+#include "tools/graphite/GraphiteTestContext.h"
+
+#include <cstring>
+#include <memory>
+
+namespace skgpu::graphite {
+
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(PipelineManifestTest,
+                                         reporter,
+                                         context,
+                                         CtsEnforcement::kNever) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(),
+                                                        SkImageInfo::MakeN32Premul(64, 64));
+    REPORTER_ASSERT(reporter, surface);
+
+    SkCanvas* canvas = surface->getCanvas();
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeXYWH(4, 4, 32, 32), paint);
+    SkPath path;
+    path.moveTo(4, 4);
+    path.cubicTo(60, 0, 0, 60, 60, 60);
+    path.close();
+    canvas->drawPath(path, paint);
+
+    std::unique_ptr<Recording> recording = recorder->snap();
+    InsertRecordingInfo info;
+    info.fRecording = recording.get();
+    context->insertRecording(info);
+    context->submit(SyncToCpu::kYes);
+
+    sk_sp<SkData> manifest = context->serializePipelineKeys();
+    REPORTER_ASSERT(reporter, manifest);
+    if (!manifest) {
+        return;
+    }
+
+    // A new process starts with an empty cache; the manifest compiles the same pipelines again.
+    GlobalCache* globalCache = context->priv().globalCache();
+    globalCache->resetGraphicsPipelines();
+    std::unique_ptr<Recorder> precompileRecorder = context->makeRecorder();
+    int compiled = PrecompileSerializedPipelines(precompileRecorder.get(), *manifest);
+    REPORTER_ASSERT(reporter, compiled > 0);
+    REPORTER_ASSERT(reporter, globalCache->numGraphicsPipelines() >= compiled);
+
+    // Pipelines that are already compiled are counted without being compiled again.
+    int before = globalCache->numGraphicsPipelines();
+    REPORTER_ASSERT(reporter,
+                    PrecompileSerializedPipelines(precompileRecorder.get(), *manifest) == compiled);
+    REPORTER_ASSERT(reporter, globalCache->numGraphicsPipelines() == before);
+
+    // Data that isn't a manifest from this version of Skia compiles nothing.
+    globalCache->resetGraphicsPipelines();
+    sk_sp<SkData> garbage = SkData::MakeUninitialized(manifest->size());
+    memset(garbage->writable_data(), 0xA5, garbage->size());
+    REPORTER_ASSERT(reporter, PrecompileSerializedPipelines(precompileRecorder.get(), *garbage) == 0);
+    sk_sp<SkData> truncated = SkData::MakeWithCopy(manifest->data(), 8);
+    REPORTER_ASSERT(reporter,
+                    PrecompileSerializedPipelines(precompileRecorder.get(), *truncated) == 0);
+    REPORTER_ASSERT(reporter, globalCache->numGraphicsPipelines() == 0);
+}
+
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(PipelineMissesTest,
+                                         reporter,
+                                         context,
+                                         CtsEnforcement::kNever) {
+    GlobalCache* globalCache = context->priv().globalCache();
+    globalCache->resetGraphicsPipelines();
+
+    auto draw = [&]() {
+        std::unique_ptr<Recorder> recorder = context->makeRecorder();
+        sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(),
+                                                            SkImageInfo::MakeN32Premul(64, 64));
+        const SkPoint pts[2] = {{0, 0}, {64, 64}};
+        const SkColor colors[2] = {SK_ColorRED, SK_ColorBLUE};
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                     SkTileMode::kClamp));
+        surface->getCanvas()->drawRect(SkRect::MakeXYWH(4, 4, 32, 32), paint);
+        std::unique_ptr<Recording> recording = recorder->snap();
+        InsertRecordingInfo info;
+        info.fRecording = recording.get();
+        context->insertRecording(info);
+        context->submit(SyncToCpu::kYes);
+    };
+
+    // Nothing was precompiled, so the draw's pipelines are misses.
+    int missesBefore = globalCache->pipelineMissEntries().size();
+    draw();
+    int misses = globalCache->pipelineMissEntries().size();
+    REPORTER_ASSERT(reporter, misses > missesBefore);
+    sk_sp<SkData> manifest = context->serializePipelineMisses();
+    REPORTER_ASSERT(reporter, manifest);
+    if (!manifest) {
+        return;
+    }
+
+    // The misses turn into PaintOptions for the gradient.
+    SkString source;
+    skia_private::TArray<SkString> skipped;
+    REPORTER_ASSERT(reporter,
+                    PipelineManifest::MakePaintOptionsSource(context->priv().shaderCodeDictionary(),
+                                                             *manifest,
+                                                             &source,
+                                                             &skipped));
+    REPORTER_ASSERT(reporter, skipped.empty(), "%s", skipped.empty() ? "" : skipped[0].c_str());
+    REPORTER_ASSERT(reporter, source.contains("PrecompileShaders::LinearGradient()"),
+                    "%s", source.c_str());
+    REPORTER_ASSERT(reporter, source.contains("SkBlendMode::kSrcOver"), "%s", source.c_str());
+    REPORTER_ASSERT(reporter, source.contains("DrawTypeFlags::kShape"), "%s", source.c_str());
+
+    // Once the misses are precompiled, drawing again misses nothing, and precompiling isn't
+    // reported as a miss.
+    globalCache->resetGraphicsPipelines();
+    std::unique_ptr<Recorder> precompileRecorder = context->makeRecorder();
+    REPORTER_ASSERT(reporter, PrecompileSerializedPipelines(precompileRecorder.get(), *manifest) > 0);
+    draw();
+    REPORTER_ASSERT(reporter, globalCache->pipelineMissEntries().size() == misses);
+}
+
+// PaintOptions can't describe a Perlin noise shader, so its pipelines are reported as skipped
+// instead of being written out as code that would precompile something else.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(PipelineMissesSkipUnsupportedTest,
+                                         reporter,
+                                         context,
+                                         CtsEnforcement::kNever) {
+    GlobalCache* globalCache = context->priv().globalCache();
+    globalCache->resetGraphicsPipelines();
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(),
+                                                        SkImageInfo::MakeN32Premul(64, 64));
+    SkPaint paint;
+    paint.setShader(SkShaders::MakeFractalNoise(0.05f, 0.05f, 2, 0.0f));
+    surface->getCanvas()->drawRect(SkRect::MakeXYWH(4, 4, 32, 32), paint);
+    std::unique_ptr<Recording> recording = recorder->snap();
+    InsertRecordingInfo info;
+    info.fRecording = recording.get();
+    context->insertRecording(info);
+    context->submit(SyncToCpu::kYes);
+
+    sk_sp<SkData> manifest = context->serializePipelineMisses();
+    REPORTER_ASSERT(reporter, manifest);
+    if (!manifest) {
+        return;
+    }
+
+    SkString source;
+    skia_private::TArray<SkString> skipped;
+    REPORTER_ASSERT(reporter,
+                    PipelineManifest::MakePaintOptionsSource(context->priv().shaderCodeDictionary(),
+                                                             *manifest,
+                                                             &source,
+                                                             &skipped));
+    REPORTER_ASSERT(reporter, skipped.size() == 1);
+    REPORTER_ASSERT(reporter, !skipped.empty() && skipped[0].contains("Perlin noise"));
+    REPORTER_ASSERT(reporter, !source.contains("Precompile("), "%s", source.c_str());
+}
+
+}  // namespace skgpu::graphite
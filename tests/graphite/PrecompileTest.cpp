@@ -0,0 +1,51 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkExecutor.h"
+#include "include/gpu/graphite/Context.h"
+#include "src/gpu/graphite/ContextPriv.h"
+#include "src/gpu/graphite/FactoryFunctions.h"
+#include "src/gpu/graphite/GlobalCache.h"
+#include "src/gpu/graphite/Precompile.h"
+#include "src/gpu/graphite/PublicPrecompile.h"
+
+#include <memory>
+
+namespace skgpu::graphite {
+
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(PrecompileWithExecutorTest,
+                                         reporter,
+                                         context,
+                                         CtsEnforcement::kNever) {
+    PaintOptions paintOptions;
+    paintOptions.setShaders({ PrecompileShaders::Color(),
+                              PrecompileShaders::LinearGradient(),
+                              PrecompileShaders::RadialGradient() });
+    SkBlendMode blendModes[] = { SkBlendMode::kSrcOver, SkBlendMode::kSrc };
+    paintOptions.setBlendModes(blendModes);
+
+    GlobalCache* globalCache = context->priv().globalCache();
+    globalCache->resetGraphicsPipelines();
+    Precompile(context, paintOptions);
+    const int serialCount = globalCache->numGraphicsPipelines();
+    REPORTER_ASSERT(reporter, serialCount > 0);
+
+    // Compiling on several threads produces the same set of pipelines...
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    globalCache->resetGraphicsPipelines();
+    Precompile(context, paintOptions, kMostCommon, executor.get());
+    REPORTER_ASSERT(reporter, globalCache->numGraphicsPipelines() == serialCount);
+
+    // ... and pipelines that are already compiled aren't compiled again.
+    Precompile(context, paintOptions, kMostCommon, executor.get());
+    REPORTER_ASSERT(reporter, globalCache->numGraphicsPipelines() == serialCount);
+}
+
+}  // namespace skgpu::graphite
@@ -7,11 +7,19 @@
 
 #include "tests/Test.h"
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkSurface.h"
 #include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Image.h"
 #include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Surface.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/graphite/Device.h"
 #include "src/gpu/graphite/RecorderPriv.h"
+#include "tools/ToolUtils.h"
 
 using namespace skgpu::graphite;
 using Mipmapped = skgpu::Mipmapped;
@@ -85,3 +93,59 @@ DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecorderDevicePtrTest, reporter, context,
     device1.reset();
     device3.reset();
 }
+
+// Large immutable raster images are copied into upload buffers on the Recorder's executor. The
+// uploaded texture must match the raster source, even after the caller drops its last ref on the
+// source before the Recorder is snapped.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(RecorderAsyncImageUploadTest, reporter, context,
+                                         CtsEnforcement::kNextRelease) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+
+    // 512x512 RGBA is 1MB, well above the size that is copied off the Recorder's thread.
+    const SkImageInfo info = SkImageInfo::Make({512, 512},
+                                               kRGBA_8888_SkColorType,
+                                               kPremul_SkAlphaType);
+    SkBitmap expected;
+    expected.allocPixels(info);
+    for (int y = 0; y < info.height(); ++y) {
+        for (int x = 0; x < info.width(); ++x) {
+            *expected.getAddr32(x, y) = SkPackARGB32(0xFF, x & 0xFF, y & 0xFF, (x ^ y) & 0xFF);
+        }
+    }
+
+    for (SkExecutor* exec : {executor.get(), static_cast<SkExecutor*>(nullptr)}) {
+        RecorderOptions options;
+        options.fExecutor = exec;
+        std::unique_ptr<Recorder> recorder = context->makeRecorder(options);
+
+        sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder.get(), info);
+        if (!surface) {
+            ERRORF(reporter, "Surface creation failed");
+            return;
+        }
+
+        {
+            SkBitmap src;
+            src.allocPixels(info);
+            SkAssertResult(expected.readPixels(src.pixmap()));
+            src.setImmutable();
+            sk_sp<SkImage> image = SkImages::TextureFromImage(recorder.get(),
+                                                              src.asImage().get(),
+                                                              {false});
+            REPORTER_ASSERT(reporter, image);
+            if (!image) {
+                return;
+            }
+
+            SkPaint paint;
+            paint.setBlendMode(SkBlendMode::kSrc);
+            surface->getCanvas()->drawImage(image, 0, 0, SkSamplingOptions(), &paint);
+        }
+
+        SkBitmap actual;
+        actual.allocPixels(info);
+        REPORTER_ASSERT(reporter, surface->readPixels(actual, 0, 0));
+        REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(expected, actual),
+                        "executor: %s", exec ? "yes" : "no");
+    }
+}
@@ -152,4 +152,47 @@ DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecordingSurfacesTestWritePixelsOffscreen, re
     run_test(reporter, context, surfaceSize, recordingSize, replayOffset, draw, expectations);
 }
 
+// Tests that a Recording can be replayed several times, with a different translation each time,
+// without being recorded again.
+DEF_GRAPHITE_TEST_FOR_ALL_CONTEXTS(RecordingSurfacesTestRepeatedReplay, reporter, context,
+                                   CtsEnforcement::kNever) {
+    const SkImageInfo surfaceImageInfo = SkImageInfo::Make(
+            12, 4, SkColorType::kRGBA_8888_SkColorType, SkAlphaType::kPremul_SkAlphaType);
+
+    std::unique_ptr<Recorder> surfaceRecorder = context->makeRecorder();
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(surfaceRecorder.get(), surfaceImageInfo);
+    Surface* graphiteSurface = static_cast<Surface*>(surface.get());
+    const TextureInfo& textureInfo = graphiteSurface->backingTextureProxy()->textureInfo();
+    std::unique_ptr<Recording> surfaceRecording = surfaceRecorder->snap();
+    context->insertRecording({surfaceRecording.get()});
+
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+    SkCanvas* canvas = recorder->makeDeferredCanvas(surfaceImageInfo.makeWH(2, 2), textureInfo);
+    SkPaint paint;
+    paint.setColor(SkColors::kRed);
+    canvas->drawRect(SkRect::MakeWH(2, 2), paint);
+    std::unique_ptr<Recording> recording = recorder->snap();
+
+    for (int x : {0, 4, 8}) {
+        REPORTER_ASSERT(reporter,
+                        context->insertRecording({recording.get(), surface.get(), {x, 1}}));
+    }
+
+    SkBitmap bitmap;
+    SkPixmap pixmap;
+    bitmap.allocPixels(surfaceImageInfo);
+    SkAssertResult(bitmap.peekPixels(&pixmap));
+    if (!surface->readPixels(pixmap, 0, 0)) {
+        ERRORF(reporter, "readPixels failed");
+        return;
+    }
+    for (int x = 0; x < surfaceImageInfo.width(); ++x) {
+        SkColor4f expected = x % 4 < 2 ? SkColors::kRed : SkColors::kTransparent;
+        REPORTER_ASSERT(reporter, pixmap.getColor4f(x, 0) == SkColors::kTransparent);
+        REPORTER_ASSERT(reporter, pixmap.getColor4f(x, 1) == expected);
+        REPORTER_ASSERT(reporter, pixmap.getColor4f(x, 2) == expected);
+        REPORTER_ASSERT(reporter, pixmap.getColor4f(x, 3) == SkColors::kTransparent);
+    }
+}
+
 }  // namespace skgpu::graphite
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tests/Test.h"
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkYUVAPixmaps.h"
+#include "include/gpu/graphite/Context.h"
+#include "include/gpu/graphite/Image.h"
+#include "include/gpu/graphite/Recorder.h"
+#include "include/gpu/graphite/Surface.h"
+#include "include/private/base/SkTo.h"
+#include "tools/Resources.h"
+
+#include <vector>
+
+namespace skgpu::graphite {
+
+namespace {
+
+SkBitmap draw_to_bitmap(skiatest::Reporter* reporter, Recorder* recorder, SkImage* image) {
+    SkImageInfo info = SkImageInfo::Make(image->dimensions(),
+                                         kRGBA_8888_SkColorType,
+                                         kPremul_SkAlphaType);
+    sk_sp<SkSurface> surface = SkSurfaces::RenderTarget(recorder, info);
+    REPORTER_ASSERT(reporter, surface);
+    SkBitmap bitmap;
+    if (!surface) {
+        return bitmap;
+    }
+    surface->getCanvas()->drawImage(image, 0, 0);
+    bitmap.allocPixels(info);
+    REPORTER_ASSERT(reporter, surface->readPixels(bitmap.pixmap(), 0, 0));
+    return bitmap;
+}
+
+bool same_pixels(const SkBitmap& a, const SkBitmap& b) {
+    if (a.dimensions() != b.dimensions()) {
+        return false;
+    }
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr(0, y), b.getAddr(0, y), a.info().minRowBytes())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // anonymous namespace
+
+// Checks that planes written straight into the upload buffer draw the same as planes that are
+// decoded to client memory and then uploaded.
+DEF_GRAPHITE_TEST_FOR_RENDERING_CONTEXTS(YUVAPlanesUploadTest, reporter, context,
+                                         CtsEnforcement::kNextRelease) {
+    std::unique_ptr<Recorder> recorder = context->makeRecorder();
+
+    const char* kFiles[] = {
+        "images/mandrill_h1v1.jpg",
+        "images/mandrill_h2v1.jpg",
+        "images/color_wheel.jpg",
+        "images/grayscale.jpg",
+    };
+
+    std::vector<const char*> names;
+    std::vector<sk_sp<SkData>> encoded;
+    std::vector<SkYUVAPixmapInfo> pixmapInfos;
+    for (const char* file : kFiles) {
+        sk_sp<SkData> data = GetResourceAsData(file);
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        SkYUVAPixmapInfo pixmapInfo;
+        if (!codec || !codec->queryYUVAInfo(SkYUVAPixmapInfo::SupportedDataTypes::All(),
+                                            &pixmapInfo)) {
+            continue;
+        }
+        names.push_back(file);
+        encoded.push_back(std::move(data));
+        pixmapInfos.push_back(pixmapInfo);
+    }
+    if (pixmapInfos.empty()) {
+        return;  // No JPEG decoder.
+    }
+    // An invalid entry produces no image, but does not affect the others.
+    pixmapInfos.push_back(SkYUVAPixmapInfo());
+
+    int writeCount = 0;
+    auto writePlanes = [&](int index, const SkYUVAPixmaps& planes) {
+        ++writeCount;
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(encoded[index]);
+        return codec && codec->getYUVAPlanes(planes) == SkCodec::kSuccess;
+    };
+    std::vector<sk_sp<SkImage>> images =
+            SkImages::TextureFromYUVAPlanes(recorder.get(), pixmapInfos, writePlanes);
+    REPORTER_ASSERT(reporter, images.size() == pixmapInfos.size());
+    REPORTER_ASSERT(reporter, !images.back());
+    REPORTER_ASSERT(reporter, writeCount <= SkToInt(encoded.size()));
+
+    for (size_t i = 0; i + 1 < pixmapInfos.size(); ++i) {
+        if (!images[i]) {
+            // Only planes that the GPU can take unconverted are written in place.
+            continue;
+        }
+        REPORTER_ASSERT(reporter,
+                        images[i]->dimensions() == pixmapInfos[i].yuvaInfo().dimensions());
+
+        SkYUVAPixmaps planes = SkYUVAPixmaps::Allocate(pixmapInfos[i]);
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(encoded[i]);
+        REPORTER_ASSERT(reporter, codec->getYUVAPlanes(planes) == SkCodec::kSuccess);
+        sk_sp<SkImage> expected = SkImages::TextureFromYUVAPixmaps(recorder.get(), planes);
+        REPORTER_ASSERT(reporter, expected);
+        if (!expected) {
+            continue;
+        }
+
+        SkBitmap actualPixels = draw_to_bitmap(reporter, recorder.get(), images[i].get());
+        SkBitmap expectedPixels = draw_to_bitmap(reporter, recorder.get(), expected.get());
+        REPORTER_ASSERT(reporter, same_pixels(actualPixels, expectedPixels), "%s", names[i]);
+    }
+
+    // An image whose planes are not written is not created.
+    std::vector<sk_sp<SkImage>> failed = SkImages::TextureFromYUVAPlanes(
+            recorder.get(),
+            SkSpan(pixmapInfos.data(), 1),
+            [](int, const SkYUVAPixmaps&) { return false; });
+    REPORTER_ASSERT(reporter, failed.size() == 1 && !failed[0]);
+}
+
+}  // namespace skgpu::graphite
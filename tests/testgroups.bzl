@@ -8,6 +8,7 @@ CODEC_TESTS = [
     "BadIcoTest.cpp",
     "SerialProcsTest.cpp",
     "CanvasStateTest.cpp",
+    "TiledImageTest.cpp",
 ]
 
 CORE_TESTS = [
@@ -37,6 +38,7 @@ CORE_TESTS = [
     "DataRefTest.cpp",
     "DequeTest.cpp",
     "DescriptorTest.cpp",
+    "DistanceFieldGenTest.cpp",
     "DrawBitmapRectTest.cpp",
     "DrawPathTest.cpp",
     "EmptyPathTest.cpp",
@@ -87,7 +89,9 @@ CORE_TESTS = [
     "PathCoverageTest.cpp",
     "PathMeasureTest.cpp",
     "PictureBBHTest.cpp",
+    "PictureDamageTest.cpp",
     "PictureShaderTest.cpp",
+    "PixelConverterTest.cpp",
     "PixelRefTest.cpp",
     "Point3Test.cpp",
     "PointTest.cpp",
@@ -96,6 +100,7 @@ CORE_TESTS = [
     "RRectInPathTest.cpp",
     "RTreeTest.cpp",
     "RandomTest.cpp",
+    "RasterPipelineBlitterCacheTest.cpp",
     "ReadPixelsTest.cpp",
     "RecorderTest.cpp",
     "RecordingXfermodeTest.cpp",
@@ -117,6 +122,7 @@ CORE_TESTS = [
     "SkContainersTest.cpp",
     "SkDOMTest.cpp",
     "SkEnumBitMaskTest.cpp",
+    "SkExecutorTest.cpp",
     "SkGaussFilterTest.cpp",
     "SkGlyphTest.cpp",
     "SkImageTest.cpp",
@@ -0,0 +1,242 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tools/MSKPCapture.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkDocument.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/docs/SkMultiPictureDocument.h"
+#include "include/gpu/GrDirectContext.h"
+#include "include/gpu/ganesh/SkImageGanesh.h"
+#include "include/utils/SkNWayCanvas.h"
+#include "src/base/SkTime.h"
+#include "src/core/SkCanvasPriv.h"
+#include "tools/SkSharingProc.h"
+
+#include <cstring>
+#include <iterator>
+
+static constexpr char kEventPrefix[] = "SkCapture|";
+
+static constexpr const char* kEventNames[] = {
+    "Flush",
+    "Submit",
+    "SyncSubmit",
+    "PurgeUnlocked",
+    "PurgeScratch",
+    "FreeResources",
+    "Upload",
+    "Mark",
+};
+static_assert(std::size(kEventNames) == static_cast<size_t>(MSKPCapture::Event::kMark) + 1);
+
+const char* MSKPCapture::EventName(Event event) {
+    return kEventNames[static_cast<int>(event)];
+}
+
+bool MSKPCapture::ParseEvent(const char key[],
+                             const SkData* value,
+                             Event* event,
+                             SkString* label,
+                             double* timeMs) {
+    static constexpr size_t kPrefixLen = std::size(kEventPrefix) - 1;
+    if (strncmp(key, kEventPrefix, kPrefixLen) != 0 || !value || value->size() != sizeof(double)) {
+        return false;
+    }
+    key += kPrefixLen;
+    const char* bar = strchr(key, '|');
+    size_t nameLen = bar ? bar - key : strlen(key);
+    for (size_t i = 0; i < std::size(kEventNames); ++i) {
+        if (strlen(kEventNames[i]) == nameLen && strncmp(key, kEventNames[i], nameLen) == 0) {
+            *event = static_cast<Event>(i);
+            // Only marks carry a label; other events are labeled with their name.
+            if ((*event == Event::kMark) != (bar != nullptr)) {
+                return false;
+            }
+            label->set(bar ? bar + 1 : kEventNames[i]);
+            memcpy(timeMs, value->data(), sizeof(double));
+            return true;
+        }
+    }
+    return false;
+}
+
+std::unique_ptr<MSKPCapture> MSKPCapture::Make(SkWStream* dst, GrDirectContext* context) {
+    if (!dst) {
+        return nullptr;
+    }
+    return std::unique_ptr<MSKPCapture>(new MSKPCapture(dst, context));
+}
+
+MSKPCapture::MSKPCapture(SkWStream* dst, GrDirectContext* context)
+        : fContext(context)
+        , fSharingContext(std::make_unique<SkSharingSerialContext>())
+        , fStartMs(SkTime::GetMSecs()) {
+    SkSerialProcs procs;
+    procs.fImageProc = SkSharingSerialContext::serializeImage;
+    procs.fImageCtx = fSharingContext.get();
+    // Pages are only serialized by finish(), so read back any texture-backed images each page
+    // draws while they are still alive.
+    SkSharingSerialContext* sharingContext = fSharingContext.get();
+    fDocument = SkMultiPictureDocument::Make(dst, &procs, [sharingContext](const SkPicture* page) {
+        SkSharingSerialContext::collectNonTextureImagesFromPicture(page, sharingContext);
+    });
+}
+
+MSKPCapture::~MSKPCapture() { this->finish(); }
+
+SkCanvas* MSKPCapture::beginFrame(SkSurface* surface) {
+    SkASSERT(fDocument);
+    if (fFrameCanvas) {
+        this->endFrame();
+    }
+    if (fPage) {
+        fDocument->endPage();
+    }
+    fPage = fDocument->beginPage(surface->width(), surface->height());
+    fFrameCanvas = std::make_unique<SkNWayCanvas>(surface->width(), surface->height());
+    fSurfaceCanvas = surface->getCanvas();
+    fFrameSize = surface->imageInfo().dimensions();
+    fSegmentCanvas = fSegmentRecorder.beginRecording(SkRect::Make(fFrameSize));
+    fFrameCanvas->addCanvas(fSurfaceCanvas);
+    fFrameCanvas->addCanvas(fSegmentCanvas);
+    this->recordEvent(Event::kMark, "FrameBegin");
+    return fFrameCanvas.get();
+}
+
+void MSKPCapture::endFrame() {
+    if (!fFrameCanvas) {
+        return;
+    }
+    fFrameCanvas->restoreToCount(1);
+    fFrameCanvas->removeAll();
+    fFrameCanvas.reset();
+    fSurfaceCanvas = nullptr;
+    fSegmentCanvas = nullptr;
+    this->drawSegment();
+    this->recordEvent(Event::kMark, "FrameEnd");
+}
+
+void MSKPCapture::drawSegment() {
+    sk_sp<SkPicture> segment = fSegmentRecorder.finishRecordingAsPicture();
+    // SkCanvas plays pictures this small back in place rather than drawing them as pictures, and
+    // a single op doesn't depend on canvas state set up by the segment, so they aren't marked.
+    if (segment->approximateOpCount() > kMaxPictureOpsToUnrollInsteadOfRef) {
+        fPage->drawAnnotation(SkRect::MakeEmpty(), kSegmentKey,
+                              SkData::MakeWithCString("X").get());
+    }
+    fPage->drawPicture(segment);
+}
+
+void MSKPCapture::flushSegment() {
+    if (!fFrameCanvas) {
+        return;
+    }
+    // The new run starts with the canvas's current save count, matrix and clip so the client's
+    // restores still balance. Only the device bounds of the clip are kept.
+    int saveCount = fFrameCanvas->getSaveCount();
+    SkM44 localToDevice = fFrameCanvas->getLocalToDevice();
+    SkIRect clipBounds = fFrameCanvas->getDeviceClipBounds();
+
+    fFrameCanvas->removeCanvas(fSegmentCanvas);
+    this->drawSegment();
+
+    fSegmentCanvas = fSegmentRecorder.beginRecording(SkRect::Make(fFrameSize));
+    for (int i = 1; i < saveCount; ++i) {
+        fSegmentCanvas->save();
+    }
+    fSegmentCanvas->clipIRect(clipBounds);
+    fSegmentCanvas->setMatrix(localToDevice);
+    fFrameCanvas->addCanvas(fSegmentCanvas);
+}
+
+void MSKPCapture::recordEvent(Event event, const char label[]) {
+    if (!fPage) {
+        // Context calls before the first frame aren't part of any page.
+        return;
+    }
+    if (event != Event::kMark) {
+        this->flushSegment();
+    }
+    SkString key(kEventPrefix);
+    key.append(EventName(event));
+    if (event == Event::kMark) {
+        SkASSERT(label && !strchr(label, '|'));
+        key.appendf("|%s", label);
+    }
+    double timeMs = SkTime::GetMSecs() - fStartMs;
+    fPage->drawAnnotation(SkRect::MakeEmpty(), key.c_str(),
+                          SkData::MakeWithCopy(&timeMs, sizeof(timeMs)).get());
+}
+
+void MSKPCapture::flush() {
+    this->recordEvent(Event::kFlush);
+    if (fContext) {
+        fContext->flush();
+    }
+}
+
+bool MSKPCapture::submit(GrSyncCpu sync) {
+    this->recordEvent(sync == GrSyncCpu::kYes ? Event::kSyncSubmit : Event::kSubmit);
+    return fContext && fContext->submit(sync);
+}
+
+void MSKPCapture::purgeUnlockedResources(GrPurgeResourceOptions opts) {
+    this->recordEvent(opts == GrPurgeResourceOptions::kScratchResourcesOnly ? Event::kPurgeScratch
+                                                                             : Event::kPurgeUnlocked);
+    if (fContext) {
+        fContext->purgeUnlockedResources(opts);
+    }
+}
+
+void MSKPCapture::freeGpuResources() {
+    this->recordEvent(Event::kFreeResources);
+    if (fContext) {
+        fContext->freeGpuResources();
+    }
+}
+
+sk_sp<SkImage> MSKPCapture::uploadImage(sk_sp<SkImage> image) {
+    if (!fContext || !image) {
+        return image;
+    }
+    sk_sp<SkImage> texture = SkImages::TextureFromImage(fContext, image);
+    if (!texture) {
+        return image;
+    }
+    // Serialize the texture as the original's pixels, so the upload and later draws of the
+    // texture refer to the same image in the MSKP.
+    fSharingContext->fNonTexMap[texture->uniqueID()] =
+            image->isTextureBacked() ? image->makeNonTextureImage() : image;
+    this->recordEvent(Event::kUpload);
+    if (fPage) {
+        fPage->drawImage(texture, 0, 0);
+    }
+    return texture;
+}
+
+void MSKPCapture::mark(const char label[]) { this->recordEvent(Event::kMark, label); }
+
+void MSKPCapture::finish() {
+    if (!fDocument) {
+        return;
+    }
+    this->endFrame();
+    if (fPage) {
+        fDocument->endPage();
+        fPage = nullptr;
+    }
+    fDocument->close();
+    fDocument.reset();
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef MSKPCapture_DEFINED
+#define MSKPCapture_DEFINED
+
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "include/gpu/GpuTypes.h"
+#include "include/gpu/GrTypes.h"
+
+#include <memory>
+
+class GrDirectContext;
+class SkCanvas;
+class SkData;
+class SkDocument;
+class SkImage;
+class SkNWayCanvas;
+class SkString;
+class SkSurface;
+class SkWStream;
+struct SkSharingSerialContext;
+
+/**
+ * Captures a GPU workload as a MSKP that MSKPPlayer can replay. Besides the canvas calls of each
+ * frame it records the client's flushes, submits, purges and texture uploads on the
+ * GrDirectContext, in the order they were made relative to the draws, plus timing markers. When
+ * the MSKP is replayed to a canvas with a GrDirectContext those context calls are repeated at the
+ * same points, so flush boundaries, and the cache and atlas state that depends on them, match the
+ * capture instead of the player flushing once per frame.
+ *
+ * Usage: make the capture for the client's context, and route the context calls through it.
+ *
+ *      canvas = capture->beginFrame(surface);
+ *      ... draw to canvas ...
+ *      capture->endFrame();
+ *      capture->flush();
+ *      capture->submit();
+ *
+ * The context calls are recorded as annotations on the page (see Event), so the MSKP stays
+ * readable by anything that reads MSKPs.
+ */
+class MSKPCapture {
+public:
+    /**
+     * Makes a capture that writes to dst when finish() is called. The context may be null to
+     * capture raster drawing, in which case only the draws and timing markers are recorded.
+     */
+    static std::unique_ptr<MSKPCapture> Make(SkWStream* dst, GrDirectContext*);
+
+    ~MSKPCapture();
+
+    /**
+     * Starts a new frame (and MSKP page) the size of the surface. The returned canvas draws to
+     * the surface and records into the page until endFrame(). Context calls made after endFrame()
+     * still belong to this frame, up to the next beginFrame().
+     */
+    SkCanvas* beginFrame(SkSurface*);
+    void endFrame();
+
+    /** These forward to the GrDirectContext and record the call. */
+    void flush();
+    bool submit(GrSyncCpu = GrSyncCpu::kNo);
+    void purgeUnlockedResources(GrPurgeResourceOptions);
+    void freeGpuResources();
+
+    /**
+     * Uploads the image to a texture with SkImages::TextureFromImage() and records the upload.
+     * Draw the returned image, not the original, so that replay draws the uploaded image too.
+     * Without a context this returns the image unchanged.
+     */
+    sk_sp<SkImage> uploadImage(sk_sp<SkImage>);
+
+    /** Records a timing marker in the current frame. The label must not contain '|'. */
+    void mark(const char label[]);
+
+    /** Ends the last frame and writes the MSKP. Called by the destructor if need be. */
+    void finish();
+
+    /**
+     * The recorded events. Each is stored as a drawAnnotation() on the page with the key
+     * "SkCapture|<event>" and the time of the call, in milliseconds since the capture was made,
+     * as a double in the data. Marks append their label to the key.
+     */
+    enum class Event {
+        kFlush,
+        kSubmit,
+        kSyncSubmit,
+        kPurgeUnlocked,
+        kPurgeScratch,
+        kFreeResources,
+        kUpload,  // The next drawImage() on the page is the uploaded image, not a draw.
+        kMark,
+    };
+
+    /**
+     * The next drawPicture() on the page is a run of the frame's draws between two events, to be
+     * drawn as is.
+     */
+    static constexpr char kSegmentKey[] = "SkCapture|Segment";
+
+    /** Decodes an event annotation. Returns false if the key isn't one written by MSKPCapture. */
+    static bool ParseEvent(const char key[],
+                           const SkData* value,
+                           Event*,
+                           SkString* label,
+                           double* timeMs);
+
+    /** The name of an event, as used in its key and as the label of its marker. */
+    static const char* EventName(Event);
+
+private:
+    MSKPCapture(SkWStream*, GrDirectContext*);
+
+    void recordEvent(Event, const char label[] = nullptr);
+    // Draws the segment being recorded to the page.
+    void drawSegment();
+    // Draws the draws recorded since the last event to the page, and starts a new run that
+    // continues with the same canvas state.
+    void flushSegment();
+
+    GrDirectContext*                        fContext;
+    std::unique_ptr<SkSharingSerialContext> fSharingContext;
+    sk_sp<SkDocument>                       fDocument;
+    SkCanvas*                               fPage = nullptr;
+    std::unique_ptr<SkNWayCanvas>           fFrameCanvas;
+    SkCanvas*                               fSurfaceCanvas = nullptr;
+    SkISize                                 fFrameSize = {0, 0};
+    SkPictureRecorder                       fSegmentRecorder;
+    SkCanvas*                               fSegmentCanvas = nullptr;
+    double                                  fStartMs;
+};
+
+#endif
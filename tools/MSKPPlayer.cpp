@@ -13,12 +13,14 @@
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkSurface.h"
 #include "include/gpu/GrDirectContext.h"
+#include "include/gpu/ganesh/SkImageGanesh.h"
 #include "include/private/base/SkTArray.h"
 #include "include/utils/SkNoDrawCanvas.h"
 #include "src/base/SkTLazy.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkStringUtils.h"
 #include "include/docs/SkMultiPictureDocument.h"
+#include "tools/MSKPCapture.h"
 #include "tools/SkSharingProc.h"
 
 using namespace skia_private;
@@ -118,6 +120,49 @@ void MSKPPlayer::DrawLayerCmd::draw(SkCanvas* canvas,
                           fConstraint);
 }
 
+// Repeats a GrDirectContext call recorded by MSKPCapture. Does nothing when not playing back to a
+// direct context.
+struct MSKPPlayer::EventCmd : Cmd {
+    MSKPCapture::Event fEvent;
+    sk_sp<SkImage>     fImage;  // The image to upload for kUpload.
+
+    bool isFullRedraw(SkCanvas*) const override { return false; }
+
+    void draw(SkCanvas* canvas, const LayerMap&, LayerStateMap*) const override {
+        auto dContext = GrAsDirectContext(canvas->recordingContext());
+        if (!dContext) {
+            return;
+        }
+        switch (fEvent) {
+            case MSKPCapture::Event::kFlush:
+                dContext->flush();
+                break;
+            case MSKPCapture::Event::kSubmit:
+                dContext->submit(GrSyncCpu::kNo);
+                break;
+            case MSKPCapture::Event::kSyncSubmit:
+                dContext->submit(GrSyncCpu::kYes);
+                break;
+            case MSKPCapture::Event::kPurgeUnlocked:
+                dContext->purgeUnlockedResources(GrPurgeResourceOptions::kAllResources);
+                break;
+            case MSKPCapture::Event::kPurgeScratch:
+                dContext->purgeUnlockedResources(GrPurgeResourceOptions::kScratchResourcesOnly);
+                break;
+            case MSKPCapture::Event::kFreeResources:
+                dContext->freeGpuResources();
+                break;
+            case MSKPCapture::Event::kUpload:
+                // The texture isn't kept, but the image is lazily decoded so its texture stays in
+                // the resource cache for later draws of it, as the client's texture would.
+                SkImages::TextureFromImage(dContext, fImage);
+                break;
+            case MSKPCapture::Event::kMark:
+                break;
+        }
+    }
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 class MSKPPlayer::CmdRecordCanvas : public SkCanvasVirtualEnforcer<SkCanvas> {
@@ -199,6 +244,15 @@ protected:
                       SkScalar dy,
                       const SkSamplingOptions& sampling,
                       const SkPaint* paint) override {
+        if (fNextDrawImageIsUpload) {
+            this->recordPicCmd();
+            auto upload = std::make_unique<EventCmd>();
+            upload->fEvent = MSKPCapture::Event::kUpload;
+            upload->fImage = sk_ref_sp(image);
+            fDst->fCmds.push_back(std::move(upload));
+            fNextDrawImageIsUpload = false;
+            return;
+        }
         fRecorder.getRecordingCanvas()->drawImage(image, dx, dy, sampling, paint);
     }
 
@@ -294,6 +348,27 @@ protected:
     void onDrawAnnotation(const SkRect& rect, const char key[], SkData* value) override {
         static constexpr char kOffscreenLayerDraw[] = "OffscreenLayerDraw";
         static constexpr char kSurfaceID[] = "SurfaceID";
+        if (strcmp(key, MSKPCapture::kSegmentKey) == 0) {
+            // The next drawPicture command holds draws from MSKPCapture with their own matrix and
+            // clip state, so record it as is.
+            fNextDrawPictureIsSegment = true;
+            return;
+        }
+        MSKPCapture::Event event;
+        Marker marker;
+        if (MSKPCapture::ParseEvent(key, value, &event, &marker.fLabel, &marker.fTimeMs)) {
+            fDst->fMarkers.push_back(std::move(marker));
+            if (event == MSKPCapture::Event::kUpload) {
+                // The next drawImage command is the image to upload.
+                fNextDrawImageIsUpload = true;
+            } else if (event != MSKPCapture::Event::kMark) {
+                this->recordPicCmd();
+                auto cmd = std::make_unique<EventCmd>();
+                cmd->fEvent = event;
+                fDst->fCmds.push_back(std::move(cmd));
+            }
+            return;
+        }
         TArray<SkString> tokens;
         SkStrSplit(key, "|", kStrict_SkStrSplitMode, &tokens);
         if (tokens.size() == 2) {
@@ -332,6 +407,11 @@ protected:
     void onDrawPicture(const SkPicture* picture,
                        const SkMatrix* matrix,
                        const SkPaint* paint) override {
+        if (fNextDrawPictureIsSegment) {
+            fRecorder.getRecordingCanvas()->drawPicture(picture, matrix, paint);
+            fNextDrawPictureIsSegment = false;
+            return;
+        }
         if (fNextDrawPictureToLayerID != -1) {
             SkASSERT(!matrix);
             SkASSERT(!paint);
@@ -378,6 +458,8 @@ private:
     int               fNextDrawPictureToLayerID       = -1;
     SkIRect           fNextDrawPictureToLayerClipRect = SkIRect::MakeEmpty();
     int               fNextDrawImageFromLayerID       = -1;
+    bool              fNextDrawPictureIsSegment       = false;
+    bool              fNextDrawImageIsUpload          = false;
     LayerMap*         fOffscreenLayers                = nullptr;
 };
 
@@ -456,6 +538,14 @@ sk_sp<SkSurface> MSKPPlayer::MakeSurfaceForLayer(const LayerCmds& layer, SkCanva
                                    &props);
 }
 
+const std::vector<MSKPPlayer::Marker>& MSKPPlayer::markers(int i) const {
+    static const std::vector<Marker> kEmpty;
+    if (i < 0 || i >= this->numFrames()) {
+        return kEmpty;
+    }
+    return fRootLayers[i].fMarkers;
+}
+
 void MSKPPlayer::resetLayers() { fOffscreenLayerStates.clear(); }
 
 void MSKPPlayer::rewindLayers() {
@@ -10,6 +10,7 @@
 
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
+#include "include/core/SkString.h"
 
 #include <memory>
 #include <unordered_map>
@@ -44,9 +45,25 @@ public:
      * Plays a frame into the passed canvas. Frames can be randomly accessed. Offscreen layers are
      * incrementally updated from their current state to the state required for the frame
      * (redrawing from scratch if their current state is ahead of the passed frame index).
+     *
+     * If the MSKP was made by MSKPCapture and the canvas has a GrDirectContext, the context's
+     * flushes, submits, purges and uploads are repeated where they were captured.
      */
     bool playFrame(SkCanvas* canvas, int i);
 
+    /** A timing marker recorded by MSKPCapture. */
+    struct Marker {
+        SkString fLabel;   // The MSKPCapture::mark() label, or the name of the context call.
+        double   fTimeMs;  // When it was recorded, in milliseconds since the capture started.
+    };
+
+    /**
+     * The markers of a frame in the order they were recorded, including one for each
+     * GrDirectContext call that playFrame() repeats. Empty if the MSKP wasn't made by
+     * MSKPCapture.
+     */
+    const std::vector<Marker>& markers(int i) const;
+
     /** Destroys any cached offscreen layers. */
     void resetLayers();
 
@@ -94,6 +111,8 @@ private:
     // layer should be current when the layer is drawn. The layer contents are updated to the
     // stored command index before the layer is drawn.
     struct DrawLayerCmd;
+    // Repeats a GrDirectContext call recorded by MSKPCapture.
+    struct EventCmd;
 
     // The commands for a root/offscreen layer and dimensions of the layer.
     struct LayerCmds {
@@ -101,6 +120,7 @@ private:
         LayerCmds(LayerCmds&&) = default;
         SkISize fDimensions;
         std::vector<std::unique_ptr<Cmd>> fCmds;
+        std::vector<Marker> fMarkers;
     };
 
     // Playback state of layer: the last command index drawn to it and the SkSurface with contents.
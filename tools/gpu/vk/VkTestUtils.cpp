@@ -439,6 +439,18 @@ static bool setup_features(const skgpu::VulkanGetProc& getProc, VkInstance inst,
         tailPNext = &ycbcrFeature->pNext;
     }
 
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT* pipelineLibraryFeature = nullptr;
+    if (extensions->hasExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME, 1)) {
+        pipelineLibraryFeature =
+                (VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT*) sk_malloc_throw(
+                        sizeof(VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT));
+        pipelineLibraryFeature->sType =
+                VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+        pipelineLibraryFeature->pNext = nullptr;
+        *tailPNext = pipelineLibraryFeature;
+        tailPNext = &pipelineLibraryFeature->pNext;
+    }
+
     if (physDeviceVersion >= VK_MAKE_VERSION(1, 1, 0)) {
         ACQUIRE_VK_PROC_LOCAL(GetPhysicalDeviceFeatures2, inst, VK_NULL_HANDLE);
         grVkGetPhysicalDeviceFeatures2(physDev, features);
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+// Turns pipeline manifests from Context::serializePipelineMisses() (or serializePipelineKeys())
+// into C++ that precompiles the same pipelines with PaintOptions, e.g.
+//
+//   precompile_gen --manifests misses.skpm > precompile.inc
+//
+// Manifests must be written by the same build of Skia as this tool. Pipelines whose paints
+// PaintOptions can't describe are listed on stderr rather than written out.
+
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkString.h"
+#include "src/gpu/graphite/PipelineManifest.h"
+#include "src/gpu/graphite/ShaderCodeDictionary.h"
+#include "tools/flags/CommandLineFlags.h"
+
+#include <cstdio>
+
+static DEFINE_string2(manifests, m, "", "Pipeline manifests to turn into PaintOptions.");
+static DEFINE_string2(write, w, "", "Write the C++ to the named file instead of stdout.");
+
+int main(int argc, char** argv) {
+    CommandLineFlags::Parse(argc, argv);
+
+    skgpu::graphite::ShaderCodeDictionary dict;
+    SkString source;
+    for (int i = 0; i < FLAGS_manifests.size(); i++) {
+        sk_sp<SkData> data = SkData::MakeFromFileName(FLAGS_manifests[i]);
+        if (!data) {
+            SkDebugf("Could not read %s.\n", FLAGS_manifests[i]);
+            return 1;
+        }
+        SkString manifestSource;
+        skia_private::TArray<SkString> skipped;
+        if (!skgpu::graphite::PipelineManifest::MakePaintOptionsSource(&dict, *data,
+                                                                       &manifestSource,
+                                                                       &skipped)) {
+            SkDebugf("Could not read %s as a pipeline manifest from this build of Skia.\n",
+                     FLAGS_manifests[i]);
+            return 1;
+        }
+        for (const SkString& paint : skipped) {
+            SkDebugf("%s: PaintOptions can't describe %s\n", FLAGS_manifests[i], paint.c_str());
+        }
+        source.appendf("// From %s\n%s", FLAGS_manifests[i], manifestSource.c_str());
+    }
+
+    if (FLAGS_write.size() > 0) {
+        SkFILEWStream stream(FLAGS_write[0]);
+        if (!stream.isValid() || !stream.write(source.c_str(), source.size())) {
+            SkDebugf("Could not write %s.\n", FLAGS_write[0]);
+            return 1;
+        }
+    } else {
+        fwrite(source.c_str(), 1, source.size(), stdout);
+    }
+    return 0;
+}
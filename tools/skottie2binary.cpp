@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
+#include "modules/skottie/include/Skottie.h"
+#include "src/utils/SkJSON.h"
+#include "tools/flags/CommandLineFlags.h"
+
+static DEFINE_string2(input, i, "", "skottie animation (JSON) to convert");
+static DEFINE_string2(output, o, "", "binary animation file to create");
+static DEFINE_bool2(verbose, v, false, "report the load times of both forms");
+
+// Converts Lottie JSON to the binary DOM form, which skottie::Animation::Builder loads directly.
+int main(int argc, char** argv) {
+    CommandLineFlags::SetUsage("Converts a skottie animation to its binary form");
+    CommandLineFlags::Parse(argc, argv);
+
+    if (FLAGS_input.size() == 0 || FLAGS_output.size() == 0) {
+        SkDebugf("-i input_file.json and -o output_file arguments required\n");
+        return -1;
+    }
+
+    const auto json = SkData::MakeFromFileName(FLAGS_input[0]);
+    if (!json) {
+        SkDebugf("failed to read %s\n", FLAGS_input[0]);
+        return -1;
+    }
+
+    const skjson::DOM dom(static_cast<const char*>(json->data()), json->size());
+    if (!dom.root().is<skjson::ObjectValue>()) {
+        SkDebugf("failed to parse %s\n", FLAGS_input[0]);
+        return -1;
+    }
+
+    SkDynamicMemoryWStream stream;
+    dom.writeBinary(&stream);
+    const auto binary = stream.detachAsData();
+
+    // Make sure the result still loads as an animation before writing it out.
+    skottie::Animation::Builder builder;
+    if (!builder.make(static_cast<const char*>(binary->data()), binary->size())) {
+        SkDebugf("%s is not a valid animation\n", FLAGS_input[0]);
+        return -1;
+    }
+    const float binaryParseMS = builder.getStats().fJsonParseTimeMS;
+
+    SkFILEWStream out(FLAGS_output[0]);
+    if (!out.isValid() || !out.write(binary->data(), binary->size())) {
+        SkDebugf("failed to write %s\n", FLAGS_output[0]);
+        return -1;
+    }
+
+    if (FLAGS_verbose) {
+        builder.make(static_cast<const char*>(json->data()), json->size());
+        SkDebugf("JSON: %zu bytes, parsed in %gms\n",
+                 json->size(), builder.getStats().fJsonParseTimeMS);
+        SkDebugf("binary: %zu bytes, loaded in %gms\n", binary->size(), binaryParseMS);
+    }
+
+    return 0;
+}
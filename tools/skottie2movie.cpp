@@ -12,6 +12,7 @@
 #include "include/core/SkSurface.h"
 #include "include/private/base/SkTPin.h"
 #include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
 #include "modules/skresources/include/SkResources.h"
 #include "src/base/SkTime.h"
 #include "src/utils/SkOSPath.h"
@@ -24,6 +25,8 @@
 #include "include/gpu/GrTypes.h"
 #include "include/gpu/ganesh/SkSurfaceGanesh.h"
 
+#include <vector>
+
 static DEFINE_string2(input, i, "", "skottie animation to render");
 static DEFINE_string2(output, o, "", "mp4 file to create");
 static DEFINE_string2(assetPath, a, "", "path to assets needed for json file");
@@ -32,6 +35,7 @@ static DEFINE_bool2(verbose, v, false, "verbose mode");
 static DEFINE_bool2(loop, l, false, "loop mode for profiling");
 static DEFINE_int(set_dst_width, 0, "set destination width (height will be computed)");
 static DEFINE_bool2(gpu, g, false, "use GPU for rendering");
+static DEFINE_int_2(threads, t, 1, "number of threads for CPU rendering");
 
 static void produce_frame(SkSurface* surf, skottie::Animation* anim, double frame) {
     anim->seekFrame(frame);
@@ -69,9 +73,16 @@ int main(int argc, char** argv) {
 
     CodecUtils::RegisterAllAvailable();
 
-    auto animation = skottie::Animation::Builder()
-        .setResourceProvider(skresources::FileResourceProvider::Make(assetPath))
-        .makeFromFile(FLAGS_input[0]);
+    // Worker threads each build their own animation, sharing the decoded assets.
+    auto resourceProvider = skresources::CachingResourceProvider::Make(
+            skresources::FileResourceProvider::Make(assetPath));
+    auto make_animation = [&]() {
+        return skottie::Animation::Builder()
+            .setResourceProvider(resourceProvider)
+            .makeFromFile(FLAGS_input[0]);
+    };
+
+    auto animation = make_animation();
     if (!animation) {
         SkDebugf("failed to load %s\n", FLAGS_input[0]);
         return -1;
@@ -103,6 +114,21 @@ int main(int argc, char** argv) {
     sk_sp<SkData> data;
 
     const auto info = SkImageInfo::MakeN32Premul(dim);
+
+    std::unique_ptr<skottie_utils::ParallelFrameRenderer> parallelRenderer;
+    std::vector<double> frameTimes;
+    if (FLAGS_threads > 1 && !FLAGS_gpu) {
+        parallelRenderer = skottie_utils::ParallelFrameRenderer::Make(make_animation, info,
+                                                                      FLAGS_threads);
+        if (!parallelRenderer) {
+            SkDebugf("failed to create %d rendering threads\n", FLAGS_threads);
+            return -1;
+        }
+        for (int i = 0; i <= frames; ++i) {
+            frameTimes.push_back(i * fps_scale);
+        }
+    }
+
     do {
         double loop_start = SkTime::GetSecs();
 
@@ -111,6 +137,21 @@ int main(int argc, char** argv) {
             return -1;
         }
 
+        if (parallelRenderer) {
+            parallelRenderer->renderFrames(frameTimes, SK_ColorWHITE,
+                                           [&](size_t, const SkPixmap& pm) {
+                                               encoder.addFrame(pm);
+                                           });
+            data = encoder.endRecording();
+
+            if (FLAGS_loop) {
+                double loop_dur = SkTime::GetSecs() - loop_start;
+                SkDebugf("recording secs %g, frames %d, recording fps %d\n",
+                         loop_dur, frames, (int)(frames / loop_dur));
+            }
+            continue;
+        }
+
         // lazily allocate the surfaces
         if (!surf) {
             if (FLAGS_gpu) {
@@ -701,6 +701,7 @@ static ResultCode process_command(SkSpan<std::string> args) {
                 compiler.errorReporter().error({}, "code has no entrypoint");
                 return false;
             }
+            compiler.runRasterPipelineOptimizations(program);
             bool wantTraceOps = (debugTrace != nullptr);
             std::unique_ptr<SkSL::RP::Program> rasterProg = SkSL::MakeRasterPipelineProgram(
                     program, *main->definition(), &skrpDebugTrace, wantTraceOps);
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tools/trace/PhaseStatsTracer.h"
+
+#include "src/core/SkTraceEvent.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace skia_private;
+
+static uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+SkEventTracer::Handle PhaseStatsTracer::addTraceEvent(char phase,
+                                                      const uint8_t* categoryEnabledFlag,
+                                                      const char* name,
+                                                      uint64_t id,
+                                                      int numArgs,
+                                                      const char** argNames,
+                                                      const uint8_t* argTypes,
+                                                      const uint64_t* argValues,
+                                                      uint8_t flags) {
+    // Only scoped events have a duration. Their handle is just their start time, which comes back
+    // to us in updateTraceEventDuration().
+    return TRACE_EVENT_PHASE_COMPLETE == phase ? now_ns() : 0;
+}
+
+void PhaseStatsTracer::updateTraceEventDuration(const uint8_t* categoryEnabledFlag,
+                                                const char* name,
+                                                SkEventTracer::Handle handle) {
+    const uint64_t end = now_ns();
+    SkString key(name);
+
+    SkAutoMutexExclusive lock(fMutex);
+    Totals* totals = fTotals.find(key);
+    if (!totals) {
+        totals = fTotals.set(std::move(key), Totals());
+    }
+    totals->fNanos += end - handle;
+    totals->fCount++;
+}
+
+TArray<PhaseStatsTracer::Phase> PhaseStatsTracer::takePhases() {
+    TArray<Phase> phases;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        phases.reserve_exact(fTotals.count());
+        fTotals.foreach([&](const SkString& name, const Totals& totals) {
+            phases.push_back({name, totals.fNanos * 1e-6, totals.fCount});
+        });
+        fTotals.reset();
+    }
+    std::sort(phases.begin(), phases.end(), [](const Phase& a, const Phase& b) {
+        return strcmp(a.fName.c_str(), b.fName.c_str()) < 0;
+    });
+    return phases;
+}
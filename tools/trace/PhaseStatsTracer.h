@@ -0,0 +1,73 @@
+/*
+ * Copyright 2024 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef PhaseStatsTracer_DEFINED
+#define PhaseStatsTracer_DEFINED
+
+#include "include/core/SkString.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
+#include "include/utils/SkEventTracer.h"
+#include "src/core/SkTHash.h"
+#include "tools/trace/EventTracingPriv.h"
+
+/**
+ * A SkEventTracer implementation that doesn't log events, but adds up the time spent in each
+ * TRACE_EVENT scope by name, so that a tool can tell which phases of its work got slower.
+ *
+ * Nested scopes with the same name are each counted, so their times overlap.
+ */
+class PhaseStatsTracer : public SkEventTracer {
+public:
+    struct Phase {
+        SkString fName;
+        double   fTotalMs;
+        int      fCount;
+    };
+
+    PhaseStatsTracer() {}
+
+    SkEventTracer::Handle addTraceEvent(char phase,
+                                        const uint8_t* categoryEnabledFlag,
+                                        const char* name,
+                                        uint64_t id,
+                                        int numArgs,
+                                        const char** argNames,
+                                        const uint8_t* argTypes,
+                                        const uint64_t* argValues,
+                                        uint8_t flags) override;
+
+    void updateTraceEventDuration(const uint8_t* categoryEnabledFlag,
+                                  const char* name,
+                                  SkEventTracer::Handle handle) override;
+
+    const uint8_t* getCategoryGroupEnabled(const char* name) override {
+        return fCategories.getCategoryGroupEnabled(name);
+    }
+
+    const char* getCategoryGroupName(const uint8_t* categoryEnabledFlag) override {
+        return fCategories.getCategoryGroupName(categoryEnabledFlag);
+    }
+
+    /**
+     * Returns the phases that ended since the last call, sorted by name, and starts over. Scopes
+     * that are still open are counted by the call after they end.
+     */
+    skia_private::TArray<Phase> takePhases();
+
+private:
+    struct Totals {
+        uint64_t fNanos = 0;
+        int      fCount = 0;
+    };
+
+    SkMutex fMutex;
+    skia_private::THashMap<SkString, Totals> fTotals SK_GUARDED_BY(fMutex);
+    SkEventTracingCategories fCategories;
+};
+
+#endif